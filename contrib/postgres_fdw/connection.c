@@ -58,6 +58,7 @@ typedef struct ConnCacheEntry
 	bool		invalidated;	/* true if reconnect is pending */
 	uint32		server_hashvalue;	/* hash value of foreign server OID */
 	uint32		mapping_hashvalue;	/* hash value of user mapping OID */
+	PgFdwConnState state;		/* extra per-connection state */
 } ConnCacheEntry;
 
 /*
@@ -102,9 +103,12 @@ static bool UserMappingPasswordRequired(UserMapping *user);
  * will_prep_stmt must be true if caller intends to create any prepared
  * statements.  Since those don't go away automatically at transaction end
  * (not even on error), we need this flag to cue manual cleanup.
+ *
+ * If state is not NULL, *state receives the per-connection state associated
+ * with the PGconn.
  */
 PGconn *
-GetConnection(UserMapping *user, bool will_prep_stmt)
+GetConnection(UserMapping *user, bool will_prep_stmt, PgFdwConnState **state)
 {
 	bool		found;
 	ConnCacheEntry *entry;
@@ -196,6 +200,7 @@ GetConnection(UserMapping *user, bool will_prep_stmt)
 		entry->mapping_hashvalue =
 			GetSysCacheHashValue1(USERMAPPINGOID,
 								  ObjectIdGetDatum(user->umid));
+		memset(&entry->state, 0, sizeof(entry->state));
 
 		/* Now try to make the connection */
 		entry->conn = connect_pg_server(server, user);
@@ -212,6 +217,10 @@ GetConnection(UserMapping *user, bool will_prep_stmt)
 	/* Remember if caller will prepare statements */
 	entry->have_prep_stmt |= will_prep_stmt;
 
+	/* If caller needs access to the per-connection state, return it. */
+	if (state)
+		*state = &entry->state;
+
 	return entry->conn;
 }
 
@@ -498,8 +507,11 @@ begin_remote_xact(ConnCacheEntry *entry)
 	/*
 	 * If we're in a subtransaction, stack up savepoints to match our level.
 	 * This ensures we can rollback just the desired effects when a
-	 * subtransaction aborts.
+	 * subtransaction aborts.  A scan of an outer query may still be fetching
+	 * asynchronously on the connection; finish that first.
 	 */
+	if (entry->xact_depth < curlevel && entry->state.pendingAreq)
+		process_pending_request(entry->state.pendingAreq);
 	while (entry->xact_depth < curlevel)
 	{
 		char		sql[64];
@@ -564,8 +576,12 @@ GetPrepStmtNumber(PGconn *conn)
  * Caller is responsible for the error handling on the result.
  */
 PGresult *
-pgfdw_exec_query(PGconn *conn, const char *query)
+pgfdw_exec_query(PGconn *conn, const char *query, PgFdwConnState *state)
 {
+	/* First, process a pending asynchronous request, if any. */
+	if (state && state->pendingAreq)
+		process_pending_request(state->pendingAreq);
+
 	/*
 	 * Submit a query.  Since we don't use non-blocking mode, this also can
 	 * block.  But its risk is relatively small, so we ignore that for now.
@@ -860,8 +876,13 @@ pgfdw_xact_callback(XactEvent event, void *arg)
 			}
 		}
 
-		/* Reset state to show we're out of a transaction */
+		/*
+		 * Reset state to show we're out of a transaction.  Any asynchronous
+		 * fetch still pending belonged to a query that failed, and has been
+		 * canceled above.
+		 */
 		entry->xact_depth = 0;
+		entry->state.pendingAreq = NULL;
 
 		/*
 		 * If the connection isn't in a good idle state, discard it to
@@ -936,6 +957,10 @@ pgfdw_subxact_callback(SubXactEvent event, SubTransactionId mySubid,
 			 */
 			pgfdw_reject_incomplete_xact_state_change(entry);
 
+			/* Finish an asynchronous fetch begun at this level, if any */
+			if (entry->state.pendingAreq)
+				process_pending_request(entry->state.pendingAreq);
+
 			/* Commit all remote subtransactions during pre-commit */
 			snprintf(sql, sizeof(sql), "RELEASE SAVEPOINT s%d", curlevel);
 			entry->changing_xact_state = true;
@@ -972,6 +997,9 @@ pgfdw_subxact_callback(SubXactEvent event, SubTransactionId mySubid,
 				abort_cleanup_failure = true;
 			else
 			{
+				/* The fetch of a pending asynchronous request is gone */
+				entry->state.pendingAreq = NULL;
+
 				/* Rollback all remote subtransactions during abort */
 				snprintf(sql, sizeof(sql),
 						 "ROLLBACK TO SAVEPOINT s%d; RELEASE SAVEPOINT s%d",
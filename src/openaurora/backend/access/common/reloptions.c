@@ -24,6 +24,7 @@
 #include "access/nbtree.h"
 #include "access/reloptions.h"
 #include "access/spgist_private.h"
+#include "access/toast_compression.h"
 #include "catalog/pg_type.h"
 #include "commands/defrem.h"
 #include "commands/tablespace.h"
@@ -158,6 +159,15 @@ static relopt_bool boolRelOpts[] =
 		},
 		true
 	},
+	{
+		{
+			"mempool_cache",
+			"Keeps pages of this table read from storage in the memory pool",
+			RELOPT_KIND_HEAP | RELOPT_KIND_TOAST,
+			ShareUpdateExclusiveLock
+		},
+		true
+	},
 	{
 		{
 			"deduplicate_items",
@@ -492,6 +502,15 @@ relopt_enum_elt_def viewCheckOptValues[] =
 	{(const char *) NULL}		/* list terminator */
 };
 
+/* values from ToastCompressionId */
+relopt_enum_elt_def toastCompressionOptValues[] =
+{
+	/* no value for INVALID, which uses default_toast_compression */
+	{"pglz", TOAST_PGLZ_COMPRESSION_ID},
+	{"lz4", TOAST_LZ4_COMPRESSION_ID},
+	{(const char *) NULL}		/* list terminator */
+};
+
 static relopt_enum enumRelOpts[] =
 {
 	{
@@ -516,6 +535,17 @@ static relopt_enum enumRelOpts[] =
 		VIEW_OPTION_CHECK_OPTION_NOT_SET,
 		gettext_noop("Valid values are \"local\" and \"cascaded\".")
 	},
+	{
+		{
+			"compression",
+			"Compression method for values of this column",
+			RELOPT_KIND_ATTRIBUTE,
+			ShareUpdateExclusiveLock
+		},
+		toastCompressionOptValues,
+		TOAST_INVALID_COMPRESSION_ID,
+		gettext_noop("Valid values are \"pglz\" and \"lz4\".")
+	},
 	/* list terminator */
 	{{NULL}}
 };
@@ -1859,7 +1889,9 @@ default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
 		{"vacuum_index_cleanup", RELOPT_TYPE_BOOL,
 		offsetof(StdRdOptions, vacuum_index_cleanup)},
 		{"vacuum_truncate", RELOPT_TYPE_BOOL,
-		offsetof(StdRdOptions, vacuum_truncate)}
+		offsetof(StdRdOptions, vacuum_truncate)},
+		{"mempool_cache", RELOPT_TYPE_BOOL,
+		offsetof(StdRdOptions, mempool_cache)}
 	};
 
 	return (bytea *) build_reloptions(reloptions, validate, kind,
@@ -2047,7 +2079,8 @@ attribute_reloptions(Datum reloptions, bool validate)
 {
 	static const relopt_parse_elt tab[] = {
 		{"n_distinct", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct)},
-		{"n_distinct_inherited", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct_inherited)}
+		{"n_distinct_inherited", RELOPT_TYPE_REAL, offsetof(AttributeOpts, n_distinct_inherited)},
+		{"compression", RELOPT_TYPE_ENUM, offsetof(AttributeOpts, compression)}
 	};
 
 	return (bytea *) build_reloptions(reloptions, validate,
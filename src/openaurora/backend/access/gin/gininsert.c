@@ -16,16 +16,117 @@
 
 #include "access/gin_private.h"
 #include "access/ginxlog.h"
+#include "access/parallel.h"
+#include "access/relscan.h"
+#include "access/table.h"
 #include "access/tableam.h"
+#include "access/xact.h"
 #include "access/xloginsert.h"
 #include "catalog/index.h"
+#include "executor/instrument.h"
+#include "lib/binaryheap.h"
 #include "miscadmin.h"
+#include "pgstat.h"
+#include "storage/buffile.h"
 #include "storage/bufmgr.h"
+#include "storage/condition_variable.h"
 #include "storage/indexfsm.h"
 #include "storage/predicate.h"
+#include "storage/sharedfileset.h"
 #include "storage/smgr.h"
+#include "storage/spin.h"
+#include "tcop/tcopprot.h"		/* pgrminclude ignore */
+#include "utils/datum.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
+#include "utils/snapmgr.h"
+
+/* Magic numbers for parallel state sharing */
+#define PARALLEL_KEY_GIN_SHARED			UINT64CONST(0xB000000000000001)
+#define PARALLEL_KEY_GIN_RUNS			UINT64CONST(0xB000000000000002)
+#define PARALLEL_KEY_QUERY_TEXT			UINT64CONST(0xB000000000000003)
+#define PARALLEL_KEY_WAL_USAGE			UINT64CONST(0xB000000000000004)
+#define PARALLEL_KEY_BUFFER_USAGE		UINT64CONST(0xB000000000000005)
+
+/*
+ * Status for GIN index builds performed in parallel.  This is allocated in a
+ * dynamic shared memory segment.
+ *
+ * Every participant scans a part of the heap into its own accumulator.  Each
+ * time that fills the participant's share of maintenance_work_mem, and once
+ * more at the end of its scan, the participant writes it out as a run: a
+ * file of the fileset holding the entries sorted by attribute and key, each
+ * with its sorted item pointers.  The leader then merges the runs of all
+ * participants, and inserts every key into the index with the item pointers
+ * of all of them, as a serial build inserts what it accumulated.
+ */
+typedef struct GinShared
+{
+	/* These fields are not modified during the build */
+	Oid			heaprelid;
+	Oid			indexrelid;
+	bool		isconcurrent;
+	int			nparticipants;	/* workers requested, plus the leader */
+	SharedFileSet fileset;		/* the runs */
+
+	/*
+	 * workersdonecv is used to monitor the progress of workers.  All
+	 * participants must indicate that they are done before the leader can
+	 * read their runs.
+	 */
+	ConditionVariable workersdonecv;
+
+	/* mutex protects the fields below, and the runs array */
+	slock_t		mutex;
+
+	/*
+	 * nparticipantsdone is number of participants finished, reltuples the
+	 * total number of input heap tuples, indtuples the number of entries
+	 * extracted from them, and brokenhotchain whether any participant
+	 * detected a broken HOT chain.
+	 */
+	int			nparticipantsdone;
+	double		reltuples;
+	double		indtuples;
+	bool		brokenhotchain;
+
+	/*
+	 * ParallelTableScanDescData data follows. Can't directly embed here, as
+	 * implementations of the parallel table scan desc interface might need
+	 * stronger alignment.
+	 */
+} GinShared;
+
+/*
+ * Return pointer to a GinShared's parallel table scan.
+ *
+ * c.f. shm_toc_allocate as to why BUFFERALIGN is used, rather than just
+ * MAXALIGN.
+ */
+#define ParallelTableScanFromGinShared(shared) \
+	(ParallelTableScanDesc) ((char *) (shared) + BUFFERALIGN(sizeof(GinShared)))
+
+/*
+ * Status for leader in parallel index build.
+ */
+typedef struct GinLeader
+{
+	/* parallel context itself */
+	ParallelContext *pcxt;
+
+	/* worker processes successfully launched, plus the leader */
+	int			nparticipants;
+
+	/*
+	 * Leader process convenience pointers to shared state.  nruns has the
+	 * number of runs each participant wrote, the leader's being the last.
+	 */
+	GinShared  *ginshared;
+	int		   *nruns;
+	Snapshot	snapshot;
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+} GinLeader;
 
 typedef struct
 {
@@ -35,8 +136,57 @@ typedef struct
 	MemoryContext tmpCtx;
 	MemoryContext funcCtx;
 	BuildAccumulator accum;
+	int			workmem;		/* KB the accumulator may take */
+
+	/*
+	 * In a parallel build, the leader has its ginleader set.  A participant
+	 * scanning the heap has ginshared, and writes its runs as participant.
+	 */
+	GinLeader  *ginleader;
+	GinShared  *ginshared;
+	int			participant;
+	int			nruns;			/* runs written so far */
 } GinBuildState;
 
+/*
+ * An entry of a run, followed by its key as written by datumSerialize() and
+ * its item pointers.
+ */
+typedef struct GinRunEntry
+{
+	OffsetNumber attnum;
+	GinNullCategory category;
+	uint32		nitems;
+	uint32		keylen;
+} GinRunEntry;
+
+/* A run being merged, and its current entry */
+typedef struct GinRunReader
+{
+	BufFile    *file;
+	MemoryContext ctx;			/* of the current entry */
+	OffsetNumber attnum;
+	Datum		key;
+	GinNullCategory category;
+	ItemPointerData *items;
+	uint32		nitems;
+} GinRunReader;
+
+static void _gin_begin_parallel(GinBuildState *buildstate, Relation heap,
+								Relation index, bool isconcurrent,
+								int request);
+static void _gin_end_parallel(GinLeader *ginleader);
+static Size _gin_parallel_estimate_shared(Relation heap, Snapshot snapshot);
+static double _gin_parallel_heapscan(GinBuildState *buildstate,
+									 bool *brokenhotchain);
+static void _gin_parallel_merge(GinBuildState *buildstate);
+static void _gin_leader_participate_as_worker(GinBuildState *buildstate,
+											  Relation heap, Relation index);
+static void _gin_parallel_scan_and_build(GinBuildState *buildstate,
+										 GinShared *ginshared, int *nruns,
+										 Relation heap, Relation index,
+										 bool progress);
+
 
 /*
  * Adds array of item pointers to tuple's posting list, or
@@ -276,6 +426,174 @@ ginHeapTupleBulkInsert(GinBuildState *buildstate, OffsetNumber attnum,
 	MemoryContextReset(buildstate->funcCtx);
 }
 
+static void
+ginBuildStateInit(GinBuildState *buildstate, Relation index, int workmem)
+{
+	initGinState(&buildstate->ginstate, index);
+	buildstate->indtuples = 0;
+	memset(&buildstate->buildStats, 0, sizeof(GinStatsData));
+	buildstate->workmem = workmem;
+	buildstate->ginleader = NULL;
+	buildstate->ginshared = NULL;
+	buildstate->participant = 0;
+	buildstate->nruns = 0;
+
+	/*
+	 * create a temporary memory context that is used to hold data not yet
+	 * dumped out to the index
+	 */
+	buildstate->tmpCtx = AllocSetContextCreate(CurrentMemoryContext,
+											   "Gin build temporary context",
+											   ALLOCSET_DEFAULT_SIZES);
+
+	/*
+	 * create a temporary memory context that is used for calling
+	 * ginExtractEntries(), and can be reset after each tuple
+	 */
+	buildstate->funcCtx = AllocSetContextCreate(CurrentMemoryContext,
+												"Gin build temporary context for user-defined function",
+												ALLOCSET_DEFAULT_SIZES);
+
+	buildstate->accum.ginstate = &buildstate->ginstate;
+	ginInitBA(&buildstate->accum);
+}
+
+static void
+ginRunWrite(BufFile *file, void *ptr, size_t len)
+{
+	if (BufFileWrite(file, ptr, len) != len)
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not write to GIN build temporary file: %m")));
+}
+
+static void
+ginRunReadExact(BufFile *file, void *ptr, size_t len)
+{
+	size_t		nread = BufFileRead(file, ptr, len);
+
+	if (nread != len)
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not read from GIN build temporary file: read only %zu of %zu bytes",
+						nread, len)));
+}
+
+static void
+ginRunName(char *name, int participant, int run)
+{
+	snprintf(name, MAXPGPATH, "gin%d.%d", participant, run);
+}
+
+/*
+ * In a participant of a parallel build, write out the accumulated entries as
+ * its next run, see GinShared, and empty the accumulator.
+ */
+static void
+ginBuildWriteRun(GinBuildState *buildstate)
+{
+	char		name[MAXPGPATH];
+	BufFile    *file;
+	ItemPointerData *list;
+	Datum		key;
+	GinNullCategory category;
+	uint32		nlist;
+	OffsetNumber attnum;
+	char	   *keyspace = NULL;
+	Size		keyspacelen = 0;
+	MemoryContext oldCtx;
+
+	oldCtx = MemoryContextSwitchTo(buildstate->tmpCtx);
+
+	ginRunName(name, buildstate->participant, buildstate->nruns);
+	file = BufFileCreateShared(&buildstate->ginshared->fileset, name);
+
+	ginBeginBAScan(&buildstate->accum);
+	while ((list = ginGetBAEntry(&buildstate->accum,
+								 &attnum, &key, &category, &nlist)) != NULL)
+	{
+		Form_pg_attribute att;
+		bool		isnull = (category != GIN_CAT_NORM_KEY);
+		GinRunEntry entry;
+		char	   *ptr;
+
+		/* there could be many entries, so be willing to abort here */
+		CHECK_FOR_INTERRUPTS();
+
+		att = TupleDescAttr(buildstate->ginstate.origTupdesc, attnum - 1);
+		entry.attnum = attnum;
+		entry.category = category;
+		entry.nitems = nlist;
+		entry.keylen = datumEstimateSpace(key, isnull, att->attbyval,
+										  att->attlen);
+		if (entry.keylen > keyspacelen)
+		{
+			keyspacelen = Max(entry.keylen, 2 * keyspacelen);
+			keyspace = palloc(keyspacelen);
+		}
+		ptr = keyspace;
+		datumSerialize(key, isnull, att->attbyval, att->attlen, &ptr);
+
+		ginRunWrite(file, &entry, sizeof(entry));
+		ginRunWrite(file, keyspace, entry.keylen);
+		ginRunWrite(file, list, sizeof(ItemPointerData) * nlist);
+	}
+	BufFileClose(file);
+	buildstate->nruns++;
+
+	MemoryContextSwitchTo(oldCtx);
+	MemoryContextReset(buildstate->tmpCtx);
+	ginInitBA(&buildstate->accum);
+}
+
+/* Read the next entry of a run being merged, false at its end */
+static bool
+ginRunRead(GinRunReader *reader)
+{
+	GinRunEntry entry;
+	size_t		nread;
+	char	   *keyspace;
+	bool		isnull;
+	MemoryContext oldCtx;
+
+	MemoryContextReset(reader->ctx);
+
+	nread = BufFileRead(reader->file, &entry, sizeof(entry));
+	if (nread == 0)
+		return false;
+	if (nread != sizeof(entry))
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not read from GIN build temporary file: read only %zu of %zu bytes",
+						nread, sizeof(entry))));
+
+	oldCtx = MemoryContextSwitchTo(reader->ctx);
+	keyspace = palloc(entry.keylen);
+	ginRunReadExact(reader->file, keyspace, entry.keylen);
+	reader->items = palloc(sizeof(ItemPointerData) * entry.nitems);
+	ginRunReadExact(reader->file, reader->items,
+					sizeof(ItemPointerData) * entry.nitems);
+	reader->key = datumRestore(&keyspace, &isnull);
+	MemoryContextSwitchTo(oldCtx);
+
+	reader->attnum = entry.attnum;
+	reader->category = entry.category;
+	reader->nitems = entry.nitems;
+	return true;
+}
+
+/* binaryheap comparator of the current entries of two runs, smallest first */
+static int
+ginRunReaderCompare(Datum a, Datum b, void *arg)
+{
+	GinRunReader *ra = (GinRunReader *) DatumGetPointer(a);
+	GinRunReader *rb = (GinRunReader *) DatumGetPointer(b);
+
+	return -ginCompareAttEntries((GinState *) arg,
+								 ra->attnum, ra->key, ra->category,
+								 rb->attnum, rb->key, rb->category);
+}
+
 static void
 ginBuildCallback(Relation index, ItemPointer tid, Datum *values,
 				 bool *isnull, bool tupleIsAlive, void *state)
@@ -291,7 +609,7 @@ ginBuildCallback(Relation index, ItemPointer tid, Datum *values,
 							   values[i], isnull[i], tid);
 
 	/* If we've maxed out our available memory, dump everything to the index */
-	if (buildstate->accum.allocatedMemory >= (Size) maintenance_work_mem * 1024L)
+	if (buildstate->accum.allocatedMemory >= (Size) buildstate->workmem * 1024L)
 	{
 		ItemPointerData *list;
 		Datum		key;
@@ -299,6 +617,14 @@ ginBuildCallback(Relation index, ItemPointer tid, Datum *values,
 		uint32		nlist;
 		OffsetNumber attnum;
 
+		/* ... or, in a participant of a parallel build, to its next run */
+		if (buildstate->ginshared != NULL)
+		{
+			ginBuildWriteRun(buildstate);
+			MemoryContextSwitchTo(oldCtx);
+			return;
+		}
+
 		ginBeginBAScan(&buildstate->accum);
 		while ((list = ginGetBAEntry(&buildstate->accum,
 									 &attnum, &key, &category, &nlist)) != NULL)
@@ -335,9 +661,7 @@ ginbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 		elog(ERROR, "index \"%s\" already contains data",
 			 RelationGetRelationName(index));
 
-	initGinState(&buildstate.ginstate, index);
-	buildstate.indtuples = 0;
-	memset(&buildstate.buildStats, 0, sizeof(GinStatsData));
+	ginBuildStateInit(&buildstate, index, maintenance_work_mem);
 
 	/* initialize the meta page */
 	MetaBuffer = GinNewBuffer(index);
@@ -359,45 +683,45 @@ ginbuild(Relation heap, Relation index, IndexInfo *indexInfo)
 	/* count the root as first entry page */
 	buildstate.buildStats.nEntryPages++;
 
-	/*
-	 * create a temporary memory context that is used to hold data not yet
-	 * dumped out to the index
-	 */
-	buildstate.tmpCtx = AllocSetContextCreate(CurrentMemoryContext,
-											  "Gin build temporary context",
-											  ALLOCSET_DEFAULT_SIZES);
-
-	/*
-	 * create a temporary memory context that is used for calling
-	 * ginExtractEntries(), and can be reset after each tuple
-	 */
-	buildstate.funcCtx = AllocSetContextCreate(CurrentMemoryContext,
-											   "Gin build temporary context for user-defined function",
-											   ALLOCSET_DEFAULT_SIZES);
+	/* Attempt to launch parallel worker scan when required */
+	if (indexInfo->ii_ParallelWorkers > 0)
+		_gin_begin_parallel(&buildstate, heap, index, indexInfo->ii_Concurrent,
+							indexInfo->ii_ParallelWorkers);
 
-	buildstate.accum.ginstate = &buildstate.ginstate;
-	ginInitBA(&buildstate.accum);
-
-	/*
-	 * Do the heap scan.  We disallow sync scan here because dataPlaceToPage
-	 * prefers to receive tuples in TID order.
-	 */
-	reltuples = table_index_build_scan(heap, index, indexInfo, false, true,
-									   ginBuildCallback, (void *) &buildstate,
-									   NULL);
-
-	/* dump remaining entries to the index */
-	oldCtx = MemoryContextSwitchTo(buildstate.tmpCtx);
-	ginBeginBAScan(&buildstate.accum);
-	while ((list = ginGetBAEntry(&buildstate.accum,
-								 &attnum, &key, &category, &nlist)) != NULL)
+	if (buildstate.ginleader)
 	{
-		/* there could be many entries, so be willing to abort here */
-		CHECK_FOR_INTERRUPTS();
-		ginEntryInsert(&buildstate.ginstate, attnum, key, category,
-					   list, nlist, &buildstate.buildStats);
+		bool		brokenhotchain;
+
+		/* Wait for the participants' runs, and merge them into the index */
+		reltuples = _gin_parallel_heapscan(&buildstate, &brokenhotchain);
+		if (brokenhotchain)
+			indexInfo->ii_BrokenHotChain = true;
+		_gin_parallel_merge(&buildstate);
+		_gin_end_parallel(buildstate.ginleader);
+	}
+	else
+	{
+		/*
+		 * Do the heap scan.  We disallow sync scan here because
+		 * dataPlaceToPage prefers to receive tuples in TID order.
+		 */
+		reltuples = table_index_build_scan(heap, index, indexInfo, false, true,
+										   ginBuildCallback, (void *) &buildstate,
+										   NULL);
+
+		/* dump remaining entries to the index */
+		oldCtx = MemoryContextSwitchTo(buildstate.tmpCtx);
+		ginBeginBAScan(&buildstate.accum);
+		while ((list = ginGetBAEntry(&buildstate.accum,
+									 &attnum, &key, &category, &nlist)) != NULL)
+		{
+			/* there could be many entries, so be willing to abort here */
+			CHECK_FOR_INTERRUPTS();
+			ginEntryInsert(&buildstate.ginstate, attnum, key, category,
+						   list, nlist, &buildstate.buildStats);
+		}
+		MemoryContextSwitchTo(oldCtx);
 	}
-	MemoryContextSwitchTo(oldCtx);
 
 	MemoryContextDelete(buildstate.funcCtx);
 	MemoryContextDelete(buildstate.tmpCtx);
@@ -538,3 +862,515 @@ gininsert(Relation index, Datum *values, bool *isnull,
 
 	return false;
 }
+
+/*
+ * Create parallel context, and launch workers for leader, see GinShared.
+ *
+ * isconcurrent indicates if operation is CREATE INDEX CONCURRENTLY.
+ *
+ * request is the target number of parallel worker processes to launch.
+ *
+ * Sets buildstate's GinLeader, which caller must use to shut down parallel
+ * mode by passing it to _gin_end_parallel() at the very end of its index
+ * build.  If not even a single worker process can be launched, this is
+ * never set, and caller should proceed with a serial index build.
+ */
+static void
+_gin_begin_parallel(GinBuildState *buildstate, Relation heap, Relation index,
+					bool isconcurrent, int request)
+{
+	ParallelContext *pcxt;
+	int			nparticipants;
+	Snapshot	snapshot;
+	Size		estginshared;
+	GinShared  *ginshared;
+	int		   *nruns;
+	GinLeader  *ginleader = (GinLeader *) palloc0(sizeof(GinLeader));
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+	char	   *sharedquery;
+	int			querylen;
+
+	/*
+	 * Enter parallel mode, and create context for parallel build of gin
+	 * index
+	 */
+	EnterParallelMode();
+	Assert(request > 0);
+	pcxt = CreateParallelContext("postgres", "_gin_parallel_build_main",
+								 request);
+
+	/* The leader scans its share of the heap too */
+	nparticipants = request + 1;
+
+	/*
+	 * Prepare for scan of the base relation.  In a normal index build, we use
+	 * SnapshotAny because we must retrieve all tuples and do our own time
+	 * qual checks (because we have to index RECENTLY_DEAD tuples).  In a
+	 * concurrent build, we take a regular MVCC snapshot and index whatever's
+	 * live according to that.
+	 */
+	if (!isconcurrent)
+		snapshot = SnapshotAny;
+	else
+		snapshot = RegisterSnapshot(GetTransactionSnapshot());
+
+	/*
+	 * Estimate size for our own PARALLEL_KEY_GIN_SHARED workspace, and the
+	 * PARALLEL_KEY_GIN_RUNS run counts
+	 */
+	estginshared = _gin_parallel_estimate_shared(heap, snapshot);
+	shm_toc_estimate_chunk(&pcxt->estimator, estginshared);
+	shm_toc_estimate_chunk(&pcxt->estimator, mul_size(sizeof(int), nparticipants));
+	shm_toc_estimate_keys(&pcxt->estimator, 2);
+
+	/*
+	 * Estimate space for WalUsage and BufferUsage -- PARALLEL_KEY_WAL_USAGE
+	 * and PARALLEL_KEY_BUFFER_USAGE.
+	 */
+	shm_toc_estimate_chunk(&pcxt->estimator,
+						   mul_size(sizeof(WalUsage), pcxt->nworkers));
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+	shm_toc_estimate_chunk(&pcxt->estimator,
+						   mul_size(sizeof(BufferUsage), pcxt->nworkers));
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+
+	/* Finally, estimate PARALLEL_KEY_QUERY_TEXT space */
+	querylen = strlen(debug_query_string);
+	shm_toc_estimate_chunk(&pcxt->estimator, querylen + 1);
+	shm_toc_estimate_keys(&pcxt->estimator, 1);
+
+	/* Everyone's had a chance to ask for space, so now create the DSM */
+	InitializeParallelDSM(pcxt);
+
+	/* If no DSM segment was available, back out (do serial build) */
+	if (pcxt->seg == NULL)
+	{
+		if (IsMVCCSnapshot(snapshot))
+			UnregisterSnapshot(snapshot);
+		DestroyParallelContext(pcxt);
+		ExitParallelMode();
+		return;
+	}
+
+	/* Store shared build state, for which we reserved space */
+	ginshared = (GinShared *) shm_toc_allocate(pcxt->toc, estginshared);
+	/* Initialize immutable state */
+	ginshared->heaprelid = RelationGetRelid(heap);
+	ginshared->indexrelid = RelationGetRelid(index);
+	ginshared->isconcurrent = isconcurrent;
+	ginshared->nparticipants = nparticipants;
+	SharedFileSetInit(&ginshared->fileset, pcxt->seg);
+	ConditionVariableInit(&ginshared->workersdonecv);
+	SpinLockInit(&ginshared->mutex);
+	/* Initialize mutable state */
+	ginshared->nparticipantsdone = 0;
+	ginshared->reltuples = 0.0;
+	ginshared->indtuples = 0.0;
+	ginshared->brokenhotchain = false;
+	table_parallelscan_initialize(heap,
+								  ParallelTableScanFromGinShared(ginshared),
+								  snapshot);
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_GIN_SHARED, ginshared);
+
+	nruns = shm_toc_allocate(pcxt->toc, mul_size(sizeof(int), nparticipants));
+	memset(nruns, 0, sizeof(int) * nparticipants);
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_GIN_RUNS, nruns);
+
+	/* Store query string for workers */
+	sharedquery = (char *) shm_toc_allocate(pcxt->toc, querylen + 1);
+	memcpy(sharedquery, debug_query_string, querylen + 1);
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_QUERY_TEXT, sharedquery);
+
+	/*
+	 * Allocate space for each worker's WalUsage and BufferUsage; no need to
+	 * initialize.
+	 */
+	walusage = shm_toc_allocate(pcxt->toc,
+								mul_size(sizeof(WalUsage), pcxt->nworkers));
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_WAL_USAGE, walusage);
+	bufferusage = shm_toc_allocate(pcxt->toc,
+								   mul_size(sizeof(BufferUsage), pcxt->nworkers));
+	shm_toc_insert(pcxt->toc, PARALLEL_KEY_BUFFER_USAGE, bufferusage);
+
+	/* Launch workers, saving status for leader/caller */
+	LaunchParallelWorkers(pcxt);
+	ginleader->pcxt = pcxt;
+	ginleader->nparticipants = pcxt->nworkers_launched + 1;
+	ginleader->ginshared = ginshared;
+	ginleader->nruns = nruns;
+	ginleader->snapshot = snapshot;
+	ginleader->walusage = walusage;
+	ginleader->bufferusage = bufferusage;
+
+	/* If no workers were successfully launched, back out (do serial build) */
+	if (pcxt->nworkers_launched == 0)
+	{
+		_gin_end_parallel(ginleader);
+		return;
+	}
+
+	/* Save leader state now that it's clear build will be parallel */
+	buildstate->ginleader = ginleader;
+
+	/* Join heap scan ourselves */
+	_gin_leader_participate_as_worker(buildstate, heap, index);
+
+	/*
+	 * Caller needs to wait for all launched workers when we return.  Make
+	 * sure that the failure-to-start case will not hang forever.
+	 */
+	WaitForParallelWorkersToAttach(pcxt);
+}
+
+/*
+ * Shut down workers, destroy parallel context, and end parallel mode.  This
+ * also removes the runs.
+ */
+static void
+_gin_end_parallel(GinLeader *ginleader)
+{
+	int			i;
+
+	/* Shutdown worker processes */
+	WaitForParallelWorkersToFinish(ginleader->pcxt);
+
+	/*
+	 * Next, accumulate WAL usage.  (This must wait for the workers to finish,
+	 * or we might get incomplete data.)
+	 */
+	for (i = 0; i < ginleader->pcxt->nworkers_launched; i++)
+		InstrAccumParallelQuery(&ginleader->bufferusage[i], &ginleader->walusage[i]);
+
+	/* Free last reference to MVCC snapshot, if one was used */
+	if (IsMVCCSnapshot(ginleader->snapshot))
+		UnregisterSnapshot(ginleader->snapshot);
+	DestroyParallelContext(ginleader->pcxt);
+	ExitParallelMode();
+}
+
+/*
+ * Returns size of shared memory required to store state for a parallel
+ * gin index build based on the snapshot its parallel scan will use.
+ */
+static Size
+_gin_parallel_estimate_shared(Relation heap, Snapshot snapshot)
+{
+	/* c.f. shm_toc_allocate as to why BUFFERALIGN is used */
+	return add_size(BUFFERALIGN(sizeof(GinShared)),
+					table_parallelscan_estimate(heap, snapshot));
+}
+
+/*
+ * Within leader, wait for end of heap scan, which is when every participant
+ * has written all its runs.
+ *
+ * Fills in the number of entries for ambuild statistics, and lets caller set
+ * field indicating that some worker encountered a broken HOT chain.
+ *
+ * Returns the total number of heap tuples scanned.
+ */
+static double
+_gin_parallel_heapscan(GinBuildState *buildstate, bool *brokenhotchain)
+{
+	GinShared  *ginshared = buildstate->ginleader->ginshared;
+	int			nparticipants = buildstate->ginleader->nparticipants;
+	double		reltuples;
+
+	for (;;)
+	{
+		SpinLockAcquire(&ginshared->mutex);
+		if (ginshared->nparticipantsdone == nparticipants)
+		{
+			buildstate->indtuples = ginshared->indtuples;
+			*brokenhotchain = ginshared->brokenhotchain;
+			reltuples = ginshared->reltuples;
+			SpinLockRelease(&ginshared->mutex);
+			break;
+		}
+		SpinLockRelease(&ginshared->mutex);
+
+		ConditionVariableSleep(&ginshared->workersdonecv,
+							   WAIT_EVENT_PARALLEL_CREATE_INDEX_SCAN);
+	}
+
+	ConditionVariableCancelSleep();
+
+	return reltuples;
+}
+
+/*
+ * Within leader, merge the runs of all participants, and insert every key
+ * into the index with their union of its item pointers.  The item pointers
+ * of a key too common for them to fit in maintenance_work_mem are inserted
+ * in parts, which ginEntryInsert() adds to what's there.
+ */
+static void
+_gin_parallel_merge(GinBuildState *buildstate)
+{
+	GinLeader  *ginleader = buildstate->ginleader;
+	GinShared  *ginshared = ginleader->ginshared;
+	GinState   *ginstate = &buildstate->ginstate;
+	Size		maxitems = (Size) maintenance_work_mem * 1024L / sizeof(ItemPointerData);
+	MemoryContext runCtx;
+	MemoryContext oldCtx;
+	GinRunReader *readers;
+	binaryheap *heap;
+	int			nreaders = 0;
+	bool		havekey = false;
+	OffsetNumber attnum = InvalidOffsetNumber;
+	Datum		key = (Datum) 0;
+	GinNullCategory category = GIN_CAT_NORM_KEY;
+	ItemPointerData *items = NULL;
+	uint32		nitems = 0;
+
+	runCtx = AllocSetContextCreate(CurrentMemoryContext,
+								   "Gin build runs",
+								   ALLOCSET_DEFAULT_SIZES);
+	oldCtx = MemoryContextSwitchTo(runCtx);
+
+	/* Open every run, and start with the first entry of each */
+	for (int p = 0; p < ginshared->nparticipants; p++)
+		nreaders += ginleader->nruns[p];
+	readers = palloc0(sizeof(GinRunReader) * Max(nreaders, 1));
+	heap = binaryheap_allocate(Max(nreaders, 1), ginRunReaderCompare, ginstate);
+	nreaders = 0;
+	for (int p = 0; p < ginshared->nparticipants; p++)
+	{
+		for (int run = 0; run < ginleader->nruns[p]; run++)
+		{
+			GinRunReader *reader = &readers[nreaders++];
+			char		name[MAXPGPATH];
+
+			ginRunName(name, p, run);
+			reader->file = BufFileOpenShared(&ginshared->fileset, name);
+			reader->ctx = AllocSetContextCreate(runCtx,
+												"Gin build run entry",
+												ALLOCSET_SMALL_SIZES);
+			if (ginRunRead(reader))
+				binaryheap_add_unordered(heap, PointerGetDatum(reader));
+			else
+				BufFileClose(reader->file);
+		}
+	}
+	binaryheap_build(heap);
+
+	/* The key being merged and its item pointers live in tmpCtx */
+	MemoryContextSwitchTo(buildstate->tmpCtx);
+	while (!binaryheap_empty(heap))
+	{
+		GinRunReader *reader = (GinRunReader *) DatumGetPointer(binaryheap_first(heap));
+
+		/* there could be many entries, so be willing to abort here */
+		CHECK_FOR_INTERRUPTS();
+
+		if (!havekey ||
+			ginCompareAttEntries(ginstate, attnum, key, category,
+								 reader->attnum, reader->key,
+								 reader->category) != 0)
+		{
+			Form_pg_attribute att;
+
+			if (nitems > 0)
+				ginEntryInsert(ginstate, attnum, key, category,
+							   items, nitems, &buildstate->buildStats);
+			MemoryContextReset(buildstate->tmpCtx);
+
+			att = TupleDescAttr(ginstate->origTupdesc, reader->attnum - 1);
+			attnum = reader->attnum;
+			category = reader->category;
+			key = category == GIN_CAT_NORM_KEY ?
+				datumCopy(reader->key, att->attbyval, att->attlen) : (Datum) 0;
+			havekey = true;
+			items = NULL;
+			nitems = 0;
+		}
+
+		if (nitems == 0)
+		{
+			items = palloc(sizeof(ItemPointerData) * reader->nitems);
+			memcpy(items, reader->items, sizeof(ItemPointerData) * reader->nitems);
+			nitems = reader->nitems;
+		}
+		else
+		{
+			ItemPointerData *merged;
+			int			nmerged;
+
+			merged = ginMergeItemPointers(items, nitems,
+										  reader->items, reader->nitems,
+										  &nmerged);
+			pfree(items);
+			items = merged;
+			nitems = nmerged;
+		}
+
+		if (nitems >= maxitems)
+		{
+			ginEntryInsert(ginstate, attnum, key, category,
+						   items, nitems, &buildstate->buildStats);
+			pfree(items);
+			items = NULL;
+			nitems = 0;
+		}
+
+		if (ginRunRead(reader))
+			binaryheap_replace_first(heap, PointerGetDatum(reader));
+		else
+		{
+			binaryheap_remove_first(heap);
+			BufFileClose(reader->file);
+		}
+	}
+	if (nitems > 0)
+		ginEntryInsert(ginstate, attnum, key, category,
+					   items, nitems, &buildstate->buildStats);
+
+	MemoryContextSwitchTo(oldCtx);
+	MemoryContextReset(buildstate->tmpCtx);
+	MemoryContextDelete(runCtx);
+}
+
+/*
+ * Within leader, participate as a parallel worker.
+ */
+static void
+_gin_leader_participate_as_worker(GinBuildState *buildstate, Relation heap,
+								  Relation index)
+{
+	GinLeader  *ginleader = buildstate->ginleader;
+	GinBuildState leaderworker;
+
+	/*
+	 * Might as well use reliable figure when doling out maintenance_work_mem
+	 * (when requested number of workers were not launched, this will be
+	 * somewhat higher than it is for other workers).
+	 */
+	ginBuildStateInit(&leaderworker, index,
+					  maintenance_work_mem / ginleader->nparticipants);
+	leaderworker.participant = ginleader->ginshared->nparticipants - 1;
+
+	/* Perform work common to all participants */
+	_gin_parallel_scan_and_build(&leaderworker, ginleader->ginshared,
+								 ginleader->nruns, heap, index, true);
+
+	MemoryContextDelete(leaderworker.funcCtx);
+	MemoryContextDelete(leaderworker.tmpCtx);
+}
+
+/*
+ * Perform work within a launched parallel process.
+ */
+void
+_gin_parallel_build_main(dsm_segment *seg, shm_toc *toc)
+{
+	char	   *sharedquery;
+	GinShared  *ginshared;
+	int		   *nruns;
+	GinBuildState buildstate;
+	Relation	heapRel;
+	Relation	indexRel;
+	LOCKMODE	heapLockmode;
+	LOCKMODE	indexLockmode;
+	WalUsage   *walusage;
+	BufferUsage *bufferusage;
+
+	/* Set debug_query_string for individual workers first */
+	sharedquery = shm_toc_lookup(toc, PARALLEL_KEY_QUERY_TEXT, false);
+	debug_query_string = sharedquery;
+
+	/* Report the query string from leader */
+	pgstat_report_activity(STATE_RUNNING, debug_query_string);
+
+	/* Look up gin shared state */
+	ginshared = shm_toc_lookup(toc, PARALLEL_KEY_GIN_SHARED, false);
+	nruns = shm_toc_lookup(toc, PARALLEL_KEY_GIN_RUNS, false);
+
+	/* Open relations using lock modes known to be obtained by index.c */
+	if (!ginshared->isconcurrent)
+	{
+		heapLockmode = ShareLock;
+		indexLockmode = AccessExclusiveLock;
+	}
+	else
+	{
+		heapLockmode = ShareUpdateExclusiveLock;
+		indexLockmode = RowExclusiveLock;
+	}
+
+	/* Open relations within worker */
+	heapRel = table_open(ginshared->heaprelid, heapLockmode);
+	indexRel = index_open(ginshared->indexrelid, indexLockmode);
+
+	/* The runs are written to the leader's fileset */
+	SharedFileSetAttach(&ginshared->fileset, seg);
+
+	/* Prepare to track buffer usage during parallel execution */
+	InstrStartParallelQuery();
+
+	ginBuildStateInit(&buildstate, indexRel,
+					  maintenance_work_mem / ginshared->nparticipants);
+	buildstate.participant = ParallelWorkerNumber;
+	_gin_parallel_scan_and_build(&buildstate, ginshared, nruns,
+								 heapRel, indexRel, false);
+
+	/* Report WAL/buffer usage during parallel execution */
+	bufferusage = shm_toc_lookup(toc, PARALLEL_KEY_BUFFER_USAGE, false);
+	walusage = shm_toc_lookup(toc, PARALLEL_KEY_WAL_USAGE, false);
+	InstrEndParallelQuery(&bufferusage[ParallelWorkerNumber],
+						  &walusage[ParallelWorkerNumber]);
+
+	MemoryContextDelete(buildstate.funcCtx);
+	MemoryContextDelete(buildstate.tmpCtx);
+
+	index_close(indexRel, indexLockmode);
+	table_close(heapRel, heapLockmode);
+}
+
+/*
+ * Perform a participant's portion of a parallel build: scan its share of the
+ * heap, writing the accumulated entries out as runs.
+ *
+ * The parallel scan hands out runs of consecutive blocks, which its read
+ * stream fetches from the storage node a batch at a time, see
+ * heap_parallelscan_nextpage().
+ */
+static void
+_gin_parallel_scan_and_build(GinBuildState *buildstate, GinShared *ginshared,
+							 int *nruns, Relation heap, Relation index,
+							 bool progress)
+{
+	TableScanDesc scan;
+	double		reltuples;
+	IndexInfo  *indexInfo;
+
+	buildstate->ginshared = ginshared;
+
+	/* Join parallel scan */
+	indexInfo = BuildIndexInfo(index);
+	indexInfo->ii_Concurrent = ginshared->isconcurrent;
+	scan = table_beginscan_parallel(heap,
+									ParallelTableScanFromGinShared(ginshared));
+	reltuples = table_index_build_scan(heap, index, indexInfo, true, progress,
+									   ginBuildCallback,
+									   (void *) buildstate, scan);
+
+	/* Write the remaining entries as the last run */
+	ginBuildWriteRun(buildstate);
+
+	/*
+	 * Done.  Record ambuild statistics, our runs, and whether we encountered
+	 * a broken HOT chain.
+	 */
+	SpinLockAcquire(&ginshared->mutex);
+	ginshared->nparticipantsdone++;
+	ginshared->reltuples += reltuples;
+	ginshared->indtuples += buildstate->indtuples;
+	if (indexInfo->ii_BrokenHotChain)
+		ginshared->brokenhotchain = true;
+	nruns[buildstate->participant] = buildstate->nruns;
+	SpinLockRelease(&ginshared->mutex);
+
+	/* Notify leader */
+	ConditionVariableSignal(&ginshared->workersdonecv);
+}
@@ -298,6 +298,12 @@ initscan(HeapScanDesc scan, ScanKey key, bool keep_startblock)
 	scan->rs_numblocks = InvalidBlockNumber;
 	scan->rs_inited = false;
 	scan->rs_ctup.t_data = NULL;
+	scan->rs_stream_next = scan->rs_startblock;
+	/* A parallel scan names its blocks a chunk at a time */
+	scan->rs_stream_left = scan->rs_base.rs_parallel ? 0 : scan->rs_nblocks;
+	if (scan->rs_base.rs_read_stream != NULL &&
+		(scan->rs_base.rs_flags & SO_TYPE_SEQSCAN))
+		ReadStreamReset(scan->rs_base.rs_read_stream);
 	ItemPointerSetInvalid(&scan->rs_ctup.t_self);
 	scan->rs_cbuf = InvalidBuffer;
 	scan->rs_cblock = InvalidBlockNumber;
@@ -339,6 +345,63 @@ heap_setscanlimits(TableScanDesc sscan, BlockNumber startBlk, BlockNumber numBlk
 
 	scan->rs_startblock = startBlk;
 	scan->rs_numblocks = numBlks;
+
+	scan->rs_stream_next = startBlk;
+	if (numBlks != InvalidBlockNumber)
+		scan->rs_stream_left = Min(numBlks, scan->rs_nblocks);
+	if (scan->rs_base.rs_read_stream != NULL)
+		ReadStreamReset(scan->rs_base.rs_read_stream);
+}
+
+/*
+ * heap_scan_stream_next - names the blocks of a seqscan to its read stream
+ *
+ * The same blocks heapgettup() goes through forward, from rs_startblock and
+ * wrapping around at the end of the relation.
+ */
+static BlockNumber
+heap_scan_stream_next(void *callback_arg)
+{
+	HeapScanDesc scan = (HeapScanDesc) callback_arg;
+	BlockNumber block;
+
+	if (scan->rs_stream_left == 0 || scan->rs_stream_next >= scan->rs_nblocks)
+		return InvalidBlockNumber;
+
+	block = scan->rs_stream_next;
+	scan->rs_stream_left--;
+	if (++scan->rs_stream_next >= scan->rs_nblocks)
+		scan->rs_stream_next = 0;
+	return block;
+}
+
+/*
+ * heap_parallelscan_nextpage - the next block of a parallel scan
+ *
+ * The blocks come in chunks of consecutive ones, see
+ * table_block_parallelscan_nextpage().  At the start of each chunk all of
+ * its blocks are named to the scan's read stream, which then fetches them a
+ * batch at a time rather than one round trip per page.
+ */
+static BlockNumber
+heap_parallelscan_nextpage(HeapScanDesc scan)
+{
+	ParallelBlockTableScanDesc pbscan =
+	(ParallelBlockTableScanDesc) scan->rs_base.rs_parallel;
+	ParallelBlockTableScanWorker pbscanwork = scan->rs_parallelworkerdata;
+	BlockNumber page;
+
+	page = table_block_parallelscan_nextpage(scan->rs_base.rs_rd,
+											 pbscanwork, pbscan);
+	if (page != InvalidBlockNumber && scan->rs_base.rs_read_stream != NULL &&
+		pbscanwork->phsw_chunk_remaining == pbscanwork->phsw_chunk_size - 1)
+	{
+		scan->rs_stream_next = page;
+		scan->rs_stream_left = Min(pbscanwork->phsw_chunk_size,
+								   pbscan->phs_nblocks - pbscanwork->phsw_nallocated);
+		ReadStreamReset(scan->rs_base.rs_read_stream);
+	}
+	return page;
 }
 
 /*
@@ -378,8 +441,13 @@ heapgetpage(TableScanDesc sscan, BlockNumber page)
 	CHECK_FOR_INTERRUPTS();
 
 	/* read page using selected strategy */
-	scan->rs_cbuf = ReadBufferExtended(scan->rs_base.rs_rd, MAIN_FORKNUM, page,
-									   RBM_NORMAL, scan->rs_strategy);
+	if (scan->rs_base.rs_read_stream != NULL)
+		scan->rs_cbuf = ReadStreamReadBuffer(scan->rs_base.rs_read_stream,
+											 page, scan->rs_strategy);
+	else
+		scan->rs_cbuf = ReadBufferExtended(scan->rs_base.rs_rd, MAIN_FORKNUM,
+										   page, RBM_NORMAL,
+										   scan->rs_strategy);
 	scan->rs_cblock = page;
 
 	if (!(scan->rs_base.rs_flags & SO_ALLOW_PAGEMODE))
@@ -522,10 +590,10 @@ heapgettup(HeapScanDesc scan,
 				(ParallelBlockTableScanDesc) scan->rs_base.rs_parallel;
 
 				table_block_parallelscan_startblock_init(scan->rs_base.rs_rd,
+														 scan->rs_parallelworkerdata,
 														 pbscan);
 
-				page = table_block_parallelscan_nextpage(scan->rs_base.rs_rd,
-														 pbscan);
+				page = heap_parallelscan_nextpage(scan);
 
 				/* Other processes might have already finished the scan. */
 				if (page == InvalidBlockNumber)
@@ -718,11 +786,7 @@ heapgettup(HeapScanDesc scan,
 		}
 		else if (scan->rs_base.rs_parallel != NULL)
 		{
-			ParallelBlockTableScanDesc pbscan =
-			(ParallelBlockTableScanDesc) scan->rs_base.rs_parallel;
-
-			page = table_block_parallelscan_nextpage(scan->rs_base.rs_rd,
-													 pbscan);
+			page = heap_parallelscan_nextpage(scan);
 			finished = (page == InvalidBlockNumber);
 		}
 		else
@@ -836,10 +900,10 @@ heapgettup_pagemode(HeapScanDesc scan,
 				(ParallelBlockTableScanDesc) scan->rs_base.rs_parallel;
 
 				table_block_parallelscan_startblock_init(scan->rs_base.rs_rd,
+														 scan->rs_parallelworkerdata,
 														 pbscan);
 
-				page = table_block_parallelscan_nextpage(scan->rs_base.rs_rd,
-														 pbscan);
+				page = heap_parallelscan_nextpage(scan);
 
 				/* Other processes might have already finished the scan. */
 				if (page == InvalidBlockNumber)
@@ -1017,11 +1081,7 @@ heapgettup_pagemode(HeapScanDesc scan,
 		}
 		else if (scan->rs_base.rs_parallel != NULL)
 		{
-			ParallelBlockTableScanDesc pbscan =
-			(ParallelBlockTableScanDesc) scan->rs_base.rs_parallel;
-
-			page = table_block_parallelscan_nextpage(scan->rs_base.rs_rd,
-													 pbscan);
+			page = heap_parallelscan_nextpage(scan);
 			finished = (page == InvalidBlockNumber);
 		}
 		else
@@ -1157,6 +1217,24 @@ heap_beginscan(Relation relation, Snapshot snapshot,
 	scan->rs_base.rs_parallel = parallel_scan;
 	scan->rs_strategy = NULL;	/* set in initscan */
 
+	/* this backend's share of a parallel scan, set up at its start */
+	if (parallel_scan != NULL)
+		scan->rs_parallelworkerdata = palloc0(sizeof(ParallelBlockTableScanWorkerData));
+	else
+		scan->rs_parallelworkerdata = NULL;
+
+	/*
+	 * A seqscan knows its blocks ahead, let it read them in batches; a
+	 * parallel one those of the chunk it got.  The stream of a bitmap scan
+	 * is set up by its executor node, which is the one knowing the blocks.
+	 */
+	if (flags & SO_TYPE_SEQSCAN)
+		scan->rs_base.rs_read_stream = ReadStreamBegin(relation, MAIN_FORKNUM,
+													   heap_scan_stream_next,
+													   scan);
+	else
+		scan->rs_base.rs_read_stream = NULL;
+
 	/*
 	 * Disable page-at-a-time mode if it's not a MVCC-safe snapshot.
 	 */
@@ -1265,6 +1343,13 @@ heap_endscan(TableScanDesc sscan)
 	if (scan->rs_strategy != NULL)
 		FreeAccessStrategy(scan->rs_strategy);
 
+	if (scan->rs_parallelworkerdata != NULL)
+		pfree(scan->rs_parallelworkerdata);
+
+	if (scan->rs_base.rs_read_stream != NULL &&
+		(scan->rs_base.rs_flags & SO_TYPE_SEQSCAN))
+		ReadStreamEnd(scan->rs_base.rs_read_stream);
+
 	if (scan->rs_base.rs_flags & SO_TEMP_SNAPSHOT)
 		UnregisterSnapshot(scan->rs_base.rs_snapshot);
 
@@ -1340,6 +1425,52 @@ heap_getnextslot(TableScanDesc sscan, ScanDirection direction, TupleTableSlot *s
 	return true;
 }
 
+/*
+ *	heap_getnextbatch	- retrieve the rest of the current page's tuples
+ *
+ * Fills tuples, which must have room for MaxHeapTuplesPerPage, with the
+ * visible tuples from the next one to the end of its page, and returns how
+ * many there are, 0 at the end of the scan. They point into *buffer, which
+ * the scan keeps pinned until its next call. Only for forward scans in
+ * page-at-a-time mode and without scan keys; the next call, or
+ * heap_getnextslot, moves on to the next page.
+ */
+int
+heap_getnextbatch(TableScanDesc sscan, HeapTuple tuples, Buffer *buffer)
+{
+	HeapScanDesc scan = (HeapScanDesc) sscan;
+	Page		dp;
+	int			ntuples = 0;
+
+	Assert(sscan->rs_flags & SO_ALLOW_PAGEMODE);
+	Assert(sscan->rs_nkeys == 0);
+
+	heapgettup_pagemode(scan, ForwardScanDirection, 0, NULL);
+	if (scan->rs_ctup.t_data == NULL)
+		return 0;
+
+	dp = BufferGetPage(scan->rs_cbuf);
+	for (int lineindex = scan->rs_cindex; lineindex < scan->rs_ntuples; lineindex++)
+	{
+		OffsetNumber lineoff = scan->rs_vistuples[lineindex];
+		ItemId		lpp = PageGetItemId(dp, lineoff);
+		HeapTuple	tuple = &tuples[ntuples++];
+
+		Assert(ItemIdIsNormal(lpp));
+		tuple->t_data = (HeapTupleHeader) PageGetItem((Page) dp, lpp);
+		tuple->t_len = ItemIdGetLength(lpp);
+		tuple->t_tableOid = RelationGetRelid(sscan->rs_rd);
+		ItemPointerSet(&(tuple->t_self), scan->rs_cblock, lineoff);
+	}
+	scan->rs_cindex = scan->rs_ntuples - 1;
+
+	if (sscan->rs_rd->pgstat_info != NULL)
+		sscan->rs_rd->pgstat_info->t_counts.t_tuples_returned += ntuples;
+
+	*buffer = scan->rs_cbuf;
+	return ntuples;
+}
+
 /*
  *	heap_fetch		- retrieve tuple with given tid
  *
@@ -2017,8 +2148,9 @@ heap_prepare_insert(Relation relation, HeapTuple tup, TransactionId xid,
 	 * performed in workers. We have the infrastructure to allow parallel
 	 * inserts in general except for the cases where inserts generate a new
 	 * CommandId (eg. inserts into a table having a foreign key column).
+	 * Callers that have ruled those out say so with HEAP_INSERT_PARALLEL.
 	 */
-	if (IsParallelWorker())
+	if (IsParallelWorker() && !(options & HEAP_INSERT_PARALLEL))
 		ereport(ERROR,
 				(errcode(ERRCODE_INVALID_TRANSACTION_STATE),
 				 errmsg("cannot insert tuples in a parallel worker")));
@@ -2104,9 +2104,16 @@ heapam_scan_bitmap_next_block(TableScanDesc scan,
 	/*
 	 * Acquire pin on the target heap page, trading in any pin we held before.
 	 */
-	hscan->rs_cbuf = ReleaseAndReadBuffer(hscan->rs_cbuf,
-										  scan->rs_rd,
-										  page);
+	if (scan->rs_read_stream != NULL)
+	{
+		if (BufferIsValid(hscan->rs_cbuf))
+			ReleaseBuffer(hscan->rs_cbuf);
+		hscan->rs_cbuf = ReadStreamReadBuffer(scan->rs_read_stream, page, NULL);
+	}
+	else
+		hscan->rs_cbuf = ReleaseAndReadBuffer(hscan->rs_cbuf,
+											  scan->rs_rd,
+											  page);
 	hscan->rs_cblock = page;
 	buffer = hscan->rs_cbuf;
 	snapshot = scan->rs_snapshot;
@@ -30,7 +30,31 @@
 #include "access/heaptoast.h"
 #include "access/toast_helper.h"
 #include "access/toast_internals.h"
+#include "storage/bufmgr.h"
 #include "utils/fmgroids.h"
+#include "utils/rel.h"
+
+extern int	IsRpcClient;
+
+/* GUC: fetch the toast heap pages of a value together on a compute node */
+bool		rpc_toast_prefetch = true;
+
+/*
+ * On a compute node every toast heap page the chunk scan misses on is a
+ * round trip to the storage node, one chunk page after the other.  When a
+ * slice spans more than a page of chunks, the toast index is scanned for
+ * the TIDs first, and the heap pages they are on are then fetched a batch at
+ * a time, the next batch once the chunks get to the last page of the one
+ * before; see PrefetchBufferBlocks().  The blocks of a batch are distinct.
+ */
+typedef struct ToastPrefetch
+{
+	BlockNumber *blocks;		/* heap blocks of the chunks, in chunk order */
+	int			nblocks;
+	int			maxblocks;		/* allocated size of blocks */
+	int			pos;			/* block of the chunk read last */
+	int			prefetched;		/* blocks prefetched so far */
+} ToastPrefetch;
 
 
 /* ----------
@@ -612,6 +636,84 @@ toast_build_flattened_tuple(TupleDesc tupleDesc,
 	return new_tuple;
 }
 
+/*
+ * Collect the heap blocks of the chunks the index scan will return, and
+ * fetch the first batch of them.  The scan keys are the ones the chunk scan
+ * was begun with, systable_beginscan_ordered() has made them index keys.
+ */
+static void
+toast_prefetch_begin(ToastPrefetch *prefetch, Relation toastrel,
+					 Relation toastidx, Snapshot snapshot, ScanKey keys,
+					 int nkeys, int nchunks)
+{
+	IndexScanDesc scan;
+	ItemPointer tid;
+
+	prefetch->maxblocks = nchunks / EXTERN_TUPLES_PER_PAGE + 1;
+	prefetch->blocks = palloc(sizeof(BlockNumber) * prefetch->maxblocks);
+	prefetch->nblocks = 0;
+	prefetch->pos = 0;
+	prefetch->prefetched = 0;
+
+	scan = index_beginscan(toastrel, toastidx, snapshot, nkeys, 0);
+	index_rescan(scan, keys, nkeys, NULL, 0);
+	while ((tid = index_getnext_tid(scan, ForwardScanDirection)) != NULL)
+	{
+		BlockNumber block = ItemPointerGetBlockNumber(tid);
+		int			i;
+
+		/* Distinct within the batch the block falls into */
+		for (i = prefetch->nblocks - prefetch->nblocks % RPC_READ_BATCH_SIZE;
+			 i < prefetch->nblocks; i++)
+			if (prefetch->blocks[i] == block)
+				break;
+		if (i < prefetch->nblocks)
+			continue;
+
+		if (prefetch->nblocks == prefetch->maxblocks)
+		{
+			prefetch->maxblocks *= 2;
+			prefetch->blocks = repalloc(prefetch->blocks,
+										sizeof(BlockNumber) * prefetch->maxblocks);
+		}
+		prefetch->blocks[prefetch->nblocks++] = block;
+	}
+	index_endscan(scan);
+
+	prefetch->prefetched = PrefetchBufferBlocks(toastrel, MAIN_FORKNUM,
+												prefetch->blocks,
+												prefetch->nblocks);
+}
+
+/*
+ * Note that the chunk just read is on block, and fetch the next batch once
+ * the chunks have got to the last block of the batch before.
+ */
+static void
+toast_prefetch_advance(ToastPrefetch *prefetch, Relation toastrel,
+					   BlockNumber block)
+{
+	int			end = Min(prefetch->nblocks,
+						  prefetch->prefetched + RPC_READ_BATCH_SIZE);
+	int			i;
+
+	for (i = prefetch->pos; i < end; i++)
+	{
+		if (prefetch->blocks[i] == block)
+		{
+			prefetch->pos = i;
+			break;
+		}
+	}
+
+	if (prefetch->pos >= prefetch->prefetched - 1 &&
+		prefetch->prefetched < prefetch->nblocks)
+		prefetch->prefetched +=
+			PrefetchBufferBlocks(toastrel, MAIN_FORKNUM,
+								 prefetch->blocks + prefetch->prefetched,
+								 prefetch->nblocks - prefetch->prefetched);
+}
+
 /*
  * Fetch a TOAST slice from a heap table.
  *
@@ -640,6 +742,8 @@ heap_fetch_toast_slice(Relation toastrel, Oid valueid, int32 attrsize,
 	int			num_indexes;
 	int			validIndex;
 	SnapshotData SnapshotToast;
+	ToastPrefetch prefetch;
+	bool		prefetching;
 
 	/* Look for the valid index of toast relation */
 	validIndex = toast_open_indexes(toastrel,
@@ -689,6 +793,14 @@ heap_fetch_toast_slice(Relation toastrel, Oid valueid, int32 attrsize,
 	toastscan = systable_beginscan_ordered(toastrel, toastidxs[validIndex],
 										   &SnapshotToast, nscankeys, toastkey);
 
+	prefetching = IsRpcClient && rpc_toast_prefetch &&
+		endchunk - startchunk + 1 > EXTERN_TUPLES_PER_PAGE &&
+		!RelationUsesLocalBuffers(toastrel);
+	if (prefetching)
+		toast_prefetch_begin(&prefetch, toastrel, toastidxs[validIndex],
+							 &SnapshotToast, toastkey, nscankeys,
+							 endchunk - startchunk + 1);
+
 	/*
 	 * Read the chunks by index
 	 *
@@ -706,6 +818,10 @@ heap_fetch_toast_slice(Relation toastrel, Oid valueid, int32 attrsize,
 		int32		chcpystrt;
 		int32		chcpyend;
 
+		if (prefetching)
+			toast_prefetch_advance(&prefetch, toastrel,
+								   ItemPointerGetBlockNumber(&ttup->t_self));
+
 		/*
 		 * Have a chunk, extract the sequence number and the data
 		 */
@@ -790,4 +906,6 @@ heap_fetch_toast_slice(Relation toastrel, Oid valueid, int32 attrsize,
 	/* End scan and close indexes. */
 	systable_endscan_ordered(toastscan);
 	toast_close_indexes(toastidxs, num_indexes, AccessShareLock);
+	if (prefetching)
+		pfree(prefetch.blocks);
 }
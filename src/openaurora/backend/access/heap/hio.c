@@ -24,6 +24,12 @@
 #include "storage/lmgr.h"
 #include "storage/smgr.h"
 
+/*
+ * Blocks a parallel COPY worker adds beyond its own whenever it extends the
+ * relation.  Its siblings are sure to need them soon.
+ */
+#define PARALLEL_INSERT_EXTRA_BLOCKS	64
+
 
 /*
  * RelationPutHeapTuple - place tuple at specified page
@@ -180,19 +186,21 @@ GetVisibilityMapPins(Relation relation, Buffer buffer1, Buffer buffer2,
  * Extend a relation by multiple blocks to avoid future contention on the
  * relation extension lock.  Our goal is to pre-extend the relation by an
  * amount which ramps up as the degree of contention ramps up, but limiting
- * the result to some sane overall value.
+ * the result to some sane overall value.  We add at least minBlocks however
+ * little contention there is.
  */
 static void
-RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
+RelationAddExtraBlocks(Relation relation, BulkInsertState bistate,
+					   int minBlocks)
 {
 	BlockNumber blockNum,
-				firstBlock = InvalidBlockNumber;
+				firstBlock;
 	int			extraBlocks;
 	int			lockWaiters;
 
 	/* Use the length of the lock wait queue to judge how much to extend. */
 	lockWaiters = RelationExtensionLockWaiterCount(relation);
-	if (lockWaiters <= 0)
+	if (lockWaiters <= 0 && minBlocks <= 0)
 		return;
 
 	/*
@@ -201,21 +209,32 @@ RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
 	 * were insufficient.  512 is just an arbitrary cap to prevent
 	 * pathological results.
 	 */
-	extraBlocks = Min(512, lockWaiters * 20);
+	extraBlocks = Max(minBlocks, Min(512, lockWaiters * 20));
+
+	/*
+	 * Extend the relation by all of the pages at once; with the rpc storage
+	 * manager that is a single round trip to the storage node instead of one
+	 * per page.  We hold the extension lock, so nobody else can take these
+	 * block numbers, and reading them with RBM_ZERO_AND_LOCK below just
+	 * hands us zeroed buffers for them.
+	 */
+	RelationOpenSmgr(relation);
+	firstBlock = smgrnblocks(relation->rd_smgr, MAIN_FORKNUM);
+	smgrzeroextend(relation->rd_smgr, MAIN_FORKNUM, firstBlock, extraBlocks, false);
 
-	do
+	for (blockNum = firstBlock; blockNum < firstBlock + extraBlocks; blockNum++)
 	{
 		Buffer		buffer;
 		Page		page;
 		Size		freespace;
 
 		/*
-		 * Extend by one page.  This should generally match the main-line
-		 * extension code in RelationGetBufferForTuple, except that we hold
-		 * the relation extension lock throughout, and we don't immediately
-		 * initialize the page (see below).
+		 * Get a buffer for the next new page.  This should generally match
+		 * the main-line extension code in RelationGetBufferForTuple, except
+		 * that we hold the relation extension lock throughout, and we don't
+		 * immediately initialize the page (see below).
 		 */
-		buffer = ReadBufferBI(relation, P_NEW, RBM_ZERO_AND_LOCK, bistate);
+		buffer = ReadBufferBI(relation, blockNum, RBM_ZERO_AND_LOCK, bistate);
 		page = BufferGetPage(buffer);
 
 		if (!PageIsNew(page))
@@ -233,15 +252,10 @@ RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
 		 */
 
 		/* we'll need this info below */
-		blockNum = BufferGetBlockNumber(buffer);
 		freespace = BufferGetPageSize(buffer) - SizeOfPageHeaderData;
 
 		UnlockReleaseBuffer(buffer);
 
-		/* Remember first block number thus added. */
-		if (firstBlock == InvalidBlockNumber)
-			firstBlock = blockNum;
-
 		/*
 		 * Immediately update the bottom level of the FSM.  This has a good
 		 * chance of making this page visible to other concurrently inserting
@@ -249,7 +263,6 @@ RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
 		 */
 		RecordPageWithFreeSpace(relation, blockNum, freespace);
 	}
-	while (--extraBlocks > 0);
 
 	/*
 	 * Updating the upper levels of the free space map is too expensive to do
@@ -257,7 +270,7 @@ RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
 	 * subsequent insertion activity sees all of those nifty free pages we
 	 * just inserted.
 	 */
-	FreeSpaceMapVacuumRange(relation, firstBlock, blockNum + 1);
+	FreeSpaceMapVacuumRange(relation, firstBlock, firstBlock + extraBlocks);
 }
 
 /*
@@ -554,6 +567,9 @@ loop:
 	 */
 	if (needLock)
 	{
+		int			minExtraBlocks = (options & HEAP_INSERT_PARALLEL) ?
+		PARALLEL_INSERT_EXTRA_BLOCKS : 0;
+
 		if (!use_fsm)
 			LockRelationForExtension(relation, ExclusiveLock);
 		else if (!ConditionalLockRelationForExtension(relation, ExclusiveLock))
@@ -578,7 +594,15 @@ loop:
 			}
 
 			/* Time to bulk-extend. */
-			RelationAddExtraBlocks(relation, bistate);
+			RelationAddExtraBlocks(relation, bistate, minExtraBlocks);
+		}
+		else if (minExtraBlocks > 0)
+		{
+			/*
+			 * The workers of a parallel insert would soon be queueing for the
+			 * lock anyway; extend for them before they do.
+			 */
+			RelationAddExtraBlocks(relation, bistate, minExtraBlocks);
 		}
 	}
 
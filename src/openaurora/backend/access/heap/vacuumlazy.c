@@ -74,12 +74,20 @@
 #include "storage/bufmgr.h"
 #include "storage/freespace.h"
 #include "storage/lmgr.h"
+#include "storage/rpc_vacuum.h"
+#include "storage/rpcclient.h"
+#include "storage/shard_map.h"
 #include "tcop/tcopprot.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/pg_rusage.h"
 #include "utils/timestamp.h"
 
+extern int	IsRpcClient;
+
+/* GUC: whether the storage node triages the pages of the first heap pass */
+bool		rpc_vacuum_triage = true;
+
 
 /*
  * Space/time tradeoff parameters: do these need to be user-tunable?
@@ -130,6 +138,12 @@
  */
 #define PREFETCH_SIZE			((BlockNumber) 32)
 
+/*
+ * Most dead line pointers of the pages of one TriageVacuum call, at least
+ * those of a page so that every call gets somewhere.
+ */
+#define VACUUM_TRIAGE_MAX_DEAD	(4 * MaxHeapTuplesPerPage)
+
 /*
  * DSM keys for parallel vacuum.  Unlike other parallel execution code, since
  * we don't need to worry about DSM keys conflicting with plan_node_id we can
@@ -319,6 +333,40 @@ typedef struct LVRelStats
 	VacErrPhase phase;
 } LVRelStats;
 
+/*
+ * State of the callbacks naming the blocks each pass over the heap reads to
+ * its read stream.
+ */
+typedef struct LVStreamState
+{
+	Relation	onerel;
+	BlockNumber nblocks;
+	BlockNumber next;			/* next block to consider */
+	BlockNumber read_until;		/* blocks below are named unchecked */
+	bool		skip_pages;		/* skip all-visible (or all-frozen) runs */
+	bool		aggressive;
+	Buffer		vmbuffer;
+	LVDeadTuples *dead_tuples;	/* second pass only */
+	int			tupindex;
+
+	/*
+	 * First pass: the pages the storage node found need no read, of blocks
+	 * below triage_end, see storage/rpc_vacuum.h.  The scan has got to
+	 * entry_pos, the callback to stream_pos.
+	 */
+	bool		triage;
+	bool		flushed;		/* our WAL is on the storage node */
+	BlockNumber triage_end;
+	int			max_dead;
+	RpcVacuumEntry *entries;	/* room for 2 * RPC_VACUUM_TRIAGE_BLOCKS */
+	int			nentries;
+	int			entry_pos;
+	int			stream_pos;
+	uint16	   *dead;			/* their dead offsets, room for 2 * max_dead */
+	int			ndead;
+	int			dead_pos;		/* of the entry at entry_pos */
+} LVStreamState;
+
 /* Struct for saving and restoring vacuum error information. */
 typedef struct LVSavedErrInfo
 {
@@ -341,6 +389,13 @@ static void lazy_scan_heap(Relation onerel, VacuumParams *params,
 						   LVRelStats *vacrelstats, Relation *Irel, int nindexes,
 						   bool aggressive);
 static void lazy_vacuum_heap(Relation onerel, LVRelStats *vacrelstats);
+static BlockNumber lazy_scan_stream_next(void *callback_arg);
+static bool lazy_stream_skippable(LVStreamState *state, BlockNumber blkno);
+static void lazy_triage_fetch(LVStreamState *state, BlockNumber blkno);
+static RpcVacuumEntry *lazy_triage_entry(LVStreamState *state, BlockNumber blkno,
+										 uint16 **dead);
+static bool lazy_stream_triaged(LVStreamState *state, BlockNumber blkno);
+static BlockNumber lazy_vacuum_stream_next(void *callback_arg);
 static bool lazy_check_needs_freeze(Buffer buf, bool *hastup);
 static void lazy_vacuum_all_indexes(Relation onerel, Relation *Irel,
 									IndexBulkDeleteResult **stats,
@@ -779,6 +834,8 @@ lazy_scan_heap(Relation onerel, VacuumParams *params, LVRelStats *vacrelstats,
 	Buffer		vmbuffer = InvalidBuffer;
 	BlockNumber next_unskippable_block;
 	bool		skipping_blocks;
+	LVStreamState stream_state;
+	ReadStream *stream;
 	xl_heap_freeze_tuple *frozen;
 	StringInfoData buf;
 	const int	initprog_index[] = {
@@ -853,6 +910,33 @@ lazy_scan_heap(Relation onerel, VacuumParams *params, LVRelStats *vacrelstats,
 	dead_tuples = vacrelstats->dead_tuples;
 	frozen = palloc(sizeof(xl_heap_freeze_tuple) * MaxHeapTuplesPerPage);
 
+	memset(&stream_state, 0, sizeof(stream_state));
+	stream_state.onerel = onerel;
+	stream_state.nblocks = nblocks;
+	stream_state.skip_pages =
+		(params->options & VACOPT_DISABLE_PAGE_SKIPPING) == 0;
+	stream_state.aggressive = aggressive;
+	stream_state.vmbuffer = InvalidBuffer;
+	stream = ReadStreamBegin(onerel, MAIN_FORKNUM, lazy_scan_stream_next,
+							 &stream_state);
+
+	/*
+	 * On a compute node, have the storage node tell the pages that need no
+	 * read.  The dead line pointers it finds are only collected for the
+	 * index vacuum; without one, the pages holding them are read.
+	 */
+	stream_state.triage = stream != NULL && IsRpcClient && rpc_vacuum_triage &&
+		!ShardMapActive() &&
+		onerel->rd_rel->relpersistence == RELPERSISTENCE_PERMANENT;
+	if (stream_state.triage)
+	{
+		stream_state.max_dead = vacrelstats->useindex ? VACUUM_TRIAGE_MAX_DEAD : 0;
+		stream_state.entries = (RpcVacuumEntry *)
+			palloc(sizeof(RpcVacuumEntry) * 2 * RPC_VACUUM_TRIAGE_BLOCKS);
+		stream_state.dead = (uint16 *)
+			palloc(sizeof(uint16) * 2 * Max(stream_state.max_dead, 1));
+	}
+
 	/* Report that we're scanning the heap, advertising total # of blocks */
 	initprog_val[0] = PROGRESS_VACUUM_PHASE_SCAN_HEAP;
 	initprog_val[1] = nblocks;
@@ -1078,6 +1162,47 @@ lazy_scan_heap(Relation onerel, VacuumParams *params, LVRelStats *vacrelstats,
 										 PROGRESS_VACUUM_PHASE_SCAN_HEAP);
 		}
 
+		/*
+		 * The storage node may have found that the page needs no pruning,
+		 * freezing or visibility map change, and then sent what we'd count
+		 * on it.  There's room left for its dead tuples now.  We still read
+		 * the last page, and those the visibility map says are all-visible,
+		 * to check the two agree.
+		 */
+		if (stream_state.triage && !all_visible_according_to_vm &&
+			blkno < nblocks - 1)
+		{
+			RpcVacuumEntry *entry;
+			uint16	   *dead;
+
+			if (stream_state.triage_end < nblocks - 1 &&
+				blkno + RPC_VACUUM_TRIAGE_BLOCKS / 2 >= stream_state.triage_end)
+				lazy_triage_fetch(&stream_state, blkno);
+			entry = lazy_triage_entry(&stream_state, blkno, &dead);
+			if (stream_state.triage && entry != NULL)
+			{
+				vacrelstats->scanned_pages++;
+				vacrelstats->tupcount_pages++;
+				num_tuples += entry->ntuples;
+				live_tuples += entry->nlive;
+				nkeep += entry->ntuples - entry->nlive;
+				nunused += entry->nunused;
+				for (i = 0; i < entry->ndead; i++)
+				{
+					ItemPointerData itemptr;
+
+					ItemPointerSet(&itemptr, blkno, dead[i]);
+					lazy_record_dead_tuple(dead_tuples, &itemptr);
+				}
+				if (entry->hastup)
+					vacrelstats->nonempty_pages = blkno + 1;
+				/* As below, the second heap pass records the others */
+				if (entry->ndead == 0)
+					RecordPageWithFreeSpace(onerel, blkno, entry->freespace);
+				continue;
+			}
+		}
+
 		/*
 		 * Pin the visibility map page in case we need to mark the page
 		 * all-visible.  In most cases this will be very cheap, because we'll
@@ -1089,8 +1214,11 @@ lazy_scan_heap(Relation onerel, VacuumParams *params, LVRelStats *vacrelstats,
 		 */
 		visibilitymap_pin(onerel, blkno, &vmbuffer);
 
-		buf = ReadBufferExtended(onerel, MAIN_FORKNUM, blkno,
-								 RBM_NORMAL, vac_strategy);
+		if (stream != NULL)
+			buf = ReadStreamReadBuffer(stream, blkno, vac_strategy);
+		else
+			buf = ReadBufferExtended(onerel, MAIN_FORKNUM, blkno,
+									 RBM_NORMAL, vac_strategy);
 
 		/* We need buffer cleanup lock so that we can prune HOT chains. */
 		if (!ConditionalLockBufferForCleanup(buf))
@@ -1682,6 +1810,15 @@ lazy_scan_heap(Relation onerel, VacuumParams *params, LVRelStats *vacrelstats,
 		ReleaseBuffer(vmbuffer);
 		vmbuffer = InvalidBuffer;
 	}
+	if (stream != NULL)
+		ReadStreamEnd(stream);
+	if (BufferIsValid(stream_state.vmbuffer))
+		ReleaseBuffer(stream_state.vmbuffer);
+	if (stream_state.entries != NULL)
+	{
+		pfree(stream_state.entries);
+		pfree(stream_state.dead);
+	}
 
 	/* If any tuples need to be deleted, perform final vacuum cycle */
 	/* XXX put a threshold on min number of tuples here? */
@@ -1831,6 +1968,8 @@ lazy_vacuum_heap(Relation onerel, LVRelStats *vacrelstats)
 	PGRUsage	ru0;
 	Buffer		vmbuffer = InvalidBuffer;
 	LVSavedErrInfo saved_err_info;
+	LVStreamState stream_state;
+	ReadStream *stream;
 
 	/* Report that we are now vacuuming the heap */
 	pgstat_progress_update_param(PROGRESS_VACUUM_PHASE,
@@ -1843,6 +1982,11 @@ lazy_vacuum_heap(Relation onerel, LVRelStats *vacrelstats)
 	pg_rusage_init(&ru0);
 	npages = 0;
 
+	memset(&stream_state, 0, sizeof(stream_state));
+	stream_state.dead_tuples = vacrelstats->dead_tuples;
+	stream = ReadStreamBegin(onerel, MAIN_FORKNUM, lazy_vacuum_stream_next,
+							 &stream_state);
+
 	tupindex = 0;
 	while (tupindex < vacrelstats->dead_tuples->num_tuples)
 	{
@@ -1855,8 +1999,11 @@ lazy_vacuum_heap(Relation onerel, LVRelStats *vacrelstats)
 
 		tblk = ItemPointerGetBlockNumber(&vacrelstats->dead_tuples->itemptrs[tupindex]);
 		vacrelstats->blkno = tblk;
-		buf = ReadBufferExtended(onerel, MAIN_FORKNUM, tblk, RBM_NORMAL,
-								 vac_strategy);
+		if (stream != NULL)
+			buf = ReadStreamReadBuffer(stream, tblk, vac_strategy);
+		else
+			buf = ReadBufferExtended(onerel, MAIN_FORKNUM, tblk, RBM_NORMAL,
+									 vac_strategy);
 		if (!ConditionalLockBufferForCleanup(buf))
 		{
 			ReleaseBuffer(buf);
@@ -1878,6 +2025,9 @@ lazy_vacuum_heap(Relation onerel, LVRelStats *vacrelstats)
 	/* Clear the block number information */
 	vacrelstats->blkno = InvalidBlockNumber;
 
+	if (stream != NULL)
+		ReadStreamEnd(stream);
+
 	if (BufferIsValid(vmbuffer))
 	{
 		ReleaseBuffer(vmbuffer);
@@ -1894,6 +2044,194 @@ lazy_vacuum_heap(Relation onerel, LVRelStats *vacrelstats)
 	restore_vacuum_error_info(vacrelstats, &saved_err_info);
 }
 
+/*
+ *	lazy_scan_stream_next() -- name the next block lazy_scan_heap will read
+ *
+ *		Like lazy_scan_heap, this leaves out runs of at least
+ *		SKIP_PAGES_THRESHOLD skippable pages, but never the last page.  The
+ *		visibility map may change meanwhile, then a block is read that wasn't
+ *		named or one named isn't read, which only costs the batching.
+ */
+static BlockNumber
+lazy_scan_stream_next(void *callback_arg)
+{
+	LVStreamState *state = (LVStreamState *) callback_arg;
+
+	while (state->next < state->nblocks)
+	{
+		BlockNumber run_end;
+
+		/* The storage node found it needs no read */
+		if (lazy_stream_triaged(state, state->next))
+		{
+			state->next++;
+			continue;
+		}
+
+		if (!state->skip_pages || state->next < state->read_until ||
+			state->next == state->nblocks - 1 ||
+			!lazy_stream_skippable(state, state->next))
+			return state->next++;
+
+		run_end = state->next + 1;
+		while (run_end < state->nblocks - 1 &&
+			   run_end - state->next < SKIP_PAGES_THRESHOLD &&
+			   lazy_stream_skippable(state, run_end))
+			run_end++;
+
+		if (run_end - state->next < SKIP_PAGES_THRESHOLD)
+		{
+			/* Too short a run to be skipped */
+			state->read_until = run_end;
+			return state->next++;
+		}
+		state->next = run_end;
+	}
+
+	return InvalidBlockNumber;
+}
+
+static bool
+lazy_stream_skippable(LVStreamState *state, BlockNumber blkno)
+{
+	uint8		vmstatus;
+
+	vmstatus = visibilitymap_get_status(state->onerel, blkno,
+										&state->vmbuffer);
+	if (state->aggressive)
+		return (vmstatus & VISIBILITYMAP_ALL_FROZEN) != 0;
+	return (vmstatus & VISIBILITYMAP_ALL_VISIBLE) != 0;
+}
+
+/*
+ *	lazy_triage_fetch() -- have the storage node triage the blocks ahead
+ *
+ *		The blocks from blkno on, or from where the last call got to, up to
+ *		the last page, which is always read.  The entries of the blocks the
+ *		scan is past are dropped first.  If the storage node can't, the scan
+ *		reads every page from here on.
+ */
+static void
+lazy_triage_fetch(LVStreamState *state, BlockNumber blkno)
+{
+	Relation	onerel = state->onerel;
+	BlockNumber start = Max(state->triage_end, blkno);
+	BlockNumber end = Min(start + RPC_VACUUM_TRIAGE_BLOCKS, state->nblocks - 1);
+	RpcVacuumHorizon horizon;
+	BlockNumber next;
+	uint16	   *dead;
+	uint64		lsn;
+	int			n;
+	int			i;
+
+	(void) lazy_triage_entry(state, blkno, &dead);
+	memmove(state->entries, state->entries + state->entry_pos,
+			sizeof(RpcVacuumEntry) * (state->nentries - state->entry_pos));
+	memmove(state->dead, state->dead + state->dead_pos,
+			sizeof(uint16) * (state->ndead - state->dead_pos));
+	state->nentries -= state->entry_pos;
+	state->ndead -= state->dead_pos;
+	state->stream_pos = Max(state->stream_pos - state->entry_pos, 0);
+	state->entry_pos = 0;
+	state->dead_pos = 0;
+
+	if (start >= end)
+	{
+		state->triage_end = state->nblocks - 1;
+		return;
+	}
+	/* Not yet, if the scan is that far behind */
+	if (state->nentries > RPC_VACUUM_TRIAGE_BLOCKS ||
+		state->ndead > state->max_dead)
+		return;
+
+	/* The storage node must have seen our own changes */
+	if (!state->flushed)
+	{
+		XLogFlush(GetXLogInsertRecPtr());
+		state->flushed = true;
+	}
+	lsn = GetLogWrtResultLsn();
+
+	horizon.oldestXmin = OldestXmin;
+	horizon.freezeLimit = FreezeLimit;
+	RelationOpenSmgr(onerel);
+	n = RpcTriageVacuum(state->entries + state->nentries,
+						state->dead + state->ndead, &next, onerel->rd_smgr,
+						start, end, &horizon, state->max_dead, lsn);
+	if (n < 0 || next <= start || next > end)
+	{
+		state->triage = false;
+		return;
+	}
+	for (i = 0; i < n; i++)
+		state->ndead += state->entries[state->nentries + i].ndead;
+	state->nentries += n;
+	state->triage_end = next;
+}
+
+/*
+ *	lazy_triage_entry() -- the triage of blkno, if it needs no read
+ *
+ *		Sets *dead to its dead offsets.  The scan asks in block order, the
+ *		entries of the blocks before blkno are passed over.
+ */
+static RpcVacuumEntry *
+lazy_triage_entry(LVStreamState *state, BlockNumber blkno, uint16 **dead)
+{
+	while (state->entry_pos < state->nentries &&
+		   (BlockNumber) state->entries[state->entry_pos].blkno < blkno)
+	{
+		state->dead_pos += state->entries[state->entry_pos].ndead;
+		state->entry_pos++;
+	}
+	if (state->entry_pos == state->nentries ||
+		(BlockNumber) state->entries[state->entry_pos].blkno != blkno)
+		return NULL;
+
+	*dead = state->dead + state->dead_pos;
+	return &state->entries[state->entry_pos];
+}
+
+/*
+ *	lazy_stream_triaged() -- whether the scan will leave blkno unread
+ *
+ *		Of the blocks triaged so far only.  Those ahead are named even if
+ *		the storage node then finds they need no read, which only costs
+ *		their reads.
+ */
+static bool
+lazy_stream_triaged(LVStreamState *state, BlockNumber blkno)
+{
+	if (!state->triage || blkno >= state->triage_end)
+		return false;
+	while (state->stream_pos < state->nentries &&
+		   (BlockNumber) state->entries[state->stream_pos].blkno < blkno)
+		state->stream_pos++;
+	return state->stream_pos < state->nentries &&
+		(BlockNumber) state->entries[state->stream_pos].blkno == blkno;
+}
+
+/*
+ *	lazy_vacuum_stream_next() -- name the next page holding dead tuples
+ */
+static BlockNumber
+lazy_vacuum_stream_next(void *callback_arg)
+{
+	LVStreamState *state = (LVStreamState *) callback_arg;
+	LVDeadTuples *dead_tuples = state->dead_tuples;
+	BlockNumber blkno;
+
+	if (state->tupindex >= dead_tuples->num_tuples)
+		return InvalidBlockNumber;
+
+	blkno = ItemPointerGetBlockNumber(&dead_tuples->itemptrs[state->tupindex]);
+	while (state->tupindex < dead_tuples->num_tuples &&
+		   ItemPointerGetBlockNumber(&dead_tuples->itemptrs[state->tupindex]) == blkno)
+		state->tupindex++;
+	return blkno;
+}
+
 /*
  *	lazy_vacuum_page() -- free dead tuples on a page
  *					 and repair its fragmentation.
@@ -8,8 +8,14 @@
 #include <boost/thread/shared_mutex.hpp>
 #include <iostream>
 #include "access/logindex_hashmap.h"
+#include "access/logindex_hot_queue.h"
+#include "access/logindex_materialize.h"
+#include "access/logindex_resident.h"
+#include <algorithm>
 #include <atomic>
 #include "storage/kv_interface.h"
+#include "storage/adaptive_sr.h"
+#include "storage/db_clone.h"
 #include "tcop/storage_server.h"
 #include <sys/time.h>
 #include <pthread.h>
@@ -19,26 +25,83 @@
 #define ITER_BATCH_SIZE 10
 #define MAX_REPLAY_VERSION_SIZE 20
 
-#define ITER_BUCKET_INTERVAL 300
 #define ITER_HEAD_INTERVAL 300
+// Bucket sweeps skipped for hot pages in a row at most, so cold chains still
+// get replayed and collected under a steady hot load
+#define MAX_HOT_ROUNDS 8
 
-void BackgroundReplayHeadNode(HashMap hashMap, HashNodeHead * head);
+// A head being replayed in the background, its headLock held meanwhile
+typedef struct BackgroundReplayJob {
+    HashNodeHead *head;
+    uint64_t lsnList[MAX_REPLAY_VERSION_SIZE];
+    int listSize;
+    LsnEntryRef toReplayedLsnEntry;
+    BufferTag bufferTag;
+    char *basePage;
+    char *replayedPage;
+} BackgroundReplayJob;
+
+bool BackgroundPrepareReplay(HashMap hashMap, BackgroundReplayJob *job);
+void BackgroundFinishReplay(HashMap hashMap, BackgroundReplayJob *job);
+int BackgroundReplayHeads(HashMap hashMap, HashNodeHead **heads, int num, bool hot, const uint32_t *scores);
+bool BackgroundReplayHotHeads(HashMap hashMap);
+
+static std::atomic<int> activeReplayers(BACKGROUND_REPLAYER_DEFAULT_THREADS);
+static std::atomic<int> replayerSleepUs(BACKGROUND_REPLAYER_DEFAULT_SLEEP_US);
+static pthread_mutex_t replayerParkLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t replayerParkCond = PTHREAD_COND_INITIALIZER;
+
+void BackgroundReplayerSetLimits(int activeThreads, int sleepUs) {
+    activeThreads = std::min(std::max(activeThreads, 1), BACKGROUND_REPLAYER_MAX_THREADS);
+    sleepUs = std::min(std::max(sleepUs, 0), 1000000);
+
+    pthread_mutex_lock(&replayerParkLock);
+    activeReplayers.store(activeThreads);
+    replayerSleepUs.store(sleepUs);
+    pthread_cond_broadcast(&replayerParkCond);
+    pthread_mutex_unlock(&replayerParkLock);
+}
+
+void BackgroundReplayerGetLimits(int *activeThreads, int *sleepUs) {
+    *activeThreads = activeReplayers.load();
+    *sleepUs = replayerSleepUs.load();
+}
+
+// Wait while this replayer is above the active limit
+static void BackgroundReplayerPark(int replayerId) {
+    if(replayerId < activeReplayers.load())
+        return;
+    pthread_mutex_lock(&replayerParkLock);
+    while(replayerId >= activeReplayers.load())
+        pthread_cond_wait(&replayerParkCond, &replayerParkLock);
+    pthread_mutex_unlock(&replayerParkLock);
+}
 
 //#define ENABLE_DEBUG_INFO2
 //
 //#define ENABLE_DEBUG_INFO
 // Use try_rdlock to get a bucketLock, if failed, iterate to next bucket immediately
 // Then iterate head list, when try_wrlock head lock successfully, vacuum that head node list
-bool BackgroundHashMapCleanRocksdb(HashMap hashMap) {
+bool BackgroundHashMapCleanRocksdb(HashMap hashMap, int replayerId) {
 
     int currentBucketID = gettid() % hashMap->bucketNum;
     HashNodeHead *headNodes[ITER_BATCH_SIZE];
     int recordNumber = 0;
     struct timeval now;
+    int hotRounds = 0;
 
     while(1) { // Iterate all buckets
-        usleep(300);
+        BackgroundReplayerPark(replayerId);
+        int sleepUs = replayerSleepUs.load();
+        usleep(sleepUs);
         HashMapClearInactiveComputeNode(hashMap);
+
+        // Pages readers keep waiting on come first, the bucket sweep only
+        // gets the rounds where they have nothing to replay
+        if(BackgroundReplayHotHeads(hashMap) && ++hotRounds < MAX_HOT_ROUNDS) {
+            continue;
+        }
+        hotRounds = 0;
 //        printf("%s %d\n", __func__ , __LINE__);
 //        fflush(stdout);
         // Iterate every bucket one by one
@@ -51,14 +114,14 @@ bool BackgroundHashMapCleanRocksdb(HashMap hashMap) {
         int statisticFinishVacuum = 0;
 
         // Set the initial iter to bucket's first
-        HashNodeHead *iter = hashMap->bucketList[currentBucketID].nodeList;
-        if (pthread_mutex_trylock(&(hashMap->bucketList[currentBucketID].replayLock)) != 0) { // Other replay process is processing this bucket
+        HashNodeHead *iter = HashMapGetBucket(hashMap, currentBucketID)->nodeList;
+        if (pthread_mutex_trylock(&(HashMapGetBucket(hashMap, currentBucketID)->replayLock)) != 0) { // Other replay process is processing this bucket
             continue;
         }
         // Now get the replay lock, check whether it has enough interval before last vacuum
         gettimeofday(&now, NULL);
-        if (now.tv_usec - hashMap->bucketList[currentBucketID].lastReplayTime.tv_usec < ITER_BUCKET_INTERVAL) {
-            pthread_mutex_unlock(&(hashMap->bucketList[currentBucketID].replayLock));
+        if (now.tv_usec - HashMapGetBucket(hashMap, currentBucketID)->lastReplayTime.tv_usec < sleepUs) {
+            pthread_mutex_unlock(&(HashMapGetBucket(hashMap, currentBucketID)->replayLock));
             continue;
         }
 
@@ -71,7 +134,7 @@ bool BackgroundHashMapCleanRocksdb(HashMap hashMap) {
             recordNumber = 0;
 
             // Add a lock to this bucket
-            pthread_rwlock_rdlock(&hashMap->bucketList[currentBucketID].bucketLock);
+            pthread_rwlock_rdlock(&HashMapGetBucket(hashMap, currentBucketID)->bucketLock);
 
 
             for(int i = 0; i < currentFinishHeadNum; i++) {
@@ -92,39 +155,14 @@ bool BackgroundHashMapCleanRocksdb(HashMap hashMap) {
             }
 
             // Release this lock
-            pthread_rwlock_unlock(&hashMap->bucketList[currentBucketID].bucketLock);
+            pthread_rwlock_unlock(&HashMapGetBucket(hashMap, currentBucketID)->bucketLock);
 
 #ifdef ENABLE_DEBUG_INFO2
             printf("%s %d, background_vacuumer %d, got %d heads\n", __func__ , __LINE__, gettid(), recordNumber);
             fflush(stdout);
 #endif
 
-            // ITER these ITER_BATCH_SIZE heads
-            for(int i = 0; i < recordNumber; i++) {
-                if( pthread_rwlock_trywrlock(&(headNodes[i]->headLock)) != 0) { // failed to grab lock, skip this node
-                    continue;
-                }
-
-#ifdef ENABLE_DEBUG_INFO2
-                printf("%s %d, background_vacuumer %d, vacuuming %d head\n", __func__ , __LINE__, gettid(), i);
-                fflush(stdout);
-#endif
-                // TODO: check finish_vacuum_time, and replay this head
-
-                struct timeval now;
-                gettimeofday(&now, NULL);
-                if(now.tv_sec - headNodes[i]->finishVacuumTime.tv_sec >= ITER_HEAD_INTERVAL) {
-                    BackgroundReplayHeadNode(hashMap, headNodes[i]);
-                    headNodes[i]->finishVacuumTime = now;
-                }
-
-#ifdef ENABLE_DEBUG_INFO2
-                printf("%s %d, background_vacuumer %d, finish vacuum %d head\n", __func__ , __LINE__, gettid(), i);
-                fflush(stdout);
-#endif
-
-                pthread_rwlock_unlock(&(headNodes[i]->headLock));
-            }
+            BackgroundReplayHeads(hashMap, headNodes, recordNumber, false, NULL);
 
             // Skip these replayed heads in the next turn
             currentFinishHeadNum += ITER_BATCH_SIZE;
@@ -141,11 +179,11 @@ bool BackgroundHashMapCleanRocksdb(HashMap hashMap) {
         if(1 || statisticFinishVacuum == 0) {
             // update the last replay time for this bucket
             gettimeofday(&now, NULL);
-            hashMap->bucketList[currentBucketID].lastReplayTime.tv_sec = now.tv_sec;
-            hashMap->bucketList[currentBucketID].lastReplayTime.tv_usec = now.tv_usec;
+            HashMapGetBucket(hashMap, currentBucketID)->lastReplayTime.tv_sec = now.tv_sec;
+            HashMapGetBucket(hashMap, currentBucketID)->lastReplayTime.tv_usec = now.tv_usec;
         }
         // now other replay process can hold the lock again.
-        pthread_mutex_unlock(&(hashMap->bucketList[currentBucketID].replayLock));
+        pthread_mutex_unlock(&(HashMapGetBucket(hashMap, currentBucketID)->replayLock));
         if(statisticFinishVacuum != 0) {
 //            printf("%s %d, successfully cleaned %d bucket %d heads\n", __func__ , __LINE__, currentBucketID, statisticFinishVacuum);
 //            fflush(stdout);
@@ -156,26 +194,172 @@ bool BackgroundHashMapCleanRocksdb(HashMap hashMap) {
 
 }
 
-// Before
-void BackgroundReplayHeadNode(HashMap hashMap, HashNodeHead * head) {
+// Versions of head above its replayedLsn, counted up to limit
+static int BackgroundChainLength(HashNodeHead *head, int limit) {
+    int chainLen = 0;
+
+    for(int i = head->entryNum - 1; i >= 0 && head->lsnEntry[i].lsn > head->replayedLsn && chainLen < limit; i--)
+        chainLen++;
+    for(HashNodeEle *ele = head->nextEle; ele != NULL && chainLen < limit; ele = ele->nextEle)
+        for(int i = 0; i < ele->entryNum && chainLen < limit; i++)
+            if(HashEleLsn(ele, i) > head->replayedLsn)
+                chainLen++;
+    return chainLen;
+}
+
+// Replay the given heads, skipping the ones another thread holds. Heads off
+// the hot queue skip the ITER_HEAD_INTERVAL wait and come with their scores,
+// NULL for the others. Heads whose replayed version wouldn't be materialized
+// aren't replayed, nor cold heads of pages resident on a compute node, see
+// access/logindex_resident.h. Returns how many heads had versions to replay.
+int BackgroundReplayHeads(HashMap hashMap, HashNodeHead **heads, int num, bool hot, const uint32_t *scores) {
+    // Collect the heads replayed on top of a base page so they go to
+    // wal_redo in one request
+    BackgroundReplayJob jobs[ITER_BATCH_SIZE];
+    ReplayBatchEntry batch[ITER_BATCH_SIZE];
+    int jobNum = 0;
+    int replayed = 0;
+
+    for(int i = 0; i < num; i++) {
+        if( pthread_rwlock_trywrlock(&(heads[i]->headLock)) != 0) { // failed to grab lock, skip this node
+            continue;
+        }
+        // Cold chain spilled to RocksDB, leave it there until someone reads it
+        if(heads[i]->spilledEntryNum != 0) {
+            pthread_rwlock_unlock(&(heads[i]->headLock));
+            continue;
+        }
+        // Past its share of this cycle while another tenant is missing
+        if(!ASR_TenantMayReplay(heads[i]->key.DbID, heads[i]->key.RelID)) {
+            pthread_rwlock_unlock(&(heads[i]->headLock));
+            continue;
+        }
+
+#ifdef ENABLE_DEBUG_INFO2
+        printf("%s %d, background_vacuumer %d, vacuuming %d head\n", __func__ , __LINE__, gettid(), i);
+        fflush(stdout);
+#endif
+
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        if(!hot && now.tv_sec - heads[i]->finishVacuumTime.tv_sec < ITER_HEAD_INTERVAL) {
+            pthread_rwlock_unlock(&(heads[i]->headLock));
+            continue;
+        }
+        heads[i]->finishVacuumTime = now;
+
+        // Left as WAL only, replaying it now would be for nothing. A head
+        // with nothing to replay still goes on, to be collected.
+        int chainLen = BackgroundChainLength(heads[i], LOGINDEX_MATERIALIZE_FORCE_CHAIN);
+        if(chainLen > 0) {
+            uint32_t score = scores != NULL ? scores[i] : LogindexHotQueueScore(heads[i]->key);
+
+            // Not read until the compute node evicts it, so its share of
+            // the budget goes to a page that will miss
+            if(!hot && chainLen < LOGINDEX_MATERIALIZE_FORCE_CHAIN && LogindexResidentContains(heads[i]->key)) {
+                LogindexResidentDeferred();
+                pthread_rwlock_unlock(&(heads[i]->headLock));
+                continue;
+            }
+            if(!LogindexShouldMaterialize(score, chainLen)) {
+                pthread_rwlock_unlock(&(heads[i]->headLock));
+                continue;
+            }
+        }
+
+        BackgroundReplayJob *job = &jobs[jobNum];
+        job->head = heads[i];
+        bool queued = BackgroundPrepareReplay(hashMap, job);
+        if(job->listSize > 0) {
+            replayed++;
+        }
+        if(queued) {
+            // Keeps holding its headLock until the batch is back
+            batch[jobNum].rnode = job->bufferTag.rnode;
+            batch[jobNum].forkNum = job->bufferTag.forkNum;
+            batch[jobNum].blkNum = job->bufferTag.blockNum;
+            batch[jobNum].lsnList = job->lsnList;
+            batch[jobNum].listSize = job->listSize;
+            batch[jobNum].basePage = job->basePage;
+            batch[jobNum].targetPage = job->replayedPage;
+            jobNum++;
+            continue;
+        }
+
+#ifdef ENABLE_DEBUG_INFO2
+        printf("%s %d, background_vacuumer %d, finish vacuum %d head\n", __func__ , __LINE__, gettid(), i);
+        fflush(stdout);
+#endif
+
+        pthread_rwlock_unlock(&(heads[i]->headLock));
+    }
+
+    if(jobNum > 0) {
+        ApplyLsnListBatch(batch, jobNum);
+        for(int i = 0; i < jobNum; i++) {
+            BackgroundFinishReplay(hashMap, &jobs[i]);
+            pthread_rwlock_unlock(&(jobs[i].head->headLock));
+        }
+    }
+    return replayed;
+}
+
+// Replay a batch of the hottest pages off the hot queue, then queue them
+// again at half their score: a page still being read keeps climbing back,
+// one that isn't fades out. Returns whether any of them needed replay.
+bool BackgroundReplayHotHeads(HashMap hashMap) {
+    KeyType keys[ITER_BATCH_SIZE];
+    uint32_t scores[ITER_BATCH_SIZE];
+    HashNodeHead *heads[ITER_BATCH_SIZE];
+    uint32_t headScores[ITER_BATCH_SIZE];
+    int headNum = 0;
+
+    int keyNum = LogindexHotQueuePop(keys, scores, ITER_BATCH_SIZE);
+    if(keyNum == 0) {
+        return false;
+    }
+
+    for(int i = 0; i < keyNum; i++) {
+        HashNodeHead *head = HashMapFindHead(hashMap, keys[i]);
+        if(head != NULL && head->replayedLsn < head->maxLsn) {
+            headScores[headNum] = scores[i];
+            heads[headNum++] = head;
+        }
+    }
+
+    int replayed = BackgroundReplayHeads(hashMap, heads, headNum, true, headScores);
+
+    for(int i = 0; i < keyNum; i++) {
+        LogindexHotQueueRecord(keys[i], scores[i] / 2);
+    }
+    return replayed > 0;
+}
+
+// Collect the versions of job->head that still need replay. A head with
+// nothing to replay, or without a base page to replay on, is dealt with
+// right away and false returned; otherwise the caller has job->basePage
+// replayed into job->replayedPage and then calls BackgroundFinishReplay.
+bool BackgroundPrepareReplay(HashMap hashMap, BackgroundReplayJob *job) {
 #ifdef ENABLE_DEBUG_INFO
     printf("%s %d\n", __func__ , __LINE__);
     fflush(stdout);
 #endif
 
+    HashNodeHead *head = job->head;
     uint64_t replayedLsn = head->replayedLsn;
-    uint64_t lsnList[MAX_REPLAY_VERSION_SIZE];
+    uint64_t *lsnList = job->lsnList;
     int listSize = 0;
-    BufferTag bufferTag;
     RelFileNode rnode;
 
     rnode.spcNode = head->key.SpcID;
     rnode.dbNode = head->key.DbID;
     rnode.relNode = head->key.RelID;
 
-    INIT_BUFFERTAG(bufferTag, rnode, (ForkNumber)head->key.ForkNum, head->key.BlkNum);
+    INIT_BUFFERTAG(job->bufferTag, rnode, (ForkNumber)head->key.ForkNum, head->key.BlkNum);
 
-    LsnEntry *toReplayedLsnEntry = NULL;
+    LsnEntryRef toReplayedLsnEntry = {NULL, NULL, 0};
+    // Position of the newest version that rewrites the whole page
+    int fullPageFrom = -1;
     // If all LSNs in head have been replayed, skip it
     if(replayedLsn < head->lsnEntry[head->entryNum-1].lsn) {
         for(int i = 0; i < head->entryNum; i++) {
@@ -184,8 +368,10 @@ void BackgroundReplayHeadNode(HashMap hashMap, HashNodeHead * head) {
                 printf("%s %d, %lu, %lu\n", __func__ , __LINE__, replayedLsn, head->lsnEntry[i].lsn);
                 fflush(stdout);
 #endif
+                if(head->lsnEntry[i].fullPage)
+                    fullPageFrom = listSize;
                 lsnList[listSize++] = head->lsnEntry[i].lsn;
-                toReplayedLsnEntry = &(head->lsnEntry[i]);
+                toReplayedLsnEntry = HeadEntryRef(&(head->lsnEntry[i]));
             }
             if(listSize >= MAX_REPLAY_VERSION_SIZE) {
                 break;
@@ -200,11 +386,13 @@ void BackgroundReplayHeadNode(HashMap hashMap, HashNodeHead * head) {
     HashNodeEle *ele = head->nextEle;
     while(ele != NULL) {
         HashNodeEle *nextEle = ele->nextEle;
-        if(replayedLsn < ele->lsnEntry[ele->entryNum-1].lsn) {
+        if(replayedLsn < HashEleLsn(ele, ele->entryNum-1)) {
            for(int i = 0; i < ele->entryNum; i++) {
-               if(replayedLsn < ele->lsnEntry[i].lsn) {
-                   lsnList[listSize++] = ele->lsnEntry[i].lsn;
-                   toReplayedLsnEntry = &(ele->lsnEntry[i]);
+               if(replayedLsn < HashEleLsn(ele, i)) {
+                   if(HashEleFullPage(ele, i))
+                       fullPageFrom = listSize;
+                   lsnList[listSize++] = HashEleLsn(ele, i);
+                   toReplayedLsnEntry = EleEntryRef(ele, i);
                }
                if(listSize >= MAX_REPLAY_VERSION_SIZE) {
                    break;
@@ -224,37 +412,131 @@ void BackgroundReplayHeadNode(HashMap hashMap, HashNodeHead * head) {
     fflush(stdout);
 #endif
     // For now, we have collect 0~MAX_REPLAY_VERSION_SIZE versions from this element node
+    // Versions before a full-page one don't need replaying
+    if(fullPageFrom > 0) {
+        memmove(lsnList, lsnList + fullPageFrom, sizeof(uint64_t) * (listSize - fullPageFrom));
+        listSize -= fullPageFrom;
+    }
+    job->listSize = listSize;
+    job->toReplayedLsnEntry = toReplayedLsnEntry;
+    job->basePage = NULL;
+    job->replayedPage = NULL;
+
+    if(listSize == 0) {
+        HashMapGarbageCollectNode(hashMap, head);
+        return false;
+    }
 
-    if(listSize > 0) {
-        // we have other following version to be replayed
-        char* replayedPage = (char*) malloc(BLCKSZ);
-        if(head->replayedLsn>0) {
-            char* basePage = NULL;
-            GetPageFromRocksdb(bufferTag, replayedLsn, &basePage);
-            ApplyLsnList(rnode, (ForkNumber) head->key.ForkNum, (BlockNumber) head->key.BlkNum, lsnList,
-                         listSize, basePage, replayedPage);
-            free(basePage);
-        } else {
-            ApplyLsnListAndGetUpdatedPage(rnode, (ForkNumber)head->key.ForkNum, head->key.BlkNum, lsnList, listSize, replayedPage);
-        }
-
-        PutPage2Rocksdb(bufferTag, lsnList[listSize-1], replayedPage);
-        toReplayedLsnEntry->materialized = true;
-        head->replayedLsn = lsnList[listSize-1];
-        free(replayedPage);
-//        printf("%s %d, applyed %d xlogs for page\n", __func__ , __LINE__, listSize);
-//        fflush(stdout);
-#ifdef ENABLE_DEBUG_INFO
-        printf("%s %d\n", __func__ , __LINE__);
-        fflush(stdout);
-#endif
+    // we have other following version to be replayed
+    job->replayedPage = (char*) malloc(BLCKSZ);
+    if(fullPageFrom >= 0) {
+        // The first record rewrites the page, any base content will do
+        job->basePage = (char*) calloc(1, BLCKSZ);
+        return true;
+    }
+    if(head->replayedLsn>0) {
+        if(GetPageFromRocksdb(job->bufferTag, replayedLsn, &job->basePage))
+            return true;
+        // The base page is gone, leave this head to the foreground replay
+        free(job->replayedPage);
+        return false;
     }
+    // A clone's block starts from its parent's page, the foreground reads it
+    if(DbCloneParentBlocks(rnode, (ForkNumber)head->key.ForkNum) > head->key.BlkNum) {
+        free(job->replayedPage);
+        job->replayedPage = NULL;
+        return false;
+    }
+
+    ApplyLsnListAndGetUpdatedPage(rnode, (ForkNumber)head->key.ForkNum, head->key.BlkNum, lsnList, listSize, job->replayedPage);
+    BackgroundFinishReplay(hashMap, job);
+    return false;
+}
+
+void BackgroundFinishReplay(HashMap hashMap, BackgroundReplayJob *job) {
+    HashNodeHead *head = job->head;
 
+    PutPage2Rocksdb(job->bufferTag, job->lsnList[job->listSize-1], job->replayedPage);
+    LsnEntryRefSetMaterialized(job->toReplayedLsnEntry, true);
+    HashMapSetReplayedLsn(hashMap, head, job->lsnList[job->listSize-1]);
+    ASR_RecordTenantReplay(head->key.DbID, head->key.RelID, job->listSize);
+    HashMapMarkHeadDirty(hashMap, head);
+    free(job->basePage);
+    free(job->replayedPage);
 #ifdef ENABLE_DEBUG_INFO
     printf("%s %d\n", __func__ , __LINE__);
     fflush(stdout);
 #endif
+
     HashMapGarbageCollectNode(hashMap, head);
+}
+
+// A page image a compute node evicted, pageLsn being the end of the last
+// record that changed it, goes in as the replayed version of the last
+// record starting before pageLsn, if the chain up to there is worth
+// materializing. Left to replay if the head is busy or spilled, or that
+// version is already replayed. Returns whether it went in.
+bool BackgroundInstallPage(HashMap hashMap, KeyType key, const char *page, uint64_t pageLsn) {
+    HashNodeHead *head = HashMapFindHead(hashMap, key);
+    LsnEntryRef version = {NULL, NULL, 0};
+    uint64_t versionLsn = 0;
+    int chainLen = 0;
+
+    // Never had a version, the base page is already current
+    if(head == NULL)
+        return false;
+    if(pthread_rwlock_trywrlock(&(head->headLock)) != 0)
+        return false;
+    if(head->spilledEntryNum != 0) {
+        pthread_rwlock_unlock(&(head->headLock));
+        return false;
+    }
+
+    for(int i = 0; i < head->entryNum; i++) {
+        uint64_t lsn = head->lsnEntry[i].lsn;
+
+        if(lsn >= pageLsn)
+            continue;
+        if(lsn > head->replayedLsn)
+            chainLen++;
+        if(lsn > versionLsn) {
+            versionLsn = lsn;
+            version = HeadEntryRef(&(head->lsnEntry[i]));
+        }
+    }
+    for(HashNodeEle *ele = head->nextEle; ele != NULL; ele = ele->nextEle) {
+        for(int i = 0; i < ele->entryNum; i++) {
+            uint64_t lsn = HashEleLsn(ele, i);
+
+            if(lsn >= pageLsn)
+                continue;
+            if(lsn > head->replayedLsn)
+                chainLen++;
+            if(lsn > versionLsn) {
+                versionLsn = lsn;
+                version = EleEntryRef(ele, i);
+            }
+        }
+    }
+    if(versionLsn <= head->replayedLsn
+       || !LogindexShouldMaterialize(LogindexHotQueueScore(head->key), chainLen)) {
+        pthread_rwlock_unlock(&(head->headLock));
+        return false;
+    }
+
+    RelFileNode rnode;
+    BufferTag bufferTag;
 
-    return;
+    rnode.spcNode = head->key.SpcID;
+    rnode.dbNode = head->key.DbID;
+    rnode.relNode = head->key.RelID;
+    INIT_BUFFERTAG(bufferTag, rnode, (ForkNumber)head->key.ForkNum, head->key.BlkNum);
+
+    PutPage2Rocksdb(bufferTag, versionLsn, const_cast<char *>(page));
+    LsnEntryRefSetMaterialized(version, true);
+    HashMapSetReplayedLsn(hashMap, head, versionLsn);
+    HashMapMarkHeadDirty(hashMap, head);
+    HashMapGarbageCollectNode(hashMap, head);
+    pthread_rwlock_unlock(&(head->headLock));
+    return true;
 }
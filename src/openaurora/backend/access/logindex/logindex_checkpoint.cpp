@@ -0,0 +1,513 @@
+//
+// Persistent snapshots of the logindex version hashmap,
+// see access/logindex_checkpoint.h.
+//
+#include "c.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "access/logindex_checkpoint.h"
+#include "storage/buf_internals.h"
+#include "storage/kv_interface.h"
+extern "C" {
+#include "port/pg_crc32c.h"
+}
+
+#define CHECKPOINT_FILE_PREFIX "logindex."
+#define CHECKPOINT_WRITE_BUFFER (1 << 20)
+
+// On-disk size of one saved lsn entry, written field by field
+#define CHECKPOINT_ENTRY_SIZE (sizeof(uint64_t) + sizeof(int32_t) + sizeof(uint8_t))
+#define CHECKPOINT_ENTRY_MATERIALIZED (1)
+#define CHECKPOINT_ENTRY_FULL_PAGE (2)
+
+static pthread_mutex_t checkpointLock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t checkpointGeneration = 0; // 0 until the first full snapshot of this process
+static uint32_t checkpointNextSequence = 0;
+static uint64_t checkpointLastEpoch = 0;
+static bool checkpointForceFull = true;
+static bool checkpointStarted = false;
+
+struct KeyTypeHash {
+    size_t operator()(const KeyType &key) const {
+        uint64_t h = key.SpcID * 0x9e3779b97f4a7c15ULL;
+        h ^= key.DbID + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h ^= key.RelID + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h ^= key.ForkNum + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h ^= (uint64_t) key.BlkNum + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+struct KeyTypeEqual {
+    bool operator()(const KeyType &a, const KeyType &b) const {
+        return a.SpcID == b.SpcID && a.DbID == b.DbID && a.RelID == b.RelID
+               && a.ForkNum == b.ForkNum && a.BlkNum == b.BlkNum;
+    }
+};
+
+struct SavedHead {
+    uint64_t replayedLsn;
+    std::vector<LsnEntry> entries;
+};
+
+typedef std::unordered_map<KeyType, SavedHead, KeyTypeHash, KeyTypeEqual> SavedHeadMap;
+
+static const char* CheckpointDir() {
+    const char *dir = getenv("LOGINDEX_CHECKPOINT_DIR");
+    return (dir != NULL && dir[0] != '\0') ? dir : NULL;
+}
+
+bool LogindexCheckpointEnabled(void) {
+    return CheckpointDir() != NULL;
+}
+
+static int CheckpointIntervalMs() {
+    const char *value = getenv("LOGINDEX_CHECKPOINT_INTERVAL_MS");
+    if(value == NULL || value[0] == '\0')
+        return LOGINDEX_CHECKPOINT_DEFAULT_INTERVAL_MS;
+    int interval = atoi(value);
+    return interval > 0 ? interval : LOGINDEX_CHECKPOINT_DEFAULT_INTERVAL_MS;
+}
+
+static std::string CheckpointPath(const char *dir, uint64_t generation, uint32_t sequence) {
+    char name[64];
+    snprintf(name, sizeof(name), CHECKPOINT_FILE_PREFIX "%016lx.%08x", generation, sequence);
+    return std::string(dir) + "/" + name;
+}
+
+static bool ParseCheckpointName(const char *name, uint64_t *generation, uint32_t *sequence) {
+    unsigned long gen;
+    unsigned int seq;
+    int consumed = 0;
+    if(sscanf(name, CHECKPOINT_FILE_PREFIX "%16lx.%8x%n", &gen, &seq, &consumed) != 2
+       || name[consumed] != '\0')
+        return false;
+    *generation = gen;
+    *sequence = seq;
+    return true;
+}
+
+// All (generation, sequence) pairs present in dir, sorted
+static std::vector<std::pair<uint64_t, uint32_t>> ListCheckpointFiles(const char *dir) {
+    std::vector<std::pair<uint64_t, uint32_t>> files;
+    DIR *d = opendir(dir);
+    if(d == NULL)
+        return files;
+    struct dirent *de;
+    while((de = readdir(d)) != NULL) {
+        uint64_t generation;
+        uint32_t sequence;
+        if(ParseCheckpointName(de->d_name, &generation, &sequence))
+            files.push_back(std::make_pair(generation, sequence));
+    }
+    closedir(d);
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+static void FsyncDir(const char *dir) {
+    int fd = open(dir, O_RDONLY);
+    if(fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+}
+
+/* ---------------------------- writing ---------------------------- */
+
+struct CheckpointWriter {
+    FILE *fp;
+    pg_crc32c crc;
+    uint64_t headCount;
+    bool failed;
+    std::string buffer;
+};
+
+static void WriterFlush(CheckpointWriter *w) {
+    if(!w->failed && !w->buffer.empty()
+       && fwrite(w->buffer.data(), 1, w->buffer.size(), w->fp) != w->buffer.size())
+        w->failed = true;
+    w->buffer.clear();
+}
+
+static void WriterAppend(CheckpointWriter *w, const void *data, size_t len) {
+    COMP_CRC32C(w->crc, data, len);
+    w->buffer.append((const char*) data, len);
+    if(w->buffer.size() >= CHECKPOINT_WRITE_BUFFER)
+        WriterFlush(w);
+}
+
+static void WriteHeadVisitor(const KeyType *key, uint64_t replayedLsn,
+                             const LsnEntry *entries, int entryNum, void *arg) {
+    CheckpointWriter *w = (CheckpointWriter*) arg;
+    uint32_t num = (uint32_t) entryNum;
+
+    WriterAppend(w, &key->SpcID, sizeof(key->SpcID));
+    WriterAppend(w, &key->DbID, sizeof(key->DbID));
+    WriterAppend(w, &key->RelID, sizeof(key->RelID));
+    WriterAppend(w, &key->ForkNum, sizeof(key->ForkNum));
+    WriterAppend(w, &key->BlkNum, sizeof(key->BlkNum));
+    WriterAppend(w, &replayedLsn, sizeof(replayedLsn));
+    WriterAppend(w, &num, sizeof(num));
+    for(int i = 0; i < entryNum; i++) {
+        int32_t pageNum = entries[i].pageNum;
+        uint8_t flags = (entries[i].materialized ? CHECKPOINT_ENTRY_MATERIALIZED : 0)
+                        | (entries[i].fullPage ? CHECKPOINT_ENTRY_FULL_PAGE : 0);
+        WriterAppend(w, &entries[i].lsn, sizeof(entries[i].lsn));
+        WriterAppend(w, &pageNum, sizeof(pageNum));
+        WriterAppend(w, &flags, sizeof(flags));
+    }
+    w->headCount++;
+}
+
+bool LogindexCheckpointWrite(HashMap hashMap, const volatile uint64_t *parseUpto, bool full) {
+    const char *dir = CheckpointDir();
+    if(dir == NULL)
+        return false;
+
+    pthread_mutex_lock(&checkpointLock);
+
+    if(mkdir(dir, 0700) != 0 && errno != EEXIST) {
+        printf("%s mkdir %s failed, errno = %d\n", __func__ , dir, errno);
+        fflush(stdout);
+        pthread_mutex_unlock(&checkpointLock);
+        return false;
+    }
+
+    full = full || checkpointForceFull || checkpointNextSequence >= LOGINDEX_CHECKPOINT_FULL_EVERY;
+    uint64_t generation = checkpointGeneration;
+    uint32_t sequence = checkpointNextSequence;
+    if(full) {
+        if(generation == 0) {
+            std::vector<std::pair<uint64_t, uint32_t>> files = ListCheckpointFiles(dir);
+            if(!files.empty())
+                generation = files.back().first;
+        }
+        generation++;
+        sequence = 0;
+    }
+
+    // Bump the epoch before reading the parse position: every version below
+    // parseLsn was inserted, and its head marked, before this point, so it is
+    // either in this file or was written by an earlier one.
+    uint64_t minEpoch = full ? 0 : checkpointLastEpoch;
+    uint64_t epoch = HashMapAdvanceDirtyEpoch(hashMap);
+    uint64_t parseLsn = __atomic_load_n(parseUpto, __ATOMIC_SEQ_CST);
+
+    std::string path = CheckpointPath(dir, generation, sequence);
+    std::string tmpPath = path + ".tmp";
+    CheckpointWriter w;
+    w.fp = fopen(tmpPath.c_str(), "wb");
+    w.headCount = 0;
+    w.failed = (w.fp == NULL);
+    INIT_CRC32C(w.crc);
+    if(w.failed) {
+        printf("%s open %s failed, errno = %d\n", __func__ , tmpPath.c_str(), errno);
+        fflush(stdout);
+        checkpointForceFull = true;
+        pthread_mutex_unlock(&checkpointLock);
+        return false;
+    }
+
+    LogindexCheckpointHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = LOGINDEX_CHECKPOINT_MAGIC;
+    header.version = LOGINDEX_CHECKPOINT_VERSION;
+    header.generation = generation;
+    header.sequence = sequence;
+    header.parseLsn = parseLsn;
+    WriterAppend(&w, &header, sizeof(header));
+
+    HashMapForEachDirtyHead(hashMap, minEpoch, WriteHeadVisitor, &w);
+
+    LogindexCheckpointTrailer trailer;
+    trailer.headCount = w.headCount;
+    COMP_CRC32C(w.crc, &trailer.headCount, sizeof(trailer.headCount));
+    FIN_CRC32C(w.crc);
+    trailer.crc = w.crc;
+    trailer.magic = LOGINDEX_CHECKPOINT_MAGIC;
+    w.buffer.append((const char*) &trailer, sizeof(trailer));
+    WriterFlush(&w);
+
+    if(fflush(w.fp) != 0 || fsync(fileno(w.fp)) != 0)
+        w.failed = true;
+    if(fclose(w.fp) != 0)
+        w.failed = true;
+    if(w.failed || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        printf("%s write %s failed, errno = %d\n", __func__ , path.c_str(), errno);
+        fflush(stdout);
+        unlink(tmpPath.c_str());
+        // A hole in the sequence ends the generation, so start over
+        checkpointForceFull = true;
+        pthread_mutex_unlock(&checkpointLock);
+        return false;
+    }
+    FsyncDir(dir);
+
+    checkpointGeneration = generation;
+    checkpointNextSequence = sequence + 1;
+    checkpointLastEpoch = epoch;
+    checkpointForceFull = false;
+
+    // The new full snapshot supersedes every older generation
+    if(full) {
+        std::vector<std::pair<uint64_t, uint32_t>> files = ListCheckpointFiles(dir);
+        for(size_t i = 0; i < files.size(); i++)
+            if(files[i].first < generation)
+                unlink(CheckpointPath(dir, files[i].first, files[i].second).c_str());
+    }
+    pthread_mutex_unlock(&checkpointLock);
+
+#ifdef ENABLE_DEBUG_INFO
+    printf("%s wrote %s, heads = %lu, parseLsn = %lu\n", __func__ , path.c_str(), w.headCount, parseLsn);
+    fflush(stdout);
+#endif
+    return true;
+}
+
+struct CheckpointThreadArgs {
+    HashMap hashMap;
+    const volatile uint64_t *parseUpto;
+};
+
+static void* LogindexCheckpointMain(void *arg) {
+    CheckpointThreadArgs *args = (CheckpointThreadArgs*) arg;
+    int intervalMs = CheckpointIntervalMs();
+    while(1) {
+        usleep((useconds_t) intervalMs * 1000);
+        LogindexCheckpointWrite(args->hashMap, args->parseUpto, false);
+    }
+    return NULL;
+}
+
+void LogindexCheckpointStart(HashMap hashMap, const volatile uint64_t *parseUpto) {
+    if(!LogindexCheckpointEnabled())
+        return;
+
+    pthread_mutex_lock(&checkpointLock);
+    bool started = checkpointStarted;
+    checkpointStarted = true;
+    pthread_mutex_unlock(&checkpointLock);
+    if(started)
+        return;
+
+    CheckpointThreadArgs *args = (CheckpointThreadArgs*) malloc(sizeof(CheckpointThreadArgs));
+    args->hashMap = hashMap;
+    args->parseUpto = parseUpto;
+
+    pthread_t tid;
+    pthread_create(&tid, NULL, LogindexCheckpointMain, args);
+    pthread_detach(tid);
+}
+
+/* ---------------------------- restoring ---------------------------- */
+
+struct CheckpointReader {
+    const char *pos;
+    const char *end;
+};
+
+static bool ReaderGet(CheckpointReader *r, void *out, size_t len) {
+    if((size_t) (r->end - r->pos) < len)
+        return false;
+    memcpy(out, r->pos, len);
+    r->pos += len;
+    return true;
+}
+
+// Validate one file and merge its heads into saved, later files replacing
+// earlier copies of the same head. Nothing is merged unless the whole file
+// checks out.
+static bool LoadCheckpointFile(const std::string &path, uint64_t generation, uint32_t sequence,
+                               SavedHeadMap *saved, uint64_t *parseLsn) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+    struct stat st;
+    if(fstat(fd, &st) != 0
+       || (size_t) st.st_size < sizeof(LogindexCheckpointHeader) + sizeof(LogindexCheckpointTrailer)) {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t) st.st_size;
+    void *map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(map == MAP_FAILED)
+        return false;
+
+    const char *data = (const char*) map;
+    bool ok = false;
+    LogindexCheckpointHeader header;
+    LogindexCheckpointTrailer trailer;
+    memcpy(&header, data, sizeof(header));
+    memcpy(&trailer, data + size - sizeof(trailer), sizeof(trailer));
+
+    pg_crc32c crc;
+    INIT_CRC32C(crc);
+    COMP_CRC32C(crc, data, size - sizeof(trailer));
+    COMP_CRC32C(crc, &trailer.headCount, sizeof(trailer.headCount));
+    FIN_CRC32C(crc);
+
+    if(header.magic == LOGINDEX_CHECKPOINT_MAGIC && header.version == LOGINDEX_CHECKPOINT_VERSION
+       && header.generation == generation && header.sequence == sequence
+       && trailer.magic == LOGINDEX_CHECKPOINT_MAGIC && EQ_CRC32C(crc, trailer.crc)) {
+        CheckpointReader r = {data + sizeof(header), data + size - sizeof(trailer)};
+        SavedHeadMap fileHeads;
+        ok = true;
+        for(uint64_t h = 0; h < trailer.headCount && ok; h++) {
+            KeyType key;
+            SavedHead head;
+            uint32_t num;
+            ok = ReaderGet(&r, &key.SpcID, sizeof(key.SpcID))
+                 && ReaderGet(&r, &key.DbID, sizeof(key.DbID))
+                 && ReaderGet(&r, &key.RelID, sizeof(key.RelID))
+                 && ReaderGet(&r, &key.ForkNum, sizeof(key.ForkNum))
+                 && ReaderGet(&r, &key.BlkNum, sizeof(key.BlkNum))
+                 && ReaderGet(&r, &head.replayedLsn, sizeof(head.replayedLsn))
+                 && ReaderGet(&r, &num, sizeof(num))
+                 && (size_t) (r.end - r.pos) / CHECKPOINT_ENTRY_SIZE >= num;
+            if(!ok)
+                break;
+            head.entries.resize(num);
+            for(uint32_t i = 0; i < num; i++) {
+                int32_t pageNum;
+                uint8_t flags;
+                ReaderGet(&r, &head.entries[i].lsn, sizeof(head.entries[i].lsn));
+                ReaderGet(&r, &pageNum, sizeof(pageNum));
+                ReaderGet(&r, &flags, sizeof(flags));
+                head.entries[i].pageNum = pageNum;
+                head.entries[i].materialized = (flags & CHECKPOINT_ENTRY_MATERIALIZED) != 0;
+                head.entries[i].fullPage = (flags & CHECKPOINT_ENTRY_FULL_PAGE) != 0;
+            }
+            fileHeads[key] = head;
+        }
+        ok = ok && r.pos == r.end;
+        if(ok) {
+            for(SavedHeadMap::iterator it = fileHeads.begin(); it != fileHeads.end(); ++it) {
+                SavedHead &dst = (*saved)[it->first];
+                dst.replayedLsn = it->second.replayedLsn;
+                dst.entries.swap(it->second.entries);
+            }
+            *parseLsn = header.parseLsn;
+        }
+    }
+
+    munmap(map, size);
+    return ok;
+}
+
+// GC and the materialize-before-write in HashMapGetBlockReplayList mean a
+// saved materialized flag may name a page that isn't in RocksDB (any more)
+static bool PageVersionExists(const KeyType &key, uint64_t lsn) {
+    BufferTag bufferTag;
+    RelFileNode rnode;
+    rnode.spcNode = key.SpcID;
+    rnode.dbNode = key.DbID;
+    rnode.relNode = key.RelID;
+    INIT_BUFFERTAG(bufferTag, rnode, (ForkNumber) key.ForkNum, key.BlkNum);
+
+    char *page = NULL;
+    int found = GetPageFromRocksdb(bufferTag, lsn, &page);
+    if(page != NULL)
+        free(page);
+    return found == 1;
+}
+
+bool LogindexCheckpointRestore(HashMap hashMap, uint64_t minLsn, uint64_t *parseLsn,
+                               LogindexRestoreRelCallback relCallback, void *arg) {
+    const char *dir = CheckpointDir();
+    if(dir == NULL)
+        return false;
+
+    std::vector<std::pair<uint64_t, uint32_t>> files = ListCheckpointFiles(dir);
+
+    // Newest generation whose full snapshot is readable, plus its unbroken
+    // run of incrementals
+    SavedHeadMap saved;
+    uint64_t restoredLsn = 0;
+    uint64_t restoredGeneration = 0;
+    uint32_t restoredFiles = 0;
+    for(size_t g = files.size(); g > 0 && restoredFiles == 0; g--) {
+        if(files[g-1].second != 0)
+            continue;
+        uint64_t generation = files[g-1].first;
+        saved.clear();
+        for(uint32_t sequence = 0; ; sequence++) {
+            if(!LoadCheckpointFile(CheckpointPath(dir, generation, sequence), generation, sequence, &saved, &restoredLsn))
+                break;
+            restoredFiles++;
+        }
+        restoredGeneration = generation;
+    }
+
+    if(restoredFiles == 0 || restoredLsn <= minLsn) {
+        printf("%s no usable logindex checkpoint in %s (files = %u, lsn = %lu, min lsn = %lu)\n",
+               __func__ , dir, restoredFiles, restoredLsn, minLsn);
+        fflush(stdout);
+        return false;
+    }
+
+    std::unordered_map<KeyType, int64_t, KeyTypeHash, KeyTypeEqual> relMaxBlk;
+    uint64_t restoredHeads = 0;
+    for(SavedHeadMap::iterator it = saved.begin(); it != saved.end(); ++it) {
+        const KeyType &key = it->first;
+        std::vector<LsnEntry> &entries = it->second.entries;
+
+        // Versions at or past the parse lsn will be parsed again
+        size_t kept = 0;
+        while(kept < entries.size() && entries[kept].lsn < restoredLsn)
+            kept++;
+        entries.resize(kept);
+        if(entries.empty())
+            continue;
+
+        uint64_t replayedLsn = 0;
+        for(size_t i = 0; i < entries.size(); i++) {
+            if(!entries[i].materialized)
+                continue;
+            if(key.BlkNum != -1 && !PageVersionExists(key, entries[i].lsn)) {
+                entries[i].materialized = false;
+                continue;
+            }
+            if(entries[i].lsn <= it->second.replayedLsn)
+                replayedLsn = entries[i].lsn;
+        }
+
+        HashMapRestoreHead(hashMap, key, entries.data(), (int) entries.size(), replayedLsn);
+        restoredHeads++;
+
+        if(key.BlkNum >= 0) {
+            KeyType relKey = key;
+            relKey.BlkNum = -1;
+            std::unordered_map<KeyType, int64_t, KeyTypeHash, KeyTypeEqual>::iterator rel = relMaxBlk.find(relKey);
+            if(rel == relMaxBlk.end())
+                relMaxBlk[relKey] = key.BlkNum;
+            else if(rel->second < key.BlkNum)
+                rel->second = key.BlkNum;
+        }
+    }
+
+    if(relCallback != NULL)
+        for(std::unordered_map<KeyType, int64_t, KeyTypeHash, KeyTypeEqual>::iterator it = relMaxBlk.begin();
+            it != relMaxBlk.end(); ++it)
+            relCallback(&it->first, it->second, restoredLsn, arg);
+
+    printf("%s restored %lu heads from %u files of generation %lu, parse lsn = %lu\n",
+           __func__ , restoredHeads, restoredFiles, restoredGeneration, restoredLsn);
+    fflush(stdout);
+
+    *parseLsn = restoredLsn;
+    return true;
+}
@@ -0,0 +1,151 @@
+//
+// Deferred garbage collection of page version chains, see
+// access/logindex_gc_queue.h.
+//
+// Every shard is a ring of keys under its own mutex, with a direct-mapped
+// filter of the hashes queued so a key queued already is skipped. The
+// filter may lose a hash to another key hashing to its slot, the key is
+// then queued twice, which costs a second collection and nothing else. A
+// key's hash leaves the filter once a thread takes it off the ring, so a
+// read after that queues it again.
+//
+#include "postgres.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "access/logindex_gc_queue.h"
+
+#define GC_SHARD_SIZE (LOGINDEX_GC_QUEUE_SIZE / LOGINDEX_GC_SHARDS)
+#define GC_FILTER_SIZE (GC_SHARD_SIZE * 2)
+// How long a thread waits when every queue is empty
+#define GC_IDLE_US (1000)
+
+typedef struct GcQueueShard {
+    pthread_mutex_t lock;
+    KeyType keys[GC_SHARD_SIZE];
+    uint64_t hashes[GC_SHARD_SIZE];
+    // Hashes of the keys queued, 0 for none
+    uint64_t filter[GC_FILTER_SIZE];
+    int head;
+    int length;
+} GcQueueShard;
+
+static GcQueueShard gcShards[LOGINDEX_GC_SHARDS];
+static HashMap gcHashMap = NULL;
+static int gcLength = 0;
+static uint64_t gcDropped = 0;
+
+static uint64_t GcKeyHash(const KeyType *key) {
+    uint64_t h = key->SpcID * 0x9E3779B97F4A7C15ull;
+
+    h ^= key->DbID + 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+    h ^= key->RelID + 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+    h ^= key->ForkNum + 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+    h ^= (uint64_t) key->BlkNum + 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+    // 0 marks an empty filter slot
+    return h != 0 ? h : 1;
+}
+
+// Takes up to LOGINDEX_GC_BATCH keys off shard, returns how many
+static int GcQueuePop(GcQueueShard *shard, KeyType *keys) {
+    int n = 0;
+
+    pthread_mutex_lock(&shard->lock);
+    while (n < LOGINDEX_GC_BATCH && shard->length > 0) {
+        uint64_t hash = shard->hashes[shard->head];
+        uint64_t *slot = &shard->filter[(hash >> 32) % GC_FILTER_SIZE];
+
+        if (*slot == hash)
+            *slot = 0;
+        keys[n++] = shard->keys[shard->head];
+        shard->head = (shard->head + 1) % GC_SHARD_SIZE;
+        shard->length--;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    if (n > 0)
+        __atomic_fetch_sub(&gcLength, n, __ATOMIC_RELAXED);
+    return n;
+}
+
+static void *LogindexGcQueueMain(void *arg) {
+    int first = (int) (intptr_t) arg;
+    KeyType keys[LOGINDEX_GC_BATCH];
+
+    while (true) {
+        bool found = false;
+
+        // Every thread goes over all shards, starting at a different one
+        for (int i = 0; i < LOGINDEX_GC_SHARDS; i++) {
+            GcQueueShard *shard = &gcShards[(first + i) % LOGINDEX_GC_SHARDS];
+            int n = GcQueuePop(shard, keys);
+
+            for (int k = 0; k < n; k++)
+                HashMapGarbageCollectKey(gcHashMap, keys[k]);
+            found |= n > 0;
+        }
+        if (!found)
+            usleep(GC_IDLE_US);
+    }
+    return NULL;
+}
+
+void LogindexGcQueueStart(HashMap hashMap) {
+    pthread_t tid;
+
+    for (int i = 0; i < LOGINDEX_GC_SHARDS; i++) {
+        pthread_mutex_init(&gcShards[i].lock, NULL);
+        memset(gcShards[i].filter, 0, sizeof(gcShards[i].filter));
+        gcShards[i].head = 0;
+        gcShards[i].length = 0;
+    }
+    gcHashMap = hashMap;
+    for (int i = 0; i < LOGINDEX_GC_THREADS; i++) {
+        pthread_create(&tid, NULL, LogindexGcQueueMain,
+                       (void *) (intptr_t) (i * LOGINDEX_GC_SHARDS / LOGINDEX_GC_THREADS));
+        pthread_detach(tid);
+    }
+}
+
+void LogindexGcQueuePush(HashMap hashMap, KeyType key) {
+    uint64_t hash;
+    GcQueueShard *shard;
+    uint64_t *slot;
+    bool queued = false;
+
+    if (gcHashMap != hashMap) {
+        HashMapGarbageCollectKey(hashMap, key);
+        return;
+    }
+
+    hash = GcKeyHash(&key);
+    shard = &gcShards[hash % LOGINDEX_GC_SHARDS];
+    slot = &shard->filter[(hash >> 32) % GC_FILTER_SIZE];
+    pthread_mutex_lock(&shard->lock);
+    if (*slot == hash) {
+        pthread_mutex_unlock(&shard->lock);
+        return;
+    }
+    if (shard->length < GC_SHARD_SIZE) {
+        int tail = (shard->head + shard->length) % GC_SHARD_SIZE;
+
+        shard->keys[tail] = key;
+        shard->hashes[tail] = hash;
+        shard->length++;
+        *slot = hash;
+        queued = true;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    if (queued)
+        __atomic_fetch_add(&gcLength, 1, __ATOMIC_RELAXED);
+    else
+        __atomic_fetch_add(&gcDropped, 1, __ATOMIC_RELAXED);
+}
+
+int LogindexGcQueueLength(void) {
+    return __atomic_load_n(&gcLength, __ATOMIC_RELAXED);
+}
+
+uint64_t LogindexGcQueueDropped(void) {
+    return __atomic_load_n(&gcDropped, __ATOMIC_RELAXED);
+}
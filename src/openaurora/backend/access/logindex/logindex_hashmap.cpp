@@ -3,69 +3,18 @@
 #include <iostream>
 #include "c.h"
 #include "access/logindex_hashmap.h"
+#include "access/logindex_slab.h"
+#include "access/logindex_lsn_search.h"
+#include "access/logindex_relindex.h"
 #include "access/xlogdefs.h"
 #include "storage/buf_internals.h"
+#include "storage/db_clone.h"
 #include "storage/kv_interface.h"
+#include <algorithm>
 #include <atomic>
+#include <vector>
+#include <unistd.h>
 
-//#define DEBUG_TIMING
-#ifdef DEBUG_TIMING
-
-#include <sys/time.h>
-#include <pthread.h>
-#include <cstdlib>
-
-int initialized4 = 0;
-struct timeval output_timing4;
-
-pthread_mutex_t timing_mutex4 = PTHREAD_MUTEX_INITIALIZER;
-long findLowerTime[16];
-long findLowerCount[16];
-
-void PrintTimingResult4() {
-    struct timeval now;
-
-    if(!initialized4){
-        gettimeofday(&output_timing4, NULL);
-        initialized4 = 1;
-
-        memset(findLowerTime, 0, 16*sizeof(findLowerTime[0]));
-        memset(findLowerCount, 0, 16*sizeof(findLowerCount[0]));
-    }
-
-
-    gettimeofday(&now, NULL);
-
-    if(now.tv_sec-output_timing4.tv_sec >= 5) {
-        for(int i = 0 ; i < 9; i++) {
-            if(findLowerCount[i] == 0)
-                continue;
-            printf("findLowerTime_%d = %ld\n",i,  findLowerTime[i]/findLowerCount[i]);
-            printf("total_findLowerTime_%d = %ld, count = %ld\n",i,  findLowerTime[i], findLowerCount[i]);
-            fflush(stdout);
-        }
-
-        output_timing4 = now;
-    }
-}
-
-#define START_TIMING(start_p)  \
-do {                         \
-    gettimeofday(start_p, NULL); \
-} while(0);
-
-#define RECORD_TIMING(start_p, end_p, global_timing, global_count) \
-do { \
-    gettimeofday(end_p, NULL); \
-    pthread_mutex_lock(&timing_mutex4); \
-    (*global_timing) += ((*end_p.tv_sec*1000000+*end_p.tv_usec) - (*start_p.tv_sec*1000000+*start_p.tv_usec)); \
-    (*global_count)++;                                                               \
-    pthread_mutex_unlock(&timing_mutex4); \
-    PrintTimingResult4(); \
-    gettimeofday(start_p, NULL); \
-} while (0);
-
-#endif
 
 //#define ENABLE_DEBUG_INFO3
 //#define ENABLE_DEBUG_INFO2
@@ -110,26 +59,83 @@ int LsnListFindLowerBound(uint64_t targetLsn, LsnEntry* entryList, int listSize)
 
 HashMap pageVersionHashMap;
 
+static HashBucket* HashMapAllocSegment() {
+    void *segment = NULL;
+    if(posix_memalign(&segment, HASH_BUCKET_ALIGN, HASH_SEGMENT_SIZE * sizeof(HashBucket)) != 0)
+        return NULL;
+
+    HashBucket *buckets = (HashBucket*) segment;
+    for(int i = 0; i < HASH_SEGMENT_SIZE; i++) {
+        buckets[i].nodeList = NULL;
+        pthread_rwlock_init(&buckets[i].bucketLock, NULL);
+        pthread_mutex_init(&buckets[i].replayLock, NULL);
+        buckets[i].lastReplayTime.tv_sec = 0;
+        buckets[i].lastReplayTime.tv_usec = 0;
+    }
+    return buckets;
+}
+
+// Pages that never had a version are most of the reads of a large cold
+// table. The filter answers those without the bucket lock: every key that
+// gets a head is added before the head is linked, and heads are never freed,
+// so a negative is exact. Each key sets PAGE_FILTER_PROBES bits of one
+// 64-byte block, a lookup touches one cache line.
+#define PAGE_FILTER_DEFAULT_MB (32)
+#define PAGE_FILTER_BLOCK_WORDS (8)
+#define PAGE_FILTER_PROBES (4)
+
+static void HashMapPageFilterCreate(HashMap hashMap) {
+    const char *size = getenv("LOGINDEX_PAGE_FILTER_MB");
+    uint64_t bytes = (uint64_t) (size != NULL ? atol(size) : PAGE_FILTER_DEFAULT_MB) << 20;
+
+    hashMap->pageFilter = NULL;
+    hashMap->pageFilterBlocks = 0;
+    hashMap->pageFilterNegatives = 0;
+    if((int64_t) bytes <= 0)
+        return;
+
+    // A power of two blocks, so the block is picked with a mask
+    uint64_t blocks = 1;
+    while(blocks * 2 * PAGE_FILTER_BLOCK_WORDS * sizeof(uint64_t) <= bytes)
+        blocks *= 2;
+    void *filter = NULL;
+    if(posix_memalign(&filter, PAGE_FILTER_BLOCK_WORDS * sizeof(uint64_t),
+                      blocks * PAGE_FILTER_BLOCK_WORDS * sizeof(uint64_t)) != 0)
+        return;
+    memset(filter, 0, blocks * PAGE_FILTER_BLOCK_WORDS * sizeof(uint64_t));
+    hashMap->pageFilter = (uint64_t*) filter;
+    hashMap->pageFilterBlocks = blocks;
+}
+
 void HashMapInit(HashMap *hashMap_p, int bucketNum) {
     *hashMap_p = (HashMap) malloc(sizeof(struct HashMapStruct) );
 #ifdef ENABLE_DEBUG_INFO
     printf("%s malloc %lu for HashMapStruct\n", __func__ , sizeof(struct HashMapStruct));
 #endif
     (*hashMap_p)->bucketNum = bucketNum;
-    (*hashMap_p)->bucketList = (HashBucket*) malloc(bucketNum * sizeof(HashBucket));
-
-    for(int i = 0; i < bucketNum; i++) {
-        (*hashMap_p)->bucketList[i].nodeList = NULL;
-        pthread_rwlock_init(&(*hashMap_p)->bucketList[i].bucketLock, NULL);
-        pthread_mutex_init(&(*hashMap_p)->bucketList[i].replayLock, NULL);
-        (*hashMap_p)->bucketList[i].lastReplayTime.tv_sec = 0;
-        (*hashMap_p)->bucketList[i].lastReplayTime.tv_usec = 0;
-    }
+    (*hashMap_p)->initBucketNum = bucketNum;
+    (*hashMap_p)->splitState = 0;
+    (*hashMap_p)->headNum = 0;
+    (*hashMap_p)->dirtyEpoch = 1;
+    (*hashMap_p)->relIndex = RelIndexCreate();
+    (*hashMap_p)->memoryLimit = 0;
+    (*hashMap_p)->accessTick = 0;
+    (*hashMap_p)->spillerStarted = 0;
+    (*hashMap_p)->spilledChains = 0;
+    (*hashMap_p)->faultedChains = 0;
+    (*hashMap_p)->unreplayedEntries = 0;
+    pthread_mutex_init(&(*hashMap_p)->splitLock, NULL);
+    (*hashMap_p)->bucketSegments = (HashBucket**) calloc(HASH_MAX_SEGMENTS, sizeof(HashBucket*));
+
+    for(int i = 0; i < bucketNum; i += HASH_SEGMENT_SIZE)
+        (*hashMap_p)->bucketSegments[i >> HASH_SEGMENT_SHIFT] = HashMapAllocSegment();
 
     (*hashMap_p)->computeNodeNum = 0;
+    (*hashMap_p)->nextComputeNodeId = 0;
     (*hashMap_p)->computeNodeList = NULL;
     (*hashMap_p)->minComputeLsn = InvalidXLogRecPtr;
     pthread_rwlock_init(&(*hashMap_p)->computeNodeLock, NULL);
+    HashMapPageFilterCreate(*hashMap_p);
 #ifdef ENABLE_DEBUG_INFO
     printf("Hashmap Address = %p\n", (*hashMap_p));
     printf("%s finished \n", __func__ );
@@ -137,24 +143,29 @@ void HashMapInit(HashMap *hashMap_p, int bucketNum) {
 #endif
 }
 
+HashBucket* HashMapGetBucket(HashMap hashMap, uint32_t bucketPos) {
+    return &hashMap->bucketSegments[bucketPos >> HASH_SEGMENT_SHIFT][bucketPos & (HASH_SEGMENT_SIZE - 1)];
+}
+
+static inline uint64_t HashMix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
 uint32_t HashKey(KeyType key) {
 //    return tag_hash((void*) &key, sizeof(KeyType));
-    uint32_t res = 0;
-    res += (key.SpcID&0xFF) * 13 + 7;
-    res += (key.DbID&0xFF) * 17 + 5;
-    res += (key.RelID&0xFF) * 11 + 7;
-    res += (key.ForkNum&0xFF) * 3 + 29;
-
-    if(key.BlkNum != -1) {
-        res += (key.BlkNum&0xFF) * 7 + 11;
-    }
-//    res |= (key.SpcID&0xFF) * 13;
-//    res <<= 7;
-//    res |= (key.DbID&0xFF) * 17;
-//    res <<= 5;
-//    res |= (key.RelID&0xFF) * 11;
-//    res <<= 7;
-//    res |= (key.ForkNum&0xFF) * 3;
+    // Murmur3-style finalizer over every key field, so keys that only
+    // differ in the high bits of RelID or BlkNum still spread out.
+    uint64_t h = HashMix64(key.SpcID ^ 0x9e3779b97f4a7c15ULL);
+    h = HashMix64(h ^ key.DbID);
+    h = HashMix64(h ^ key.RelID);
+    h = HashMix64(h ^ (((uint64_t) key.ForkNum << 32) | (uint32_t) key.BlkNum));
+    h ^= (uint64_t) key.BlkNum >> 32;
+    uint32_t res = (uint32_t) (h ^ (h >> 32));
 #ifdef ENABLE_DEBUG_INFO
     printf("%s=%u\n", __func__ , res);
 #endif
@@ -162,6 +173,170 @@ uint32_t HashKey(KeyType key) {
     return res;
 }
 
+// The block and the bits in it come from one 64-bit mix of the key's hash
+static inline uint64_t *HashMapPageFilterBlock(HashMap hashMap, KeyType key, uint32_t hashValue, uint64_t *bits) {
+    uint64_t h = HashMix64(((uint64_t) hashValue << 32) ^ (uint32_t) key.BlkNum ^ ((uint64_t) key.RelID << 13));
+
+    *bits = h >> 32;
+    return &hashMap->pageFilter[(h & (hashMap->pageFilterBlocks - 1)) * PAGE_FILTER_BLOCK_WORDS];
+}
+
+static void HashMapPageFilterAdd(HashMap hashMap, KeyType key, uint32_t hashValue) {
+    uint64_t bits;
+
+    if(hashMap->pageFilter == NULL)
+        return;
+    uint64_t *block = HashMapPageFilterBlock(hashMap, key, hashValue, &bits);
+    for(int i = 0; i < PAGE_FILTER_PROBES; i++, bits >>= 9)
+        __atomic_fetch_or(&block[(bits >> 6) & (PAGE_FILTER_BLOCK_WORDS - 1)], 1ull << (bits & 63), __ATOMIC_RELEASE);
+}
+
+static bool HashMapPageFilterTest(HashMap hashMap, KeyType key, uint32_t hashValue) {
+    uint64_t bits;
+
+    if(hashMap->pageFilter == NULL)
+        return true;
+    uint64_t *block = HashMapPageFilterBlock(hashMap, key, hashValue, &bits);
+    for(int i = 0; i < PAGE_FILTER_PROBES; i++, bits >>= 9)
+        if((__atomic_load_n(&block[(bits >> 6) & (PAGE_FILTER_BLOCK_WORDS - 1)], __ATOMIC_ACQUIRE)
+            & (1ull << (bits & 63))) == 0) {
+            __atomic_fetch_add(&hashMap->pageFilterNegatives, 1, __ATOMIC_RELAXED);
+            return false;
+        }
+    return true;
+}
+
+bool HashMapMayContain(HashMap hashMap, KeyType key) {
+    return HashMapPageFilterTest(hashMap, key, HashKey(key));
+}
+
+// Bucket that currently holds hashValue under linear hashing
+static inline uint32_t HashMapBucketPos(HashMap hashMap, uint32_t hashValue) {
+    uint64_t state = __atomic_load_n(&hashMap->splitState, __ATOMIC_ACQUIRE);
+    uint32_t level = (uint32_t) (state >> 32);
+    uint32_t split = (uint32_t) state;
+
+    uint32_t pos = hashValue % ((uint32_t) hashMap->initBucketNum << level);
+    if(pos < split)
+        pos = hashValue % ((uint32_t) hashMap->initBucketNum << (level + 1));
+    return pos;
+}
+
+#define BUCKET_LOCK_READ 0
+#define BUCKET_LOCK_WRITE 1
+// Exclusive if the lock is free right now, shared otherwise
+#define BUCKET_LOCK_TRY_WRITE 2
+
+// Lock the bucket owning hashValue. A split may move the key between
+// computing its position and getting the lock, so recheck and retry.
+// *exclusive tells whether the lock was taken for write.
+static uint32_t HashMapLockBucket(HashMap hashMap, uint32_t hashValue, int mode, bool *exclusive) {
+    for(;;) {
+        uint32_t pos = HashMapBucketPos(hashMap, hashValue);
+        pthread_rwlock_t *lock = &HashMapGetBucket(hashMap, pos)->bucketLock;
+        bool wr = (mode == BUCKET_LOCK_WRITE);
+
+        if(mode == BUCKET_LOCK_TRY_WRITE)
+            wr = (pthread_rwlock_trywrlock(lock) == 0);
+        if(!wr)
+            pthread_rwlock_rdlock(lock);
+        else if(mode == BUCKET_LOCK_WRITE)
+            pthread_rwlock_wrlock(lock);
+
+        if(HashMapBucketPos(hashMap, hashValue) == pos) {
+            if(exclusive != NULL)
+                *exclusive = wr;
+            return pos;
+        }
+        pthread_rwlock_unlock(lock);
+    }
+}
+
+// Split the next bucket in linear-hashing order if the table is overloaded.
+// Only one thread splits at a time; others just carry on.
+static void HashMapMaybeSplit(HashMap hashMap) {
+    uint32_t bucketNum = __atomic_load_n(&hashMap->bucketNum, __ATOMIC_RELAXED);
+    if(__atomic_load_n(&hashMap->headNum, __ATOMIC_RELAXED) <= (uint64_t) bucketNum * HASH_SPLIT_LOAD)
+        return;
+    if(bucketNum >= (uint32_t) HASH_MAX_SEGMENTS * HASH_SEGMENT_SIZE)
+        return;
+    if(pthread_mutex_trylock(&hashMap->splitLock) != 0)
+        return;
+
+    uint64_t state = hashMap->splitState;
+    uint32_t level = (uint32_t) (state >> 32);
+    uint32_t split = (uint32_t) state;
+    uint32_t levelSize = (uint32_t) hashMap->initBucketNum << level;
+    uint32_t newPos = split + levelSize;
+
+    if(hashMap->bucketSegments[newPos >> HASH_SEGMENT_SHIFT] == NULL)
+        hashMap->bucketSegments[newPos >> HASH_SEGMENT_SHIFT] = HashMapAllocSegment();
+    if(hashMap->bucketSegments[newPos >> HASH_SEGMENT_SHIFT] == NULL) {
+        pthread_mutex_unlock(&hashMap->splitLock);
+        return;
+    }
+
+    HashBucket *oldBucket = HashMapGetBucket(hashMap, split);
+    HashBucket *newBucket = HashMapGetBucket(hashMap, newPos);
+    pthread_rwlock_wrlock(&oldBucket->bucketLock);
+    pthread_rwlock_wrlock(&newBucket->bucketLock);
+
+    HashNodeHead *iter = oldBucket->nodeList;
+    while(iter != NULL) {
+        HashNodeHead *next = iter->nextHead;
+        if(iter->hashValue % (levelSize << 1) == newPos) {
+            // unlink from the old bucket
+            if(iter->prevHead != NULL)
+                iter->prevHead->nextHead = iter->nextHead;
+            else
+                oldBucket->nodeList = iter->nextHead;
+            if(iter->nextHead != NULL)
+                iter->nextHead->prevHead = iter->prevHead;
+
+            // push to the new bucket
+            iter->prevHead = NULL;
+            iter->nextHead = newBucket->nodeList;
+            if(newBucket->nodeList != NULL)
+                newBucket->nodeList->prevHead = iter;
+            newBucket->nodeList = iter;
+            iter->bucket = newBucket;
+        }
+        iter = next;
+    }
+
+    if(split + 1 == levelSize)
+        state = (uint64_t) (level + 1) << 32;
+    else
+        state = ((uint64_t) level << 32) | (split + 1);
+    __atomic_store_n(&hashMap->splitState, state, __ATOMIC_RELEASE);
+    __atomic_store_n(&hashMap->bucketNum, (int) (newPos + 1), __ATOMIC_RELEASE);
+
+    pthread_rwlock_unlock(&newBucket->bucketLock);
+    pthread_rwlock_unlock(&oldBucket->bucketLock);
+    pthread_mutex_unlock(&hashMap->splitLock);
+}
+
+// Seqlock around lsn entry appends, see HashNodeHead.writeSeq
+#define HeadSeqWriteBegin(head) do { \
+    __atomic_fetch_add(&(head)->writeSeq, 1, __ATOMIC_RELAXED); \
+    __atomic_thread_fence(__ATOMIC_RELEASE); \
+} while(0)
+
+#define HeadSeqWriteEnd(head) do { \
+    __atomic_thread_fence(__ATOMIC_RELEASE); \
+    __atomic_fetch_add(&(head)->writeSeq, 1, __ATOMIC_RELAXED); \
+} while(0)
+
+// Called with head->headLock held (shared or exclusive), so a checkpoint that
+// takes the lock exclusively sees either none or all of the change
+void HashMapMarkHeadDirty(HashMap hashMap, HashNodeHead *head) {
+    __atomic_store_n(&head->dirtyEpoch, __atomic_load_n(&hashMap->dirtyEpoch, __ATOMIC_SEQ_CST), __ATOMIC_RELAXED);
+}
+
+uint64_t HashMapAdvanceDirtyEpoch(HashMap hashMap) {
+    return __atomic_add_fetch(&hashMap->dirtyEpoch, 1, __ATOMIC_SEQ_CST);
+}
+
 bool KeyMatch(KeyType key1, KeyType key2) {
     if(key1.SpcID == key2.SpcID
     && key1.DbID == key2.DbID
@@ -173,25 +348,171 @@ bool KeyMatch(KeyType key1, KeyType key2) {
         return false;
 }
 
+static void HashHeadBufferTag(const HashNodeHead *head, BufferTag *bufferTag) {
+    RelFileNode rnode;
+
+    rnode.spcNode = head->key.SpcID;
+    rnode.dbNode = head->key.DbID;
+    rnode.relNode = head->key.RelID;
+    INIT_BUFFERTAG(*bufferTag, rnode, (ForkNumber)head->key.ForkNum, head->key.BlkNum);
+}
+
+// A spilled chain is stored as two words per entry: lsn, (pageNum << 1) | materialized,
+// with SPILL_FULL_PAGE_BIT above the pageNum bits for full-page versions
+#define SPILL_FULL_PAGE_BIT ((uint64_t) 1 << 33)
+
+static bool HashMapReadSpilledChain(const HashNodeHead *head, std::vector<LsnEntry> &entries) {
+    BufferTag bufferTag;
+    uint64_t *chain = NULL;
+    int chainLen = 0;
+
+    HashHeadBufferTag(head, &bufferTag);
+    if(!GetLsnChainFromRocksdb(bufferTag, &chain, &chainLen))
+        return false;
+    if(chainLen != 2 * (int) head->spilledEntryNum) {
+        free(chain);
+        return false;
+    }
+
+    for(int i = 0; i < chainLen; i += 2) {
+        LsnEntry entry;
+        entry.lsn = chain[i];
+        entry.pageNum = (int32_t) (uint32_t) (chain[i+1] >> 1);
+        entry.materialized = chain[i+1] & 1;
+        entry.fullPage = (chain[i+1] & SPILL_FULL_PAGE_BIT) != 0;
+        entries.push_back(entry);
+    }
+    free(chain);
+    return true;
+}
+
+// Rebuild the element nodes of a spilled head. Called with headLock held exclusively.
+static void HashMapFaultInChain(HashMap hashMap, HashNodeHead *head) {
+    std::vector<LsnEntry> entries;
+    BufferTag bufferTag;
+
+    if(!HashMapReadSpilledChain(head, entries)) {
+        // Nothing better to do than carry on with the head's own entries
+        printf("%s lost the spilled chain, spc = %lu, db = %lu, rel = %lu, fork = %u, blk = %ld, entries = %u\n",
+               __func__, head->key.SpcID, head->key.DbID, head->key.RelID, head->key.ForkNum, head->key.BlkNum,
+               head->spilledEntryNum);
+        fflush(stdout);
+        head->spilledEntryNum = 0;
+        return;
+    }
+
+    HashNodeEle *tail = NULL;
+    for(size_t i = 0; i < entries.size(); i++) {
+        if(tail == NULL || !HashEleFits(tail, entries[i].lsn)) {
+            HashNodeEle *eleNode = LogindexSlabAllocEle();
+            eleNode->baseLsn = entries[i].lsn;
+            eleNode->materializedBits = 0;
+            eleNode->fullPageBits = 0;
+            eleNode->entryNum = 0;
+            eleNode->nextEle = NULL;
+            eleNode->prevEle = tail;
+            if(tail != NULL)
+                tail->nextEle = eleNode;
+            else
+                head->nextEle = eleNode;
+            tail = eleNode;
+        }
+        tail->lsnDelta[tail->entryNum] = (uint32_t) (entries[i].lsn - tail->baseLsn);
+        tail->pageNum[tail->entryNum] = entries[i].pageNum;
+        HashEleSetMaterialized(tail, tail->entryNum, entries[i].materialized);
+        HashEleSetFullPage(tail, tail->entryNum, entries[i].fullPage);
+        tail->entryNum++;
+        tail->maxLsn = entries[i].lsn;
+    }
+    head->tailEle = tail;
+    head->spilledEntryNum = 0;
+
+    HashHeadBufferTag(head, &bufferTag);
+    DeleteLsnChainFromRocksdb(bufferTag);
+    __atomic_fetch_add(&hashMap->faultedChains, 1, __ATOMIC_RELAXED);
+}
+
+// Lock head->headLock with its whole version chain in memory, faulting a
+// spilled chain back in first. Everything that walks the element nodes
+// locks the head through here.
+static void HashMapLockHeadResident(HashMap hashMap, HashNodeHead *head, bool exclusive) {
+    __atomic_store_n(&head->accessTick, __atomic_load_n(&hashMap->accessTick, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+
+    while(true) {
+        if(exclusive)
+            pthread_rwlock_wrlock(&head->headLock);
+        else
+            pthread_rwlock_rdlock(&head->headLock);
+        if(head->spilledEntryNum == 0)
+            return;
+
+        if(!exclusive) {
+            pthread_rwlock_unlock(&head->headLock);
+            pthread_rwlock_wrlock(&head->headLock);
+        }
+        if(head->spilledEntryNum != 0)
+            HashMapFaultInChain(hashMap, head);
+        if(exclusive)
+            return;
+        // Retake it shared, the spiller may get in between but that is rare
+        pthread_rwlock_unlock(&head->headLock);
+    }
+}
+
+// A version appended to head counts as unreplayed unless the head is already
+// replayed past it (only a restored head can be)
+static inline void HashMapCountNewVersion(HashMap hashMap, const HashNodeHead *head, uint64_t lsn) {
+    if(head->key.BlkNum != -1 && lsn > head->replayedLsn)
+        __atomic_fetch_add(&hashMap->unreplayedEntries, 1, __ATOMIC_RELAXED);
+}
+
+void HashMapSetReplayedLsn(HashMap hashMap, HashNodeHead *head, uint64_t lsn) {
+    if(lsn <= head->replayedLsn)
+        return;
+
+    if(head->key.BlkNum != -1) {
+        int64_t replayed = 0;
+        for(int i = 0; i < head->entryNum; i++)
+            if(head->lsnEntry[i].lsn > head->replayedLsn && head->lsnEntry[i].lsn <= lsn)
+                replayed++;
+        for(HashNodeEle *ele = head->nextEle; ele != NULL && ele->baseLsn <= lsn; ele = ele->nextEle) {
+            if(ele->maxLsn <= head->replayedLsn)
+                continue;
+            for(int i = 0; i < ele->entryNum; i++) {
+                uint64_t eleLsn = HashEleLsn(ele, i);
+                if(eleLsn > head->replayedLsn && eleLsn <= lsn)
+                    replayed++;
+            }
+        }
+        __atomic_fetch_sub(&hashMap->unreplayedEntries, replayed, __ATOMIC_RELAXED);
+    }
+    head->replayedLsn = lsn;
+}
+
+uint64_t HashMapUnreplayedEntries(HashMap hashMap) {
+    int64_t entries = __atomic_load_n(&hashMap->unreplayedEntries, __ATOMIC_RELAXED);
+
+    return entries > 0 ? (uint64_t) entries : 0;
+}
+
 // It can be called by two different logics
 // 1. Set the base page as the replayed page (lsn=1), and we should acquire holdHeadLock in this function
 // 2. After GetReplayLsnList (it holds the header lock and doesn't release), and ApplyLsnList, we use this function
 //      to update the final step (ReplayedLsn), and its parameter is holdHeadLock=True, we should only release lock.
 bool HashMapUpdateReplayedLsn(HashMap hashMap, KeyType key, uint64_t lsn, bool holdHeadLock) {
     uint32_t hashValue = HashKey(key);
-    uint32_t bucketPos = hashValue % hashMap->bucketNum;
+    uint32_t bucketPos = HashMapLockBucket(hashMap, hashValue, BUCKET_LOCK_READ, NULL);
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s start, hashValue = %u, bucketPos = %u \n", __func__ , hashValue, bucketPos);
     fflush(stdout);
 #endif
-    pthread_rwlock_rdlock(&hashMap->bucketList[bucketPos].bucketLock);
 
 #ifdef ENABLE_DEBUG_INFO2
     printf("%s %d, got the bucketLock, bucketPos = %u, tid = %d\n", __func__ , __LINE__, bucketPos, gettid());
     fflush(stdout);
 #endif
-    HashNodeHead* iter = hashMap->bucketList[bucketPos].nodeList;
+    HashNodeHead* iter = HashMapGetBucket(hashMap, bucketPos)->nodeList;
     bool foundHead = false;
     while(iter != NULL) {
         // If found matched key, break the loop
@@ -205,7 +526,7 @@ bool HashMapUpdateReplayedLsn(HashMap hashMap, KeyType key, uint64_t lsn, bool h
     }
 
     if (!foundHead) {
-        pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+        pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
 #ifdef ENABLE_DEBUG_INFO2
         printf("%s %d, release the bucketLock, bucketPos = %u, tid = %d\n", __func__ , __LINE__, bucketPos, gettid());
         fflush(stdout);
@@ -214,7 +535,7 @@ bool HashMapUpdateReplayedLsn(HashMap hashMap, KeyType key, uint64_t lsn, bool h
     }
 
 
-    pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+    pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
 #ifdef ENABLE_DEBUG_INFO2
     printf("%s %d, release the bucketLock, bucketPos = %u, tid = %d\n", __func__ , __LINE__, bucketPos, gettid());
     fflush(stdout);
@@ -225,14 +546,15 @@ bool HashMapUpdateReplayedLsn(HashMap hashMap, KeyType key, uint64_t lsn, bool h
         printf("%s try to get header lock, %lu, %lu, %lu, fork = %u, blk = %lu\n", __func__, iter->key.SpcID, iter->key.DbID, iter->key.RelID, iter->key.ForkNum, iter->key.BlkNum );
         fflush(stdout);
 #endif
-        pthread_rwlock_wrlock(&iter->headLock);
+        HashMapLockHeadResident(hashMap, iter, true);
     }
 #ifdef ENABLE_DEBUG_INFO
     printf("%s %d\n", __func__ , __LINE__);
     fflush(stdout);
 #endif
     if (iter->replayedLsn < lsn) {
-        iter->replayedLsn = lsn;
+        HashMapSetReplayedLsn(hashMap, iter, lsn);
+        HashMapMarkHeadDirty(hashMap, iter);
 #ifdef ENABLE_DEBUG_INFO
         printf("%s %d release header lock, %lu, %lu, %lu, fork = %u, blk = %lu\n", __func__, __LINE__, iter->key.SpcID, iter->key.DbID, iter->key.RelID, iter->key.ForkNum, iter->key.BlkNum );
         fflush(stdout);
@@ -249,13 +571,24 @@ bool HashMapUpdateReplayedLsn(HashMap hashMap, KeyType key, uint64_t lsn, bool h
     }
 }
 
+// Same as LsnListFindLowerBound, over an element node's delta-encoded lsns
+int HashEleFindLowerBound(uint64_t targetLsn, const HashNodeEle *ele) {
+    if(ele->entryNum == 0 || targetLsn < ele->baseLsn) {
+        return -1;
+    }
+
+    uint64_t targetDelta64 = targetLsn - ele->baseLsn;
+    uint32_t targetDelta = targetDelta64 > HASH_ELE_MAX_DELTA ? (uint32_t) HASH_ELE_MAX_DELTA : (uint32_t) targetDelta64;
+
+    // Find the last delta <= targetDelta
+    return LsnDeltaFindLowerBound(ele->lsnDelta, ele->entryNum, targetDelta);
+}
+
 bool HashMapUpdateMaterializedStatus(HashMap hashMap, KeyType key, uint64_t lsn, bool holdHeadLock, bool status) {
     uint32_t hashValue = HashKey(key);
-    uint32_t bucketPos = hashValue % hashMap->bucketNum;
-
-    pthread_rwlock_rdlock(&hashMap->bucketList[bucketPos].bucketLock);
+    uint32_t bucketPos = HashMapLockBucket(hashMap, hashValue, BUCKET_LOCK_READ, NULL);
 
-    HashNodeHead* iter = hashMap->bucketList[bucketPos].nodeList;
+    HashNodeHead* iter = HashMapGetBucket(hashMap, bucketPos)->nodeList;
     bool foundHead = false;
     while(iter != NULL) {
         if(iter->hashValue == hashValue
@@ -267,17 +600,18 @@ bool HashMapUpdateMaterializedStatus(HashMap hashMap, KeyType key, uint64_t lsn,
     }
 
     if (!foundHead) {
-        pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+        pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
         return false;
     }
 
-    pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+    pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
     if(!holdHeadLock) {
-        pthread_rwlock_wrlock(&iter->headLock);
+        HashMapLockHeadResident(hashMap, iter, true);
     }
     for(int i = 0; i < iter->entryNum; i++){
         if(iter->lsnEntry[i].lsn == lsn){
             iter->lsnEntry[i].materialized = status;
+            HashMapMarkHeadDirty(hashMap, iter);
             pthread_rwlock_unlock(&iter->headLock);
             return true;
         }
@@ -285,8 +619,9 @@ bool HashMapUpdateMaterializedStatus(HashMap hashMap, KeyType key, uint64_t lsn,
     auto eleIter = iter->nextEle;
     while(eleIter != NULL){
         for(int i = 0; i < eleIter->entryNum; i++){
-            if(eleIter->lsnEntry[i].lsn == lsn){
-                eleIter->lsnEntry[i].materialized = status;
+            if(HashEleLsn(eleIter, i) == lsn){
+                HashEleSetMaterialized(eleIter, i, status);
+                HashMapMarkHeadDirty(hashMap, iter);
                 pthread_rwlock_unlock(&iter->headLock);
                 return true;
             }
@@ -297,7 +632,57 @@ bool HashMapUpdateMaterializedStatus(HashMap hashMap, KeyType key, uint64_t lsn,
     return false;
 }
 
-bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, bool noEmptyFirstSlot) {
+// Read-only lookup of the newest version of key whose lsn <= targetLsn.
+// Unlike HashMapGetBlockReplayList, it neither builds a replay list nor
+// leaves the head locked, so callers can use it just to decide whether a
+// page changed. Returns false if the key is unknown or has no such version.
+bool HashMapGetLatestLsn(HashMap hashMap, KeyType key, uint64_t targetLsn, uint64_t *latestLsn) {
+    uint32_t hashValue = HashKey(key);
+    if(!HashMapPageFilterTest(hashMap, key, hashValue))
+        return false;
+    uint32_t bucketPos = HashMapLockBucket(hashMap, hashValue, BUCKET_LOCK_READ, NULL);
+
+    HashNodeHead* iter = HashMapGetBucket(hashMap, bucketPos)->nodeList;
+    bool foundHead = false;
+    while(iter != NULL) {
+        if(iter->hashValue == hashValue
+           && KeyMatch(iter->key, key)) {
+            foundHead = true;
+            break;
+        }
+        iter = iter->nextHead;
+    }
+
+    if (!foundHead) {
+        pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
+        return false;
+    }
+
+    pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
+    HashMapLockHeadResident(hashMap, iter, false);
+
+    bool found = false;
+    int resultIndex = LsnListFindLowerBound(targetLsn, iter->lsnEntry, iter->entryNum);
+    if(resultIndex >= 0) {
+        *latestLsn = iter->lsnEntry[resultIndex].lsn;
+        found = true;
+    }
+
+    HashNodeEle* eleIter = iter->nextEle;
+    while(eleIter != NULL && eleIter->entryNum > 0 && eleIter->baseLsn <= targetLsn) {
+        resultIndex = HashEleFindLowerBound(targetLsn, eleIter);
+        if(resultIndex >= 0) {
+            *latestLsn = HashEleLsn(eleIter, resultIndex);
+            found = true;
+        }
+        eleIter = eleIter->nextEle;
+    }
+
+    pthread_rwlock_unlock(&iter->headLock);
+    return found;
+}
+
+bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, bool noEmptyFirstSlot, bool fullPage) {
 #ifdef ENABLE_DEBUG_INFO3
     printf("%s start, spc = %lu, db = %lu, rel = %lu, fork = %d, blk = %ld, lsn = %lu\n", __func__ ,
            key.SpcID, key.DbID, key.RelID, key.ForkNum, key.BlkNum, lsn);
@@ -305,24 +690,23 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
 #endif
 
     uint32_t hashValue = HashKey(key);
-    uint32_t bucketPos = hashValue % hashMap->bucketNum;
+    // Lock this slot
+    // Maybe we won't add a new head, and only need a ReadLock
+    // TODO: use readLock first, if we need create head, writeLock it later
+//    WriterLock w_lock(hashMap->bucketList[bucketPos].bucketLock);
+    uint32_t bucketPos = HashMapLockBucket(hashMap, hashValue, BUCKET_LOCK_WRITE, NULL);
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s bucketPos = %u, hashValue = %u\n", __func__ , bucketPos, hashValue);
     fflush(stdout);
 #endif
-    // Lock this slot
-    // Maybe we won't add a new head, and only need a ReadLock
-    // TODO: use readLock first, if we need create head, writeLock it later
-//    WriterLock w_lock(hashMap->bucketList[bucketPos].bucketLock);
-    pthread_rwlock_wrlock(&hashMap->bucketList[bucketPos].bucketLock);
 
 #ifdef ENABLE_DEBUG_INFO2
     printf("%s %d, got the bucketLock, bucketPos = %u, tid = %d\n", __func__ , __LINE__, bucketPos, gettid());
     fflush(stdout);
 #endif
 
-    HashNodeHead* iter = hashMap->bucketList[bucketPos].nodeList;
+    HashNodeHead* iter = HashMapGetBucket(hashMap, bucketPos)->nodeList;
     bool foundHead = false;
     while(iter != NULL) {
 
@@ -350,13 +734,15 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
 #ifdef ENABLE_DEBUG_INFO
         printf("Create head node\n");
 #endif
-        HashNodeHead* head = (HashNodeHead*) malloc(sizeof(HashNodeHead));
+        HashNodeHead* head = LogindexSlabAllocHead();
 
+        HashMapPageFilterAdd(hashMap, key, hashValue);
         head->key = key;
         head->hashValue = hashValue;
-        head->bucket = &hashMap->bucketList[bucketPos];
+        head->bucket = HashMapGetBucket(hashMap, bucketPos);
 
         pthread_rwlock_init(&head->headLock, NULL);
+        head->writeSeq = 0;
 
         if(key.BlkNum != -1 && !noEmptyFirstSlot) { // this is for page version lsn list
 //            printf("%s %d, insertLsn = %lu\n", __func__ , __LINE__, lsn);
@@ -366,6 +752,8 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
             head->lsnEntry[1].lsn = lsn;
             head->lsnEntry[0].materialized = false;
             head->lsnEntry[1].materialized = false;
+            head->lsnEntry[0].fullPage = false;
+            head->lsnEntry[1].fullPage = fullPage;
             head->entryNum = 2;
         } else{ // this is for rel nblocks
 //            printf("%s %d, insertLsn = %lu\n", __func__ , __LINE__, lsn);
@@ -374,11 +762,13 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
             head->lsnEntry[0].lsn = lsn;
             head->lsnEntry[0].pageNum = pageNum;
             head->lsnEntry[0].materialized = false;
+            head->lsnEntry[0].fullPage = fullPage;
             head->entryNum = 1;
         };
         head->maxLsn = lsn;
         // If toReplayLsn == 0, then no page was replayed
         head->replayedLsn = 0;
+        HashMapCountNewVersion(hashMap, head, lsn);
 
         head->prevHead = NULL;
         head->nextHead = NULL;
@@ -386,6 +776,9 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
         head->tailEle = NULL;
         head->finishVacuumTime.tv_sec = 0;
         head->finishVacuumTime.tv_usec = 0;
+        head->spilledEntryNum = 0;
+        head->accessTick = __atomic_load_n(&hashMap->accessTick, __ATOMIC_RELAXED);
+        HashMapMarkHeadDirty(hashMap, head);
 
         // Add this new head to the first position of bucket list
 
@@ -396,7 +789,11 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
         head->nextHead = head->bucket->nodeList;
         head->bucket->nodeList = head;
 
-        pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+        pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
+
+        RelIndexAddBlock(hashMap->relIndex, &key);
+        __atomic_fetch_add(&hashMap->headNum, 1, __ATOMIC_RELAXED);
+        HashMapMaybeSplit(hashMap);
 
 #ifdef ENABLE_DEBUG_INFO2
         printf("%s %d, release the bucketLock, bucketPos = %u, tid = %d\n", __func__ , __LINE__, bucketPos, gettid());
@@ -418,7 +815,7 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
         iter->bucket->nodeList = iter;
     }
 
-    pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+    pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
 #ifdef ENABLE_DEBUG_INFO2
     printf("%s %d, release the bucketLock, bucketPos = %u, tid = %d\n", __func__ , __LINE__, bucketPos, gettid());
     fflush(stdout);
@@ -432,7 +829,7 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
 #endif
 //    WriterLock w_header_lock(iter->headLock);
 
-    pthread_rwlock_rdlock(&iter->headLock);
+    HashMapLockHeadResident(hashMap, iter, false);
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s Get header lock, %lu, %lu, %lu, fork = %u, blk = %lu\n", __func__, iter->key.SpcID, iter->key.DbID, iter->key.RelID, iter->key.ForkNum, iter->key.BlkNum );
@@ -447,7 +844,7 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
         fflush(stdout);
 #endif
 
-//        pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+//        pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
         pthread_rwlock_unlock(&iter->headLock);
         return false;
     }
@@ -469,16 +866,20 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
 #endif
 
             iter->lsnEntry[iter->entryNum-1].pageNum = pageNum;
+            iter->lsnEntry[iter->entryNum-1].fullPage |= fullPage;
         } else { // Check the tail node in this head list
 #ifdef ENABLE_DEBUG_INFO
             printf("%s %d, found in node entryPos = %d\n", __func__ , __LINE__, iter->tailEle->entryNum-1);
             fflush(stdout);
 #endif
 
-            iter->tailEle->lsnEntry[ iter->tailEle->entryNum -1 ].pageNum = pageNum;
+            iter->tailEle->pageNum[ iter->tailEle->entryNum -1 ] = pageNum;
+            if(fullPage)
+                HashEleSetFullPage(iter->tailEle, iter->tailEle->entryNum - 1, true);
         }
+        HashMapMarkHeadDirty(hashMap, iter);
 
-//        pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+//        pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
 #ifdef ENABLE_DEBUG_INFO
         printf("%s %d release header lock, %lu, %lu, %lu, fork = %u, blk = %lu\n", __func__, __LINE__, iter->key.SpcID, iter->key.DbID, iter->key.RelID, iter->key.ForkNum, iter->key.BlkNum );
         fflush(stdout);
@@ -497,14 +898,19 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
         printf("%s %d\n", __func__ , __LINE__);
         fflush(stdout);
 #endif
+        HeadSeqWriteBegin(iter);
         iter->lsnEntry[iter->entryNum].pageNum = pageNum;
         iter->lsnEntry[iter->entryNum].lsn = lsn;
         iter->lsnEntry[iter->entryNum].materialized = false;
+        iter->lsnEntry[iter->entryNum].fullPage = fullPage;
         iter->entryNum++;
 
         iter->maxLsn = lsn;
+        HeadSeqWriteEnd(iter);
+        HashMapCountNewVersion(hashMap, iter, lsn);
+        HashMapMarkHeadDirty(hashMap, iter);
 
-//        pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+//        pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
 #ifdef ENABLE_DEBUG_INFO
         printf("%s %d release header lock, %lu, %lu, %lu, fork = %u, blk = %lu\n", __func__, __LINE__, iter->key.SpcID, iter->key.DbID, iter->key.RelID, iter->key.ForkNum, iter->key.BlkNum );
         fflush(stdout);
@@ -519,7 +925,7 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
 #endif
     // If the tail node has available space, add this entry to tail node
     if(iter->tailEle
-        && iter->tailEle->entryNum < HASH_ELEM_NUM) {
+        && HashEleFits(iter->tailEle, lsn)) {
 
 #ifdef ENABLE_DEBUG_INFO
         printf("%s %d\n", __func__ , __LINE__);
@@ -527,17 +933,22 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
 //        printf("add into tail node\n");
 #endif
         HashNodeEle *nodeEle = iter->tailEle;
-        nodeEle->lsnEntry[nodeEle->entryNum].pageNum = pageNum;
-        nodeEle->lsnEntry[nodeEle->entryNum].lsn = lsn;
-        nodeEle->lsnEntry[nodeEle->entryNum].materialized = false;
+        HeadSeqWriteBegin(iter);
+        nodeEle->pageNum[nodeEle->entryNum] = pageNum;
+        nodeEle->lsnDelta[nodeEle->entryNum] = (uint32_t) (lsn - nodeEle->baseLsn);
+        HashEleSetMaterialized(nodeEle, nodeEle->entryNum, false);
+        HashEleSetFullPage(nodeEle, nodeEle->entryNum, fullPage);
 
         nodeEle->entryNum++;
 
         // update this node's maxLsn and header's lsn
         nodeEle->maxLsn = lsn;
         iter->maxLsn = lsn;
+        HeadSeqWriteEnd(iter);
+        HashMapCountNewVersion(hashMap, iter, lsn);
+        HashMapMarkHeadDirty(hashMap, iter);
 
-//        pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+//        pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
 #ifdef ENABLE_DEBUG_INFO
         printf("%s %d release header lock, %lu, %lu, %lu, fork = %u, blk = %lu\n", __func__, __LINE__, iter->key.SpcID, iter->key.DbID, iter->key.RelID, iter->key.ForkNum, iter->key.BlkNum );
         fflush(stdout);
@@ -554,15 +965,18 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
     // Add a new element node to the head list tail.
 
 //    printf("Create tail node\n");
-    HashNodeEle* eleNode = (HashNodeEle*) malloc(sizeof(HashNodeEle));
+    HashNodeEle* eleNode = LogindexSlabAllocEle();
     eleNode->maxLsn = lsn;
-    eleNode->lsnEntry[0].pageNum = pageNum;
-    eleNode->lsnEntry[0].lsn = lsn;
-    eleNode->lsnEntry[0].materialized = false;
+    eleNode->baseLsn = lsn;
+    eleNode->materializedBits = 0;
+    eleNode->fullPageBits = fullPage ? 1 : 0;
+    eleNode->pageNum[0] = pageNum;
+    eleNode->lsnDelta[0] = 0;
     eleNode->entryNum = 1;
     eleNode->nextEle = NULL;
     eleNode->prevEle = NULL;
 
+    HeadSeqWriteBegin(iter);
     iter->maxLsn = lsn;
 
     // If header has one or more element nodes
@@ -574,8 +988,11 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
         iter->nextEle = eleNode;
         iter->tailEle = eleNode;
     }
+    HeadSeqWriteEnd(iter);
+    HashMapCountNewVersion(hashMap, iter, lsn);
+    HashMapMarkHeadDirty(hashMap, iter);
 
-//    pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+//    pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
 #ifdef ENABLE_DEBUG_INFO
     printf("%s %d release header lock, %lu, %lu, %lu, fork = %u, blk = %lu\n", __func__, __LINE__, iter->key.SpcID, iter->key.DbID, iter->key.RelID, iter->key.ForkNum, iter->key.BlkNum );
     fflush(stdout);
@@ -598,10 +1015,69 @@ bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, b
     } \
 }while(0)
 
+// Shared-lock fast path of HashMapGetBlockReplayList for the cases that
+// need no replay and change nothing in the head: the version at targetLsn
+// is already materialized, or nothing after the base page exists yet.
+// Returns false if the caller has to take the exclusive path.
+static bool HashMapGetReplayedNoWrite(HashMap hashMap, HashNodeHead *iter, uint64_t targetLsn, uint64_t *replayedLsn) {
+    bool done = false;
+
+    HashMapLockHeadResident(hashMap, iter, false);
+
+    uint32_t seq = __atomic_load_n(&iter->writeSeq, __ATOMIC_ACQUIRE);
+    if(seq & 1) {
+        pthread_rwlock_unlock(&iter->headLock);
+        return false;
+    }
+
+    uint64_t result = 0;
+    if(iter->replayedLsn == targetLsn) {
+        result = iter->replayedLsn;
+        done = true;
+    } else if(iter->replayedLsn > targetLsn) {
+        bool found = false, materialized = false;
+        int resultIndex = LsnListFindLowerBound(targetLsn, iter->lsnEntry, iter->entryNum);
+        if(resultIndex >= 0) {
+            found = true;
+            materialized = iter->lsnEntry[resultIndex].materialized;
+            result = iter->lsnEntry[resultIndex].lsn;
+        }
+        for(HashNodeEle *eleIter = iter->nextEle;
+            eleIter != NULL && eleIter->entryNum > 0 && eleIter->baseLsn <= targetLsn;
+            eleIter = eleIter->nextEle) {
+            resultIndex = HashEleFindLowerBound(targetLsn, eleIter);
+            if(resultIndex >= 0) {
+                found = true;
+                materialized = HashEleMaterialized(eleIter, resultIndex);
+                result = HashEleLsn(eleIter, resultIndex);
+            }
+        }
+        if(found && materialized)
+            done = true;
+    } else if(iter->replayedLsn == iter->maxLsn) {
+        result = iter->maxLsn;
+        done = true;
+    } else if(iter->replayedLsn == 0 && iter->entryNum > 1 && iter->lsnEntry[0].lsn == 0 && iter->lsnEntry[1].lsn > targetLsn) {
+        result = 0;
+        done = true;
+    }
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if(__atomic_load_n(&iter->writeSeq, __ATOMIC_RELAXED) != seq)
+        done = false;
+
+    pthread_rwlock_unlock(&iter->headLock);
+
+    if(done)
+        *replayedLsn = result;
+    return done;
+}
+
 // This function will return lsn list that need be replayed
 // Parameters:
 //      $targetLsn is caller's request lsn, we need to replay until current lsn >= targetLsn
 //      $replayedLsn is in this block lsn list, which largest lsn has been replayed, if no page is replayed, set it as 0
+//                  It is also 0 when the list starts at a version that rewrites the whole page, which needs no base page
 //      $toReplayList and $listLen is caller's value, toReplayList should start from first lsn need replay
 //      return value: if list not exist, return false. if list exists and no version need to be replayed, return true and an empty list (listLen = 0),
 //                      in this case, the replayedLsn is the version that largest lsn that <= targetLsn
@@ -612,15 +1088,19 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
     fflush(stdout);
 #endif
     uint32_t hashValue = HashKey(key);
-    uint32_t bucketPos = hashValue % hashMap->bucketNum;
+    if(!HashMapPageFilterTest(hashMap, key, hashValue))
+        return false;
+    // Lock this slot. Only take it exclusively (for the move-to-front below)
+    // when nobody else holds it; concurrent readers share it instead of
+    // serializing on the bucket.
+    //    ReaderLock r_lock(hashMap->bucketList[bucketPos].bucketLock);
+    bool exclusiveBucket;
+    uint32_t bucketPos = HashMapLockBucket(hashMap, hashValue, BUCKET_LOCK_TRY_WRITE, &exclusiveBucket);
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s start, hashValue = %u, bucketPos = %u, pid = %d \n", __func__ , hashValue, bucketPos, getpid());
     fflush(stdout);
 #endif
-    // Lock this slot
-    //    ReaderLock r_lock(hashMap->bucketList[bucketPos].bucketLock);
-    pthread_rwlock_wrlock(&hashMap->bucketList[bucketPos].bucketLock);
 
 #ifdef ENABLE_DEBUG_INFO2
     printf("%s %d, got the bucketLock, bucketPos = %u, tid = %d\n", __func__ , __LINE__, bucketPos, gettid());
@@ -628,7 +1108,7 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
 #endif
 
     // Find the match head
-    HashNodeHead* iter = hashMap->bucketList[bucketPos].nodeList;
+    HashNodeHead* iter = HashMapGetBucket(hashMap, bucketPos)->nodeList;
     bool foundHead = false;
     while(iter != NULL) {
 
@@ -654,7 +1134,7 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
 
     // If this relation doesn't exist in hash map, return false
     if(!foundHead) {
-        pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+        pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
 #ifdef ENABLE_DEBUG_INFO2
         printf("%s %d, release the bucketLock, bucketPos = %u, tid = %d\n", __func__ , __LINE__, bucketPos, gettid());
         fflush(stdout);
@@ -663,7 +1143,7 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
     }
 
     // Move this recently inserted node to the first position in the bucket head list
-    if(iter->prevHead != NULL) { // if this head node is not the first head element in the list
+    if(exclusiveBucket && iter->prevHead != NULL) { // if this head node is not the first head element in the list
         iter->prevHead->nextHead = iter->nextHead;
         if(iter->nextHead != NULL) { // if this head node is not the rear node in the list
             iter->nextHead->prevHead = iter->prevHead;
@@ -673,7 +1153,7 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
         iter->nextHead->prevHead = iter;
         iter->bucket->nodeList = iter;
     }
-    pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+    pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
 #ifdef ENABLE_DEBUG_INFO2
     printf("%s %d, release the bucketLock, bucketPos = %u, tid = %d\n", __func__ , __LINE__, bucketPos, gettid());
         fflush(stdout);
@@ -684,8 +1164,13 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
     printf("%s try to get header lock, %lu, %lu, %lu, fork = %u, blk = %lu\n", __func__, iter->key.SpcID, iter->key.DbID, iter->key.RelID, iter->key.ForkNum, iter->key.BlkNum );
     fflush(stdout);
 #endif
+    if(HashMapGetReplayedNoWrite(hashMap, iter, targetLsn, replayedLsn)) {
+        *listLen = 0;
+        return true;
+    }
+
     // Unlock it until caller func has finished replaying task
-    pthread_rwlock_wrlock(&iter->headLock);
+    HashMapLockHeadResident(hashMap, iter, true);
 #ifdef ENABLE_DEBUG_INFO
     printf("%s %d , pid = %d\n", __func__ , __LINE__, getpid());
     fflush(stdout);
@@ -745,14 +1230,21 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
                             *replayedLsn = iter->lsnEntry[i].lsn;
                             break;
                         }
-                        else
+                        else {
                             AddToToReplayList(iter->lsnEntry[i].lsn);
+                            // Nothing older matters, and no base page is needed
+                            if(iter->lsnEntry[i].fullPage) {
+                                *replayedLsn = 0;
+                                break;
+                            }
+                        }
                     for(int i = 0, j = toReplayCount - 1; i < j; i++, j--){
                         uint64_t tmp = (*toReplayList)[i];
                         (*toReplayList)[i] = (*toReplayList)[j];
                         (*toReplayList)[j] = tmp;
                     }
                     *listLen = toReplayCount;
+                    HashMapMarkHeadDirty(hashMap, iter);
                     iter->lsnEntry[resultIndex].materialized = true; // todo (te): Here we assume the caller will always materialize this version, but it needs to be changed.
                 }
                 return true;
@@ -767,22 +1259,22 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
         // Try to find it in following nodes
         // Initialize the currentLsn as the rear lsn of list
         int resultIndex = iter->entryNum - 1;
-        LsnEntry* currentEntry = &(iter->lsnEntry[iter->entryNum-1]);
+        LsnEntryRef currentEntry = HeadEntryRef(&(iter->lsnEntry[iter->entryNum-1]));
 
         HashNodeEle* eleIter = iter->nextEle;
         while(eleIter != NULL) {
             // fast skip
             if(eleIter->maxLsn < targetLsn) {
-                currentEntry = &(eleIter->lsnEntry[eleIter->entryNum-1]);
+                currentEntry = EleEntryRef(eleIter, eleIter->entryNum-1);
 
                 eleIter = eleIter->nextEle;
                 continue;
             }
 
-            resultIndex = LsnListFindLowerBound(targetLsn, eleIter->lsnEntry, eleIter->entryNum);
+            resultIndex = HashEleFindLowerBound(targetLsn, eleIter);
 
             if(resultIndex >= 0)
-                currentEntry = &(eleIter->lsnEntry[resultIndex]);
+                currentEntry = EleEntryRef(eleIter, resultIndex);
 
             // Found the desired lsn
             break;
@@ -791,9 +1283,9 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
         printf("%s %d , pid = %d\n", __func__ , __LINE__, getpid());
         fflush(stdout);
 #endif
-        if(currentEntry->materialized){
+        if(LsnEntryRefMaterialized(currentEntry)){
             *listLen = 0;
-            *replayedLsn = currentEntry->lsn;
+            *replayedLsn = LsnEntryRefLsn(currentEntry);
             pthread_rwlock_unlock(&iter->headLock);
         }
         else{
@@ -801,16 +1293,24 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
             int toReplayCount = 0;
             *toReplayList = (uint64_t*) malloc(sizeof(uint64_t)* mallocSize);
 
+            // Walk back to a materialized version, or to one that rewrites
+            // the whole page and so needs no base page (replayedLsn 0)
             bool foundReplayedEntry = false;
-            for(auto eIter = eleIter; eIter != NULL; eIter = eIter->prevEle, resultIndex = eIter != NULL ? eIter->entryNum - 1 : iter->entryNum - 1)
+            for(auto eIter = eleIter; eIter != NULL && !foundReplayedEntry; eIter = eIter->prevEle, resultIndex = eIter != NULL ? eIter->entryNum - 1 : iter->entryNum - 1)
                 for(int i = resultIndex; i >= 0; i--)
-                    if(eIter->lsnEntry[i].materialized){
+                    if(HashEleMaterialized(eIter, i)){
                         foundReplayedEntry = true;
-                        *replayedLsn = eIter->lsnEntry[i].lsn;
+                        *replayedLsn = HashEleLsn(eIter, i);
                         break;
                     }
-                    else
-                        AddToToReplayList(eIter->lsnEntry[i].lsn);
+                    else {
+                        AddToToReplayList(HashEleLsn(eIter, i));
+                        if(HashEleFullPage(eIter, i)) {
+                            foundReplayedEntry = true;
+                            *replayedLsn = 0;
+                            break;
+                        }
+                    }
             if(!foundReplayedEntry){
                 for(int i = resultIndex; i >= 0; i--)
                     if(iter->lsnEntry[i].materialized){
@@ -818,8 +1318,14 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
                         *replayedLsn = iter->lsnEntry[i].lsn;
                         break;
                     }
-                    else
+                    else {
                         AddToToReplayList(iter->lsnEntry[i].lsn);
+                        if(iter->lsnEntry[i].fullPage) {
+                            foundReplayedEntry = true;
+                            *replayedLsn = 0;
+                            break;
+                        }
+                    }
             }
             for(int i = 0, j = toReplayCount - 1; i < j; i++, j--){
                 uint64_t tmp = (*toReplayList)[i];
@@ -827,7 +1333,8 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
                 (*toReplayList)[j] = tmp;
             }
             *listLen = toReplayCount;
-            currentEntry->materialized = true; // todo (te): Here we assume the caller will always materialize this version, but it needs to be changed.
+            HashMapMarkHeadDirty(hashMap, iter);
+            LsnEntryRefSetMaterialized(currentEntry, true); // todo (te): Here we assume the caller will always materialize this version, but it needs to be changed.
         }
 #ifdef ENABLE_DEBUG_INFO
         printf("%s %d release header lock, %lu, %lu, %lu, fork = %u, blk = %lu\n", __func__, __LINE__, iter->key.SpcID, iter->key.DbID, iter->key.RelID, iter->key.ForkNum, iter->key.BlkNum );
@@ -872,7 +1379,9 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
     int mallocSize = 16;
     int toReplayCount = 0;
     *toReplayList = (uint64_t*) malloc(sizeof(uint64_t)* mallocSize);
-    LsnEntry* toReplayedLsnEntry;
+    LsnEntryRef toReplayedLsnEntry = {NULL, NULL, 0};
+    // Position in the list of the newest version that rewrites the whole page
+    int fullPageFrom = -1;
 
     // Circumstance: ... $replayedLsn ..(what we need).. $targetLsn
     int foundReplayLsnPosition = 0;
@@ -894,8 +1403,10 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
             fflush(stdout);
 #endif
             if(iter->lsnEntry[i].lsn <= targetLsn) {
+                if(iter->lsnEntry[i].fullPage)
+                    fullPageFrom = toReplayCount;
                 AddToToReplayList(iter->lsnEntry[i].lsn);
-                toReplayedLsnEntry = &(iter->lsnEntry[i]);
+                toReplayedLsnEntry = HeadEntryRef(&(iter->lsnEntry[i]));
             } else { // found all toReplay list
                 break;
             }
@@ -908,7 +1419,7 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
 
     HashNodeEle* eleIter = iter->nextEle;
     while(eleIter != NULL) {
-        if(eleIter->lsnEntry[0].lsn > targetLsn) {
+        if(eleIter->baseLsn > targetLsn) {
             break;
         }
 
@@ -920,20 +1431,19 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
 
         int startIndex = 0;
         if(!foundReplayLsnPosition) {
-            startIndex = LsnListFindLowerBound(iter->replayedLsn, eleIter->lsnEntry, eleIter->entryNum);
+            startIndex = HashEleFindLowerBound(iter->replayedLsn, eleIter);
             startIndex +=1;
             foundReplayLsnPosition = 1;
         }
 
 
         // targetEntry should be found in the list
-        for(int i = startIndex; i < eleIter->entryNum; i++) {
-            if(eleIter->lsnEntry[i].lsn <= targetLsn) {
-                AddToToReplayList(eleIter->lsnEntry[i].lsn);
-                toReplayedLsnEntry = &(eleIter->lsnEntry[i]);
-            } else {  // found all toReplay list
-                break;
-            }
+        int endIndex = eleIter->maxLsn <= targetLsn ? eleIter->entryNum - 1 : HashEleFindLowerBound(targetLsn, eleIter);
+        for(int i = startIndex; i <= endIndex; i++) {
+            if(HashEleFullPage(eleIter, i))
+                fullPageFrom = toReplayCount;
+            AddToToReplayList(HashEleLsn(eleIter, i));
+            toReplayedLsnEntry = EleEntryRef(eleIter, i);
         }
 
         eleIter = eleIter->nextEle;
@@ -943,6 +1453,14 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
     printf("%s %d , pid = %d\n", __func__ , __LINE__, getpid());
     fflush(stdout);
 #endif
+    // Everything before a full-page version is overwritten by it, so replay
+    // starts there, without a base page
+    if(fullPageFrom >= 0) {
+        memmove(*toReplayList, *toReplayList + fullPageFrom, sizeof(uint64_t) * (toReplayCount - fullPageFrom));
+        toReplayCount -= fullPageFrom;
+        *replayedLsn = 0;
+    }
+
     *listLen = toReplayCount;
     if(toReplayCount == 0) {
         pthread_rwlock_unlock(&iter->headLock);
@@ -954,7 +1472,8 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
         free(*toReplayList);
     }
     else{
-        toReplayedLsnEntry->materialized = true; // todo (te): Here we assume the caller will always materialize this version, but it needs to be changed.
+        HashMapMarkHeadDirty(hashMap, iter);
+        LsnEntryRefSetMaterialized(toReplayedLsnEntry, true); // todo (te): Here we assume the caller will always materialize this version, but it needs to be changed.
     }
 
 #ifdef ENABLE_DEBUG_INFO
@@ -969,11 +1488,9 @@ bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn,
 
 bool HashMapGarbageCollectKey(HashMap hashMap, KeyType key){
     uint32_t hashValue = HashKey(key);
-    uint32_t bucketPos = hashValue % hashMap->bucketNum;
-
-    pthread_rwlock_rdlock(&hashMap->bucketList[bucketPos].bucketLock);
+    uint32_t bucketPos = HashMapLockBucket(hashMap, hashValue, BUCKET_LOCK_READ, NULL);
 
-    HashNodeHead* iter = hashMap->bucketList[bucketPos].nodeList;
+    HashNodeHead* iter = HashMapGetBucket(hashMap, bucketPos)->nodeList;
     bool foundHead = false;
     while(iter != NULL) {
         if(iter->hashValue == hashValue
@@ -985,21 +1502,118 @@ bool HashMapGarbageCollectKey(HashMap hashMap, KeyType key){
     }
 
     if (!foundHead) {
-        pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
+        pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
         return false;
     }
-    pthread_rwlock_unlock(&hashMap->bucketList[bucketPos].bucketLock);
-    pthread_rwlock_wrlock(&iter->headLock);
+    pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
+    HashMapLockHeadResident(hashMap, iter, true);
     HashMapGarbageCollectNode(hashMap, iter);
     pthread_rwlock_unlock(&iter->headLock);
     return true;
 }
 
+HashNodeHead *HashMapFindHead(HashMap hashMap, KeyType key) {
+    uint32_t hashValue = HashKey(key);
+    uint32_t bucketPos = HashMapLockBucket(hashMap, hashValue, BUCKET_LOCK_READ, NULL);
+
+    HashNodeHead* iter = HashMapGetBucket(hashMap, bucketPos)->nodeList;
+    while(iter != NULL) {
+        if(iter->hashValue == hashValue
+           && KeyMatch(iter->key, key)) {
+            break;
+        }
+        iter = iter->nextHead;
+    }
+    pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
+    return iter;
+}
+
+int HashMapGetRelationBlocks(HashMap hashMap, KeyType relKey, int64_t fromBlk, int64_t *blocks, int maxBlocks) {
+    return RelIndexGetBlocks(hashMap->relIndex, &relKey, fromBlk, blocks, maxBlocks);
+}
+
+#define GC_RELATION_BATCH (256)
+
+int64_t HashMapGarbageCollectRelation(HashMap hashMap, KeyType relKey, int64_t fromBlk) {
+    int64_t blocks[GC_RELATION_BATCH];
+    int64_t visited = 0;
+    int found;
+
+    do {
+        found = RelIndexGetBlocks(hashMap->relIndex, &relKey, fromBlk, blocks, GC_RELATION_BATCH);
+        for(int i = 0; i < found; i++) {
+            KeyType key = relKey;
+            key.BlkNum = blocks[i];
+            HashMapGarbageCollectKey(hashMap, key);
+        }
+        visited += found;
+        if(found > 0)
+            fromBlk = blocks[found - 1] + 1;
+    } while(found == GC_RELATION_BATCH);
+    return visited;
+}
+
+// Called with headLock held exclusively, the whole chain resident
+static void HashMapDropHeadVersions(HashMap hashMap, HashNodeHead *head, bool deletePages) {
+    BufferTag bufferTag;
+    int64_t unreplayed = 0;
+
+    HashHeadBufferTag(head, &bufferTag);
+    HeadSeqWriteBegin(head);
+    for(int i = 0; i < head->entryNum; i++) {
+        if(deletePages && head->lsnEntry[i].materialized)
+            DeletePageFromRocksdb(bufferTag, head->lsnEntry[i].lsn);
+        if(head->lsnEntry[i].lsn > head->replayedLsn)
+            unreplayed++;
+    }
+    while(head->nextEle != NULL) {
+        HashNodeEle *ele = head->nextEle;
+        for(int i = 0; i < ele->entryNum; i++) {
+            if(deletePages && HashEleMaterialized(ele, i))
+                DeletePageFromRocksdb(bufferTag, HashEleLsn(ele, i));
+            if(HashEleLsn(ele, i) > head->replayedLsn)
+                unreplayed++;
+        }
+        head->nextEle = ele->nextEle;
+        LogindexSlabFreeEle(ele);
+    }
+    head->tailEle = NULL;
+    head->entryNum = 0;
+    head->maxLsn = 0;
+    head->replayedLsn = 0;
+    HeadSeqWriteEnd(head);
+    if(head->key.BlkNum != -1)
+        __atomic_fetch_sub(&hashMap->unreplayedEntries, unreplayed, __ATOMIC_RELAXED);
+    HashMapMarkHeadDirty(hashMap, head);
+}
+
+int64_t HashMapDropRelation(HashMap hashMap, KeyType relKey, int64_t fromBlk, int maxBlocks, bool deletePages) {
+    int64_t blocks[GC_RELATION_BATCH];
+    int found;
+
+    if(maxBlocks > GC_RELATION_BATCH)
+        maxBlocks = GC_RELATION_BATCH;
+    found = RelIndexGetBlocks(hashMap->relIndex, &relKey, fromBlk, blocks, maxBlocks);
+    for(int i = 0; i < found; i++) {
+        KeyType key = relKey;
+        key.BlkNum = blocks[i];
+
+        HashNodeHead *head = HashMapFindHead(hashMap, key);
+        if(head == NULL)
+            continue;
+        // A spilled chain is faulted in, its versions go with the rest
+        HashMapLockHeadResident(hashMap, head, true);
+        HashMapDropHeadVersions(hashMap, head, deletePages);
+        pthread_rwlock_unlock(&head->headLock);
+    }
+    return found == maxBlocks ? blocks[found - 1] + 1 : -1;
+}
+
 // Delete corresponding RocksDb pages and hashNodeEle
 // Should remember ele->prev/next in advance, ele will be erased in this func
 void VacuumHashNode(HashNodeHead* head, HashNodeEle* ele, BufferTag bufferTag) {
 //    for(int i = 0; i < ele->entryNum; i++) {
-//        DeletePageFromRocksdb(bufferTag, ele->lsnEntry[i].lsn);
+//        DeletePageFromRocksdb(bufferTag, HashEleLsn(ele, i));
 //    }
     if(ele == head->nextEle) { // if it is the first node
         head->nextEle = ele->nextEle;
@@ -1012,16 +1626,22 @@ void VacuumHashNode(HashNodeHead* head, HashNodeEle* ele, BufferTag bufferTag) {
             ele->nextEle->prevEle = ele->prevEle;
         }
     }
-    free(ele);
+    LogindexSlabFreeEle(ele);
 }
 
 void HashMapGarbageCollectNode(HashMap hashMap, HashNodeHead *head){
     auto minComputeLsn = HashMapGetMinComputeLsn(hashMap);
     if(minComputeLsn == InvalidXLogRecPtr || head->replayedLsn < minComputeLsn)
         minComputeLsn = head->replayedLsn;
+    // Clones of the database read its pages as of their fork LSN
+    uint64_t forkLsn = DbCloneOldestForkLsn(head->key.SpcID, head->key.DbID);
+    if(forkLsn != InvalidXLogRecPtr && forkLsn < minComputeLsn)
+        minComputeLsn = forkLsn;
     if(minComputeLsn <= 0ull)
         return;
 
+    // Only a head that loses versions needs checkpointing again
+    bool changed = false;
     uint64_t toKeepLsn = InvalidXLogRecPtr;
     BufferTag bufferTag;
     RelFileNode rnode;
@@ -1043,9 +1663,9 @@ void HashMapGarbageCollectNode(HashMap hashMap, HashNodeHead *head){
     while(ele != NULL) {
         bool to_break = false;
         for(int i = 0; i < ele->entryNum; i++)
-            if(ele->lsnEntry[i].lsn <= minComputeLsn){
-                if(ele->lsnEntry[i].materialized)
-                    toKeepLsn = ele->lsnEntry[i].lsn;
+            if(HashEleLsn(ele, i) <= minComputeLsn){
+                if(HashEleMaterialized(ele, i))
+                    toKeepLsn = HashEleLsn(ele, i);
             }
             else{
                 to_break = true;
@@ -1059,8 +1679,11 @@ void HashMapGarbageCollectNode(HashMap hashMap, HashNodeHead *head){
     for(int i = 0; i < head->entryNum; i++)
         if(head->lsnEntry[i].lsn < toKeepLsn){
             if(head->lsnEntry[i].materialized){
-                DeletePageFromRocksdb(bufferTag, head->lsnEntry[i].lsn);
+                // Compaction drops it once the horizon passes toKeepLsn
+                if(!KvPageGcInCompaction())
+                    DeletePageFromRocksdb(bufferTag, head->lsnEntry[i].lsn);
                 head->lsnEntry[i].materialized = false;
+                changed = true;
             }
         }
         else
@@ -1069,10 +1692,12 @@ void HashMapGarbageCollectNode(HashMap hashMap, HashNodeHead *head){
     while(ele != NULL) {
         bool to_break = false;
         for(int i = 0; i < ele->entryNum; i++)
-            if(ele->lsnEntry[i].lsn < toKeepLsn){
-                if(ele->lsnEntry[i].materialized){
-                    DeletePageFromRocksdb(bufferTag, ele->lsnEntry[i].lsn);
-                    ele->lsnEntry[i].materialized = false;
+            if(HashEleLsn(ele, i) < toKeepLsn){
+                if(HashEleMaterialized(ele, i)){
+                    if(!KvPageGcInCompaction())
+                        DeletePageFromRocksdb(bufferTag, HashEleLsn(ele, i));
+                    HashEleSetMaterialized(ele, i, false);
+                    changed = true;
                 }
             }
             else{
@@ -1083,26 +1708,282 @@ void HashMapGarbageCollectNode(HashMap hashMap, HashNodeHead *head){
             break;
         auto nextEle = ele->nextEle;
         VacuumHashNode(head, ele, bufferTag);
+        changed = true;
         ele = nextEle;
     }
+    if(changed)
+        HashMapMarkHeadDirty(hashMap, head);
+}
+
+uint64_t HashMapForEachDirtyHead(HashMap hashMap, uint64_t minEpoch, HashMapHeadVisitor visitor, void *arg) {
+    uint64_t visited = 0;
+    std::vector<HashNodeHead*> heads;
+    std::vector<LsnEntry> entries;
+
+    // Re-read bucketNum every round, so heads that a concurrent split moves
+    // into a new bucket are still seen (possibly twice, which is harmless)
+    for(int pos = 0; pos < __atomic_load_n(&hashMap->bucketNum, __ATOMIC_ACQUIRE); pos++) {
+        HashBucket *bucket = HashMapGetBucket(hashMap, pos);
+        heads.clear();
+        // Heads are never freed while the map is alive, so the pointers stay
+        // valid after the bucket lock is dropped
+        pthread_rwlock_rdlock(&bucket->bucketLock);
+        for(HashNodeHead *iter = bucket->nodeList; iter != NULL; iter = iter->nextHead)
+            heads.push_back(iter);
+        pthread_rwlock_unlock(&bucket->bucketLock);
+
+        for(size_t h = 0; h < heads.size(); h++) {
+            HashNodeHead *head = heads[h];
+            // Exclusive, so no insert or replay is half-way through the head
+            pthread_rwlock_wrlock(&head->headLock);
+            if(head->dirtyEpoch < minEpoch) {
+                pthread_rwlock_unlock(&head->headLock);
+                continue;
+            }
+
+            KeyType key = head->key;
+            uint64_t replayedLsn = head->replayedLsn;
+            entries.assign(head->lsnEntry, head->lsnEntry + head->entryNum);
+            // Copy a spilled chain straight from RocksDB, a checkpoint
+            // shouldn't pull cold chains back into memory
+            if(head->spilledEntryNum != 0 && !HashMapReadSpilledChain(head, entries)) {
+                pthread_rwlock_unlock(&head->headLock);
+                continue;
+            }
+            for(HashNodeEle *ele = head->nextEle; ele != NULL; ele = ele->nextEle)
+                for(int i = 0; i < ele->entryNum; i++) {
+                    LsnEntry entry;
+                    entry.lsn = HashEleLsn(ele, i);
+                    entry.pageNum = ele->pageNum[i];
+                    entry.materialized = HashEleMaterialized(ele, i);
+                    entry.fullPage = HashEleFullPage(ele, i);
+                    entries.push_back(entry);
+                }
+            pthread_rwlock_unlock(&head->headLock);
+
+            visitor(&key, replayedLsn, entries.data(), (int) entries.size(), arg);
+            visited++;
+        }
+    }
+    return visited;
+}
+
+bool HashMapRestoreHead(HashMap hashMap, KeyType key, const LsnEntry *entries, int entryNum, uint64_t replayedLsn) {
+    if(entryNum <= 0)
+        return false;
+
+    for(int i = 0; i < entryNum; i++)
+        HashMapInsertKey(hashMap, key, entries[i].lsn, entries[i].pageNum, true, entries[i].fullPage);
+
+    uint32_t hashValue = HashKey(key);
+    uint32_t bucketPos = HashMapLockBucket(hashMap, hashValue, BUCKET_LOCK_READ, NULL);
+    HashNodeHead* iter = HashMapGetBucket(hashMap, bucketPos)->nodeList;
+    while(iter != NULL && !(iter->hashValue == hashValue && KeyMatch(iter->key, key)))
+        iter = iter->nextHead;
+    pthread_rwlock_unlock(&HashMapGetBucket(hashMap, bucketPos)->bucketLock);
+    if(iter == NULL)
+        return false;
+
+    // The inserts above laid the entries out in the same order
+    HashMapLockHeadResident(hashMap, iter, true);
+    int pos = 0;
+    for(int i = 0; i < iter->entryNum && pos < entryNum; i++, pos++)
+        iter->lsnEntry[i].materialized = entries[pos].materialized;
+    for(HashNodeEle *ele = iter->nextEle; ele != NULL; ele = ele->nextEle)
+        for(int i = 0; i < ele->entryNum && pos < entryNum; i++, pos++)
+            HashEleSetMaterialized(ele, i, entries[pos].materialized);
+    HashMapSetReplayedLsn(hashMap, iter, replayedLsn);
+    HashMapMarkHeadDirty(hashMap, iter);
+    pthread_rwlock_unlock(&iter->headLock);
+    return true;
+}
+
+#define SPILL_TICK_US (100000)
+// Heads untouched for this many ticks are cold enough to spill
+#define SPILL_COLD_TICKS (2)
+// Once over the limit, spill until usage drops below this share of it
+#define SPILL_LOW_WATERMARK_PCT (90)
+#define SPILL_CHECK_BUCKETS (64)
+
+uint64_t HashMapResidentBytes(void) {
+    LogindexSlabStats slab;
+
+    LogindexSlabGetStats(&slab);
+    return slab.headInUse * sizeof(HashNodeHead) + slab.eleInUse * sizeof(HashNodeEle);
+}
+
+// Move head's element nodes to RocksDB. Called with headLock held exclusively.
+// The logical content doesn't change, so the head isn't marked dirty.
+static bool HashMapSpillChain(HashMap hashMap, HashNodeHead *head) {
+    std::vector<uint64_t> chain;
+    BufferTag bufferTag;
+
+    for(HashNodeEle *ele = head->nextEle; ele != NULL; ele = ele->nextEle)
+        for(int i = 0; i < ele->entryNum; i++) {
+            chain.push_back(HashEleLsn(ele, i));
+            chain.push_back(((uint64_t) (uint32_t) ele->pageNum[i] << 1) | (HashEleMaterialized(ele, i) ? 1 : 0)
+                            | (HashEleFullPage(ele, i) ? SPILL_FULL_PAGE_BIT : 0));
+        }
+    if(chain.empty())
+        return false;
+
+    HashHeadBufferTag(head, &bufferTag);
+    if(PutLsnChain2Rocksdb(bufferTag, chain.data(), (int) chain.size()) != 0)
+        return false;
+
+    while(head->nextEle != NULL) {
+        HashNodeEle *ele = head->nextEle;
+        head->nextEle = ele->nextEle;
+        LogindexSlabFreeEle(ele);
+    }
+    head->tailEle = NULL;
+    head->spilledEntryNum = (uint32_t) (chain.size() / 2);
+    __atomic_fetch_add(&hashMap->spilledChains, 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+static void *HashMapSpillerMain(void *arg) {
+    HashMap hashMap = (HashMap) arg;
+    uint32_t cursor = 0;
+    std::vector<HashNodeHead*> heads;
+
+    while(true) {
+        usleep(SPILL_TICK_US);
+        uint32_t tick = __atomic_add_fetch(&hashMap->accessTick, 1, __ATOMIC_RELAXED);
+        // The governor may move the limit between ticks
+        uint64_t memoryLimit = __atomic_load_n(&hashMap->memoryLimit, __ATOMIC_RELAXED);
+        uint64_t lowWatermark = memoryLimit / 100 * SPILL_LOW_WATERMARK_PCT;
+        if(memoryLimit == 0 || HashMapResidentBytes() <= memoryLimit)
+            continue;
+
+        // Sweep at most every bucket once per tick, carrying on where the
+        // last sweep stopped
+        int bucketNum = __atomic_load_n(&hashMap->bucketNum, __ATOMIC_ACQUIRE);
+        for(int visited = 0; visited < bucketNum; visited++) {
+            if(visited % SPILL_CHECK_BUCKETS == 0 && HashMapResidentBytes() <= lowWatermark)
+                break;
+
+            cursor = (cursor + 1) % (uint32_t) bucketNum;
+            HashBucket *bucket = HashMapGetBucket(hashMap, cursor);
+            heads.clear();
+            // Heads are never freed while the map is alive
+            pthread_rwlock_rdlock(&bucket->bucketLock);
+            for(HashNodeHead *iter = bucket->nodeList; iter != NULL; iter = iter->nextHead)
+                if(iter->key.BlkNum >= 0 && iter->nextEle != NULL)
+                    heads.push_back(iter);
+            pthread_rwlock_unlock(&bucket->bucketLock);
+
+            for(size_t h = 0; h < heads.size(); h++) {
+                HashNodeHead *head = heads[h];
+                if(tick - __atomic_load_n(&head->accessTick, __ATOMIC_RELAXED) < SPILL_COLD_TICKS)
+                    continue;
+                // Whoever holds it is using the head, so it isn't cold
+                if(pthread_rwlock_trywrlock(&head->headLock) != 0)
+                    continue;
+                if(head->spilledEntryNum == 0 && head->nextEle != NULL)
+                    HashMapSpillChain(hashMap, head);
+                pthread_rwlock_unlock(&head->headLock);
+            }
+        }
+    }
+    return NULL;
+}
+
+void HashMapSetMemoryLimit(HashMap hashMap, uint64_t bytes) {
+    __atomic_store_n(&hashMap->memoryLimit, bytes, __ATOMIC_RELAXED);
+    if(bytes == 0 || __atomic_exchange_n(&hashMap->spillerStarted, 1, __ATOMIC_ACQ_REL) != 0)
+        return;
+
+    pthread_t tid;
+    pthread_create(&tid, NULL, HashMapSpillerMain, hashMap);
+    pthread_detach(tid);
+}
+
+void HashMapStartSpiller(HashMap hashMap) {
+    const char *limit = getenv("LOGINDEX_MEMORY_LIMIT_MB");
+    if(limit == NULL || atol(limit) <= 0)
+        return;
+
+    HashMapSetMemoryLimit(hashMap, (uint64_t) atol(limit) << 20);
+    printf("%s logindex memory limit = %lu MB\n", __func__, hashMap->memoryLimit >> 20);
+    fflush(stdout);
+}
+
+// Versions below minComputeLsn used to go only when their head was read or
+// replayed again. The sweeper visits every head each time the minimum moves.
+#define GC_SWEEP_IDLE_US HashMapComputeNodeHearbeatInterval_us
+// Pause this long after so many buckets, readers and the replayers first
+#define GC_SWEEP_YIELD_BUCKETS (64)
+#define GC_SWEEP_YIELD_US (1000)
+
+static void *HashMapGcSweeperMain(void *arg) {
+    HashMap hashMap = (HashMap) arg;
+    uint64_t sweptLsn = InvalidXLogRecPtr;
+    std::vector<HashNodeHead*> heads;
+
+    while(true) {
+        usleep(GC_SWEEP_IDLE_US);
+        uint64_t minComputeLsn = HashMapGetMinComputeLsn(hashMap);
+        if(minComputeLsn == InvalidXLogRecPtr || minComputeLsn <= sweptLsn)
+            continue;
+
+        // Re-read bucketNum every round, as HashMapForEachDirtyHead does
+        for(int pos = 0; pos < __atomic_load_n(&hashMap->bucketNum, __ATOMIC_ACQUIRE); pos++) {
+            if(pos > 0 && pos % GC_SWEEP_YIELD_BUCKETS == 0)
+                usleep(GC_SWEEP_YIELD_US);
+
+            HashBucket *bucket = HashMapGetBucket(hashMap, pos);
+            heads.clear();
+            // Heads are never freed while the map is alive
+            pthread_rwlock_rdlock(&bucket->bucketLock);
+            for(HashNodeHead *iter = bucket->nodeList; iter != NULL; iter = iter->nextHead)
+                if(iter->entryNum > 0 && iter->lsnEntry[0].lsn < minComputeLsn)
+                    heads.push_back(iter);
+            pthread_rwlock_unlock(&bucket->bucketLock);
+
+            for(size_t h = 0; h < heads.size(); h++) {
+                HashNodeHead *head = heads[h];
+                // Someone is using it, and collects it as well
+                if(pthread_rwlock_trywrlock(&head->headLock) != 0)
+                    continue;
+                // Compaction takes care of a spilled chain's versions
+                if(head->spilledEntryNum == 0)
+                    HashMapGarbageCollectNode(hashMap, head);
+                pthread_rwlock_unlock(&head->headLock);
+            }
+        }
+        sweptLsn = minComputeLsn;
+    }
+    return NULL;
+}
+
+void HashMapStartGcSweeper(HashMap hashMap) {
+    pthread_t tid;
+    pthread_create(&tid, NULL, HashMapGcSweeperMain, hashMap);
+    pthread_detach(tid);
 }
 
 void HashMapDestroy(HashMap hashMap){
     for(int i = 0; i < hashMap->bucketNum; i++) {
-        while (hashMap->bucketList[i].nodeList) {
-            HashNodeHead* head = hashMap->bucketList[i].nodeList;
+        HashBucket *bucket = HashMapGetBucket(hashMap, i);
+        while (bucket->nodeList) {
+            HashNodeHead* head = bucket->nodeList;
 
             while(head->nextEle) {
                 HashNodeEle* elemNode = head->nextEle;
                 head->nextEle = head->nextEle->nextEle;
-                free(elemNode);
+                LogindexSlabFreeEle(elemNode);
             }
 
-            hashMap->bucketList[i].nodeList = head->nextHead;
-            free(head);
+            bucket->nodeList = head->nextHead;
+            LogindexSlabFreeHead(head);
         }
     }
-    free(hashMap->bucketList);
+    for(int i = 0; i < HASH_MAX_SEGMENTS; i++)
+        free(hashMap->bucketSegments[i]);
+    free(hashMap->bucketSegments);
+    RelIndexDestroy(hashMap->relIndex);
+    free(hashMap->pageFilter);
     if(hashMap->computeNodeList != NULL)
         free(hashMap->computeNodeList);
     free(hashMap);
@@ -1133,34 +2014,96 @@ void HashMapDestroy(HashMap hashMap){
 //    return i+1;
 //}
 
+// Bytes a secondary may fall behind the newest node, 0 = no limit
+static uint64_t HashMapSecondaryMaxLagBytes() {
+    static uint64_t maxLagBytes = UINT64_MAX;
+
+    if(maxLagBytes == UINT64_MAX) {
+        const char *limit = getenv("SECONDARY_NODE_MAX_LAG_MB");
+        maxLagBytes = (limit != NULL && atol(limit) > 0) ? (uint64_t) atol(limit) << 20 : 0;
+    }
+    return maxLagBytes;
+}
+
+// Drops the nodes gone silent and the secondaries lagging past their limit,
+// then moves minComputeLsn and the RocksDB GC horizon to the slowest node
+// left. Needs computeNodeLock held for writing.
+static void HashMapRefreshComputeNodes(HashMap hashMap) {
+    timeval now;
+    gettimeofday(&now, NULL);
+    unsigned long now_usec = (now.tv_sec * 1000000ul) + now.tv_usec;
+    uint64_t newestLsn = InvalidXLogRecPtr;
+    int kept = 0;
+
+    for(int i = 0; i < hashMap->computeNodeNum; i++)
+        newestLsn = std::max(newestLsn, hashMap->computeNodeList[i].lsn);
+
+    hashMap->minComputeLsn = InvalidXLogRecPtr;
+    for(int i = 0; i < hashMap->computeNodeNum; i++){
+        ComputeNodeInfo *node = &hashMap->computeNodeList[i];
+        unsigned long active_usec = (node->activeTime.tv_sec * 1000000ul) + node->activeTime.tv_usec;
+
+        if(now_usec - active_usec > HashMapComputeNodeInactiveTimeout_us)
+            continue;
+        if(node->maxLagBytes > 0 && newestLsn - node->lsn > node->maxLagBytes){
+            printf("%s compute node %u lags %lu bytes behind, forced to re-sync\n", __func__, node->id, newestLsn - node->lsn);
+            fflush(stdout);
+            continue;
+        }
+        if(hashMap->minComputeLsn == InvalidXLogRecPtr || node->lsn < hashMap->minComputeLsn)
+            hashMap->minComputeLsn = node->lsn;
+        if(kept != i)
+            memcpy(&hashMap->computeNodeList[kept], node, sizeof(ComputeNodeInfo));
+        kept++;
+    }
+    if(hashMap->minComputeLsn != InvalidXLogRecPtr) {
+        uint64_t forkLsn = DbCloneOldestForkLsn(InvalidOid, InvalidOid);
+        KvSetPageGcHorizon(forkLsn != InvalidXLogRecPtr ? std::min(forkLsn, hashMap->minComputeLsn) : hashMap->minComputeLsn);
+    }
+    hashMap->computeNodeNum = kept;
+}
+
 int32_t HashMapRegisterSecondaryNode(HashMap hashMap, bool primary, uint64_t lsn){
     pthread_rwlock_wrlock(&hashMap->computeNodeLock);
+    // Versions older than the slowest node may already be collected, a node
+    // that isn't held to a lag must not start out behind it
+    if(primary && lsn < std::max<uint64_t>(KvGetPageGcHorizon(), hashMap->minComputeLsn)){
+        pthread_rwlock_unlock(&hashMap->computeNodeLock);
+        return -1;
+    }
     hashMap->computeNodeNum++;
     hashMap->computeNodeList = (ComputeNodeInfo*) realloc(hashMap->computeNodeList, sizeof(ComputeNodeInfo) * hashMap->computeNodeNum);
-    uint32_t id = hashMap->computeNodeNum <= 1 ? 0 : hashMap->computeNodeList[hashMap->computeNodeNum - 2].id;
-    hashMap->computeNodeList[hashMap->computeNodeNum - 1].id = id;
-    hashMap->computeNodeList[hashMap->computeNodeNum - 1].primary = primary;
-    hashMap->computeNodeList[hashMap->computeNodeNum - 1].active = true;
-    hashMap->computeNodeList[hashMap->computeNodeNum - 1].lsn = lsn;
-    gettimeofday(&hashMap->computeNodeList[hashMap->computeNodeNum - 1].activeTime, NULL);
+    ComputeNodeInfo *node = &hashMap->computeNodeList[hashMap->computeNodeNum - 1];
+    uint32_t id = hashMap->nextComputeNodeId++;
+    node->id = id;
+    node->primary = primary;
+    node->active = true;
+    node->lsn = lsn;
+    // The primary sets the pace, only secondaries are held to a lag
+    node->maxLagBytes = primary ? 0 : HashMapSecondaryMaxLagBytes();
+    gettimeofday(&node->activeTime, NULL);
     if(hashMap->minComputeLsn == InvalidXLogRecPtr || lsn < hashMap->minComputeLsn)
         hashMap->minComputeLsn = lsn;
     pthread_rwlock_unlock(&hashMap->computeNodeLock);
     return id;
 }
 
-void HashMapSecondaryNodeUpdatesLsn(HashMap hashMap, int32_t node_id, int64_t lsn){
+int32_t HashMapSecondaryNodeUpdatesLsn(HashMap hashMap, int32_t node_id, int64_t lsn){
+    bool found = false;
+
     pthread_rwlock_wrlock(&hashMap->computeNodeLock);
-    hashMap->minComputeLsn = InvalidXLogRecPtr;
     for(int i = 0; i < hashMap->computeNodeNum; i++){
-        if(hashMap->computeNodeList[i].id == node_id){
+        if(hashMap->computeNodeList[i].id == (uint32_t) node_id){
             hashMap->computeNodeList[i].lsn = lsn;
             gettimeofday(&hashMap->computeNodeList[i].activeTime, NULL);
         }
-        if(hashMap->computeNodeList[i].active && (hashMap->minComputeLsn == InvalidXLogRecPtr || hashMap->computeNodeList[i].lsn < hashMap->minComputeLsn))
-            hashMap->minComputeLsn = hashMap->computeNodeList[i].lsn;
     }
+    HashMapRefreshComputeNodes(hashMap);
+    for(int i = 0; i < hashMap->computeNodeNum; i++)
+        if(hashMap->computeNodeList[i].id == (uint32_t) node_id)
+            found = true;
     pthread_rwlock_unlock(&hashMap->computeNodeLock);
+    return found ? HASHMAP_NODE_OK : HASHMAP_NODE_RESYNC;
 }
 
 uint64_t HashMapGetMinComputeLsn(HashMap hashMap){
@@ -1177,29 +2120,10 @@ void HashMapClearInactiveComputeNode(HashMap hashMap){
         return;
     }
 
-    int inactive_cnt = 0;
-    timeval now;
-    gettimeofday(&now, NULL);
-    unsigned long now_usec = (now.tv_sec * 1000000ul) + now.tv_usec;
-
-    hashMap->minComputeLsn = InvalidXLogRecPtr;
-    for(int i = 0; i < hashMap->computeNodeNum; i++){
-        unsigned long active_usec = (hashMap->computeNodeList[i].activeTime.tv_sec * 1000000ul) + hashMap->computeNodeList[i].activeTime.tv_usec;
-        if(now_usec - active_usec > HashMapComputeNodeInactiveTimeout_us){
-            inactive_cnt++;
-            continue;
-        }
-        if(hashMap->minComputeLsn == InvalidXLogRecPtr || hashMap->computeNodeList[i].lsn < hashMap->minComputeLsn)
-            hashMap->minComputeLsn = hashMap->computeNodeList[i].lsn;
-        if(inactive_cnt > 0)
-            memcpy(&hashMap->computeNodeList[i - inactive_cnt], &hashMap->computeNodeList[i], sizeof(ComputeNodeInfo));
-    }
-    hashMap->computeNodeNum -= inactive_cnt;
+    HashMapRefreshComputeNodes(hashMap);
     if(hashMap->computeNodeNum <= 0){
         free(hashMap->computeNodeList);
         hashMap->computeNodeList = NULL;
     }
-    else
-        hashMap->computeNodeList = (ComputeNodeInfo*) realloc(hashMap->computeNodeList, hashMap->computeNodeNum * sizeof(ComputeNodeInfo));
     pthread_rwlock_unlock(&hashMap->computeNodeLock);
 }
@@ -0,0 +1,268 @@
+//
+// Priority queue of pages for background replay, see
+// access/logindex_hot_queue.h.
+//
+// A binary max-heap over a fixed pool of entries, with a chained hash index
+// from page to entry so repeated reads of a page bump the same entry. Decay
+// is applied lazily by whoever takes the lock next.
+//
+#include <pthread.h>
+#include "postgres.h"
+
+#include <time.h>
+
+#include "access/logindex_hot_queue.h"
+
+#define HOT_QUEUE_HASH_SIZE (LOGINDEX_HOT_QUEUE_SIZE * 2)
+#define HOT_QUEUE_NONE (-1)
+
+typedef struct HotQueueEntry {
+    KeyType     key;
+    uint32_t    score;
+    int         heapPos;
+    int         next;       // hash chain, or free list
+} HotQueueEntry;
+
+static pthread_mutex_t hot_queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static HotQueueEntry hot_queue_entries[LOGINDEX_HOT_QUEUE_SIZE];
+static int hot_queue_heap[LOGINDEX_HOT_QUEUE_SIZE];
+static int hot_queue_hash[HOT_QUEUE_HASH_SIZE];
+static int hot_queue_len = 0;
+static int hot_queue_free = HOT_QUEUE_NONE;
+static bool hot_queue_initialized = false;
+static uint64_t hot_queue_last_decay = 0;
+
+static uint64_t
+HotQueueNowMs(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static uint32_t
+HotQueueHash(const KeyType *key) {
+    uint64_t h = key->SpcID * 0x9E3779B97F4A7C15ull;
+
+    h ^= key->DbID + 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+    h ^= key->RelID + 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+    h ^= key->ForkNum + 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+    h ^= (uint64_t) key->BlkNum + 0xC2B2AE3D27D4EB4Full + (h << 6) + (h >> 2);
+    return (uint32_t) (h ^ (h >> 32)) % HOT_QUEUE_HASH_SIZE;
+}
+
+static bool
+HotQueueKeyEqual(const KeyType *a, const KeyType *b) {
+    return a->SpcID == b->SpcID && a->DbID == b->DbID && a->RelID == b->RelID
+           && a->ForkNum == b->ForkNum && a->BlkNum == b->BlkNum;
+}
+
+static void
+HotQueueInitLocked(void) {
+    for (int i = 0; i < HOT_QUEUE_HASH_SIZE; i++)
+        hot_queue_hash[i] = HOT_QUEUE_NONE;
+    for (int i = 0; i < LOGINDEX_HOT_QUEUE_SIZE; i++)
+        hot_queue_entries[i].next = i + 1 < LOGINDEX_HOT_QUEUE_SIZE ? i + 1 : HOT_QUEUE_NONE;
+    hot_queue_free = 0;
+    hot_queue_last_decay = HotQueueNowMs();
+    hot_queue_initialized = true;
+}
+
+static void
+HotQueueSwap(int a, int b) {
+    int tmp = hot_queue_heap[a];
+
+    hot_queue_heap[a] = hot_queue_heap[b];
+    hot_queue_heap[b] = tmp;
+    hot_queue_entries[hot_queue_heap[a]].heapPos = a;
+    hot_queue_entries[hot_queue_heap[b]].heapPos = b;
+}
+
+static void
+HotQueueSiftUp(int pos) {
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+
+        if (hot_queue_entries[hot_queue_heap[parent]].score >= hot_queue_entries[hot_queue_heap[pos]].score)
+            break;
+        HotQueueSwap(parent, pos);
+        pos = parent;
+    }
+}
+
+static void
+HotQueueSiftDown(int pos) {
+    while (true) {
+        int largest = pos;
+        int left = 2 * pos + 1;
+        int right = left + 1;
+
+        if (left < hot_queue_len
+            && hot_queue_entries[hot_queue_heap[left]].score > hot_queue_entries[hot_queue_heap[largest]].score)
+            largest = left;
+        if (right < hot_queue_len
+            && hot_queue_entries[hot_queue_heap[right]].score > hot_queue_entries[hot_queue_heap[largest]].score)
+            largest = right;
+        if (largest == pos)
+            break;
+        HotQueueSwap(pos, largest);
+        pos = largest;
+    }
+}
+
+// Drop the entry from the hash index and free it, leaving the heap alone
+static void
+HotQueueUnlink(int idx) {
+    HotQueueEntry *entry = &hot_queue_entries[idx];
+    int *link = &hot_queue_hash[HotQueueHash(&entry->key)];
+
+    while (*link != idx)
+        link = &hot_queue_entries[*link].next;
+    *link = entry->next;
+    entry->next = hot_queue_free;
+    hot_queue_free = idx;
+}
+
+// Remove the entry at heap position pos
+static void
+HotQueueRemoveAt(int pos) {
+    HotQueueUnlink(hot_queue_heap[pos]);
+
+    hot_queue_len--;
+    if (pos != hot_queue_len) {
+        hot_queue_heap[pos] = hot_queue_heap[hot_queue_len];
+        hot_queue_entries[hot_queue_heap[pos]].heapPos = pos;
+        HotQueueSiftDown(pos);
+        HotQueueSiftUp(pos);
+    }
+}
+
+static void
+HotQueueDecayLocked(uint64_t now) {
+    int kept;
+
+    if (now - hot_queue_last_decay < LOGINDEX_HOT_DECAY_MS)
+        return;
+
+    // Halve once per elapsed period, at most down to nothing
+    uint64_t periods = (now - hot_queue_last_decay) / LOGINDEX_HOT_DECAY_MS;
+    int shift = periods >= 32 ? 32 : (int) periods;
+
+    hot_queue_last_decay += periods * LOGINDEX_HOT_DECAY_MS;
+
+    // Halving keeps the order, but the entries that reach zero go, so
+    // compact the heap and re-heapify
+    kept = 0;
+    for (int i = 0; i < hot_queue_len; i++) {
+        int idx = hot_queue_heap[i];
+        HotQueueEntry *entry = &hot_queue_entries[idx];
+
+        entry->score = shift >= 32 ? 0 : entry->score >> shift;
+        if (entry->score == 0) {
+            HotQueueUnlink(idx);
+            continue;
+        }
+        entry->heapPos = kept;
+        hot_queue_heap[kept++] = idx;
+    }
+    hot_queue_len = kept;
+    for (int i = hot_queue_len / 2 - 1; i >= 0; i--)
+        HotQueueSiftDown(i);
+}
+
+void
+LogindexHotQueueRecord(KeyType key, uint32_t weight) {
+    uint32_t bucket = HotQueueHash(&key);
+
+    if (weight == 0)
+        return;
+
+    pthread_mutex_lock(&hot_queue_lock);
+    if (!hot_queue_initialized)
+        HotQueueInitLocked();
+    HotQueueDecayLocked(HotQueueNowMs());
+
+    for (int idx = hot_queue_hash[bucket]; idx != HOT_QUEUE_NONE; idx = hot_queue_entries[idx].next) {
+        HotQueueEntry *entry = &hot_queue_entries[idx];
+
+        if (HotQueueKeyEqual(&entry->key, &key)) {
+            entry->score = entry->score > UINT32_MAX - weight ? UINT32_MAX : entry->score + weight;
+            HotQueueSiftUp(entry->heapPos);
+            pthread_mutex_unlock(&hot_queue_lock);
+            return;
+        }
+    }
+
+    if (hot_queue_free == HOT_QUEUE_NONE) {
+        // Full: a plain read doesn't displace anything, a hot miss takes the
+        // place of the last heap entry, which is a leaf and so fairly cold
+        int last = hot_queue_len - 1;
+        if (hot_queue_entries[hot_queue_heap[last]].score >= weight) {
+            pthread_mutex_unlock(&hot_queue_lock);
+            return;
+        }
+        HotQueueRemoveAt(last);
+    }
+
+    int idx = hot_queue_free;
+    HotQueueEntry *entry = &hot_queue_entries[idx];
+
+    hot_queue_free = entry->next;
+    entry->key = key;
+    entry->score = weight;
+    entry->next = hot_queue_hash[bucket];
+    hot_queue_hash[bucket] = idx;
+    entry->heapPos = hot_queue_len;
+    hot_queue_heap[hot_queue_len++] = idx;
+    HotQueueSiftUp(entry->heapPos);
+    pthread_mutex_unlock(&hot_queue_lock);
+}
+
+int
+LogindexHotQueuePop(KeyType *keys, uint32_t *scores, int max) {
+    int n = 0;
+
+    pthread_mutex_lock(&hot_queue_lock);
+    if (hot_queue_initialized)
+        HotQueueDecayLocked(HotQueueNowMs());
+    while (n < max && hot_queue_len > 0) {
+        HotQueueEntry *top = &hot_queue_entries[hot_queue_heap[0]];
+
+        keys[n] = top->key;
+        scores[n] = top->score;
+        n++;
+        HotQueueRemoveAt(0);
+    }
+    pthread_mutex_unlock(&hot_queue_lock);
+    return n;
+}
+
+uint32_t
+LogindexHotQueueScore(KeyType key) {
+    uint32_t score = 0;
+
+    pthread_mutex_lock(&hot_queue_lock);
+    if (hot_queue_initialized) {
+        HotQueueDecayLocked(HotQueueNowMs());
+        for (int idx = hot_queue_hash[HotQueueHash(&key)]; idx != HOT_QUEUE_NONE; idx = hot_queue_entries[idx].next) {
+            if (HotQueueKeyEqual(&hot_queue_entries[idx].key, &key)) {
+                score = hot_queue_entries[idx].score;
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock(&hot_queue_lock);
+    return score;
+}
+
+int
+LogindexHotQueueLength(void) {
+    int len;
+
+    pthread_mutex_lock(&hot_queue_lock);
+    if (hot_queue_initialized)
+        HotQueueDecayLocked(HotQueueNowMs());
+    len = hot_queue_len;
+    pthread_mutex_unlock(&hot_queue_lock);
+    return len;
+}
@@ -0,0 +1,99 @@
+//
+// Lower-bound search kernels for element node lsn deltas,
+// see access/logindex_lsn_search.h.
+//
+#include <stdint.h>
+#include "access/logindex_lsn_search.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define LSN_SEARCH_AVX2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define LSN_SEARCH_NEON 1
+#endif
+
+int LsnDeltaFindLowerBoundScalar(const uint32_t *deltas, int n, uint32_t target) {
+    // Branch-free count, the compiler turns the comparison into setcc
+    int count = 0;
+    for(int i = 0; i < n; i++)
+        count += deltas[i] <= target;
+    return count - 1;
+}
+
+int LsnDeltaFindLowerBoundBinary(const uint32_t *deltas, int n, uint32_t target) {
+    int low = 0, high = n;
+    while(low < high) {
+        int mid = (low + high) / 2;
+        if(deltas[mid] <= target)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low - 1;
+}
+
+#ifdef LSN_SEARCH_AVX2
+__attribute__((target("avx2")))
+static int LsnDeltaFindLowerBoundAvx2(const uint32_t *deltas, int n, uint32_t target) {
+    // AVX2 only has signed compares: flip the sign bit of both sides
+    const __m256i bias = _mm256_set1_epi32((int) 0x80000000u);
+    const __m256i key = _mm256_xor_si256(_mm256_set1_epi32((int) target), bias);
+    int greater = 0;
+    int i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (deltas + i));
+        __m256i gt = _mm256_cmpgt_epi32(_mm256_xor_si256(v, bias), key);
+        greater += __builtin_popcount((unsigned) _mm256_movemask_ps(_mm256_castsi256_ps(gt)));
+    }
+    int count = i - greater;
+    for(; i < n; i++)
+        count += deltas[i] <= target;
+    return count - 1;
+}
+
+static bool LsnSearchHaveAvx2() {
+    static const bool haveAvx2 = __builtin_cpu_supports("avx2");
+    return haveAvx2;
+}
+#endif
+
+#ifdef LSN_SEARCH_NEON
+static int LsnDeltaFindLowerBoundNeon(const uint32_t *deltas, int n, uint32_t target) {
+    const uint32x4_t key = vdupq_n_u32(target);
+    uint32x4_t acc = vdupq_n_u32(0);
+    int i = 0;
+    for(; i + 4 <= n; i += 4) {
+        // Lanes are all-ones where delta <= target, i.e. -1 per hit
+        acc = vsubq_u32(acc, vcleq_u32(vld1q_u32(deltas + i), key));
+    }
+    int count = (int) vaddvq_u32(acc);
+    for(; i < n; i++)
+        count += deltas[i] <= target;
+    return count - 1;
+}
+#endif
+
+int LsnDeltaFindLowerBoundVector(const uint32_t *deltas, int n, uint32_t target) {
+#if defined(LSN_SEARCH_AVX2)
+    if(LsnSearchHaveAvx2())
+        return LsnDeltaFindLowerBoundAvx2(deltas, n, target);
+#elif defined(LSN_SEARCH_NEON)
+    return LsnDeltaFindLowerBoundNeon(deltas, n, target);
+#endif
+    return LsnDeltaFindLowerBoundScalar(deltas, n, target);
+}
+
+int LsnDeltaFindLowerBound(const uint32_t *deltas, int n, uint32_t target) {
+    return LsnDeltaFindLowerBoundVector(deltas, n, target);
+}
+
+const char* LsnDeltaSearchKernelName(void) {
+#if defined(LSN_SEARCH_AVX2)
+    if(LsnSearchHaveAvx2())
+        return "avx2";
+#elif defined(LSN_SEARCH_NEON)
+    return "neon";
+#endif
+    return "scalar";
+}
@@ -0,0 +1,90 @@
+//
+// Which replayed page versions are written to RocksDB, see
+// access/logindex_materialize.h.
+//
+// The write budget is a token bucket of page bytes, refilled at
+// LOGINDEX_MATERIALIZE_MB a second and holding at most a second's worth.
+// Forced versions take their bytes even when it is empty, so they hold the
+// others back until it refills.
+//
+#include <pthread.h>
+#include "postgres.h"
+
+#include <time.h>
+
+#include "access/logindex_materialize.h"
+
+static pthread_mutex_t materialize_lock = PTHREAD_MUTEX_INITIALIZER;
+static bool materialize_initialized = false;
+// Bytes a second, 0 = no limit
+static int64_t materialize_rate = 0;
+static int64_t materialize_tokens = 0;
+static uint64_t materialize_last_us = 0;
+static uint64_t materialize_count = 0;
+static uint64_t materialize_skipped = 0;
+
+static uint64_t
+MaterializeNowUs(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static void
+MaterializeInitLocked(void) {
+    const char *value = getenv("LOGINDEX_MATERIALIZE_MB");
+
+    if (value != NULL && atol(value) > 0)
+        materialize_rate = (int64_t) atol(value) << 20;
+    materialize_tokens = materialize_rate;
+    materialize_last_us = MaterializeNowUs();
+    materialize_initialized = true;
+}
+
+// Take a page's bytes off the budget, even past empty if forced
+static bool
+MaterializeTakeBudgetLocked(bool force) {
+    uint64_t now;
+
+    if (materialize_rate == 0)
+        return true;
+
+    now = MaterializeNowUs();
+    materialize_tokens += (int64_t) ((now - materialize_last_us) * materialize_rate / 1000000);
+    if (materialize_tokens > materialize_rate)
+        materialize_tokens = materialize_rate;
+    materialize_last_us = now;
+
+    if (materialize_tokens < BLCKSZ && !force)
+        return false;
+    materialize_tokens -= BLCKSZ;
+    return true;
+}
+
+bool
+LogindexShouldMaterialize(uint32_t score, int chainLen) {
+    bool force = chainLen >= LOGINDEX_MATERIALIZE_FORCE_CHAIN;
+    bool worth = force || chainLen >= LOGINDEX_MATERIALIZE_MIN_CHAIN
+                 || score >= LOGINDEX_MATERIALIZE_MIN_SCORE;
+    bool materialize;
+
+    pthread_mutex_lock(&materialize_lock);
+    if (!materialize_initialized)
+        MaterializeInitLocked();
+    materialize = worth && MaterializeTakeBudgetLocked(force);
+    if (materialize)
+        materialize_count++;
+    else
+        materialize_skipped++;
+    pthread_mutex_unlock(&materialize_lock);
+    return materialize;
+}
+
+void
+LogindexMaterializeCounts(uint64_t *materialized, uint64_t *skipped) {
+    pthread_mutex_lock(&materialize_lock);
+    *materialized = materialize_count;
+    *skipped = materialize_skipped;
+    pthread_mutex_unlock(&materialize_lock);
+}
@@ -0,0 +1,262 @@
+//
+// Parallel logindex insertion, see access/logindex_pipeline.h.
+//
+// Every queued version gets a sequence number from the (single) parser.
+// Each shard keeps the sequence number of its oldest version not inserted
+// yet, so "every version before seq is in the map" is a min() over shards.
+// The parser's progress goes into a FIFO of (lsn, seq) points, the lsn
+// being safe to publish once that min reaches seq; whichever thread moves
+// the min (a worker after a batch, or the parser itself) publishes.
+//
+#include <pthread.h>
+#include "postgres.h"
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "access/logindex_pipeline.h"
+#include "access/lsn_waiter.h"
+#include "access/page_change_feed.h"
+#include "storage/cpu_roles.h"
+#include "storage/shard_map.h"
+
+// Versions a worker takes per lock round trip
+#define PIPELINE_WORKER_BATCH 64
+
+typedef struct PipelineEntry {
+    KeyType     key;
+    XLogRecPtr  lsn;
+    uint64_t    seq;
+    bool        fullPage;
+} PipelineEntry;
+
+typedef struct PipelineShard {
+    pthread_mutex_t lock;
+    pthread_cond_t  notEmpty;
+    pthread_cond_t  notFull;    // also signalled when the shard drains
+    PipelineEntry  *entries;
+    uint64_t        head;       // versions queued
+    uint64_t        tail;       // versions inserted
+    // seq of the oldest version not inserted yet, UINT64_MAX when idle
+    uint64_t        pendingSeq;
+    pthread_t       thread;
+} PipelineShard;
+
+typedef struct PipelinePoint {
+    XLogRecPtr  lsn;
+    uint64_t    seq;            // safe once every version before seq is in
+} PipelinePoint;
+
+extern XLogRecPtr XLogParseUpto;
+
+static HashMap pipeline_map = NULL;
+static int pipeline_shard_num = 0;
+static PipelineShard *pipeline_shards = NULL;
+static pid_t pipeline_pid = 0;
+static uint64_t pipeline_seq = 0;   // parser only
+
+static pthread_mutex_t pipeline_frontier_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pipeline_frontier_not_full = PTHREAD_COND_INITIALIZER;
+static PipelinePoint *pipeline_points = NULL;
+static uint64_t pipeline_point_head = 0;
+static uint64_t pipeline_point_tail = 0;
+static int pipeline_point_size = 0;
+
+static uint64_t
+PipelineMinPending(void) {
+    uint64_t min = UINT64_MAX;
+
+    for (int i = 0; i < pipeline_shard_num; i++) {
+        uint64_t seq = __atomic_load_n(&pipeline_shards[i].pendingSeq, __ATOMIC_ACQUIRE);
+        if (seq < min)
+            min = seq;
+    }
+    return min;
+}
+
+// Called with pipeline_frontier_lock held, returns the lsn to announce
+static XLogRecPtr
+PipelinePublishLocked(void) {
+    uint64_t minPending = PipelineMinPending();
+    XLogRecPtr published = InvalidXLogRecPtr;
+
+    while (pipeline_point_tail < pipeline_point_head) {
+        PipelinePoint *point = &pipeline_points[pipeline_point_tail % pipeline_point_size];
+
+        if (point->seq > minPending)
+            break;
+        published = point->lsn;
+        pipeline_point_tail++;
+    }
+    if (published != InvalidXLogRecPtr) {
+        if (published > XLogParseUpto)
+            XLogParseUpto = published;
+        pthread_cond_signal(&pipeline_frontier_not_full);
+    }
+    return published;
+}
+
+static void
+PipelinePublish(void) {
+    XLogRecPtr published;
+
+    pthread_mutex_lock(&pipeline_frontier_lock);
+    published = PipelinePublishLocked();
+    pthread_mutex_unlock(&pipeline_frontier_lock);
+
+    if (published != InvalidXLogRecPtr)
+        LsnWaiterAdvance(XLogParseUpto);
+}
+
+static void *
+PipelineWorkerMain(void *arg) {
+    PipelineShard *shard = (PipelineShard *) arg;
+    PipelineEntry batch[PIPELINE_WORKER_BATCH];
+
+    CpuRoleBind(CPU_ROLE_PARSE, -1);
+    while (true) {
+        int n = 0;
+
+        pthread_mutex_lock(&shard->lock);
+        while (shard->tail == shard->head)
+            pthread_cond_wait(&shard->notEmpty, &shard->lock);
+        while (n < PIPELINE_WORKER_BATCH && shard->tail + n < shard->head) {
+            batch[n] = shard->entries[(shard->tail + n) % LOGINDEX_PIPELINE_QUEUE_SIZE];
+            n++;
+        }
+        pthread_mutex_unlock(&shard->lock);
+
+        for (int i = 0; i < n; i++)
+            HashMapInsertKey(pipeline_map, batch[i].key, batch[i].lsn, 0, true, batch[i].fullPage);
+
+        pthread_mutex_lock(&shard->lock);
+        shard->tail += n;
+        __atomic_store_n(&shard->pendingSeq,
+                         shard->tail < shard->head
+                         ? shard->entries[shard->tail % LOGINDEX_PIPELINE_QUEUE_SIZE].seq : UINT64_MAX,
+                         __ATOMIC_RELEASE);
+        pthread_cond_broadcast(&shard->notFull);
+        pthread_mutex_unlock(&shard->lock);
+
+        PipelinePublish();
+    }
+    return NULL;
+}
+
+void
+LogindexPipelineStart(HashMap hashMap) {
+    const char *value = getenv("LOGINDEX_INDEX_THREADS");
+    int threads = LOGINDEX_PIPELINE_DEFAULT_THREADS;
+
+    if (value != NULL)
+        threads = Min(Max(atoi(value), 0), LOGINDEX_PIPELINE_MAX_THREADS);
+
+    pipeline_map = hashMap;
+    pipeline_pid = getpid();
+    if (threads == 0)
+        return;
+
+    pipeline_shards = (PipelineShard *) calloc(threads, sizeof(PipelineShard));
+    for (int i = 0; i < threads; i++) {
+        PipelineShard *shard = &pipeline_shards[i];
+
+        pthread_mutex_init(&shard->lock, NULL);
+        pthread_cond_init(&shard->notEmpty, NULL);
+        pthread_cond_init(&shard->notFull, NULL);
+        shard->entries = (PipelineEntry *) malloc(sizeof(PipelineEntry) * LOGINDEX_PIPELINE_QUEUE_SIZE);
+        shard->pendingSeq = UINT64_MAX;
+    }
+    pipeline_point_size = threads * LOGINDEX_PIPELINE_QUEUE_SIZE;
+    pipeline_points = (PipelinePoint *) malloc(sizeof(PipelinePoint) * pipeline_point_size);
+
+    // Workers read the shard count, so publish it before they start
+    pipeline_shard_num = threads;
+    for (int i = 0; i < threads; i++)
+        pthread_create(&pipeline_shards[i].thread, NULL, PipelineWorkerMain, &pipeline_shards[i]);
+
+    printf("%s logindex insertion on %d threads\n", __func__, threads);
+    fflush(stdout);
+}
+
+void
+LogindexPipelineInsert(HashMap hashMap, KeyType key, XLogRecPtr lsn, bool fullPage) {
+    PageChangeFeedPublish(key, lsn);
+    // Versions of blocks another storage shard owns are its to index
+    if (!ShardMapOwns(key.SpcID, key.DbID, key.RelID, key.BlkNum, lsn))
+        return;
+    if (pipeline_shard_num == 0) {
+        HashMapInsertKey(hashMap, key, lsn, 0, true, fullPage);
+        return;
+    }
+
+    uint32_t hash = (uint32_t) (key.SpcID * 0x9E3779B1u) ^ (uint32_t) (key.DbID * 0x85EBCA77u) ^
+                    (uint32_t) (key.RelID * 0xC2B2AE3Du) ^ (uint32_t) (key.ForkNum * 0x27D4EB2Fu) ^
+                    (uint32_t) ((uint64_t) key.BlkNum * 0x165667B1u);
+    hash ^= hash >> 15;
+    PipelineShard *shard = &pipeline_shards[hash % pipeline_shard_num];
+
+    pthread_mutex_lock(&shard->lock);
+    while (shard->head - shard->tail >= LOGINDEX_PIPELINE_QUEUE_SIZE)
+        pthread_cond_wait(&shard->notFull, &shard->lock);
+    PipelineEntry *entry = &shard->entries[shard->head % LOGINDEX_PIPELINE_QUEUE_SIZE];
+    entry->key = key;
+    entry->lsn = lsn;
+    entry->seq = pipeline_seq;
+    entry->fullPage = fullPage;
+    if (shard->tail == shard->head)
+        __atomic_store_n(&shard->pendingSeq, pipeline_seq, __ATOMIC_RELEASE);
+    shard->head++;
+    pthread_cond_signal(&shard->notEmpty);
+    pthread_mutex_unlock(&shard->lock);
+
+    pipeline_seq++;
+}
+
+void
+LogindexPipelineAdvance(XLogRecPtr parsedUpto) {
+    XLogRecPtr published;
+
+    PageChangeFeedAdvance(parsedUpto);
+    if (pipeline_shard_num == 0) {
+        if (parsedUpto > XLogParseUpto)
+            XLogParseUpto = parsedUpto;
+        LsnWaiterAdvance(XLogParseUpto);
+        return;
+    }
+
+    pthread_mutex_lock(&pipeline_frontier_lock);
+    if (pipeline_point_tail < pipeline_point_head &&
+        pipeline_points[(pipeline_point_head - 1) % pipeline_point_size].seq == pipeline_seq) {
+        // Nothing queued since the last point, extend it
+        PipelinePoint *last = &pipeline_points[(pipeline_point_head - 1) % pipeline_point_size];
+        if (parsedUpto > last->lsn)
+            last->lsn = parsedUpto;
+    } else {
+        while (pipeline_point_head - pipeline_point_tail >= (uint64_t) pipeline_point_size)
+            pthread_cond_wait(&pipeline_frontier_not_full, &pipeline_frontier_lock);
+        pipeline_points[pipeline_point_head % pipeline_point_size].lsn = parsedUpto;
+        pipeline_points[pipeline_point_head % pipeline_point_size].seq = pipeline_seq;
+        pipeline_point_head++;
+    }
+    published = PipelinePublishLocked();
+    pthread_mutex_unlock(&pipeline_frontier_lock);
+
+    if (published != InvalidXLogRecPtr)
+        LsnWaiterAdvance(XLogParseUpto);
+}
+
+void
+LogindexPipelineDrain(void) {
+    if (pipeline_shard_num == 0 || getpid() != pipeline_pid)
+        return;
+
+    for (int i = 0; i < pipeline_shard_num; i++) {
+        PipelineShard *shard = &pipeline_shards[i];
+
+        pthread_mutex_lock(&shard->lock);
+        while (shard->tail < shard->head)
+            pthread_cond_wait(&shard->notFull, &shard->lock);
+        pthread_mutex_unlock(&shard->lock);
+    }
+    PipelinePublish();
+}
@@ -0,0 +1,166 @@
+//
+// Relation -> blocks index for the logindex hashmap,
+// see access/logindex_relindex.h.
+//
+#include "c.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unordered_map>
+#include <vector>
+#include "access/logindex_relindex.h"
+
+// Shards of the relation table, each with its own lock, so inserts into
+// different relations rarely meet
+#define REL_INDEX_SHARDS (64)
+
+struct RelIndexKey {
+    uint64_t SpcID;
+    uint64_t DbID;
+    uint64_t RelID;
+    uint32_t ForkNum;
+
+    bool operator==(const RelIndexKey &other) const {
+        return SpcID == other.SpcID && DbID == other.DbID
+               && RelID == other.RelID && ForkNum == other.ForkNum;
+    }
+};
+
+struct RelIndexKeyHash {
+    size_t operator()(const RelIndexKey &key) const {
+        uint64_t h = key.RelID * 0x9e3779b97f4a7c15ULL;
+        h ^= key.DbID + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h ^= key.SpcID + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h ^= key.ForkNum + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        return h;
+    }
+};
+
+// One bit per block
+struct RelBlocks {
+    pthread_rwlock_t lock;
+    std::vector<uint64_t> words;
+    int64_t count;
+};
+
+struct RelIndexShard {
+    pthread_rwlock_t lock;
+    std::unordered_map<RelIndexKey, RelBlocks*, RelIndexKeyHash> relations;
+};
+
+struct LogindexRelIndex {
+    RelIndexShard shards[REL_INDEX_SHARDS];
+};
+
+static RelIndexKey MakeRelIndexKey(const KeyType *key) {
+    RelIndexKey relKey;
+    relKey.SpcID = key->SpcID;
+    relKey.DbID = key->DbID;
+    relKey.RelID = key->RelID;
+    relKey.ForkNum = key->ForkNum;
+    return relKey;
+}
+
+static RelIndexShard* GetShard(LogindexRelIndex *index, const RelIndexKey &key) {
+    return &index->shards[RelIndexKeyHash()(key) % REL_INDEX_SHARDS];
+}
+
+static RelBlocks* FindRelBlocks(LogindexRelIndex *index, const RelIndexKey &key, bool create) {
+    RelIndexShard *shard = GetShard(index, key);
+    RelBlocks *rel = NULL;
+
+    pthread_rwlock_rdlock(&shard->lock);
+    auto it = shard->relations.find(key);
+    if(it != shard->relations.end())
+        rel = it->second;
+    pthread_rwlock_unlock(&shard->lock);
+    if(rel != NULL || !create)
+        return rel;
+
+    pthread_rwlock_wrlock(&shard->lock);
+    RelBlocks *&slot = shard->relations[key];
+    if(slot == NULL) {
+        slot = new RelBlocks();
+        pthread_rwlock_init(&slot->lock, NULL);
+        slot->count = 0;
+    }
+    rel = slot;
+    pthread_rwlock_unlock(&shard->lock);
+    return rel;
+}
+
+LogindexRelIndex* RelIndexCreate(void) {
+    LogindexRelIndex *index = new LogindexRelIndex();
+    for(int i = 0; i < REL_INDEX_SHARDS; i++)
+        pthread_rwlock_init(&index->shards[i].lock, NULL);
+    return index;
+}
+
+void RelIndexDestroy(LogindexRelIndex *index) {
+    if(index == NULL)
+        return;
+    for(int i = 0; i < REL_INDEX_SHARDS; i++) {
+        for(auto &it : index->shards[i].relations) {
+            pthread_rwlock_destroy(&it.second->lock);
+            delete it.second;
+        }
+        pthread_rwlock_destroy(&index->shards[i].lock);
+    }
+    delete index;
+}
+
+void RelIndexAddBlock(LogindexRelIndex *index, const KeyType *key) {
+    if(index == NULL || key->BlkNum < 0)
+        return;
+
+    RelBlocks *rel = FindRelBlocks(index, MakeRelIndexKey(key), true);
+    uint64_t word = (uint64_t) key->BlkNum >> 6;
+    uint64_t bit = (uint64_t) 1 << (key->BlkNum & 63);
+
+    pthread_rwlock_wrlock(&rel->lock);
+    if(rel->words.size() <= word)
+        rel->words.resize(word + 1, 0);
+    if(!(rel->words[word] & bit)) {
+        rel->words[word] |= bit;
+        rel->count++;
+    }
+    pthread_rwlock_unlock(&rel->lock);
+}
+
+int RelIndexGetBlocks(LogindexRelIndex *index, const KeyType *relKey, int64_t fromBlk,
+                      int64_t *blocks, int maxBlocks) {
+    if(index == NULL || maxBlocks <= 0)
+        return 0;
+    RelBlocks *rel = FindRelBlocks(index, MakeRelIndexKey(relKey), false);
+    if(rel == NULL)
+        return 0;
+    if(fromBlk < 0)
+        fromBlk = 0;
+
+    int found = 0;
+    pthread_rwlock_rdlock(&rel->lock);
+    size_t wordNum = rel->words.size();
+    for(size_t w = (size_t) fromBlk >> 6; w < wordNum && found < maxBlocks; w++) {
+        uint64_t bits = rel->words[w];
+        // Mask off blocks below fromBlk in its own word
+        if(w == ((size_t) fromBlk >> 6))
+            bits &= ~(uint64_t) 0 << (fromBlk & 63);
+        while(bits != 0 && found < maxBlocks) {
+            blocks[found++] = (int64_t) (w << 6) + __builtin_ctzll(bits);
+            bits &= bits - 1;
+        }
+    }
+    pthread_rwlock_unlock(&rel->lock);
+    return found;
+}
+
+int64_t RelIndexBlockCount(LogindexRelIndex *index, const KeyType *relKey) {
+    if(index == NULL)
+        return 0;
+    RelBlocks *rel = FindRelBlocks(index, MakeRelIndexKey(relKey), false);
+    if(rel == NULL)
+        return 0;
+    pthread_rwlock_rdlock(&rel->lock);
+    int64_t count = rel->count;
+    pthread_rwlock_unlock(&rel->lock);
+    return count;
+}
@@ -0,0 +1,124 @@
+//
+// Summaries of the pages resident on compute nodes, see
+// access/logindex_resident.h.
+//
+// Each node has a slot holding its last summary. A new summary is copied
+// out of the RPC's buffer before the slot's lock is taken, so a lookup of
+// the background replayer only waits for the pointers to be swapped.
+//
+#include <pthread.h>
+#include "postgres.h"
+
+#include <time.h>
+
+#include "access/logindex_resident.h"
+
+typedef struct ResidentSlot {
+    uint32_t nodeKey;
+    uint32_t blocks;
+    uint64_t expiresUs;
+    uint64_t *filter;
+} ResidentSlot;
+
+static pthread_rwlock_t resident_lock = PTHREAD_RWLOCK_INITIALIZER;
+static ResidentSlot resident_slots[RESIDENT_SUMMARY_MAX_NODES];
+// Any slot with a summary, so a node without compute nodes publishing
+// doesn't take the lock for every head
+static bool resident_any = false;
+static uint64_t resident_deferred = 0;
+
+static uint64_t
+ResidentNowUs(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+bool
+LogindexResidentPublish(const char *summary, size_t len) {
+    ResidentSummaryHeader header;
+    ResidentSlot *slot = NULL;
+    uint64_t *filter;
+    uint64_t *old;
+    uint64_t now;
+
+    if (len < sizeof(header))
+        return false;
+    memcpy(&header, summary, sizeof(header));
+    if (header.magic != RESIDENT_SUMMARY_MAGIC || header.blocks == 0
+        || (header.blocks & (header.blocks - 1)) != 0 || len != ResidentSummarySize(header.blocks))
+        return false;
+
+    filter = (uint64_t *) malloc(len - sizeof(header));
+    if (filter == NULL)
+        return false;
+    memcpy(filter, summary + sizeof(header), len - sizeof(header));
+    now = ResidentNowUs();
+
+    pthread_rwlock_wrlock(&resident_lock);
+    // The node's own slot, else a free or expired one, else the one that
+    // expires first
+    for (int i = 0; i < RESIDENT_SUMMARY_MAX_NODES && slot == NULL; i++)
+        if (resident_slots[i].filter != NULL && resident_slots[i].nodeKey == header.nodeKey)
+            slot = &resident_slots[i];
+    for (int i = 0; i < RESIDENT_SUMMARY_MAX_NODES && slot == NULL; i++)
+        if (resident_slots[i].filter == NULL || resident_slots[i].expiresUs <= now)
+            slot = &resident_slots[i];
+    if (slot == NULL) {
+        slot = &resident_slots[0];
+        for (int i = 1; i < RESIDENT_SUMMARY_MAX_NODES; i++)
+            if (resident_slots[i].expiresUs < slot->expiresUs)
+                slot = &resident_slots[i];
+    }
+    old = slot->filter;
+    slot->nodeKey = header.nodeKey;
+    slot->blocks = header.blocks;
+    slot->expiresUs = now + (uint64_t) header.ttlMs * 1000;
+    slot->filter = filter;
+    __atomic_store_n(&resident_any, true, __ATOMIC_RELEASE);
+    pthread_rwlock_unlock(&resident_lock);
+
+    free(old);
+    return true;
+}
+
+bool
+LogindexResidentContains(KeyType key) {
+    uint64_t hash;
+    uint64_t now;
+    bool found = false;
+
+    if (!__atomic_load_n(&resident_any, __ATOMIC_ACQUIRE) || key.BlkNum < 0)
+        return false;
+    hash = ResidentSummaryHash(key.SpcID, key.DbID, key.RelID, key.ForkNum, (uint32_t) key.BlkNum);
+    now = ResidentNowUs();
+
+    pthread_rwlock_rdlock(&resident_lock);
+    for (int i = 0; i < RESIDENT_SUMMARY_MAX_NODES && !found; i++) {
+        ResidentSlot *slot = &resident_slots[i];
+
+        if (slot->filter != NULL && slot->expiresUs > now)
+            found = ResidentSummaryTest(slot->filter, slot->blocks, hash);
+    }
+    pthread_rwlock_unlock(&resident_lock);
+    return found;
+}
+
+void
+LogindexResidentDeferred(void) {
+    __atomic_fetch_add(&resident_deferred, 1, __ATOMIC_RELAXED);
+}
+
+void
+LogindexResidentCounts(uint64_t *nodes, uint64_t *deferred) {
+    uint64_t now = ResidentNowUs();
+
+    *nodes = 0;
+    pthread_rwlock_rdlock(&resident_lock);
+    for (int i = 0; i < RESIDENT_SUMMARY_MAX_NODES; i++)
+        if (resident_slots[i].filter != NULL && resident_slots[i].expiresUs > now)
+            (*nodes)++;
+    pthread_rwlock_unlock(&resident_lock);
+    *deferred = __atomic_load_n(&resident_deferred, __ATOMIC_RELAXED);
+}
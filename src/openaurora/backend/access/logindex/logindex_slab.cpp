@@ -0,0 +1,148 @@
+//
+// Slab pools for the logindex hashmap nodes, see access/logindex_slab.h.
+//
+#include "c.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <atomic>
+#include <mutex>
+#include "access/logindex_slab.h"
+
+// Objects per chunk, and how many a thread keeps before handing a batch
+// back to the shared list.
+#define SLAB_CHUNK_OBJECTS 256
+#define SLAB_THREAD_CACHE_MAX 512
+#define SLAB_TRANSFER_BATCH 256
+#define SLAB_ALIGN 64
+
+// Free objects are chained through their first word.
+struct SlabFreeNode {
+    SlabFreeNode *next;
+};
+
+template<typename T>
+class NodeSlab {
+public:
+    T* Alloc() {
+        ThreadCache &cache = LocalCache();
+        if(cache.head == NULL)
+            Refill(cache);
+
+        SlabFreeNode *node = cache.head;
+        cache.head = node->next;
+        cache.count--;
+        inUse.fetch_add(1, std::memory_order_relaxed);
+        return reinterpret_cast<T*>(node);
+    }
+
+    void Free(T *obj) {
+        ThreadCache &cache = LocalCache();
+        SlabFreeNode *node = reinterpret_cast<SlabFreeNode*>(obj);
+        node->next = cache.head;
+        cache.head = node;
+        cache.count++;
+        inUse.fetch_sub(1, std::memory_order_relaxed);
+
+        // The vacuum threads free what the WAL-parse thread allocated, so
+        // surplus has to flow back to the shared list.
+        if(cache.count > SLAB_THREAD_CACHE_MAX)
+            Release(cache, SLAB_TRANSFER_BATCH);
+    }
+
+    uint64_t InUse() { return inUse.load(std::memory_order_relaxed); }
+    uint64_t Reserved() { return reserved.load(std::memory_order_relaxed); }
+
+private:
+    struct ThreadCache {
+        NodeSlab *owner;
+        SlabFreeNode *head;
+        int count;
+
+        ~ThreadCache() {
+            if(owner != NULL && count > 0)
+                owner->Release(*this, count);
+        }
+    };
+
+    ThreadCache &LocalCache() {
+        static thread_local ThreadCache cache = {NULL, NULL, 0};
+        cache.owner = this;
+        return cache;
+    }
+
+    void Refill(ThreadCache &cache) {
+        {
+            std::lock_guard<std::mutex> guard(sharedMutex);
+            int moved = 0;
+            while(sharedHead != NULL && moved < SLAB_TRANSFER_BATCH) {
+                SlabFreeNode *node = sharedHead;
+                sharedHead = node->next;
+                node->next = cache.head;
+                cache.head = node;
+                moved++;
+            }
+            cache.count += moved;
+        }
+        if(cache.head != NULL)
+            return;
+
+        // Shared list is empty too, carve a fresh chunk
+        size_t objSize = TYPEALIGN(SLAB_ALIGN, sizeof(T));
+        char *chunk = NULL;
+        if(posix_memalign((void**) &chunk, SLAB_ALIGN, objSize * SLAB_CHUNK_OBJECTS) != 0) {
+            fprintf(stderr, "%s: out of memory allocating logindex slab chunk\n", __func__);
+            abort();
+        }
+        for(int i = SLAB_CHUNK_OBJECTS - 1; i >= 0; i--) {
+            SlabFreeNode *node = reinterpret_cast<SlabFreeNode*>(chunk + i * objSize);
+            node->next = cache.head;
+            cache.head = node;
+        }
+        cache.count += SLAB_CHUNK_OBJECTS;
+        reserved.fetch_add(SLAB_CHUNK_OBJECTS, std::memory_order_relaxed);
+    }
+
+    void Release(ThreadCache &cache, int num) {
+        std::lock_guard<std::mutex> guard(sharedMutex);
+        for(int i = 0; i < num && cache.head != NULL; i++) {
+            SlabFreeNode *node = cache.head;
+            cache.head = node->next;
+            cache.count--;
+            node->next = sharedHead;
+            sharedHead = node;
+        }
+    }
+
+    std::mutex sharedMutex;
+    SlabFreeNode *sharedHead = NULL;
+    std::atomic<uint64_t> inUse{0};
+    std::atomic<uint64_t> reserved{0};
+};
+
+static NodeSlab<HashNodeHead> headSlab;
+static NodeSlab<HashNodeEle> eleSlab;
+
+HashNodeHead* LogindexSlabAllocHead(void) {
+    return headSlab.Alloc();
+}
+
+void LogindexSlabFreeHead(HashNodeHead *head) {
+    headSlab.Free(head);
+}
+
+HashNodeEle* LogindexSlabAllocEle(void) {
+    return eleSlab.Alloc();
+}
+
+void LogindexSlabFreeEle(HashNodeEle *ele) {
+    eleSlab.Free(ele);
+}
+
+void LogindexSlabGetStats(LogindexSlabStats *stats) {
+    stats->headInUse = headSlab.InUse();
+    stats->eleInUse = eleSlab.InUse();
+    stats->headReserved = headSlab.Reserved();
+    stats->eleReserved = eleSlab.Reserved();
+    stats->bytesReserved = stats->headReserved * TYPEALIGN(SLAB_ALIGN, sizeof(HashNodeHead))
+                           + stats->eleReserved * TYPEALIGN(SLAB_ALIGN, sizeof(HashNodeEle));
+}
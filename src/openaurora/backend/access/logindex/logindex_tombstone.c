@@ -0,0 +1,273 @@
+//
+// Lazy reclamation of dropped and truncated relations, see
+// access/logindex_tombstone.h.
+//
+// The tombstones are a small array under one mutex, drops are rare. The
+// reclaimer works off one batch at a time under sweepLock, so a tombstone
+// reclaimed on the spot never has a batch of it run twice; it looks its
+// tombstone up again by id once it holds the lock.
+//
+#include "postgres.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+#include "access/logindex_tombstone.h"
+#include "access/xlogdefs.h"
+#include "common/relpath.h"
+#include "storage/db_clone.h"
+#include "storage/kv_interface.h"
+
+// How often the reclaimer looks for a tombstone it may reclaim
+#define TOMBSTONE_IDLE_US (100 * 1000)
+// Blocks per batch, and the pause after one for the readers and replayers
+#define TOMBSTONE_BATCH_BLOCKS (256)
+#define TOMBSTONE_YIELD_US (1000)
+
+typedef enum TombstoneKind {
+    TOMBSTONE_DROP = 0,
+    TOMBSTONE_TRUNCATE
+} TombstoneKind;
+
+typedef struct LogindexTombstone {
+    uint64_t id;
+    TombstoneKind kind;
+    // The whole relation of a drop, the fork of a truncate
+    KeyType relKey;
+    // Of a drop
+    uint64_t lsn;
+    // Where the sweep goes on, a truncate starts at its first block
+    int nextFork;
+    int64_t nextBlk;
+    // A drop's pages go with range deletes, none left to delete one by one
+    bool rangeDeleted;
+} LogindexTombstone;
+
+static pthread_mutex_t tombstoneLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t sweepLock = PTHREAD_MUTEX_INITIALIZER;
+static LogindexTombstone tombstones[LOGINDEX_TOMBSTONE_MAX];
+static int tombstoneNum = 0;
+static uint64_t nextTombstoneId = 1;
+// Drops pending, read without the lock by LogindexTombstoneHides
+static int dropNum = 0;
+static HashMap tombstoneHashMap = NULL;
+
+static void TombstoneRelKey(KeyType *relKey, RelFileNode rnode, int fork) {
+    relKey->SpcID = rnode.spcNode;
+    relKey->DbID = rnode.dbNode;
+    relKey->RelID = rnode.relNode;
+    relKey->ForkNum = fork;
+    relKey->BlkNum = -1;
+}
+
+static bool TombstoneMatches(const LogindexTombstone *tombstone, RelFileNode rnode) {
+    return tombstone->relKey.SpcID == rnode.spcNode && tombstone->relKey.DbID == rnode.dbNode &&
+           tombstone->relKey.RelID == rnode.relNode;
+}
+
+static RelFileNode TombstoneRelFileNode(const LogindexTombstone *tombstone) {
+    RelFileNode rnode;
+
+    rnode.spcNode = (Oid) tombstone->relKey.SpcID;
+    rnode.dbNode = (Oid) tombstone->relKey.DbID;
+    rnode.relNode = (Oid) tombstone->relKey.RelID;
+    return rnode;
+}
+
+// Caller holds tombstoneLock
+static void TombstoneRemoveLocked(int index) {
+    if (tombstones[index].kind == TOMBSTONE_DROP)
+        __atomic_fetch_sub(&dropNum, 1, __ATOMIC_RELEASE);
+    tombstones[index] = tombstones[--tombstoneNum];
+}
+
+// Caller holds tombstoneLock
+static int TombstoneFindLocked(uint64_t id) {
+    for (int i = 0; i < tombstoneNum; i++) {
+        if (tombstones[i].id == id)
+            return i;
+    }
+    return -1;
+}
+
+// Whether nothing reads the dropped relation below its LSN any more
+static bool TombstoneReady(const LogindexTombstone *tombstone, uint64_t minComputeLsn) {
+    uint64_t forkLsn;
+
+    if (tombstone->kind == TOMBSTONE_TRUNCATE)
+        return true;
+    if (minComputeLsn == InvalidXLogRecPtr || minComputeLsn < tombstone->lsn)
+        return false;
+    forkLsn = DbCloneOldestForkLsn((Oid) tombstone->relKey.SpcID, (Oid) tombstone->relKey.DbID);
+    return forkLsn == InvalidXLogRecPtr || forkLsn >= tombstone->lsn;
+}
+
+// One batch of tombstone, returns true once it is reclaimed. Caller holds sweepLock
+static bool TombstoneReclaimStep(LogindexTombstone *tombstone) {
+    KeyType relKey = tombstone->relKey;
+
+    if (tombstone->kind == TOMBSTONE_TRUNCATE) {
+        HashMapGarbageCollectRelation(tombstoneHashMap, relKey, tombstone->nextBlk);
+        return true;
+    }
+
+    // Once before the sweep, telling whether the engine deletes ranges
+    if (tombstone->nextFork == 0 && tombstone->nextBlk == 0)
+        tombstone->rangeDeleted = DeleteRelationFromRocksdb(TombstoneRelFileNode(tombstone)) != 0;
+
+    relKey.ForkNum = tombstone->nextFork;
+    tombstone->nextBlk = HashMapDropRelation(tombstoneHashMap, relKey, tombstone->nextBlk, TOMBSTONE_BATCH_BLOCKS,
+                                             !tombstone->rangeDeleted);
+    if (tombstone->nextBlk >= 0)
+        return false;
+    tombstone->nextBlk = 0;
+    if (++tombstone->nextFork <= MAX_FORKNUM)
+        return false;
+
+    // And once after, for the versions the replayers wrote meanwhile
+    if (tombstone->rangeDeleted)
+        DeleteRelationFromRocksdb(TombstoneRelFileNode(tombstone));
+    return true;
+}
+
+static void TombstoneReclaimNow(LogindexTombstone *tombstone) {
+    pthread_mutex_lock(&sweepLock);
+    while (!TombstoneReclaimStep(tombstone))
+        ;
+    pthread_mutex_unlock(&sweepLock);
+}
+
+// Adds tombstone, false if the table is full
+static bool TombstoneAdd(LogindexTombstone *tombstone) {
+    bool added = false;
+
+    pthread_mutex_lock(&tombstoneLock);
+    if (tombstoneNum < LOGINDEX_TOMBSTONE_MAX) {
+        tombstone->id = nextTombstoneId++;
+        tombstones[tombstoneNum++] = *tombstone;
+        if (tombstone->kind == TOMBSTONE_DROP)
+            __atomic_fetch_add(&dropNum, 1, __ATOMIC_RELEASE);
+        added = true;
+    }
+    pthread_mutex_unlock(&tombstoneLock);
+    return added;
+}
+
+static void *LogindexTombstoneMain(void *arg) {
+    while (true) {
+        uint64_t minComputeLsn = HashMapGetMinComputeLsn(tombstoneHashMap);
+        LogindexTombstone tombstone;
+        uint64_t id = 0;
+        int index;
+
+        pthread_mutex_lock(&tombstoneLock);
+        for (int i = 0; i < tombstoneNum && id == 0; i++) {
+            if (TombstoneReady(&tombstones[i], minComputeLsn))
+                id = tombstones[i].id;
+        }
+        pthread_mutex_unlock(&tombstoneLock);
+        if (id == 0) {
+            usleep(TOMBSTONE_IDLE_US);
+            continue;
+        }
+
+        pthread_mutex_lock(&sweepLock);
+        pthread_mutex_lock(&tombstoneLock);
+        index = TombstoneFindLocked(id);
+        if (index >= 0)
+            tombstone = tombstones[index];
+        pthread_mutex_unlock(&tombstoneLock);
+        // Reclaimed on the spot meanwhile
+        if (index < 0) {
+            pthread_mutex_unlock(&sweepLock);
+            continue;
+        }
+
+        bool done = TombstoneReclaimStep(&tombstone);
+
+        pthread_mutex_lock(&tombstoneLock);
+        index = TombstoneFindLocked(id);
+        if (index >= 0) {
+            if (done)
+                TombstoneRemoveLocked(index);
+            else
+                tombstones[index] = tombstone;
+        }
+        pthread_mutex_unlock(&tombstoneLock);
+        pthread_mutex_unlock(&sweepLock);
+        usleep(TOMBSTONE_YIELD_US);
+    }
+    return NULL;
+}
+
+void LogindexTombstoneStart(HashMap hashMap) {
+    pthread_t tid;
+
+    tombstoneHashMap = hashMap;
+    pthread_create(&tid, NULL, LogindexTombstoneMain, NULL);
+    pthread_detach(tid);
+}
+
+void LogindexTombstoneDrop(RelFileNode rnode, uint64_t lsn) {
+    LogindexTombstone tombstone;
+
+    if (tombstoneHashMap == NULL)
+        return;
+    memset(&tombstone, 0, sizeof(tombstone));
+    tombstone.kind = TOMBSTONE_DROP;
+    TombstoneRelKey(&tombstone.relKey, rnode, 0);
+    tombstone.lsn = lsn;
+    if (!TombstoneAdd(&tombstone)) {
+        printf("%s %d tombstones pending, the versions of rel %u stay\n", __func__, LOGINDEX_TOMBSTONE_MAX,
+               rnode.relNode);
+        fflush(stdout);
+    }
+}
+
+void LogindexTombstoneTruncate(KeyType relKey, int64_t fromBlk) {
+    LogindexTombstone tombstone;
+
+    if (tombstoneHashMap == NULL)
+        return;
+    memset(&tombstone, 0, sizeof(tombstone));
+    tombstone.kind = TOMBSTONE_TRUNCATE;
+    tombstone.relKey = relKey;
+    tombstone.relKey.BlkNum = -1;
+    tombstone.nextBlk = fromBlk;
+    if (!TombstoneAdd(&tombstone))
+        TombstoneReclaimNow(&tombstone);
+}
+
+void LogindexTombstoneCreate(RelFileNode rnode) {
+    LogindexTombstone tombstone;
+    bool found = false;
+
+    if (__atomic_load_n(&dropNum, __ATOMIC_ACQUIRE) == 0)
+        return;
+    pthread_mutex_lock(&tombstoneLock);
+    for (int i = 0; i < tombstoneNum; i++) {
+        if (tombstones[i].kind == TOMBSTONE_DROP && TombstoneMatches(&tombstones[i], rnode)) {
+            tombstone = tombstones[i];
+            TombstoneRemoveLocked(i);
+            found = true;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&tombstoneLock);
+    if (found)
+        TombstoneReclaimNow(&tombstone);
+}
+
+bool LogindexTombstoneHides(RelFileNode rnode, uint64_t lsn) {
+    bool hidden = false;
+
+    if (__atomic_load_n(&dropNum, __ATOMIC_ACQUIRE) == 0)
+        return false;
+    pthread_mutex_lock(&tombstoneLock);
+    for (int i = 0; i < tombstoneNum && !hidden; i++) {
+        hidden = tombstones[i].kind == TOMBSTONE_DROP && TombstoneMatches(&tombstones[i], rnode) &&
+                 lsn >= tombstones[i].lsn;
+    }
+    pthread_mutex_unlock(&tombstoneLock);
+    return hidden;
+}
@@ -0,0 +1,191 @@
+//
+// LSN waiter registry.
+//
+// Rpc server threads that need a page at an LSN the startup process has not
+// parsed yet register here and sleep on their own condition variable. The
+// waiters are kept in a min-heap ordered by target LSN, so the parser only
+// has to look at the heap top after advancing XLogParseUpto and can wake
+// exactly the waiters whose LSN has been reached.
+//
+#include <pthread.h>
+#include "postgres.h"
+
+#include <errno.h>
+#include <time.h>
+
+#include "access/lsn_waiter.h"
+#include "port/atomics.h"
+
+#define LSN_WAITER_MAX 1024
+
+typedef struct LsnWaiter {
+    XLogRecPtr      targetLsn;
+    pthread_cond_t  cond;
+    bool            woken;
+} LsnWaiter;
+
+extern XLogRecPtr XLogParseUpto;
+extern int reachXlogTempEnd;
+
+static pthread_mutex_t  lsn_waiter_mutex = PTHREAD_MUTEX_INITIALIZER;
+static LsnWaiter       *lsn_waiter_heap[LSN_WAITER_MAX];
+static int              lsn_waiter_count = 0;
+
+// Smallest registered target, readable without the mutex so that the parser
+// can skip locking when nobody is waiting for what it just parsed.
+static volatile XLogRecPtr lsn_waiter_min = PG_UINT64_MAX;
+
+static void
+HeapSwap(int a, int b) {
+    LsnWaiter *tmp = lsn_waiter_heap[a];
+    lsn_waiter_heap[a] = lsn_waiter_heap[b];
+    lsn_waiter_heap[b] = tmp;
+}
+
+static void
+HeapPush(LsnWaiter *waiter) {
+    int i = lsn_waiter_count++;
+
+    lsn_waiter_heap[i] = waiter;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (lsn_waiter_heap[parent]->targetLsn <= lsn_waiter_heap[i]->targetLsn)
+            break;
+        HeapSwap(parent, i);
+        i = parent;
+    }
+}
+
+static void
+HeapRemoveAt(int i) {
+    lsn_waiter_count--;
+    if (i == lsn_waiter_count)
+        return;
+
+    lsn_waiter_heap[i] = lsn_waiter_heap[lsn_waiter_count];
+
+    // Sift up, then down; only one of them will move the element.
+    while (i > 0 && lsn_waiter_heap[(i - 1) / 2]->targetLsn > lsn_waiter_heap[i]->targetLsn) {
+        HeapSwap((i - 1) / 2, i);
+        i = (i - 1) / 2;
+    }
+    for (;;) {
+        int left = 2 * i + 1;
+        int right = left + 1;
+        int smallest = i;
+
+        if (left < lsn_waiter_count &&
+            lsn_waiter_heap[left]->targetLsn < lsn_waiter_heap[smallest]->targetLsn)
+            smallest = left;
+        if (right < lsn_waiter_count &&
+            lsn_waiter_heap[right]->targetLsn < lsn_waiter_heap[smallest]->targetLsn)
+            smallest = right;
+        if (smallest == i)
+            break;
+        HeapSwap(i, smallest);
+        i = smallest;
+    }
+}
+
+static void
+HeapRemove(LsnWaiter *waiter) {
+    int i;
+
+    for (i = 0; i < lsn_waiter_count; i++) {
+        if (lsn_waiter_heap[i] == waiter) {
+            HeapRemoveAt(i);
+            return;
+        }
+    }
+}
+
+static void
+UpdateMin(void) {
+    if (lsn_waiter_count > 0)
+        lsn_waiter_min = lsn_waiter_heap[0]->targetLsn;
+    else
+        lsn_waiter_min = PG_UINT64_MAX;
+}
+
+bool LsnWaiterWait(XLogRecPtr targetLsn, uint32_t wait_usec) {
+    LsnWaiter waiter;
+    struct timespec ts;
+    int rc = 0;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += wait_usec / 1000000;
+    ts.tv_nsec += (long) (wait_usec % 1000000) * 1000;
+    if (ts.tv_nsec >= 1000000000) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    waiter.targetLsn = targetLsn;
+    waiter.woken = false;
+    pthread_cond_init(&waiter.cond, NULL);
+
+    pthread_mutex_lock(&lsn_waiter_mutex);
+
+    if (lsn_waiter_count >= LSN_WAITER_MAX) {
+        // Registry is full, degrade to a plain timed sleep.
+        while (!waiter.woken && rc != ETIMEDOUT)
+            rc = pthread_cond_timedwait(&waiter.cond, &lsn_waiter_mutex, &ts);
+        pthread_mutex_unlock(&lsn_waiter_mutex);
+        pthread_cond_destroy(&waiter.cond);
+        return false;
+    }
+
+    HeapPush(&waiter);
+    UpdateMin();
+
+    // Pairs with the barrier in LsnWaiterAdvance: either the parser sees our
+    // target, or we see its new XLogParseUpto here.
+    pg_memory_barrier();
+
+    if (XLogParseUpto >= targetLsn || reachXlogTempEnd)
+        waiter.woken = true;
+
+    while (!waiter.woken && rc != ETIMEDOUT)
+        rc = pthread_cond_timedwait(&waiter.cond, &lsn_waiter_mutex, &ts);
+
+    if (!waiter.woken) {
+        HeapRemove(&waiter);
+        UpdateMin();
+    }
+
+    pthread_mutex_unlock(&lsn_waiter_mutex);
+    pthread_cond_destroy(&waiter.cond);
+
+    return waiter.woken;
+}
+
+void LsnWaiterAdvance(XLogRecPtr parsedUpto) {
+    pg_memory_barrier();
+
+    if (parsedUpto < lsn_waiter_min)
+        return;
+
+    pthread_mutex_lock(&lsn_waiter_mutex);
+    while (lsn_waiter_count > 0 && lsn_waiter_heap[0]->targetLsn <= parsedUpto) {
+        LsnWaiter *waiter = lsn_waiter_heap[0];
+
+        HeapRemoveAt(0);
+        waiter->woken = true;
+        pthread_cond_signal(&waiter->cond);
+    }
+    UpdateMin();
+    pthread_mutex_unlock(&lsn_waiter_mutex);
+}
+
+void LsnWaiterWakeAll(void) {
+    int i;
+
+    pthread_mutex_lock(&lsn_waiter_mutex);
+    for (i = 0; i < lsn_waiter_count; i++) {
+        lsn_waiter_heap[i]->woken = true;
+        pthread_cond_signal(&lsn_waiter_heap[i]->cond);
+    }
+    lsn_waiter_count = 0;
+    UpdateMin();
+    pthread_mutex_unlock(&lsn_waiter_mutex);
+}
@@ -0,0 +1,162 @@
+//
+// Page change feed of the storage node, see access/page_change_feed.h.
+//
+// There is one parser thread, the only writer. RPC threads read under
+// feed_lock, which the writer holds only to add an entry or move upto.
+//
+#include <pthread.h>
+#include "postgres.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "access/page_change_feed.h"
+#include "access/xlogreader.h"
+
+static pthread_mutex_t feed_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t feed_changed = PTHREAD_COND_INITIALIZER;
+static PageChangeFeedEntry *feed_ring = NULL;
+static uint64_t feed_size = 0;
+static uint64_t feed_head = 0;      // entries published
+static XLogRecPtr feed_since = InvalidXLogRecPtr;
+static XLogRecPtr feed_upto = InvalidXLogRecPtr;
+static int feed_waiters = 0;
+// Set by the first reader, read by the parser without the lock
+static bool feed_active = false;
+
+static void
+PageChangeFeedActivateLocked(void) {
+    const char *value = getenv("PAGE_CHANGE_FEED_ENTRIES");
+    uint64_t size = PAGE_CHANGE_FEED_DEFAULT_ENTRIES;
+
+    if (feed_ring != NULL)
+        return;
+    if (value != NULL && atol(value) > 0)
+        size = (uint64_t) atol(value);
+    feed_ring = (PageChangeFeedEntry *) malloc(sizeof(PageChangeFeedEntry) * size);
+    if (feed_ring == NULL)
+        return;
+    feed_size = size;
+    __atomic_store_n(&feed_active, true, __ATOMIC_RELEASE);
+}
+
+void
+PageChangeFeedPublish(KeyType key, XLogRecPtr lsn) {
+    PageChangeFeedEntry *entry;
+
+    if (!__atomic_load_n(&feed_active, __ATOMIC_ACQUIRE))
+        return;
+
+    pthread_mutex_lock(&feed_lock);
+    entry = &feed_ring[feed_head % feed_size];
+    entry->lsn = lsn;
+    entry->spcNode = (uint32_t) key.SpcID;
+    entry->dbNode = (uint32_t) key.DbID;
+    entry->relNode = (uint32_t) key.RelID;
+    entry->blockNum = (uint32_t) key.BlkNum;
+    entry->forkNum = (int32_t) key.ForkNum;
+    feed_head++;
+    pthread_mutex_unlock(&feed_lock);
+}
+
+void
+PageChangeFeedPublishRecord(XLogReaderState *record) {
+    if (!__atomic_load_n(&feed_active, __ATOMIC_ACQUIRE))
+        return;
+
+    for (int block_id = 0; block_id <= record->max_block_id; block_id++) {
+        RelFileNode rnode;
+        ForkNumber forknum;
+        BlockNumber blkno;
+        KeyType key;
+
+        if (!XLogRecGetBlockTag(record, block_id, &rnode, &forknum, &blkno))
+            continue;
+        key.SpcID = rnode.spcNode;
+        key.DbID = rnode.dbNode;
+        key.RelID = rnode.relNode;
+        key.ForkNum = forknum;
+        key.BlkNum = blkno;
+        PageChangeFeedPublish(key, record->ReadRecPtr);
+    }
+}
+
+void
+PageChangeFeedAdvance(XLogRecPtr parsedUpto) {
+    if (!__atomic_load_n(&feed_active, __ATOMIC_ACQUIRE))
+        return;
+
+    pthread_mutex_lock(&feed_lock);
+    // Versions of the record being parsed when the feed came up may have
+    // been missed, it only vouches for the records after it
+    if (feed_since == InvalidXLogRecPtr)
+        feed_since = parsedUpto;
+    if (parsedUpto > feed_upto)
+        feed_upto = parsedUpto;
+    if (feed_waiters > 0)
+        pthread_cond_broadcast(&feed_changed);
+    pthread_mutex_unlock(&feed_lock);
+}
+
+size_t
+PageChangeFeedReplySize(int maxEntries) {
+    return sizeof(PageChangeFeedHeader) +
+           sizeof(PageChangeFeedEntry) * Min(Max(maxEntries, 0), PAGE_CHANGE_FEED_MAX_BATCH);
+}
+
+size_t
+PageChangeFeedRead(uint64_t fromSeq, int maxEntries, int waitMs, char *buf) {
+    PageChangeFeedHeader header;
+    uint64_t count;
+
+    maxEntries = Min(Max(maxEntries, 0), PAGE_CHANGE_FEED_MAX_BATCH);
+
+    pthread_mutex_lock(&feed_lock);
+    PageChangeFeedActivateLocked();
+    if (feed_ring == NULL) {
+        pthread_mutex_unlock(&feed_lock);
+        return 0;
+    }
+
+    // Nothing new, wait for the parser a little
+    if (waitMs > 0 && feed_head <= fromSeq) {
+        XLogRecPtr upto = feed_upto;
+        struct timeval now;
+        struct timespec deadline;
+
+        gettimeofday(&now, NULL);
+        deadline.tv_sec = now.tv_sec + waitMs / 1000;
+        deadline.tv_nsec = (long) now.tv_usec * 1000 + (long) (waitMs % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        feed_waiters++;
+        while (feed_head <= fromSeq && feed_upto == upto)
+            if (pthread_cond_timedwait(&feed_changed, &feed_lock, &deadline) != 0)
+                break;
+        feed_waiters--;
+    }
+
+    header.flags = 0;
+    // A secondary ahead of the feed, one following an earlier storage
+    // server, starts over as well
+    if (fromSeq > feed_head || (feed_head > feed_size && fromSeq < feed_head - feed_size)) {
+        header.flags |= PAGE_CHANGE_FEED_OVERFLOW;
+        fromSeq = feed_head > feed_size ? feed_head - feed_size : 0;
+    }
+    count = Min(feed_head - fromSeq, (uint64_t) maxEntries);
+    for (uint64_t i = 0; i < count; i++)
+        memcpy(buf + sizeof(header) + sizeof(PageChangeFeedEntry) * i,
+               &feed_ring[(fromSeq + i) % feed_size], sizeof(PageChangeFeedEntry));
+    header.nextSeq = fromSeq + count;
+    header.since = feed_since;
+    header.count = (uint32_t) count;
+    // Cut short, complete up to the first record left out
+    header.upto = header.nextSeq < feed_head ? feed_ring[header.nextSeq % feed_size].lsn : feed_upto;
+    pthread_mutex_unlock(&feed_lock);
+
+    memcpy(buf, &header, sizeof(header));
+    return sizeof(header) + sizeof(PageChangeFeedEntry) * count;
+}
@@ -33,6 +33,18 @@
 /* GUC variables */
 char	   *default_table_access_method = DEFAULT_TABLE_ACCESS_METHOD;
 bool		synchronize_seqscans = true;
+int			rpc_parallel_scan_chunk = 64;
+
+extern int	IsRpcClient;
+
+/*
+ * Parallel scans of a compute node hand out blocks in chunks, read through
+ * read streams a batch at a time.  Chunks get smaller towards the end of the
+ * scan so that the workers finish together, see
+ * table_block_parallelscan_nextpage().
+ */
+#define PARALLEL_SEQSCAN_RAMPDOWN_CHUNKS	64
+#define PARALLEL_SEQSCAN_MAX_CHUNK_SIZE		8192
 
 
 /* ----------------------------------------------------------------------------
@@ -408,10 +420,20 @@ table_block_parallelscan_reinitialize(Relation rel, ParallelTableScanDesc pscan)
  * to set the startblock once.
  */
 void
-table_block_parallelscan_startblock_init(Relation rel, ParallelBlockTableScanDesc pbscan)
+table_block_parallelscan_startblock_init(Relation rel,
+										 ParallelBlockTableScanWorker pbscanwork,
+										 ParallelBlockTableScanDesc pbscan)
 {
 	BlockNumber sync_startpage = InvalidBlockNumber;
 
+	/* Every block on its own unless round trips are worth saving */
+	pbscanwork->phsw_nallocated = 0;
+	pbscanwork->phsw_chunk_remaining = 0;
+	pbscanwork->phsw_chunk_size = 1;
+	if (IsRpcClient && !RelationUsesLocalBuffers(rel))
+		pbscanwork->phsw_chunk_size = Min(rpc_parallel_scan_chunk,
+										  PARALLEL_SEQSCAN_MAX_CHUNK_SIZE);
+
 retry:
 	/* Grab the spinlock. */
 	SpinLockAcquire(&pbscan->phs_mutex);
@@ -449,9 +471,14 @@ retry:
  * another backend could have grabbed a page to scan and not yet finished
  * looking at it, so it doesn't follow that the scan is done when the first
  * backend gets an InvalidBlockNumber return.
+ *
+ * A backend is allocated phsw_chunk_size consecutive pages at a time and
+ * returns them one by one before it allocates the next chunk.
  */
 BlockNumber
-table_block_parallelscan_nextpage(Relation rel, ParallelBlockTableScanDesc pbscan)
+table_block_parallelscan_nextpage(Relation rel,
+								  ParallelBlockTableScanWorker pbscanwork,
+								  ParallelBlockTableScanDesc pbscan)
 {
 	BlockNumber page;
 	uint64		nallocated;
@@ -471,7 +498,30 @@ table_block_parallelscan_nextpage(Relation rel, ParallelBlockTableScanDesc pbsca
 	 * The actual page to return is calculated by adding the counter to the
 	 * starting block number, modulo nblocks.
 	 */
-	nallocated = pg_atomic_fetch_add_u64(&pbscan->phs_nallocated, 1);
+	if (pbscanwork->phsw_chunk_remaining > 0)
+	{
+		/* Go on with the chunk we have */
+		pbscanwork->phsw_chunk_remaining--;
+		nallocated = ++pbscanwork->phsw_nallocated;
+	}
+	else
+	{
+		/*
+		 * Halve the chunk size once the pages left are fewer than a few
+		 * chunks' worth, so that no worker is still reading a big chunk long
+		 * after the others ran out.
+		 */
+		if (pbscanwork->phsw_chunk_size > 1 &&
+			pbscanwork->phsw_nallocated + (uint64) pbscanwork->phsw_chunk_size *
+			PARALLEL_SEQSCAN_RAMPDOWN_CHUNKS > pbscan->phs_nblocks)
+			pbscanwork->phsw_chunk_size >>= 1;
+
+		nallocated = pbscanwork->phsw_nallocated =
+			pg_atomic_fetch_add_u64(&pbscan->phs_nallocated,
+									pbscanwork->phsw_chunk_size);
+		pbscanwork->phsw_chunk_remaining = pbscanwork->phsw_chunk_size - 1;
+	}
+
 	if (nallocated >= pbscan->phs_nblocks)
 		page = InvalidBlockNumber;	/* all blocks have been allocated */
 	else
@@ -18,7 +18,10 @@
 #include "access/table.h"
 #include "access/toast_helper.h"
 #include "access/toast_internals.h"
+#include "catalog/catalog.h"
 #include "catalog/pg_type_d.h"
+#include "utils/attoptcache.h"
+#include "utils/rel.h"
 
 
 /*
@@ -217,6 +220,30 @@ toast_tuple_find_biggest_attribute(ToastTupleContext *ttc,
 	return biggest_attno;
 }
 
+/*
+ * Get the compression method set for an attribute by its "compression"
+ * option, or TOAST_INVALID_COMPRESSION_ID to use the default.  System
+ * catalogs always use the default; looking up their attribute options might
+ * recurse into the catalog being updated.
+ */
+static int
+toast_attribute_compression(Relation rel, int attribute)
+{
+	AttributeOpts *aopt;
+	int			cmethod;
+
+	if (rel == NULL || IsCatalogRelation(rel))
+		return TOAST_INVALID_COMPRESSION_ID;
+
+	aopt = get_attribute_options(RelationGetRelid(rel), attribute + 1);
+	if (aopt == NULL)
+		return TOAST_INVALID_COMPRESSION_ID;
+	cmethod = aopt->compression;
+	pfree(aopt);
+
+	return cmethod;
+}
+
 /*
  * Try compression for an attribute.
  *
@@ -226,9 +253,13 @@ void
 toast_tuple_try_compression(ToastTupleContext *ttc, int attribute)
 {
 	Datum	   *value = &ttc->ttc_values[attribute];
-	Datum		new_value = toast_compress_datum(*value);
+	Datum		new_value;
 	ToastAttrInfo *attr = &ttc->ttc_attr[attribute];
 
+	new_value = toast_compress_datum(*value,
+									 toast_attribute_compression(ttc->ttc_rel,
+																 attribute));
+
 	if (DatumGetPointer(new_value) != NULL)
 	{
 		/* successful compression */
@@ -87,6 +87,9 @@ static SlruCtlData XactCtlData;
 
 #define XactCtl (&XactCtlData)
 
+/* GUC variable, zero sizes the buffers from shared_buffers */
+int			transaction_buffers = 0;
+
 
 static int	ZeroCLOGPage(int pageno, bool writeXlog);
 static bool CLOGPagePrecedes(int page1, int page2);
@@ -670,11 +673,14 @@ TransactionIdGetStatus(TransactionId xid, XLogRecPtr *lsn)
  * required to start, which could be a problem for people running very small
  * configurations.  The following formula seems to represent a reasonable
  * compromise: people with very low values for shared_buffers will get fewer
- * CLOG buffers as well, and everyone else will get 128.
+ * CLOG buffers as well, and everyone else will get 128.  Setting
+ * transaction_buffers overrides the formula.
  */
 Size
 CLOGShmemBuffers(void)
 {
+	if (transaction_buffers > 0)
+		return transaction_buffers;
 	return Min(128, Max(4, NBuffers / 512));
 }
 
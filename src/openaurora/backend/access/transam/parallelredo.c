@@ -0,0 +1,457 @@
+/*-------------------------------------------------------------------------
+ * parallelredo.c
+ *	   Parallel page redo of a compute node's hot standby
+ *
+ * Portions Copyright (c) 1996-2020, PostgreSQL Global Development Group
+ *
+ * IDENTIFICATION
+ *	  src/backend/access/transam/parallelredo.c
+ *
+ * NOTES
+ *	  A compute node's standby redoes a record only on those of its pages
+ *	  that are in shared buffers, whatever else is read later comes from the
+ *	  storage node, which replays the WAL itself.  With rpc_redo_workers set,
+ *	  the startup process hands those pages to as many redo workers instead
+ *	  of redoing them one after the other.  A page always goes to the worker
+ *	  its BufferTag hashes to, over a shm_mq, so the records of a page are
+ *	  redone in WAL order.  The pages of a record changing several of them
+ *	  may go to different workers, each is sent the record whole along with
+ *	  the pages it is to redo of it, and decodes it again.
+ *
+ *	  A record changing no page in buffers, a commit or a relation created
+ *	  or dropped among them, is a barrier: the startup process waits until
+ *	  the workers redid everything sent to them before it replays the record
+ *	  itself.  A transaction is thus only seen committed once its changes
+ *	  are in buffers.  The replay position reported is the end of the last
+ *	  record of which every page is redone, and before the startup process
+ *	  waits for more WAL it waits for the workers, so the position catches
+ *	  up with what was read.
+ *
+ *	  A page evicted after it was handed to a worker is read again by that
+ *	  worker, from the storage node or the caches behind shared buffers, and
+ *	  the redo of a page is skipped if the page is already past the record.
+ *
+ *	  The workers are started as the first page is sent and stop as the
+ *	  startup process detaches from their queues at the end of recovery.  A
+ *	  worker that fails takes the startup process down with it.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "access/logindex_func.h"
+#include "access/parallelredo.h"
+#include "access/polar_logindex.h"
+#include "access/xlog.h"
+#include "miscadmin.h"
+#include "pgstat.h"
+#include "postmaster/bgworker.h"
+#include "postmaster/startup.h"
+#include "storage/bufmgr.h"
+#include "storage/proc.h"
+#include "storage/shm_mq.h"
+#include "storage/shmem.h"
+#include "storage/spin.h"
+#include "storage/GroundDB/mempool_client.h"
+#include "utils/memutils.h"
+#include "utils/resowner.h"
+
+#define PARALLEL_REDO_QUEUE_SIZE	(256 * 1024)
+
+/* Maximum time the startup process sleeps before checking on its workers */
+#define PARALLEL_REDO_NAPTIME		1000L
+
+int			rpc_redo_workers = 0;
+
+/* A redo worker, in shared memory */
+typedef struct ParallelRedoSlot
+{
+	/* End of the last record sent, set by the startup process */
+	XLogRecPtr	sent;
+
+	/* End of the last record redone, set by the worker */
+	XLogRecPtr	applied;
+} ParallelRedoSlot;
+
+typedef struct ParallelRedoShared
+{
+	int			nslots;
+	int			startup_pgprocno;
+
+	/* Protects the slots */
+	slock_t		mutex;
+
+	ParallelRedoSlot slots[FLEXIBLE_ARRAY_MEMBER];
+} ParallelRedoShared;
+
+/* What precedes the pages and the record in a message to a worker */
+typedef struct ParallelRedoHeader
+{
+	XLogRecPtr	ReadRecPtr;
+	XLogRecPtr	EndRecPtr;
+	int			ntags;
+} ParallelRedoHeader;
+
+static ParallelRedoShared *pr_shared = NULL;
+
+/* Startup process */
+static bool pr_started = false;
+static int	pr_nworkers = 0;
+static BackgroundWorkerHandle **pr_handles = NULL;
+static shm_mq_handle **pr_mqhs = NULL;
+static BufferTag *pr_tags = NULL;
+static int	pr_maxtags = 0;
+
+static Size
+pr_slots_size(int nslots)
+{
+	return MAXALIGN(offsetof(ParallelRedoShared, slots) +
+					nslots * sizeof(ParallelRedoSlot));
+}
+
+static shm_mq *
+pr_queue(int slotno)
+{
+	return (shm_mq *) ((char *) pr_shared + pr_slots_size(pr_shared->nslots) +
+					   (Size) slotno * PARALLEL_REDO_QUEUE_SIZE);
+}
+
+Size
+ParallelRedoShmemSize(void)
+{
+	Size		size;
+
+	if (rpc_redo_workers <= 0)
+		return 0;
+
+	size = pr_slots_size(rpc_redo_workers);
+	size = add_size(size, mul_size(rpc_redo_workers, PARALLEL_REDO_QUEUE_SIZE));
+	return size;
+}
+
+void
+ParallelRedoShmemInit(void)
+{
+	bool		found;
+	int			i;
+
+	if (rpc_redo_workers <= 0)
+		return;
+
+	pr_shared = (ParallelRedoShared *)
+		ShmemInitStruct("Parallel Redo", ParallelRedoShmemSize(), &found);
+	if (found)
+		return;
+
+	pr_shared->nslots = rpc_redo_workers;
+	pr_shared->startup_pgprocno = -1;
+	SpinLockInit(&pr_shared->mutex);
+	for (i = 0; i < pr_shared->nslots; i++)
+	{
+		pr_shared->slots[i].sent = InvalidXLogRecPtr;
+		pr_shared->slots[i].applied = InvalidXLogRecPtr;
+		shm_mq_create(pr_queue(i), PARALLEL_REDO_QUEUE_SIZE);
+	}
+}
+
+static bool
+pr_launch(int slotno)
+{
+	BackgroundWorker bgw;
+	BackgroundWorkerHandle *handle;
+	shm_mq	   *mq = pr_queue(slotno);
+
+	memset(&bgw, 0, sizeof(bgw));
+	bgw.bgw_flags = BGWORKER_SHMEM_ACCESS;
+	bgw.bgw_start_time = BgWorkerStart_PostmasterStart;
+	snprintf(bgw.bgw_library_name, BGW_MAXLEN, "postgres");
+	snprintf(bgw.bgw_function_name, BGW_MAXLEN, "ParallelRedoWorkerMain");
+	snprintf(bgw.bgw_name, BGW_MAXLEN, "parallel redo worker %d", slotno);
+	snprintf(bgw.bgw_type, BGW_MAXLEN, "parallel redo worker");
+	bgw.bgw_restart_time = BGW_NEVER_RESTART;
+	bgw.bgw_notify_pid = MyProcPid;
+	bgw.bgw_main_arg = Int32GetDatum(slotno);
+
+	if (!RegisterDynamicBackgroundWorker(&bgw, &handle))
+		return false;
+
+	shm_mq_set_sender(mq, MyProc);
+	pr_mqhs[slotno] = shm_mq_attach(mq, NULL, handle);
+	pr_handles[slotno] = handle;
+	return true;
+}
+
+bool
+ParallelRedoEnabled(void)
+{
+	MemoryContext oldctx;
+
+	if (pr_started)
+		return pr_nworkers > 0;
+	pr_started = true;
+
+	if (pr_shared == NULL)
+		return false;
+
+	pr_shared->startup_pgprocno = MyProc->pgprocno;
+
+	oldctx = MemoryContextSwitchTo(TopMemoryContext);
+	pr_handles = (BackgroundWorkerHandle **)
+		palloc0(pr_shared->nslots * sizeof(BackgroundWorkerHandle *));
+	pr_mqhs = (shm_mq_handle **)
+		palloc0(pr_shared->nslots * sizeof(shm_mq_handle *));
+	while (pr_nworkers < pr_shared->nslots && pr_launch(pr_nworkers))
+		pr_nworkers++;
+	MemoryContextSwitchTo(oldctx);
+
+	if (pr_nworkers < pr_shared->nslots)
+		ereport(LOG,
+				(errmsg("could only start %d of %d parallel redo workers",
+						pr_nworkers, pr_shared->nslots),
+				 errhint("You might need to increase max_worker_processes.")));
+	return pr_nworkers > 0;
+}
+
+static void
+pr_send(int slotno, XLogReaderState *record, BufferTag *tags, int ntags)
+{
+	ParallelRedoSlot *slot = &pr_shared->slots[slotno];
+	ParallelRedoHeader hdr;
+	shm_mq_iovec iov[3];
+	shm_mq_result res;
+
+	hdr.ReadRecPtr = record->ReadRecPtr;
+	hdr.EndRecPtr = record->EndRecPtr;
+	hdr.ntags = ntags;
+
+	iov[0].data = (const char *) &hdr;
+	iov[0].len = sizeof(hdr);
+	iov[1].data = (const char *) tags;
+	iov[1].len = ntags * sizeof(BufferTag);
+	iov[2].data = (const char *) record->decoded_record;
+	iov[2].len = record->decoded_record->xl_tot_len;
+
+	/* An idle worker is done with every record before this one */
+	SpinLockAcquire(&pr_shared->mutex);
+	if (slot->applied >= slot->sent)
+		slot->applied = record->ReadRecPtr;
+	slot->sent = record->EndRecPtr;
+	SpinLockRelease(&pr_shared->mutex);
+
+	res = shm_mq_sendv(pr_mqhs[slotno], iov, 3, false);
+	if (res != SHM_MQ_SUCCESS)
+		ereport(ERROR,
+				(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+				 errmsg("lost connection to parallel redo worker %d", slotno)));
+}
+
+void
+ParallelRedoDispatch(XLogReaderState *record, BufferTag *tags, int ntags)
+{
+	int			slotno;
+	int			i;
+
+	Assert(pr_nworkers > 0);
+
+	if (pr_maxtags < ntags)
+	{
+		pr_maxtags = Max(ntags, XLR_MAX_BLOCK_ID + 1);
+		if (pr_tags)
+			pfree(pr_tags);
+		pr_tags = (BufferTag *)
+			MemoryContextAlloc(TopMemoryContext, pr_maxtags * sizeof(BufferTag));
+	}
+
+	/* A record is sent once to each worker that has pages of it to redo */
+	for (slotno = 0; slotno < pr_nworkers; slotno++)
+	{
+		int			mine = 0;
+
+		for (i = 0; i < ntags; i++)
+		{
+			if (BufTableHashCode(&tags[i]) % pr_nworkers == slotno)
+				pr_tags[mine++] = tags[i];
+		}
+		if (mine > 0)
+			pr_send(slotno, record, pr_tags, mine);
+	}
+}
+
+bool
+ParallelRedoInProgress(void)
+{
+	bool		busy = false;
+	int			i;
+
+	if (pr_nworkers == 0)
+		return false;
+
+	SpinLockAcquire(&pr_shared->mutex);
+	for (i = 0; i < pr_nworkers && !busy; i++)
+		busy = pr_shared->slots[i].applied < pr_shared->slots[i].sent;
+	SpinLockRelease(&pr_shared->mutex);
+	return busy;
+}
+
+void
+ParallelRedoWaitAll(void)
+{
+	while (ParallelRedoInProgress())
+	{
+		int			i;
+
+		for (i = 0; i < pr_nworkers; i++)
+		{
+			pid_t		pid;
+
+			if (GetBackgroundWorkerPid(pr_handles[i], &pid) == BGWH_STOPPED)
+				ereport(ERROR,
+						(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+						 errmsg("parallel redo worker %d exited unexpectedly", i)));
+		}
+
+		(void) WaitLatch(MyLatch,
+						 WL_LATCH_SET | WL_TIMEOUT | WL_EXIT_ON_PM_DEATH,
+						 PARALLEL_REDO_NAPTIME,
+						 WAIT_EVENT_RECOVERY_PARALLEL_REDO);
+		ResetLatch(MyLatch);
+		HandleStartupProcInterrupts();
+	}
+}
+
+XLogRecPtr
+ParallelRedoReplayedUpto(XLogRecPtr upto)
+{
+	XLogRecPtr	replayed = upto;
+	int			i;
+
+	if (pr_nworkers == 0)
+		return upto;
+
+	/*
+	 * A worker still busy has redone every record sent to it up to the one
+	 * it applied last, and those idle all of theirs.
+	 */
+	SpinLockAcquire(&pr_shared->mutex);
+	for (i = 0; i < pr_nworkers; i++)
+	{
+		ParallelRedoSlot *slot = &pr_shared->slots[i];
+
+		if (slot->applied < slot->sent)
+			replayed = Min(replayed, slot->applied);
+	}
+	SpinLockRelease(&pr_shared->mutex);
+
+	return replayed;
+}
+
+void
+ParallelRedoShutdown(void)
+{
+	int			i;
+
+	if (pr_nworkers == 0)
+		return;
+
+	ParallelRedoWaitAll();
+	for (i = 0; i < pr_nworkers; i++)
+		shm_mq_detach(pr_mqhs[i]);
+	for (i = 0; i < pr_nworkers; i++)
+		WaitForBackgroundWorkerShutdown(pr_handles[i]);
+	pr_nworkers = 0;
+}
+
+void
+ParallelRedoWorkerMain(Datum main_arg)
+{
+	int			slotno = DatumGetInt32(main_arg);
+	ParallelRedoSlot *slot = &pr_shared->slots[slotno];
+	shm_mq	   *mq = pr_queue(slotno);
+	shm_mq_handle *mqh;
+	XLogReaderState *reader;
+	char	   *recbuf = NULL;
+	Size		recbuflen = 0;
+
+	BackgroundWorkerUnblockSignals();
+
+	/* The buffer manager, as the startup process has it */
+	BaseInit();
+	CurrentResourceOwner = ResourceOwnerCreate(NULL, "parallel redo worker");
+	InRecovery = true;
+
+	shm_mq_set_receiver(mq, MyProc);
+	mqh = shm_mq_attach(mq, NULL, NULL);
+
+	reader = XLogReaderAllocate(wal_segment_size, NULL, XL_ROUTINE(), NULL);
+	if (reader == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_OUT_OF_MEMORY),
+				 errmsg("out of memory"),
+				 errdetail("Failed while allocating a WAL reading processor.")));
+
+	for (;;)
+	{
+		ParallelRedoHeader hdr;
+		BufferTag  *tags;
+		char	   *record;
+		uint32		tot_len;
+		char	   *errormsg;
+		Size		nbytes;
+		void	   *data;
+		bool		drained;
+		int			i;
+
+		/* The startup process detaches as recovery ends */
+		if (shm_mq_receive(mqh, &nbytes, &data, false) != SHM_MQ_SUCCESS)
+			break;
+
+		memcpy(&hdr, data, sizeof(hdr));
+		tags = (BufferTag *) ((char *) data + sizeof(hdr));
+		record = (char *) (tags + hdr.ntags);
+		memcpy(&tot_len, record + offsetof(XLogRecord, xl_tot_len), sizeof(uint32));
+
+		/* The decoded record points into it, aligned as the reader's is */
+		if (recbuflen < tot_len)
+		{
+			recbuflen = Max(tot_len, BLCKSZ);
+			if (recbuf)
+				pfree(recbuf);
+			recbuf = MemoryContextAlloc(TopMemoryContext, recbuflen);
+		}
+		memcpy(recbuf, record, tot_len);
+
+		reader->ReadRecPtr = hdr.ReadRecPtr;
+		reader->EndRecPtr = hdr.EndRecPtr;
+		if (!DecodeXLogRecord(reader, (XLogRecord *) recbuf, &errormsg))
+			elog(ERROR, "failed to decode WAL record at %X/%X: %s",
+				 (uint32) (hdr.ReadRecPtr >> 32), (uint32) hdr.ReadRecPtr,
+				 errormsg);
+		polar_xlog_decode_data(reader);
+
+		for (i = 0; i < hdr.ntags; i++)
+		{
+			BufferTag	tag = tags[i];
+			Buffer		buff = InvalidBuffer;
+
+			MempoolClientReplaying = true;
+			XlogRedoSinglePage(reader, &tag, &buff);
+			MempoolClientReplaying = false;
+			if (BufferIsValid(buff))
+				UnlockReleaseBuffer(buff);
+		}
+
+		SpinLockAcquire(&pr_shared->mutex);
+		slot->applied = hdr.EndRecPtr;
+		drained = slot->applied >= slot->sent;
+		SpinLockRelease(&pr_shared->mutex);
+
+		/* The startup process may be waiting at a barrier */
+		if (drained)
+			SetLatch(&ProcGlobal->allProcs[pr_shared->startup_pgprocno].procLatch);
+
+		CHECK_FOR_INTERRUPTS();
+	}
+
+	proc_exit(0);
+}
@@ -9,7 +9,10 @@
  * page, soon after a page transition).  Read traffic will probably touch
  * a larger span of pages, but in any case a fairly small number of page
  * buffers should be sufficient.  So, we just search the buffers using plain
- * linear search; there's no need for a hashtable or anything fancy.
+ * linear search; there's no need for a hashtable or anything fancy.  Larger
+ * pools are split into banks of about SLRU_BANK_SIZE slots, and a page is
+ * only ever kept in the bank its page number maps to, so the search stays
+ * within one bank however many buffers are configured.
  * The management algorithm is straight LRU except that we will never swap
  * out the latest page (since we know it's going to be hit again eventually).
  *
@@ -196,6 +199,7 @@ SimpleLruInit(SlruCtl ctl, const char *name, int nslots, int nlsns,
 		shared->ControlLock = ctllock;
 
 		shared->num_slots = nslots;
+		shared->num_banks = Max(1, nslots / SLRU_BANK_SIZE);
 		shared->lsn_groups_per_page = nlsns;
 
 		shared->cur_lru_count = 0;
@@ -255,6 +259,19 @@ SimpleLruInit(SlruCtl ctl, const char *name, int nslots, int nlsns,
 	StrNCpy(ctl->Dir, subdir, sizeof(ctl->Dir));
 }
 
+/*
+ * Compute the range of slots [*first, *last) of the bank that pageno may be
+ * kept in.
+ */
+static inline void
+SlruBankSlots(SlruShared shared, int pageno, int *first, int *last)
+{
+	int			bankno = (uint32) pageno % shared->num_banks;
+
+	*first = (int) ((int64) bankno * shared->num_slots / shared->num_banks);
+	*last = (int) ((int64) (bankno + 1) * shared->num_slots / shared->num_banks);
+}
+
 /*
  * Initialize (or reinitialize) a page to zeroes.
  *
@@ -483,12 +500,16 @@ SimpleLruReadPage_ReadOnly(SlruCtl ctl, int pageno, TransactionId xid)
 {
 	SlruShared	shared = ctl->shared;
 	int			slotno;
+	int			firstslot;
+	int			lastslot;
+
+	SlruBankSlots(shared, pageno, &firstslot, &lastslot);
 
 	/* Try to find the page while holding only shared lock */
 	LWLockAcquire(shared->ControlLock, LW_SHARED);
 
 	/* See if page is already in a buffer */
-	for (slotno = 0; slotno < shared->num_slots; slotno++)
+	for (slotno = firstslot; slotno < lastslot; slotno++)
 	{
 		if (shared->page_number[slotno] == pageno &&
 			shared->page_status[slotno] != SLRU_PAGE_EMPTY &&
@@ -1000,7 +1021,7 @@ SlruReportIOError(SlruCtl ctl, int pageno, TransactionId xid)
  * any slot already holds the target page, and return that slot if so.
  * Thus, the returned slot is *either* a slot already holding the pageno
  * (could be any state except EMPTY), *or* a freeable slot (state EMPTY
- * or CLEAN).
+ * or CLEAN).  Only the slots of pageno's bank are considered.
  *
  * Control lock must be held at entry, and will be held at exit.
  */
@@ -1008,6 +1029,10 @@ static int
 SlruSelectLRUPage(SlruCtl ctl, int pageno)
 {
 	SlruShared	shared = ctl->shared;
+	int			firstslot;
+	int			lastslot;
+
+	SlruBankSlots(shared, pageno, &firstslot, &lastslot);
 
 	/* Outer loop handles restart after I/O */
 	for (;;)
@@ -1022,7 +1047,7 @@ SlruSelectLRUPage(SlruCtl ctl, int pageno)
 		int			best_invalid_page_number = 0;	/* keep compiler quiet */
 
 		/* See if page already has a buffer assigned */
-		for (slotno = 0; slotno < shared->num_slots; slotno++)
+		for (slotno = firstslot; slotno < lastslot; slotno++)
 		{
 			if (shared->page_number[slotno] == pageno &&
 				shared->page_status[slotno] != SLRU_PAGE_EMPTY)
@@ -1057,7 +1082,7 @@ SlruSelectLRUPage(SlruCtl ctl, int pageno)
 		 * multiple pages with the same lru_count.
 		 */
 		cur_count = (shared->cur_lru_count)++;
-		for (slotno = 0; slotno < shared->num_slots; slotno++)
+		for (slotno = firstslot; slotno < lastslot; slotno++)
 		{
 			int			this_delta;
 			int			this_page_number;
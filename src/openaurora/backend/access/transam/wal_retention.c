@@ -0,0 +1,508 @@
+//
+// Compressed WAL retention of the storage node, see access/wal_retention.h.
+//
+// The pass runs on a thread of its own and only logs with printf, as the
+// other storage node threads do. Readers keep the compressed file they
+// read last open and the blocks they decompressed last per thread, as the
+// RPC threads of the storage node read segments at once.
+//
+#include "postgres.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <zstd.h>
+#include "access/wal_retention.h"
+#include "access/xlog.h"
+#include "access/xlog_internal.h"
+#include "common/file_perm.h"
+
+// GUC, in MB
+int wal_retention_compress_age = -1;
+
+// Retained WAL is compressed once and read rarely, favour the ratio
+#define WAL_RETENTION_ZSTD_LEVEL (3)
+#define WAL_RETENTION_CACHE_BLOCKS (4)
+// A segment found without a compressed file is looked for again after this
+#define WAL_RETENTION_MISS_RECHECK_US (1000000)
+
+extern XLogRecPtr XLogParseUpto;
+
+typedef struct WalRetentionFile {
+    TimeLineID tli;
+    XLogSegNo segno;
+    int fd;
+    uint32_t blocks;
+    WalRetentionBlock *index;
+} WalRetentionFile;
+
+typedef struct WalRetentionCached {
+    TimeLineID tli;
+    XLogSegNo segno;
+    uint32_t block;
+    bool valid;
+    uint64_t used;
+} WalRetentionCached;
+
+static __thread WalRetentionFile openFile = {0, 0, -1, 0, NULL};
+static __thread WalRetentionCached cached[WAL_RETENTION_CACHE_BLOCKS];
+static __thread char *cacheData = NULL;
+static __thread char *frameData = NULL;
+static __thread uint64_t cacheClock = 0;
+static __thread ZSTD_DCtx *decompressCtx = NULL;
+static __thread TimeLineID missTli = 0;
+static __thread XLogSegNo missSegno = 0;
+static __thread uint64_t missUs = 0;
+
+static pthread_once_t retentionOnce = PTHREAD_ONCE_INIT;
+// Of the last pass
+static uint64_t retainedSegments = 0;
+static uint64_t retainedRawBytes = 0;
+static uint64_t retainedStoredBytes = 0;
+// Set once the file system turned out not to punch holes
+static bool punchUnsupported = false;
+
+static uint64_t WalRetentionNowUs(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static void WalRetentionPath(char *path, TimeLineID tli, XLogSegNo segno) {
+    char fname[MAXFNAMELEN];
+
+    XLogFileName(fname, tli, segno, wal_segment_size);
+    snprintf(path, MAXPGPATH, WAL_RETENTION_DIR "/%s", fname);
+}
+
+static bool WalRetentionPReadFull(int fd, char *buf, size_t len, off_t off) {
+    size_t done = 0;
+
+    while (done < len) {
+        ssize_t got = pg_pread(fd, buf + done, len - done, off + done);
+
+        if (got <= 0)
+            return false;
+        done += got;
+    }
+    return true;
+}
+
+static bool WalRetentionPWriteFull(int fd, const char *buf, size_t len, off_t off) {
+    size_t done = 0;
+
+    while (done < len) {
+        ssize_t put = pg_pwrite(fd, buf + done, len - done, off + done);
+
+        if (put <= 0)
+            return false;
+        done += put;
+    }
+    return true;
+}
+
+// Whether the piece [start, end) of a block, at p, reads as punched: the
+// header of its first page, or all of it without one, zero
+static bool WalRetentionLooksPunched(const char *p, uint32_t start, uint32_t end) {
+    uint32_t page = TYPEALIGN(XLOG_BLCKSZ, start);
+
+    if (page + sizeof(uint16) <= end) {
+        uint16 magic;
+
+        memcpy(&magic, p + (page - start), sizeof(magic));
+        return magic == 0;
+    }
+    for (uint32_t i = 0; i < end - start; i++)
+        if (p[i] != 0)
+            return false;
+    return true;
+}
+
+static bool WalRetentionAnyPunched(const char *buf, int amount, uint32_t off) {
+    uint32_t end = off + (uint32_t) amount;
+
+    for (uint32_t start = off; start < end;) {
+        uint32_t pieceEnd = Min(end, (start / WAL_RETENTION_BLOCK + 1) * WAL_RETENTION_BLOCK);
+
+        if (WalRetentionLooksPunched(buf + (start - off), start, pieceEnd))
+            return true;
+        start = pieceEnd;
+    }
+    return false;
+}
+
+static void WalRetentionClose(void) {
+    if (openFile.fd >= 0)
+        close(openFile.fd);
+    free(openFile.index);
+    openFile.fd = -1;
+    openFile.index = NULL;
+}
+
+// Opens the compressed file of the segment for this thread. 1 if it is
+// open, 0 if the segment has none, -1 if it can't be read.
+static int WalRetentionLoad(TimeLineID tli, XLogSegNo segno) {
+    char path[MAXPGPATH];
+    WalRetentionHeader header;
+    uint32_t blocks = wal_segment_size / WAL_RETENTION_BLOCK;
+    size_t indexSize = sizeof(WalRetentionBlock) * blocks;
+    int fd;
+
+    if (openFile.fd >= 0 && openFile.tli == tli && openFile.segno == segno)
+        return 1;
+    if (missTli == tli && missSegno == segno && WalRetentionNowUs() - missUs < WAL_RETENTION_MISS_RECHECK_US)
+        return 0;
+
+    WalRetentionPath(path, tli, segno);
+    fd = open(path, O_RDONLY | PG_BINARY, 0);
+    if (fd < 0) {
+        if (errno != ENOENT)
+            return -1;
+        missTli = tli;
+        missSegno = segno;
+        missUs = WalRetentionNowUs();
+        return 0;
+    }
+
+    WalRetentionClose();
+    openFile.index = (WalRetentionBlock *) malloc(indexSize);
+    if (openFile.index == NULL || !WalRetentionPReadFull(fd, (char *) &header, sizeof(header), 0)
+        || header.magic != WAL_RETENTION_MAGIC || header.blockSize != WAL_RETENTION_BLOCK
+        || header.blocks != blocks || !WalRetentionPReadFull(fd, (char *) openFile.index, indexSize, sizeof(header))) {
+        close(fd);
+        WalRetentionClose();
+        return -1;
+    }
+    for (uint32_t i = 0; i < blocks; i++) {
+        if (openFile.index[i].length >= WAL_RETENTION_BLOCK) {
+            close(fd);
+            WalRetentionClose();
+            return -1;
+        }
+    }
+    openFile.tli = tli;
+    openFile.segno = segno;
+    openFile.fd = fd;
+    openFile.blocks = blocks;
+    return 1;
+}
+
+// The block of the open file decompressed, NULL if it can't be
+static const char *WalRetentionBlockData(uint32_t block) {
+    WalRetentionBlock *entry = &openFile.index[block];
+    int victim = 0;
+    char *data;
+    size_t n;
+
+    for (int i = 0; i < WAL_RETENTION_CACHE_BLOCKS; i++) {
+        WalRetentionCached *slot = &cached[i];
+
+        if (slot->valid && slot->tli == openFile.tli && slot->segno == openFile.segno && slot->block == block) {
+            slot->used = ++cacheClock;
+            return cacheData + (size_t) i * WAL_RETENTION_BLOCK;
+        }
+        if (!slot->valid || slot->used < cached[victim].used)
+            victim = i;
+    }
+
+    if (cacheData == NULL)
+        cacheData = (char *) malloc((size_t) WAL_RETENTION_CACHE_BLOCKS * WAL_RETENTION_BLOCK);
+    if (frameData == NULL)
+        frameData = (char *) malloc(WAL_RETENTION_BLOCK);
+    if (decompressCtx == NULL)
+        decompressCtx = ZSTD_createDCtx();
+    if (cacheData == NULL || frameData == NULL || decompressCtx == NULL)
+        return NULL;
+
+    cached[victim].valid = false;
+    data = cacheData + (size_t) victim * WAL_RETENTION_BLOCK;
+    if (!WalRetentionPReadFull(openFile.fd, frameData, entry->length, (off_t) entry->offset))
+        return NULL;
+    n = ZSTD_decompressDCtx(decompressCtx, data, WAL_RETENTION_BLOCK, frameData, entry->length);
+    if (ZSTD_isError(n) || n != WAL_RETENTION_BLOCK)
+        return NULL;
+
+    cached[victim].tli = openFile.tli;
+    cached[victim].segno = openFile.segno;
+    cached[victim].block = block;
+    cached[victim].valid = true;
+    cached[victim].used = ++cacheClock;
+    return data;
+}
+
+bool WalRetentionFill(TimeLineID tli, XLogSegNo segno, char *buf, int amount, uint32_t off) {
+    uint32_t end = off + (uint32_t) Max(amount, 0);
+
+    if (wal_segment_size % WAL_RETENTION_BLOCK != 0)
+        return true;
+    for (uint32_t start = off; start < end;) {
+        uint32_t block = start / WAL_RETENTION_BLOCK;
+        uint32_t pieceEnd = Min(end, (block + 1) * WAL_RETENTION_BLOCK);
+        char *piece = buf + (start - off);
+
+        if (WalRetentionLooksPunched(piece, start, pieceEnd)) {
+            int loaded = WalRetentionLoad(tli, segno);
+
+            if (loaded < 0)
+                return false;
+            // Zeros of a segment never compressed are what it holds
+            if (loaded == 0)
+                return true;
+            if (block < openFile.blocks && openFile.index[block].length > 0) {
+                const char *data = WalRetentionBlockData(block);
+
+                if (data == NULL)
+                    return false;
+                memcpy(piece, data + (start - block * WAL_RETENTION_BLOCK), pieceEnd - start);
+            }
+        }
+        start = pieceEnd;
+    }
+    return true;
+}
+
+bool WalRetentionFillFd(int fd, char *buf, int amount, uint32_t off) {
+    char link[64];
+    char target[MAXPGPATH];
+    const char *fname;
+    TimeLineID tli;
+    XLogSegNo segno;
+    ssize_t len;
+
+    if (amount <= 0 || !WalRetentionAnyPunched(buf, amount, off))
+        return true;
+    snprintf(link, sizeof(link), "/proc/self/fd/%d", fd);
+    len = readlink(link, target, sizeof(target) - 1);
+    if (len <= 0)
+        return true;
+    target[len] = '\0';
+    fname = strrchr(target, '/');
+    fname = fname != NULL ? fname + 1 : target;
+    if (!IsXLogFileName(fname))
+        return true;
+    XLogFromFileName(fname, &tli, &segno, wal_segment_size);
+    return WalRetentionFill(tli, segno, buf, amount, off);
+}
+
+static bool WalRetentionSyncDir(const char *path) {
+    int fd = open(path, O_RDONLY | PG_BINARY, 0);
+    bool synced;
+
+    if (fd < 0)
+        return false;
+    synced = pg_fsync(fd) == 0;
+    close(fd);
+    return synced;
+}
+
+// Punches the blocks stored out of the segment. False if the file system
+// doesn't take it; a block it fails otherwise stays in the segment.
+static bool WalRetentionPunch(int fd, const WalRetentionBlock *index, uint32_t blocks) {
+#ifdef FALLOC_FL_PUNCH_HOLE
+    bool punched = false;
+
+    for (uint32_t i = 0; i < blocks; i++) {
+        if (index[i].length == 0)
+            continue;
+        if (fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, (off_t) i * WAL_RETENTION_BLOCK,
+                      WAL_RETENTION_BLOCK) == 0)
+            punched = true;
+        else if (!punched && errno == EOPNOTSUPP)
+            return false;
+    }
+    pg_fsync(fd);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool WalRetentionCompressSegment(TimeLineID tli, XLogSegNo segno) {
+    uint32_t blocks = wal_segment_size / WAL_RETENTION_BLOCK;
+    size_t bound = ZSTD_compressBound(WAL_RETENTION_BLOCK);
+    size_t indexSize = sizeof(WalRetentionBlock) * blocks;
+    char segPath[MAXPGPATH];
+    char path[MAXPGPATH];
+    char tmpPath[MAXPGPATH];
+    WalRetentionHeader header;
+    WalRetentionBlock *index = NULL;
+    ZSTD_CCtx *cctx = NULL;
+    ZSTD_DCtx *dctx = NULL;
+    char *raw = NULL;
+    char *frame = NULL;
+    char *check = NULL;
+    uint64_t offset;
+    int fd = -1;
+    int out = -1;
+    bool done = false;
+
+    if (punchUnsupported || blocks == 0 || wal_segment_size % WAL_RETENTION_BLOCK != 0)
+        return false;
+    XLogFilePath(segPath, tli, segno, wal_segment_size);
+    WalRetentionPath(path, tli, segno);
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+
+    index = (WalRetentionBlock *) calloc(blocks, sizeof(WalRetentionBlock));
+    raw = (char *) malloc(WAL_RETENTION_BLOCK);
+    frame = (char *) malloc(bound);
+    check = (char *) malloc(WAL_RETENTION_BLOCK);
+    cctx = ZSTD_createCCtx();
+    dctx = ZSTD_createDCtx();
+    if (index == NULL || raw == NULL || frame == NULL || check == NULL || cctx == NULL || dctx == NULL)
+        goto cleanup;
+    fd = open(segPath, O_RDWR | PG_BINARY, 0);
+    out = open(tmpPath, O_WRONLY | O_CREAT | O_TRUNC | PG_BINARY, pg_file_create_mode);
+    if (fd < 0 || out < 0)
+        goto cleanup;
+
+    offset = sizeof(header) + indexSize;
+    for (uint32_t i = 0; i < blocks; i++) {
+        size_t n;
+
+        if (!WalRetentionPReadFull(fd, raw, WAL_RETENTION_BLOCK, (off_t) i * WAL_RETENTION_BLOCK))
+            goto cleanup;
+        n = ZSTD_compressCCtx(cctx, frame, bound, raw, WAL_RETENTION_BLOCK, WAL_RETENTION_ZSTD_LEVEL);
+        if (ZSTD_isError(n) || n >= WAL_RETENTION_BLOCK)
+            continue;
+        // What is punched must come back as it was
+        if (ZSTD_decompressDCtx(dctx, check, WAL_RETENTION_BLOCK, frame, n) != WAL_RETENTION_BLOCK
+            || memcmp(check, raw, WAL_RETENTION_BLOCK) != 0)
+            continue;
+        if (!WalRetentionPWriteFull(out, frame, n, (off_t) offset))
+            goto cleanup;
+        index[i].offset = offset;
+        index[i].length = (uint32_t) n;
+        offset += n;
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.magic = WAL_RETENTION_MAGIC;
+    header.blockSize = WAL_RETENTION_BLOCK;
+    header.blocks = blocks;
+    if (!WalRetentionPWriteFull(out, (const char *) &header, sizeof(header), 0)
+        || !WalRetentionPWriteFull(out, (const char *) index, indexSize, sizeof(header)) || pg_fsync(out) != 0)
+        goto cleanup;
+    close(out);
+    out = -1;
+    if (rename(tmpPath, path) != 0 || !WalRetentionSyncDir(WAL_RETENTION_DIR))
+        goto cleanup;
+
+    // Durable now, reads of the blocks punched find them there
+    if (!WalRetentionPunch(fd, index, blocks)) {
+        printf("%s the file system of %s can't punch holes, WAL stays uncompressed\n", __func__, XLOGDIR);
+        fflush(stdout);
+        punchUnsupported = true;
+        unlink(path);
+        goto cleanup;
+    }
+    done = true;
+
+cleanup:
+    if (out >= 0) {
+        close(out);
+        unlink(tmpPath);
+    }
+    if (fd >= 0)
+        close(fd);
+    ZSTD_freeCCtx(cctx);
+    ZSTD_freeDCtx(dctx);
+    free(check);
+    free(frame);
+    free(raw);
+    free(index);
+    return done;
+}
+
+static void WalRetentionPass(void) {
+    XLogRecPtr upto = XLogRpcPersistedUpto(XLogParseUpto);
+    uint64_t age = (uint64_t) Max(wal_retention_compress_age, 0) * 1024 * 1024;
+    bool compress = wal_retention_compress_age >= 0 && upto > age;
+    uint64_t segments = 0;
+    uint64_t storedBytes = 0;
+    struct dirent *de;
+    DIR *dir;
+
+    if (mkdir(WAL_RETENTION_DIR, pg_dir_create_mode) != 0 && errno != EEXIST)
+        return;
+
+    // Compressed files of segments that are gone, and ones left unfinished
+    dir = opendir(WAL_RETENTION_DIR);
+    while (dir != NULL && (de = readdir(dir)) != NULL) {
+        char path[MAXPGPATH];
+        char segPath[MAXPGPATH];
+        struct stat st;
+
+        if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0)
+            continue;
+        snprintf(path, sizeof(path), WAL_RETENTION_DIR "/%s", de->d_name);
+        snprintf(segPath, sizeof(segPath), XLOGDIR "/%s", de->d_name);
+        if (!IsXLogFileName(de->d_name) || stat(segPath, &st) != 0)
+            unlink(path);
+        else if (stat(path, &st) == 0) {
+            segments++;
+            storedBytes += st.st_size;
+        }
+    }
+    if (dir != NULL)
+        closedir(dir);
+
+    dir = compress ? opendir(XLOGDIR) : NULL;
+    while (dir != NULL && (de = readdir(dir)) != NULL) {
+        char path[MAXPGPATH];
+        struct stat st;
+        TimeLineID tli;
+        XLogSegNo segno;
+        XLogRecPtr segEnd;
+
+        if (!IsXLogFileName(de->d_name))
+            continue;
+        XLogFromFileName(de->d_name, &tli, &segno, wal_segment_size);
+        XLogSegNoOffsetToRecPtr(segno + 1, 0, wal_segment_size, segEnd);
+        WalRetentionPath(path, tli, segno);
+        if (segEnd > upto - age || stat(path, &st) == 0)
+            continue;
+        if (WalRetentionCompressSegment(tli, segno) && stat(path, &st) == 0) {
+            segments++;
+            storedBytes += st.st_size;
+        }
+    }
+    if (dir != NULL)
+        closedir(dir);
+
+    __atomic_store_n(&retainedSegments, segments, __ATOMIC_RELAXED);
+    __atomic_store_n(&retainedRawBytes, segments * wal_segment_size, __ATOMIC_RELAXED);
+    __atomic_store_n(&retainedStoredBytes, storedBytes, __ATOMIC_RELAXED);
+}
+
+static void *WalRetentionLoop(void *arg) {
+    for (;;) {
+        sleep(WAL_RETENTION_INTERVAL);
+        WalRetentionPass();
+    }
+    return NULL;
+}
+
+static void WalRetentionStartOnce(void) {
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, WalRetentionLoop, NULL) == 0)
+        pthread_detach(thread);
+}
+
+void WalRetentionStart(void) {
+    pthread_once(&retentionOnce, WalRetentionStartOnce);
+}
+
+void WalRetentionCounts(uint64_t *segments, uint64_t *rawBytes, uint64_t *storedBytes) {
+    *segments = __atomic_load_n(&retainedSegments, __ATOMIC_RELAXED);
+    *rawBytes = __atomic_load_n(&retainedRawBytes, __ATOMIC_RELAXED);
+    *storedBytes = __atomic_load_n(&retainedStoredBytes, __ATOMIC_RELAXED);
+}
@@ -43,6 +43,12 @@
 #include "access/polar_logindex.h"
 #include "access/logindex_func.h"
 #include "access/wakeup_latch.h"
+#include "access/lsn_waiter.h"
+#include "access/logindex_checkpoint.h"
+#include "access/logindex_pipeline.h"
+#include "access/page_change_feed.h"
+#include "access/parallelredo.h"
+#include "access/wal_retention.h"
 #include "catalog/catversion.h"
 #include "catalog/pg_control.h"
 #include "catalog/pg_database.h"
@@ -78,6 +84,7 @@
 #include "storage/spin.h"
 #include "storage/sync.h"
 #include "storage/kv_interface.h"
+#include "storage/adaptive_sr.h"
 #include "utils/builtins.h"
 #include "utils/guc.h"
 #include "utils/memutils.h"
@@ -88,7 +95,14 @@
 #include "tcop/storage_server.h"
 #include "tcop/wal_redo.h"
 #include "storage/rpcclient.h"
+#include "storage/wal_read_cache.h"
 #include "storage/rel_cache.h"
+#include "storage/rpc_relsize.h"
+#include "storage/compressed_page_cache.h"
+#include "storage/local_page_cache.h"
+#include "storage/map_page_cache.h"
+#include "storage/buf_change_feed.h"
+#include "storage/buf_warm_start.h"
 
 #include "storage/GroundDB/mempool_client.h"
 
@@ -163,8 +177,11 @@ int pg_pwrite_rpc_local(int fd, char *p, int amount, int offset) {
 }
 
 int xlog_write_rpc_local(int fd, char *p, Size amount, uint32 offset, int startIdx, int blkNum, uint64_t* xlblocks, int xlblocksBufferNum, uint64_t lsn) {
-    if(IsRpcClient)
+    // In place of the caller's WALWrite, which it ends
+    if(IsRpcClient) {
+        pgstat_report_wait_start(WAIT_EVENT_RPC_XLOG_WRITE);
         return RpcXLogWriteWithPosition(fd, p, amount, offset, startIdx, blkNum, xlblocks, xlblocksBufferNum, lsn);
+    }
     else
         return pg_pwrite(fd, p, amount, offset);
 }
@@ -192,6 +209,34 @@ extern bool	am_wal_redo_postgres;
 
 extern HashMap pageVersionHashMap;
 
+/*
+ * Rebuild the relation size cache for a relation restored from a logindex
+ * checkpoint, the same way the parse loop below does for a relation it sees
+ * for the first time.
+ */
+static void
+LogindexRestoreRelSize(const KeyType *relKey, int64_t maxBlkNum, uint64_t parseLsn, void *arg)
+{
+	RelFileNode rnode;
+	RelKey		cacheKey;
+	uint32_t	size = (uint32_t) (maxBlkNum + 1);
+	uint32_t	cached;
+	int			baseRelSize;
+
+	rnode.spcNode = relKey->SpcID;
+	rnode.dbNode = relKey->DbID;
+	rnode.relNode = relKey->RelID;
+	TransRelNode2RelKey(rnode, &cacheKey, (ForkNumber) relKey->ForkNum);
+
+	if (GetRelSizeCache(cacheKey, &cached) && cached >= size)
+		return;
+	baseRelSize = SyncGetRelSize(rnode, (ForkNumber) relKey->ForkNum, parseLsn);
+	if (baseRelSize > 0 && (uint32_t) baseRelSize > size)
+		size = baseRelSize;
+	ExtendRelSizeCache(cacheKey, size);
+	RpcRelSizeExtend(cacheKey, size, parseLsn);
+}
+
 extern uint64_t RpcXLogFlushedLsn;
 
 extern bool MempoolClientReplaying;
@@ -210,7 +255,7 @@ char	   *XLogArchiveCommand = NULL;
 bool		EnableHotStandby = false;
 bool		fullPageWrites = true;
 bool		wal_log_hints = false;
-bool		wal_compression = false;
+int			wal_compression = WAL_COMPRESSION_NONE;
 char	   *wal_consistency_checking_string = NULL;
 bool	   *wal_consistency_checking = NULL;
 bool		wal_init_zero = true;
@@ -222,6 +267,7 @@ int			CommitDelay = 0;	/* precommit delay in microseconds */
 int			CommitSiblings = 5; /* # concurrent xacts needed to sleep */
 int			wal_retrieve_retry_interval = 5000;
 int			max_slot_wal_keep_size_mb = -1;
+int			wal_readahead_size = 32;	/* in XLOG_BLCKSZ pages */
 
 //#define XLOG_IN_ROCKSDB
 //#define ENABLE_DEBUG_INFO
@@ -234,11 +280,14 @@ bool		XLOG_DEBUG = false;
 int			wal_segment_size = DEFAULT_XLOG_SEG_SIZE;
 
 /*
- * Number of WAL insertion locks to use. A higher value allows more insertions
- * to happen concurrently, but adds some CPU overhead to flushing the WAL,
- * which needs to iterate all the locks.
+ * Number of WAL insertion locks to use (GUC wal_insert_locks). A higher value
+ * allows more insertions to happen concurrently, but adds some CPU overhead
+ * to flushing the WAL, which needs to iterate all the locks. -1 sizes it to
+ * the number of CPUs, see XLOGChooseNumInsertLocks().
  */
-#define NUM_XLOGINSERT_LOCKS  8
+int			XLOGInsertLocks = -1;
+
+#define NUM_XLOGINSERT_LOCKS  XLOGInsertLocks
 
 /*
  * Max distance from last checkpoint, before triggering a new xlog-based
@@ -425,6 +474,12 @@ static bool LocalHotStandbyActive = false;
  */
 static bool LocalPromoteIsTriggered = false;
 
+/*
+ * Does the replay position reported lag the records read, for redo workers
+ * still at their pages?
+ */
+static bool parallelRedoBehind = false;
+
 /*
  * Local state for XLogInsertAllowed():
  *		1: unconditionally allowed to insert XLOG
@@ -475,6 +530,12 @@ const char *recoveryTargetName;
 XLogRecPtr	recoveryTargetLSN;
 int			recovery_min_apply_delay = 0;
 
+/* set via GUC rpc_as_of_lsn, see GetLogWrtResultLsn() */
+XLogRecPtr	RpcAsOfLsn = InvalidXLogRecPtr;
+
+/* set via GUC rpc_instant_recovery, see InstantRecovery */
+bool		rpc_instant_recovery = false;
+
 /* options formerly taken from recovery.conf for XLOG streaming */
 bool		StandbyModeRequested = false;
 char	   *PrimaryConnInfo = NULL;
@@ -721,29 +782,41 @@ typedef enum ExclusiveBackupState
  */
 static SessionBackupState sessionBackupState = SESSION_BACKUP_NONE;
 
+/*
+ * An entry of the prev-link table. A record's inserter publishes its start
+ * here, keyed by its end, for the inserter of the next record, which
+ * reserved the space starting at that end, to copy to its prev-link. end is
+ * 0 while the entry is free, XLOG_PREV_LINK_CLAIMED while it is filled in.
+ */
+typedef struct XLogPrevLink
+{
+	pg_atomic_uint64 end;
+	uint64		start;
+} XLogPrevLink;
+
+#define XLOG_PREV_LINK_CLAIMED	PG_UINT64_MAX
+
 /*
  * Shared state data for WAL insertion.
  */
 typedef struct XLogCtlInsert
 {
-	slock_t		insertpos_lck;	/* protects CurrBytePos and PrevBytePos */
-
 	/*
 	 * CurrBytePos is the end of reserved WAL. The next record will be
-	 * inserted at that position. PrevBytePos is the start position of the
-	 * previously inserted (or rather, reserved) record - it is copied to the
-	 * prev-link of the next record. These are stored as "usable byte
-	 * positions" rather than XLogRecPtrs (see XLogBytePosToRecPtr()).
+	 * inserted at that position. It is stored as a "usable byte position"
+	 * rather than an XLogRecPtr (see XLogBytePosToRecPtr()), and advanced
+	 * with an atomic fetch-add. The start of the previous record, which is
+	 * copied to the prev-link of the next one, is handed over through the
+	 * prev-link table, see XLogPrevLinkPublish().
 	 */
-	uint64		CurrBytePos;
-	uint64		PrevBytePos;
+	pg_atomic_uint64 CurrBytePos;
 
 	/*
-	 * Make sure the above heavily-contended spinlock and byte positions are
-	 * on their own cache line. In particular, the RedoRecPtr and full page
-	 * write variables below should be on a different cache line. They are
-	 * read on every WAL insertion, but updated rarely, and we don't want
-	 * those reads to steal the cache line containing Curr/PrevBytePos.
+	 * Make sure the above heavily-contended byte position is on its own
+	 * cache line. In particular, the RedoRecPtr and full page write variables
+	 * below should be on a different cache line. They are read on every WAL
+	 * insertion, but updated rarely, and we don't want those reads to steal
+	 * the cache line containing CurrBytePos.
 	 */
 	char		pad[PG_CACHE_LINE_SIZE];
 
@@ -777,6 +850,10 @@ typedef struct XLogCtlInsert
 	 * WAL insertion locks.
 	 */
 	WALInsertLockPadded *WALInsertLocks;
+
+	/* The prev-link table, and its number of entries - 1 */
+	XLogPrevLink *prevLinks;
+	uint32		prevLinkMask;
 } XLogCtlInsert;
 
 /*
@@ -910,6 +987,14 @@ typedef struct XLogCtlData
 	 */
 	XLogRecPtr	lastFpwDisableRecPtr;
 
+	/*
+	 * On a storage node, the end of the WAL handed to the persistence
+	 * thread, and of the WAL it has written to the segment files.  What lies
+	 * between is only in RpcXLogPages for now.
+	 */
+	pg_atomic_uint64 rpcPersistQueued;
+	pg_atomic_uint64 rpcPersistWritten;
+
 	slock_t		info_lck;		/* locks shared variables shown above */
 } XLogCtlData;
 
@@ -917,6 +1002,8 @@ static XLogCtlData *XLogCtl = NULL;
 
 /* a private copy of XLogCtl->Insert.WALInsertLocks, for convenience */
 static WALInsertLockPadded *WALInsertLocks = NULL;
+static XLogPrevLink *XLogPrevLinks = NULL;
+static uint32 XLogPrevLinkMask = 0;
 
 /*
  * We maintain an image of pg_control in shared memory.
@@ -1017,6 +1104,18 @@ static XLogSource currentSource = XLOG_FROM_ANY;
 static bool lastSourceFailed = false;
 static bool pendingWalRcvRestart = false;
 
+/*
+ * WAL that XLogPageRead() read ahead, wal_readahead_size pages of the open
+ * segment at a time, at offsets walReadaheadStart to walReadaheadEnd of
+ * segment walReadaheadSegNo of timeline walReadaheadTLI.  Only pages known
+ * to be complete are read ahead, see XLogReadaheadLimit().
+ */
+static char *walReadaheadBuf = NULL;
+static XLogSegNo walReadaheadSegNo = 0;
+static TimeLineID walReadaheadTLI = 0;
+static uint32 walReadaheadStart = 0;
+static uint32 walReadaheadEnd = 0;
+
 typedef struct XLogPageReadPrivate
 {
 	int			emode;
@@ -1062,6 +1161,17 @@ static bool InRedo = false;
 /* Have we launched bgwriter during recovery? */
 static bool bgwriterLaunched = false;
 
+/*
+ * Is this a compute node's crash recovery leaving the page redo to the
+ * storage node?  The storage node replays every page record itself, lazily
+ * as the pages are read, and the compute node reads at the end of the WAL
+ * the storage node holds once out of recovery.  So only the records that
+ * rebuild the compute node's own state (CLOG and the other SLRUs, the
+ * relmapper, the control file) need redo here, and recovery ends with an
+ * end-of-recovery record like a fast promotion rather than a checkpoint.
+ */
+static bool InstantRecovery = false;
+
 /* For WALInsertLockAcquire/Release functions */
 static int	MyLockNo = 0;
 static bool holdingAllLocks = false;
@@ -1074,6 +1184,7 @@ static void readRecoverySignalFile(void);
 static void validateRecoveryParameters(void);
 static void exitArchiveRecovery(TimeLineID endTLI, XLogRecPtr endOfLog);
 static bool recoveryStopsBefore(XLogReaderState *record);
+static bool RedoLeftToStorage(XLogReaderState *record);
 static bool recoveryStopsAfter(XLogReaderState *record);
 static void recoveryPausesHere(bool endOfRecovery);
 static bool recoveryApplyDelay(XLogReaderState *record);
@@ -1100,7 +1211,9 @@ static int	XLogFileRead(XLogSegNo segno, int emode, TimeLineID tli,
 static int	XLogFileReadAnyTLI(XLogSegNo segno, int emode, XLogSource source);
 static bool WaitForWALToBecomeAvailable(XLogRecPtr RecPtr, bool randAccess,
 										bool fetching_ckpt, XLogRecPtr tliRecPtr);
+static void WaitForParallelRedo(void);
 static int	emode_for_corrupt_record(int emode, XLogRecPtr RecPtr);
+static int	XLogReadPage(char *readBuf, XLogRecPtr targetPagePtr);
 static void XLogFileClose(void);
 static void PreallocXlogFiles(XLogRecPtr endptr);
 static void RemoveTempXlogFiles(void);
@@ -1212,8 +1325,8 @@ XLogInsertRecord(XLogRecData *rdata,
 	 * record to the shared WAL buffer cache is a two-step process:
 	 *
 	 * 1. Reserve the right amount of space from the WAL. The current head of
-	 *	  reserved space is kept in Insert->CurrBytePos, and is protected by
-	 *	  insertpos_lck.
+	 *	  reserved space is kept in Insert->CurrBytePos, and is advanced
+	 *	  atomically.
 	 *
 	 * 2. Copy the record to the reserved WAL space. This involves finding the
 	 *	  correct WAL buffer containing the reserved space, and copying the
@@ -1455,6 +1568,76 @@ XLogInsertRecord(XLogRecData *rdata,
 	return EndPos;
 }
 
+/*
+ * The prev-link table entry for a record ending at endbytepos.
+ */
+static inline XLogPrevLink *
+XLogPrevLinkSlot(uint64 endbytepos)
+{
+	return &XLogPrevLinks[(endbytepos / MAXIMUM_ALIGNOF) & XLogPrevLinkMask];
+}
+
+/*
+ * Publish the start of the record reserved from startbytepos to endbytepos,
+ * for the record reserved next.
+ *
+ * Only the inserters between their reservation and this call have entries
+ * that are not taken yet, and they all reserved space before ours (the next
+ * inserters take ours first), so waiting for an entry to be free never waits
+ * for an inserter that is waiting itself for us.
+ */
+static inline void
+XLogPrevLinkPublish(uint64 startbytepos, uint64 endbytepos)
+{
+	XLogPrevLink *link = XLogPrevLinkSlot(endbytepos);
+	uint64		expected = 0;
+
+	if (!pg_atomic_compare_exchange_u64(&link->end, &expected,
+										XLOG_PREV_LINK_CLAIMED))
+	{
+		SpinDelayStatus delayStatus;
+
+		init_local_spin_delay(&delayStatus);
+		do
+		{
+			perform_spin_delay(&delayStatus);
+			expected = 0;
+		} while (!pg_atomic_compare_exchange_u64(&link->end, &expected,
+												 XLOG_PREV_LINK_CLAIMED));
+		finish_spin_delay(&delayStatus);
+	}
+	link->start = startbytepos;
+	pg_write_barrier();
+	pg_atomic_write_u64(&link->end, endbytepos);
+}
+
+/*
+ * Take the start of the record that ends at startbytepos, waiting for its
+ * inserter to publish it.
+ */
+static inline uint64
+XLogPrevLinkTake(uint64 startbytepos)
+{
+	XLogPrevLink *link = XLogPrevLinkSlot(startbytepos);
+	uint64		prevbytepos;
+
+	if (pg_atomic_read_u64(&link->end) != startbytepos)
+	{
+		SpinDelayStatus delayStatus;
+
+		init_local_spin_delay(&delayStatus);
+		while (pg_atomic_read_u64(&link->end) != startbytepos)
+			perform_spin_delay(&delayStatus);
+		finish_spin_delay(&delayStatus);
+	}
+	pg_read_barrier();
+	prevbytepos = link->start;
+	/* The exchange is a full barrier, the read above can't move past it */
+	pg_atomic_exchange_u64(&link->end, 0);
+
+	return prevbytepos;
+}
+
 /*
  * Reserves the right amount of space for a record of given size from the WAL.
  * *StartPos is set to the beginning of the reserved section, *EndPos to
@@ -1462,9 +1645,10 @@ XLogInsertRecord(XLogRecData *rdata,
  * used to set the xl_prev of this record.
  *
  * This is the performance critical part of XLogInsert that must be serialized
- * across backends. The rest can happen mostly in parallel. Try to keep this
- * section as short as possible, insertpos_lck can be heavily contended on a
- * busy system.
+ * across backends. The rest can happen mostly in parallel. The space is
+ * reserved with a single atomic fetch-add; the previous record's start comes
+ * from its inserter through the prev-link table, which normally has it
+ * already.
  *
  * NB: The space calculation here must match the code in CopyXLogRecordToWAL,
  * where we actually copy the record to the reserved space.
@@ -1484,24 +1668,18 @@ ReserveXLogInsertLocation(int size, XLogRecPtr *StartPos, XLogRecPtr *EndPos,
 	Assert(size > SizeOfXLogRecord);
 
 	/*
-	 * The duration the spinlock needs to be held is minimized by minimizing
-	 * the calculations that have to be done while holding the lock. The
-	 * current tip of reserved WAL is kept in CurrBytePos, as a byte position
-	 * that only counts "usable" bytes in WAL, that is, it excludes all WAL
-	 * page headers. The mapping between "usable" byte positions and physical
-	 * positions (XLogRecPtrs) can be done outside the locked region, and
-	 * because the usable byte position doesn't include any headers, reserving
-	 * X bytes from WAL is almost as simple as "CurrBytePos += X".
+	 * The current tip of reserved WAL is kept in CurrBytePos, as a byte
+	 * position that only counts "usable" bytes in WAL, that is, it excludes
+	 * all WAL page headers. The mapping between "usable" byte positions and
+	 * physical positions (XLogRecPtrs) can be done afterwards, and because
+	 * the usable byte position doesn't include any headers, reserving X bytes
+	 * from WAL is just "CurrBytePos += X".
 	 */
-	SpinLockAcquire(&Insert->insertpos_lck);
-
-	startbytepos = Insert->CurrBytePos;
+	startbytepos = pg_atomic_fetch_add_u64(&Insert->CurrBytePos, size);
 	endbytepos = startbytepos + size;
-	prevbytepos = Insert->PrevBytePos;
-	Insert->CurrBytePos = endbytepos;
-	Insert->PrevBytePos = startbytepos;
 
-	SpinLockRelease(&Insert->insertpos_lck);
+	prevbytepos = XLogPrevLinkTake(startbytepos);
+	XLogPrevLinkPublish(startbytepos, endbytepos);
 
 	*StartPos = XLogBytePosToRecPtr(startbytepos);
 	*EndPos = XLogBytePosToEndRecPtr(endbytepos);
@@ -1537,25 +1715,24 @@ ReserveXLogSwitch(XLogRecPtr *StartPos, XLogRecPtr *EndPos, XLogRecPtr *PrevPtr)
 	uint32		segleft;
 
 	/*
-	 * These calculations are a bit heavy-weight to be done while holding a
-	 * spinlock, but since we're holding all the WAL insertion locks, there
-	 * are no other inserters competing for it. GetXLogInsertRecPtr() does
-	 * compete for it, but that's not called very frequently.
+	 * Since we're holding all the WAL insertion locks, there are no other
+	 * inserters competing for CurrBytePos, and all the reservations before
+	 * ours have published their prev-links, so this needs no atomic
+	 * read-modify-write.
 	 */
-	SpinLockAcquire(&Insert->insertpos_lck);
+	Assert(holdingAllLocks);
 
-	startbytepos = Insert->CurrBytePos;
+	startbytepos = pg_atomic_read_u64(&Insert->CurrBytePos);
 
 	ptr = XLogBytePosToEndRecPtr(startbytepos);
 	if (XLogSegmentOffset(ptr, wal_segment_size) == 0)
 	{
-		SpinLockRelease(&Insert->insertpos_lck);
 		*EndPos = *StartPos = ptr;
 		return false;
 	}
 
 	endbytepos = startbytepos + size;
-	prevbytepos = Insert->PrevBytePos;
+	prevbytepos = XLogPrevLinkTake(startbytepos);
 
 	*StartPos = XLogBytePosToRecPtr(startbytepos);
 	*EndPos = XLogBytePosToEndRecPtr(endbytepos);
@@ -1567,10 +1744,8 @@ ReserveXLogSwitch(XLogRecPtr *StartPos, XLogRecPtr *EndPos, XLogRecPtr *PrevPtr)
 		*EndPos += segleft;
 		endbytepos = XLogRecPtrToBytePos(*EndPos);
 	}
-	Insert->CurrBytePos = endbytepos;
-	Insert->PrevBytePos = startbytepos;
-
-	SpinLockRelease(&Insert->insertpos_lck);
+	XLogPrevLinkPublish(startbytepos, endbytepos);
+	pg_atomic_write_u64(&Insert->CurrBytePos, endbytepos);
 
 	*PrevPtr = XLogBytePosToRecPtr(prevbytepos);
 
@@ -1984,9 +2159,7 @@ WaitXLogInsertionsToFinish(XLogRecPtr upto)
 		elog(PANIC, "cannot wait without a PGPROC structure");
 
 	/* Read the current insert position */
-	SpinLockAcquire(&Insert->insertpos_lck);
-	bytepos = Insert->CurrBytePos;
-	SpinLockRelease(&Insert->insertpos_lck);
+	bytepos = pg_atomic_read_u64(&Insert->CurrBytePos);
 	reservedUpto = XLogBytePosToEndRecPtr(bytepos);
 
 	/*
@@ -2869,6 +3042,11 @@ XLogWrite(XLogwrtRqst WriteRqst, bool flexible)
 
 			issue_xlog_fsync(openLogFile, openLogSegNo);
 		}
+		else if (IsRpcClient)
+		{
+			/* the writes may still be in flight to the storage node */
+			issue_xlog_fsync(openLogFile, openLogSegNo);
+		}
 
 		/* signal that we need to wakeup walsenders later */
 		WalSndWakeupRequest();
@@ -2876,6 +3054,17 @@ XLogWrite(XLogwrtRqst WriteRqst, bool flexible)
 		LogwrtResult.Flush = LogwrtResult.Write;
 	}
 
+	/*
+	 * Writes still in flight to the storage node must land before the next
+	 * holder of WALWriteLock sends its own over another connection.
+	 */
+	if (IsRpcClient && !RpcXLogWritesComplete())
+		ereport(PANIC,
+				(errcode_for_file_access(),
+				 errmsg("could not write to log file at %X/%X: %m",
+						(uint32) (LogwrtResult.Write >> 32),
+						(uint32) LogwrtResult.Write)));
+
 	/*
 	 * Update shared-memory status
 	 *
@@ -4679,7 +4868,9 @@ ReadRecord(XLogReaderState *xlogreader, int emode,
             printf("%s reached the end of xlog\n", __func__ );
             fflush(stdout);
 #endif
+            LogindexPipelineDrain();
             reachXlogTempEnd = 1;
+            LsnWaiterWakeAll();
 			if (readFile >= 0)
 			{
 				close(readFile);
@@ -5347,6 +5538,28 @@ XLOGChooseNumBuffers(void)
 	return xbuffers;
 }
 
+/*
+ * Auto-tune the number of WAL insertion locks, to the number of CPUs.
+ */
+static int
+XLOGChooseNumInsertLocks(void)
+{
+	long		ncpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (int) Max(Min(ncpus, 64), 8);
+}
+
+/*
+ * Number of prev-link table entries, a power of 2. Only the inserters between
+ * their reservation and publishing their prev-link hold an entry, at most one
+ * per insertion lock, so a few times that number keeps collisions rare.
+ */
+static uint32
+XLogPrevLinkCount(void)
+{
+	return Max(pg_nextpower2_32((uint32) NUM_XLOGINSERT_LOCKS * 4), 64);
+}
+
 /*
  * GUC check_hook for wal_buffers
  */
@@ -5425,11 +5638,23 @@ XLOGShmemSize(void)
 	}
 	Assert(XLOGbuffers > 0);
 
+	/* Likewise for wal_insert_locks */
+	if (XLOGInsertLocks == -1)
+	{
+		char		buf[32];
+
+		snprintf(buf, sizeof(buf), "%d", XLOGChooseNumInsertLocks());
+		SetConfigOption("wal_insert_locks", buf, PGC_POSTMASTER, PGC_S_OVERRIDE);
+	}
+	Assert(XLOGInsertLocks > 0);
+
 	/* XLogCtl */
 	size = sizeof(XLogCtlData);
 
 	/* WAL insertion locks, plus alignment */
 	size = add_size(size, mul_size(sizeof(WALInsertLockPadded), NUM_XLOGINSERT_LOCKS + 1));
+	/* the prev-link table */
+	size = add_size(size, mul_size(sizeof(XLogPrevLink), XLogPrevLinkCount()));
 	/* xlblocks array */
 	size = add_size(size, mul_size(sizeof(XLogRecPtr), XLOGbuffers));
 	/* extra alignment padding for XLOG I/O buffers */
@@ -5494,8 +5719,10 @@ XLOGShmemInit(void)
 		/* both should be present or neither */
 		Assert(foundCFile && foundXLog);
 
-		/* Initialize local copy of WALInsertLocks */
+		/* Initialize local copy of WALInsertLocks and the prev-link table */
 		WALInsertLocks = XLogCtl->Insert.WALInsertLocks;
+		XLogPrevLinks = XLogCtl->Insert.prevLinks;
+		XLogPrevLinkMask = XLogCtl->Insert.prevLinkMask;
 
 		if (localControlFile)
 			pfree(localControlFile);
@@ -5544,6 +5771,15 @@ XLOGShmemInit(void)
 		WALInsertLocks[i].l.lastImportantAt = InvalidXLogRecPtr;
 	}
 
+	XLogPrevLinks = XLogCtl->Insert.prevLinks = (XLogPrevLink *) allocptr;
+	XLogPrevLinkMask = XLogCtl->Insert.prevLinkMask = XLogPrevLinkCount() - 1;
+	allocptr += sizeof(XLogPrevLink) * XLogPrevLinkCount();
+	for (i = 0; i <= XLogPrevLinkMask; i++)
+	{
+		pg_atomic_init_u64(&XLogPrevLinks[i].end, 0);
+		XLogPrevLinks[i].start = 0;
+	}
+
     allocptr = (char *) TYPEALIGN(XLOG_BLCKSZ, allocptr);
     RpcXLogPages = allocptr;
     allocptr += (Size) XLOG_BLCKSZ * XLOGbuffers;
@@ -5572,9 +5808,11 @@ XLOGShmemInit(void)
 	XLogCtl->SharedPromoteIsTriggered = false;
 	XLogCtl->WalWriterSleeping = false;
 
-	SpinLockInit(&XLogCtl->Insert.insertpos_lck);
+	pg_atomic_init_u64(&XLogCtl->Insert.CurrBytePos, 0);
 	SpinLockInit(&XLogCtl->info_lck);
 	SpinLockInit(&XLogCtl->ulsn_lck);
+	pg_atomic_init_u64(&XLogCtl->rpcPersistQueued, 0);
+	pg_atomic_init_u64(&XLogCtl->rpcPersistWritten, 0);
 #ifdef ENABLE_DEBUG_INFO
     printf("%s InitSharedLatch for recoveryWakeupLatch\n", __func__ );
     fflush(stdout);
@@ -5863,6 +6101,33 @@ readRecoverySignalFile(void)
 static void
 validateRecoveryParameters(void)
 {
+	/*
+	 * A compute node pinned to a past LSN reads no newer page, so it has to
+	 * be a hot standby whose replay stops there.
+	 */
+	if (IsRpcClient && RpcAsOfLsn != InvalidXLogRecPtr)
+	{
+		if (!StandbyModeRequested || !EnableHotStandby)
+			ereport(FATAL,
+					(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+					 errmsg("rpc_as_of_lsn requires standby mode with hot_standby enabled"),
+					 errhint("Create the file \"%s\" in the data directory.",
+							 STANDBY_SIGNAL_FILE)));
+		if (recoveryTarget != RECOVERY_TARGET_UNSET)
+			ereport(FATAL,
+					(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+					 errmsg("rpc_as_of_lsn cannot be combined with a recovery target")));
+		/* The memory pool only has the newest version of a page */
+		if (IsRpcClient > 1)
+			ereport(FATAL,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("rpc_as_of_lsn is not supported with the memory pool")));
+		recoveryTarget = RECOVERY_TARGET_LSN;
+		recoveryTargetLSN = RpcAsOfLsn;
+		recoveryTargetInclusive = true;
+		recoveryTargetAction = RECOVERY_TARGET_ACTION_PAUSE;
+	}
+
 	if (!ArchiveRecoveryRequested)
 		return;
 
@@ -6081,6 +6346,39 @@ getRecordTimestamp(XLogReaderState *record, TimestampTz *recordXtime)
 	return false;
 }
 
+/*
+ * Whether the record only changes pages, the redo InstantRecovery leaves to
+ * the storage node.  Records of these rmgrs without block references (heap
+ * rewrite mappings, new cids) still have to be redone.
+ */
+static bool
+RedoLeftToStorage(XLogReaderState *record)
+{
+	uint8		info = XLogRecGetInfo(record) & ~XLR_INFO_MASK;
+
+	if (!XLogRecHasAnyBlockRefs(record))
+		return false;
+
+	switch (XLogRecGetRmid(record))
+	{
+		case RM_XLOG_ID:
+			return info == XLOG_FPI || info == XLOG_FPI_FOR_HINT;
+		case RM_HEAP_ID:
+		case RM_HEAP2_ID:
+		case RM_BTREE_ID:
+		case RM_HASH_ID:
+		case RM_GIN_ID:
+		case RM_GIST_ID:
+		case RM_SEQ_ID:
+		case RM_SPGIST_ID:
+		case RM_BRIN_ID:
+		case RM_GENERIC_ID:
+			return true;
+		default:
+			return false;
+	}
+}
+
 /*
  * For point-in-time recovery, this function decides whether we want to
  * stop applying the XLOG before the current record.
@@ -6747,7 +7045,8 @@ StartupXLOG(void)
 	bool		haveTblspcMap = false;
 	XLogRecPtr	RecPtr,
 				checkPointLoc,
-				EndOfLog;
+				EndOfLog,
+				replayedUpto;
 	TimeLineID	EndOfLogTLI;
 	TimeLineID	PrevTimeLineID;
 	XLogRecord *record;
@@ -6759,6 +7058,7 @@ StartupXLOG(void)
 	XLogPageReadPrivate private;
 	bool		fast_promoted = false;
 	struct stat st;
+	uint64_t	logindexRestoredLsn = 0;
 
 	/*
 	 * We should have an aux process resource owner to use, and we should not
@@ -7363,6 +7663,13 @@ StartupXLOG(void)
 		InRecovery = true;
 	}
 
+	/*
+	 * After a clean shutdown, load the table statistics it saved; recovery
+	 * discards them, see pgstat_reset_all() below.
+	 */
+	if (!InRecovery)
+		pgstat_restore_shared_stats();
+
 	/* REDO */
 	if (InRecovery)
 	{
@@ -7624,7 +7931,9 @@ StartupXLOG(void)
 		 * process in addition to postmaster!  Also, fsync requests are
 		 * subsequently to be handled by the checkpointer, not locally.
 		 */
-		if (ArchiveRecoveryRequested && IsUnderPostmaster)
+		InstantRecovery = rpc_instant_recovery && IsRpcClient &&
+			!ArchiveRecoveryRequested;
+		if ((ArchiveRecoveryRequested || InstantRecovery) && IsUnderPostmaster)
 		{
 			PublishStartupProcessInformation();
 			EnableSyncRequestForwarding();
@@ -7642,11 +7951,28 @@ StartupXLOG(void)
         printf("%s  %d \n", __func__ , __LINE__);
         fflush(stdout);
 #endif
+		/*
+		 * On the storage node, a logindex checkpoint newer than the redo
+		 * point already holds every page version before its parse lsn, so
+		 * parsing can resume there.
+		 */
+		if (IsRpcServer && LogindexCheckpointEnabled() &&
+			LogindexCheckpointRestore(pageVersionHashMap, checkPoint.redo, &logindexRestoredLsn,
+									  LogindexRestoreRelSize, NULL))
+		{
+			XLogParseUpto = logindexRestoredLsn;
+			LsnWaiterAdvance(XLogParseUpto);
+			ereport(LOG,
+					(errmsg("logindex checkpoint restored up to %X/%X",
+							(uint32) (logindexRestoredLsn >> 32), (uint32) logindexRestoredLsn)));
+			XLogBeginRead(xlogreader, logindexRestoredLsn);
+			record = ReadRecord(xlogreader, PANIC, false);
+		}
 		/*
 		 * Find the first record that logically follows the checkpoint --- it
 		 * might physically precede it, though.
 		 */
-		if (checkPoint.redo < RecPtr)
+		else if (checkPoint.redo < RecPtr)
 		{
 			/* back up to find the record */
 			XLogBeginRead(xlogreader, checkPoint.redo);
@@ -7657,6 +7983,11 @@ StartupXLOG(void)
 			/* just have to read next record after CheckPoint */
 			record = ReadRecord(xlogreader, LOG, false);
 		}
+		if (IsRpcServer)
+		{
+			LogindexPipelineStart(pageVersionHashMap);
+			LogindexCheckpointStart(pageVersionHashMap, &XLogParseUpto);
+		}
 
 #ifdef ITER_TIMING
         struct timeval start;
@@ -7913,17 +8244,20 @@ StartupXLOG(void)
 //                                    fflush(stdout);
                                     uint32_t result = -1;
                                     bool found = GetRelSizeCache(relKey, &result);
-                                    if(found && result<xlogreader->blocks[i].blkno+1) {
-                                        InsertRelSizeCache(relKey, xlogreader->blocks[i].blkno+1);
-                                    } else if(!found) {
+                                    if(found) {
+                                        ExtendRelSizeCache(relKey, xlogreader->blocks[i].blkno+1);
+                                    } else {
                                         // TODO: Could this merge with RocksDb creating list, since we will migrate list from RocksDb to inMem hashTable
                                         int baseRelSize = SyncGetRelSize(xlogreader->blocks[i].rnode, xlogreader->blocks[i].forknum, xlogreader->ReadRecPtr);
                                         if(baseRelSize > xlogreader->blocks[i].blkno+1) {
-                                            InsertRelSizeCache(relKey, baseRelSize);
+                                            ExtendRelSizeCache(relKey, baseRelSize);
                                         } else {
-                                            InsertRelSizeCache(relKey, xlogreader->blocks[i].blkno+1);
+                                            ExtendRelSizeCache(relKey, xlogreader->blocks[i].blkno+1);
                                         }
                                     }
+                                    // Readers at this record's LSN or later see the size
+                                    if(GetRelSizeCache(relKey, &result))
+                                        RpcRelSizeExtend(relKey, result, xlogreader->EndRecPtr);
 //                                    printf("%s %d\n", __func__ , __LINE__);
 //                                    fflush(stdout);
 //                                    RelSizeReleaseLock(relKey);
@@ -7945,6 +8279,7 @@ StartupXLOG(void)
                     fflush(stdout);
 #endif
                     bool parsed = false;
+                    bool pageRecord = true;
                     switch (record->xl_rmid) {
                         case RM_XLOG_ID:
                             parsed = polar_xlog_idx_save(xlogreader);
@@ -7980,6 +8315,7 @@ StartupXLOG(void)
                             parsed = polar_generic_idx_save(xlogreader);
                             break;
                         default:
+                            pageRecord = false;
                             break;
                     }
 
@@ -8005,6 +8341,14 @@ StartupXLOG(void)
                     RECORD_TIMING(&start, &end, &(startupTime[3]), &(startupCount[3]))
 #endif
                     if(!parsed) {
+                        // A page record redone here may read pages, which
+                        // must have every version queued so far indexed
+                        if(pageRecord || record->xl_rmid == RM_SMGR_ID || record->xl_rmid == RM_DBASE_ID)
+                            LogindexPipelineDrain();
+                        // Secondaries following the page change feed have
+                        // to hear of the pages changed here as well
+                        if(pageRecord)
+                            PageChangeFeedPublishRecord(xlogreader);
                         RmgrTable[record->xl_rmid].rm_redo(xlogreader);
 
                     }
@@ -8015,18 +8359,13 @@ StartupXLOG(void)
                     fflush(stdout);
 #endif
 
-                    if(xlogreader->EndRecPtr > XLogParseUpto) {
-                        XLogParseUpto = xlogreader->EndRecPtr;
+                    // XLogParseUpto follows once this record's versions are indexed.
+                    // It seems sometime xlogreader->EndRecPtr won't change
+                    LogindexPipelineAdvance(Max(xlogreader->EndRecPtr, xlogreader->ReadRecPtr));
 #ifdef ENABLE_STARTUP_DEBUG_INFO
-                        printf("%s %d , set XLogParseUpto as %lu\n", __func__ , __LINE__, XLogParseUpto);
-                        fflush(stdout);
+                    printf("%s %d , parsed up to %lu\n", __func__ , __LINE__, Max(xlogreader->EndRecPtr, xlogreader->ReadRecPtr));
+                    fflush(stdout);
 #endif
-
-                    }
-                    // It seems sometime xlogreader->EndRecPtr won't change
-                    if(xlogreader->ReadRecPtr > XLogParseUpto) {
-                        XLogParseUpto = xlogreader->ReadRecPtr;
-                    }
 #ifdef DEBUG_TIMING
                     RECORD_TIMING(&start, &end, &(startupTime[4]), &(startupCount[4]))
 #endif
@@ -8083,25 +8422,43 @@ StartupXLOG(void)
                     BufferTag * bufferTagList = NULL;
                     int tagNum;
                     int parsed = GetXlogBuffTagList(xlogreader, &bufferTagList, &tagNum);
+                    // Buffers the storage node's page change feed already
+                    // refreshed for this record need no redo
+                    bool fed = BufChangeFeedCatchUp(xlogreader->ReadRecPtr);
                     if(!parsed) { // If not related with buffer pool
 #ifdef ENABLE_STARTUP_DEBUG_INFO
                         printf("%s %d, immediately reply the xlog\n", __func__ , __LINE__);
                         fflush(stdout);
 #endif
-                        RmgrTable[record->xl_rmid].rm_redo(xlogreader);
+                        // A barrier: what it changes may be seen only once
+                        // the pages before it are redone
+                        ParallelRedoWaitAll();
+                        if(!(InstantRecovery && RedoLeftToStorage(xlogreader)))
+                            RmgrTable[record->xl_rmid].rm_redo(xlogreader);
                     } else {
+                        // A standby's pages may be redone by the redo workers
+                        bool parallel = StandbyMode && !fed && tagNum > 0 && ParallelRedoEnabled();
+                        BufferTag *redoTags = parallel ? palloc(tagNum * sizeof(BufferTag)) : NULL;
+                        int redoTagNum = 0;
+
 #ifdef ENABLE_STARTUP_DEBUG_INFO
                         printf("%s %d, need single redo for pages\n", __func__ , __LINE__);
                         fflush(stdout);
 #endif
                         // Iterate all blocks in bufferTag
-                        for(int i = 0; i < tagNum; i++) {
+                        for(int i = 0; i < tagNum && !fed; i++) {
                             BufferTag tempTag = bufferTagList[i];
 #ifdef ENABLE_STARTUP_DEBUG_INFO
                             printf("%s %d, find page in buffer, spc=%u, db=%u, rel=%u, fork=%d, blk=%u\n", __func__ , __LINE__,
                                    tempTag.rnode.spcNode, tempTag.rnode.dbNode, tempTag.rnode.relNode, tempTag.forkNum, tempTag.blockNum);
                             fflush(stdout);
 #endif
+                            // A kept map page is outdated whether or not
+                            // the block is in buffers, the redo doesn't
+                            // bring in the visibility map page it clears
+                            MapPageCacheInvalidateRedo(&tempTag);
+                            IndexPageCacheInvalidate(&tempTag);
+
                             // Find and lock the buffer content
                             // TODO, xlogRedoSinglePage will lock again
                             Buffer buff = FindPageInBuffer(tempTag.rnode, tempTag.forkNum, tempTag.blockNum);
@@ -8110,13 +8467,20 @@ StartupXLOG(void)
                             fflush(stdout);
 #endif
 
-                            // If buffer pool doesn't contain this page, just ignore (no redo)
+                            // If buffer pool doesn't contain this page, just ignore (no redo),
+                            // but a copy on the local SSD or compressed in
+                            // memory is no longer current
                             if(buff == InvalidBuffer) {
+                                LocalPageCacheInvalidate(&tempTag);
+                                CompressedPageCacheInvalidate(&tempTag);
 #ifdef ENABLE_STARTUP_DEBUG_INFO
                                 printf("%s %d drop this xlog block\n", __func__ , __LINE__);
                                 fflush(stdout);
 #endif
                                 continue;
+                            } else if(parallel) {
+                                ReleaseBuffer(buff);
+                                redoTags[redoTagNum++] = tempTag;
                             } else { //
 //                                UnlockReleaseBuffer(buff);
                                 buff = InvalidBuffer;
@@ -8138,6 +8502,10 @@ StartupXLOG(void)
                             }
                         }
 
+                        if(redoTagNum > 0)
+                            ParallelRedoDispatch(xlogreader, redoTags, redoTagNum);
+                        if(redoTags != NULL)
+                            pfree(redoTags);
                         if(tagNum > 0)
                             free(bufferTagList);
                     }
@@ -8172,10 +8540,13 @@ StartupXLOG(void)
 
 				/*
 				 * Update lastReplayedEndRecPtr after this record has been
-				 * successfully replayed.
+				 * successfully replayed, and the pages of those before it the
+				 * redo workers may still be at.
 				 */
+				replayedUpto = ParallelRedoReplayedUpto(EndRecPtr);
+				parallelRedoBehind = replayedUpto < EndRecPtr;
 				SpinLockAcquire(&XLogCtl->info_lck);
-				XLogCtl->lastReplayedEndRecPtr = EndRecPtr;
+				XLogCtl->lastReplayedEndRecPtr = replayedUpto;
 				XLogCtl->lastReplayedTLI = ThisTimeLineID;
 				SpinLockRelease(&XLogCtl->info_lck);
 
@@ -8229,6 +8600,7 @@ StartupXLOG(void)
 			/*
 			 * end of main redo apply loop
 			 */
+			ParallelRedoShutdown();
 
 			if (reachedRecoveryTarget)
 			{
@@ -8494,8 +8866,9 @@ StartupXLOG(void)
 	 * previous incarnation.
 	 */
 	Insert = &XLogCtl->Insert;
-	Insert->PrevBytePos = XLogRecPtrToBytePos(LastRec);
-	Insert->CurrBytePos = XLogRecPtrToBytePos(EndOfLog);
+	pg_atomic_write_u64(&Insert->CurrBytePos, XLogRecPtrToBytePos(EndOfLog));
+	XLogPrevLinkPublish(XLogRecPtrToBytePos(LastRec),
+						XLogRecPtrToBytePos(EndOfLog));
 
 	/*
 	 * Tricky point here: readBuf contains the *last* block that the LastRec
@@ -8568,7 +8941,7 @@ StartupXLOG(void)
 		 */
 		if (bgwriterLaunched)
 		{
-			if (fast_promote)
+			if (fast_promote || InstantRecovery)
 			{
 				checkPointLoc = ControlFile->checkPoint;
 
@@ -8786,6 +9159,12 @@ StartupXLOG(void)
 	 */
 	WalSndWakeup();
 
+	/*
+	 * Warm the shared buffers up before postmaster lets connections in, which
+	 * it does once we exit.  A standby did it before hot standby began.
+	 */
+	BufWarmStartLoad();
+
 	/*
 	 * If this was a fast promotion, request an (online) checkpoint now. This
 	 * isn't required for consistency, but the last restartpoint might be far
@@ -8889,6 +9268,8 @@ CheckRecoveryConsistency(void)
 
 		LocalHotStandbyActive = true;
 
+		BufWarmStartLoad();
+
 		SendPostmasterSignal(PMSIGNAL_BEGIN_HOT_STANDBY);
 	}
 }
@@ -9639,7 +10020,7 @@ CreateCheckPoint(int flags)
 	 * determine the checkpoint REDO pointer.
 	 */
 	WALInsertLockAcquireExclusive();
-	curInsert = XLogBytePosToRecPtr(Insert->CurrBytePos);
+	curInsert = XLogBytePosToRecPtr(pg_atomic_read_u64(&Insert->CurrBytePos));
 
 	/*
 	 * If this isn't a shutdown or forced checkpoint, and if there has been no
@@ -10020,7 +10401,10 @@ CheckPointGuts(XLogRecPtr checkPointRedo, int flags)
 	CheckPointReplicationSlots();
 	CheckPointSnapBuild();
 	CheckPointLogicalRewriteHeap();
-	CheckPointBuffers(flags);	/* performs all required fsyncs */
+	if (IsRpcClient && rpc_disaggregated_checkpoint)
+		CheckPointBuffersDisaggregated(checkPointRedo, flags);
+	else
+		CheckPointBuffers(flags);	/* performs all required fsyncs */
 	CheckPointReplicationOrigin();
 	/* We deliberately delay 2PC checkpointing as long as possible */
 	CheckPointTwoPhase(checkPointRedo);
@@ -11265,7 +11649,9 @@ issue_xlog_fsync(int fd, XLogSegNo segno)
 #endif
 		case SYNC_METHOD_OPEN:
 		case SYNC_METHOD_OPEN_DSYNC:
-			/* write synced it already */
+			/* write synced it already, once the storage node answered it */
+			if (IsRpcClient && !RpcXLogWritesComplete())
+				msg = _("could not write to file \"%s\": %m");
 			break;
 		default:
 			elog(PANIC, "unrecognized wal_sync_method: %d", sync_method);
@@ -12346,9 +12732,7 @@ GetXLogInsertRecPtr(void)
 	XLogCtlInsert *Insert = &XLogCtl->Insert;
 	uint64		current_bytepos;
 
-	SpinLockAcquire(&Insert->insertpos_lck);
-	current_bytepos = Insert->CurrBytePos;
-	SpinLockRelease(&Insert->insertpos_lck);
+	current_bytepos = pg_atomic_read_u64(&Insert->CurrBytePos);
 
 	return XLogBytePosToRecPtr(current_bytepos);
 }
@@ -12693,6 +13077,108 @@ CancelBackup(void)
 	}
 }
 
+/*
+ * The end of the WAL of the open segment that can't change any more, so
+ * that XLogReadPage() may read the pages below it ahead, or invalid if
+ * only the page asked for should be read.
+ */
+static XLogRecPtr
+XLogReadaheadLimit(void)
+{
+	XLogRecPtr	upto;
+
+	if (wal_readahead_size <= 1)
+		return InvalidXLogRecPtr;
+
+	if (readSource == XLOG_FROM_STREAM)
+		upto = flushedUpto;
+	else if (readSource == XLOG_FROM_RPC)
+		upto = RpcXLogFlushedLsn;
+	else if (!StandbyMode && !IsRpcServer)
+	{
+		/* Nothing writes the segments read by crash or archive recovery */
+		upto = PG_UINT64_MAX;
+	}
+	else
+		return InvalidXLogRecPtr;
+
+	if (IsRpcServer)
+		upto = XLogRpcPersistedUpto(upto);
+	return upto;
+}
+
+/* Read amount bytes at offset off of the open segment */
+static int
+XLogReadFile(char *buf, int amount, uint32 off)
+{
+	int			r;
+
+#ifdef RPC_REMOTE_DISK
+	if (IsRpcClient)
+		return WalReadCacheRead(readFile, curFileTLI, readSegNo, buf, amount, (int) off);
+#endif
+	r = pg_pread(readFile, buf, amount, (off_t) off);
+
+	/* Blocks of a segment the storage node compressed read as zeros */
+	if (r > 0 && IsRpcServer &&
+		!WalRetentionFill(curFileTLI, readSegNo, buf, r, off))
+	{
+		errno = EIO;
+		return -1;
+	}
+	return r;
+}
+
+/*
+ * Read the page at targetPagePtr of the open segment into readBuf, from
+ * the WAL read ahead if it's there.  Otherwise the complete pages after it
+ * are read along with it, in a single read of up to wal_readahead_size
+ * pages, so that in RPC mode a scan of the WAL takes a call every so many
+ * pages instead of every page.  Returns the bytes read of the page.
+ */
+static int
+XLogReadPage(char *readBuf, XLogRecPtr targetPagePtr)
+{
+	uint32		pageOff = XLogSegmentOffset(targetPagePtr, wal_segment_size);
+	XLogRecPtr	segStart = targetPagePtr - pageOff;
+	XLogRecPtr	limit;
+	uint32		end;
+	int			r;
+
+	if (walReadaheadSegNo == readSegNo && walReadaheadTLI == curFileTLI &&
+		pageOff >= walReadaheadStart && pageOff + XLOG_BLCKSZ <= walReadaheadEnd)
+	{
+		memcpy(readBuf, walReadaheadBuf + (pageOff - walReadaheadStart), XLOG_BLCKSZ);
+		return XLOG_BLCKSZ;
+	}
+
+	limit = XLogReadaheadLimit();
+	if (limit <= segStart + pageOff + 2 * XLOG_BLCKSZ)
+		return XLogReadFile(readBuf, XLOG_BLCKSZ, pageOff);
+
+	end = (uint32) Min(limit - segStart, (XLogRecPtr) wal_segment_size);
+	end = Min(end - end % XLOG_BLCKSZ, pageOff + (uint32) wal_readahead_size * XLOG_BLCKSZ);
+
+	if (walReadaheadBuf == NULL)
+		walReadaheadBuf = MemoryContextAllocExtended(TopMemoryContext,
+													 (Size) wal_readahead_size * XLOG_BLCKSZ,
+													 MCXT_ALLOC_NO_OOM);
+	if (walReadaheadBuf == NULL)
+		return XLogReadFile(readBuf, XLOG_BLCKSZ, pageOff);
+
+	walReadaheadEnd = walReadaheadStart = 0;
+	r = XLogReadFile(walReadaheadBuf, (int) (end - pageOff), pageOff);
+	if (r < XLOG_BLCKSZ)
+		return XLogReadFile(readBuf, XLOG_BLCKSZ, pageOff);
+
+	walReadaheadSegNo = readSegNo;
+	walReadaheadTLI = curFileTLI;
+	walReadaheadStart = pageOff;
+	walReadaheadEnd = pageOff + (uint32) r - (uint32) r % XLOG_BLCKSZ;
+	memcpy(readBuf, walReadaheadBuf, XLOG_BLCKSZ);
+	return XLOG_BLCKSZ;
+}
+
 /*
  * Read the XLOG page containing RecPtr into readBuf (if not read already).
  * Returns number of bytes read, if the page is read successfully, or -1
@@ -12899,10 +13385,9 @@ retry:
         fflush(stdout);
 #endif
 #ifdef RPC_REMOTE_DISK
-        r = pg_pread_rpc_local(readFile, readBuf, XLOG_BLCKSZ, (int) readOff);
-#else
-        r = pg_pread(readFile, readBuf, XLOG_BLCKSZ, (off_t) readOff);
+        XLogRpcPersistWait(targetPagePtr + reqLen);
 #endif
+        r = XLogReadPage(readBuf, targetPagePtr);
     }
     if(IsRpcServer) {
         pthread_rwlock_unlock(&(RpcXLogPagesLocks[bufferIdx]));
@@ -12998,10 +13483,14 @@ next_record_is_invalid:
 	readFile = -1;
 	readLen = 0;
 	readSource = XLOG_FROM_ANY;
+	/* The next source might have the pages differently */
+	walReadaheadEnd = walReadaheadStart = 0;
 
 	/* In standby-mode or rpc server mode, keep trying */
 	if (StandbyMode || IsRpcServer) {
+        LogindexPipelineDrain();
         reachXlogTempEnd = 1;
+        LsnWaiterWakeAll();
 
         goto retry;
     }
@@ -13569,6 +14058,7 @@ WaitForWALToBecomeAvailable(XLogRecPtr RecPtr, bool randAccess,
 					 * that pg_stat_replication doesn't show stale
 					 * information.
 					 */
+					WaitForParallelRedo();
 					if (!streaming_reply_sent)
 					{
 						WalRcvForceReply();
@@ -13604,6 +14094,7 @@ WaitForWALToBecomeAvailable(XLogRecPtr RecPtr, bool randAccess,
                 }
 //                printf("%s %d, get into RPC Latch waiting, flushedLsn = %lu, pid = %d\n", __func__ , __LINE__, RpcXLogFlushedLsn, gettid());
 //                fflush(stdout);
+                WaitForParallelRedo();
                 WaitForNewXLog(0, 5000000);
 //                (void) WaitLatch(&XLogCtl->recoveryWakeupLatch,
 //                                 WL_LATCH_SET | WL_TIMEOUT |
@@ -13636,6 +14127,23 @@ WaitForWALToBecomeAvailable(XLogRecPtr RecPtr, bool randAccess,
 	return false;				/* not reached */
 }
 
+/*
+ * Before waiting for more WAL, let the redo workers finish the pages of the
+ * records read so far, so that the replay position reported covers them.
+ */
+static void
+WaitForParallelRedo(void)
+{
+	if (!parallelRedoBehind)
+		return;
+
+	ParallelRedoWaitAll();
+	SpinLockAcquire(&XLogCtl->info_lck);
+	XLogCtl->lastReplayedEndRecPtr = EndRecPtr;
+	SpinLockRelease(&XLogCtl->info_lck);
+	parallelRedoBehind = false;
+}
+
 /*
  * Set flag to signal the walreceiver to restart.  (The startup process calls
  * this on noticing a relevant configuration change.)
@@ -13843,11 +14351,74 @@ XLogRequestWalReceiverReply(void)
 
 uint64_t GetLogWrtResultLsn(void)
 {
+    // Replay stops there too, see validateRecoveryParameters()
+    if(IsRpcClient && RpcAsOfLsn != InvalidXLogRecPtr)
+        return RpcAsOfLsn;
     if(WalRcv && WalRcv->flushedUpto > XLogCtl->LogwrtResult.Flush)
         return WalRcv->flushedUpto;
     else
         return XLogCtl->LogwrtResult.Flush;
 }
+static void
+AtomicAdvanceU64(pg_atomic_uint64 *target, uint64 value)
+{
+	uint64		old = pg_atomic_read_u64(target);
+
+	while (old < value &&
+		   !pg_atomic_compare_exchange_u64(target, &old, value))
+		;
+}
+
+/*
+ * Called by the storage node as WAL up to upto is queued for its segment
+ * files, before the WAL is published to readers of RpcXLogPages.
+ */
+void
+XLogRpcPersistQueued(XLogRecPtr upto)
+{
+	AtomicAdvanceU64(&XLogCtl->rpcPersistQueued, upto);
+}
+
+/* Called by the persistence thread as WAL up to upto is written */
+void
+XLogRpcPersistWritten(XLogRecPtr upto)
+{
+	AtomicAdvanceU64(&XLogCtl->rpcPersistWritten, upto);
+}
+
+/*
+ * How far the segment files are known to hold the WAL, up to upto.  Like
+ * XLogRpcPersistWait(), but without waiting.
+ */
+XLogRecPtr
+XLogRpcPersistedUpto(XLogRecPtr upto)
+{
+	XLogRecPtr	written = pg_atomic_read_u64(&XLogCtl->rpcPersistWritten);
+
+	if (written < upto &&
+		written < pg_atomic_read_u64(&XLogCtl->rpcPersistQueued))
+		return written;
+	return upto;
+}
+
+/*
+ * Wait until the segment files hold the WAL up to upto, if any of it is
+ * still queued.  Only a reader that misses RpcXLogPages gets here.
+ */
+void
+XLogRpcPersistWait(XLogRecPtr upto)
+{
+	for (;;)
+	{
+		XLogRecPtr	written = pg_atomic_read_u64(&XLogCtl->rpcPersistWritten);
+
+		if (written >= upto ||
+			written >= pg_atomic_read_u64(&XLogCtl->rpcPersistQueued))
+			return;
+		pg_usleep(100L);
+	}
+}
+
 extern void GetLogWrtResult(XLogRecPtr* Write, XLogRecPtr* Flush){
 	*Write = XLogCtl->LogwrtResult.Write;
 	*Flush = XLogCtl->LogwrtResult.Flush;
@@ -13929,7 +14500,14 @@ void ParseXLogBlocksLsn(XLogReaderState *record, int recordBlockId) {
 	if(IsRpcClient > 2)
 		InsertIntoVersionMap(key, record->ReadRecPtr);
 	else
-    	HashMapInsertKey(pageVersionHashMap, key, record->ReadRecPtr, 0, true);
+	{
+    	LogindexPipelineInsert(pageVersionHashMap, key, record->ReadRecPtr,
+							   XLogRecBlockImageApply(record, recordBlockId)
+							   || (record->blocks[recordBlockId].flags & BKPBLOCK_WILL_INIT) != 0);
+		/* Each block of the record is charged an equal part of it */
+		ASR_RecordTenantWal(key.DbID, key.RelID,
+							XLogRecGetTotalLen(record) / (record->max_block_id + 1));
+	}
 
 #ifdef ENABLE_DEBUG_INFO
     if (info == 0xA0) {
@@ -18,6 +18,7 @@
 #include "postgres.h"
 
 #include <unistd.h>
+#include <lz4.h>
 
 #include "access/transam.h"
 #include "access/xlog_internal.h"
@@ -27,6 +28,7 @@
 #include "common/pg_lzcompress.h"
 #include "replication/origin.h"
 #include "storage/rpcclient.h"
+#include "storage/wal_read_cache.h"
 
 #ifndef FRONTEND
 #include "miscadmin.h"
@@ -41,6 +43,13 @@ int pg_pread_rpc_local2(int fd, char *p, int amount, int offset) {
     else
         return pg_pread(fd, p, amount, offset);
 }
+
+static int pg_pread_segment_rpc_local(WALOpenSegment *seg, char *p, int amount, int offset) {
+    if(IsRpcClient)
+        return WalReadCacheRead(seg->ws_file, seg->ws_tli, seg->ws_segno, p, amount, offset);
+    else
+        return pg_pread(seg->ws_file, p, amount, offset);
+}
 #endif
 
 
@@ -49,6 +58,9 @@ static void report_invalid_record(XLogReaderState *state, const char *fmt,...)
 static bool allocate_recordbuf(XLogReaderState *state, uint32 reclength);
 static int	ReadPageInternal(XLogReaderState *state, XLogRecPtr pageptr,
 							 int reqLen);
+static bool XLogReaderSelectPage(XLogReaderState *state, XLogRecPtr pageptr);
+static XLogRecord *XLogReadRecordInternal(XLogReaderState *state, bool decode,
+										  char **errormsg);
 static void XLogReaderInvalReadState(XLogReaderState *state);
 static bool ValidXLogRecordHeader(XLogReaderState *state, XLogRecPtr RecPtr,
 								  XLogRecPtr PrevRecPtr, XLogRecord *record, bool randAccess);
@@ -61,6 +73,9 @@ static void WALOpenSegmentInit(WALOpenSegment *seg, WALSegmentContext *segcxt,
 /* size of the buffer allocated for error message. */
 #define MAX_ERRORMSG_LEN 1000
 
+/* initial size of the buffer a batch assembles records crossing pages in */
+#define XLOG_BATCH_ARENA_SIZE (8 * Max(BLCKSZ, XLOG_BLCKSZ))
+
 /*
  * Construct a string in state->errormsg_buf explaining what's wrong with
  * the current record being read.
@@ -165,10 +180,52 @@ XLogReaderFree(XLogReaderState *state)
 	pfree(state->errormsg_buf);
 	if (state->readRecordBuf)
 		pfree(state->readRecordBuf);
-	pfree(state->readBuf);
+	if (state->readaheadBuf)
+	{
+		pfree(state->readaheadBuf);
+		pfree(state->readaheadPagePtrs);
+	}
+	else
+		pfree(state->readBuf);
 	pfree(state);
 }
 
+/*
+ * Have readBuf move through a ring of npages pages, so that the records
+ * XLogReadRecordBatch() finds within a page can be left where they were
+ * read.  Returns false if out of memory; the reader then keeps reading into
+ * a single page.
+ */
+bool
+XLogReaderSetReadahead(XLogReaderState *state, int npages)
+{
+	char	   *buf;
+	XLogRecPtr *pageptrs;
+
+	if (npages <= 1 || state->readaheadBuf != NULL)
+		return true;
+
+	buf = (char *) palloc_extended((Size) npages * XLOG_BLCKSZ,
+								   MCXT_ALLOC_NO_OOM);
+	pageptrs = (XLogRecPtr *) palloc_extended(sizeof(XLogRecPtr) * npages,
+											  MCXT_ALLOC_NO_OOM | MCXT_ALLOC_ZERO);
+	if (!buf || !pageptrs)
+	{
+		if (buf)
+			pfree(buf);
+		if (pageptrs)
+			pfree(pageptrs);
+		return false;
+	}
+
+	pfree(state->readBuf);
+	state->readBuf = state->readaheadBuf = buf;
+	state->readaheadPagePtrs = pageptrs;
+	state->readaheadPages = npages;
+	XLogReaderInvalReadState(state);
+	return true;
+}
+
 /*
  * Allocate readRecordBuf to fit a record of at least the given length.
  * Returns true if successful, false if out of memory.
@@ -277,6 +334,159 @@ XLogBeginRead(XLogReaderState *state, XLogRecPtr RecPtr)
  */
 XLogRecord *
 XLogReadRecord(XLogReaderState *state, char **errormsg)
+{
+	/* The pages of the last batch may be read over */
+	state->readaheadPinned = InvalidXLogRecPtr;
+
+	return XLogReadRecordInternal(state, true, errormsg);
+}
+
+/*
+ * Read the records following the reader's position into batch, until it's
+ * full, a record ends at or after upto (if valid) or no more can be read.
+ * A record within one page is left where it was read, in the reader's ring
+ * of pages (see XLogReaderSetReadahead()); the batch ends before a page
+ * would be read over one of them.  A record that crosses a page boundary
+ * isn't contiguous in the WAL, and is assembled into the batch's arena.
+ *
+ * The records aren't decoded, and the reader stays where it was until they
+ * are, one by one, by XLogRecordBatchDecode().  The next read from the
+ * reader starts after the last record decoded.  They're valid until then.
+ *
+ * Returns how many records were read.  If none could be, *errormsg is set
+ * as by XLogReadRecord(); an error after some records is met again by the
+ * next read.
+ */
+int
+XLogReadRecordBatch(XLogReaderState *state, XLogRecordBatch *batch,
+					XLogRecPtr upto, char **errormsg)
+{
+	*errormsg = NULL;
+	batch->nrecords = 0;
+	batch->arena_used = 0;
+	batch->prevReadRecPtr = state->ReadRecPtr;
+	batch->prevEndRecPtr = state->EndRecPtr;
+	state->readaheadPinned = InvalidXLogRecPtr;
+	state->readaheadFull = false;
+
+	while (batch->nrecords < batch->max_records &&
+		   (XLogRecPtrIsInvalid(upto) || state->EndRecPtr < upto))
+	{
+		XLogRecord *record = XLogReadRecordInternal(state, false, errormsg);
+		int			n = batch->nrecords;
+
+		if (record == NULL)
+		{
+			if (n > 0 || state->readaheadFull)
+				*errormsg = NULL;
+			break;
+		}
+
+		if ((char *) record == state->readRecordBuf)
+		{
+			Size		len = MAXALIGN(record->xl_tot_len);
+
+			if (batch->arena_used + len > batch->arena_size)
+			{
+				char	   *arena;
+
+				/* It's read again by the next batch */
+				if (n > 0)
+					break;
+				arena = (char *) palloc_extended(len, MCXT_ALLOC_NO_OOM);
+				if (arena == NULL)
+				{
+					report_invalid_record(state, "out of memory for record of length %u at %X/%X",
+										  record->xl_tot_len,
+										  (uint32) (state->ReadRecPtr >> 32),
+										  (uint32) state->ReadRecPtr);
+					*errormsg = state->errormsg_buf;
+					break;
+				}
+				pfree(batch->arena);
+				batch->arena = arena;
+				batch->arena_size = len;
+			}
+			memcpy(batch->arena + batch->arena_used, record, record->xl_tot_len);
+			record = (XLogRecord *) (batch->arena + batch->arena_used);
+			batch->arena_used += len;
+		}
+		else if (XLogRecPtrIsInvalid(state->readaheadPinned))
+			state->readaheadPinned = state->ReadRecPtr - state->ReadRecPtr % XLOG_BLCKSZ;
+
+		batch->records[n] = record;
+		batch->startptrs[n] = state->ReadRecPtr;
+		batch->endptrs[n] = state->EndRecPtr;
+		batch->nrecords++;
+	}
+
+	state->ReadRecPtr = batch->prevReadRecPtr;
+	state->EndRecPtr = batch->prevEndRecPtr;
+	return batch->nrecords;
+}
+
+/*
+ * Decode record i of batch into the reader and move the reader past it, as
+ * XLogReadRecord() would have read it.  Returns NULL with *errormsg set if
+ * it can't be decoded; the records from it on are dropped from the batch,
+ * and the reader stays where it was.
+ */
+XLogRecord *
+XLogRecordBatchDecode(XLogReaderState *state, XLogRecordBatch *batch, int i,
+					  char **errormsg)
+{
+	XLogRecord *record = batch->records[i];
+
+	Assert(i >= 0 && i < batch->nrecords);
+
+	*errormsg = NULL;
+	state->errormsg_buf[0] = '\0';
+	ResetDecoder(state);
+
+	if (!DecodeXLogRecord(state, record, errormsg))
+	{
+		batch->nrecords = i;
+		return NULL;
+	}
+	state->ReadRecPtr = batch->startptrs[i];
+	state->EndRecPtr = batch->endptrs[i];
+	return record;
+}
+
+/* Get a batch of up to max_records records, see XLogReadRecordBatch() */
+XLogRecordBatch *
+XLogRecordBatchAllocate(int max_records)
+{
+	XLogRecordBatch *batch;
+
+	Assert(max_records > 0);
+
+	batch = (XLogRecordBatch *) palloc0(sizeof(XLogRecordBatch));
+	batch->max_records = max_records;
+	batch->records = (XLogRecord **) palloc(sizeof(XLogRecord *) * max_records);
+	batch->startptrs = (XLogRecPtr *) palloc(sizeof(XLogRecPtr) * max_records);
+	batch->endptrs = (XLogRecPtr *) palloc(sizeof(XLogRecPtr) * max_records);
+	batch->arena_size = XLOG_BATCH_ARENA_SIZE;
+	batch->arena = (char *) palloc(batch->arena_size);
+	return batch;
+}
+
+void
+XLogRecordBatchFree(XLogRecordBatch *batch)
+{
+	pfree(batch->records);
+	pfree(batch->startptrs);
+	pfree(batch->endptrs);
+	pfree(batch->arena);
+	pfree(batch);
+}
+
+/*
+ * XLogReadRecord() and XLogReadRecordBatch(), decode telling whether to
+ * decode the record read.
+ */
+static XLogRecord *
+XLogReadRecordInternal(XLogReaderState *state, bool decode, char **errormsg)
 {
 	XLogRecPtr	RecPtr;
 	XLogRecord *record;
@@ -657,6 +867,8 @@ XLogReadRecord(XLogReaderState *state, char **errormsg)
     printf("%s %d \n", __func__ , __LINE__);
     fflush(stdout);
 #endif
+	if (!decode)
+		return record;
 	if (DecodeXLogRecord(state, record, errormsg))
 		return record;
 	else
@@ -722,6 +934,8 @@ ReadPageInternal(XLogReaderState *state, XLogRecPtr pageptr, int reqLen)
 	{
 		XLogRecPtr	targetSegmentPtr = pageptr - targetPageOff;
 
+		if (!XLogReaderSelectPage(state, targetSegmentPtr))
+			goto err;
         // targetSegmentPtr is the start position of the SEGMENT
 		readLen = state->routine.page_read(state, targetSegmentPtr, XLOG_BLCKSZ,
 										   state->currRecPtr,
@@ -741,6 +955,8 @@ ReadPageInternal(XLogReaderState *state, XLogRecPtr pageptr, int reqLen)
 	 * First, read the requested data length, but at least a short page header
 	 * so that we can validate it.
 	 */
+	if (!XLogReaderSelectPage(state, pageptr))
+		goto err;
 	readLen = state->routine.page_read(state, pageptr, Max(reqLen, SizeOfXLogShortPHD),
 									   state->currRecPtr,
 									   state->readBuf);
@@ -785,6 +1001,35 @@ err:
 	return -1;
 }
 
+/*
+ * Point readBuf at the page of the ring pageptr is read into.  Fails, and
+ * sets readaheadFull, if that page holds records of the current batch.
+ */
+static bool
+XLogReaderSelectPage(XLogReaderState *state, XLogRecPtr pageptr)
+{
+	XLogRecPtr *held = &state->readBufPagePtr;
+	int			slot = 0;
+
+	if (state->readaheadBuf != NULL)
+	{
+		slot = (int) ((pageptr / XLOG_BLCKSZ) % state->readaheadPages);
+		held = &state->readaheadPagePtrs[slot];
+	}
+
+	if (*held != pageptr && !XLogRecPtrIsInvalid(state->readaheadPinned) &&
+		*held >= state->readaheadPinned)
+	{
+		state->readaheadFull = true;
+		return false;
+	}
+
+	*held = pageptr;
+	if (state->readaheadBuf != NULL)
+		state->readBuf = state->readaheadBuf + (Size) slot * XLOG_BLCKSZ;
+	return true;
+}
+
 /*
  * Invalidate the xlogreader's read state to force a re-read.
  */
@@ -1235,7 +1480,7 @@ WALRead(XLogReaderState *state,
 		/* Reset errno first; eases reporting non-errno-affecting errors */
 		errno = 0;
 #ifdef RPC_REMOTE_DISK
-		readbytes = pg_pread_rpc_local2(state->seg.ws_file, p, segbytes, (off_t) startoff);
+		readbytes = pg_pread_segment_rpc_local(&state->seg, p, segbytes, (off_t) startoff);
 #else
         readbytes = pg_pread(state->seg.ws_file, p, segbytes, (off_t) startoff);
 #endif
@@ -1699,9 +1944,20 @@ RestoreBlockImage(XLogReaderState *record, uint8 block_id, char *page)
 
 	if (bkpb->bimg_info & BKPIMAGE_IS_COMPRESSED)
 	{
+		bool		decomp_success;
+
 		/* If a backup block image is compressed, decompress it */
-		if (pglz_decompress(ptr, bkpb->bimg_len, tmp.data,
-							BLCKSZ - bkpb->hole_length, true) < 0)
+		if (bkpb->bimg_info & BKPIMAGE_COMPRESS_LZ4)
+			decomp_success = LZ4_decompress_safe(ptr, tmp.data,
+												 bkpb->bimg_len,
+												 BLCKSZ - bkpb->hole_length) ==
+				BLCKSZ - bkpb->hole_length;
+		else
+			decomp_success = pglz_decompress(ptr, bkpb->bimg_len, tmp.data,
+											 BLCKSZ - bkpb->hole_length,
+											 true) >= 0;
+
+		if (!decomp_success)
 		{
 			report_invalid_record(record, "invalid compressed image at %X/%X, block %d",
 								  (uint32) (record->ReadRecPtr >> 32),
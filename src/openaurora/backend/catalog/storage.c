@@ -19,6 +19,7 @@
 
 #include "postgres.h"
 
+#include "access/logindex_tombstone.h"
 #include "access/parallel.h"
 #include "access/visibilitymap.h"
 #include "access/xact.h"
@@ -28,12 +29,15 @@
 #include "catalog/storage.h"
 #include "catalog/storage_xlog.h"
 #include "miscadmin.h"
+#include "storage/db_clone.h"
 #include "storage/freespace.h"
 #include "storage/smgr.h"
 #include "utils/hsearch.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
 
+extern int IsRpcClient;
+
 /* GUC variables */
 int			wal_skip_threshold = 2048;	/* in kilobytes */
 
@@ -916,6 +920,13 @@ smgr_redo(XLogReaderState *record)
 
 		reln = smgropen(xlrec->rnode, InvalidBackendId);
 		smgrcreate(reln, xlrec->forkNum, true);
+
+		/* A new relfilenode in a clone is the clone's own */
+		if (!IsRpcClient)
+			DbCloneForget(xlrec->rnode, xlrec->forkNum);
+		/* Nor may it keep versions of a dropped one of the same name */
+		if (!IsRpcClient)
+			LogindexTombstoneCreate(xlrec->rnode);
 	}
 	else if (info == XLOG_SMGR_TRUNCATE)
 	{
@@ -963,8 +974,20 @@ smgr_redo(XLogReaderState *record)
 
 			/* Also tell xlogutils.c about it */
 			XLogTruncateRelation(xlrec->rnode, MAIN_FORKNUM, xlrec->blkno);
+
+			if (!IsRpcClient)
+				DbCloneTruncate(xlrec->rnode, MAIN_FORKNUM, xlrec->blkno);
 		}
 
+		/*
+		 * The map blocks a clone reads from its parent may cover the blocks
+		 * truncated away, which could come back. Empty maps are always safe.
+		 */
+		if (!IsRpcClient && (xlrec->flags & SMGR_TRUNCATE_FSM) != 0)
+			DbCloneForget(xlrec->rnode, FSM_FORKNUM);
+		if (!IsRpcClient && (xlrec->flags & SMGR_TRUNCATE_VM) != 0)
+			DbCloneForget(xlrec->rnode, VISIBILITYMAP_FORKNUM);
+
 		/* Prepare for truncation of FSM and VM too */
 		rel = CreateFakeRelcacheEntry(xlrec->rnode);
 
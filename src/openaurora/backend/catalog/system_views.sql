@@ -823,6 +823,29 @@ CREATE VIEW pg_stat_wal_receiver AS
     FROM pg_stat_get_wal_receiver() s
     WHERE s.pid IS NOT NULL;
 
+CREATE VIEW pg_stat_smart_replay AS
+    SELECT
+            s.metric,
+            s.labels,
+            s.value
+    FROM pg_stat_get_smart_replay() s;
+
+CREATE VIEW pg_stat_mempool AS
+    SELECT
+            s.hits,
+            s.stale_hits,
+            s.misses,
+            s.read_failures,
+            s.flush_failures,
+            s.reconnects,
+            s.flushed_pages,
+            s.flushed_pages * current_setting('block_size')::int8 AS flushed_bytes,
+            s.queued_flushes,
+            s.read_time,
+            s.read_latency_histogram,
+            s.stats_reset
+    FROM pg_stat_get_mempool() s;
+
 CREATE VIEW pg_stat_subscription AS
     SELECT
             su.oid AS subid,
@@ -18,13 +18,16 @@
 #include <unistd.h>
 #include <sys/stat.h>
 
+#include "access/genam.h"
 #include "access/heapam.h"
 #include "access/htup_details.h"
+#include "access/parallel.h"
 #include "access/sysattr.h"
 #include "access/tableam.h"
 #include "access/xact.h"
 #include "access/xlog.h"
 #include "catalog/dependency.h"
+#include "catalog/pg_am.h"
 #include "catalog/pg_authid.h"
 #include "catalog/pg_type.h"
 #include "commands/copy.h"
@@ -39,15 +42,20 @@
 #include "libpq/pqformat.h"
 #include "mb/pg_wchar.h"
 #include "miscadmin.h"
+#include "pgstat.h"
 #include "nodes/makefuncs.h"
+#include "optimizer/clauses.h"
 #include "optimizer/optimizer.h"
 #include "parser/parse_coerce.h"
 #include "parser/parse_collate.h"
 #include "parser/parse_expr.h"
 #include "parser/parse_relation.h"
 #include "port/pg_bswap.h"
+#include "postmaster/bgworker_internals.h"
 #include "rewrite/rewriteHandler.h"
+#include "storage/condition_variable.h"
 #include "storage/fd.h"
+#include "storage/spin.h"
 #include "tcop/tcopprot.h"
 #include "utils/acl.h"
 #include "utils/builtins.h"
@@ -137,6 +145,7 @@ typedef struct CopyStateData
 	bool		freeze;			/* freeze rows on loading? */
 	bool		csv_mode;		/* Comma Separated Value format? */
 	bool		header_line;	/* CSV header line? */
+	int			parallel_workers;	/* workers for COPY FROM, 0 if serial */
 	char	   *null_print;		/* NULL marker string (server encoding!) */
 	int			null_print_len; /* length of same */
 	char	   *null_print_client;	/* same converted to file encoding */
@@ -360,6 +369,9 @@ static CopyState BeginCopyTo(ParseState *pstate, Relation rel, RawStmt *query,
 							 Oid queryRelId, const char *filename, bool is_program,
 							 List *attnamelist, List *options);
 static void EndCopyTo(CopyState cstate);
+static bool IsParallelCopyAllowed(CopyState cstate);
+static uint64 ParallelCopyFrom(CopyState cstate, List *attnamelist,
+							   List *options);
 static uint64 DoCopyTo(CopyState cstate);
 static uint64 CopyTo(CopyState cstate);
 static void CopyOneRowTo(CopyState cstate, TupleTableSlot *slot);
@@ -1069,7 +1081,10 @@ DoCopy(ParseState *pstate, const CopyStmt *stmt,
 		cstate = BeginCopyFrom(pstate, rel, stmt->filename, stmt->is_program,
 							   NULL, stmt->attlist, stmt->options);
 		cstate->whereClause = whereClause;
-		*processed = CopyFrom(cstate);	/* copy from file to database */
+		if (IsParallelCopyAllowed(cstate))
+			*processed = ParallelCopyFrom(cstate, stmt->attlist, stmt->options);
+		else
+			*processed = CopyFrom(cstate);	/* copy from file to database */
 		EndCopyFrom(cstate);
 	}
 	else
@@ -1109,6 +1124,7 @@ ProcessCopyOptions(ParseState *pstate,
 				   List *options)
 {
 	bool		format_specified = false;
+	bool		parallel_specified = false;
 	ListCell   *option;
 
 	/* Support external use for option sanity checking */
@@ -1155,6 +1171,23 @@ ProcessCopyOptions(ParseState *pstate,
 						 parser_errposition(pstate, defel->location)));
 			cstate->freeze = defGetBoolean(defel);
 		}
+		else if (strcmp(defel->defname, "parallel") == 0)
+		{
+			if (parallel_specified)
+				ereport(ERROR,
+						(errcode(ERRCODE_SYNTAX_ERROR),
+						 errmsg("conflicting or redundant options"),
+						 parser_errposition(pstate, defel->location)));
+			parallel_specified = true;
+			cstate->parallel_workers = defGetInt32(defel);
+			if (cstate->parallel_workers < 0 ||
+				cstate->parallel_workers > MAX_PARALLEL_WORKER_LIMIT)
+				ereport(ERROR,
+						(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+						 errmsg("argument to option \"%s\" must be between 0 and %d",
+								defel->defname, MAX_PARALLEL_WORKER_LIMIT),
+						 parser_errposition(pstate, defel->location)));
+		}
 		else if (strcmp(defel->defname, "delimiter") == 0)
 		{
 			if (cstate->delim)
@@ -1424,6 +1457,12 @@ ProcessCopyOptions(ParseState *pstate,
 				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
 				 errmsg("COPY force null only available using COPY FROM")));
 
+	/* Check parallel */
+	if (cstate->parallel_workers > 0 && !is_from)
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("COPY PARALLEL only available using COPY FROM")));
+
 	/* Don't allow the delimiter to appear in the null string. */
 	if (strchr(cstate->null_print, cstate->delim[0]) != NULL)
 		ereport(ERROR,
@@ -2771,6 +2810,10 @@ CopyFrom(CopyState cstate)
 		ti_options |= TABLE_INSERT_FROZEN;
 	}
 
+	/* The workers of a parallel COPY; see IsParallelCopyAllowed() */
+	if (IsParallelWorker())
+		ti_options |= TABLE_INSERT_PARALLEL;
+
 	/*
 	 * We need a ResultRelInfo so we can use the regular executor's
 	 * index-entry-making machinery.  (There used to be a huge amount of code
@@ -3827,6 +3870,563 @@ EndCopyFrom(CopyState cstate)
 	EndCopy(cstate);
 }
 
+/*
+ * Parallel COPY FROM
+ *
+ * With the PARALLEL option the leader only reads the input.  It cuts it at
+ * line ends into chunks of up to PARALLEL_COPY_SLOT_SIZE bytes, and puts
+ * them in a ring of slots in dynamic shared memory.  Each worker runs an
+ * ordinary CopyFrom(), whose data source callback takes the next filled
+ * slot, so every worker parses a stream of whole lines and inserts them with
+ * its own multi-insert buffers.  A line too long for one slot spans several,
+ * marked "more", which the worker taking the first one also takes before
+ * anyone else takes a slot.  The header line, if any, is skipped by whoever
+ * gets the first slot.
+ *
+ * The leader finds the line ends with the same rules as CopyReadLineText(),
+ * scanning byte by byte, so it can't do that for client encodings in which
+ * ASCII bytes can be part of a multibyte character; and it can't for the
+ * binary format at all.  It also stops at the end-of-copy marker, so that
+ * the workers never see one.
+ *
+ * The workers insert under the leader's transaction and command ID, so
+ * anything that would need a new command ID (triggers, foreign keys) or
+ * run parallel-unsafe functions (defaults, CHECK constraints, index
+ * expressions, the WHERE clause, domain constraints) rules the parallel mode
+ * out, and so do tables that are not plain heap tables.  Relation extension
+ * is in bulk, see HEAP_INSERT_PARALLEL.  Error messages give the line
+ * numbers within the failing worker's share of the input.
+ */
+#define PARALLEL_COPY_KEY_SHARED	UINT64CONST(0xC000000000000001)
+#define PARALLEL_COPY_KEY_DATA		UINT64CONST(0xC000000000000002)
+#define PARALLEL_COPY_KEY_ARGS		UINT64CONST(0xC000000000000003)
+
+#define PARALLEL_COPY_SLOT_SIZE		(256 * 1024)
+#define PARALLEL_COPY_SLOTS_PER_WORKER	4
+
+typedef enum ParallelCopySlotState
+{
+	PCOPY_SLOT_FREE,
+	PCOPY_SLOT_FILLED,			/* waiting for a worker */
+	PCOPY_SLOT_TAKEN			/* a worker is parsing it */
+} ParallelCopySlotState;
+
+typedef struct ParallelCopySlot
+{
+	ParallelCopySlotState state;
+	int			len;
+	bool		more;			/* ends inside a line, continued by the next */
+	bool		first;			/* starts the input */
+} ParallelCopySlot;
+
+typedef struct ParallelCopyShared
+{
+	Oid			relid;
+	int			nslots;
+
+	slock_t		mutex;			/* protects everything below */
+	int			head;			/* next slot for a worker to take */
+	bool		continuing;		/* head continues a taken slot */
+	bool		finished;		/* the leader has filled its last slot */
+	uint64		processed;		/* rows the workers have inserted */
+	ConditionVariable filled_cv;	/* a slot was filled, or finished */
+	ConditionVariable free_cv;	/* a slot was freed */
+	ParallelCopySlot slots[FLEXIBLE_ARRAY_MEMBER];
+} ParallelCopyShared;
+
+/* Leader's state */
+typedef struct ParallelCopyLeader
+{
+	ParallelCopyShared *shared;
+	char	   *data;
+	int			fill;			/* next slot to fill */
+	bool		filled_any;
+} ParallelCopyLeader;
+
+/* Worker's state, for ParallelCopyGetData */
+static ParallelCopyShared *pcopy_shared = NULL;
+static char *pcopy_data = NULL;
+static int	pcopy_slot = -1;	/* slot being read, or -1 */
+static int	pcopy_offset = 0;
+
+/*
+ * Can this COPY FROM run in parallel?
+ */
+static bool
+IsParallelCopyAllowed(CopyState cstate)
+{
+	Relation	rel = cstate->rel;
+	TupleDesc	tupDesc = RelationGetDescr(rel);
+	List	   *indexoids;
+	ListCell   *lc;
+	bool		safe = true;
+
+	if (cstate->parallel_workers <= 0 || IsInParallelMode())
+		return false;
+
+	/* The leader has to find the line ends */
+	if (cstate->binary || cstate->encoding_embeds_ascii ||
+		(cstate->copy_dest != COPY_FILE && cstate->copy_dest != COPY_NEW_FE))
+		return false;
+
+	if (rel->rd_rel->relkind != RELKIND_RELATION ||
+		rel->rd_rel->relam != HEAP_TABLE_AM_OID ||
+		RelationUsesLocalBuffers(rel) ||
+		rel->trigdesc != NULL || cstate->freeze)
+		return false;
+
+	if (cstate->whereClause && !is_parallel_safe_expr(cstate->whereClause))
+		return false;
+
+	for (int attnum = 1; attnum <= tupDesc->natts; attnum++)
+	{
+		Form_pg_attribute att = TupleDescAttr(tupDesc, attnum - 1);
+
+		if (att->attisdropped)
+			continue;
+		if (list_member_int(cstate->attnumlist, attnum))
+		{
+			if (get_typtype(att->atttypid) == TYPTYPE_DOMAIN)
+				return false;
+		}
+		else if (att->atthasdef)
+		{
+			Node	   *defexpr = build_column_default(rel, attnum);
+
+			if (defexpr != NULL && !is_parallel_safe_expr(defexpr))
+				return false;
+		}
+	}
+
+	if (tupDesc->constr)
+	{
+		for (int i = 0; i < tupDesc->constr->num_check; i++)
+		{
+			Node	   *check = stringToNode(tupDesc->constr->check[i].ccbin);
+
+			if (!is_parallel_safe_expr(check))
+				return false;
+		}
+	}
+
+	indexoids = RelationGetIndexList(rel);
+	foreach(lc, indexoids)
+	{
+		Relation	index = index_open(lfirst_oid(lc), AccessShareLock);
+
+		safe = is_parallel_safe_expr((Node *) RelationGetIndexExpressions(index)) &&
+			is_parallel_safe_expr((Node *) RelationGetIndexPredicate(index));
+		index_close(index, AccessShareLock);
+		if (!safe)
+			break;
+	}
+	list_free(indexoids);
+
+	return safe;
+}
+
+/*
+ * Leader: put len bytes of input in the next slot, waiting for it to be free
+ */
+static void
+ParallelCopyFillSlot(ParallelCopyLeader *leader, const char *buf, int len,
+					 bool more)
+{
+	ParallelCopyShared *shared = leader->shared;
+	ParallelCopySlot *slot = &shared->slots[leader->fill];
+
+	for (;;)
+	{
+		bool		isfree;
+
+		SpinLockAcquire(&shared->mutex);
+		isfree = (slot->state == PCOPY_SLOT_FREE);
+		SpinLockRelease(&shared->mutex);
+		if (isfree)
+			break;
+		ConditionVariableSleep(&shared->free_cv, WAIT_EVENT_PARALLEL_COPY_FILL);
+	}
+	ConditionVariableCancelSleep();
+
+	memcpy(leader->data + (Size) leader->fill * PARALLEL_COPY_SLOT_SIZE,
+		   buf, len);
+
+	SpinLockAcquire(&shared->mutex);
+	slot->len = len;
+	slot->more = more;
+	slot->first = !leader->filled_any;
+	slot->state = PCOPY_SLOT_FILLED;
+	SpinLockRelease(&shared->mutex);
+	ConditionVariableBroadcast(&shared->filled_cv);
+
+	leader->filled_any = true;
+	leader->fill = (leader->fill + 1) % shared->nslots;
+}
+
+/*
+ * Leader: read all of the input and hand it to the workers in line-aligned
+ * chunks
+ */
+static void
+ParallelCopyDistribute(CopyState cstate, ParallelCopyLeader *leader)
+{
+	StringInfoData buf;
+	int			scan = 0;		/* next byte to look at */
+	int			eol = 0;		/* end of the last complete line */
+	bool		line_start = true;
+	bool		in_quote = false;
+	bool		last_was_esc = false;
+	bool		eof = false;
+	bool		stop = false;
+	char		quotec = '\0';
+	char		escapec = '\0';
+
+	if (cstate->csv_mode)
+	{
+		quotec = cstate->quote[0];
+		escapec = cstate->escape[0];
+		/* ignore special escape processing if it's the same as quotec */
+		if (quotec == escapec)
+			escapec = '\0';
+	}
+
+	initStringInfo(&buf);
+	enlargeStringInfo(&buf, PARALLEL_COPY_SLOT_SIZE);
+
+	while (!eof && !stop)
+	{
+		int			nread;
+
+		CHECK_FOR_INTERRUPTS();
+
+		nread = CopyGetData(cstate, buf.data + buf.len, 1,
+							Min(RAW_BUF_SIZE, PARALLEL_COPY_SLOT_SIZE - buf.len));
+		if (nread <= 0)
+			eof = true;
+		else
+			buf.len += nread;
+		buf.data[buf.len] = '\0';
+
+		/*
+		 * Find the line ends, as CopyReadLineText() would.  We look two bytes
+		 * ahead for the end-of-copy marker, so we may stop short of the end
+		 * of the data read so far.
+		 */
+		while (scan < buf.len)
+		{
+			char		c = buf.data[scan];
+
+			if (c == '\\' && (!cstate->csv_mode || line_start))
+			{
+				if (scan + 2 >= buf.len && !eof)
+					break;
+				if (buf.data[scan + 1] == '.' &&
+					(scan + 2 >= buf.len ||
+					 buf.data[scan + 2] == '\n' || buf.data[scan + 2] == '\r'))
+				{
+					/* End-of-copy marker, whatever precedes it is the last row */
+					buf.len = scan;
+					stop = true;
+					break;
+				}
+				if (!cstate->csv_mode)
+				{
+					/* Anything after a backslash is data, even a newline */
+					scan = Min(scan + 2, buf.len);
+					line_start = false;
+					continue;
+				}
+			}
+
+			if (cstate->csv_mode)
+			{
+				if (in_quote && c == escapec)
+					last_was_esc = !last_was_esc;
+				if (c == quotec && !last_was_esc)
+					in_quote = !in_quote;
+				if (c != escapec)
+					last_was_esc = false;
+			}
+			scan++;
+
+			/* Chunks end after a \n only, so that \r\n stays together */
+			line_start = (c == '\n' || c == '\r') && !in_quote;
+			if (c == '\n' && !in_quote)
+				eol = scan;
+		}
+
+		if (eof || stop)
+			break;
+		if (buf.len < PARALLEL_COPY_SLOT_SIZE)
+			continue;
+
+		/* A slot's worth: everything up to the last line end, if any */
+		if (eol == 0)
+		{
+			ParallelCopyFillSlot(leader, buf.data, scan, true);
+			eol = scan;
+		}
+		else
+			ParallelCopyFillSlot(leader, buf.data, eol, false);
+		memmove(buf.data, buf.data + eol, buf.len - eol);
+		buf.len -= eol;
+		scan -= eol;
+		eol = 0;
+	}
+
+	if (buf.len > 0)
+		ParallelCopyFillSlot(leader, buf.data, buf.len, false);
+
+	/* In protocol version 3, ignore anything after \. up to the end of data */
+	if (stop && cstate->copy_dest == COPY_NEW_FE)
+	{
+		while (CopyGetData(cstate, buf.data, 1, RAW_BUF_SIZE) > 0)
+			;
+	}
+	pfree(buf.data);
+
+	SpinLockAcquire(&leader->shared->mutex);
+	leader->shared->finished = true;
+	SpinLockRelease(&leader->shared->mutex);
+	ConditionVariableBroadcast(&leader->shared->filled_cv);
+}
+
+/*
+ * Copy the input into the table with the help of parallel workers.  Falls
+ * back to CopyFrom() if none can be had.
+ */
+static uint64
+ParallelCopyFrom(CopyState cstate, List *attnamelist, List *options)
+{
+	ParallelContext *pcxt;
+	ParallelCopyShared *shared;
+	ParallelCopyLeader leader;
+	char	   *args;
+	char	   *sharedargs;
+	int			nslots;
+	Size		sharedsize;
+	uint64		processed;
+
+	/*
+	 * The workers use our XID and command ID; make sure both are assigned
+	 * and marked used before the parallel operation starts.
+	 */
+	(void) GetCurrentTransactionId();
+	(void) GetCurrentCommandId(true);
+
+	EnterParallelMode();
+	pcxt = CreateParallelContext("postgres", "ParallelCopyMain",
+								 cstate->parallel_workers);
+
+	nslots = PARALLEL_COPY_SLOTS_PER_WORKER * cstate->parallel_workers;
+	sharedsize = add_size(offsetof(ParallelCopyShared, slots),
+						  mul_size(nslots, sizeof(ParallelCopySlot)));
+	args = nodeToString(list_make3(attnamelist, options, cstate->whereClause));
+	shm_toc_estimate_chunk(&pcxt->estimator, sharedsize);
+	shm_toc_estimate_chunk(&pcxt->estimator,
+						   mul_size(nslots, PARALLEL_COPY_SLOT_SIZE));
+	shm_toc_estimate_chunk(&pcxt->estimator, strlen(args) + 1);
+	shm_toc_estimate_keys(&pcxt->estimator, 3);
+
+	InitializeParallelDSM(pcxt);
+
+	/* If no DSM segment was available, copy serially */
+	if (pcxt->seg == NULL)
+	{
+		DestroyParallelContext(pcxt);
+		ExitParallelMode();
+		return CopyFrom(cstate);
+	}
+
+	shared = (ParallelCopyShared *) shm_toc_allocate(pcxt->toc, sharedsize);
+	shared->relid = RelationGetRelid(cstate->rel);
+	shared->nslots = nslots;
+	SpinLockInit(&shared->mutex);
+	shared->head = 0;
+	shared->continuing = false;
+	shared->finished = false;
+	shared->processed = 0;
+	ConditionVariableInit(&shared->filled_cv);
+	ConditionVariableInit(&shared->free_cv);
+	for (int i = 0; i < nslots; i++)
+		shared->slots[i].state = PCOPY_SLOT_FREE;
+	shm_toc_insert(pcxt->toc, PARALLEL_COPY_KEY_SHARED, shared);
+
+	leader.shared = shared;
+	leader.data = shm_toc_allocate(pcxt->toc,
+								   mul_size(nslots, PARALLEL_COPY_SLOT_SIZE));
+	leader.fill = 0;
+	leader.filled_any = false;
+	shm_toc_insert(pcxt->toc, PARALLEL_COPY_KEY_DATA, leader.data);
+
+	sharedargs = shm_toc_allocate(pcxt->toc, strlen(args) + 1);
+	strcpy(sharedargs, args);
+	shm_toc_insert(pcxt->toc, PARALLEL_COPY_KEY_ARGS, sharedargs);
+
+	LaunchParallelWorkers(pcxt);
+	if (pcxt->nworkers_launched == 0)
+	{
+		DestroyParallelContext(pcxt);
+		ExitParallelMode();
+		return CopyFrom(cstate);
+	}
+	WaitForParallelWorkersToAttach(pcxt);
+
+	ParallelCopyDistribute(cstate, &leader);
+
+	WaitForParallelWorkersToFinish(pcxt);
+	processed = shared->processed;
+
+	DestroyParallelContext(pcxt);
+	ExitParallelMode();
+
+	return processed;
+}
+
+/*
+ * Worker: take the slot at the head of the ring, or the continuation of the
+ * slot just read.  Returns -1 when the input is exhausted.
+ */
+static int
+ParallelCopyTakeSlot(bool continuation)
+{
+	ParallelCopyShared *shared = pcopy_shared;
+	bool		wake = false;
+	int			taken;
+
+	for (;;)
+	{
+		ParallelCopySlot *slot;
+
+		SpinLockAcquire(&shared->mutex);
+		slot = &shared->slots[shared->head];
+		if (slot->state == PCOPY_SLOT_FILLED &&
+			(continuation || !shared->continuing))
+		{
+			taken = shared->head;
+			slot->state = PCOPY_SLOT_TAKEN;
+			shared->head = (shared->head + 1) % shared->nslots;
+			/* the others may go on once a long line's last slot is taken */
+			wake = shared->continuing && !slot->more;
+			shared->continuing = slot->more;
+			SpinLockRelease(&shared->mutex);
+			break;
+		}
+		if (shared->finished && slot->state != PCOPY_SLOT_FILLED)
+		{
+			SpinLockRelease(&shared->mutex);
+			taken = -1;
+			break;
+		}
+		SpinLockRelease(&shared->mutex);
+		ConditionVariableSleep(&shared->filled_cv, WAIT_EVENT_PARALLEL_COPY_TAKE);
+	}
+	ConditionVariableCancelSleep();
+
+	if (wake)
+		ConditionVariableBroadcast(&shared->filled_cv);
+	return taken;
+}
+
+static void
+ParallelCopyReleaseSlot(int slotno)
+{
+	SpinLockAcquire(&pcopy_shared->mutex);
+	pcopy_shared->slots[slotno].state = PCOPY_SLOT_FREE;
+	SpinLockRelease(&pcopy_shared->mutex);
+	ConditionVariableBroadcast(&pcopy_shared->free_cv);
+}
+
+/*
+ * Worker: data source callback of its CopyState
+ */
+static int
+ParallelCopyGetData(void *outbuf, int minread, int maxread)
+{
+	int			bytesread = 0;
+
+	while (bytesread < maxread)
+	{
+		ParallelCopySlot *slot;
+		int			n;
+
+		if (pcopy_slot < 0)
+		{
+			if (bytesread >= minread)
+				break;
+			pcopy_slot = ParallelCopyTakeSlot(false);
+			pcopy_offset = 0;
+			if (pcopy_slot < 0)
+				break;
+		}
+
+		slot = &pcopy_shared->slots[pcopy_slot];
+		n = Min(slot->len - pcopy_offset, maxread - bytesread);
+		memcpy((char *) outbuf + bytesread,
+			   pcopy_data + (Size) pcopy_slot * PARALLEL_COPY_SLOT_SIZE + pcopy_offset,
+			   n);
+		bytesread += n;
+		pcopy_offset += n;
+
+		if (pcopy_offset == slot->len)
+		{
+			bool		more = slot->more;
+
+			ParallelCopyReleaseSlot(pcopy_slot);
+			pcopy_slot = more ? ParallelCopyTakeSlot(true) : -1;
+			pcopy_offset = 0;
+		}
+	}
+
+	return bytesread;
+}
+
+/*
+ * Entry point of a parallel COPY FROM worker
+ */
+void
+ParallelCopyMain(dsm_segment *seg, shm_toc *toc)
+{
+	ParseState *pstate;
+	Relation	rel;
+	List	   *args;
+	CopyState	cstate;
+	uint64		processed;
+
+	pcopy_shared = (ParallelCopyShared *)
+		shm_toc_lookup(toc, PARALLEL_COPY_KEY_SHARED, false);
+	pcopy_data = shm_toc_lookup(toc, PARALLEL_COPY_KEY_DATA, false);
+	args = (List *) stringToNode(shm_toc_lookup(toc, PARALLEL_COPY_KEY_ARGS,
+												false));
+
+	rel = table_open(pcopy_shared->relid, RowExclusiveLock);
+
+	/* CopyFrom() wants the range table the leader had */
+	pstate = make_parsestate(NULL);
+	(void) addRangeTableEntryForRelation(pstate, rel, RowExclusiveLock,
+										 NULL, false, false);
+
+	cstate = BeginCopyFrom(pstate, rel, NULL, false, ParallelCopyGetData,
+						   (List *) linitial(args), (List *) lsecond(args));
+	cstate->whereClause = (Node *) lthird(args);
+
+	/* Only the worker that gets the start of the input has the header */
+	pcopy_slot = ParallelCopyTakeSlot(false);
+	pcopy_offset = 0;
+	if (pcopy_slot < 0 || !pcopy_shared->slots[pcopy_slot].first)
+		cstate->header_line = false;
+
+	processed = CopyFrom(cstate);
+	EndCopyFrom(cstate);
+
+	SpinLockAcquire(&pcopy_shared->mutex);
+	pcopy_shared->processed += processed;
+	SpinLockRelease(&pcopy_shared->mutex);
+
+	table_close(rel, RowExclusiveLock);
+	free_parsestate(pstate);
+}
+
 /*
  * Read the next input line and stash it in line_buf, with conversion to
  * server encoding.
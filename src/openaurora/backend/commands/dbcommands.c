@@ -52,6 +52,8 @@
 #include "postmaster/bgwriter.h"
 #include "replication/slot.h"
 #include "storage/copydir.h"
+#include "storage/db_clone.h"
+#include "storage/kv_interface.h"
 #include "storage/fd.h"
 #include "storage/ipc.h"
 #include "storage/lmgr.h"
@@ -65,6 +67,8 @@
 #include "utils/snapmgr.h"
 #include "utils/syscache.h"
 
+extern int IsRpcClient;
+
 typedef struct
 {
 	Oid			src_dboid;		/* source (template) DB */
@@ -2213,14 +2217,24 @@ dbase_redo(XLogReaderState *record)
 		/*
 		 * Copy this subdirectory to the new location
 		 *
-		 * We don't need to copy subdirectories
+		 * We don't need to copy subdirectories. The storage node may make
+		 * it a clone that reads the source's pages instead.
 		 */
-		copydir(src_path, dst_path, false);
+		if (!IsRpcClient && DbCloneEnabled())
+			DbCloneCreate(xlrec->src_tablespace_id, xlrec->src_db_id,
+						  xlrec->tablespace_id, xlrec->db_id, record->EndRecPtr);
+		else
+			copydir(src_path, dst_path, false);
+
+		/* The storage node drops what it kept of an older database of the OID */
+		if (!IsRpcClient)
+			KvCreateDatabase(xlrec->db_id);
 	}
 	else if (info == XLOG_DBASE_DROP)
 	{
 		xl_dbase_drop_rec *xlrec = (xl_dbase_drop_rec *) XLogRecGetData(record);
 		char	   *dst_path;
+		bool		cloned = false;
 		int			i;
 
 		if (InHotStandby)
@@ -2253,6 +2267,13 @@ dbase_redo(XLogReaderState *record)
 
 		for (i = 0; i < xlrec->ntablespaces; i++)
 		{
+			/* A clone still reads the pages of this one */
+			if (!IsRpcClient && !DbCloneDrop(xlrec->tablespace_ids[i], xlrec->db_id))
+			{
+				cloned = true;
+				continue;
+			}
+
 			dst_path = GetDatabasePath(xlrec->db_id, xlrec->tablespace_ids[i]);
 
 			/* And remove the physical files */
@@ -2263,6 +2284,13 @@ dbase_redo(XLogReaderState *record)
 			pfree(dst_path);
 		}
 
+		/*
+		 * The storage node removes the database's own page store, once no
+		 * compute node reads below the drop.
+		 */
+		if (!IsRpcClient && !cloned)
+			KvDropDatabase(xlrec->db_id, record->EndRecPtr);
+
 		if (InHotStandby)
 		{
 			/*
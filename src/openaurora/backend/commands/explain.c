@@ -39,6 +39,8 @@
 #include "utils/typcache.h"
 #include "utils/xml.h"
 
+extern int IsRpcClient;
+
 
 /* Hook for plugins to get control in ExplainOneQuery() */
 ExplainOneQuery_hook_type ExplainOneQuery_hook = NULL;
@@ -119,6 +121,7 @@ static const char *explain_get_index_name(Oid indexId);
 static void show_buffer_usage(ExplainState *es, const BufferUsage *usage,
 							  bool planning);
 static void show_wal_usage(ExplainState *es, const WalUsage *usage);
+static void show_storage_usage(ExplainState *es, const StorageUsage *usage);
 static void ExplainIndexScanDetails(Oid indexid, ScanDirection indexorderdir,
 									ExplainState *es);
 static void ExplainScanTarget(Scan *plan, ExplainState *es);
@@ -183,6 +186,8 @@ ExplainQuery(ParseState *pstate, ExplainStmt *stmt,
 			es->buffers = defGetBoolean(opt);
 		else if (strcmp(opt->defname, "wal") == 0)
 			es->wal = defGetBoolean(opt);
+		else if (strcmp(opt->defname, "storage") == 0)
+			es->storage = defGetBoolean(opt);
 		else if (strcmp(opt->defname, "settings") == 0)
 			es->settings = defGetBoolean(opt);
 		else if (strcmp(opt->defname, "timing") == 0)
@@ -227,6 +232,11 @@ ExplainQuery(ParseState *pstate, ExplainStmt *stmt,
 				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
 				 errmsg("EXPLAIN option WAL requires ANALYZE")));
 
+	if (es->storage && !es->analyze)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("EXPLAIN option STORAGE requires ANALYZE")));
+
 	/* if the timing was not set explicitly, set default value */
 	es->timing = (timing_set) ? es->timing : es->analyze;
 
@@ -516,6 +526,8 @@ ExplainOnePlan(PlannedStmt *plannedstmt, IntoClause *into, ExplainState *es,
 		instrument_option |= INSTRUMENT_BUFFERS;
 	if (es->wal)
 		instrument_option |= INSTRUMENT_WAL;
+	if (es->storage)
+		instrument_option |= INSTRUMENT_STORAGE;
 
 	/*
 	 * We always collect timing for the entire statement, even when node-level
@@ -1377,6 +1389,8 @@ ExplainNode(PlanState *planstate, List *ancestors,
 		}
 		if (plan->parallel_aware)
 			appendStringInfoString(es->str, "Parallel ");
+		if (plan->async_capable)
+			appendStringInfoString(es->str, "Async ");
 		appendStringInfoString(es->str, pname);
 		es->indent++;
 	}
@@ -1396,6 +1410,7 @@ ExplainNode(PlanState *planstate, List *ancestors,
 		if (custom_name)
 			ExplainPropertyText("Custom Plan Provider", custom_name, es);
 		ExplainPropertyBool("Parallel Aware", plan->parallel_aware, es);
+		ExplainPropertyBool("Async Capable", plan->async_capable, es);
 	}
 
 	switch (nodeTag(plan))
@@ -1982,14 +1997,16 @@ ExplainNode(PlanState *planstate, List *ancestors,
 		}
 	}
 
-	/* Show buffer/WAL usage */
+	/* Show buffer/WAL/storage usage */
 	if (es->buffers && planstate->instrument)
 		show_buffer_usage(es, &planstate->instrument->bufusage, false);
 	if (es->wal && planstate->instrument)
 		show_wal_usage(es, &planstate->instrument->walusage);
+	if (es->storage && planstate->instrument)
+		show_storage_usage(es, &planstate->instrument->storageusage);
 
-	/* Prepare per-worker buffer/WAL usage */
-	if (es->workers_state && (es->buffers || es->wal) && es->verbose)
+	/* Prepare per-worker buffer/WAL/storage usage */
+	if (es->workers_state && (es->buffers || es->wal || es->storage) && es->verbose)
 	{
 		WorkerInstrumentation *w = planstate->worker_instrument;
 
@@ -2006,6 +2023,8 @@ ExplainNode(PlanState *planstate, List *ancestors,
 				show_buffer_usage(es, &instrument->bufusage, false);
 			if (es->wal)
 				show_wal_usage(es, &instrument->walusage);
+			if (es->storage)
+				show_storage_usage(es, &instrument->storageusage);
 			ExplainCloseWorker(n, es);
 		}
 	}
@@ -3303,10 +3322,14 @@ show_buffer_usage(ExplainState *es, const BufferUsage *usage, bool planning)
 								 usage->local_blks_written > 0);
 		bool		has_temp = (usage->temp_blks_read > 0 ||
 								usage->temp_blks_written > 0);
+		bool		has_remote = (usage->remote_blks_read > 0 ||
+								  usage->mempool_blks_hit > 0);
 		bool		has_timing = (!INSTR_TIME_IS_ZERO(usage->blk_read_time) ||
-								  !INSTR_TIME_IS_ZERO(usage->blk_write_time));
+								  !INSTR_TIME_IS_ZERO(usage->blk_write_time) ||
+								  !INSTR_TIME_IS_ZERO(usage->remote_blk_read_time));
 		bool		show_planning = (planning && (has_shared ||
-												  has_local || has_temp || has_timing));
+												  has_local || has_temp ||
+												  has_remote || has_timing));
 
 		if (show_planning)
 		{
@@ -3316,7 +3339,7 @@ show_buffer_usage(ExplainState *es, const BufferUsage *usage, bool planning)
 		}
 
 		/* Show only positive counter values. */
-		if (has_shared || has_local || has_temp)
+		if (has_shared || has_local || has_temp || has_remote)
 		{
 			ExplainIndentText(es);
 			appendStringInfoString(es->str, "Buffers:");
@@ -3336,7 +3359,7 @@ show_buffer_usage(ExplainState *es, const BufferUsage *usage, bool planning)
 				if (usage->shared_blks_written > 0)
 					appendStringInfo(es->str, " written=%ld",
 									 usage->shared_blks_written);
-				if (has_local || has_temp)
+				if (has_local || has_temp || has_remote)
 					appendStringInfoChar(es->str, ',');
 			}
 			if (has_local)
@@ -3354,7 +3377,7 @@ show_buffer_usage(ExplainState *es, const BufferUsage *usage, bool planning)
 				if (usage->local_blks_written > 0)
 					appendStringInfo(es->str, " written=%ld",
 									 usage->local_blks_written);
-				if (has_temp)
+				if (has_temp || has_remote)
 					appendStringInfoChar(es->str, ',');
 			}
 			if (has_temp)
@@ -3366,6 +3389,21 @@ show_buffer_usage(ExplainState *es, const BufferUsage *usage, bool planning)
 				if (usage->temp_blks_written > 0)
 					appendStringInfo(es->str, " written=%ld",
 									 usage->temp_blks_written);
+				if (has_remote)
+					appendStringInfoChar(es->str, ',');
+			}
+			if (has_remote)
+			{
+				appendStringInfoString(es->str, " remote");
+				if (usage->remote_blks_read > 0)
+					appendStringInfo(es->str, " read=%ld",
+									 usage->remote_blks_read);
+				if (usage->mempool_blks_hit > 0)
+					appendStringInfo(es->str, " mempool=%ld",
+									 usage->mempool_blks_hit);
+				if (usage->remote_read_bytes > 0)
+					appendStringInfo(es->str, " bytes=" UINT64_FORMAT,
+									 usage->remote_read_bytes);
 			}
 			appendStringInfoChar(es->str, '\n');
 		}
@@ -3381,6 +3419,9 @@ show_buffer_usage(ExplainState *es, const BufferUsage *usage, bool planning)
 			if (!INSTR_TIME_IS_ZERO(usage->blk_write_time))
 				appendStringInfo(es->str, " write=%0.3f",
 								 INSTR_TIME_GET_MILLISEC(usage->blk_write_time));
+			if (!INSTR_TIME_IS_ZERO(usage->remote_blk_read_time))
+				appendStringInfo(es->str, " remote read=%0.3f",
+								 INSTR_TIME_GET_MILLISEC(usage->remote_blk_read_time));
 			appendStringInfoChar(es->str, '\n');
 		}
 
@@ -3418,6 +3459,19 @@ show_buffer_usage(ExplainState *es, const BufferUsage *usage, bool planning)
 								 INSTR_TIME_GET_MILLISEC(usage->blk_write_time),
 								 3, es);
 		}
+		/* Only remote reads make them, don't clutter a local plan */
+		if (IsRpcClient)
+		{
+			ExplainPropertyInteger("Remote Read Blocks", NULL,
+								   usage->remote_blks_read, es);
+			ExplainPropertyInteger("Mempool Hit Blocks", NULL,
+								   usage->mempool_blks_hit, es);
+			ExplainPropertyUInteger("Remote Read Bytes", NULL,
+									usage->remote_read_bytes, es);
+			ExplainPropertyFloat("Remote Read Time", "ms",
+								 INSTR_TIME_GET_MILLISEC(usage->remote_blk_read_time),
+								 3, es);
+		}
 	}
 }
 
@@ -3459,6 +3513,43 @@ show_wal_usage(ExplainState *es, const WalUsage *usage)
 	}
 }
 
+/*
+ * Show the page reads sent to storage nodes, and the time the storage nodes
+ * spent waiting for the WAL to be parsed and replaying for them.
+ */
+static void
+show_storage_usage(ExplainState *es, const StorageUsage *usage)
+{
+	if (es->format == EXPLAIN_FORMAT_TEXT)
+	{
+		/* Show only positive counter values. */
+		if (usage->remote_reads > 0)
+		{
+			ExplainIndentText(es);
+			appendStringInfo(es->str, "Storage: reads=%ld bytes=" UINT64_FORMAT,
+							 usage->remote_reads, usage->remote_bytes);
+			if (usage->wait_parse_ns > 0)
+				appendStringInfo(es->str, " wait parse=%0.3f",
+								 (double) usage->wait_parse_ns / 1000000.0);
+			if (usage->replay_ns > 0)
+				appendStringInfo(es->str, " replay=%0.3f",
+								 (double) usage->replay_ns / 1000000.0);
+			appendStringInfoChar(es->str, '\n');
+		}
+	}
+	else
+	{
+		ExplainPropertyInteger("Storage Reads", NULL,
+							   usage->remote_reads, es);
+		ExplainPropertyUInteger("Storage Read Bytes", NULL,
+								usage->remote_bytes, es);
+		ExplainPropertyFloat("Storage Wait Parse Time", "ms",
+							 (double) usage->wait_parse_ns / 1000000.0, 3, es);
+		ExplainPropertyFloat("Storage Replay Time", "ms",
+							 (double) usage->replay_ns / 1000000.0, 3, es);
+	}
+}
+
 /*
  * Add some additional details about an IndexScan or IndexOnlyScan
  */
@@ -0,0 +1,498 @@
+/*-------------------------------------------------------------------------
+ *
+ * execBatch.c
+ *	  Vectorized evaluation of scan quals over a page of tuples
+ *
+ * Row mode runs a scan's qual through the expression interpreter once per
+ * tuple. Here the common comparison and arithmetic clauses run as tight
+ * loops over a page of column values instead, see executor/execBatch.h
+ * for what is covered.
+ *
+ * Results don't differ from row mode: the clauses are evaluated in order,
+ * each over the rows all earlier ones were true for, so a row one of them
+ * rejects, or that is null for it, is never seen by the next one, just as
+ * ExecQual stops at the first clause that isn't true. Arithmetic checks for
+ * overflow and raises the same errors as the int2/int4/int8 operators.
+ *
+ * Portions Copyright (c) 1996-2020, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ *
+ * IDENTIFICATION
+ *	  src/backend/executor/execBatch.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/stratnum.h"
+#include "catalog/pg_opfamily.h"
+#include "catalog/pg_type.h"
+#include "common/int.h"
+#include "executor/execBatch.h"
+#include "nodes/primnodes.h"
+#include "utils/fmgroids.h"
+#include "utils/lsyscache.h"
+
+typedef enum BatchExprKind
+{
+	BATCH_COLUMN,
+	BATCH_CONST,
+	BATCH_ARITH,
+	BATCH_COMPARE,
+	BATCH_NULLTEST
+} BatchExprKind;
+
+typedef enum BatchArithOp
+{
+	BATCH_ADD,
+	BATCH_SUB,
+	BATCH_MUL
+} BatchArithOp;
+
+struct BatchExpr
+{
+	BatchExprKind kind;
+	int			op;				/* BatchArithOp, btree strategy or
+								 * NullTestType */
+	int			width;			/* bytes of an arithmetic result */
+	int			column;			/* BATCH_COLUMN and BATCH_NULLTEST */
+	BatchExpr  *left;
+	BatchExpr  *right;
+	int64	   *values;			/* value nodes, [row] */
+	bool	   *nulls;
+};
+
+typedef struct BatchArithInfo
+{
+	Oid			funcid;
+	BatchArithOp op;
+	int			width;
+} BatchArithInfo;
+
+static const BatchArithInfo batch_arith_ops[] = {
+	{F_INT2PL, BATCH_ADD, 2},
+	{F_INT2MI, BATCH_SUB, 2},
+	{F_INT2MUL, BATCH_MUL, 2},
+	{F_INT4PL, BATCH_ADD, 4},
+	{F_INT4MI, BATCH_SUB, 4},
+	{F_INT4MUL, BATCH_MUL, 4},
+	{F_INT8PL, BATCH_ADD, 8},
+	{F_INT8MI, BATCH_SUB, 8},
+	{F_INT8MUL, BATCH_MUL, 8}
+};
+
+static BatchExpr *batch_compile_operand(BatchQual *bq, Expr *expr, Index scanrelid);
+
+/* Whether values of the type are held by the batches */
+static bool
+batch_type_supported(Oid type)
+{
+	switch (type)
+	{
+		case INT2OID:
+		case INT4OID:
+		case INT8OID:
+		case OIDOID:
+		case DATEOID:
+			return true;
+		default:
+			return false;
+	}
+}
+
+static int64
+batch_datum_value(Datum value, Oid type)
+{
+	switch (type)
+	{
+		case INT2OID:
+			return DatumGetInt16(value);
+		case INT8OID:
+			return DatumGetInt64(value);
+		case OIDOID:
+			return DatumGetObjectId(value);
+		default:
+			/* int4, date */
+			return DatumGetInt32(value);
+	}
+}
+
+static BatchExpr *
+batch_new_value(BatchExprKind kind)
+{
+	BatchExpr  *expr = palloc0(sizeof(BatchExpr));
+
+	expr->kind = kind;
+	expr->values = palloc(sizeof(int64) * BATCH_MAX_ROWS);
+	expr->nulls = palloc0(sizeof(bool) * BATCH_MAX_ROWS);
+	return expr;
+}
+
+/* The position of the batch column for attno, added if new */
+static int
+batch_column(BatchQual *bq, AttrNumber attno, Oid type)
+{
+	for (int c = 0; c < bq->ncolumns; c++)
+		if (bq->attnos[c] == attno)
+			return c;
+
+	if (bq->ncolumns == 0)
+	{
+		bq->attnos = palloc(sizeof(AttrNumber));
+		bq->types = palloc(sizeof(Oid));
+		bq->values = palloc(sizeof(int64 *));
+		bq->nulls = palloc(sizeof(bool *));
+	}
+	else
+	{
+		bq->attnos = repalloc(bq->attnos, sizeof(AttrNumber) * (bq->ncolumns + 1));
+		bq->types = repalloc(bq->types, sizeof(Oid) * (bq->ncolumns + 1));
+		bq->values = repalloc(bq->values, sizeof(int64 *) * (bq->ncolumns + 1));
+		bq->nulls = repalloc(bq->nulls, sizeof(bool *) * (bq->ncolumns + 1));
+	}
+	bq->attnos[bq->ncolumns] = attno;
+	bq->types[bq->ncolumns] = type;
+	bq->values[bq->ncolumns] = palloc(sizeof(int64) * BATCH_MAX_ROWS);
+	bq->nulls[bq->ncolumns] = palloc(sizeof(bool) * BATCH_MAX_ROWS);
+	bq->maxattno = Max(bq->maxattno, attno);
+	return bq->ncolumns++;
+}
+
+/* A user column of the scanned relation */
+static Var *
+batch_scan_var(Expr *expr, Index scanrelid)
+{
+	Var		   *var;
+
+	if (!IsA(expr, Var))
+		return NULL;
+	var = (Var *) expr;
+	if (var->varno != scanrelid || var->varlevelsup != 0 || var->varattno < 1 ||
+		!batch_type_supported(var->vartype))
+		return NULL;
+	return var;
+}
+
+static BatchExpr *
+batch_compile_arith(BatchQual *bq, OpExpr *op, Index scanrelid)
+{
+	BatchExpr  *expr;
+	BatchExpr  *left;
+	BatchExpr  *right;
+	const BatchArithInfo *info = NULL;
+
+	for (int i = 0; i < lengthof(batch_arith_ops); i++)
+		if (batch_arith_ops[i].funcid == op->opfuncid)
+			info = &batch_arith_ops[i];
+	if (info == NULL)
+		return NULL;
+
+	left = batch_compile_operand(bq, linitial(op->args), scanrelid);
+	right = left != NULL ? batch_compile_operand(bq, lsecond(op->args), scanrelid) : NULL;
+	if (right == NULL)
+		return NULL;
+
+	expr = batch_new_value(BATCH_ARITH);
+	expr->op = info->op;
+	expr->width = info->width;
+	expr->left = left;
+	expr->right = right;
+	return expr;
+}
+
+static BatchExpr *
+batch_compile_operand(BatchQual *bq, Expr *expr, Index scanrelid)
+{
+	Var		   *var;
+
+	if ((var = batch_scan_var(expr, scanrelid)) != NULL)
+	{
+		BatchExpr  *column = palloc0(sizeof(BatchExpr));
+
+		column->kind = BATCH_COLUMN;
+		column->column = batch_column(bq, var->varattno, var->vartype);
+		column->values = bq->values[column->column];
+		column->nulls = bq->nulls[column->column];
+		return column;
+	}
+
+	if (IsA(expr, Const))
+	{
+		Const	   *cnst = (Const *) expr;
+		BatchExpr  *value;
+		int64		constant;
+
+		if (cnst->constisnull || !batch_type_supported(cnst->consttype))
+			return NULL;
+		constant = batch_datum_value(cnst->constvalue, cnst->consttype);
+		value = batch_new_value(BATCH_CONST);
+		for (int i = 0; i < BATCH_MAX_ROWS; i++)
+			value->values[i] = constant;
+		return value;
+	}
+
+	if (IsA(expr, OpExpr) && list_length(((OpExpr *) expr)->args) == 2)
+		return batch_compile_arith(bq, (OpExpr *) expr, scanrelid);
+
+	return NULL;
+}
+
+/* The btree strategy of a comparison the batches can evaluate */
+static int
+batch_compare_strategy(OpExpr *op)
+{
+	int			strategy;
+
+	strategy = get_op_opfamily_strategy(op->opno, INTEGER_BTREE_FAM_OID);
+	if (strategy != InvalidStrategy)
+		return strategy;
+	strategy = get_op_opfamily_strategy(op->opno, OID_BTREE_FAM_OID);
+	if (strategy != InvalidStrategy)
+		return strategy;
+
+	/* date's family also compares it with timestamps, take date's own */
+	switch (op->opfuncid)
+	{
+		case F_DATE_LT:
+			return BTLessStrategyNumber;
+		case F_DATE_LE:
+			return BTLessEqualStrategyNumber;
+		case F_DATE_EQ:
+			return BTEqualStrategyNumber;
+		case F_DATE_GE:
+			return BTGreaterEqualStrategyNumber;
+		case F_DATE_GT:
+			return BTGreaterStrategyNumber;
+		default:
+			return InvalidStrategy;
+	}
+}
+
+static BatchExpr *
+batch_compile_clause(BatchQual *bq, Expr *clause, Index scanrelid)
+{
+	BatchExpr  *expr;
+
+	if (IsA(clause, OpExpr))
+	{
+		OpExpr	   *op = (OpExpr *) clause;
+		BatchExpr  *left;
+		BatchExpr  *right;
+		int			strategy;
+
+		if (list_length(op->args) != 2)
+			return NULL;
+		strategy = batch_compare_strategy(op);
+		if (strategy == InvalidStrategy)
+			return NULL;
+		left = batch_compile_operand(bq, linitial(op->args), scanrelid);
+		right = left != NULL ? batch_compile_operand(bq, lsecond(op->args), scanrelid) : NULL;
+		if (right == NULL)
+			return NULL;
+
+		expr = palloc0(sizeof(BatchExpr));
+		expr->kind = BATCH_COMPARE;
+		expr->op = strategy;
+		expr->left = left;
+		expr->right = right;
+		return expr;
+	}
+
+	if (IsA(clause, NullTest))
+	{
+		NullTest   *test = (NullTest *) clause;
+		Var		   *var = batch_scan_var(test->arg, scanrelid);
+
+		if (var == NULL || test->argisrow)
+			return NULL;
+		expr = palloc0(sizeof(BatchExpr));
+		expr->kind = BATCH_NULLTEST;
+		expr->op = test->nulltesttype;
+		expr->column = batch_column(bq, var->varattno, var->vartype);
+		return expr;
+	}
+
+	return NULL;
+}
+
+BatchQual *
+ExecInitBatchQual(List *qual, Index scanrelid, List **residual)
+{
+	BatchQual  *bq = palloc0(sizeof(BatchQual));
+	ListCell   *lc;
+
+	foreach(lc, qual)
+	{
+		BatchExpr  *expr = batch_compile_clause(bq, (Expr *) lfirst(lc), scanrelid);
+
+		if (expr == NULL)
+			break;
+		bq->clauses = lappend(bq->clauses, expr);
+	}
+
+	if (bq->clauses == NIL)
+	{
+		/* Columns of a clause given up on halfway are just left unused */
+		*residual = qual;
+		return NULL;
+	}
+	*residual = list_copy_tail(qual, list_length(bq->clauses));
+	return bq;
+}
+
+void
+ExecBatchQualLoad(BatchQual *bq, int row, TupleTableSlot *slot)
+{
+	slot_getsomeattrs(slot, bq->maxattno);
+	for (int c = 0; c < bq->ncolumns; c++)
+	{
+		int			att = bq->attnos[c] - 1;
+
+		bq->nulls[c][row] = slot->tts_isnull[att];
+		if (!slot->tts_isnull[att])
+			bq->values[c][row] = batch_datum_value(slot->tts_values[att], bq->types[c]);
+	}
+}
+
+static void
+batch_out_of_range(int width)
+{
+	ereport(ERROR,
+			(errcode(ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE),
+			 errmsg(width == 2 ? "smallint out of range" :
+					width == 4 ? "integer out of range" : "bigint out of range")));
+}
+
+static inline bool
+batch_arith_overflow(int op, int width, int64 a, int64 b, int64 *result)
+{
+	if (width == 8)
+	{
+		switch (op)
+		{
+			case BATCH_ADD:
+				return pg_add_s64_overflow(a, b, result);
+			case BATCH_SUB:
+				return pg_sub_s64_overflow(a, b, result);
+			default:
+				return pg_mul_s64_overflow(a, b, result);
+		}
+	}
+
+	/* Operands of width 2 or 4 can't overflow an int64 */
+	switch (op)
+	{
+		case BATCH_ADD:
+			*result = a + b;
+			break;
+		case BATCH_SUB:
+			*result = a - b;
+			break;
+		default:
+			*result = a * b;
+			break;
+	}
+	if (width == 2)
+		return *result < PG_INT16_MIN || *result > PG_INT16_MAX;
+	return *result < PG_INT32_MIN || *result > PG_INT32_MAX;
+}
+
+/* Computes a value node for the selected rows */
+static void
+batch_eval_value(BatchExpr *expr, const uint16 *sel, int nsel)
+{
+	BatchExpr  *left = expr->left;
+	BatchExpr  *right = expr->right;
+
+	if (expr->kind != BATCH_ARITH)
+		return;
+
+	batch_eval_value(left, sel, nsel);
+	batch_eval_value(right, sel, nsel);
+	for (int i = 0; i < nsel; i++)
+	{
+		int			row = sel[i];
+
+		expr->nulls[row] = left->nulls[row] || right->nulls[row];
+		if (!expr->nulls[row] &&
+			batch_arith_overflow(expr->op, expr->width, left->values[row],
+								 right->values[row], &expr->values[row]))
+			batch_out_of_range(expr->width);
+	}
+}
+
+#define BATCH_FILTER(cond) \
+	for (int i = 0; i < nsel; i++) \
+	{ \
+		int			row = sel[i]; \
+		\
+		if (!lnulls[row] && !rnulls[row] && (cond)) \
+			sel[kept++] = row; \
+	}
+
+/* Narrows sel to the rows the clause is true for, returns how many */
+static int
+batch_eval_clause(BatchQual *bq, BatchExpr *expr, uint16 *sel, int nsel)
+{
+	int			kept = 0;
+
+	if (expr->kind == BATCH_NULLTEST)
+	{
+		bool	   *nulls = bq->nulls[expr->column];
+		bool		wantNull = expr->op == IS_NULL;
+
+		for (int i = 0; i < nsel; i++)
+			if (nulls[sel[i]] == wantNull)
+				sel[kept++] = sel[i];
+		return kept;
+	}
+
+	batch_eval_value(expr->left, sel, nsel);
+	batch_eval_value(expr->right, sel, nsel);
+	{
+		const int64 *lvalues = expr->left->values;
+		const int64 *rvalues = expr->right->values;
+		const bool *lnulls = expr->left->nulls;
+		const bool *rnulls = expr->right->nulls;
+
+		switch (expr->op)
+		{
+			case BTLessStrategyNumber:
+				BATCH_FILTER(lvalues[row] < rvalues[row]);
+				break;
+			case BTLessEqualStrategyNumber:
+				BATCH_FILTER(lvalues[row] <= rvalues[row]);
+				break;
+			case BTEqualStrategyNumber:
+				BATCH_FILTER(lvalues[row] == rvalues[row]);
+				break;
+			case BTGreaterEqualStrategyNumber:
+				BATCH_FILTER(lvalues[row] >= rvalues[row]);
+				break;
+			case BTGreaterStrategyNumber:
+				BATCH_FILTER(lvalues[row] > rvalues[row]);
+				break;
+			default:
+				elog(ERROR, "unrecognized btree strategy %d", expr->op);
+		}
+	}
+	return kept;
+}
+
+int
+ExecBatchQual(BatchQual *bq, int nrows, uint16 *selection)
+{
+	int			nsel = nrows;
+	ListCell   *lc;
+
+	for (int i = 0; i < nrows; i++)
+		selection[i] = i;
+	foreach(lc, bq->clauses)
+	{
+		nsel = batch_eval_clause(bq, (BatchExpr *) lfirst(lc), selection, nsel);
+		if (nsel == 0)
+			break;
+	}
+	return nsel;
+}
@@ -2980,6 +2980,10 @@ ExecBuildAggTrans(AggState *aggstate, AggStatePerPhase phase,
 		int			argno;
 		ListCell   *bail;
 
+		/* Advanced a batch of rows at a time by nodeAgg.c instead */
+		if (pertrans->batch_transfn != NULL)
+			continue;
+
 		/*
 		 * If filter present, emit. Do so before evaluating the input, to
 		 * avoid potentially unneeded computations, or even worse, unintended
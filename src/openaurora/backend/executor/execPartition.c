@@ -29,7 +29,9 @@
 #include "partitioning/partprune.h"
 #include "rewrite/rewriteManip.h"
 #include "utils/acl.h"
+#include "utils/hsearch.h"
 #include "utils/lsyscache.h"
+#include "utils/memutils.h"
 #include "utils/partcache.h"
 #include "utils/rls.h"
 #include "utils/ruleutils.h"
@@ -160,6 +162,26 @@ typedef struct SubplanResultRelHashElem
 	ResultRelInfo *rri;
 } SubplanResultRelHashElem;
 
+/*
+ * The run-time pruning state of a PartitionPruneInfo of a cached plan is kept
+ * from one execution of the plan to the next, so that executing a generic
+ * plan doesn't set up the partitions' maps and the steps' support functions
+ * anew each time.  Only the expression states, and copies of what pruning
+ * changes, are made per execution.  A plan run again by a recursive call
+ * while the state is in use gets its own one.
+ */
+typedef struct PartitionPruneCacheEntry
+{
+	PartitionPruneInfo *pruneinfo;	/* hash key -- must be first */
+	MemoryContext cxt;			/* holds prunestate, NULL until the second
+								 * execution: custom plans run only once */
+	PartitionPruneState *prunestate;	/* NULL until first built */
+	bool		executed;		/* the plan ran before */
+	bool		in_use;			/* by an execution in progress */
+} PartitionPruneCacheEntry;
+
+static HTAB *PartitionPruneCache = NULL;
+
 
 static void ExecHashSubPlanResultRelsByOid(ModifyTableState *mtstate,
 										   PartitionTupleRouting *proute);
@@ -189,7 +211,19 @@ static char *ExecBuildSlotPartitionKeyDescription(Relation rel,
 												  bool *isnull,
 												  int maxfieldlen);
 static List *adjust_partition_tlist(List *tlist, TupleConversionMap *map);
+static PartitionPruneCacheEntry *PartitionPruneCacheLookup(PartitionPruneInfo *pruneinfo);
+static void PartitionPruneCacheDrop(void *arg);
+static void PartitionPruneCacheRelease(void *arg);
+static PartitionPruneState *CreatePartitionPruneState(EState *estate,
+													  PartitionPruneInfo *partitionpruneinfo,
+													  MemoryContext statecxt);
+static bool BindPartitionPruneState(PlanState *planstate,
+									PartitionPruneState *prunestate,
+									PartitionPruneInfo *partitionpruneinfo);
 static void ExecInitPruningContext(PartitionPruneContext *context,
+								   List *pruning_steps,
+								   PartitionKey partkey);
+static void ExecBindPruningContext(PartitionPruneContext *context,
 								   List *pruning_steps,
 								   PartitionDesc partdesc,
 								   PartitionKey partkey,
@@ -998,6 +1032,20 @@ ExecInitRoutingInfo(ModifyTableState *mtstate,
 		partRelInfo->ri_FdwRoutine->BeginForeignInsert != NULL)
 		partRelInfo->ri_FdwRoutine->BeginForeignInsert(mtstate, partRelInfo);
 
+	/*
+	 * Determine if the FDW supports batch insert and the batch size (the FDW
+	 * may support batching but have it disabled for the table or for this
+	 * query). If the FDW does not support batching, the batch size is 1.
+	 */
+	if (mtstate->operation == CMD_INSERT &&
+		partRelInfo->ri_FdwRoutine != NULL &&
+		partRelInfo->ri_FdwRoutine->GetForeignModifyBatchSize &&
+		partRelInfo->ri_FdwRoutine->ExecForeignBatchInsert)
+		partRelInfo->ri_BatchSize =
+			partRelInfo->ri_FdwRoutine->GetForeignModifyBatchSize(partRelInfo);
+	else
+		partRelInfo->ri_BatchSize = 1;
+
 	partRelInfo->ri_PartitionInfo = partrouteinfo;
 	partRelInfo->ri_CopyMultiInsertBuffer = NULL;
 
@@ -1175,6 +1223,7 @@ ExecCleanupTupleRouting(ModifyTableState *mtstate,
 {
 	HTAB	   *htab = proute->subplan_resultrel_htab;
 	int			i;
+	int			j;
 
 	/*
 	 * Remember, proute->partition_dispatch_info[0] corresponds to the root
@@ -1219,6 +1268,13 @@ ExecCleanupTupleRouting(ModifyTableState *mtstate,
 				continue;
 		}
 
+		/* Release the slots made for batch insert, if any */
+		for (j = 0; j < resultRelInfo->ri_NumSlotsInitialized; j++)
+		{
+			ExecDropSingleTupleTableSlot(resultRelInfo->ri_Slots[j]);
+			ExecDropSingleTupleTableSlot(resultRelInfo->ri_PlanSlots[j]);
+		}
+
 		ExecCloseIndices(resultRelInfo);
 		table_close(resultRelInfo->ri_RelationDesc, NoLock);
 	}
@@ -1629,15 +1685,149 @@ ExecCreatePartitionPruneState(PlanState *planstate,
 							  PartitionPruneInfo *partitionpruneinfo)
 {
 	EState	   *estate = planstate->state;
+	PartitionPruneCacheEntry *entry;
 	PartitionPruneState *prunestate;
-	int			n_part_hierarchies;
-	ListCell   *lc;
-	int			i;
+	MemoryContextCallback *cb;
 
 	if (estate->es_partition_directory == NULL)
 		estate->es_partition_directory =
 			CreatePartitionDirectory(estate->es_query_cxt);
 
+	entry = PartitionPruneCacheLookup(partitionpruneinfo);
+	if (entry != NULL && entry->cxt == NULL && entry->executed)
+		entry->cxt = AllocSetContextCreate(CacheMemoryContext,
+										   "Partition Prune Cache Entry",
+										   ALLOCSET_SMALL_SIZES);
+	if (entry == NULL || entry->cxt == NULL || entry->in_use)
+	{
+		/*
+		 * Not of a cached plan, its first execution, or used further up by a
+		 * recursive call
+		 */
+		if (entry != NULL)
+			entry->executed = true;
+		prunestate = CreatePartitionPruneState(estate, partitionpruneinfo,
+											   CurrentMemoryContext);
+		if (!BindPartitionPruneState(planstate, prunestate, partitionpruneinfo))
+			elog(ERROR, "could not match partition child tables to plan elements");
+		return prunestate;
+	}
+
+	prunestate = entry->prunestate;
+	if (prunestate == NULL ||
+		!BindPartitionPruneState(planstate, prunestate, partitionpruneinfo))
+	{
+		/* First execution, or the partitions changed since the last one */
+		MemoryContextReset(entry->cxt);
+		prunestate = CreatePartitionPruneState(estate, partitionpruneinfo,
+											   entry->cxt);
+		entry->prunestate = prunestate;
+		if (!BindPartitionPruneState(planstate, prunestate, partitionpruneinfo))
+			elog(ERROR, "could not match partition child tables to plan elements");
+	}
+
+	/* Released with the executor state */
+	entry->in_use = true;
+	cb = MemoryContextAlloc(estate->es_query_cxt, sizeof(MemoryContextCallback));
+	cb->func = PartitionPruneCacheRelease;
+	cb->arg = partitionpruneinfo;
+	MemoryContextRegisterResetCallback(estate->es_query_cxt, cb);
+
+	return prunestate;
+}
+
+/*
+ * PartitionPruneCacheLookup
+ *		Returns the cache entry of the PartitionPruneInfo of a cached plan,
+ *		creating it if needed, or NULL if the plan isn't cached.
+ *
+ * The entry goes away with the plan's memory context, so the address of the
+ * PartitionPruneInfo can't be that of another plan's while the entry exists.
+ */
+static PartitionPruneCacheEntry *
+PartitionPruneCacheLookup(PartitionPruneInfo *pruneinfo)
+{
+	MemoryContext plancxt = GetMemoryChunkContext(pruneinfo);
+	PartitionPruneCacheEntry *entry;
+	MemoryContextCallback *cb;
+	bool		found;
+
+	if (strcmp(plancxt->name, "CachedPlan") != 0)
+		return NULL;
+
+	if (PartitionPruneCache == NULL)
+	{
+		HASHCTL		ctl;
+
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = sizeof(PartitionPruneInfo *);
+		ctl.entrysize = sizeof(PartitionPruneCacheEntry);
+		ctl.hcxt = CacheMemoryContext;
+		PartitionPruneCache = hash_create("Partition Prune Cache", 64, &ctl,
+										  HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	}
+
+	entry = hash_search(PartitionPruneCache, &pruneinfo, HASH_ENTER, &found);
+	if (!found)
+	{
+		entry->cxt = NULL;
+		entry->prunestate = NULL;
+		entry->executed = false;
+		entry->in_use = false;
+
+		cb = MemoryContextAlloc(plancxt, sizeof(MemoryContextCallback));
+		cb->func = PartitionPruneCacheDrop;
+		cb->arg = pruneinfo;
+		MemoryContextRegisterResetCallback(plancxt, cb);
+	}
+	return entry;
+}
+
+/* The cached plan holding the PartitionPruneInfo arg is going away */
+static void
+PartitionPruneCacheDrop(void *arg)
+{
+	PartitionPruneCacheEntry *entry;
+
+	entry = hash_search(PartitionPruneCache, &arg, HASH_FIND, NULL);
+	if (entry == NULL)
+		return;
+	if (entry->cxt != NULL)
+		MemoryContextDelete(entry->cxt);
+	hash_search(PartitionPruneCache, &arg, HASH_REMOVE, NULL);
+}
+
+/* The execution using the entry of the PartitionPruneInfo arg is over */
+static void
+PartitionPruneCacheRelease(void *arg)
+{
+	PartitionPruneCacheEntry *entry;
+
+	entry = hash_search(PartitionPruneCache, &arg, HASH_FIND, NULL);
+	if (entry != NULL)
+		entry->in_use = false;
+}
+
+/*
+ * CreatePartitionPruneState
+ *		Build the parts of a PartitionPruneState that don't depend on the
+ *		execution, in 'statecxt'.
+ *
+ * BindPartitionPruneState must be called before the state is used.
+ */
+static PartitionPruneState *
+CreatePartitionPruneState(EState *estate,
+						  PartitionPruneInfo *partitionpruneinfo,
+						  MemoryContext statecxt)
+{
+	PartitionPruneState *prunestate;
+	MemoryContext oldcontext;
+	int			n_part_hierarchies;
+	ListCell   *lc;
+	int			i;
+
+	oldcontext = MemoryContextSwitchTo(statecxt);
+
 	n_part_hierarchies = list_length(partitionpruneinfo->prune_infos);
 	Assert(n_part_hierarchies > 0);
 
@@ -1649,8 +1839,7 @@ ExecCreatePartitionPruneState(PlanState *planstate,
 			   sizeof(PartitionPruningData *) * n_part_hierarchies);
 
 	prunestate->execparamids = NULL;
-	/* other_subplans can change at runtime, so we need our own copy */
-	prunestate->other_subplans = bms_copy(partitionpruneinfo->other_subplans);
+	prunestate->other_subplans = NULL;
 	prunestate->do_initial_prune = false;	/* may be set below */
 	prunestate->do_exec_prune = false;	/* may be set below */
 	prunestate->num_partprunedata = n_part_hierarchies;
@@ -1662,7 +1851,7 @@ ExecCreatePartitionPruneState(PlanState *planstate,
 	 * our control.
 	 */
 	prunestate->prune_context =
-		AllocSetContextCreate(CurrentMemoryContext,
+		AllocSetContextCreate(statecxt,
 							  "Partition Prune",
 							  ALLOCSET_DEFAULT_SIZES);
 
@@ -1709,17 +1898,19 @@ ExecCreatePartitionPruneState(PlanState *planstate,
 			 */
 			Assert(partdesc->nparts >= pinfo->nparts);
 			pprune->nparts = partdesc->nparts;
+			pprune->partoids = palloc(sizeof(Oid) * partdesc->nparts);
+			memcpy(pprune->partoids, partdesc->oids,
+				   sizeof(Oid) * partdesc->nparts);
 			pprune->subplan_map = palloc(sizeof(int) * partdesc->nparts);
 			if (partdesc->nparts == pinfo->nparts)
 			{
 				/*
 				 * There are no new partitions, so this is simple.  We can
-				 * simply point to the subpart_map from the plan, but we must
-				 * copy the subplan_map since we may change it later.
+				 * simply point to the maps from the plan; the subplan_map is
+				 * copied from there as we may change it later.
 				 */
 				pprune->subpart_map = pinfo->subpart_map;
-				memcpy(pprune->subplan_map, pinfo->subplan_map,
-					   sizeof(int) * pinfo->nparts);
+				pprune->initial_subplan_map = pinfo->subplan_map;
 
 				/*
 				 * Double-check that the list of unpruned relations has not
@@ -1754,6 +1945,7 @@ ExecCreatePartitionPruneState(PlanState *planstate,
 				 * relid_map entries, however, had better be a subset of the
 				 * partdesc entries and in the same order.
 				 */
+				pprune->initial_subplan_map = palloc(sizeof(int) * partdesc->nparts);
 				pprune->subpart_map = palloc(sizeof(int) * partdesc->nparts);
 				for (pp_idx = 0; pp_idx < partdesc->nparts; pp_idx++)
 				{
@@ -1766,7 +1958,7 @@ ExecCreatePartitionPruneState(PlanState *planstate,
 						pinfo->relid_map[pd_idx] == partdesc->oids[pp_idx])
 					{
 						/* match... */
-						pprune->subplan_map[pp_idx] =
+						pprune->initial_subplan_map[pp_idx] =
 							pinfo->subplan_map[pd_idx];
 						pprune->subpart_map[pp_idx] =
 							pinfo->subpart_map[pd_idx];
@@ -1775,7 +1967,7 @@ ExecCreatePartitionPruneState(PlanState *planstate,
 					else
 					{
 						/* this partdesc entry is not in the plan */
-						pprune->subplan_map[pp_idx] = -1;
+						pprune->initial_subplan_map[pp_idx] = -1;
 						pprune->subpart_map[pp_idx] = -1;
 					}
 				}
@@ -1790,9 +1982,7 @@ ExecCreatePartitionPruneState(PlanState *planstate,
 				if (pd_idx != pinfo->nparts)
 					elog(ERROR, "could not match partition child tables to plan elements");
 			}
-
-			/* present_parts is also subject to later modification */
-			pprune->present_parts = bms_copy(pinfo->present_parts);
+			pprune->present_parts = NULL;
 
 			/*
 			 * Initialize pruning contexts as needed.
@@ -1802,7 +1992,7 @@ ExecCreatePartitionPruneState(PlanState *planstate,
 			{
 				ExecInitPruningContext(&pprune->initial_context,
 									   pinfo->initial_pruning_steps,
-									   partdesc, partkey, planstate);
+									   partkey);
 				/* Record whether initial pruning is needed at any level */
 				prunestate->do_initial_prune = true;
 			}
@@ -1811,7 +2001,7 @@ ExecCreatePartitionPruneState(PlanState *planstate,
 			{
 				ExecInitPruningContext(&pprune->exec_context,
 									   pinfo->exec_pruning_steps,
-									   partdesc, partkey, planstate);
+									   partkey);
 				/* Record whether exec pruning is needed at any level */
 				prunestate->do_exec_prune = true;
 			}
@@ -1828,37 +2018,126 @@ ExecCreatePartitionPruneState(PlanState *planstate,
 		i++;
 	}
 
+	MemoryContextSwitchTo(oldcontext);
+
 	return prunestate;
 }
 
 /*
- * Initialize a PartitionPruneContext for the given list of pruning steps.
+ * BindPartitionPruneState
+ *		Set up a PartitionPruneState built by CreatePartitionPruneState for an
+ *		execution of its plan by 'planstate', undoing anything an earlier one
+ *		changed.
+ *
+ * What changes during an execution, and the expression states, are made in
+ * the current memory context.  Returns false if the partitions aren't those
+ * the state was built for.
+ */
+static bool
+BindPartitionPruneState(PlanState *planstate, PartitionPruneState *prunestate,
+						PartitionPruneInfo *partitionpruneinfo)
+{
+	EState	   *estate = planstate->state;
+	ListCell   *lc;
+	int			i;
+
+	i = 0;
+	foreach(lc, partitionpruneinfo->prune_infos)
+	{
+		List	   *partrelpruneinfos = lfirst_node(List, lc);
+		PartitionPruningData *prunedata = prunestate->partprunedata[i];
+		ListCell   *lc2;
+		int			j;
+
+		j = 0;
+		foreach(lc2, partrelpruneinfos)
+		{
+			PartitionedRelPruneInfo *pinfo = lfirst_node(PartitionedRelPruneInfo, lc2);
+			PartitionedRelPruningData *pprune = &prunedata->partrelprunedata[j];
+			Relation	partrel;
+			PartitionDesc partdesc;
+			PartitionKey partkey;
+
+			partrel = ExecGetRangeTableRelation(estate, pinfo->rtindex);
+			partkey = RelationGetPartitionKey(partrel);
+			partdesc = PartitionDirectoryLookup(estate->es_partition_directory,
+												partrel);
+			if (partdesc->nparts != pprune->nparts ||
+				memcmp(partdesc->oids, pprune->partoids,
+					   sizeof(Oid) * partdesc->nparts) != 0)
+				return false;
+
+			/* subplan_map and present_parts are subject to later modification */
+			memcpy(pprune->subplan_map, pprune->initial_subplan_map,
+				   sizeof(int) * pprune->nparts);
+			pprune->present_parts = bms_copy(pinfo->present_parts);
+
+			if (pprune->initial_pruning_steps)
+				ExecBindPruningContext(&pprune->initial_context,
+									   pprune->initial_pruning_steps,
+									   partdesc, partkey, planstate);
+			if (pprune->exec_pruning_steps)
+				ExecBindPruningContext(&pprune->exec_context,
+									   pprune->exec_pruning_steps,
+									   partdesc, partkey, planstate);
+			j++;
+		}
+		i++;
+	}
+
+	/* other_subplans can change at runtime, so we need our own copy */
+	prunestate->other_subplans = bms_copy(partitionpruneinfo->other_subplans);
+
+	return true;
+}
+
+/*
+ * Initialize a PartitionPruneContext for the given list of pruning steps,
+ * but for what ExecBindPruningContext sets.
  */
 static void
 ExecInitPruningContext(PartitionPruneContext *context,
+					   List *pruning_steps,
+					   PartitionKey partkey)
+{
+	int			n_steps;
+
+	n_steps = list_length(pruning_steps);
+
+	context->strategy = partkey->strategy;
+	context->partnatts = partkey->partnatts;
+
+	/*
+	 * We'll look up type-specific support functions as needed, they are kept
+	 * as long as the context
+	 */
+	context->stepcmpfuncs = (FmgrInfo *)
+		palloc0(sizeof(FmgrInfo) * n_steps * partkey->partnatts);
+
+	context->ppccontext = CurrentMemoryContext;
+}
+
+/*
+ * Set up a PartitionPruneContext built by ExecInitPruningContext for an
+ * execution by 'planstate'.
+ */
+static void
+ExecBindPruningContext(PartitionPruneContext *context,
 					   List *pruning_steps,
 					   PartitionDesc partdesc,
 					   PartitionKey partkey,
 					   PlanState *planstate)
 {
 	int			n_steps;
-	int			partnatts;
+	int			partnatts = context->partnatts;
 	ListCell   *lc;
 
 	n_steps = list_length(pruning_steps);
 
-	context->strategy = partkey->strategy;
-	context->partnatts = partnatts = partkey->partnatts;
 	context->nparts = partdesc->nparts;
 	context->boundinfo = partdesc->boundinfo;
 	context->partcollation = partkey->partcollation;
 	context->partsupfunc = partkey->partsupfunc;
-
-	/* We'll look up type-specific support functions as needed */
-	context->stepcmpfuncs = (FmgrInfo *)
-		palloc0(sizeof(FmgrInfo) * n_steps * partnatts);
-
-	context->ppccontext = CurrentMemoryContext;
 	context->planstate = planstate;
 
 	/* Initialize expression state for each expression we need */
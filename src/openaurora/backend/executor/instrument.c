@@ -21,9 +21,11 @@ BufferUsage pgBufferUsage;
 static BufferUsage save_pgBufferUsage;
 WalUsage	pgWalUsage;
 static WalUsage save_pgWalUsage;
+StorageUsage pgStorageUsage;
 
 static void BufferUsageAdd(BufferUsage *dst, const BufferUsage *add);
 static void WalUsageAdd(WalUsage *dst, WalUsage *add);
+static void StorageUsageAdd(StorageUsage *dst, const StorageUsage *add);
 
 
 /* Allocate new instrumentation structure(s) */
@@ -34,10 +36,12 @@ InstrAlloc(int n, int instrument_options)
 
 	/* initialize all fields to zeroes, then modify as needed */
 	instr = palloc0(n * sizeof(Instrumentation));
-	if (instrument_options & (INSTRUMENT_BUFFERS | INSTRUMENT_TIMER | INSTRUMENT_WAL))
+	if (instrument_options & (INSTRUMENT_BUFFERS | INSTRUMENT_TIMER | INSTRUMENT_WAL |
+							  INSTRUMENT_STORAGE))
 	{
 		bool		need_buffers = (instrument_options & INSTRUMENT_BUFFERS) != 0;
 		bool		need_wal = (instrument_options & INSTRUMENT_WAL) != 0;
+		bool		need_storage = (instrument_options & INSTRUMENT_STORAGE) != 0;
 		bool		need_timer = (instrument_options & INSTRUMENT_TIMER) != 0;
 		int			i;
 
@@ -45,6 +49,7 @@ InstrAlloc(int n, int instrument_options)
 		{
 			instr[i].need_bufusage = need_buffers;
 			instr[i].need_walusage = need_wal;
+			instr[i].need_storageusage = need_storage;
 			instr[i].need_timer = need_timer;
 		}
 	}
@@ -59,6 +64,7 @@ InstrInit(Instrumentation *instr, int instrument_options)
 	memset(instr, 0, sizeof(Instrumentation));
 	instr->need_bufusage = (instrument_options & INSTRUMENT_BUFFERS) != 0;
 	instr->need_walusage = (instrument_options & INSTRUMENT_WAL) != 0;
+	instr->need_storageusage = (instrument_options & INSTRUMENT_STORAGE) != 0;
 	instr->need_timer = (instrument_options & INSTRUMENT_TIMER) != 0;
 }
 
@@ -76,6 +82,9 @@ InstrStartNode(Instrumentation *instr)
 
 	if (instr->need_walusage)
 		instr->walusage_start = pgWalUsage;
+
+	if (instr->need_storageusage)
+		instr->storageusage_start = pgStorageUsage;
 }
 
 /* Exit from a plan node */
@@ -108,6 +117,10 @@ InstrStopNode(Instrumentation *instr, double nTuples)
 		WalUsageAccumDiff(&instr->walusage,
 						  &pgWalUsage, &instr->walusage_start);
 
+	if (instr->need_storageusage)
+		StorageUsageAccumDiff(&instr->storageusage,
+							  &pgStorageUsage, &instr->storageusage_start);
+
 	/* Is this the first tuple of this cycle? */
 	if (!instr->running)
 	{
@@ -116,6 +129,14 @@ InstrStopNode(Instrumentation *instr, double nTuples)
 	}
 }
 
+/* Update tuple count */
+void
+InstrUpdateTupleCount(Instrumentation *instr, double nTuples)
+{
+	/* count the returned tuples */
+	instr->tuplecount += nTuples;
+}
+
 /* Finish a run cycle for a plan node */
 void
 InstrEndLoop(Instrumentation *instr)
@@ -174,6 +195,9 @@ InstrAggNode(Instrumentation *dst, Instrumentation *add)
 
 	if (dst->need_walusage)
 		WalUsageAdd(&dst->walusage, &add->walusage);
+
+	if (dst->need_storageusage)
+		StorageUsageAdd(&dst->storageusage, &add->storageusage);
 }
 
 /* note current values during parallel executor startup */
@@ -218,6 +242,10 @@ BufferUsageAdd(BufferUsage *dst, const BufferUsage *add)
 	dst->temp_blks_written += add->temp_blks_written;
 	INSTR_TIME_ADD(dst->blk_read_time, add->blk_read_time);
 	INSTR_TIME_ADD(dst->blk_write_time, add->blk_write_time);
+	dst->remote_blks_read += add->remote_blks_read;
+	dst->mempool_blks_hit += add->mempool_blks_hit;
+	dst->remote_read_bytes += add->remote_read_bytes;
+	INSTR_TIME_ADD(dst->remote_blk_read_time, add->remote_blk_read_time);
 }
 
 /* dst += add - sub */
@@ -240,6 +268,11 @@ BufferUsageAccumDiff(BufferUsage *dst,
 						  add->blk_read_time, sub->blk_read_time);
 	INSTR_TIME_ACCUM_DIFF(dst->blk_write_time,
 						  add->blk_write_time, sub->blk_write_time);
+	dst->remote_blks_read += add->remote_blks_read - sub->remote_blks_read;
+	dst->mempool_blks_hit += add->mempool_blks_hit - sub->mempool_blks_hit;
+	dst->remote_read_bytes += add->remote_read_bytes - sub->remote_read_bytes;
+	INSTR_TIME_ACCUM_DIFF(dst->remote_blk_read_time,
+						  add->remote_blk_read_time, sub->remote_blk_read_time);
 }
 
 /* helper functions for WAL usage accumulation */
@@ -258,3 +291,22 @@ WalUsageAccumDiff(WalUsage *dst, const WalUsage *add, const WalUsage *sub)
 	dst->wal_records += add->wal_records - sub->wal_records;
 	dst->wal_fpi += add->wal_fpi - sub->wal_fpi;
 }
+
+/* helper functions for storage node read usage accumulation */
+static void
+StorageUsageAdd(StorageUsage *dst, const StorageUsage *add)
+{
+	dst->remote_reads += add->remote_reads;
+	dst->remote_bytes += add->remote_bytes;
+	dst->wait_parse_ns += add->wait_parse_ns;
+	dst->replay_ns += add->replay_ns;
+}
+
+void
+StorageUsageAccumDiff(StorageUsage *dst, const StorageUsage *add, const StorageUsage *sub)
+{
+	dst->remote_reads += add->remote_reads - sub->remote_reads;
+	dst->remote_bytes += add->remote_bytes - sub->remote_bytes;
+	dst->wait_parse_ns += add->wait_parse_ns - sub->wait_parse_ns;
+	dst->replay_ns += add->replay_ns - sub->replay_ns;
+}
@@ -267,6 +267,8 @@
 #include "utils/syscache.h"
 #include "utils/tuplesort.h"
 
+bool		enable_batch_agg = true;
+
 /*
  * Control how many partitions are created when spilling HashAgg to
  * disk.
@@ -305,6 +307,22 @@
  */
 #define HASHAGG_HLL_BIT_WIDTH 5
 
+/*
+ * A hash table expected to be larger than the CPU caches is filled a batch
+ * of input tuples at a time: all of them are hashed and their buckets
+ * prefetched before the first is looked up, so that the cache misses of the
+ * probes overlap instead of each lookup waiting for its own.
+ */
+#define HASHAGG_PREFETCH_BATCH 16
+#define HASHAGG_PREFETCH_MIN_SIZE (4 * 1024 * 1024)
+
+/*
+ * Input rows of the transition states with a batched transition function
+ * (see utils/aggbatch.h) are collected this many at a time, and each batch
+ * is aggregated by one call.
+ */
+#define AGG_BATCH_SIZE 1024
+
 /*
  * Estimate chunk overhead as a constant 16 bytes. XXX: should this be
  * improved?
@@ -389,6 +407,9 @@ static void advance_transition_function(AggState *aggstate,
 										AggStatePerTrans pertrans,
 										AggStatePerGroup pergroupstate);
 static void advance_aggregates(AggState *aggstate);
+static void agg_batch_init(AggState *aggstate, Agg *node);
+static void agg_batch_load(AggState *aggstate);
+static void agg_batch_flush(AggState *aggstate);
 static void process_ordered_aggregate_single(AggState *aggstate,
 											 AggStatePerTrans pertrans,
 											 AggStatePerGroup pergroupstate);
@@ -431,8 +452,10 @@ static void initialize_hash_entry(AggState *aggstate,
 								  TupleHashTable hashtable,
 								  TupleHashEntry entry);
 static void lookup_hash_entries(AggState *aggstate);
+static void lookup_hash_entry_hashed(AggState *aggstate, uint32 hash);
 static TupleTableSlot *agg_retrieve_direct(AggState *aggstate);
 static void agg_fill_hash_table(AggState *aggstate);
+static void agg_fill_hash_table_batched(AggState *aggstate);
 static bool agg_refill_hash_table(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table(AggState *aggstate);
 static TupleTableSlot *agg_retrieve_hash_table_in_memory(AggState *aggstate);
@@ -850,6 +873,140 @@ advance_aggregates(AggState *aggstate)
 	ExecEvalExprSwitchContext(aggstate->phase->evaltrans,
 							  aggstate->tmpcontext,
 							  &dummynull);
+
+	if (aggstate->agg_batching)
+		agg_batch_load(aggstate);
+}
+
+/*
+ * Set up the transition states that have a batched transition function to
+ * be advanced a batch of input rows at a time, leaving them out of the
+ * phases' evaltrans.  That is done when every input row advances the same
+ * transition states, in plain and sorted aggregation without grouping sets,
+ * and for aggregates without FILTER, ORDER BY or DISTINCT.
+ */
+static void
+agg_batch_init(AggState *aggstate, Agg *node)
+{
+	if (!enable_batch_agg ||
+		(node->aggstrategy != AGG_PLAIN && node->aggstrategy != AGG_SORTED) ||
+		node->groupingSets != NIL ||
+		DO_AGGSPLIT_COMBINE(aggstate->aggsplit))
+		return;
+
+	for (int transno = 0; transno < aggstate->numtrans; transno++)
+	{
+		AggStatePerTrans pertrans = &aggstate->pertrans[transno];
+		AggBatchTransFunc batch_transfn;
+
+		if (pertrans->numSortCols > 0 || pertrans->aggref->aggfilter != NULL ||
+			pertrans->numTransInputs > 1)
+			continue;
+		batch_transfn = AggBatchTransFuncFor(pertrans->transfn_oid);
+		if (batch_transfn == NULL)
+			continue;
+
+		pertrans->batch_transfn = batch_transfn;
+		if (pertrans->numTransInputs == 1)
+		{
+			TargetEntry *tle = linitial_node(TargetEntry, pertrans->aggref->args);
+
+			pertrans->batch_argstate = ExecInitExpr(tle->expr,
+													&aggstate->ss.ps);
+			get_typlenbyval(exprType((Node *) tle->expr),
+							&pertrans->batch_argtypeLen,
+							&pertrans->batch_argtypeByVal);
+			pertrans->batch_values = palloc(sizeof(Datum) * AGG_BATCH_SIZE);
+			pertrans->batch_nulls = palloc(sizeof(bool) * AGG_BATCH_SIZE);
+		}
+		aggstate->agg_batching = true;
+	}
+
+	if (aggstate->agg_batching)
+		aggstate->agg_batch_context =
+			AllocSetContextCreate(CurrentMemoryContext,
+								  "AggBatch",
+								  ALLOCSET_DEFAULT_SIZES);
+}
+
+/*
+ * Add the inputs of the current input tuple to the batches, and advance the
+ * transition states by them once they are full.  A by-reference input is
+ * copied, as the batch outlives the tuple; count() only looks at its nulls.
+ */
+static void
+agg_batch_load(AggState *aggstate)
+{
+	ExprContext *tmpcontext = aggstate->tmpcontext;
+	int			row = aggstate->agg_batch_nrows;
+
+	for (int transno = 0; transno < aggstate->numtrans; transno++)
+	{
+		AggStatePerTrans pertrans = &aggstate->pertrans[transno];
+		Datum		value;
+		bool		isnull;
+
+		if (pertrans->batch_argstate == NULL)
+			continue;
+
+		value = ExecEvalExprSwitchContext(pertrans->batch_argstate,
+										  tmpcontext, &isnull);
+		if (!isnull && !pertrans->batch_argtypeByVal &&
+			pertrans->batch_transfn != int8inc_any_batch)
+		{
+			MemoryContext oldContext;
+
+			oldContext = MemoryContextSwitchTo(aggstate->agg_batch_context);
+			value = datumCopy(value, false, pertrans->batch_argtypeLen);
+			MemoryContextSwitchTo(oldContext);
+		}
+		pertrans->batch_values[row] = value;
+		pertrans->batch_nulls[row] = isnull;
+	}
+
+	if (++aggstate->agg_batch_nrows == AGG_BATCH_SIZE)
+		agg_batch_flush(aggstate);
+}
+
+/*
+ * Advance the batched transition states of the current group by the input
+ * rows collected so far.  Called when the batches are full, and before the
+ * group is finalized.
+ */
+static void
+agg_batch_flush(AggState *aggstate)
+{
+	AggStatePerGroup pergroup = aggstate->pergroups[0];
+	MemoryContext aggcontext = aggstate->aggcontexts[0]->ecxt_per_tuple_memory;
+	int			nrows = aggstate->agg_batch_nrows;
+	MemoryContext oldContext;
+
+	if (nrows == 0)
+		return;
+
+	/* the transition functions work in the per-input-tuple context */
+	oldContext = MemoryContextSwitchTo(aggstate->tmpcontext->ecxt_per_tuple_memory);
+	for (int transno = 0; transno < aggstate->numtrans; transno++)
+	{
+		AggStatePerTrans pertrans = &aggstate->pertrans[transno];
+		AggStatePerGroup pergroupstate = &pergroup[transno];
+
+		if (pertrans->batch_transfn == NULL)
+			continue;
+
+		pertrans->batch_transfn(&pergroupstate->transValue,
+								&pergroupstate->transValueIsNull,
+								pertrans->batch_values,
+								pertrans->batch_nulls,
+								nrows, aggcontext);
+		if (!pergroupstate->transValueIsNull)
+			pergroupstate->noTransValue = false;
+	}
+	MemoryContextSwitchTo(oldContext);
+	ResetExprContext(aggstate->tmpcontext);
+
+	aggstate->agg_batch_nrows = 0;
+	MemoryContextReset(aggstate->agg_batch_context);
 }
 
 /*
@@ -2133,6 +2290,47 @@ lookup_hash_entries(AggState *aggstate)
 	}
 }
 
+/*
+ * Like lookup_hash_entries, for an aggregate with a single hashed grouping
+ * set and the current tuple's hash already computed.
+ */
+static void
+lookup_hash_entry_hashed(AggState *aggstate, uint32 hash)
+{
+	AggStatePerHash perhash = &aggstate->perhash[0];
+	TupleHashTable hashtable = perhash->hashtable;
+	TupleTableSlot *outerslot = aggstate->tmpcontext->ecxt_outertuple;
+	TupleHashEntry entry;
+	bool		isnew = false;
+
+	Assert(aggstate->num_hashes == 1);
+
+	select_current_set(aggstate, 0, true);
+	prepare_hash_slot(perhash, outerslot, perhash->hashslot);
+	entry = LookupTupleHashEntryHash(hashtable, perhash->hashslot,
+									 aggstate->hash_spill_mode ? NULL : &isnew,
+									 hash);
+
+	if (entry != NULL)
+	{
+		if (isnew)
+			initialize_hash_entry(aggstate, hashtable, entry);
+		aggstate->hash_pergroup[0] = entry->additional;
+	}
+	else
+	{
+		HashAggSpill *spill = &aggstate->hash_spills[0];
+
+		if (spill->partitions == NULL)
+			hashagg_spill_init(spill, aggstate->hash_tapeinfo, 0,
+							   perhash->aggnode->numGroups,
+							   aggstate->hashentrysize);
+
+		hashagg_spill_tuple(aggstate, spill, outerslot, hash);
+		aggstate->hash_pergroup[0] = NULL;
+	}
+}
+
 /*
  * ExecAgg -
  *
@@ -2508,6 +2706,9 @@ agg_retrieve_direct(AggState *aggstate)
 
 		select_current_set(aggstate, currentSet, false);
 
+		if (aggstate->agg_batching)
+			agg_batch_flush(aggstate);
+
 		finalize_aggregates(aggstate,
 							peragg,
 							pergroups[currentSet]);
@@ -2534,6 +2735,12 @@ agg_fill_hash_table(AggState *aggstate)
 	TupleTableSlot *outerslot;
 	ExprContext *tmpcontext = aggstate->tmpcontext;
 
+	if (aggstate->hash_batch != NULL)
+	{
+		agg_fill_hash_table_batched(aggstate);
+		return;
+	}
+
 	/*
 	 * Process each outer-plan tuple, and then fetch the next one, until we
 	 * exhaust the outer plan.
@@ -2570,6 +2777,70 @@ agg_fill_hash_table(AggState *aggstate)
 						   &aggstate->perhash[0].hashiter);
 }
 
+/*
+ * agg_fill_hash_table with the input read HASHAGG_PREFETCH_BATCH tuples at a
+ * time, see there. The tuples are copied out of the outer plan's slot, so
+ * that the batch outlives the next fetch.
+ */
+static void
+agg_fill_hash_table_batched(AggState *aggstate)
+{
+	AggStatePerHash perhash = &aggstate->perhash[0];
+	TupleTableSlot **batch = aggstate->hash_batch;
+	ExprContext *tmpcontext = aggstate->tmpcontext;
+	uint32		hashes[HASHAGG_PREFETCH_BATCH];
+	bool		done = false;
+
+	while (!done)
+	{
+		int			n;
+		int			i;
+
+		for (n = 0; n < HASHAGG_PREFETCH_BATCH; n++)
+		{
+			TupleTableSlot *outerslot = fetch_input_tuple(aggstate);
+
+			if (TupIsNull(outerslot))
+			{
+				done = true;
+				break;
+			}
+			ExecCopySlot(batch[n], outerslot);
+
+			prepare_hash_slot(perhash, batch[n], perhash->hashslot);
+			hashes[n] = TupleHashTableHash(perhash->hashtable, perhash->hashslot);
+			TupleHashTablePrefetch(perhash->hashtable, hashes[n]);
+		}
+
+		for (i = 0; i < n; i++)
+		{
+			/* set up for lookup_hash_entry_hashed and advance_aggregates */
+			tmpcontext->ecxt_outertuple = batch[i];
+
+			/* Find or build the hashtable entry */
+			lookup_hash_entry_hashed(aggstate, hashes[i]);
+
+			/* Advance the aggregates (or combine functions) */
+			advance_aggregates(aggstate);
+
+			/* Reset per-input-tuple context after each tuple */
+			ResetExprContext(tmpcontext);
+		}
+	}
+
+	for (int i = 0; i < HASHAGG_PREFETCH_BATCH; i++)
+		ExecClearTuple(batch[i]);
+
+	/* finalize spills, if any */
+	hashagg_finish_initial_spills(aggstate);
+
+	aggstate->table_filled = true;
+	/* Initialize to walk the first hash table */
+	select_current_set(aggstate, 0, true);
+	ResetTupleHashIterator(aggstate->perhash[0].hashtable,
+						   &aggstate->perhash[0].hashiter);
+}
+
 /*
  * If any data was spilled during hash aggregation, reset the hash table and
  * reprocess one batch of spilled data. After reprocessing a batch, the hash
@@ -3668,6 +3939,22 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 		build_hash_tables(aggstate);
 		aggstate->table_filled = false;
 
+		/*
+		 * Plain hash aggregation into a large table fills it in batches. The
+		 * batch slots are of the outer plan's type, for the compiled
+		 * expressions that assume it.
+		 */
+		if (node->aggstrategy == AGG_HASHED && aggstate->num_hashes == 1 &&
+			aggstate->perhash[0].aggnode->numGroups * aggstate->hashentrysize >=
+			HASHAGG_PREFETCH_MIN_SIZE)
+		{
+			aggstate->hash_batch = palloc(sizeof(TupleTableSlot *) * HASHAGG_PREFETCH_BATCH);
+			for (i = 0; i < HASHAGG_PREFETCH_BATCH; i++)
+				aggstate->hash_batch[i] =
+					ExecInitExtraTupleSlot(estate, scanDesc,
+										   aggstate->ss.ps.outerops);
+		}
+
 		/* Initialize this to 1, meaning nothing spilled, yet */
 		aggstate->hash_batches_used = 1;
 	}
@@ -4025,6 +4312,8 @@ ExecInitAgg(Agg *node, EState *estate, int eflags)
 				(errcode(ERRCODE_GROUPING_ERROR),
 				 errmsg("aggregate function calls cannot be nested")));
 
+	agg_batch_init(aggstate, node);
+
 	/*
 	 * Build expressions doing all the transition work at once. We build a
 	 * different one for each phase, as the number of transition function
@@ -4667,6 +4956,13 @@ ExecReScanAgg(AggState *node)
 		}
 	}
 
+	/* Drop the input rows of batched transition states not yet aggregated */
+	if (node->agg_batching)
+	{
+		node->agg_batch_nrows = 0;
+		MemoryContextReset(node->agg_batch_context);
+	}
+
 	/* Make sure we have closed any open tuplesorts */
 	for (transno = 0; transno < node->numtrans; transno++)
 	{
@@ -52,13 +52,18 @@
 #include "utils/snapmgr.h"
 #include "utils/spccache.h"
 
+extern int	IsRpcClient;
+
 static TupleTableSlot *BitmapHeapNext(BitmapHeapScanState *node);
 static inline void BitmapDoneInitializingSharedState(ParallelBitmapHeapState *pstate);
 static inline void BitmapAdjustPrefetchIterator(BitmapHeapScanState *node,
 												TBMIterateResult *tbmres);
 static inline void BitmapAdjustPrefetchTarget(BitmapHeapScanState *node);
+static BlockNumber BitmapStreamNext(void *callback_arg);
 static inline void BitmapPrefetch(BitmapHeapScanState *node,
 								  TableScanDesc scan);
+static void BitmapPrefetchBatch(BitmapHeapScanState *node,
+								TableScanDesc scan);
 static bool BitmapShouldInitializeSharedState(ParallelBitmapHeapState *pstate);
 
 
@@ -119,8 +124,25 @@ BitmapHeapNext(BitmapHeapScanState *node)
 			node->tbmiterator = tbmiterator = tbm_begin_iterate(tbm);
 			node->tbmres = tbmres = NULL;
 
+			/*
+			 * On a compute node, the pages to fetch are named to a read
+			 * stream by an iterator of their own, so that they can be read
+			 * in batches.  That takes the place of prefetching.
+			 */
+			if (scan->rs_read_stream == NULL)
+				scan->rs_read_stream = ReadStreamBegin(node->ss.ss_currentRelation,
+													   MAIN_FORKNUM,
+													   BitmapStreamNext,
+													   node);
+			if (scan->rs_read_stream != NULL)
+			{
+				node->stream_iterator = tbm_begin_iterate(tbm);
+				node->stream_nblocks =
+					RelationGetNumberOfBlocks(node->ss.ss_currentRelation);
+			}
+
 #ifdef USE_PREFETCH
-			if (node->prefetch_maximum > 0)
+			if (node->prefetch_maximum > 0 && scan->rs_read_stream == NULL)
 			{
 				node->prefetch_iterator = tbm_begin_iterate(tbm);
 				node->prefetch_pages = 0;
@@ -457,6 +479,40 @@ BitmapAdjustPrefetchTarget(BitmapHeapScanState *node)
 #endif							/* USE_PREFETCH */
 }
 
+/*
+ * BitmapStreamNext - Name the next page BitmapHeapNext will fetch
+ *
+ * Pages that will be skipped, as in BitmapHeapNext, or that are past the end
+ * of the relation are left out.
+ */
+static BlockNumber
+BitmapStreamNext(void *callback_arg)
+{
+	BitmapHeapScanState *node = (BitmapHeapScanState *) callback_arg;
+	TBMIterateResult *tbmres;
+
+	if (node->stream_iterator == NULL)
+		return InvalidBlockNumber;
+
+	while ((tbmres = tbm_iterate(node->stream_iterator)) != NULL)
+	{
+		bool		skip_fetch;
+
+		if (tbmres->blockno >= node->stream_nblocks)
+			continue;
+
+		skip_fetch = (node->can_skip_fetch &&
+					  !tbmres->recheck &&
+					  VM_ALL_VISIBLE(node->ss.ss_currentRelation,
+									 tbmres->blockno,
+									 &node->pvmbuffer));
+		if (!skip_fetch)
+			return tbmres->blockno;
+	}
+
+	return InvalidBlockNumber;
+}
+
 /*
  * BitmapPrefetch - Prefetch, if prefetch_pages are behind prefetch_target
  */
@@ -511,6 +567,12 @@ BitmapPrefetch(BitmapHeapScanState *node, TableScanDesc scan)
 		return;
 	}
 
+	if (IsRpcClient)
+	{
+		BitmapPrefetchBatch(node, scan);
+		return;
+	}
+
 	if (pstate->prefetch_pages < pstate->prefetch_target)
 	{
 		TBMSharedIterator *prefetch_iterator = node->shared_prefetch_iterator;
@@ -562,6 +624,64 @@ BitmapPrefetch(BitmapHeapScanState *node, TableScanDesc scan)
 #endif							/* USE_PREFETCH */
 }
 
+/*
+ * BitmapPrefetchBatch - BitmapPrefetch of a parallel scan on a compute node
+ *
+ * The workers share the prefetch iterator, so no read stream can name the
+ * pages one of them fetches.  Instead a worker takes the pages it is to
+ * prefetch off the shared iterator a batch at a time, once the prefetch
+ * target is that far ahead, and fetches them with one PrefetchBufferBlocks
+ * call.
+ */
+static void
+BitmapPrefetchBatch(BitmapHeapScanState *node, TableScanDesc scan)
+{
+#ifdef USE_PREFETCH
+	ParallelBitmapHeapState *pstate = node->pstate;
+	TBMSharedIterator *prefetch_iterator = node->shared_prefetch_iterator;
+	BlockNumber blocks[RPC_READ_BATCH_SIZE];
+	int			nblocks = 0;
+	int			npages;
+	int			i;
+
+	if (prefetch_iterator == NULL)
+		return;
+
+	SpinLockAcquire(&pstate->mutex);
+	npages = pstate->prefetch_target - pstate->prefetch_pages;
+	if (npages < Min(pstate->prefetch_target, RPC_READ_BATCH_SIZE))
+		npages = 0;
+	npages = Min(npages, RPC_READ_BATCH_SIZE);
+	pstate->prefetch_pages += npages;
+	SpinLockRelease(&pstate->mutex);
+
+	for (i = 0; i < npages; i++)
+	{
+		TBMIterateResult *tbmpre = tbm_shared_iterate(prefetch_iterator);
+
+		if (tbmpre == NULL)
+		{
+			/* No more pages to prefetch */
+			tbm_end_shared_iterate(prefetch_iterator);
+			node->shared_prefetch_iterator = NULL;
+			break;
+		}
+
+		/* As in BitmapPrefetch, skip pages we expect not to need */
+		if (node->can_skip_fetch &&
+			(node->tbmres ? !node->tbmres->recheck : false) &&
+			VM_ALL_VISIBLE(node->ss.ss_currentRelation,
+						   tbmpre->blockno,
+						   &node->pvmbuffer))
+			continue;
+		blocks[nblocks++] = tbmpre->blockno;
+	}
+
+	if (nblocks > 0)
+		PrefetchBufferBlocks(scan->rs_rd, MAIN_FORKNUM, blocks, nblocks);
+#endif							/* USE_PREFETCH */
+}
+
 /*
  * BitmapHeapRecheck -- access method routine to recheck a tuple in EvalPlanQual
  */
@@ -615,12 +735,16 @@ ExecReScanBitmapHeapScan(BitmapHeapScanState *node)
 		tbm_end_shared_iterate(node->shared_tbmiterator);
 	if (node->shared_prefetch_iterator)
 		tbm_end_shared_iterate(node->shared_prefetch_iterator);
+	if (node->stream_iterator)
+		tbm_end_iterate(node->stream_iterator);
 	if (node->tbm)
 		tbm_free(node->tbm);
 	if (node->vmbuffer != InvalidBuffer)
 		ReleaseBuffer(node->vmbuffer);
 	if (node->pvmbuffer != InvalidBuffer)
 		ReleaseBuffer(node->pvmbuffer);
+	if (node->ss.ss_currentScanDesc->rs_read_stream != NULL)
+		ReadStreamReset(node->ss.ss_currentScanDesc->rs_read_stream);
 	node->tbm = NULL;
 	node->tbmiterator = NULL;
 	node->tbmres = NULL;
@@ -628,6 +752,7 @@ ExecReScanBitmapHeapScan(BitmapHeapScanState *node)
 	node->initialized = false;
 	node->shared_tbmiterator = NULL;
 	node->shared_prefetch_iterator = NULL;
+	node->stream_iterator = NULL;
 	node->vmbuffer = InvalidBuffer;
 	node->pvmbuffer = InvalidBuffer;
 
@@ -685,10 +810,14 @@ ExecEndBitmapHeapScan(BitmapHeapScanState *node)
 		tbm_end_shared_iterate(node->shared_tbmiterator);
 	if (node->shared_prefetch_iterator)
 		tbm_end_shared_iterate(node->shared_prefetch_iterator);
+	if (node->stream_iterator)
+		tbm_end_iterate(node->stream_iterator);
 	if (node->vmbuffer != InvalidBuffer)
 		ReleaseBuffer(node->vmbuffer);
 	if (node->pvmbuffer != InvalidBuffer)
 		ReleaseBuffer(node->pvmbuffer);
+	if (scanDesc->rs_read_stream != NULL)
+		ReadStreamEnd(scanDesc->rs_read_stream);
 
 	/*
 	 * close heap scan
@@ -741,6 +870,8 @@ ExecInitBitmapHeapScan(BitmapHeapScan *node, EState *estate, int eflags)
 	scanstate->shared_tbmiterator = NULL;
 	scanstate->shared_prefetch_iterator = NULL;
 	scanstate->pstate = NULL;
+	scanstate->stream_iterator = NULL;
+	scanstate->stream_nblocks = InvalidBlockNumber;
 
 	/*
 	 * We can potentially skip fetching heap pages if we do not need any
@@ -797,6 +928,14 @@ ExecInitBitmapHeapScan(BitmapHeapScan *node, EState *estate, int eflags)
 	scanstate->prefetch_maximum =
 		get_tablespace_io_concurrency(currentRelation->rd_rel->reltablespace);
 
+	/*
+	 * A compute node prefetches the pages of a parallel scan in batches, see
+	 * BitmapPrefetchBatch; keep up to two of them ahead.
+	 */
+	if (IsRpcClient && scanstate->prefetch_maximum > 0)
+		scanstate->prefetch_maximum = Max(scanstate->prefetch_maximum,
+										  2 * RPC_READ_BATCH_SIZE);
+
 	scanstate->ss.ss_currentRelation = currentRelation;
 
 	scanstate->ss.ss_currentScanDesc = table_beginscan_bm(currentRelation,
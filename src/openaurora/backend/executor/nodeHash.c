@@ -34,6 +34,7 @@
 #include "executor/hashjoin.h"
 #include "executor/nodeHash.h"
 #include "executor/nodeHashjoin.h"
+#include "lib/bloomfilter.h"
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "port/atomics.h"
@@ -174,6 +175,9 @@ MultiExecPrivateHash(HashState *node)
 		{
 			int			bucketNumber;
 
+			if (hashtable->bloom != NULL)
+				bloom_add_element(hashtable->bloom, (unsigned char *) &hashvalue,
+								  sizeof(hashvalue));
 			bucketNumber = ExecHashGetSkewBucket(hashtable, hashvalue);
 			if (bucketNumber != INVALID_SKEW_BUCKET_NO)
 			{
@@ -509,10 +513,12 @@ ExecHashTableCreate(HashState *state, List *hashOperators, List *hashCollations,
 	hashtable->spaceAllowedSkew =
 		hashtable->spaceAllowed * SKEW_HASH_MEM_PERCENT / 100;
 	hashtable->chunks = NULL;
+	hashtable->unusedChunks = NULL;
 	hashtable->current_chunk = NULL;
 	hashtable->parallel_state = state->parallel_state;
 	hashtable->area = state->ps.state->es_query_dsa;
 	hashtable->batches = NULL;
+	hashtable->bloom = NULL;
 
 #ifdef HJDEBUG
 	printf("Hashjoin %p: initial nbatch = %d, nbuckets = %d\n",
@@ -531,6 +537,10 @@ ExecHashTableCreate(HashState *state, List *hashOperators, List *hashCollations,
 												"HashBatchContext",
 												ALLOCSET_DEFAULT_SIZES);
 
+	hashtable->tupleCxt = BumpContextCreate(hashtable->hashCxt,
+											"HashTupleContext",
+											ALLOCSET_DEFAULT_SIZES);
+
 	/* Allocate data that will live for the life of the hashjoin */
 
 	oldcxt = MemoryContextSwitchTo(hashtable->hashCxt);
@@ -578,6 +588,15 @@ ExecHashTableCreate(HashState *state, List *hashOperators, List *hashCollations,
 		PrepareTempTablespaces();
 	}
 
+	/*
+	 * The bloom filter takes the planner's estimate of the inner rows; it
+	 * only gets less selective if the estimate is low.  It isn't counted in
+	 * spaceUsed, work_mem caps it separately.
+	 */
+	if (state->build_bloom && hashtable->parallel_state == NULL)
+		hashtable->bloom = bloom_create(Max((int64) state->ps.plan->plan_rows, 1),
+										work_mem, 0);
+
 	MemoryContextSwitchTo(oldcxt);
 
 	if (hashtable->parallel_state)
@@ -892,7 +911,10 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 	MemoryContext oldcxt;
 	long		ninmemory;
 	long		nfreed;
-	HashMemoryChunk oldchunks;
+	HashMemoryChunk chunk;
+	HashMemoryChunk nextchunk;
+	HashMemoryChunk dstchunk;
+	HashMemoryChunk dstprev = NULL;
 
 	/* do nothing if we've decided to shut off growth */
 	if (!hashtable->growEnabled)
@@ -962,25 +984,33 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 	/*
 	 * We will scan through the chunks directly, so that we can reset the
 	 * buckets now and not have to keep track which tuples in the buckets have
-	 * already been processed. We will free the old chunks as we go.
+	 * already been processed.  The chunks are in a bump context and can't be
+	 * freed one at a time, so instead the tuples we keep are moved down over
+	 * the ones dumped, within the same chunks, and the chunks that end up
+	 * empty are set aside for dense_alloc() to reuse.
 	 */
 	memset(hashtable->buckets.unshared, 0,
 		   sizeof(HashJoinTuple) * hashtable->nbuckets);
-	oldchunks = hashtable->chunks;
-	hashtable->chunks = NULL;
+	dstchunk = hashtable->chunks;
 
-	/* so, let's scan through the old chunks, and all tuples in each chunk */
-	while (oldchunks != NULL)
+	/* so, let's scan through the chunks, and all tuples in each chunk */
+	for (chunk = hashtable->chunks; chunk != NULL; chunk = chunk->next.unshared)
 	{
-		HashMemoryChunk nextchunk = oldchunks->next.unshared;
-
-		/* position within the buffer (up to oldchunks->used) */
+		/* position within the buffer (up to used) */
 		size_t		idx = 0;
+		size_t		used = chunk->used;
+
+		/*
+		 * The tuples kept are only ever moved to this chunk or one before it,
+		 * never past the tuple read, so it can be refilled from the start.
+		 */
+		chunk->used = 0;
+		chunk->ntuples = 0;
 
-		/* process all tuples stored in this chunk (and then free it) */
-		while (idx < oldchunks->used)
+		/* process all tuples stored in this chunk */
+		while (idx < used)
 		{
-			HashJoinTuple hashTuple = (HashJoinTuple) (HASH_CHUNK_DATA(oldchunks) + idx);
+			HashJoinTuple hashTuple = (HashJoinTuple) (HASH_CHUNK_DATA(chunk) + idx);
 			MinimalTuple tuple = HJTUPLE_MINTUPLE(hashTuple);
 			int			hashTupleSize = (HJTUPLE_OVERHEAD + tuple->t_len);
 			int			bucketno;
@@ -992,11 +1022,18 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 
 			if (batchno == curbatch)
 			{
-				/* keep tuple in memory - copy it into the new chunk */
+				/* keep tuple in memory - move it down to the first room */
 				HashJoinTuple copyTuple;
 
-				copyTuple = (HashJoinTuple) dense_alloc(hashtable, hashTupleSize);
-				memcpy(copyTuple, hashTuple, hashTupleSize);
+				while (dstchunk->maxlen - dstchunk->used < MAXALIGN(hashTupleSize))
+				{
+					dstprev = dstchunk;
+					dstchunk = dstchunk->next.unshared;
+				}
+				copyTuple = (HashJoinTuple) (HASH_CHUNK_DATA(dstchunk) + dstchunk->used);
+				memmove(copyTuple, hashTuple, hashTupleSize);
+				dstchunk->used += MAXALIGN(hashTupleSize);
+				dstchunk->ntuples++;
 
 				/* and add it back to the appropriate bucket */
 				copyTuple->next.unshared = hashtable->buckets.unshared[bucketno];
@@ -1020,10 +1057,35 @@ ExecHashIncreaseNumBatches(HashJoinTable hashtable)
 			/* allow this loop to be cancellable */
 			CHECK_FOR_INTERRUPTS();
 		}
+	}
+
+	/*
+	 * Put the chunk the last tuple kept went to first, where dense_alloc()
+	 * looks for room, followed by the full ones before it.  The empty chunks
+	 * after it are set aside, but for those of oversized tuples too small to
+	 * take regular ones, which are only freed with the rest of the batch.
+	 */
+	if (dstchunk != NULL)
+	{
+		chunk = dstchunk->next.unshared;
+		if (dstprev != NULL)
+		{
+			dstprev->next.unshared = NULL;
+			dstchunk->next.unshared = hashtable->chunks;
+		}
+		else
+			dstchunk->next.unshared = NULL;
+		hashtable->chunks = dstchunk;
 
-		/* we're done with this chunk - free it and proceed to the next one */
-		pfree(oldchunks);
-		oldchunks = nextchunk;
+		for (; chunk != NULL; chunk = nextchunk)
+		{
+			nextchunk = chunk->next.unshared;
+			if (chunk->maxlen >= HASH_CHUNK_SIZE)
+			{
+				chunk->next.unshared = hashtable->unusedChunks;
+				hashtable->unusedChunks = chunk;
+			}
+		}
 	}
 
 #ifdef HJDEBUG
@@ -1454,8 +1516,7 @@ ExecHashIncreaseNumBuckets(HashJoinTable hashtable)
 	/*
 	 * Just reallocate the proper number of buckets - we don't need to walk
 	 * through them - we can walk the dense-allocated chunks (just like in
-	 * ExecHashIncreaseNumBatches, but without all the copying into new
-	 * chunks)
+	 * ExecHashIncreaseNumBatches, but without moving the tuples)
 	 */
 	hashtable->buckets.unshared =
 		(HashJoinTuple *) repalloc(hashtable->buckets.unshared,
@@ -2148,6 +2209,7 @@ ExecHashTableReset(HashJoinTable hashtable)
 	 * reinitialize the context for a new pass.
 	 */
 	MemoryContextReset(hashtable->batchCxt);
+	MemoryContextReset(hashtable->tupleCxt);
 	oldcxt = MemoryContextSwitchTo(hashtable->batchCxt);
 
 	/* Reallocate and reinitialize the hash bucket headers. */
@@ -2160,6 +2222,7 @@ ExecHashTableReset(HashJoinTable hashtable)
 
 	/* Forget the chunks (the memory was freed by the context reset above). */
 	hashtable->chunks = NULL;
+	hashtable->unusedChunks = NULL;
 }
 
 /*
@@ -2721,7 +2784,7 @@ dense_alloc(HashJoinTable hashtable, Size size)
 	if (size > HASH_CHUNK_THRESHOLD)
 	{
 		/* allocate new chunk and put it at the beginning of the list */
-		newChunk = (HashMemoryChunk) MemoryContextAlloc(hashtable->batchCxt,
+		newChunk = (HashMemoryChunk) MemoryContextAlloc(hashtable->tupleCxt,
 														HASH_CHUNK_HEADER_SIZE + size);
 		newChunk->maxlen = size;
 		newChunk->used = size;
@@ -2752,11 +2815,21 @@ dense_alloc(HashJoinTable hashtable, Size size)
 	if ((hashtable->chunks == NULL) ||
 		(hashtable->chunks->maxlen - hashtable->chunks->used) < size)
 	{
-		/* allocate new chunk and put it at the beginning of the list */
-		newChunk = (HashMemoryChunk) MemoryContextAlloc(hashtable->batchCxt,
-														HASH_CHUNK_HEADER_SIZE + HASH_CHUNK_SIZE);
-
-		newChunk->maxlen = HASH_CHUNK_SIZE;
+		/*
+		 * Reuse a chunk ExecHashIncreaseNumBatches() emptied, else allocate
+		 * a new one, and put it at the beginning of the list
+		 */
+		if (hashtable->unusedChunks != NULL)
+		{
+			newChunk = hashtable->unusedChunks;
+			hashtable->unusedChunks = newChunk->next.unshared;
+		}
+		else
+		{
+			newChunk = (HashMemoryChunk) MemoryContextAlloc(hashtable->tupleCxt,
+															HASH_CHUNK_HEADER_SIZE + HASH_CHUNK_SIZE);
+			newChunk->maxlen = HASH_CHUNK_SIZE;
+		}
 		newChunk->used = size;
 		newChunk->ntuples = 1;
 
@@ -112,6 +112,7 @@
 #include "executor/hashjoin.h"
 #include "executor/nodeHash.h"
 #include "executor/nodeHashjoin.h"
+#include "lib/bloomfilter.h"
 #include "miscadmin.h"
 #include "pgstat.h"
 #include "utils/memutils.h"
@@ -133,6 +134,11 @@
 /* Returns true if doing null-fill on inner relation */
 #define HJ_FILL_INNER(hjstate)	((hjstate)->hj_NullOuterTupleSlot != NULL)
 
+/* A bloom filter with more of its bits set passes too much to be worth it */
+#define HJ_BLOOM_MAX_FILL		0.5
+
+bool		enable_hashjoin_bloom = true;
+
 static TupleTableSlot *ExecHashJoinOuterGetTuple(PlanState *outerNode,
 												 HashJoinState *hjstate,
 												 uint32 *hashvalue);
@@ -146,6 +152,8 @@ static TupleTableSlot *ExecHashJoinGetSavedTuple(HashJoinState *hjstate,
 static bool ExecHashJoinNewBatch(HashJoinState *hjstate);
 static bool ExecParallelHashJoinNewBatch(HashJoinState *hjstate);
 static void ExecParallelHashJoinPartitionOuter(HashJoinState *node);
+static void ExecHashJoinPushBloom(HashJoinState *hjstate);
+static void ExecHashJoinRemoveBloom(HashJoinState *hjstate);
 
 
 /* ----------------------------------------------------------------
@@ -289,6 +297,8 @@ ExecHashJoinImpl(PlanState *pstate, bool parallel)
 				 */
 				hashNode->hashtable = hashtable;
 				(void) MultiExecProcNode((PlanState *) hashNode);
+				if (hashtable->bloom != NULL)
+					ExecHashJoinPushBloom(node);
 
 				/*
 				 * If the inner relation is completely empty, and we're not
@@ -752,6 +762,30 @@ ExecInitHashJoin(HashJoin *node, EState *estate, int eflags)
 	hjstate->hj_MatchedOuter = false;
 	hjstate->hj_OuterNotEmpty = false;
 
+	/*
+	 * Outer tuples without a match are discarded unless we null-fill them,
+	 * so the outer scan can drop those whose hash value no inner tuple has.
+	 * That is only worth a check per outer tuple with more of them than
+	 * inner ones.
+	 */
+	if (enable_hashjoin_bloom && !HJ_FILL_OUTER(hjstate) &&
+		outerNode->plan_rows > hashNode->plan.plan_rows)
+	{
+		switch (nodeTag(outerPlanState(hjstate)))
+		{
+			case T_SeqScanState:
+			case T_IndexScanState:
+			case T_IndexOnlyScanState:
+			case T_BitmapHeapScanState:
+			case T_CustomScanState:
+				castNode(HashState, innerPlanState(hjstate))->build_bloom = true;
+				hjstate->hj_BloomContext = CreateExprContext(estate);
+				break;
+			default:
+				break;
+		}
+	}
+
 	return hjstate;
 }
 
@@ -1203,6 +1237,61 @@ ExecParallelHashJoinNewBatch(HashJoinState *hjstate)
 	return false;
 }
 
+/*
+ * ExecHashJoinPushBloom
+ *		hand the bloom filter of the hash table just built to the outer scan
+ *
+ * Outer tuples fetched before, to see whether the outer relation is empty,
+ * didn't go through it; the join still checks every tuple itself.
+ */
+static void
+ExecHashJoinPushBloom(HashJoinState *hjstate)
+{
+	ScanState  *outer = (ScanState *) outerPlanState(hjstate);
+
+	if (bloom_prop_bits_set(hjstate->hj_HashTable->bloom) > HJ_BLOOM_MAX_FILL)
+		return;
+	outer->ss_HashFilter = hjstate;
+}
+
+/*
+ * ExecHashJoinRemoveBloom
+ *		stop the outer scan from using the bloom filter of the hash table
+ */
+static void
+ExecHashJoinRemoveBloom(HashJoinState *hjstate)
+{
+	ScanState  *outer = (ScanState *) outerPlanState(hjstate);
+
+	if (hjstate->hj_BloomContext != NULL && outer->ss_HashFilter == hjstate)
+		outer->ss_HashFilter = NULL;
+}
+
+/*
+ * ExecHashJoinOuterMayMatch
+ *		whether a tuple of the outer scan may have a match in the hash table
+ *
+ * slot is one the outer plan returned.  False means it can't, it has a null
+ * key or a hash value no inner tuple has: the join would discard it.
+ */
+bool
+ExecHashJoinOuterMayMatch(HashJoinState *hjstate, TupleTableSlot *slot)
+{
+	ExprContext *econtext = hjstate->hj_BloomContext;
+	uint32		hashvalue;
+
+	ResetExprContext(econtext);
+	econtext->ecxt_outertuple = slot;
+	if (!ExecHashGetHashValue(hjstate->hj_HashTable, econtext,
+							  hjstate->hj_OuterHashKeys,
+							  true,	/* outer tuple */
+							  false,
+							  &hashvalue))
+		return false;
+	return !bloom_lacks_element(hjstate->hj_HashTable->bloom,
+								(unsigned char *) &hashvalue, sizeof(hashvalue));
+}
+
 /*
  * ExecHashJoinSaveTuple
  *		save a tuple to a batch file.
@@ -1342,6 +1431,7 @@ ExecReScanHashJoin(HashJoinState *node)
 			/* for safety, be sure to clear child plan node's pointer too */
 			hashNode->hashtable = NULL;
 
+			ExecHashJoinRemoveBloom(node);
 			ExecHashTableDestroy(node->hj_HashTable);
 			node->hj_HashTable = NULL;
 			node->hj_JoinState = HJ_BUILD_HASHTABLE;
@@ -38,11 +38,15 @@
 #include "lib/pairingheap.h"
 #include "miscadmin.h"
 #include "nodes/nodeFuncs.h"
+#include "storage/bufmgr.h"
 #include "utils/array.h"
 #include "utils/datum.h"
 #include "utils/lsyscache.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
+#include "utils/snapmgr.h"
+
+extern int	IsRpcClient;
 
 /*
  * When an ordering operator is used, tuples fetched from the index that
@@ -69,6 +73,48 @@ static void reorderqueue_push(IndexScanState *node, TupleTableSlot *slot,
 							  Datum *orderbyvals, bool *orderbynulls);
 static HeapTuple reorderqueue_pop(IndexScanState *node);
 
+/*
+ * Every heap page a plain index scan misses on is a round trip to the
+ * storage node, though the index would already tell the TIDs to come.  On a
+ * compute node the scan reads up to rpc_index_prefetch_distance TIDs ahead
+ * into an IndexPrefetchQueue.  Once it gets to a TID whose page wasn't
+ * looked at yet, the pages of the queued TIDs are fetched together, see
+ * PrefetchBufferBlocks().  The tuples still come in index order, from the
+ * queue.
+ *
+ * The index AM can't be told to kill the entries of dead tuples then, its
+ * current entry is another one.  Only forward-only MVCC scans without
+ * ORDER BY operators read ahead: they return at most one tuple per TID,
+ * and the AM doesn't keep the heap page pinned for them.
+ */
+#define INDEX_PREFETCH_MAX_DISTANCE 256
+
+typedef struct IndexPrefetchEntry
+{
+	ItemPointerData tid;
+	bool		recheck;		/* xs_recheck of the TID */
+	bool		checked;		/* its heap page was looked at */
+} IndexPrefetchEntry;
+
+typedef struct IndexPrefetchQueue
+{
+	int			distance;		/* size of entries */
+	int			head;
+	int			count;
+	bool		exhausted;		/* the index has no more TIDs */
+	IndexPrefetchEntry entries[FLEXIBLE_ARRAY_MEMBER];
+} IndexPrefetchQueue;
+
+#define IndexPrefetchEntryAt(queue, i) \
+	(&(queue)->entries[((queue)->head + (i)) % (queue)->distance])
+
+/* GUC: TIDs an index scan reads ahead on a compute node, 0 turns it off */
+int			rpc_index_prefetch_distance = 32;
+
+static bool IndexNextPrefetch(IndexScanState *node, ScanDirection direction,
+							  TupleTableSlot *slot);
+static void IndexPrefetchPages(IndexScanState *node);
+
 
 /* ----------------------------------------------------------------
  *		IndexNext
@@ -130,7 +176,9 @@ IndexNext(IndexScanState *node)
 	/*
 	 * ok, now that we have what we need, fetch the next tuple.
 	 */
-	while (index_getnext_slot(scandesc, direction, slot))
+	while (node->iss_Prefetch != NULL ?
+		   IndexNextPrefetch(node, direction, slot) :
+		   index_getnext_slot(scandesc, direction, slot))
 	{
 		CHECK_FOR_INTERRUPTS();
 
@@ -160,6 +208,98 @@ IndexNext(IndexScanState *node)
 	return ExecClearTuple(slot);
 }
 
+/*
+ * IndexNextPrefetch
+ *		index_getnext_slot() through the scan's IndexPrefetchQueue
+ */
+static bool
+IndexNextPrefetch(IndexScanState *node, ScanDirection direction,
+				  TupleTableSlot *slot)
+{
+	IndexPrefetchQueue *queue = node->iss_Prefetch;
+	IndexScanDesc scandesc = node->iss_ScanDesc;
+
+	for (;;)
+	{
+		IndexPrefetchEntry *entry;
+
+		while (!queue->exhausted && queue->count < queue->distance)
+		{
+			ItemPointer tid;
+
+			/* The fetch was for a TID other than the AM's current one */
+			scandesc->kill_prior_tuple = false;
+			tid = index_getnext_tid(scandesc, direction);
+			if (tid == NULL)
+			{
+				queue->exhausted = true;
+				break;
+			}
+			entry = IndexPrefetchEntryAt(queue, queue->count);
+			entry->tid = *tid;
+			entry->recheck = scandesc->xs_recheck;
+			entry->checked = false;
+			queue->count++;
+		}
+		if (queue->count == 0)
+			return false;
+
+		entry = IndexPrefetchEntryAt(queue, 0);
+		if (!entry->checked)
+			IndexPrefetchPages(node);
+
+		scandesc->xs_heaptid = entry->tid;
+		scandesc->xs_recheck = entry->recheck;
+		queue->head = (queue->head + 1) % queue->distance;
+		queue->count--;
+
+		if (index_fetch_heap(scandesc, slot))
+			return true;
+	}
+}
+
+/*
+ * IndexPrefetchPages
+ *		Fetch the heap pages of the queued TIDs not looked at yet
+ */
+static void
+IndexPrefetchPages(IndexScanState *node)
+{
+	IndexPrefetchQueue *queue = node->iss_Prefetch;
+	BlockNumber blocks[INDEX_PREFETCH_MAX_DISTANCE];
+	int			nblocks = 0;
+	int			nlooked;
+	int			i;
+	int			j;
+
+	for (i = 0; i < queue->count; i++)
+	{
+		IndexPrefetchEntry *entry = IndexPrefetchEntryAt(queue, i);
+		BlockNumber block = ItemPointerGetBlockNumber(&entry->tid);
+
+		if (entry->checked)
+			continue;
+		for (j = 0; j < nblocks; j++)
+			if (blocks[j] == block)
+				break;
+		if (j == nblocks)
+			blocks[nblocks++] = block;
+	}
+
+	nlooked = PrefetchBufferBlocks(node->ss.ss_currentRelation, MAIN_FORKNUM,
+								   blocks, nblocks);
+
+	for (i = 0; i < queue->count; i++)
+	{
+		IndexPrefetchEntry *entry = IndexPrefetchEntryAt(queue, i);
+		BlockNumber block = ItemPointerGetBlockNumber(&entry->tid);
+
+		for (j = 0; j < nlooked && !entry->checked; j++)
+			if (blocks[j] == block)
+				entry->checked = true;
+	}
+}
+
 /* ----------------------------------------------------------------
  *		IndexNextWithReorder
  *
@@ -585,6 +725,14 @@ ExecReScanIndexScan(IndexScanState *node)
 					 node->iss_OrderByKeys, node->iss_NumOrderByKeys);
 	node->iss_ReachedEnd = false;
 
+	/* forget the TIDs read ahead */
+	if (node->iss_Prefetch)
+	{
+		node->iss_Prefetch->head = 0;
+		node->iss_Prefetch->count = 0;
+		node->iss_Prefetch->exhausted = false;
+	}
+
 	ExecScanReScan(&node->ss);
 }
 
@@ -1079,6 +1227,26 @@ ExecInitIndexScan(IndexScan *node, EState *estate, int eflags)
 		indexstate->iss_RuntimeContext = NULL;
 	}
 
+	/*
+	 * On a compute node, read TIDs ahead to fetch their heap pages together,
+	 * if the scan qualifies; see IndexNextPrefetch.
+	 */
+	if (IsRpcClient && rpc_index_prefetch_distance > 0 &&
+		indexstate->iss_NumOrderByKeys == 0 &&
+		(eflags & (EXEC_FLAG_BACKWARD | EXEC_FLAG_MARK)) == 0 &&
+		IsMVCCSnapshot(estate->es_snapshot) &&
+		currentRelation->rd_rel->relam == HEAP_TABLE_AM_OID &&
+		!RelationUsesLocalBuffers(currentRelation))
+	{
+		int			distance = Min(rpc_index_prefetch_distance,
+								   INDEX_PREFETCH_MAX_DISTANCE);
+
+		indexstate->iss_Prefetch = (IndexPrefetchQueue *)
+			palloc0(offsetof(IndexPrefetchQueue, entries) +
+					distance * sizeof(IndexPrefetchEntry));
+		indexstate->iss_Prefetch->distance = distance;
+	}
+
 	/*
 	 * all done.
 	 */
@@ -0,0 +1,1173 @@
+/*-------------------------------------------------------------------------
+ *
+ * nodeRpcScan.c
+ *	  Support routines for scans whose pages are filtered on the storage
+ *	  node.
+ *
+ * A sequential scan of a compute node pulls every page of the relation
+ * from the storage node, though with a selective qual most of them hold no
+ * row of the result.  When one of the scan's quals compares an integer or
+ * oid column to a constant, and is expected to keep fewer than
+ * rpc_scan_pushdown_selectivity of the rows, the planner offers an RpcScan
+ * custom path besides the SeqScan.  It sends the qual along with
+ * ScanRelation (see storage/rpc_scan.h) and gets back only the pages of a
+ * range of blocks whose tuples may satisfy it.  Those are loaded into
+ * shared buffers and scanned here as heapgetpage would; visibility and
+ * every qual of the plan are still checked on this side, the storage node
+ * knows nothing of snapshots or the commit log.
+ *
+ * An aggregate of such a relation without GROUP BY, and without a qual or
+ * with a single one the storage node can check, gets an RpcAgg path as well
+ * (see storage/rpc_agg.h): a custom scan returning one row of the partial
+ * aggregate states under a Finalize Aggregate.  The storage node adds the
+ * all-visible pages to the states, the others it names are added here.
+ *
+ * Portions Copyright (c) 1996-2020, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ *
+ * IDENTIFICATION
+ *	  src/backend/executor/nodeRpcScan.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include <math.h>
+
+#include "access/heapam.h"
+#include "access/relscan.h"
+#include "access/stratnum.h"
+#include "access/tableam.h"
+#include "access/xlog.h"
+#include "catalog/pg_aggregate.h"
+#include "catalog/pg_am.h"
+#include "catalog/pg_opfamily.h"
+#include "catalog/pg_type.h"
+#include "commands/explain.h"
+#include "executor/executor.h"
+#include "executor/nodeRpcScan.h"
+#include "miscadmin.h"
+#include "nodes/extensible.h"
+#include "nodes/makefuncs.h"
+#include "optimizer/clauses.h"
+#include "optimizer/cost.h"
+#include "optimizer/optimizer.h"
+#include "optimizer/pathnode.h"
+#include "optimizer/restrictinfo.h"
+#include "pgstat.h"
+#include "storage/bufmgr.h"
+#include "storage/predicate.h"
+#include "storage/rpc_agg.h"
+#include "storage/rpc_scan.h"
+#include "storage/rpcclient.h"
+#include "storage/shard_map.h"
+#include "utils/fmgroids.h"
+#include "utils/lsyscache.h"
+#include "utils/rel.h"
+#include "utils/spccache.h"
+#include "utils/syscache.h"
+
+extern int	IsRpcClient;
+
+/* GUC: highest selectivity of a qual still pushed down, 0 turns it off */
+double		rpc_scan_pushdown_selectivity = 0.01;
+
+/* GUC: whether aggregates may be computed halfway on the storage node */
+bool		rpc_agg_pushdown = true;
+
+/* Blocks the storage node looks at per ScanRelation */
+#define RPC_SCAN_RANGE		1024
+
+/* Pages it sends back at most, and blocks read per batch without it */
+#define RPC_SCAN_BATCH		32
+
+typedef struct RpcScanState
+{
+	CustomScanState css;
+	RpcScanQual qual;
+	bool		pushdown;		/* false once blocks are read here */
+	bool		flushed;		/* our WAL went out before the first fetch */
+	BlockNumber nextBlock;		/* first block not fetched yet */
+	BlockNumber *blocks;		/* blocks of the current batch */
+	char	   *pages;			/* their pages as ScanRelation sent them */
+	int			nblocks;		/* blocks in the batch */
+	int			current;		/* the one being scanned, -1 before the first */
+	int			tupleIndex;		/* next of its tuples to look at */
+} RpcScanState;
+
+typedef struct RpcAggScanState
+{
+	CustomScanState css;
+	RpcAggSpec	spec;
+	bool		pushdown;		/* false once blocks are read here */
+	bool		done;			/* the row of partial states went out */
+	TupleTableSlot *heapSlot;	/* tuples of the blocks added here */
+	BlockNumber *blocks;		/* blocks the storage node left to us */
+} RpcAggScanState;
+
+static Plan *RpcScanPlanPath(PlannerInfo *root, RelOptInfo *rel,
+							 CustomPath *best_path, List *tlist,
+							 List *clauses, List *custom_plans);
+static Node *RpcScanCreateState(CustomScan *cscan);
+static void RpcScanBegin(CustomScanState *node, EState *estate, int eflags);
+static TupleTableSlot *RpcScanExec(CustomScanState *node);
+static void RpcScanEnd(CustomScanState *node);
+static void RpcScanReScan(CustomScanState *node);
+static void RpcScanExplain(CustomScanState *node, List *ancestors,
+						   ExplainState *es);
+static Plan *RpcAggPlanPath(PlannerInfo *root, RelOptInfo *rel,
+							CustomPath *best_path, List *tlist,
+							List *clauses, List *custom_plans);
+static Node *RpcAggCreateState(CustomScan *cscan);
+static void RpcAggBegin(CustomScanState *node, EState *estate, int eflags);
+static TupleTableSlot *RpcAggExec(CustomScanState *node);
+static void RpcAggEnd(CustomScanState *node);
+static void RpcAggReScan(CustomScanState *node);
+static void RpcAggExplain(CustomScanState *node, List *ancestors,
+						  ExplainState *es);
+
+static const CustomPathMethods RpcScanPathMethods = {
+	"RpcScan",
+	RpcScanPlanPath,
+};
+
+static const CustomScanMethods RpcScanScanMethods = {
+	"RpcScan",
+	RpcScanCreateState,
+};
+
+static const CustomExecMethods RpcScanExecMethods = {
+	.CustomName = "RpcScan",
+	.BeginCustomScan = RpcScanBegin,
+	.ExecCustomScan = RpcScanExec,
+	.EndCustomScan = RpcScanEnd,
+	.ReScanCustomScan = RpcScanReScan,
+	.ExplainCustomScan = RpcScanExplain,
+};
+
+static const CustomPathMethods RpcAggPathMethods = {
+	"RpcAgg",
+	RpcAggPlanPath,
+};
+
+static const CustomScanMethods RpcAggScanMethods = {
+	"RpcAgg",
+	RpcAggCreateState,
+};
+
+static const CustomExecMethods RpcAggExecMethods = {
+	.CustomName = "RpcAgg",
+	.BeginCustomScan = RpcAggBegin,
+	.ExecCustomScan = RpcAggExec,
+	.EndCustomScan = RpcAggEnd,
+	.ReScanCustomScan = RpcAggReScan,
+	.ExplainCustomScan = RpcAggExplain,
+};
+
+/* ----------------------------------------------------------------
+ *						Planner Support
+ * ----------------------------------------------------------------
+ */
+
+/*
+ * rpc_scan_clause -- the pushdown form of a restriction clause
+ *
+ * Returns false unless the clause is "column op constant", or the commuted
+ * form, with an integer or oid column of rel and a btree comparison.
+ */
+static bool
+rpc_scan_clause(RelOptInfo *rel, RestrictInfo *rinfo, int *attnum,
+				int *strategy, int *kind, int64 *constant)
+{
+	OpExpr	   *op;
+	Node	   *left;
+	Node	   *right;
+	Var		   *var;
+	Const	   *cnst;
+	bool		commuted;
+	Oid			opfamily;
+	int			strat;
+
+	if (!IsA(rinfo->clause, OpExpr))
+		return false;
+	op = (OpExpr *) rinfo->clause;
+	if (list_length(op->args) != 2)
+		return false;
+	left = linitial(op->args);
+	right = lsecond(op->args);
+
+	if (IsA(left, Var) && IsA(right, Const))
+	{
+		var = (Var *) left;
+		cnst = (Const *) right;
+		commuted = false;
+	}
+	else if (IsA(left, Const) && IsA(right, Var))
+	{
+		var = (Var *) right;
+		cnst = (Const *) left;
+		commuted = true;
+	}
+	else
+		return false;
+
+	if (var->varno != rel->relid || var->varlevelsup != 0 ||
+		var->varattno < 1 || var->varattno > RPC_SCAN_MAX_ATTS ||
+		cnst->constisnull)
+		return false;
+
+	switch (var->vartype)
+	{
+		case INT2OID:
+		case INT4OID:
+		case INT8OID:
+			if (cnst->consttype != INT2OID && cnst->consttype != INT4OID &&
+				cnst->consttype != INT8OID)
+				return false;
+			opfamily = INTEGER_BTREE_FAM_OID;
+			*kind = RPC_SCAN_SIGNED;
+			break;
+		case OIDOID:
+			if (cnst->consttype != OIDOID)
+				return false;
+			opfamily = OID_BTREE_FAM_OID;
+			*kind = RPC_SCAN_UNSIGNED;
+			break;
+		default:
+			return false;
+	}
+
+	strat = get_op_opfamily_strategy(op->opno, opfamily);
+	if (strat == InvalidStrategy)
+		return false;
+	if (commuted)
+		strat = BTCommuteStrategyNumber(strat);
+
+	switch (cnst->consttype)
+	{
+		case INT2OID:
+			*constant = DatumGetInt16(cnst->constvalue);
+			break;
+		case INT4OID:
+			*constant = DatumGetInt32(cnst->constvalue);
+			break;
+		case INT8OID:
+			*constant = DatumGetInt64(cnst->constvalue);
+			break;
+		default:
+			*constant = DatumGetObjectId(cnst->constvalue);
+			break;
+	}
+	*attnum = var->varattno;
+	*strategy = strat;
+	return true;
+}
+
+/*
+ * rpc_scan_relation -- whether the storage node can scan the relation
+ *
+ * It has to be a plain heap the storage node holds the pages of.
+ */
+static bool
+rpc_scan_relation(RangeTblEntry *rte)
+{
+	Relation	relation;
+	bool		usable;
+
+	if (rte->rtekind != RTE_RELATION || rte->inh || rte->tablesample != NULL ||
+		(rte->relkind != RELKIND_RELATION && rte->relkind != RELKIND_MATVIEW))
+		return false;
+
+	relation = table_open(rte->relid, NoLock);
+	usable = relation->rd_rel->relam == HEAP_TABLE_AM_OID &&
+		relation->rd_rel->relpersistence == RELPERSISTENCE_PERMANENT;
+	table_close(relation, NoLock);
+
+	return usable;
+}
+
+/*
+ * cost_rpc_scan -- cost of an RpcScan keeping a selectivity of the rows
+ *
+ * Like cost_seqscan, for only the pages expected to hold a match, with the
+ * matches spread out over the relation.
+ */
+static void
+cost_rpc_scan(CustomPath *path, RelOptInfo *rel, Selectivity selectivity)
+{
+	Cost		startup_cost;
+	Cost		run_cost;
+	Cost		cpu_per_tuple;
+	double		spc_seq_page_cost;
+	double		tuples_per_page;
+	double		pages_fraction;
+
+	get_relation_page_costs(rel->reltablespace, rel->relfilenode, NULL,
+							&spc_seq_page_cost);
+
+	tuples_per_page = rel->pages > 0 ? rel->tuples / rel->pages : 1.0;
+	pages_fraction = 1.0 - pow(1.0 - selectivity, Max(tuples_per_page, 1.0));
+	CLAMP_PROBABILITY(pages_fraction);
+
+	startup_cost = rel->baserestrictcost.startup;
+	cpu_per_tuple = cpu_tuple_cost + rel->baserestrictcost.per_tuple;
+	run_cost = spc_seq_page_cost * rel->pages * pages_fraction +
+		cpu_per_tuple * rel->tuples * pages_fraction;
+
+	startup_cost += path->path.pathtarget->cost.startup;
+	run_cost += path->path.pathtarget->cost.per_tuple * path->path.rows;
+
+	path->path.startup_cost = startup_cost;
+	path->path.total_cost = startup_cost + run_cost;
+}
+
+/*
+ * create_rpc_scan_paths
+ *	  Offer an RpcScan of a plain heap relation with a selective qual the
+ *	  storage node can check.
+ */
+void
+create_rpc_scan_paths(PlannerInfo *root, RelOptInfo *rel, RangeTblEntry *rte)
+{
+	static bool registered = false;
+	CustomPath *path;
+	ListCell   *lc;
+	Selectivity best_selec = 2.0;
+	int			best_attnum = 0;
+	int			best_strategy = 0;
+	int			best_kind = 0;
+	int64		best_constant = 0;
+
+	if (!IsRpcClient || rpc_scan_pushdown_selectivity <= 0 ||
+		rel->lateral_relids != NULL || !rpc_scan_relation(rte))
+		return;
+
+	foreach(lc, rel->baserestrictinfo)
+	{
+		RestrictInfo *rinfo = lfirst_node(RestrictInfo, lc);
+		int			attnum;
+		int			strategy;
+		int			kind;
+		int64		constant;
+		Selectivity selec;
+
+		if (!rpc_scan_clause(rel, rinfo, &attnum, &strategy, &kind, &constant))
+			continue;
+		selec = clause_selectivity(root, (Node *) rinfo, 0, JOIN_INNER, NULL);
+		if (selec < best_selec)
+		{
+			best_selec = selec;
+			best_attnum = attnum;
+			best_strategy = strategy;
+			best_kind = kind;
+			best_constant = constant;
+		}
+	}
+	if (best_attnum == 0 || best_selec > rpc_scan_pushdown_selectivity)
+		return;
+
+	/* Plans are read back by name, e.g. from a cached plan's copy */
+	if (!registered)
+	{
+		RegisterCustomScanMethods(&RpcScanScanMethods);
+		registered = true;
+	}
+
+	path = makeNode(CustomPath);
+	path->path.pathtype = T_CustomScan;
+	path->path.parent = rel;
+	path->path.pathtarget = rel->reltarget;
+	path->path.param_info = NULL;
+	path->path.parallel_aware = false;
+	path->path.parallel_safe = false;
+	path->path.parallel_workers = 0;
+	path->path.rows = rel->rows;
+	path->path.pathkeys = NIL;
+	path->flags = 0;
+	path->custom_paths = NIL;
+	path->custom_private = list_make4(makeInteger(best_attnum),
+									  makeInteger(best_strategy),
+									  makeInteger(best_kind),
+									  makeConst(INT8OID, -1, InvalidOid,
+												sizeof(int64),
+												Int64GetDatum(best_constant),
+												false, FLOAT8PASSBYVAL));
+	path->methods = &RpcScanPathMethods;
+	cost_rpc_scan(path, rel, best_selec);
+
+	add_path(rel, &path->path);
+}
+
+static Plan *
+RpcScanPlanPath(PlannerInfo *root, RelOptInfo *rel, CustomPath *best_path,
+				List *tlist, List *clauses, List *custom_plans)
+{
+	CustomScan *cscan = makeNode(CustomScan);
+
+	cscan->scan.plan.targetlist = tlist;
+	/* The pushed down qual too, the storage node only sorts out pages */
+	cscan->scan.plan.qual = extract_actual_clauses(clauses, false);
+	cscan->scan.scanrelid = rel->relid;
+	cscan->flags = best_path->flags;
+	cscan->custom_private = best_path->custom_private;
+	cscan->methods = &RpcScanScanMethods;
+
+	return &cscan->scan.plan;
+}
+
+/* ----------------------------------------------------------------
+ *						Scan Support
+ * ----------------------------------------------------------------
+ */
+
+static Node *
+RpcScanCreateState(CustomScan *cscan)
+{
+	RpcScanState *state = palloc0(sizeof(RpcScanState));
+
+	NodeSetTag(state, T_CustomScanState);
+	state->css.methods = &RpcScanExecMethods;
+
+	return (Node *) state;
+}
+
+static void
+RpcScanBegin(CustomScanState *node, EState *estate, int eflags)
+{
+	RpcScanState *state = (RpcScanState *) node;
+	CustomScan *cscan = (CustomScan *) node->ss.ps.plan;
+	Relation	rel = node->ss.ss_currentRelation;
+	TupleDesc	tupdesc = RelationGetDescr(rel);
+	int			i;
+
+	state->qual.attnum = intVal(linitial(cscan->custom_private));
+	state->qual.strategy = intVal(lsecond(cscan->custom_private));
+	state->qual.kind = intVal(lthird(cscan->custom_private));
+	state->qual.constant =
+		DatumGetInt64(((Const *) lfourth(cscan->custom_private))->constvalue);
+	for (i = 0; i < state->qual.attnum && i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute att = TupleDescAttr(tupdesc, i);
+
+		state->qual.atts[i].attlen = att->attlen;
+		state->qual.atts[i].attalign = att->attalign;
+	}
+
+	state->blocks = palloc(sizeof(BlockNumber) * RPC_SCAN_BATCH);
+	state->pages = palloc(BLCKSZ * RPC_SCAN_BATCH);
+	state->pushdown = IsRpcClient && !ShardMapActive() &&
+		!RecoveryInProgress() && state->qual.attnum <= tupdesc->natts;
+	state->flushed = false;
+	state->nextBlock = 0;
+	state->nblocks = 0;
+	state->current = -1;
+
+	/* A plain heap scan, with the blocks it reads left to us */
+	node->ss.ss_currentScanDesc =
+		table_beginscan_sampling(rel, estate->es_snapshot, 0, NULL,
+								 true, false, true);
+	PredicateLockRelation(rel, estate->es_snapshot);
+}
+
+/*
+ * RpcScanFetch -- make the next batch of blocks current
+ *
+ * Returns false once the relation has been scanned.  Should ScanRelation
+ * fail, the old storage node doesn't know it say, the rest of the blocks
+ * are read one batch after another as a SeqScan would.
+ */
+static bool
+RpcScanFetch(RpcScanState *state)
+{
+	TableScanDesc scan = state->css.ss.ss_currentScanDesc;
+	HeapScanDesc hscan = (HeapScanDesc) scan;
+	Relation	rel = scan->rs_rd;
+	int			n;
+
+	while (state->nextBlock < hscan->rs_nblocks)
+	{
+		if (state->pushdown)
+		{
+			BlockNumber end = Min(state->nextBlock + RPC_SCAN_RANGE,
+								  hscan->rs_nblocks);
+			BlockNumber next = InvalidBlockNumber;
+			XLogRecPtr	lsn;
+
+			/* The storage node must have seen our own changes */
+			if (!state->flushed)
+			{
+				XLogFlush(GetXLogInsertRecPtr());
+				state->flushed = true;
+			}
+			lsn = GetLogWrtResultLsn();
+
+			RelationOpenSmgr(rel);
+			n = RpcScanRelation(state->pages, state->blocks, &next,
+								rel->rd_smgr, state->nextBlock, end,
+								&state->qual, RPC_SCAN_BATCH, lsn);
+			if (n >= 0 && next > state->nextBlock && next <= end)
+			{
+				LoadFetchedPages(rel->rd_smgr, rel->rd_rel->relpersistence,
+								 MAIN_FORKNUM, state->blocks, state->pages,
+								 n, lsn, hscan->rs_strategy);
+				state->nextBlock = next;
+				state->nblocks = n;
+				state->current = -1;
+				if (n > 0)
+					return true;
+				continue;
+			}
+			state->pushdown = false;
+		}
+
+		n = Min(RPC_SCAN_BATCH, hscan->rs_nblocks - state->nextBlock);
+		for (int i = 0; i < n; i++)
+			state->blocks[i] = state->nextBlock + i;
+		state->nextBlock += n;
+		state->nblocks = n;
+		state->current = -1;
+		return true;
+	}
+	return false;
+}
+
+/*
+ * RpcScanNextTuple -- the next visible tuple of the scan's current block
+ *
+ * *tupleIndex counts the tuples looked at, 0 right after heapgetpage.
+ */
+static bool
+RpcScanNextTuple(TableScanDesc scan, int *tupleIndex, TupleTableSlot *slot)
+{
+	HeapScanDesc hscan = (HeapScanDesc) scan;
+	HeapTuple	tuple = &hscan->rs_ctup;
+	Page		page = BufferGetPage(hscan->rs_cbuf);
+	OffsetNumber maxoff;
+
+	if (scan->rs_flags & SO_ALLOW_PAGEMODE)
+	{
+		OffsetNumber off;
+		ItemId		itemid;
+
+		/* heapgetpage found the visible ones */
+		if (*tupleIndex >= hscan->rs_ntuples)
+			return false;
+		off = hscan->rs_vistuples[(*tupleIndex)++];
+		itemid = PageGetItemId(page, off);
+		tuple->t_data = (HeapTupleHeader) PageGetItem(page, itemid);
+		tuple->t_len = ItemIdGetLength(itemid);
+		ItemPointerSet(&tuple->t_self, hscan->rs_cblock, off);
+
+		ExecStoreBufferHeapTuple(tuple, slot, hscan->rs_cbuf);
+		pgstat_count_heap_getnext(scan->rs_rd);
+		return true;
+	}
+
+	LockBuffer(hscan->rs_cbuf, BUFFER_LOCK_SHARE);
+	maxoff = PageGetMaxOffsetNumber(page);
+	while (*tupleIndex < maxoff)
+	{
+		OffsetNumber off = FirstOffsetNumber + (*tupleIndex)++;
+		ItemId		itemid = PageGetItemId(page, off);
+		bool		visible;
+
+		if (!ItemIdIsNormal(itemid))
+			continue;
+		tuple->t_data = (HeapTupleHeader) PageGetItem(page, itemid);
+		tuple->t_len = ItemIdGetLength(itemid);
+		ItemPointerSet(&tuple->t_self, hscan->rs_cblock, off);
+
+		visible = HeapTupleSatisfiesVisibility(tuple, scan->rs_snapshot,
+											   hscan->rs_cbuf);
+		HeapCheckForSerializableConflictOut(visible, scan->rs_rd, tuple,
+											hscan->rs_cbuf, scan->rs_snapshot);
+		if (!visible)
+			continue;
+
+		LockBuffer(hscan->rs_cbuf, BUFFER_LOCK_UNLOCK);
+		ExecStoreBufferHeapTuple(tuple, slot, hscan->rs_cbuf);
+		pgstat_count_heap_getnext(scan->rs_rd);
+		return true;
+	}
+	LockBuffer(hscan->rs_cbuf, BUFFER_LOCK_UNLOCK);
+	return false;
+}
+
+static TupleTableSlot *
+RpcScanNext(ScanState *ss)
+{
+	RpcScanState *state = (RpcScanState *) ss;
+	TableScanDesc scan = ss->ss_currentScanDesc;
+	HeapScanDesc hscan = (HeapScanDesc) scan;
+	TupleTableSlot *slot = ss->ss_ScanTupleSlot;
+
+	for (;;)
+	{
+		if (state->current >= 0 &&
+			RpcScanNextTuple(scan, &state->tupleIndex, slot))
+			return slot;
+
+		if (state->current + 1 >= state->nblocks && !RpcScanFetch(state))
+		{
+			if (BufferIsValid(hscan->rs_cbuf))
+			{
+				ReleaseBuffer(hscan->rs_cbuf);
+				hscan->rs_cbuf = InvalidBuffer;
+			}
+			return ExecClearTuple(slot);
+		}
+
+		state->current++;
+		heapgetpage(scan, state->blocks[state->current]);
+		state->tupleIndex = 0;
+	}
+}
+
+static bool
+RpcScanRecheck(ScanState *ss, TupleTableSlot *slot)
+{
+	/* Nothing to recheck, the quals are all in the plan */
+	return true;
+}
+
+static TupleTableSlot *
+RpcScanExec(CustomScanState *node)
+{
+	return ExecScan(&node->ss,
+					(ExecScanAccessMtd) RpcScanNext,
+					(ExecScanRecheckMtd) RpcScanRecheck);
+}
+
+static void
+RpcScanEnd(CustomScanState *node)
+{
+	if (node->ss.ss_currentScanDesc)
+		table_endscan(node->ss.ss_currentScanDesc);
+}
+
+static void
+RpcScanReScan(CustomScanState *node)
+{
+	RpcScanState *state = (RpcScanState *) node;
+
+	state->nextBlock = 0;
+	state->nblocks = 0;
+	state->current = -1;
+	table_rescan(node->ss.ss_currentScanDesc, NULL);
+	ExecScanReScan(&node->ss);
+}
+
+/*
+ * rpc_scan_explain_qual -- show the qual the storage node checks
+ */
+static void
+rpc_scan_explain_qual(RpcScanQual *qual, Relation rel, ExplainState *es)
+{
+	TupleDesc	tupdesc = RelationGetDescr(rel);
+	static const char *const operators[] = {"", "<", "<=", "=", ">=", ">"};
+	const char *attname = "?";
+
+	if (qual->attnum <= tupdesc->natts)
+		attname = NameStr(TupleDescAttr(tupdesc, qual->attnum - 1)->attname);
+	ExplainPropertyText("Storage Node Filter",
+						psprintf("%s %s " INT64_FORMAT, attname,
+								 operators[qual->strategy], qual->constant),
+						es);
+}
+
+static void
+RpcScanExplain(CustomScanState *node, List *ancestors, ExplainState *es)
+{
+	RpcScanState *state = (RpcScanState *) node;
+
+	rpc_scan_explain_qual(&state->qual, node->ss.ss_currentRelation, es);
+}
+
+/* ----------------------------------------------------------------
+ *						Aggregate Support
+ * ----------------------------------------------------------------
+ */
+
+/*
+ * rpc_agg_target -- the storage node's form of a partial aggregate
+ *
+ * Returns false unless it is count(*), or count, sum, min or max of a plain
+ * column of the relation the storage node can add up itself.
+ */
+static bool
+rpc_agg_target(Aggref *aggref, Index relid, RpcAggTarget *target)
+{
+	HeapTuple	aggtup;
+	Oid			transfn;
+	Var		   *var = NULL;
+
+	if (aggref->aggfilter != NULL || aggref->aggdistinct != NIL ||
+		aggref->aggorder != NIL || aggref->aggdirectargs != NIL ||
+		aggref->aggkind != AGGKIND_NORMAL || aggref->agglevelsup != 0)
+		return false;
+
+	if (!aggref->aggstar)
+	{
+		TargetEntry *tle;
+
+		if (list_length(aggref->args) != 1)
+			return false;
+		tle = linitial_node(TargetEntry, aggref->args);
+		if (!IsA(tle->expr, Var))
+			return false;
+		var = (Var *) tle->expr;
+		if (var->varno != relid || var->varlevelsup != 0 ||
+			var->varattno < 1 || var->varattno > RPC_SCAN_MAX_ATTS)
+			return false;
+	}
+
+	aggtup = SearchSysCache1(AGGFNOID, ObjectIdGetDatum(aggref->aggfnoid));
+	if (!HeapTupleIsValid(aggtup))
+		return false;
+	transfn = ((Form_pg_aggregate) GETSTRUCT(aggtup))->aggtransfn;
+	ReleaseSysCache(aggtup);
+
+	switch (transfn)
+	{
+		case F_INT8INC:
+			target->func = RPC_AGG_COUNT_STAR;
+			break;
+		case F_INT8INC_ANY:
+			target->func = RPC_AGG_COUNT;
+			break;
+		case F_INT2_SUM:
+		case F_INT4_SUM:
+			target->func = RPC_AGG_SUM;
+			break;
+		case F_INT2SMALLER:
+		case F_INT4SMALLER:
+		case F_INT8SMALLER:
+		case F_OIDSMALLER:
+			target->func = RPC_AGG_MIN;
+			break;
+		case F_INT2LARGER:
+		case F_INT4LARGER:
+		case F_INT8LARGER:
+		case F_OIDLARGER:
+			target->func = RPC_AGG_MAX;
+			break;
+		default:
+			return false;
+	}
+	if ((target->func == RPC_AGG_COUNT_STAR) != (var == NULL))
+		return false;
+
+	target->attnum = var ? var->varattno : 0;
+	target->kind = var && var->vartype == OIDOID ?
+		RPC_SCAN_UNSIGNED : RPC_SCAN_SIGNED;
+	return true;
+}
+
+/*
+ * create_rpc_agg_paths
+ *	  Offer a Finalize Aggregate over an RpcAgg of input_rel, a plain heap
+ *	  relation, if the storage node can compute the partial aggregates of
+ *	  partial_target.
+ */
+void
+create_rpc_agg_paths(PlannerInfo *root, RelOptInfo *input_rel,
+					 RelOptInfo *grouped_rel, PathTarget *partial_target,
+					 GroupPathExtraData *extra)
+{
+	static bool registered = false;
+	RangeTblEntry *rte;
+	CustomPath *path;
+	List	   *custom_private;
+	AggClauseCosts partial_costs;
+	AggClauseCosts final_costs;
+	double		spc_seq_page_cost;
+	double		fallback_fraction;
+	int			attnum = 0;
+	int			strategy = 0;
+	int			kind = 0;
+	int64		constant = 0;
+	ListCell   *lc;
+
+	if (!IsRpcClient || !rpc_agg_pushdown ||
+		root->parse->groupClause != NIL || root->parse->groupingSets != NIL ||
+		input_rel->reloptkind != RELOPT_BASEREL ||
+		input_rel->rtekind != RTE_RELATION ||
+		input_rel->lateral_relids != NULL)
+		return;
+
+	/* Only the all-visible pages are added on the storage node */
+	if (input_rel->allvisfrac <= 0)
+		return;
+
+	rte = planner_rt_fetch(input_rel->relid, root);
+	if (!rpc_scan_relation(rte))
+		return;
+
+	/* Every row counts, or the storage node must be able to tell which */
+	if (list_length(input_rel->baserestrictinfo) > 1)
+		return;
+	if (input_rel->baserestrictinfo != NIL &&
+		!rpc_scan_clause(input_rel, linitial(input_rel->baserestrictinfo),
+						 &attnum, &strategy, &kind, &constant))
+		return;
+
+	if (partial_target->exprs == NIL ||
+		list_length(partial_target->exprs) > RPC_AGG_MAX_AGGS)
+		return;
+	custom_private = list_make4(makeInteger(attnum), makeInteger(strategy),
+								makeInteger(kind),
+								makeConst(INT8OID, -1, InvalidOid,
+										  sizeof(int64),
+										  Int64GetDatum(constant),
+										  false, FLOAT8PASSBYVAL));
+	foreach(lc, partial_target->exprs)
+	{
+		Node	   *expr = (Node *) lfirst(lc);
+		RpcAggTarget target;
+
+		if (!IsA(expr, Aggref) ||
+			!rpc_agg_target((Aggref *) expr, input_rel->relid, &target))
+			return;
+		custom_private = lappend(custom_private, makeInteger(target.func));
+		custom_private = lappend(custom_private, makeInteger(target.attnum));
+		custom_private = lappend(custom_private, makeInteger(target.kind));
+	}
+
+	if (!registered)
+	{
+		RegisterCustomScanMethods(&RpcAggScanMethods);
+		registered = true;
+	}
+
+	MemSet(&partial_costs, 0, sizeof(AggClauseCosts));
+	get_agg_clause_costs(root, (Node *) partial_target->exprs,
+						 AGGSPLIT_INITIAL_SERIAL, &partial_costs);
+	MemSet(&final_costs, 0, sizeof(AggClauseCosts));
+	get_agg_clause_costs(root, (Node *) grouped_rel->reltarget->exprs,
+						 AGGSPLIT_FINAL_DESERIAL, &final_costs);
+	get_agg_clause_costs(root, extra->havingQual,
+						 AGGSPLIT_FINAL_DESERIAL, &final_costs);
+
+	path = makeNode(CustomPath);
+	path->path.pathtype = T_CustomScan;
+	path->path.parent = input_rel;
+	path->path.pathtarget = partial_target;
+	path->path.param_info = NULL;
+	path->path.parallel_aware = false;
+	path->path.parallel_safe = false;
+	path->path.parallel_workers = 0;
+	path->path.rows = 1;
+	path->path.pathkeys = NIL;
+	path->flags = 0;
+	path->custom_paths = NIL;
+	path->custom_private = custom_private;
+	path->methods = &RpcAggPathMethods;
+
+	/*
+	 * The pages that aren't all-visible are read and aggregated as by a
+	 * SeqScan under a partial Aggregate, the others cost the storage node a
+	 * look at each tuple.  The row comes only at the end.
+	 */
+	get_relation_page_costs(input_rel->reltablespace, input_rel->relfilenode,
+							NULL,
+							&spc_seq_page_cost);
+	fallback_fraction = 1.0 - input_rel->allvisfrac;
+	path->path.startup_cost = partial_costs.transCost.startup +
+		input_rel->baserestrictcost.startup +
+		spc_seq_page_cost * input_rel->pages * fallback_fraction +
+		(cpu_tuple_cost + input_rel->baserestrictcost.per_tuple +
+		 partial_costs.transCost.per_tuple) *
+		input_rel->tuples * fallback_fraction +
+		cpu_operator_cost * input_rel->tuples * input_rel->allvisfrac +
+		partial_target->cost.startup + partial_target->cost.per_tuple;
+	path->path.total_cost = path->path.startup_cost;
+
+	add_path(grouped_rel, (Path *)
+			 create_agg_path(root, grouped_rel, &path->path,
+							 grouped_rel->reltarget, AGG_PLAIN,
+							 AGGSPLIT_FINAL_DESERIAL, NIL,
+							 (List *) extra->havingQual, &final_costs, 1));
+}
+
+static Plan *
+RpcAggPlanPath(PlannerInfo *root, RelOptInfo *rel, CustomPath *best_path,
+			   List *tlist, List *clauses, List *custom_plans)
+{
+	CustomScan *cscan = makeNode(CustomScan);
+
+	/*
+	 * The row holds the partial aggregates, which nothing here evaluates:
+	 * they're the scan tuple.  The qual went into custom_private.
+	 */
+	cscan->scan.plan.targetlist = tlist;
+	cscan->scan.plan.qual = NIL;
+	cscan->scan.scanrelid = rel->relid;
+	cscan->flags = best_path->flags;
+	cscan->custom_scan_tlist = copyObject(tlist);
+	cscan->custom_private = best_path->custom_private;
+	cscan->methods = &RpcAggScanMethods;
+
+	return &cscan->scan.plan;
+}
+
+static Node *
+RpcAggCreateState(CustomScan *cscan)
+{
+	RpcAggScanState *state = palloc0(sizeof(RpcAggScanState));
+
+	NodeSetTag(state, T_CustomScanState);
+	state->css.methods = &RpcAggExecMethods;
+
+	return (Node *) state;
+}
+
+static void
+RpcAggBegin(CustomScanState *node, EState *estate, int eflags)
+{
+	RpcAggScanState *state = (RpcAggScanState *) node;
+	CustomScan *cscan = (CustomScan *) node->ss.ps.plan;
+	Relation	rel = node->ss.ss_currentRelation;
+	TupleDesc	tupdesc = RelationGetDescr(rel);
+	RpcAggSpec *spec = &state->spec;
+	ListCell   *lc;
+	int			maxatt;
+	int			i;
+
+	lc = list_head(cscan->custom_private);
+	spec->qual.attnum = intVal(lfirst(lc));
+	lc = lnext(cscan->custom_private, lc);
+	spec->qual.strategy = intVal(lfirst(lc));
+	lc = lnext(cscan->custom_private, lc);
+	spec->qual.kind = intVal(lfirst(lc));
+	lc = lnext(cscan->custom_private, lc);
+	spec->qual.constant = DatumGetInt64(((Const *) lfirst(lc))->constvalue);
+	maxatt = spec->qual.attnum;
+	for (lc = lnext(cscan->custom_private, lc); lc != NULL;
+		 lc = lnext(cscan->custom_private, lc))
+	{
+		RpcAggTarget *agg = &spec->aggs[spec->naggs++];
+
+		agg->func = intVal(lfirst(lc));
+		lc = lnext(cscan->custom_private, lc);
+		agg->attnum = intVal(lfirst(lc));
+		lc = lnext(cscan->custom_private, lc);
+		agg->kind = intVal(lfirst(lc));
+		maxatt = Max(maxatt, agg->attnum);
+	}
+	for (i = 0; i < maxatt && i < tupdesc->natts; i++)
+	{
+		Form_pg_attribute att = TupleDescAttr(tupdesc, i);
+
+		spec->qual.atts[i].attlen = att->attlen;
+		spec->qual.atts[i].attalign = att->attalign;
+	}
+
+	state->heapSlot = table_slot_create(rel, &estate->es_tupleTable);
+	state->blocks = palloc(sizeof(BlockNumber) * RPC_SCAN_BATCH);
+	state->pushdown = IsRpcClient && !ShardMapActive() &&
+		!RecoveryInProgress() && maxatt <= tupdesc->natts;
+	state->done = false;
+
+	node->ss.ss_currentScanDesc =
+		table_beginscan_sampling(rel, estate->es_snapshot, 0, NULL,
+								 true, false, true);
+	PredicateLockRelation(rel, estate->es_snapshot);
+}
+
+/*
+ * rpc_agg_slot_value -- column attnum of the slot's tuple as the storage
+ *		node reads it
+ */
+static void
+rpc_agg_slot_value(TupleTableSlot *slot, int attnum, int kind,
+				   int64 *value, bool *isnull)
+{
+	Datum		datum = slot_getattr(slot, attnum, isnull);
+
+	*value = 0;
+	if (*isnull)
+		return;
+	switch (TupleDescAttr(slot->tts_tupleDescriptor, attnum - 1)->attlen)
+	{
+		case sizeof(int16):
+			*value = DatumGetInt16(datum);
+			break;
+		case sizeof(int32):
+			*value = kind == RPC_SCAN_UNSIGNED ?
+				(int64) DatumGetUInt32(datum) : (int64) DatumGetInt32(datum);
+			break;
+		case sizeof(int64):
+			*value = DatumGetInt64(datum);
+			break;
+	}
+}
+
+/*
+ * RpcAggAddBlock -- add the visible tuples of a block to the states
+ */
+static void
+RpcAggAddBlock(RpcAggScanState *state, BlockNumber blkno, RpcAggState *states)
+{
+	TableScanDesc scan = state->css.ss.ss_currentScanDesc;
+	TupleTableSlot *slot = state->heapSlot;
+	RpcAggSpec *spec = &state->spec;
+	int			tupleIndex = 0;
+
+	CHECK_FOR_INTERRUPTS();
+
+	heapgetpage(scan, blkno);
+	while (RpcScanNextTuple(scan, &tupleIndex, slot))
+	{
+		int64		value;
+		bool		isnull;
+		int			i;
+
+		if (spec->qual.attnum > 0)
+		{
+			rpc_agg_slot_value(slot, spec->qual.attnum, spec->qual.kind,
+							   &value, &isnull);
+			if (isnull || !RpcScanCompare(&spec->qual, value))
+				continue;
+		}
+		for (i = 0; i < spec->naggs; i++)
+		{
+			RpcAggTarget *agg = &spec->aggs[i];
+
+			value = 0;
+			isnull = false;
+			if (agg->func != RPC_AGG_COUNT_STAR)
+				rpc_agg_slot_value(slot, agg->attnum, agg->kind,
+								   &value, &isnull);
+			RpcAggAdvance(agg, &states[i], value, isnull);
+		}
+	}
+	ExecClearTuple(slot);
+}
+
+static TupleTableSlot *
+RpcAggNext(ScanState *ss)
+{
+	RpcAggScanState *state = (RpcAggScanState *) ss;
+	TableScanDesc scan = ss->ss_currentScanDesc;
+	HeapScanDesc hscan = (HeapScanDesc) scan;
+	Relation	rel = scan->rs_rd;
+	TupleTableSlot *slot = ss->ss_ScanTupleSlot;
+	RpcAggSpec *spec = &state->spec;
+	RpcAggState states[RPC_AGG_MAX_AGGS];
+	BlockNumber blkno = 0;
+	bool		flushed = false;
+	int			i;
+
+	if (state->done)
+		return ExecClearTuple(slot);
+	state->done = true;
+
+	RpcAggInit(spec, states);
+	while (blkno < hscan->rs_nblocks)
+	{
+		if (state->pushdown)
+		{
+			RpcAggState partial[RPC_AGG_MAX_AGGS];
+			BlockNumber end = Min(blkno + RPC_SCAN_RANGE, hscan->rs_nblocks);
+			BlockNumber next = InvalidBlockNumber;
+			XLogRecPtr	lsn;
+			int			n;
+
+			/* The storage node must have seen our own changes */
+			if (!flushed)
+			{
+				XLogFlush(GetXLogInsertRecPtr());
+				flushed = true;
+			}
+			lsn = GetLogWrtResultLsn();
+
+			CHECK_FOR_INTERRUPTS();
+			RelationOpenSmgr(rel);
+			n = RpcAggregateRelation(partial, state->blocks, &next,
+									 rel->rd_smgr, blkno, end, spec,
+									 RPC_SCAN_BATCH, lsn);
+			if (n >= 0 && next > blkno && next <= end)
+			{
+				RpcAggCombine(spec, states, partial);
+				for (i = 0; i < n; i++)
+					RpcAggAddBlock(state, state->blocks[i], states);
+				blkno = next;
+				continue;
+			}
+			state->pushdown = false;
+		}
+		RpcAggAddBlock(state, blkno++, states);
+	}
+	if (BufferIsValid(hscan->rs_cbuf))
+	{
+		ReleaseBuffer(hscan->rs_cbuf);
+		hscan->rs_cbuf = InvalidBuffer;
+	}
+
+	ExecClearTuple(slot);
+	for (i = 0; i < spec->naggs; i++)
+	{
+		int64		value = states[i].value;
+
+		slot->tts_isnull[i] = states[i].isnull != 0;
+		switch (TupleDescAttr(slot->tts_tupleDescriptor, i)->atttypid)
+		{
+			case INT2OID:
+				slot->tts_values[i] = Int16GetDatum((int16) value);
+				break;
+			case INT4OID:
+				slot->tts_values[i] = Int32GetDatum((int32) value);
+				break;
+			case OIDOID:
+				slot->tts_values[i] = ObjectIdGetDatum((Oid) value);
+				break;
+			default:
+				slot->tts_values[i] = Int64GetDatum(value);
+				break;
+		}
+	}
+	return ExecStoreVirtualTuple(slot);
+}
+
+static bool
+RpcAggRecheck(ScanState *ss, TupleTableSlot *slot)
+{
+	return true;
+}
+
+static TupleTableSlot *
+RpcAggExec(CustomScanState *node)
+{
+	return ExecScan(&node->ss,
+					(ExecScanAccessMtd) RpcAggNext,
+					(ExecScanRecheckMtd) RpcAggRecheck);
+}
+
+static void
+RpcAggEnd(CustomScanState *node)
+{
+	/* The heap slot goes with the executor's tuple table */
+	if (node->ss.ss_currentScanDesc)
+		table_endscan(node->ss.ss_currentScanDesc);
+}
+
+static void
+RpcAggReScan(CustomScanState *node)
+{
+	RpcAggScanState *state = (RpcAggScanState *) node;
+
+	state->done = false;
+	table_rescan(node->ss.ss_currentScanDesc, NULL);
+	ExecScanReScan(&node->ss);
+}
+
+static void
+RpcAggExplain(CustomScanState *node, List *ancestors, ExplainState *es)
+{
+	RpcAggScanState *state = (RpcAggScanState *) node;
+
+	if (state->spec.qual.attnum > 0)
+		rpc_scan_explain_qual(&state->spec.qual, node->ss.ss_currentRelation,
+							  es);
+}
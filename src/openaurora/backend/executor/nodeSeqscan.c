@@ -15,6 +15,7 @@
 /*
  * INTERFACE ROUTINES
  *		ExecSeqScan				sequentially scans a relation.
+ *		ExecSeqScanBatch		the same, evaluating the qual a page at a time.
  *		ExecSeqNext				retrieve next tuple in sequential order.
  *		ExecInitSeqScan			creates and initializes a seqscan node.
  *		ExecEndSeqScan			releases any storage allocated.
@@ -27,12 +28,18 @@
  */
 #include "postgres.h"
 
+#include "access/heapam.h"
 #include "access/relscan.h"
 #include "access/tableam.h"
+#include "executor/execBatch.h"
 #include "executor/execdebug.h"
+#include "executor/nodeHashjoin.h"
 #include "executor/nodeSeqscan.h"
+#include "miscadmin.h"
 #include "utils/rel.h"
 
+bool		enable_batch_seqscan = true;
+
 static TupleTableSlot *SeqNext(SeqScanState *node);
 
 /* ----------------------------------------------------------------
@@ -46,6 +53,25 @@ static TupleTableSlot *SeqNext(SeqScanState *node);
  *		This is a workhorse for ExecSeqScan
  * ----------------------------------------------------------------
  */
+static TableScanDesc
+SeqBeginScan(SeqScanState *node)
+{
+	TableScanDesc scandesc = node->ss.ss_currentScanDesc;
+
+	if (scandesc == NULL)
+	{
+		/*
+		 * We reach here if the scan is not parallel, or if we're serially
+		 * executing a scan that was planned to be parallel.
+		 */
+		scandesc = table_beginscan(node->ss.ss_currentRelation,
+								   node->ss.ps.state->es_snapshot,
+								   0, NULL);
+		node->ss.ss_currentScanDesc = scandesc;
+	}
+	return scandesc;
+}
+
 static TupleTableSlot *
 SeqNext(SeqScanState *node)
 {
@@ -57,23 +83,11 @@ SeqNext(SeqScanState *node)
 	/*
 	 * get information from the estate and scan state
 	 */
-	scandesc = node->ss.ss_currentScanDesc;
+	scandesc = SeqBeginScan(node);
 	estate = node->ss.ps.state;
 	direction = estate->es_direction;
 	slot = node->ss.ss_ScanTupleSlot;
 
-	if (scandesc == NULL)
-	{
-		/*
-		 * We reach here if the scan is not parallel, or if we're serially
-		 * executing a scan that was planned to be parallel.
-		 */
-		scandesc = table_beginscan(node->ss.ss_currentRelation,
-								   estate->es_snapshot,
-								   0, NULL);
-		node->ss.ss_currentScanDesc = scandesc;
-	}
-
 	/*
 	 * get the next tuple from the table
 	 */
@@ -114,6 +128,125 @@ ExecSeqScan(PlanState *pstate)
 					(ExecScanRecheckMtd) SeqRecheck);
 }
 
+/* ----------------------------------------------------------------
+ *		SeqNextBatch
+ *
+ *		Reads the visible tuples of the next page and evaluates the
+ *		batch qual over them. Returns false at the end of the scan.
+ * ----------------------------------------------------------------
+ */
+static bool
+SeqNextBatch(SeqScanState *node)
+{
+	TupleTableSlot *slot = node->ss.ss_ScanTupleSlot;
+	int			ntuples;
+
+	ntuples = heap_getnextbatch(node->ss.ss_currentScanDesc,
+								node->batchtuples, &node->batchbuffer);
+	if (ntuples == 0)
+		return false;
+
+	for (int i = 0; i < ntuples; i++)
+	{
+		ExecStoreBufferHeapTuple(&node->batchtuples[i], slot, node->batchbuffer);
+		ExecBatchQualLoad(node->batchqual, i, slot);
+	}
+	node->batchsize = ExecBatchQual(node->batchqual, ntuples, node->batchselection);
+	node->batchpos = 0;
+	InstrCountFiltered1(node, ntuples - node->batchsize);
+	return true;
+}
+
+/* ----------------------------------------------------------------
+ *		ExecSeqScanBatch(node)
+ *
+ *		Like ExecSeqScan, for a scan whose qual starts with clauses
+ *		execBatch.c can evaluate. They are evaluated a page at a time,
+ *		the rest of the qual and the projection still row by row.
+ * ----------------------------------------------------------------
+ */
+static TupleTableSlot *
+ExecSeqScanBatch(PlanState *pstate)
+{
+	SeqScanState *node = castNode(SeqScanState, pstate);
+	ExprContext *econtext = node->ss.ps.ps_ExprContext;
+	ExprState  *qual = node->batchresidual;
+	ProjectionInfo *projInfo = node->ss.ps.ps_ProjInfo;
+	TupleTableSlot *slot = node->ss.ss_ScanTupleSlot;
+
+	/*
+	 * Batches need the scan to work a page at a time, a non-MVCC snapshot
+	 * doesn't allow that; the scan then stays in row mode.
+	 */
+	if (node->batchqual != NULL &&
+		!(SeqBeginScan(node)->rs_flags & SO_ALLOW_PAGEMODE))
+		node->batchqual = NULL;
+	if (node->batchqual == NULL)
+		return ExecSeqScan(pstate);
+
+	Assert(ScanDirectionIsForward(node->ss.ps.state->es_direction));
+	ResetExprContext(econtext);
+
+	for (;;)
+	{
+		CHECK_FOR_INTERRUPTS();
+
+		if (node->batchpos >= node->batchsize)
+		{
+			if (!SeqNextBatch(node))
+			{
+				if (projInfo)
+					return ExecClearTuple(projInfo->pi_state.resultslot);
+				return ExecClearTuple(slot);
+			}
+			continue;
+		}
+
+		ExecStoreBufferHeapTuple(&node->batchtuples[node->batchselection[node->batchpos++]],
+								 slot, node->batchbuffer);
+		econtext->ecxt_scantuple = slot;
+		if (qual == NULL || ExecQual(qual, econtext))
+		{
+			TupleTableSlot *result = projInfo ? ExecProject(projInfo) : slot;
+
+			/* See ExecScan */
+			if (node->ss.ss_HashFilter == NULL ||
+				ExecHashJoinOuterMayMatch(node->ss.ss_HashFilter, result))
+				return result;
+		}
+		else
+			InstrCountFiltered1(node, 1);
+		ResetExprContext(econtext);
+	}
+}
+
+/*
+ * ExecInitSeqScanBatch -- set the scan up for batch mode if it can be
+ *
+ * Needs a heap relation, a forward-only scan outside EvalPlanQual, and a
+ * qual whose first clause execBatch.c can evaluate.
+ */
+static void
+ExecInitSeqScanBatch(SeqScanState *scanstate, SeqScan *node, EState *estate,
+					 int eflags)
+{
+	List	   *residual;
+
+	if (!enable_batch_seqscan || node->plan.qual == NIL ||
+		(eflags & EXEC_FLAG_BACKWARD) || estate->es_epq_active != NULL ||
+		scanstate->ss.ss_currentRelation->rd_tableam != GetHeapamTableAmRoutine())
+		return;
+
+	scanstate->batchqual = ExecInitBatchQual(node->plan.qual, node->scanrelid,
+											 &residual);
+	if (scanstate->batchqual == NULL)
+		return;
+	scanstate->batchresidual = ExecInitQual(residual, (PlanState *) scanstate);
+	scanstate->batchtuples = palloc(sizeof(HeapTupleData) * BATCH_MAX_ROWS);
+	scanstate->batchselection = palloc(sizeof(uint16) * BATCH_MAX_ROWS);
+	scanstate->ss.ps.ExecProcNode = ExecSeqScanBatch;
+}
+
 
 /* ----------------------------------------------------------------
  *		ExecInitSeqScan
@@ -171,6 +304,8 @@ ExecInitSeqScan(SeqScan *node, EState *estate, int eflags)
 	scanstate->ss.ps.qual =
 		ExecInitQual(node->plan.qual, (PlanState *) scanstate);
 
+	ExecInitSeqScanBatch(scanstate, node, estate, eflags);
+
 	return scanstate;
 }
 
@@ -230,6 +365,8 @@ ExecReScanSeqScan(SeqScanState *node)
 	if (scan != NULL)
 		table_rescan(scan,		/* scan desc */
 					 NULL);		/* new scan keys */
+	node->batchsize = 0;
+	node->batchpos = 0;
 
 	ExecScanReScan((ScanState *) node);
 }
@@ -28,11 +28,14 @@
 #include <llvm-c/Transforms/Utils.h>
 #endif
 
+#include "common/sha2.h"
 #include "jit/llvmjit.h"
 #include "jit/llvmjit_emit.h"
+#include "lib/ilist.h"
 #include "miscadmin.h"
 #include "portability/instr_time.h"
 #include "storage/ipc.h"
+#include "utils/hsearch.h"
 #include "utils/memutils.h"
 #include "utils/resowner_private.h"
 
@@ -43,6 +46,28 @@ typedef struct LLVMJitHandle
 	LLVMOrcModuleHandle orc_handle;
 } LLVMJitHandle;
 
+/*
+ * Module emitted for one context and kept for the later ones building the
+ * same module, see llvm_cache_key(). Up to jit_cache_size of them are kept,
+ * the least recently used that no context uses any more go first.
+ */
+typedef struct LLVMJitCacheEntry
+{
+	uint8		key[PG_SHA256_DIGEST_LENGTH];	/* hash key, must be first */
+	LLVMJitHandle handle;
+	int			nfunctions;
+	void	  **addrs;			/* of the functions, in module order */
+	int			refcount;		/* contexts using the module */
+	dlist_node	lru_node;
+} LLVMJitCacheEntry;
+
+/* A function of a context found in the cache */
+typedef struct LLVMJitCachedFunction
+{
+	char	   *funcname;
+	void	   *addr;
+} LLVMJitCachedFunction;
+
 
 /* types & functions commonly needed for JITing */
 LLVMTypeRef TypeSizeT;
@@ -92,6 +117,10 @@ static LLVMTargetRef llvm_targetref;
 static LLVMOrcJITStackRef llvm_opt0_orc;
 static LLVMOrcJITStackRef llvm_opt3_orc;
 
+static HTAB *llvm_cache = NULL;
+static dlist_head llvm_cache_lru = DLIST_STATIC_INIT(llvm_cache_lru);
+static int	llvm_cache_entries = 0;
+
 
 static void llvm_release_context(JitContext *context);
 static void llvm_session_initialize(void);
@@ -99,6 +128,13 @@ static void llvm_shutdown(int code, Datum arg);
 static void llvm_compile_module(LLVMJitContext *context);
 static void llvm_optimize_module(LLVMJitContext *context, LLVMModuleRef module);
 
+static List *llvm_cache_key(LLVMJitContext *context, uint8 *key);
+static void llvm_cache_use(LLVMJitContext *context, LLVMJitCacheEntry *entry,
+						   List *funcnames);
+static void llvm_cache_put(LLVMJitContext *context, const uint8 *key,
+						   List *funcnames, LLVMJitHandle *handle);
+static void llvm_cache_evict(void);
+
 static void llvm_create_types(void);
 static uint64_t llvm_resolve_symbol(const char *name, void *ctx);
 
@@ -179,6 +215,30 @@ llvm_release_context(JitContext *context)
 			LLVMOrcRemoveModule(jit_handle->stack, jit_handle->orc_handle);
 			pfree(jit_handle);
 		}
+
+		while (llvm_context->cached_functions != NIL)
+		{
+			LLVMJitCachedFunction *cached;
+
+			cached = (LLVMJitCachedFunction *) linitial(llvm_context->cached_functions);
+			llvm_context->cached_functions =
+				list_delete_first(llvm_context->cached_functions);
+
+			pfree(cached->funcname);
+			pfree(cached);
+		}
+
+		if (llvm_context->cached != NIL)
+		{
+			ListCell   *lc;
+
+			foreach(lc, llvm_context->cached)
+				((LLVMJitCacheEntry *) lfirst(lc))->refcount--;
+			list_free(llvm_context->cached);
+			llvm_context->cached = NIL;
+
+			llvm_cache_evict();
+		}
 	}
 }
 
@@ -235,9 +295,7 @@ void *
 llvm_get_function(LLVMJitContext *context, const char *funcname)
 {
 	LLVMOrcTargetAddress addr = 0;
-#if defined(HAVE_DECL_LLVMORCGETSYMBOLADDRESSIN) && HAVE_DECL_LLVMORCGETSYMBOLADDRESSIN
 	ListCell   *lc;
-#endif
 
 	llvm_assert_in_fatal_section();
 
@@ -250,6 +308,14 @@ llvm_get_function(LLVMJitContext *context, const char *funcname)
 		llvm_compile_module(context);
 	}
 
+	foreach(lc, context->cached_functions)
+	{
+		LLVMJitCachedFunction *cached = (LLVMJitCachedFunction *) lfirst(lc);
+
+		if (strcmp(cached->funcname, funcname) == 0)
+			return cached->addr;
+	}
+
 	/*
 	 * ORC's symbol table is of *unmangled* symbols. Therefore we don't need
 	 * to mangle here.
@@ -489,12 +555,39 @@ llvm_compile_module(LLVMJitContext *context)
 	static LLVMOrcJITStackRef compile_orc;
 	instr_time	starttime;
 	instr_time	endtime;
+	uint8		key[PG_SHA256_DIGEST_LENGTH];
+	List	   *funcnames = NIL;
 
 	if (context->base.flags & PGJIT_OPT3)
 		compile_orc = llvm_opt3_orc;
 	else
 		compile_orc = llvm_opt0_orc;
 
+	/* code that was emitted already only needs to be looked up */
+	if (jit_cache_size > 0)
+	{
+		LLVMJitCacheEntry *entry;
+
+		funcnames = llvm_cache_key(context, key);
+		entry = (LLVMJitCacheEntry *) hash_search(llvm_cache, key,
+												  HASH_FIND, NULL);
+		if (entry != NULL)
+		{
+			llvm_cache_use(context, entry, funcnames);
+
+			LLVMDisposeModule(context->module);
+			context->module = NULL;
+			context->compiled = true;
+
+			ereport(DEBUG1,
+					(errmsg("JIT module found in cache, %d functions",
+							entry->nfunctions),
+					 errhidestmt(true),
+					 errhidecontext(true)));
+			return;
+		}
+	}
+
 	/* perform inlining */
 	if (context->base.flags & PGJIT_INLINE)
 	{
@@ -579,17 +672,27 @@ llvm_compile_module(LLVMJitContext *context)
 	context->compiled = true;
 
 	/* remember emitted code for cleanup and lookups */
-	oldcontext = MemoryContextSwitchTo(TopMemoryContext);
+	if (jit_cache_size > 0)
+	{
+		LLVMJitHandle handle;
+
+		handle.stack = compile_orc;
+		handle.orc_handle = orc_handle;
+
+		llvm_cache_put(context, key, funcnames, &handle);
+	}
+	else
 	{
 		LLVMJitHandle *handle;
 
+		oldcontext = MemoryContextSwitchTo(TopMemoryContext);
 		handle = (LLVMJitHandle *) palloc(sizeof(LLVMJitHandle));
 		handle->stack = compile_orc;
 		handle->orc_handle = orc_handle;
 
 		context->handles = lappend(context->handles, handle);
+		MemoryContextSwitchTo(oldcontext);
 	}
-	MemoryContextSwitchTo(oldcontext);
 
 	ereport(DEBUG1,
 			(errmsg("time to inline: %.3fs, opt: %.3fs, emit: %.3fs",
@@ -600,6 +703,178 @@ llvm_compile_module(LLVMJitContext *context)
 			 errhidecontext(true)));
 }
 
+/*
+ * Compute the cache key of the pending module into key, and return the names
+ * of the functions it defines, allocated in TopMemoryContext.
+ *
+ * The key is a hash of the module's IR and of the flags it is compiled with.
+ * For the IR of two contexts to be the same, their functions are named after
+ * their positions while it is printed, and the expressions have been built
+ * relocatable, see llvm_compile_expr(); equal IR is then equal code, whatever
+ * built it. Tuple descriptors are part of the IR of the deform functions.
+ */
+static List *
+llvm_cache_key(LLVMJitContext *context, uint8 *key)
+{
+	List	   *funcnames = NIL;
+	ListCell   *lc;
+	LLVMValueRef func;
+	pg_sha256_ctx ctx;
+	char	   *ir;
+	int			flags = context->base.flags & (PGJIT_OPT3 | PGJIT_INLINE);
+	int			n = 0;
+
+	for (func = LLVMGetFirstFunction(context->module);
+		 func != NULL;
+		 func = LLVMGetNextFunction(func))
+	{
+		char		canonical[32];
+
+		if (LLVMIsDeclaration(func))
+			continue;
+
+		funcnames = lappend(funcnames,
+							MemoryContextStrdup(TopMemoryContext,
+												LLVMGetValueName(func)));
+		snprintf(canonical, sizeof(canonical), "pgjit.%d", n++);
+		LLVMSetValueName(func, canonical);
+	}
+
+	ir = LLVMPrintModuleToString(context->module);
+	pg_sha256_init(&ctx);
+	pg_sha256_update(&ctx, (uint8 *) &flags, sizeof(flags));
+	pg_sha256_update(&ctx, (uint8 *) ir, strlen(ir));
+	pg_sha256_final(&ctx, key);
+	LLVMDisposeMessage(ir);
+
+	/* and give the functions their names back */
+	lc = list_head(funcnames);
+	for (func = LLVMGetFirstFunction(context->module);
+		 func != NULL;
+		 func = LLVMGetNextFunction(func))
+	{
+		if (LLVMIsDeclaration(func))
+			continue;
+
+		LLVMSetValueName(func, (char *) lfirst(lc));
+		lc = lnext(funcnames, lc);
+	}
+
+	return funcnames;
+}
+
+/*
+ * Let context use the module of entry, its functions being funcnames.
+ */
+static void
+llvm_cache_use(LLVMJitContext *context, LLVMJitCacheEntry *entry,
+			   List *funcnames)
+{
+	MemoryContext oldcontext;
+	ListCell   *lc;
+	int			i = 0;
+
+	Assert(list_length(funcnames) == entry->nfunctions);
+
+	oldcontext = MemoryContextSwitchTo(TopMemoryContext);
+	foreach(lc, funcnames)
+	{
+		LLVMJitCachedFunction *cached;
+
+		cached = (LLVMJitCachedFunction *) palloc(sizeof(LLVMJitCachedFunction));
+		cached->funcname = (char *) lfirst(lc);
+		cached->addr = entry->addrs[i++];
+
+		context->cached_functions = lappend(context->cached_functions, cached);
+	}
+	context->cached = lappend(context->cached, entry);
+	MemoryContextSwitchTo(oldcontext);
+	list_free(funcnames);
+
+	entry->refcount++;
+	dlist_move_head(&llvm_cache_lru, &entry->lru_node);
+}
+
+/*
+ * Add the module just emitted for context to the cache.
+ */
+static void
+llvm_cache_put(LLVMJitContext *context, const uint8 *key,
+			   List *funcnames, LLVMJitHandle *handle)
+{
+	LLVMJitCacheEntry *entry;
+	void	  **addrs;
+	ListCell   *lc;
+	int			i = 0;
+	bool		found;
+
+	addrs = MemoryContextAlloc(TopMemoryContext,
+							   sizeof(void *) * Max(list_length(funcnames), 1));
+	foreach(lc, funcnames)
+	{
+		const char *funcname = (const char *) lfirst(lc);
+		LLVMOrcTargetAddress addr = 0;
+
+#if defined(HAVE_DECL_LLVMORCGETSYMBOLADDRESSIN) && HAVE_DECL_LLVMORCGETSYMBOLADDRESSIN
+		if (LLVMOrcGetSymbolAddressIn(handle->stack, &addr, handle->orc_handle, funcname))
+			elog(ERROR, "failed to look up symbol \"%s\"", funcname);
+#elif LLVM_VERSION_MAJOR < 5
+		addr = LLVMOrcGetSymbolAddress(handle->stack, funcname);
+#else
+		if (LLVMOrcGetSymbolAddress(handle->stack, &addr, funcname))
+			elog(ERROR, "failed to look up symbol \"%s\"", funcname);
+#endif
+		if (!addr)
+			elog(ERROR, "failed to JIT: %s", funcname);
+		addrs[i++] = (void *) (uintptr_t) addr;
+	}
+
+	entry = (LLVMJitCacheEntry *) hash_search(llvm_cache, key,
+											  HASH_ENTER, &found);
+	Assert(!found);
+	entry->handle = *handle;
+	entry->nfunctions = list_length(funcnames);
+	entry->addrs = addrs;
+	entry->refcount = 0;
+	dlist_push_head(&llvm_cache_lru, &entry->lru_node);
+	llvm_cache_entries++;
+
+	llvm_cache_use(context, entry, funcnames);
+	llvm_cache_evict();
+}
+
+/*
+ * Remove the least recently used modules no context uses any more, until
+ * there are no more than jit_cache_size.
+ */
+static void
+llvm_cache_evict(void)
+{
+	dlist_node *node;
+
+	if (llvm_cache_entries <= jit_cache_size ||
+		dlist_is_empty(&llvm_cache_lru))
+		return;
+
+	node = dlist_tail_node(&llvm_cache_lru);
+	while (node != NULL && llvm_cache_entries > jit_cache_size)
+	{
+		LLVMJitCacheEntry *entry = dlist_container(LLVMJitCacheEntry,
+												   lru_node, node);
+
+		node = dlist_has_prev(&llvm_cache_lru, node) ?
+			dlist_prev_node(&llvm_cache_lru, node) : NULL;
+		if (entry->refcount > 0)
+			continue;
+
+		dlist_delete(&entry->lru_node);
+		LLVMOrcRemoveModule(entry->handle.stack, entry->handle.orc_handle);
+		pfree(entry->addrs);
+		hash_search(llvm_cache, entry->key, HASH_REMOVE, NULL);
+		llvm_cache_entries--;
+	}
+}
+
 /*
  * Per session initialization.
  */
@@ -683,6 +958,16 @@ llvm_session_initialize(void)
 	}
 #endif
 
+	{
+		HASHCTL		ctl;
+
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = PG_SHA256_DIGEST_LENGTH;
+		ctl.entrysize = sizeof(LLVMJitCacheEntry);
+		llvm_cache = hash_create("LLVM JIT cache", 64, &ctl,
+								 HASH_ELEM | HASH_BLOBS);
+	}
+
 	before_shmem_exit(llvm_shutdown, 0);
 
 	llvm_session_initialized = true;
@@ -92,6 +92,7 @@
 #include "optimizer/planmain.h"
 #include "optimizer/restrictinfo.h"
 #include "parser/parsetree.h"
+#include "storage/rpc_fetch_cost.h"
 #include "utils/lsyscache.h"
 #include "utils/selfuncs.h"
 #include "utils/spccache.h"
@@ -138,6 +139,7 @@ bool		enable_gathermerge = true;
 bool		enable_partitionwise_join = false;
 bool		enable_partitionwise_aggregate = false;
 bool		enable_parallel_append = true;
+bool		enable_async_append = true;
 bool		enable_parallel_hash = true;
 bool		enable_partition_pruning = true;
 
@@ -201,6 +203,34 @@ clamp_row_est(double nrows)
 	return nrows;
 }
 
+/*
+ * get_relation_page_costs
+ *	  The page costs of the tablespace spcid, as get_tablespace_page_costs
+ *	  returns them, for the relation stored in rnode.
+ *
+ * With rpc_measured_page_costs, a compute node in RPC mode scales them by
+ * how long fetches of the relation's pages took, see
+ * storage/rpc_fetch_cost.h.  Anywhere else nothing was measured, and they
+ * are the tablespace's.
+ */
+void
+get_relation_page_costs(Oid spcid, RelFileNode rnode,
+						double *spc_random_page_cost,
+						double *spc_seq_page_cost)
+{
+	double		random_cost;
+	double		seq_cost;
+
+	get_tablespace_page_costs(spcid, &random_cost, &seq_cost);
+	if (rpc_measured_page_costs && OidIsValid(rnode.relNode))
+		(void) RpcFetchPageCosts(rnode, &random_cost, &seq_cost);
+
+	if (spc_random_page_cost)
+		*spc_random_page_cost = random_cost;
+	if (spc_seq_page_cost)
+		*spc_seq_page_cost = seq_cost;
+}
+
 
 /*
  * cost_seqscan
@@ -234,9 +264,9 @@ cost_seqscan(Path *path, PlannerInfo *root,
 		startup_cost += disable_cost;
 
 	/* fetch estimated page cost for tablespace containing table */
-	get_tablespace_page_costs(baserel->reltablespace,
-							  NULL,
-							  &spc_seq_page_cost);
+	get_relation_page_costs(baserel->reltablespace, baserel->relfilenode,
+							NULL,
+							&spc_seq_page_cost);
 
 	/*
 	 * disk costs
@@ -316,9 +346,9 @@ cost_samplescan(Path *path, PlannerInfo *root,
 		path->rows = baserel->rows;
 
 	/* fetch estimated page cost for tablespace containing table */
-	get_tablespace_page_costs(baserel->reltablespace,
-							  &spc_random_page_cost,
-							  &spc_seq_page_cost);
+	get_relation_page_costs(baserel->reltablespace, baserel->relfilenode,
+							&spc_random_page_cost,
+							&spc_seq_page_cost);
 
 	/* if NextSampleBlock is used, assume random access, else sequential */
 	spc_page_cost = (tsm->NextSampleBlock != NULL) ?
@@ -565,9 +595,9 @@ cost_index(IndexPath *path, PlannerInfo *root, double loop_count,
 	tuples_fetched = clamp_row_est(indexSelectivity * baserel->tuples);
 
 	/* fetch estimated page costs for tablespace containing table */
-	get_tablespace_page_costs(baserel->reltablespace,
-							  &spc_random_page_cost,
-							  &spc_seq_page_cost);
+	get_relation_page_costs(baserel->reltablespace, baserel->relfilenode,
+							&spc_random_page_cost,
+							&spc_seq_page_cost);
 
 	/*----------
 	 * Estimate number of main-table pages fetched, and compute I/O cost.
@@ -978,9 +1008,9 @@ cost_bitmap_heap_scan(Path *path, PlannerInfo *root, RelOptInfo *baserel,
 	T = (baserel->pages > 1) ? (double) baserel->pages : 1.0;
 
 	/* Fetch estimated page costs for tablespace containing table. */
-	get_tablespace_page_costs(baserel->reltablespace,
-							  &spc_random_page_cost,
-							  &spc_seq_page_cost);
+	get_relation_page_costs(baserel->reltablespace, baserel->relfilenode,
+							&spc_random_page_cost,
+							&spc_seq_page_cost);
 
 	/*
 	 * For small numbers of pages we should charge spc_random_page_cost
@@ -1249,9 +1279,9 @@ cost_tidscan(Path *path, PlannerInfo *root,
 	cost_qual_eval(&tid_qual_cost, tidquals, root);
 
 	/* fetch estimated page cost for tablespace containing table */
-	get_tablespace_page_costs(baserel->reltablespace,
-							  &spc_random_page_cost,
-							  NULL);
+	get_relation_page_costs(baserel->reltablespace, baserel->relfilenode,
+							&spc_random_page_cost,
+							NULL);
 
 	/* disk costs --- assume each tuple on a different page */
 	run_cost += spc_random_page_cost * ntuples;
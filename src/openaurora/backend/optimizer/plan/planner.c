@@ -30,6 +30,7 @@
 #include "catalog/pg_type.h"
 #include "executor/executor.h"
 #include "executor/nodeAgg.h"
+#include "executor/nodeRpcScan.h"
 #include "foreign/fdwapi.h"
 #include "jit/jit.h"
 #include "lib/bipartite_match.h"
@@ -4155,6 +4156,14 @@ create_ordinary_grouping_paths(PlannerInfo *root, RelOptInfo *input_rel,
 							  partially_grouped_rel, agg_costs, gd,
 							  dNumGroups, extra);
 
+	/* Consider computing the partial aggregates on the storage node */
+	if ((extra->flags & GROUPING_CAN_PARTIAL_AGG) != 0 && gd == NULL)
+		create_rpc_agg_paths(root, input_rel, grouped_rel,
+							 make_partial_grouping_target(root,
+														  grouped_rel->reltarget,
+														  extra->havingQual),
+							 extra);
+
 	/* Give a helpful error if we failed to find any implementation */
 	if (grouped_rel->pathlist == NIL)
 		ereport(ERROR,
@@ -6335,7 +6344,8 @@ plan_cluster_use_sort(Oid tableOid, Oid indexOid)
  *		CREATE INDEX should request for use
  *
  * tableOid is the table on which the index is to be built.  indexOid is the
- * OID of an index to be created or reindexed (which must be a btree index).
+ * OID of an index to be created or reindexed (which must be a btree or GIN
+ * index).
  *
  * Return value is the number of parallel worker processes to request.  It
  * may be unsafe to proceed if this is 0.  Note that this does not include the
@@ -3314,6 +3314,41 @@ make_one_partition_rbound(PartitionKey key, int index, List *datums, bool lower)
 	return bound;
 }
 
+/*
+ * partition_key_cmp
+ *
+ * Compare two partition key values with the key's btree comparison function,
+ * inline for the integer and date/time types: the bound searches of run-time
+ * pruning and tuple routing call this at every step, and with thousands of
+ * partitions the function calls would dominate them.
+ */
+static inline int32
+partition_key_cmp(FmgrInfo *cmpfn, Oid collation, Datum a, Datum b)
+{
+	if (cmpfn->fn_addr == btint4cmp || cmpfn->fn_addr == date_cmp)
+	{
+		int32		x = DatumGetInt32(a);
+		int32		y = DatumGetInt32(b);
+
+		return x < y ? -1 : (x > y ? 1 : 0);
+	}
+	if (cmpfn->fn_addr == btint8cmp || cmpfn->fn_addr == timestamp_cmp)
+	{
+		int64		x = DatumGetInt64(a);
+		int64		y = DatumGetInt64(b);
+
+		return x < y ? -1 : (x > y ? 1 : 0);
+	}
+	if (cmpfn->fn_addr == btoidcmp)
+	{
+		Oid			x = DatumGetObjectId(a);
+		Oid			y = DatumGetObjectId(b);
+
+		return x < y ? -1 : (x > y ? 1 : 0);
+	}
+	return DatumGetInt32(FunctionCall2Coll(cmpfn, collation, a, b));
+}
+
 /*
  * partition_rbound_cmp
  *
@@ -3364,10 +3399,8 @@ partition_rbound_cmp(int partnatts, FmgrInfo *partsupfunc,
 			 */
 			break;
 
-		cmpval = DatumGetInt32(FunctionCall2Coll(&partsupfunc[i],
-												 partcollation[i],
-												 datums1[i],
-												 datums2[i]));
+		cmpval = partition_key_cmp(&partsupfunc[i], partcollation[i],
+								   datums1[i], datums2[i]);
 		if (cmpval != 0)
 			break;
 	}
@@ -3410,10 +3443,8 @@ partition_rbound_datum_cmp(FmgrInfo *partsupfunc, Oid *partcollation,
 		else if (rb_kind[i] == PARTITION_RANGE_DATUM_MAXVALUE)
 			return 1;
 
-		cmpval = DatumGetInt32(FunctionCall2Coll(&partsupfunc[i],
-												 partcollation[i],
-												 rb_datums[i],
-												 tuple_datums[i]));
+		cmpval = partition_key_cmp(&partsupfunc[i], partcollation[i],
+								   rb_datums[i], tuple_datums[i]);
 		if (cmpval != 0)
 			break;
 	}
@@ -3462,10 +3493,8 @@ partition_list_bsearch(FmgrInfo *partsupfunc, Oid *partcollation,
 		int32		cmpval;
 
 		mid = (lo + hi + 1) / 2;
-		cmpval = DatumGetInt32(FunctionCall2Coll(&partsupfunc[0],
-												 partcollation[0],
-												 boundinfo->datums[mid][0],
-												 value));
+		cmpval = partition_key_cmp(&partsupfunc[0], partcollation[0],
+								   boundinfo->datums[mid][0], value);
 		if (cmpval <= 0)
 		{
 			lo = mid;
@@ -2744,19 +2744,10 @@ static PgStat_StatTabEntry *
 get_pgstat_tabentry_relid(Oid relid, bool isshared, PgStat_StatDBEntry *shared,
 						  PgStat_StatDBEntry *dbentry)
 {
-	PgStat_StatTabEntry *tabentry = NULL;
-
-	if (isshared)
-	{
-		if (PointerIsValid(shared))
-			tabentry = hash_search(shared->tables, &relid,
-								   HASH_FIND, NULL);
-	}
-	else if (PointerIsValid(dbentry))
-		tabentry = hash_search(dbentry->tables, &relid,
-							   HASH_FIND, NULL);
+	if (!PointerIsValid(isshared ? shared : dbentry))
+		return NULL;
 
-	return tabentry;
+	return pgstat_fetch_stat_tabentry_ext(isshared, relid);
 }
 
 /*
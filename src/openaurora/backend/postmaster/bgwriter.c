@@ -42,6 +42,8 @@
 #include "postmaster/bgwriter.h"
 #include "postmaster/interrupt.h"
 #include "storage/buf_internals.h"
+#include "storage/buf_resident_summary.h"
+#include "storage/buf_warm_start.h"
 #include "storage/bufmgr.h"
 #include "storage/condition_variable.h"
 #include "storage/fd.h"
@@ -233,6 +235,16 @@ BackgroundWriterMain(void)
 		 */
 		can_hibernate = BgBufferSync(&wb_context);
 
+		/*
+		 * Record the buffers in use for the warm start of the next node
+		 */
+		BufWarmStartRecordIfDue();
+
+		/*
+		 * Tell the storage node which pages need no background replay yet
+		 */
+		BufResidentSummaryPublishIfDue();
+
 		/*
 		 * Send off activity statistics to the stats collector
 		 */
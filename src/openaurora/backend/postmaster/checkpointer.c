@@ -563,6 +563,8 @@ HandleCheckpointerInterrupts(void)
 		ExitOnAnyError = true;
 		/* Close down the database */
 		ShutdownXLOG(0, 0);
+		/* Save the shared table statistics for the next start */
+		pgstat_save_shared_stats();
 		/* Normal exit from the checkpointer is here */
 		proc_exit(0);			/* done */
 	}
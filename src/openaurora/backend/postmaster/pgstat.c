@@ -60,6 +60,7 @@
 #include "storage/lmgr.h"
 #include "storage/pg_shmem.h"
 #include "storage/procsignal.h"
+#include "storage/shmem.h"
 #include "storage/sinvaladt.h"
 #include "utils/ascii.h"
 #include "utils/guc.h"
@@ -105,6 +106,13 @@
 #define PGSTAT_TAB_HASH_SIZE	512
 #define PGSTAT_FUNCTION_HASH_SIZE	512
 
+/* ----------
+ * The shared statistics tables.  PGSTAT_NUM_PARTITIONS must be a power of 2.
+ * ----------
+ */
+#define PGSTAT_NUM_PARTITIONS	16
+#define PGSTAT_SHARED_DB_HASH_SIZE	128
+
 
 /* ----------
  * Total number of backends including auxiliary
@@ -126,6 +134,7 @@ bool		pgstat_track_activities = false;
 bool		pgstat_track_counts = false;
 int			pgstat_track_functions = TRACK_FUNC_OFF;
 int			pgstat_track_activity_query_size = 1024;
+int			pgstat_max_tables = 16384;
 
 /* ----------
  * Built from GUC parameter
@@ -264,10 +273,44 @@ typedef struct TwoPhasePgStatRecord
 } TwoPhasePgStatRecord;
 
 /*
- * Info about current "snapshot" of stats file
+ * Info about current "snapshot" of the statistics: the copies of the shared
+ * entries read in this transaction, and whether the collector's stats file
+ * has been read.
  */
 static MemoryContext pgStatLocalContext = NULL;
 static HTAB *pgStatDBHash = NULL;
+static bool pgStatGlobalsRead = false;
+
+/*
+ * The shared statistics tables, see CreateSharedStats().  They are NULL in
+ * processes not attached to the main shared memory segment, which then keep
+ * no database, table or function statistics.
+ */
+typedef struct PgStat_SharedKey
+{
+	Oid			databaseid;		/* InvalidOid for shared catalogs */
+	Oid			objectid;		/* table or function */
+} PgStat_SharedKey;
+
+typedef struct PgStat_SharedTabEntry
+{
+	PgStat_SharedKey key;
+	PgStat_StatTabEntry stats;
+} PgStat_SharedTabEntry;
+
+typedef struct PgStat_SharedFuncEntry
+{
+	PgStat_SharedKey key;
+	PgStat_StatFuncEntry stats;
+} PgStat_SharedFuncEntry;
+
+static LWLockPadded *pgStatPartitionLocks = NULL;
+static HTAB *pgStatSharedDBHash = NULL;
+static HTAB *pgStatSharedTabHash = NULL;
+static HTAB *pgStatSharedFuncHash = NULL;
+
+#define PgStatPartitionLock(hashcode) \
+	(&pgStatPartitionLocks[(hashcode) % PGSTAT_NUM_PARTITIONS].lock)
 
 /* Status for backends including auxiliary */
 static LocalPgBackendStatus *localBackendStatusTable = NULL;
@@ -278,18 +321,16 @@ static int	localNumBackends = 0;
 /*
  * Cluster wide statistics, kept in the stats collector.
  * Contains statistics that are not collected per database
- * or per table.
+ * or per table; those are kept in shared memory.
  */
 static PgStat_ArchiverStats archiverStats;
 static PgStat_GlobalStats globalStats;
 static PgStat_SLRUStats slruStats[SLRU_NUM_ELEMENTS];
 
 /*
- * List of OIDs of databases we need to write out.  If an entry is InvalidOid,
- * it means to write only the shared-catalog stats ("DB 0"); otherwise, we
- * will write both that DB's data and the shared stats.
+ * Whether a backend asked for a newer stats file than the last one written.
  */
-static List *pending_write_requests = NIL;
+static bool pending_write_request = false;
 
 /*
  * Total time charged to functions so far in the current backend.
@@ -310,18 +351,31 @@ static pid_t pgstat_forkexec(void);
 NON_EXEC_STATIC void PgstatCollectorMain(int argc, char *argv[]) pg_attribute_noreturn();
 static void pgstat_beshutdown_hook(int code, Datum arg);
 
-static PgStat_StatDBEntry *pgstat_get_db_entry(Oid databaseid, bool create);
-static PgStat_StatTabEntry *pgstat_get_tab_entry(PgStat_StatDBEntry *dbentry,
-												 Oid tableoid, bool create);
-static void pgstat_write_statsfiles(bool permanent, bool allDbs);
-static void pgstat_write_db_statsfile(PgStat_StatDBEntry *dbentry, bool permanent);
-static HTAB *pgstat_read_statsfiles(Oid onlydb, bool permanent, bool deep);
-static void pgstat_read_db_statsfile(Oid databaseid, HTAB *tabhash, HTAB *funchash, bool permanent);
+static PgStat_StatDBEntry *pgstat_lock_db_entry(Oid databaseid, bool create,
+												LWLockMode mode, LWLock **lock);
+static PgStat_StatTabEntry *pgstat_lock_tab_entry(Oid databaseid, Oid tableoid,
+												  bool create, LWLockMode mode,
+												  LWLock **lock);
+static PgStat_StatFuncEntry *pgstat_lock_func_entry(Oid databaseid,
+													Oid functionid,
+													bool create,
+													LWLockMode mode,
+													LWLock **lock);
+static void pgstat_ensure_db_entry(Oid databaseid);
+static void pgstat_lock_all_partitions(LWLockMode mode);
+static void pgstat_unlock_all_partitions(void);
+static void pgstat_remove_shared_entry(HTAB *htab, Oid databaseid, Oid objectid);
+static void pgstat_remove_db_objects(Oid databaseid);
+static List *pgstat_shared_oids(HTAB *htab, Oid databaseid);
+static PgStat_StatDBEntry *pgstat_snapshot_db_entry(Oid databaseid);
+static PgStat_StatTabEntry *pgstat_snapshot_tab_entry(Oid databaseid, Oid tableoid);
+static PgStat_StatFuncEntry *pgstat_snapshot_func_entry(Oid databaseid, Oid functionid);
+static void pgstat_write_statsfile(bool permanent);
+static void pgstat_read_statsfile(bool permanent);
 static void backend_read_statsfile(void);
 static void pgstat_read_current_status(void);
 
 static bool pgstat_write_statsfile_needed(void);
-static bool pgstat_db_requested(Oid databaseid);
 
 static void pgstat_send_tabstat(PgStat_MsgTabstat *tsmsg);
 static void pgstat_send_funcstats(void);
@@ -342,25 +396,24 @@ static void pgstat_setheader(PgStat_MsgHdr *hdr, StatMsgType mtype);
 static void pgstat_send(void *msg, int len);
 
 static void pgstat_recv_inquiry(PgStat_MsgInquiry *msg, int len);
-static void pgstat_recv_tabstat(PgStat_MsgTabstat *msg, int len);
-static void pgstat_recv_tabpurge(PgStat_MsgTabpurge *msg, int len);
-static void pgstat_recv_dropdb(PgStat_MsgDropdb *msg, int len);
-static void pgstat_recv_resetcounter(PgStat_MsgResetcounter *msg, int len);
 static void pgstat_recv_resetsharedcounter(PgStat_MsgResetsharedcounter *msg, int len);
-static void pgstat_recv_resetsinglecounter(PgStat_MsgResetsinglecounter *msg, int len);
 static void pgstat_recv_resetslrucounter(PgStat_MsgResetslrucounter *msg, int len);
-static void pgstat_recv_autovac(PgStat_MsgAutovacStart *msg, int len);
-static void pgstat_recv_vacuum(PgStat_MsgVacuum *msg, int len);
-static void pgstat_recv_analyze(PgStat_MsgAnalyze *msg, int len);
 static void pgstat_recv_archiver(PgStat_MsgArchiver *msg, int len);
 static void pgstat_recv_bgwriter(PgStat_MsgBgWriter *msg, int len);
 static void pgstat_recv_slru(PgStat_MsgSLRU *msg, int len);
-static void pgstat_recv_funcstat(PgStat_MsgFuncstat *msg, int len);
-static void pgstat_recv_funcpurge(PgStat_MsgFuncpurge *msg, int len);
-static void pgstat_recv_recoveryconflict(PgStat_MsgRecoveryConflict *msg, int len);
-static void pgstat_recv_deadlock(PgStat_MsgDeadlock *msg, int len);
-static void pgstat_recv_checksum_failure(PgStat_MsgChecksumFailure *msg, int len);
-static void pgstat_recv_tempfile(PgStat_MsgTempFile *msg, int len);
+
+static void pgstat_apply_tabstat(PgStat_MsgTabstat *msg);
+static void pgstat_apply_dropdb(PgStat_MsgDropdb *msg);
+static void pgstat_apply_resetcounter(PgStat_MsgResetcounter *msg);
+static void pgstat_apply_resetsinglecounter(PgStat_MsgResetsinglecounter *msg);
+static void pgstat_apply_autovac(PgStat_MsgAutovacStart *msg);
+static void pgstat_apply_vacuum(PgStat_MsgVacuum *msg);
+static void pgstat_apply_analyze(PgStat_MsgAnalyze *msg);
+static void pgstat_apply_funcstat(PgStat_MsgFuncstat *msg);
+static void pgstat_apply_recoveryconflict(PgStat_MsgRecoveryConflict *msg);
+static void pgstat_apply_deadlock(PgStat_MsgDeadlock *msg);
+static void pgstat_apply_checksum_failure(PgStat_MsgChecksumFailure *msg);
+static void pgstat_apply_tempfile(PgStat_MsgTempFile *msg);
 
 /* ------------------------------------------------------------
  * Public functions called from postmaster follow
@@ -676,10 +729,13 @@ pgstat_reset_remove_files(const char *directory)
 
 		/*
 		 * Skip directory entries that don't match the file names we write.
-		 * See get_dbstat_filename for the database-specific pattern.
+		 * The db_<oid> files are left by older versions, which kept each
+		 * database's statistics in a file of its own.
 		 */
 		if (strncmp(entry->d_name, "global.", 7) == 0)
 			nchars = 7;
+		else if (strncmp(entry->d_name, "objects.", 8) == 0)
+			nchars = 8;
 		else
 		{
 			nchars = 0;
@@ -830,10 +886,11 @@ allow_immediate_pgstat_restart(void)
  * pgstat_report_stat() -
  *
  *	Must be called by processes that performs DML: tcop/postgres.c, logical
- *	receiver processes, SPI worker, etc. to send the so far collected
- *	per-table and function usage statistics to the collector.  Note that this
- *	is called only when not within a transaction, so it is fair to use
- *	transaction stop time as an approximation of current time.
+ *	receiver processes, SPI worker, etc. to add the so far collected
+ *	per-table and function usage statistics to the shared ones, and to send
+ *	the SLRU ones to the collector.  Note that this is called only when not
+ *	within a transaction, so it is fair to use transaction stop time as an
+ *	approximation of current time.
  * ----------
  */
 void
@@ -856,8 +913,9 @@ pgstat_report_stat(bool force)
 		return;
 
 	/*
-	 * Don't send a message unless it's been at least PGSTAT_STAT_INTERVAL
-	 * msec since we last sent one, or the caller wants to force stats out.
+	 * Don't flush the counts unless it's been at least PGSTAT_STAT_INTERVAL
+	 * msec since we last did, or the caller wants to force stats out.  Each
+	 * flush takes the partition locks of the objects it counts.
 	 */
 	now = GetCurrentTransactionStopTimestamp();
 	if (!force &&
@@ -878,7 +936,7 @@ pgstat_report_stat(bool force)
 
 	/*
 	 * Scan through the TabStatusArray struct(s) to find tables that actually
-	 * have counts, and build messages to send.  We have to separate shared
+	 * have counts, and build messages to apply.  We have to separate shared
 	 * relations from regular ones because the databaseid field in the message
 	 * header has to depend on that.
 	 */
@@ -907,7 +965,8 @@ pgstat_report_stat(bool force)
 				continue;
 
 			/*
-			 * OK, insert data into the appropriate message, and send if full.
+			 * OK, insert data into the appropriate message, and apply if
+			 * full.
 			 */
 			this_msg = entry->t_shared ? &shared_msg : &regular_msg;
 			this_ent = &this_msg->m_entry[this_msg->m_nentries];
@@ -927,8 +986,8 @@ pgstat_report_stat(bool force)
 	}
 
 	/*
-	 * Send partial messages.  Make sure that any pending xact commit/abort
-	 * gets counted, even if there are no table stats to send.
+	 * Apply partial messages.  Make sure that any pending xact commit/abort
+	 * gets counted, even if there are no table stats to apply.
 	 */
 	if (regular_msg.m_nentries > 0 ||
 		pgStatXactCommit > 0 || pgStatXactRollback > 0)
@@ -936,7 +995,7 @@ pgstat_report_stat(bool force)
 	if (shared_msg.m_nentries > 0)
 		pgstat_send_tabstat(&shared_msg);
 
-	/* Now, send function statistics */
+	/* Now, apply function statistics */
 	pgstat_send_funcstats();
 
 	/* Finally send SLRU statistics */
@@ -944,21 +1003,17 @@ pgstat_report_stat(bool force)
 }
 
 /*
- * Subroutine for pgstat_report_stat: finish and send a tabstat message
+ * Subroutine for pgstat_report_stat: finish and apply a tabstat message
  */
 static void
 pgstat_send_tabstat(PgStat_MsgTabstat *tsmsg)
 {
-	int			n;
-	int			len;
-
-	/* It's unlikely we'd get here with no socket, but maybe not impossible */
-	if (pgStatSock == PGINVALID_SOCKET)
+	if (pgStatSharedDBHash == NULL)
 		return;
 
 	/*
 	 * Report and reset accumulated xact commit/rollback and I/O timings
-	 * whenever we send a normal tabstat message
+	 * whenever we apply a normal tabstat message
 	 */
 	if (OidIsValid(tsmsg->m_databaseid))
 	{
@@ -979,16 +1034,11 @@ pgstat_send_tabstat(PgStat_MsgTabstat *tsmsg)
 		tsmsg->m_block_write_time = 0;
 	}
 
-	n = tsmsg->m_nentries;
-	len = offsetof(PgStat_MsgTabstat, m_entry[0]) +
-		n * sizeof(PgStat_TableEntry);
-
-	pgstat_setheader(&tsmsg->m_hdr, PGSTAT_MTYPE_TABSTAT);
-	pgstat_send(tsmsg, len);
+	pgstat_apply_tabstat(tsmsg);
 }
 
 /*
- * Subroutine for pgstat_report_stat: populate and send a function stat message
+ * Subroutine for pgstat_report_stat: populate and apply a function stat message
  */
 static void
 pgstat_send_funcstats(void)
@@ -1000,10 +1050,9 @@ pgstat_send_funcstats(void)
 	PgStat_BackendFunctionEntry *entry;
 	HASH_SEQ_STATUS fstat;
 
-	if (pgStatFunctions == NULL)
+	if (pgStatFunctions == NULL || pgStatSharedDBHash == NULL)
 		return;
 
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_FUNCSTAT);
 	msg.m_databaseid = MyDatabaseId;
 	msg.m_nentries = 0;
 
@@ -1026,8 +1075,7 @@ pgstat_send_funcstats(void)
 
 		if (++msg.m_nentries >= PGSTAT_NUM_FUNCENTRIES)
 		{
-			pgstat_send(&msg, offsetof(PgStat_MsgFuncstat, m_entry[0]) +
-						msg.m_nentries * sizeof(PgStat_FunctionEntry));
+			pgstat_apply_funcstat(&msg);
 			msg.m_nentries = 0;
 		}
 
@@ -1036,8 +1084,7 @@ pgstat_send_funcstats(void)
 	}
 
 	if (msg.m_nentries > 0)
-		pgstat_send(&msg, offsetof(PgStat_MsgFuncstat, m_entry[0]) +
-					msg.m_nentries * sizeof(PgStat_FunctionEntry));
+		pgstat_apply_funcstat(&msg);
 
 	have_function_stats = false;
 }
@@ -1046,43 +1093,31 @@ pgstat_send_funcstats(void)
 /* ----------
  * pgstat_vacuum_stat() -
  *
- *	Will tell the collector about objects he can get rid of.
+ *	Remove the statistics of objects that don't exist anymore.
  * ----------
  */
 void
 pgstat_vacuum_stat(void)
 {
 	HTAB	   *htab;
-	PgStat_MsgTabpurge msg;
-	PgStat_MsgFuncpurge f_msg;
-	HASH_SEQ_STATUS hstat;
-	PgStat_StatDBEntry *dbentry;
-	PgStat_StatTabEntry *tabentry;
-	PgStat_StatFuncEntry *funcentry;
-	int			len;
+	List	   *oids;
+	ListCell   *lc;
 
-	if (pgStatSock == PGINVALID_SOCKET)
+	if (pgStatSharedDBHash == NULL)
 		return;
 
-	/*
-	 * If not done for this transaction, read the statistics collector stats
-	 * file into some hash tables.
-	 */
-	backend_read_statsfile();
-
 	/*
 	 * Read pg_database and make a list of OIDs of all existing databases
 	 */
 	htab = pgstat_collect_oids(DatabaseRelationId, Anum_pg_database_oid);
 
 	/*
-	 * Search the database hash table for dead databases and tell the
-	 * collector to drop them.
+	 * Search the shared database table for dead databases and drop them.
 	 */
-	hash_seq_init(&hstat, pgStatDBHash);
-	while ((dbentry = (PgStat_StatDBEntry *) hash_seq_search(&hstat)) != NULL)
+	oids = pgstat_shared_oids(pgStatSharedDBHash, InvalidOid);
+	foreach(lc, oids)
 	{
-		Oid			dbid = dbentry->databaseid;
+		Oid			dbid = lfirst_oid(lc);
 
 		CHECK_FOR_INTERRUPTS();
 
@@ -1093,130 +1128,54 @@ pgstat_vacuum_stat(void)
 	}
 
 	/* Clean up */
+	list_free(oids);
 	hash_destroy(htab);
 
 	/*
-	 * Lookup our own database entry; if not found, nothing more to do.
-	 */
-	dbentry = (PgStat_StatDBEntry *) hash_search(pgStatDBHash,
-												 (void *) &MyDatabaseId,
-												 HASH_FIND, NULL);
-	if (dbentry == NULL || dbentry->tables == NULL)
-		return;
-
-	/*
-	 * Similarly to above, make a list of all known relations in this DB.
-	 */
-	htab = pgstat_collect_oids(RelationRelationId, Anum_pg_class_oid);
-
-	/*
-	 * Initialize our messages table counter to zero
+	 * Collect the tables of our own database that have stats, and check if
+	 * they still exist.  If there are none, skip reading pg_class.
 	 */
-	msg.m_nentries = 0;
-
-	/*
-	 * Check for all tables listed in stats hashtable if they still exist.
-	 */
-	hash_seq_init(&hstat, dbentry->tables);
-	while ((tabentry = (PgStat_StatTabEntry *) hash_seq_search(&hstat)) != NULL)
+	oids = pgstat_shared_oids(pgStatSharedTabHash, MyDatabaseId);
+	if (oids != NIL)
 	{
-		Oid			tabid = tabentry->tableid;
-
-		CHECK_FOR_INTERRUPTS();
-
-		if (hash_search(htab, (void *) &tabid, HASH_FIND, NULL) != NULL)
-			continue;
+		htab = pgstat_collect_oids(RelationRelationId, Anum_pg_class_oid);
 
-		/*
-		 * Not there, so add this table's Oid to the message
-		 */
-		msg.m_tableid[msg.m_nentries++] = tabid;
-
-		/*
-		 * If the message is full, send it out and reinitialize to empty
-		 */
-		if (msg.m_nentries >= PGSTAT_NUM_TABPURGE)
+		foreach(lc, oids)
 		{
-			len = offsetof(PgStat_MsgTabpurge, m_tableid[0])
-				+ msg.m_nentries * sizeof(Oid);
+			Oid			tabid = lfirst_oid(lc);
 
-			pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_TABPURGE);
-			msg.m_databaseid = MyDatabaseId;
-			pgstat_send(&msg, len);
+			CHECK_FOR_INTERRUPTS();
 
-			msg.m_nentries = 0;
+			if (hash_search(htab, (void *) &tabid, HASH_FIND, NULL) == NULL)
+				pgstat_remove_shared_entry(pgStatSharedTabHash,
+										   MyDatabaseId, tabid);
 		}
-	}
 
-	/*
-	 * Send the rest
-	 */
-	if (msg.m_nentries > 0)
-	{
-		len = offsetof(PgStat_MsgTabpurge, m_tableid[0])
-			+ msg.m_nentries * sizeof(Oid);
-
-		pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_TABPURGE);
-		msg.m_databaseid = MyDatabaseId;
-		pgstat_send(&msg, len);
+		list_free(oids);
+		hash_destroy(htab);
 	}
 
-	/* Clean up */
-	hash_destroy(htab);
-
 	/*
-	 * Now repeat the above steps for functions.  However, we needn't bother
+	 * Now repeat the above steps for functions.  Again we needn't bother
 	 * in the common case where no function stats are being collected.
 	 */
-	if (dbentry->functions != NULL &&
-		hash_get_num_entries(dbentry->functions) > 0)
+	oids = pgstat_shared_oids(pgStatSharedFuncHash, MyDatabaseId);
+	if (oids != NIL)
 	{
 		htab = pgstat_collect_oids(ProcedureRelationId, Anum_pg_proc_oid);
 
-		pgstat_setheader(&f_msg.m_hdr, PGSTAT_MTYPE_FUNCPURGE);
-		f_msg.m_databaseid = MyDatabaseId;
-		f_msg.m_nentries = 0;
-
-		hash_seq_init(&hstat, dbentry->functions);
-		while ((funcentry = (PgStat_StatFuncEntry *) hash_seq_search(&hstat)) != NULL)
+		foreach(lc, oids)
 		{
-			Oid			funcid = funcentry->functionid;
+			Oid			funcid = lfirst_oid(lc);
 
 			CHECK_FOR_INTERRUPTS();
 
-			if (hash_search(htab, (void *) &funcid, HASH_FIND, NULL) != NULL)
-				continue;
-
-			/*
-			 * Not there, so add this function's Oid to the message
-			 */
-			f_msg.m_functionid[f_msg.m_nentries++] = funcid;
-
-			/*
-			 * If the message is full, send it out and reinitialize to empty
-			 */
-			if (f_msg.m_nentries >= PGSTAT_NUM_FUNCPURGE)
-			{
-				len = offsetof(PgStat_MsgFuncpurge, m_functionid[0])
-					+ f_msg.m_nentries * sizeof(Oid);
-
-				pgstat_send(&f_msg, len);
-
-				f_msg.m_nentries = 0;
-			}
-		}
-
-		/*
-		 * Send the rest
-		 */
-		if (f_msg.m_nentries > 0)
-		{
-			len = offsetof(PgStat_MsgFuncpurge, m_functionid[0])
-				+ f_msg.m_nentries * sizeof(Oid);
-
-			pgstat_send(&f_msg, len);
+			if (hash_search(htab, (void *) &funcid, HASH_FIND, NULL) == NULL)
+				pgstat_remove_shared_entry(pgStatSharedFuncHash,
+										   MyDatabaseId, funcid);
 		}
 
+		list_free(oids);
 		hash_destroy(htab);
 	}
 }
@@ -1276,9 +1235,9 @@ pgstat_collect_oids(Oid catalogid, AttrNumber anum_oid)
 /* ----------
  * pgstat_drop_database() -
  *
- *	Tell the collector that we just dropped a database.
- *	(If the message gets lost, we will still clean the dead DB eventually
- *	via future invocations of pgstat_vacuum_stat().)
+ *	Remove the statistics of a database we just dropped.
+ *	(If we fail before getting here, we will still clean the dead DB
+ *	eventually via future invocations of pgstat_vacuum_stat().)
  * ----------
  */
 void
@@ -1286,21 +1245,18 @@ pgstat_drop_database(Oid databaseid)
 {
 	PgStat_MsgDropdb msg;
 
-	if (pgStatSock == PGINVALID_SOCKET)
+	if (pgStatSharedDBHash == NULL)
 		return;
 
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_DROPDB);
 	msg.m_databaseid = databaseid;
-	pgstat_send(&msg, sizeof(msg));
+	pgstat_apply_dropdb(&msg);
 }
 
 
 /* ----------
  * pgstat_drop_relation() -
  *
- *	Tell the collector that we just dropped a relation.
- *	(If the message gets lost, we will still clean the dead entry eventually
- *	via future invocations of pgstat_vacuum_stat().)
+ *	Remove the statistics of a relation we just dropped.
  *
  *	Currently not used for lack of any good place to call it; we rely
  *	entirely on pgstat_vacuum_stat() to clean out stats for dead rels.
@@ -1310,20 +1266,10 @@ pgstat_drop_database(Oid databaseid)
 void
 pgstat_drop_relation(Oid relid)
 {
-	PgStat_MsgTabpurge msg;
-	int			len;
-
-	if (pgStatSock == PGINVALID_SOCKET)
+	if (pgStatSharedDBHash == NULL)
 		return;
 
-	msg.m_tableid[0] = relid;
-	msg.m_nentries = 1;
-
-	len = offsetof(PgStat_MsgTabpurge, m_tableid[0]) + sizeof(Oid);
-
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_TABPURGE);
-	msg.m_databaseid = MyDatabaseId;
-	pgstat_send(&msg, len);
+	pgstat_remove_shared_entry(pgStatSharedTabHash, MyDatabaseId, relid);
 }
 #endif							/* NOT_USED */
 
@@ -1331,7 +1277,7 @@ pgstat_drop_relation(Oid relid)
 /* ----------
  * pgstat_reset_counters() -
  *
- *	Tell the statistics collector to reset counters for our database.
+ *	Reset counters for our database.
  *
  *	Permission checking for this function is managed through the normal
  *	GRANT system.
@@ -1342,12 +1288,11 @@ pgstat_reset_counters(void)
 {
 	PgStat_MsgResetcounter msg;
 
-	if (pgStatSock == PGINVALID_SOCKET)
+	if (pgStatSharedDBHash == NULL)
 		return;
 
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_RESETCOUNTER);
 	msg.m_databaseid = MyDatabaseId;
-	pgstat_send(&msg, sizeof(msg));
+	pgstat_apply_resetcounter(&msg);
 #ifdef USE_MEMPOOL_STAT
 	ResetStatForMemPool();
 #endif
@@ -1367,6 +1312,13 @@ pgstat_reset_shared_counters(const char *target)
 {
 	PgStat_MsgResetsharedcounter msg;
 
+	/* The mempool counters live in shared memory, not in the collector */
+	if (strcmp(target, "mempool") == 0)
+	{
+		MemPoolStatReset();
+		return;
+	}
+
 	if (pgStatSock == PGINVALID_SOCKET)
 		return;
 
@@ -1378,7 +1330,7 @@ pgstat_reset_shared_counters(const char *target)
 		ereport(ERROR,
 				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
 				 errmsg("unrecognized reset target: \"%s\"", target),
-				 errhint("Target must be \"archiver\" or \"bgwriter\".")));
+				 errhint("Target must be \"archiver\", \"bgwriter\" or \"mempool\".")));
 
 	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_RESETSHAREDCOUNTER);
 	pgstat_send(&msg, sizeof(msg));
@@ -1387,7 +1339,7 @@ pgstat_reset_shared_counters(const char *target)
 /* ----------
  * pgstat_reset_single_counter() -
  *
- *	Tell the statistics collector to reset a single counter.
+ *	Reset a single counter.
  *
  *	Permission checking for this function is managed through the normal
  *	GRANT system.
@@ -1398,15 +1350,14 @@ pgstat_reset_single_counter(Oid objoid, PgStat_Single_Reset_Type type)
 {
 	PgStat_MsgResetsinglecounter msg;
 
-	if (pgStatSock == PGINVALID_SOCKET)
+	if (pgStatSharedDBHash == NULL)
 		return;
 
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_RESETSINGLECOUNTER);
 	msg.m_databaseid = MyDatabaseId;
 	msg.m_resettype = type;
 	msg.m_objectid = objoid;
 
-	pgstat_send(&msg, sizeof(msg));
+	pgstat_apply_resetsinglecounter(&msg);
 }
 
 /* ----------
@@ -1446,21 +1397,20 @@ pgstat_report_autovac(Oid dboid)
 {
 	PgStat_MsgAutovacStart msg;
 
-	if (pgStatSock == PGINVALID_SOCKET)
+	if (pgStatSharedDBHash == NULL)
 		return;
 
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_AUTOVAC_START);
 	msg.m_databaseid = dboid;
 	msg.m_start_time = GetCurrentTimestamp();
 
-	pgstat_send(&msg, sizeof(msg));
+	pgstat_apply_autovac(&msg);
 }
 
 
 /* ---------
  * pgstat_report_vacuum() -
  *
- *	Tell the collector about the table we just vacuumed.
+ *	Count the table we just vacuumed.
  * ---------
  */
 void
@@ -1469,23 +1419,22 @@ pgstat_report_vacuum(Oid tableoid, bool shared,
 {
 	PgStat_MsgVacuum msg;
 
-	if (pgStatSock == PGINVALID_SOCKET || !pgstat_track_counts)
+	if (pgStatSharedDBHash == NULL || !pgstat_track_counts)
 		return;
 
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_VACUUM);
 	msg.m_databaseid = shared ? InvalidOid : MyDatabaseId;
 	msg.m_tableoid = tableoid;
 	msg.m_autovacuum = IsAutoVacuumWorkerProcess();
 	msg.m_vacuumtime = GetCurrentTimestamp();
 	msg.m_live_tuples = livetuples;
 	msg.m_dead_tuples = deadtuples;
-	pgstat_send(&msg, sizeof(msg));
+	pgstat_apply_vacuum(&msg);
 }
 
 /* --------
  * pgstat_report_analyze() -
  *
- *	Tell the collector about the table we just analyzed.
+ *	Count the table we just analyzed.
  *
  * Caller must provide new live- and dead-tuples estimates, as well as a
  * flag indicating whether to reset the changes_since_analyze counter.
@@ -1498,7 +1447,7 @@ pgstat_report_analyze(Relation rel,
 {
 	PgStat_MsgAnalyze msg;
 
-	if (pgStatSock == PGINVALID_SOCKET || !pgstat_track_counts)
+	if (pgStatSharedDBHash == NULL || !pgstat_track_counts)
 		return;
 
 	/*
@@ -1506,9 +1455,9 @@ pgstat_report_analyze(Relation rel,
 	 * already inserted and/or deleted rows in the target table. ANALYZE will
 	 * have counted such rows as live or dead respectively. Because we will
 	 * report our counts of such rows at transaction end, we should subtract
-	 * off these counts from what we send to the collector now, else they'll
-	 * be double-counted after commit.  (This approach also ensures that the
-	 * collector ends up with the right numbers if we abort instead of
+	 * off these counts from what we store now, else they'll be
+	 * double-counted after commit.  (This approach also ensures that the
+	 * shared stats end up with the right numbers if we abort instead of
 	 * committing.)
 	 */
 	if (rel->pgstat_info != NULL)
@@ -1527,7 +1476,6 @@ pgstat_report_analyze(Relation rel,
 		deadtuples = Max(deadtuples, 0);
 	}
 
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_ANALYZE);
 	msg.m_databaseid = rel->rd_rel->relisshared ? InvalidOid : MyDatabaseId;
 	msg.m_tableoid = RelationGetRelid(rel);
 	msg.m_autovacuum = IsAutoVacuumWorkerProcess();
@@ -1535,13 +1483,13 @@ pgstat_report_analyze(Relation rel,
 	msg.m_analyzetime = GetCurrentTimestamp();
 	msg.m_live_tuples = livetuples;
 	msg.m_dead_tuples = deadtuples;
-	pgstat_send(&msg, sizeof(msg));
+	pgstat_apply_analyze(&msg);
 }
 
 /* --------
  * pgstat_report_recovery_conflict() -
  *
- *	Tell the collector about a Hot Standby recovery conflict.
+ *	Count a Hot Standby recovery conflict.
  * --------
  */
 void
@@ -1549,19 +1497,18 @@ pgstat_report_recovery_conflict(int reason)
 {
 	PgStat_MsgRecoveryConflict msg;
 
-	if (pgStatSock == PGINVALID_SOCKET || !pgstat_track_counts)
+	if (pgStatSharedDBHash == NULL || !pgstat_track_counts)
 		return;
 
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_RECOVERYCONFLICT);
 	msg.m_databaseid = MyDatabaseId;
 	msg.m_reason = reason;
-	pgstat_send(&msg, sizeof(msg));
+	pgstat_apply_recoveryconflict(&msg);
 }
 
 /* --------
  * pgstat_report_deadlock() -
  *
- *	Tell the collector about a deadlock detected.
+ *	Count a deadlock detected.
  * --------
  */
 void
@@ -1569,12 +1516,11 @@ pgstat_report_deadlock(void)
 {
 	PgStat_MsgDeadlock msg;
 
-	if (pgStatSock == PGINVALID_SOCKET || !pgstat_track_counts)
+	if (pgStatSharedDBHash == NULL || !pgstat_track_counts)
 		return;
 
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_DEADLOCK);
 	msg.m_databaseid = MyDatabaseId;
-	pgstat_send(&msg, sizeof(msg));
+	pgstat_apply_deadlock(&msg);
 }
 
 
@@ -1582,7 +1528,7 @@ pgstat_report_deadlock(void)
 /* --------
  * pgstat_report_checksum_failures_in_db() -
  *
- *	Tell the collector about one or more checksum failures.
+ *	Count one or more checksum failures.
  * --------
  */
 void
@@ -1590,21 +1536,20 @@ pgstat_report_checksum_failures_in_db(Oid dboid, int failurecount)
 {
 	PgStat_MsgChecksumFailure msg;
 
-	if (pgStatSock == PGINVALID_SOCKET || !pgstat_track_counts)
+	if (pgStatSharedDBHash == NULL || !pgstat_track_counts)
 		return;
 
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_CHECKSUMFAILURE);
 	msg.m_databaseid = dboid;
 	msg.m_failurecount = failurecount;
 	msg.m_failure_time = GetCurrentTimestamp();
 
-	pgstat_send(&msg, sizeof(msg));
+	pgstat_apply_checksum_failure(&msg);
 }
 
 /* --------
  * pgstat_report_checksum_failure() -
  *
- *	Tell the collector about a checksum failure.
+ *	Count a checksum failure.
  * --------
  */
 void
@@ -1616,7 +1561,7 @@ pgstat_report_checksum_failure(void)
 /* --------
  * pgstat_report_tempfile() -
  *
- *	Tell the collector about a temporary file.
+ *	Count a temporary file.
  * --------
  */
 void
@@ -1624,13 +1569,12 @@ pgstat_report_tempfile(size_t filesize)
 {
 	PgStat_MsgTempFile msg;
 
-	if (pgStatSock == PGINVALID_SOCKET || !pgstat_track_counts)
+	if (pgStatSharedDBHash == NULL || !pgstat_track_counts)
 		return;
 
-	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_TEMPFILE);
 	msg.m_databaseid = MyDatabaseId;
 	msg.m_filesize = filesize;
-	pgstat_send(&msg, sizeof(msg));
+	pgstat_apply_tempfile(&msg);
 }
 
 
@@ -1659,14 +1603,14 @@ pgstat_ping(void)
  * ----------
  */
 static void
-pgstat_send_inquiry(TimestampTz clock_time, TimestampTz cutoff_time, Oid databaseid)
+pgstat_send_inquiry(TimestampTz clock_time, TimestampTz cutoff_time)
 {
 	PgStat_MsgInquiry msg;
 
 	pgstat_setheader(&msg.m_hdr, PGSTAT_MTYPE_INQUIRY);
 	msg.clock_time = clock_time;
 	msg.cutoff_time = cutoff_time;
-	msg.databaseid = databaseid;
+	msg.databaseid = InvalidOid;
 	pgstat_send(&msg, sizeof(msg));
 }
 
@@ -2476,30 +2420,193 @@ pgstat_twophase_postabort(TransactionId xid, uint16 info,
 }
 
 
+/* ----------
+ * pgstat_snapshot_db_entry() -
+ *
+ *	Return this transaction's copy of the shared entry of a database,
+ *	taking it on first use, or NULL if there is none.  The copies are kept
+ *	until pgstat_clear_snapshot() is called.
+ * ----------
+ */
+static PgStat_StatDBEntry *
+pgstat_snapshot_db_entry(Oid databaseid)
+{
+	PgStat_StatDBEntry *dbentry;
+	PgStat_StatDBEntry *shared;
+	PgStat_StatDBEntry dbbuf;
+	LWLock	   *lock;
+
+	if (pgStatSharedDBHash == NULL)
+		return NULL;
+
+	if (pgStatDBHash == NULL)
+	{
+		HASHCTL		hash_ctl;
+
+		pgstat_setup_memcxt();
+
+		memset(&hash_ctl, 0, sizeof(hash_ctl));
+		hash_ctl.keysize = sizeof(Oid);
+		hash_ctl.entrysize = sizeof(PgStat_StatDBEntry);
+		hash_ctl.hcxt = pgStatLocalContext;
+		pgStatDBHash = hash_create("Databases hash", PGSTAT_DB_HASH_SIZE,
+								   &hash_ctl,
+								   HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	}
+
+	dbentry = (PgStat_StatDBEntry *) hash_search(pgStatDBHash,
+												 (void *) &databaseid,
+												 HASH_FIND, NULL);
+	if (dbentry != NULL)
+		return dbentry;
+
+	shared = pgstat_lock_db_entry(databaseid, false, LW_SHARED, &lock);
+	if (shared == NULL)
+		return NULL;
+	memcpy(&dbbuf, shared, sizeof(dbbuf));
+	LWLockRelease(lock);
+
+	/* The shared entry has no tables or functions hashes, nor has the copy */
+	dbentry = (PgStat_StatDBEntry *) hash_search(pgStatDBHash,
+												 (void *) &databaseid,
+												 HASH_ENTER, NULL);
+	memcpy(dbentry, &dbbuf, sizeof(dbbuf));
+
+	return dbentry;
+}
+
+
+/* ----------
+ * pgstat_snapshot_tab_entry() -
+ *
+ *	Likewise for the shared entry of a table, which is kept in the tables
+ *	hash of the copy of its database's entry.
+ * ----------
+ */
+static PgStat_StatTabEntry *
+pgstat_snapshot_tab_entry(Oid databaseid, Oid tableoid)
+{
+	PgStat_StatDBEntry *dbentry;
+	PgStat_StatTabEntry *tabentry;
+	PgStat_StatTabEntry *shared;
+	PgStat_StatTabEntry tabbuf;
+	LWLock	   *lock;
+
+	/* Tables only have entries in databases that have one */
+	dbentry = pgstat_snapshot_db_entry(databaseid);
+	if (dbentry == NULL)
+		return NULL;
+
+	if (dbentry->tables != NULL)
+	{
+		tabentry = (PgStat_StatTabEntry *) hash_search(dbentry->tables,
+													   (void *) &tableoid,
+													   HASH_FIND, NULL);
+		if (tabentry != NULL)
+			return tabentry;
+	}
+
+	shared = pgstat_lock_tab_entry(databaseid, tableoid, false, LW_SHARED,
+								   &lock);
+	if (shared == NULL)
+		return NULL;
+	memcpy(&tabbuf, shared, sizeof(tabbuf));
+	LWLockRelease(lock);
+
+	if (dbentry->tables == NULL)
+	{
+		HASHCTL		hash_ctl;
+
+		memset(&hash_ctl, 0, sizeof(hash_ctl));
+		hash_ctl.keysize = sizeof(Oid);
+		hash_ctl.entrysize = sizeof(PgStat_StatTabEntry);
+		hash_ctl.hcxt = pgStatLocalContext;
+		dbentry->tables = hash_create("Per-database table",
+									  PGSTAT_TAB_HASH_SIZE,
+									  &hash_ctl,
+									  HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	}
+
+	tabentry = (PgStat_StatTabEntry *) hash_search(dbentry->tables,
+												   (void *) &tableoid,
+												   HASH_ENTER, NULL);
+	memcpy(tabentry, &tabbuf, sizeof(tabbuf));
+
+	return tabentry;
+}
+
+
+/* ----------
+ * pgstat_snapshot_func_entry() -
+ *
+ *	Likewise for the shared entry of a function.
+ * ----------
+ */
+static PgStat_StatFuncEntry *
+pgstat_snapshot_func_entry(Oid databaseid, Oid functionid)
+{
+	PgStat_StatDBEntry *dbentry;
+	PgStat_StatFuncEntry *funcentry;
+	PgStat_StatFuncEntry *shared;
+	PgStat_StatFuncEntry funcbuf;
+	LWLock	   *lock;
+
+	dbentry = pgstat_snapshot_db_entry(databaseid);
+	if (dbentry == NULL)
+		return NULL;
+
+	if (dbentry->functions != NULL)
+	{
+		funcentry = (PgStat_StatFuncEntry *) hash_search(dbentry->functions,
+														 (void *) &functionid,
+														 HASH_FIND, NULL);
+		if (funcentry != NULL)
+			return funcentry;
+	}
+
+	shared = pgstat_lock_func_entry(databaseid, functionid, false, LW_SHARED,
+									&lock);
+	if (shared == NULL)
+		return NULL;
+	memcpy(&funcbuf, shared, sizeof(funcbuf));
+	LWLockRelease(lock);
+
+	if (dbentry->functions == NULL)
+	{
+		HASHCTL		hash_ctl;
+
+		memset(&hash_ctl, 0, sizeof(hash_ctl));
+		hash_ctl.keysize = sizeof(Oid);
+		hash_ctl.entrysize = sizeof(PgStat_StatFuncEntry);
+		hash_ctl.hcxt = pgStatLocalContext;
+		dbentry->functions = hash_create("Per-database function",
+										 PGSTAT_FUNCTION_HASH_SIZE,
+										 &hash_ctl,
+										 HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+	}
+
+	funcentry = (PgStat_StatFuncEntry *) hash_search(dbentry->functions,
+													 (void *) &functionid,
+													 HASH_ENTER, NULL);
+	memcpy(funcentry, &funcbuf, sizeof(funcbuf));
+
+	return funcentry;
+}
+
+
 /* ----------
  * pgstat_fetch_stat_dbentry() -
  *
  *	Support function for the SQL-callable pgstat* functions. Returns
  *	the collected statistics for one database or NULL. NULL doesn't mean
  *	that the database doesn't exist, it is just not yet known by the
- *	collector, so the caller is better off to report ZERO instead.
+ *	statistics, so the caller is better off to report ZERO instead.
  * ----------
  */
 PgStat_StatDBEntry *
 pgstat_fetch_stat_dbentry(Oid dbid)
 {
-	/*
-	 * If not done for this transaction, read the statistics collector stats
-	 * file into some hash tables.
-	 */
-	backend_read_statsfile();
-
-	/*
-	 * Lookup the requested database; return NULL if not found
-	 */
-	return (PgStat_StatDBEntry *) hash_search(pgStatDBHash,
-											  (void *) &dbid,
-											  HASH_FIND, NULL);
+	return pgstat_snapshot_db_entry(dbid);
 }
 
 
@@ -2509,55 +2616,38 @@ pgstat_fetch_stat_dbentry(Oid dbid)
  *	Support function for the SQL-callable pgstat* functions. Returns
  *	the collected statistics for one table or NULL. NULL doesn't mean
  *	that the table doesn't exist, it is just not yet known by the
- *	collector, so the caller is better off to report ZERO instead.
+ *	statistics, so the caller is better off to report ZERO instead.
  * ----------
  */
 PgStat_StatTabEntry *
 pgstat_fetch_stat_tabentry(Oid relid)
 {
-	Oid			dbid;
-	PgStat_StatDBEntry *dbentry;
 	PgStat_StatTabEntry *tabentry;
 
 	/*
-	 * If not done for this transaction, read the statistics collector stats
-	 * file into some hash tables.
+	 * Look in our database, and if we didn't find it, maybe it's a shared
+	 * table.
 	 */
-	backend_read_statsfile();
+	tabentry = pgstat_fetch_stat_tabentry_ext(false, relid);
+	if (tabentry != NULL)
+		return tabentry;
 
-	/*
-	 * Lookup our database, then look in its table hash table.
-	 */
-	dbid = MyDatabaseId;
-	dbentry = (PgStat_StatDBEntry *) hash_search(pgStatDBHash,
-												 (void *) &dbid,
-												 HASH_FIND, NULL);
-	if (dbentry != NULL && dbentry->tables != NULL)
-	{
-		tabentry = (PgStat_StatTabEntry *) hash_search(dbentry->tables,
-													   (void *) &relid,
-													   HASH_FIND, NULL);
-		if (tabentry)
-			return tabentry;
-	}
+	return pgstat_fetch_stat_tabentry_ext(true, relid);
+}
 
-	/*
-	 * If we didn't find it, maybe it's a shared table.
-	 */
-	dbid = InvalidOid;
-	dbentry = (PgStat_StatDBEntry *) hash_search(pgStatDBHash,
-												 (void *) &dbid,
-												 HASH_FIND, NULL);
-	if (dbentry != NULL && dbentry->tables != NULL)
-	{
-		tabentry = (PgStat_StatTabEntry *) hash_search(dbentry->tables,
-													   (void *) &relid,
-													   HASH_FIND, NULL);
-		if (tabentry)
-			return tabentry;
-	}
 
-	return NULL;
+/* ----------
+ * pgstat_fetch_stat_tabentry_ext() -
+ *
+ *	Like pgstat_fetch_stat_tabentry(), but only looks among the shared
+ *	catalogs if shared is true, and only in our database otherwise.
+ * ----------
+ */
+PgStat_StatTabEntry *
+pgstat_fetch_stat_tabentry_ext(bool shared, Oid relid)
+{
+	return pgstat_snapshot_tab_entry(shared ? InvalidOid : MyDatabaseId,
+									 relid);
 }
 
 
@@ -2571,22 +2661,7 @@ pgstat_fetch_stat_tabentry(Oid relid)
 PgStat_StatFuncEntry *
 pgstat_fetch_stat_funcentry(Oid func_id)
 {
-	PgStat_StatDBEntry *dbentry;
-	PgStat_StatFuncEntry *funcentry = NULL;
-
-	/* load the stats file if needed */
-	backend_read_statsfile();
-
-	/* Lookup our database, then find the requested function.  */
-	dbentry = pgstat_fetch_stat_dbentry(MyDatabaseId);
-	if (dbentry != NULL && dbentry->functions != NULL)
-	{
-		funcentry = (PgStat_StatFuncEntry *) hash_search(dbentry->functions,
-														 (void *) &func_id,
-														 HASH_FIND, NULL);
-	}
-
-	return funcentry;
+	return pgstat_snapshot_func_entry(MyDatabaseId, func_id);
 }
 
 
@@ -3760,6 +3835,9 @@ pgstat_get_wait_ipc(WaitEventIPC w)
 
 	switch (w)
 	{
+		case WAIT_EVENT_APPEND_READY:
+			event_name = "AppendReady";
+			break;
 		case WAIT_EVENT_BACKUP_WAIT_WAL_ARCHIVE:
 			event_name = "BackupWaitWalArchive";
 			break;
@@ -3826,6 +3904,12 @@ pgstat_get_wait_ipc(WaitEventIPC w)
 		case WAIT_EVENT_HASH_GROW_BUCKETS_REINSERT:
 			event_name = "HashGrowBucketsReinsert";
 			break;
+		case WAIT_EVENT_LOGICAL_PARALLEL_APPLY_COMMIT:
+			event_name = "LogicalParallelApplyCommit";
+			break;
+		case WAIT_EVENT_LOGICAL_PARALLEL_APPLY_WORKER:
+			event_name = "LogicalParallelApplyWorker";
+			break;
 		case WAIT_EVENT_LOGICAL_SYNC_DATA:
 			event_name = "LogicalSyncData";
 			break;
@@ -3847,6 +3931,12 @@ pgstat_get_wait_ipc(WaitEventIPC w)
 		case WAIT_EVENT_PARALLEL_BITMAP_SCAN:
 			event_name = "ParallelBitmapScan";
 			break;
+		case WAIT_EVENT_PARALLEL_COPY_FILL:
+			event_name = "ParallelCopyFill";
+			break;
+		case WAIT_EVENT_PARALLEL_COPY_TAKE:
+			event_name = "ParallelCopyTake";
+			break;
 		case WAIT_EVENT_PARALLEL_CREATE_INDEX_SCAN:
 			event_name = "ParallelCreateIndexScan";
 			break;
@@ -3868,6 +3958,9 @@ pgstat_get_wait_ipc(WaitEventIPC w)
 		case WAIT_EVENT_RECOVERY_CONFLICT_TABLESPACE:
 			event_name = "RecoveryConflictTablespace";
 			break;
+		case WAIT_EVENT_RECOVERY_PARALLEL_REDO:
+			event_name = "RecoveryParallelRedo";
+			break;
 		case WAIT_EVENT_RECOVERY_PAUSE:
 			event_name = "RecoveryPause";
 			break;
@@ -4032,6 +4125,9 @@ pgstat_get_wait_io(WaitEventIO w)
 		case WAIT_EVENT_LOGICAL_REWRITE_WRITE:
 			event_name = "LogicalRewriteWrite";
 			break;
+		case WAIT_EVENT_MEMPOOL_READ:
+			event_name = "MemPoolRead";
+			break;
 		case WAIT_EVENT_RELATION_MAP_READ:
 			event_name = "RelationMapRead";
 			break;
@@ -4062,6 +4158,15 @@ pgstat_get_wait_io(WaitEventIO w)
 		case WAIT_EVENT_REPLICATION_SLOT_WRITE:
 			event_name = "ReplicationSlotWrite";
 			break;
+		case WAIT_EVENT_RPC_NBLOCKS:
+			event_name = "RpcNblocks";
+			break;
+		case WAIT_EVENT_RPC_READ:
+			event_name = "RpcRead";
+			break;
+		case WAIT_EVENT_RPC_XLOG_WRITE:
+			event_name = "RpcXLogWrite";
+			break;
 		case WAIT_EVENT_SLRU_FLUSH_SYNC:
 			event_name = "SLRUFlushSync";
 			break;
@@ -4485,10 +4590,10 @@ PgstatCollectorMain(int argc, char *argv[])
 	init_ps_display(NULL);
 
 	/*
-	 * Read in existing stats files or initialize the stats to zero.
+	 * Read in the existing stats file or initialize the stats to zero.
 	 */
 	pgStatRunningInCollector = true;
-	pgStatDBHash = pgstat_read_statsfiles(InvalidOid, true, true);
+	pgstat_read_statsfile(true);
 
 	/*
 	 * Loop to process messages until we get SIGQUIT or detect ungraceful
@@ -4531,11 +4636,11 @@ PgstatCollectorMain(int argc, char *argv[])
 			}
 
 			/*
-			 * Write the stats file(s) if a new request has arrived that is
-			 * not satisfied by existing file(s).
+			 * Write the stats file if a new request has arrived that is not
+			 * satisfied by the existing file.
 			 */
 			if (pgstat_write_statsfile_needed())
-				pgstat_write_statsfiles(false, false);
+				pgstat_write_statsfile(false);
 
 			/*
 			 * Try to receive and process a message.  This will not block,
@@ -4589,49 +4694,16 @@ PgstatCollectorMain(int argc, char *argv[])
 					pgstat_recv_inquiry(&msg.msg_inquiry, len);
 					break;
 
-				case PGSTAT_MTYPE_TABSTAT:
-					pgstat_recv_tabstat(&msg.msg_tabstat, len);
-					break;
-
-				case PGSTAT_MTYPE_TABPURGE:
-					pgstat_recv_tabpurge(&msg.msg_tabpurge, len);
-					break;
-
-				case PGSTAT_MTYPE_DROPDB:
-					pgstat_recv_dropdb(&msg.msg_dropdb, len);
-					break;
-
-				case PGSTAT_MTYPE_RESETCOUNTER:
-					pgstat_recv_resetcounter(&msg.msg_resetcounter, len);
-					break;
-
 				case PGSTAT_MTYPE_RESETSHAREDCOUNTER:
 					pgstat_recv_resetsharedcounter(&msg.msg_resetsharedcounter,
 												   len);
 					break;
 
-				case PGSTAT_MTYPE_RESETSINGLECOUNTER:
-					pgstat_recv_resetsinglecounter(&msg.msg_resetsinglecounter,
-												   len);
-					break;
-
 				case PGSTAT_MTYPE_RESETSLRUCOUNTER:
 					pgstat_recv_resetslrucounter(&msg.msg_resetslrucounter,
 												 len);
 					break;
 
-				case PGSTAT_MTYPE_AUTOVAC_START:
-					pgstat_recv_autovac(&msg.msg_autovacuum_start, len);
-					break;
-
-				case PGSTAT_MTYPE_VACUUM:
-					pgstat_recv_vacuum(&msg.msg_vacuum, len);
-					break;
-
-				case PGSTAT_MTYPE_ANALYZE:
-					pgstat_recv_analyze(&msg.msg_analyze, len);
-					break;
-
 				case PGSTAT_MTYPE_ARCHIVER:
 					pgstat_recv_archiver(&msg.msg_archiver, len);
 					break;
@@ -4644,32 +4716,6 @@ PgstatCollectorMain(int argc, char *argv[])
 					pgstat_recv_slru(&msg.msg_slru, len);
 					break;
 
-				case PGSTAT_MTYPE_FUNCSTAT:
-					pgstat_recv_funcstat(&msg.msg_funcstat, len);
-					break;
-
-				case PGSTAT_MTYPE_FUNCPURGE:
-					pgstat_recv_funcpurge(&msg.msg_funcpurge, len);
-					break;
-
-				case PGSTAT_MTYPE_RECOVERYCONFLICT:
-					pgstat_recv_recoveryconflict(&msg.msg_recoveryconflict,
-												 len);
-					break;
-
-				case PGSTAT_MTYPE_DEADLOCK:
-					pgstat_recv_deadlock(&msg.msg_deadlock, len);
-					break;
-
-				case PGSTAT_MTYPE_TEMPFILE:
-					pgstat_recv_tempfile(&msg.msg_tempfile, len);
-					break;
-
-				case PGSTAT_MTYPE_CHECKSUMFAILURE:
-					pgstat_recv_checksum_failure(&msg.msg_checksumfailure,
-												 len);
-					break;
-
 				default:
 					break;
 			}
@@ -4711,21 +4757,17 @@ PgstatCollectorMain(int argc, char *argv[])
 	/*
 	 * Save the final stats to reuse at next startup.
 	 */
-	pgstat_write_statsfiles(true, true);
+	pgstat_write_statsfile(true);
 
 	exit(0);
 }
 
 /*
  * Subroutine to clear stats in a database entry
- *
- * Tables and functions hashes are initialized to empty.
  */
 static void
 reset_dbentry_counters(PgStat_StatDBEntry *dbentry)
 {
-	HASHCTL		hash_ctl;
-
 	dbentry->n_xact_commit = 0;
 	dbentry->n_xact_rollback = 0;
 	dbentry->n_blocks_fetched = 0;
@@ -4752,122 +4794,333 @@ reset_dbentry_counters(PgStat_StatDBEntry *dbentry)
 	dbentry->stat_reset_timestamp = GetCurrentTimestamp();
 	dbentry->stats_timestamp = 0;
 
-	memset(&hash_ctl, 0, sizeof(hash_ctl));
-	hash_ctl.keysize = sizeof(Oid);
-	hash_ctl.entrysize = sizeof(PgStat_StatTabEntry);
-	dbentry->tables = hash_create("Per-database table",
-								  PGSTAT_TAB_HASH_SIZE,
-								  &hash_ctl,
-								  HASH_ELEM | HASH_BLOBS);
+	dbentry->tables = NULL;
+	dbentry->functions = NULL;
+}
 
-	hash_ctl.keysize = sizeof(Oid);
-	hash_ctl.entrysize = sizeof(PgStat_StatFuncEntry);
-	dbentry->functions = hash_create("Per-database function",
-									 PGSTAT_FUNCTION_HASH_SIZE,
-									 &hash_ctl,
-									 HASH_ELEM | HASH_BLOBS);
+/* ------------------------------------------------------------
+ * Functions for management of the shared statistics tables
+ *
+ * The database, table and function entries are kept in three shared hash
+ * tables, which backends update directly when they flush their pending
+ * counts.  Like the lock manager's, the tables are partitioned by hash
+ * code, and all their entries are allocated at startup: max_stats_tables
+ * for tables and as many for functions.  An entry is read under its
+ * partition's lock in shared mode and changed under it in exclusive mode.
+ * The three tables share the partition locks, and no process holds more
+ * than one of them at a time, except the scans, which take them all in
+ * order.  When a table is full, the counts of the objects that don't fit
+ * are dropped.
+ * ------------------------------------------------------------
+ */
+
+/*
+ * Report shared-memory space needed by CreateSharedStats.
+ */
+Size
+SharedStatsShmemSize(void)
+{
+	Size		size;
+
+	size = mul_size(PGSTAT_NUM_PARTITIONS, sizeof(LWLockPadded));
+	size = add_size(size, hash_estimate_size(PGSTAT_SHARED_DB_HASH_SIZE,
+											 sizeof(PgStat_StatDBEntry)));
+	size = add_size(size, hash_estimate_size(pgstat_max_tables,
+											 sizeof(PgStat_SharedTabEntry)));
+	size = add_size(size, hash_estimate_size(pgstat_max_tables,
+											 sizeof(PgStat_SharedFuncEntry)));
+
+	return size;
+}
+
+/*
+ * Initialize the shared statistics tables during postmaster startup.
+ */
+void
+CreateSharedStats(void)
+{
+	HASHCTL		info;
+	bool		found;
+	int			i;
+
+	pgStatPartitionLocks = (LWLockPadded *)
+		ShmemInitStruct("PgStat Partition Locks",
+						mul_size(PGSTAT_NUM_PARTITIONS, sizeof(LWLockPadded)),
+						&found);
+	if (!found)
+	{
+		for (i = 0; i < PGSTAT_NUM_PARTITIONS; i++)
+			LWLockInitialize(&pgStatPartitionLocks[i].lock,
+							 LWTRANCHE_PGSTAT_PARTITION);
+	}
+
+	memset(&info, 0, sizeof(info));
+	info.keysize = sizeof(Oid);
+	info.entrysize = sizeof(PgStat_StatDBEntry);
+	info.num_partitions = PGSTAT_NUM_PARTITIONS;
+	pgStatSharedDBHash = ShmemInitHash("PgStat Databases",
+									   PGSTAT_SHARED_DB_HASH_SIZE,
+									   PGSTAT_SHARED_DB_HASH_SIZE,
+									   &info,
+									   HASH_ELEM | HASH_BLOBS | HASH_PARTITION);
+
+	info.keysize = sizeof(PgStat_SharedKey);
+	info.entrysize = sizeof(PgStat_SharedTabEntry);
+	pgStatSharedTabHash = ShmemInitHash("PgStat Tables",
+										pgstat_max_tables,
+										pgstat_max_tables,
+										&info,
+										HASH_ELEM | HASH_BLOBS | HASH_PARTITION);
+
+	info.entrysize = sizeof(PgStat_SharedFuncEntry);
+	pgStatSharedFuncHash = ShmemInitHash("PgStat Functions",
+										 pgstat_max_tables,
+										 pgstat_max_tables,
+										 &info,
+										 HASH_ELEM | HASH_BLOBS | HASH_PARTITION);
 }
 
 /*
- * Lookup the hash table entry for the specified database. If no hash
- * table entry exists, initialize it, if the create parameter is true.
- * Else, return NULL.
+ * Look up the shared entry of a database, and return it with its partition
+ * lock held in the given mode, which has to be exclusive to create the
+ * entry if it's missing.  The caller releases *lock.  Returns NULL, with no
+ * lock held, if there is no entry, or no room for a new one.
  */
 static PgStat_StatDBEntry *
-pgstat_get_db_entry(Oid databaseid, bool create)
+pgstat_lock_db_entry(Oid databaseid, bool create, LWLockMode mode,
+					 LWLock **lock)
 {
 	PgStat_StatDBEntry *result;
+	uint32		hashcode;
 	bool		found;
-	HASHACTION	action = (create ? HASH_ENTER : HASH_FIND);
 
-	/* Lookup or create the hash table entry for this database */
-	result = (PgStat_StatDBEntry *) hash_search(pgStatDBHash,
-												&databaseid,
-												action, &found);
+	Assert(!create || mode == LW_EXCLUSIVE);
+
+	hashcode = get_hash_value(pgStatSharedDBHash, &databaseid);
+	*lock = PgStatPartitionLock(hashcode);
+	LWLockAcquire(*lock, mode);
 
-	if (!create && !found)
+	result = (PgStat_StatDBEntry *)
+		hash_search_with_hash_value(pgStatSharedDBHash, &databaseid, hashcode,
+									create ? HASH_ENTER_NULL : HASH_FIND,
+									&found);
+	if (result == NULL)
+	{
+		LWLockRelease(*lock);
 		return NULL;
+	}
 
-	/*
-	 * If not found, initialize the new one.  This creates empty hash tables
-	 * for tables and functions, too.
-	 */
+	/* If not found, initialize the new one. */
 	if (!found)
 		reset_dbentry_counters(result);
 
 	return result;
 }
 
-
 /*
- * Lookup the hash table entry for the specified table. If no hash
- * table entry exists, initialize it, if the create parameter is true.
- * Else, return NULL.
+ * Likewise for the shared entry of a table.
  */
 static PgStat_StatTabEntry *
-pgstat_get_tab_entry(PgStat_StatDBEntry *dbentry, Oid tableoid, bool create)
+pgstat_lock_tab_entry(Oid databaseid, Oid tableoid, bool create,
+					  LWLockMode mode, LWLock **lock)
+{
+	PgStat_SharedTabEntry *result;
+	PgStat_SharedKey key;
+	uint32		hashcode;
+	bool		found;
+
+	Assert(!create || mode == LW_EXCLUSIVE);
+
+	key.databaseid = databaseid;
+	key.objectid = tableoid;
+	hashcode = get_hash_value(pgStatSharedTabHash, &key);
+	*lock = PgStatPartitionLock(hashcode);
+	LWLockAcquire(*lock, mode);
+
+	result = (PgStat_SharedTabEntry *)
+		hash_search_with_hash_value(pgStatSharedTabHash, &key, hashcode,
+									create ? HASH_ENTER_NULL : HASH_FIND,
+									&found);
+	if (result == NULL)
+	{
+		LWLockRelease(*lock);
+		return NULL;
+	}
+
+	/* If not found, initialize the new one. */
+	if (!found)
+	{
+		MemSet(&result->stats, 0, sizeof(PgStat_StatTabEntry));
+		result->stats.tableid = tableoid;
+	}
+
+	return &result->stats;
+}
+
+/*
+ * Likewise for the shared entry of a function.
+ */
+static PgStat_StatFuncEntry *
+pgstat_lock_func_entry(Oid databaseid, Oid functionid, bool create,
+					   LWLockMode mode, LWLock **lock)
 {
-	PgStat_StatTabEntry *result;
+	PgStat_SharedFuncEntry *result;
+	PgStat_SharedKey key;
+	uint32		hashcode;
 	bool		found;
-	HASHACTION	action = (create ? HASH_ENTER : HASH_FIND);
 
-	/* Lookup or create the hash table entry for this table */
-	result = (PgStat_StatTabEntry *) hash_search(dbentry->tables,
-												 &tableoid,
-												 action, &found);
+	Assert(!create || mode == LW_EXCLUSIVE);
 
-	if (!create && !found)
+	key.databaseid = databaseid;
+	key.objectid = functionid;
+	hashcode = get_hash_value(pgStatSharedFuncHash, &key);
+	*lock = PgStatPartitionLock(hashcode);
+	LWLockAcquire(*lock, mode);
+
+	result = (PgStat_SharedFuncEntry *)
+		hash_search_with_hash_value(pgStatSharedFuncHash, &key, hashcode,
+									create ? HASH_ENTER_NULL : HASH_FIND,
+									&found);
+	if (result == NULL)
+	{
+		LWLockRelease(*lock);
 		return NULL;
+	}
 
 	/* If not found, initialize the new one. */
 	if (!found)
 	{
-		result->numscans = 0;
-		result->tuples_returned = 0;
-		result->tuples_fetched = 0;
-		result->tuples_inserted = 0;
-		result->tuples_updated = 0;
-		result->tuples_deleted = 0;
-		result->tuples_hot_updated = 0;
-		result->n_live_tuples = 0;
-		result->n_dead_tuples = 0;
-		result->changes_since_analyze = 0;
-		result->inserts_since_vacuum = 0;
-		result->blocks_fetched = 0;
-		result->blocks_hit = 0;
-		result->vacuum_timestamp = 0;
-		result->vacuum_count = 0;
-		result->autovac_vacuum_timestamp = 0;
-		result->autovac_vacuum_count = 0;
-		result->analyze_timestamp = 0;
-		result->analyze_count = 0;
-		result->autovac_analyze_timestamp = 0;
-		result->autovac_analyze_count = 0;
+		MemSet(&result->stats, 0, sizeof(PgStat_StatFuncEntry));
+		result->stats.functionid = functionid;
+	}
+
+	return &result->stats;
+}
+
+/*
+ * Make sure a database has a shared entry, for the entries of its objects
+ * to be seen through.
+ */
+static void
+pgstat_ensure_db_entry(Oid databaseid)
+{
+	LWLock	   *lock;
+
+	if (pgstat_lock_db_entry(databaseid, true, LW_EXCLUSIVE, &lock) != NULL)
+		LWLockRelease(lock);
+}
+
+/*
+ * Take all the partition locks, in order, to scan the shared tables.
+ */
+static void
+pgstat_lock_all_partitions(LWLockMode mode)
+{
+	int			i;
+
+	for (i = 0; i < PGSTAT_NUM_PARTITIONS; i++)
+		LWLockAcquire(&pgStatPartitionLocks[i].lock, mode);
+}
+
+static void
+pgstat_unlock_all_partitions(void)
+{
+	int			i;
+
+	for (i = PGSTAT_NUM_PARTITIONS; --i >= 0;)
+		LWLockRelease(&pgStatPartitionLocks[i].lock);
+}
+
+/*
+ * Remove the shared entry of a table or function, if there is one; htab is
+ * pgStatSharedTabHash or pgStatSharedFuncHash.
+ */
+static void
+pgstat_remove_shared_entry(HTAB *htab, Oid databaseid, Oid objectid)
+{
+	PgStat_SharedKey key;
+	uint32		hashcode;
+	LWLock	   *lock;
+
+	key.databaseid = databaseid;
+	key.objectid = objectid;
+	hashcode = get_hash_value(htab, &key);
+	lock = PgStatPartitionLock(hashcode);
+
+	LWLockAcquire(lock, LW_EXCLUSIVE);
+	(void) hash_search_with_hash_value(htab, &key, hashcode, HASH_REMOVE, NULL);
+	LWLockRelease(lock);
+}
+
+/*
+ * Remove all the table and function entries of a database.  The caller has
+ * to hold all the partition locks exclusively.
+ */
+static void
+pgstat_remove_db_objects(Oid databaseid)
+{
+	HTAB	   *tables[2];
+	HASH_SEQ_STATUS hstat;
+	PgStat_SharedKey *key;
+	int			i;
+
+	tables[0] = pgStatSharedTabHash;
+	tables[1] = pgStatSharedFuncHash;
+	for (i = 0; i < lengthof(tables); i++)
+	{
+		hash_seq_init(&hstat, tables[i]);
+		while ((key = (PgStat_SharedKey *) hash_seq_search(&hstat)) != NULL)
+		{
+			if (key->databaseid == databaseid)
+				(void) hash_search(tables[i], (void *) key, HASH_REMOVE, NULL);
+		}
+	}
+}
+
+/*
+ * Return the OIDs of the databases that have a shared entry if htab is
+ * pgStatSharedDBHash, else those of the tables or functions of the given
+ * database that have one.
+ */
+static List *
+pgstat_shared_oids(HTAB *htab, Oid databaseid)
+{
+	HASH_SEQ_STATUS hstat;
+	void	   *entry;
+	List	   *result = NIL;
+
+	pgstat_lock_all_partitions(LW_SHARED);
+
+	hash_seq_init(&hstat, htab);
+	while ((entry = hash_seq_search(&hstat)) != NULL)
+	{
+		if (htab == pgStatSharedDBHash)
+			result = lappend_oid(result,
+								 ((PgStat_StatDBEntry *) entry)->databaseid);
+		else if (((PgStat_SharedKey *) entry)->databaseid == databaseid)
+			result = lappend_oid(result,
+								 ((PgStat_SharedKey *) entry)->objectid);
 	}
 
+	pgstat_unlock_all_partitions();
+
 	return result;
 }
 
 
 /* ----------
- * pgstat_write_statsfiles() -
- *		Write the global statistics file, as well as requested DB files.
- *
- *	'permanent' specifies writing to the permanent files not temporary ones.
- *	When true (happens only when the collector is shutting down), also remove
- *	the temporary files so that backends starting up under a new postmaster
- *	can't read old data before the new collector is ready.
+ * pgstat_write_statsfile() -
+ *		Write the global statistics file.
  *
- *	When 'allDbs' is false, only the requested databases (listed in
- *	pending_write_requests) will be written; otherwise, all databases
- *	will be written.
+ *	'permanent' specifies writing to the permanent file not the temporary
+ *	one.  When true (happens only when the collector is shutting down), also
+ *	remove the temporary file so that backends starting up under a new
+ *	postmaster can't read old data before the new collector is ready.
  * ----------
  */
 static void
-pgstat_write_statsfiles(bool permanent, bool allDbs)
+pgstat_write_statsfile(bool permanent)
 {
-	HASH_SEQ_STATUS hstat;
-	PgStat_StatDBEntry *dbentry;
 	FILE	   *fpout;
 	int32		format_id;
 	const char *tmpfile = permanent ? PGSTAT_STAT_PERMANENT_TMPFILE : pgstat_stat_tmpname;
@@ -4919,33 +5172,6 @@ pgstat_write_statsfiles(bool permanent, bool allDbs)
 	rc = fwrite(slruStats, sizeof(slruStats), 1, fpout);
 	(void) rc;					/* we'll check for error with ferror */
 
-	/*
-	 * Walk through the database table.
-	 */
-	hash_seq_init(&hstat, pgStatDBHash);
-	while ((dbentry = (PgStat_StatDBEntry *) hash_seq_search(&hstat)) != NULL)
-	{
-		/*
-		 * Write out the table and function stats for this DB into the
-		 * appropriate per-DB stat file, if required.
-		 */
-		if (allDbs || pgstat_db_requested(dbentry->databaseid))
-		{
-			/* Make DB's timestamp consistent with the global stats */
-			dbentry->stats_timestamp = globalStats.stats_timestamp;
-
-			pgstat_write_db_statsfile(dbentry, permanent);
-		}
-
-		/*
-		 * Write out the DB entry. We don't write the tables or functions
-		 * pointers, since they're of no use to any other process.
-		 */
-		fputc('D', fpout);
-		rc = fwrite(dbentry, offsetof(PgStat_StatDBEntry, tables), 1, fpout);
-		(void) rc;				/* we'll check for error with ferror */
-	}
-
 	/*
 	 * No more output to be done. Close the temp file and replace the old
 	 * pgstat.stat with it.  The ferror() check replaces testing for error
@@ -4983,249 +5209,87 @@ pgstat_write_statsfiles(bool permanent, bool allDbs)
 		unlink(pgstat_stat_filename);
 
 	/*
-	 * Now throw away the list of requests.  Note that requests sent after we
-	 * started the write are still waiting on the network socket.
+	 * Now the request is satisfied.  Note that requests sent after we started
+	 * the write are still waiting on the network socket.
 	 */
-	list_free(pending_write_requests);
-	pending_write_requests = NIL;
-}
-
-/*
- * return the filename for a DB stat file; filename is the output buffer,
- * of length len.
- */
-static void
-get_dbstat_filename(bool permanent, bool tempname, Oid databaseid,
-					char *filename, int len)
-{
-	int			printed;
-
-	/* NB -- pgstat_reset_remove_files knows about the pattern this uses */
-	printed = snprintf(filename, len, "%s/db_%u.%s",
-					   permanent ? PGSTAT_STAT_PERMANENT_DIRECTORY :
-					   pgstat_stat_directory,
-					   databaseid,
-					   tempname ? "tmp" : "stat");
-	if (printed >= len)
-		elog(ERROR, "overlength pgstat path");
+	pending_write_request = false;
 }
 
 /* ----------
- * pgstat_write_db_statsfile() -
- *		Write the stat file for a single database.
+ * pgstat_read_statsfile() -
  *
- *	If writing to the permanent file (happens when the collector is
- *	shutting down only), remove the temporary file so that backends
- *	starting up under a new postmaster can't read the old data before
- *	the new collector is ready.
+ *	Reads in the existing global statistics file: the global, archiver and
+ *	SLRU stats.
+ *
+ *	'permanent' specifies reading from the permanent file not the temporary
+ *	one.  When true (happens only when the collector is starting up), remove
+ *	the file after reading; the in-memory status is now authoritative, and
+ *	the file would be out of date in case somebody else reads it.
  * ----------
  */
 static void
-pgstat_write_db_statsfile(PgStat_StatDBEntry *dbentry, bool permanent)
+pgstat_read_statsfile(bool permanent)
 {
-	HASH_SEQ_STATUS tstat;
-	HASH_SEQ_STATUS fstat;
-	PgStat_StatTabEntry *tabentry;
-	PgStat_StatFuncEntry *funcentry;
-	FILE	   *fpout;
+	FILE	   *fpin;
 	int32		format_id;
-	Oid			dbid = dbentry->databaseid;
-	int			rc;
-	char		tmpfile[MAXPGPATH];
-	char		statfile[MAXPGPATH];
-
-	get_dbstat_filename(permanent, true, dbid, tmpfile, MAXPGPATH);
-	get_dbstat_filename(permanent, false, dbid, statfile, MAXPGPATH);
+	const char *statfile = permanent ? PGSTAT_STAT_PERMANENT_FILENAME : pgstat_stat_filename;
+	int			i;
 
-	elog(DEBUG2, "writing stats file \"%s\"", statfile);
+	/*
+	 * Clear out global and archiver statistics so they start from zero in
+	 * case we can't load an existing statsfile.
+	 */
+	memset(&globalStats, 0, sizeof(globalStats));
+	memset(&archiverStats, 0, sizeof(archiverStats));
+	memset(&slruStats, 0, sizeof(slruStats));
 
 	/*
-	 * Open the statistics temp file to write out the current values.
+	 * Set the current timestamp (will be kept only in case we can't load an
+	 * existing statsfile).
 	 */
-	fpout = AllocateFile(tmpfile, PG_BINARY_W);
-	if (fpout == NULL)
-	{
-		ereport(LOG,
-				(errcode_for_file_access(),
-				 errmsg("could not open temporary statistics file \"%s\": %m",
-						tmpfile)));
-		return;
-	}
+	globalStats.stat_reset_timestamp = GetCurrentTimestamp();
+	archiverStats.stat_reset_timestamp = globalStats.stat_reset_timestamp;
 
 	/*
-	 * Write the file header --- currently just a format ID.
+	 * Set the same reset timestamp for all SLRU items too.
 	 */
-	format_id = PGSTAT_FILE_FORMAT_ID;
-	rc = fwrite(&format_id, sizeof(format_id), 1, fpout);
-	(void) rc;					/* we'll check for error with ferror */
+	for (i = 0; i < SLRU_NUM_ELEMENTS; i++)
+		slruStats[i].stat_reset_timestamp = globalStats.stat_reset_timestamp;
 
 	/*
-	 * Walk through the database's access stats per table.
+	 * Try to open the stats file. If it doesn't exist, the backends simply
+	 * return zero for anything and the collector simply starts from scratch
+	 * with empty counters.
+	 *
+	 * ENOENT is a possibility if the stats collector is not running or has
+	 * not yet written the stats file the first time.  Any other failure
+	 * condition is suspicious.
 	 */
-	hash_seq_init(&tstat, dbentry->tables);
-	while ((tabentry = (PgStat_StatTabEntry *) hash_seq_search(&tstat)) != NULL)
+	if ((fpin = AllocateFile(statfile, PG_BINARY_R)) == NULL)
 	{
-		fputc('T', fpout);
-		rc = fwrite(tabentry, sizeof(PgStat_StatTabEntry), 1, fpout);
-		(void) rc;				/* we'll check for error with ferror */
+		if (errno != ENOENT)
+			ereport(pgStatRunningInCollector ? LOG : WARNING,
+					(errcode_for_file_access(),
+					 errmsg("could not open statistics file \"%s\": %m",
+							statfile)));
+		return;
 	}
 
 	/*
-	 * Walk through the database's function stats table.
+	 * Verify it's of the expected format.
 	 */
-	hash_seq_init(&fstat, dbentry->functions);
-	while ((funcentry = (PgStat_StatFuncEntry *) hash_seq_search(&fstat)) != NULL)
+	if (fread(&format_id, 1, sizeof(format_id), fpin) != sizeof(format_id) ||
+		format_id != PGSTAT_FILE_FORMAT_ID)
 	{
-		fputc('F', fpout);
-		rc = fwrite(funcentry, sizeof(PgStat_StatFuncEntry), 1, fpout);
-		(void) rc;				/* we'll check for error with ferror */
+		ereport(pgStatRunningInCollector ? LOG : WARNING,
+				(errmsg("corrupted statistics file \"%s\"", statfile)));
+		goto done;
 	}
 
 	/*
-	 * No more output to be done. Close the temp file and replace the old
-	 * pgstat.stat with it.  The ferror() check replaces testing for error
-	 * after each individual fputc or fwrite above.
+	 * Read global stats struct
 	 */
-	fputc('E', fpout);
-
-	if (ferror(fpout))
-	{
-		ereport(LOG,
-				(errcode_for_file_access(),
-				 errmsg("could not write temporary statistics file \"%s\": %m",
-						tmpfile)));
-		FreeFile(fpout);
-		unlink(tmpfile);
-	}
-	else if (FreeFile(fpout) < 0)
-	{
-		ereport(LOG,
-				(errcode_for_file_access(),
-				 errmsg("could not close temporary statistics file \"%s\": %m",
-						tmpfile)));
-		unlink(tmpfile);
-	}
-	else if (rename(tmpfile, statfile) < 0)
-	{
-		ereport(LOG,
-				(errcode_for_file_access(),
-				 errmsg("could not rename temporary statistics file \"%s\" to \"%s\": %m",
-						tmpfile, statfile)));
-		unlink(tmpfile);
-	}
-
-	if (permanent)
-	{
-		get_dbstat_filename(false, false, dbid, statfile, MAXPGPATH);
-
-		elog(DEBUG2, "removing temporary stats file \"%s\"", statfile);
-		unlink(statfile);
-	}
-}
-
-/* ----------
- * pgstat_read_statsfiles() -
- *
- *	Reads in some existing statistics collector files and returns the
- *	databases hash table that is the top level of the data.
- *
- *	If 'onlydb' is not InvalidOid, it means we only want data for that DB
- *	plus the shared catalogs ("DB 0").  We'll still populate the DB hash
- *	table for all databases, but we don't bother even creating table/function
- *	hash tables for other databases.
- *
- *	'permanent' specifies reading from the permanent files not temporary ones.
- *	When true (happens only when the collector is starting up), remove the
- *	files after reading; the in-memory status is now authoritative, and the
- *	files would be out of date in case somebody else reads them.
- *
- *	If a 'deep' read is requested, table/function stats are read, otherwise
- *	the table/function hash tables remain empty.
- * ----------
- */
-static HTAB *
-pgstat_read_statsfiles(Oid onlydb, bool permanent, bool deep)
-{
-	PgStat_StatDBEntry *dbentry;
-	PgStat_StatDBEntry dbbuf;
-	HASHCTL		hash_ctl;
-	HTAB	   *dbhash;
-	FILE	   *fpin;
-	int32		format_id;
-	bool		found;
-	const char *statfile = permanent ? PGSTAT_STAT_PERMANENT_FILENAME : pgstat_stat_filename;
-	int			i;
-
-	/*
-	 * The tables will live in pgStatLocalContext.
-	 */
-	pgstat_setup_memcxt();
-
-	/*
-	 * Create the DB hashtable
-	 */
-	memset(&hash_ctl, 0, sizeof(hash_ctl));
-	hash_ctl.keysize = sizeof(Oid);
-	hash_ctl.entrysize = sizeof(PgStat_StatDBEntry);
-	hash_ctl.hcxt = pgStatLocalContext;
-	dbhash = hash_create("Databases hash", PGSTAT_DB_HASH_SIZE, &hash_ctl,
-						 HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
-
-	/*
-	 * Clear out global and archiver statistics so they start from zero in
-	 * case we can't load an existing statsfile.
-	 */
-	memset(&globalStats, 0, sizeof(globalStats));
-	memset(&archiverStats, 0, sizeof(archiverStats));
-	memset(&slruStats, 0, sizeof(slruStats));
-
-	/*
-	 * Set the current timestamp (will be kept only in case we can't load an
-	 * existing statsfile).
-	 */
-	globalStats.stat_reset_timestamp = GetCurrentTimestamp();
-	archiverStats.stat_reset_timestamp = globalStats.stat_reset_timestamp;
-
-	/*
-	 * Set the same reset timestamp for all SLRU items too.
-	 */
-	for (i = 0; i < SLRU_NUM_ELEMENTS; i++)
-		slruStats[i].stat_reset_timestamp = globalStats.stat_reset_timestamp;
-
-	/*
-	 * Try to open the stats file. If it doesn't exist, the backends simply
-	 * return zero for anything and the collector simply starts from scratch
-	 * with empty counters.
-	 *
-	 * ENOENT is a possibility if the stats collector is not running or has
-	 * not yet written the stats file the first time.  Any other failure
-	 * condition is suspicious.
-	 */
-	if ((fpin = AllocateFile(statfile, PG_BINARY_R)) == NULL)
-	{
-		if (errno != ENOENT)
-			ereport(pgStatRunningInCollector ? LOG : WARNING,
-					(errcode_for_file_access(),
-					 errmsg("could not open statistics file \"%s\": %m",
-							statfile)));
-		return dbhash;
-	}
-
-	/*
-	 * Verify it's of the expected format.
-	 */
-	if (fread(&format_id, 1, sizeof(format_id), fpin) != sizeof(format_id) ||
-		format_id != PGSTAT_FILE_FORMAT_ID)
-	{
-		ereport(pgStatRunningInCollector ? LOG : WARNING,
-				(errmsg("corrupted statistics file \"%s\"", statfile)));
-		goto done;
-	}
-
-	/*
-	 * Read global stats struct
-	 */
-	if (fread(&globalStats, 1, sizeof(globalStats), fpin) != sizeof(globalStats))
+	if (fread(&globalStats, 1, sizeof(globalStats), fpin) != sizeof(globalStats))
 	{
 		ereport(pgStatRunningInCollector ? LOG : WARNING,
 				(errmsg("corrupted statistics file \"%s\"", statfile)));
@@ -5266,105 +5330,11 @@ pgstat_read_statsfiles(Oid onlydb, bool permanent, bool deep)
 	}
 
 	/*
-	 * We found an existing collector stats file. Read it and put all the
-	 * hashtable entries into place.
+	 * 'E'	The EOF marker of a complete stats file.
 	 */
-	for (;;)
-	{
-		switch (fgetc(fpin))
-		{
-				/*
-				 * 'D'	A PgStat_StatDBEntry struct describing a database
-				 * follows.
-				 */
-			case 'D':
-				if (fread(&dbbuf, 1, offsetof(PgStat_StatDBEntry, tables),
-						  fpin) != offsetof(PgStat_StatDBEntry, tables))
-				{
-					ereport(pgStatRunningInCollector ? LOG : WARNING,
-							(errmsg("corrupted statistics file \"%s\"",
-									statfile)));
-					goto done;
-				}
-
-				/*
-				 * Add to the DB hash
-				 */
-				dbentry = (PgStat_StatDBEntry *) hash_search(dbhash,
-															 (void *) &dbbuf.databaseid,
-															 HASH_ENTER,
-															 &found);
-				if (found)
-				{
-					ereport(pgStatRunningInCollector ? LOG : WARNING,
-							(errmsg("corrupted statistics file \"%s\"",
-									statfile)));
-					goto done;
-				}
-
-				memcpy(dbentry, &dbbuf, sizeof(PgStat_StatDBEntry));
-				dbentry->tables = NULL;
-				dbentry->functions = NULL;
-
-				/*
-				 * In the collector, disregard the timestamp we read from the
-				 * permanent stats file; we should be willing to write a temp
-				 * stats file immediately upon the first request from any
-				 * backend.
-				 */
-				if (pgStatRunningInCollector)
-					dbentry->stats_timestamp = 0;
-
-				/*
-				 * Don't create tables/functions hashtables for uninteresting
-				 * databases.
-				 */
-				if (onlydb != InvalidOid)
-				{
-					if (dbbuf.databaseid != onlydb &&
-						dbbuf.databaseid != InvalidOid)
-						break;
-				}
-
-				memset(&hash_ctl, 0, sizeof(hash_ctl));
-				hash_ctl.keysize = sizeof(Oid);
-				hash_ctl.entrysize = sizeof(PgStat_StatTabEntry);
-				hash_ctl.hcxt = pgStatLocalContext;
-				dbentry->tables = hash_create("Per-database table",
-											  PGSTAT_TAB_HASH_SIZE,
-											  &hash_ctl,
-											  HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
-
-				hash_ctl.keysize = sizeof(Oid);
-				hash_ctl.entrysize = sizeof(PgStat_StatFuncEntry);
-				hash_ctl.hcxt = pgStatLocalContext;
-				dbentry->functions = hash_create("Per-database function",
-												 PGSTAT_FUNCTION_HASH_SIZE,
-												 &hash_ctl,
-												 HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
-
-				/*
-				 * If requested, read the data from the database-specific
-				 * file.  Otherwise we just leave the hashtables empty.
-				 */
-				if (deep)
-					pgstat_read_db_statsfile(dbentry->databaseid,
-											 dbentry->tables,
-											 dbentry->functions,
-											 permanent);
-
-				break;
-
-			case 'E':
-				goto done;
-
-			default:
-				ereport(pgStatRunningInCollector ? LOG : WARNING,
-						(errmsg("corrupted statistics file \"%s\"",
-								statfile)));
-				goto done;
-		}
-	}
+	if (fgetc(fpin) != 'E')
+		ereport(pgStatRunningInCollector ? LOG : WARNING,
+				(errmsg("corrupted statistics file \"%s\"", statfile)));
 
 done:
 	FreeFile(fpin);
@@ -5375,48 +5345,26 @@ done:
 		elog(DEBUG2, "removing permanent stats file \"%s\"", statfile);
 		unlink(statfile);
 	}
-
-	return dbhash;
 }
 
-
 /* ----------
- * pgstat_read_db_statsfile() -
- *
- *	Reads in the existing statistics collector file for the given database,
- *	filling the passed-in tables and functions hash tables.
- *
- *	As in pgstat_read_statsfiles, if the permanent file is requested, it is
- *	removed after reading.
+ * pgstat_read_statsfile_timestamp() -
  *
- *	Note: this code has the ability to skip storing per-table or per-function
- *	data, if NULL is passed for the corresponding hashtable.  That's not used
- *	at the moment though.
+ *	Attempt to determine the timestamp of the last global statfile write.
+ *	Returns true if successful; the timestamp is stored in *ts.
  * ----------
  */
-static void
-pgstat_read_db_statsfile(Oid databaseid, HTAB *tabhash, HTAB *funchash,
-						 bool permanent)
+static bool
+pgstat_read_statsfile_timestamp(bool permanent, TimestampTz *ts)
 {
-	PgStat_StatTabEntry *tabentry;
-	PgStat_StatTabEntry tabbuf;
-	PgStat_StatFuncEntry funcbuf;
-	PgStat_StatFuncEntry *funcentry;
+	PgStat_GlobalStats myGlobalStats;
 	FILE	   *fpin;
 	int32		format_id;
-	bool		found;
-	char		statfile[MAXPGPATH];
-
-	get_dbstat_filename(permanent, false, databaseid, statfile, MAXPGPATH);
+	const char *statfile = permanent ? PGSTAT_STAT_PERMANENT_FILENAME : pgstat_stat_filename;
 
 	/*
-	 * Try to open the stats file. If it doesn't exist, the backends simply
-	 * return zero for anything and the collector simply starts from scratch
-	 * with empty counters.
-	 *
-	 * ENOENT is a possibility if the stats collector is not running or has
-	 * not yet written the stats file the first time.  Any other failure
-	 * condition is suspicious.
+	 * Try to open the stats file.  As above, anything but ENOENT is worthy of
+	 * complaining about.
 	 */
 	if ((fpin = AllocateFile(statfile, PG_BINARY_R)) == NULL)
 	{
@@ -5425,7 +5373,7 @@ pgstat_read_db_statsfile(Oid databaseid, HTAB *tabhash, HTAB *funchash,
 					(errcode_for_file_access(),
 					 errmsg("could not open statistics file \"%s\": %m",
 							statfile)));
-		return;
+		return false;
 	}
 
 	/*
@@ -5436,281 +5384,256 @@ pgstat_read_db_statsfile(Oid databaseid, HTAB *tabhash, HTAB *funchash,
 	{
 		ereport(pgStatRunningInCollector ? LOG : WARNING,
 				(errmsg("corrupted statistics file \"%s\"", statfile)));
-		goto done;
+		FreeFile(fpin);
+		return false;
 	}
 
 	/*
-	 * We found an existing collector stats file. Read it and put all the
-	 * hashtable entries into place.
+	 * Read global stats struct
 	 */
-	for (;;)
+	if (fread(&myGlobalStats, 1, sizeof(myGlobalStats),
+			  fpin) != sizeof(myGlobalStats))
 	{
-		switch (fgetc(fpin))
-		{
-				/*
-				 * 'T'	A PgStat_StatTabEntry follows.
-				 */
-			case 'T':
-				if (fread(&tabbuf, 1, sizeof(PgStat_StatTabEntry),
-						  fpin) != sizeof(PgStat_StatTabEntry))
-				{
-					ereport(pgStatRunningInCollector ? LOG : WARNING,
-							(errmsg("corrupted statistics file \"%s\"",
-									statfile)));
-					goto done;
-				}
+		ereport(pgStatRunningInCollector ? LOG : WARNING,
+				(errmsg("corrupted statistics file \"%s\"", statfile)));
+		FreeFile(fpin);
+		return false;
+	}
 
-				/*
-				 * Skip if table data not wanted.
-				 */
-				if (tabhash == NULL)
-					break;
+	*ts = myGlobalStats.stats_timestamp;
 
-				tabentry = (PgStat_StatTabEntry *) hash_search(tabhash,
-															   (void *) &tabbuf.tableid,
-															   HASH_ENTER, &found);
+	FreeFile(fpin);
+	return true;
+}
 
-				if (found)
-				{
-					ereport(pgStatRunningInCollector ? LOG : WARNING,
-							(errmsg("corrupted statistics file \"%s\"",
-									statfile)));
-					goto done;
-				}
+/* ----------
+ * pgstat_save_shared_stats() -
+ *
+ *	Write the shared database, table and function statistics to
+ *	PGSTAT_STAT_OBJECTS_FILENAME, for the next start to read back.  Called by
+ *	the checkpointer at shutdown, after the shutdown checkpoint; this is the
+ *	only time these statistics go to disk.
+ *
+ *	After the format ID, the file holds a 'D' record per database, with the
+ *	PgStat_StatDBEntry up to its hashes, then a 'T' record per table and an
+ *	'F' record per function, with the OID of their database followed by the
+ *	PgStat_StatTabEntry or PgStat_StatFuncEntry, and an 'E'.
+ * ----------
+ */
+void
+pgstat_save_shared_stats(void)
+{
+	HASH_SEQ_STATUS hstat;
+	PgStat_StatDBEntry *dbentry;
+	PgStat_SharedTabEntry *tabentry;
+	PgStat_SharedFuncEntry *funcentry;
+	FILE	   *fpout;
+	int32		format_id;
+	const char *tmpfile = PGSTAT_STAT_OBJECTS_TMPFILE;
+	const char *statfile = PGSTAT_STAT_OBJECTS_FILENAME;
+	int			rc;
 
-				memcpy(tabentry, &tabbuf, sizeof(tabbuf));
-				break;
+	if (pgStatSharedDBHash == NULL)
+		return;
 
-				/*
-				 * 'F'	A PgStat_StatFuncEntry follows.
-				 */
-			case 'F':
-				if (fread(&funcbuf, 1, sizeof(PgStat_StatFuncEntry),
-						  fpin) != sizeof(PgStat_StatFuncEntry))
-				{
-					ereport(pgStatRunningInCollector ? LOG : WARNING,
-							(errmsg("corrupted statistics file \"%s\"",
-									statfile)));
-					goto done;
-				}
+	elog(DEBUG2, "writing stats file \"%s\"", statfile);
 
-				/*
-				 * Skip if function data not wanted.
-				 */
-				if (funchash == NULL)
-					break;
+	fpout = AllocateFile(tmpfile, PG_BINARY_W);
+	if (fpout == NULL)
+	{
+		ereport(LOG,
+				(errcode_for_file_access(),
+				 errmsg("could not open temporary statistics file \"%s\": %m",
+						tmpfile)));
+		return;
+	}
 
-				funcentry = (PgStat_StatFuncEntry *) hash_search(funchash,
-																 (void *) &funcbuf.functionid,
-																 HASH_ENTER, &found);
+	format_id = PGSTAT_FILE_FORMAT_ID;
+	rc = fwrite(&format_id, sizeof(format_id), 1, fpout);
+	(void) rc;					/* we'll check for error with ferror */
 
-				if (found)
-				{
-					ereport(pgStatRunningInCollector ? LOG : WARNING,
-							(errmsg("corrupted statistics file \"%s\"",
-									statfile)));
-					goto done;
-				}
+	pgstat_lock_all_partitions(LW_SHARED);
 
-				memcpy(funcentry, &funcbuf, sizeof(funcbuf));
-				break;
+	hash_seq_init(&hstat, pgStatSharedDBHash);
+	while ((dbentry = (PgStat_StatDBEntry *) hash_seq_search(&hstat)) != NULL)
+	{
+		fputc('D', fpout);
+		rc = fwrite(dbentry, offsetof(PgStat_StatDBEntry, tables), 1, fpout);
+		(void) rc;				/* we'll check for error with ferror */
+	}
 
-				/*
-				 * 'E'	The EOF marker of a complete stats file.
-				 */
-			case 'E':
-				goto done;
+	hash_seq_init(&hstat, pgStatSharedTabHash);
+	while ((tabentry = (PgStat_SharedTabEntry *) hash_seq_search(&hstat)) != NULL)
+	{
+		fputc('T', fpout);
+		rc = fwrite(&tabentry->key.databaseid, sizeof(Oid), 1, fpout);
+		(void) rc;				/* we'll check for error with ferror */
+		rc = fwrite(&tabentry->stats, sizeof(PgStat_StatTabEntry), 1, fpout);
+		(void) rc;				/* we'll check for error with ferror */
+	}
 
-			default:
-				ereport(pgStatRunningInCollector ? LOG : WARNING,
-						(errmsg("corrupted statistics file \"%s\"",
-								statfile)));
-				goto done;
-		}
+	hash_seq_init(&hstat, pgStatSharedFuncHash);
+	while ((funcentry = (PgStat_SharedFuncEntry *) hash_seq_search(&hstat)) != NULL)
+	{
+		fputc('F', fpout);
+		rc = fwrite(&funcentry->key.databaseid, sizeof(Oid), 1, fpout);
+		(void) rc;				/* we'll check for error with ferror */
+		rc = fwrite(&funcentry->stats, sizeof(PgStat_StatFuncEntry), 1, fpout);
+		(void) rc;				/* we'll check for error with ferror */
 	}
 
-done:
-	FreeFile(fpin);
+	pgstat_unlock_all_partitions();
 
-	if (permanent)
+	fputc('E', fpout);
+
+	if (ferror(fpout))
 	{
-		elog(DEBUG2, "removing permanent stats file \"%s\"", statfile);
-		unlink(statfile);
+		ereport(LOG,
+				(errcode_for_file_access(),
+				 errmsg("could not write temporary statistics file \"%s\": %m",
+						tmpfile)));
+		FreeFile(fpout);
+		unlink(tmpfile);
+	}
+	else if (FreeFile(fpout) < 0)
+	{
+		ereport(LOG,
+				(errcode_for_file_access(),
+				 errmsg("could not close temporary statistics file \"%s\": %m",
+						tmpfile)));
+		unlink(tmpfile);
+	}
+	else if (rename(tmpfile, statfile) < 0)
+	{
+		ereport(LOG,
+				(errcode_for_file_access(),
+				 errmsg("could not rename temporary statistics file \"%s\" to \"%s\": %m",
+						tmpfile, statfile)));
+		unlink(tmpfile);
 	}
 }
 
 /* ----------
- * pgstat_read_db_statsfile_timestamp() -
+ * pgstat_restore_shared_stats() -
  *
- *	Attempt to determine the timestamp of the last db statfile write.
- *	Returns true if successful; the timestamp is stored in *ts.
- *
- *	This needs to be careful about handling databases for which no stats file
- *	exists, such as databases without a stat entry or those not yet written:
- *
- *	- if there's a database entry in the global file, return the corresponding
- *	stats_timestamp value.
- *
- *	- if there's no db stat entry (e.g. for a new or inactive database),
- *	there's no stats_timestamp value, but also nothing to write so we return
- *	the timestamp of the global statfile.
+ *	Load the file pgstat_save_shared_stats() wrote at the last shutdown into
+ *	the shared tables, and remove it: the shared tables are authoritative
+ *	from now on, and the file would be out of date after a crash.  Called by
+ *	the startup process when no recovery is needed, as recovery discards the
+ *	statistics.
  * ----------
  */
-static bool
-pgstat_read_db_statsfile_timestamp(Oid databaseid, bool permanent,
-								   TimestampTz *ts)
+void
+pgstat_restore_shared_stats(void)
 {
-	PgStat_StatDBEntry dbentry;
-	PgStat_GlobalStats myGlobalStats;
-	PgStat_ArchiverStats myArchiverStats;
-	PgStat_SLRUStats mySLRUStats[SLRU_NUM_ELEMENTS];
+	PgStat_StatDBEntry dbbuf;
+	PgStat_StatTabEntry tabbuf;
+	PgStat_StatFuncEntry funcbuf;
+	PgStat_StatDBEntry *dbentry;
+	PgStat_StatTabEntry *tabentry;
+	PgStat_StatFuncEntry *funcentry;
+	Oid			dbid;
+	LWLock	   *lock;
 	FILE	   *fpin;
 	int32		format_id;
-	const char *statfile = permanent ? PGSTAT_STAT_PERMANENT_FILENAME : pgstat_stat_filename;
+	const char *statfile = PGSTAT_STAT_OBJECTS_FILENAME;
+
+	if (pgStatSharedDBHash == NULL)
+		return;
 
-	/*
-	 * Try to open the stats file.  As above, anything but ENOENT is worthy of
-	 * complaining about.
-	 */
 	if ((fpin = AllocateFile(statfile, PG_BINARY_R)) == NULL)
 	{
 		if (errno != ENOENT)
-			ereport(pgStatRunningInCollector ? LOG : WARNING,
+			ereport(LOG,
 					(errcode_for_file_access(),
 					 errmsg("could not open statistics file \"%s\": %m",
 							statfile)));
-		return false;
+		return;
 	}
 
-	/*
-	 * Verify it's of the expected format.
-	 */
 	if (fread(&format_id, 1, sizeof(format_id), fpin) != sizeof(format_id) ||
 		format_id != PGSTAT_FILE_FORMAT_ID)
-	{
-		ereport(pgStatRunningInCollector ? LOG : WARNING,
-				(errmsg("corrupted statistics file \"%s\"", statfile)));
-		FreeFile(fpin);
-		return false;
-	}
-
-	/*
-	 * Read global stats struct
-	 */
-	if (fread(&myGlobalStats, 1, sizeof(myGlobalStats),
-			  fpin) != sizeof(myGlobalStats))
-	{
-		ereport(pgStatRunningInCollector ? LOG : WARNING,
-				(errmsg("corrupted statistics file \"%s\"", statfile)));
-		FreeFile(fpin);
-		return false;
-	}
-
-	/*
-	 * Read archiver stats struct
-	 */
-	if (fread(&myArchiverStats, 1, sizeof(myArchiverStats),
-			  fpin) != sizeof(myArchiverStats))
-	{
-		ereport(pgStatRunningInCollector ? LOG : WARNING,
-				(errmsg("corrupted statistics file \"%s\"", statfile)));
-		FreeFile(fpin);
-		return false;
-	}
-
-	/*
-	 * Read SLRU stats struct
-	 */
-	if (fread(mySLRUStats, 1, sizeof(mySLRUStats), fpin) != sizeof(mySLRUStats))
-	{
-		ereport(pgStatRunningInCollector ? LOG : WARNING,
-				(errmsg("corrupted statistics file \"%s\"", statfile)));
-		FreeFile(fpin);
-		return false;
-	}
-
-	/* By default, we're going to return the timestamp of the global file. */
-	*ts = myGlobalStats.stats_timestamp;
+		goto corrupted;
 
-	/*
-	 * We found an existing collector stats file.  Read it and look for a
-	 * record for the requested database.  If found, use its timestamp.
-	 */
 	for (;;)
 	{
 		switch (fgetc(fpin))
 		{
-				/*
-				 * 'D'	A PgStat_StatDBEntry struct describing a database
-				 * follows.
-				 */
 			case 'D':
-				if (fread(&dbentry, 1, offsetof(PgStat_StatDBEntry, tables),
+				if (fread(&dbbuf, 1, offsetof(PgStat_StatDBEntry, tables),
 						  fpin) != offsetof(PgStat_StatDBEntry, tables))
-				{
-					ereport(pgStatRunningInCollector ? LOG : WARNING,
-							(errmsg("corrupted statistics file \"%s\"",
-									statfile)));
-					goto done;
-				}
+					goto corrupted;
 
-				/*
-				 * If this is the DB we're looking for, save its timestamp and
-				 * we're done.
-				 */
-				if (dbentry.databaseid == databaseid)
-				{
-					*ts = dbentry.stats_timestamp;
-					goto done;
-				}
+				dbentry = pgstat_lock_db_entry(dbbuf.databaseid, true,
+											   LW_EXCLUSIVE, &lock);
+				if (dbentry == NULL)
+					break;
+				memcpy(dbentry, &dbbuf, offsetof(PgStat_StatDBEntry, tables));
+				LWLockRelease(lock);
+				break;
+
+			case 'T':
+				if (fread(&dbid, 1, sizeof(Oid), fpin) != sizeof(Oid) ||
+					fread(&tabbuf, 1, sizeof(tabbuf), fpin) != sizeof(tabbuf))
+					goto corrupted;
+
+				tabentry = pgstat_lock_tab_entry(dbid, tabbuf.tableid, true,
+												 LW_EXCLUSIVE, &lock);
+				if (tabentry == NULL)
+					break;
+				memcpy(tabentry, &tabbuf, sizeof(tabbuf));
+				LWLockRelease(lock);
+				break;
+
+			case 'F':
+				if (fread(&dbid, 1, sizeof(Oid), fpin) != sizeof(Oid) ||
+					fread(&funcbuf, 1, sizeof(funcbuf), fpin) != sizeof(funcbuf))
+					goto corrupted;
 
+				funcentry = pgstat_lock_func_entry(dbid, funcbuf.functionid,
+												   true, LW_EXCLUSIVE, &lock);
+				if (funcentry == NULL)
+					break;
+				memcpy(funcentry, &funcbuf, sizeof(funcbuf));
+				LWLockRelease(lock);
 				break;
 
 			case 'E':
 				goto done;
 
 			default:
-				ereport(pgStatRunningInCollector ? LOG : WARNING,
-						(errmsg("corrupted statistics file \"%s\"",
-								statfile)));
-				goto done;
+				goto corrupted;
 		}
 	}
 
+corrupted:
+	ereport(LOG,
+			(errmsg("corrupted statistics file \"%s\"", statfile)));
+
 done:
 	FreeFile(fpin);
-	return true;
+
+	elog(DEBUG2, "removing permanent stats file \"%s\"", statfile);
+	unlink(statfile);
 }
 
 /*
- * If not already done, read the statistics collector stats file into
- * some hash tables.  The results will be kept until pgstat_clear_snapshot()
- * is called (typically, at end of transaction).
+ * If not already done, read the statistics collector stats file, which has
+ * the global, archiver and SLRU stats.  The results will be kept until
+ * pgstat_clear_snapshot() is called (typically, at end of transaction).
  */
 static void
 backend_read_statsfile(void)
 {
 	TimestampTz min_ts = 0;
 	TimestampTz ref_ts = 0;
-	Oid			inquiry_db;
 	int			count;
 
 	/* already read it? */
-	if (pgStatDBHash)
+	if (pgStatGlobalsRead)
 		return;
 	Assert(!pgStatRunningInCollector);
 
-	/*
-	 * In a normal backend, we check staleness of the data for our own DB, and
-	 * so we send MyDatabaseId in inquiry messages.  In the autovac launcher,
-	 * check staleness of the shared-catalog data, and send InvalidOid in
-	 * inquiry messages so as not to force writing unnecessary data.
-	 */
-	if (IsAutoVacuumLauncherProcess())
-		inquiry_db = InvalidOid;
-	else
-		inquiry_db = MyDatabaseId;
-
 	/*
 	 * Loop until fresh enough stats file is available or we ran out of time.
 	 * The stats inquiry message is sent repeatedly in case collector drops
@@ -5724,7 +5647,7 @@ backend_read_statsfile(void)
 
 		CHECK_FOR_INTERRUPTS();
 
-		ok = pgstat_read_db_statsfile_timestamp(inquiry_db, false, &file_ts);
+		ok = pgstat_read_statsfile_timestamp(false, &file_ts);
 
 		cur_ts = GetCurrentTimestamp();
 		/* Calculate min acceptable timestamp, if we didn't already */
@@ -5733,10 +5656,7 @@ backend_read_statsfile(void)
 			/*
 			 * We set the minimum acceptable timestamp to PGSTAT_STAT_INTERVAL
 			 * msec before now.  This indirectly ensures that the collector
-			 * needn't write the file more often than PGSTAT_STAT_INTERVAL. In
-			 * an autovacuum worker, however, we want a lower delay to avoid
-			 * using stale data, so we use PGSTAT_RETRY_DELAY (since the
-			 * number of workers is low, this shouldn't be a problem).
+			 * needn't write the file more often than PGSTAT_STAT_INTERVAL.
 			 *
 			 * We don't recompute min_ts after sleeping, except in the
 			 * unlikely case that cur_ts went backwards.  So we might end up
@@ -5747,12 +5667,8 @@ backend_read_statsfile(void)
 			 * actually accept.
 			 */
 			ref_ts = cur_ts;
-			if (IsAutoVacuumWorkerProcess())
-				min_ts = TimestampTzPlusMilliseconds(ref_ts,
-													 -PGSTAT_RETRY_DELAY);
-			else
-				min_ts = TimestampTzPlusMilliseconds(ref_ts,
-													 -PGSTAT_STAT_INTERVAL);
+			min_ts = TimestampTzPlusMilliseconds(ref_ts,
+												 -PGSTAT_STAT_INTERVAL);
 		}
 
 		/*
@@ -5783,7 +5699,7 @@ backend_read_statsfile(void)
 				pfree(mytime);
 			}
 
-			pgstat_send_inquiry(cur_ts, min_ts, inquiry_db);
+			pgstat_send_inquiry(cur_ts, min_ts);
 			break;
 		}
 
@@ -5793,7 +5709,7 @@ backend_read_statsfile(void)
 
 		/* Not there or too old, so kick the collector and wait a bit */
 		if ((count % PGSTAT_INQ_LOOP_COUNT) == 0)
-			pgstat_send_inquiry(cur_ts, min_ts, inquiry_db);
+			pgstat_send_inquiry(cur_ts, min_ts);
 
 		pg_usleep(PGSTAT_RETRY_DELAY * 1000L);
 	}
@@ -5803,15 +5719,8 @@ backend_read_statsfile(void)
 				(errmsg("using stale statistics instead of current ones "
 						"because stats collector is not responding")));
 
-	/*
-	 * Autovacuum launcher wants stats about all databases, but a shallow read
-	 * is sufficient.  Regular backends want a deep read for just the tables
-	 * they can see (MyDatabaseId + shared catalogs).
-	 */
-	if (IsAutoVacuumLauncherProcess())
-		pgStatDBHash = pgstat_read_statsfiles(InvalidOid, false, false);
-	else
-		pgStatDBHash = pgstat_read_statsfiles(MyDatabaseId, false, true);
+	pgstat_read_statsfile(false);
+	pgStatGlobalsRead = true;
 }
 
 
@@ -5851,6 +5760,7 @@ pgstat_clear_snapshot(void)
 	/* Reset variables */
 	pgStatLocalContext = NULL;
 	pgStatDBHash = NULL;
+	pgStatGlobalsRead = false;
 	localBackendStatusTable = NULL;
 	localNumBackends = 0;
 }
@@ -5865,26 +5775,23 @@ pgstat_clear_snapshot(void)
 static void
 pgstat_recv_inquiry(PgStat_MsgInquiry *msg, int len)
 {
-	PgStat_StatDBEntry *dbentry;
-
-	elog(DEBUG2, "received inquiry for database %u", msg->databaseid);
+	elog(DEBUG2, "received inquiry");
 
 	/*
-	 * If there's already a write request for this DB, there's nothing to do.
+	 * If there's already a write request, there's nothing to do.
 	 *
-	 * Note that if a request is found, we return early and skip the below
-	 * check for clock skew.  This is okay, since the only way for a DB
-	 * request to be present in the list is that we have been here since the
-	 * last write round.  It seems sufficient to check for clock skew once per
-	 * write round.
+	 * Note that if a request is pending, we return early and skip the below
+	 * check for clock skew.  This is okay, since the only way for a request
+	 * to be pending is that we have been here since the last write round.
+	 * It seems sufficient to check for clock skew once per write round.
 	 */
-	if (list_member_oid(pending_write_requests, msg->databaseid))
+	if (pending_write_request)
 		return;
 
 	/*
-	 * Check to see if we last wrote this database at a time >= the requested
+	 * Check to see if we last wrote the file at a time >= the requested
 	 * cutoff time.  If so, this is a stale request that was generated before
-	 * we updated the DB file, and we don't need to do so again.
+	 * we updated the file, and we don't need to do so again.
 	 *
 	 * If the requestor's local clock time is older than stats_timestamp, we
 	 * should suspect a clock glitch, ie system time going backwards; though
@@ -5893,22 +5800,11 @@ pgstat_recv_inquiry(PgStat_MsgInquiry *msg, int len)
 	 * retreat in the system clock reading could otherwise cause us to neglect
 	 * to update the stats file for a long time.
 	 */
-	dbentry = pgstat_get_db_entry(msg->databaseid, false);
-	if (dbentry == NULL)
-	{
-		/*
-		 * We have no data for this DB.  Enter a write request anyway so that
-		 * the global stats will get updated.  This is needed to prevent
-		 * backend_read_statsfile from waiting for data that we cannot supply,
-		 * in the case of a new DB that nobody has yet reported any stats for.
-		 * See the behavior of pgstat_read_db_statsfile_timestamp.
-		 */
-	}
-	else if (msg->clock_time < dbentry->stats_timestamp)
+	if (msg->clock_time < globalStats.stats_timestamp)
 	{
 		TimestampTz cur_ts = GetCurrentTimestamp();
 
-		if (cur_ts < dbentry->stats_timestamp)
+		if (cur_ts < globalStats.stats_timestamp)
 		{
 			/*
 			 * Sure enough, time went backwards.  Force a new stats file write
@@ -5918,11 +5814,11 @@ pgstat_recv_inquiry(PgStat_MsgInquiry *msg, int len)
 			char	   *mytime;
 
 			/* Copy because timestamptz_to_str returns a static buffer */
-			writetime = pstrdup(timestamptz_to_str(dbentry->stats_timestamp));
+			writetime = pstrdup(timestamptz_to_str(globalStats.stats_timestamp));
 			mytime = pstrdup(timestamptz_to_str(cur_ts));
 			elog(LOG,
-				 "stats_timestamp %s is later than collector's time %s for database %u",
-				 writetime, mytime, dbentry->databaseid);
+				 "stats_timestamp %s is later than collector's time %s",
+				 writetime, mytime);
 			pfree(writetime);
 			pfree(mytime);
 		}
@@ -5935,242 +5831,162 @@ pgstat_recv_inquiry(PgStat_MsgInquiry *msg, int len)
 			return;
 		}
 	}
-	else if (msg->cutoff_time <= dbentry->stats_timestamp)
+	else if (msg->cutoff_time <= globalStats.stats_timestamp)
 	{
 		/* Stale request, ignore it */
 		return;
 	}
 
 	/*
-	 * We need to write this DB, so create a request.
+	 * We need to write the file, so note the request.
 	 */
-	pending_write_requests = lappend_oid(pending_write_requests,
-										 msg->databaseid);
+	pending_write_request = true;
 }
 
 
 /* ----------
- * pgstat_recv_tabstat() -
+ * pgstat_apply_tabstat() -
  *
- *	Count what the backend has done.
+ *	Count what the backend has done into the shared tables.
  * ----------
  */
 static void
-pgstat_recv_tabstat(PgStat_MsgTabstat *msg, int len)
+pgstat_apply_tabstat(PgStat_MsgTabstat *msg)
 {
 	PgStat_StatDBEntry *dbentry;
 	PgStat_StatTabEntry *tabentry;
+	PgStat_TableCounts dbcounts;
+	LWLock	   *lock;
 	int			i;
-	bool		found;
-
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
 
-	/*
-	 * Update database-wide stats.
-	 */
-	dbentry->n_xact_commit += (PgStat_Counter) (msg->m_xact_commit);
-	dbentry->n_xact_rollback += (PgStat_Counter) (msg->m_xact_rollback);
-	dbentry->n_block_read_time += msg->m_block_read_time;
-	dbentry->n_block_write_time += msg->m_block_write_time;
+	MemSet(&dbcounts, 0, sizeof(dbcounts));
 
 	/*
-	 * Process all table entries in the message.
+	 * Process all table entries in the message.  A new entry starts from
+	 * zero, so adding the values to it initializes it to them.
 	 */
 	for (i = 0; i < msg->m_nentries; i++)
 	{
 		PgStat_TableEntry *tabmsg = &(msg->m_entry[i]);
 
-		tabentry = (PgStat_StatTabEntry *) hash_search(dbentry->tables,
-													   (void *) &(tabmsg->t_id),
-													   HASH_ENTER, &found);
+		/*
+		 * Add per-table stats to the per-database entry, too.
+		 */
+		dbcounts.t_tuples_returned += tabmsg->t_counts.t_tuples_returned;
+		dbcounts.t_tuples_fetched += tabmsg->t_counts.t_tuples_fetched;
+		dbcounts.t_tuples_inserted += tabmsg->t_counts.t_tuples_inserted;
+		dbcounts.t_tuples_updated += tabmsg->t_counts.t_tuples_updated;
+		dbcounts.t_tuples_deleted += tabmsg->t_counts.t_tuples_deleted;
+		dbcounts.t_blocks_fetched += tabmsg->t_counts.t_blocks_fetched;
+		dbcounts.t_blocks_hit += tabmsg->t_counts.t_blocks_hit;
+
+		tabentry = pgstat_lock_tab_entry(msg->m_databaseid, tabmsg->t_id,
+										 true, LW_EXCLUSIVE, &lock);
+		if (tabentry == NULL)
+			continue;
 
-		if (!found)
-		{
-			/*
-			 * If it's a new table entry, initialize counters to the values we
-			 * just got.
-			 */
-			tabentry->numscans = tabmsg->t_counts.t_numscans;
-			tabentry->tuples_returned = tabmsg->t_counts.t_tuples_returned;
-			tabentry->tuples_fetched = tabmsg->t_counts.t_tuples_fetched;
-			tabentry->tuples_inserted = tabmsg->t_counts.t_tuples_inserted;
-			tabentry->tuples_updated = tabmsg->t_counts.t_tuples_updated;
-			tabentry->tuples_deleted = tabmsg->t_counts.t_tuples_deleted;
-			tabentry->tuples_hot_updated = tabmsg->t_counts.t_tuples_hot_updated;
-			tabentry->n_live_tuples = tabmsg->t_counts.t_delta_live_tuples;
-			tabentry->n_dead_tuples = tabmsg->t_counts.t_delta_dead_tuples;
-			tabentry->changes_since_analyze = tabmsg->t_counts.t_changed_tuples;
-			tabentry->inserts_since_vacuum = tabmsg->t_counts.t_tuples_inserted;
-			tabentry->blocks_fetched = tabmsg->t_counts.t_blocks_fetched;
-			tabentry->blocks_hit = tabmsg->t_counts.t_blocks_hit;
-
-			tabentry->vacuum_timestamp = 0;
-			tabentry->vacuum_count = 0;
-			tabentry->autovac_vacuum_timestamp = 0;
-			tabentry->autovac_vacuum_count = 0;
-			tabentry->analyze_timestamp = 0;
-			tabentry->analyze_count = 0;
-			tabentry->autovac_analyze_timestamp = 0;
-			tabentry->autovac_analyze_count = 0;
-		}
-		else
+		tabentry->numscans += tabmsg->t_counts.t_numscans;
+		tabentry->tuples_returned += tabmsg->t_counts.t_tuples_returned;
+		tabentry->tuples_fetched += tabmsg->t_counts.t_tuples_fetched;
+		tabentry->tuples_inserted += tabmsg->t_counts.t_tuples_inserted;
+		tabentry->tuples_updated += tabmsg->t_counts.t_tuples_updated;
+		tabentry->tuples_deleted += tabmsg->t_counts.t_tuples_deleted;
+		tabentry->tuples_hot_updated += tabmsg->t_counts.t_tuples_hot_updated;
+		/* If table was truncated, first reset the live/dead counters */
+		if (tabmsg->t_counts.t_truncated)
 		{
-			/*
-			 * Otherwise add the values to the existing entry.
-			 */
-			tabentry->numscans += tabmsg->t_counts.t_numscans;
-			tabentry->tuples_returned += tabmsg->t_counts.t_tuples_returned;
-			tabentry->tuples_fetched += tabmsg->t_counts.t_tuples_fetched;
-			tabentry->tuples_inserted += tabmsg->t_counts.t_tuples_inserted;
-			tabentry->tuples_updated += tabmsg->t_counts.t_tuples_updated;
-			tabentry->tuples_deleted += tabmsg->t_counts.t_tuples_deleted;
-			tabentry->tuples_hot_updated += tabmsg->t_counts.t_tuples_hot_updated;
-			/* If table was truncated, first reset the live/dead counters */
-			if (tabmsg->t_counts.t_truncated)
-			{
-				tabentry->n_live_tuples = 0;
-				tabentry->n_dead_tuples = 0;
-				tabentry->inserts_since_vacuum = 0;
-			}
-			tabentry->n_live_tuples += tabmsg->t_counts.t_delta_live_tuples;
-			tabentry->n_dead_tuples += tabmsg->t_counts.t_delta_dead_tuples;
-			tabentry->changes_since_analyze += tabmsg->t_counts.t_changed_tuples;
-			tabentry->inserts_since_vacuum += tabmsg->t_counts.t_tuples_inserted;
-			tabentry->blocks_fetched += tabmsg->t_counts.t_blocks_fetched;
-			tabentry->blocks_hit += tabmsg->t_counts.t_blocks_hit;
+			tabentry->n_live_tuples = 0;
+			tabentry->n_dead_tuples = 0;
+			tabentry->inserts_since_vacuum = 0;
 		}
+		tabentry->n_live_tuples += tabmsg->t_counts.t_delta_live_tuples;
+		tabentry->n_dead_tuples += tabmsg->t_counts.t_delta_dead_tuples;
+		tabentry->changes_since_analyze += tabmsg->t_counts.t_changed_tuples;
+		tabentry->inserts_since_vacuum += tabmsg->t_counts.t_tuples_inserted;
+		tabentry->blocks_fetched += tabmsg->t_counts.t_blocks_fetched;
+		tabentry->blocks_hit += tabmsg->t_counts.t_blocks_hit;
 
 		/* Clamp n_live_tuples in case of negative delta_live_tuples */
 		tabentry->n_live_tuples = Max(tabentry->n_live_tuples, 0);
 		/* Likewise for n_dead_tuples */
 		tabentry->n_dead_tuples = Max(tabentry->n_dead_tuples, 0);
 
-		/*
-		 * Add per-table stats to the per-database entry, too.
-		 */
-		dbentry->n_tuples_returned += tabmsg->t_counts.t_tuples_returned;
-		dbentry->n_tuples_fetched += tabmsg->t_counts.t_tuples_fetched;
-		dbentry->n_tuples_inserted += tabmsg->t_counts.t_tuples_inserted;
-		dbentry->n_tuples_updated += tabmsg->t_counts.t_tuples_updated;
-		dbentry->n_tuples_deleted += tabmsg->t_counts.t_tuples_deleted;
-		dbentry->n_blocks_fetched += tabmsg->t_counts.t_blocks_fetched;
-		dbentry->n_blocks_hit += tabmsg->t_counts.t_blocks_hit;
+		LWLockRelease(lock);
 	}
-}
-
-
-/* ----------
- * pgstat_recv_tabpurge() -
- *
- *	Arrange for dead table removal.
- * ----------
- */
-static void
-pgstat_recv_tabpurge(PgStat_MsgTabpurge *msg, int len)
-{
-	PgStat_StatDBEntry *dbentry;
-	int			i;
-
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, false);
 
 	/*
-	 * No need to purge if we don't even know the database.
+	 * Update database-wide stats.
 	 */
-	if (!dbentry || !dbentry->tables)
+	dbentry = pgstat_lock_db_entry(msg->m_databaseid, true, LW_EXCLUSIVE,
+								   &lock);
+	if (dbentry == NULL)
 		return;
 
-	/*
-	 * Process all table entries in the message.
-	 */
-	for (i = 0; i < msg->m_nentries; i++)
-	{
-		/* Remove from hashtable if present; we don't care if it's not. */
-		(void) hash_search(dbentry->tables,
-						   (void *) &(msg->m_tableid[i]),
-						   HASH_REMOVE, NULL);
-	}
+	dbentry->n_xact_commit += (PgStat_Counter) (msg->m_xact_commit);
+	dbentry->n_xact_rollback += (PgStat_Counter) (msg->m_xact_rollback);
+	dbentry->n_block_read_time += msg->m_block_read_time;
+	dbentry->n_block_write_time += msg->m_block_write_time;
+	dbentry->n_tuples_returned += dbcounts.t_tuples_returned;
+	dbentry->n_tuples_fetched += dbcounts.t_tuples_fetched;
+	dbentry->n_tuples_inserted += dbcounts.t_tuples_inserted;
+	dbentry->n_tuples_updated += dbcounts.t_tuples_updated;
+	dbentry->n_tuples_deleted += dbcounts.t_tuples_deleted;
+	dbentry->n_blocks_fetched += dbcounts.t_blocks_fetched;
+	dbentry->n_blocks_hit += dbcounts.t_blocks_hit;
+
+	LWLockRelease(lock);
 }
 
 
 /* ----------
- * pgstat_recv_dropdb() -
+ * pgstat_apply_dropdb() -
  *
- *	Arrange for dead database removal
+ *	Remove the shared entries of a dead database.
  * ----------
  */
 static void
-pgstat_recv_dropdb(PgStat_MsgDropdb *msg, int len)
+pgstat_apply_dropdb(PgStat_MsgDropdb *msg)
 {
 	Oid			dbid = msg->m_databaseid;
-	PgStat_StatDBEntry *dbentry;
-
-	/*
-	 * Lookup the database in the hashtable.
-	 */
-	dbentry = pgstat_get_db_entry(dbid, false);
-
-	/*
-	 * If found, remove it (along with the db statfile).
-	 */
-	if (dbentry)
-	{
-		char		statfile[MAXPGPATH];
-
-		get_dbstat_filename(false, false, dbid, statfile, MAXPGPATH);
 
-		elog(DEBUG2, "removing stats file \"%s\"", statfile);
-		unlink(statfile);
+	pgstat_lock_all_partitions(LW_EXCLUSIVE);
 
-		if (dbentry->tables != NULL)
-			hash_destroy(dbentry->tables);
-		if (dbentry->functions != NULL)
-			hash_destroy(dbentry->functions);
+	pgstat_remove_db_objects(dbid);
+	(void) hash_search(pgStatSharedDBHash, (void *) &dbid, HASH_REMOVE, NULL);
 
-		if (hash_search(pgStatDBHash,
-						(void *) &dbid,
-						HASH_REMOVE, NULL) == NULL)
-			ereport(ERROR,
-					(errmsg("database hash table corrupted during cleanup --- abort")));
-	}
+	pgstat_unlock_all_partitions();
 }
 
 
 /* ----------
- * pgstat_recv_resetcounter() -
+ * pgstat_apply_resetcounter() -
  *
  *	Reset the statistics for the specified database.
  * ----------
  */
 static void
-pgstat_recv_resetcounter(PgStat_MsgResetcounter *msg, int len)
+pgstat_apply_resetcounter(PgStat_MsgResetcounter *msg)
 {
 	PgStat_StatDBEntry *dbentry;
+	Oid			dbid = msg->m_databaseid;
 
-	/*
-	 * Lookup the database in the hashtable.  Nothing to do if not there.
-	 */
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, false);
-
-	if (!dbentry)
-		return;
+	pgstat_lock_all_partitions(LW_EXCLUSIVE);
 
 	/*
-	 * We simply throw away all the database's table entries by recreating a
-	 * new hash table for them.
+	 * Lookup the database in the hashtable.  Nothing to do if not there.
+	 * Else throw away all the database's table and function entries, and
+	 * reset the database-level stats, too.
 	 */
-	if (dbentry->tables != NULL)
-		hash_destroy(dbentry->tables);
-	if (dbentry->functions != NULL)
-		hash_destroy(dbentry->functions);
-
-	dbentry->tables = NULL;
-	dbentry->functions = NULL;
+	dbentry = (PgStat_StatDBEntry *) hash_search(pgStatSharedDBHash,
+												 (void *) &dbid,
+												 HASH_FIND, NULL);
+	if (dbentry)
+	{
+		pgstat_remove_db_objects(dbid);
+		reset_dbentry_counters(dbentry);
+	}
 
-	/*
-	 * Reset database-level stats, too.  This creates empty hash tables for
-	 * tables and functions.
-	 */
-	reset_dbentry_counters(dbentry);
+	pgstat_unlock_all_partitions();
 }
 
 /* ----------
@@ -6202,31 +6018,33 @@ pgstat_recv_resetsharedcounter(PgStat_MsgResetsharedcounter *msg, int len)
 }
 
 /* ----------
- * pgstat_recv_resetsinglecounter() -
+ * pgstat_apply_resetsinglecounter() -
  *
  *	Reset a statistics for a single object
  * ----------
  */
 static void
-pgstat_recv_resetsinglecounter(PgStat_MsgResetsinglecounter *msg, int len)
+pgstat_apply_resetsinglecounter(PgStat_MsgResetsinglecounter *msg)
 {
 	PgStat_StatDBEntry *dbentry;
+	LWLock	   *lock;
 
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, false);
-
+	dbentry = pgstat_lock_db_entry(msg->m_databaseid, false, LW_EXCLUSIVE,
+								   &lock);
 	if (!dbentry)
 		return;
 
 	/* Set the reset timestamp for the whole database */
 	dbentry->stat_reset_timestamp = GetCurrentTimestamp();
+	LWLockRelease(lock);
 
 	/* Remove object if it exists, ignore it if not */
 	if (msg->m_resettype == RESET_TABLE)
-		(void) hash_search(dbentry->tables, (void *) &(msg->m_objectid),
-						   HASH_REMOVE, NULL);
+		pgstat_remove_shared_entry(pgStatSharedTabHash, msg->m_databaseid,
+								   msg->m_objectid);
 	else if (msg->m_resettype == RESET_FUNCTION)
-		(void) hash_search(dbentry->functions, (void *) &(msg->m_objectid),
-						   HASH_REMOVE, NULL);
+		pgstat_remove_shared_entry(pgStatSharedFuncHash, msg->m_databaseid,
+								   msg->m_objectid);
 }
 
 /* ----------
@@ -6253,42 +6071,51 @@ pgstat_recv_resetslrucounter(PgStat_MsgResetslrucounter *msg, int len)
 }
 
 /* ----------
- * pgstat_recv_autovac() -
+ * pgstat_apply_autovac() -
  *
  *	Process an autovacuum signaling message.
  * ----------
  */
 static void
-pgstat_recv_autovac(PgStat_MsgAutovacStart *msg, int len)
+pgstat_apply_autovac(PgStat_MsgAutovacStart *msg)
 {
 	PgStat_StatDBEntry *dbentry;
+	LWLock	   *lock;
 
 	/*
 	 * Store the last autovacuum time in the database's hashtable entry.
 	 */
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
+	dbentry = pgstat_lock_db_entry(msg->m_databaseid, true, LW_EXCLUSIVE,
+								   &lock);
+	if (dbentry == NULL)
+		return;
 
 	dbentry->last_autovac_time = msg->m_start_time;
+
+	LWLockRelease(lock);
 }
 
 /* ----------
- * pgstat_recv_vacuum() -
+ * pgstat_apply_vacuum() -
  *
  *	Process a VACUUM message.
  * ----------
  */
 static void
-pgstat_recv_vacuum(PgStat_MsgVacuum *msg, int len)
+pgstat_apply_vacuum(PgStat_MsgVacuum *msg)
 {
-	PgStat_StatDBEntry *dbentry;
 	PgStat_StatTabEntry *tabentry;
+	LWLock	   *lock;
+
+	pgstat_ensure_db_entry(msg->m_databaseid);
 
 	/*
 	 * Store the data in the table's hashtable entry.
 	 */
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
-
-	tabentry = pgstat_get_tab_entry(dbentry, msg->m_tableoid, true);
+	tabentry = pgstat_lock_tab_entry(msg->m_databaseid, msg->m_tableoid,
+									 true, LW_EXCLUSIVE, &lock);
+	if (tabentry == NULL)
+		return;
 
 	tabentry->n_live_tuples = msg->m_live_tuples;
 	tabentry->n_dead_tuples = msg->m_dead_tuples;
@@ -6315,26 +6142,31 @@ pgstat_recv_vacuum(PgStat_MsgVacuum *msg, int len)
 		tabentry->vacuum_timestamp = msg->m_vacuumtime;
 		tabentry->vacuum_count++;
 	}
+
+	LWLockRelease(lock);
 }
 
 /* ----------
- * pgstat_recv_analyze() -
+ * pgstat_apply_analyze() -
  *
  *	Process an ANALYZE message.
  * ----------
  */
 static void
-pgstat_recv_analyze(PgStat_MsgAnalyze *msg, int len)
+pgstat_apply_analyze(PgStat_MsgAnalyze *msg)
 {
-	PgStat_StatDBEntry *dbentry;
 	PgStat_StatTabEntry *tabentry;
+	LWLock	   *lock;
+
+	pgstat_ensure_db_entry(msg->m_databaseid);
 
 	/*
 	 * Store the data in the table's hashtable entry.
 	 */
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
-
-	tabentry = pgstat_get_tab_entry(dbentry, msg->m_tableoid, true);
+	tabentry = pgstat_lock_tab_entry(msg->m_databaseid, msg->m_tableoid,
+									 true, LW_EXCLUSIVE, &lock);
+	if (tabentry == NULL)
+		return;
 
 	tabentry->n_live_tuples = msg->m_live_tuples;
 	tabentry->n_dead_tuples = msg->m_dead_tuples;
@@ -6357,6 +6189,8 @@ pgstat_recv_analyze(PgStat_MsgAnalyze *msg, int len)
 		tabentry->analyze_timestamp = msg->m_analyzetime;
 		tabentry->analyze_count++;
 	}
+
+	LWLockRelease(lock);
 }
 
 
@@ -6427,17 +6261,21 @@ pgstat_recv_slru(PgStat_MsgSLRU *msg, int len)
 }
 
 /* ----------
- * pgstat_recv_recoveryconflict() -
+ * pgstat_apply_recoveryconflict() -
  *
  *	Process a RECOVERYCONFLICT message.
  * ----------
  */
 static void
-pgstat_recv_recoveryconflict(PgStat_MsgRecoveryConflict *msg, int len)
+pgstat_apply_recoveryconflict(PgStat_MsgRecoveryConflict *msg)
 {
 	PgStat_StatDBEntry *dbentry;
+	LWLock	   *lock;
 
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
+	dbentry = pgstat_lock_db_entry(msg->m_databaseid, true, LW_EXCLUSIVE,
+								   &lock);
+	if (dbentry == NULL)
+		return;
 
 	switch (msg->m_reason)
 	{
@@ -6464,177 +6302,123 @@ pgstat_recv_recoveryconflict(PgStat_MsgRecoveryConflict *msg, int len)
 			dbentry->n_conflict_startup_deadlock++;
 			break;
 	}
+
+	LWLockRelease(lock);
 }
 
 /* ----------
- * pgstat_recv_deadlock() -
+ * pgstat_apply_deadlock() -
  *
  *	Process a DEADLOCK message.
  * ----------
  */
 static void
-pgstat_recv_deadlock(PgStat_MsgDeadlock *msg, int len)
+pgstat_apply_deadlock(PgStat_MsgDeadlock *msg)
 {
 	PgStat_StatDBEntry *dbentry;
+	LWLock	   *lock;
 
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
+	dbentry = pgstat_lock_db_entry(msg->m_databaseid, true, LW_EXCLUSIVE,
+								   &lock);
+	if (dbentry == NULL)
+		return;
 
 	dbentry->n_deadlocks++;
+
+	LWLockRelease(lock);
 }
 
 /* ----------
- * pgstat_recv_checksum_failure() -
+ * pgstat_apply_checksum_failure() -
  *
  *	Process a CHECKSUMFAILURE message.
  * ----------
  */
 static void
-pgstat_recv_checksum_failure(PgStat_MsgChecksumFailure *msg, int len)
+pgstat_apply_checksum_failure(PgStat_MsgChecksumFailure *msg)
 {
 	PgStat_StatDBEntry *dbentry;
+	LWLock	   *lock;
 
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
+	dbentry = pgstat_lock_db_entry(msg->m_databaseid, true, LW_EXCLUSIVE,
+								   &lock);
+	if (dbentry == NULL)
+		return;
 
 	dbentry->n_checksum_failures += msg->m_failurecount;
 	dbentry->last_checksum_failure = msg->m_failure_time;
+
+	LWLockRelease(lock);
 }
 
 /* ----------
- * pgstat_recv_tempfile() -
+ * pgstat_apply_tempfile() -
  *
  *	Process a TEMPFILE message.
  * ----------
  */
 static void
-pgstat_recv_tempfile(PgStat_MsgTempFile *msg, int len)
+pgstat_apply_tempfile(PgStat_MsgTempFile *msg)
 {
 	PgStat_StatDBEntry *dbentry;
+	LWLock	   *lock;
 
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
+	dbentry = pgstat_lock_db_entry(msg->m_databaseid, true, LW_EXCLUSIVE,
+								   &lock);
+	if (dbentry == NULL)
+		return;
 
 	dbentry->n_temp_bytes += msg->m_filesize;
 	dbentry->n_temp_files += 1;
+
+	LWLockRelease(lock);
 }
 
 /* ----------
- * pgstat_recv_funcstat() -
+ * pgstat_apply_funcstat() -
  *
- *	Count what the backend has done.
+ *	Count what the backend has done into the shared tables.
  * ----------
  */
 static void
-pgstat_recv_funcstat(PgStat_MsgFuncstat *msg, int len)
+pgstat_apply_funcstat(PgStat_MsgFuncstat *msg)
 {
 	PgStat_FunctionEntry *funcmsg = &(msg->m_entry[0]);
-	PgStat_StatDBEntry *dbentry;
 	PgStat_StatFuncEntry *funcentry;
+	LWLock	   *lock;
 	int			i;
-	bool		found;
 
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, true);
+	pgstat_ensure_db_entry(msg->m_databaseid);
 
 	/*
-	 * Process all function entries in the message.
+	 * Process all function entries in the message.  As for tables, a new
+	 * entry starts from zero.
 	 */
 	for (i = 0; i < msg->m_nentries; i++, funcmsg++)
 	{
-		funcentry = (PgStat_StatFuncEntry *) hash_search(dbentry->functions,
-														 (void *) &(funcmsg->f_id),
-														 HASH_ENTER, &found);
-
-		if (!found)
-		{
-			/*
-			 * If it's a new function entry, initialize counters to the values
-			 * we just got.
-			 */
-			funcentry->f_numcalls = funcmsg->f_numcalls;
-			funcentry->f_total_time = funcmsg->f_total_time;
-			funcentry->f_self_time = funcmsg->f_self_time;
-		}
-		else
-		{
-			/*
-			 * Otherwise add the values to the existing entry.
-			 */
-			funcentry->f_numcalls += funcmsg->f_numcalls;
-			funcentry->f_total_time += funcmsg->f_total_time;
-			funcentry->f_self_time += funcmsg->f_self_time;
-		}
-	}
-}
-
-/* ----------
- * pgstat_recv_funcpurge() -
- *
- *	Arrange for dead function removal.
- * ----------
- */
-static void
-pgstat_recv_funcpurge(PgStat_MsgFuncpurge *msg, int len)
-{
-	PgStat_StatDBEntry *dbentry;
-	int			i;
-
-	dbentry = pgstat_get_db_entry(msg->m_databaseid, false);
+		funcentry = pgstat_lock_func_entry(msg->m_databaseid, funcmsg->f_id,
+										   true, LW_EXCLUSIVE, &lock);
+		if (funcentry == NULL)
+			continue;
 
-	/*
-	 * No need to purge if we don't even know the database.
-	 */
-	if (!dbentry || !dbentry->functions)
-		return;
+		funcentry->f_numcalls += funcmsg->f_numcalls;
+		funcentry->f_total_time += funcmsg->f_total_time;
+		funcentry->f_self_time += funcmsg->f_self_time;
 
-	/*
-	 * Process all function entries in the message.
-	 */
-	for (i = 0; i < msg->m_nentries; i++)
-	{
-		/* Remove from hashtable if present; we don't care if it's not. */
-		(void) hash_search(dbentry->functions,
-						   (void *) &(msg->m_functionid[i]),
-						   HASH_REMOVE, NULL);
+		LWLockRelease(lock);
 	}
 }
 
 /* ----------
  * pgstat_write_statsfile_needed() -
  *
- *	Do we need to write out any stats files?
+ *	Do we need to write out the stats file?
  * ----------
  */
 static bool
 pgstat_write_statsfile_needed(void)
 {
-	if (pending_write_requests != NIL)
-		return true;
-
-	/* Everything was written recently */
-	return false;
-}
-
-/* ----------
- * pgstat_db_requested() -
- *
- *	Checks whether stats for a particular DB need to be written to a file.
- * ----------
- */
-static bool
-pgstat_db_requested(Oid databaseid)
-{
-	/*
-	 * If any requests are outstanding at all, we should write the stats for
-	 * shared catalogs (the "database" with OID 0).  This ensures that
-	 * backends will see up-to-date stats for shared catalogs, even though
-	 * they send inquiry messages mentioning only their own DB.
-	 */
-	if (databaseid == InvalidOid && pending_write_requests != NIL)
-		return true;
-
-	/* Search to see if there's an open request to write this database. */
-	if (list_member_oid(pending_write_requests, databaseid))
-		return true;
-
-	return false;
+	return pending_write_request;
 }
 
 /*
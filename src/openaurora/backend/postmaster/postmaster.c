@@ -185,6 +185,24 @@ typedef struct bkend
 
 static dlist_head BackendList = DLIST_STATIC_INIT(BackendList);
 
+/*
+ * Backends started ahead of their clients, see MaybeStartWarmBackends.  Each
+ * is in BackendList as well, and waits on the other end of channel for the
+ * socket of its client.  The oldest ones are at the tail and are handed
+ * clients first.
+ */
+typedef struct WarmBackend
+{
+	pid_t		pid;
+	pgsocket	channel;		/* postmaster's end of a socketpair */
+	dlist_node	elem;
+} WarmBackend;
+
+static dlist_head WarmBackendList = DLIST_STATIC_INIT(WarmBackendList);
+static int	NumWarmBackends = 0;
+
+int			rpc_warm_backends = 0;
+
 #ifdef EXEC_BACKEND
 static Backend *ShmemBackendArray;
 #endif
@@ -418,6 +436,15 @@ static void BackendRun(Port *port) pg_attribute_noreturn();
 static void ExitPostmaster(int status) pg_attribute_noreturn();
 static int	ServerLoop(void);
 static int	BackendStartup(Port *port);
+static void MaybeStartWarmBackends(void);
+#ifndef EXEC_BACKEND
+static bool StartWarmBackend(void);
+static void WarmBackendMain(pgsocket channel) pg_attribute_noreturn();
+#endif
+static bool HandOffToWarmBackend(Port *port);
+static void ForgetWarmBackend(WarmBackend *wb);
+static void ForgetWarmBackendPid(int pid);
+static void RetireWarmBackends(void);
 static int	ProcessStartupPacket(Port *port, bool ssl_done, bool gss_done);
 static void SendNegotiateProtocolVersion(List *unrecognized_protocol_options);
 static void processCancelRequest(Port *port, void *pkt);
@@ -525,6 +552,7 @@ typedef struct
 	bool		IsBinaryUpgrade;
 	int			max_safe_fds;
 	int			MaxBackends;
+	int			FastPathLockGroupsPerBackend;
 #ifdef WIN32
 	HANDLE		PostmasterHandle;
 	HANDLE		initial_signal_pipe;
@@ -1418,7 +1446,8 @@ PostmasterMain(int argc, char *argv[])
 
 	/* Some workers may be scheduled to start now */
 	maybe_start_bgworkers();
-	if(IsRpcClient > 1)
+	/* It also holds the page versions of a node pinned to a past LSN */
+	if(IsRpcClient > 1 || (IsRpcClient && RpcAsOfLsn != InvalidXLogRecPtr))
 		MPSyncPID = StartMemPoolSynchronizer();
 
 	status = ServerLoop();
@@ -1748,7 +1777,8 @@ ServerLoop(void)
 					port = ConnCreate(ListenSocket[i]);
 					if (port)
 					{
-						BackendStartup(port);
+						if (!HandOffToWarmBackend(port))
+							BackendStartup(port);
 
 						/*
 						 * We no longer need the open socket or port structure
@@ -1827,6 +1857,9 @@ ServerLoop(void)
 		if (StartWorkerNeeded || HaveCrashedWorker)
 			maybe_start_bgworkers();
 
+		/* Replace the warm backends that got a client or went away */
+		MaybeStartWarmBackends();
+
 #ifdef HAVE_PTHREAD_IS_THREADED_NP
 
 		/*
@@ -2640,6 +2673,12 @@ ClosePostmasterPorts(bool am_syslogger)
 	if (bonjour_sdref)
 		close(DNSServiceRefSockFD(bonjour_sdref));
 #endif
+
+	/*
+	 * Close the channels to the warm backends, which must see the postmaster
+	 * close its end.  Not tracked by fd.c either.
+	 */
+	RetireWarmBackends();
 }
 
 
@@ -2768,6 +2807,12 @@ SIGHUP_handler(SIGNAL_ARGS)
 		/* Update the starting-point file for future children */
 		write_nondefault_variables(PGC_SIGHUP);
 #endif
+
+		/*
+		 * The warm backends carry the old configuration and pg_hba.conf;
+		 * ServerLoop starts new ones.
+		 */
+		RetireWarmBackends();
 	}
 
 #ifdef WIN32
@@ -2951,6 +2996,9 @@ reaper(SIGNAL_ARGS)
 
 	while ((pid = waitpid(-1, &exitstatus, WNOHANG)) > 0)
 	{
+		/* A warm backend is cleaned up as a backend below, too */
+		ForgetWarmBackendPid(pid);
+
 		/*
 		 * Check if this child was a startup process.
 		 */
@@ -3785,6 +3833,14 @@ LogChildExit(int lev, const char *procname, int pid, int exitstatus)
 static void
 PostmasterStateMachine(void)
 {
+	/*
+	 * Warm backends would wait for clients forever, holding up a smart
+	 * shutdown.
+	 */
+	if ((pmState != PM_RUN && pmState != PM_HOT_STANDBY) ||
+		connsAllowed != ALLOW_ALL_CONNS)
+		RetireWarmBackends();
+
 	/* If we're doing a smart shutdown, try to advance that state. */
 	if (pmState == PM_RUN || pmState == PM_HOT_STANDBY)
 	{
@@ -4269,6 +4325,324 @@ BackendStartup(Port *port)
 	return STATUS_OK;
 }
 
+/*
+ * MaybeStartWarmBackends -- keep rpc_warm_backends backends ahead of clients
+ *
+ * A backend of a compute node connects to the storage node on its first
+ * page, and a short session spends much of its life doing so.  A warm
+ * backend is forked and connected before its client arrives, and then waits
+ * for HandOffToWarmBackend to give it the client's socket.  Only while
+ * normal connections are allowed, the warm backends are retired otherwise.
+ *
+ * The mempool client isn't set up ahead, as it takes LWLocks a process
+ * without a PGPROC can't wait on.
+ */
+static void
+MaybeStartWarmBackends(void)
+{
+	int			target = IsRpcClient ? rpc_warm_backends : 0;
+
+	if ((pmState != PM_RUN && pmState != PM_HOT_STANDBY) ||
+		connsAllowed != ALLOW_ALL_CONNS || FatalError)
+		target = 0;
+
+	/* The newest ones go first when there are too many */
+	while (NumWarmBackends > target)
+		ForgetWarmBackend(dlist_head_element(WarmBackend, elem, &WarmBackendList));
+
+#ifndef EXEC_BACKEND
+	while (NumWarmBackends < target &&
+		   canAcceptConnections(BACKEND_TYPE_NORMAL) == CAC_OK)
+	{
+		if (!StartWarmBackend())
+			break;
+	}
+#endif
+}
+
+#ifndef EXEC_BACKEND
+/*
+ * StartWarmBackend -- fork a backend that waits for a client
+ *
+ * The bookkeeping is BackendStartup's, only without the Port.
+ *
+ * returns: false if the fork failed.
+ */
+static bool
+StartWarmBackend(void)
+{
+	Backend    *bn;
+	WarmBackend *wb;
+	int			channel[2];
+	pid_t		pid;
+
+	bn = (Backend *) malloc(sizeof(Backend));
+	wb = (WarmBackend *) malloc(sizeof(WarmBackend));
+	if (!bn || !wb)
+	{
+		free(bn);
+		free(wb);
+		ereport(LOG,
+				(errcode(ERRCODE_OUT_OF_MEMORY),
+				 errmsg("out of memory")));
+		return false;
+	}
+
+	if (!RandomCancelKey(&MyCancelKey))
+	{
+		free(bn);
+		free(wb);
+		ereport(LOG,
+				(errcode(ERRCODE_INTERNAL_ERROR),
+				 errmsg("could not generate random cancel key")));
+		return false;
+	}
+
+	if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, channel) < 0)
+	{
+		free(bn);
+		free(wb);
+		ereport(LOG,
+				(errcode_for_socket_access(),
+				 errmsg("could not create socket pair for warm backend: %m")));
+		return false;
+	}
+
+	bn->cancel_key = MyCancelKey;
+	bn->dead_end = false;
+	bn->child_slot = MyPMChildSlot = AssignPostmasterChildSlot();
+	bn->bgworker_notify = false;
+
+	pid = fork_process();
+	if (pid == 0)				/* child */
+	{
+		free(bn);
+		free(wb);
+		close(channel[0]);
+
+		/* Detangle from postmaster */
+		InitPostmasterChild();
+
+		/* Close the postmaster's sockets */
+		ClosePostmasterPorts(false);
+
+		WarmBackendMain(channel[1]);
+	}
+
+	close(channel[1]);
+
+	if (pid < 0)
+	{
+		/* in parent, fork failed */
+		int			save_errno = errno;
+
+		(void) ReleasePostmasterChildSlot(bn->child_slot);
+		close(channel[0]);
+		free(bn);
+		free(wb);
+		errno = save_errno;
+		ereport(LOG,
+				(errmsg("could not fork warm backend process: %m")));
+		return false;
+	}
+
+	ereport(DEBUG2,
+			(errmsg_internal("forked new warm backend, pid=%d", (int) pid)));
+
+	bn->pid = pid;
+	bn->bkend_type = BACKEND_TYPE_NORMAL;
+	dlist_push_head(&BackendList, &bn->elem);
+
+	wb->pid = pid;
+	wb->channel = channel[0];
+	dlist_push_head(&WarmBackendList, &wb->elem);
+	NumWarmBackends++;
+
+	return true;
+}
+
+/*
+ * WarmBackendMain -- a warm backend until it has a client
+ *
+ * Connects to the storage node and waits for the Port and socket
+ * HandOffToWarmBackend sends.  The postmaster closing the channel instead,
+ * on a reload, a shutdown or by dying, ends the process.  With the client's
+ * socket it goes on as a backend BackendStartup forked would.
+ */
+static void
+WarmBackendMain(pgsocket channel)
+{
+	Port	   *port;
+	struct msghdr msg;
+	struct iovec iov;
+	union
+	{
+		struct cmsghdr hdr;
+		char		buf[CMSG_SPACE(sizeof(int))];
+	}			control;
+	struct cmsghdr *cmsg;
+	ssize_t		rc;
+
+	/* As BackendInitialize does while it waits for the startup packet */
+	pqsignal(SIGTERM, process_startup_packet_die);
+	pqsignal(SIGQUIT, SignalHandlerForCrashExit);
+	PG_SETMASK(&StartupBlockSig);
+
+	if (!RpcWarmUp())
+		ereport(DEBUG1,
+				(errmsg_internal("warm backend could not connect to the storage node")));
+
+	if (!(port = (Port *) calloc(1, sizeof(Port))))
+		ereport(FATAL,
+				(errcode(ERRCODE_OUT_OF_MEMORY),
+				 errmsg("out of memory")));
+
+	memset(&msg, 0, sizeof(msg));
+	iov.iov_base = port;
+	iov.iov_len = sizeof(Port);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buf;
+	msg.msg_controllen = sizeof(control.buf);
+
+	do
+	{
+		rc = recvmsg(channel, &msg, 0);
+	} while (rc < 0 && errno == EINTR);
+
+	cmsg = CMSG_FIRSTHDR(&msg);
+	if (rc != sizeof(Port) || cmsg == NULL ||
+		cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+		proc_exit(1);
+
+	memcpy(&port->sock, CMSG_DATA(cmsg), sizeof(int));
+	close(channel);
+
+	PG_SETMASK(&BlockSig);
+
+	/* The session starts now, not when the process did */
+	InitProcessGlobals();
+
+	/* The postmaster's pointer means nothing here, see ConnCreate */
+#if defined(ENABLE_GSS) || defined(ENABLE_SSPI)
+	port->gss = (pg_gssinfo *) calloc(1, sizeof(pg_gssinfo));
+	if (!port->gss)
+		ereport(FATAL,
+				(errcode(ERRCODE_OUT_OF_MEMORY),
+				 errmsg("out of memory")));
+#endif
+
+	/* Perform additional initialization and collect startup packet */
+	BackendInitialize(port);
+
+	/* And run the backend */
+	BackendRun(port);
+}
+#endif							/* !EXEC_BACKEND */
+
+/*
+ * HandOffToWarmBackend -- give the client of port to a warm backend
+ *
+ * returns: false if no warm backend took it, the caller forks one then.
+ */
+static bool
+HandOffToWarmBackend(Port *port)
+{
+	if (dlist_is_empty(&WarmBackendList))
+		return false;
+
+	/* A connection to be refused goes to a dead-end child as always */
+	port->canAcceptConnections = canAcceptConnections(BACKEND_TYPE_NORMAL);
+	if (port->canAcceptConnections != CAC_OK &&
+		port->canAcceptConnections != CAC_SUPERUSER)
+		return false;
+
+	while (!dlist_is_empty(&WarmBackendList))
+	{
+		WarmBackend *wb = dlist_tail_element(WarmBackend, elem, &WarmBackendList);
+		struct msghdr msg;
+		struct iovec iov;
+		union
+		{
+			struct cmsghdr hdr;
+			char		buf[CMSG_SPACE(sizeof(int))];
+		}			control;
+		struct cmsghdr *cmsg;
+		pid_t		pid = wb->pid;
+		ssize_t		rc;
+
+		memset(&msg, 0, sizeof(msg));
+		memset(&control, 0, sizeof(control));
+		iov.iov_base = port;
+		iov.iov_len = sizeof(Port);
+		msg.msg_iov = &iov;
+		msg.msg_iovlen = 1;
+		msg.msg_control = control.buf;
+		msg.msg_controllen = sizeof(control.buf);
+		cmsg = CMSG_FIRSTHDR(&msg);
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_RIGHTS;
+		cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+		memcpy(CMSG_DATA(cmsg), &port->sock, sizeof(int));
+
+		do
+		{
+			rc = sendmsg(wb->channel, &msg, 0);
+		} while (rc < 0 && errno == EINTR);
+
+		/* Either way it won't wait for a client any more */
+		ForgetWarmBackend(wb);
+
+		if (rc == sizeof(Port))
+		{
+			ereport(DEBUG2,
+					(errmsg_internal("handed connection to warm backend, pid=%d socket=%d",
+									 (int) pid, (int) port->sock)));
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * ForgetWarmBackend -- close the channel to a warm backend
+ *
+ * One still waiting for a client sees that and exits.
+ */
+static void
+ForgetWarmBackend(WarmBackend *wb)
+{
+	close(wb->channel);
+	dlist_delete(&wb->elem);
+	free(wb);
+	NumWarmBackends--;
+}
+
+static void
+ForgetWarmBackendPid(int pid)
+{
+	dlist_mutable_iter iter;
+
+	dlist_foreach_modify(iter, &WarmBackendList)
+	{
+		WarmBackend *wb = dlist_container(WarmBackend, elem, iter.cur);
+
+		if (wb->pid == pid)
+		{
+			ForgetWarmBackend(wb);
+			break;
+		}
+	}
+}
+
+static void
+RetireWarmBackends(void)
+{
+	while (!dlist_is_empty(&WarmBackendList))
+		ForgetWarmBackend(dlist_head_element(WarmBackend, elem, &WarmBackendList));
+}
+
 /*
  * Try to report backend fork() failure to client before we close the
  * connection.  Since we do not care to risk blocking the postmaster on
@@ -6247,6 +6621,7 @@ save_backend_variables(BackendParameters *param, Port *port,
 	param->max_safe_fds = max_safe_fds;
 
 	param->MaxBackends = MaxBackends;
+	param->FastPathLockGroupsPerBackend = FastPathLockGroupsPerBackend;
 
 #ifdef WIN32
 	param->PostmasterHandle = PostmasterHandle;
@@ -6482,6 +6857,7 @@ restore_backend_variables(BackendParameters *param, Port *port)
 	max_safe_fds = param->max_safe_fds;
 
 	MaxBackends = param->MaxBackends;
+	FastPathLockGroupsPerBackend = param->FastPathLockGroupsPerBackend;
 
 #ifdef WIN32
 	PostmasterHandle = param->PostmasterHandle;
@@ -29,6 +29,7 @@
 #include "pgstat.h"
 #include "pqexpbuffer.h"
 #include "replication/walreceiver.h"
+#include "replication/wal_ship_compress.h"
 #include "utils/builtins.h"
 #include "utils/memutils.h"
 #include "utils/pg_lsn.h"
@@ -127,10 +128,22 @@ libpqrcv_connect(const char *conninfo, bool logical, const char *appname,
 {
 	WalReceiverConn *conn;
 	PostgresPollingStatusType status;
-	const char *keys[5];
-	const char *vals[5];
+	const char *keys[6];
+	const char *vals[6];
 	int			i = 0;
 
+	/*
+	 * Ask the walsender to compress the WAL it sends.  This comes before the
+	 * connection string, so options given there take precedence.
+	 */
+	if (!logical && wal_ship_compression != WAL_SHIP_COMPRESSION_OFF)
+	{
+		keys[i] = "options";
+		vals[i] = wal_ship_compression == WAL_SHIP_COMPRESSION_ZSTD ?
+			"-c wal_sender_compression=zstd" : "-c wal_sender_compression=lz4";
+		i++;
+	}
+
 	/*
 	 * We use the expand_dbname parameter to process the connection string (or
 	 * URI), and pass some extra options.
@@ -1018,6 +1031,12 @@ libpqrcv_exec(WalReceiverConn *conn, const char *query,
 			walres->status = WALRCV_ERROR;
 			walres->err = pchomp(PQerrorMessage(conn->streamConn));
 			break;
+
+		case PGRES_PIPELINE_SYNC:
+		case PGRES_PIPELINE_ABORTED:
+			walres->status = WALRCV_ERROR;
+			walres->err = _("unexpected pipeline mode");
+			break;
 	}
 
 	PQclear(pgres);
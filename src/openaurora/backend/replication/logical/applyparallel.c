@@ -0,0 +1,938 @@
+/*-------------------------------------------------------------------------
+ * applyparallel.c
+ *	   Parallel apply of logical replication transactions
+ *
+ * Copyright (c) 2016-2020, PostgreSQL Global Development Group
+ *
+ * IDENTIFICATION
+ *	  src/backend/replication/logical/applyparallel.c
+ *
+ * NOTES
+ *	  The apply worker of a subscription (the leader) hands transactions to
+ *	  up to max_parallel_apply_workers_per_subscription parallel apply
+ *	  workers, so that transactions changing disjoint tables are applied at
+ *	  the same time.  The publisher sends a transaction only once it has
+ *	  committed, so the leader gathers it whole, from BEGIN to COMMIT, and
+ *	  learns which tables it changes on the way.  It is then sent over a
+ *	  shm_mq to an idle worker, once no transaction still being applied
+ *	  changes any of them.  A transaction that truncates, one too large to
+ *	  keep (logical_decoding_work_mem) and all of them while a table is not
+ *	  yet READY are applied by the leader as before, after those being
+ *	  applied by workers are done.
+ *
+ *	  Transactions are told apart by the relations of the publisher they
+ *	  change.  The apply workers run with session_replication_role replica,
+ *	  so foreign keys between tables don't make them depend on each other.
+ *
+ *	  The workers commit in the order the publisher did, each waits for the
+ *	  transaction to commit before it.  It waits on the predecessor's
+ *	  virtual transaction id lock, so that one blocked on a row lock of its
+ *	  successor is found by the deadlock detector rather than waiting
+ *	  forever.  All of them advance the replication origin of the leader, so
+ *	  that the origin always tells the last transaction applied of a prefix
+ *	  of the stream.  The leader reports a position flushed to the publisher
+ *	  only once all before it are.
+ *
+ *	  The RELATION and TYPE messages are sent once per relation and type, to
+ *	  whichever worker applies the transaction they come in.  The leader
+ *	  keeps them all and sends a worker those it hasn't seen before the next
+ *	  transaction it gets, and applies those it hasn't itself before it
+ *	  applies one.
+ *
+ *	  A worker that fails takes the leader down, which stops the others, and
+ *	  the subscription starts again from its origin.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include "access/xact.h"
+#include "libpq/pqformat.h"
+#include "libpq/pqsignal.h"
+#include "miscadmin.h"
+#include "pgstat.h"
+#include "postmaster/bgworker.h"
+#include "postmaster/interrupt.h"
+#include "replication/logicallauncher.h"
+#include "replication/logicalworker.h"
+#include "replication/origin.h"
+#include "replication/reorderbuffer.h"
+#include "replication/worker_internal.h"
+#include "storage/condition_variable.h"
+#include "storage/dsm.h"
+#include "storage/ipc.h"
+#include "storage/lock.h"
+#include "storage/proc.h"
+#include "storage/shm_mq.h"
+#include "storage/spin.h"
+#include "tcop/tcopprot.h"
+#include "utils/guc.h"
+#include "utils/memutils.h"
+
+#define PARALLEL_APPLY_QUEUE_SIZE	(256 * 1024)
+
+/* Maximum time the leader sleeps before checking on its workers (1s) */
+#define PARALLEL_APPLY_NAPTIME		1000L
+
+int			max_parallel_apply_workers_per_subscription = 0;
+
+bool		InParallelApplyWorker = false;
+
+/* A parallel apply worker, in shared memory */
+typedef struct ParallelApplySlot
+{
+	/* Set by the leader before it sends the transaction */
+	uint64		seq;
+	bool		busy;
+
+	/* Set by the worker as it starts a local transaction */
+	VirtualTransactionId vxid;
+
+	/* Set by the worker as it commits, with busy cleared */
+	XLogRecPtr	remote_end;
+	XLogRecPtr	local_end;
+} ParallelApplySlot;
+
+typedef struct ParallelApplyShared
+{
+	Oid			dbid;
+	Oid			userid;
+	Oid			subid;
+	RepOriginId originid;
+	pid_t		leader_pid;
+	int			leader_pgprocno;
+	int			nslots;
+
+	/* Protects the following and the slots */
+	slock_t		mutex;
+
+	/* Sequence number of the transaction to commit next */
+	uint64		next_commit;
+
+	/* Broadcast as next_commit advances or a worker starts a transaction */
+	ConditionVariable commit_cv;
+
+	ParallelApplySlot slots[FLEXIBLE_ARRAY_MEMBER];
+} ParallelApplyShared;
+
+/* The leader's view of a parallel apply worker */
+typedef struct ParallelApplyWorker
+{
+	BackgroundWorkerHandle *handle; /* NULL until launched */
+	shm_mq_handle *mqh;
+
+	/* A transaction was sent whose commit is not yet collected */
+	bool		pending;
+	uint64		seq;
+
+	/* Remote relations it changes */
+	Oid		   *relids;
+	int			nrelids;
+	int			maxrelids;
+
+	/* Schema messages sent so far */
+	int			schema_sent;
+} ParallelApplyWorker;
+
+static dsm_segment *pa_seg = NULL;
+static ParallelApplyShared *pa_shared = NULL;
+
+/* Leader */
+static ParallelApplyWorker *pa_workers = NULL;
+static uint64 pa_last_seq = 0;
+
+/* The RELATION and TYPE messages received, and how many the leader applied */
+static List *pa_schema_log = NIL;
+static int	pa_schema_applied = 0;
+
+/* The transaction being gathered */
+static bool pa_gathering = false;
+static bool pa_replaying = false;
+static StringInfoData pa_gather_buf;
+static bool pa_gather_serial = false;
+static int	pa_gather_schema_start = 0;
+static Oid *pa_gather_relids = NULL;
+static int	pa_gather_nrelids = 0;
+static int	pa_gather_maxrelids = 0;
+
+/* Worker */
+static ParallelApplySlot *MyParallelApplySlot = NULL;
+static LogicalRepWorker pa_worker_info;
+
+static shm_mq *
+pa_queue(ParallelApplyShared *shared, int slotno)
+{
+	Size		offset;
+
+	offset = MAXALIGN(offsetof(ParallelApplyShared, slots) +
+					  shared->nslots * sizeof(ParallelApplySlot));
+	return (shm_mq *) ((char *) shared + offset +
+					   (Size) slotno * PARALLEL_APPLY_QUEUE_SIZE);
+}
+
+/*
+ * Stop the workers as the leader exits, so that none commits a transaction
+ * the next leader will apply again.
+ */
+static void
+pa_shutdown(int code, Datum arg)
+{
+	int			i;
+
+	for (i = 0; i < pa_shared->nslots; i++)
+	{
+		if (pa_workers[i].handle != NULL)
+			TerminateBackgroundWorker(pa_workers[i].handle);
+	}
+	for (i = 0; i < pa_shared->nslots; i++)
+	{
+		if (pa_workers[i].handle != NULL)
+			WaitForBackgroundWorkerShutdown(pa_workers[i].handle);
+	}
+}
+
+static void
+pa_setup(void)
+{
+	int			nslots = max_parallel_apply_workers_per_subscription;
+	Size		size;
+	int			i;
+
+	size = MAXALIGN(offsetof(ParallelApplyShared, slots) +
+					nslots * sizeof(ParallelApplySlot));
+	size = add_size(size, mul_size(nslots, PARALLEL_APPLY_QUEUE_SIZE));
+
+	pa_seg = dsm_create(size, 0);
+	dsm_pin_mapping(pa_seg);
+	pa_shared = dsm_segment_address(pa_seg);
+
+	pa_shared->dbid = MyLogicalRepWorker->dbid;
+	pa_shared->userid = MyLogicalRepWorker->userid;
+	pa_shared->subid = MyLogicalRepWorker->subid;
+	pa_shared->originid = replorigin_session_origin;
+	pa_shared->leader_pid = MyProcPid;
+	pa_shared->leader_pgprocno = MyProc->pgprocno;
+	pa_shared->nslots = nslots;
+	SpinLockInit(&pa_shared->mutex);
+	pa_shared->next_commit = 1;
+	ConditionVariableInit(&pa_shared->commit_cv);
+
+	for (i = 0; i < nslots; i++)
+	{
+		memset(&pa_shared->slots[i], 0, sizeof(ParallelApplySlot));
+		shm_mq_create(pa_queue(pa_shared, i), PARALLEL_APPLY_QUEUE_SIZE);
+	}
+
+	pa_workers = (ParallelApplyWorker *)
+		MemoryContextAllocZero(ApplyContext,
+							   nslots * sizeof(ParallelApplyWorker));
+
+	before_shmem_exit(pa_shutdown, (Datum) 0);
+}
+
+static bool
+pa_launch(int slotno)
+{
+	BackgroundWorker bgw;
+	BackgroundWorkerHandle *handle;
+	ParallelApplyWorker *worker = &pa_workers[slotno];
+	shm_mq	   *mq = pa_queue(pa_shared, slotno);
+	MemoryContext oldctx;
+
+	memset(&bgw, 0, sizeof(bgw));
+	bgw.bgw_flags = BGWORKER_SHMEM_ACCESS |
+		BGWORKER_BACKEND_DATABASE_CONNECTION;
+	bgw.bgw_start_time = BgWorkerStart_RecoveryFinished;
+	snprintf(bgw.bgw_library_name, BGW_MAXLEN, "postgres");
+	snprintf(bgw.bgw_function_name, BGW_MAXLEN, "ParallelApplyWorkerMain");
+	snprintf(bgw.bgw_name, BGW_MAXLEN,
+			 "logical replication parallel apply worker for subscription %u",
+			 MyLogicalRepWorker->subid);
+	snprintf(bgw.bgw_type, BGW_MAXLEN, "logical replication parallel worker");
+	bgw.bgw_restart_time = BGW_NEVER_RESTART;
+	bgw.bgw_notify_pid = MyProcPid;
+	bgw.bgw_main_arg = UInt32GetDatum(dsm_segment_handle(pa_seg));
+	memcpy(bgw.bgw_extra, &slotno, sizeof(int));
+
+	oldctx = MemoryContextSwitchTo(ApplyContext);
+	if (!RegisterDynamicBackgroundWorker(&bgw, &handle))
+	{
+		MemoryContextSwitchTo(oldctx);
+		return false;
+	}
+
+	shm_mq_set_sender(mq, MyProc);
+	worker->mqh = shm_mq_attach(mq, pa_seg, handle);
+	worker->handle = handle;
+	MemoryContextSwitchTo(oldctx);
+
+	return true;
+}
+
+/*
+ * Sleep until a worker commits, checking that none has exited.
+ */
+static void
+pa_wait(void)
+{
+	int			rc;
+	int			i;
+
+	for (i = 0; i < pa_shared->nslots; i++)
+	{
+		pid_t		pid;
+
+		if (pa_workers[i].handle != NULL &&
+			GetBackgroundWorkerPid(pa_workers[i].handle, &pid) == BGWH_STOPPED)
+			ereport(ERROR,
+					(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+					 errmsg("logical replication parallel apply worker for subscription \"%s\" exited unexpectedly",
+							MySubscription->name)));
+	}
+
+	rc = WaitLatch(MyLatch,
+				   WL_LATCH_SET | WL_TIMEOUT | WL_EXIT_ON_PM_DEATH,
+				   PARALLEL_APPLY_NAPTIME,
+				   WAIT_EVENT_LOGICAL_PARALLEL_APPLY_WORKER);
+
+	if (rc & WL_LATCH_SET)
+	{
+		ResetLatch(MyLatch);
+		CHECK_FOR_INTERRUPTS();
+	}
+}
+
+/*
+ * Track the flush positions of the transactions the workers committed, in
+ * the order they did.
+ */
+void
+ParallelApplyCollect(void)
+{
+	if (pa_workers == NULL)
+		return;
+
+	for (;;)
+	{
+		ParallelApplyWorker *next = NULL;
+		ParallelApplySlot *slot;
+		bool		busy;
+		XLogRecPtr	remote_end;
+		XLogRecPtr	local_end;
+		int			i;
+
+		for (i = 0; i < pa_shared->nslots; i++)
+		{
+			if (pa_workers[i].pending &&
+				(next == NULL || pa_workers[i].seq < next->seq))
+				next = &pa_workers[i];
+		}
+		if (next == NULL)
+			return;
+
+		slot = &pa_shared->slots[next - pa_workers];
+		SpinLockAcquire(&pa_shared->mutex);
+		busy = slot->busy;
+		remote_end = slot->remote_end;
+		local_end = slot->local_end;
+		SpinLockRelease(&pa_shared->mutex);
+
+		if (busy)
+			return;
+
+		/* Nothing to flush if it wrote nothing */
+		if (!XLogRecPtrIsInvalid(local_end))
+			store_flush_position(remote_end, local_end);
+		next->pending = false;
+	}
+}
+
+/*
+ * Is a transaction sent to a worker not yet known committed?
+ */
+bool
+ParallelApplyInProgress(void)
+{
+	int			i;
+
+	if (pa_workers == NULL)
+		return false;
+
+	for (i = 0; i < pa_shared->nslots; i++)
+	{
+		if (pa_workers[i].pending)
+			return true;
+	}
+	return false;
+}
+
+/*
+ * Wait until the workers have committed all transactions sent to them, for
+ * the leader to apply the next itself.
+ */
+void
+ParallelApplyWaitAll(void)
+{
+	for (;;)
+	{
+		ParallelApplyCollect();
+		if (!ParallelApplyInProgress())
+			return;
+		pa_wait();
+	}
+}
+
+static bool
+pa_relids_overlap(const ParallelApplyWorker *worker)
+{
+	int			i;
+	int			j;
+
+	for (i = 0; i < worker->nrelids; i++)
+	{
+		for (j = 0; j < pa_gather_nrelids; j++)
+		{
+			if (worker->relids[i] == pa_gather_relids[j])
+				return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * Wait for a worker to take the transaction gathered, once none changing
+ * any of its relations is still being applied.  Returns -1 if no worker can
+ * be had and the leader is to apply it.
+ */
+static int
+pa_wait_for_worker(void)
+{
+	if (pa_shared == NULL)
+		pa_setup();
+
+	for (;;)
+	{
+		int			nslots = Min(pa_shared->nslots,
+								 max_parallel_apply_workers_per_subscription);
+		int			idle = -1;
+		int			unlaunched = -1;
+		int			nlaunched = 0;
+		bool		conflict = false;
+		int			i;
+
+		if (nslots <= 0)
+			return -1;
+
+		ParallelApplyCollect();
+
+		for (i = 0; i < pa_shared->nslots; i++)
+		{
+			ParallelApplyWorker *worker = &pa_workers[i];
+
+			if (worker->handle != NULL)
+				nlaunched++;
+			if (worker->pending)
+				conflict |= pa_relids_overlap(worker);
+			else if (i >= nslots)
+				continue;
+			else if (worker->handle == NULL)
+			{
+				if (unlaunched < 0)
+					unlaunched = i;
+			}
+			else if (idle < 0)
+				idle = i;
+		}
+
+		if (!conflict)
+		{
+			if (idle >= 0)
+				return idle;
+			if (unlaunched >= 0 && pa_launch(unlaunched))
+				return unlaunched;
+			/* Out of background worker slots */
+			if (nlaunched == 0)
+				return -1;
+		}
+
+		pa_wait();
+	}
+}
+
+static void
+pa_send_bytes(ParallelApplyWorker *worker, const char *data, Size len)
+{
+	shm_mq_result res;
+
+	res = shm_mq_send(worker->mqh, len, data, false);
+	if (res != SHM_MQ_SUCCESS)
+		ereport(ERROR,
+				(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+				 errmsg("lost connection to the logical replication parallel apply worker for subscription \"%s\"",
+						MySubscription->name)));
+}
+
+static void
+pa_send(int slotno)
+{
+	ParallelApplyWorker *worker = &pa_workers[slotno];
+	ParallelApplySlot *slot = &pa_shared->slots[slotno];
+	int			pos;
+
+	worker->seq = ++pa_last_seq;
+	worker->pending = true;
+
+	SpinLockAcquire(&pa_shared->mutex);
+	slot->seq = worker->seq;
+	slot->busy = true;
+	SetInvalidVirtualTransactionId(slot->vxid);
+	slot->remote_end = InvalidXLogRecPtr;
+	slot->local_end = InvalidXLogRecPtr;
+	SpinLockRelease(&pa_shared->mutex);
+
+	if (worker->maxrelids < pa_gather_nrelids)
+	{
+		worker->maxrelids = pa_gather_maxrelids;
+		if (worker->relids)
+			pfree(worker->relids);
+		worker->relids = (Oid *)
+			MemoryContextAlloc(ApplyContext, worker->maxrelids * sizeof(Oid));
+	}
+	memcpy(worker->relids, pa_gather_relids, pa_gather_nrelids * sizeof(Oid));
+	worker->nrelids = pa_gather_nrelids;
+
+	/* The schema messages it hasn't seen, those of this one come with it */
+	for (; worker->schema_sent < pa_gather_schema_start; worker->schema_sent++)
+	{
+		StringInfo	msg = list_nth(pa_schema_log, worker->schema_sent);
+
+		pa_send_bytes(worker, msg->data, msg->len);
+	}
+
+	for (pos = 0; pos < pa_gather_buf.len;)
+	{
+		uint32		len;
+
+		memcpy(&len, pa_gather_buf.data + pos, sizeof(uint32));
+		pos += sizeof(uint32);
+		pa_send_bytes(worker, pa_gather_buf.data + pos, len);
+		pos += len;
+	}
+	worker->schema_sent = list_length(pa_schema_log);
+}
+
+static void
+pa_apply_message(char *data, int len)
+{
+	StringInfoData s;
+
+	s.data = data;
+	s.len = len;
+	s.maxlen = -1;
+	s.cursor = 0;
+
+	apply_dispatch(&s);
+	MemoryContextReset(ApplyMessageContext);
+}
+
+/*
+ * Apply the schema messages the leader hasn't up to the given one.
+ */
+static void
+pa_catch_up_schema(int upto)
+{
+	pa_replaying = true;
+	for (; pa_schema_applied < upto; pa_schema_applied++)
+	{
+		StringInfo	msg = list_nth(pa_schema_log, pa_schema_applied);
+
+		pa_apply_message(msg->data, msg->len);
+	}
+	pa_replaying = false;
+}
+
+/*
+ * Apply the transaction gathered in the leader, as far as it came.
+ */
+static void
+pa_replay(void)
+{
+	int			pos;
+
+	pa_catch_up_schema(pa_gather_schema_start);
+
+	pa_replaying = true;
+	for (pos = 0; pos < pa_gather_buf.len;)
+	{
+		uint32		len;
+
+		memcpy(&len, pa_gather_buf.data + pos, sizeof(uint32));
+		pos += sizeof(uint32);
+		pa_apply_message(pa_gather_buf.data + pos, len);
+		pos += len;
+	}
+	pa_replaying = false;
+
+	pa_schema_applied = list_length(pa_schema_log);
+	resetStringInfo(&pa_gather_buf);
+}
+
+static void
+pa_begin_gather(void)
+{
+	if (pa_gather_buf.data == NULL)
+	{
+		MemoryContext oldctx = MemoryContextSwitchTo(ApplyContext);
+
+		initStringInfo(&pa_gather_buf);
+		pa_gather_maxrelids = 8;
+		pa_gather_relids = (Oid *) palloc(pa_gather_maxrelids * sizeof(Oid));
+		MemoryContextSwitchTo(oldctx);
+	}
+
+	resetStringInfo(&pa_gather_buf);
+	pa_gather_nrelids = 0;
+	pa_gather_serial = false;
+	pa_gather_schema_start = list_length(pa_schema_log);
+	pa_gathering = true;
+
+	in_remote_transaction = true;
+	pgstat_report_activity(STATE_RUNNING, NULL);
+}
+
+static void
+pa_gather_relid(Oid relid)
+{
+	int			i;
+
+	for (i = 0; i < pa_gather_nrelids; i++)
+	{
+		if (pa_gather_relids[i] == relid)
+			return;
+	}
+
+	if (pa_gather_nrelids == pa_gather_maxrelids)
+	{
+		pa_gather_maxrelids *= 2;
+		pa_gather_relids = (Oid *) repalloc(pa_gather_relids,
+											pa_gather_maxrelids * sizeof(Oid));
+	}
+	pa_gather_relids[pa_gather_nrelids++] = relid;
+}
+
+static void
+pa_finish_gather(void)
+{
+	int			slotno;
+
+	pa_gathering = false;
+
+	if (!pa_gather_serial && pa_gather_nrelids == 0 && ParallelApplyInProgress())
+	{
+		/* Nothing to apply, and nothing to commit before those in workers */
+		resetStringInfo(&pa_gather_buf);
+		in_remote_transaction = false;
+		pgstat_report_activity(STATE_IDLE, NULL);
+		return;
+	}
+
+	slotno = -1;
+	if (!pa_gather_serial && pa_gather_nrelids > 0)
+		slotno = pa_wait_for_worker();
+
+	if (slotno < 0)
+	{
+		ParallelApplyWaitAll();
+		pa_replay();
+		return;
+	}
+
+	pa_send(slotno);
+	resetStringInfo(&pa_gather_buf);
+
+	in_remote_transaction = false;
+	pgstat_report_activity(STATE_IDLE, NULL);
+}
+
+/*
+ * Called by the leader for each message before it's applied.  Returns true
+ * if the message was taken to be applied later, with its transaction.
+ */
+bool
+ParallelApplyGatherMessage(char action, StringInfo s)
+{
+	/* The message, from the action byte read */
+	char	   *data = s->data + s->cursor - 1;
+	int			len = s->len - s->cursor + 1;
+
+	if (am_parallel_apply_worker() || am_tablesync_worker() || pa_replaying)
+		return false;
+
+	/* Whoever ends up applying the transaction, the workers learn them all */
+	if (action == 'R' || action == 'Y')
+	{
+		MemoryContext oldctx = MemoryContextSwitchTo(ApplyContext);
+		StringInfo	msg = makeStringInfo();
+
+		appendBinaryStringInfo(msg, data, len);
+		pa_schema_log = lappend(pa_schema_log, msg);
+		MemoryContextSwitchTo(oldctx);
+
+		if (!pa_gathering)
+		{
+			pa_schema_applied = list_length(pa_schema_log);
+			return false;
+		}
+	}
+
+	if (!pa_gathering)
+	{
+		if (action != 'B')
+			return false;
+
+		/* A table in sync needs every change before its position applied */
+		if (max_parallel_apply_workers_per_subscription <= 0 ||
+			!AllTablesyncsReady())
+		{
+			ParallelApplyWaitAll();
+			pa_catch_up_schema(list_length(pa_schema_log));
+			return false;
+		}
+		pa_begin_gather();
+	}
+
+	appendBinaryStringInfo(&pa_gather_buf, (char *) &len, sizeof(uint32));
+	appendBinaryStringInfo(&pa_gather_buf, data, len);
+
+	switch (action)
+	{
+		case 'I':
+		case 'U':
+		case 'D':
+			{
+				StringInfoData peek = *s;
+
+				pa_gather_relid(pq_getmsgint(&peek, 4));
+				break;
+			}
+		case 'T':
+			/* May cascade to other relations */
+			pa_gather_serial = true;
+			break;
+	}
+
+	if (action == 'C')
+		pa_finish_gather();
+	else if (pa_gather_buf.len > logical_decoding_work_mem * 1024L)
+	{
+		/* Too large to keep, the rest is applied here as it comes */
+		pa_gathering = false;
+		ParallelApplyWaitAll();
+		pa_replay();
+	}
+
+	return true;
+}
+
+/*
+ * Called by a parallel apply worker as it starts a local transaction.
+ */
+void
+ParallelApplyStartTransaction(void)
+{
+	VirtualTransactionId vxid;
+
+	GET_VXID_FROM_PGPROC(vxid, *MyProc);
+
+	SpinLockAcquire(&pa_shared->mutex);
+	MyParallelApplySlot->vxid = vxid;
+	SpinLockRelease(&pa_shared->mutex);
+
+	/* A successor may wait for it */
+	ConditionVariableBroadcast(&pa_shared->commit_cv);
+}
+
+/*
+ * Wait for the transactions before ours to commit.
+ */
+void
+ParallelApplyWaitTurn(void)
+{
+	ConditionVariablePrepareToSleep(&pa_shared->commit_cv);
+	for (;;)
+	{
+		uint64		next;
+		uint64		seq;
+		VirtualTransactionId vxid;
+		int			i;
+
+		SetInvalidVirtualTransactionId(vxid);
+
+		SpinLockAcquire(&pa_shared->mutex);
+		next = pa_shared->next_commit;
+		seq = MyParallelApplySlot->seq;
+		for (i = 0; i < pa_shared->nslots; i++)
+		{
+			if (pa_shared->slots[i].busy && pa_shared->slots[i].seq == next)
+				vxid = pa_shared->slots[i].vxid;
+		}
+		SpinLockRelease(&pa_shared->mutex);
+
+		if (next == seq)
+			break;
+
+		/*
+		 * Wait on the lock of the transaction to commit next, where the
+		 * deadlock detector sees us.  It advances next_commit after its
+		 * commit.
+		 */
+		if (VirtualTransactionIdIsValid(vxid))
+			VirtualXactLock(vxid, true);
+
+		ConditionVariableSleep(&pa_shared->commit_cv,
+							   WAIT_EVENT_LOGICAL_PARALLEL_APPLY_COMMIT);
+	}
+	ConditionVariableCancelSleep();
+}
+
+/*
+ * Called by a parallel apply worker once it committed the transaction, or
+ * found nothing to commit, in which case local_lsn is invalid.
+ */
+void
+ParallelApplyCommitted(XLogRecPtr remote_lsn, XLogRecPtr local_lsn)
+{
+	SpinLockAcquire(&pa_shared->mutex);
+	MyParallelApplySlot->remote_end = remote_lsn;
+	MyParallelApplySlot->local_end = local_lsn;
+	SetInvalidVirtualTransactionId(MyParallelApplySlot->vxid);
+	MyParallelApplySlot->busy = false;
+	pa_shared->next_commit++;
+	SpinLockRelease(&pa_shared->mutex);
+
+	ConditionVariableBroadcast(&pa_shared->commit_cv);
+	SetLatch(&ProcGlobal->allProcs[pa_shared->leader_pgprocno].procLatch);
+}
+
+/* Logical replication parallel apply worker entry point */
+void
+ParallelApplyWorkerMain(Datum main_arg)
+{
+	dsm_segment *seg;
+	shm_mq	   *mq;
+	shm_mq_handle *mqh;
+	int			slotno;
+	MemoryContext oldctx;
+
+	memcpy(&slotno, MyBgworkerEntry->bgw_extra, sizeof(int));
+
+	/* Setup signal handling */
+	pqsignal(SIGHUP, SignalHandlerForConfigReload);
+	pqsignal(SIGTERM, die);
+	BackgroundWorkerUnblockSignals();
+
+	seg = dsm_attach(DatumGetUInt32(main_arg));
+	if (seg == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+				 errmsg("could not map dynamic shared memory segment")));
+	dsm_pin_mapping(seg);
+	pa_shared = dsm_segment_address(seg);
+	MyParallelApplySlot = &pa_shared->slots[slotno];
+
+	mq = pa_queue(pa_shared, slotno);
+	shm_mq_set_receiver(mq, MyProc);
+	mqh = shm_mq_attach(mq, seg, NULL);
+
+	InParallelApplyWorker = true;
+
+	/* Not a slot of the launcher, the leader's is of no other use here */
+	memset(&pa_worker_info, 0, sizeof(pa_worker_info));
+	pa_worker_info.in_use = true;
+	pa_worker_info.proc = MyProc;
+	pa_worker_info.dbid = pa_shared->dbid;
+	pa_worker_info.userid = pa_shared->userid;
+	pa_worker_info.subid = pa_shared->subid;
+	MyLogicalRepWorker = &pa_worker_info;
+
+	/* Run as replica session replication role. */
+	SetConfigOption("session_replication_role", "replica",
+					PGC_SUSET, PGC_S_OVERRIDE);
+
+	/* Connect to our database. */
+	BackgroundWorkerInitializeConnectionByOid(pa_shared->dbid,
+											  pa_shared->userid,
+											  0);
+
+	/*
+	 * Set always-secure search path, so malicious users can't redirect user
+	 * code (e.g. pg_index.indexprs).
+	 */
+	SetConfigOption("search_path", "", PGC_SUSET, PGC_S_OVERRIDE);
+
+	ApplyContext = AllocSetContextCreate(TopMemoryContext,
+										 "ApplyContext",
+										 ALLOCSET_DEFAULT_SIZES);
+	StartTransactionCommand();
+	oldctx = MemoryContextSwitchTo(ApplyContext);
+
+	MySubscription = GetSubscription(pa_shared->subid, true);
+	if (!MySubscription)
+		proc_exit(0);
+
+	/* Changes to the subscription restart the leader, and us with it */
+	MySubscriptionValid = true;
+	MemoryContextSwitchTo(oldctx);
+
+	/* Setup synchronous commit according to the user's wishes */
+	SetConfigOption("synchronous_commit", MySubscription->synccommit,
+					PGC_BACKEND, PGC_S_OVERRIDE);
+
+	/* Advance the origin the leader acquired */
+	replorigin_session_setup(pa_shared->originid, pa_shared->leader_pid);
+	replorigin_session_origin = pa_shared->originid;
+
+	CommitTransactionCommand();
+
+	ApplyMessageContext = AllocSetContextCreate(ApplyContext,
+												"ApplyMessageContext",
+												ALLOCSET_DEFAULT_SIZES);
+
+	pgstat_report_activity(STATE_IDLE, NULL);
+
+	for (;;)
+	{
+		shm_mq_result res;
+		Size		len;
+		void	   *data;
+		StringInfoData s;
+
+		CHECK_FOR_INTERRUPTS();
+
+		MemoryContextSwitchTo(ApplyMessageContext);
+
+		res = shm_mq_receive(mqh, &len, &data, false);
+
+		/* The leader is gone */
+		if (res != SHM_MQ_SUCCESS)
+			break;
+
+		if (ConfigReloadPending)
+		{
+			ConfigReloadPending = false;
+			ProcessConfigFile(PGC_SIGHUP);
+		}
+
+		s.data = data;
+		s.len = len;
+		s.maxlen = -1;
+		s.cursor = 0;
+
+		apply_dispatch(&s);
+
+		MemoryContextReset(ApplyMessageContext);
+	}
+
+	proc_exit(0);
+}
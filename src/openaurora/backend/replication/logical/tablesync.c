@@ -105,6 +105,9 @@
 
 static bool table_states_valid = false;
 
+/* The last fetch of the table states found no table not READY */
+static bool table_states_all_ready = false;
+
 StringInfo	copybuf = NULL;
 
 /*
@@ -360,6 +363,7 @@ process_syncing_tables_for_apply(XLogRecPtr current_lsn)
 		MemoryContextSwitchTo(oldctx);
 
 		table_states_valid = true;
+		table_states_all_ready = (table_states == NIL);
 	}
 
 	/*
@@ -534,6 +538,19 @@ process_syncing_tables(XLogRecPtr current_lsn)
 		process_syncing_tables_for_apply(current_lsn);
 }
 
+/*
+ * Are all tables of the subscription READY?
+ *
+ * As of the last time the apply worker fetched the table states, so false
+ * from the time they are invalidated until process_syncing_tables() fetches
+ * them again.
+ */
+bool
+AllTablesyncsReady(void)
+{
+	return table_states_valid && table_states_all_ready;
+}
+
 /*
  * Create list of columns for COPY based on logical relation mapping.
  */
@@ -99,7 +99,7 @@ typedef struct SlotErrCallbackArg
 	int			remote_attnum;
 } SlotErrCallbackArg;
 
-static MemoryContext ApplyMessageContext = NULL;
+MemoryContext ApplyMessageContext = NULL;
 MemoryContext ApplyContext = NULL;
 
 WalReceiverConn *wrconn = NULL;
@@ -112,7 +112,6 @@ static XLogRecPtr remote_final_lsn = InvalidXLogRecPtr;
 
 static void send_feedback(XLogRecPtr recvpos, bool force, bool requestReply);
 
-static void store_flush_position(XLogRecPtr remote_lsn);
 
 static void maybe_reread_subscription(void);
 
@@ -181,6 +180,9 @@ ensure_transaction(void)
 	SetCurrentStatementStartTimestamp();
 	StartTransactionCommand();
 
+	if (am_parallel_apply_worker())
+		ParallelApplyStartTransaction();
+
 	maybe_reread_subscription();
 
 	MemoryContextSwitchTo(ApplyMessageContext);
@@ -503,6 +505,10 @@ apply_handle_commit(StringInfo s)
 
 	Assert(commit_data.commit_lsn == remote_final_lsn);
 
+	/* A parallel apply worker takes its turn even if it has nothing to do */
+	if (am_parallel_apply_worker())
+		ensure_transaction();
+
 	/* The synchronization worker runs in single transaction. */
 	if (IsTransactionState() && !am_tablesync_worker())
 	{
@@ -513,10 +519,17 @@ apply_handle_commit(StringInfo s)
 		replorigin_session_origin_lsn = commit_data.end_lsn;
 		replorigin_session_origin_timestamp = commit_data.committime;
 
+		/* Commit in the order of the publisher */
+		if (am_parallel_apply_worker())
+			ParallelApplyWaitTurn();
+
 		CommitTransactionCommand();
 		pgstat_report_stat(false);
 
-		store_flush_position(commit_data.end_lsn);
+		if (am_parallel_apply_worker())
+			ParallelApplyCommitted(commit_data.end_lsn, XactLastCommitEnd);
+		else
+			store_flush_position(commit_data.end_lsn, XactLastCommitEnd);
 	}
 	else
 	{
@@ -528,7 +541,8 @@ apply_handle_commit(StringInfo s)
 	in_remote_transaction = false;
 
 	/* Process any tables that are being synchronized in parallel. */
-	process_syncing_tables(commit_data.end_lsn);
+	if (!am_parallel_apply_worker())
+		process_syncing_tables(commit_data.end_lsn);
 
 	pgstat_report_activity(STATE_IDLE, NULL);
 }
@@ -1345,11 +1359,18 @@ apply_handle_truncate(StringInfo s)
 /*
  * Logical replication protocol message dispatcher.
  */
-static void
+void
 apply_dispatch(StringInfo s)
 {
 	char		action = pq_getmsgbyte(s);
 
+	/*
+	 * The leader gathers a transaction to hand it to a parallel apply worker
+	 * whole, see applyparallel.c.
+	 */
+	if (ParallelApplyGatherMessage(action, s))
+		return;
+
 	switch (action)
 	{
 			/* BEGIN */
@@ -1450,23 +1471,24 @@ get_flush_position(XLogRecPtr *write, XLogRecPtr *flush,
 }
 
 /*
- * Store current remote/local lsn pair in the tracking list.
+ * Store remote/local lsn pair of a commit in the tracking list.
  */
-static void
-store_flush_position(XLogRecPtr remote_lsn)
+void
+store_flush_position(XLogRecPtr remote_lsn, XLogRecPtr local_lsn)
 {
 	FlushPosition *flushpos;
+	MemoryContext oldctx;
 
 	/* Need to do this in permanent context */
-	MemoryContextSwitchTo(ApplyContext);
+	oldctx = MemoryContextSwitchTo(ApplyContext);
 
 	/* Track commit lsn  */
 	flushpos = (FlushPosition *) palloc(sizeof(FlushPosition));
-	flushpos->local_end = XactLastCommitEnd;
+	flushpos->local_end = local_lsn;
 	flushpos->remote_end = remote_lsn;
 
 	dlist_push_tail(&lsn_mapping, &flushpos->node);
-	MemoryContextSwitchTo(ApplyMessageContext);
+	MemoryContextSwitchTo(oldctx);
 }
 
 
@@ -1613,6 +1635,14 @@ LogicalRepApplyLoop(XLogRecPtr last_received)
 			 * now.
 			 */
 			AcceptInvalidationMessages();
+
+			/*
+			 * A table being synchronized needs all changes up to where it
+			 * is asked to catch up applied.
+			 */
+			if (!AllTablesyncsReady())
+				ParallelApplyWaitAll();
+
 			maybe_reread_subscription();
 
 			/* Process any table synchronization changes. */
@@ -1639,7 +1669,7 @@ LogicalRepApplyLoop(XLogRecPtr last_received)
 		 * no particular urgency about waking up unless we get data or a
 		 * signal.
 		 */
-		if (!dlist_is_empty(&lsn_mapping))
+		if (!dlist_is_empty(&lsn_mapping) || ParallelApplyInProgress())
 			wait_time = WalWriterDelay;
 		else
 			wait_time = NAPTIME_PER_CYCLE;
@@ -1741,13 +1771,14 @@ send_feedback(XLogRecPtr recvpos, bool force, bool requestReply)
 	if (recvpos < last_recvpos)
 		recvpos = last_recvpos;
 
+	ParallelApplyCollect();
 	get_flush_position(&writepos, &flushpos, &have_pending_txes);
 
 	/*
 	 * No outstanding transactions to flush, we can report the latest received
 	 * position. This is important for synchronous replication.
 	 */
-	if (!have_pending_txes)
+	if (!have_pending_txes && !ParallelApplyInProgress())
 		flushpos = writepos = recvpos;
 
 	if (writepos < last_writepos)
@@ -2084,7 +2115,7 @@ ApplyWorkerMain(Datum main_arg)
 		originid = replorigin_by_name(originname, true);
 		if (!OidIsValid(originid))
 			originid = replorigin_create(originname);
-		replorigin_session_setup(originid);
+		replorigin_session_setup(originid, 0);
 		replorigin_session_origin = originid;
 		origin_startpos = replorigin_session_get_progress(false);
 		CommitTransactionCommand();
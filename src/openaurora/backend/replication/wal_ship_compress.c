@@ -0,0 +1,103 @@
+#include "postgres.h"
+
+#include <string.h>
+#include <lz4.h>
+#include <zstd.h>
+#include "replication/wal_ship_compress.h"
+
+// GUCs
+int wal_ship_compression = WAL_SHIP_COMPRESSION_OFF;
+int wal_sender_compression = WAL_SHIP_COMPRESSION_OFF;
+
+#define WAL_SHIP_FRAME_MAGIC (0x57534346)   // "WSCF"
+// WAL is compressed on the commit path, favour speed
+#define WAL_SHIP_ZSTD_LEVEL (1)
+
+// Storage nodes decompress on many RPC threads at once
+static __thread ZSTD_CCtx *zstdCompressCtx = NULL;
+static __thread ZSTD_DCtx *zstdDecompressCtx = NULL;
+
+size_t WalShipCompressBound(size_t len) {
+    size_t lz4Bound = (size_t) LZ4_compressBound((int) len);
+    size_t zstdBound = ZSTD_compressBound(len);
+
+    return WAL_SHIP_FRAME_HEADER_SIZE + Max(lz4Bound, zstdBound);
+}
+
+size_t WalShipCompress(int method, const char *src, size_t len, char *dst) {
+    uint32 magic = WAL_SHIP_FRAME_MAGIC;
+    uint32 rawlen = (uint32) len;
+    char *out = dst + WAL_SHIP_FRAME_HEADER_SIZE;
+    size_t outlen = 0;
+
+    if (len == 0 || len > PG_INT32_MAX)
+        return 0;
+    switch (method) {
+        case WAL_SHIP_COMPRESSION_LZ4: {
+            int n = LZ4_compress_default(src, out, (int) len, LZ4_compressBound((int) len));
+
+            if (n > 0)
+                outlen = (size_t) n;
+            break;
+        }
+        case WAL_SHIP_COMPRESSION_ZSTD: {
+            size_t n;
+
+            if (zstdCompressCtx == NULL)
+                zstdCompressCtx = ZSTD_createCCtx();
+            if (zstdCompressCtx == NULL)
+                return 0;
+            n = ZSTD_compressCCtx(zstdCompressCtx, out, ZSTD_compressBound(len), src, len,
+                                  WAL_SHIP_ZSTD_LEVEL);
+            if (!ZSTD_isError(n))
+                outlen = n;
+            break;
+        }
+        default:
+            return 0;
+    }
+    if (outlen == 0 || WAL_SHIP_FRAME_HEADER_SIZE + outlen >= len)
+        return 0;
+
+    memcpy(dst, &magic, sizeof(magic));
+    memcpy(dst + 4, &rawlen, sizeof(rawlen));
+    dst[8] = (char) method;
+    dst[9] = dst[10] = dst[11] = 0;
+    return WAL_SHIP_FRAME_HEADER_SIZE + outlen;
+}
+
+size_t WalShipFrameRawLength(const char *frame, size_t framelen) {
+    uint32 magic, rawlen;
+
+    if (framelen <= WAL_SHIP_FRAME_HEADER_SIZE)
+        return 0;
+    memcpy(&magic, frame, sizeof(magic));
+    memcpy(&rawlen, frame + 4, sizeof(rawlen));
+    if (magic != WAL_SHIP_FRAME_MAGIC)
+        return 0;
+    return rawlen;
+}
+
+bool WalShipDecompress(const char *frame, size_t framelen, char *dst, size_t rawlen) {
+    const char *in = frame + WAL_SHIP_FRAME_HEADER_SIZE;
+    size_t inlen = framelen - WAL_SHIP_FRAME_HEADER_SIZE;
+
+    if (rawlen == 0 || WalShipFrameRawLength(frame, framelen) != rawlen)
+        return false;
+    switch (frame[8]) {
+        case WAL_SHIP_COMPRESSION_LZ4:
+            return LZ4_decompress_safe(in, dst, (int) inlen, (int) rawlen) == (int) rawlen;
+        case WAL_SHIP_COMPRESSION_ZSTD: {
+            size_t n;
+
+            if (zstdDecompressCtx == NULL)
+                zstdDecompressCtx = ZSTD_createDCtx();
+            if (zstdDecompressCtx == NULL)
+                return false;
+            n = ZSTD_decompressDCtx(zstdDecompressCtx, dst, rawlen, in, inlen);
+            return !ZSTD_isError(n) && n == rawlen;
+        }
+        default:
+            return false;
+    }
+}
@@ -76,6 +76,7 @@
 #include "replication/walreceiver.h"
 #include "replication/walsender.h"
 #include "replication/walsender_private.h"
+#include "replication/wal_ship_compress.h"
 #include "storage/condition_variable.h"
 #include "storage/fd.h"
 #include "storage/ipc.h"
@@ -2829,6 +2830,31 @@ retry:
 	output_message.len += nbytes;
 	output_message.data[output_message.len] = '\0';
 
+	/*
+	 * If the walreceiver asked for it, compress the slice and send it as a
+	 * 'z' message instead.  The frame is shorter than the slice, so it is
+	 * copied back over it.
+	 */
+	if (wal_sender_compression != WAL_SHIP_COMPRESSION_OFF)
+	{
+		static char *frame = NULL;
+		int			hdrlen = 1 + sizeof(int64) * 3;
+		size_t		framelen;
+
+		if (frame == NULL)
+			frame = MemoryContextAlloc(TopMemoryContext,
+									   WalShipCompressBound(MAX_SEND_SIZE));
+		framelen = WalShipCompress(wal_sender_compression,
+								   &output_message.data[hdrlen], nbytes, frame);
+		if (framelen > 0)
+		{
+			output_message.data[0] = 'z';
+			memcpy(&output_message.data[hdrlen], frame, framelen);
+			output_message.len = hdrlen + framelen;
+			output_message.data[output_message.len] = '\0';
+		}
+	}
+
 	/*
 	 * Fill the send timestamp last, so that it is taken as late as possible.
 	 */
@@ -54,10 +54,19 @@ LRUCache::LRUCache() : capacity_(0), usage_(0) {
   lru_.prev = &lru_;
   in_use_.next = &in_use_;
   in_use_.prev = &in_use_;
+  clock_.next = &clock_;
+  clock_.prev = &clock_;
 }
 
 LRUCache::~LRUCache() {
   assert(in_use_.next == &in_use_);  // Error if caller has an unreleased handle
+  while (hand_hot_ != nullptr) {
+    LRUHandle* e = hand_hot_;
+    assert(e->refs == 1);
+    Clock_Unlink(e);
+    e->in_cache = false;
+    Unref(e, nullptr);
+  }
   for (LRUHandle* e = lru_.next; e != &lru_;) {
     LRUHandle* next = e->next;
     assert(e->in_cache);
@@ -70,6 +79,10 @@ LRUCache::~LRUCache() {
 //Can we use the lock within the handle to reduce the conflict here so that the critical seciton
 // of the cache shard lock will be minimized.
     void LRUCache::Ref(LRUHandle* e) {
+        if (policy_ == kClockProCache) {
+            e->refs++;
+            return;
+        }
         if (e->refs == 1 && e->in_cache) {  // If on lru_ list, move to in_use_ list.
             LRU_Remove(e);
             LRU_Append(&in_use_, e);
@@ -79,6 +92,17 @@ LRUCache::~LRUCache() {
 
 void LRUCache::Unref(LRUHandle *e, SpinLock *spin_l) {
   assert(e->refs > 0);
+  if (policy_ == kClockProCache) {
+    // Not in any list but the clock, which FinishErase took it out of.
+    // Release calls this without the lock.
+    if (e->refs.fetch_sub(1) == 1) {
+      assert(!e->in_cache);
+      if(e->deleter != nullptr)
+        (*e->deleter)(e);
+      delete e;
+    }
+    return;
+  }
   e->refs--;
   if (e->refs == 0) {  // Deallocate.
       //Finish erase will only goes here, or directly return. it will never goes to next if clause
@@ -124,8 +148,11 @@ Cache::Handle* LRUCache::Lookup(const KeyType& key, uint32_t hash) {
     // Unref or release which will update the lRU list.
     LRUHandle* e = table_.Lookup(key, hash);
     if (e != nullptr) {
+        if (policy_ == kClockProCache && e->clock_state == kClockTest)
+            return nullptr;
         assert(e->refs >= 1);
         Ref(e);
+        e->referenced.store(true, std::memory_order_relaxed);
     }
     return reinterpret_cast<Cache::Handle*>(e);
 }
@@ -136,9 +163,25 @@ Cache::Handle *DSMEngine::LRUCache::LookupInsert(const KeyType &key, uint32_t ha
     //  Answer: Ref will refer this key and later, the outer function has to call
     // Unref or release which will update the lRU list.
     LRUHandle* e = table_.Lookup(key, hash);
+    if (policy_ == kClockProCache && e != nullptr && e->clock_state == kClockTest) {
+        // Inserted again while tracked, the entry comes back hot and the cold
+        // ones get more room
+        if (cold_capacity_ < capacity_)
+            cold_capacity_++;
+        Clock_Unlink(e);
+        e->clock_state = kClockHot;
+        e->referenced.store(false, std::memory_order_relaxed);
+        e->value = value;
+        e->deleter = deleter;
+        e->charge = charge;
+        e->refs++;  // for the returned handle.
+        Clock_Insert(e);
+        return reinterpret_cast<Cache::Handle*>(e);
+    }
     if (e != nullptr) {
         assert(e->refs >= 1);
         Ref(e);
+        e->referenced.store(true, std::memory_order_relaxed);
         return reinterpret_cast<Cache::Handle*>(e);
     }else{
         // This LRU handle is not initialized.
@@ -156,6 +199,14 @@ Cache::Handle *DSMEngine::LRUCache::LookupInsert(const KeyType &key, uint32_t ha
         e->hash = hash;
         e->in_cache = false;
         e->refs = 1;  // for the returned handle.
+        if (policy_ == kClockProCache && capacity_ > 0) {
+            e->refs++;
+            e->in_cache = true;
+            e->clock_state = kClockCold;
+            table_.Insert(e);
+            Clock_Insert(e);
+            return reinterpret_cast<Cache::Handle*>(e);
+        }
         if (capacity_ > 0) {
             e->refs++;  // for the table_cache's reference. refer here and unrefer outside
             e->in_cache = true;
@@ -213,6 +264,10 @@ Cache::Handle *DSMEngine::LRUCache::LookupInsert(const KeyType &key, uint32_t ha
 Cache::Handle* LRUCache::LookupErase(const KeyType& key, uint32_t hash) {
     SpinLock l(&mutex_);
     LRUHandle* e = table_.Remove(key, hash);
+    if (policy_ == kClockProCache && e != nullptr && e->clock_state == kClockTest) {
+        FinishErase(e, &l);
+        return nullptr;
+    }
     if (e != nullptr) {
         assert(e->refs >= 1);
         Ref(e);
@@ -222,6 +277,10 @@ Cache::Handle* LRUCache::LookupErase(const KeyType& key, uint32_t hash) {
     return reinterpret_cast<Cache::Handle*>(e);
 }
 void LRUCache::Release(Cache::Handle* handle) {
+  if (policy_ == kClockProCache) {
+    Unref(reinterpret_cast<LRUHandle *>(handle), nullptr);
+    return;
+  }
   SpinLock l(&mutex_);
     Unref(reinterpret_cast<LRUHandle *>(handle), &l);
 }
@@ -251,6 +310,14 @@ Cache::Handle* LRUCache::Insert(const KeyType& key, uint32_t hash, void* value,
 //  std::memcpy(e->key_data, key.data(), key.size());
 //  WriteLock l(&mutex_);
   SpinLock l(&mutex_);
+  if (policy_ == kClockProCache && capacity_ > 0) {
+    e->refs++;
+    e->in_cache = true;
+    e->clock_state = kClockCold;
+    FinishErase(table_.Insert(e), &l);
+    Clock_Insert(e);
+    return reinterpret_cast<Cache::Handle*>(e);
+  }
   if (capacity_ > 0) {
     e->refs++;  // for the table_cache's reference. refer here and unrefer outside
     e->in_cache = true;
@@ -316,7 +383,12 @@ bool LRUCache::FinishErase(LRUHandle *e, SpinLock *spin_l) {
 //#endif
     assert(e->in_cache);
     e->in_cache = false;
-    usage_ -= e->charge;
+    if (policy_ == kClockProCache) {
+      if (e->clock_state != kClockTest)
+        usage_ -= e->charge;
+      Clock_Unlink(e);
+    } else
+      usage_ -= e->charge;
   // decrease the reference of cache, making it not pinned by cache, but it
   // can still be pinned outside the cache.
 //      assert(e->refs == 1);
@@ -333,13 +405,136 @@ void LRUCache::Erase(const KeyType& key, uint32_t hash) {
   LRUHandle* e = table_.Remove(key, hash);
   auto page_meta = (mempool::PageMeta*)(e->value);
   FinishErase(e, &l);
-  freelist_->push_back(page_meta);
+  // A test entry has no value
+  if (page_meta != nullptr)
+    freelist_->push_back(page_meta);
+}
+
+// The clock of kClockProCache, a list with a dummy head the hands skip.
+LRUHandle* LRUCache::Clock_Next(LRUHandle* e) {
+  return e->next == &clock_ ? clock_.next : e->next;
+}
+
+// New entries go behind the hot hand, the entry the hands reach last.
+void LRUCache::Clock_Link(LRUHandle* e) {
+  clock_size_++;
+  if (e->clock_state == kClockHot)
+    count_hot_ += e->charge;
+  else
+    count_cold_ += e->charge;
+  if (hand_hot_ == nullptr) {
+    LRU_Append(&clock_, e);
+    hand_hot_ = hand_cold_ = hand_test_ = e;
+    return;
+  }
+  LRU_Append(hand_hot_, e);
+  if (hand_cold_ == hand_hot_)
+    hand_cold_ = e;
+}
+
+void LRUCache::Clock_Unlink(LRUHandle* e) {
+  clock_size_--;
+  if (e->clock_state == kClockHot)
+    count_hot_ -= e->charge;
+  else if (e->clock_state == kClockCold)
+    count_cold_ -= e->charge;
+  else
+    count_test_--;
+  LRUHandle* next = Clock_Next(e) == e ? nullptr : Clock_Next(e);
+  if (hand_hot_ == e)
+    hand_hot_ = next;
+  if (hand_cold_ == e)
+    hand_cold_ = next;
+  if (hand_test_ == e)
+    hand_test_ = next;
+  LRU_Remove(e);
+}
+
+// e is in the table with its references set. Makes room for it and links it,
+// the value of an evicted entry is handed over to it if it has none.
+void LRUCache::Clock_Insert(LRUHandle* e) {
+  // Pinned cold entries are passed over, stop once all have been seen a few
+  // times. The shard is then over its capacity until they are released.
+  size_t steps = 3 * clock_size_;
+  while (usage_ + e->charge > capacity_ && hand_cold_ != nullptr && steps-- > 0)
+    Clock_RunHandCold(e);
+  Clock_Link(e);
+  usage_ += e->charge;
+  if (e->value == nullptr)
+    e->value = freelist_->pop_front();
+}
+
+// Drops a test entry, its key wasn't inserted again while tracked
+void LRUCache::Clock_EndTest(LRUHandle* e) {
+  if (cold_capacity_ > 1)
+    cold_capacity_--;
+  FinishErase(table_.Remove(e->key(), e->hash), nullptr);
+}
+
+void LRUCache::Clock_RunHandCold(LRUHandle* e_new) {
+  LRUHandle* e = hand_cold_;
+  hand_cold_ = Clock_Next(e);
+  if (e->clock_state == kClockCold && e->refs == 1) {
+    if (e->referenced.exchange(false, std::memory_order_relaxed)) {
+      e->clock_state = kClockHot;
+      count_cold_ -= e->charge;
+      count_hot_ += e->charge;
+    } else {
+      if (e_new->value == nullptr)
+        e_new->value = e->value;
+      else
+        freelist_->push_back((mempool::PageMeta*)e->value);
+      if (e->deleter != nullptr)
+        (*e->deleter)(e);
+      e->deleter = nullptr;
+      e->value = nullptr;
+      e->clock_state = kClockTest;
+      count_cold_ -= e->charge;
+      usage_ -= e->charge;
+      count_test_++;
+      while (count_test_ > capacity_)
+        Clock_RunHandTest();
+    }
+  }
+  while (hand_hot_ != nullptr && count_hot_ > capacity_ - cold_capacity_)
+    Clock_RunHandHot();
+}
+
+void LRUCache::Clock_RunHandHot() {
+  LRUHandle* e = hand_hot_;
+  hand_hot_ = Clock_Next(e);
+  if (e->clock_state == kClockHot) {
+    if (!e->referenced.exchange(false, std::memory_order_relaxed)) {
+      e->clock_state = kClockCold;
+      count_hot_ -= e->charge;
+      count_cold_ += e->charge;
+    }
+  } else if (e->clock_state == kClockTest) {
+    Clock_EndTest(e);
+  }
+}
+
+void LRUCache::Clock_RunHandTest() {
+  LRUHandle* e = hand_test_;
+  hand_test_ = Clock_Next(e);
+  if (e->clock_state == kClockTest)
+    Clock_EndTest(e);
 }
 
 void LRUCache::Prune() {
 //  MutexLock l(&mutex_);
 //  WriteLock l(&mutex_);
     SpinLock l(&mutex_);
+  for (size_t n = clock_size_; n > 0 && hand_cold_ != nullptr; n--) {
+    LRUHandle* e = hand_cold_;
+    hand_cold_ = Clock_Next(e);
+    if (e->refs == 1) {
+      auto page_meta = (mempool::PageMeta*)(e->value);
+      FinishErase(table_.Remove(e->key(), e->hash), nullptr);
+      if (page_meta != nullptr)
+        freelist_->push_back(page_meta);
+    }
+  }
   while (lru_.next != &lru_) {
     LRUHandle* e = lru_.next;
     assert(e->refs == 1);
@@ -371,10 +566,11 @@ class ShardedLRUCache : public Cache {
   static uint32_t Shard(uint32_t hash) { return hash >> (32 - kNumShardBits); }
 
  public:
-  explicit ShardedLRUCache(size_t capacity, mempool::FreeList* fl) : last_id_(0), freelist_(fl) {
+  explicit ShardedLRUCache(size_t capacity, mempool::FreeList* fl, CachePolicy policy) : last_id_(0), freelist_(fl) {
     capacity_ = capacity;
     for (int s = 0; s < kNumShards; s++) {
       shard_[s].SetCapacity((capacity + s) / kNumShards);
+      shard_[s].SetPolicy(policy);
       shard_[s].freelist_ = fl;
     }
   }
@@ -458,7 +654,11 @@ class ShardedLRUCache : public Cache {
 };
 
 
-Cache* NewLRUCache(size_t capacity, mempool::FreeList* fl) { return new ShardedLRUCache(capacity, fl); }
+Cache* NewLRUCache(size_t capacity, mempool::FreeList* fl, CachePolicy policy) {
+  return new ShardedLRUCache(capacity, fl, policy);
+}
+
+uint32_t CacheShardOf(const KeyType& key) { return Hash(&key, 0) >> (32 - kNumShardBits); }
 
 
 LocalBuffer::LocalBuffer(const CacheConfig &cache_config) {
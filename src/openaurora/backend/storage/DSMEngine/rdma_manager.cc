@@ -1,5 +1,6 @@
 #include <fstream>
 #include <cstdint>
+#include <poll.h>
 #include "storage/DSMEngine/rdma_manager.h"
 // #include "storage/page.h"
 #include "storage/DSMEngine/HugePageAlloc.h"
@@ -331,8 +332,14 @@ void RDMA_Manager::ConnectQPThroughSocket(std::string qp_type, int socket_fd, ui
     // cq1 send queue, cq2 receive queue
     ibv_cq* cq1 = ibv_create_cq(res->ib_ctx, cq_size, NULL, NULL, 0);
     ibv_cq* cq2;
+    ibv_comp_channel* recv_channel = nullptr;
+    if (cq_event_mode) {
+        recv_channel = ibv_create_comp_channel(res->ib_ctx);
+        if (!recv_channel)
+            fprintf(stderr, "failed to create a completion channel, polling instead\n");
+    }
     if (seperated_cq)
-        cq2 = ibv_create_cq(res->ib_ctx, cq_size, NULL, NULL, 0);
+        cq2 = ibv_create_cq(res->ib_ctx, cq_size, NULL, recv_channel, 0);
     if (!cq1)
         fprintf(stderr, "failed to create CQ with %u entries\n", cq_size);
 
@@ -380,6 +387,8 @@ void RDMA_Manager::ConnectQPThroughSocket(std::string qp_type, int socket_fd, ui
     res->qp_map[target_node_id] = qp;
     res->cq_map.insert({target_node_id, std::make_pair(cq1, cq2)});
     res->qp_main_connection_info.insert({target_node_id, remote_con_data});
+    if (recv_channel != nullptr)
+        res->recv_channel_map[target_node_id] = recv_channel;
     l.unlock();
 
     if (connect_qp(qp, qp_type, target_node_id))
@@ -1399,6 +1408,60 @@ int RDMA_Manager::RDMA_Read(ibv_mr *remote_mr, ibv_mr *local_mr, uint64_t remote
     return rc;
 }
 
+int RDMA_Manager::RDMA_Read_Batch(ibv_mr **remote_mrs, ibv_mr **local_mrs, uint64_t *remote_offsets, size_t *msg_sizes,
+                                  int num, int poll_num, uint16_t target_node_id, std::string qp_type) {
+    std::vector<ibv_send_wr> sr(num);
+    std::vector<ibv_sge> sge(num);
+    struct ibv_send_wr* bad_wr = NULL;
+    int rc;
+
+    for (int i = 0; i < num; i++) {
+        memset(&sge[i], 0, sizeof(ibv_sge));
+        sge[i].addr = (uintptr_t)local_mrs[i]->addr;
+        sge[i].length = msg_sizes[i];
+        sge[i].lkey = local_mrs[i]->lkey;
+
+        memset(&sr[i], 0, sizeof(ibv_send_wr));
+        sr[i].next = i + 1 < num ? &sr[i + 1] : NULL;
+        sr[i].wr_id = 0;
+        sr[i].sg_list = &sge[i];
+        sr[i].num_sge = 1;
+        sr[i].opcode = IBV_WR_RDMA_READ;
+        // One doorbell, one completion for the whole list
+        if (i + 1 == num) sr[i].send_flags = IBV_SEND_SIGNALED;
+        sr[i].wr.rdma.remote_addr = reinterpret_cast<uint64_t>(remote_mrs[i]->addr) + remote_offsets[i];
+        sr[i].wr.rdma.rkey = remote_mrs[i]->rkey;
+    }
+
+    ibv_qp* qp;
+    if (qp_type == "default"){
+        qp = static_cast<ibv_qp*>(qp_data_default.at(target_node_id)->Get());
+        if (qp == NULL) {
+            Remote_Query_Pair_Connection(qp_type,target_node_id);
+            qp = static_cast<ibv_qp*>(qp_data_default.at(target_node_id)->Get());
+        }
+        rc = ibv_post_send(qp, &sr[0], &bad_wr);
+    } else {
+        rc = ibv_post_send(res->qp_map.at(target_node_id), &sr[0], &bad_wr);
+    }
+
+    if (rc) {
+        fprintf(stderr, "failed to post SR %s \n", qp_type.c_str());
+        exit(1);
+    }
+
+    if (poll_num != 0) {
+        ibv_wc wc;
+        rc = poll_completion(&wc, 1, qp_type, true, target_node_id);
+        if (rc != 0) {
+            std::cout << "RDMA Read Failed" << std::endl;
+            std::cout << "q id is" << qp_type << std::endl;
+            fprintf(stdout, "QP number=0x%x\n", res->qp_map[target_node_id]->qp_num);
+        }
+    }
+    return rc;
+}
+
 int RDMA_Manager::RDMA_Write(GlobalAddress remote_ptr, ibv_mr *local_mr, size_t msg_size, size_t send_flag,
                                                             int poll_num,
                                                             Chunk_type pool_name, std::string qp_type) {
@@ -2181,6 +2244,39 @@ int RDMA_Manager::try_poll_completions(ibv_wc* wc_p, int num_entries, std::strin
     return poll_result;
 }
 
+int RDMA_Manager::wait_poll_completions(ibv_wc* wc_p, int num_entries, std::string& qp_type,
+                                        uint16_t target_node_id, int timeout_ms) {
+    ibv_comp_channel* channel = nullptr;
+    ibv_cq* cq;
+    std::shared_lock<std::shared_mutex> l(qp_cq_map_mutex);
+    auto iter = res->recv_channel_map.find(target_node_id);
+    if (iter != res->recv_channel_map.end())
+        channel = iter->second;
+    cq = res->cq_map.at(target_node_id).second;
+    l.unlock();
+    if (channel == nullptr)
+        return try_poll_completions(wc_p, num_entries, qp_type, false, target_node_id);
+
+    // Arm first and poll again, a completion arriving in between raises no
+    // event
+    if (ibv_req_notify_cq(cq, 0)) {
+        fprintf(stderr, "failed to request a CQ notification\n");
+        return try_poll_completions(wc_p, num_entries, qp_type, false, target_node_id);
+    }
+    int poll_result = try_poll_completions(wc_p, num_entries, qp_type, false, target_node_id);
+    if (poll_result != 0)
+        return poll_result;
+
+    struct pollfd pfd = {channel->fd, POLLIN, 0};
+    if (poll(&pfd, 1, timeout_ms) > 0) {
+        ibv_cq* ev_cq;
+        void* ev_ctx;
+        if (ibv_get_cq_event(channel, &ev_cq, &ev_ctx) == 0)
+            ibv_ack_cq_events(ev_cq, 1);
+    }
+    return try_poll_completions(wc_p, num_entries, qp_type, false, target_node_id);
+}
+
 int RDMA_Manager::try_poll_completions_xcompute(ibv_wc *wc_p, int num_entries, bool send_cq, uint16_t target_node_id,
                                                                                                 int num_of_cp) {
         assert(target_node_id%2 == 0);
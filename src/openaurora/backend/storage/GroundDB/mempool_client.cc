@@ -1,7 +1,10 @@
+#include <atomic>
 #include <mutex>
+#include <signal.h>
 #include "storage/GroundDB/mempool_client.h"
 #include "storage/GroundDB/rdma.hh"
 #include "storage/DSMEngine/rdma_manager.h"
+#include "storage/DSMEngine/HugePageAlloc.h"
 #include "storage/rpcclient.h"
 #include "utils/DSMEngine/hash.h"
 #include "utils/version_map.h"
@@ -15,16 +18,26 @@ namespace mempool{
 class MemPoolClient{
 public:
     MemPoolClient();
-    static MemPoolClient* Get_Instance();
+    // drain completes the prefetches in flight first, see DrainPrefetchedPages
+    static MemPoolClient* Get_Instance(bool drain = true);
     bool AppendToPAT(size_t memnode_id, size_t pa_idx);
     void Disconnect();
+	// The memory nodes a page is kept on, replica 0 is its primary one
+	int PageReplicaCount();
+	size_t PagePlacement(KeyType PageID, int replica);
 	int AccessPageOnMemoryPool(KeyType PageID);
 	int RemovePageOnMemoryPool(KeyType PageID);
 	void GetNewestPageAddressTable();
+	void SyncPageAddressTableDeltas();
+	bool PageAddressTableDeltasValid();
 	int AsyncFlushPageToMemoryPool(char* src, KeyType PageID);
 	int SyncFlushPageToMemoryPool(char* src, KeyType PageID);
-	void FlushXLogInfoToMemoryPool();
+	size_t FlushQueuedPages();
+	void RewarmMemoryNodes();
+	void RebalanceMemoryNodes();
+	bool FlushXLogInfoToMemoryPool();
 	void FetchXLogInfoFromMemoryPool();
+	int CheckDoorbells();
     void FlushUpdateVersionMapInfoToMemoryPool(KeyType page_id, XLogRecPtr lsn);
     int FetchUpdateVersionMapInfoFromMemoryPool(size_t info_idx);
     size_t GetFirstUpdateVersionMapInfoIndex();
@@ -38,7 +51,87 @@ public:
 
     size_t memnode_cnt;
     std::vector<int> has_failed;
+
+    // Per memory node, the index of the next PAT delta to apply, valid once
+    // a full sync set it
+    std::vector<size_t> pat_delta_ptr;
+    std::vector<bool> pat_delta_valid;
+    std::chrono::steady_clock::time_point last_full_sync_pat;
+
+    // Per memory node, whether it is being refilled with the pages it is a
+    // replica of since it reconnected, and the slot the scan is at
+    std::vector<bool> rewarming;
+    std::vector<size_t> rewarm_pa_idx, rewarm_pa_ofs;
+
+    // Per memory node, the hash of its address the placement of pages is
+    // seeded with, see PagePlacement
+    std::vector<uint32_t> memnode_seed;
+    // Whether the pages kept off their placement are being moved to it, and
+    // the slot the scan is at
+    bool rebalancing;
+    size_t rebalance_pa_idx, rebalance_pa_ofs;
+
+    // Per memory node, its update doorbell once looked up and the words last
+    // read of it
+    std::vector<bool> has_doorbell;
+    std::vector<ibv_mr> doorbell_mr;
+    std::vector<UpdateDoorbell> doorbell_seen;
+    // The xlog info last flushed, valid is false before the first flush
+    XLogInfo flushed_xlog_info;
+
+private:
+    bool FetchMRInfo(size_t memnode_id, size_t pa_idx, mr_info_response& res);
+    bool FetchPageAddressTableDeltas(size_t memnode_id, size_t ptr, sync_pat_delta_response& res);
+	int AccessPageOnMemoryNode(KeyType PageID, size_t memnode_id);
+	int RemovePageOnMemoryNode(KeyType PageID, size_t memnode_id);
+	int AsyncFlushPageToMemoryNode(char* src, KeyType PageID, size_t memnode_id);
+	int SyncFlushPageToMemoryNode(char* src, KeyType PageID, size_t memnode_id);
+	int AsyncFlushPagesToMemoryNode(char** srcs, KeyType* PageIDs, int cnt, size_t memnode_id);
+    // Runs op on every replica of the page, 0 if one of them succeeded
+    template<typename Op> int ForEachReplica(KeyType PageID, Op op);
+};
+
+//! A few registered slots of the Message, PageArray and PageIDArray pools
+//! are kept per thread, so that a fetch takes and returns its slots
+//! without the shared chunk allocator and its lock. They belong to the
+//! RDMA_Manager of one connection, a new connection starts a new
+//! generation and the cached slots of an older one are dropped with it.
+#define CACHED_SLOTS_PER_POOL 4
+
+static std::atomic<uint64_t> slot_generation(1);
+
+struct SlotCache{
+    uint64_t generation = 0;
+    int cnt[DSMEngine::DataChunk + 1] = {};
+    ibv_mr slots[DSMEngine::DataChunk + 1][CACHED_SLOTS_PER_POOL];
 };
+static thread_local SlotCache slot_cache;
+
+static bool SlotIsCached(DSMEngine::Chunk_type pool){
+    return pool == DSMEngine::Message || pool == DSMEngine::PageArray || pool == DSMEngine::PageIDArray;
+}
+
+void AllocateCachedSlot(DSMEngine::RDMA_Manager* rdma_mg, ibv_mr& mr, DSMEngine::Chunk_type pool){
+    uint64_t generation = slot_generation.load(std::memory_order_acquire);
+    if(slot_cache.generation != generation){
+        slot_cache = SlotCache();
+        slot_cache.generation = generation;
+    }
+    if(SlotIsCached(pool) && slot_cache.cnt[pool] > 0){
+        mr = slot_cache.slots[pool][--slot_cache.cnt[pool]];
+        return;
+    }
+    rdma_mg->Allocate_Local_RDMA_Slot(mr, pool);
+}
+
+void DeallocateCachedSlot(DSMEngine::RDMA_Manager* rdma_mg, ibv_mr& mr, DSMEngine::Chunk_type pool){
+    if(SlotIsCached(pool) && slot_cache.generation == slot_generation.load(std::memory_order_acquire)
+        && slot_cache.cnt[pool] < CACHED_SLOTS_PER_POOL){
+        slot_cache.slots[pool][slot_cache.cnt[pool]++] = mr;
+        return;
+    }
+    rdma_mg->Deallocate_Local_RDMA_Slot(mr.addr, pool);
+}
 
 static bool first_time_to_connect_to_mempool_server = true;
 static std::chrono::steady_clock::time_point last_time_try_connecting_to_mempool_server;
@@ -49,6 +142,7 @@ bool time_to_reconnect(){
 
 MemPoolClient::MemPoolClient(){
 	LWLockAcquire(mempool_client_connection_lock, LW_EXCLUSIVE);
+    DSMEngine::huge_page_size = mempool_huge_pages;
     struct DSMEngine::config_t config = {
             NULL,  /* dev_name */
             122189, /* tcp_port */
@@ -57,6 +151,7 @@ MemPoolClient::MemPoolClient(){
             0,
             0 << 16 | get_MemPoolClient_node_id()};
     rdma_mg = DSMEngine::RDMA_Manager::Get_Instance(&config);
+    slot_generation.fetch_add(1, std::memory_order_acq_rel);
     if (rdma_mg == NULL){
         has_failed.push_back(true);
         goto exit;
@@ -64,6 +159,22 @@ MemPoolClient::MemPoolClient(){
     memnode_cnt = rdma_mg->GetMemoryNodeNum();
     for(int i = 0; i < memnode_cnt; i++)
         has_failed.push_back(!rdma_mg->memory_node_status[2 * i + 1]);
+    pat_delta_ptr.assign(memnode_cnt, 0);
+    pat_delta_valid.assign(memnode_cnt, false);
+    rewarming.assign(memnode_cnt, false);
+    rewarm_pa_idx.assign(memnode_cnt, 0);
+    rewarm_pa_ofs.assign(memnode_cnt, 0);
+    for(int i = 0; i < memnode_cnt; i++){
+        const std::string& address = rdma_mg->memory_nodes[2 * i + 1];
+        memnode_seed.push_back(DSMEngine::Hash(address.data(), address.size(), 0));
+    }
+    // The memory nodes may have been others when the pages were flushed
+    rebalancing = true;
+    rebalance_pa_idx = rebalance_pa_ofs = 0;
+    has_doorbell.assign(memnode_cnt, false);
+    doorbell_mr.assign(memnode_cnt, ibv_mr());
+    doorbell_seen.assign(memnode_cnt, UpdateDoorbell());
+    memset(&flushed_xlog_info, 0, sizeof(flushed_xlog_info));
     rdma_mg->Mempool_initialize(DSMEngine::PageArray, BLCKSZ, RECEIVE_OUTSTANDING_SIZE * BLCKSZ);
     rdma_mg->Mempool_initialize(DSMEngine::PageIDArray, sizeof(KeyType), RECEIVE_OUTSTANDING_SIZE * sizeof(KeyType));
 
@@ -94,13 +205,13 @@ exit:
 	LWLockRelease(mempool_client_connection_lock);
 }
 
-bool MemPoolClient::AppendToPAT(size_t memnode_id, size_t pa_idx){
+bool MemPoolClient::FetchMRInfo(size_t memnode_id, size_t pa_idx, mr_info_response& res){
 	ibv_mr recv_mr, send_mr;
 
-	rdma_mg->Allocate_Local_RDMA_Slot(recv_mr, DSMEngine::Message);
+	AllocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
 	has_failed[memnode_id] |= rdma_mg->post_receive<DSMEngine::RDMA_Reply>(&recv_mr, 2 * memnode_id + 1);
     if(has_failed[memnode_id]) return false;
-	rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+	AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 	auto req = &send_pointer->content.mr_info;
 	send_pointer->command = DSMEngine::mr_info_;
@@ -117,21 +228,107 @@ bool MemPoolClient::AppendToPAT(size_t memnode_id, size_t pa_idx){
 	has_failed[memnode_id] |= rdma_mg->poll_completion(wc, 1, qp_type, false, 2 * memnode_id + 1);
     if(has_failed[memnode_id]) return false;
 
-	auto res = &((DSMEngine::RDMA_Reply*)recv_mr.addr)->content.mr_info;
-	pat.append_page_array(memnode_id, pa_idx, res->pa_mr.length / BLCKSZ, res->pa_mr, res->pida_mr);
+	res = ((DSMEngine::RDMA_Reply*)recv_mr.addr)->content.mr_info;
 
-	rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-	rdma_mg->Deallocate_Local_RDMA_Slot(recv_mr.addr, DSMEngine::Message);
+	DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+	DeallocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
     return true;
 }
 
+bool MemPoolClient::AppendToPAT(size_t memnode_id, size_t pa_idx){
+    mr_info_response res;
+    if(!FetchMRInfo(memnode_id, pa_idx, res))
+        return false;
+	pat.append_page_array(memnode_id, pa_idx, res.pa_mr.length / BLCKSZ, res.pa_mr, res.pida_mr);
+    return true;
+}
+
+//! Reads posted by PrefetchPageFromMemoryPool, at most PREFETCH_PAGES per
+//! thread. Each is a chained read of the page and its id with only the last
+//! work request signaled. A queue pair completes in posting order, so a
+//! completion polled from a memory node's send queue belongs to its oldest
+//! posted prefetch. Every other operation polls the same queue expecting
+//! its own completion, so they first drain the prefetches in flight. The
+//! pages read stay in the table until they are fetched or replaced.
+#define PREFETCH_PAGES 16
+
+enum PrefetchState {PREFETCH_FREE, PREFETCH_POSTED, PREFETCH_DONE};
+
+struct PrefetchedPage{
+    KeyType page_id;
+    size_t memnode_id;
+    uint64_t seq;
+    PrefetchState state;
+    bool has_slots;
+    ibv_mr pa_mr, pida_mr;
+};
+
+struct PrefetchTable{
+    uint64_t generation = 0;
+    uint64_t seq = 0;
+    int posted = 0;
+    PrefetchedPage pages[PREFETCH_PAGES] = {};
+};
+static thread_local PrefetchTable prefetch_table;
+
+// The slots of an older connection went away with its RDMA_Manager
+static PrefetchTable* GetPrefetchTable(){
+    uint64_t generation = slot_generation.load(std::memory_order_acquire);
+    if(prefetch_table.generation != generation){
+        prefetch_table = PrefetchTable();
+        prefetch_table.generation = generation;
+    }
+    return &prefetch_table;
+}
+
+static PrefetchedPage* OldestPrefetch(PrefetchTable* table, int memnode_id, bool posted){
+    PrefetchedPage* oldest = nullptr;
+    for(int i = 0; i < PREFETCH_PAGES; i++){
+        auto page = &table->pages[i];
+        if(posted ? page->state != PREFETCH_POSTED : page->state == PREFETCH_POSTED)
+            continue;
+        if(memnode_id >= 0 && page->memnode_id != (size_t)memnode_id)
+            continue;
+        if(oldest == nullptr || page->seq < oldest->seq)
+            oldest = page;
+    }
+    return oldest;
+}
+
+// Polls one completion of the memory node, that of its oldest prefetch
+static void CompleteOldestPrefetch(MemPoolClient* client, PrefetchTable* table, size_t memnode_id){
+    ibv_wc wc;
+    auto page = OldestPrefetch(table, memnode_id, true);
+    if(page == nullptr)
+        return;
+    if(client->rdma_mg->poll_completion(&wc, 1, "main", true, memnode_id * 2 + 1) != 0){
+        MemPoolStatCount(MEMPOOL_STAT_READ_FAILURES, 1);
+        client->has_failed[memnode_id] = true;
+        for(int i = 0; i < PREFETCH_PAGES; i++)
+            if(table->pages[i].state == PREFETCH_POSTED && table->pages[i].memnode_id == memnode_id){
+                table->pages[i].state = PREFETCH_FREE;
+                table->posted--;
+            }
+        return;
+    }
+    page->state = PREFETCH_DONE;
+    table->posted--;
+}
+
+static void DrainPrefetchedPages(MemPoolClient* client){
+    auto table = GetPrefetchTable();
+    while(table->posted > 0)
+        CompleteOldestPrefetch(client, table, OldestPrefetch(table, -1, true)->memnode_id);
+}
+
 static pid_t pid = -1;
 static MemPoolClient* client = nullptr;
 static std::mutex get_instance_lock;
-MemPoolClient* MemPoolClient::Get_Instance(){
+MemPoolClient* MemPoolClient::Get_Instance(bool drain){
     Clear_Instance_If_Failed();
     get_instance_lock.lock();
     if (client == nullptr && (first_time_to_connect_to_mempool_server || time_to_reconnect()) || pid != getpid()){
+        bool reconnect = !first_time_to_connect_to_mempool_server && pid == getpid();
         first_time_to_connect_to_mempool_server = false;
         last_time_try_connecting_to_mempool_server = std::chrono::steady_clock::now();
         client = new MemPoolClient();
@@ -141,6 +338,8 @@ MemPoolClient* MemPoolClient::Get_Instance(){
             delete client;
             client = nullptr;
         }
+        else if(reconnect)
+            MemPoolStatCount(MEMPOOL_STAT_RECONNECTS, 1);
 	}
     else if (client != nullptr && time_to_reconnect()){
         last_time_try_connecting_to_mempool_server = std::chrono::steady_clock::now();
@@ -148,6 +347,16 @@ MemPoolClient* MemPoolClient::Get_Instance(){
             if(client->has_failed[i]){
                 if(client->rdma_mg->Client_Set_Up_One_Connection(2 * i + 1)){
                     client->has_failed[i] = false;
+                    // A restarted memory node registered another doorbell
+                    client->has_doorbell[i] = false;
+                    MemPoolStatCount(MEMPOOL_STAT_RECONNECTS, 1);
+                    if(MEMPOOL_PAGE_REPLICAS > 1){
+                        client->rewarming[i] = true;
+                        client->rewarm_pa_idx[i] = client->rewarm_pa_ofs[i] = 0;
+                    }
+                    // Its page arrays come back into the table
+                    client->rebalancing = true;
+                    client->rebalance_pa_idx = client->rebalance_pa_ofs = 0;
                     if(is_first_mpc_connection[i]){
                         if(client->AppendToPAT(i, 0))
                             is_first_mpc_connection[i] = false;
@@ -158,6 +367,8 @@ MemPoolClient* MemPoolClient::Get_Instance(){
             }
     }
     get_instance_lock.unlock();
+    if(drain && client != nullptr)
+        DrainPrefetchedPages(client);
     return client;
 }
 void MemPoolClient::Clear_Instance(bool disconnect){
@@ -211,6 +422,7 @@ void ReportStatForMemPool(){
             (double)tmpStoCnt / totalCnt
         );
     LWLockRelease(mempool_client_stat_lock);
+    DSMEngine::hugePagePrintStats(stderr);
 }
 void ResetStatForMemPool(){
     LWLockAcquire(mempool_client_stat_lock, LW_EXCLUSIVE);
@@ -219,26 +431,34 @@ void ResetStatForMemPool(){
 }
 
 bool PageExistsInMemPool(KeyType PageID, RDMAReadPageInfo* rdma_read_info) {
-	auto client = mempool::MemPoolClient::Get_Instance();
+	auto client = mempool::MemPoolClient::Get_Instance(false);
     if(client == NULL) return false;
-    size_t memnode_id = DSMEngine::Hash(&PageID, 0) % client->memnode_cnt;
-    if(client->has_failed[memnode_id]) return false;
-	client->pat.at(PageID, *rdma_read_info);
+	client->pat.at(PageID, *rdma_read_info, client->has_failed.data());
 	return rdma_read_info->pa_ofs != -1;
 }
 
-bool FetchPageFromMemoryPool(char* des, KeyType PageID, RDMAReadPageInfo* rdma_read_info){
-	auto client = mempool::MemPoolClient::Get_Instance();
-    if(client == NULL || client->has_failed[rdma_read_info->memnode_id]) return false;
+namespace mempool{
+
+// Reads the page in the slot, false if another page took it. The memory node
+// is marked failed if the read fails.
+static bool ReadPageFromMemoryNode(MemPoolClient* client, char* des, KeyType PageID, RDMAReadPageInfo* rdma_read_info, bool& failed){
 	auto rdma_mg = client->rdma_mg;
 
-    bool failed = false, ret = false;
+    bool ret = false;
+    failed = false;
 	ibv_mr pa_mr, pida_mr;
-	rdma_mg->Allocate_Local_RDMA_Slot(pa_mr, DSMEngine::PageArray);
-	rdma_mg->Allocate_Local_RDMA_Slot(pida_mr, DSMEngine::PageIDArray);
-	failed = rdma_mg->RDMA_Read(&rdma_read_info->remote_pa_mr, &pa_mr, rdma_read_info->pa_ofs * BLCKSZ, BLCKSZ, IBV_SEND_SIGNALED, 1, rdma_read_info->memnode_id * 2 + 1, "main");
-	if(failed) goto exit;
-	failed = rdma_mg->RDMA_Read(&rdma_read_info->remote_pida_mr, &pida_mr, rdma_read_info->pa_ofs * sizeof(KeyType), sizeof(KeyType), IBV_SEND_SIGNALED, 1, rdma_read_info->memnode_id * 2 + 1, "main");
+	mempool::AllocateCachedSlot(rdma_mg, pa_mr, DSMEngine::PageArray);
+	mempool::AllocateCachedSlot(rdma_mg, pida_mr, DSMEngine::PageIDArray);
+    {
+    // The page and its id in one chained post, polled once
+    ibv_mr* remote_mrs[2] = {&rdma_read_info->remote_pa_mr, &rdma_read_info->remote_pida_mr};
+    ibv_mr* local_mrs[2] = {&pa_mr, &pida_mr};
+    uint64_t remote_offsets[2] = {rdma_read_info->pa_ofs * BLCKSZ, rdma_read_info->pa_ofs * sizeof(KeyType)};
+    size_t msg_sizes[2] = {BLCKSZ, sizeof(KeyType)};
+    auto start = std::chrono::steady_clock::now();
+	failed = rdma_mg->RDMA_Read_Batch(remote_mrs, local_mrs, remote_offsets, msg_sizes, 2, 1, rdma_read_info->memnode_id * 2 + 1, "main");
+    MemPoolStatReadLatency(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    }
 	if(failed) goto exit;
 
     {
@@ -250,52 +470,205 @@ bool FetchPageFromMemoryPool(char* des, KeyType PageID, RDMAReadPageInfo* rdma_r
     }
 
 exit:
-	rdma_mg->Deallocate_Local_RDMA_Slot(pa_mr.addr, DSMEngine::PageArray);
-	rdma_mg->Deallocate_Local_RDMA_Slot(pida_mr.addr, DSMEngine::PageIDArray);
+	mempool::DeallocateCachedSlot(rdma_mg, pa_mr, DSMEngine::PageArray);
+	mempool::DeallocateCachedSlot(rdma_mg, pida_mr, DSMEngine::PageIDArray);
     if(failed){
+        MemPoolStatCount(MEMPOOL_STAT_READ_FAILURES, 1);
         client->has_failed[rdma_read_info->memnode_id] = true;
         return false;
     }
 	return ret;
 }
 
+} // namespace mempool
+
+bool FetchPageFromMemoryPool(char* des, KeyType PageID, RDMAReadPageInfo* rdma_read_info){
+	auto client = mempool::MemPoolClient::Get_Instance();
+    if(client == NULL) return false;
+    // A failed memory node is passed over for the next replica of the page
+    for(int r = 0; r < MEMPOOL_PAGE_REPLICAS; r++){
+        if(client->has_failed[rdma_read_info->memnode_id]){
+            client->pat.at(PageID, *rdma_read_info, client->has_failed.data());
+            if(rdma_read_info->pa_ofs == -1)
+                return false;
+        }
+        bool failed;
+        bool ret = mempool::ReadPageFromMemoryNode(client, des, PageID, rdma_read_info, failed);
+        if(!failed)
+            return ret;
+    }
+    return false;
+}
+
+bool PrefetchPageFromMemoryPool(KeyType PageID){
+	RDMAReadPageInfo rdma_read_info;
+	auto client = mempool::MemPoolClient::Get_Instance(false);
+    if(client == NULL || !PageExistsInMemPool(PageID, &rdma_read_info)) return false;
+    auto table = mempool::GetPrefetchTable();
+    for(int i = 0; i < PREFETCH_PAGES; i++)
+        if(table->pages[i].state != mempool::PREFETCH_FREE
+            && mempool::KeyTypeEqualFunction()(table->pages[i].page_id, PageID))
+            return true;
+
+    // A free entry, else the oldest read page, else the oldest in flight
+    mempool::PrefetchedPage* page = nullptr;
+    for(int i = 0; i < PREFETCH_PAGES && page == nullptr; i++)
+        if(table->pages[i].state == mempool::PREFETCH_FREE)
+            page = &table->pages[i];
+    if(page == nullptr)
+        page = mempool::OldestPrefetch(table, -1, false);
+    if(page == nullptr){
+        page = mempool::OldestPrefetch(table, -1, true);
+        mempool::CompleteOldestPrefetch(client, table, page->memnode_id);
+    }
+    page->state = mempool::PREFETCH_FREE;
+    if(client->has_failed[rdma_read_info.memnode_id]) return false;
+
+	auto rdma_mg = client->rdma_mg;
+    if(!page->has_slots){
+        rdma_mg->Allocate_Local_RDMA_Slot(page->pa_mr, DSMEngine::PageArray);
+        rdma_mg->Allocate_Local_RDMA_Slot(page->pida_mr, DSMEngine::PageIDArray);
+        page->has_slots = true;
+    }
+    ibv_mr* remote_mrs[2] = {&rdma_read_info.remote_pa_mr, &rdma_read_info.remote_pida_mr};
+    ibv_mr* local_mrs[2] = {&page->pa_mr, &page->pida_mr};
+    uint64_t remote_offsets[2] = {rdma_read_info.pa_ofs * BLCKSZ, rdma_read_info.pa_ofs * sizeof(KeyType)};
+    size_t msg_sizes[2] = {BLCKSZ, sizeof(KeyType)};
+	if(rdma_mg->RDMA_Read_Batch(remote_mrs, local_mrs, remote_offsets, msg_sizes, 2, 0, rdma_read_info.memnode_id * 2 + 1, "main")){
+        MemPoolStatCount(MEMPOOL_STAT_READ_FAILURES, 1);
+        client->has_failed[rdma_read_info.memnode_id] = true;
+        return false;
+    }
+    page->page_id = PageID;
+    page->memnode_id = rdma_read_info.memnode_id;
+    page->seq = ++table->seq;
+    page->state = mempool::PREFETCH_POSTED;
+    table->posted++;
+    return true;
+}
+
+int FetchPrefetchedPageFromMemoryPool(char* des, KeyType PageID){
+	auto client = mempool::MemPoolClient::Get_Instance(false);
+    if(client == NULL) return 0;
+    auto table = mempool::GetPrefetchTable();
+    mempool::PrefetchedPage* page = nullptr;
+    for(int i = 0; i < PREFETCH_PAGES && page == nullptr; i++)
+        if(table->pages[i].state != mempool::PREFETCH_FREE
+            && mempool::KeyTypeEqualFunction()(table->pages[i].page_id, PageID))
+            page = &table->pages[i];
+    if(page == nullptr) return 0;
+
+    while(page->state == mempool::PREFETCH_POSTED)
+        mempool::CompleteOldestPrefetch(client, table, page->memnode_id);
+    if(page->state != mempool::PREFETCH_DONE) return 0;
+    page->state = mempool::PREFETCH_FREE;
+    // The slot was given to another page after the table was read
+    if(!mempool::KeyTypeEqualFunction()(*(KeyType*)page->pida_mr.addr, PageID))
+        return -1;
+    memcpy(des, page->pa_mr.addr, BLCKSZ);
+    return 1;
+}
+
 bool LsnIsSatisfied(XLogRecPtr PageLSN, XLogRecPtr TargetLSN){
 	return PageLSN <= TargetLSN;
 }
 
-void GetLSNListfromVersionMap(KeyType PageID, XLogRecPtr current_lsn, XLogRecPtr target_lsn, std::vector<XLogRecPtr>& lsn_list){
-	lsn_list.clear();
+#define REPLAY_LSN_BATCH 256
+
+// Copies the LSNs of the page in (current_lsn, target_lsn] into lsn_list, up
+// to max_cnt of them, and returns how many were copied. The version map only
+// appends, and the records of a page are inserted in LSN order, so the list
+// comes out sorted and the walk stops at the first LSN past target_lsn.
+static size_t GetLSNListfromVersionMap(KeyType PageID, uint32 hashcode, XLogRecPtr current_lsn, XLogRecPtr target_lsn, XLogRecPtr* lsn_list, size_t max_cnt){
+	size_t cnt = 0;
 	bool found, head;
 	auto result = 
-		hash_search_vm(version_map, &PageID, HASH_FIND, &found, &head);
+		hash_search_with_hash_value_vm(version_map, &PageID, hashcode, HASH_FIND, &found, &head);
 	if(!found)
-		return;
+		return 0;
 	while(result != NULL){
+		XLogRecPtr* lsn;
+		int slot_cnt;
 		if(head){
-			auto item_head = (ITEMHEAD_VM*)result;
-			for(int i = 0; i < ITEMHEAD_SLOT_CNT_VM; i++)
-				if(item_head->lsn[i] == InvalidXLogRecPtr)
-					break;
-				else if(current_lsn < item_head->lsn[i] && item_head->lsn[i] <= target_lsn)
-					lsn_list.push_back(item_head->lsn[i]);
-			result = hash_next_segment_vm(item_head, true);
-			head = false;
+			lsn = ((ITEMHEAD_VM*)result)->lsn;
+			slot_cnt = ITEMHEAD_SLOT_CNT_VM;
 		}
 		else{
-			auto item_seg = (ITEMSEG_VM*)result;
-			for(int i = 0; i < ITEMSEG_SLOT_CNT_VM; i++)
-				if(item_seg->lsn[i] == InvalidXLogRecPtr)
-					break;
-				else if(current_lsn < item_seg->lsn[i] && item_seg->lsn[i] <= target_lsn)
-					lsn_list.push_back(item_seg->lsn[i]);
-			result = hash_next_segment_vm(item_seg, false);
+			lsn = ((ITEMSEG_VM*)result)->lsn;
+			slot_cnt = ITEMSEG_SLOT_CNT_VM;
 		}
+		for(int i = 0; i < slot_cnt; i++){
+			if(lsn[i] == InvalidXLogRecPtr || lsn[i] > target_lsn)
+				return cnt;
+			if(lsn[i] <= current_lsn)
+				continue;
+			Assert(cnt == 0 || lsn_list[cnt - 1] < lsn[i]);
+			lsn_list[cnt++] = lsn[i];
+			if(cnt == max_cnt)
+				return cnt;
+		}
+		result = hash_next_segment_vm(result, head);
+		head = false;
+	}
+	return cnt;
+}
+
+//! The records replayed onto stale mempool pages, kept per backend by their
+//! LSN. The stale pages a scan reads mostly lag behind by the same records,
+//! a multi-insert or a vacuum of neighbouring blocks, or lists of records
+//! that overlap, so each gets the records without its own WAL reads. The
+//! raw record is kept, a hit decodes it again from memory. A record at a
+//! flushed LSN never changes, the entries are only ever replaced. Records
+//! larger than REPLAY_RECORD_MAX_LEN, full page images mostly, aren't kept.
+#define REPLAY_RECORD_CACHE_SIZE 256
+#define REPLAY_RECORD_MAX_LEN (2 * BLCKSZ)
+
+struct ReplayRecord{
+	XLogRecPtr lsn, end_lsn;
+	uint32 len, cap;
+	char* data;
+};
+static ReplayRecord replay_record_cache[REPLAY_RECORD_CACHE_SIZE];
+
+// Decodes the record at lsn into reader_state, reading it only if it isn't
+// kept. The record is valid until the next call.
+static XLogRecord* ReadReplayRecord(XLogReaderState* reader_state, XLogRecPtr lsn){
+	auto& entry = replay_record_cache[(lsn / MAXIMUM_ALIGNOF) % REPLAY_RECORD_CACHE_SIZE];
+	char* err_msg = NULL;
+	XLogRecord* record;
+
+	if(entry.len > 0 && entry.lsn == lsn){
+		if(DecodeXLogRecord(reader_state, (XLogRecord*)entry.data, &err_msg)){
+			reader_state->ReadRecPtr = lsn;
+			reader_state->EndRecPtr = entry.end_lsn;
+			return reader_state->decoded_record;
+		}
+		entry.len = 0;
 	}
-	sort(lsn_list.begin(), lsn_list.end());
-	return;
+
+	XLogBeginRead(reader_state, lsn);
+	record = XLogReadRecord(reader_state, &err_msg);
+	if(record == NULL)
+		elog(ERROR, "could not read WAL record at %X/%X to replay onto a mempool page: %s",
+			 (uint32) (lsn >> 32), (uint32) lsn, err_msg ? err_msg : "no record");
+	if(record->xl_tot_len > REPLAY_RECORD_MAX_LEN)
+		return record;
+	if(entry.cap < record->xl_tot_len){
+		free(entry.data);
+		entry.data = (char*)malloc(REPLAY_RECORD_MAX_LEN);
+		entry.cap = entry.data == NULL ? 0 : REPLAY_RECORD_MAX_LEN;
+		entry.len = 0;
+		if(entry.data == NULL)
+			return record;
+	}
+	memcpy(entry.data, record, record->xl_tot_len);
+	entry.lsn = lsn;
+	entry.end_lsn = reader_state->EndRecPtr;
+	entry.len = record->xl_tot_len;
+	return record;
 }
 
-void ApplyLSNListToPage(KeyType PageID, char* block, std::vector<XLogRecPtr>& lsn_list){
+static void ApplyLSNListToPage(KeyType PageID, char* block, XLogRecPtr* lsn_list, size_t lsn_cnt){
 	static bool initialized = false;
 	if(!initialized){
     	ReadControlFileTimeLine();
@@ -314,10 +687,8 @@ void ApplyLSNListToPage(KeyType PageID, char* block, std::vector<XLogRecPtr>& ls
     BufferTag bufferTag;
 	XLogRecord* record;
     INIT_BUFFERTAG(bufferTag, ((RelFileNode){PageID.SpcID, PageID.DbID, PageID.RelID}), (ForkNumber)PageID.ForkNum, PageID.BlkNum);
-    for(int i = 0; i < lsn_list.size(); i++) {
-		char* err_msg;
-        XLogBeginRead(reader_state, lsn_list[i]);
-        record = XLogReadRecord(reader_state, &err_msg);
+    for(size_t i = 0; i < lsn_cnt; i++) {
+        record = ReadReplayRecord(reader_state, lsn_list[i]);
 		polar_xlog_decode_data(reader_state);
         buf = InvalidBuffer;
 
@@ -372,26 +743,32 @@ void ApplyLSNListToPage(KeyType PageID, char* block, std::vector<XLogRecPtr>& ls
 
 bool ReplayXLog(KeyType PageID, BufferDesc* bufHdr, char* block, XLogRecPtr current_lsn, XLogRecPtr target_lsn){
     MempoolClientReplaying = true;
-	std::vector<XLogRecPtr> lsn_list;
-	LWLockAcquire(mempool_client_version_map_lock, LW_SHARED);
-	GetLSNListfromVersionMap(PageID, current_lsn, target_lsn, lsn_list);
-	LWLockRelease(mempool_client_version_map_lock);
-	if(lsn_list.size() > 0){
-		ApplyLSNListToPage(PageID, block, lsn_list);
-        MempoolClientReplaying = false;
-		return true;
-	}
-	else{
-        MempoolClientReplaying = false;
-		return false;
-    }
+	XLogRecPtr lsn_list[REPLAY_LSN_BATCH];
+	bool replayed = false;
+	size_t lsn_cnt;
+	uint32 hashcode = get_hash_value_vm(version_map, &PageID);
+	LWLock* partition_lock = VersionMapPartitionLock(hashcode);
+	// A page far behind is replayed in batches, each picking up after the
+	// last record applied
+	do{
+		LWLockAcquire(partition_lock, LW_SHARED);
+		lsn_cnt = GetLSNListfromVersionMap(PageID, hashcode, current_lsn, target_lsn, lsn_list, REPLAY_LSN_BATCH);
+		LWLockRelease(partition_lock);
+		if(lsn_cnt == 0)
+			break;
+		ApplyLSNListToPage(PageID, block, lsn_list, lsn_cnt);
+		current_lsn = lsn_list[lsn_cnt - 1];
+		replayed = true;
+	}while(lsn_cnt == REPLAY_LSN_BATCH);
+    MempoolClientReplaying = false;
+	return replayed;
 }
 
 void mempool::MemPoolClient::Disconnect(){
 	auto rdma_mg = this->rdma_mg;
 	ibv_mr send_mr;
 
-	rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 	send_pointer->command = DSMEngine::disconnect_;
 	rdma_mg->post_send<DSMEngine::RDMA_Request>(&send_mr, 1);
@@ -400,17 +777,82 @@ void mempool::MemPoolClient::Disconnect(){
 	std::string qp_type("main");
 	rdma_mg->poll_completion(wc, 1, qp_type, true, 1);
 	
-	rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+}
+
+int mempool::MemPoolClient::PageReplicaCount(){
+    return std::min<int>(MEMPOOL_PAGE_REPLICAS, memnode_cnt);
+}
+
+// The score of a memory node for a page, the 64 bit finalizer of MurmurHash3
+// over both hashes
+static uint64_t RendezvousScore(uint32_t page_hash, uint32_t memnode_seed){
+    uint64_t h = (uint64_t)page_hash << 32 | memnode_seed;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+//! Rendezvous hashing: replica r of a page is the memory node with the r-th
+//! highest score for it. A node added takes only the pages it scores highest
+//! for, about 1/n of them, and a node removed gives up only its own, where a
+//! hash modulo the node count moved nearly every page. The nodes are scored
+//! by their address, not their place in the configuration, so every compute
+//! node places a page alike whatever order it lists them in. The replica of
+//! a failed node's page is the next highest, spread over all the others.
+size_t mempool::MemPoolClient::PagePlacement(KeyType PageID, int replica){
+    uint32_t page_hash = DSMEngine::Hash(&PageID, 0);
+    size_t chosen[MEMPOOL_PAGE_REPLICAS];
+    for(int r = 0; r <= replica; r++){
+        uint64_t best_score = 0;
+        bool found = false;
+        for(size_t i = 0; i < memnode_cnt; i++){
+            bool taken = false;
+            for(int p = 0; p < r; p++)
+                taken |= chosen[p] == i;
+            uint64_t score = RendezvousScore(page_hash, memnode_seed[i]);
+            if(!taken && (!found || score > best_score)){
+                chosen[r] = i;
+                best_score = score;
+                found = true;
+            }
+        }
+    }
+    return chosen[replica];
+}
+
+template<typename Op>
+int mempool::MemPoolClient::ForEachReplica(KeyType PageID, Op op){
+    int rc = -1;
+    for(int r = 0; r < PageReplicaCount(); r++)
+        if(op(PagePlacement(PageID, r)) == 0)
+            rc = 0;
+    return rc;
 }
 
 int mempool::MemPoolClient::AccessPageOnMemoryPool(KeyType PageID){
+    return ForEachReplica(PageID, [&](size_t memnode_id){return AccessPageOnMemoryNode(PageID, memnode_id);});
+}
+int mempool::MemPoolClient::RemovePageOnMemoryPool(KeyType PageID){
+    return ForEachReplica(PageID, [&](size_t memnode_id){return RemovePageOnMemoryNode(PageID, memnode_id);});
+}
+int mempool::MemPoolClient::AsyncFlushPageToMemoryPool(char* src, KeyType PageID){
+    return ForEachReplica(PageID, [&](size_t memnode_id){return AsyncFlushPageToMemoryNode(src, PageID, memnode_id);});
+}
+int mempool::MemPoolClient::SyncFlushPageToMemoryPool(char* src, KeyType PageID){
+    return ForEachReplica(PageID, [&](size_t memnode_id){return SyncFlushPageToMemoryNode(src, PageID, memnode_id);});
+}
+
+int mempool::MemPoolClient::AccessPageOnMemoryNode(KeyType PageID, size_t memnode_id){
     int rc = 0;
 	auto rdma_mg = this->rdma_mg;
 	ibv_mr send_mr;
-    size_t memnode_id = DSMEngine::Hash(&PageID, 0) % memnode_cnt;
     if(has_failed[memnode_id]) return -1;
 
-	rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 	auto req = &send_pointer->content.access_page;
 	send_pointer->command = DSMEngine::access_page_;
@@ -421,19 +863,18 @@ int mempool::MemPoolClient::AccessPageOnMemoryPool(KeyType PageID){
 	std::string qp_type("main");
 	rc |= rdma_mg->poll_completion(wc, 1, qp_type, true, memnode_id * 2 + 1);
 	
-	rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
     if(rc) has_failed[memnode_id] = true;
     return rc;
 }
-int mempool::MemPoolClient::RemovePageOnMemoryPool(KeyType PageID){
+int mempool::MemPoolClient::RemovePageOnMemoryNode(KeyType PageID, size_t memnode_id){
     int rc = 0;
 	auto rdma_mg = this->rdma_mg;
 	ibv_mr send_mr;
-    size_t memnode_id = DSMEngine::Hash(&PageID, 0) % memnode_cnt;
     if(has_failed[memnode_id])
         return -1;
 
-	rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 	auto req = &send_pointer->content.remove_page;
 	send_pointer->command = DSMEngine::async_remove_page_;
@@ -444,7 +885,7 @@ int mempool::MemPoolClient::RemovePageOnMemoryPool(KeyType PageID){
 	std::string qp_type("main");
 	rc |= rdma_mg->poll_completion(wc, 1, qp_type, true, memnode_id * 2 + 1);
 	
-	rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
     if(rc) has_failed[memnode_id] = true;
     return rc;
 }
@@ -479,16 +920,24 @@ void mempool::MemPoolClient::GetNewestPageAddressTable(){
 	auto& pat = this->pat;
 	auto rdma_mg = this->rdma_mg;
 	ibv_mr recv_mr, send_mr;
+    // Deltas from here on cover whatever the scan below misses
+    sync_pat_delta_response head;
+    for(size_t i = 0; i < memnode_cnt; i++){
+        pat_delta_valid[i] = !has_failed[i] && FetchPageAddressTableDeltas(i, SYNC_PAT_DELTA_HEAD, head) && !head.overrun;
+        if(pat_delta_valid[i])
+            pat_delta_ptr[i] = head.next_ptr;
+    }
+    last_full_sync_pat = std::chrono::steady_clock::now();
 	for(size_t i = 0, max_i = pat.page_array_count(); i < max_i; i++){
         size_t memnode_id, memnode_pa_idx;
         pat.get_memnode_id(i, memnode_id, memnode_pa_idx);
         if(has_failed[memnode_id])
             continue;
 		for(size_t j = 0, max_j = pat.page_array_size(i); j < max_j; j += SYNC_PAT_SIZE){
-			rdma_mg->Allocate_Local_RDMA_Slot(recv_mr, DSMEngine::Message);
+			mempool::AllocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
 			has_failed[memnode_id] |= rdma_mg->post_receive<DSMEngine::RDMA_Reply>(&recv_mr, memnode_id * 2 + 1);
             if(has_failed[memnode_id]) break;
-			rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+			mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 			auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 			auto req = &send_pointer->content.sync_pat;
 			send_pointer->command = DSMEngine::sync_pat_;
@@ -510,21 +959,82 @@ void mempool::MemPoolClient::GetNewestPageAddressTable(){
 			for(size_t k = 0; j + k < max_j && k < SYNC_PAT_SIZE; k++)
 				pat.update(i, j + k, res->page_id_array[k]);
 
-			rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-			rdma_mg->Deallocate_Local_RDMA_Slot(recv_mr.addr, DSMEngine::Message);
+			mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+			mempool::DeallocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
 		}
     }
 }
 
-int mempool::MemPoolClient::AsyncFlushPageToMemoryPool(char* src, KeyType PageID){
+bool mempool::MemPoolClient::FetchPageAddressTableDeltas(size_t memnode_id, size_t ptr, sync_pat_delta_response& res){
+	auto rdma_mg = this->rdma_mg;
+	ibv_mr recv_mr, send_mr;
+    bool ok = false;
+
+	mempool::AllocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+	has_failed[memnode_id] |= rdma_mg->post_receive<DSMEngine::RDMA_Reply>(&recv_mr, memnode_id * 2 + 1);
+    if(has_failed[memnode_id]) goto exit;
+    {
+	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
+	send_pointer->command = DSMEngine::sync_pat_delta_;
+	send_pointer->buffer = recv_mr.addr;
+	send_pointer->rkey = recv_mr.rkey;
+	send_pointer->content.sync_pat_delta.ptr = ptr;
+	has_failed[memnode_id] |= rdma_mg->post_send<DSMEngine::RDMA_Request>(&send_mr, memnode_id * 2 + 1);
+    if(has_failed[memnode_id]) goto exit;
+
+	ibv_wc wc[3] = {};
+	std::string qp_type("main");
+	has_failed[memnode_id] |= rdma_mg->poll_completion(wc, 1, qp_type, true, memnode_id * 2 + 1);
+    if(has_failed[memnode_id]) goto exit;
+	has_failed[memnode_id] |= rdma_mg->poll_completion(wc, 1, qp_type, false, memnode_id * 2 + 1);
+    if(has_failed[memnode_id]) goto exit;
+
+    res = ((DSMEngine::RDMA_Reply*)recv_mr.addr)->content.sync_pat_delta;
+    ok = true;
+    }
+exit:
+	mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
+    return ok;
+}
+
+bool mempool::MemPoolClient::PageAddressTableDeltasValid(){
+    for(size_t i = 0; i < memnode_cnt; i++)
+        if(!has_failed[i] && !pat_delta_valid[i])
+            return false;
+    return true;
+}
+
+void mempool::MemPoolClient::SyncPageAddressTableDeltas(){
+    sync_pat_delta_response res;
+    for(size_t i = 0; i < memnode_cnt; i++){
+        if(has_failed[i] || !pat_delta_valid[i])
+            continue;
+        do{
+            if(!FetchPageAddressTableDeltas(i, pat_delta_ptr[i], res) || res.overrun){
+                pat_delta_valid[i] = false;
+                break;
+            }
+            for(size_t k = 0; k < res.cnt; k++){
+                size_t pa_idx;
+                // A page array only appended to the table by a later full sync
+                if(pat.get_pa_idx(i, res.deltas[k].pa_idx, pa_idx))
+                    pat.update(pa_idx, res.deltas[k].pa_ofs, res.deltas[k].page_id);
+            }
+            pat_delta_ptr[i] = res.next_ptr;
+        } while(res.cnt == SYNC_PAT_DELTA_SIZE);
+    }
+}
+
+int mempool::MemPoolClient::AsyncFlushPageToMemoryNode(char* src, KeyType PageID, size_t memnode_id){
     int rc = 0;
 	auto rdma_mg = this->rdma_mg;
 	ibv_mr send_mr;
-    size_t memnode_id = DSMEngine::Hash(&PageID, 0) % memnode_cnt;
     if(has_failed[memnode_id])
         return -1;
 
-	rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 	auto req = &send_pointer->content.flush_page;
 	send_pointer->command = DSMEngine::async_flush_page_;
@@ -536,21 +1046,25 @@ int mempool::MemPoolClient::AsyncFlushPageToMemoryPool(char* src, KeyType PageID
 	std::string qp_type("main");
 	rc |= rdma_mg->poll_completion(wc, 1, qp_type, true, memnode_id * 2 + 1);
 	
-	rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-    if(rc) has_failed[memnode_id] = true;
+	mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+    if(rc){
+        MemPoolStatCount(MEMPOOL_STAT_FLUSH_FAILURES, 1);
+        has_failed[memnode_id] = true;
+    }
+    else
+        MemPoolStatCount(MEMPOOL_STAT_FLUSHED_PAGES, 1);
     return rc;
 }
-int mempool::MemPoolClient::SyncFlushPageToMemoryPool(char* src, KeyType PageID){
+int mempool::MemPoolClient::SyncFlushPageToMemoryNode(char* src, KeyType PageID, size_t memnode_id){
     int rc = 0;
 	auto rdma_mg = this->rdma_mg;
 	ibv_mr recv_mr, send_mr;
-    size_t memnode_id = DSMEngine::Hash(&PageID, 0) % memnode_cnt;
     if(has_failed[memnode_id])
         return -1;
 
-	rdma_mg->Allocate_Local_RDMA_Slot(recv_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
 	rc |= rdma_mg->post_receive<DSMEngine::RDMA_Reply>(&recv_mr, memnode_id * 2 + 1);
-	rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 	auto req = &send_pointer->content.flush_page;
 	send_pointer->command = DSMEngine::sync_flush_page_;
@@ -565,11 +1079,91 @@ int mempool::MemPoolClient::SyncFlushPageToMemoryPool(char* src, KeyType PageID)
 	rc |= rdma_mg->poll_completion(wc, 1, qp_type, true, memnode_id * 2 + 1);
 	rc |= rdma_mg->poll_completion(wc, 1, qp_type, false, memnode_id * 2 + 1);
 	
-	rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-	rdma_mg->Deallocate_Local_RDMA_Slot(recv_mr.addr, DSMEngine::Message);
-    if(rc) has_failed[memnode_id] = true;
+	mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
+    if(rc){
+        MemPoolStatCount(MEMPOOL_STAT_FLUSH_FAILURES, 1);
+        has_failed[memnode_id] = true;
+    }
+    else
+        MemPoolStatCount(MEMPOOL_STAT_FLUSHED_PAGES, 1);
     return rc;
 }
+#define MEMPOOL_FLUSH_BATCH SEND_OUTSTANDING_SIZE
+
+int mempool::MemPoolClient::AsyncFlushPagesToMemoryNode(char** srcs, KeyType* PageIDs, int cnt, size_t memnode_id){
+    int rc = 0;
+	auto rdma_mg = this->rdma_mg;
+	ibv_mr send_mrs[MEMPOOL_FLUSH_BATCH];
+	ibv_mr* mrs[MEMPOOL_FLUSH_BATCH];
+    if(has_failed[memnode_id])
+        return -1;
+
+    for(int i = 0; i < cnt; i++){
+	    mempool::AllocateCachedSlot(rdma_mg, send_mrs[i], DSMEngine::Message);
+	    auto send_pointer = (DSMEngine::RDMA_Request*)send_mrs[i].addr;
+	    auto req = &send_pointer->content.flush_page;
+	    send_pointer->command = DSMEngine::async_flush_page_;
+	    req->page_id = PageIDs[i];
+	    memcpy(req->page_data, srcs[i], BLCKSZ);
+        mrs[i] = &send_mrs[i];
+    }
+	rc |= rdma_mg->post_send_batch<DSMEngine::RDMA_Request>(mrs, cnt, memnode_id * 2 + 1);
+
+	ibv_wc wc[3] = {};
+	std::string qp_type("main");
+	rc |= rdma_mg->poll_completion(wc, 1, qp_type, true, memnode_id * 2 + 1);
+
+    for(int i = 0; i < cnt; i++)
+	    mempool::DeallocateCachedSlot(rdma_mg, send_mrs[i], DSMEngine::Message);
+    if(rc){
+        MemPoolStatCount(MEMPOOL_STAT_FLUSH_FAILURES, 1);
+        has_failed[memnode_id] = true;
+    }
+    else
+        MemPoolStatCount(MEMPOOL_STAT_FLUSHED_PAGES, cnt);
+    return rc;
+}
+
+// Ships the pages the backends queued, a batch per memory node at a time.
+// Returns how many there were.
+size_t mempool::MemPoolClient::FlushQueuedPages(){
+    size_t flushed = 0;
+    int cnt;
+    do{
+        uint64 tail = *mpc_flush_ring_tail;
+        MemPoolFlushSlot* slots[MEMPOOL_FLUSH_BATCH];
+        for(cnt = 0; cnt < MEMPOOL_FLUSH_BATCH; cnt++){
+            slots[cnt] = &mpc_flush_ring[(tail + cnt) % MEMPOOL_FLUSH_RING_SIZE];
+            if(__atomic_load_n(&slots[cnt]->seq, __ATOMIC_ACQUIRE) != tail + cnt + 1)
+                break;
+        }
+        if(cnt == 0)
+            break;
+
+        for(size_t memnode_id = 0; memnode_id < memnode_cnt; memnode_id++){
+            char* srcs[MEMPOOL_FLUSH_BATCH];
+            KeyType page_ids[MEMPOOL_FLUSH_BATCH];
+            int node_cnt = 0;
+            for(int i = 0; i < cnt; i++)
+                for(int r = 0; r < PageReplicaCount(); r++)
+                    if(PagePlacement(slots[i]->page_id, r) == memnode_id){
+                        srcs[node_cnt] = slots[i]->page;
+                        page_ids[node_cnt++] = slots[i]->page_id;
+                        break;
+                    }
+            if(node_cnt > 0)
+                AsyncFlushPagesToMemoryNode(srcs, page_ids, node_cnt, memnode_id);
+        }
+
+        for(int i = 0; i < cnt; i++)
+            __atomic_store_n(&slots[i]->seq, tail + i + MEMPOOL_FLUSH_RING_SIZE, __ATOMIC_RELEASE);
+        *mpc_flush_ring_tail = tail + cnt;
+        flushed += cnt;
+    } while(cnt == MEMPOOL_FLUSH_BATCH);
+    return flushed;
+}
+
 void AsyncFlushPageToMemoryPool(char* src, KeyType PageID){
     auto client = mempool::MemPoolClient::Get_Instance();
     if(client == NULL) return;
@@ -580,44 +1174,166 @@ void SyncFlushPageToMemoryPool(char* src, KeyType PageID){
     if(client == NULL) return;
     client->SyncFlushPageToMemoryPool(src, PageID);
 }
-void mempool::MemPoolClient::FlushXLogInfoToMemoryPool(){
+
+#define REWARM_SLOTS_PER_ROUND 256
+
+// Copies the pages a reconnected memory node is a replica of from their
+// other replicas, a few slots a round so that the sync loop isn't held up
+void mempool::MemPoolClient::RewarmMemoryNodes(){
+    char page[BLCKSZ];
+    for(size_t i = 0; i < memnode_cnt; i++){
+        if(!rewarming[i] || has_failed[i])
+            continue;
+        size_t& pa_idx = rewarm_pa_idx[i];
+        size_t& pa_ofs = rewarm_pa_ofs[i];
+        for(int n = 0; n < REWARM_SLOTS_PER_ROUND; n++){
+            if(pa_idx >= pat.page_array_count()){
+                rewarming[i] = false;
+                break;
+            }
+            size_t memnode_id, memnode_pa_idx;
+            pat.get_memnode_id(pa_idx, memnode_id, memnode_pa_idx);
+            if(memnode_id == i || has_failed[memnode_id] || pa_ofs >= pat.page_array_size(pa_idx)){
+                pa_idx++;
+                pa_ofs = 0;
+                continue;
+            }
+            KeyType pid;
+            RDMAReadPageInfo info;
+            pat.slot_at(pa_idx, pa_ofs++, pid, info);
+            if(KeyTypeEqualFunction()(pid, nullKeyType) || pat.exists_on(pid, i))
+                continue;
+            bool is_replica = false;
+            for(int r = 0; r < PageReplicaCount(); r++)
+                is_replica |= PagePlacement(pid, r) == i;
+            if(!is_replica)
+                continue;
+            bool failed;
+            if(ReadPageFromMemoryNode(this, page, pid, &info, failed))
+                AsyncFlushPageToMemoryNode(page, pid, i);
+            if(failed)
+                break;
+        }
+    }
+}
+
+#define REBALANCE_SLOTS_PER_ROUND 256
+// Evictions the sketch must have counted of a page for it to be moved
+#define REBALANCE_MIN_EVICTIONS 2
+
+namespace mempool{
+
+// The count-min estimate of the evictions of a page, see AdmitOnEviction
+static uint8 EvictionEstimate(KeyType PageID){
+    uint8 estimate = 15;
+    for(int i = 0; i < MEMPOOL_SKETCH_DEPTH; i++)
+        estimate = std::min(estimate, __atomic_load_n(
+            &mpc_admission_sketch[i * MEMPOOL_SKETCH_WIDTH + DSMEngine::Hash(&PageID, i) % MEMPOOL_SKETCH_WIDTH],
+            __ATOMIC_RELAXED));
+    return estimate;
+}
+
+} // namespace mempool
+
+// Moves the pages kept on a memory node that is no replica of theirs, after
+// the memory nodes changed, to the ones that are, a few slots a round. A
+// page is read at its placement by its next flush anyway, so only those the
+// sketch counted evictions of are worth the copy; without the sketch all
+// are. The old copy is removed once the new ones are written, and a page
+// the scan misses just ages out of its old node.
+void mempool::MemPoolClient::RebalanceMemoryNodes(){
+    char page[BLCKSZ];
+    if(!rebalancing)
+        return;
+    for(int n = 0; n < REBALANCE_SLOTS_PER_ROUND; n++){
+        if(rebalance_pa_idx >= pat.page_array_count()){
+            rebalancing = false;
+            break;
+        }
+        size_t memnode_id, memnode_pa_idx;
+        pat.get_memnode_id(rebalance_pa_idx, memnode_id, memnode_pa_idx);
+        if(has_failed[memnode_id] || rebalance_pa_ofs >= pat.page_array_size(rebalance_pa_idx)){
+            rebalance_pa_idx++;
+            rebalance_pa_ofs = 0;
+            continue;
+        }
+        KeyType pid;
+        RDMAReadPageInfo info;
+        pat.slot_at(rebalance_pa_idx, rebalance_pa_ofs++, pid, info);
+        if(KeyTypeEqualFunction()(pid, nullKeyType))
+            continue;
+        bool is_replica = false;
+        for(int r = 0; r < PageReplicaCount(); r++)
+            is_replica |= PagePlacement(pid, r) == memnode_id;
+        if(is_replica)
+            continue;
+        if(mempool_admission == MEMPOOL_ADMIT_ADAPTIVE && EvictionEstimate(pid) < REBALANCE_MIN_EVICTIONS)
+            continue;
+        bool failed;
+        if(!ReadPageFromMemoryNode(this, page, pid, &info, failed)){
+            if(failed)
+                break;
+            continue;
+        }
+        int rc = 0;
+        for(int r = 0; r < PageReplicaCount(); r++){
+            size_t target = PagePlacement(pid, r);
+            if(!pat.exists_on(pid, target))
+                rc |= AsyncFlushPageToMemoryNode(page, pid, target);
+        }
+        if(rc == 0)
+            RemovePageOnMemoryNode(pid, memnode_id);
+    }
+}
+
+// Returns false if the xlog info didn't change since the last flush, the
+// replicas would only be woken for nothing
+bool mempool::MemPoolClient::FlushXLogInfoToMemoryPool(){
 	ibv_mr recv_mr, send_mr;
+    XLogInfo xlog_info;
+
+    memset(&xlog_info, 0, sizeof(xlog_info));
+    xlog_info.valid = true;
+	xlog_info.RpcXLogFlushedLsn = RpcXLogFlushedLsn;
+	xlog_info.ProcLastRecPtr = ProcLastRecPtr;
+	xlog_info.XactLastRecEnd = XactLastRecEnd;
+	xlog_info.XactLastCommitEnd = XactLastCommitEnd;
+    GetLogWrtResult(&xlog_info.LogwrtResult_Write, &xlog_info.LogwrtResult_Flush);
+    if(memcmp(&xlog_info, &flushed_xlog_info, sizeof(xlog_info)) == 0)
+        return false;
 
-	rdma_mg->Allocate_Local_RDMA_Slot(recv_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
 	has_failed[0] |= rdma_mg->post_receive<DSMEngine::RDMA_Reply>(&recv_mr, 1);
-    if(has_failed[0]) return;
-	rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+    if(has_failed[0]) return false;
+	mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 	auto req = &send_pointer->content.flush_xlog_info;
 	send_pointer->command = DSMEngine::flush_xlog_info_;
 	send_pointer->buffer = recv_mr.addr;
 	send_pointer->rkey = recv_mr.rkey;
-    req->xlog_info.valid = true;
-	req->xlog_info.RpcXLogFlushedLsn = RpcXLogFlushedLsn;
-	req->xlog_info.ProcLastRecPtr = ProcLastRecPtr;
-	req->xlog_info.XactLastRecEnd = XactLastRecEnd;
-	req->xlog_info.XactLastCommitEnd = XactLastCommitEnd;
-    GetLogWrtResult(&req->xlog_info.LogwrtResult_Write, &req->xlog_info.LogwrtResult_Flush);
+    req->xlog_info = xlog_info;
 	has_failed[0] |= rdma_mg->post_send<DSMEngine::RDMA_Request>(&send_mr, 1);
-    if(has_failed[0]) return;
+    if(has_failed[0]) return false;
 
 	ibv_wc wc[3] = {};
 	std::string qp_type("main");
 	has_failed[0] |= rdma_mg->poll_completion(wc, 1, qp_type, true, 1);
-    if(has_failed[0]) return;
+    if(has_failed[0]) return false;
 	has_failed[0] |= rdma_mg->poll_completion(wc, 1, qp_type, false, 1);
-    if(has_failed[0]) return;
+    if(has_failed[0]) return false;
 
-	rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-	rdma_mg->Deallocate_Local_RDMA_Slot(recv_mr.addr, DSMEngine::Message);
+    flushed_xlog_info = xlog_info;
+	mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
+    return true;
 }
 void mempool::MemPoolClient::FetchXLogInfoFromMemoryPool(){
 	ibv_mr recv_mr, send_mr;
 
-	rdma_mg->Allocate_Local_RDMA_Slot(recv_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
 	has_failed[0] |= rdma_mg->post_receive<DSMEngine::RDMA_Reply>(&recv_mr, 1);
     if(has_failed[0]) return;
-	rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 	send_pointer->command = DSMEngine::fetch_xlog_info_;
 	send_pointer->buffer = recv_mr.addr;
@@ -641,16 +1357,57 @@ void mempool::MemPoolClient::FetchXLogInfoFromMemoryPool(){
         UpdateLogWrtResult(res->xlog_info.LogwrtResult_Write, res->xlog_info.LogwrtResult_Flush);
     }
 
-	rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-	rdma_mg->Deallocate_Local_RDMA_Slot(recv_mr.addr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
+}
+#define DOORBELL_PAT_DELTA 1
+#define DOORBELL_XLOG_INFO 2
+
+// Reads the doorbell of every memory node, looking it up first on a node
+// not asked yet. Returns the DOORBELL_ bits of the updates some node took
+// since the last call. A node whose doorbell can't be read sets them all,
+// the caller then fetches as if it rang.
+int mempool::MemPoolClient::CheckDoorbells(){
+    int rang = 0;
+	ibv_mr local_mr;
+
+	mempool::AllocateCachedSlot(rdma_mg, local_mr, DSMEngine::Message);
+    for(size_t i = 0; i < memnode_cnt; i++){
+        if(has_failed[i])
+            continue;
+        if(!has_doorbell[i]){
+            mr_info_response res;
+            has_doorbell[i] = FetchMRInfo(i, 0, res) && res.doorbell_mr.addr != nullptr;
+            if(!has_doorbell[i]){
+                rang |= DOORBELL_PAT_DELTA | DOORBELL_XLOG_INFO;
+                continue;
+            }
+            doorbell_mr[i] = res.doorbell_mr;
+        }
+        if(rdma_mg->RDMA_Read(&doorbell_mr[i], &local_mr, 0, sizeof(UpdateDoorbell), IBV_SEND_SIGNALED, 1, i * 2 + 1, "main")){
+            has_failed[i] = true;
+            rang |= DOORBELL_PAT_DELTA | DOORBELL_XLOG_INFO;
+            continue;
+        }
+        auto words = (UpdateDoorbell*)local_mr.addr;
+        // Moved back too if the node restarted
+        if(words->pat_delta_ptr != doorbell_seen[i].pat_delta_ptr)
+            rang |= DOORBELL_PAT_DELTA;
+        // The xlog info is kept by the first node only
+        if(i == 0 && words->xlog_info_seq != doorbell_seen[i].xlog_info_seq)
+            rang |= DOORBELL_XLOG_INFO;
+        doorbell_seen[i] = *words;
+    }
+	mempool::DeallocateCachedSlot(rdma_mg, local_mr, DSMEngine::Message);
+    return rang;
 }
 void mempool::MemPoolClient::FlushUpdateVersionMapInfoToMemoryPool(KeyType page_id, XLogRecPtr lsn){
 	ibv_mr recv_mr, send_mr;
 
-	rdma_mg->Allocate_Local_RDMA_Slot(recv_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
 	has_failed[0] |= rdma_mg->post_receive<DSMEngine::RDMA_Reply>(&recv_mr, 1);
     if(has_failed[0]) return;
-	rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 	auto req = &send_pointer->content.flush_update_vm_info;
 	send_pointer->command = DSMEngine::flush_update_vm_info_;
@@ -668,17 +1425,17 @@ void mempool::MemPoolClient::FlushUpdateVersionMapInfoToMemoryPool(KeyType page_
 	has_failed[0] |= rdma_mg->poll_completion(wc, 1, qp_type, false, 1);
     if(has_failed[0]) return;
 
-	rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-	rdma_mg->Deallocate_Local_RDMA_Slot(recv_mr.addr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
 }
 int mempool::MemPoolClient::FetchUpdateVersionMapInfoFromMemoryPool(size_t info_idx){
     int ret = 0;
 	ibv_mr recv_mr, send_mr;
 
-	rdma_mg->Allocate_Local_RDMA_Slot(recv_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
 	has_failed[0] |= rdma_mg->post_receive<DSMEngine::RDMA_Reply>(&recv_mr, 1);
     if(has_failed[0]) return ret;
-	rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 	auto req = &send_pointer->content.fetch_update_vm_info;
 	send_pointer->command = DSMEngine::fetch_update_vm_info_;
@@ -701,18 +1458,18 @@ int mempool::MemPoolClient::FetchUpdateVersionMapInfoFromMemoryPool(size_t info_
         InsertIntoVersionMap(res->info.page_id, res->info.lsn);
     }
 
-	rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-	rdma_mg->Deallocate_Local_RDMA_Slot(recv_mr.addr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
     return ret;
 }
 size_t mempool::MemPoolClient::GetFirstUpdateVersionMapInfoIndex(){
     int ret = 0;
 	ibv_mr recv_mr, send_mr;
 
-	rdma_mg->Allocate_Local_RDMA_Slot(recv_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
 	has_failed[0] |= rdma_mg->post_receive<DSMEngine::RDMA_Reply>(&recv_mr, 1);
     if(has_failed[0]) return ret;
-	rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+	mempool::AllocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
 	auto send_pointer = (DSMEngine::RDMA_Request*)send_mr.addr;
 	send_pointer->command = DSMEngine::get_first_update_vm_info_idx_;
 	send_pointer->buffer = recv_mr.addr;
@@ -730,27 +1487,99 @@ size_t mempool::MemPoolClient::GetFirstUpdateVersionMapInfoIndex(){
 	auto res = &((DSMEngine::RDMA_Reply*)recv_mr.addr)->content.get_first_update_vm_info_idx;
     *update_vm_info_ptr = res->idx;
 
-	rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-	rdma_mg->Deallocate_Local_RDMA_Slot(recv_mr.addr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, send_mr, DSMEngine::Message);
+	mempool::DeallocateCachedSlot(rdma_mg, recv_mr, DSMEngine::Message);
     return ret;
 }
+int mempool_admission = MEMPOOL_ADMIT_ALL;
+int mempool_huge_pages = MEMPOOL_HUGE_PAGES_2MB;
+
+bool MemPoolOffersReadPage(bool relationCached, bool ringStrategy){
+    if(!relationCached)
+        return false;
+    return mempool_admission == MEMPOOL_ADMIT_ALL || !ringStrategy;
+}
+
+namespace mempool{
+
+//! A page evicted for the first time in a while is likely one of a single
+//! pass, so only the evictions of pages the sketch has already counted are
+//! admitted. Only the smallest counters of a page are increased, and all of
+//! them are halved once MEMPOOL_SKETCH_WIDTH evictions were counted, so that
+//! old counts fade. Racing updates may lose a count, which is fine.
+static bool AdmitOnEviction(KeyType PageID){
+    uint8* counters[MEMPOOL_SKETCH_DEPTH];
+    uint8 estimate = 15;
+    for(int i = 0; i < MEMPOOL_SKETCH_DEPTH; i++){
+        counters[i] = &mpc_admission_sketch[i * MEMPOOL_SKETCH_WIDTH + DSMEngine::Hash(&PageID, i) % MEMPOOL_SKETCH_WIDTH];
+        estimate = std::min(estimate, __atomic_load_n(counters[i], __ATOMIC_RELAXED));
+    }
+    if(estimate < 15)
+        for(int i = 0; i < MEMPOOL_SKETCH_DEPTH; i++)
+            if(__atomic_load_n(counters[i], __ATOMIC_RELAXED) == estimate)
+                __atomic_store_n(counters[i], estimate + 1, __ATOMIC_RELAXED);
+    if(__atomic_add_fetch(mpc_admission_sketch_adds, 1, __ATOMIC_RELAXED) % MEMPOOL_SKETCH_WIDTH == 0)
+        for(size_t i = 0; i < MEMPOOL_SKETCH_DEPTH * MEMPOOL_SKETCH_WIDTH; i++)
+            __atomic_store_n(&mpc_admission_sketch[i], __atomic_load_n(&mpc_admission_sketch[i], __ATOMIC_RELAXED) >> 1, __ATOMIC_RELAXED);
+    return estimate > 0;
+}
+
+//! An evicting backend only copies the page into the flush ring, the mempool
+//! synchronizer sends them on. If it doesn't run, or the ring is full, the
+//! backend sends the page itself.
+static bool QueuePageFlush(char* src, KeyType PageID){
+    if(!__atomic_load_n(mpc_flush_daemon_running, __ATOMIC_ACQUIRE))
+        return false;
+    uint64 pos = __atomic_load_n(mpc_flush_ring_head, __ATOMIC_RELAXED);
+    MemPoolFlushSlot* slot;
+    while(true){
+        slot = &mpc_flush_ring[pos % MEMPOOL_FLUSH_RING_SIZE];
+        int64 dif = (int64)__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - (int64)pos;
+        if(dif == 0){
+            if(__atomic_compare_exchange_n(mpc_flush_ring_head, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        }
+        else if(dif < 0)
+            return false;
+        else
+            pos = __atomic_load_n(mpc_flush_ring_head, __ATOMIC_RELAXED);
+    }
+    slot->page_id = PageID;
+    memcpy(slot->page, src, BLCKSZ);
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+    MemPoolStatCount(MEMPOOL_STAT_QUEUED_FLUSHES, 1);
+    return true;
+}
+
+} // namespace mempool
+
 void MemPoolmdwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char *buffer, bool skipFsync){
 #ifndef MEMPOOL_CACHE_POLICY_DISJOINT
-    AsyncFlushPageToMemoryPool(buffer, (KeyType){
+    KeyType page_id = {
         reln->smgr_rnode.node.spcNode,
         reln->smgr_rnode.node.dbNode,
         reln->smgr_rnode.node.relNode,
         forknum,
         blocknum,
-    });
+    };
+    // A page the mempool already holds is always refreshed
+    if(mempool_admission == MEMPOOL_ADMIT_ADAPTIVE && !mempool::AdmitOnEviction(page_id)){
+        RDMAReadPageInfo rdma_read_info;
+        if(!PageExistsInMemPool(page_id, &rdma_read_info))
+            return;
+    }
+    if(!mempool::QueuePageFlush(buffer, page_id))
+        AsyncFlushPageToMemoryPool(buffer, page_id);
 #endif
 }
 
 void InsertIntoVersionMap(KeyType page_id, XLogRecPtr lsn){
-	LWLockAcquire(mempool_client_version_map_lock, LW_EXCLUSIVE);
+	uint32 hashcode = get_hash_value_vm(version_map, &page_id);
+	LWLock* partition_lock = VersionMapPartitionLock(hashcode);
+	LWLockAcquire(partition_lock, LW_EXCLUSIVE);
 	bool found, head;
 	auto result = 
-		hash_search_vm(version_map, &page_id, HASH_ENTER, &found, &head);
+		hash_search_with_hash_value_vm(version_map, &page_id, hashcode, HASH_ENTER, &found, &head);
 	if(head){
 		auto item_head = (ITEMHEAD_VM*)result;
 		for(int i = 0; i < ITEMHEAD_SLOT_CNT_VM; i++)
@@ -768,7 +1597,7 @@ void InsertIntoVersionMap(KeyType page_id, XLogRecPtr lsn){
 			}
 	}
 	// can only insert to the end of list
-	LWLockRelease(mempool_client_version_map_lock);
+	LWLockRelease(partition_lock);
 }
 void ParseXLogBlocksLsn_vm(XLogReaderState *record, int recordBlockId, XLogRecPtr lsn){
 	auto& blk = record->blocks[recordBlockId];
@@ -1809,30 +2638,86 @@ vm_generic_idx_save(XLogReaderState *record, XLogRecPtr lsn)
     return true;
 }
 
+// A node pinned to a past LSN with rpc_as_of_lsn is behind on purpose, so
+// it registers the way the primary does, which isn't held to a lag. If the
+// storage node no longer has the versions it needs, the node shuts down.
+static int MemPoolRegisterComputeNode(uint64_t lsn){
+    bool pinned = RpcAsOfLsn != InvalidXLogRecPtr;
+    int id = RpcRegisterSecondaryNode(IsRpcClient == 2 || pinned, lsn);
+
+    if(id < 0){
+        ereport(LOG,
+                (errmsg("storage node no longer keeps the page versions at %X/%X, shutting down",
+                        (uint32) (lsn >> 32), (uint32) lsn)));
+        kill(PostmasterPid, SIGINT);
+        proc_exit(0);
+    }
+    return id;
+}
+
 void MemPoolSyncMain(){
-    int SyncToStorageHashMapId = RpcRegisterSecondaryNode(IsRpcClient == 2, GetLogWrtResultLsn());
-
-    size_t interval_us[4] = {CheckSyncPAT_Interval_us, SyncXLogInfo_Interval_us, SyncUpdateVersionMapInfo_Interval_us, HashMapComputeNodeHearbeatInterval_us};
-    size_t min_interval_us = interval_us[0];
-    for(int i = 0; i < 4; i++)
-        min_interval_us = std::min(min_interval_us, interval_us[i]);
-	std::chrono::steady_clock::duration interval[3];
-    for(int i = 0; i < 4; i++)
+    int SyncToStorageHashMapId = MemPoolRegisterComputeNode(GetLogWrtResultLsn());
+
+    size_t interval_us[7] = {CheckSyncPAT_Interval_us, SyncXLogInfo_Interval_us, SyncUpdateVersionMapInfo_Interval_us, HashMapComputeNodeHearbeatInterval_us, SyncPATDelta_Interval_us, RewarmMemoryNode_Interval_us, FetchXLogInfo_Interval_us};
+    __atomic_store_n(mpc_flush_daemon_running, true, __ATOMIC_RELEASE);
+	std::chrono::steady_clock::duration interval[7];
+    for(int i = 0; i < 7; i++)
         interval[i] = std::chrono::duration<int, std::micro>(interval_us[i]);
 
-    std::chrono::steady_clock::time_point last[3];
-    for(int i = 0; i < 4; i++)
+    std::chrono::steady_clock::time_point last[7];
+    for(int i = 0; i < 7; i++)
         last[i] = std::chrono::steady_clock::now() - interval[i];
         
+    // The PAT deltas and the xlog info are fetched when the memory nodes'
+    // doorbells say there is something new, or at the long intervals if
+    // they don't. The wait between rounds doubles while nothing happens and
+    // is back to the shortest after a round with work.
+    size_t wait_us = SyncWait_Min_us;
     std::chrono::steady_clock::time_point now;
     while(true){
+        bool busy = false;
+        int rang = 0;
+        // Only there to hold the page versions of a pinned node
+        if(IsRpcClient <= 1)
+            goto skip_mempool_sync;
+        {
+            auto client = mempool::MemPoolClient::Get_Instance();
+            if(client == NULL) goto skip_mempool_sync;
+            rang = client->CheckDoorbells();
+            busy |= rang != 0;
+        }
+
+        now = std::chrono::steady_clock::now();
+        if((rang & DOORBELL_PAT_DELTA) || now - last[4] >= interval[4]){
+            last[4] = now;
+            auto client = mempool::MemPoolClient::Get_Instance();
+            if(client == NULL) goto skip_mempool_sync;
+            client->SyncPageAddressTableDeltas();
+        }
+
+        now = std::chrono::steady_clock::now();
+        if(now - last[5] >= interval[5]){
+            last[5] = now;
+            auto client = mempool::MemPoolClient::Get_Instance();
+            if(client == NULL) goto skip_mempool_sync;
+            if(MEMPOOL_PAGE_REPLICAS > 1)
+                client->RewarmMemoryNodes();
+            client->RebalanceMemoryNodes();
+        }
+
         now = std::chrono::steady_clock::now();
         if(now - last[0] >= interval[0]){
             last[0] = now;
             if(whetherSyncPAT()){
                 auto client = mempool::MemPoolClient::Get_Instance();
                 if(client == NULL) goto skip_mempool_sync;
-                client->GetNewestPageAddressTable();
+                // While the deltas are followed, a requested sync only has
+                // to catch up on them, a full one is a rare safety net
+                if(client->PageAddressTableDeltasValid()
+                    && now - client->last_full_sync_pat < std::chrono::duration<long long, std::micro>(FullSyncPAT_Interval_us))
+                    client->SyncPageAddressTableDeltas();
+                else
+                    client->GetNewestPageAddressTable();
             }
         }
 
@@ -1842,14 +2727,14 @@ void MemPoolSyncMain(){
                 last[1] = now;
                 auto client = mempool::MemPoolClient::Get_Instance();
                 if(client == NULL) goto skip_mempool_sync;
-                client->FlushXLogInfoToMemoryPool();
+                busy |= client->FlushXLogInfoToMemoryPool();
             }
         }
 
         if(IsRpcClient == 3){
             now = std::chrono::steady_clock::now();
-            if(now - last[1] >= interval[1]){
-                last[1] = now;
+            if((rang & DOORBELL_XLOG_INFO) || now - last[6] >= interval[6]){
+                last[6] = now;
                 auto client = mempool::MemPoolClient::Get_Instance();
                 if(client == NULL) goto skip_mempool_sync;
                 client->FetchXLogInfoFromMemoryPool();
@@ -1874,8 +2759,26 @@ skip_mempool_sync:
         now = std::chrono::steady_clock::now();
         if(now - last[3] >= interval[3]){
             last[3] = now;
-            RpcSecondaryNodeUpdatesLsn(SyncToStorageHashMapId, GetLogWrtResultLsn());
+            uint64_t lsn = GetLogWrtResultLsn();
+            // Dropped for lagging too far, versions older than the others
+            // need may already be gone, so start over from where we are
+            if(RpcSecondaryNodeHeartbeat(SyncToStorageHashMapId, lsn) != 0){
+                ereport(LOG,
+                        (errmsg("storage node no longer keeps page versions for compute node %d, registering again at %X/%X",
+                                SyncToStorageHashMapId, (uint32) (lsn >> 32), (uint32) lsn)));
+                SyncToStorageHashMapId = MemPoolRegisterComputeNode(lsn);
+            }
+        }
+
+        // Sleep only once the evicted pages are all shipped
+        if(IsRpcClient > 1){
+            auto client = mempool::MemPoolClient::Get_Instance();
+            if(client != NULL && client->FlushQueuedPages() > 0){
+                wait_us = SyncWait_Min_us;
+                continue;
+            }
         }
-        usleep(min_interval_us);
+        wait_us = busy ? SyncWait_Min_us : std::min(wait_us * 2, (size_t)SyncWait_Max_us);
+        usleep(wait_us);
     }
 }
\ No newline at end of file
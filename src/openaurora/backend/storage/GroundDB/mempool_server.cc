@@ -1,6 +1,7 @@
 #include <unistd.h>
 #include "storage/GroundDB/mempool_server.h"
 #include "storage/GroundDB/rdma_server.hh"
+#include "storage/DSMEngine/HugePageAlloc.h"
 
 void MemPoolMain(int argc, char *argv[], const char *dbname, const char *username) {
     auto mempool = new mempool::MemPoolManager();
@@ -12,10 +13,17 @@ void MemPoolMain(int argc, char *argv[], const char *dbname, const char *usernam
             0,
             1};
     // mempool->init_resources(config.tcp_port, config.dev_name, config.ib_port);
+    // The page arrays are tens of GB read at random, as few NIC translations
+    // as the huge pages available allow
+    DSMEngine::huge_page_size = DSMEngine::HugePage1GB;
     mempool->init_rdma_manager(88, config);
+    mempool->rdma_mg->cq_event_mode = true;
     mempool->init_xlog_info();
-    mempool->init_thread_pool(10);
+    mempool->init_request_workers(10);
     mempool->allocate_page_array(1 << 20);
+    DSMEngine::hugePagePrintStats(stdout);
     mempool->init_vminfo_ring(1 << 15);
+    mempool->init_pat_delta_ring(1 << 16);
+    mempool->init_doorbell();
     mempool->Server_to_Client_Communication();
 }
\ No newline at end of file
@@ -30,6 +30,14 @@ void PageAddressTable::get_memnode_id(size_t pa_idx, size_t& memnode_id, size_t&
 	memnode_pa_idx = mpc_pa_to_memnode[pa_idx << 1 | 1];
 	LWLockRelease(mempool_client_pat_lock);
 }
+bool PageAddressTable::get_pa_idx(size_t memnode_id, size_t memnode_pa_idx, size_t& pa_idx){
+	LWLockAcquire(mempool_client_pat_lock, LW_SHARED);
+	bool found = memnode_pa_idx < mpc_pa_cnt_per_memnode[memnode_id];
+	if(found)
+		pa_idx = mpc_memnode_to_pa[memnode_id * MAX_PAGE_ARRAY_COUNT_PER_MEMNODE + memnode_pa_idx];
+	LWLockRelease(mempool_client_pat_lock);
+	return found;
+}
 void PageAddressTable::init(size_t memnode_cnt){
 	*mpc_pa_cnt = 0;
 	*mpc_pa_size = 0;
@@ -59,7 +67,8 @@ void PageAddressTable::append_page_array(size_t memnode_id, size_t pa_idx, size_
 	}
 	LWLockRelease(mempool_client_pat_lock);
 }
-void PageAddressTable::at(KeyType pid, RDMAReadPageInfo& info){
+void PageAddressTable::at(KeyType pid, RDMAReadPageInfo& info, const int* has_failed){
+	info.pa_ofs = -1;
 	LWLockAcquire(mempool_client_pat_lock, LW_SHARED);
     auto *result = (PATLookupEntry*)
 		hash_search_with_hash_value(mpc_pid_to_idx,
@@ -67,14 +76,42 @@ void PageAddressTable::at(KeyType pid, RDMAReadPageInfo& info){
 									get_hash_value(mpc_pid_to_idx, &pid),
 									HASH_FIND,
 									NULL);
-	if(result != NULL){
-		info.remote_pa_mr = mpc_idx_to_mr[result->pa_idx << 1];
-		info.remote_pida_mr = mpc_idx_to_mr[result->pa_idx << 1 | 1];
-		info.pa_ofs = result->pa_ofs;
-		info.memnode_id = mpc_pa_to_memnode[result->pa_idx << 1];
+	for(int r = 0; result != NULL && r < MEMPOOL_PAGE_REPLICAS; r++){
+		if(result->pa_ofs[r] == (size_t)-1)
+			continue;
+		size_t memnode_id = mpc_pa_to_memnode[result->pa_idx[r] << 1];
+		if(has_failed != nullptr && has_failed[memnode_id])
+			continue;
+		info.remote_pa_mr = mpc_idx_to_mr[result->pa_idx[r] << 1];
+		info.remote_pida_mr = mpc_idx_to_mr[result->pa_idx[r] << 1 | 1];
+		info.pa_ofs = result->pa_ofs[r];
+		info.memnode_id = memnode_id;
+		break;
 	}
-	else
-		info.pa_ofs = -1;
+	LWLockRelease(mempool_client_pat_lock);
+}
+bool PageAddressTable::exists_on(KeyType pid, size_t memnode_id){
+	bool found = false;
+	LWLockAcquire(mempool_client_pat_lock, LW_SHARED);
+    auto *result = (PATLookupEntry*)
+		hash_search_with_hash_value(mpc_pid_to_idx,
+									&pid,
+									get_hash_value(mpc_pid_to_idx, &pid),
+									HASH_FIND,
+									NULL);
+	for(int r = 0; result != NULL && r < MEMPOOL_PAGE_REPLICAS; r++)
+		if(result->pa_ofs[r] != (size_t)-1 && mpc_pa_to_memnode[result->pa_idx[r] << 1] == memnode_id)
+			found = true;
+	LWLockRelease(mempool_client_pat_lock);
+	return found;
+}
+void PageAddressTable::slot_at(size_t pa_idx, size_t pa_ofs, KeyType& pid, RDMAReadPageInfo& info){
+	LWLockAcquire(mempool_client_pat_lock, LW_SHARED);
+	pid = mpc_idx_to_pid[mpc_pa_size[pa_idx] + pa_ofs];
+	info.remote_pa_mr = mpc_idx_to_mr[pa_idx << 1];
+	info.remote_pida_mr = mpc_idx_to_mr[pa_idx << 1 | 1];
+	info.pa_ofs = pa_ofs;
+	info.memnode_id = mpc_pa_to_memnode[pa_idx << 1];
 	LWLockRelease(mempool_client_pat_lock);
 }
 void PageAddressTable::update(size_t pa_idx, size_t pa_ofs, KeyType pid){
@@ -86,20 +123,49 @@ void PageAddressTable::update(size_t pa_idx, size_t pa_ofs, KeyType pid){
 				hash_search_with_hash_value(mpc_pid_to_idx,
 											&page_id,
 											get_hash_value(mpc_pid_to_idx, &page_id),
-											HASH_REMOVE,
+											HASH_FIND,
 											NULL);
 			Assert(result != NULL);
+			// The entry goes once the page is left in no slot
+			bool in_slot = false;
+			for(int r = 0; result != NULL && r < MEMPOOL_PAGE_REPLICAS; r++){
+				if(result->pa_idx[r] == pa_idx && result->pa_ofs[r] == pa_ofs)
+					result->pa_ofs[r] = -1;
+				in_slot |= result->pa_ofs[r] != (size_t)-1;
+			}
+			if(result != NULL && !in_slot)
+				hash_search_with_hash_value(mpc_pid_to_idx,
+											&page_id,
+											get_hash_value(mpc_pid_to_idx, &page_id),
+											HASH_REMOVE,
+											NULL);
 		}
 		page_id = pid;
 		if(!KeyTypeEqualFunction()(pid, nullKeyType)){
+			bool found;
 			auto result = (PATLookupEntry*)
 				hash_search_with_hash_value(mpc_pid_to_idx,
 											&pid,
 											get_hash_value(mpc_pid_to_idx, &pid),
 											HASH_ENTER,
-											NULL);
-			result->pa_idx = pa_idx;
-			result->pa_ofs = pa_ofs;
+											&found);
+			if(!found)
+				for(int r = 0; r < MEMPOOL_PAGE_REPLICAS; r++)
+					result->pa_ofs[r] = -1;
+			// A memory node holds a page once, a slot of it still listed is
+			// stale. Else the page takes a free replica.
+			int r_free = -1, r_same = -1;
+			for(int r = 0; r < MEMPOOL_PAGE_REPLICAS; r++){
+				if(result->pa_ofs[r] == (size_t)-1){
+					if(r_free < 0)
+						r_free = r;
+				}
+				else if(mpc_pa_to_memnode[result->pa_idx[r] << 1] == mpc_pa_to_memnode[pa_idx << 1])
+					r_same = r;
+			}
+			int r = r_same >= 0 ? r_same : (r_free >= 0 ? r_free : 0);
+			result->pa_idx[r] = pa_idx;
+			result->pa_ofs[r] = pa_ofs;
 		}
 	}
 	LWLockRelease(mempool_client_pat_lock);
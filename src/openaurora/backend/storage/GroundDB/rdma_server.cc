@@ -1,11 +1,11 @@
 #include <fstream>
 #include <thread>
+#include <pthread.h>
 #include "c.h"
 #include "storage/checksum_impl.h"
 #include "storage/bufpage.h"
 #include "storage/GroundDB/mempool_server.h"
 #include "storage/GroundDB/rdma_server.hh"
-#include "storage/DSMEngine/ThreadPool.h"
 #include "storage/DSMEngine/cache.h"
 #include "storage/GroundDB/request_buffer.h"
 
@@ -17,6 +17,15 @@ typedef struct request_handler_args{
 	uint16_t compute_node_id;
 } request_handler_args;
 
+#define REQUEST_RING_SIZE 1024
+
+// A slot is free for the enqueue at position pos when seq is pos, and holds
+// a request for the dequeue at pos when seq is pos + 1
+struct MemPoolManager::RequestSlot{
+	std::atomic<uint64_t> seq;
+	request_handler_args args;
+};
+
 void MemPoolManager::init_rdma_manager(int pr_s, DSMEngine::config_t &config){
     pr_size = pr_s;
     rdma_mg = std::make_shared<DSMEngine::RDMA_Manager>(config);
@@ -110,6 +119,9 @@ int MemPoolManager::server_sock_connect(const char* servername, int port) {
     return sockfd;
 }
 
+// How long an idle connection thread sleeps on its completion channel at once
+#define CQ_EVENT_WAIT_TIMEOUT_MS 100
+
 void MemPoolManager::server_communication_thread(std::string client_ip, int socket_fd) {
     printf("A new shared memory thread start\n");
     char temp_receive[3*sizeof(ibv_mr)];
@@ -161,6 +173,12 @@ void MemPoolManager::server_communication_thread(std::string client_ip, int sock
             if(++miss_poll_counter < 256){
                 continue;
             }
+            else if(rdma_mg->cq_event_mode){
+                // Sleep until the client sends, without the latency of the
+                // backoff below
+                if(rdma_mg->wait_poll_completions(wc, 1, client_ip, compute_node_id, CQ_EVENT_WAIT_TIMEOUT_MS) == 0)
+                    continue;
+            }
             else if(miss_poll_counter < 512){
                 usleep(16);
                 continue;
@@ -175,55 +193,17 @@ void MemPoolManager::server_communication_thread(std::string client_ip, int sock
             }
         }
         miss_poll_counter = 0;
-        auto* req_args = new request_handler_args();
-        auto& receive_msg_buf = req_args->request;
-        req_args->request = *(DSMEngine::RDMA_Request*)recv_mr[buffer_position].addr;
-        req_args->client_ip = client_ip;
-        req_args->compute_node_id = compute_node_id;
-
-        // copy the pointer of receive buf to a new place because
-        // it is the same with send buff pointer.
-        rdma_mg->post_receive<DSMEngine::RDMA_Request>(&recv_mr[buffer_position], compute_node_id, client_ip);
-        if (receive_msg_buf.command == DSMEngine::async_flush_page_) {
-            std::function<void(void *args)> handler = [this](void *args){this->async_flush_page_handler(args);};
-            thrd_pool->Schedule(std::move(handler), (void*)req_args);
-        } else if (receive_msg_buf.command == DSMEngine::sync_flush_page_) {
-            std::function<void(void *args)> handler = [this](void *args){this->sync_flush_page_handler(args);};
-            thrd_pool->Schedule(std::move(handler), (void*)req_args);
-        } else if (receive_msg_buf.command == DSMEngine::access_page_) {
-            std::function<void(void *args)> handler = [this](void *args){this->access_page_handler(args);};
-            thrd_pool->Schedule(std::move(handler), (void*)req_args);
-        } else if (receive_msg_buf.command == DSMEngine::async_remove_page_) {
-            std::function<void(void *args)> handler = [this](void *args){this->async_remove_page_handler(args);};
-            thrd_pool->Schedule(std::move(handler), (void*)req_args);
-        } else if (receive_msg_buf.command == DSMEngine::sync_pat_) {
-            std::function<void(void *args)> handler = [this](void *args){this->sync_pat_handler(args);};
-            thrd_pool->Schedule(std::move(handler), (void*)req_args);
-        } else if (receive_msg_buf.command == DSMEngine::mr_info_) {
-            std::function<void(void *args)> handler = [this](void *args){this->mr_info_handler(args);};
-            thrd_pool->Schedule(std::move(handler), (void*)req_args);
-        } else if (receive_msg_buf.command == DSMEngine::flush_xlog_info_) {
-            std::function<void(void *args)> handler = [this](void *args){this->flush_xlog_info_handler(args);};
-            thrd_pool->Schedule(std::move(handler), (void*)req_args);
-        } else if (receive_msg_buf.command == DSMEngine::fetch_xlog_info_) {
-            std::function<void(void *args)> handler = [this](void *args){this->fetch_xlog_info_handler(args);};
-            thrd_pool->Schedule(std::move(handler), (void*)req_args);
-        } else if (receive_msg_buf.command == DSMEngine::flush_update_vm_info_) {
-            std::function<void(void *args)> handler = [this](void *args){this->flush_update_vm_info_handler(args);};
-            thrd_pool->Schedule(std::move(handler), (void*)req_args);
-        } else if (receive_msg_buf.command == DSMEngine::fetch_update_vm_info_) {
-            std::function<void(void *args)> handler = [this](void *args){this->fetch_update_vm_info_handler(args);};
-            thrd_pool->Schedule(std::move(handler), (void*)req_args);
-        } else if (receive_msg_buf.command == DSMEngine::get_first_update_vm_info_idx_) {
-            std::function<void(void *args)> handler = [this](void *args){this->get_first_update_vm_info_idx_handler(args);};
-            thrd_pool->Schedule(std::move(handler), (void*)req_args);
-        } else if (receive_msg_buf.command == DSMEngine::disconnect_) {
+        auto& receive_msg_buf = *(DSMEngine::RDMA_Request*)recv_mr[buffer_position].addr;
+        if (receive_msg_buf.command == DSMEngine::disconnect_)
             break;
-        } else {
+        // The request is copied into the worker's slot, so the buffer can
+        // be posted again right after.
+        if (!dispatch_request(receive_msg_buf, client_ip, compute_node_id)) {
             printf("corrupt message from client (node %d). %d\n", compute_node_id, receive_msg_buf.command);
             assert(false);
             break;
         }
+        rdma_mg->post_receive<DSMEngine::RDMA_Request>(&recv_mr[buffer_position], compute_node_id, client_ip);
         // increase the buffer index
         if (buffer_position == RECEIVE_OUTSTANDING_SIZE - 1 )
             buffer_position = 0;
@@ -249,9 +229,114 @@ void MemPoolManager::server_communication_thread(std::string client_ip, int sock
     // TODO: Build up a exit method for shared memory side, don't forget to destroy all the RDMA resourses.
 }
 
-void MemPoolManager::init_thread_pool(size_t thrd_num){
-    thrd_pool = new DSMEngine::ThreadPool();
-    thrd_pool->SetBackgroundThreads(thrd_num);
+void MemPoolManager::init_request_workers(size_t worker_cnt){
+    for(size_t i = 0; i < worker_cnt; i++){
+        auto worker = new RequestWorker();
+        worker->ring = new RequestSlot[REQUEST_RING_SIZE];
+        for(size_t j = 0; j < REQUEST_RING_SIZE; j++)
+            worker->ring[j].seq.store(j, std::memory_order_relaxed);
+        worker->mask = REQUEST_RING_SIZE - 1;
+        worker->enqueue_pos.store(0, std::memory_order_relaxed);
+        worker->dequeue_pos = 0;
+        workers.emplace_back(worker);
+    }
+    for(size_t i = 0; i < worker_cnt; i++)
+        workers[i]->thread = std::thread(&MemPoolManager::request_worker, this, i);
+}
+
+bool MemPoolManager::dispatch_request(const DSMEngine::RDMA_Request& request, const std::string& client_ip, uint16_t compute_node_id){
+    size_t worker_id;
+    switch(request.command){
+    case DSMEngine::async_flush_page_:
+    case DSMEngine::sync_flush_page_:
+        worker_id = DSMEngine::CacheShardOf(request.content.flush_page.page_id) % workers.size();
+        break;
+    case DSMEngine::access_page_:
+        worker_id = DSMEngine::CacheShardOf(request.content.access_page.page_id) % workers.size();
+        break;
+    case DSMEngine::async_remove_page_:
+        worker_id = DSMEngine::CacheShardOf(request.content.remove_page.page_id) % workers.size();
+        break;
+    case DSMEngine::sync_pat_:
+    case DSMEngine::mr_info_:
+    case DSMEngine::flush_xlog_info_:
+    case DSMEngine::fetch_xlog_info_:
+    case DSMEngine::flush_update_vm_info_:
+    case DSMEngine::fetch_update_vm_info_:
+    case DSMEngine::get_first_update_vm_info_idx_:
+    case DSMEngine::sync_pat_delta_:
+        worker_id = compute_node_id / 2 % workers.size();
+        break;
+    default:
+        return false;
+    }
+
+    auto worker = workers[worker_id].get();
+    uint64_t pos = worker->enqueue_pos.load(std::memory_order_relaxed);
+    RequestSlot* slot;
+    while(true){
+        slot = &worker->ring[pos & worker->mask];
+        int64_t dif = (int64_t)slot->seq.load(std::memory_order_acquire) - (int64_t)pos;
+        if(dif == 0){
+            if(worker->enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else{
+            // The ring is full, wait for the worker
+            if(dif < 0)
+                std::this_thread::yield();
+            pos = worker->enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    slot->args.request = request;
+    slot->args.client_ip = client_ip;
+    slot->args.compute_node_id = compute_node_id;
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void MemPoolManager::request_worker(size_t worker_id){
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(worker_id % std::thread::hardware_concurrency(), &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+
+    auto worker = workers[worker_id].get();
+    int miss_poll_counter = 0;
+    while(!exit_all_threads_){
+        auto slot = &worker->ring[worker->dequeue_pos & worker->mask];
+        if(slot->seq.load(std::memory_order_acquire) != worker->dequeue_pos + 1){
+            if(++miss_poll_counter < 256)
+                continue;
+            else if(miss_poll_counter < 512)
+                usleep(16);
+            else
+                usleep(256);
+            continue;
+        }
+        miss_poll_counter = 0;
+        run_request(&slot->args);
+        slot->seq.store(worker->dequeue_pos + worker->mask + 1, std::memory_order_release);
+        worker->dequeue_pos++;
+    }
+}
+
+void MemPoolManager::run_request(void* args){
+    switch(((request_handler_args*)args)->request.command){
+    case DSMEngine::async_flush_page_: async_flush_page_handler(args); break;
+    case DSMEngine::sync_flush_page_: sync_flush_page_handler(args); break;
+    case DSMEngine::access_page_: access_page_handler(args); break;
+    case DSMEngine::async_remove_page_: async_remove_page_handler(args); break;
+    case DSMEngine::sync_pat_: sync_pat_handler(args); break;
+    case DSMEngine::mr_info_: mr_info_handler(args); break;
+    case DSMEngine::flush_xlog_info_: flush_xlog_info_handler(args); break;
+    case DSMEngine::fetch_xlog_info_: fetch_xlog_info_handler(args); break;
+    case DSMEngine::flush_update_vm_info_: flush_update_vm_info_handler(args); break;
+    case DSMEngine::fetch_update_vm_info_: fetch_update_vm_info_handler(args); break;
+    case DSMEngine::get_first_update_vm_info_idx_: get_first_update_vm_info_idx_handler(args); break;
+    case DSMEngine::sync_pat_delta_: sync_pat_delta_handler(args); break;
+    default: assert(false);
+    }
 }
 
 void MemPoolManager::allocate_page_array(size_t pa_size){
@@ -263,12 +348,12 @@ void MemPoolManager::allocate_page_array(size_t pa_size){
     rdma_mg->Local_Memory_Register(&pa_buf, &pa_mr, BLCKSZ * pa_size, DSMEngine::PageArray);
     rdma_mg->Local_Memory_Register(&pida_buf, &pida_mr, sizeof(KeyType) * pa_size, DSMEngine::PageIDArray);
     
-    freelist.init();
-    lru = DSMEngine::NewLRUCache(pa_size, &freelist);
+    freelist.init(pa_size);
+    lru = DSMEngine::NewLRUCache(pa_size, &freelist, DSMEngine::kClockProCache);
 
     page_arrays.push_back((struct page_array){.pa_mr = pa_mr, .pida_mr = pida_mr, .pa_buf = pa_buf, .pida_buf = pida_buf, .size = pa_size});
     for(size_t i = 0; i < pa_size; i++){
-        auto pagemeta = new struct PageMeta;
+        auto pagemeta = freelist.at(i);
         *pagemeta = (struct PageMeta){
             .page_addr = pa_buf + i * BLCKSZ,
             .page_id_addr = pida_buf + i * sizeof(KeyType)
@@ -292,6 +377,48 @@ void MemPoolManager::init_vminfo_ring(size_t ring_size){
     vminfo_ring.ptr = 0;
 }
 
+void MemPoolManager::init_pat_delta_ring(size_t ring_size){
+    assert(ring_size >= SYNC_PAT_DELTA_SIZE);
+    pat_delta_ring.ring = new PATDelta[ring_size]();
+    pat_delta_ring.size = ring_size;
+    pat_delta_ring.ptr = 0;
+}
+
+void MemPoolManager::init_doorbell(){
+    void* buf = nullptr;
+    if(posix_memalign(&buf, 64, sizeof(UpdateDoorbell)) != 0){
+        fprintf(stderr, "failed to allocate the update doorbell\n");
+        exit(1);
+    }
+    doorbell = (UpdateDoorbell*)buf;
+    memset(doorbell, 0, sizeof(UpdateDoorbell));
+    doorbell->pat_delta_ptr = pat_delta_ring.ptr;
+    doorbell_mr = ibv_reg_mr(rdma_mg->res->pd, doorbell, sizeof(UpdateDoorbell),
+                             IBV_ACCESS_LOCAL_WRITE | IBV_ACCESS_REMOTE_READ);
+    if(doorbell_mr == nullptr){
+        fprintf(stderr, "failed to register the update doorbell\n");
+        exit(1);
+    }
+}
+
+// Called under the entry's lock, so the deltas of a slot are in the order
+// its page id was written
+void MemPoolManager::record_pat_delta(void* page_id_addr, const KeyType& page_id){
+    auto addr = (char*)page_id_addr;
+    for(size_t i = 0; i < page_arrays.size(); i++){
+        auto& page_array = page_arrays[i];
+        if(addr < page_array.pida_buf || addr >= page_array.pida_buf + page_array.size * sizeof(KeyType))
+            continue;
+        std::unique_lock<std::mutex> lk(pat_delta_ring.mtx);
+        auto& delta = pat_delta_ring.ring[(pat_delta_ring.ptr++) % pat_delta_ring.size];
+        delta.pa_idx = i;
+        delta.pa_ofs = (addr - page_array.pida_buf) / sizeof(KeyType);
+        delta.page_id = page_id;
+        __atomic_store_n(&doorbell->pat_delta_ptr, pat_delta_ring.ptr, __ATOMIC_RELEASE);
+        return;
+    }
+}
+
 void MemPoolManager::async_flush_page_handler(void* args){
     auto Args = (request_handler_args*)args;
     auto request = &Args->request;
@@ -303,12 +430,13 @@ void MemPoolManager::async_flush_page_handler(void* args){
     auto e = lru->LookupInsert(req->page_id, nullptr, 1, nullptr);
     auto pagemeta = (PageMeta*)e->value;
     std::unique_lock<std::shared_mutex> lk(e->rw_mtx);
+    bool moved = !KeyTypeEqualFunction()(*(KeyType*)pagemeta->page_id_addr, req->page_id);
     memcpy(pagemeta->page_addr, req->page_data, BLCKSZ);
     memcpy(pagemeta->page_id_addr, &req->page_id, sizeof(KeyType));
+    if(moved)
+        record_pat_delta(pagemeta->page_id_addr, req->page_id);
     lk.unlock();
     lru->Release(e);
-
-    delete Args;
 }
 
 void MemPoolManager::sync_flush_page_handler(void* args){
@@ -325,8 +453,11 @@ void MemPoolManager::sync_flush_page_handler(void* args){
     auto e = lru->LookupInsert(req->page_id, nullptr, 1, nullptr);
     auto pagemeta = (PageMeta*)e->value;
     std::unique_lock<std::shared_mutex> lk(e->rw_mtx);
+    bool moved = !KeyTypeEqualFunction()(*(KeyType*)pagemeta->page_id_addr, req->page_id);
     memcpy(pagemeta->page_addr, req->page_data, BLCKSZ);
     memcpy(pagemeta->page_id_addr, &req->page_id, sizeof(KeyType));
+    if(moved)
+        record_pat_delta(pagemeta->page_id_addr, req->page_id);
     lk.unlock();
     lru->Release(e);
 
@@ -335,7 +466,6 @@ void MemPoolManager::sync_flush_page_handler(void* args){
     ibv_wc wc[3] = {};
     rdma_mg->poll_completion(wc, 1, client_ip, true, target_node_id);
     rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-    delete Args;
 }
 
 void MemPoolManager::access_page_handler(void* args){
@@ -349,8 +479,6 @@ void MemPoolManager::access_page_handler(void* args){
     auto e = lru->Lookup(req->page_id);
     if (e != nullptr)
         lru->Release(e);
-
-    delete Args;
 }
 
 void MemPoolManager::async_remove_page_handler(void* args){
@@ -365,11 +493,10 @@ void MemPoolManager::async_remove_page_handler(void* args){
         auto pagemeta = (PageMeta*)e->value;
         std::unique_lock<std::shared_mutex> lk(e->rw_mtx);
         *(KeyType*)(pagemeta->page_id_addr) = nullKeyType;
+        record_pat_delta(pagemeta->page_id_addr, nullKeyType);
         lk.unlock();
         lru->Release(e);
     }
-
-    delete Args;
 }
 
 void MemPoolManager::sync_pat_handler(void* args){
@@ -393,7 +520,6 @@ void MemPoolManager::sync_pat_handler(void* args){
     ibv_wc wc[3] = {};
     rdma_mg->poll_completion(wc, 1, client_ip, true, target_node_id);
     rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-    delete Args;
 }
 
 void MemPoolManager::mr_info_handler(void* args){
@@ -410,13 +536,13 @@ void MemPoolManager::mr_info_handler(void* args){
 
     memcpy(&res->pa_mr, page_arrays[req->pa_idx].pa_mr, sizeof(ibv_mr));
     memcpy(&res->pida_mr, page_arrays[req->pa_idx].pida_mr, sizeof(ibv_mr));
+    memcpy(&res->doorbell_mr, doorbell_mr, sizeof(ibv_mr));
 
     send_pointer->received = true;
     rdma_mg->post_send<DSMEngine::RDMA_Reply>(&send_mr, target_node_id);
     ibv_wc wc[3] = {};
     rdma_mg->poll_completion(wc, 1, client_ip, true, target_node_id);
     rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-    delete Args;
 }
 
 void MemPoolManager::flush_xlog_info_handler(void* args){
@@ -431,13 +557,13 @@ void MemPoolManager::flush_xlog_info_handler(void* args){
     auto send_pointer = (DSMEngine::RDMA_Reply*)send_mr.addr;
 
     xlog_info = req->xlog_info;
+    __atomic_add_fetch(&doorbell->xlog_info_seq, 1, __ATOMIC_RELEASE);
 
     send_pointer->received = true;
     rdma_mg->post_send<DSMEngine::RDMA_Reply>(&send_mr, target_node_id);
     ibv_wc wc[3] = {};
     rdma_mg->poll_completion(wc, 1, client_ip, true, target_node_id);
     rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-    delete Args;
 }
 
 void MemPoolManager::fetch_xlog_info_handler(void* args){
@@ -458,7 +584,6 @@ void MemPoolManager::fetch_xlog_info_handler(void* args){
     ibv_wc wc[3] = {};
     rdma_mg->poll_completion(wc, 1, client_ip, true, target_node_id);
     rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-    delete Args;
 }
 
 void MemPoolManager::flush_update_vm_info_handler(void* args){
@@ -483,7 +608,6 @@ void MemPoolManager::flush_update_vm_info_handler(void* args){
     ibv_wc wc[3] = {};
     rdma_mg->poll_completion(wc, 1, client_ip, true, target_node_id);
     rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-    delete Args;
 }
 
 void MemPoolManager::fetch_update_vm_info_handler(void* args){
@@ -510,7 +634,6 @@ void MemPoolManager::fetch_update_vm_info_handler(void* args){
     ibv_wc wc[3] = {};
     rdma_mg->poll_completion(wc, 1, client_ip, true, target_node_id);
     rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-    delete Args;
 }
 
 void MemPoolManager::get_first_update_vm_info_idx_handler(void* args){
@@ -535,7 +658,42 @@ void MemPoolManager::get_first_update_vm_info_idx_handler(void* args){
     ibv_wc wc[3] = {};
     rdma_mg->poll_completion(wc, 1, client_ip, true, target_node_id);
     rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
-    delete Args;
+}
+
+void MemPoolManager::sync_pat_delta_handler(void* args){
+    auto Args = (request_handler_args*)args;
+    auto request = &Args->request;
+    auto client_ip = Args->client_ip;
+    auto target_node_id = Args->compute_node_id;
+    auto req = &request->content.sync_pat_delta;
+
+    ibv_mr send_mr;
+    rdma_mg->Allocate_Local_RDMA_Slot(send_mr, DSMEngine::Message);
+    auto send_pointer = (DSMEngine::RDMA_Reply*)send_mr.addr;
+    auto res = &send_pointer->content.sync_pat_delta;
+
+    {
+        std::unique_lock<std::mutex> lk(pat_delta_ring.mtx);
+        res->overrun = false;
+        res->cnt = 0;
+        if(req->ptr == SYNC_PAT_DELTA_HEAD)
+            res->next_ptr = pat_delta_ring.ptr;
+        // Ahead of the ring if this server restarted since the client synced
+        else if(req->ptr > pat_delta_ring.ptr || pat_delta_ring.ptr - req->ptr > pat_delta_ring.size)
+            res->overrun = true;
+        else{
+            res->cnt = std::min(pat_delta_ring.ptr - req->ptr, (size_t)SYNC_PAT_DELTA_SIZE);
+            for(size_t i = 0; i < res->cnt; i++)
+                res->deltas[i] = pat_delta_ring.ring[(req->ptr + i) % pat_delta_ring.size];
+            res->next_ptr = req->ptr + res->cnt;
+        }
+    }
+
+    send_pointer->received = true;
+    rdma_mg->post_send<DSMEngine::RDMA_Reply>(&send_mr, target_node_id);
+    ibv_wc wc[3] = {};
+    rdma_mg->poll_completion(wc, 1, client_ip, true, target_node_id);
+    rdma_mg->Deallocate_Local_RDMA_Slot(send_mr.addr, DSMEngine::Message);
 }
 
 } // namespace mempool
@@ -7,6 +7,30 @@
  * averages (EWMAs) and a periodic controller that adjusts replay budget based
  * on system load, queue depth, and read latency.
  *
+ * The controller is proportional-integral: the weighted error of the smoothed
+ * metrics against their targets sets the aggressiveness directly (KP) and
+ * accumulates into it over time (KI), so a steady overload keeps raising the
+ * budget until the backlog is back at target. The integral stops while the
+ * output is saturated or slew-limited, so it doesn't wind up. Time steps come
+ * from the monotonic clock, and the smoothing factor follows the real step.
+ *
+ * Besides the per-call record budget handed to the redo processes, the same
+ * aggressiveness sets how many background replayer threads run, how long
+ * they sleep between rounds, and how many redo processes the pool may put
+ * in service, so an idle storage node gives its CPU back. Turning ASR off
+ * puts those back where they were.
+ *
+ * Replay is also shared out between tenants (databases, or relations with
+ * asr_tenant_per_relation). Each one's hot misses, reads, WAL ingest and
+ * background replays are counted, and every cycle the background replay
+ * capacity of the last cycle is split between them: part equally, part by
+ * demand (hot misses, or WAL when nobody misses), scaled by the tenant's
+ * asr_tenant_weights entry. A tenant past its share is only held back while
+ * another one with share left is missing, so replay never idles for it.
+ *
+ * Every ASRConfig field is a GUC (asr_*); the storage server reloads them on
+ * SIGHUP.
+ *
  * IDENTIFICATION
  *		src/backend/storage/adaptive_sr.c
  *
@@ -22,15 +46,24 @@
 #include <stdatomic.h>
 
 #include "storage/adaptive_sr.h"
+#include "access/background_hashmap_vacuumer.h"
+#include "access/logindex_slab.h"
+#include "postmaster/interrupt.h"
 #include "utils/guc.h"
 #include "miscadmin.h"
+#include "tcop/wal_redo_pool.h"
+
+extern HashMap pageVersionHashMap;
+extern XLogRecPtr XLogParseUpto;
+extern uint64_t RpcXLogFlushedLsn;
 
 /*
  * Default configuration parameters.
  * These match typical production settings but can be tuned via GUCs.
  */
 static ASRConfig asr_default_config = {
-	.QSTAR = 100.0,			/* Expect ~100 pending records is healthy */
+	.QSTAR = 100.0,			/* Expect ~100 pending versions is healthy */
+	.GSTAR = 16 * 1024 * 1024,	/* 16 MB of unparsed WAL */
 	.RSTAR = 0.05,			/* 5% hot miss rate is acceptable */
 	.WSTAR = 10 * 1024 * 1024,	/* 10 MB/s WAL rate */
 	.BMIN = 10,				/* Min 10 records/tick */
@@ -39,11 +72,51 @@ static ASRConfig asr_default_config = {
 	.WM = 0.6,				/* Hot miss dominates */
 	.WW = 0.1,				/* WAL rate weight */
 	.HYST = 20,				/* Hysteresis threshold */
-	.MAX_STEP = 0.2,		/* Max 20% change per tick */
+	.MAX_STEP = 1.0,		/* Full range in no less than 1s */
+	.KP = 0.5,				/* Proportional gain */
+	.KI = 0.5,				/* Integral gain, per second */
+	.SMOOTHING_MS = 1000,	/* EWMA time constant */
+	.CYCLE_MS = 200,		/* Controller period */
+	.RMIN = 1,				/* Background replayer threads */
+	.RMAX = 8,
+	.SLEEP_MIN_US = 100,	/* Replayer sleep between rounds */
+	.SLEEP_MAX_US = 10000,
+	.PMIN = 1,				/* Redo processes in service */
+	.PMAX = WAL_REDO_POOL_DEFAULT_MAX,
+	.TENANT_DEMAND_SHARE = 0.8,	/* Rest of the capacity split equally */
+	.tenant_per_relation = false,
 	.enable_adaptive_sr = false,	/* Disabled by default */
 	.verbose_metrics = false	/* Quiet by default */
 };
 
+/* GUC variables, see guc.c. ASR_LoadGucConfig copies them into asr_config. */
+bool		asr_enable = false;
+bool		asr_verbose_metrics = false;
+double		asr_queue_target = 100.0;
+double		asr_parse_gap_target = 16 * 1024 * 1024;
+double		asr_miss_rate_target = 0.05;
+double		asr_wal_rate_target = 10 * 1024 * 1024;
+int			asr_min_budget = 10;
+int			asr_max_budget = 2000;
+double		asr_queue_weight = 0.3;
+double		asr_miss_weight = 0.6;
+double		asr_wal_weight = 0.1;
+int			asr_hysteresis = 20;
+double		asr_max_step = 1.0;
+double		asr_kp = 0.5;
+double		asr_ki = 0.5;
+int			asr_smoothing_ms = 1000;
+int			asr_controller_interval = 200;
+int			asr_min_replayers = 1;
+int			asr_max_replayers = 8;
+int			asr_min_replayer_sleep_us = 100;
+int			asr_max_replayer_sleep_us = 10000;
+int			asr_min_redo_processes = 1;
+int			asr_max_redo_processes = WAL_REDO_POOL_DEFAULT_MAX;
+bool		asr_tenant_per_relation = false;
+char	   *asr_tenant_weights = NULL;
+double		asr_tenant_demand_share = 0.8;
+
 /* Current config (mutable, protected by asr_config_lock) */
 static ASRConfig asr_config;
 static pthread_rwlock_t asr_config_lock = PTHREAD_RWLOCK_INITIALIZER;
@@ -56,17 +129,23 @@ typedef struct {
 	/* Raw counters */
 	_Atomic(uint64_t) replay_tasks_count;	/* Number of replay tasks */
 	_Atomic(uint64_t) hot_misses;			/* Number of hot miss events */
+	_Atomic(uint64_t) reads;				/* Number of page reads served */
 	_Atomic(uint64_t) wal_bytes_received;	/* Total WAL bytes received */
 	
 	/* Smoothed values (EWMA) */
 	double		queue_ewma;
+	double		gap_ewma;
 	double		miss_rate_ewma;
+	double		replay_rate_ewma;
 	double		wal_bps_ewma;
 	
 	/* Derived state */
 	int			current_budget;
 	double		current_aggressiveness;
+	double		integral;			/* Integral term of the aggressiveness */
+	struct timespec last_tick;		/* Monotonic time of the last update */
 	uint64_t	last_total_misses;
+	uint64_t	last_total_reads;
 	uint64_t	last_total_tasks;
 	uint64_t	last_wal_bytes;
 	time_t		last_measurement;
@@ -78,19 +157,69 @@ typedef struct {
 static ASRMetricsInternal asr_metrics = {
 	.replay_tasks_count = 0,
 	.hot_misses = 0,
+	.reads = 0,
 	.wal_bytes_received = 0,
 	.queue_ewma = 0.0,
+	.gap_ewma = 0.0,
 	.miss_rate_ewma = 0.0,
+	.replay_rate_ewma = 0.0,
 	.wal_bps_ewma = 0.0,
 	.current_budget = 100,
 	.current_aggressiveness = 0.0,
+	.integral = 0.0,
 	.last_total_misses = 0,
+	.last_total_reads = 0,
 	.last_total_tasks = 0,
 	.last_wal_bytes = 0,
 	.last_measurement = 0,
 	.metrics_lock = PTHREAD_MUTEX_INITIALIZER
 };
 
+/*
+ * Per-tenant accounting. Slots are claimed once under asr_tenant_lock and
+ * never freed, so the hot paths find theirs without locking; tenants past
+ * ASR_MAX_TENANTS share the last slot.
+ */
+#define ASR_TENANT_EMPTY UINT64_MAX
+#define ASR_TENANT_OTHER (ASR_MAX_TENANTS)
+
+typedef struct {
+	_Atomic(uint64_t) key;			/* (db << 32) | rel, or ASR_TENANT_EMPTY */
+	_Atomic(uint64_t) reads;
+	_Atomic(uint64_t) hot_misses;
+	_Atomic(uint64_t) wal_bytes;
+	_Atomic(uint64_t) replayed;		/* Versions replayed in the background */
+	_Atomic(int64_t) tokens;		/* Background replays left this cycle */
+	_Atomic(bool) missing;			/* Had hot misses in the last cycle */
+	
+	/* Controller state, under asr_tenant_lock */
+	uint64_t	last_reads;
+	uint64_t	last_misses;
+	uint64_t	last_wal;
+	uint64_t	last_replayed;
+	double		miss_ps_ewma;
+	double		miss_rate_ewma;
+	double		wal_bps_ewma;
+	double		replayed_ps_ewma;
+	double		weight;
+	double		share;
+} ASRTenant;
+
+static ASRTenant asr_tenants[ASR_MAX_TENANTS + 1];
+static pthread_mutex_t asr_tenant_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t asr_tenant_once = PTHREAD_ONCE_INIT;
+static volatile bool asr_tenant_by_relation = false;
+
+/* Parsed asr_tenant_weights, under asr_config_lock */
+static Oid	asr_weight_db[ASR_MAX_TENANTS];
+static double asr_weight_value[ASR_MAX_TENANTS];
+static int	asr_weight_num = 0;
+
+/* Redo pool limits from before ASR first changed them */
+static bool asr_pool_saved = false;
+static int	asr_pool_saved_min;
+static int	asr_pool_saved_max;
+
 /* Flag to signal controller shutdown */
 static volatile sig_atomic_t asr_shutdown_requested = 0;
 
@@ -99,36 +228,114 @@ static pid_t asr_controller_pid = 0;
 static pthread_t asr_controller_tid = 0;
 
 /*
- * Exponential moving average: new_val = alpha * raw + (1 - alpha) * old_val
- * alpha higher = more responsive to changes, lower = more smoothing.
+ * Exponential moving average: new_val = alpha * raw + (1 - alpha) * old_val,
+ * with alpha = 1 - exp(-dt / tau) so the smoothing spans the same time
+ * whatever the step. tau == 0 disables smoothing.
  */
-#define EWMA_ALPHA 0.3
+static double
+ewma_update(double old_val, double new_val, double alpha)
+{
+	return (alpha * new_val) + ((1.0 - alpha) * old_val);
+}
 
 static double
-ewma_update(double old_val, double new_val)
+ewma_alpha(double dt, int tau_ms)
 {
-	return (EWMA_ALPHA * new_val) + ((1.0 - EWMA_ALPHA) * old_val);
+	if (tau_ms <= 0)
+		return 1.0;
+	return 1.0 - exp(-dt * 1000.0 / tau_ms);
 }
 
 /*
- * Compute normalized pressure from a raw value vs its expected level.
- * Returns [0.0, 1.0] with 0 = below threshold, 1 = at or above 2x threshold.
+ * Compute the normalized error of a raw value vs its expected level.
+ * Returns [-1.0, 1.0]: 0 at the target, 1 at or above twice the target,
+ * -1 when idle.
  */
 static double
 compute_pressure(double raw, double expected)
 {
 	double e;
 	
-	if (raw <= expected)
+	if (expected <= 0.0)
 		return 0.0;
 	
 	e = (raw / expected) - 1.0;
 	if (e > 1.0)
 		e = 1.0;
+	if (e < -1.0)
+		e = -1.0;
 	
 	return e;
 }
 
+static void
+asr_tenant_reset_locked(void)
+{
+	for (int i = 0; i <= ASR_MAX_TENANTS; i++)
+	{
+		ASRTenant  *t = &asr_tenants[i];
+		
+		atomic_store(&t->key, i == ASR_TENANT_OTHER ? 0 : ASR_TENANT_EMPTY);
+		atomic_store(&t->reads, 0);
+		atomic_store(&t->hot_misses, 0);
+		atomic_store(&t->wal_bytes, 0);
+		atomic_store(&t->replayed, 0);
+		atomic_store(&t->tokens, 0);
+		atomic_store(&t->missing, false);
+		t->last_reads = t->last_misses = t->last_wal = t->last_replayed = 0;
+		t->miss_ps_ewma = t->miss_rate_ewma = t->wal_bps_ewma = t->replayed_ps_ewma = 0.0;
+		t->weight = 1.0;
+		t->share = 0.0;
+	}
+}
+
+static void
+asr_tenant_init(void)
+{
+	pthread_mutex_lock(&asr_tenant_lock);
+	asr_tenant_reset_locked();
+	pthread_mutex_unlock(&asr_tenant_lock);
+}
+
+/*
+ * The slot of a tenant, claiming a free one the first time it is seen.
+ */
+static ASRTenant *
+asr_tenant_slot(Oid dbNode, Oid relNode)
+{
+	uint64_t	key;
+	uint32_t	start;
+	
+	pthread_once(&asr_tenant_once, asr_tenant_init);
+	if (!asr_tenant_by_relation)
+		relNode = InvalidOid;
+	key = ((uint64_t) dbNode << 32) | relNode;
+	start = (uint32_t) ((key * 0x9E3779B97F4A7C15ull) >> 32) % ASR_MAX_TENANTS;
+	
+	for (int i = 0; i < ASR_MAX_TENANTS; i++)
+	{
+		ASRTenant  *t = &asr_tenants[(start + i) % ASR_MAX_TENANTS];
+		uint64_t	cur = atomic_load(&t->key);
+		
+		if (cur == key)
+			return t;
+		if (cur != ASR_TENANT_EMPTY)
+			continue;
+		
+		pthread_mutex_lock(&asr_tenant_lock);
+		cur = atomic_load(&t->key);
+		if (cur == ASR_TENANT_EMPTY)
+		{
+			atomic_store(&t->key, key);
+			cur = key;
+		}
+		pthread_mutex_unlock(&asr_tenant_lock);
+		if (cur == key)
+			return t;
+	}
+	return &asr_tenants[ASR_TENANT_OTHER];
+}
+
 /*
  * ASR_RecordReplayTask - Record completion of replay tasks (thread-safe).
  * Called from wal_redo.c after each record is applied.
@@ -147,12 +354,123 @@ ASR_RecordReplayTask(int count)
  * Called from rpcserver.cpp when GetPage@LSN blocks on incomplete replay.
  */
 void
-ASR_RecordHotMiss(void)
+ASR_RecordHotMiss(Oid dbNode, Oid relNode)
 {
 	if (!asr_config.enable_adaptive_sr)
 		return;
 	
 	atomic_fetch_add(&asr_metrics.hot_misses, 1);
+	atomic_fetch_add(&asr_tenant_slot(dbNode, relNode)->hot_misses, 1);
+}
+
+/*
+ * ASR_RecordRead - Record a page read request (thread-safe).
+ * Called from rpcserver.cpp for every GetPage@LSN, the hot miss rate is
+ * taken against these.
+ */
+void
+ASR_RecordRead(Oid dbNode, Oid relNode)
+{
+	if (!asr_config.enable_adaptive_sr)
+		return;
+	
+	atomic_fetch_add(&asr_metrics.reads, 1);
+	atomic_fetch_add(&asr_tenant_slot(dbNode, relNode)->reads, 1);
+}
+
+/*
+ * ASR_RecordTenantWal - Record WAL bytes parsed for a tenant (thread-safe).
+ * Called from ParseXLogBlocksLsn, each block of a record gets its share.
+ */
+void
+ASR_RecordTenantWal(Oid dbNode, Oid relNode, size_t bytes)
+{
+	if (!asr_config.enable_adaptive_sr || bytes == 0)
+		return;
+	
+	atomic_fetch_add(&asr_tenant_slot(dbNode, relNode)->wal_bytes, (uint64_t) bytes);
+}
+
+/*
+ * ASR_TenantMayReplay - May the background replayer replay a page of this
+ * tenant now (thread-safe)? Yes while it has share left this cycle, and
+ * otherwise only if no other tenant with share left is missing.
+ */
+bool
+ASR_TenantMayReplay(Oid dbNode, Oid relNode)
+{
+	ASRTenant  *self;
+	
+	if (!asr_config.enable_adaptive_sr)
+		return true;
+	
+	self = asr_tenant_slot(dbNode, relNode);
+	if (atomic_load(&self->tokens) > 0)
+		return true;
+	
+	for (int i = 0; i <= ASR_MAX_TENANTS; i++)
+	{
+		ASRTenant  *t = &asr_tenants[i];
+		
+		if (t == self || atomic_load(&t->key) == ASR_TENANT_EMPTY)
+			continue;
+		if (atomic_load(&t->missing) && atomic_load(&t->tokens) > 0)
+			return false;
+	}
+	return true;
+}
+
+/*
+ * ASR_RecordTenantReplay - Charge versions replayed in the background to
+ * a tenant (thread-safe).
+ */
+void
+ASR_RecordTenantReplay(Oid dbNode, Oid relNode, int versions)
+{
+	ASRTenant  *t;
+	
+	if (!asr_config.enable_adaptive_sr || versions <= 0)
+		return;
+	
+	t = asr_tenant_slot(dbNode, relNode);
+	atomic_fetch_add(&t->replayed, (uint64_t) versions);
+	atomic_fetch_sub(&t->tokens, (int64_t) versions);
+}
+
+/*
+ * ASR_ReadTenants - Copy the metrics of up to max tenants (thread-safe).
+ * Returns how many were copied.
+ */
+int
+ASR_ReadTenants(ASRTenantMetrics *tenants, int max)
+{
+	int			n = 0;
+	
+	pthread_once(&asr_tenant_once, asr_tenant_init);
+	pthread_mutex_lock(&asr_tenant_lock);
+	for (int i = 0; i <= ASR_MAX_TENANTS && n < max; i++)
+	{
+		ASRTenant  *t = &asr_tenants[i];
+		uint64_t	key = atomic_load(&t->key);
+		
+		if (key == ASR_TENANT_EMPTY)
+			continue;
+		if (i == ASR_TENANT_OTHER && t->last_reads == 0 && t->last_wal == 0)
+			continue;
+		tenants[n].dbNode = (Oid) (key >> 32);
+		tenants[n].relNode = (Oid) key;
+		tenants[n].other = i == ASR_TENANT_OTHER;
+		tenants[n].weight = t->weight;
+		tenants[n].share = t->share;
+		tenants[n].tokens = atomic_load(&t->tokens);
+		tenants[n].hot_miss_per_sec = t->miss_ps_ewma;
+		tenants[n].hot_miss_rate = t->miss_rate_ewma;
+		tenants[n].wal_ingest_bps = t->wal_bps_ewma;
+		tenants[n].replayed_per_sec = t->replayed_ps_ewma;
+		n++;
+	}
+	pthread_mutex_unlock(&asr_tenant_lock);
+	return n;
 }
 
 /*
@@ -183,6 +501,21 @@ ASR_GetCurrentBudget(void)
 	return budget;
 }
 
+/*
+ * ASR_Enabled - Is the controller on (thread-safe).
+ */
+bool
+ASR_Enabled(void)
+{
+	bool enabled;
+	
+	pthread_rwlock_rdlock(&asr_config_lock);
+	enabled = asr_config.enable_adaptive_sr;
+	pthread_rwlock_unlock(&asr_config_lock);
+	
+	return enabled;
+}
+
 /*
  * ASR_SetBudget - Update replay budget (controller only, thread-safe).
  */
@@ -223,7 +556,9 @@ ASR_ReadMetrics(void)
 	pthread_mutex_lock(&asr_metrics.metrics_lock);
 	
 	snapshot.replay_queue_length = asr_metrics.queue_ewma;
+	snapshot.parse_gap_bytes = asr_metrics.gap_ewma;
 	snapshot.hot_miss_rate = asr_metrics.miss_rate_ewma;
+	snapshot.replay_tasks_per_sec = asr_metrics.replay_rate_ewma;
 	snapshot.wal_ingest_bps = asr_metrics.wal_bps_ewma;
 	snapshot.aggressiveness = asr_metrics.current_aggressiveness;
 	snapshot.replay_budget = asr_metrics.current_budget;
@@ -231,21 +566,237 @@ ASR_ReadMetrics(void)
 	
 	pthread_mutex_unlock(&asr_metrics.metrics_lock);
 	
+	snapshot.reads_total = atomic_load(&asr_metrics.reads);
+	snapshot.hot_misses_total = atomic_load(&asr_metrics.hot_misses);
+	snapshot.replay_tasks_total = atomic_load(&asr_metrics.replay_tasks_count);
+	snapshot.wal_bytes_total = atomic_load(&asr_metrics.wal_bytes_received);
+	
+	WalRedoPoolStats pool;
+	
+	BackgroundReplayerGetLimits(&snapshot.replayer_threads, &snapshot.replayer_sleep_us);
+	WalRedoPoolGetStats(&pool);
+	snapshot.redo_processes = pool.maxSize;
+	
 	return snapshot;
 }
 
 /*
- * Update smoothed metrics from raw atomic counters.
+ * Linear map of aggressiveness onto [lo, hi].
+ */
+static int
+scale_by_aggressiveness(double A, int lo, int hi)
+{
+	return lo + (int) floor(A * (hi - lo) + 0.5);
+}
+
+/*
+ * Set the replayer threads, their sleep and the redo pool's limits, where
+ * they changed. Takes the actuators' own locks, so call it without ours.
+ */
+static void
+asr_drive_actuators(int threads, int sleep_us, int pmin, int pmax)
+{
+	int cur_threads, cur_sleep_us;
+	WalRedoPoolStats pool;
+	
+	BackgroundReplayerGetLimits(&cur_threads, &cur_sleep_us);
+	if (cur_threads != threads || cur_sleep_us != sleep_us)
+		BackgroundReplayerSetLimits(threads, sleep_us);
+	
+	WalRedoPoolGetStats(&pool);
+	if (pool.forked == 0)
+		return;					/* Redo processes not forked yet */
+	if (!asr_pool_saved)
+	{
+		asr_pool_saved_min = pool.minSize;
+		asr_pool_saved_max = pool.maxSize;
+		asr_pool_saved = true;
+	}
+	/* Compare after the pool's own clamping, or it never matches */
+	pmax = Min(Max(pmax, 1), pool.forked);
+	pmin = Min(Max(pmin, 1), pmax);
+	if (pool.minSize != pmin || pool.maxSize != pmax)
+		WalRedoPoolSetLimits(pmin, pmax);
+}
+
+/*
+ * Hand the actuators back to their own defaults when ASR is turned off.
+ */
+static void
+asr_release_actuators(void)
+{
+	BackgroundReplayerSetLimits(BACKGROUND_REPLAYER_DEFAULT_THREADS,
+								BACKGROUND_REPLAYER_DEFAULT_SLEEP_US);
+	if (asr_pool_saved)
+	{
+		WalRedoPoolSetLimits(asr_pool_saved_min, asr_pool_saved_max);
+		asr_pool_saved = false;
+	}
+}
+
+static double
+asr_tenant_weight(Oid dbNode)
+{
+	for (int i = 0; i < asr_weight_num; i++)
+		if (asr_weight_db[i] == dbNode)
+			return asr_weight_value[i];
+	return 1.0;
+}
+
+/*
+ * Smooth every tenant's counters and share the background replay capacity
+ * of the last cycle (at least budget) out to them as tokens. Called by the
+ * controller with asr_config_lock held.
+ */
+static void
+asr_update_tenants(double dt, double alpha, int budget, const ASRConfig *cfg)
+{
+	double		total_miss = 0.0;
+	double		total_wal = 0.0;
+	double		total_weighted = 0.0;
+	uint64_t	capacity = 0;
+	int			active = 0;
+	
+	pthread_once(&asr_tenant_once, asr_tenant_init);
+	pthread_mutex_lock(&asr_tenant_lock);
+	
+	for (int i = 0; i <= ASR_MAX_TENANTS; i++)
+	{
+		ASRTenant  *t = &asr_tenants[i];
+		uint64_t	key = atomic_load(&t->key);
+		uint64_t	reads, misses, wal, replayed;
+		uint64_t	reads_delta, misses_delta;
+		
+		if (key == ASR_TENANT_EMPTY)
+			continue;
+		reads = atomic_load(&t->reads);
+		misses = atomic_load(&t->hot_misses);
+		wal = atomic_load(&t->wal_bytes);
+		replayed = atomic_load(&t->replayed);
+		reads_delta = reads - t->last_reads;
+		misses_delta = misses - t->last_misses;
+		
+		t->miss_ps_ewma = ewma_update(t->miss_ps_ewma, misses_delta / dt, alpha);
+		t->miss_rate_ewma = ewma_update(t->miss_rate_ewma,
+										reads_delta > 0 ? Min(1.0, (double) misses_delta / reads_delta) : 0.0,
+										alpha);
+		t->wal_bps_ewma = ewma_update(t->wal_bps_ewma, (wal - t->last_wal) / dt, alpha);
+		t->replayed_ps_ewma = ewma_update(t->replayed_ps_ewma, (replayed - t->last_replayed) / dt, alpha);
+		capacity += replayed - t->last_replayed;
+		atomic_store(&t->missing, misses_delta > 0);
+		
+		t->last_reads = reads;
+		t->last_misses = misses;
+		t->last_wal = wal;
+		t->last_replayed = replayed;
+		t->weight = i == ASR_TENANT_OTHER ? 1.0 : asr_tenant_weight((Oid) (key >> 32));
+		
+		total_miss += t->miss_ps_ewma;
+		total_wal += t->wal_bps_ewma;
+		active++;
+	}
+	
+	if (active == 0)
+	{
+		pthread_mutex_unlock(&asr_tenant_lock);
+		return;
+	}
+	
+	/* Equal part plus demand part, then weighted */
+	for (int pass = 0; pass < 2; pass++)
+	{
+		for (int i = 0; i <= ASR_MAX_TENANTS; i++)
+		{
+			ASRTenant  *t = &asr_tenants[i];
+			double		demand;
+			
+			if (atomic_load(&t->key) == ASR_TENANT_EMPTY)
+				continue;
+			if (pass == 0)
+			{
+				if (total_miss > 0.0)
+					demand = t->miss_ps_ewma / total_miss;
+				else if (total_wal > 0.0)
+					demand = t->wal_bps_ewma / total_wal;
+				else
+					demand = 1.0 / active;
+				t->share = t->weight * ((1.0 - cfg->TENANT_DEMAND_SHARE) / active
+										+ cfg->TENANT_DEMAND_SHARE * demand);
+				total_weighted += t->share;
+			}
+			else
+			{
+				t->share = total_weighted > 0.0 ? t->share / total_weighted : 0.0;
+				atomic_store(&t->tokens,
+							 (int64_t) ceil(t->share * Max(capacity, (uint64_t) budget)));
+			}
+		}
+	}
+	
+	pthread_mutex_unlock(&asr_tenant_lock);
+}
+
+/*
+ * Parse asr_tenant_weights ("oid:weight, ...") into the weight table.
+ * Called with asr_config_lock held for writing.
+ */
+static void
+asr_parse_tenant_weights(const char *value)
+{
+	char	   *copy, *item, *saveptr;
+	
+	asr_weight_num = 0;
+	if (value == NULL || value[0] == '\0')
+		return;
+	
+	copy = strdup(value);
+	if (copy == NULL)
+		return;
+	for (item = strtok_r(copy, ", ", &saveptr); item != NULL; item = strtok_r(NULL, ", ", &saveptr))
+	{
+		char	   *end;
+		unsigned long db = strtoul(item, &end, 10);
+		double		weight;
+		
+		if (end == item || *end != ':')
+		{
+			ereport(WARNING,
+					(errmsg("[ASR] ignoring asr_tenant_weights entry \"%s\"", item)));
+			continue;
+		}
+		weight = strtod(end + 1, &end);
+		if (*end != '\0' || weight <= 0.0)
+		{
+			ereport(WARNING,
+					(errmsg("[ASR] ignoring asr_tenant_weights entry \"%s\"", item)));
+			continue;
+		}
+		if (asr_weight_num == ASR_MAX_TENANTS)
+		{
+			ereport(WARNING,
+					(errmsg("[ASR] asr_tenant_weights has more than %d entries", ASR_MAX_TENANTS)));
+			break;
+		}
+		asr_weight_db[asr_weight_num] = (Oid) db;
+		asr_weight_value[asr_weight_num] = weight;
+		asr_weight_num++;
+	}
+	free(copy);
+}
+
+/*
+ * Update smoothed metrics from raw atomic counters, as of tick.
  * This is called periodically by the controller.
  */
 static void
-asr_update_smoothed_metrics(void)
+asr_update_smoothed_metrics(const struct timespec *tick)
 {
-	time_t now;
-	double dt, new_queue, new_miss_rate, new_wal_bps;
-	uint64_t total_misses, total_tasks, total_wal_bytes;
-	double eq, em, ew, aggressiveness;
+	double dt, alpha, new_queue, new_gap, new_miss_rate, new_wal_bps;
+	uint64_t total_misses, total_reads, total_tasks, total_wal_bytes;
+	XLogRecPtr flushed, parsed;
+	double eq, eg, em, ew, error, integral, aggressiveness;
 	int new_budget, last_budget;
+	int threads, sleep_us, pmin, pmax;
 	int delta;
 	const ASRConfig *cfg;
 	
@@ -253,78 +804,117 @@ asr_update_smoothed_metrics(void)
 	pthread_rwlock_rdlock(&asr_config_lock);
 	cfg = &asr_config;
 	
-	now = time(NULL);
 	pthread_mutex_lock(&asr_metrics.metrics_lock);
 	
 	/* Time since last measurement */
 	if (asr_metrics.last_measurement == 0)
-		dt = 1.0;
+		dt = cfg->CYCLE_MS / 1000.0;
 	else
-		dt = (double)(now - asr_metrics.last_measurement);
-	if (dt < 0.1) dt = 0.1;	/* Minimum granularity */
+		dt = (tick->tv_sec - asr_metrics.last_tick.tv_sec)
+			+ (tick->tv_nsec - asr_metrics.last_tick.tv_nsec) / 1e9;
+	if (dt < 0.001) dt = 0.001;	/* Minimum granularity */
+	alpha = ewma_alpha(dt, cfg->SMOOTHING_MS);
 	
 	/* Read atomic counters */
 	total_tasks = atomic_load(&asr_metrics.replay_tasks_count);
 	total_misses = atomic_load(&asr_metrics.hot_misses);
+	total_reads = atomic_load(&asr_metrics.reads);
 	total_wal_bytes = atomic_load(&asr_metrics.wal_bytes_received);
 	
 	/*
-	 * Estimate replay queue length from rate of tasks being applied.
-	 * This is a rough approximation; ideally we'd read from actual queue.
+	 * Replay backlog: page versions the logindex holds above their
+	 * replayed LSN. This is what is left to do, unlike the task rate,
+	 * which only says how fast it is being done.
 	 */
+	new_queue = pageVersionHashMap != NULL
+		? (double) HashMapUnreplayedEntries(pageVersionHashMap) : 0.0;
+	asr_metrics.queue_ewma = ewma_update(asr_metrics.queue_ewma, new_queue, alpha);
+	
+	/*
+	 * Parse backlog: WAL flushed to us that the logindex doesn't cover
+	 * yet. Reads past XLogParseUpto wait in WaitParse for it.
+	 */
+	flushed = RpcXLogFlushedLsn;
+	parsed = XLogParseUpto;
+	new_gap = (parsed != InvalidXLogRecPtr && flushed > parsed)
+		? (double) (flushed - parsed) : 0.0;
+	asr_metrics.gap_ewma = ewma_update(asr_metrics.gap_ewma, new_gap, alpha);
+	
+	/* Replay throughput, reported only */
 	uint64_t tasks_delta = total_tasks - asr_metrics.last_total_tasks;
-	new_queue = (dt > 0) ? (double)tasks_delta / dt : 0.0;
-	asr_metrics.queue_ewma = ewma_update(asr_metrics.queue_ewma, new_queue);
+	asr_metrics.replay_rate_ewma = ewma_update(asr_metrics.replay_rate_ewma,
+											   (double) tasks_delta / dt, alpha);
 	asr_metrics.last_total_tasks = total_tasks;
 	
 	/*
-	 * Hot miss rate: fraction of read events that were hot misses.
-	 * Approximation: misses / (misses + some baseline read count).
-	 * For now, just track smoothed miss count as a proxy.
+	 * Hot miss rate: fraction of reads that had to replay.
 	 */
 	uint64_t misses_delta = total_misses - asr_metrics.last_total_misses;
-	if (total_tasks > asr_metrics.last_total_tasks)
+	uint64_t reads_delta = total_reads - asr_metrics.last_total_reads;
+	if (reads_delta > 0)
 	{
-		new_miss_rate = (double)misses_delta / (double)(tasks_delta + 1);
+		new_miss_rate = (double)misses_delta / (double)reads_delta;
+		if (new_miss_rate > 1.0)
+			new_miss_rate = 1.0;
 	}
 	else
 	{
 		new_miss_rate = 0.0;
 	}
-	asr_metrics.miss_rate_ewma = ewma_update(asr_metrics.miss_rate_ewma, new_miss_rate);
+	asr_metrics.miss_rate_ewma = ewma_update(asr_metrics.miss_rate_ewma, new_miss_rate, alpha);
 	asr_metrics.last_total_misses = total_misses;
+	asr_metrics.last_total_reads = total_reads;
 	
 	/*
 	 * WAL ingest rate in bytes per second.
 	 */
 	uint64_t wal_delta = total_wal_bytes - asr_metrics.last_wal_bytes;
-	new_wal_bps = (dt > 0) ? (double)wal_delta / dt : 0.0;
-	asr_metrics.wal_bps_ewma = ewma_update(asr_metrics.wal_bps_ewma, new_wal_bps);
+	new_wal_bps = (double)wal_delta / dt;
+	asr_metrics.wal_bps_ewma = ewma_update(asr_metrics.wal_bps_ewma, new_wal_bps, alpha);
 	asr_metrics.last_wal_bytes = total_wal_bytes;
 	
 	/*
-	 * Compute pressures in [0.0, 1.0].
+	 * Compute errors in [-1.0, 1.0]. Either backlog counts as queue
+	 * error.
 	 */
 	eq = compute_pressure(asr_metrics.queue_ewma, cfg->QSTAR);
+	eg = compute_pressure(asr_metrics.gap_ewma, cfg->GSTAR);
+	if (eg > eq)
+		eq = eg;
 	em = compute_pressure(asr_metrics.miss_rate_ewma, cfg->RSTAR);
 	ew = compute_pressure(asr_metrics.wal_bps_ewma, cfg->WSTAR);
 	
 	/*
-	 * Weighted aggressiveness: hot miss rate dominates.
+	 * Weighted error: hot miss rate dominates.
+	 */
+	error = cfg->WQ * eq + cfg->WM * em + cfg->WW * ew;
+	
+	/*
+	 * PI step. The integral is kept in [0, 1] and only taken when the
+	 * output can follow it (anti-windup).
 	 */
-	aggressiveness = cfg->WQ * eq + cfg->WM * em + cfg->WW * ew;
+	integral = asr_metrics.integral + cfg->KI * error * dt;
+	if (integral > 1.0) integral = 1.0;
+	if (integral < 0.0) integral = 0.0;
+	aggressiveness = cfg->KP * error + integral;
+	
+	bool saturated = (aggressiveness > 1.0 && error > 0) || (aggressiveness < 0.0 && error < 0);
 	if (aggressiveness > 1.0) aggressiveness = 1.0;
 	if (aggressiveness < 0.0) aggressiveness = 0.0;
 	
-	/* Apply smoothing/step limits to aggressiveness */
+	/* Limit the slew rate */
+	double max_delta = cfg->MAX_STEP * dt;
 	double delta_a = aggressiveness - asr_metrics.current_aggressiveness;
-	if (fabs(delta_a) > cfg->MAX_STEP)
+	if (fabs(delta_a) > max_delta)
 	{
 		if (delta_a > 0)
-			aggressiveness = asr_metrics.current_aggressiveness + cfg->MAX_STEP;
+			aggressiveness = asr_metrics.current_aggressiveness + max_delta;
 		else
-			aggressiveness = asr_metrics.current_aggressiveness - cfg->MAX_STEP;
+			aggressiveness = asr_metrics.current_aggressiveness - max_delta;
+		saturated = true;
 	}
+	if (!saturated)
+		asr_metrics.integral = integral;
 	asr_metrics.current_aggressiveness = aggressiveness;
 	
 	/*
@@ -333,14 +923,23 @@ asr_update_smoothed_metrics(void)
 	new_budget = budget_from_aggressiveness(aggressiveness, cfg);
 	last_budget = asr_metrics.current_budget;
 	
-	/* Apply hysteresis */
+	/* Apply hysteresis, but always settle on the range ends */
 	delta = new_budget - last_budget;
 	if (delta < 0) delta = -delta;
-	if (delta < cfg->HYST)
+	if (delta < cfg->HYST && new_budget != cfg->BMIN && new_budget != cfg->BMAX)
 		new_budget = last_budget;
 	
 	asr_metrics.current_budget = new_budget;
-	asr_metrics.last_measurement = now;
+	asr_metrics.last_measurement = time(NULL);
+	asr_metrics.last_tick = *tick;
+	
+	asr_update_tenants(dt, alpha, new_budget, cfg);
+	
+	/* The other actuators, applied once the locks are dropped */
+	threads = scale_by_aggressiveness(aggressiveness, cfg->RMIN, cfg->RMAX);
+	sleep_us = scale_by_aggressiveness(aggressiveness, cfg->SLEEP_MAX_US, cfg->SLEEP_MIN_US);
+	pmin = cfg->PMIN;
+	pmax = scale_by_aggressiveness(aggressiveness, cfg->PMIN, cfg->PMAX);
 	
 	/*
 	 * Verbose logging (if enabled).
@@ -348,18 +947,44 @@ asr_update_smoothed_metrics(void)
 	if (cfg->verbose_metrics)
 	{
 		ereport(LOG,
-				(errmsg("[ASR] metrics: queue=%.2f miss_rate=%.4f wal_bps=%.0f "
-						"pressures(q=%.2f m=%.2f w=%.2f) agg=%.2f budget=%d",
+				(errmsg("[ASR] metrics: queue=%.2f parse_gap=%.0f miss_rate=%.4f "
+						"replay_rate=%.1f wal_bps=%.0f "
+						"errors(q=%.2f m=%.2f w=%.2f) integral=%.3f agg=%.2f budget=%d "
+						"replayers=%d sleep=%dus redo_max=%d",
 						asr_metrics.queue_ewma,
+						asr_metrics.gap_ewma,
 						asr_metrics.miss_rate_ewma,
+						asr_metrics.replay_rate_ewma,
 						asr_metrics.wal_bps_ewma,
 						eq, em, ew,
+						asr_metrics.integral,
 						aggressiveness,
-						asr_metrics.current_budget)));
+						asr_metrics.current_budget,
+						threads, sleep_us, pmax)));
+
+		LogindexSlabStats slab;
+
+		LogindexSlabGetStats(&slab);
+		ereport(LOG,
+				(errmsg("[ASR] logindex memory: heads=%lu/%lu eles=%lu/%lu reserved=%lu bytes",
+						(unsigned long) slab.headInUse,
+						(unsigned long) slab.headReserved,
+						(unsigned long) slab.eleInUse,
+						(unsigned long) slab.eleReserved,
+						(unsigned long) slab.bytesReserved)));
+		if (pageVersionHashMap != NULL && pageVersionHashMap->memoryLimit > 0)
+			ereport(LOG,
+					(errmsg("[ASR] logindex spill: resident=%lu limit=%lu spilled=%lu faulted=%lu",
+							(unsigned long) HashMapResidentBytes(),
+							(unsigned long) pageVersionHashMap->memoryLimit,
+							(unsigned long) pageVersionHashMap->spilledChains,
+							(unsigned long) pageVersionHashMap->faultedChains)));
 	}
 	
 	pthread_mutex_unlock(&asr_metrics.metrics_lock);
 	pthread_rwlock_unlock(&asr_config_lock);
+	
+	asr_drive_actuators(threads, sleep_us, pmin, pmax);
 }
 
 /*
@@ -370,16 +995,35 @@ asr_update_smoothed_metrics(void)
 static void *
 asr_controller_main(void *arg)
 {
-	/* Controller cycle: 200ms */
-	const long CONTROLLER_CYCLE_MS = 200;
-	
 	while (!asr_shutdown_requested)
 	{
+		int			cycle_ms;
+		bool		enabled;
+		
+		/* The storage server has no other loop that reloads the config */
+		if (ConfigReloadPending)
+		{
+			ConfigReloadPending = false;
+			ProcessConfigFile(PGC_SIGHUP);
+			ASR_LoadGucConfig();
+		}
+		
+		pthread_rwlock_rdlock(&asr_config_lock);
+		cycle_ms = asr_config.CYCLE_MS;
+		enabled = asr_config.enable_adaptive_sr;
+		pthread_rwlock_unlock(&asr_config_lock);
+		
 		/* Update smoothed metrics and compute new budget */
-		asr_update_smoothed_metrics();
+		if (enabled)
+		{
+			struct timespec now;
+			
+			clock_gettime(CLOCK_MONOTONIC, &now);
+			asr_update_smoothed_metrics(&now);
+		}
 		
 		/* Sleep for one cycle */
-		usleep(CONTROLLER_CYCLE_MS * 1000);
+		usleep(cycle_ms * 1000L);
 	}
 	
 	return NULL;
@@ -395,6 +1039,7 @@ ASR_Init(void)
 	pthread_rwlock_wrlock(&asr_config_lock);
 	memcpy(&asr_config, &asr_default_config, sizeof(ASRConfig));
 	pthread_rwlock_unlock(&asr_config_lock);
+	ASR_LoadGucConfig();
 	
 	/* Initialize current budget */
 	asr_metrics.current_budget = asr_config.BMIN;
@@ -404,6 +1049,18 @@ ASR_Init(void)
 					asr_config.enable_adaptive_sr ? "enabled" : "disabled")));
 }
 
+/*
+ * ASR_Tick - Run one controller cycle as of now, on the monotonic clock.
+ * The controller thread runs its cycles on the real clock; the simulator
+ * in src/test/asr drives them on a simulated one instead.
+ */
+void
+ASR_Tick(const struct timespec *now)
+{
+	if (ASR_Enabled())
+		asr_update_smoothed_metrics(now);
+}
+
 /*
  * ASR_StartController - Start the controller thread.
  * Called from storage_server.c main.
@@ -413,13 +1070,10 @@ ASR_StartController(void)
 {
 	int ret;
 	
-	if (!asr_config.enable_adaptive_sr)
-	{
-		ereport(LOG,
-				(errmsg("[ASR] not starting controller (disabled via config)")));
-		return;
-	}
-	
+	/*
+	 * Started even when disabled, it is also what picks up a reload that
+	 * turns asr_enable on.
+	 */
 	asr_shutdown_requested = 0;
 	ret = pthread_create(&asr_controller_tid, NULL, asr_controller_main, NULL);
 	
@@ -432,7 +1086,8 @@ ASR_StartController(void)
 	}
 	
 	ereport(LOG,
-			(errmsg("[ASR] controller thread started")));
+			(errmsg("[ASR] controller thread started, adaptive_sr=%s",
+					asr_config.enable_adaptive_sr ? "enabled" : "disabled")));
 }
 
 /*
@@ -493,3 +1148,75 @@ ASR_UpdateConfig(const ASRConfig *new_config)
 			(errmsg("[ASR] config updated, adaptive_sr=%s",
 					asr_config.enable_adaptive_sr ? "enabled" : "disabled")));
 }
+
+/*
+ * ASR_LoadGucConfig - Copy the asr_* GUCs into the controller config.
+ * Called at startup and after every config reload.
+ */
+void
+ASR_LoadGucConfig(void)
+{
+	ASRConfig	cfg;
+	bool		was_enabled = ASR_Enabled();
+	
+	cfg.QSTAR = asr_queue_target;
+	cfg.GSTAR = asr_parse_gap_target;
+	cfg.RSTAR = asr_miss_rate_target;
+	cfg.WSTAR = asr_wal_rate_target;
+	cfg.BMIN = asr_min_budget;
+	cfg.BMAX = asr_max_budget;
+	cfg.WQ = asr_queue_weight;
+	cfg.WM = asr_miss_weight;
+	cfg.WW = asr_wal_weight;
+	cfg.HYST = asr_hysteresis;
+	cfg.MAX_STEP = asr_max_step;
+	cfg.KP = asr_kp;
+	cfg.KI = asr_ki;
+	cfg.SMOOTHING_MS = asr_smoothing_ms;
+	cfg.CYCLE_MS = asr_controller_interval;
+	cfg.RMIN = asr_min_replayers;
+	cfg.RMAX = Max(asr_max_replayers, asr_min_replayers);
+	cfg.SLEEP_MIN_US = asr_min_replayer_sleep_us;
+	cfg.SLEEP_MAX_US = Max(asr_max_replayer_sleep_us, asr_min_replayer_sleep_us);
+	cfg.PMIN = asr_min_redo_processes;
+	cfg.PMAX = Max(asr_max_redo_processes, asr_min_redo_processes);
+	cfg.TENANT_DEMAND_SHARE = asr_tenant_demand_share;
+	cfg.tenant_per_relation = asr_tenant_per_relation;
+	cfg.enable_adaptive_sr = asr_enable;
+	cfg.verbose_metrics = asr_verbose_metrics;
+	
+	if (cfg.BMAX < cfg.BMIN)
+	{
+		ereport(WARNING,
+				(errmsg("[ASR] asr_max_budget %d is below asr_min_budget %d, using %d",
+						cfg.BMAX, cfg.BMIN, cfg.BMIN)));
+		cfg.BMAX = cfg.BMIN;
+	}
+	
+	ASR_UpdateConfig(&cfg);
+	
+	pthread_rwlock_wrlock(&asr_config_lock);
+	asr_parse_tenant_weights(asr_tenant_weights);
+	pthread_rwlock_unlock(&asr_config_lock);
+	
+	/* Tenants are keyed differently now, start counting afresh */
+	if (cfg.tenant_per_relation != asr_tenant_by_relation)
+	{
+		pthread_once(&asr_tenant_once, asr_tenant_init);
+		pthread_mutex_lock(&asr_tenant_lock);
+		asr_tenant_by_relation = cfg.tenant_per_relation;
+		asr_tenant_reset_locked();
+		pthread_mutex_unlock(&asr_tenant_lock);
+	}
+	
+	/* Keep the current budget inside the new range */
+	pthread_mutex_lock(&asr_metrics.metrics_lock);
+	if (asr_metrics.current_budget < cfg.BMIN)
+		asr_metrics.current_budget = cfg.BMIN;
+	if (asr_metrics.current_budget > cfg.BMAX)
+		asr_metrics.current_budget = cfg.BMAX;
+	pthread_mutex_unlock(&asr_metrics.metrics_lock);
+	
+	if (was_enabled && !cfg.enable_adaptive_sr)
+		asr_release_actuators();
+}
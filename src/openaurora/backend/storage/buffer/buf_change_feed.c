@@ -0,0 +1,78 @@
+#include "postgres.h"
+
+#include "access/page_change_feed.h"
+#include "storage/buf_change_feed.h"
+#include "storage/bufmgr.h"
+#include "storage/rpcclient.h"
+#include "utils/memutils.h"
+
+extern int IsRpcClient;
+
+// GUC
+bool page_change_feed = false;
+
+// How long the storage node may hold a request while it parses on
+#define BUF_CHANGE_FEED_WAIT_MS (10)
+
+static char *reply = NULL;
+static uint64 nextSeq = 0;
+static XLogRecPtr since = InvalidXLogRecPtr;
+static XLogRecPtr upto = InvalidXLogRecPtr;
+static bool failed = false;
+
+static bool BufChangeFeedFetch(bool wait) {
+    PageChangeFeedHeader header;
+    int len;
+
+    if (reply == NULL)
+        reply = MemoryContextAlloc(TopMemoryContext, PageChangeFeedReplySize(PAGE_CHANGE_FEED_MAX_BATCH));
+    len = RpcFetchPageChanges(reply, PAGE_CHANGE_FEED_MAX_BATCH, wait ? BUF_CHANGE_FEED_WAIT_MS : 0, nextSeq);
+    if (len < (int) sizeof(header)) {
+        ereport(LOG,
+                (errmsg("page change feed of the storage node is unavailable, redoing page records")));
+        failed = true;
+        return false;
+    }
+    memcpy(&header, reply, sizeof(header));
+
+    if (header.flags & PAGE_CHANGE_FEED_OVERFLOW) {
+        ereport(LOG,
+                (errmsg("page change feed lost its place, refreshing all buffers")));
+        RefreshAllBuffersForChange(header.upto);
+    }
+    for (uint32 i = 0; i < header.count; i++) {
+        PageChangeFeedEntry entry;
+        RelFileNode rnode;
+
+        memcpy(&entry, reply + sizeof(header) + sizeof(entry) * i, sizeof(entry));
+        rnode.spcNode = entry.spcNode;
+        rnode.dbNode = entry.dbNode;
+        rnode.relNode = entry.relNode;
+        RefreshBufferForChange(rnode, (ForkNumber) entry.forkNum, entry.blockNum, entry.lsn);
+    }
+
+    nextSeq = header.nextSeq;
+    since = header.since;
+    upto = header.upto;
+    return true;
+}
+
+bool BufChangeFeedCatchUp(XLogRecPtr lsn) {
+    bool wait = false;
+
+    if (!page_change_feed || !IsRpcClient || failed)
+        return false;
+
+    while (since == InvalidXLogRecPtr || (since <= lsn && upto <= lsn)) {
+        uint64 before = nextSeq;
+
+        if (!BufChangeFeedFetch(wait))
+            return false;
+        // Still coming up, the record is redone
+        if (since == InvalidXLogRecPtr)
+            return false;
+        // Caught up with the feed, let the storage node parse on
+        wait = nextSeq == before;
+    }
+    return since <= lsn;
+}
@@ -15,6 +15,7 @@
 #include "postgres.h"
 
 #include "storage/buf_internals.h"
+#include "storage/buf_numa.h"
 #include "storage/bufmgr.h"
 
 BufferDescPadded *BufferDescriptors;
@@ -108,6 +109,18 @@ InitBufferPool(void)
 	{
 		int			i;
 
+		/*
+		 * Split the buffers over the NUMA nodes, before the headers are first
+		 * touched.
+		 */
+		if (BufNumaNodeCount() > 1 && NBuffers >= BufNumaNodeCount())
+		{
+			BufNumaPlace(BufferDescriptors, NBuffers * sizeof(BufferDescPadded),
+						 BufNumaNodeCount());
+			BufNumaPlace(BufferBlocks, NBuffers * (Size) BLCKSZ,
+						 BufNumaNodeCount());
+		}
+
 		/*
 		 * Initialize all the buffer headers.
 		 */
@@ -119,6 +132,8 @@ InitBufferPool(void)
 
 			pg_atomic_init_u32(&buf->state, 0);
 			buf->wait_backend_pid = 0;
+			buf->refetch_cost = 0;
+			buf->sweep_credit = 0;
 
 			buf->buf_id = i;
 
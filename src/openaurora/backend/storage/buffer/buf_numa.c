@@ -0,0 +1,128 @@
+#include "postgres.h"
+
+#include <stdio.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "miscadmin.h"
+#include "storage/buf_numa.h"
+
+// GUC
+bool numa_buffer_partitions = false;
+
+#define BUF_NUMA_SYSFS "/sys/devices/system/node"
+// Partitions are bound in whole huge pages
+#define BUF_NUMA_ALIGN ((Size) 2 * 1024 * 1024)
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED (1)
+#endif
+
+static int nodeCount = 0;
+static int myNode = -1;
+
+// Parses a sysfs list like "0-3,8-11", calling add for each number
+static void BufNumaParseList(const char *path, void (*add)(int, void *), void *arg) {
+    FILE *file = fopen(path, "r");
+    int first, last;
+    char sep = ',';
+
+    if (file == NULL)
+        return;
+    while (sep == ',' && fscanf(file, "%d", &first) == 1) {
+        last = first;
+        if (fscanf(file, "%c", &sep) == 1 && sep == '-') {
+            if (fscanf(file, "%d", &last) != 1)
+                break;
+            if (fscanf(file, "%c", &sep) != 1)
+                sep = '\n';
+        }
+        for (int i = first; i <= last; i++)
+            add(i, arg);
+    }
+    fclose(file);
+}
+
+static void BufNumaAddNode(int node, void *arg) {
+    int *count = (int *) arg;
+
+    if (node + 1 > *count)
+        *count = node + 1;
+}
+
+int BufNumaNodeCount(void) {
+    if (nodeCount > 0)
+        return nodeCount;
+    nodeCount = 1;
+    if (numa_buffer_partitions) {
+        int count = 0;
+
+        BufNumaParseList(BUF_NUMA_SYSFS "/online", BufNumaAddNode, &count);
+        if (count > 1)
+            nodeCount = Min(count, BUF_NUMA_MAX_NODES);
+    }
+    return nodeCount;
+}
+
+void BufNumaPlace(void *start, Size size, int nodes) {
+#ifdef __linux__
+    static bool warned = false;
+
+    for (int node = 0; node < nodes; node++) {
+        char *from = (char *) TYPEALIGN_DOWN(BUF_NUMA_ALIGN, (char *) start + size * node / nodes);
+        char *to = (char *) TYPEALIGN_DOWN(BUF_NUMA_ALIGN, (char *) start + size * (node + 1) / nodes);
+        unsigned long mask = 1UL << node;
+
+        // The first and last pages may be shared with the neighbours
+        if (node > 0)
+            from += BUF_NUMA_ALIGN;
+        if (node == nodes - 1)
+            to = (char *) TYPEALIGN(BUF_NUMA_ALIGN, (char *) start + size);
+        if (to <= from)
+            continue;
+        if (syscall(SYS_mbind, from, to - from, MPOL_PREFERRED, &mask,
+                    BUF_NUMA_MAX_NODES + 1, 0) != 0 && !warned) {
+            warned = true;
+            ereport(LOG,
+                    (errmsg("could not place shared buffers on NUMA node %d: %m", node)));
+        }
+    }
+#endif
+}
+
+#ifdef __linux__
+static void BufNumaAddCpu(int cpu, void *arg) {
+    if (cpu < CPU_SETSIZE)
+        CPU_SET(cpu, (cpu_set_t *) arg);
+}
+#endif
+
+void BufNumaBindBackend(int procno) {
+#ifdef __linux__
+    char path[MAXPGPATH];
+    cpu_set_t cpus;
+    int nodes = BufNumaNodeCount();
+
+    if (nodes <= 1)
+        return;
+    myNode = procno % nodes;
+    CPU_ZERO(&cpus);
+    snprintf(path, sizeof(path), BUF_NUMA_SYSFS "/node%d/cpulist", myNode);
+    BufNumaParseList(path, BufNumaAddCpu, &cpus);
+    if (CPU_COUNT(&cpus) == 0 || sched_setaffinity(0, sizeof(cpus), &cpus) != 0)
+        myNode = -1;
+#endif
+}
+
+int BufNumaMyNode(void) {
+#ifdef __linux__
+    unsigned cpu, node;
+
+    if (myNode >= 0)
+        return myNode;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0 && (int) node < BufNumaNodeCount())
+        return (int) node;
+#endif
+    return 0;
+}
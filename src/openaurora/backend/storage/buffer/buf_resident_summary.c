@@ -0,0 +1,82 @@
+#include "postgres.h"
+
+#include "access/logindex_resident.h"
+#include "miscadmin.h"
+#include "storage/buf_internals.h"
+#include "storage/buf_resident_summary.h"
+#include "storage/rpcclient.h"
+#include "utils/memutils.h"
+#include "utils/timestamp.h"
+
+extern int IsRpcClient;
+
+// GUC
+int buffer_resident_summary_interval = 0;
+
+// Intervals a summary stands for
+#define BUF_RESIDENT_SUMMARY_TTL_INTERVALS (4)
+
+static char *summary = NULL;
+static uint32 summaryBlocks = 0;
+static TimestampTz lastPublish = 0;
+static bool failed = false;
+
+static void BufResidentSummaryPublish(void) {
+    ResidentSummaryHeader header;
+    uint64 *filter;
+    uint32 count = 0;
+
+    // A power of two blocks of RESIDENT_SUMMARY_BITS_PER_PAGE bits a buffer
+    if (summary == NULL) {
+        summaryBlocks = 1;
+        while ((uint64) summaryBlocks * RESIDENT_SUMMARY_BLOCK_WORDS * 64 <
+               (uint64) NBuffers * RESIDENT_SUMMARY_BITS_PER_PAGE)
+            summaryBlocks *= 2;
+        summary = MemoryContextAllocHuge(TopMemoryContext, ResidentSummarySize(summaryBlocks));
+    }
+    filter = (uint64 *) (summary + sizeof(header));
+    memset(filter, 0, ResidentSummarySize(summaryBlocks) - sizeof(header));
+
+    for (int i = 0; i < NBuffers; i++) {
+        BufferDesc *bufHdr = GetBufferDescriptor(i);
+        uint32 buf_state = LockBufHdr(bufHdr);
+        BufferTag tag = bufHdr->tag;
+
+        UnlockBufHdr(bufHdr, buf_state);
+        if (!(buf_state & BM_VALID) || !(buf_state & BM_PERMANENT))
+            continue;
+        ResidentSummaryAdd(filter, summaryBlocks,
+                           ResidentSummaryHash(tag.rnode.spcNode, tag.rnode.dbNode, tag.rnode.relNode,
+                                               (uint32) tag.forkNum, tag.blockNum));
+        count++;
+    }
+
+    header.magic = RESIDENT_SUMMARY_MAGIC;
+    // The same for the node's life, so each summary replaces its last one
+    header.nodeKey = (uint32) (PgStartTime ^ PostmasterPid);
+    header.blocks = summaryBlocks;
+    header.count = count;
+    header.ttlMs = (uint32) Min((int64) buffer_resident_summary_interval * BUF_RESIDENT_SUMMARY_TTL_INTERVALS,
+                                PG_INT32_MAX);
+    header.reserved = 0;
+    memcpy(summary, &header, sizeof(header));
+
+    if (RpcPublishResidentPages(summary, (int32) ResidentSummarySize(summaryBlocks)) != 1) {
+        ereport(LOG,
+                (errmsg("storage node does not take resident page summaries, not sending them")));
+        failed = true;
+    }
+}
+
+void BufResidentSummaryPublishIfDue(void) {
+    TimestampTz now;
+
+    if (!IsRpcClient || failed || buffer_resident_summary_interval <= 0)
+        return;
+
+    now = GetCurrentTimestamp();
+    if (lastPublish != 0 && !TimestampDifferenceExceeds(lastPublish, now, buffer_resident_summary_interval))
+        return;
+    lastPublish = now;
+    BufResidentSummaryPublish();
+}
@@ -0,0 +1,252 @@
+#include "postgres.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "access/xlog.h"
+#include "miscadmin.h"
+#include "storage/buf_internals.h"
+#include "storage/buf_warm_start.h"
+#include "storage/bufmgr.h"
+#include "storage/fd.h"
+#include "storage/rpcclient.h"
+#include "storage/smgr.h"
+#include "utils/timestamp.h"
+
+extern int IsRpcClient;
+
+// GUCs, the interval in seconds
+bool buffer_warm_start = false;
+int buffer_warm_start_interval = 300;
+
+#define BUF_WARM_START_TEMP_FILE BUF_WARM_START_FILE ".tmp"
+#define BUF_WARM_START_MAGIC (0x42575346)   // "BWSF"
+// Written and read in pieces, each one RPC to the storage node
+#define BUF_WARM_START_CHUNK (1024 * 1024)
+
+typedef struct BufWarmStartHeader {
+    uint32 magic;
+    uint32 count;
+    XLogRecPtr lsn;
+} BufWarmStartHeader;
+
+typedef struct BufWarmStartEntry {
+    Oid spcNode;
+    Oid dbNode;
+    Oid relNode;
+    BlockNumber blockNum;
+    int16 forkNum;
+    uint16 usage;
+} BufWarmStartEntry;
+
+static TimestampTz lastRecord = 0;
+
+// Offsets of the storage node's files are 32 bits wide
+#define BUF_WARM_START_MAX_ENTRIES \
+    ((PG_INT32_MAX - sizeof(BufWarmStartHeader)) / sizeof(BufWarmStartEntry))
+
+static int BufWarmStartWrite(int fd, char *p, int amount, int offset) {
+    if (IsRpcClient)
+        return RpcPgPWrite(fd, p, amount, offset);
+    return (int) pg_pwrite(fd, p, amount, offset);
+}
+
+static int BufWarmStartRead(int fd, char *p, int amount, int offset) {
+    if (IsRpcClient)
+        return RpcPgPRead(fd, p, amount, offset);
+    return (int) pg_pread(fd, p, amount, offset);
+}
+
+// Moves the first len bytes of the file in chunks, false if one falls short
+static bool BufWarmStartTransfer(int fd, char *p, Size len, bool write) {
+    Size done = 0;
+
+    while (done < len) {
+        int amount = (int) Min(len - done, BUF_WARM_START_CHUNK);
+        int r = write ? BufWarmStartWrite(fd, p + done, amount, (int) done)
+                      : BufWarmStartRead(fd, p + done, amount, (int) done);
+
+        if (r != amount)
+            return false;
+        done += amount;
+    }
+    return true;
+}
+
+static void BufWarmStartRecord(void) {
+    uint32 maxEntries = (uint32) Min((Size) NBuffers, BUF_WARM_START_MAX_ENTRIES);
+    Size size = sizeof(BufWarmStartHeader) + sizeof(BufWarmStartEntry) * maxEntries;
+    char *data = palloc_extended(size, MCXT_ALLOC_HUGE);
+    BufWarmStartHeader *header = (BufWarmStartHeader *) data;
+    BufWarmStartEntry *entries = (BufWarmStartEntry *) (data + sizeof(BufWarmStartHeader));
+    uint32 count = 0;
+    int fd;
+
+    for (int i = 0; i < NBuffers && count < maxEntries; i++) {
+        BufferDesc *bufHdr = GetBufferDescriptor(i);
+        uint32 buf_state = LockBufHdr(bufHdr);
+
+        if ((buf_state & BM_TAG_VALID) && (buf_state & BM_PERMANENT)) {
+            BufWarmStartEntry *entry = &entries[count++];
+
+            entry->spcNode = bufHdr->tag.rnode.spcNode;
+            entry->dbNode = bufHdr->tag.rnode.dbNode;
+            entry->relNode = bufHdr->tag.rnode.relNode;
+            entry->blockNum = bufHdr->tag.blockNum;
+            entry->forkNum = (int16) bufHdr->tag.forkNum;
+            entry->usage = (uint16) BUF_STATE_GET_USAGECOUNT(buf_state);
+        }
+        UnlockBufHdr(bufHdr, buf_state);
+    }
+    header->magic = BUF_WARM_START_MAGIC;
+    header->count = count;
+    header->lsn = GetLogWrtResultLsn();
+    size = sizeof(BufWarmStartHeader) + sizeof(BufWarmStartEntry) * count;
+
+    fd = OpenTransientFile_Rpc_Local(BUF_WARM_START_TEMP_FILE, O_RDWR | O_CREAT | O_TRUNC | PG_BINARY);
+    if (fd < 0) {
+        ereport(LOG,
+                (errcode_for_file_access(),
+                 errmsg("could not create file \"%s\": %m", BUF_WARM_START_TEMP_FILE)));
+        pfree(data);
+        return;
+    }
+    if (!BufWarmStartTransfer(fd, data, size, true) || pg_fsync_rpc_local(fd) != 0) {
+        ereport(LOG,
+                (errcode_for_file_access(),
+                 errmsg("could not write file \"%s\": %m", BUF_WARM_START_TEMP_FILE)));
+        CloseTransientFile_Rpc_Local(fd);
+        pfree(data);
+        return;
+    }
+    CloseTransientFile_Rpc_Local(fd);
+    pfree(data);
+
+    Unlink_Rpc_Local(BUF_WARM_START_FILE);
+    durable_rename_excl_rpc_local(BUF_WARM_START_TEMP_FILE, BUF_WARM_START_FILE, LOG);
+}
+
+void BufWarmStartRecordIfDue(void) {
+    TimestampTz now;
+
+    if (!buffer_warm_start || buffer_warm_start_interval <= 0)
+        return;
+    // The nodes share the file on the storage node, it's the primary's
+    if (RecoveryInProgress() && (IsRpcClient || !HotStandbyActive()))
+        return;
+
+    now = GetCurrentTimestamp();
+    // Not in the first interval, while the buffers are still cold
+    if (lastRecord == 0) {
+        lastRecord = now;
+        return;
+    }
+    if (!TimestampDifferenceExceeds(lastRecord, now, buffer_warm_start_interval * 1000))
+        return;
+    lastRecord = now;
+    BufWarmStartRecord();
+}
+
+static int BufWarmStartCompareUsage(const void *a, const void *b) {
+    const BufWarmStartEntry *x = (const BufWarmStartEntry *) a;
+    const BufWarmStartEntry *y = (const BufWarmStartEntry *) b;
+
+    return (int) y->usage - (int) x->usage;
+}
+
+static int BufWarmStartCompareTag(const void *a, const void *b) {
+    const BufWarmStartEntry *x = (const BufWarmStartEntry *) a;
+    const BufWarmStartEntry *y = (const BufWarmStartEntry *) b;
+
+    if (x->spcNode != y->spcNode)
+        return x->spcNode < y->spcNode ? -1 : 1;
+    if (x->dbNode != y->dbNode)
+        return x->dbNode < y->dbNode ? -1 : 1;
+    if (x->relNode != y->relNode)
+        return x->relNode < y->relNode ? -1 : 1;
+    if (x->forkNum != y->forkNum)
+        return x->forkNum < y->forkNum ? -1 : 1;
+    if (x->blockNum != y->blockNum)
+        return x->blockNum < y->blockNum ? -1 : 1;
+    return 0;
+}
+
+void BufWarmStartLoad(void) {
+    static bool loaded = false;
+    BufWarmStartHeader header;
+    BufWarmStartEntry *entries;
+    BlockNumber *blocks;
+    char *data;
+    uint32 count;
+    int fd;
+    int nread = 0;
+    bool ok;
+
+    if (loaded || !buffer_warm_start)
+        return;
+    loaded = true;
+
+    fd = OpenTransientFile_Rpc_Local(BUF_WARM_START_FILE, O_RDONLY | PG_BINARY);
+    // Nothing recorded yet
+    if (fd < 0)
+        return;
+    if (BufWarmStartRead(fd, (char *) &header, sizeof(header), 0) != sizeof(header) ||
+        header.magic != BUF_WARM_START_MAGIC || header.count > BUF_WARM_START_MAX_ENTRIES) {
+        ereport(LOG,
+                (errmsg("ignoring invalid buffer warm start file \"%s\"", BUF_WARM_START_FILE)));
+        CloseTransientFile_Rpc_Local(fd);
+        return;
+    }
+    count = header.count;
+    // Read from the start, as the chunks are offset from there
+    data = palloc_extended(sizeof(header) + sizeof(BufWarmStartEntry) * count, MCXT_ALLOC_HUGE);
+    ok = BufWarmStartTransfer(fd, data, sizeof(header) + sizeof(BufWarmStartEntry) * count, false);
+    CloseTransientFile_Rpc_Local(fd);
+    if (!ok) {
+        ereport(LOG,
+                (errmsg("could not read buffer warm start file \"%s\"", BUF_WARM_START_FILE)));
+        pfree(data);
+        return;
+    }
+    entries = (BufWarmStartEntry *) (data + sizeof(header));
+
+    if (count > (uint32) NBuffers) {
+        qsort(entries, count, sizeof(BufWarmStartEntry), BufWarmStartCompareUsage);
+        count = NBuffers;
+    }
+    qsort(entries, count, sizeof(BufWarmStartEntry), BufWarmStartCompareTag);
+
+    blocks = palloc_extended(sizeof(BlockNumber) * Max(count, 1), MCXT_ALLOC_HUGE);
+    for (uint32 i = 0, next; i < count && have_free_buffer(); i = next) {
+        BufWarmStartEntry *first = &entries[i];
+        RelFileNode rnode;
+        SMgrRelation smgr;
+        BlockNumber nblocks;
+        int n = 0;
+
+        for (next = i + 1; next < count; next++)
+            if (entries[next].spcNode != first->spcNode || entries[next].dbNode != first->dbNode ||
+                entries[next].relNode != first->relNode || entries[next].forkNum != first->forkNum)
+                break;
+        if (first->forkNum < 0 || first->forkNum > MAX_FORKNUM)
+            continue;
+
+        rnode.spcNode = first->spcNode;
+        rnode.dbNode = first->dbNode;
+        rnode.relNode = first->relNode;
+        smgr = smgropen(rnode, InvalidBackendId);
+        // Dropped or truncated since it was recorded
+        if (!smgrexists(smgr, (ForkNumber) first->forkNum))
+            continue;
+        nblocks = smgrnblocks(smgr, (ForkNumber) first->forkNum);
+        for (uint32 j = i; j < next; j++)
+            if (entries[j].blockNum < nblocks)
+                blocks[n++] = entries[j].blockNum;
+        nread += PrewarmBuffers(smgr, (ForkNumber) first->forkNum, blocks, n);
+    }
+
+    ereport(LOG,
+            (errmsg("read %d of %u buffers recorded at %X/%X", nread, header.count,
+                    (uint32) (header.lsn >> 32), (uint32) header.lsn)));
+    pfree(blocks);
+    pfree(data);
+}
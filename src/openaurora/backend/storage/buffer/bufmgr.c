@@ -35,6 +35,7 @@
 
 #include "access/tableam.h"
 #include "access/xlog.h"
+#include "access/xlog_internal.h"
 #include "catalog/catalog.h"
 #include "catalog/storage.h"
 #include "catalog/pg_namespace.h"
@@ -50,12 +51,18 @@
 #include "storage/proc.h"
 #include "storage/smgr.h"
 #include "storage/standby.h"
+#include "utils/memutils.h"
 #include "utils/ps_status.h"
 #include "utils/rel.h"
 #include "utils/resowner_private.h"
 #include "utils/timestamp.h"
 #include "storage/rpcclient.h"
+#include "storage/shard_map.h"
 #include "storage/GroundDB/mempool_client.h"
+#include "storage/compressed_page_cache.h"
+#include "storage/local_page_cache.h"
+#include "storage/rpc_fetch_cost.h"
+#include "storage/map_page_cache.h"
 
 
 /* Note: these two macros only work on shared buffers, not local ones! */
@@ -72,6 +79,9 @@
 
 #define RELS_BSEARCH_THRESHOLD		20
 
+/* How long a disaggregated checkpoint waits for the storage node's parse */
+#define RPC_CHECKPOINT_PARSE_WAIT_MS	10000
+
 typedef struct PrivateRefCountEntry
 {
 	Buffer		buffer;
@@ -129,6 +139,9 @@ bool		zero_damaged_pages = false;
 int			bgwriter_lru_maxpages = 100;
 double		bgwriter_lru_multiplier = 2.0;
 bool		track_io_timing = false;
+bool		rpc_disaggregated_checkpoint = false;
+bool		rpc_local_hint_bits = false;
+int			rpc_catalog_prewarm_blocks = 8;
 
 /*
  * How many buffers PrefetchBuffer callers should try to stay ahead of their
@@ -514,6 +527,27 @@ PrefetchSharedBuffer(SMgrRelation smgr_reln,
 	if (buf_id < 0)
 	{
 #ifdef USE_PREFETCH
+		/*
+		 * A page the memory pool holds is read from there by RDMA, the
+		 * ReadBuffer that follows takes the read over once it completes.
+		 */
+		if (IsRpcClient > 1)
+		{
+			KeyType		page_id = {
+				smgr_reln->smgr_rnode.node.spcNode,
+				smgr_reln->smgr_rnode.node.dbNode,
+				smgr_reln->smgr_rnode.node.relNode,
+				forkNum,
+				blockNum
+			};
+
+			if (PrefetchPageFromMemoryPool(page_id))
+			{
+				result.initiated_io = true;
+				return result;
+			}
+		}
+
 		/*
 		 * Try to initiate an asynchronous read.  This returns false in
 		 * recovery if the relation file doesn't exist.
@@ -675,7 +709,8 @@ ReadBufferExtended(Relation reln, ForkNumber forkNum, BlockNumber blockNum,
 	 */
 	pgstat_count_buffer_read(reln);
 	buf = ReadBuffer_common(reln->rd_smgr, reln->rd_rel->relpersistence,
-							forkNum, blockNum, mode, strategy, &hit);
+							forkNum, blockNum, mode, strategy,
+							RelationGetMempoolCache(reln), &hit);
 	if (hit == 1)
 		pgstat_count_buffer_hit(reln);
 #ifdef USE_MEMPOOL_STAT
@@ -721,19 +756,579 @@ ReadBufferWithoutRelcache(RelFileNode rnode, ForkNumber forkNum,
 	Assert(InRecovery);
 
 	return ReadBuffer_common(smgr, RELPERSISTENCE_PERMANENT, forkNum, blockNum,
-							 mode, strategy, &hit);
+							 mode, strategy, true, &hit);
+}
+
+
+/*
+ * Batched page fetch for sequential reads on an RPC compute node.
+ *
+ * Every shared-buffer miss used to cost one ReadBufferCommon round trip.
+ * Once a backend misses on two consecutive blocks of the same relation fork,
+ * we ask the storage node for the next RPC_READ_BATCH_SIZE blocks with a
+ * single ReadBufferBatch call and keep the extra page images here.  A later
+ * miss inside the batch is served from this array as long as the flushed LSN
+ * has not moved since the batch was fetched, so it sees exactly the page
+ * version a ReadBufferCommon call would have returned.  Read streams keep the
+ * pages they fetch ahead here too, those needn't be consecutive.
+ * RPC_READ_BATCH_SIZE is in bufmgr.h.
+ */
+typedef struct RpcReadBatch
+{
+	RelFileNode rnode;			/* relation of the cached pages */
+	ForkNumber	forkNum;
+	BlockNumber blocks[RPC_READ_BATCH_SIZE];	/* blocks held in pages */
+	int			nblocks;		/* number of valid pages, 0 if empty */
+	XLogRecPtr	lsn;			/* LSN the pages were materialized at */
+	RelFileNode lastRnode;		/* last miss, for sequential detection */
+	ForkNumber	lastForkNum;
+	BlockNumber lastBlock;
+	char	   *pages;			/* RPC_READ_BATCH_SIZE * BLCKSZ bytes */
+} RpcReadBatch;
+
+static RpcReadBatch rpcReadBatch = {{0}, InvalidForkNumber, {0}, 0,
+									InvalidXLogRecPtr, {0}, InvalidForkNumber,
+									InvalidBlockNumber, NULL};
+
+/* Index of the block's page in the batch, -1 if it has none */
+static int
+RpcReadBatchLookup(RpcReadBatch *batch, RelFileNode rnode, ForkNumber forkNum,
+				   BlockNumber blockNum, XLogRecPtr lsn)
+{
+	int			i;
+
+	if (batch->nblocks == 0 || batch->lsn != lsn ||
+		!RelFileNodeEquals(batch->rnode, rnode) || batch->forkNum != forkNum)
+		return -1;
+	for (i = 0; i < batch->nblocks; i++)
+		if (batch->blocks[i] == blockNum)
+			return i;
+	return -1;
+}
+
+/* FetchPageFromMemoryPool, reporting its wait */
+static bool
+MemPoolReadPage(char *buff, KeyType page_id, RDMAReadPageInfo *rdma_read_info)
+{
+	bool		found;
+
+	pgstat_report_wait_start(WAIT_EVENT_MEMPOOL_READ);
+	found = FetchPageFromMemoryPool(buff, page_id, rdma_read_info);
+	pgstat_report_wait_end();
+	return found;
+}
+
+static void
+RpcReadBufferBatched(char *buff, SMgrRelation smgr, char relpersistence,
+					 ForkNumber forkNum, BlockNumber blockNum,
+					 ReadBufferMode mode)
+{
+	RpcReadBatch *batch = &rpcReadBatch;
+	RelFileNode rnode = smgr->smgr_rnode.node;
+	XLogRecPtr	lsn = GetLogWrtResultLsn();
+	bool		sequential;
+	int			nread;
+	int			i;
+
+	/* A map page kept since its eviction is the newest version */
+	if (MapPageCacheFork(forkNum) && !SmgrIsTemp(smgr) &&
+		(mode == RBM_NORMAL || mode == RBM_ZERO_ON_ERROR))
+	{
+		BufferTag	tag;
+
+		INIT_BUFFERTAG(tag, rnode, forkNum, blockNum);
+		if (MapPageCacheGet(&tag, buff))
+			return;
+	}
+
+	/* So is a B-tree upper-level page */
+	if (forkNum == MAIN_FORKNUM && IndexPageCacheEnabled() &&
+		!SmgrIsTemp(smgr) && mode == RBM_NORMAL)
+	{
+		BufferTag	tag;
+
+		INIT_BUFFERTAG(tag, rnode, forkNum, blockNum);
+		if (IndexPageCacheGet(&tag, buff))
+			return;
+	}
+
+	sequential = RelFileNodeEquals(batch->lastRnode, rnode) &&
+		batch->lastForkNum == forkNum &&
+		batch->lastBlock != InvalidBlockNumber &&
+		blockNum == batch->lastBlock + 1;
+	batch->lastRnode = rnode;
+	batch->lastForkNum = forkNum;
+	batch->lastBlock = blockNum;
+
+	i = RpcReadBatchLookup(batch, rnode, forkNum, blockNum, lsn);
+	if (i >= 0)
+	{
+		memcpy(buff, batch->pages + (Size) i * BLCKSZ, BLCKSZ);
+		return;
+	}
+
+	if (!sequential || SmgrIsTemp(smgr))
+	{
+		RpcReadBuffer_common(buff, smgr, relpersistence, forkNum, blockNum, mode);
+		return;
+	}
+
+	if (batch->pages == NULL)
+		batch->pages = MemoryContextAlloc(TopMemoryContext,
+										  (Size) RPC_READ_BATCH_SIZE * BLCKSZ);
+
+	batch->nblocks = 0;
+	nread = RpcReadBufferBatch(batch->pages, smgr, relpersistence, forkNum,
+							   blockNum, RPC_READ_BATCH_SIZE, mode, lsn);
+	if (nread <= 0)
+	{
+		RpcReadBuffer_common(buff, smgr, relpersistence, forkNum, blockNum, mode);
+		return;
+	}
+
+	batch->rnode = rnode;
+	batch->forkNum = forkNum;
+	for (i = 0; i < nread; i++)
+		batch->blocks[i] = blockNum + i;
+	batch->nblocks = nread;
+	batch->lsn = lsn;
+	memcpy(buff, batch->pages, BLCKSZ);
+}
+
+/*
+ * Streaming reads
+ *
+ * A compute node in RPC mode pays a round trip for every page it misses on.
+ * A caller that knows which blocks it is going to read names them through a
+ * callback, and reads them with ReadStreamReadBuffer() in that order.  The
+ * stream keeps the next READ_STREAM_DISTANCE named blocks queued.  When the
+ * caller gets to one it hasn't looked at yet, the queued blocks not in shared
+ * buffers are fetched together: consecutive ones in one ReadBufferBatch call,
+ * others pipelined on the connection, those the memory pool holds by RDMA
+ * prefetch.  The pages wait in rpcReadBatch for the ReadBuffer of each.
+ *
+ * The caller may skip named blocks, or read ones it didn't name; those are
+ * just read on their own.  Elsewhere than on a compute node there is no
+ * stream, ReadStreamBegin() returns NULL and the caller reads as before.
+ */
+#define READ_STREAM_DISTANCE RPC_READ_BATCH_SIZE
+
+typedef struct ReadStreamEntry
+{
+	BlockNumber blockNum;
+	bool		checked;		/* fetched ahead, or found not to need it */
+} ReadStreamEntry;
+
+struct ReadStream
+{
+	Relation	reln;
+	ForkNumber	forkNum;
+	ReadStreamBlockCallback callback;
+	void	   *callback_arg;
+	bool		exhausted;		/* the callback has no more blocks */
+	int			head;
+	int			count;
+	ReadStreamEntry queue[READ_STREAM_DISTANCE];
+};
+
+/*
+ * ReadStreamBegin -- start a stream of reads of the fork of a relation
+ *
+ * Returns NULL if reads are better left to ReadBufferExtended().
+ */
+ReadStream *
+ReadStreamBegin(Relation reln, ForkNumber forkNum,
+				ReadStreamBlockCallback callback, void *callback_arg)
+{
+	ReadStream *stream;
+
+	if (!IsRpcClient || RelationUsesLocalBuffers(reln))
+		return NULL;
+
+	stream = palloc0(sizeof(ReadStream));
+	stream->reln = reln;
+	stream->forkNum = forkNum;
+	stream->callback = callback;
+	stream->callback_arg = callback_arg;
+	return stream;
+}
+
+/*
+ * ReadStreamReset -- forget the queued blocks, the callback starts over
+ */
+void
+ReadStreamReset(ReadStream *stream)
+{
+	stream->exhausted = false;
+	stream->head = 0;
+	stream->count = 0;
+}
+
+void
+ReadStreamEnd(ReadStream *stream)
+{
+	pfree(stream);
+}
+
+#define ReadStreamEntryAt(stream, i) \
+	(&(stream)->queue[((stream)->head + (i)) % READ_STREAM_DISTANCE])
+
+/*
+ * Fetches those of up to a batch of blocks that aren't in shared buffers
+ * into rpcReadBatch, where the ReadBuffer of each finds them
+ */
+static void
+RpcReadBatchFetchAhead(SMgrRelation smgr, char relpersistence,
+					   ForkNumber forkNum, const BlockNumber *candidates,
+					   int ncandidates)
+{
+	RpcReadBatch *batch = &rpcReadBatch;
+	BlockNumber blocks[RPC_READ_BATCH_SIZE];
+	XLogRecPtr	lsn;
+	bool		consecutive = true;
+	int			nblocks = 0;
+	int			nread;
+	int			i;
+
+	Assert(ncandidates <= RPC_READ_BATCH_SIZE);
+
+	for (i = 0; i < ncandidates; i++)
+	{
+		BufferTag	tag;
+		uint32		hash;
+		LWLock	   *partitionLock;
+		int			buf_id;
+
+		INIT_BUFFERTAG(tag, smgr->smgr_rnode.node, forkNum, candidates[i]);
+		hash = BufTableHashCode(&tag);
+		partitionLock = BufMappingPartitionLock(hash);
+		LWLockAcquire(partitionLock, LW_SHARED);
+		buf_id = BufTableLookup(&tag, hash);
+		LWLockRelease(partitionLock);
+		if (buf_id >= 0)
+			continue;
+
+		if (IsRpcClient > 1)
+		{
+			KeyType		page_id = {
+				tag.rnode.spcNode,
+				tag.rnode.dbNode,
+				tag.rnode.relNode,
+				tag.forkNum,
+				tag.blockNum
+			};
+
+			if (PrefetchPageFromMemoryPool(page_id))
+				continue;
+		}
+
+		if (nblocks > 0 && candidates[i] != blocks[nblocks - 1] + 1)
+			consecutive = false;
+		blocks[nblocks++] = candidates[i];
+	}
+
+	/* A single page is read by the ReadBuffer as well */
+	if (nblocks <= 1)
+		return;
+
+	if (batch->pages == NULL)
+		batch->pages = MemoryContextAlloc(TopMemoryContext,
+										  (Size) RPC_READ_BATCH_SIZE * BLCKSZ);
+
+	lsn = GetLogWrtResultLsn();
+	batch->nblocks = 0;
+	if (consecutive)
+		nread = RpcReadBufferBatch(batch->pages, smgr, relpersistence,
+								   forkNum, blocks[0], nblocks,
+								   RBM_NORMAL, lsn);
+	else
+	{
+		RpcReadBufferPipelined(batch->pages, smgr, relpersistence,
+							   forkNum, blocks, nblocks, RBM_NORMAL);
+		nread = nblocks;
+	}
+	if (nread <= 0)
+		return;
+
+	batch->rnode = smgr->smgr_rnode.node;
+	batch->forkNum = forkNum;
+	memcpy(batch->blocks, blocks, sizeof(BlockNumber) * nread);
+	batch->nblocks = nread;
+	batch->lsn = lsn;
+}
+
+/* Fetches the queued blocks not looked at yet, up to a batch of them */
+static void
+ReadStreamFetchAhead(ReadStream *stream)
+{
+	BlockNumber candidates[READ_STREAM_DISTANCE];
+	int			ncandidates = 0;
+	int			i;
+
+	RelationOpenSmgr(stream->reln);
+
+	for (i = 0; i < stream->count; i++)
+	{
+		ReadStreamEntry *entry = ReadStreamEntryAt(stream, i);
+
+		if (entry->checked)
+			continue;
+		entry->checked = true;
+		candidates[ncandidates++] = entry->blockNum;
+	}
+
+	RpcReadBatchFetchAhead(stream->reln->rd_smgr,
+						   stream->reln->rd_rel->relpersistence,
+						   stream->forkNum, candidates, ncandidates);
+}
+
+/*
+ * ReadStreamReadBuffer -- ReadBufferExtended() of a block of the stream
+ */
+Buffer
+ReadStreamReadBuffer(ReadStream *stream, BlockNumber blockNum,
+					 BufferAccessStrategy strategy)
+{
+	int			i;
+
+	while (!stream->exhausted && stream->count < READ_STREAM_DISTANCE)
+	{
+		BlockNumber next = stream->callback(stream->callback_arg);
+
+		if (next == InvalidBlockNumber)
+			stream->exhausted = true;
+		else
+		{
+			ReadStreamEntry *entry = ReadStreamEntryAt(stream, stream->count);
+
+			entry->blockNum = next;
+			entry->checked = false;
+			stream->count++;
+		}
+	}
+
+	for (i = 0; i < stream->count; i++)
+		if (ReadStreamEntryAt(stream, i)->blockNum == blockNum)
+			break;
+	if (i < stream->count)
+	{
+		/* The blocks before it were skipped */
+		stream->head = (stream->head + i) % READ_STREAM_DISTANCE;
+		stream->count -= i;
+
+		/* Fetch it along with those after it */
+		if (!ReadStreamEntryAt(stream, 0)->checked)
+			ReadStreamFetchAhead(stream);
+
+		stream->head = (stream->head + 1) % READ_STREAM_DISTANCE;
+		stream->count--;
+	}
+
+	return ReadBufferExtended(stream->reln, stream->forkNum, blockNum,
+							  RBM_NORMAL, strategy);
+}
+
+/*
+ * PrefetchBufferBlocks -- fetch ahead blocks the caller is about to read
+ *
+ * On a compute node those of the first blocks, up to a batch of them, that
+ * aren't in shared buffers are fetched together into rpcReadBatch, where the
+ * ReadBuffer of each finds them, as a read stream would.  The blocks should
+ * be distinct.  Returns how many of them were looked at; the caller passes
+ * the others again once it gets to them.
+ */
+int
+PrefetchBufferBlocks(Relation reln, ForkNumber forkNum,
+					 const BlockNumber *blocks, int nblocks)
+{
+	nblocks = Min(nblocks, RPC_READ_BATCH_SIZE);
+	if (!IsRpcClient || RelationUsesLocalBuffers(reln) || nblocks == 0)
+		return nblocks;
+
+	RelationOpenSmgr(reln);
+	RpcReadBatchFetchAhead(reln->rd_smgr, reln->rd_rel->relpersistence,
+						   forkNum, blocks, nblocks);
+	return nblocks;
+}
+
+/*
+ * PrewarmBuffers -- read blocks of a permanent fork into shared buffers
+ *
+ * The blocks are left unpinned.  On a compute node they are fetched a batch
+ * at a time the way a read stream fetches ahead.  Stops once no buffer is
+ * free, as reading on would only evict the blocks read before.  Returns the
+ * number of blocks read.
+ */
+int
+PrewarmBuffers(SMgrRelation smgr, ForkNumber forkNum,
+			   const BlockNumber *blocks, int nblocks)
+{
+	int			nread = 0;
+
+	while (nread < nblocks && have_free_buffer())
+	{
+		int			n = Min(nblocks - nread, RPC_READ_BATCH_SIZE);
+		int			i;
+
+		if (IsRpcClient)
+			RpcReadBatchFetchAhead(smgr, RELPERSISTENCE_PERMANENT, forkNum,
+								   blocks + nread, n);
+		for (i = 0; i < n; i++)
+		{
+			Buffer		buffer;
+			char		hit;
+
+			CHECK_FOR_INTERRUPTS();
+			buffer = ReadBuffer_common(smgr, RELPERSISTENCE_PERMANENT, forkNum,
+									   blocks[nread + i], RBM_NORMAL, NULL,
+									   true, &hit);
+			ReleaseBuffer(buffer);
+		}
+		nread += n;
+	}
+	return nread;
 }
 
+/* Whether a block of a relation's main fork is in shared buffers */
+static bool
+BufferIsCached(RelFileNode rnode, BlockNumber blockNum)
+{
+	BufferTag	tag;
+	uint32		hash;
+	LWLock	   *partitionLock;
+	int			buf_id;
+
+	INIT_BUFFERTAG(tag, rnode, MAIN_FORKNUM, blockNum);
+	hash = BufTableHashCode(&tag);
+	partitionLock = BufMappingPartitionLock(hash);
+	LWLockAcquire(partitionLock, LW_SHARED);
+	buf_id = BufTableLookup(&tag, hash);
+	LWLockRelease(partitionLock);
+	return buf_id >= 0;
+}
+
+/*
+ * PrewarmRelationHeads -- read the first blocks of many relations into
+ * shared buffers
+ *
+ * Up to maxBlocks blocks of the main fork of each relation whose first block
+ * isn't in shared buffers are fetched from the storage node in a single
+ * ReadRelationHeads call.  The pages go through rpcReadBatch a relation at a
+ * time, so a page is only taken if the flushed LSN hasn't moved since it was
+ * fetched, and is otherwise read on its own like any other miss.  Relations
+ * whose first block is cached already cost nothing, so once one backend has
+ * done this the next ones don't touch the network.  Returns the number of
+ * blocks read.
+ */
+int
+PrewarmRelationHeads(const RelFileNode *rnodes, int nrels, int maxBlocks)
+{
+	RelFileNode *missing;
+	int		   *counts;
+	char	   *pages;
+	BlockNumber *blocks;
+	XLogRecPtr	lsn;
+	int			nmissing = 0;
+	int			nread = 0;
+	int			i;
+
+	if (!IsRpcClient || ShardMapActive() || nrels <= 0 || maxBlocks <= 0)
+		return 0;
+
+	missing = palloc(sizeof(RelFileNode) * nrels);
+	for (i = 0; i < nrels; i++)
+		if (!BufferIsCached(rnodes[i], 0))
+			missing[nmissing++] = rnodes[i];
+	if (nmissing == 0)
+	{
+		pfree(missing);
+		return 0;
+	}
+
+	counts = palloc(sizeof(int) * nmissing);
+	pages = palloc_extended((Size) nmissing * maxBlocks * BLCKSZ, MCXT_ALLOC_HUGE);
+	blocks = palloc(sizeof(BlockNumber) * maxBlocks);
+	lsn = GetLogWrtResultLsn();
+	RpcReadRelationHeads(pages, counts, missing, nmissing, MAIN_FORKNUM,
+						 maxBlocks, lsn);
+
+	for (i = 0; i < maxBlocks; i++)
+		blocks[i] = i;
+	for (i = 0; i < nmissing; i++)
+	{
+		LoadFetchedPages(smgropen(missing[i], InvalidBackendId),
+						 RELPERSISTENCE_PERMANENT, MAIN_FORKNUM, blocks,
+						 pages + (Size) i * maxBlocks * BLCKSZ, counts[i],
+						 lsn, NULL);
+		nread += counts[i];
+	}
+
+	pfree(blocks);
+	pfree(pages);
+	pfree(counts);
+	pfree(missing);
+	return nread;
+}
+
+/*
+ * LoadFetchedPages -- put pages fetched from the storage node in shared buffers
+ *
+ * The pages are those of blocks at lsn, as a caller fetched them in a call of
+ * its own.  They go through rpcReadBatch a batch at a time, so a block already
+ * in shared buffers keeps its buffer, and a page is only taken if the flushed
+ * LSN hasn't moved since lsn; the block is read on its own otherwise.
+ */
+void
+LoadFetchedPages(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
+				 const BlockNumber *blocks, const char *pages, int npages,
+				 XLogRecPtr lsn, BufferAccessStrategy strategy)
+{
+	RpcReadBatch *batch = &rpcReadBatch;
+	int			done;
+
+	if (batch->pages == NULL)
+		batch->pages = MemoryContextAlloc(TopMemoryContext,
+										  (Size) RPC_READ_BATCH_SIZE * BLCKSZ);
+
+	for (done = 0; done < npages; done += RPC_READ_BATCH_SIZE)
+	{
+		int			n = Min(npages - done, RPC_READ_BATCH_SIZE);
+		int			j;
+
+		memcpy(batch->pages, pages + (Size) done * BLCKSZ, (Size) n * BLCKSZ);
+		batch->rnode = smgr->smgr_rnode.node;
+		batch->forkNum = forkNum;
+		for (j = 0; j < n; j++)
+			batch->blocks[j] = blocks[done + j];
+		batch->nblocks = n;
+		batch->lsn = lsn;
+
+		for (j = 0; j < n; j++)
+		{
+			Buffer		buffer;
+			char		hit;
+
+			buffer = ReadBuffer_common(smgr, relpersistence, forkNum,
+									   blocks[done + j], RBM_NORMAL,
+									   strategy, true, &hit);
+			ReleaseBuffer(buffer);
+		}
+	}
+
+	batch->nblocks = 0;
+}
 
 /*
  * ReadBuffer_common -- common logic for all ReadBuffer variants
  *
  * *hit is set to true if the request was satisfied from shared buffer cache.
+ * mempoolCache is false if the relation's pages are kept out of the memory
+ * pool.
  */
 Buffer
 ReadBuffer_common(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 				  BlockNumber blockNum, ReadBufferMode mode,
-				  BufferAccessStrategy strategy, char *hit)
+				  BufferAccessStrategy strategy, bool mempoolCache, char *hit)
 {
 	BufferDesc *bufHdr;
 	Block		bufBlock;
@@ -929,11 +1524,18 @@ ReadBuffer_common(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 		{
 			instr_time	io_start,
 						io_time;
+			uint64		remote_bytes = pgStorageUsage.remote_bytes;
+			bool		compressed_hit = false;
 
-			if (track_io_timing)
+			if (track_io_timing || IsRpcClient)
 				INSTR_TIME_SET_CURRENT(io_start);
 			if(IsRpcClient){
-				if(IsRpcClient > 1){
+				/* A page evicted before may be kept compressed in memory */
+				if (mode == RBM_NORMAL && relpersistence == RELPERSISTENCE_PERMANENT &&
+					CompressedPageCacheEnabled() &&
+					CompressedPageCacheGet(&bufHdr->tag, (char *) bufBlock))
+					compressed_hit = true;
+				else if(IsRpcClient > 1){
 					bool read_from_mempool = false;
 					KeyType page_id = {
 						smgr->smgr_rnode.node.spcNode,
@@ -943,15 +1545,26 @@ ReadBuffer_common(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 						blockNum
 					};
 					RDMAReadPageInfo rdma_read_info;
-					if(PageExistsInMemPool(page_id, &rdma_read_info)){
+					// Completes a PrefetchBuffer of the page, if there was one
+					pgstat_report_wait_start(WAIT_EVENT_MEMPOOL_READ);
+					int prefetched = FetchPrefetchedPageFromMemoryPool((char*)bufBlock, page_id);
+					pgstat_report_wait_end();
+					if(prefetched < 0)
+						AsyncGetNewestPageAddressTable();
+					else if(prefetched > 0 || PageExistsInMemPool(page_id, &rdma_read_info)){
 						Assert(DataChecksumsEnabled());
-						if(FetchPageFromMemoryPool((char*)bufBlock, page_id, &rdma_read_info)
+						if((prefetched > 0 || MemPoolReadPage((char*)bufBlock, page_id, &rdma_read_info))
 						&& PageFromMemPoolIsVerified((Page)bufBlock, blockNum)){
 							XLogRecPtr cur_lsn = PageXLogRecPtrGet(((PageHeader)bufBlock)->pd_lsn);
 							if(LsnIsSatisfied(cur_lsn, GetLogWrtResultLsn())){
 								read_from_mempool = true;
 								*hit = 2;
-								toMarkDirty |= ReplayXLog(page_id, bufHdr, (char*)bufBlock, cur_lsn, GetLogWrtResultLsn());
+								if(ReplayXLog(page_id, bufHdr, (char*)bufBlock, cur_lsn, GetLogWrtResultLsn())){
+									toMarkDirty = true;
+									MemPoolStatCount(MEMPOOL_STAT_STALE_HITS, 1);
+								}
+								else
+									MemPoolStatCount(MEMPOOL_STAT_HITS, 1);
 #ifndef MEMPOOL_CACHE_POLICY_DISJOINT
 								AsyncAccessPageOnMemoryPool(page_id);
 #else
@@ -963,27 +1576,56 @@ ReadBuffer_common(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 							AsyncGetNewestPageAddressTable();
 					}
 					if(!read_from_mempool){
-						RpcReadBuffer_common((char*)bufBlock, smgr, relpersistence, forkNum, blockNum, mode);
-						toMarkDirty = true;
+						MemPoolStatCount(MEMPOOL_STAT_MISSES, 1);
+						RpcReadBufferBatched((char*)bufBlock, smgr, relpersistence, forkNum, blockNum, mode);
+						/* Dirty, so that eviction hands it to the mempool */
+						toMarkDirty = MemPoolOffersReadPage(mempoolCache, strategy != NULL);
 #ifdef MEMPOOL_CACHE_POLICY_COVERING
-						SyncFlushPageToMemoryPool(bufBlock, page_id);
+						if(toMarkDirty)
+							SyncFlushPageToMemoryPool(bufBlock, page_id);
 						toMarkDirty = false;
 #endif
 					}
 				}
 				else
-					RpcReadBuffer_common((char*)bufBlock, smgr, relpersistence, forkNum, blockNum, mode);
+					RpcReadBufferBatched((char*)bufBlock, smgr, relpersistence, forkNum, blockNum, mode);
 			}
 			else
 			    smgrread(smgr, forkNum, blockNum, (char *) bufBlock);
 
-			if (track_io_timing)
+			if (track_io_timing || IsRpcClient)
 			{
 				INSTR_TIME_SET_CURRENT(io_time);
 				INSTR_TIME_SUBTRACT(io_time, io_start);
+			}
+			if (track_io_timing)
+			{
 				pgstat_count_buffer_read_time(INSTR_TIME_GET_MICROSEC(io_time));
 				INSTR_TIME_ADD(pgBufferUsage.blk_read_time, io_time);
 			}
+			if (IsRpcClient)
+			{
+				/* A memory node's page came over RDMA, BLCKSZ of it */
+				if (*hit == 2)
+				{
+					pgBufferUsage.mempool_blks_hit++;
+					pgBufferUsage.remote_read_bytes += BLCKSZ;
+				}
+				else if (!compressed_hit)
+				{
+					pgBufferUsage.remote_blks_read++;
+					pgBufferUsage.remote_read_bytes += pgStorageUsage.remote_bytes - remote_bytes;
+				}
+				INSTR_TIME_ADD(pgBufferUsage.remote_blk_read_time, io_time);
+			}
+			/* We have the buffer pinned, the clock sweep leaves it alone */
+			if (IsRpcClient && !isLocalBuf)
+				bufHdr->refetch_cost = StrategyRefetchCost(*hit == 2,
+														   INSTR_TIME_GET_MICROSEC(io_time));
+			/* The storage node's pages are timed by rpcclient.cpp */
+			if (IsRpcClient && !isLocalBuf && (*hit == 2 || compressed_hit))
+				RpcFetchCostRecord(bufHdr->tag.rnode, RPC_FETCH_SINGLE,
+								   INSTR_TIME_GET_MICROSEC(io_time));
 
 			/* check for garbage data */
 			if (!PageIsVerified((Page) bufBlock, blockNum))
@@ -1148,6 +1790,108 @@ FindPageInBuffer(RelFileNode rnode, ForkNumber forkNumber, BlockNumber blockNumb
     return InvalidBuffer;
 }
 
+/*
+ * RefreshBufferForChange -- the record at lsn changed the page on the
+ *		storage node
+ *
+ * A secondary following the storage node's page change feed calls this
+ * instead of redoing the record. An unpinned buffer of the page is dropped,
+ * the next read fetches it again. A pinned one is read again in place under
+ * its exclusive content lock, as redo would have changed it. A page already
+ * at lsn or later is left alone.
+ */
+void
+RefreshBufferForChange(RelFileNode rnode, ForkNumber forkNum, BlockNumber blockNum,
+					   XLogRecPtr lsn)
+{
+	BufferTag	tag;
+	uint32		hash;
+	LWLock	   *partitionLock;
+	BufferDesc *buf;
+	Buffer		buffer;
+	uint32		buf_state;
+	int			buf_id;
+
+	INIT_BUFFERTAG(tag, rnode, forkNum, blockNum);
+	hash = BufTableHashCode(&tag);
+	partitionLock = BufMappingPartitionLock(hash);
+	LocalPageCacheInvalidate(&tag);
+	MapPageCacheInvalidate(&tag);
+	IndexPageCacheInvalidate(&tag);
+	CompressedPageCacheInvalidate(&tag);
+
+	LWLockAcquire(partitionLock, LW_EXCLUSIVE);
+	buf_id = BufTableLookup(&tag, hash);
+	if (buf_id < 0)
+	{
+		LWLockRelease(partitionLock);
+		return;
+	}
+	buf = GetBufferDescriptor(buf_id);
+	buf_state = LockBufHdr(buf);
+	if (BUF_STATE_GET_REFCOUNT(buf_state) == 0)
+	{
+		uint32		oldFlags = buf_state & BUF_FLAG_MASK;
+
+		/* Nobody can change an unpinned page under us */
+		if ((oldFlags & BM_VALID) && PageGetLSN(BufHdrGetBlock(buf)) >= lsn)
+		{
+			UnlockBufHdr(buf, buf_state);
+			LWLockRelease(partitionLock);
+			return;
+		}
+
+		/* As InvalidateBuffer, with the mapping lock held all along */
+		CLEAR_BUFFERTAG(buf->tag);
+		buf_state &= ~(BUF_FLAG_MASK | BUF_USAGECOUNT_MASK);
+		UnlockBufHdr(buf, buf_state);
+		if (oldFlags & BM_TAG_VALID)
+			BufTableDelete(&tag, hash);
+		LWLockRelease(partitionLock);
+		StrategyFreeBuffer(buf);
+		return;
+	}
+	UnlockBufHdr(buf, buf_state);
+	LWLockRelease(partitionLock);
+
+	buffer = FindPageInBuffer(rnode, forkNum, blockNum);
+	if (buffer == InvalidBuffer)
+		return;
+	LockBuffer(buffer, BUFFER_LOCK_EXCLUSIVE);
+	if (PageGetLSN(BufferGetPage(buffer)) < lsn)
+		RpcReadBuffer_common((char *) BufferGetPage(buffer),
+							 smgropen(rnode, InvalidBackendId),
+							 RELPERSISTENCE_PERMANENT, forkNum, blockNum, RBM_NORMAL);
+	UnlockReleaseBuffer(buffer);
+}
+
+/*
+ * RefreshAllBuffersForChange -- any page may have changed on the storage
+ *		node up to lsn
+ *
+ * Used when a secondary lost its place in the page change feed.
+ */
+void
+RefreshAllBuffersForChange(XLogRecPtr lsn)
+{
+	LocalPageCacheInvalidateAll();
+	MapPageCacheInvalidateAll();
+	IndexPageCacheInvalidateAll();
+	CompressedPageCacheInvalidateAll();
+
+	for (int i = 0; i < NBuffers; i++)
+	{
+		BufferDesc *bufHdr = GetBufferDescriptor(i);
+		uint32		buf_state = LockBufHdr(bufHdr);
+		BufferTag	tag = bufHdr->tag;
+		bool		permanent = (buf_state & BM_TAG_VALID) && (buf_state & BM_PERMANENT);
+
+		UnlockBufHdr(bufHdr, buf_state);
+		if (permanent)
+			RefreshBufferForChange(tag.rnode, tag.forkNum, tag.blockNum, lsn);
+	}
+}
+
 /*
  * BufferAlloc -- subroutine for ReadBuffer.  Handles lookup of a shared
  *		buffer.  If no buffer exists already, selects a replacement
@@ -1339,7 +2083,25 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 					});
 #endif
 				FlushBuffer(buf, NULL);
-				LWLockRelease(BufferDescriptorGetContentLock(buf));
+
+				/*
+				 * The storage node only has the WAL of the changes made
+				 * here, and replays it when the page is read next.  A
+				 * primary can hand it the page as it is now instead.
+				 */
+				if (IsRpcClient && rpc_install_evicted_pages &&
+					(oldFlags & BM_DIRTY) && (oldFlags & BM_PERMANENT) &&
+					!RecoveryInProgress())
+				{
+					PGAlignedBlock evicted;
+
+					memcpy(evicted.data, BufHdrGetBlock(buf), BLCKSZ);
+					LWLockRelease(BufferDescriptorGetContentLock(buf));
+					RpcInstallEvictedPage(buf->tag.rnode, buf->tag.forkNum,
+										  buf->tag.blockNum, evicted.data);
+				}
+				else
+					LWLockRelease(BufferDescriptorGetContentLock(buf));
 
 				ScheduleBufferTagForWriteback(&BackendWritebackContext,
 											  &buf->tag);
@@ -1360,6 +2122,49 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 			}
 		}
 
+		/*
+		 * A compute node keeps the evicted page on its local SSD, or in
+		 * memory for a visibility map or free space map page and a B-tree
+		 * upper-level page, and compressed in memory as well for any other
+		 * page.  As for the
+		 * write above, the share-lock is only taken if it's free; a page
+		 * that can't be had now goes unkept, and an older version kept
+		 * before is no longer current.
+		 */
+		if (IsRpcClient && (oldFlags & BM_VALID) && (oldFlags & BM_PERMANENT) &&
+			MapPageCacheEnabled() && MapPageCacheFork(buf->tag.forkNum))
+		{
+			if (LWLockConditionalAcquire(BufferDescriptorGetContentLock(buf),
+										 LW_SHARED))
+			{
+				MapPageCachePut(&buf->tag, (char *) BufHdrGetBlock(buf));
+				LWLockRelease(BufferDescriptorGetContentLock(buf));
+			}
+			else
+				MapPageCacheInvalidate(&buf->tag);
+		}
+		else if (IsRpcClient && (oldFlags & BM_VALID) && (oldFlags & BM_PERMANENT) &&
+				 (LocalPageCacheEnabled() || IndexPageCacheEnabled() ||
+				  CompressedPageCacheEnabled()))
+		{
+			if (LWLockConditionalAcquire(BufferDescriptorGetContentLock(buf),
+										 LW_SHARED))
+			{
+				if (!IndexPageCachePut(&buf->tag, (char *) BufHdrGetBlock(buf)))
+				{
+					CompressedPageCachePut(&buf->tag, (char *) BufHdrGetBlock(buf));
+					LocalPageCachePut(&buf->tag, (char *) BufHdrGetBlock(buf));
+				}
+				LWLockRelease(BufferDescriptorGetContentLock(buf));
+			}
+			else
+			{
+				LocalPageCacheInvalidate(&buf->tag);
+				IndexPageCacheInvalidate(&buf->tag);
+				CompressedPageCacheInvalidate(&buf->tag);
+			}
+		}
+
 		/*
 		 * To change the association of a valid buffer, we'll need to have
 		 * exclusive lock on both the old and new mapping partitions.
@@ -1500,6 +2305,8 @@ BufferAlloc(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
 	 * just like permanent relations.
 	 */
 	buf->tag = newTag;
+	buf->refetch_cost = 0;
+	buf->sweep_credit = 0;
 	buf_state &= ~(BM_VALID | BM_DIRTY | BM_JUST_DIRTIED |
 				   BM_CHECKPOINT_NEEDED | BM_IO_ERROR | BM_PERMANENT |
 				   BUF_USAGECOUNT_MASK);
@@ -1632,6 +2439,15 @@ retry:
 	 */
 	LWLockRelease(oldPartitionLock);
 
+	/* A copy on the local SSD may be outdated by what is dropped */
+	if (IsRpcClient && (oldFlags & BM_PERMANENT))
+	{
+		LocalPageCacheInvalidate(&oldTag);
+		MapPageCacheInvalidate(&oldTag);
+		IndexPageCacheInvalidate(&oldTag);
+		CompressedPageCacheInvalidate(&oldTag);
+	}
+
 	/*
 	 * Insert the buffer at the head of the list of free buffers.
 	 */
@@ -2804,6 +3620,48 @@ CheckPointBuffers(int flags)
 	TRACE_POSTGRESQL_BUFFER_CHECKPOINT_DONE();
 }
 
+/*
+ * CheckPointBuffersDisaggregated
+ *
+ * CheckPointBuffers of a compute node with rpc_disaggregated_checkpoint on.
+ * The storage node rebuilds every page from WAL, so instead of writing the
+ * dirty buffers out we only make sure the node has the WAL before
+ * checkPointRedo written and parsed; failing that, the checkpoint errors out
+ * and the redo pointer stays where it was.  Dirty buffers stay dirty and are
+ * still flushed when evicted, which flushes the WAL they need first and hands
+ * them to the memory pool.
+ */
+void
+CheckPointBuffersDisaggregated(XLogRecPtr checkPointRedo, int flags)
+{
+	XLogRecPtr	target = checkPointRedo;
+	XLogRecPtr	parsed;
+
+	TRACE_POSTGRESQL_BUFFER_CHECKPOINT_START(flags);
+	CheckpointStats.ckpt_write_t = GetCurrentTimestamp();
+	XLogFlush(checkPointRedo);
+
+	/*
+	 * A redo pointer just past a page header follows a record that ended at
+	 * the start of the page, which is as far as the parse gets.
+	 */
+	if (XLogSegmentOffset(target, wal_segment_size) == SizeOfXLogLongPHD ||
+		target % XLOG_BLCKSZ == SizeOfXLogShortPHD)
+		target -= target % XLOG_BLCKSZ;
+
+	CheckpointStats.ckpt_sync_t = GetCurrentTimestamp();
+	TRACE_POSTGRESQL_BUFFER_CHECKPOINT_SYNC_START();
+	parsed = (XLogRecPtr) RpcWaitWalParsed((int64_t) target,
+										   RPC_CHECKPOINT_PARSE_WAIT_MS);
+	if (parsed < target)
+		ereport(ERROR,
+				(errmsg("storage node has parsed WAL only up to %X/%X, checkpoint needs %X/%X",
+						(uint32) (parsed >> 32), (uint32) parsed,
+						(uint32) (target >> 32), (uint32) target)));
+	CheckpointStats.ckpt_sync_end_t = GetCurrentTimestamp();
+	TRACE_POSTGRESQL_BUFFER_CHECKPOINT_DONE();
+}
+
 
 /*
  * Do whatever is needed to prepare for commit at the bufmgr and smgr levels
@@ -3155,6 +4013,14 @@ DropRelFileNodeBuffers(RelFileNodeBackend rnode, ForkNumber *forkNum,
 		return;
 	}
 
+	/* Kept pages past the end aren't in buffers anymore */
+	for (j = 0; j < nforks; j++)
+	{
+		MapPageCacheDropRelation(rnode.node, forkNum[j], firstDelBlock[j]);
+		IndexPageCacheDropRelation(rnode.node, forkNum[j], firstDelBlock[j]);
+		CompressedPageCacheDropRelation(rnode.node, forkNum[j], firstDelBlock[j]);
+	}
+
 	for (i = 0; i < NBuffers; i++)
 	{
 		BufferDesc *bufHdr = GetBufferDescriptor(i);
@@ -3227,7 +4093,12 @@ DropRelFileNodesAllBuffers(RelFileNodeBackend *rnodes, int nnodes)
 				DropRelFileNodeAllLocalBuffers(rnodes[i].node);
 		}
 		else
+		{
 			nodes[n++] = rnodes[i].node;
+			MapPageCacheDropRelation(rnodes[i].node, InvalidForkNumber, 0);
+			IndexPageCacheDropRelation(rnodes[i].node, InvalidForkNumber, 0);
+			CompressedPageCacheDropRelation(rnodes[i].node, InvalidForkNumber, 0);
+		}
 	}
 
 	/*
@@ -3317,6 +4188,9 @@ DropDatabaseBuffers(Oid dbid)
 	 * We needn't consider local buffers, since by assumption the target
 	 * database isn't our own.
 	 */
+	MapPageCacheDropDatabase(dbid);
+	IndexPageCacheDropDatabase(dbid);
+	CompressedPageCacheDropDatabase(dbid);
 
 	for (i = 0; i < NBuffers; i++)
 	{
@@ -3791,6 +4665,19 @@ MarkBufferDirtyHint(Buffer buffer, bool buffer_std)
 		 * We don't check full_page_writes here because that logic is included
 		 * when we call XLogInsert() since the value changes dynamically.
 		 */
+		/*
+		 * With rpc_local_hint_bits, a compute node keeps the hints of a
+		 * permanent page in its buffer only.  The storage node rebuilds the
+		 * page from WAL without them, and whoever reads it next sets them
+		 * again, so there's no full page image to log and nothing to write
+		 * back when the buffer is evicted; as in recovery below, the page
+		 * just isn't dirtied.  A page dirtied by a real change still takes
+		 * its hints along when it's written.
+		 */
+		if (IsRpcClient && rpc_local_hint_bits &&
+			(pg_atomic_read_u32(&bufHdr->state) & BM_PERMANENT))
+			return;
+
 		if (XLogHintBitIsNeeded() &&
 			(pg_atomic_read_u32(&bufHdr->state) & BM_PERMANENT))
 		{
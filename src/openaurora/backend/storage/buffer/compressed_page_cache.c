@@ -0,0 +1,311 @@
+#include "postgres.h"
+
+#include <lz4.h>
+
+#include "common/hashfn.h"
+#include "storage/bufpage.h"
+#include "storage/compressed_page_cache.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+
+// GUC
+int compressed_page_cache_size = 0;
+
+#define CPC_NONE (-1)
+// Pages are appended at multiples of this
+#define CPC_ALIGN (64)
+// Largest compressed page kept
+#define CPC_MAX_LEN (BLCKSZ - BLCKSZ / 4)
+// Entries per block of the arena, for pages compressing up to 4x
+#define CPC_ENTRIES_PER_BLOCK (4)
+
+typedef struct CpcEntry {
+    BufferTag tag;
+    uint32 hash;
+    int next;           // in the bucket
+    bool linked;
+    bool referenced;
+    XLogRecPtr lsn;     // of the page kept
+    uint64 pos;         // where in the log it was appended
+    uint32 len;         // compressed
+} CpcEntry;
+
+typedef struct CpcCtl {
+    LWLock lock;
+    int entryNum;
+    int bucketNum;
+    int hand;
+    uint64 arenaSize;
+    uint64 head;        // where in the log the next page goes
+} CpcCtl;
+
+static CpcCtl *ctl = NULL;
+static int *buckets;
+static CpcEntry *entries;
+static char *arena;
+
+// A compressed page of this backend on its way to the arena
+static char compressBuf[LZ4_COMPRESSBOUND(BLCKSZ)];
+
+#define CpcArenaBytes() ((Size) compressed_page_cache_size * BLCKSZ)
+#define CpcEntryCount() (compressed_page_cache_size * CPC_ENTRIES_PER_BLOCK)
+
+Size CompressedPageCacheShmemSize(void) {
+    Size size = 0;
+
+    if (compressed_page_cache_size <= 0)
+        return size;
+    size = add_size(size, sizeof(CpcCtl));
+    size = add_size(size, mul_size(CpcEntryCount(), sizeof(CpcEntry)));
+    size = add_size(size, mul_size(mul_size(CpcEntryCount(), 2), sizeof(int)));
+    size = add_size(size, CpcArenaBytes());
+    return size;
+}
+
+void CompressedPageCacheShmemInit(void) {
+    bool found;
+
+    if (compressed_page_cache_size <= 0)
+        return;
+    ctl = (CpcCtl *)
+        ShmemInitStruct("Compressed Page Cache Ctl", sizeof(CpcCtl), &found);
+    entries = (CpcEntry *)
+        ShmemInitStruct("Compressed Page Cache Entries",
+                        CpcEntryCount() * sizeof(CpcEntry), &found);
+    buckets = (int *)
+        ShmemInitStruct("Compressed Page Cache Buckets",
+                        CpcEntryCount() * 2 * sizeof(int), &found);
+    arena = (char *)
+        ShmemInitStruct("Compressed Page Cache Arena", CpcArenaBytes(), &found);
+    if (found)
+        return;
+
+    LWLockInitialize(&ctl->lock, LWTRANCHE_COMPRESSED_PAGE_CACHE);
+    ctl->entryNum = CpcEntryCount();
+    ctl->bucketNum = CpcEntryCount() * 2;
+    ctl->hand = 0;
+    ctl->arenaSize = CpcArenaBytes();
+    ctl->head = 0;
+    MemSet(entries, 0, CpcEntryCount() * sizeof(CpcEntry));
+    for (int b = 0; b < ctl->bucketNum; b++)
+        buckets[b] = CPC_NONE;
+}
+
+bool CompressedPageCacheEnabled(void) {
+    return ctl != NULL;
+}
+
+static uint32 CpcHash(const BufferTag *tag) {
+    return hash_bytes((const unsigned char *) tag, sizeof(BufferTag));
+}
+
+// Caller holds the lock. Whether the head hasn't passed over the bytes of
+// the entry's page yet
+static bool CpcEntryIntact(const CpcEntry *e) {
+    return e->pos + ctl->arenaSize >= ctl->head;
+}
+
+// Caller holds the lock. Returns the entry of the page or NONE
+static int CpcFind(uint32 hash, const BufferTag *tag) {
+    int entry = buckets[hash % ctl->bucketNum];
+
+    while (entry != CPC_NONE) {
+        CpcEntry *e = &entries[entry];
+
+        if (e->hash == hash && BUFFERTAGS_EQUAL(e->tag, *tag))
+            return entry;
+        entry = e->next;
+    }
+    return CPC_NONE;
+}
+
+// Caller holds the lock exclusively
+static void CpcLink(int entry, uint32 hash, const BufferTag *tag) {
+    CpcEntry *e = &entries[entry];
+    int *bucket = &buckets[hash % ctl->bucketNum];
+
+    e->tag = *tag;
+    e->hash = hash;
+    e->next = *bucket;
+    e->linked = true;
+    *bucket = entry;
+}
+
+// Caller holds the lock exclusively
+static void CpcUnlink(int entry) {
+    CpcEntry *e = &entries[entry];
+    int *link = &buckets[e->hash % ctl->bucketNum];
+
+    if (!e->linked)
+        return;
+    while (*link != entry)
+        link = &entries[*link].next;
+    *link = e->next;
+    e->linked = false;
+}
+
+// Caller holds the lock exclusively. An entry whose page was overwritten, or
+// not referenced since the hand last passed it, is taken
+static int CpcEvict(void) {
+    for (int i = 0; i < 2 * ctl->entryNum; i++) {
+        int entry = ctl->hand;
+        CpcEntry *e = &entries[entry];
+
+        ctl->hand = (ctl->hand + 1) % ctl->entryNum;
+        if (!e->linked)
+            return entry;
+        if (e->referenced && CpcEntryIntact(e)) {
+            e->referenced = false;
+            continue;
+        }
+        CpcUnlink(entry);
+        return entry;
+    }
+    return CPC_NONE;
+}
+
+// Caller holds the lock exclusively. Appends len bytes of the log, where a
+// page doesn't wrap around the end of the arena, and returns their position
+static uint64 CpcAppend(const char *data, uint32 len) {
+    uint64 alignedLen = TYPEALIGN(CPC_ALIGN, len);
+    uint64 offset = ctl->head % ctl->arenaSize;
+    uint64 pos;
+
+    if (offset + alignedLen > ctl->arenaSize)
+        ctl->head += ctl->arenaSize - offset;
+    pos = ctl->head;
+    ctl->head += alignedLen;
+    memcpy(arena + pos % ctl->arenaSize, data, len);
+    return pos;
+}
+
+bool CompressedPageCacheGet(const BufferTag *tag, char *page) {
+    uint32 hash;
+    int entry;
+    bool kept = false;
+
+    if (!CompressedPageCacheEnabled())
+        return false;
+    hash = CpcHash(tag);
+
+    LWLockAcquire(&ctl->lock, LW_SHARED);
+    entry = CpcFind(hash, tag);
+    if (entry != CPC_NONE && CpcEntryIntact(&entries[entry])) {
+        CpcEntry *e = &entries[entry];
+
+        kept = LZ4_decompress_safe(arena + e->pos % ctl->arenaSize, page, (int) e->len, BLCKSZ) == BLCKSZ;
+        if (kept)
+            e->referenced = true;
+    }
+    LWLockRelease(&ctl->lock);
+    return kept;
+}
+
+void CompressedPageCachePut(const BufferTag *tag, const char *page) {
+    XLogRecPtr lsn = PageGetLSN((Page) page);
+    uint32 hash;
+    int entry;
+    int len;
+
+    if (!CompressedPageCacheEnabled())
+        return;
+    if (PageIsNew((Page) page)) {
+        CompressedPageCacheInvalidate(tag);
+        return;
+    }
+    hash = CpcHash(tag);
+
+    // Read and evicted again unchanged, it is kept already
+    LWLockAcquire(&ctl->lock, LW_SHARED);
+    entry = CpcFind(hash, tag);
+    if (entry != CPC_NONE && entries[entry].lsn == lsn && CpcEntryIntact(&entries[entry])) {
+        entries[entry].referenced = true;
+        LWLockRelease(&ctl->lock);
+        return;
+    }
+    LWLockRelease(&ctl->lock);
+
+    len = LZ4_compress_default(page, compressBuf, BLCKSZ, sizeof(compressBuf));
+
+    LWLockAcquire(&ctl->lock, LW_EXCLUSIVE);
+    entry = CpcFind(hash, tag);
+    if (len <= 0 || len > CPC_MAX_LEN) {
+        // What was kept of the page is older
+        if (entry != CPC_NONE)
+            CpcUnlink(entry);
+        LWLockRelease(&ctl->lock);
+        return;
+    }
+    if (entry == CPC_NONE) {
+        entry = CpcEvict();
+        if (entry == CPC_NONE) {
+            LWLockRelease(&ctl->lock);
+            return;
+        }
+        CpcLink(entry, hash, tag);
+    }
+    entries[entry].lsn = lsn;
+    entries[entry].len = (uint32) len;
+    entries[entry].pos = CpcAppend(compressBuf, (uint32) len);
+    entries[entry].referenced = true;
+    LWLockRelease(&ctl->lock);
+}
+
+void CompressedPageCacheInvalidate(const BufferTag *tag) {
+    uint32 hash;
+    int entry;
+
+    if (!CompressedPageCacheEnabled())
+        return;
+    hash = CpcHash(tag);
+
+    // Most pages invalidated aren't kept
+    LWLockAcquire(&ctl->lock, LW_SHARED);
+    entry = CpcFind(hash, tag);
+    LWLockRelease(&ctl->lock);
+    if (entry == CPC_NONE)
+        return;
+
+    LWLockAcquire(&ctl->lock, LW_EXCLUSIVE);
+    entry = CpcFind(hash, tag);
+    if (entry != CPC_NONE)
+        CpcUnlink(entry);
+    LWLockRelease(&ctl->lock);
+}
+
+void CompressedPageCacheInvalidateAll(void) {
+    if (!CompressedPageCacheEnabled())
+        return;
+
+    LWLockAcquire(&ctl->lock, LW_EXCLUSIVE);
+    for (int entry = 0; entry < ctl->entryNum; entry++)
+        CpcUnlink(entry);
+    LWLockRelease(&ctl->lock);
+}
+
+void CompressedPageCacheDropRelation(RelFileNode rnode, ForkNumber forkNum, BlockNumber firstBlock) {
+    if (!CompressedPageCacheEnabled())
+        return;
+
+    LWLockAcquire(&ctl->lock, LW_EXCLUSIVE);
+    for (int entry = 0; entry < ctl->entryNum; entry++) {
+        CpcEntry *e = &entries[entry];
+
+        if (e->linked && RelFileNodeEquals(e->tag.rnode, rnode) &&
+            (forkNum == InvalidForkNumber || (e->tag.forkNum == forkNum && e->tag.blockNum >= firstBlock)))
+            CpcUnlink(entry);
+    }
+    LWLockRelease(&ctl->lock);
+}
+
+void CompressedPageCacheDropDatabase(Oid dbid) {
+    if (!CompressedPageCacheEnabled())
+        return;
+
+    LWLockAcquire(&ctl->lock, LW_EXCLUSIVE);
+    for (int entry = 0; entry < ctl->entryNum; entry++) {
+        if (entries[entry].linked && entries[entry].tag.rnode.dbNode == dbid)
+            CpcUnlink(entry);
+    }
+    LWLockRelease(&ctl->lock);
+}
@@ -17,6 +17,7 @@
 
 #include "port/atomics.h"
 #include "storage/buf_internals.h"
+#include "storage/buf_numa.h"
 #include "storage/bufmgr.h"
 #include "storage/proc.h"
 
@@ -38,6 +39,14 @@ typedef struct
 	 */
 	pg_atomic_uint32 nextVictimBuffer;
 
+	/*
+	 * With the buffers partitioned by NUMA node, a clock hand for each
+	 * partition, which backends on its node try first. These only increase
+	 * too, and are used modulo the size of the partition.
+	 */
+	int			numaNodes;
+	pg_atomic_uint32 nodeVictimBuffer[BUF_NUMA_MAX_NODES];
+
 	int			firstFreeBuffer;	/* Head of list of unused buffers */
 	int			lastFreeBuffer; /* Tail of list of unused buffers */
 
@@ -168,6 +177,97 @@ ClockSweepTick(void)
 	return victim;
 }
 
+/*
+ * NodeClockSweepTick - ClockSweepTick() within the partition of a NUMA node
+ */
+static inline uint32
+NodeClockSweepTick(int node)
+{
+	int			first = BufNumaPartitionStart(node, StrategyControl->numaNodes);
+	int			size = BufNumaPartitionStart(node + 1, StrategyControl->numaNodes) - first;
+	uint32		victim;
+
+	victim = pg_atomic_fetch_add_u32(&StrategyControl->nodeVictimBuffer[node], 1);
+	return first + victim % size;
+}
+
+/*
+ * StrategyClockSweep - run the clock sweep until a buffer is found
+ *
+ * Over the whole pool for node < 0, where all the buffers being pinned is an
+ * error.  Within the partition of a NUMA node otherwise, where NULL is
+ * returned then.
+ */
+static BufferDesc *
+StrategyClockSweep(int node, BufferAccessStrategy strategy, uint32 *buf_state)
+{
+	BufferDesc *buf;
+	int			trycounter;
+	int			size;
+	uint32		local_buf_state;	/* to avoid repeated (de-)referencing */
+
+	if (node < 0)
+		size = NBuffers;
+	else
+		size = BufNumaPartitionStart(node + 1, StrategyControl->numaNodes) -
+			BufNumaPartitionStart(node, StrategyControl->numaNodes);
+
+	trycounter = size;
+	for (;;)
+	{
+		buf = GetBufferDescriptor(node < 0 ? ClockSweepTick() : NodeClockSweepTick(node));
+
+		/*
+		 * If the buffer is pinned or has a nonzero usage_count, we cannot use
+		 * it; decrement the usage_count (unless pinned) and keep scanning.
+		 */
+		local_buf_state = LockBufHdr(buf);
+
+		if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0)
+		{
+			if (BUF_STATE_GET_USAGECOUNT(local_buf_state) != 0)
+			{
+				/* A page dear to read again keeps its usage longer */
+				if (buf->sweep_credit > 0)
+					buf->sweep_credit--;
+				else
+				{
+					local_buf_state -= BUF_USAGECOUNT_ONE;
+					buf->sweep_credit = buf->refetch_cost;
+				}
+
+				trycounter = size;
+			}
+			else
+			{
+				/* Found a usable buffer */
+				if (strategy != NULL)
+					AddBufferToRing(strategy, buf);
+				*buf_state = local_buf_state;
+				return buf;
+			}
+		}
+		else if (--trycounter == 0)
+		{
+			UnlockBufHdr(buf, local_buf_state);
+
+			/* Another partition may have one */
+			if (node >= 0)
+				return NULL;
+
+			/*
+			 * We've scanned all the buffers without making any state changes,
+			 * so all the buffers are pinned (or were when we looked at them).
+			 * We could hope that someone will free one eventually, but it's
+			 * probably better to fail than to risk getting stuck in an
+			 * infinite loop.
+			 */
+			elog(ERROR, "no unpinned buffers available");
+		}
+		UnlockBufHdr(buf, local_buf_state);
+	}
+}
+
 /*
  * have_free_buffer -- a lockless check to see if there is a free buffer in
  *					   buffer pool.
@@ -202,7 +302,6 @@ StrategyGetBuffer(BufferAccessStrategy strategy, uint32 *buf_state)
 {
 	BufferDesc *buf;
 	int			bgwprocno;
-	int			trycounter;
 	uint32		local_buf_state;	/* to avoid repeated (de-)referencing */
 
 	/*
@@ -312,49 +411,51 @@ StrategyGetBuffer(BufferAccessStrategy strategy, uint32 *buf_state)
 		}
 	}
 
-	/* Nothing on the freelist, so run the "clock sweep" algorithm */
-	trycounter = NBuffers;
-	for (;;)
+	/*
+	 * Nothing on the freelist, so run the "clock sweep" algorithm, over the
+	 * buffers in the memory of our NUMA node first.
+	 */
+	if (StrategyControl->numaNodes > 1)
 	{
-		buf = GetBufferDescriptor(ClockSweepTick());
+		buf = StrategyClockSweep(BufNumaMyNode() % StrategyControl->numaNodes,
+								 strategy, buf_state);
+		if (buf != NULL)
+			return buf;
+	}
+	return StrategyClockSweep(-1, strategy, buf_state);
+}
 
-		/*
-		 * If the buffer is pinned or has a nonzero usage_count, we cannot use
-		 * it; decrement the usage_count (unless pinned) and keep scanning.
-		 */
-		local_buf_state = LockBufHdr(buf);
+/*
+ * StrategyRefetchCost -- how dear a page just read in is to read again
+ *
+ * In RPC mode a miss may be nearly free, or cost a network round trip plus
+ * however long the storage node takes to replay the page.  The storage node
+ * doesn't report the replay it did, so the time the read took stands in for
+ * it: pages from the mempool, or copied from an earlier batched read, cost
+ * nothing extra; a read over RPC costs one, and up to BUF_REFETCH_COST_MAX
+ * the longer it took compared with this backend's usual RPC read.
+ */
+#define BUF_REFETCH_COST_MAX	3
+#define BUF_REFETCH_LOCAL_US	20
 
-		if (BUF_STATE_GET_REFCOUNT(local_buf_state) == 0)
-		{
-			if (BUF_STATE_GET_USAGECOUNT(local_buf_state) != 0)
-			{
-				local_buf_state -= BUF_USAGECOUNT_ONE;
+uint8
+StrategyRefetchCost(bool fromMemPool, uint64 readTimeUs)
+{
+	static double avgReadTimeUs = 0;
+	uint8		cost = 1;
 
-				trycounter = NBuffers;
-			}
-			else
-			{
-				/* Found a usable buffer */
-				if (strategy != NULL)
-					AddBufferToRing(strategy, buf);
-				*buf_state = local_buf_state;
-				return buf;
-			}
-		}
-		else if (--trycounter == 0)
-		{
-			/*
-			 * We've scanned all the buffers without making any state changes,
-			 * so all the buffers are pinned (or were when we looked at them).
-			 * We could hope that someone will free one eventually, but it's
-			 * probably better to fail than to risk getting stuck in an
-			 * infinite loop.
-			 */
-			UnlockBufHdr(buf, local_buf_state);
-			elog(ERROR, "no unpinned buffers available");
-		}
-		UnlockBufHdr(buf, local_buf_state);
-	}
+	if (fromMemPool || readTimeUs < BUF_REFETCH_LOCAL_US)
+		return 0;
+
+	if (avgReadTimeUs == 0)
+		avgReadTimeUs = readTimeUs;
+	if (readTimeUs > 8 * avgReadTimeUs)
+		cost = BUF_REFETCH_COST_MAX;
+	else if (readTimeUs > 2 * avgReadTimeUs)
+		cost = 2;
+	avgReadTimeUs += (readTimeUs - avgReadTimeUs) / 64;
+
+	return cost;
 }
 
 /*
@@ -515,6 +616,11 @@ StrategyInitialize(bool init)
 		/* Initialize the clock sweep pointer */
 		pg_atomic_init_u32(&StrategyControl->nextVictimBuffer, 0);
 
+		/* And those of the NUMA partitions */
+		StrategyControl->numaNodes = Min(BufNumaNodeCount(), NBuffers);
+		for (int i = 0; i < BUF_NUMA_MAX_NODES; i++)
+			pg_atomic_init_u32(&StrategyControl->nodeVictimBuffer[i], 0);
+
 		/* Clear statistics */
 		StrategyControl->completePasses = 0;
 		pg_atomic_init_u32(&StrategyControl->numBufferAllocs, 0);
@@ -0,0 +1,423 @@
+#include "postgres.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "access/xlog.h"
+#include "common/hashfn.h"
+#include "port/pg_crc32c.h"
+#include "storage/bufpage.h"
+#include "storage/local_page_cache.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+
+// GUCs
+char *local_page_cache_path = NULL;
+int local_page_cache_size = 0;
+
+#define LOCAL_PAGE_CACHE_MAGIC (0x4C504331)
+#define LOCAL_PAGE_CACHE_NONE (-1)
+
+// The first block of the file
+typedef struct LocalPageCacheFileHeader {
+    uint32 magic;
+    uint32 blcksz;
+    uint32 slotNum;
+    uint64 systemId;
+} LocalPageCacheFileHeader;
+
+// A slot in the directory of the file, rewritten once its page is
+typedef struct LocalPageCacheEntry {
+    BufferTag tag;
+    XLogRecPtr lsn;
+    pg_crc32c crc;
+    uint32 valid;
+} LocalPageCacheEntry;
+
+typedef struct LocalPageCacheSlot {
+    LocalPageCacheEntry entry;
+    uint32 hash;
+    uint32 gen;         // bumped whenever the page is rewritten or invalidated
+    int next;           // in the bucket
+    bool linked;
+    bool busy;          // the page is being written
+    bool referenced;
+    bool current;       // not changed since it was put
+} LocalPageCacheSlot;
+
+typedef struct LocalPageCacheCtl {
+    LWLock lock;
+    int slotNum;
+    int bucketNum;
+    int hand;
+} LocalPageCacheCtl;
+
+static LocalPageCacheCtl *ctl = NULL;
+static int *buckets;
+static LocalPageCacheSlot *slots;
+static int cacheFd = -1;
+
+#define LocalPageCacheDirOffset() ((off_t) BLCKSZ)
+#define LocalPageCacheEntryOffset(slot) \
+    (LocalPageCacheDirOffset() + (off_t) (slot) * sizeof(LocalPageCacheEntry))
+#define LocalPageCachePageOffset(slotNum, slot) \
+    (LocalPageCacheDirOffset() + \
+     (off_t) TYPEALIGN(BLCKSZ, (Size) (slotNum) * sizeof(LocalPageCacheEntry)) + \
+     (off_t) (slot) * BLCKSZ)
+
+static bool LocalPageCacheConfigured(void) {
+    return local_page_cache_path != NULL && local_page_cache_path[0] != '\0' &&
+           local_page_cache_size > 0;
+}
+
+Size LocalPageCacheShmemSize(void) {
+    Size size = 0;
+
+    if (!LocalPageCacheConfigured())
+        return size;
+    size = add_size(size, sizeof(LocalPageCacheCtl));
+    size = add_size(size, mul_size(local_page_cache_size, sizeof(LocalPageCacheSlot)));
+    size = add_size(size, mul_size(mul_size(local_page_cache_size, 2), sizeof(int)));
+    return size;
+}
+
+static uint32 LocalPageCacheHash(const BufferTag *tag) {
+    return hash_bytes((const unsigned char *) tag, sizeof(BufferTag));
+}
+
+// Caller holds the lock. Returns the slot of the page or NONE
+static int LocalPageCacheFind(uint32 hash, const BufferTag *tag) {
+    int slot = buckets[hash % ctl->bucketNum];
+
+    while (slot != LOCAL_PAGE_CACHE_NONE) {
+        LocalPageCacheSlot *s = &slots[slot];
+
+        if (s->hash == hash && BUFFERTAGS_EQUAL(s->entry.tag, *tag))
+            return slot;
+        slot = s->next;
+    }
+    return LOCAL_PAGE_CACHE_NONE;
+}
+
+// Caller holds the lock exclusively
+static void LocalPageCacheLink(int slot, uint32 hash, const BufferTag *tag) {
+    LocalPageCacheSlot *s = &slots[slot];
+    int *bucket = &buckets[hash % ctl->bucketNum];
+
+    s->entry.tag = *tag;
+    s->hash = hash;
+    s->next = *bucket;
+    s->linked = true;
+    *bucket = slot;
+}
+
+// Caller holds the lock exclusively
+static void LocalPageCacheUnlink(int slot) {
+    LocalPageCacheSlot *s = &slots[slot];
+    int *link = &buckets[s->hash % ctl->bucketNum];
+
+    if (!s->linked)
+        return;
+    while (*link != slot)
+        link = &slots[*link].next;
+    *link = s->next;
+    s->linked = false;
+    s->entry.valid = 0;
+    s->current = false;
+}
+
+// Caller holds the lock exclusively. A slot not referenced since the hand
+// last passed it is taken, those being written are passed over
+static int LocalPageCacheEvict(void) {
+    for (int i = 0; i < 2 * ctl->slotNum; i++) {
+        int slot = ctl->hand;
+        LocalPageCacheSlot *s = &slots[slot];
+
+        ctl->hand = (ctl->hand + 1) % ctl->slotNum;
+        if (s->busy)
+            continue;
+        if (!s->linked)
+            return slot;
+        if (s->referenced) {
+            s->referenced = false;
+            continue;
+        }
+        LocalPageCacheUnlink(slot);
+        return slot;
+    }
+    return LOCAL_PAGE_CACHE_NONE;
+}
+
+static bool LocalPageCacheOpen(void) {
+    if (cacheFd < 0)
+        cacheFd = open(local_page_cache_path, O_RDWR | PG_BINARY, 0);
+    return cacheFd >= 0;
+}
+
+// Rebuilds the hash table from the directory of the file, or starts the
+// file over if it was made for another cache or cluster
+static void LocalPageCacheLoad(void) {
+    LocalPageCacheFileHeader header;
+    char *block = palloc0(BLCKSZ);
+    int loaded = 0;
+
+    cacheFd = open(local_page_cache_path, O_RDWR | O_CREAT | PG_BINARY, S_IRUSR | S_IWUSR);
+    if (cacheFd < 0) {
+        ereport(LOG,
+                (errcode_for_file_access(),
+                 errmsg("could not open local page cache file \"%s\": %m, the cache is disabled",
+                        local_page_cache_path)));
+        ctl->slotNum = 0;
+        pfree(block);
+        return;
+    }
+
+    if (pread(cacheFd, block, BLCKSZ, 0) == BLCKSZ)
+        memcpy(&header, block, sizeof(header));
+    else
+        MemSet(&header, 0, sizeof(header));
+
+    if (header.magic == LOCAL_PAGE_CACHE_MAGIC && header.blcksz == BLCKSZ &&
+        header.slotNum == (uint32) ctl->slotNum && header.systemId == GetSystemIdentifier()) {
+        int perBlock = BLCKSZ / sizeof(LocalPageCacheEntry);
+
+        for (int first = 0; first < ctl->slotNum; first += perBlock) {
+            LocalPageCacheEntry *entries = (LocalPageCacheEntry *) block;
+
+            if (pread(cacheFd, block, BLCKSZ, LocalPageCacheEntryOffset(first)) <= 0)
+                break;
+            for (int i = 0; i < perBlock && first + i < ctl->slotNum; i++) {
+                uint32 hash;
+                int other;
+
+                if (!entries[i].valid)
+                    continue;
+                // A page forgotten by a crash may be in the file twice
+                hash = LocalPageCacheHash(&entries[i].tag);
+                other = LocalPageCacheFind(hash, &entries[i].tag);
+                if (other != LOCAL_PAGE_CACHE_NONE) {
+                    if (slots[other].entry.lsn >= entries[i].lsn)
+                        continue;
+                    LocalPageCacheUnlink(other);
+                    loaded--;
+                }
+                LocalPageCacheLink(first + i, hash, &entries[i].tag);
+                slots[first + i].entry = entries[i];
+                loaded++;
+            }
+        }
+    } else {
+        header.magic = LOCAL_PAGE_CACHE_MAGIC;
+        header.blcksz = BLCKSZ;
+        header.slotNum = ctl->slotNum;
+        header.systemId = GetSystemIdentifier();
+        MemSet(block, 0, BLCKSZ);
+        memcpy(block, &header, sizeof(header));
+        // Truncating first zeroes the directory
+        if (ftruncate(cacheFd, 0) != 0 ||
+            ftruncate(cacheFd, LocalPageCachePageOffset(ctl->slotNum, ctl->slotNum)) != 0 ||
+            pwrite(cacheFd, block, BLCKSZ, 0) != BLCKSZ) {
+            ereport(LOG,
+                    (errcode_for_file_access(),
+                     errmsg("could not initialize local page cache file \"%s\": %m, the cache is disabled",
+                            local_page_cache_path)));
+            ctl->slotNum = 0;
+        }
+    }
+    if (ctl->slotNum > 0)
+        ereport(LOG,
+                (errmsg("local page cache \"%s\" has %d of %d pages",
+                        local_page_cache_path, loaded, ctl->slotNum)));
+    pfree(block);
+}
+
+void LocalPageCacheShmemInit(void) {
+    bool found;
+
+    if (!LocalPageCacheConfigured())
+        return;
+    ctl = (LocalPageCacheCtl *)
+        ShmemInitStruct("Local Page Cache Ctl", sizeof(LocalPageCacheCtl), &found);
+    slots = (LocalPageCacheSlot *)
+        ShmemInitStruct("Local Page Cache Slots",
+                        local_page_cache_size * sizeof(LocalPageCacheSlot), &found);
+    buckets = (int *)
+        ShmemInitStruct("Local Page Cache Buckets",
+                        local_page_cache_size * 2 * sizeof(int), &found);
+    if (found)
+        return;
+
+    LWLockInitialize(&ctl->lock, LWTRANCHE_LOCAL_PAGE_CACHE);
+    ctl->slotNum = local_page_cache_size;
+    ctl->bucketNum = local_page_cache_size * 2;
+    ctl->hand = 0;
+    MemSet(slots, 0, local_page_cache_size * sizeof(LocalPageCacheSlot));
+    for (int b = 0; b < ctl->bucketNum; b++)
+        buckets[b] = LOCAL_PAGE_CACHE_NONE;
+    LocalPageCacheLoad();
+}
+
+bool LocalPageCacheEnabled(void) {
+    return ctl != NULL && ctl->slotNum > 0;
+}
+
+// The page turned out to be torn or lost, it is dropped unless rewritten
+// since gen
+static void LocalPageCacheForget(int slot, uint32 gen) {
+    LocalPageCacheEntry entry;
+
+    LWLockAcquire(&ctl->lock, LW_EXCLUSIVE);
+    if (slots[slot].gen != gen || slots[slot].busy) {
+        LWLockRelease(&ctl->lock);
+        return;
+    }
+    LocalPageCacheUnlink(slot);
+    entry = slots[slot].entry;
+    LWLockRelease(&ctl->lock);
+    (void) pwrite(cacheFd, &entry, sizeof(entry), LocalPageCacheEntryOffset(slot));
+}
+
+bool LocalPageCacheGet(const BufferTag *tag, char *page, bool *current) {
+    uint32 hash;
+    uint32 gen;
+    pg_crc32c crc;
+    pg_crc32c pageCrc;
+    int slot;
+
+    if (!LocalPageCacheEnabled() || !LocalPageCacheOpen())
+        return false;
+    hash = LocalPageCacheHash(tag);
+
+    LWLockAcquire(&ctl->lock, LW_SHARED);
+    slot = LocalPageCacheFind(hash, tag);
+    if (slot == LOCAL_PAGE_CACHE_NONE || slots[slot].busy || !slots[slot].entry.valid) {
+        LWLockRelease(&ctl->lock);
+        return false;
+    }
+    slots[slot].referenced = true;
+    gen = slots[slot].gen;
+    crc = slots[slot].entry.crc;
+    *current = slots[slot].current;
+    LWLockRelease(&ctl->lock);
+
+    if (pread(cacheFd, page, BLCKSZ, LocalPageCachePageOffset(ctl->slotNum, slot)) != BLCKSZ) {
+        LocalPageCacheForget(slot, gen);
+        return false;
+    }
+    INIT_CRC32C(pageCrc);
+    COMP_CRC32C(pageCrc, page, BLCKSZ);
+    FIN_CRC32C(pageCrc);
+
+    // A slot rewritten or invalidated during the read is lost for this time
+    LWLockAcquire(&ctl->lock, LW_SHARED);
+    if (slots[slot].gen != gen) {
+        LWLockRelease(&ctl->lock);
+        return false;
+    }
+    LWLockRelease(&ctl->lock);
+    if (!EQ_CRC32C(pageCrc, crc)) {
+        LocalPageCacheForget(slot, gen);
+        return false;
+    }
+    return true;
+}
+
+void LocalPageCachePut(const BufferTag *tag, const char *page) {
+    XLogRecPtr lsn = PageGetLSN((Page) page);
+    LocalPageCacheEntry entry;
+    uint32 hash;
+    uint32 gen;
+    int slot;
+    bool written;
+
+    if (!LocalPageCacheEnabled() || !LocalPageCacheOpen())
+        return;
+    hash = LocalPageCacheHash(tag);
+
+    LWLockAcquire(&ctl->lock, LW_EXCLUSIVE);
+    slot = LocalPageCacheFind(hash, tag);
+    if (slot != LOCAL_PAGE_CACHE_NONE) {
+        // Already there, or being written by another backend. The same
+        // version differs at most in hint bits
+        if (slots[slot].busy || (slots[slot].entry.valid && slots[slot].entry.lsn == lsn)) {
+            slots[slot].referenced = true;
+            if (!slots[slot].busy)
+                slots[slot].current = true;
+            LWLockRelease(&ctl->lock);
+            return;
+        }
+    } else {
+        slot = LocalPageCacheEvict();
+        if (slot == LOCAL_PAGE_CACHE_NONE) {
+            LWLockRelease(&ctl->lock);
+            return;
+        }
+        LocalPageCacheLink(slot, hash, tag);
+    }
+    slots[slot].entry.valid = 0;
+    slots[slot].current = false;
+    slots[slot].busy = true;
+    gen = ++slots[slot].gen;
+    LWLockRelease(&ctl->lock);
+
+    entry.tag = *tag;
+    entry.lsn = lsn;
+    entry.valid = 1;
+    INIT_CRC32C(entry.crc);
+    COMP_CRC32C(entry.crc, page, BLCKSZ);
+    FIN_CRC32C(entry.crc);
+    written = pwrite(cacheFd, page, BLCKSZ, LocalPageCachePageOffset(ctl->slotNum, slot)) == BLCKSZ;
+    // The directory entry may reach the disk before the page or not at all,
+    // the CRC tells
+    if (written)
+        written = pwrite(cacheFd, &entry, sizeof(entry), LocalPageCacheEntryOffset(slot)) == sizeof(entry);
+
+    LWLockAcquire(&ctl->lock, LW_EXCLUSIVE);
+    slots[slot].busy = false;
+    if (written) {
+        slots[slot].entry = entry;
+        slots[slot].referenced = true;
+        // Unless it was invalidated while being written
+        slots[slot].current = slots[slot].gen == gen;
+    } else
+        LocalPageCacheUnlink(slot);
+    LWLockRelease(&ctl->lock);
+}
+
+void LocalPageCacheInvalidate(const BufferTag *tag) {
+    uint32 hash;
+    int slot;
+
+    if (!LocalPageCacheEnabled())
+        return;
+    hash = LocalPageCacheHash(tag);
+
+    // Most pages invalidated aren't kept, or already not current
+    LWLockAcquire(&ctl->lock, LW_SHARED);
+    slot = LocalPageCacheFind(hash, tag);
+    if (slot == LOCAL_PAGE_CACHE_NONE ||
+        (!slots[slot].busy && !slots[slot].current)) {
+        LWLockRelease(&ctl->lock);
+        return;
+    }
+    LWLockRelease(&ctl->lock);
+
+    LWLockAcquire(&ctl->lock, LW_EXCLUSIVE);
+    slot = LocalPageCacheFind(hash, tag);
+    if (slot != LOCAL_PAGE_CACHE_NONE) {
+        slots[slot].current = false;
+        slots[slot].gen++;
+    }
+    LWLockRelease(&ctl->lock);
+}
+
+void LocalPageCacheInvalidateAll(void) {
+    if (!LocalPageCacheEnabled())
+        return;
+
+    LWLockAcquire(&ctl->lock, LW_EXCLUSIVE);
+    for (int slot = 0; slot < ctl->slotNum; slot++) {
+        slots[slot].current = false;
+        slots[slot].gen++;
+    }
+    LWLockRelease(&ctl->lock);
+}
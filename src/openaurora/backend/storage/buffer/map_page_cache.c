@@ -0,0 +1,356 @@
+#include "postgres.h"
+
+#include "access/nbtree.h"
+#include "access/visibilitymap.h"
+#include "common/hashfn.h"
+#include "storage/lwlock.h"
+#include "storage/map_page_cache.h"
+#include "storage/shmem.h"
+
+// GUCs
+int map_page_cache_size = 0;
+int index_page_cache_size = 0;
+
+#define MAP_PAGE_CACHE_NONE (-1)
+
+typedef struct MapPageCacheSlot {
+    BufferTag tag;
+    uint32 hash;
+    int next;           // in the bucket
+    bool linked;
+    bool referenced;
+} MapPageCacheSlot;
+
+typedef struct MapPageCacheCtl {
+    LWLock lock;
+    int slotNum;
+    int bucketNum;
+    int hand;
+} MapPageCacheCtl;
+
+// The map page cache and the index page cache are two of these, each in
+// shared memory of its own
+typedef struct PageCache {
+    MapPageCacheCtl *ctl;
+    int *buckets;
+    MapPageCacheSlot *slots;
+    char *pages;
+} PageCache;
+
+static PageCache mapCache;
+static PageCache indexCache;
+
+#define PageCachePage(cache, slot) ((cache)->pages + (Size) (slot) * BLCKSZ)
+
+static Size PageCacheShmemSize(int size) {
+    Size total = 0;
+
+    if (size <= 0)
+        return total;
+    total = add_size(total, sizeof(MapPageCacheCtl));
+    total = add_size(total, mul_size(size, sizeof(MapPageCacheSlot)));
+    total = add_size(total, mul_size(mul_size(size, 2), sizeof(int)));
+    total = add_size(total, mul_size(size, BLCKSZ));
+    return total;
+}
+
+static void PageCacheShmemInit(PageCache *cache, const char *name, int size, int trancheId) {
+    char structName[SHMEM_INDEX_KEYSIZE];
+    bool found;
+
+    if (size <= 0)
+        return;
+    snprintf(structName, sizeof(structName), "%s Ctl", name);
+    cache->ctl = (MapPageCacheCtl *) ShmemInitStruct(structName, sizeof(MapPageCacheCtl), &found);
+    snprintf(structName, sizeof(structName), "%s Slots", name);
+    cache->slots = (MapPageCacheSlot *) ShmemInitStruct(structName, size * sizeof(MapPageCacheSlot), &found);
+    snprintf(structName, sizeof(structName), "%s Buckets", name);
+    cache->buckets = (int *) ShmemInitStruct(structName, size * 2 * sizeof(int), &found);
+    snprintf(structName, sizeof(structName), "%s Pages", name);
+    cache->pages = (char *) ShmemInitStruct(structName, (Size) size * BLCKSZ, &found);
+    if (found)
+        return;
+
+    LWLockInitialize(&cache->ctl->lock, trancheId);
+    cache->ctl->slotNum = size;
+    cache->ctl->bucketNum = size * 2;
+    cache->ctl->hand = 0;
+    MemSet(cache->slots, 0, size * sizeof(MapPageCacheSlot));
+    for (int b = 0; b < cache->ctl->bucketNum; b++)
+        cache->buckets[b] = MAP_PAGE_CACHE_NONE;
+}
+
+static uint32 MapPageCacheHash(const BufferTag *tag) {
+    return hash_bytes((const unsigned char *) tag, sizeof(BufferTag));
+}
+
+// Caller holds the lock. Returns the slot of the page or NONE
+static int PageCacheFind(PageCache *cache, uint32 hash, const BufferTag *tag) {
+    int slot = cache->buckets[hash % cache->ctl->bucketNum];
+
+    while (slot != MAP_PAGE_CACHE_NONE) {
+        MapPageCacheSlot *s = &cache->slots[slot];
+
+        if (s->hash == hash && BUFFERTAGS_EQUAL(s->tag, *tag))
+            return slot;
+        slot = s->next;
+    }
+    return MAP_PAGE_CACHE_NONE;
+}
+
+// Caller holds the lock exclusively
+static void PageCacheLink(PageCache *cache, int slot, uint32 hash, const BufferTag *tag) {
+    MapPageCacheSlot *s = &cache->slots[slot];
+    int *bucket = &cache->buckets[hash % cache->ctl->bucketNum];
+
+    s->tag = *tag;
+    s->hash = hash;
+    s->next = *bucket;
+    s->linked = true;
+    *bucket = slot;
+}
+
+// Caller holds the lock exclusively
+static void PageCacheUnlink(PageCache *cache, int slot) {
+    MapPageCacheSlot *s = &cache->slots[slot];
+    int *link = &cache->buckets[s->hash % cache->ctl->bucketNum];
+
+    if (!s->linked)
+        return;
+    while (*link != slot)
+        link = &cache->slots[*link].next;
+    *link = s->next;
+    s->linked = false;
+}
+
+// Caller holds the lock exclusively. A slot not referenced since the hand
+// last passed it is taken
+static int PageCacheEvict(PageCache *cache) {
+    MapPageCacheCtl *ctl = cache->ctl;
+
+    for (int i = 0; i < 2 * ctl->slotNum; i++) {
+        int slot = ctl->hand;
+        MapPageCacheSlot *s = &cache->slots[slot];
+
+        ctl->hand = (ctl->hand + 1) % ctl->slotNum;
+        if (!s->linked)
+            return slot;
+        if (s->referenced) {
+            s->referenced = false;
+            continue;
+        }
+        PageCacheUnlink(cache, slot);
+        return slot;
+    }
+    return MAP_PAGE_CACHE_NONE;
+}
+
+static bool PageCacheGet(PageCache *cache, const BufferTag *tag, char *page) {
+    uint32 hash = MapPageCacheHash(tag);
+    int slot;
+
+    LWLockAcquire(&cache->ctl->lock, LW_SHARED);
+    slot = PageCacheFind(cache, hash, tag);
+    if (slot == MAP_PAGE_CACHE_NONE) {
+        LWLockRelease(&cache->ctl->lock);
+        return false;
+    }
+    cache->slots[slot].referenced = true;
+    memcpy(page, PageCachePage(cache, slot), BLCKSZ);
+    LWLockRelease(&cache->ctl->lock);
+    return true;
+}
+
+static void PageCachePut(PageCache *cache, const BufferTag *tag, const char *page) {
+    uint32 hash = MapPageCacheHash(tag);
+    int slot;
+
+    LWLockAcquire(&cache->ctl->lock, LW_EXCLUSIVE);
+    slot = PageCacheFind(cache, hash, tag);
+    if (slot == MAP_PAGE_CACHE_NONE) {
+        slot = PageCacheEvict(cache);
+        if (slot == MAP_PAGE_CACHE_NONE) {
+            LWLockRelease(&cache->ctl->lock);
+            return;
+        }
+        PageCacheLink(cache, slot, hash, tag);
+    }
+    cache->slots[slot].referenced = true;
+    memcpy(PageCachePage(cache, slot), page, BLCKSZ);
+    LWLockRelease(&cache->ctl->lock);
+}
+
+static void PageCacheInvalidate(PageCache *cache, const BufferTag *tag) {
+    uint32 hash = MapPageCacheHash(tag);
+    int slot;
+
+    // Most pages invalidated aren't kept
+    LWLockAcquire(&cache->ctl->lock, LW_SHARED);
+    slot = PageCacheFind(cache, hash, tag);
+    LWLockRelease(&cache->ctl->lock);
+    if (slot == MAP_PAGE_CACHE_NONE)
+        return;
+
+    LWLockAcquire(&cache->ctl->lock, LW_EXCLUSIVE);
+    slot = PageCacheFind(cache, hash, tag);
+    if (slot != MAP_PAGE_CACHE_NONE)
+        PageCacheUnlink(cache, slot);
+    LWLockRelease(&cache->ctl->lock);
+}
+
+static void PageCacheInvalidateAll(PageCache *cache) {
+    LWLockAcquire(&cache->ctl->lock, LW_EXCLUSIVE);
+    for (int slot = 0; slot < cache->ctl->slotNum; slot++)
+        PageCacheUnlink(cache, slot);
+    LWLockRelease(&cache->ctl->lock);
+}
+
+static void PageCacheDropRelation(PageCache *cache, RelFileNode rnode, ForkNumber forkNum, BlockNumber firstBlock) {
+    LWLockAcquire(&cache->ctl->lock, LW_EXCLUSIVE);
+    for (int slot = 0; slot < cache->ctl->slotNum; slot++) {
+        MapPageCacheSlot *s = &cache->slots[slot];
+
+        if (s->linked && RelFileNodeEquals(s->tag.rnode, rnode) &&
+            (forkNum == InvalidForkNumber || (s->tag.forkNum == forkNum && s->tag.blockNum >= firstBlock)))
+            PageCacheUnlink(cache, slot);
+    }
+    LWLockRelease(&cache->ctl->lock);
+}
+
+static void PageCacheDropDatabase(PageCache *cache, Oid dbid) {
+    LWLockAcquire(&cache->ctl->lock, LW_EXCLUSIVE);
+    for (int slot = 0; slot < cache->ctl->slotNum; slot++) {
+        if (cache->slots[slot].linked && cache->slots[slot].tag.rnode.dbNode == dbid)
+            PageCacheUnlink(cache, slot);
+    }
+    LWLockRelease(&cache->ctl->lock);
+}
+
+Size MapPageCacheShmemSize(void) {
+    return PageCacheShmemSize(map_page_cache_size);
+}
+
+void MapPageCacheShmemInit(void) {
+    PageCacheShmemInit(&mapCache, "Map Page Cache", map_page_cache_size, LWTRANCHE_MAP_PAGE_CACHE);
+}
+
+bool MapPageCacheEnabled(void) {
+    return mapCache.ctl != NULL;
+}
+
+bool MapPageCacheGet(const BufferTag *tag, char *page) {
+    if (!MapPageCacheEnabled() || !MapPageCacheFork(tag->forkNum))
+        return false;
+    return PageCacheGet(&mapCache, tag, page);
+}
+
+void MapPageCachePut(const BufferTag *tag, const char *page) {
+    if (!MapPageCacheEnabled() || !MapPageCacheFork(tag->forkNum))
+        return;
+    PageCachePut(&mapCache, tag, page);
+}
+
+void MapPageCacheInvalidate(const BufferTag *tag) {
+    if (!MapPageCacheEnabled() || !MapPageCacheFork(tag->forkNum))
+        return;
+    PageCacheInvalidate(&mapCache, tag);
+}
+
+void MapPageCacheInvalidateRedo(const BufferTag *tag) {
+    BufferTag mapTag;
+
+    if (!MapPageCacheEnabled())
+        return;
+    if (tag->forkNum != MAIN_FORKNUM) {
+        MapPageCacheInvalidate(tag);
+        return;
+    }
+    // The record may have cleared the heap block's bits; that of an index
+    // block is of no page
+    INIT_BUFFERTAG(mapTag, tag->rnode, VISIBILITYMAP_FORKNUM, HEAPBLK_TO_MAPBLOCK(tag->blockNum));
+    MapPageCacheInvalidate(&mapTag);
+}
+
+void MapPageCacheInvalidateAll(void) {
+    if (!MapPageCacheEnabled())
+        return;
+    PageCacheInvalidateAll(&mapCache);
+}
+
+void MapPageCacheDropRelation(RelFileNode rnode, ForkNumber forkNum, BlockNumber firstBlock) {
+    if (!MapPageCacheEnabled() || (forkNum != InvalidForkNumber && !MapPageCacheFork(forkNum)))
+        return;
+    PageCacheDropRelation(&mapCache, rnode, forkNum, firstBlock);
+}
+
+void MapPageCacheDropDatabase(Oid dbid) {
+    if (!MapPageCacheEnabled())
+        return;
+    PageCacheDropDatabase(&mapCache, dbid);
+}
+
+Size IndexPageCacheShmemSize(void) {
+    return PageCacheShmemSize(index_page_cache_size);
+}
+
+void IndexPageCacheShmemInit(void) {
+    PageCacheShmemInit(&indexCache, "Index Page Cache", index_page_cache_size, LWTRANCHE_INDEX_PAGE_CACHE);
+}
+
+bool IndexPageCacheEnabled(void) {
+    return indexCache.ctl != NULL;
+}
+
+// A B-tree page has no page id at the end of its special space, its cycle
+// id stays below those of the hash and GiST pages of the same special size
+static bool IndexPageIsUpper(const char *page) {
+    BTPageOpaque opaque;
+
+    if (PageIsNew((Page) page) ||
+        PageGetSpecialSize((Page) page) != MAXALIGN(sizeof(BTPageOpaqueData)))
+        return false;
+    opaque = (BTPageOpaque) PageGetSpecialPointer((Page) page);
+    return opaque->btpo_cycleid <= MAX_BT_CYCLE_ID && !P_ISLEAF(opaque) && !P_IGNORE(opaque);
+}
+
+bool IndexPageCacheGet(const BufferTag *tag, char *page) {
+    if (!IndexPageCacheEnabled() || tag->forkNum != MAIN_FORKNUM)
+        return false;
+    return PageCacheGet(&indexCache, tag, page);
+}
+
+bool IndexPageCachePut(const BufferTag *tag, const char *page) {
+    if (!IndexPageCacheEnabled() || tag->forkNum != MAIN_FORKNUM)
+        return false;
+    // A page kept before may have been split off as a leaf or deleted since
+    if (!IndexPageIsUpper(page)) {
+        PageCacheInvalidate(&indexCache, tag);
+        return false;
+    }
+    PageCachePut(&indexCache, tag, page);
+    return true;
+}
+
+void IndexPageCacheInvalidate(const BufferTag *tag) {
+    if (!IndexPageCacheEnabled() || tag->forkNum != MAIN_FORKNUM)
+        return;
+    PageCacheInvalidate(&indexCache, tag);
+}
+
+void IndexPageCacheInvalidateAll(void) {
+    if (!IndexPageCacheEnabled())
+        return;
+    PageCacheInvalidateAll(&indexCache);
+}
+
+void IndexPageCacheDropRelation(RelFileNode rnode, ForkNumber forkNum, BlockNumber firstBlock) {
+    if (!IndexPageCacheEnabled() || (forkNum != InvalidForkNumber && forkNum != MAIN_FORKNUM))
+        return;
+    PageCacheDropRelation(&indexCache, rnode, forkNum, firstBlock);
+}
+
+void IndexPageCacheDropDatabase(Oid dbid) {
+    if (!IndexPageCacheEnabled())
+        return;
+    PageCacheDropDatabase(&indexCache, dbid);
+}
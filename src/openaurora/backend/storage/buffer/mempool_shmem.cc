@@ -1,9 +1,13 @@
 #include <chrono>
 #include "postgres.h"
 #include "storage/GroundDB/mempool_shmem.h"
+#include "miscadmin.h"
+#include "storage/proc.h"
+#include "utils/timestamp.h"
 #include "utils/DSMEngine/hash.h"
 
 LWLock *mempool_client_lw_lock;
+LWLockPadded *mempool_client_version_map_locks;
 size_t *node_id_cnt;
 
 std::chrono::steady_clock::time_point *last_sync_pat;
@@ -18,6 +22,18 @@ HTAB *mpc_pid_to_idx;
 HTAB_VM *version_map;
 size_t *update_vm_info_ptr;
 
+uint8 *mpc_admission_sketch;
+uint64 *mpc_admission_sketch_adds;
+
+MemPoolFlushSlot *mpc_flush_ring;
+uint64 *mpc_flush_ring_head, *mpc_flush_ring_tail;
+bool *mpc_flush_daemon_running;
+
+MemPoolStatSlot *mpc_stat_slots;
+TimestampTz *mpc_stat_reset_time;
+// A slot per PGPROC, and one more for the processes without one
+#define MEMPOOL_STAT_SLOTS (MaxBackends + NUM_AUXILIARY_PROCS + 1)
+
 bool *is_first_mpc, *is_first_mpc_connection;
 
 void* ShmemInitStruct(char* name, size_t size, bool& found_any, bool& found_all){
@@ -36,6 +52,10 @@ void MemPoolClientShmemInit(){
 		ShmemInitStruct("MemPool Client lwlock",
 						NUMBER_OF_mempool_client_lw_lock * sizeof(LWLock),
 						found_any, found_all);
+	mempool_client_version_map_locks = (LWLockPadded *)
+		ShmemInitStruct("MemPool Client VersionMap partition locks",
+						NUM_VERSION_MAP_PARTITIONS * sizeof(LWLockPadded),
+						found_any, found_all);
 	node_id_cnt = (size_t*)
 		ShmemInitStruct("MemPool Client node ID counter",
 						sizeof(size_t),
@@ -100,14 +120,47 @@ void MemPoolClientShmemInit(){
     MemSet(&info_vm, 0, sizeof(info_vm));
 	info_vm.hash = info.hash;
 	info_vm.match = info.match;
+	info_vm.num_partitions = NUM_VERSION_MAP_PARTITIONS;
 	version_map =
 		ShmemInitVersionMap("MemPool Client VersionMap",
 						1 << 18, 1 << 20,
-						&info_vm, HASH_ELEM | HASH_BLOBS | HASH_FUNCTION | HASH_COMPARE);
+						&info_vm, HASH_ELEM | HASH_BLOBS | HASH_PARTITION | HASH_FUNCTION | HASH_COMPARE);
 	update_vm_info_ptr = (size_t*)
 		ShmemInitStruct("MemPool Client VersionMap Info Pointer",
 						sizeof(size_t),
 						found_any, found_all);
+	mpc_admission_sketch = (uint8*)
+		ShmemInitStruct("MemPool Client admission sketch",
+						MEMPOOL_SKETCH_DEPTH * MEMPOOL_SKETCH_WIDTH,
+						found_any, found_all);
+	mpc_admission_sketch_adds = (uint64*)
+		ShmemInitStruct("MemPool Client admission sketch additions",
+						sizeof(uint64),
+						found_any, found_all);
+	mpc_flush_ring = (MemPoolFlushSlot*)
+		ShmemInitStruct("MemPool Client flush ring",
+						MEMPOOL_FLUSH_RING_SIZE * sizeof(MemPoolFlushSlot),
+						found_any, found_all);
+	mpc_flush_ring_head = (uint64*)
+		ShmemInitStruct("MemPool Client flush ring head",
+						sizeof(uint64),
+						found_any, found_all);
+	mpc_flush_ring_tail = (uint64*)
+		ShmemInitStruct("MemPool Client flush ring tail",
+						sizeof(uint64),
+						found_any, found_all);
+	mpc_flush_daemon_running = (bool*)
+		ShmemInitStruct("MemPool Client flush daemon flag",
+						sizeof(bool),
+						found_any, found_all);
+	mpc_stat_slots = (MemPoolStatSlot*)
+		ShmemInitStruct("MemPool Client stat slots",
+						MEMPOOL_STAT_SLOTS * sizeof(MemPoolStatSlot),
+						found_any, found_all);
+	mpc_stat_reset_time = (TimestampTz*)
+		ShmemInitStruct("MemPool Client stat reset time",
+						sizeof(TimestampTz),
+						found_any, found_all);
 
 	if (found_any){
 		/* should find all of these, or none of them */
@@ -116,10 +169,20 @@ void MemPoolClientShmemInit(){
 	else{
 		for(int i = 0; i < NUMBER_OF_mempool_client_lw_lock; i++)
 			LWLockInitialize(&mempool_client_lw_lock[i], LWTRANCHE_MEMPOOL_CLIENT);
+		for(int i = 0; i < NUM_VERSION_MAP_PARTITIONS; i++)
+			LWLockInitialize(&mempool_client_version_map_locks[i].lock, LWTRANCHE_MEMPOOL_VERSION_MAP);
 		*node_id_cnt = 0;
 		*last_sync_pat = std::chrono::steady_clock::now();
 		*is_first_mpc = true;
 		*mpLocalCnt = *mpMemCnt = *mpStoCnt = 0;
+		MemSet(mpc_admission_sketch, 0, MEMPOOL_SKETCH_DEPTH * MEMPOOL_SKETCH_WIDTH);
+		*mpc_admission_sketch_adds = 0;
+		for(size_t i = 0; i < MEMPOOL_FLUSH_RING_SIZE; i++)
+			mpc_flush_ring[i].seq = i;
+		*mpc_flush_ring_head = *mpc_flush_ring_tail = 0;
+		*mpc_flush_daemon_running = false;
+		MemSet(mpc_stat_slots, 0, MEMPOOL_STAT_SLOTS * sizeof(MemPoolStatSlot));
+		*mpc_stat_reset_time = GetCurrentTimestamp();
 	}
 }
 
@@ -131,6 +194,8 @@ Size MemPoolClientShmemSize(void)
 
 	size = add_size(size, mul_size(NUMBER_OF_mempool_client_lw_lock, sizeof(LWLock)));
 
+	size = add_size(size, mul_size(NUM_VERSION_MAP_PARTITIONS, sizeof(LWLockPadded)));
+
 	size = add_size(size, sizeof(size_t));
 
 	size = add_size(size, sizeof(std::chrono::steady_clock::time_point));
@@ -159,9 +224,69 @@ Size MemPoolClientShmemSize(void)
 
 	size = add_size(size, sizeof(size_t));
 
+	size = add_size(size, mul_size(MEMPOOL_SKETCH_DEPTH, MEMPOOL_SKETCH_WIDTH));
+
+	size = add_size(size, sizeof(uint64));
+
+	size = add_size(size, mul_size(MEMPOOL_FLUSH_RING_SIZE, sizeof(MemPoolFlushSlot)));
+
+	size = add_size(size, mul_size(2, sizeof(uint64)));
+
+	size = add_size(size, sizeof(bool));
+
+	size = add_size(size, mul_size(MEMPOOL_STAT_SLOTS, sizeof(MemPoolStatSlot)));
+
+	size = add_size(size, sizeof(TimestampTz));
+
 	return size;
 }
 
+static MemPoolStatSlot* MemPoolStatMySlot(){
+	if(MyProc == NULL)
+		return &mpc_stat_slots[MEMPOOL_STAT_SLOTS - 1];
+	return &mpc_stat_slots[MyProc->pgprocno];
+}
+
+void MemPoolStatCount(MemPoolStatCounter counter, uint64 n){
+	if(mpc_stat_slots == NULL)
+		return;
+	__atomic_fetch_add(&MemPoolStatMySlot()->counters[counter], n, __ATOMIC_RELAXED);
+}
+
+void MemPoolStatReadLatency(uint64 us){
+	int bucket = 0;
+	if(mpc_stat_slots == NULL)
+		return;
+	while(bucket < MEMPOOL_STAT_READ_LATENCY_BUCKETS - 1 && us >= (2ull << bucket))
+		bucket++;
+	MemPoolStatSlot* slot = MemPoolStatMySlot();
+	__atomic_fetch_add(&slot->read_latency[bucket], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&slot->counters[MEMPOOL_STAT_READ_TIME_US], us, __ATOMIC_RELAXED);
+}
+
+void MemPoolStatCollect(MemPoolStatSlot* sum){
+	MemSet(sum, 0, sizeof(MemPoolStatSlot));
+	for(int i = 0; i < MEMPOOL_STAT_SLOTS; i++){
+		for(int c = 0; c < NUM_MEMPOOL_STAT_COUNTERS; c++)
+			sum->counters[c] += __atomic_load_n(&mpc_stat_slots[i].counters[c], __ATOMIC_RELAXED);
+		for(int b = 0; b < MEMPOOL_STAT_READ_LATENCY_BUCKETS; b++)
+			sum->read_latency[b] += __atomic_load_n(&mpc_stat_slots[i].read_latency[b], __ATOMIC_RELAXED);
+	}
+}
+
+// A count racing with the reset may survive it, which is fine for stats
+void MemPoolStatReset(){
+	for(int i = 0; i < MEMPOOL_STAT_SLOTS; i++){
+		for(int c = 0; c < NUM_MEMPOOL_STAT_COUNTERS; c++)
+			__atomic_store_n(&mpc_stat_slots[i].counters[c], 0, __ATOMIC_RELAXED);
+		for(int b = 0; b < MEMPOOL_STAT_READ_LATENCY_BUCKETS; b++)
+			__atomic_store_n(&mpc_stat_slots[i].read_latency[b], 0, __ATOMIC_RELAXED);
+	}
+	LWLockAcquire(mempool_client_stat_lock, LW_EXCLUSIVE);
+	*mpc_stat_reset_time = GetCurrentTimestamp();
+	LWLockRelease(mempool_client_stat_lock);
+}
+
 size_t get_MemPoolClient_node_id(){
 	size_t id = *node_id_cnt;
 	*node_id_cnt += 2;
@@ -0,0 +1,213 @@
+/*-------------------------------------------------------------------------
+ *
+ * cpu_roles.c
+ *		CPU placement of the storage node's threads, by what they do
+ *
+ * The storage node runs the WAL parse, the redo processes, the page
+ * service, the background replayers and RocksDB's flushes and compactions
+ * side by side. Left to the scheduler a compaction burst takes the core the
+ * parse runs on, and every read waiting in WaitParse waits with it. See
+ * storage/cpu_roles.h for the configuration.
+ *
+ * Only affinity masks are used, so no privileges or cgroup setup are
+ * needed: Linux threads and forked processes start with the mask of their
+ * creator, so binding the process to "other" first keeps later threads,
+ * RocksDB's included, off the dedicated CPUs. CpuRolesInit runs before any
+ * thread is started and the masks are only read afterwards.
+ *
+ * IDENTIFICATION
+ *		src/backend/storage/cpu_roles.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+#include <stdlib.h>
+#include <string.h>
+
+#include "storage/cpu_roles.h"
+
+#ifdef __linux__
+
+static const char *const role_names[CPU_ROLES] = {
+	"other", "parse", "redo", "rpc", "replay", "compaction"
+};
+
+static cpu_set_t role_cpus[CPU_ROLES];
+static bool role_given[CPU_ROLES];
+static bool roles_enabled = false;
+
+/* Adds the CPUs of list, "0-3,8", to set; false if it doesn't parse */
+static bool
+cpu_roles_parse_list(const char *list, cpu_set_t *set)
+{
+	const char *p = list;
+
+	while (*p != '\0')
+	{
+		char	   *end;
+		long		from = strtol(p, &end, 10);
+		long		to = from;
+
+		if (end == p || from < 0)
+			return false;
+		p = end;
+		if (*p == '-')
+		{
+			p++;
+			to = strtol(p, &end, 10);
+			if (end == p || to < from)
+				return false;
+			p = end;
+		}
+		for (long cpu = from; cpu <= to && cpu < CPU_SETSIZE; cpu++)
+			CPU_SET((int) cpu, set);
+		if (*p == ',')
+			p++;
+		else if (*p != '\0')
+			return false;
+	}
+	return CPU_COUNT(set) > 0;
+}
+
+static int
+cpu_roles_lookup(const char *name, size_t len)
+{
+	for (int i = 0; i < CPU_ROLES; i++)
+	{
+		if (strlen(role_names[i]) == len && strncmp(role_names[i], name, len) == 0)
+			return i;
+	}
+	return -1;
+}
+
+void
+CpuRolesInit(void)
+{
+	const char *env = getenv("STORAGE_CPU_ROLES");
+	char	   *copy;
+	char	   *save = NULL;
+	cpu_set_t	online;
+
+	if (env == NULL || env[0] == '\0')
+		return;
+	if (sched_getaffinity(0, sizeof(online), &online) != 0)
+		return;
+
+	copy = strdup(env);
+	if (copy == NULL)
+		return;
+	for (char *item = strtok_r(copy, ";", &save); item != NULL; item = strtok_r(NULL, ";", &save))
+	{
+		char	   *eq = strchr(item, '=');
+		int			role = eq != NULL ? cpu_roles_lookup(item, eq - item) : -1;
+		cpu_set_t	set;
+
+		CPU_ZERO(&set);
+		if (role < 0 || !cpu_roles_parse_list(eq + 1, &set))
+		{
+			ereport(WARNING,
+					(errmsg("ignoring \"%s\" of STORAGE_CPU_ROLES", item)));
+			continue;
+		}
+		CPU_AND(&set, &set, &online);
+		if (CPU_COUNT(&set) == 0)
+		{
+			ereport(WARNING,
+					(errmsg("ignoring \"%s\" of STORAGE_CPU_ROLES, none of its CPUs is usable", item)));
+			continue;
+		}
+		role_cpus[role] = set;
+		role_given[role] = true;
+		roles_enabled = true;
+	}
+	free(copy);
+
+	if (!roles_enabled)
+		return;
+
+	/* Everything else keeps clear of the dedicated CPUs, if that leaves any */
+	if (!role_given[CPU_ROLE_OTHER])
+	{
+		cpu_set_t	other = online;
+
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+		{
+			if ((role_given[CPU_ROLE_PARSE] && CPU_ISSET(cpu, &role_cpus[CPU_ROLE_PARSE])) ||
+				(role_given[CPU_ROLE_REDO] && CPU_ISSET(cpu, &role_cpus[CPU_ROLE_REDO])))
+				CPU_CLR(cpu, &other);
+		}
+		role_cpus[CPU_ROLE_OTHER] = CPU_COUNT(&other) > 0 ? other : online;
+	}
+	for (int i = 0; i < CPU_ROLES; i++)
+	{
+		if (!role_given[i])
+			role_cpus[i] = role_cpus[CPU_ROLE_OTHER];
+		ereport(LOG,
+				(errmsg("storage CPU role \"%s\" runs on %d CPUs", role_names[i],
+						CPU_COUNT(&role_cpus[i]))));
+	}
+
+	CpuRoleBind(CPU_ROLE_OTHER, -1);
+}
+
+bool
+CpuRolesEnabled(void)
+{
+	return roles_enabled;
+}
+
+void
+CpuRoleBind(CpuRole role, int nth)
+{
+	cpu_set_t	set;
+
+	if (!roles_enabled)
+		return;
+
+	set = role_cpus[role];
+	if (nth >= 0)
+	{
+		int			skip = nth % CPU_COUNT(&role_cpus[role]);
+
+		CPU_ZERO(&set);
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+		{
+			if (!CPU_ISSET(cpu, &role_cpus[role]))
+				continue;
+			if (skip-- == 0)
+			{
+				CPU_SET(cpu, &set);
+				break;
+			}
+		}
+	}
+	/* pid 0 is the calling thread; not ereport, threads call this too */
+	if (sched_setaffinity(0, sizeof(set), &set) != 0)
+		fprintf(stderr, "could not bind to the CPUs of role \"%s\": %s\n", role_names[role],
+				strerror(errno));
+}
+
+#else							/* !__linux__ */
+
+void
+CpuRolesInit(void)
+{
+}
+
+bool
+CpuRolesEnabled(void)
+{
+	return false;
+}
+
+void
+CpuRoleBind(CpuRole role, int nth)
+{
+}
+
+#endif							/* __linux__ */
@@ -19,6 +19,7 @@
 #include "access/heapam.h"
 #include "access/multixact.h"
 #include "access/nbtree.h"
+#include "access/parallelredo.h"
 #include "access/subtrans.h"
 #include "access/twophase.h"
 #include "commands/async.h"
@@ -36,6 +37,9 @@
 #include "storage/bufmgr.h"
 #include "storage/dsm.h"
 #include "storage/ipc.h"
+#include "storage/compressed_page_cache.h"
+#include "storage/local_page_cache.h"
+#include "storage/map_page_cache.h"
 #include "storage/pg_shmem.h"
 #include "storage/pmsignal.h"
 #include "storage/predicate.h"
@@ -45,7 +49,9 @@
 #include "storage/sinvaladt.h"
 #include "storage/spin.h"
 #include "storage/rel_cache.h"
+#include "storage/rpc_fetch_cost.h"
 #include "storage/builtin_shmht.h"
+#include "utils/sharedplancache.h"
 #include "utils/snapmgr.h"
 #include "access/polar_logindex.h"
 #include "storage/GroundDB/mempool_shmem.h"
@@ -122,6 +128,12 @@ CreateSharedMemoryAndSemaphores(void)
 		 */
 		size = 100000;
 		size = add_size(size, MemPoolClientShmemSize());
+		size = add_size(size, LocalPageCacheShmemSize());
+		size = add_size(size, MapPageCacheShmemSize());
+		size = add_size(size, IndexPageCacheShmemSize());
+		size = add_size(size, CompressedPageCacheShmemSize());
+		size = add_size(size, RpcFetchCostShmemSize());
+		size = add_size(size, ParallelRedoShmemSize());
 		size = add_size(size, PGSemaphoreShmemSize(numSemas));
 		size = add_size(size, SpinlockSemaSize());
 		size = add_size(size, hash_estimate_size(SHMEM_INDEX_SIZE,
@@ -140,6 +152,8 @@ CreateSharedMemoryAndSemaphores(void)
 		size = add_size(size, LWLockShmemSize());
 		size = add_size(size, ProcArrayShmemSize());
 		size = add_size(size, BackendStatusShmemSize());
+		size = add_size(size, SharedStatsShmemSize());
+		size = add_size(size, SharedPlanCacheShmemSize());
 		size = add_size(size, SInvalShmemSize());
 		size = add_size(size, PMSignalShmemSize());
 		size = add_size(size, ProcSignalShmemSize());
@@ -231,6 +245,12 @@ CreateSharedMemoryAndSemaphores(void)
 	MultiXactShmemInit();
 	MemPoolClientShmemInit();
 	InitBufferPool();
+	LocalPageCacheShmemInit();
+	MapPageCacheShmemInit();
+	IndexPageCacheShmemInit();
+	CompressedPageCacheShmemInit();
+	RpcFetchCostShmemInit();
+	ParallelRedoShmemInit();
 
     polar_logindex_shmem_init(24, 0);
 	/*
@@ -250,6 +270,8 @@ CreateSharedMemoryAndSemaphores(void)
 		InitProcGlobal();
 	CreateSharedProcArray();
 	CreateSharedBackendStatus();
+	CreateSharedStats();
+	SharedPlanCacheShmemInit();
 	TwoPhaseShmemInit();
 	BackgroundWorkerShmemInit();
 
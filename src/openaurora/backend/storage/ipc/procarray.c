@@ -10,7 +10,9 @@
  *
  * Because of various subtle race conditions it is critical that a backend
  * hold the correct locks while setting or clearing its MyPgXact->xid field.
- * See notes in src/backend/access/transam/README.
+ * See notes in src/backend/access/transam/README.  The xids are also kept,
+ * in ProcArray order, in the dense ProcGlobal->xids array that snapshots
+ * scan; the two are always set together.
  *
  * The process arrays now also include structures representing prepared
  * transactions.  The xid and subxids fields of these are valid, as are the
@@ -104,6 +106,12 @@ static ProcArrayStruct *procArray;
 static PGPROC *allProcs;
 static PGXACT *allPgXact;
 
+/*
+ * The global xmin GetSnapshotData() last computed from the PGXACT xmins, see
+ * there.
+ */
+static TransactionId cachedGlobalXmin = InvalidTransactionId;
+
 /*
  * Bookkeeping for tracking emulated transactions in recovery
  */
@@ -175,6 +183,8 @@ static void KnownAssignedXidsReset(void);
 static inline void ProcArrayEndTransactionInternal(PGPROC *proc,
 												   PGXACT *pgxact, TransactionId latestXid);
 static void ProcArrayGroupClearXid(PGPROC *proc, TransactionId latestXid);
+static bool GetSnapshotDataReuse(Snapshot snapshot);
+static void GetSnapshotDataInitOldSnapshot(Snapshot snapshot);
 
 /*
  * Report shared-memory space needed by CreateSharedProcArray.
@@ -249,6 +259,7 @@ CreateSharedProcArray(void)
 		procArray->lastOverflowedXid = InvalidTransactionId;
 		procArray->replication_slot_xmin = InvalidTransactionId;
 		procArray->replication_slot_catalog_xmin = InvalidTransactionId;
+		ShmemVariableCache->xactCompletionCount = 1;
 	}
 
 	allProcs = ProcGlobal->allProcs;
@@ -277,8 +288,14 @@ ProcArrayAdd(PGPROC *proc)
 {
 	ProcArrayStruct *arrayP = procArray;
 	int			index;
+	int			i;
 
+	/*
+	 * XidGenLock too, as moving the entries of ProcGlobal->xids changes the
+	 * pgxactoff of the backends after us, which GetNewTransactionId() uses.
+	 */
 	LWLockAcquire(ProcArrayLock, LW_EXCLUSIVE);
+	LWLockAcquire(XidGenLock, LW_EXCLUSIVE);
 
 	if (arrayP->numProcs >= arrayP->maxProcs)
 	{
@@ -287,6 +304,7 @@ ProcArrayAdd(PGPROC *proc)
 		 * fixed supply of PGPROC structs too, and so we should have failed
 		 * earlier.)
 		 */
+		LWLockRelease(XidGenLock);
 		LWLockRelease(ProcArrayLock);
 		ereport(FATAL,
 				(errcode(ERRCODE_TOO_MANY_CONNECTIONS),
@@ -314,9 +332,16 @@ ProcArrayAdd(PGPROC *proc)
 
 	memmove(&arrayP->pgprocnos[index + 1], &arrayP->pgprocnos[index],
 			(arrayP->numProcs - index) * sizeof(int));
+	memmove(&ProcGlobal->xids[index + 1], &ProcGlobal->xids[index],
+			(arrayP->numProcs - index) * sizeof(TransactionId));
 	arrayP->pgprocnos[index] = proc->pgprocno;
+	ProcGlobal->xids[index] = allPgXact[proc->pgprocno].xid;
 	arrayP->numProcs++;
 
+	for (i = index; i < arrayP->numProcs; i++)
+		allProcs[arrayP->pgprocnos[i]].pgxactoff = i;
+
+	LWLockRelease(XidGenLock);
 	LWLockRelease(ProcArrayLock);
 }
 
@@ -342,7 +367,9 @@ ProcArrayRemove(PGPROC *proc, TransactionId latestXid)
 		DisplayXidCache();
 #endif
 
+	/* See ProcArrayAdd for XidGenLock */
 	LWLockAcquire(ProcArrayLock, LW_EXCLUSIVE);
+	LWLockAcquire(XidGenLock, LW_EXCLUSIVE);
 
 	if (TransactionIdIsValid(latestXid))
 	{
@@ -352,6 +379,9 @@ ProcArrayRemove(PGPROC *proc, TransactionId latestXid)
 		if (TransactionIdPrecedes(ShmemVariableCache->latestCompletedXid,
 								  latestXid))
 			ShmemVariableCache->latestCompletedXid = latestXid;
+
+		/* Same as ProcArrayEndTransactionInternal */
+		ShmemVariableCache->xactCompletionCount++;
 	}
 	else
 	{
@@ -363,17 +393,28 @@ ProcArrayRemove(PGPROC *proc, TransactionId latestXid)
 	{
 		if (arrayP->pgprocnos[index] == proc->pgprocno)
 		{
+			int			i;
+
 			/* Keep the PGPROC array sorted. See notes above */
 			memmove(&arrayP->pgprocnos[index], &arrayP->pgprocnos[index + 1],
 					(arrayP->numProcs - index - 1) * sizeof(int));
+			memmove(&ProcGlobal->xids[index], &ProcGlobal->xids[index + 1],
+					(arrayP->numProcs - index - 1) * sizeof(TransactionId));
 			arrayP->pgprocnos[arrayP->numProcs - 1] = -1;	/* for debugging */
+			ProcGlobal->xids[arrayP->numProcs - 1] = InvalidTransactionId;
 			arrayP->numProcs--;
+
+			for (i = index; i < arrayP->numProcs; i++)
+				allProcs[arrayP->pgprocnos[i]].pgxactoff = i;
+
+			LWLockRelease(XidGenLock);
 			LWLockRelease(ProcArrayLock);
 			return;
 		}
 	}
 
 	/* Oops */
+	LWLockRelease(XidGenLock);
 	LWLockRelease(ProcArrayLock);
 
 	elog(LOG, "failed to find proc %p in ProcArray", proc);
@@ -452,6 +493,7 @@ ProcArrayEndTransactionInternal(PGPROC *proc, PGXACT *pgxact,
 								TransactionId latestXid)
 {
 	pgxact->xid = InvalidTransactionId;
+	ProcGlobal->xids[proc->pgxactoff] = InvalidTransactionId;
 	proc->lxid = InvalidLocalTransactionId;
 	pgxact->xmin = InvalidTransactionId;
 	/* must be cleared with xid/xmin: */
@@ -467,6 +509,9 @@ ProcArrayEndTransactionInternal(PGPROC *proc, PGXACT *pgxact,
 	if (TransactionIdPrecedes(ShmemVariableCache->latestCompletedXid,
 							  latestXid))
 		ShmemVariableCache->latestCompletedXid = latestXid;
+
+	/* Snapshots taken before this one aren't current any more */
+	ShmemVariableCache->xactCompletionCount++;
 }
 
 /*
@@ -602,12 +647,15 @@ ProcArrayClearTransaction(PGPROC *proc)
 	PGXACT	   *pgxact = &allPgXact[proc->pgprocno];
 
 	/*
-	 * We can skip locking ProcArrayLock here, because this action does not
+	 * A shared ProcArrayLock is enough here, because this action does not
 	 * actually change anyone's view of the set of running XIDs: our entry is
 	 * duplicate with the gxact that has already been inserted into the
-	 * ProcArray.
+	 * ProcArray.  But we need it to keep our pgxactoff from moving.
 	 */
+	LWLockAcquire(ProcArrayLock, LW_SHARED);
+
 	pgxact->xid = InvalidTransactionId;
+	ProcGlobal->xids[proc->pgxactoff] = InvalidTransactionId;
 	proc->lxid = InvalidLocalTransactionId;
 	pgxact->xmin = InvalidTransactionId;
 	proc->recoveryConflictPending = false;
@@ -619,6 +667,8 @@ ProcArrayClearTransaction(PGPROC *proc)
 	/* Clear the subtransaction-XID cache too */
 	pgxact->nxids = 0;
 	pgxact->overflowed = false;
+
+	LWLockRelease(ProcArrayLock);
 }
 
 /*
@@ -1497,6 +1547,13 @@ GetMaxSnapshotSubxidCount(void)
  *		RecentGlobalDataXmin: the global xmin for non-catalog tables
  *			>= RecentGlobalXmin
  *
+ * If no transaction with an XID has ended since the snapshot was last filled
+ * in, its contents are still current, and we only redo the bookkeeping; see
+ * GetSnapshotDataReuse().  Otherwise the running XIDs come from the dense
+ * ProcGlobal->xids array.  The PGXACT xmins, which only matter for
+ * RecentGlobalXmin, are only scanned when the result could be newer than the
+ * last one computed, see below.
+ *
  * Note: this function should probably not be called with an argument that's
  * not statically allocated (see xip allocation below).
  */
@@ -1513,6 +1570,7 @@ GetSnapshotData(Snapshot snapshot)
 	bool		suboverflowed = false;
 	TransactionId replication_slot_xmin = InvalidTransactionId;
 	TransactionId replication_slot_catalog_xmin = InvalidTransactionId;
+	uint64		curXactCompletionCount;
 
 	Assert(snapshot != NULL);
 
@@ -1554,6 +1612,15 @@ GetSnapshotData(Snapshot snapshot)
 	 */
 	LWLockAcquire(ProcArrayLock, LW_SHARED);
 
+	if (GetSnapshotDataReuse(snapshot))
+	{
+		LWLockRelease(ProcArrayLock);
+		GetSnapshotDataInitOldSnapshot(snapshot);
+		return snapshot;
+	}
+
+	curXactCompletionCount = ShmemVariableCache->xactCompletionCount;
+
 	/* xmax is always latestCompletedXid + 1 */
 	xmax = ShmemVariableCache->latestCompletedXid;
 	Assert(TransactionIdIsNormal(xmax));
@@ -1567,36 +1634,23 @@ GetSnapshotData(Snapshot snapshot)
 	if (!snapshot->takenDuringRecovery)
 	{
 		int		   *pgprocnos = arrayP->pgprocnos;
+		TransactionId *other_xids = ProcGlobal->xids;
 		int			numProcs;
 
 		/*
-		 * Spin over procArray checking xid, xmin, and subxids.  The goal is
-		 * to gather all active xids, find the lowest xmin, and try to record
-		 * subxids.
+		 * Spin over the dense xid array, checking xid and subxids.  The goal
+		 * is to gather all active xids, find the lowest one, and try to
+		 * record subxids.  The PGXACT of a backend is only looked at when it
+		 * has an xid.
 		 */
 		numProcs = arrayP->numProcs;
 		for (index = 0; index < numProcs; index++)
 		{
-			int			pgprocno = pgprocnos[index];
-			PGXACT	   *pgxact = &allPgXact[pgprocno];
-			TransactionId xid;
-
-			/*
-			 * Skip over backends doing logical decoding which manages xmin
-			 * separately (check below) and ones running LAZY VACUUM.
-			 */
-			if (pgxact->vacuumFlags &
-				(PROC_IN_LOGICAL_DECODING | PROC_IN_VACUUM))
-				continue;
-
-			/* Update globalxmin to be the smallest valid xmin */
-			xid = UINT32_ACCESS_ONCE(pgxact->xmin);
-			if (TransactionIdIsNormal(xid) &&
-				NormalTransactionIdPrecedes(xid, globalxmin))
-				globalxmin = xid;
+			int			pgprocno;
+			PGXACT	   *pgxact;
 
 			/* Fetch xid just once - see GetNewTransactionId */
-			xid = UINT32_ACCESS_ONCE(pgxact->xid);
+			TransactionId xid = UINT32_ACCESS_ONCE(other_xids[index]);
 
 			/*
 			 * If the transaction has no XID assigned, we can skip it; it
@@ -1604,10 +1658,21 @@ GetSnapshotData(Snapshot snapshot)
 			 * skip it; such transactions will be treated as running anyway
 			 * (and any sub-XIDs will also be >= xmax).
 			 */
-			if (!TransactionIdIsNormal(xid)
+			if (likely(!TransactionIdIsNormal(xid))
 				|| !NormalTransactionIdPrecedes(xid, xmax))
 				continue;
 
+			pgprocno = pgprocnos[index];
+			pgxact = &allPgXact[pgprocno];
+
+			/*
+			 * Skip over backends doing logical decoding which manages xmin
+			 * separately (check below) and ones running LAZY VACUUM.
+			 */
+			if (pgxact->vacuumFlags &
+				(PROC_IN_LOGICAL_DECODING | PROC_IN_VACUUM))
+				continue;
+
 			/*
 			 * We don't include our own XIDs (if any) in the snapshot, but we
 			 * must include them in xmin.
@@ -1657,6 +1722,41 @@ GetSnapshotData(Snapshot snapshot)
 				}
 			}
 		}
+
+		/*
+		 * Then the smallest xmin, for globalxmin.  A global xmin once
+		 * computed stays a valid bound: every backend's xmin was at least
+		 * that, and xmins set later are at least the oldest XID running then,
+		 * which was running or not yet assigned when it was computed.  And
+		 * it can never be newer than xmin.  So only scan the xmins again
+		 * when the last result is older than xmin, and could advance.
+		 */
+		if (TransactionIdIsNormal(cachedGlobalXmin) &&
+			!TransactionIdPrecedes(cachedGlobalXmin, xmin))
+			globalxmin = cachedGlobalXmin;
+		else
+		{
+			for (index = 0; index < numProcs; index++)
+			{
+				PGXACT	   *pgxact = &allPgXact[pgprocnos[index]];
+				TransactionId xid;
+
+				/* As above */
+				if (pgxact->vacuumFlags &
+					(PROC_IN_LOGICAL_DECODING | PROC_IN_VACUUM))
+					continue;
+
+				/* Update globalxmin to be the smallest valid xmin */
+				xid = UINT32_ACCESS_ONCE(pgxact->xmin);
+				if (TransactionIdIsNormal(xid) &&
+					NormalTransactionIdPrecedes(xid, globalxmin))
+					globalxmin = xid;
+			}
+
+			if (TransactionIdPrecedes(xmin, globalxmin))
+				globalxmin = xmin;
+			cachedGlobalXmin = globalxmin;
+		}
 	}
 	else
 	{
@@ -1747,6 +1847,8 @@ GetSnapshotData(Snapshot snapshot)
 	snapshot->subxcnt = subcount;
 	snapshot->suboverflowed = suboverflowed;
 
+	snapshot->snapXactCompletionCount = curXactCompletionCount;
+
 	snapshot->curcid = GetCurrentCommandId(false);
 
 	/*
@@ -1757,6 +1859,59 @@ GetSnapshotData(Snapshot snapshot)
 	snapshot->regd_count = 0;
 	snapshot->copied = false;
 
+	GetSnapshotDataInitOldSnapshot(snapshot);
+
+	return snapshot;
+}
+
+/*
+ * GetSnapshotDataReuse -- reuse the contents of a snapshot, if still current
+ *
+ * If no transaction with an XID left the ProcArray since the snapshot was
+ * filled in, the set of running XIDs it recorded is unchanged: XIDs assigned
+ * since are >= its xmax.  Then only the per-call state needs to be set up
+ * again.  Snapshots taken during recovery are always recomputed, as
+ * KnownAssignedXids doesn't maintain the count.
+ *
+ * Caller must hold ProcArrayLock.
+ */
+static bool
+GetSnapshotDataReuse(Snapshot snapshot)
+{
+	Assert(LWLockHeldByMe(ProcArrayLock));
+
+	if (snapshot->snapXactCompletionCount !=
+		ShmemVariableCache->xactCompletionCount)
+		return false;
+	if (snapshot->takenDuringRecovery || RecoveryInProgress())
+		return false;
+
+	/*
+	 * As no transaction ended, the XIDs running when the snapshot was taken,
+	 * the oldest of which is its xmin, still are, so no backend's xmin can
+	 * have gone past it since, and it is safe to advertise it again.  The
+	 * global xmin variables computed then are still valid too.
+	 */
+	if (!TransactionIdIsValid(MyPgXact->xmin))
+		MyPgXact->xmin = TransactionXmin = snapshot->xmin;
+	RecentXmin = snapshot->xmin;
+
+	snapshot->curcid = GetCurrentCommandId(false);
+
+	/* As in GetSnapshotData */
+	snapshot->active_count = 0;
+	snapshot->regd_count = 0;
+	snapshot->copied = false;
+
+	return true;
+}
+
+/*
+ * Fill in the "snapshot too old" fields of a snapshot.
+ */
+static void
+GetSnapshotDataInitOldSnapshot(Snapshot snapshot)
+{
 	if (old_snapshot_threshold < 0)
 	{
 		/*
@@ -1775,10 +1930,8 @@ GetSnapshotData(Snapshot snapshot)
 		 */
 		snapshot->lsn = GetXLogInsertRecPtr();
 		snapshot->whenTaken = GetSnapshotCurrentTimestamp();
-		MaintainOldSnapshotTimeMapping(snapshot->whenTaken, xmin);
+		MaintainOldSnapshotTimeMapping(snapshot->whenTaken, snapshot->xmin);
 	}
-
-	return snapshot;
 }
 
 /*
@@ -3211,6 +3364,9 @@ XidCacheRemoveRunningXids(TransactionId xid,
 							  latestXid))
 		ShmemVariableCache->latestCompletedXid = latestXid;
 
+	/* The subtransactions aren't running any more either */
+	ShmemVariableCache->xactCompletionCount++;
+
 	LWLockRelease(ProcArrayLock);
 }
 
@@ -0,0 +1,301 @@
+#include "postgres.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "common/hashfn.h"
+#include "storage/kv_engine.h"
+
+char *kv_engine = NULL;
+
+static const KvEngine *engines[KV_ENGINE_MAX];
+static int engineNum = 0;
+static pthread_mutex_t engineLock = PTHREAD_MUTEX_INITIALIZER;
+
+int KvRegisterEngine(const KvEngine *engine) {
+    int err = 0;
+
+    pthread_mutex_lock(&engineLock);
+    for (int i = 0; i < engineNum; i++)
+        if (engines[i] == engine || strcmp(engines[i]->name, engine->name) == 0)
+            err = 1;
+    if (!err && engineNum < KV_ENGINE_MAX)
+        engines[engineNum++] = engine;
+    else
+        err = 1;
+    pthread_mutex_unlock(&engineLock);
+    return err;
+}
+
+const KvEngine *KvLookupEngine(const char *name) {
+    const KvEngine *engine = NULL;
+
+    pthread_mutex_lock(&engineLock);
+    for (int i = 0; i < engineNum && engine == NULL; i++)
+        if (strcmp(engines[i]->name, name) == 0)
+            engine = engines[i];
+    pthread_mutex_unlock(&engineLock);
+    return engine;
+}
+
+#define KV_INDEX_SHARDS (64)
+#define KV_INDEX_INIT_BUCKETS (1024)
+// Page versions are grouped by page, the ~LSN is the rest of the key
+#define KV_INDEX_MAX_SUFFIX (KV_PAGE_KEY_LEN - KV_PAGE_PREFIX_LEN)
+
+typedef struct KvIndexEntry {
+    char suffix[KV_INDEX_MAX_SUFFIX];
+    uint8 suffixLen;
+    void *payload;
+} KvIndexEntry;
+
+typedef struct KvIndexGroup {
+    struct KvIndexGroup *next;
+    uint32 hash;
+    uint8 family;
+    uint16 keyLen;
+    int num;
+    int cap;
+    KvIndexEntry *entries;
+    char key[FLEXIBLE_ARRAY_MEMBER];
+} KvIndexGroup;
+
+typedef struct KvIndexShard {
+    pthread_rwlock_t lock;
+    KvIndexGroup **buckets;
+    uint32 bucketNum;
+    uint32 groupNum;
+} KvIndexShard;
+
+struct KvIndex {
+    KvIndexShard shards[KV_INDEX_SHARDS];
+};
+
+static size_t KvIndexGroupLen(KvFamily family, size_t keyLen) {
+    if (family == KV_FAMILY_PAGE && keyLen == KV_PAGE_KEY_LEN)
+        return KV_PAGE_PREFIX_LEN;
+    return keyLen;
+}
+
+KvIndex *KvIndexCreate(void) {
+    KvIndex *index = (KvIndex*) calloc(1, sizeof(KvIndex));
+
+    for (int i = 0; i < KV_INDEX_SHARDS; i++) {
+        KvIndexShard *shard = &index->shards[i];
+
+        pthread_rwlock_init(&shard->lock, NULL);
+        shard->bucketNum = KV_INDEX_INIT_BUCKETS;
+        shard->buckets = (KvIndexGroup**) calloc(shard->bucketNum, sizeof(KvIndexGroup*));
+    }
+    return index;
+}
+
+void KvIndexDestroy(KvIndex *index, void (*freePayload)(void *payload)) {
+    if (index == NULL)
+        return;
+    for (int i = 0; i < KV_INDEX_SHARDS; i++) {
+        KvIndexShard *shard = &index->shards[i];
+
+        for (uint32 b = 0; b < shard->bucketNum; b++) {
+            KvIndexGroup *group = shard->buckets[b];
+
+            while (group != NULL) {
+                KvIndexGroup *next = group->next;
+
+                for (int e = 0; e < group->num; e++)
+                    freePayload(group->entries[e].payload);
+                free(group->entries);
+                free(group);
+                group = next;
+            }
+        }
+        free(shard->buckets);
+        pthread_rwlock_destroy(&shard->lock);
+    }
+    free(index);
+}
+
+// Caller holds the shard lock
+static KvIndexGroup **KvIndexFindGroup(KvIndexShard *shard, uint32 hash, KvFamily family,
+                                       const char *key, size_t groupLen) {
+    KvIndexGroup **link = &shard->buckets[hash % shard->bucketNum];
+
+    for (; *link != NULL; link = &(*link)->next) {
+        KvIndexGroup *group = *link;
+
+        if (group->hash == hash && group->family == family && group->keyLen == groupLen
+            && memcmp(group->key, key, groupLen) == 0)
+            return link;
+    }
+    return link;
+}
+
+static int KvIndexCompareSuffix(const KvIndexEntry *entry, const char *suffix, size_t suffixLen) {
+    size_t len = Min(entry->suffixLen, suffixLen);
+    int cmp = memcmp(entry->suffix, suffix, len);
+
+    if (cmp != 0)
+        return cmp;
+    return (int) entry->suffixLen - (int) suffixLen;
+}
+
+// First entry at or after suffix
+static int KvIndexLowerBound(const KvIndexGroup *group, const char *suffix, size_t suffixLen) {
+    int low = 0;
+    int high = group->num;
+
+    while (low < high) {
+        int mid = (low + high) / 2;
+
+        if (KvIndexCompareSuffix(&group->entries[mid], suffix, suffixLen) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    return low;
+}
+
+// Caller holds the shard write lock
+static void KvIndexGrow(KvIndexShard *shard) {
+    uint32 bucketNum = shard->bucketNum * 2;
+    KvIndexGroup **buckets = (KvIndexGroup**) calloc(bucketNum, sizeof(KvIndexGroup*));
+
+    if (buckets == NULL)
+        return;
+    for (uint32 b = 0; b < shard->bucketNum; b++) {
+        KvIndexGroup *group = shard->buckets[b];
+
+        while (group != NULL) {
+            KvIndexGroup *next = group->next;
+
+            group->next = buckets[group->hash % bucketNum];
+            buckets[group->hash % bucketNum] = group;
+            group = next;
+        }
+    }
+    free(shard->buckets);
+    shard->buckets = buckets;
+    shard->bucketNum = bucketNum;
+}
+
+void *KvIndexPut(KvIndex *index, KvFamily family, const char *key, size_t keyLen, void *payload) {
+    size_t groupLen = KvIndexGroupLen(family, keyLen);
+    const char *suffix = key + groupLen;
+    size_t suffixLen = keyLen - groupLen;
+    uint32 hash = hash_bytes((const unsigned char *) key, (int) groupLen);
+    KvIndexShard *shard = &index->shards[hash % KV_INDEX_SHARDS];
+    void *old = NULL;
+
+    pthread_rwlock_wrlock(&shard->lock);
+    KvIndexGroup **link = KvIndexFindGroup(shard, hash, family, key, groupLen);
+    KvIndexGroup *group = *link;
+    if (group == NULL) {
+        group = (KvIndexGroup*) calloc(1, offsetof(KvIndexGroup, key) + groupLen);
+        group->hash = hash;
+        group->family = (uint8) family;
+        group->keyLen = (uint16) groupLen;
+        memcpy(group->key, key, groupLen);
+        *link = group;
+        if (++shard->groupNum > shard->bucketNum)
+            KvIndexGrow(shard);
+    }
+
+    int pos = KvIndexLowerBound(group, suffix, suffixLen);
+    if (pos < group->num && KvIndexCompareSuffix(&group->entries[pos], suffix, suffixLen) == 0) {
+        old = group->entries[pos].payload;
+        group->entries[pos].payload = payload;
+        pthread_rwlock_unlock(&shard->lock);
+        return old;
+    }
+
+    if (group->num == group->cap) {
+        group->cap = group->cap > 0 ? group->cap * 2 : 4;
+        group->entries = (KvIndexEntry*) realloc(group->entries, group->cap * sizeof(KvIndexEntry));
+    }
+    // New versions have the smallest ~LSN, they usually go first
+    memmove(&group->entries[pos + 1], &group->entries[pos], (group->num - pos) * sizeof(KvIndexEntry));
+    memcpy(group->entries[pos].suffix, suffix, suffixLen);
+    group->entries[pos].suffixLen = (uint8) suffixLen;
+    group->entries[pos].payload = payload;
+    group->num++;
+    pthread_rwlock_unlock(&shard->lock);
+    return old;
+}
+
+void *KvIndexDelete(KvIndex *index, KvFamily family, const char *key, size_t keyLen) {
+    size_t groupLen = KvIndexGroupLen(family, keyLen);
+    const char *suffix = key + groupLen;
+    size_t suffixLen = keyLen - groupLen;
+    uint32 hash = hash_bytes((const unsigned char *) key, (int) groupLen);
+    KvIndexShard *shard = &index->shards[hash % KV_INDEX_SHARDS];
+    void *old = NULL;
+
+    pthread_rwlock_wrlock(&shard->lock);
+    KvIndexGroup **link = KvIndexFindGroup(shard, hash, family, key, groupLen);
+    KvIndexGroup *group = *link;
+    if (group != NULL) {
+        int pos = KvIndexLowerBound(group, suffix, suffixLen);
+
+        if (pos < group->num && KvIndexCompareSuffix(&group->entries[pos], suffix, suffixLen) == 0) {
+            old = group->entries[pos].payload;
+            memmove(&group->entries[pos], &group->entries[pos + 1],
+                    (group->num - pos - 1) * sizeof(KvIndexEntry));
+            group->num--;
+        }
+        if (group->num == 0) {
+            *link = group->next;
+            shard->groupNum--;
+            free(group->entries);
+            free(group);
+        }
+    }
+    pthread_rwlock_unlock(&shard->lock);
+    return old;
+}
+
+static int KvIndexVisit(KvIndex *index, KvFamily family, const char *key, size_t keyLen, int exact,
+                        KvIndexVisitor visitor, void *arg) {
+    size_t groupLen = KvIndexGroupLen(family, keyLen);
+    const char *suffix = key + groupLen;
+    size_t suffixLen = keyLen - groupLen;
+    uint32 hash = hash_bytes((const unsigned char *) key, (int) groupLen);
+    KvIndexShard *shard = &index->shards[hash % KV_INDEX_SHARDS];
+    int found = 0;
+
+    pthread_rwlock_rdlock(&shard->lock);
+    KvIndexGroup *group = *KvIndexFindGroup(shard, hash, family, key, groupLen);
+    if (group != NULL) {
+        int pos = KvIndexLowerBound(group, suffix, suffixLen);
+
+        if (pos < group->num
+            && (!exact || KvIndexCompareSuffix(&group->entries[pos], suffix, suffixLen) == 0)) {
+            char foundKey[KV_PAGE_KEY_LEN];
+            size_t foundKeyLen = groupLen + group->entries[pos].suffixLen;
+
+            if (foundKeyLen <= sizeof(foundKey)) {
+                memcpy(foundKey, group->key, groupLen);
+                memcpy(foundKey + groupLen, group->entries[pos].suffix, group->entries[pos].suffixLen);
+                visitor(foundKey, foundKeyLen, group->entries[pos].payload, arg);
+            } else {
+                // Only whole keys are longer than a page version key
+                visitor(group->key, groupLen, group->entries[pos].payload, arg);
+            }
+            found = 1;
+        }
+    }
+    pthread_rwlock_unlock(&shard->lock);
+    return found;
+}
+
+int KvIndexGet(KvIndex *index, KvFamily family, const char *key, size_t keyLen,
+               KvIndexVisitor visitor, void *arg) {
+    return KvIndexVisit(index, family, key, keyLen, 1, visitor, arg);
+}
+
+int KvIndexSeek(KvIndex *index, KvFamily family, const char *key, size_t keyLen, size_t prefixLen,
+                KvIndexVisitor visitor, void *arg) {
+    // The groups are the only key ranges kept in order
+    if (prefixLen != KvIndexGroupLen(family, keyLen))
+        return 0;
+    return KvIndexVisit(index, family, key, keyLen, 0, visitor, arg);
+}
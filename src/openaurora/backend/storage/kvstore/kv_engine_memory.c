@@ -0,0 +1,90 @@
+#include "postgres.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include "storage/kv_engine.h"
+
+//! The values are kept in the index itself. Nothing is persisted, the store
+//! is empty after a restart, it is meant for benchmarks and for nodes that
+//! rebuild their page versions from WAL anyway.
+typedef struct KvMemoryValue {
+    size_t len;
+    char data[FLEXIBLE_ARRAY_MEMBER];
+} KvMemoryValue;
+
+typedef struct KvMemoryCopy {
+    char **key;
+    size_t *keyLen;
+    char **value;
+    size_t *valueLen;
+} KvMemoryCopy;
+
+static KvIndex *memoryIndex = NULL;
+
+static int KvMemoryOpen(void) {
+    memoryIndex = KvIndexCreate();
+    return memoryIndex == NULL;
+}
+
+static void KvMemoryClose(void) {
+    KvIndexDestroy(memoryIndex, free);
+    memoryIndex = NULL;
+}
+
+static int KvMemoryPut(KvFamily family, const char *key, size_t keyLen, const char *value, size_t valueLen) {
+    KvMemoryValue *stored = (KvMemoryValue*) malloc(offsetof(KvMemoryValue, data) + valueLen);
+
+    if (stored == NULL)
+        return 1;
+    stored->len = valueLen;
+    memcpy(stored->data, value, valueLen);
+    free(KvIndexPut(memoryIndex, family, key, keyLen, stored));
+    return 0;
+}
+
+static void KvMemoryCopyOut(const char *key, size_t keyLen, void *payload, void *arg) {
+    KvMemoryValue *stored = (KvMemoryValue*) payload;
+    KvMemoryCopy *copy = (KvMemoryCopy*) arg;
+
+    if (copy->key != NULL) {
+        *copy->key = (char*) malloc(keyLen);
+        memcpy(*copy->key, key, keyLen);
+        *copy->keyLen = keyLen;
+    }
+    // Empty values still need a pointer to tell them from missing ones
+    *copy->value = (char*) malloc(Max(stored->len, 1));
+    memcpy(*copy->value, stored->data, stored->len);
+    *copy->valueLen = stored->len;
+}
+
+static int KvMemoryGet(KvFamily family, const char *key, size_t keyLen, char **value, size_t *valueLen) {
+    KvMemoryCopy copy = {NULL, NULL, value, valueLen};
+
+    *value = NULL;
+    *valueLen = 0;
+    KvIndexGet(memoryIndex, family, key, keyLen, KvMemoryCopyOut, &copy);
+    return 0;
+}
+
+static int KvMemoryDelete(KvFamily family, const char *key, size_t keyLen) {
+    free(KvIndexDelete(memoryIndex, family, key, keyLen));
+    return 0;
+}
+
+static int KvMemorySeek(KvFamily family, const char *key, size_t keyLen, size_t prefixLen,
+                        char **foundKey, size_t *foundKeyLen, char **value, size_t *valueLen) {
+    KvMemoryCopy copy = {foundKey, foundKeyLen, value, valueLen};
+
+    return KvIndexSeek(memoryIndex, family, key, keyLen, prefixLen, KvMemoryCopyOut, &copy);
+}
+
+const KvEngine KvMemoryEngine = {
+    "memory",
+    KvMemoryOpen,
+    KvMemoryClose,
+    KvMemoryPut,
+    KvMemoryGet,
+    KvMemoryDelete,
+    KvMemorySeek,
+    0
+};
@@ -0,0 +1,721 @@
+#include "postgres.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "miscadmin.h"
+#include "port/pg_crc32c.h"
+#include "storage/kv_engine.h"
+
+//! Log-structured engine for a local SSD, in the three layers of
+//! docs/pluggable_kvstore.md:
+//!   index  the sharded KvIndex maps a key to where its record is on disk
+//!   buffer an LRU of the values read or written last
+//!   disk   records are appended to 16MB segment files, never rewritten
+//! A put or delete appends a record and repoints the index. A segment
+//! without live records is unlinked and its number reused. When a new
+//! segment is started, the live records of a mostly dead oldest segment are
+//! copied forward so it can go too. The index is rebuilt from the segments
+//! on open.
+//!
+//! Segment file: $Magic(4) $Pad(4) $Seq(8) [$Record]*
+//! Record:       $Magic(4) $CRC(4) $ValueLen(4) $KeyLen(2) $Family(1) $Flags(1) $Key $Value
+#define KV_SSD_DIR ("kv_ssd_store")
+#define KV_SSD_SEGMENT_SIZE (16*1024*1024)
+#define KV_SSD_MAX_SEGMENTS (65536)
+#define KV_SSD_SEGMENT_MAGIC (0x4B565347)  // "KVSG"
+#define KV_SSD_RECORD_MAGIC (0x4B565245)   // "KVRE"
+#define KV_SSD_RECORD_TOMBSTONE (0x01)
+// Below this share of live bytes the oldest segment is copied forward
+#define KV_SSD_CLEAN_RATIO (4)
+
+#define KV_SSD_CACHE_SHARDS (16)
+#define KV_SSD_CACHE_BUCKETS (4096)
+#define KV_SSD_CACHE_SIZE ((size_t)256*1024*1024)
+
+typedef struct KvSsdSegmentHeader {
+    uint32 magic;
+    uint32 pad;
+    uint64 seq;
+} KvSsdSegmentHeader;
+
+typedef struct KvSsdRecordHeader {
+    uint32 magic;
+    pg_crc32c crc;  // of the rest of the header, the key and the value
+    uint32 valueLen;
+    uint16 keyLen;
+    uint8 family;
+    uint8 flags;
+} KvSsdRecordHeader;
+
+typedef struct KvSsdSegment {
+    int fd;
+    int inUse;
+    uint64 seq;
+    int64 liveBytes;   // of the records the index points at
+    int tombstones;    // needed while an older segment may hold the key
+} KvSsdSegment;
+
+// Index payload
+typedef struct KvSsdLocation {
+    uint32 segment;
+    uint32 offset;
+    uint32 recordLen;
+    uint64 seq;
+} KvSsdLocation;
+
+// The segment state below is guarded by appendLock, which also orders the
+// index updates with the appends. Readers only take the index shard locks,
+// a record is live while the index points at it, so its segment stays open
+// while they hold the lock.
+static pthread_mutex_t appendLock = PTHREAD_MUTEX_INITIALIZER;
+static KvSsdSegment *segments = NULL;
+static uint32 segmentNum = 0;  // high-water mark of the segment numbers
+static uint32 *freeSegments = NULL;
+static uint32 freeNum = 0;
+static uint32 activeSegment = 0;
+static uint32 activeOffset = 0;
+static uint64 nextSeq = 1;
+static KvIndex *ssdIndex = NULL;
+static char ssdPath[MAXPGPATH];
+
+//! Buffer layer. Records never change in place and the ids, $Seq and
+//! $Offset, are never reused, so the cache needs no invalidation.
+typedef struct KvSsdCacheEntry {
+    uint64 id;
+    struct KvSsdCacheEntry *hashNext;
+    struct KvSsdCacheEntry *prev;
+    struct KvSsdCacheEntry *next;
+    size_t len;
+    char data[FLEXIBLE_ARRAY_MEMBER];
+} KvSsdCacheEntry;
+
+typedef struct KvSsdCacheShard {
+    pthread_mutex_t lock;
+    KvSsdCacheEntry *buckets[KV_SSD_CACHE_BUCKETS];
+    KvSsdCacheEntry *head;  // most recently used
+    KvSsdCacheEntry *tail;
+    size_t bytes;
+} KvSsdCacheShard;
+
+static KvSsdCacheShard *ssdCache = NULL;
+
+static uint64 KvSsdRecordId(uint64 seq, uint32 offset) {
+    return (seq << 24) | offset;
+}
+
+static void KvSsdCacheUnlink(KvSsdCacheShard *shard, KvSsdCacheEntry *entry) {
+    if (entry->prev != NULL)
+        entry->prev->next = entry->next;
+    else
+        shard->head = entry->next;
+    if (entry->next != NULL)
+        entry->next->prev = entry->prev;
+    else
+        shard->tail = entry->prev;
+}
+
+static void KvSsdCachePushFront(KvSsdCacheShard *shard, KvSsdCacheEntry *entry) {
+    entry->prev = NULL;
+    entry->next = shard->head;
+    if (shard->head != NULL)
+        shard->head->prev = entry;
+    shard->head = entry;
+    if (shard->tail == NULL)
+        shard->tail = entry;
+}
+
+static void KvSsdCacheRemove(KvSsdCacheShard *shard, KvSsdCacheEntry *entry) {
+    KvSsdCacheEntry **link = &shard->buckets[entry->id % KV_SSD_CACHE_BUCKETS];
+
+    while (*link != entry)
+        link = &(*link)->hashNext;
+    *link = entry->hashNext;
+    KvSsdCacheUnlink(shard, entry);
+    shard->bytes -= entry->len;
+    free(entry);
+}
+
+static void KvSsdCachePut(uint64 id, const char *value, size_t len) {
+    KvSsdCacheShard *shard = &ssdCache[id % KV_SSD_CACHE_SHARDS];
+    size_t capacity = KV_SSD_CACHE_SIZE / KV_SSD_CACHE_SHARDS;
+    KvSsdCacheEntry *entry;
+
+    // A few big values must not push out the rest
+    if (len > capacity / 64)
+        return;
+    entry = (KvSsdCacheEntry*) malloc(offsetof(KvSsdCacheEntry, data) + len);
+    if (entry == NULL)
+        return;
+    entry->id = id;
+    entry->len = len;
+    memcpy(entry->data, value, len);
+
+    pthread_mutex_lock(&shard->lock);
+    entry->hashNext = shard->buckets[id % KV_SSD_CACHE_BUCKETS];
+    shard->buckets[id % KV_SSD_CACHE_BUCKETS] = entry;
+    KvSsdCachePushFront(shard, entry);
+    shard->bytes += len;
+    while (shard->bytes > capacity && shard->tail != NULL)
+        KvSsdCacheRemove(shard, shard->tail);
+    pthread_mutex_unlock(&shard->lock);
+}
+
+// Returns a malloc'ed copy of the cached value, or NULL
+static char *KvSsdCacheGet(uint64 id, size_t *len) {
+    KvSsdCacheShard *shard = &ssdCache[id % KV_SSD_CACHE_SHARDS];
+    KvSsdCacheEntry *entry;
+    char *copy = NULL;
+
+    pthread_mutex_lock(&shard->lock);
+    for (entry = shard->buckets[id % KV_SSD_CACHE_BUCKETS]; entry != NULL; entry = entry->hashNext)
+        if (entry->id == id)
+            break;
+    if (entry != NULL) {
+        KvSsdCacheUnlink(shard, entry);
+        KvSsdCachePushFront(shard, entry);
+        copy = (char*) malloc(Max(entry->len, 1));
+        memcpy(copy, entry->data, entry->len);
+        *len = entry->len;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return copy;
+}
+
+static void KvSsdCacheDestroy(void) {
+    if (ssdCache == NULL)
+        return;
+    for (int i = 0; i < KV_SSD_CACHE_SHARDS; i++) {
+        while (ssdCache[i].tail != NULL)
+            KvSsdCacheRemove(&ssdCache[i], ssdCache[i].tail);
+        pthread_mutex_destroy(&ssdCache[i].lock);
+    }
+    free(ssdCache);
+    ssdCache = NULL;
+}
+
+//! Disk layer
+
+static void KvSsdSegmentPath(char *path, uint32 segment) {
+    snprintf(path, MAXPGPATH, "%s/seg_%08u", ssdPath, segment);
+}
+
+static pg_crc32c KvSsdRecordCrc(const KvSsdRecordHeader *header, const char *key, const char *value) {
+    pg_crc32c crc;
+
+    INIT_CRC32C(crc);
+    COMP_CRC32C(crc, &header->valueLen,
+                sizeof(KvSsdRecordHeader) - offsetof(KvSsdRecordHeader, valueLen));
+    COMP_CRC32C(crc, key, header->keyLen);
+    COMP_CRC32C(crc, value, header->valueLen);
+    FIN_CRC32C(crc);
+    return crc;
+}
+
+static int KvSsdWriteAll(int fd, const char *buf, size_t len, off_t offset) {
+    while (len > 0) {
+        ssize_t written = pwrite(fd, buf, len, offset);
+
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return 1;
+        buf += written;
+        len -= written;
+        offset += written;
+    }
+    return 0;
+}
+
+static int KvSsdReadAll(int fd, char *buf, size_t len, off_t offset) {
+    while (len > 0) {
+        ssize_t nread = pread(fd, buf, len, offset);
+
+        if (nread < 0 && errno == EINTR)
+            continue;
+        if (nread <= 0)
+            return 1;
+        buf += nread;
+        len -= nread;
+        offset += nread;
+    }
+    return 0;
+}
+
+// Caller holds appendLock
+static void KvSsdFreeSegment(uint32 segment) {
+    char path[MAXPGPATH];
+
+    close(segments[segment].fd);
+    KvSsdSegmentPath(path, segment);
+    unlink(path);
+    segments[segment].fd = -1;
+    segments[segment].inUse = 0;
+    segments[segment].liveBytes = 0;
+    segments[segment].tombstones = 0;
+    freeSegments[freeNum++] = segment;
+}
+
+// Caller holds appendLock. Returns the segment with the lowest $Seq, or -1
+static int KvSsdOldestSegment(void) {
+    int oldest = -1;
+
+    for (uint32 i = 0; i < segmentNum; i++)
+        if (segments[i].inUse && (oldest < 0 || segments[i].seq < segments[oldest].seq))
+            oldest = (int) i;
+    return oldest;
+}
+
+// Caller holds appendLock. Unlinks the segments without live records, the
+// ones with tombstones once nothing older is left
+static void KvSsdReclaim(uint32 segment) {
+    if (!segments[segment].inUse || segment == activeSegment || segments[segment].liveBytes > 0)
+        return;
+    if (segments[segment].tombstones == 0) {
+        KvSsdFreeSegment(segment);
+        return;
+    }
+    for (;;) {
+        int oldest = KvSsdOldestSegment();
+
+        if (oldest < 0 || (uint32) oldest == activeSegment || segments[oldest].liveBytes > 0)
+            return;
+        KvSsdFreeSegment((uint32) oldest);
+    }
+}
+
+// Caller holds appendLock
+static int KvSsdStartSegment(void) {
+    char path[MAXPGPATH];
+    KvSsdSegmentHeader header;
+    uint32 segment;
+    int fd;
+
+    if (freeNum > 0)
+        segment = freeSegments[--freeNum];
+    else if (segmentNum < KV_SSD_MAX_SEGMENTS)
+        segment = segmentNum++;
+    else
+        return 1;
+
+    KvSsdSegmentPath(path, segment);
+    fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    header.magic = KV_SSD_SEGMENT_MAGIC;
+    header.pad = 0;
+    header.seq = nextSeq++;
+    if (fd < 0 || KvSsdWriteAll(fd, (char*) &header, sizeof(header), 0)) {
+        printf("%s failed to create %s, error = %s\n", __func__ , path, strerror(errno));
+        fflush(stdout);
+        if (fd >= 0)
+            close(fd);
+        freeSegments[freeNum++] = segment;
+        return 1;
+    }
+
+    if (segments[activeSegment].inUse) {
+        // Sealed, it is only read from now on
+        fdatasync(segments[activeSegment].fd);
+    }
+    segments[segment].fd = fd;
+    segments[segment].inUse = 1;
+    segments[segment].seq = header.seq;
+    segments[segment].liveBytes = 0;
+    segments[segment].tombstones = 0;
+    uint32 sealed = activeSegment;
+    activeSegment = segment;
+    activeOffset = sizeof(header);
+    if (sealed != segment)
+        KvSsdReclaim(sealed);
+    return 0;
+}
+
+// Caller holds appendLock. Appends a record to the active segment
+static int KvSsdAppend(KvFamily family, uint8 flags, const char *key, size_t keyLen,
+                       const char *value, size_t valueLen, KvSsdLocation *location) {
+    KvSsdRecordHeader header;
+    size_t recordLen = sizeof(header) + keyLen + valueLen;
+    char *record;
+
+    if (keyLen > PG_UINT16_MAX || recordLen > KV_SSD_SEGMENT_SIZE - sizeof(KvSsdSegmentHeader)) {
+        printf("%s record of %zu bytes doesn't fit a segment\n", __func__ , recordLen);
+        fflush(stdout);
+        return 1;
+    }
+    if (activeOffset + recordLen > KV_SSD_SEGMENT_SIZE && KvSsdStartSegment())
+        return 1;
+
+    header.magic = KV_SSD_RECORD_MAGIC;
+    header.valueLen = (uint32) valueLen;
+    header.keyLen = (uint16) keyLen;
+    header.family = (uint8) family;
+    header.flags = flags;
+    header.crc = KvSsdRecordCrc(&header, key, value);
+
+    record = (char*) malloc(recordLen);
+    if (record == NULL)
+        return 1;
+    memcpy(record, &header, sizeof(header));
+    memcpy(record + sizeof(header), key, keyLen);
+    memcpy(record + sizeof(header) + keyLen, value, valueLen);
+    if (KvSsdWriteAll(segments[activeSegment].fd, record, recordLen, activeOffset)) {
+        printf("%s failed, error = %s\n", __func__ , strerror(errno));
+        fflush(stdout);
+        free(record);
+        return 1;
+    }
+    free(record);
+
+    location->segment = activeSegment;
+    location->offset = activeOffset;
+    location->recordLen = (uint32) recordLen;
+    location->seq = segments[activeSegment].seq;
+    activeOffset += recordLen;
+    return 0;
+}
+
+// Caller holds appendLock. The index now points at location instead of old
+static void KvSsdRepoint(KvSsdLocation *old, const KvSsdLocation *location) {
+    if (location != NULL)
+        segments[location->segment].liveBytes += location->recordLen;
+    if (old != NULL) {
+        segments[old->segment].liveBytes -= old->recordLen;
+        KvSsdReclaim(old->segment);
+        free(old);
+    }
+}
+
+typedef struct KvSsdRead {
+    char **key;
+    size_t *keyLen;
+    char **value;
+    size_t *valueLen;
+    KvSsdLocation location;
+} KvSsdRead;
+
+// Runs under the index shard lock, which keeps the record's segment open
+static void KvSsdReadValue(const char *key, size_t keyLen, void *payload, void *arg) {
+    KvSsdLocation *location = (KvSsdLocation*) payload;
+    KvSsdRead *read = (KvSsdRead*) arg;
+    uint64 id = KvSsdRecordId(location->seq, location->offset);
+    size_t valueLen = location->recordLen - sizeof(KvSsdRecordHeader) - keyLen;
+
+    read->location = *location;
+    if (read->key != NULL) {
+        *read->key = (char*) malloc(keyLen);
+        memcpy(*read->key, key, keyLen);
+        *read->keyLen = keyLen;
+    }
+
+    *read->value = KvSsdCacheGet(id, read->valueLen);
+    if (*read->value != NULL)
+        return;
+    *read->value = (char*) malloc(Max(valueLen, 1));
+    if (KvSsdReadAll(segments[location->segment].fd, *read->value, valueLen,
+                     location->offset + sizeof(KvSsdRecordHeader) + keyLen)) {
+        printf("%s failed, segment = %u, offset = %u, error = %s\n", __func__ ,
+               location->segment, location->offset, strerror(errno));
+        fflush(stdout);
+        free(*read->value);
+        *read->value = NULL;
+        return;
+    }
+    *read->valueLen = valueLen;
+    KvSsdCachePut(id, *read->value, valueLen);
+}
+
+static void KvSsdCopyLocation(const char *key, size_t keyLen, void *payload, void *arg) {
+    *(KvSsdLocation*) arg = *(KvSsdLocation*) payload;
+}
+
+// Caller holds appendLock. Copies the live records of the oldest segment to
+// the active one, so it can be unlinked
+static void KvSsdClean(void) {
+    int oldest = KvSsdOldestSegment();
+    char *data;
+    uint32 offset = sizeof(KvSsdSegmentHeader);
+    struct stat st;
+
+    if (oldest < 0 || (uint32) oldest == activeSegment
+        || segments[oldest].liveBytes * KV_SSD_CLEAN_RATIO > KV_SSD_SEGMENT_SIZE)
+        return;
+    if (fstat(segments[oldest].fd, &st) != 0)
+        return;
+    data = (char*) malloc(st.st_size);
+    if (data == NULL || KvSsdReadAll(segments[oldest].fd, data, st.st_size, 0)) {
+        free(data);
+        return;
+    }
+
+    while (offset + sizeof(KvSsdRecordHeader) <= (uint32) st.st_size && segments[oldest].liveBytes > 0) {
+        KvSsdRecordHeader header;
+        KvSsdLocation current;
+        KvSsdLocation moved;
+
+        memcpy(&header, data + offset, sizeof(header));
+        if (header.magic != KV_SSD_RECORD_MAGIC)
+            break;
+        size_t recordLen = sizeof(header) + header.keyLen + header.valueLen;
+        const char *key = data + offset + sizeof(header);
+        const char *value = key + header.keyLen;
+
+        // Only the records the index still points at are live
+        if (!(header.flags & KV_SSD_RECORD_TOMBSTONE)
+            && KvIndexGet(ssdIndex, (KvFamily) header.family, key, header.keyLen, KvSsdCopyLocation, &current)
+            && current.segment == (uint32) oldest && current.offset == offset
+            && KvSsdAppend((KvFamily) header.family, 0, key, header.keyLen, value, header.valueLen, &moved) == 0) {
+            KvSsdLocation *stored = (KvSsdLocation*) malloc(sizeof(KvSsdLocation));
+
+            *stored = moved;
+            KvSsdRepoint(KvIndexPut(ssdIndex, (KvFamily) header.family, key, header.keyLen, stored), stored);
+        }
+        offset += recordLen;
+    }
+    free(data);
+    // Nothing older holds the keys of its tombstones
+    if (segments[oldest].inUse && segments[oldest].liveBytes == 0)
+        KvSsdFreeSegment((uint32) oldest);
+}
+
+typedef struct KvSsdFoundSegment {
+    uint32 segment;
+    uint64 seq;
+    int fd;
+} KvSsdFoundSegment;
+
+static int KvSsdCompareSeq(const void *a, const void *b) {
+    uint64 seqA = ((const KvSsdFoundSegment*) a)->seq;
+    uint64 seqB = ((const KvSsdFoundSegment*) b)->seq;
+
+    return seqA < seqB ? -1 : (seqA > seqB ? 1 : 0);
+}
+
+// Replays one segment into the index, returns the end of its valid records
+static uint32 KvSsdReplaySegment(uint32 segment, char *data) {
+    uint32 offset = sizeof(KvSsdSegmentHeader);
+    struct stat st;
+    size_t size = 0;
+
+    if (fstat(segments[segment].fd, &st) == 0 && st.st_size <= KV_SSD_SEGMENT_SIZE
+        && KvSsdReadAll(segments[segment].fd, data, st.st_size, 0) == 0)
+        size = st.st_size;
+    while (offset + sizeof(KvSsdRecordHeader) <= size) {
+        KvSsdRecordHeader header;
+
+        memcpy(&header, data + offset, sizeof(header));
+        size_t recordLen = sizeof(header) + header.keyLen + header.valueLen;
+        if (header.magic != KV_SSD_RECORD_MAGIC || header.family >= KV_FAMILY_NUM
+            || offset + recordLen > size)
+            break;
+        const char *key = data + offset + sizeof(header);
+        const char *value = key + header.keyLen;
+        // A torn write ends the log
+        if (!EQ_CRC32C(header.crc, KvSsdRecordCrc(&header, key, value)))
+            break;
+
+        if (header.flags & KV_SSD_RECORD_TOMBSTONE) {
+            segments[segment].tombstones++;
+            KvSsdRepoint(KvIndexDelete(ssdIndex, (KvFamily) header.family, key, header.keyLen), NULL);
+        } else {
+            KvSsdLocation *location = (KvSsdLocation*) malloc(sizeof(KvSsdLocation));
+
+            location->segment = segment;
+            location->offset = offset;
+            location->recordLen = (uint32) recordLen;
+            location->seq = segments[segment].seq;
+            KvSsdRepoint(KvIndexPut(ssdIndex, (KvFamily) header.family, key, header.keyLen, location), location);
+        }
+        offset += recordLen;
+    }
+    return offset;
+}
+
+static int KvSsdOpen(void) {
+    KvSsdFoundSegment *found;
+    int foundNum = 0;
+    DIR *dir;
+    struct dirent *de;
+    char *data;
+
+    snprintf(ssdPath, sizeof(ssdPath), "%s/%s", DataDir, KV_SSD_DIR);
+    if (mkdir(ssdPath, 0700) != 0 && errno != EEXIST) {
+        printf("%s failed to create %s, error = %s\n", __func__ , ssdPath, strerror(errno));
+        fflush(stdout);
+        return 1;
+    }
+
+    segments = (KvSsdSegment*) calloc(KV_SSD_MAX_SEGMENTS, sizeof(KvSsdSegment));
+    freeSegments = (uint32*) malloc(sizeof(uint32) * KV_SSD_MAX_SEGMENTS);
+    found = (KvSsdFoundSegment*) malloc(sizeof(KvSsdFoundSegment) * KV_SSD_MAX_SEGMENTS);
+    ssdCache = (KvSsdCacheShard*) calloc(KV_SSD_CACHE_SHARDS, sizeof(KvSsdCacheShard));
+    for (int i = 0; i < KV_SSD_CACHE_SHARDS; i++)
+        pthread_mutex_init(&ssdCache[i].lock, NULL);
+    ssdIndex = KvIndexCreate();
+
+    dir = opendir(ssdPath);
+    while (dir != NULL && (de = readdir(dir)) != NULL) {
+        char path[MAXPGPATH];
+        KvSsdSegmentHeader header;
+        uint32 segment;
+        int fd;
+
+        if (sscanf(de->d_name, "seg_%08u", &segment) != 1 || segment >= KV_SSD_MAX_SEGMENTS)
+            continue;
+        KvSsdSegmentPath(path, segment);
+        fd = open(path, O_RDWR);
+        if (fd < 0)
+            continue;
+        // Created but never written, drop it
+        if (KvSsdReadAll(fd, (char*) &header, sizeof(header), 0) || header.magic != KV_SSD_SEGMENT_MAGIC) {
+            close(fd);
+            unlink(path);
+            continue;
+        }
+        found[foundNum].segment = segment;
+        found[foundNum].seq = header.seq;
+        found[foundNum].fd = fd;
+        foundNum++;
+    }
+    if (dir != NULL)
+        closedir(dir);
+
+    // Later records overwrite earlier ones, replay in $Seq order
+    qsort(found, foundNum, sizeof(KvSsdFoundSegment), KvSsdCompareSeq);
+    pthread_mutex_lock(&appendLock);
+    for (int i = 0; i < foundNum; i++) {
+        uint32 segment = found[i].segment;
+
+        segments[segment].fd = found[i].fd;
+        segments[segment].inUse = 1;
+        segments[segment].seq = found[i].seq;
+        segmentNum = Max(segmentNum, segment + 1);
+        nextSeq = found[i].seq + 1;
+    }
+    for (uint32 i = 0; i < segmentNum; i++)
+        if (!segments[i].inUse)
+            freeSegments[freeNum++] = i;
+
+    // Segments whose records are all overwritten later are unlinked on the way
+    data = (char*) malloc(KV_SSD_SEGMENT_SIZE);
+    for (int i = 0; i < foundNum; i++) {
+        activeSegment = found[i].segment;
+        activeOffset = KvSsdReplaySegment(activeSegment, data);
+    }
+    free(data);
+    free(found);
+
+    int err = 0;
+    if (foundNum == 0) {
+        err = KvSsdStartSegment();
+    } else {
+        // Whatever follows the last valid record was never acknowledged
+        if (ftruncate(segments[activeSegment].fd, activeOffset) != 0) {
+            printf("%s failed to truncate the active segment, error = %s\n", __func__ , strerror(errno));
+            fflush(stdout);
+        }
+        for (uint32 i = 0; i < segmentNum; i++)
+            if (segments[i].inUse)
+                KvSsdReclaim(i);
+    }
+    pthread_mutex_unlock(&appendLock);
+    printf("%s opened %s, %d segments\n", __func__ , ssdPath, foundNum);
+    fflush(stdout);
+    return err;
+}
+
+static void KvSsdClose(void) {
+    pthread_mutex_lock(&appendLock);
+    KvIndexDestroy(ssdIndex, free);
+    ssdIndex = NULL;
+    for (uint32 i = 0; i < segmentNum; i++)
+        if (segments[i].inUse) {
+            fdatasync(segments[i].fd);
+            close(segments[i].fd);
+        }
+    free(segments);
+    free(freeSegments);
+    segments = NULL;
+    freeSegments = NULL;
+    segmentNum = freeNum = 0;
+    KvSsdCacheDestroy();
+    pthread_mutex_unlock(&appendLock);
+}
+
+static int KvSsdPut(KvFamily family, const char *key, size_t keyLen, const char *value, size_t valueLen) {
+    KvSsdLocation *location = (KvSsdLocation*) malloc(sizeof(KvSsdLocation));
+    uint32 segment;
+
+    if (location == NULL)
+        return 1;
+    pthread_mutex_lock(&appendLock);
+    segment = activeSegment;
+    if (KvSsdAppend(family, 0, key, keyLen, value, valueLen, location)) {
+        pthread_mutex_unlock(&appendLock);
+        free(location);
+        return 1;
+    }
+    KvSsdRepoint(KvIndexPut(ssdIndex, family, key, keyLen, location), location);
+    // A new segment was started, make room behind it
+    if (location->segment != segment)
+        KvSsdClean();
+    KvSsdCachePut(KvSsdRecordId(location->seq, location->offset), value, valueLen);
+    pthread_mutex_unlock(&appendLock);
+    return 0;
+}
+
+static int KvSsdGet(KvFamily family, const char *key, size_t keyLen, char **value, size_t *valueLen) {
+    KvSsdRead read = {NULL, NULL, value, valueLen};
+
+    *value = NULL;
+    *valueLen = 0;
+    KvIndexGet(ssdIndex, family, key, keyLen, KvSsdReadValue, &read);
+    return 0;
+}
+
+static int KvSsdDelete(KvFamily family, const char *key, size_t keyLen) {
+    KvSsdLocation tombstone;
+    KvSsdLocation current;
+    int err = 0;
+
+    pthread_mutex_lock(&appendLock);
+    if (KvIndexGet(ssdIndex, family, key, keyLen, KvSsdCopyLocation, &current)) {
+        err = KvSsdAppend(family, KV_SSD_RECORD_TOMBSTONE, key, keyLen, "", 0, &tombstone);
+        if (err == 0) {
+            segments[tombstone.segment].tombstones++;
+            KvSsdRepoint(KvIndexDelete(ssdIndex, family, key, keyLen), NULL);
+        }
+    }
+    pthread_mutex_unlock(&appendLock);
+    return err;
+}
+
+static int KvSsdSeek(KvFamily family, const char *key, size_t keyLen, size_t prefixLen,
+                     char **foundKey, size_t *foundKeyLen, char **value, size_t *valueLen) {
+    KvSsdRead read = {foundKey, foundKeyLen, value, valueLen};
+
+    *value = NULL;
+    if (!KvIndexSeek(ssdIndex, family, key, keyLen, prefixLen, KvSsdReadValue, &read))
+        return 0;
+    if (*value == NULL) {
+        free(*foundKey);
+        *foundKey = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+const KvEngine KvSsdEngine = {
+    "ssd",
+    KvSsdOpen,
+    KvSsdClose,
+    KvSsdPut,
+    KvSsdGet,
+    KvSsdDelete,
+    KvSsdSeek,
+    0
+};
@@ -4,6 +4,10 @@
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <dirent.h>
+#include <ftw.h>
+#include <pthread.h>
+#include <sys/stat.h>
 #include "storage/kv_interface.h"
 #include "pg_config_manual.h"
 #include "stdlib.h"
@@ -15,29 +19,120 @@
 #include "miscadmin.h"
 #include "postgres.h"
 #include "storage/buf_internals.h"
+#include "storage/cpu_roles.h"
 #include "access/xlogreader.h"
-#ifdef USE_LIGHT_KV
-// #include "storage/light_weighted_kvstore_api.h"
-#endif
+#include "common/file_perm.h"
+#include "port/pg_bswap.h"
+#include "storage/kv_engine.h"
+#include "storage/kv_page_cache.h"
+#include "storage/kv_page_delta.h"
+#include "storage/kv_tier.h"
+#include "storage/stage_timing.h"
 
 #define USE_ROCKSDB 1
-//#define USE_LIGHT_KV 1
 
 #ifdef USE_ROCKSDB
 
 #include "rocksdb/c.h"
-rocksdb_t *db = NULL;
 
 #endif
 
+// The engine in use, set once the store is open
+static const KvEngine *kvEngine = NULL;
+static pthread_mutex_t kvEngineLock = PTHREAD_MUTEX_INITIALIZER;
+
+#ifdef USE_ROCKSDB
+
+static const char *const familyNames[KV_FAMILY_NUM] = {"default", "meta", "pages", "xlog"};
+
+//! With kv_per_database the page versions and lsn chains of each database
+//! live in a rocksdb instance of their own, under KV_DATABASE_STORE_DIR, so
+//! the flushes, compactions and write stalls of one database don't hold up
+//! the others, and a dropped database goes with its directory. The xlog, the
+//! pages of the shared catalogs and the string keys stay in the main store.
+//! The instances are opened with the same options, they share the env's
+//! background threads, the block cache and the compaction rate limiter.
+typedef struct KvRocksdbStore {
+    Oid dbid;                   // InvalidOid for the main store
+    // Held shared while db is used, exclusively to open or close it. Readers
+    // nest, a delta reads its base under it, the default rwlock prefers them
+    pthread_rwlock_t lock;
+    rocksdb_t *db;              // NULL until opened, and once dropped
+    rocksdb_column_family_handle_t *families[KV_FAMILY_NUM];
+    rocksdb_writebatch_wi_t *pageBatch;   // under pageBatchLock
+    XLogRecPtr dropLsn;         // the database was dropped there, 0 if it wasn't
+} KvRocksdbStore;
+
+// Database stores are found by OID in the table, slots are only ever filled.
+// Past KV_DATABASE_STORES databases the pages of the others can't be stored.
+#define KV_DATABASE_STORES (4096)
+#define KV_DATABASE_STORE_DIR ("rocksdb_databases")
+
+static KvRocksdbStore mainStore = {InvalidOid, PTHREAD_RWLOCK_INITIALIZER};
+static KvRocksdbStore *databaseStores[KV_DATABASE_STORES];
+// The same stores in the order they were added, to walk them
+static KvRocksdbStore *databaseStoreList[KV_DATABASE_STORES];
+static int databaseStoreNum = 0;
+static pthread_mutex_t databaseStoresLock = PTHREAD_MUTEX_INITIALIZER;
+
+// The options and family options are kept for the lifetime of the store,
+// database stores are opened with them and the page batch looks keys up
+// with the family ones
+static rocksdb_options_t *storeOptions = NULL;
+static rocksdb_options_t *familyOptions[KV_FAMILY_NUM];
+static rocksdb_cache_t *blockCache = NULL;
+static rocksdb_ratelimiter_t *rateLimiter = NULL;
+
+//! Page version puts and deletes are combined into an indexed write batch
+//! per store. It is committed once kv_page_batch_size writes are pending, or
+//! by the flusher thread after kv_page_batch_delay ms. Reads look into the
+//! batch first, so a version is visible as soon as it is put. A store's lock
+//! is taken before pageBatchLock.
+static pthread_mutex_t pageBatchLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pageBatchCond = PTHREAD_COND_INITIALIZER;
+static int pageBatchFlusherStarted = 0;
+
+// Created with the store and shared by all threads, rocksdb only reads them
+static rocksdb_readoptions_t *readOptions = NULL;
+static rocksdb_readoptions_t *prefixReadOptions = NULL;
+static rocksdb_writeoptions_t *writeOptions = NULL;
+static rocksdb_writeoptions_t *pageWriteOptions = NULL;
+
+#endif
+
+// GUCs
+int kv_page_batch_size = 32;
+int kv_page_batch_delay = 5;
+bool kv_page_disable_wal = false;
+bool kv_page_compaction_gc = true;
+int kv_page_delta_versions = 0;
+bool kv_per_database = false;
+int kv_compaction_rate_limit = 0;
+
+// Oldest LSN a compute node may still read, 0 while unknown
+static uint64_t pageGcHorizon = 0;
+
 // $SpcID_$DbID_$RelID_$ForkNum_$BlkNum
 #define ROCKSDB_LSN_LIST_KEY  ("rocks_list_%lu_%lu_%lu_%d_%u\0")
 
-// $SpcID_$DbID_$RelID_$ForkNum_$BlkNum_$LSN
-#define ROCKSDB_PAGE_VERSION_KEY  ("rocks_page_%lu_%lu_%lu_%d_%u_%lu\0")
-
-// $LSN
-#define ROCKSDB_XLOG_KEY ("rocks_xlog_%lu\0")
+//! The page keys are laid out in kv_engine.h. In rocksdb the bloom filters
+//! are built on the page prefix, so a lookup of a page that was never stored
+//! skips the SSTs.
+#define KV_KEY_KIND_PAGE_VERSION (0x50414745)  // "PAGE"
+#define KV_KEY_KIND_LSN_CHAIN (0x43484E4C)     // "CHNL", logindex version chain spilled by the hashmap
+
+// Kept in the meta family, stores of an older layout lack it
+#define KV_KEY_FORMAT_KEY ("rocks_key_format")
+#define KV_KEY_FORMAT_VERSION ("4")
+// Kept in the meta family of the main store, stores without it are shared
+#define KV_LAYOUT_KEY ("rocks_layout")
+#define KV_LAYOUT_SHARED ("shared")
+#define KV_LAYOUT_PER_DATABASE ("per_database")
+#define KV_BLOOM_BITS_PER_KEY (10)
+#define KV_BLOCK_CACHE_SIZE ((size_t)1024*1024*1024)
+
+// Xlog keys are the big-endian $LSN, so the records are appended in key order
+#define KV_XLOG_KEY_LEN (8)
 
 #define MAX_PATH_LEN (256)
 
@@ -47,17 +142,421 @@ char KvStorePath[MAXPGPATH];
 //! Total length = uint64 * ($ListLen+2)
 //! $CurrPos points to [0, ..., (n-1)]
 
-#ifdef USE_LIGHT_KV
-void InitKvStore() {
-    InitLightWeightedKVStore();
+#ifdef USE_ROCKSDB
+static void KvStartPageBatchFlusher(void);
+
+//! Page version GC runs in compaction. Within a page the versions come
+//! newest first, the first full version at or below the horizon is the base
+//! any compute node could still need. The ones older than it are dropped
+//! without a tombstone, the deltas and loose versions in between are kept.
+//! A compaction sees only part of the versions, so it may keep more than
+//! that, never less.
+typedef struct KvPageGcFilter {
+    char prefix[KV_PAGE_PREFIX_LEN];
+    int havePrefix;
+    int baseKept;
+    uint64_t horizon;
+} KvPageGcFilter;
+
+static unsigned char KvPageGcFilterFilter(void *state, int level, const char *key, size_t keyLength,
+                                          const char *existingValue, size_t valueLength, char **newValue,
+                                          size_t *newValueLength, unsigned char *valueChanged) {
+    KvPageGcFilter *filter = (KvPageGcFilter*) state;
+    uint64 beLsn;
+
+    *valueChanged = 0;
+    if (filter->horizon == 0 || keyLength != KV_PAGE_KEY_LEN)
+        return 0;
+    if (!filter->havePrefix || memcmp(filter->prefix, key, KV_PAGE_PREFIX_LEN) != 0) {
+        memcpy(filter->prefix, key, KV_PAGE_PREFIX_LEN);
+        filter->havePrefix = 1;
+        filter->baseKept = 0;
+    }
+    memcpy(&beLsn, key + KV_PAGE_PREFIX_LEN, sizeof(beLsn));
+    if (~pg_ntoh64(beLsn) > filter->horizon)
+        return 0;
+    if (!filter->baseKept) {
+        uint64_t baseLsn;
+        int kind = KvPageValueKind(existingValue, valueLength, &baseLsn);
+
+        // A base moved to the object store is still the base
+        if (kind == KV_PAGE_VALUE_REMOTE)
+            kind = KvPageRemoteDecode(existingValue, valueLength, NULL);
+        filter->baseKept = kind == KV_PAGE_VALUE_BASE;
+        return 0;
+    }
+    return 1;
 }
-#endif
 
-#ifdef USE_ROCKSDB
-void InitKvStore() {
-    if (db != NULL) {
+static const char *KvPageGcFilterName(void *state) {
+    return "openaurora.page_version_gc";
+}
+
+static void KvPageGcFilterDestroy(void *state) {
+    free(state);
+}
+
+// One filter per (sub)compaction, each sees its keys in order
+static rocksdb_compactionfilter_t *KvPageGcFilterCreate(void *state, rocksdb_compactionfiltercontext_t *context) {
+    KvPageGcFilter *filter = (KvPageGcFilter*) calloc(1, sizeof(KvPageGcFilter));
+
+    // The horizon only moves forward, a late snapshot of it is still safe
+    filter->horizon = __atomic_load_n(&pageGcHorizon, __ATOMIC_ACQUIRE);
+    return rocksdb_compactionfilter_create(filter, KvPageGcFilterDestroy, KvPageGcFilterFilter, KvPageGcFilterName);
+}
+
+static void KvPageGcFactoryDestroy(void *state) {
+}
+
+static const char *KvPageGcFactoryName(void *state) {
+    return "openaurora.page_version_gc_factory";
+}
+
+// Page versions lived in the default family before, as string keys in the
+// oldest layout. Lookups through the families would miss all of them, refuse
+// such a store instead. Returns 1 if the store is new
+static int KvCheckKeyFormat(void) {
+    char *err = NULL;
+    size_t len = 0;
+    char *marker = rocksdb_get_cf(mainStore.db, readOptions, mainStore.families[KV_FAMILY_META],
+                                  KV_KEY_FORMAT_KEY, strlen(KV_KEY_FORMAT_KEY), &len, &err);
+
+    if (err == NULL && marker == NULL) {
+        rocksdb_iterator_t *it = rocksdb_create_iterator_cf(mainStore.db, readOptions,
+                                                            mainStore.families[KV_FAMILY_DEFAULT]);
+        int legacy;
+
+        rocksdb_iter_seek_to_first(it);
+        legacy = rocksdb_iter_valid(it);
+        rocksdb_iter_destroy(it);
+        if (legacy)
+            ereport(FATAL,
+                    (errmsg("rocksdb store \"%s\" uses an older key layout", KvStorePath),
+                     errhint("Remove the store, the storage node rebuilds the page versions from WAL.")));
+
+        rocksdb_put_cf(mainStore.db, writeOptions, mainStore.families[KV_FAMILY_META],
+                       KV_KEY_FORMAT_KEY, strlen(KV_KEY_FORMAT_KEY),
+                       KV_KEY_FORMAT_VERSION, strlen(KV_KEY_FORMAT_VERSION), &err);
+        if (err != NULL) {
+            printf("%s failed to write the key format marker, error = %s\n", __func__ , err);
+            fflush(stdout);
+            free(err);
+        }
+        return 1;
+    }
+
+    if (err != NULL) {
+        printf("%s failed to read the key format marker, error = %s\n", __func__ , err);
+        fflush(stdout);
+        free(err);
+        return 0;
+    }
+    if (len != strlen(KV_KEY_FORMAT_VERSION) || memcmp(marker, KV_KEY_FORMAT_VERSION, len) != 0) {
+        free(marker);
+        ereport(FATAL,
+                (errmsg("rocksdb store \"%s\" has an unknown key format", KvStorePath)));
+    }
+    free(marker);
+    return 0;
+}
+
+// Either layout would miss the page versions the other one wrote, a store
+// keeps the one it was created with. Stores from before kv_per_database
+// lack the marker, they are shared.
+static void KvCheckLayout(int newStore) {
+    const char *layout = kv_per_database ? KV_LAYOUT_PER_DATABASE : KV_LAYOUT_SHARED;
+    char *err = NULL;
+    size_t len = 0;
+    char *marker = rocksdb_get_cf(mainStore.db, readOptions, mainStore.families[KV_FAMILY_META],
+                                  KV_LAYOUT_KEY, strlen(KV_LAYOUT_KEY), &len, &err);
+
+    if (err != NULL) {
+        printf("%s failed to read the layout marker, error = %s\n", __func__ , err);
+        fflush(stdout);
+        free(err);
+        return;
+    }
+    if (marker == NULL && newStore) {
+        rocksdb_put_cf(mainStore.db, writeOptions, mainStore.families[KV_FAMILY_META],
+                       KV_LAYOUT_KEY, strlen(KV_LAYOUT_KEY), layout, strlen(layout), &err);
+        if (err != NULL) {
+            printf("%s failed to write the layout marker, error = %s\n", __func__ , err);
+            fflush(stdout);
+            free(err);
+        }
+        return;
+    }
+    if (marker == NULL ? strcmp(layout, KV_LAYOUT_SHARED) != 0
+                       : len != strlen(layout) || memcmp(marker, layout, len) != 0) {
+        free(marker);
+        ereport(FATAL,
+                (errmsg("rocksdb store \"%s\" wasn't created with kv_per_database = %s",
+                        KvStorePath, kv_per_database ? "on" : "off"),
+                 errhint("Set kv_per_database as it was, or remove the store, the storage node rebuilds "
+                         "the page versions from WAL.")));
+    }
+    free(marker);
+}
+
+static void KvDatabaseStorePath(char *path, Oid dbid) {
+    snprintf(path, MAXPGPATH, "%s/%s/%u", DataDir, KV_DATABASE_STORE_DIR, dbid);
+}
+
+// Caller holds store->lock exclusively. Returns 0 once the store is open
+static int KvStoreOpenLocked(KvRocksdbStore *store, const char *path) {
+    char *err = NULL;
+    rocksdb_t *storeDb = rocksdb_open_column_families(storeOptions, path, KV_FAMILY_NUM, familyNames,
+                                                      (const rocksdb_options_t *const *) familyOptions,
+                                                      store->families, &err);
+
+    if (err != NULL) {
+        printf("%s open %s failed, error = %s\n", __func__ , path, err);
+        fflush(stdout);
+        free(err);
+        return 1;
+    }
+    pthread_mutex_lock(&pageBatchLock);
+    if (store->pageBatch == NULL)
+        store->pageBatch = rocksdb_writebatch_wi_create(0, 1);
+    pthread_mutex_unlock(&pageBatchLock);
+    __atomic_store_n(&store->db, storeDb, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// Caller holds store->lock exclusively, the batch was committed or dropped
+static void KvStoreCloseLocked(KvRocksdbStore *store) {
+    if (store->db == NULL)
+        return;
+    for (int i = 0; i < KV_FAMILY_NUM; i++)
+        rocksdb_column_family_handle_destroy(store->families[i]);
+    rocksdb_close(store->db);
+    __atomic_store_n(&store->db, NULL, __ATOMIC_RELEASE);
+}
+
+// Takes the store's lock shared and returns its db, or NULL without the lock
+// if it isn't open
+static rocksdb_t *KvStoreAcquire(KvRocksdbStore *store) {
+    if (store == NULL)
+        return NULL;
+    pthread_rwlock_rdlock(&store->lock);
+    if (store->db == NULL) {
+        pthread_rwlock_unlock(&store->lock);
+        return NULL;
+    }
+    return store->db;
+}
+
+static void KvStoreRelease(KvRocksdbStore *store) {
+    pthread_rwlock_unlock(&store->lock);
+}
+
+//! The store of a database, opened on its first use. One that doesn't exist
+//! is created if create is set, the reads don't. NULL if there is none or it
+//! can't be opened.
+static KvRocksdbStore *KvDatabaseStore(Oid dbid, int create) {
+    uint32 slot = (dbid * 0x9E3779B1U) % KV_DATABASE_STORES;
+    KvRocksdbStore *store = NULL;
+    char path[MAXPGPATH];
+    struct stat st;
+
+    for (int i = 0; i < KV_DATABASE_STORES; i++) {
+        KvRocksdbStore *found = __atomic_load_n(&databaseStores[(slot + i) % KV_DATABASE_STORES], __ATOMIC_ACQUIRE);
+
+        if (found == NULL || found->dbid == dbid) {
+            store = found;
+            break;
+        }
+    }
+    if (store != NULL && __atomic_load_n(&store->db, __ATOMIC_ACQUIRE) != NULL)
+        return store;
+
+    KvDatabaseStorePath(path, dbid);
+    if (!create && stat(path, &st) != 0)
+        return NULL;
+
+    if (store == NULL) {
+        pthread_mutex_lock(&databaseStoresLock);
+        for (int i = 0; i < KV_DATABASE_STORES; i++) {
+            KvRocksdbStore **at = &databaseStores[(slot + i) % KV_DATABASE_STORES];
+
+            if (*at == NULL) {
+                KvRocksdbStore *added = (KvRocksdbStore*) calloc(1, sizeof(KvRocksdbStore));
+
+                added->dbid = dbid;
+                pthread_rwlock_init(&added->lock, NULL);
+                databaseStoreList[databaseStoreNum] = added;
+                __atomic_store_n(&databaseStoreNum, databaseStoreNum + 1, __ATOMIC_RELEASE);
+                __atomic_store_n(at, added, __ATOMIC_RELEASE);
+            }
+            if ((*at)->dbid == dbid) {
+                store = *at;
+                break;
+            }
+        }
+        pthread_mutex_unlock(&databaseStoresLock);
+        if (store == NULL) {
+            printf("%s no room for the store of database %u\n", __func__ , dbid);
+            fflush(stdout);
+            return NULL;
+        }
+    }
+
+    pthread_rwlock_wrlock(&store->lock);
+    if (store->db == NULL) {
+        char parent[MAXPGPATH];
+
+        snprintf(parent, sizeof(parent), "%s/%s", DataDir, KV_DATABASE_STORE_DIR);
+        if (pg_mkdir_p(parent, pg_dir_create_mode) != 0 && errno != EEXIST) {
+            printf("%s mkdir %s failed, errno = %d\n", __func__ , parent, errno);
+            fflush(stdout);
+        } else if (KvStoreOpenLocked(store, path) == 0) {
+            store->dropLsn = InvalidXLogRecPtr;
+        }
+    }
+    pthread_rwlock_unlock(&store->lock);
+    return __atomic_load_n(&store->db, __ATOMIC_ACQUIRE) != NULL ? store : NULL;
+}
+
+//! The database of a key, InvalidOid for the ones of the main store: every
+//! xlog and string key, and the pages of the shared catalogs
+static Oid KvKeyDatabase(KvFamily family, const char *key, size_t keyLen) {
+    uint32 fields[3];
+
+    if ((family != KV_FAMILY_PAGE && family != KV_FAMILY_META) || keyLen < KV_PAGE_PREFIX_LEN)
+        return InvalidOid;
+    memcpy(fields, key, sizeof(fields));
+    if (pg_ntoh32(fields[0]) != KV_KEY_KIND_PAGE_VERSION && pg_ntoh32(fields[0]) != KV_KEY_KIND_LSN_CHAIN)
+        return InvalidOid;
+    return (Oid) pg_ntoh32(fields[2]);
+}
+
+static KvRocksdbStore *KvStoreForDatabase(Oid dbid, int create) {
+    if (!kv_per_database || dbid == InvalidOid)
+        return &mainStore;
+    return KvDatabaseStore(dbid, create);
+}
+
+static KvRocksdbStore *KvStoreForKey(KvFamily family, const char *key, size_t keyLen, int create) {
+    return KvStoreForDatabase(KvKeyDatabase(family, key, keyLen), create);
+}
+
+// Walks the main store and then the database stores, *pos starts at 0.
+// Returns NULL past the last one
+static KvRocksdbStore *KvStoreNext(int *pos) {
+    int num = __atomic_load_n(&databaseStoreNum, __ATOMIC_ACQUIRE);
+
+    if (*pos > num)
+        return NULL;
+    return (*pos)++ == 0 ? &mainStore : databaseStoreList[*pos - 2];
+}
+
+static int KvRemoveEntry(const char *path, const struct stat *st, int flag, struct FTW *ftw) {
+    if (remove(path) != 0) {
+        printf("%s remove %s failed, errno = %d\n", __func__ , path, errno);
+        fflush(stdout);
+    }
+    return 0;
+}
+
+static void *KvRemoveDirectory(void *arg) {
+    char *path = (char*) arg;
+
+    nftw(path, KvRemoveEntry, 16, FTW_DEPTH | FTW_PHYS);
+    free(path);
+    return NULL;
+}
+
+// Removal runs in a thread of its own, a large store takes a while
+static void KvRemoveInBackground(char *doomed) {
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, KvRemoveDirectory, doomed) == 0)
+        pthread_detach(thread);
+    else
+        KvRemoveDirectory(doomed);
+}
+
+// What a crash left of the stores being removed
+static void KvRemoveDroppedStores(void) {
+    char parent[MAXPGPATH];
+    struct dirent *entry;
+    DIR *dir;
+
+    snprintf(parent, sizeof(parent), "%s/%s", DataDir, KV_DATABASE_STORE_DIR);
+    if ((dir = opendir(parent)) == NULL)
         return;
+    while ((entry = readdir(dir)) != NULL) {
+        char *doomed;
+
+        if (strstr(entry->d_name, ".dropped.") == NULL)
+            continue;
+        doomed = (char*) malloc(MAXPGPATH);
+        snprintf(doomed, MAXPGPATH, "%s/%s", parent, entry->d_name);
+        KvRemoveInBackground(doomed);
+    }
+    closedir(dir);
+}
+
+// Caller holds store->lock exclusively. The store is closed and its
+// directory renamed away at once, nothing reads the database any more
+static void KvReapStoreLocked(KvRocksdbStore *store) {
+    char path[MAXPGPATH];
+    char *doomed;
+
+    if (store->db != NULL) {
+        pthread_mutex_lock(&pageBatchLock);
+        rocksdb_writebatch_wi_clear(store->pageBatch);
+        pthread_mutex_unlock(&pageBatchLock);
+        KvStoreCloseLocked(store);
+
+        KvDatabaseStorePath(path, store->dbid);
+        doomed = (char*) malloc(MAXPGPATH);
+        snprintf(doomed, MAXPGPATH, "%s.dropped.%lX", path, (unsigned long) store->dropLsn);
+        if (rename(path, doomed) == 0) {
+            KvRemoveInBackground(doomed);
+        } else {
+            printf("%s rename %s failed, errno = %d\n", __func__ , path, errno);
+            fflush(stdout);
+            free(doomed);
+        }
     }
+    __atomic_store_n(&store->dropLsn, InvalidXLogRecPtr, __ATOMIC_RELEASE);
+}
+
+//! A dropped database's store goes once no compute node reads below the
+//! drop. The flusher thread checks, it passes over a store in use. A storage
+//! node restarted before that keeps the store, as it keeps the versions of
+//! dropped relations.
+static void KvReapDroppedStores(void) {
+    uint64_t horizon = KvGetPageGcHorizon();
+    int num = __atomic_load_n(&databaseStoreNum, __ATOMIC_ACQUIRE);
+
+    for (int i = 0; i < num; i++) {
+        KvRocksdbStore *store = databaseStoreList[i];
+        XLogRecPtr dropLsn = __atomic_load_n(&store->dropLsn, __ATOMIC_ACQUIRE);
+
+        if (dropLsn == InvalidXLogRecPtr || horizon == 0 || horizon < dropLsn)
+            continue;
+        if (pthread_rwlock_trywrlock(&store->lock) != 0)
+            continue;
+        if (store->dropLsn != InvalidXLogRecPtr)
+            KvReapStoreLocked(store);
+        pthread_rwlock_unlock(&store->lock);
+    }
+}
+
+static rocksdb_block_based_table_options_t *KvTableOptionsCreate(int wholeKeyFiltering) {
+    rocksdb_block_based_table_options_t *tableOptions = rocksdb_block_based_options_create();
+
+    rocksdb_block_based_options_set_filter_policy(tableOptions,
+            rocksdb_filterpolicy_create_bloom(KV_BLOOM_BITS_PER_KEY));
+    rocksdb_block_based_options_set_whole_key_filtering(tableOptions, wholeKeyFiltering);
+    rocksdb_block_based_options_set_block_cache(tableOptions, blockCache);
+    rocksdb_block_based_options_set_cache_index_and_filter_blocks(tableOptions, 1);
+    return tableOptions;
+}
+
+static int KvRocksdbOpen(void) {
     printf("%s start\n", __func__ );
     fflush(stdout);
 
@@ -94,94 +593,281 @@ void InitKvStore() {
     rocksdb_options_set_write_buffer_size(options, (size_t)10*1024*1024*1024);
 
     rocksdb_env_t *options_env = rocksdb_create_default_env();
+    // The flush and compaction threads start here and keep the mask of
+    // storage/cpu_roles.h, below the parse in priority as well
+    CpuRoleBind(CPU_ROLE_COMPACTION, -1);
     rocksdb_env_set_high_priority_background_threads(options_env, (int)(cpus));
     rocksdb_env_set_low_priority_background_threads(options_env, (int)(cpus));
+    if (CpuRolesEnabled()) {
+        rocksdb_env_lower_thread_pool_cpu_priority(options_env);
+        rocksdb_env_lower_high_priority_thread_pool_cpu_priority(options_env);
+    }
+    CpuRoleBind(CPU_ROLE_OTHER, -1);
     rocksdb_options_set_env(options,options_env);
+    // One limiter for the flushes and compactions of every store, which all
+    // run on the env's threads
+    if (kv_compaction_rate_limit > 0) {
+        rateLimiter = rocksdb_ratelimiter_create((int64_t) kv_compaction_rate_limit * 1024 * 1024, 100 * 1000, 10);
+        rocksdb_options_set_ratelimiter(options, rateLimiter);
+    }
     // create the DB if it's not already present
     rocksdb_options_set_create_if_missing(options, 1);
-
+    rocksdb_options_set_create_missing_column_families(options, 1);
+
+    blockCache = rocksdb_cache_create_lru(KV_BLOCK_CACHE_SIZE);
+    rocksdb_block_based_table_options_t *tableOptions[KV_FAMILY_NUM];
+    for (int i = 0; i < KV_FAMILY_NUM; i++)
+        familyOptions[i] = rocksdb_options_create_copy(options);
+
+    // Nothing is written to the default family any more
+    rocksdb_options_set_write_buffer_size(familyOptions[KV_FAMILY_DEFAULT], (size_t)4*1024*1024);
+    tableOptions[KV_FAMILY_DEFAULT] = KvTableOptionsCreate(1);
+
+    rocksdb_options_set_write_buffer_size(familyOptions[KV_FAMILY_META], (size_t)64*1024*1024);
+    tableOptions[KV_FAMILY_META] = KvTableOptionsCreate(1);
+
+    // Most page lookups are misses for pages that were never materialized,
+    // the prefix bloom answers them without touching the data blocks. Keep
+    // whole key filters too, the exact version lookups use them.
+    rocksdb_options_set_prefix_extractor(familyOptions[KV_FAMILY_PAGE],
+            rocksdb_slicetransform_create_fixed_prefix(KV_PAGE_PREFIX_LEN));
+    rocksdb_options_set_memtable_prefix_bloom_size_ratio(familyOptions[KV_FAMILY_PAGE], 0.1);
+    rocksdb_options_set_write_buffer_size(familyOptions[KV_FAMILY_PAGE], (size_t)512*1024*1024);
+    rocksdb_options_set_max_write_buffer_number(familyOptions[KV_FAMILY_PAGE], 4);
+    tableOptions[KV_FAMILY_PAGE] = KvTableOptionsCreate(1);
+    if (kv_page_compaction_gc)
+        rocksdb_options_set_compaction_filter_factory(familyOptions[KV_FAMILY_PAGE],
+                rocksdb_compactionfilterfactory_create(NULL, KvPageGcFactoryDestroy,
+                                                       KvPageGcFilterCreate, KvPageGcFactoryName));
+
+    // Xlog arrives in LSN order, in bursts. Universal compaction merges the
+    // sorted runs without rewriting each level, and more memtables absorb the
+    // bursts instead of stalling the writes. FIFO would drop records that
+    // still have to be replayed.
+    rocksdb_options_set_compaction_style(familyOptions[KV_FAMILY_XLOG], rocksdb_universal_compaction);
+    rocksdb_options_set_compression(familyOptions[KV_FAMILY_XLOG], rocksdb_no_compression);
+    rocksdb_options_set_write_buffer_size(familyOptions[KV_FAMILY_XLOG], (size_t)256*1024*1024);
+    rocksdb_options_set_max_write_buffer_number(familyOptions[KV_FAMILY_XLOG], 6);
+    tableOptions[KV_FAMILY_XLOG] = KvTableOptionsCreate(1);
+
+    for (int i = 0; i < KV_FAMILY_NUM; i++)
+        rocksdb_options_set_block_based_table_factory(familyOptions[i], tableOptions[i]);
 
     // open DB
-    char *err = NULL;
-    db = rocksdb_open(options, KvStorePath, &err);
-    rocksdb_options_destroy(options);
+    int failed;
+    storeOptions = options;
+    pthread_rwlock_wrlock(&mainStore.lock);
+    failed = KvStoreOpenLocked(&mainStore, KvStorePath);
+    pthread_rwlock_unlock(&mainStore.lock);
+    for (int i = 0; i < KV_FAMILY_NUM; i++)
+        rocksdb_block_based_options_destroy(tableOptions[i]);
+    if (failed) {
+        for (int i = 0; i < KV_FAMILY_NUM; i++) {
+            rocksdb_options_destroy(familyOptions[i]);
+            familyOptions[i] = NULL;
+        }
+        rocksdb_options_destroy(storeOptions);
+        storeOptions = NULL;
+        if (rateLimiter != NULL)
+            rocksdb_ratelimiter_destroy(rateLimiter);
+        rateLimiter = NULL;
+        rocksdb_cache_destroy(blockCache);
+        blockCache = NULL;
+        return 1;
+    }
+
+    readOptions = rocksdb_readoptions_create();
+    prefixReadOptions = rocksdb_readoptions_create();
+    rocksdb_readoptions_set_prefix_same_as_start(prefixReadOptions, 1);
+    writeOptions = rocksdb_writeoptions_create();
+    // A lost page version is replayed again from the xlog, which keeps its WAL
+    pageWriteOptions = rocksdb_writeoptions_create();
+    rocksdb_writeoptions_disable_WAL(pageWriteOptions, kv_page_disable_wal ? 1 : 0);
+
+    KvCheckLayout(KvCheckKeyFormat());
+    if (kv_per_database)
+        KvRemoveDroppedStores();
+    KvStartPageBatchFlusher();
+    KvTierStart();
     printf("%s ends \n", __func__ );
     fflush(stdout);
-    return;
+    return 0;
 }
 #endif
 
 
 #ifdef USE_ROCKSDB
-int KvPut(char *key, char *value, int valueLen) {
-//    ereport(NOTICE,
-//            (errcode(ERRCODE_INTERNAL_ERROR),
-//                    errmsg("[KvPut] key = %s, valueLen = %d\n", key,  valueLen)));
-    InitKvStore();
-
+static int KvRocksdbPut(KvFamily family, const char *key, size_t keyLen, const char *value, size_t valueLen) {
+    KvRocksdbStore *store = KvStoreForKey(family, key, keyLen, 1);
+    rocksdb_t *storeDb = KvStoreAcquire(store);
     char * err = NULL;
-    rocksdb_writeoptions_t *writeoptions = rocksdb_writeoptions_create();
-    rocksdb_put(db, writeoptions, key, strlen(key), value, valueLen,
-                &err);
-//    ereport(NOTICE,
-//            (errcode(ERRCODE_INTERNAL_ERROR),
-//                    errmsg("[KvPut] Put completed\n")));
-    rocksdb_writeoptions_destroy(writeoptions);
+
+    if (storeDb == NULL)
+        return 1;
+    rocksdb_put_cf(storeDb, writeOptions, store->families[family], key, keyLen, value, valueLen,
+                   &err);
+    KvStoreRelease(store);
     if (err != NULL) {
         printf("%s failed, error = %s\n", __func__ , err);
-//        ereport(ERROR,
-//                (errcode(ERRCODE_KV_COMMAND_ERROR),
-//                        errmsg("[KvPut] KvPut failed, error = %s\n", err)));
+        free(err);
         return 1;
     }
     return 0;
 }
-#endif
 
-#ifdef USE_LIGHT_KV
-int KvPut(char *key, char *value, int valueLen) {
-    KvStoreInsertKVPair(key, strlen(key), value);
+// returned_value should be freed by caller function.
+static int KvRocksdbGet(KvFamily family, const char *key, size_t keyLen, char **value, size_t *len) {
+    KvRocksdbStore *store = KvStoreForKey(family, key, keyLen, 0);
+    rocksdb_t *storeDb = KvStoreAcquire(store);
+    char *err = NULL;
+
+    (*value) = NULL;
+    if (storeDb == NULL)
+        return store == &mainStore;
+    (*value) =
+            rocksdb_get_cf(storeDb, readOptions, store->families[family], key, keyLen, len, &err);
+    KvStoreRelease(store);
+    if (err != NULL) {
+        free(err);
+        return 1;
+    }
     return 0;
 }
 
-#endif
-
+static int KvRocksdbDelete(KvFamily family, const char *key, size_t keyLen) {
+    KvRocksdbStore *store = KvStoreForKey(family, key, keyLen, 0);
+    rocksdb_t *storeDb = KvStoreAcquire(store);
+    char * err = NULL;
 
-#ifdef USE_ROCKSDB
-// returned_value should be freed by caller function.
-int KvGet(char *key, char **value, size_t *len) {
-//    ereport(NOTICE,
-//            (errcode(ERRCODE_INTERNAL_ERROR),
-//                    errmsg("[KvGet] key = %s \n", key)));
-    InitKvStore();
-    char *err = NULL;
-    rocksdb_readoptions_t *readoptions = rocksdb_readoptions_create();
-    (*value) =
-            rocksdb_get(db, readoptions, key, strlen(key), len, &err);
-    rocksdb_readoptions_destroy(readoptions);
+    if (storeDb == NULL)
+        return store == &mainStore;
+    rocksdb_delete_cf(storeDb, writeOptions, store->families[family], key, keyLen, &err);
+    KvStoreRelease(store);
     if (err != NULL) {
+        free(err);
         return 1;
     }
     return 0;
 }
-#endif
 
-#ifdef USE_LIGHT_KV
-// returned_value should be freed by caller function.
-int KvGet(char *key, char **value, size_t *len) {
-    *value = (char*)malloc(8192);
-    int err = KvStoreGetValue(key, strlen(key), *value);
-    if (!err) {
-        *len = 8192;
+static int KvRocksdbSeek(KvFamily family, const char *key, size_t keyLen, size_t prefixLen,
+                         char **foundKey, size_t *foundKeyLen, char **value, size_t *valueLen) {
+    KvRocksdbStore *store = KvStoreForKey(family, key, keyLen, 0);
+    rocksdb_t *storeDb = KvStoreAcquire(store);
+
+    if (storeDb == NULL)
         return 0;
-    } else {
-        free(*value);
-        *value = NULL;
-        return 1;
+    // The page family's prefix extractor bounds the iterator to the page,
+    // the prefix bloom filters skip the files without it
+    rocksdb_iterator_t *it = rocksdb_create_iterator_cf(storeDb,
+            family == KV_FAMILY_PAGE && prefixLen == KV_PAGE_PREFIX_LEN ? prefixReadOptions : readOptions,
+            store->families[family]);
+    int found = 0;
+
+    rocksdb_iter_seek(it, key, keyLen);
+    if (rocksdb_iter_valid(it)) {
+        size_t itKeyLen = 0, itValueLen = 0;
+        const char *itKey = rocksdb_iter_key(it, &itKeyLen);
+
+        if (itKeyLen >= prefixLen && memcmp(itKey, key, prefixLen) == 0) {
+            const char *itValue = rocksdb_iter_value(it, &itValueLen);
+
+            *foundKey = (char*) malloc(itKeyLen);
+            memcpy(*foundKey, itKey, itKeyLen);
+            *foundKeyLen = itKeyLen;
+            *value = (char*) malloc(Max(itValueLen, 1));
+            memcpy(*value, itValue, itValueLen);
+            *valueLen = itValueLen;
+            found = 1;
+        }
+    }
+
+    char *err = NULL;
+    rocksdb_iter_get_error(it, &err);
+    if (err != NULL) {
+        printf("%s failed, error = %s\n", __func__ , err);
+        fflush(stdout);
+        free(err);
     }
+    rocksdb_iter_destroy(it);
+    KvStoreRelease(store);
+    return found;
+}
+
+static void KvRocksdbClose(void);
+
+static const KvEngine KvRocksdbEngine = {
+    "rocksdb",
+    KvRocksdbOpen,
+    KvRocksdbClose,
+    KvRocksdbPut,
+    KvRocksdbGet,
+    KvRocksdbDelete,
+    KvRocksdbSeek,
+    1
+};
+
+// The page batch, the pinned and batched reads and the compaction filter
+// are rocksdb's own
+static int KvUsingRocksdb(void) {
+    return kvEngine == &KvRocksdbEngine;
 }
+#endif
+
+//! The engine is picked by kv_engine when the store is first used. Engines
+//! of extensions have to be registered by then.
+void InitKvStore() {
+    const KvEngine *engine;
 
+    if (__atomic_load_n(&kvEngine, __ATOMIC_ACQUIRE) != NULL)
+        return;
+    pthread_mutex_lock(&kvEngineLock);
+    if (kvEngine != NULL) {
+        pthread_mutex_unlock(&kvEngineLock);
+        return;
+    }
+#ifdef USE_ROCKSDB
+    KvRegisterEngine(&KvRocksdbEngine);
 #endif
+    KvRegisterEngine(&KvMemoryEngine);
+    KvRegisterEngine(&KvSsdEngine);
+
+    engine = KvLookupEngine(kv_engine != NULL && kv_engine[0] != '\0' ? kv_engine : "rocksdb");
+    if (engine == NULL) {
+        pthread_mutex_unlock(&kvEngineLock);
+        ereport(FATAL,
+                (errmsg("unknown kv_engine \"%s\"", kv_engine)));
+    }
+    if (engine->open() == 0)
+        __atomic_store_n(&kvEngine, engine, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&kvEngineLock);
+}
+
+static int KvPutKey(KvFamily family, const char *key, size_t keyLen, const char *value, size_t valueLen) {
+    InitKvStore();
+    if (kvEngine == NULL)
+        return 1;
+    return kvEngine->put(family, key, keyLen, value, valueLen);
+}
+
+int KvPut(char *key, char *value, int valueLen) {
+    return KvPutKey(KV_FAMILY_META, key, strlen(key), value, valueLen);
+}
+
+
+// returned_value should be freed by caller function.
+static int KvGetKey(KvFamily family, const char *key, size_t keyLen, char **value, size_t *len) {
+    InitKvStore();
+    *value = NULL;
+    if (kvEngine == NULL)
+        return 1;
+    return kvEngine->get(family, key, keyLen, value, len);
+}
+
+// returned_value should be freed by caller function.
+int KvGet(char *key, char **value, size_t *len) {
+    return KvGetKey(KV_FAMILY_META, key, strlen(key), value, len);
+}
 
 #ifdef DISABLED_FUNCTION
 // if the key doesn't exist, return 1
@@ -213,81 +899,405 @@ int KvPutInt(char *key, int value) {
 }
 #endif
 
-#ifdef USE_ROCKSDB
-void KvClose() {
-//    ereport(NOTICE,
-//            (errcode(ERRCODE_INTERNAL_ERROR),
-//                    errmsg("[KvClose] Start Close\n\n\n")));
-    if (db != NULL) {
-        rocksdb_close(db);
-        db = NULL;
-//        ereport(NOTICE,
-//                (errcode(ERRCODE_INTERNAL_ERROR),
-//                        errmsg("[KvClose] Start Close, success\n\n\n")));
-    }
 
-    return;
-}
-#endif
 
-#ifdef USE_LIGHT_KV
-void KvClose() {
-    DestroyLightWeightedKVStore();
-    return;
+static int KvDeleteKey(KvFamily family, const char *key, size_t keyLen) {
+    InitKvStore();
+    if (kvEngine == NULL)
+        return 1;
+    return kvEngine->delete_key(family, key, keyLen);
 }
-#endif
 
+int KvDelete(char *key) {
+    return KvDeleteKey(KV_FAMILY_META, key, strlen(key));
+}
 
 #ifdef USE_ROCKSDB
-int KvDelete(char *key) {
-//    ereport(NOTICE,
-//            (errcode(ERRCODE_INTERNAL_ERROR),
-//                    errmsg("[KvDelete]Started\n")));
-    InitKvStore();
-    char * err;
-    rocksdb_writeoptions_t *writeoptions = rocksdb_writeoptions_create();
-    rocksdb_delete(db, writeoptions, key, strlen(key), &err);
-    rocksdb_writeoptions_destroy(writeoptions);
+// Caller holds the store's lock shared, and pageBatchLock
+static void KvCommitPageBatchLocked(KvRocksdbStore *store) {
+    char *err = NULL;
+
+    if (store->pageBatch == NULL || rocksdb_writebatch_wi_count(store->pageBatch) == 0 || store->db == NULL ||
+        !KvUsingRocksdb())
+        return;
+    rocksdb_write_writebatch_wi(store->db, pageWriteOptions, store->pageBatch, &err);
     if (err != NULL) {
-        return 1;
+        printf("%s failed, %d writes lost, error = %s\n", __func__ ,
+               rocksdb_writebatch_wi_count(store->pageBatch), err);
+        fflush(stdout);
+        free(err);
     }
-    return 0;
+    rocksdb_writebatch_wi_clear(store->pageBatch);
 }
-#endif
 
-#ifdef USE_LIGHT_KV
-int KvDelete(char *key) {
-    KvStoreDeleteValue(key, strlen(key));
-    return 0;
+void KvFlushPageBatch(void) {
+    KvRocksdbStore *store;
+    int pos = 0;
+
+    while ((store = KvStoreNext(&pos)) != NULL) {
+        if (KvStoreAcquire(store) == NULL)
+            continue;
+        pthread_mutex_lock(&pageBatchLock);
+        KvCommitPageBatchLocked(store);
+        pthread_mutex_unlock(&pageBatchLock);
+        KvStoreRelease(store);
+    }
 }
-#endif
-
 
-int PutXlogWithLsn(XLogRecPtr lsn, XLogRecord* record) {
+static void *KvPageBatchFlusher(void *arg) {
+    pthread_mutex_lock(&pageBatchLock);
+    for (;;) {
+        struct timespec deadline;
+        int delayMs = kv_page_batch_delay > 0 ? kv_page_batch_delay : 1;
+
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += (long) delayMs * 1000000L;
+        deadline.tv_sec += deadline.tv_nsec / 1000000000L;
+        deadline.tv_nsec %= 1000000000L;
+        pthread_cond_timedwait(&pageBatchCond, &pageBatchLock, &deadline);
+        // The store locks are taken first
+        pthread_mutex_unlock(&pageBatchLock);
+        KvFlushPageBatch();
+        KvReapDroppedStores();
+        pthread_mutex_lock(&pageBatchLock);
+    }
+    return NULL;
+}
 
-    char tempKey[MAX_PATH_LEN];
-    snprintf(tempKey, sizeof(tempKey), ROCKSDB_XLOG_KEY, lsn);
+static void KvStartPageBatchFlusher(void) {
+    pthread_t thread;
 
-    return KvPut(tempKey, (char*)record, record->xl_tot_len);
+    pthread_mutex_lock(&pageBatchLock);
+    if (!pageBatchFlusherStarted && pthread_create(&thread, NULL, KvPageBatchFlusher, NULL) == 0) {
+        pthread_detach(thread);
+        pageBatchFlusherStarted = 1;
+    }
+    pthread_mutex_unlock(&pageBatchLock);
 }
 
-int GetXlogWithLsn(XLogRecPtr lsn, XLogRecord** record, size_t* record_size) {
-    char tempKey[MAX_PATH_LEN];
-    snprintf(tempKey, sizeof(tempKey), ROCKSDB_XLOG_KEY, lsn);
+static void KvBatchPutKey(const char *key, size_t keyLen, const char *value, int valueLen) {
+    KvRocksdbStore *store;
 
-    KvGet(tempKey, (char**)record, record_size);
-    return *record_size > 0;
+    InitKvStore();
+    if (kv_page_batch_size <= 1 || !KvUsingRocksdb()) {
+        // Keep the order with writes still pending from a bigger batch size
+        KvFlushPageBatch();
+        KvPutKey(KV_FAMILY_PAGE, key, keyLen, value, valueLen);
+        return;
+    }
+    store = KvStoreForKey(KV_FAMILY_PAGE, key, keyLen, 1);
+    if (KvStoreAcquire(store) == NULL) {
+        printf("%s failed, the store isn't open\n", __func__ );
+        fflush(stdout);
+        return;
+    }
+    pthread_mutex_lock(&pageBatchLock);
+    rocksdb_writebatch_wi_put_cf(store->pageBatch, store->families[KV_FAMILY_PAGE], key, keyLen, value, valueLen);
+    if (rocksdb_writebatch_wi_count(store->pageBatch) >= kv_page_batch_size)
+        KvCommitPageBatchLocked(store);
+    pthread_mutex_unlock(&pageBatchLock);
+    KvStoreRelease(store);
 }
 
-#ifdef DISABLED_FUNCTION
-// Put list:
-//      input: list, listNum
-//      Set listNum to rocksdb
-//      This function treats list as a pure list,
-//          doesn't care about LsnList format
-int PutListWithKey(char* key, uint64_t* listPointer, int listSize) {
-    return KvPut(key, (char*)listPointer, listSize*sizeof(uint64_t));
-}
+static void KvBatchDeleteKey(const char *key, size_t keyLen) {
+    KvRocksdbStore *store;
+
+    InitKvStore();
+    if (kv_page_batch_size <= 1 || !KvUsingRocksdb()) {
+        // Keep the order with writes still pending from a bigger batch size
+        KvFlushPageBatch();
+        KvDeleteKey(KV_FAMILY_PAGE, key, keyLen);
+        return;
+    }
+    // Nothing to delete in a store that doesn't exist
+    store = KvStoreForKey(KV_FAMILY_PAGE, key, keyLen, 0);
+    if (KvStoreAcquire(store) == NULL)
+        return;
+    pthread_mutex_lock(&pageBatchLock);
+    rocksdb_writebatch_wi_delete_cf(store->pageBatch, store->families[KV_FAMILY_PAGE], key, keyLen);
+    if (rocksdb_writebatch_wi_count(store->pageBatch) >= kv_page_batch_size)
+        KvCommitPageBatchLocked(store);
+    pthread_mutex_unlock(&pageBatchLock);
+    KvStoreRelease(store);
+}
+
+// The batch is only searched under the lock, the store outside of it. A
+// version deleted in the batch may still be returned from the store until
+// the batch is committed, deletes only drop versions nobody reads any more.
+// Caller holds the store's lock shared, and pageBatchLock. Returns a malloc'ed
+// copy of the pending value, or NULL
+static char *KvPageBatchLookupLocked(KvRocksdbStore *store, const char *key, size_t keyLen, size_t *len) {
+    char *err = NULL;
+    char *value = NULL;
+
+    if (store->pageBatch != NULL && rocksdb_writebatch_wi_count(store->pageBatch) > 0 && KvUsingRocksdb())
+        value = rocksdb_writebatch_wi_get_from_batch_cf(store->pageBatch, familyOptions[KV_FAMILY_PAGE],
+                                                        store->families[KV_FAMILY_PAGE], key, keyLen, len, &err);
+    if (err != NULL) {
+        free(err);
+        free(value);
+        value = NULL;
+    }
+    return value;
+}
+
+#else
+void KvFlushPageBatch(void) {
+}
+
+static void KvBatchPutKey(const char *key, size_t keyLen, const char *value, int valueLen) {
+    KvPutKey(KV_FAMILY_PAGE, key, keyLen, value, valueLen);
+}
+
+static void KvBatchDeleteKey(const char *key, size_t keyLen) {
+    KvDeleteKey(KV_FAMILY_PAGE, key, keyLen);
+}
+#endif
+
+#ifdef USE_ROCKSDB
+static void KvRocksdbClose(void) {
+    KvRocksdbStore *store;
+    int pos = 0;
+
+    if (mainStore.db != NULL) {
+        KvFlushPageBatch();
+        while ((store = KvStoreNext(&pos)) != NULL) {
+            pthread_rwlock_wrlock(&store->lock);
+            KvStoreCloseLocked(store);
+            pthread_rwlock_unlock(&store->lock);
+        }
+        rocksdb_readoptions_destroy(readOptions);
+        rocksdb_readoptions_destroy(prefixReadOptions);
+        rocksdb_writeoptions_destroy(writeOptions);
+        rocksdb_writeoptions_destroy(pageWriteOptions);
+        for (int i = 0; i < KV_FAMILY_NUM; i++) {
+            rocksdb_options_destroy(familyOptions[i]);
+            familyOptions[i] = NULL;
+        }
+        rocksdb_options_destroy(storeOptions);
+        storeOptions = NULL;
+        if (rateLimiter != NULL)
+            rocksdb_ratelimiter_destroy(rateLimiter);
+        rateLimiter = NULL;
+        rocksdb_cache_destroy(blockCache);
+        blockCache = NULL;
+        readOptions = prefixReadOptions = NULL;
+        writeOptions = pageWriteOptions = NULL;
+    }
+}
+#endif
+
+void KvClose() {
+    pthread_mutex_lock(&kvEngineLock);
+    if (kvEngine != NULL) {
+        kvEngine->close();
+        __atomic_store_n(&kvEngine, NULL, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&kvEngineLock);
+}
+
+bool KvPageGcInCompaction(void) {
+    InitKvStore();
+    return kv_page_compaction_gc && kvEngine != NULL && kvEngine->compactionGc;
+}
+
+// Fills key with the page prefix, returns the prefix length
+static size_t KvMakePagePrefix(char *key, uint32 kind, BufferTag bufferTag) {
+    uint32 fields[KV_PAGE_PREFIX_LEN / sizeof(uint32)];
+
+    fields[0] = pg_hton32(kind);
+    fields[1] = pg_hton32(bufferTag.rnode.spcNode);
+    fields[2] = pg_hton32(bufferTag.rnode.dbNode);
+    fields[3] = pg_hton32(bufferTag.rnode.relNode);
+    fields[4] = pg_hton32((uint32) bufferTag.forkNum);
+    fields[5] = pg_hton32(bufferTag.blockNum);
+    memcpy(key, fields, KV_PAGE_PREFIX_LEN);
+    return KV_PAGE_PREFIX_LEN;
+}
+
+static size_t KvMakePageVersionKey(char *key, BufferTag bufferTag, uint64_t lsn) {
+    uint64 beLsn = pg_hton64(~lsn);
+
+    KvMakePagePrefix(key, KV_KEY_KIND_PAGE_VERSION, bufferTag);
+    memcpy(key + KV_PAGE_PREFIX_LEN, &beLsn, sizeof(beLsn));
+    return KV_PAGE_KEY_LEN;
+}
+
+
+// Xlog records never change once written, so a direct-mapped cache keyed by
+// LSN needs no invalidation. The storage node reads the records for every
+// redo process, so they all share it.
+#define XLOG_CACHE_SLOTS (4096)
+#define XLOG_CACHE_LOCKS (64)
+// Bigger records (FPIs mostly) are read once, don't let them push out others
+#define XLOG_CACHE_MAX_RECORD (BLCKSZ+1024)
+
+typedef struct XlogCacheSlot {
+    XLogRecPtr lsn;
+    char *record;
+    size_t size;
+} XlogCacheSlot;
+
+static XlogCacheSlot xlogCache[XLOG_CACHE_SLOTS];
+static pthread_mutex_t xlogCacheLocks[XLOG_CACHE_LOCKS];
+static pthread_once_t xlogCacheOnce = PTHREAD_ONCE_INIT;
+
+static void XlogCacheInit(void) {
+    for (int i = 0; i < XLOG_CACHE_LOCKS; i++)
+        pthread_mutex_init(&xlogCacheLocks[i], NULL);
+}
+
+static int XlogCacheSlotOf(XLogRecPtr lsn) {
+    // Records are MAXALIGNed, so the low bits carry nothing
+    return (int) ((lsn >> 3) % XLOG_CACHE_SLOTS);
+}
+
+static void XlogCachePut(XLogRecPtr lsn, const char *record, size_t size) {
+    int slot = XlogCacheSlotOf(lsn);
+    char *copy;
+
+    if (size == 0 || size > XLOG_CACHE_MAX_RECORD)
+        return;
+    pthread_once(&xlogCacheOnce, XlogCacheInit);
+    copy = (char*) malloc(size);
+    memcpy(copy, record, size);
+
+    pthread_mutex_lock(&xlogCacheLocks[slot % XLOG_CACHE_LOCKS]);
+    free(xlogCache[slot].record);
+    xlogCache[slot].lsn = lsn;
+    xlogCache[slot].record = copy;
+    xlogCache[slot].size = size;
+    pthread_mutex_unlock(&xlogCacheLocks[slot % XLOG_CACHE_LOCKS]);
+}
+
+// Returns a malloc'ed copy of the cached record, or NULL
+static char *XlogCacheGet(XLogRecPtr lsn, size_t *size) {
+    int slot = XlogCacheSlotOf(lsn);
+    char *copy = NULL;
+
+    pthread_once(&xlogCacheOnce, XlogCacheInit);
+    pthread_mutex_lock(&xlogCacheLocks[slot % XLOG_CACHE_LOCKS]);
+    if (xlogCache[slot].record != NULL && xlogCache[slot].lsn == lsn) {
+        copy = (char*) malloc(xlogCache[slot].size);
+        memcpy(copy, xlogCache[slot].record, xlogCache[slot].size);
+        *size = xlogCache[slot].size;
+    }
+    pthread_mutex_unlock(&xlogCacheLocks[slot % XLOG_CACHE_LOCKS]);
+    return copy;
+}
+
+static void KvMakeXlogKey(char *key, XLogRecPtr lsn) {
+    uint64 beLsn = pg_hton64(lsn);
+
+    memcpy(key, &beLsn, sizeof(beLsn));
+}
+
+int PutXlogWithLsn(XLogRecPtr lsn, XLogRecord* record) {
+
+    char tempKey[KV_XLOG_KEY_LEN];
+    KvMakeXlogKey(tempKey, lsn);
+
+    // Replays of the page it touches usually follow shortly
+    XlogCachePut(lsn, (char*)record, record->xl_tot_len);
+    return KvPutKey(KV_FAMILY_XLOG, tempKey, sizeof(tempKey), (char*)record, record->xl_tot_len);
+}
+
+int GetXlogWithLsn(XLogRecPtr lsn, XLogRecord** record, size_t* record_size) {
+    return GetXlogListWithLsn(&lsn, 1, record, record_size) == 1;
+}
+
+int GetXlogListWithLsn(const XLogRecPtr* lsnList, int num, XLogRecord** records, size_t* recordSizes) {
+    int found = 0;
+    int missNum = 0;
+    int *missPos = (int*) malloc(sizeof(int) * num);
+
+    for (int i = 0; i < num; i++) {
+        records[i] = (XLogRecord*) XlogCacheGet(lsnList[i], &recordSizes[i]);
+        if (records[i] != NULL) {
+            found++;
+        } else {
+            recordSizes[i] = 0;
+            missPos[missNum++] = i;
+        }
+    }
+
+    if (missNum > 0) {
+        char (*keys)[KV_XLOG_KEY_LEN] = malloc(sizeof(*keys) * missNum);
+        char **values = (char**) malloc(sizeof(char*) * missNum);
+        size_t *valueSizes = (size_t*) malloc(sizeof(size_t) * missNum);
+
+        for (int i = 0; i < missNum; i++)
+            KvMakeXlogKey(keys[i], lsnList[missPos[i]]);
+
+        InitKvStore();
+#ifdef USE_ROCKSDB
+        // One lookup for the whole chain instead of one per record
+        if (KvUsingRocksdb() && KvStoreAcquire(&mainStore) != NULL) {
+            const char **keyList = (const char**) malloc(sizeof(char*) * missNum);
+            size_t *keySizes = (size_t*) malloc(sizeof(size_t) * missNum);
+            char **errs = (char**) malloc(sizeof(char*) * missNum);
+            const rocksdb_column_family_handle_t **families =
+                    (const rocksdb_column_family_handle_t**) malloc(sizeof(*families) * missNum);
+
+            for (int i = 0; i < missNum; i++) {
+                keyList[i] = keys[i];
+                keySizes[i] = KV_XLOG_KEY_LEN;
+                families[i] = mainStore.families[KV_FAMILY_XLOG];
+            }
+            rocksdb_multi_get_cf(mainStore.db, readOptions, families, missNum, keyList, keySizes, values, valueSizes,
+                                 errs);
+            KvStoreRelease(&mainStore);
+            for (int i = 0; i < missNum; i++) {
+                if (errs[i] != NULL) {
+                    printf("%s failed, lsn = %lu, error = %s\n", __func__, lsnList[missPos[i]], errs[i]);
+                    fflush(stdout);
+                    free(errs[i]);
+                    free(values[i]);
+                    values[i] = NULL;
+                    valueSizes[i] = 0;
+                }
+            }
+            free(keyList);
+            free(keySizes);
+            free(errs);
+            free(families);
+        } else
+#endif
+        {
+            for (int i = 0; i < missNum; i++) {
+                if (KvGetKey(KV_FAMILY_XLOG, keys[i], KV_XLOG_KEY_LEN, &values[i], &valueSizes[i]) != 0) {
+                    values[i] = NULL;
+                    valueSizes[i] = 0;
+                }
+            }
+        }
+
+        for (int i = 0; i < missNum; i++) {
+            records[missPos[i]] = (XLogRecord*) values[i];
+            recordSizes[missPos[i]] = values[i] != NULL ? valueSizes[i] : 0;
+            if (values[i] != NULL) {
+                XlogCachePut(lsnList[missPos[i]], values[i], valueSizes[i]);
+                found++;
+            }
+        }
+        free(keys);
+        free(values);
+        free(valueSizes);
+    }
+
+    free(missPos);
+    return found;
+}
+
+#ifdef DISABLED_FUNCTION
+// Put list:
+//      input: list, listNum
+//      Set listNum to rocksdb
+//      This function treats list as a pure list,
+//          doesn't care about LsnList format
+int PutListWithKey(char* key, uint64_t* listPointer, int listSize) {
+    return KvPut(key, (char*)listPointer, listSize*sizeof(uint64_t));
+}
 
 
 // Get list:
@@ -366,48 +1376,823 @@ int FindListLowerBound(uint64_t* uintList, uint64_t targetLsn, uint64_t *foundLs
 }
 #endif
 
+void KvSetPageGcHorizon(uint64_t lsn) {
+    uint64_t current = __atomic_load_n(&pageGcHorizon, __ATOMIC_ACQUIRE);
+
+    // Compute nodes only move forward, a node leaving must not pull it back
+    // below what compaction may already have dropped
+    while (lsn > current &&
+           !__atomic_compare_exchange_n(&pageGcHorizon, &current, lsn, false, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+        ;
+}
+
+uint64_t KvGetPageGcHorizon(void) {
+    return __atomic_load_n(&pageGcHorizon, __ATOMIC_ACQUIRE);
+}
+
 void DeletePageFromRocksdb(BufferTag bufferTag, uint64_t lsn) {
-    char tempKey[MAX_PATH_LEN];
-    snprintf(tempKey, sizeof(tempKey), ROCKSDB_PAGE_VERSION_KEY, bufferTag.rnode.spcNode,
-             bufferTag.rnode.dbNode, bufferTag.rnode.relNode, bufferTag.forkNum, bufferTag.blockNum, lsn);
+    char tempKey[KV_PAGE_KEY_LEN];
+    size_t keyLen = KvMakePageVersionKey(tempKey, bufferTag, lsn);
+
+    KvPageCacheForget(bufferTag, lsn);
+    KvBatchDeleteKey(tempKey, keyLen);
+}
+
+int DeleteRelationFromRocksdb(RelFileNode rnode) {
+#ifdef USE_ROCKSDB
+    char startKey[KV_PAGE_PREFIX_LEN];
+    char endKey[KV_PAGE_PREFIX_LEN];
+    BufferTag bufferTag;
+    KvRocksdbStore *store;
+    rocksdb_t *storeDb;
+    char *err = NULL;
+
+    InitKvStore();
+    if (!KvUsingRocksdb())
+        return 0;
+    store = KvStoreForDatabase(rnode.dbNode, 0);
+
+    // Block 0 of the first fork up to past the last one
+    INIT_BUFFERTAG(bufferTag, rnode, (ForkNumber) 0, 0);
+    KvMakePagePrefix(startKey, KV_KEY_KIND_PAGE_VERSION, bufferTag);
+    bufferTag.forkNum = (ForkNumber) (MAX_FORKNUM + 1);
+    KvMakePagePrefix(endKey, KV_KEY_KIND_PAGE_VERSION, bufferTag);
+
+    // Versions still in the batch would be written after the range delete
+    KvFlushPageBatch();
+    // A database without a store has no versions left to delete
+    if ((storeDb = KvStoreAcquire(store)) == NULL)
+        return store != &mainStore;
+    rocksdb_delete_range_cf(storeDb, writeOptions, store->families[KV_FAMILY_PAGE], startKey, KV_PAGE_PREFIX_LEN,
+                            endKey, KV_PAGE_PREFIX_LEN, &err);
+    KvStoreRelease(store);
+    if (err != NULL) {
+        printf("%s failed, error = %s\n", __func__ , err);
+        fflush(stdout);
+        free(err);
+        return 0;
+    }
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+void KvDropDatabase(Oid dbid, uint64_t lsn) {
+#ifdef USE_ROCKSDB
+    KvRocksdbStore *store;
 
-    KvDelete(tempKey);
+    // Compute nodes replay the drop too, they have no store open
+    if (__atomic_load_n(&kvEngine, __ATOMIC_ACQUIRE) == NULL || !KvUsingRocksdb() || !kv_per_database ||
+        dbid == InvalidOid)
+        return;
+    if ((store = KvDatabaseStore(dbid, 0)) != NULL)
+        __atomic_store_n(&store->dropLsn, lsn, __ATOMIC_RELEASE);
+#endif
+}
+
+void KvCreateDatabase(Oid dbid) {
+#ifdef USE_ROCKSDB
+    KvRocksdbStore *store;
+
+    if (__atomic_load_n(&kvEngine, __ATOMIC_ACQUIRE) == NULL || !KvUsingRocksdb() || !kv_per_database ||
+        dbid == InvalidOid)
+        return;
+    if ((store = KvDatabaseStore(dbid, 0)) == NULL ||
+        __atomic_load_n(&store->dropLsn, __ATOMIC_ACQUIRE) == InvalidXLogRecPtr)
+        return;
+    // The new database under the OID must not see the old one's pages
+    pthread_rwlock_wrlock(&store->lock);
+    if (store->dropLsn != InvalidXLogRecPtr)
+        KvReapStoreLocked(store);
+    pthread_rwlock_unlock(&store->lock);
+#endif
+}
+
+static int KvReadPage(BufferTag bufferTag, uint64_t lsn, char* page, int allowDelta);
+
+// Turns a stored value into the page, a delta is applied on its base version.
+// return value: filled->1, else 0
+static int KvCopyPageValue(BufferTag bufferTag, const char *value, size_t valueSize, char *page, int allowDelta) {
+    uint64_t baseLsn = 0;
+
+    switch (KvPageValueKind(value, valueSize, &baseLsn)) {
+        case KV_PAGE_VALUE_BASE:
+            memcpy(page, value, BLCKSZ);
+            return 1;
+        case KV_PAGE_VALUE_LOOSE:
+            memcpy(page, value + sizeof(KvPageValueHeader), BLCKSZ);
+            return 1;
+        case KV_PAGE_VALUE_DELTA:
+            // Deltas are always taken against a full version
+            if (!allowDelta || !KvReadPage(bufferTag, baseLsn, page, 0)) {
+                printf("%s lost the base %lu of a delta, rel = %u, blk = %u\n", __func__ ,
+                       baseLsn, bufferTag.rnode.relNode, bufferTag.blockNum);
+                return 0;
+            }
+            return KvPageDeltaApply(value, valueSize, page);
+        case KV_PAGE_VALUE_REMOTE: {
+            size_t fetchedSize = 0;
+            char *fetched = KvTierFetch(value, valueSize, &fetchedSize);
+            int found;
+
+            // Never another remote value
+            if (fetched == NULL || KvPageValueKind(fetched, fetchedSize, &baseLsn) == KV_PAGE_VALUE_REMOTE) {
+                free(fetched);
+                return 0;
+            }
+            found = KvCopyPageValue(bufferTag, fetched, fetchedSize, page, allowDelta);
+            free(fetched);
+            return found;
+        }
+        default:
+            return 0;
+    }
 }
 
 // pageContent should be freed by caller functions
 // return value: found->1, not found->0
 int GetPageFromRocksdb(BufferTag bufferTag, uint64_t lsn, char** pageContent) {
-    char tempKey[MAX_PATH_LEN];
-    snprintf(tempKey, sizeof(tempKey), ROCKSDB_PAGE_VERSION_KEY, bufferTag.rnode.spcNode,
-             bufferTag.rnode.dbNode, bufferTag.rnode.relNode, bufferTag.forkNum, bufferTag.blockNum, lsn);
+    *pageContent = (char*) malloc(BLCKSZ);
+    if (!ReadPageFromRocksdb(bufferTag, lsn, *pageContent)) {
+        free(*pageContent);
+        *pageContent = NULL;
+        return 0;
+    }
+    return 1;
+}
 
-    size_t valueSize;
+// Copies the page straight out of the block cache or memtable into page,
+// rocksdb doesn't make the malloc'ed copy of rocksdb_get.
+// return value: found->1, not found->0
+int ReadPageFromRocksdb(BufferTag bufferTag, uint64_t lsn, char* page) {
+    uint64 stageStart = StageTimingStart();
+    int found = 1;
+
+    if (!KvPageCacheGet(bufferTag, lsn, page)) {
+        found = KvReadPage(bufferTag, lsn, page, 1);
+        if (found)
+            KvPageCachePut(bufferTag, lsn, page);
+    }
+    StageTimingEnd(STAGE_ROCKSDB_GET, stageStart);
+    return found;
+}
 
-    // error occurred
-    if(KvGet(tempKey, pageContent, &valueSize)){
-        printf("%s failed, because of KvGet function failed\n", __func__ );
+static int KvReadPage(BufferTag bufferTag, uint64_t lsn, char* page, int allowDelta) {
+    char tempKey[KV_PAGE_KEY_LEN];
+    size_t keyLen = KvMakePageVersionKey(tempKey, bufferTag, lsn);
+    size_t valueSize = 0;
+    char *value = NULL;
+    int found;
+
+    InitKvStore();
+#ifdef USE_ROCKSDB
+    if (KvUsingRocksdb()) {
+        KvRocksdbStore *store = KvStoreForDatabase(bufferTag.rnode.dbNode, 0);
+        rocksdb_t *storeDb = KvStoreAcquire(store);
+        char *err = NULL;
+        rocksdb_pinnableslice_t *pinned;
+
+        if (storeDb == NULL)
+            return 0;
+        pthread_mutex_lock(&pageBatchLock);
+        value = KvPageBatchLookupLocked(store, tempKey, keyLen, &valueSize);
+        pthread_mutex_unlock(&pageBatchLock);
+        if (value != NULL) {
+            KvStoreRelease(store);
+            found = KvCopyPageValue(bufferTag, value, valueSize, page, allowDelta);
+            free(value);
+            return found;
+        }
+
+        pinned = rocksdb_get_pinned_cf(storeDb, readOptions, store->families[KV_FAMILY_PAGE], tempKey, keyLen, &err);
+        if (err != NULL) {
+            printf("%s failed, error = %s\n", __func__ , err);
+            free(err);
+            KvStoreRelease(store);
+            return 0;
+        }
+        if (pinned == NULL) {
+            KvStoreRelease(store);
+            return 0;
+        }
+        const char *pinnedValue = rocksdb_pinnableslice_value(pinned, &valueSize);
+        found = KvCopyPageValue(bufferTag, pinnedValue, valueSize, page, allowDelta);
+        rocksdb_pinnableslice_destroy(pinned);
+        KvStoreRelease(store);
+        return found;
+    }
+#endif
+
+    if (KvGetKey(KV_FAMILY_PAGE, tempKey, keyLen, &value, &valueSize) || value == NULL)
         return 0;
+    found = KvCopyPageValue(bufferTag, value, valueSize, page, allowDelta);
+    free(value);
+    return found;
+}
+
+#ifdef USE_ROCKSDB
+typedef void (*KvMultiGetVisitor)(int pos, const char *value, size_t valueLen, void *arg);
+
+//! Looks the keys of the family up with one batched lookup per store they
+//! route to. The visitor sees each value found while it is pinned, pos is
+//! the key's in keys.
+static void KvRocksdbMultiGet(KvFamily family, const char **keys, const size_t *keySizes, int num,
+                              KvMultiGetVisitor visitor, void *arg) {
+    KvRocksdbStore **stores = (KvRocksdbStore**) malloc(sizeof(*stores) * num);
+    int *grouped = (int*) calloc(num, sizeof(int));
+    const char **groupKeys = (const char**) malloc(sizeof(char*) * num);
+    size_t *groupSizes = (size_t*) malloc(sizeof(size_t) * num);
+    int *groupPos = (int*) malloc(sizeof(int) * num);
+    rocksdb_pinnableslice_t **values = (rocksdb_pinnableslice_t**) calloc(num, sizeof(*values));
+    char **errs = (char**) calloc(num, sizeof(char*));
+
+    for (int i = 0; i < num; i++)
+        stores[i] = KvStoreForKey(family, keys[i], keySizes[i], 0);
+    for (int i = 0; i < num; i++) {
+        KvRocksdbStore *store = stores[i];
+        int groupNum = 0;
+
+        if (grouped[i])
+            continue;
+        // Usually all of the keys are of one store
+        for (int j = i; j < num; j++) {
+            if (grouped[j] || stores[j] != store)
+                continue;
+            groupKeys[groupNum] = keys[j];
+            groupSizes[groupNum] = keySizes[j];
+            groupPos[groupNum++] = j;
+            grouped[j] = 1;
+        }
+        if (KvStoreAcquire(store) == NULL)
+            continue;
+        rocksdb_batched_multi_get_cf(store->db, readOptions, store->families[family], groupNum,
+                                     groupKeys, groupSizes, values, errs, false);
+        for (int k = 0; k < groupNum; k++) {
+            size_t valueLen = 0;
+
+            if (errs[k] != NULL) {
+                printf("%s failed, error = %s\n", __func__ , errs[k]);
+                free(errs[k]);
+                errs[k] = NULL;
+            }
+            if (values[k] == NULL)
+                continue;
+            const char *value = rocksdb_pinnableslice_value(values[k], &valueLen);
+            visitor(groupPos[k], value, valueLen, arg);
+            rocksdb_pinnableslice_destroy(values[k]);
+            values[k] = NULL;
+        }
+        KvStoreRelease(store);
     }
-    if(valueSize == 0)
+    free(stores);
+    free(grouped);
+    free(groupKeys);
+    free(groupSizes);
+    free(groupPos);
+    free(values);
+    free(errs);
+}
+
+typedef struct KvReadPageListState {
+    const BufferTag *bufferTags;
+    const int *missPos;
+    char **pages;
+    int *found;
+    int foundNum;
+} KvReadPageListState;
+
+static void KvReadPageListVisit(int pos, const char *value, size_t valueLen, void *arg) {
+    KvReadPageListState *state = (KvReadPageListState*) arg;
+    int page = state->missPos[pos];
+
+    state->found[page] = KvCopyPageValue(state->bufferTags[page], value, valueLen, state->pages[page], 1);
+    state->foundNum += state->found[page];
+}
+
+static int KvRocksdbReadPageList(const BufferTag* bufferTags, const uint64_t* lsnList, int num, char** pages, int* found) {
+    char (*keys)[KV_PAGE_KEY_LEN] = malloc(sizeof(*keys) * num);
+    const char **keyList = (const char**) malloc(sizeof(char*) * num);
+    size_t *keySizes = (size_t*) malloc(sizeof(size_t) * num);
+    int *missPos = (int*) malloc(sizeof(int) * num);
+    char **pendings = (char**) calloc(num, sizeof(char*));
+    size_t *pendingSizes = (size_t*) calloc(num, sizeof(size_t));
+    int missNum = 0;
+    int foundNum = 0;
+
+    for (int i = 0; i < num; i++) {
+        KvRocksdbStore *store = KvStoreForDatabase(bufferTags[i].rnode.dbNode, 0);
+
+        KvMakePageVersionKey(keys[i], bufferTags[i], lsnList[i]);
+        if (KvStoreAcquire(store) != NULL) {
+            pthread_mutex_lock(&pageBatchLock);
+            pendings[i] = KvPageBatchLookupLocked(store, keys[i], KV_PAGE_KEY_LEN, &pendingSizes[i]);
+            pthread_mutex_unlock(&pageBatchLock);
+            KvStoreRelease(store);
+        }
+        if (pendings[i] == NULL) {
+            keyList[missNum] = keys[i];
+            keySizes[missNum] = KV_PAGE_KEY_LEN;
+            missPos[missNum++] = i;
+        }
+    }
+
+    // Decoded outside of the lock, a delta reads its base
+    for (int i = 0; i < num; i++) {
+        found[i] = 0;
+        if (pendings[i] != NULL) {
+            found[i] = KvCopyPageValue(bufferTags[i], pendings[i], pendingSizes[i], pages[i], 1);
+            foundNum += found[i];
+            free(pendings[i]);
+        }
+    }
+
+    if (missNum > 0) {
+        KvReadPageListState state = {bufferTags, missPos, pages, found, 0};
+
+        KvRocksdbMultiGet(KV_FAMILY_PAGE, keyList, keySizes, missNum, KvReadPageListVisit, &state);
+        foundNum += state.foundNum;
+    }
+
+    free(keys);
+    free(keyList);
+    free(keySizes);
+    free(missPos);
+    free(pendings);
+    free(pendingSizes);
+    return foundNum;
+}
+#endif
+
+#ifdef USE_ROCKSDB
+// Returns whether it saw every key of the store. Caller holds its lock shared
+static int KvScanStorePages(KvRocksdbStore *store, rocksdb_readoptions_t *scanOptions,
+                            KvPageScanVisitor visitor, void *arg) {
+    rocksdb_iterator_t *it = rocksdb_create_iterator_cf(store->db, scanOptions, store->families[KV_FAMILY_PAGE]);
+    char *err = NULL;
+
+    int complete = 1;
+    for (rocksdb_iter_seek_to_first(it); rocksdb_iter_valid(it); rocksdb_iter_next(it)) {
+        size_t keyLen = 0, valueLen = 0;
+        const char *key = rocksdb_iter_key(it, &keyLen);
+        const char *value = rocksdb_iter_value(it, &valueLen);
+
+        if (!visitor(key, keyLen, value, valueLen, arg)) {
+            complete = 0;
+            break;
+        }
+    }
+    rocksdb_iter_get_error(it, &err);
+    if (err != NULL) {
+        printf("%s failed, error = %s\n", __func__ , err);
+        fflush(stdout);
+        free(err);
+        complete = 0;
+    }
+    rocksdb_iter_destroy(it);
+    return complete;
+}
+
+//! The sweep reads each value once, it doesn't fill the block cache. The
+//! stores are walked one after the other, the keys are in order within each.
+int KvScanPages(KvPageScanVisitor visitor, void *arg) {
+    rocksdb_readoptions_t *scanOptions;
+    KvRocksdbStore *store;
+    int complete = 1;
+    int pos = 0;
+
+    InitKvStore();
+    if (!KvUsingRocksdb() || mainStore.db == NULL)
+        return 1;
+    scanOptions = rocksdb_readoptions_create();
+    rocksdb_readoptions_set_fill_cache(scanOptions, 0);
+    rocksdb_readoptions_set_total_order_seek(scanOptions, 1);
+
+    while (complete && (store = KvStoreNext(&pos)) != NULL) {
+        if (KvStoreAcquire(store) == NULL)
+            continue;
+        complete = KvScanStorePages(store, scanOptions, visitor, arg);
+        KvStoreRelease(store);
+    }
+    rocksdb_readoptions_destroy(scanOptions);
+    return !complete;
+}
+#else
+int KvScanPages(KvPageScanVisitor visitor, void *arg) {
+    return 1;
+}
+#endif
+
+#ifdef USE_ROCKSDB
+void KvMemoryUsage(uint64_t *memtableBytes, uint64_t *blockCacheBytes) {
+    KvRocksdbStore *store;
+    int pos = 0;
+
+    *memtableBytes = 0;
+    *blockCacheBytes = 0;
+    if (!KvUsingRocksdb() || mainStore.db == NULL)
+        return;
+    while ((store = KvStoreNext(&pos)) != NULL) {
+        if (KvStoreAcquire(store) == NULL)
+            continue;
+        for (int i = 0; i < KV_FAMILY_NUM; i++) {
+            uint64_t bytes = 0;
+
+            // Immutable memtables waiting for their flush, and the ones pinned
+            // by iterators, still hold their memory
+            if (rocksdb_property_int_cf(store->db, store->families[i], "rocksdb.size-all-mem-tables", &bytes) == 0)
+                *memtableBytes += bytes;
+        }
+        KvStoreRelease(store);
+    }
+    // One cache for all of the stores
+    *blockCacheBytes = rocksdb_cache_get_usage(blockCache);
+}
+
+int KvFlushLargestMemtable(uint64_t minBytes) {
+    KvRocksdbStore *largestStore = NULL;
+    KvRocksdbStore *store;
+    uint64_t largest = 0;
+    int family = -1;
+    int pos = 0;
+    char *err = NULL;
+
+    if (!KvUsingRocksdb() || mainStore.db == NULL)
+        return -1;
+    while ((store = KvStoreNext(&pos)) != NULL) {
+        if (KvStoreAcquire(store) == NULL)
+            continue;
+        for (int i = 0; i < KV_FAMILY_NUM; i++) {
+            uint64_t bytes = 0;
+
+            if (rocksdb_property_int_cf(store->db, store->families[i], "rocksdb.cur-size-active-mem-table",
+                                        &bytes) == 0 && bytes > largest) {
+                largest = bytes;
+                family = i;
+                largestStore = store;
+            }
+        }
+        KvStoreRelease(store);
+    }
+    if (family < 0 || largest < minBytes || KvStoreAcquire(largestStore) == NULL)
+        return -1;
+
+    // Switch the memtable and let the flush run in the background
+    rocksdb_flushoptions_t *flushOptions = rocksdb_flushoptions_create();
+    rocksdb_flushoptions_set_wait(flushOptions, 0);
+    rocksdb_flush_cf(largestStore->db, flushOptions, largestStore->families[family], &err);
+    rocksdb_flushoptions_destroy(flushOptions);
+    KvStoreRelease(largestStore);
+    if (err != NULL) {
+        printf("%s flush of %s failed, error = %s\n", __func__ , familyNames[family], err);
+        fflush(stdout);
+        free(err);
+        return -1;
+    }
+    return family;
+}
+
+size_t KvBlockCacheCapacity(void) {
+    return blockCache != NULL ? rocksdb_cache_get_capacity(blockCache) : KV_BLOCK_CACHE_SIZE;
+}
+
+void KvSetBlockCacheCapacity(size_t bytes) {
+    if (blockCache != NULL)
+        rocksdb_cache_set_capacity(blockCache, Min(bytes, KV_BLOCK_CACHE_SIZE));
+}
+#else
+void KvMemoryUsage(uint64_t *memtableBytes, uint64_t *blockCacheBytes) {
+    *memtableBytes = 0;
+    *blockCacheBytes = 0;
+}
+
+int KvFlushLargestMemtable(uint64_t minBytes) {
+    return -1;
+}
+
+size_t KvBlockCacheCapacity(void) {
+    return 0;
+}
+
+void KvSetBlockCacheCapacity(size_t bytes) {
+}
+#endif
+
+void KvReplacePageValue(const char *key, size_t keyLen, const char *value, size_t valueLen) {
+    KvBatchPutKey(key, keyLen, value, (int) valueLen);
+}
+
+// Reads several page versions with one batched lookup, pages[i] must hold
+// BLCKSZ bytes. found[i] tells whether pages[i] was filled.
+// Returns how many were found.
+int ReadPageListFromRocksdb(const BufferTag* bufferTags, const uint64_t* lsnList, int num, char** pages, int* found) {
+    int foundNum = 0;
+
+    InitKvStore();
+#ifdef USE_ROCKSDB
+    if (KvUsingRocksdb()) {
+        BufferTag *missTags = (BufferTag*) malloc(sizeof(BufferTag) * num);
+        uint64_t *missLsns = (uint64_t*) malloc(sizeof(uint64_t) * num);
+        char **missPages = (char**) malloc(sizeof(char*) * num);
+        int *missFound = (int*) malloc(sizeof(int) * num);
+        int *missPos = (int*) malloc(sizeof(int) * num);
+        int missNum = 0;
+
+        // Only the pages the cache doesn't have go to rocksdb
+        for (int i = 0; i < num; i++) {
+            found[i] = KvPageCacheGet(bufferTags[i], lsnList[i], pages[i]);
+            foundNum += found[i];
+            if (found[i])
+                continue;
+            missTags[missNum] = bufferTags[i];
+            missLsns[missNum] = lsnList[i];
+            missPages[missNum] = pages[i];
+            missPos[missNum++] = i;
+        }
+        if (missNum > 0)
+            foundNum += KvRocksdbReadPageList(missTags, missLsns, missNum, missPages, missFound);
+        for (int i = 0; i < missNum; i++) {
+            found[missPos[i]] = missFound[i];
+            if (missFound[i])
+                KvPageCachePut(missTags[i], missLsns[i], missPages[i]);
+        }
+        free(missTags);
+        free(missLsns);
+        free(missPages);
+        free(missFound);
+        free(missPos);
+        return foundNum;
+    }
+#endif
+    for (int i = 0; i < num; i++) {
+        found[i] = ReadPageFromRocksdb(bufferTags[i], lsnList[i], pages[i]);
+        foundNum += found[i];
+    }
+    return foundNum;
+}
+
+// Newest stored version of the page at or before lsn, page may be NULL when
+// only its LSN is of interest. Versions are stored newest first, so it is
+// the first key from ~lsn on within the page.
+static int KvSeekNewestPage(BufferTag bufferTag, uint64_t lsn, uint64_t *foundLsn, char *page) {
+    char tempKey[KV_PAGE_KEY_LEN];
+    size_t keyLen = KvMakePageVersionKey(tempKey, bufferTag, lsn);
+    char *foundKey = NULL;
+    char *value = NULL;
+    size_t foundKeyLen = 0, valueSize = 0;
+    int found = 0;
+
+    InitKvStore();
+    if (kvEngine == NULL)
+        return 0;
+    // The engine doesn't see the pending batch
+    KvFlushPageBatch();
+    if (!kvEngine->seek(KV_FAMILY_PAGE, tempKey, keyLen, KV_PAGE_PREFIX_LEN,
+                        &foundKey, &foundKeyLen, &value, &valueSize))
         return 0;
 
+    if (foundKeyLen == KV_PAGE_KEY_LEN && valueSize > 0) {
+        uint64 beLsn;
+
+        memcpy(&beLsn, foundKey + KV_PAGE_PREFIX_LEN, sizeof(beLsn));
+        *foundLsn = ~pg_ntoh64(beLsn);
+        found = page == NULL || KvCopyPageValue(bufferTag, value, valueSize, page, 1);
+    }
+    free(foundKey);
+    free(value);
+    return found;
+}
+
+// pageContent should be freed by caller functions
+// return value: found->1, not found->0
+int GetNewestPageFromRocksdb(BufferTag bufferTag, uint64_t lsn, uint64_t *foundLsn, char** pageContent) {
+    *pageContent = (char*) malloc(BLCKSZ);
+    if (!KvSeekNewestPage(bufferTag, lsn, foundLsn, *pageContent)) {
+        free(*pageContent);
+        *pageContent = NULL;
+        return 0;
+    }
     return 1;
 }
 
+//! With kv_page_delta_versions, a put is stored as a delta against the last
+//! full version of the page, kept here. Up to that many deltas follow a full
+//! version. A version older than the newest one already stored is written
+//! loose, as a full version no later delta refers to, so no full version
+//! lies between a delta and its base. The compaction filter relies on it.
+#define KV_DELTA_SLOTS (4096)
+#define KV_DELTA_LOCKS (64)
+// A bigger delta saves too little to be worth the extra read
+#define KV_DELTA_MAX_LEN (BLCKSZ / 4)
+
+typedef struct KvDeltaSlot {
+    BufferTag tag;
+    int valid;
+    int deltas;
+    uint64_t baseLsn;
+    uint64_t lastLsn;
+    char base[BLCKSZ];
+} KvDeltaSlot;
+
+static KvDeltaSlot *deltaSlots = NULL;
+static pthread_mutex_t deltaLocks[KV_DELTA_LOCKS];
+static pthread_once_t deltaOnce = PTHREAD_ONCE_INIT;
+
+static void KvDeltaInit(void) {
+    for (int i = 0; i < KV_DELTA_LOCKS; i++)
+        pthread_mutex_init(&deltaLocks[i], NULL);
+    deltaSlots = (KvDeltaSlot*) calloc(KV_DELTA_SLOTS, sizeof(KvDeltaSlot));
+}
+
+static int KvDeltaSlotOf(BufferTag bufferTag) {
+    uint32 hash = bufferTag.rnode.relNode * 0x9E3779B1u ^ bufferTag.blockNum * 0x85EBCA77u
+                  ^ (uint32) bufferTag.forkNum ^ bufferTag.rnode.dbNode;
+
+    return (int) (hash % KV_DELTA_SLOTS);
+}
+
+static void KvPutDeltaPage(BufferTag bufferTag, uint64_t lsn, const char *key, size_t keyLen, char *page) {
+    char value[KV_PAGE_VALUE_MAX_LEN];
+    size_t valueLen;
+    int slotNum = KvDeltaSlotOf(bufferTag);
+    KvDeltaSlot *slot;
+
+    pthread_once(&deltaOnce, KvDeltaInit);
+    slot = &deltaSlots[slotNum];
+    pthread_mutex_lock(&deltaLocks[slotNum % KV_DELTA_LOCKS]);
+    if (!slot->valid || !BUFFERTAGS_EQUAL(slot->tag, bufferTag)) {
+        uint64_t newestLsn = 0;
+
+        // Other puts of the page may have been made while it wasn't cached
+        if (KvSeekNewestPage(bufferTag, ~(uint64_t) 0, &newestLsn, NULL) && newestLsn >= lsn) {
+            valueLen = KvPageLooseEncode(page, value);
+            KvBatchPutKey(key, keyLen, value, (int) valueLen);
+            pthread_mutex_unlock(&deltaLocks[slotNum % KV_DELTA_LOCKS]);
+            return;
+        }
+        slot->valid = 0;
+    } else if (lsn <= slot->lastLsn) {
+        valueLen = KvPageLooseEncode(page, value);
+        KvBatchPutKey(key, keyLen, value, (int) valueLen);
+        pthread_mutex_unlock(&deltaLocks[slotNum % KV_DELTA_LOCKS]);
+        return;
+    } else if (slot->deltas < kv_page_delta_versions
+               && (valueLen = KvPageDeltaEncode(slot->base, slot->baseLsn, page, value, KV_DELTA_MAX_LEN)) > 0) {
+        KvBatchPutKey(key, keyLen, value, (int) valueLen);
+        slot->deltas++;
+        slot->lastLsn = lsn;
+        pthread_mutex_unlock(&deltaLocks[slotNum % KV_DELTA_LOCKS]);
+        return;
+    }
+
+    // A new full version, the base of the next deltas
+    KvBatchPutKey(key, keyLen, page, BLCKSZ);
+    slot->tag = bufferTag;
+    slot->valid = 1;
+    slot->deltas = 0;
+    slot->baseLsn = lsn;
+    slot->lastLsn = lsn;
+    memcpy(slot->base, page, BLCKSZ);
+    pthread_mutex_unlock(&deltaLocks[slotNum % KV_DELTA_LOCKS]);
+}
+
 void PutPage2Rocksdb(BufferTag bufferTag, uint64_t lsn, char* pageContent) {
-    char tempKey[MAX_PATH_LEN];
-    snprintf(tempKey, sizeof(tempKey), ROCKSDB_PAGE_VERSION_KEY, bufferTag.rnode.spcNode,
-             bufferTag.rnode.dbNode, bufferTag.rnode.relNode, bufferTag.forkNum, bufferTag.blockNum, lsn);
+    char tempKey[KV_PAGE_KEY_LEN];
+    size_t keyLen = KvMakePageVersionKey(tempKey, bufferTag, lsn);
 #ifdef ENABLE_DEBUG_INFO
-    printf("%s %d, key = %s\n", __func__ , __LINE__, tempKey);
+    printf("%s %d, rel = %u, blk = %u, lsn = %lu\n", __func__ , __LINE__,
+           bufferTag.rnode.relNode, bufferTag.blockNum, lsn);
     fflush(stdout);
 #endif
 
-    KvPut(tempKey, pageContent, BLCKSZ);
+    // A delta can only be dropped together with its base by compaction, the
+    // explicit deletes don't know about bases
+    // The newest replayed version is the one read next
+    KvPageCachePut(bufferTag, lsn, pageContent);
+    if (kv_page_delta_versions > 0 && KvPageGcInCompaction()) {
+        KvPutDeltaPage(bufferTag, lsn, tempKey, keyLen, pageContent);
+        return;
+    }
+    KvBatchPutKey(tempKey, keyLen, pageContent, BLCKSZ);
 
     return;
 }
 
+//! Lsn Chain Format: $ChainLen, [v0, v1, ... , v($ChainLen-1)]
+//! The values are opaque to this file, the logindex hashmap packs two per entry
+int PutLsnChain2Rocksdb(BufferTag bufferTag, uint64_t* chain, int chainLen) {
+    char tempKey[KV_PAGE_PREFIX_LEN];
+    size_t keyLen = KvMakePagePrefix(tempKey, KV_KEY_KIND_LSN_CHAIN, bufferTag);
+
+    size_t valueLen = (chainLen + 1) * sizeof(uint64_t);
+    uint64_t *value = (uint64_t*) calloc(1, valueLen);
+    if(value == NULL)
+        return 1;
+    value[0] = chainLen;
+    memcpy(value + 1, chain, chainLen * sizeof(uint64_t));
+
+    int err = KvPutKey(KV_FAMILY_META, tempKey, keyLen, (char*)value, valueLen);
+    free(value);
+    return err;
+}
+
+// Unpacks a stored chain into a malloc'ed array, returns 0 if it is damaged
+static int KvDecodeLsnChain(const char *value, size_t valueSize, uint64_t **chain, int *chainLen) {
+    uint64_t storedLen;
+
+    if(valueSize < sizeof(uint64_t))
+        return 0;
+    memcpy(&storedLen, value, sizeof(uint64_t));
+    if(storedLen > valueSize / sizeof(uint64_t) - 1)
+        return 0;
+
+    *chainLen = (int) storedLen;
+    *chain = (uint64_t*) malloc((*chainLen + 1) * sizeof(uint64_t));
+    memcpy(*chain, value + sizeof(uint64_t), *chainLen * sizeof(uint64_t));
+    return 1;
+}
+
+// *chain should be freed by caller functions
+// return value: found->1, not found->0
+int GetLsnChainFromRocksdb(BufferTag bufferTag, uint64_t** chain, int* chainLen) {
+    char tempKey[KV_PAGE_PREFIX_LEN];
+    size_t keyLen = KvMakePagePrefix(tempKey, KV_KEY_KIND_LSN_CHAIN, bufferTag);
+
+    char *value = NULL;
+    size_t valueSize = 0;
+    if(KvGetKey(KV_FAMILY_META, tempKey, keyLen, &value, &valueSize)) {
+        printf("%s failed, because of KvGet function failed\n", __func__ );
+        return 0;
+    }
+    int found = value != NULL && KvDecodeLsnChain(value, valueSize, chain, chainLen);
+    free(value);
+    return found;
+}
+
+#ifdef USE_ROCKSDB
+typedef struct KvLsnChainListState {
+    uint64_t **chains;
+    int *chainLens;
+    int foundNum;
+} KvLsnChainListState;
+
+static void KvLsnChainListVisit(int pos, const char *value, size_t valueLen, void *arg) {
+    KvLsnChainListState *state = (KvLsnChainListState*) arg;
+
+    if (KvDecodeLsnChain(value, valueLen, &state->chains[pos], &state->chainLens[pos]))
+        state->foundNum++;
+}
+
+static int KvRocksdbGetLsnChainList(const BufferTag* bufferTags, int num, uint64_t** chains, int* chainLens) {
+    KvLsnChainListState state = {chains, chainLens, 0};
+
+    char (*keys)[KV_PAGE_PREFIX_LEN] = malloc(sizeof(*keys) * num);
+    const char **keyList = (const char**) malloc(sizeof(char*) * num);
+    size_t *keySizes = (size_t*) malloc(sizeof(size_t) * num);
+
+    for (int i = 0; i < num; i++) {
+        keySizes[i] = KvMakePagePrefix(keys[i], KV_KEY_KIND_LSN_CHAIN, bufferTags[i]);
+        keyList[i] = keys[i];
+        chains[i] = NULL;
+        chainLens[i] = 0;
+    }
+    KvRocksdbMultiGet(KV_FAMILY_META, keyList, keySizes, num, KvLsnChainListVisit, &state);
+    free(keys);
+    free(keyList);
+    free(keySizes);
+    return state.foundNum;
+}
+#endif
+
+// Fetches the chains of several pages with one batched lookup. Missing ones
+// come back NULL, the others should be freed by caller functions.
+// Returns how many were found.
+int GetLsnChainListFromRocksdb(const BufferTag* bufferTags, int num, uint64_t** chains, int* chainLens) {
+    int foundNum = 0;
+
+    InitKvStore();
+#ifdef USE_ROCKSDB
+    if (KvUsingRocksdb())
+        return KvRocksdbGetLsnChainList(bufferTags, num, chains, chainLens);
+#endif
+    for (int i = 0; i < num; i++) {
+        if (GetLsnChainFromRocksdb(bufferTags[i], &chains[i], &chainLens[i])) {
+            foundNum++;
+        } else {
+            chains[i] = NULL;
+            chainLens[i] = 0;
+        }
+    }
+    return foundNum;
+}
+
+void DeleteLsnChainFromRocksdb(BufferTag bufferTag) {
+    char tempKey[KV_PAGE_PREFIX_LEN];
+    size_t keyLen = KvMakePagePrefix(tempKey, KV_KEY_KIND_LSN_CHAIN, bufferTag);
+
+    KvDeleteKey(KV_FAMILY_META, tempKey, keyLen);
+}
+
 
 #ifdef DISABLED_FUNCTION
 
@@ -0,0 +1,213 @@
+#include "postgres.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "common/hashfn.h"
+#include "storage/kv_page_cache.h"
+
+// GUC
+int kv_page_cache_size = 16384;
+
+#define KV_PAGE_CACHE_SHARDS (64)
+#define KV_PAGE_CACHE_NONE (-1)
+
+typedef struct KvPageCacheFrame {
+    BufferTag tag;
+    uint64_t lsn;
+    uint32 hash;
+    int valid;
+    int referenced;
+    int next;           // in the bucket
+} KvPageCacheFrame;
+
+typedef struct KvPageCacheShard {
+    pthread_mutex_t lock;
+    int frameNum;
+    int limit;          // frames the clock uses, the others are released
+    int validNum;
+    int hand;
+    int bucketNum;
+    int *buckets;
+    KvPageCacheFrame *frames;
+    char *pages;
+} KvPageCacheShard;
+
+static KvPageCacheShard *shards = NULL;
+static pthread_once_t cacheOnce = PTHREAD_ONCE_INIT;
+
+static void KvPageCacheInit(void) {
+    int frameNum = kv_page_cache_size / KV_PAGE_CACHE_SHARDS;
+
+    if (frameNum <= 0)
+        return;
+    shards = (KvPageCacheShard*) calloc(KV_PAGE_CACHE_SHARDS, sizeof(KvPageCacheShard));
+    for (int i = 0; i < KV_PAGE_CACHE_SHARDS; i++) {
+        KvPageCacheShard *shard = &shards[i];
+
+        pthread_mutex_init(&shard->lock, NULL);
+        shard->frameNum = frameNum;
+        shard->limit = frameNum;
+        shard->bucketNum = frameNum * 2;
+        shard->buckets = (int*) malloc(sizeof(int) * shard->bucketNum);
+        for (int b = 0; b < shard->bucketNum; b++)
+            shard->buckets[b] = KV_PAGE_CACHE_NONE;
+        shard->frames = (KvPageCacheFrame*) calloc(frameNum, sizeof(KvPageCacheFrame));
+        shard->pages = (char*) malloc((size_t) frameNum * BLCKSZ);
+    }
+}
+
+static KvPageCacheShard *KvPageCacheShardOf(BufferTag tag, uint32 *hash) {
+    pthread_once(&cacheOnce, KvPageCacheInit);
+    if (shards == NULL)
+        return NULL;
+    *hash = hash_bytes((const unsigned char *) &tag, sizeof(tag));
+    return &shards[*hash % KV_PAGE_CACHE_SHARDS];
+}
+
+// Caller holds the shard lock. Returns the frame of the page or NONE
+static int KvPageCacheFind(KvPageCacheShard *shard, uint32 hash, BufferTag tag) {
+    int frame = shard->buckets[(hash / KV_PAGE_CACHE_SHARDS) % shard->bucketNum];
+
+    while (frame != KV_PAGE_CACHE_NONE) {
+        KvPageCacheFrame *entry = &shard->frames[frame];
+
+        if (entry->hash == hash && BUFFERTAGS_EQUAL(entry->tag, tag))
+            return frame;
+        frame = entry->next;
+    }
+    return KV_PAGE_CACHE_NONE;
+}
+
+// Caller holds the shard lock
+static void KvPageCacheUnlink(KvPageCacheShard *shard, int frame) {
+    KvPageCacheFrame *entry = &shard->frames[frame];
+    int *link = &shard->buckets[(entry->hash / KV_PAGE_CACHE_SHARDS) % shard->bucketNum];
+
+    while (*link != frame)
+        link = &shard->frames[*link].next;
+    *link = entry->next;
+    entry->valid = 0;
+    shard->validNum--;
+}
+
+// Caller holds the shard lock. A frame not referenced since the hand last
+// passed it is taken
+static int KvPageCacheEvict(KvPageCacheShard *shard) {
+    for (;;) {
+        int frame = shard->hand;
+        KvPageCacheFrame *entry = &shard->frames[frame];
+
+        shard->hand = (shard->hand + 1) % shard->limit;
+        if (!entry->valid)
+            return frame;
+        if (entry->referenced) {
+            entry->referenced = 0;
+            continue;
+        }
+        KvPageCacheUnlink(shard, frame);
+        return frame;
+    }
+}
+
+int KvPageCacheGet(BufferTag tag, uint64_t lsn, char *page) {
+    uint32 hash;
+    KvPageCacheShard *shard = KvPageCacheShardOf(tag, &hash);
+    int hit = 0;
+
+    if (shard == NULL)
+        return 0;
+    pthread_mutex_lock(&shard->lock);
+    int frame = KvPageCacheFind(shard, hash, tag);
+    if (frame != KV_PAGE_CACHE_NONE && shard->frames[frame].lsn == lsn) {
+        shard->frames[frame].referenced = 1;
+        memcpy(page, shard->pages + (size_t) frame * BLCKSZ, BLCKSZ);
+        hit = 1;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return hit;
+}
+
+void KvPageCachePut(BufferTag tag, uint64_t lsn, const char *page) {
+    uint32 hash;
+    KvPageCacheShard *shard = KvPageCacheShardOf(tag, &hash);
+
+    if (shard == NULL)
+        return;
+    pthread_mutex_lock(&shard->lock);
+    int frame = KvPageCacheFind(shard, hash, tag);
+    if (frame != KV_PAGE_CACHE_NONE) {
+        // An older version read late must not replace the newest one
+        if (shard->frames[frame].lsn > lsn) {
+            pthread_mutex_unlock(&shard->lock);
+            return;
+        }
+    } else {
+        int *bucket = &shard->buckets[(hash / KV_PAGE_CACHE_SHARDS) % shard->bucketNum];
+
+        frame = KvPageCacheEvict(shard);
+        shard->frames[frame].tag = tag;
+        shard->frames[frame].hash = hash;
+        shard->frames[frame].valid = 1;
+        shard->validNum++;
+        shard->frames[frame].next = *bucket;
+        *bucket = frame;
+    }
+    shard->frames[frame].lsn = lsn;
+    shard->frames[frame].referenced = 1;
+    memcpy(shard->pages + (size_t) frame * BLCKSZ, page, BLCKSZ);
+    pthread_mutex_unlock(&shard->lock);
+}
+
+void KvPageCacheForget(BufferTag tag, uint64_t lsn) {
+    uint32 hash;
+    KvPageCacheShard *shard = KvPageCacheShardOf(tag, &hash);
+
+    if (shard == NULL)
+        return;
+    pthread_mutex_lock(&shard->lock);
+    int frame = KvPageCacheFind(shard, hash, tag);
+    if (frame != KV_PAGE_CACHE_NONE && shard->frames[frame].lsn == lsn)
+        KvPageCacheUnlink(shard, frame);
+    pthread_mutex_unlock(&shard->lock);
+}
+
+void KvPageCacheSetLimit(int blocks) {
+    long osPage = sysconf(_SC_PAGESIZE);
+
+    pthread_once(&cacheOnce, KvPageCacheInit);
+    if (shards == NULL)
+        return;
+    for (int i = 0; i < KV_PAGE_CACHE_SHARDS; i++) {
+        KvPageCacheShard *shard = &shards[i];
+        int limit = Min(Max(blocks / KV_PAGE_CACHE_SHARDS, 1), shard->frameNum);
+
+        pthread_mutex_lock(&shard->lock);
+        if (limit < shard->limit) {
+            for (int frame = limit; frame < shard->limit; frame++)
+                if (shard->frames[frame].valid)
+                    KvPageCacheUnlink(shard, frame);
+            // Hand the released frames' memory back, they are refilled on use
+            uintptr_t from = TYPEALIGN(osPage, (uintptr_t) (shard->pages + (size_t) limit * BLCKSZ));
+            uintptr_t to = TYPEALIGN_DOWN(osPage, (uintptr_t) (shard->pages + (size_t) shard->limit * BLCKSZ));
+            if (to > from)
+                madvise((void *) from, to - from, MADV_DONTNEED);
+            if (shard->hand >= limit)
+                shard->hand = 0;
+        }
+        shard->limit = limit;
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+uint64_t KvPageCacheBytes(void) {
+    uint64_t frames = 0;
+
+    if (shards == NULL)
+        return 0;
+    for (int i = 0; i < KV_PAGE_CACHE_SHARDS; i++)
+        frames += (uint64_t) __atomic_load_n(&shards[i].validNum, __ATOMIC_RELAXED);
+    return frames * BLCKSZ;
+}
@@ -0,0 +1,144 @@
+#include "postgres.h"
+
+#include <string.h>
+#include "storage/kv_page_delta.h"
+
+// Unchanged stretches shorter than a run header are cheaper to copy along
+#define KV_DELTA_MERGE_GAP ((int) (2 * sizeof(uint16_t)))
+
+int KvPageValueKind(const char *value, size_t valueLen, uint64_t *baseLsn) {
+    KvPageValueHeader header;
+
+    if (valueLen == BLCKSZ)
+        return KV_PAGE_VALUE_BASE;
+    if (valueLen < sizeof(header))
+        return KV_PAGE_VALUE_INVALID;
+
+    memcpy(&header, value, sizeof(header));
+    if (header.magic != KV_PAGE_VALUE_MAGIC)
+        return KV_PAGE_VALUE_INVALID;
+    if (header.kind == KV_PAGE_VALUE_LOOSE && valueLen == KV_PAGE_VALUE_MAX_LEN)
+        return KV_PAGE_VALUE_LOOSE;
+    if (header.kind == KV_PAGE_VALUE_DELTA) {
+        *baseLsn = header.baseLsn;
+        return KV_PAGE_VALUE_DELTA;
+    }
+    if (header.kind == KV_PAGE_VALUE_REMOTE && valueLen == KV_PAGE_REMOTE_LEN) {
+        *baseLsn = header.baseLsn;
+        return KV_PAGE_VALUE_REMOTE;
+    }
+    return KV_PAGE_VALUE_INVALID;
+}
+
+size_t KvPageDeltaEncode(const char *base, uint64_t baseLsn, const char *page, char *out, size_t maxLen) {
+    KvPageValueHeader header;
+    size_t pos = sizeof(header);
+    int runs = 0;
+    int i = 0;
+
+    if (maxLen < sizeof(header))
+        return 0;
+
+    while (i < BLCKSZ) {
+        // Most of the page is unchanged, skip it a word at a time
+        if (i + 8 <= BLCKSZ && memcmp(base + i, page + i, 8) == 0) {
+            i += 8;
+            continue;
+        }
+        if (base[i] == page[i]) {
+            i++;
+            continue;
+        }
+
+        int start = i;
+        int end = i + 1;
+        for (;;) {
+            while (end < BLCKSZ && base[end] != page[end])
+                end++;
+            int next = end;
+            while (next < BLCKSZ && next - end < KV_DELTA_MERGE_GAP && base[next] == page[next])
+                next++;
+            if (next >= BLCKSZ || next - end >= KV_DELTA_MERGE_GAP)
+                break;
+            end = next;
+        }
+
+        uint16_t offset = (uint16_t) start;
+        uint16_t len = (uint16_t) (end - start);
+        if (pos + 2 * sizeof(uint16_t) + len > maxLen)
+            return 0;
+        memcpy(out + pos, &offset, sizeof(offset));
+        memcpy(out + pos + sizeof(offset), &len, sizeof(len));
+        memcpy(out + pos + 2 * sizeof(uint16_t), page + start, len);
+        pos += 2 * sizeof(uint16_t) + len;
+        runs++;
+        i = end;
+    }
+
+    header.magic = KV_PAGE_VALUE_MAGIC;
+    header.kind = KV_PAGE_VALUE_DELTA;
+    header.runs = (uint16_t) runs;
+    header.baseLsn = baseLsn;
+    memcpy(out, &header, sizeof(header));
+    return pos;
+}
+
+int KvPageDeltaApply(const char *value, size_t valueLen, char *page) {
+    KvPageValueHeader header;
+    size_t pos = sizeof(header);
+
+    if (valueLen < sizeof(header))
+        return 0;
+    memcpy(&header, value, sizeof(header));
+
+    for (int r = 0; r < header.runs; r++) {
+        uint16_t offset, len;
+
+        if (pos + 2 * sizeof(uint16_t) > valueLen)
+            return 0;
+        memcpy(&offset, value + pos, sizeof(offset));
+        memcpy(&len, value + pos + sizeof(offset), sizeof(len));
+        pos += 2 * sizeof(uint16_t);
+        if (pos + len > valueLen || (size_t) offset + len > BLCKSZ)
+            return 0;
+        memcpy(page + offset, value + pos, len);
+        pos += len;
+    }
+    return pos == valueLen;
+}
+
+size_t KvPageLooseEncode(const char *page, char *out) {
+    KvPageValueHeader header;
+
+    header.magic = KV_PAGE_VALUE_MAGIC;
+    header.kind = KV_PAGE_VALUE_LOOSE;
+    header.runs = 0;
+    header.baseLsn = 0;
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), page, BLCKSZ);
+    return KV_PAGE_VALUE_MAX_LEN;
+}
+
+size_t KvPageRemoteEncode(int kind, uint64_t baseLsn, const KvPageRemoteRef *ref, char *out) {
+    KvPageValueHeader header;
+
+    header.magic = KV_PAGE_VALUE_MAGIC;
+    header.kind = KV_PAGE_VALUE_REMOTE;
+    header.runs = (uint16_t) kind;
+    header.baseLsn = baseLsn;
+    memcpy(out, &header, sizeof(header));
+    memcpy(out + sizeof(header), ref, sizeof(*ref));
+    return KV_PAGE_REMOTE_LEN;
+}
+
+int KvPageRemoteDecode(const char *value, size_t valueLen, KvPageRemoteRef *ref) {
+    KvPageValueHeader header;
+    uint64_t baseLsn;
+
+    if (KvPageValueKind(value, valueLen, &baseLsn) != KV_PAGE_VALUE_REMOTE)
+        return KV_PAGE_VALUE_INVALID;
+    memcpy(&header, value, sizeof(header));
+    if (ref != NULL)
+        memcpy(ref, value + sizeof(header), sizeof(*ref));
+    return header.runs;
+}
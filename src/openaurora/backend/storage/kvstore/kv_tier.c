@@ -0,0 +1,437 @@
+#include "postgres.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "port/pg_bswap.h"
+#include "port/pg_crc32c.h"
+#include "storage/kv_engine.h"
+#include "storage/kv_interface.h"
+#include "storage/kv_page_delta.h"
+#include "storage/kv_tier.h"
+
+// GUCs
+char *kv_tier_path = NULL;
+int kv_tier_min_age = 4096;     // MB of WAL
+
+#define KV_TIER_OBJECT_SIZE ((size_t)64*1024*1024)
+#define KV_TIER_INTERVAL (60)   // seconds
+#define KV_TIER_CACHE_SLOTS (8192)
+#define KV_TIER_CACHE_LOCKS (64)
+
+//! Manifest Format: $NextObject(8), [$Object(8)]*
+#define KV_TIER_MANIFEST_KEY ("kv_tier_objects")
+
+static const KvTierStore *tierStore = NULL;
+static pthread_once_t tierOnce = PTHREAD_ONCE_INIT;
+
+// Only the sweep changes them
+static uint64_t nextObject = 0;
+static uint64_t *objects = NULL;
+static int objectNum = 0;
+
+static void KvTierObjectPath(char *path, size_t len, uint64_t object) {
+    snprintf(path, len, "%s/pages_%016lx", kv_tier_path, (unsigned long) object);
+}
+
+static int KvTierDirPut(uint64_t object, const char *data, size_t len) {
+    char path[MAXPGPATH];
+    char tempPath[MAXPGPATH];
+    size_t written = 0;
+    int fd;
+
+    KvTierObjectPath(path, sizeof(path), object);
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+    fd = open(tempPath, O_WRONLY | O_CREAT | O_TRUNC | PG_BINARY, 0600);
+    if (fd < 0) {
+        printf("%s open %s failed, error = %s\n", __func__ , tempPath, strerror(errno));
+        fflush(stdout);
+        return 1;
+    }
+    while (written < len) {
+        ssize_t n = write(fd, data + written, len - written);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        written += n;
+    }
+    if (written < len || fsync(fd) != 0) {
+        printf("%s write %s failed, error = %s\n", __func__ , tempPath, strerror(errno));
+        fflush(stdout);
+        close(fd);
+        unlink(tempPath);
+        return 1;
+    }
+    close(fd);
+    // A torn object is never seen under its name
+    if (rename(tempPath, path) != 0) {
+        printf("%s rename %s failed, error = %s\n", __func__ , tempPath, strerror(errno));
+        fflush(stdout);
+        unlink(tempPath);
+        return 1;
+    }
+    return 0;
+}
+
+static int KvTierDirGet(uint64_t object, size_t offset, size_t len, char *buf) {
+    char path[MAXPGPATH];
+    size_t nread = 0;
+    int fd;
+
+    KvTierObjectPath(path, sizeof(path), object);
+    fd = open(path, O_RDONLY | PG_BINARY, 0);
+    if (fd < 0)
+        return 1;
+    while (nread < len) {
+        ssize_t n = pread(fd, buf + nread, len - nread, offset + nread);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        nread += n;
+    }
+    close(fd);
+    return nread < len;
+}
+
+static int KvTierDirRemove(uint64_t object) {
+    char path[MAXPGPATH];
+
+    KvTierObjectPath(path, sizeof(path), object);
+    return unlink(path) != 0 && errno != ENOENT;
+}
+
+const KvTierStore KvTierDirStore = {
+    "directory",
+    KvTierDirPut,
+    KvTierDirGet,
+    KvTierDirRemove
+};
+
+void KvSetTierStore(const KvTierStore *store) {
+    __atomic_store_n(&tierStore, store, __ATOMIC_RELEASE);
+}
+
+static const KvTierStore *KvTierActiveStore(void) {
+    const KvTierStore *store = __atomic_load_n(&tierStore, __ATOMIC_ACQUIRE);
+
+    if (store == NULL && kv_tier_path != NULL && kv_tier_path[0] != '\0')
+        store = &KvTierDirStore;
+    return store;
+}
+
+//! The values fetched last, a remote value never changes, so the cache
+//! needs no invalidation.
+typedef struct KvTierCacheSlot {
+    uint64_t object;
+    uint32_t offset;
+    char *value;
+    size_t len;
+} KvTierCacheSlot;
+
+static KvTierCacheSlot tierCache[KV_TIER_CACHE_SLOTS];
+static pthread_mutex_t tierCacheLocks[KV_TIER_CACHE_LOCKS];
+static pthread_once_t tierCacheOnce = PTHREAD_ONCE_INIT;
+
+static void KvTierCacheInit(void) {
+    for (int i = 0; i < KV_TIER_CACHE_LOCKS; i++)
+        pthread_mutex_init(&tierCacheLocks[i], NULL);
+}
+
+static int KvTierCacheSlotOf(uint64_t object, uint32_t offset) {
+    return (int) (((object * 0x9E3779B97F4A7C15ull) ^ offset) % KV_TIER_CACHE_SLOTS);
+}
+
+char *KvTierFetch(const char *value, size_t valueLen, size_t *fetchedLen) {
+    const KvTierStore *store = KvTierActiveStore();
+    KvPageRemoteRef ref;
+    pg_crc32c crc;
+    char *fetched = NULL;
+    char *copy;
+    int slot;
+
+    if (KvPageRemoteDecode(value, valueLen, &ref) == KV_PAGE_VALUE_INVALID)
+        return NULL;
+    slot = KvTierCacheSlotOf(ref.object, ref.offset);
+    pthread_once(&tierCacheOnce, KvTierCacheInit);
+    pthread_mutex_lock(&tierCacheLocks[slot % KV_TIER_CACHE_LOCKS]);
+    if (tierCache[slot].value != NULL && tierCache[slot].object == ref.object
+        && tierCache[slot].offset == ref.offset) {
+        fetched = (char*) malloc(tierCache[slot].len);
+        memcpy(fetched, tierCache[slot].value, tierCache[slot].len);
+        *fetchedLen = tierCache[slot].len;
+    }
+    pthread_mutex_unlock(&tierCacheLocks[slot % KV_TIER_CACHE_LOCKS]);
+    if (fetched != NULL)
+        return fetched;
+
+    if (store == NULL) {
+        printf("%s object %lu is out of reach, kv_tier_path isn't set\n", __func__ , (unsigned long) ref.object);
+        fflush(stdout);
+        return NULL;
+    }
+    fetched = (char*) malloc(Max(ref.len, 1));
+    if (store->get(ref.object, ref.offset, ref.len, fetched) != 0) {
+        printf("%s read of object %lu failed\n", __func__ , (unsigned long) ref.object);
+        fflush(stdout);
+        free(fetched);
+        return NULL;
+    }
+    INIT_CRC32C(crc);
+    COMP_CRC32C(crc, fetched, ref.len);
+    FIN_CRC32C(crc);
+    if (!EQ_CRC32C(crc, ref.crc)) {
+        printf("%s object %lu is damaged at %u\n", __func__ , (unsigned long) ref.object, ref.offset);
+        fflush(stdout);
+        free(fetched);
+        return NULL;
+    }
+
+    copy = (char*) malloc(Max(ref.len, 1));
+    memcpy(copy, fetched, ref.len);
+    pthread_mutex_lock(&tierCacheLocks[slot % KV_TIER_CACHE_LOCKS]);
+    free(tierCache[slot].value);
+    tierCache[slot].object = ref.object;
+    tierCache[slot].offset = ref.offset;
+    tierCache[slot].value = copy;
+    tierCache[slot].len = ref.len;
+    pthread_mutex_unlock(&tierCacheLocks[slot % KV_TIER_CACHE_LOCKS]);
+    *fetchedLen = ref.len;
+    return fetched;
+}
+
+static void KvTierLoadManifest(void) {
+    char key[] = KV_TIER_MANIFEST_KEY;
+    char *value = NULL;
+    size_t len = 0;
+
+    if (KvGet(key, &value, &len) != 0 || value == NULL)
+        return;
+    if (len >= sizeof(uint64_t) && len % sizeof(uint64_t) == 0) {
+        memcpy(&nextObject, value, sizeof(uint64_t));
+        objectNum = (int) (len / sizeof(uint64_t)) - 1;
+        objects = (uint64_t*) malloc(sizeof(uint64_t) * Max(objectNum, 1));
+        memcpy(objects, value + sizeof(uint64_t), sizeof(uint64_t) * objectNum);
+    }
+    free(value);
+}
+
+static int KvTierSaveManifest(void) {
+    char key[] = KV_TIER_MANIFEST_KEY;
+    size_t len = sizeof(uint64_t) * (objectNum + 1);
+    char *value = (char*) malloc(len);
+    int err;
+
+    memcpy(value, &nextObject, sizeof(uint64_t));
+    memcpy(value + sizeof(uint64_t), objects, sizeof(uint64_t) * objectNum);
+    err = KvPut(key, value, (int) len);
+    free(value);
+    return err;
+}
+
+typedef struct KvTierPending {
+    char key[KV_PAGE_KEY_LEN];
+    int kind;
+    uint64_t baseLsn;
+    KvPageRemoteRef ref;
+} KvTierPending;
+
+typedef struct KvTierSweep {
+    uint64_t coldLsn;
+    char prefix[KV_PAGE_PREFIX_LEN];
+    int havePrefix;
+    int cold;
+    // The objects listed when the sweep started, with their remote values
+    uint64_t *listed;
+    int *refs;
+    int listedNum;
+    // The object being filled
+    char *data;
+    size_t len;
+    KvTierPending *pending;
+    int pendingNum;
+    int pendingCap;
+} KvTierSweep;
+
+static int KvTierCompareObject(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t*) a;
+    uint64_t y = *(const uint64_t*) b;
+
+    return x < y ? -1 : x > y;
+}
+
+// Stores the object, then lists it, then points the versions at it. A crash
+// in between leaves an object without remote values, removed by a later sweep
+static void KvTierFlushObject(KvTierSweep *sweep, const KvTierStore *store) {
+    uint64_t object = nextObject;
+
+    if (sweep->pendingNum == 0)
+        return;
+    nextObject++;
+    objects = (uint64_t*) realloc(objects, sizeof(uint64_t) * (objectNum + 1));
+    objects[objectNum++] = object;
+    if (store->put(object, sweep->data, sweep->len) != 0 || KvTierSaveManifest() != 0) {
+        // The versions stay local, the next sweep tries again
+        store->remove(object);
+        objectNum--;
+        sweep->pendingNum = 0;
+        sweep->len = 0;
+        return;
+    }
+
+    for (int i = 0; i < sweep->pendingNum; i++) {
+        KvTierPending *pending = &sweep->pending[i];
+        char value[KV_PAGE_REMOTE_LEN];
+        size_t valueLen;
+
+        pending->ref.object = object;
+        valueLen = KvPageRemoteEncode(pending->kind, pending->baseLsn, &pending->ref, value);
+        KvReplacePageValue(pending->key, KV_PAGE_KEY_LEN, value, valueLen);
+    }
+    KvFlushPageBatch();
+    printf("%s moved %d page versions, %zu bytes, to object %lu\n", __func__ ,
+           sweep->pendingNum, sweep->len, (unsigned long) object);
+    fflush(stdout);
+    sweep->pendingNum = 0;
+    sweep->len = 0;
+}
+
+static int KvTierVisitPage(const char *key, size_t keyLen, const char *value, size_t valueLen, void *arg) {
+    KvTierSweep *sweep = (KvTierSweep*) arg;
+    const KvTierStore *store = KvTierActiveStore();
+    uint64_t baseLsn = 0;
+    int kind;
+
+    // The logindex chains share the family
+    if (keyLen != KV_PAGE_KEY_LEN)
+        return 1;
+    if (!sweep->havePrefix || memcmp(sweep->prefix, key, KV_PAGE_PREFIX_LEN) != 0) {
+        uint64 beLsn;
+
+        memcpy(sweep->prefix, key, KV_PAGE_PREFIX_LEN);
+        sweep->havePrefix = 1;
+        // Newest first, the first version tells whether the page is cold
+        memcpy(&beLsn, key + KV_PAGE_PREFIX_LEN, sizeof(beLsn));
+        sweep->cold = ~pg_ntoh64(beLsn) <= sweep->coldLsn;
+    }
+
+    kind = KvPageValueKind(value, valueLen, &baseLsn);
+    if (kind == KV_PAGE_VALUE_REMOTE) {
+        KvPageRemoteRef ref;
+        uint64_t *found;
+
+        KvPageRemoteDecode(value, valueLen, &ref);
+        found = (uint64_t*) bsearch(&ref.object, sweep->listed, sweep->listedNum, sizeof(uint64_t),
+                                    KvTierCompareObject);
+        if (found != NULL)
+            sweep->refs[found - sweep->listed]++;
+        return 1;
+    }
+    if (!sweep->cold || kind == KV_PAGE_VALUE_INVALID || store == NULL)
+        return 1;
+
+    if (sweep->pendingNum == sweep->pendingCap) {
+        sweep->pendingCap = sweep->pendingCap > 0 ? sweep->pendingCap * 2 : 1024;
+        sweep->pending = (KvTierPending*) realloc(sweep->pending, sizeof(KvTierPending) * sweep->pendingCap);
+    }
+    KvTierPending *pending = &sweep->pending[sweep->pendingNum++];
+    memcpy(pending->key, key, KV_PAGE_KEY_LEN);
+    pending->kind = kind;
+    pending->baseLsn = baseLsn;
+    pending->ref.offset = (uint32_t) sweep->len;
+    pending->ref.len = (uint32_t) valueLen;
+    pending->ref.pad = 0;
+    INIT_CRC32C(pending->ref.crc);
+    COMP_CRC32C(pending->ref.crc, value, valueLen);
+    FIN_CRC32C(pending->ref.crc);
+    memcpy(sweep->data + sweep->len, value, valueLen);
+    sweep->len += valueLen;
+
+    if (sweep->len + KV_PAGE_VALUE_MAX_LEN > KV_TIER_OBJECT_SIZE)
+        KvTierFlushObject(sweep, store);
+    return 1;
+}
+
+static void KvTierSweepOnce(void) {
+    const KvTierStore *store = KvTierActiveStore();
+    uint64_t horizon = KvGetPageGcHorizon();
+    uint64_t minAge = (uint64_t) kv_tier_min_age * 1024 * 1024;
+    KvTierSweep sweep;
+    int complete;
+    int removed = 0;
+
+    // Nothing is cold before the compute nodes tell how far they read
+    if (store == NULL || horizon <= minAge)
+        return;
+    memset(&sweep, 0, sizeof(sweep));
+    sweep.coldLsn = horizon - minAge;
+    sweep.listedNum = objectNum;
+    sweep.listed = (uint64_t*) malloc(sizeof(uint64_t) * Max(objectNum, 1));
+    sweep.refs = (int*) calloc(Max(objectNum, 1), sizeof(int));
+    memcpy(sweep.listed, objects, sizeof(uint64_t) * objectNum);
+    qsort(sweep.listed, sweep.listedNum, sizeof(uint64_t), KvTierCompareObject);
+    sweep.data = (char*) malloc(KV_TIER_OBJECT_SIZE);
+
+    // The objects stored from here on aren't in the list, only listed ones
+    // can be found unused
+    KvFlushPageBatch();
+    complete = KvScanPages(KvTierVisitPage, &sweep) == 0;
+    KvTierFlushObject(&sweep, store);
+
+    if (complete) {
+        for (int i = 0; i < sweep.listedNum; i++) {
+            if (sweep.refs[i] > 0)
+                continue;
+            for (int j = 0; j < objectNum; j++) {
+                if (objects[j] == sweep.listed[i]) {
+                    objects[j] = objects[--objectNum];
+                    removed++;
+                    break;
+                }
+            }
+        }
+        // Unlisted first, a crash leaves an object behind rather than a
+        // listing of one that is gone
+        if (removed > 0 && KvTierSaveManifest() == 0) {
+            for (int i = 0; i < sweep.listedNum; i++)
+                if (sweep.refs[i] == 0)
+                    store->remove(sweep.listed[i]);
+            printf("%s removed %d unused objects\n", __func__ , removed);
+            fflush(stdout);
+        }
+    }
+
+    free(sweep.listed);
+    free(sweep.refs);
+    free(sweep.data);
+    free(sweep.pending);
+}
+
+static void *KvTierLoop(void *arg) {
+    KvTierLoadManifest();
+    for (;;) {
+        sleep(KV_TIER_INTERVAL);
+        KvTierSweepOnce();
+    }
+    return NULL;
+}
+
+static void KvTierStartOnce(void) {
+    pthread_t thread;
+
+    if (pthread_create(&thread, NULL, KvTierLoop, NULL) == 0)
+        pthread_detach(thread);
+}
+
+void KvTierStart(void) {
+    if (kv_tier_path == NULL || kv_tier_path[0] == '\0')
+        return;
+    pthread_once(&tierOnce, KvTierStartOnce);
+}
@@ -185,7 +185,22 @@ static const char *const BuiltinTrancheNames[] = {
 	"WAL_LOGINDEX_IO",
 	"WAL_LOGINDEX_BLOOM_LRU",
 	"MEMPOOL_CLIENT",
-	"MEMPOOL_SERVER"
+	"MEMPOOL_SERVER",
+	"LOCAL_PAGE_CACHE",
+	/* LWTRANCHE_MAP_PAGE_CACHE: */
+	"MapPageCache",
+	/* LWTRANCHE_INDEX_PAGE_CACHE: */
+	"IndexPageCache",
+	/* LWTRANCHE_COMPRESSED_PAGE_CACHE: */
+	"CompressedPageCache",
+	/* LWTRANCHE_PGSTAT_PARTITION: */
+	"PgStatPartition",
+	/* LWTRANCHE_SHARED_PLAN_CACHE: */
+	"SharedPlanCache",
+	/* LWTRANCHE_SHARED_PLAN_CACHE_DSA: */
+	"SharedPlanCacheDSA",
+	/* LWTRANCHE_MEMPOOL_VERSION_MAP: */
+	"MemPoolVersionMap"
 };
 
 StaticAssertDecl(lengthof(BuiltinTrancheNames) ==
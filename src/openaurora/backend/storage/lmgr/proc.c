@@ -45,6 +45,7 @@
 #include "replication/slot.h"
 #include "replication/syncrep.h"
 #include "replication/walsender.h"
+#include "storage/buf_numa.h"
 #include "storage/condition_variable.h"
 #include "storage/ipc.h"
 #include "storage/lmgr.h"
@@ -94,6 +95,7 @@ static void RemoveProcFromArray(int code, Datum arg);
 static void ProcKill(int code, Datum arg);
 static void AuxiliaryProcKill(int code, Datum arg);
 static void CheckDeadLock(void);
+static Size FastPathLockArraySize(void);
 
 
 /*
@@ -119,9 +121,32 @@ ProcGlobalShmemSize(void)
 	size = add_size(size, mul_size(NUM_AUXILIARY_PROCS, sizeof(PGXACT)));
 	size = add_size(size, mul_size(max_prepared_xacts, sizeof(PGXACT)));
 
+	/* Dense xid array */
+	size = add_size(size, mul_size(add_size(MaxBackends,
+											NUM_AUXILIARY_PROCS + max_prepared_xacts),
+								   sizeof(TransactionId)));
+
+	/* Fast-path lock arrays */
+	size = add_size(size, mul_size(add_size(MaxBackends,
+											NUM_AUXILIARY_PROCS + max_prepared_xacts),
+								   FastPathLockArraySize()));
+
 	return size;
 }
 
+/*
+ * Report the size of the fast-path lock array of a PGPROC: a word of lock
+ * bits and FP_LOCK_SLOTS_PER_GROUP relation OIDs per group.
+ */
+static Size
+FastPathLockArraySize(void)
+{
+	return add_size(MAXALIGN(mul_size(FastPathLockGroupsPerBackend,
+									  sizeof(uint64))),
+					MAXALIGN(mul_size(FastPathLockSlotsPerBackend(),
+									  sizeof(Oid))));
+}
+
 /*
  * Report number of semaphores needed by InitProcGlobal.
  */
@@ -165,6 +190,8 @@ InitProcGlobal(void)
 {
 	PGPROC	   *procs;
 	PGXACT	   *pgxacts;
+	char	   *fpPtr;
+	Size		fpSize = FastPathLockArraySize();
 	int			i,
 				j;
 	bool		found;
@@ -217,9 +244,24 @@ InitProcGlobal(void)
 	MemSet(pgxacts, 0, TotalProcs * sizeof(PGXACT));
 	ProcGlobal->allPgXact = pgxacts;
 
+	/* The ProcArray's dense copy of the xids, see PROC_HDR */
+	ProcGlobal->xids = (TransactionId *)
+		ShmemAlloc(TotalProcs * sizeof(TransactionId));
+	MemSet(ProcGlobal->xids, 0, TotalProcs * sizeof(TransactionId));
+
+	/*
+	 * And the fast-path lock arrays, whose size is only known at startup.
+	 */
+	fpPtr = (char *) ShmemAlloc(TotalProcs * fpSize);
+	MemSet(fpPtr, 0, TotalProcs * fpSize);
+
 	for (i = 0; i < TotalProcs; i++)
 	{
 		/* Common initialization for all PGPROCs, regardless of type. */
+		procs[i].fpLockBits = (uint64 *) fpPtr;
+		procs[i].fpRelId = (Oid *)
+			(fpPtr + MAXALIGN(FastPathLockGroupsPerBackend * sizeof(uint64)));
+		fpPtr += fpSize;
 
 		/*
 		 * Set up per-PGPROC semaphore, latch, and fpInfoLock.  Prepared xact
@@ -364,6 +406,9 @@ InitProcess(void)
 	}
 	MyPgXact = &ProcGlobal->allPgXact[MyProc->pgprocno];
 
+	/* Stay on one NUMA node, with the buffers it prefers */
+	BufNumaBindBackend(MyProc->pgprocno);
+
 	/*
 	 * Cross-check that the PGPROC is of the type we expect; if this were not
 	 * the case, it would get returned to the wrong list.
@@ -563,6 +608,8 @@ InitAuxiliaryProcess(void)
 
 	SpinLockRelease(ProcStructLock);
 
+	BufNumaBindBackend(MyProc->pgprocno);
+
 	/*
 	 * Initialize all fields of MyProc, except for those previously
 	 * initialized by InitProcGlobal.
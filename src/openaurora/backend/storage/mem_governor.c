@@ -0,0 +1,243 @@
+/*-------------------------------------------------------------------------
+ *
+ * mem_governor.c
+ *		Memory budget of the storage node, across its components
+ *
+ * The components are sampled rather than charged as they allocate: RocksDB
+ * reports its memtables and block cache, the page cache and the logindex
+ * slabs count what they hold, and the processes' resident sizes come from
+ * /proc. What the storage server holds beyond the components it knows of,
+ * the RPC handlers' buffers among it, is "other". Of the wal_redo processes
+ * only their private memory counts, the shared segments are the parent's.
+ *
+ * Pushing back escalates one step a tick, cheapest first: a flushed
+ * memtable is still read from its SST, a shrunken cache only costs misses,
+ * a spilled logindex chain costs a RocksDB read when its page is used.
+ * See storage/mem_governor.h for the configuration.
+ *
+ * IDENTIFICATION
+ *		src/backend/storage/mem_governor.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "access/logindex_hashmap.h"
+#include "storage/kv_interface.h"
+#include "storage/kv_page_cache.h"
+#include "storage/mem_governor.h"
+
+extern HashMap pageVersionHashMap;
+
+#define MEM_GOVERNOR_TICK_US (250 * 1000)
+/* Usage under this share of the limit gives the components their room back */
+#define MEM_GOVERNOR_RELAX_PCT (90)
+/* Active memtables smaller than this aren't worth an SST of their own */
+#define MEM_GOVERNOR_MIN_FLUSH ((uint64) 32 << 20)
+/* The caches keep at least this share of their size, in permille */
+#define MEM_GOVERNOR_MIN_CACHE_PERMILLE (1000 / 16)
+#define MEM_GOVERNOR_LOGINDEX_FLOOR ((uint64) 64 << 20)
+#define MEM_GOVERNOR_MAX_PROCESSES (64)
+
+static pid_t tracked_pids[MEM_GOVERNOR_MAX_PROCESSES];
+static int	tracked_num = 0;
+
+static uint64 mem_limit = 0;
+/* The sizes the components were configured with */
+static size_t block_cache_size = 0;
+static int	page_cache_blocks = 0;
+static uint64 logindex_configured = 0;
+static int	cache_permille = 1000;
+static uint64 mem_actions[MEM_ACTIONS];
+
+void
+MemGovernorTrackProcess(pid_t pid)
+{
+	if (tracked_num < MEM_GOVERNOR_MAX_PROCESSES)
+		tracked_pids[tracked_num++] = pid;
+}
+
+/* Resident and shared bytes of pid, 0 for the calling process */
+static bool
+mem_read_statm(pid_t pid, uint64 *resident, uint64 *shared)
+{
+	char		path[64];
+	unsigned long size,
+				rss,
+				shr;
+	FILE	   *file;
+	bool		ok;
+
+	if (pid == 0)
+		strcpy(path, "/proc/self/statm");
+	else
+		snprintf(path, sizeof(path), "/proc/%d/statm", (int) pid);
+	file = fopen(path, "r");
+	if (file == NULL)
+		return false;
+	ok = fscanf(file, "%lu %lu %lu", &size, &rss, &shr) == 3;
+	fclose(file);
+	if (ok)
+	{
+		long		osPage = sysconf(_SC_PAGESIZE);
+
+		*resident = (uint64) rss * osPage;
+		*shared = (uint64) shr * osPage;
+	}
+	return ok;
+}
+
+void
+MemGovernorRead(MemGovernorStats *stats)
+{
+	uint64		known = 0;
+	uint64		resident = 0;
+	uint64		shared = 0;
+
+	memset(stats, 0, sizeof(*stats));
+	KvMemoryUsage(&stats->bytes[MEM_MEMTABLES], &stats->bytes[MEM_BLOCK_CACHE]);
+	stats->bytes[MEM_PAGE_CACHE] = KvPageCacheBytes();
+	stats->bytes[MEM_LOGINDEX] = HashMapResidentBytes();
+	for (int i = 0; i < tracked_num; i++)
+	{
+		if (mem_read_statm(tracked_pids[i], &resident, &shared) && resident > shared)
+			stats->bytes[MEM_REDO] += resident - shared;
+	}
+	for (int c = 0; c < MEM_OTHER; c++)
+		if (c != MEM_REDO)
+			known += stats->bytes[c];
+	if (mem_read_statm(0, &resident, &shared) && resident > known)
+		stats->bytes[MEM_OTHER] = resident - known;
+
+	for (int c = 0; c < MEM_COMPONENTS; c++)
+		stats->total += stats->bytes[c];
+	stats->limit = mem_limit;
+	stats->cacheScale = __atomic_load_n(&cache_permille, __ATOMIC_RELAXED) / 1000.0;
+	stats->logindexLimit = pageVersionHashMap != NULL ?
+		__atomic_load_n(&pageVersionHashMap->memoryLimit, __ATOMIC_RELAXED) : 0;
+	for (int a = 0; a < MEM_ACTIONS; a++)
+		stats->actions[a] = __atomic_load_n(&mem_actions[a], __ATOMIC_RELAXED);
+}
+
+static void
+mem_set_cache_permille(int permille)
+{
+	KvSetBlockCacheCapacity((size_t) ((double) block_cache_size * permille / 1000));
+	KvPageCacheSetLimit((int) ((int64) page_cache_blocks * permille / 1000));
+	__atomic_store_n(&cache_permille, permille, __ATOMIC_RELAXED);
+}
+
+static void
+mem_count(MemAction action)
+{
+	__atomic_fetch_add(&mem_actions[action], 1, __ATOMIC_RELAXED);
+}
+
+static void
+mem_push_back(const MemGovernorStats *stats)
+{
+	uint64		excess = stats->total - mem_limit;
+	uint64		logindex = stats->bytes[MEM_LOGINDEX];
+	uint64		target;
+
+	if (stats->bytes[MEM_MEMTABLES] >= MEM_GOVERNOR_MIN_FLUSH &&
+		KvFlushLargestMemtable(MEM_GOVERNOR_MIN_FLUSH) >= 0)
+	{
+		mem_count(MEM_ACTION_FLUSH);
+		return;
+	}
+
+	if (cache_permille > MEM_GOVERNOR_MIN_CACHE_PERMILLE &&
+		stats->bytes[MEM_BLOCK_CACHE] + stats->bytes[MEM_PAGE_CACHE] > 0)
+	{
+		mem_set_cache_permille(Max(cache_permille * 3 / 4, MEM_GOVERNOR_MIN_CACHE_PERMILLE));
+		mem_count(MEM_ACTION_SHRINK);
+		return;
+	}
+
+	if (pageVersionHashMap == NULL)
+		return;
+	target = Max(logindex > excess ? logindex - excess : 0, MEM_GOVERNOR_LOGINDEX_FLOOR);
+	if (logindex_configured > 0)
+		target = Min(target, logindex_configured);
+	if (stats->logindexLimit == 0 || target < stats->logindexLimit)
+	{
+		HashMapSetMemoryLimit(pageVersionHashMap, target);
+		mem_count(MEM_ACTION_SPILL);
+	}
+}
+
+static void
+mem_relax(const MemGovernorStats *stats)
+{
+	uint64		headroom = mem_limit / 100 * MEM_GOVERNOR_RELAX_PCT - stats->total;
+	uint64		target;
+
+	if (cache_permille < 1000)
+	{
+		mem_set_cache_permille(Min(cache_permille * 5 / 4 + 1, 1000));
+		return;
+	}
+
+	/* The logindex limit is the governor's until it is back where it was */
+	if (pageVersionHashMap == NULL || stats->logindexLimit == logindex_configured)
+		return;
+	target = stats->logindexLimit + headroom / 2;
+	if (logindex_configured > 0 && target >= logindex_configured)
+		target = logindex_configured;
+	else if (logindex_configured == 0 && target >= mem_limit)
+		target = 0;
+	HashMapSetMemoryLimit(pageVersionHashMap, target);
+}
+
+static void *
+mem_governor_main(void *arg)
+{
+	MemGovernorStats stats;
+
+	for (;;)
+	{
+		usleep(MEM_GOVERNOR_TICK_US);
+		MemGovernorRead(&stats);
+		if (stats.total > mem_limit)
+			mem_push_back(&stats);
+		else if (stats.total < mem_limit / 100 * MEM_GOVERNOR_RELAX_PCT)
+			mem_relax(&stats);
+	}
+	return NULL;
+}
+
+void
+MemGovernorStart(void)
+{
+	const char *limit = getenv("STORAGE_MEMORY_LIMIT_MB");
+	pthread_t	tid;
+	int			ret;
+
+	if (limit == NULL || atol(limit) <= 0)
+		return;
+
+	mem_limit = (uint64) atol(limit) << 20;
+	block_cache_size = KvBlockCacheCapacity();
+	page_cache_blocks = kv_page_cache_size;
+	if (pageVersionHashMap != NULL)
+		logindex_configured = pageVersionHashMap->memoryLimit;
+
+	ret = pthread_create(&tid, NULL, mem_governor_main, NULL);
+	if (ret != 0)
+	{
+		ereport(WARNING,
+				(errmsg("could not start the memory governor: %s", strerror(ret))));
+		return;
+	}
+	pthread_detach(tid);
+	ereport(LOG,
+			(errmsg("storage node memory limit = " UINT64_FORMAT " MB", mem_limit >> 20)));
+}
@@ -1,10 +1,11 @@
 //#include "c.h"
 #include <stdio.h>
 #include <iostream>
+#include <sched.h>
 #include "postgres.h"
+#include "common/hashfn.h"
 #include "storage/builtin_shmht.h"
 #include "storage/shmem.h"
-#include "utils/hsearch.h"
 //#include "miscadmin.h"
 //#include "port/atomics.h"
 //#include "storage/buf.h"
@@ -15,70 +16,118 @@
 //#include "storage/spin.h"
 //#include "utils/relcache.h"
 
-static HTAB* SharedRelSizeHash;
+//! Open addressing over a fixed array in shared memory, so that the compute
+//! node processes and the storage node's rpc threads can all use it without
+//! a lock. A slot is claimed once for a tag and never given back: its tag is
+//! written before the slot turns USED, after which it doesn't change. The
+//! size is one atomic word, REL_SIZE_ABSENT while nothing is cached and
+//! REL_SIZE_MISSING once the fork is known not to exist.
+//!
+//! forgetLsn is the LSN of the last forget. An answer of the storage node
+//! asked for at an LSN not above it may predate the forget, so it isn't
+//! cached, see RelSizeTableInsertLease.
+#define REL_SIZE_TABLE_SLOTS (REL_SIZE_ESTIMATE_SIZE * 2)
+#define REL_SIZE_ABSENT (0xFFFFFFFFu)
+#define REL_SIZE_MISSING (0xFFFFFFFEu)
+
+#define REL_SIZE_UNKNOWN(size) ((size) == REL_SIZE_ABSENT || (size) == REL_SIZE_MISSING)
+
+#define REL_SIZE_SLOT_FREE (0)
+#define REL_SIZE_SLOT_CLAIMED (1)
+#define REL_SIZE_SLOT_USED (2)
+
+typedef struct RelSizeSlot {
+    uint32 state;
+    uint32 hash;
+    RelTag tag;
+    uint32 size;
+    uint64 forgetLsn;
+} RelSizeSlot;
+
+static RelSizeSlot *relSizeSlots;
 
 Size RelSizeTableShmemSize() {
-//    std::cout << __func__  << ", " << __LINE__ << std::endl;
-//    fflush(stdout);
-    return hash_estimate_size(REL_SIZE_ESTIMATE_SIZE, sizeof(RelSizeLookupEntry));
+    return mul_size(REL_SIZE_TABLE_SLOTS, sizeof(RelSizeSlot));
 }
 
 void
 InitRelSizeTable()
 {
-//    std::cout << __func__  << ", " << __LINE__ << std::endl;
-//    fflush(stdout);
-    HASHCTL		info;
-
-    MemSet(&info, 0, sizeof(info));
-    /* assume no locking is needed yet */
-
-    /* BufferTag maps to Buffer */
-    info.keysize = sizeof(RelTag);
-    info.entrysize = sizeof(RelSizeLookupEntry);
-    info.num_partitions = REL_SIZE_PARTITION_NUM;
-
-    SharedRelSizeHash = ShmemInitHash("Shared Relation Size Table",
-                                  REL_SIZE_ESTIMATE_SIZE/8, REL_SIZE_ESTIMATE_SIZE/8,
-                                  &info,
-                                  HASH_ELEM | HASH_BLOBS | HASH_PARTITION);
+    bool found;
+
+    relSizeSlots = (RelSizeSlot *) ShmemInitStruct("Shared Relation Size Table", RelSizeTableShmemSize(), &found);
+    if (!found)
+        memset(relSizeSlots, 0, RelSizeTableShmemSize());
 }
 
 uint32
 RelSizeTableHashCode(RelTag *tagPtr)
 {
-    return get_hash_value(SharedRelSizeHash, (void *) tagPtr);
+    return hash_bytes((const unsigned char *) tagPtr, sizeof(RelTag));
+}
+
+// The slot of the tag, claimed for it if create is set. NULL if it has none,
+// or if the table is full
+static RelSizeSlot *
+RelSizeTableFindSlot(RelTag *tagPtr, uint32 hashcode, bool create)
+{
+    uint32 pos = hashcode % REL_SIZE_TABLE_SLOTS;
+
+    for (int probe = 0; probe < REL_SIZE_TABLE_SLOTS; probe++, pos = (pos + 1) % REL_SIZE_TABLE_SLOTS) {
+        RelSizeSlot *slot = &relSizeSlots[pos];
+        uint32 state = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+
+        if (state == REL_SIZE_SLOT_FREE) {
+            if (!create)
+                return NULL;
+            if (__atomic_compare_exchange_n(&slot->state, &state, REL_SIZE_SLOT_CLAIMED, false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                slot->hash = hashcode;
+                slot->tag = *tagPtr;
+                __atomic_store_n(&slot->size, REL_SIZE_ABSENT, __ATOMIC_RELAXED);
+                __atomic_store_n(&slot->forgetLsn, 0, __ATOMIC_RELAXED);
+                __atomic_store_n(&slot->state, REL_SIZE_SLOT_USED, __ATOMIC_RELEASE);
+                return slot;
+            }
+        }
+        // Claimed by someone else a moment ago, its tag follows at once
+        while (state == REL_SIZE_SLOT_CLAIMED) {
+            sched_yield();
+            state = __atomic_load_n(&slot->state, __ATOMIC_ACQUIRE);
+        }
+        if (slot->hash == hashcode && RelFileNodeEquals(slot->tag.reln, tagPtr->reln)
+            && slot->tag.forkNumber == tagPtr->forkNumber)
+            return slot;
+    }
+    return NULL;
 }
 
 int
 RelSizeTableLookup(RelTag *tagPtr, uint32 hashcode)
 {
-    RelSizeLookupEntry *result;
-
-//    std::cout << __func__ << " " << __LINE__ << ", lookup: " << tagPtr->reln.spcNode << "_" << tagPtr->reln.dbNode
-//    << "_" << tagPtr->reln.relNode << "_" << tagPtr->forkNumber << std::endl;
-//    printf("%s %d, lookup: %lu_%lu_%lu_%d\n", __func__ , __LINE__, tagPtr->reln.spcNode, tagPtr->reln.dbNode,
-//           tagPtr->reln.relNode, tagPtr->forkNumber);
-//    fflush(stdout);
-    result = (RelSizeLookupEntry *)
-            hash_search_with_hash_value(SharedRelSizeHash,
-                                        (void *) tagPtr,
-                                        hashcode,
-                                        HASH_FIND,
-                                        NULL);
-
-//    if(result)
-//        std::cout << __func__ << " " << __LINE__ << ", lookup: " << tagPtr->reln.spcNode << "_" << tagPtr->reln.dbNode
-//                  << "_" << tagPtr->reln.relNode << "_" << tagPtr->forkNumber << " result=" << result->relSize << std::endl;
-//    else
-//        std::cout << __func__ << " " << __LINE__ << ", lookup: " << tagPtr->reln.spcNode << "_" << tagPtr->reln.dbNode
-//                  << "_" << tagPtr->reln.relNode << "_" << tagPtr->forkNumber << " result=NULL" << std::endl;
-//    fflush(stdout);
-
-    if (!result)
+    RelSizeSlot *slot = RelSizeTableFindSlot(tagPtr, hashcode, false);
+    uint32 size;
+
+    if (slot == NULL)
+        return -1;
+    size = __atomic_load_n(&slot->size, __ATOMIC_ACQUIRE);
+    if (REL_SIZE_UNKNOWN(size))
         return -1;
+    return (int) size;
+}
 
-    return result->relSize;
+int
+RelSizeTableLookupExists(RelTag *tagPtr, uint32 hashcode)
+{
+    RelSizeSlot *slot = RelSizeTableFindSlot(tagPtr, hashcode, false);
+    uint32 size;
+
+    if (slot == NULL)
+        return -1;
+    size = __atomic_load_n(&slot->size, __ATOMIC_ACQUIRE);
+    if (size == REL_SIZE_ABSENT)
+        return -1;
+    return size != REL_SIZE_MISSING;
 }
 
 // Return -1 on successfully insertion
@@ -86,44 +135,96 @@ RelSizeTableLookup(RelTag *tagPtr, uint32 hashcode)
 int
 RelSizeTableInsert(RelTag *tagPtr, uint32 hashcode, int relSize)
 {
-//    std::cout<< __func__  << " " << __LINE__ << " " << tagPtr->reln.spcNode << " " <<
-//    tagPtr->reln.dbNode << " " << tagPtr->reln.relNode << " " << tagPtr->forkNumber << " relSize=" << relSize << std::endl;
-//    fflush(stdout);
-    RelSizeLookupEntry *result;
-    bool		found;
-
-    result = (RelSizeLookupEntry *)
-            hash_search_with_hash_value(SharedRelSizeHash,
-                                        (void *) tagPtr,
-                                        hashcode,
-                                        HASH_ENTER,
-                                        &found);
-
-//    std::cout<< __func__  << " " << __LINE__ << std::endl;
-//    fflush(stdout);
-    if (found)					/* found something already in the table */
-    {
-        result->relSize = relSize;
-        return result->relSize;
+    RelSizeSlot *slot = RelSizeTableFindSlot(tagPtr, hashcode, true);
+    uint32 old;
+
+    if (slot == NULL)
+        return -1;
+    old = __atomic_exchange_n(&slot->size, (uint32) relSize, __ATOMIC_ACQ_REL);
+    if (REL_SIZE_UNKNOWN(old))
+        return -1;
+    return relSize;
+}
+
+bool
+RelSizeTableInsertIfAbsent(RelTag *tagPtr, uint32 hashcode, int relSize)
+{
+    RelSizeSlot *slot = RelSizeTableFindSlot(tagPtr, hashcode, true);
+    uint32 expected = REL_SIZE_ABSENT;
+
+    if (slot == NULL)
+        return false;
+    // A fork known missing has been created meanwhile
+    while (REL_SIZE_UNKNOWN(expected)) {
+        if (__atomic_compare_exchange_n(&slot->size, &expected, (uint32) relSize, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            return true;
+    }
+    return false;
+}
+
+bool
+RelSizeTableInsertLease(RelTag *tagPtr, uint32 hashcode, int relSize, uint64 lsn)
+{
+    RelSizeSlot *slot = RelSizeTableFindSlot(tagPtr, hashcode, true);
+    uint32 expected = REL_SIZE_ABSENT;
+    uint32 value = relSize < 0 ? REL_SIZE_MISSING : (uint32) relSize;
+
+    if (slot == NULL)
+        return false;
+    if (!__atomic_compare_exchange_n(&slot->size, &expected, value, false,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+        return false;
+    // A forget racing with the answer either shows its LSN here, or stores
+    // ABSENT after our value
+    if (__atomic_load_n(&slot->forgetLsn, __ATOMIC_SEQ_CST) >= lsn) {
+        __atomic_compare_exchange_n(&slot->size, &value, REL_SIZE_ABSENT, false,
+                                    __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        return false;
     }
+    return true;
+}
 
-    result->relSize = relSize;
+void
+RelSizeTableForget(RelTag *tagPtr, uint32 hashcode, uint64 lsn)
+{
+    RelSizeSlot *slot = RelSizeTableFindSlot(tagPtr, hashcode, true);
+    uint64 current;
+
+    if (slot == NULL)
+        return;
+    current = __atomic_load_n(&slot->forgetLsn, __ATOMIC_SEQ_CST);
+    while (current < lsn) {
+        if (__atomic_compare_exchange_n(&slot->forgetLsn, &current, lsn, false,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+            break;
+    }
+    __atomic_store_n(&slot->size, REL_SIZE_ABSENT, __ATOMIC_SEQ_CST);
+}
 
-    return -1;
+void
+RelSizeTableExtend(RelTag *tagPtr, uint32 hashcode, int relSize)
+{
+    RelSizeSlot *slot = RelSizeTableFindSlot(tagPtr, hashcode, true);
+    uint32 current;
+
+    if (slot == NULL)
+        return;
+    current = __atomic_load_n(&slot->size, __ATOMIC_ACQUIRE);
+    while (REL_SIZE_UNKNOWN(current) || current < (uint32) relSize) {
+        if (__atomic_compare_exchange_n(&slot->size, &current, (uint32) relSize, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            break;
+    }
 }
 
 void
 RelSizeTableDelete(RelTag *tagPtr, uint32 hashcode)
 {
-    RelSizeLookupEntry *result;
+    RelSizeSlot *slot = RelSizeTableFindSlot(tagPtr, hashcode, false);
 
-    result = (RelSizeLookupEntry *)
-            hash_search_with_hash_value(SharedRelSizeHash,
-                                        (void *) tagPtr,
-                                        hashcode,
-                                        HASH_REMOVE,
-                                        NULL);
-
-    if (!result)				/* shouldn't happen */
+    if (!slot)				/* shouldn't happen */
         elog(ERROR, "shared relation size hash table corrupted");
-}
\ No newline at end of file
+    // The slot stays with the tag
+    __atomic_store_n(&slot->size, REL_SIZE_ABSENT, __ATOMIC_RELEASE);
+}
@@ -23,15 +23,14 @@ static void ParseRelKey2String(RelKey relKey, char* tempKey) {
 //    fflush(stdout);
 }
 
+void ParseRelKey2RelTag(RelKey relKey, RelTag *relTag);
+
+// The whole tag, so unrelated relations rarely share a lock
 static uint32_t HashRelKey(RelKey key) {
-//    return tag_hash((void*) &key, sizeof(KeyType));
-    uint32_t res = 0;
-    res += (key.SpcId&0xFF) * 13 + 7;
-    res += (key.DbId&0xFF) * 17 + 5;
-    res += (key.RelId&0xFF) * 11 + 7;
-    res += (key.forkNum&0xFF) * 3 + 29;
+    RelTag tag;
 
-    return res;
+    ParseRelKey2RelTag(key, &tag);
+    return RelSizeTableHashCode(&tag);
 }
 
 
@@ -93,6 +92,41 @@ void InsertRelSizeCache(RelKey relKey, uint32_t blockNum) {
 //    }
 }
 
+void ExtendRelSizeCache(RelKey relKey, uint32_t blockNum) {
+    RelTag tag;
+
+    ParseRelKey2RelTag(relKey, &tag);
+    RelSizeTableExtend(&tag, RelSizeTableHashCode(&tag), (int) blockNum);
+}
+
+bool InsertRelSizeCacheIfAbsent(RelKey relKey, uint32_t blockNum) {
+    RelTag tag;
+
+    ParseRelKey2RelTag(relKey, &tag);
+    return RelSizeTableInsertIfAbsent(&tag, RelSizeTableHashCode(&tag), (int) blockNum);
+}
+
+bool InsertRelSizeLease(RelKey relKey, int32_t blockNum, uint64_t lsn) {
+    RelTag tag;
+
+    ParseRelKey2RelTag(relKey, &tag);
+    return RelSizeTableInsertLease(&tag, RelSizeTableHashCode(&tag), blockNum, lsn);
+}
+
+void ForgetRelSizeCache(RelKey relKey, uint64_t lsn) {
+    RelTag tag;
+
+    ParseRelKey2RelTag(relKey, &tag);
+    RelSizeTableForget(&tag, RelSizeTableHashCode(&tag), lsn);
+}
+
+int GetRelExistsCache(RelKey relKey) {
+    RelTag tag;
+
+    ParseRelKey2RelTag(relKey, &tag);
+    return RelSizeTableLookupExists(&tag, RelSizeTableHashCode(&tag));
+}
+
 bool GetRelSizeCache(RelKey relKey, uint32_t *result) {
 //    char tempKey[MAX_PATH_LEN];
 //    snprintf(tempKey, sizeof(tempKey), REL_SIZE_CACHE_KEY,
@@ -82,6 +82,14 @@ uint32_t DataPageAccess_ReadBufferCommon_args::read(::apache::thrift::protocol::
           xfer += iprot->skip(ftype);
         }
         break;
+      case 7:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_traceId);
+          this->__isset._traceId = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
       default:
         xfer += iprot->skip(ftype);
         break;
@@ -123,6 +131,10 @@ uint32_t DataPageAccess_ReadBufferCommon_args::write(::apache::thrift::protocol:
   xfer += oprot->writeI64(this->_lsn);
   xfer += oprot->writeFieldEnd();
 
+  xfer += oprot->writeFieldBegin("_traceId", ::apache::thrift::protocol::T_I64, 7);
+  xfer += oprot->writeI64(this->_traceId);
+  xfer += oprot->writeFieldEnd();
+
   xfer += oprot->writeFieldStop();
   xfer += oprot->writeStructEnd();
   return xfer;
@@ -162,6 +174,10 @@ uint32_t DataPageAccess_ReadBufferCommon_pargs::write(::apache::thrift::protocol
   xfer += oprot->writeI64((*(this->_lsn)));
   xfer += oprot->writeFieldEnd();
 
+  xfer += oprot->writeFieldBegin("_traceId", ::apache::thrift::protocol::T_I64, 7);
+  xfer += oprot->writeI64((*(this->_traceId)));
+  xfer += oprot->writeFieldEnd();
+
   xfer += oprot->writeFieldStop();
   xfer += oprot->writeStructEnd();
   return xfer;
@@ -1531,6 +1547,9 @@ uint32_t DataPageAccess_RpcMdCreate_presult::read(::apache::thrift::protocol::TP
 DataPageAccess_RpcMdExtend_args::~DataPageAccess_RpcMdExtend_args() noexcept {
 }
 
+DataPageAccess_RpcMdExtendMany_args::~DataPageAccess_RpcMdExtendMany_args() noexcept {
+}
+
 
 uint32_t DataPageAccess_RpcMdExtend_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
@@ -1613,6 +1632,87 @@ uint32_t DataPageAccess_RpcMdExtend_args::read(::apache::thrift::protocol::TProt
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcMdExtendMany_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->_reln.read(iprot);
+          this->__isset._reln = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_forknum);
+          this->__isset._forknum = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_startblk);
+          this->__isset._startblk = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_nblocks);
+          this->__isset._nblocks = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 5:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->skipFsync);
+          this->__isset.skipFsync = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 6:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
 uint32_t DataPageAccess_RpcMdExtend_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
   uint32_t xfer = 0;
   ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
@@ -1647,10 +1747,47 @@ uint32_t DataPageAccess_RpcMdExtend_args::write(::apache::thrift::protocol::TPro
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcMdExtendMany_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcMdExtendMany_args");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += this->_reln.write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_forknum);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_startblk", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_startblk);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_nblocks", ::apache::thrift::protocol::T_I32, 4);
+  xfer += oprot->writeI32(this->_nblocks);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("skipFsync", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32(this->skipFsync);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
 
 DataPageAccess_RpcMdExtend_pargs::~DataPageAccess_RpcMdExtend_pargs() noexcept {
 }
 
+DataPageAccess_RpcMdExtendMany_pargs::~DataPageAccess_RpcMdExtendMany_pargs() noexcept {
+}
+
 
 uint32_t DataPageAccess_RpcMdExtend_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
   uint32_t xfer = 0;
@@ -1686,10 +1823,47 @@ uint32_t DataPageAccess_RpcMdExtend_pargs::write(::apache::thrift::protocol::TPr
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcMdExtendMany_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcMdExtendMany_pargs");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += (*(this->_reln)).write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_forknum)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_startblk", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_startblk)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_nblocks", ::apache::thrift::protocol::T_I32, 4);
+  xfer += oprot->writeI32((*(this->_nblocks)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("skipFsync", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32((*(this->skipFsync)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
 
 DataPageAccess_RpcMdExtend_result::~DataPageAccess_RpcMdExtend_result() noexcept {
 }
 
+DataPageAccess_RpcMdExtendMany_result::~DataPageAccess_RpcMdExtendMany_result() noexcept {
+}
+
 
 uint32_t DataPageAccess_RpcMdExtend_result::read(::apache::thrift::protocol::TProtocol* iprot) {
 
@@ -1719,6 +1893,34 @@ uint32_t DataPageAccess_RpcMdExtend_result::read(::apache::thrift::protocol::TPr
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcMdExtendMany_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    xfer += iprot->skip(ftype);
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
 uint32_t DataPageAccess_RpcMdExtend_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
 
   uint32_t xfer = 0;
@@ -1730,10 +1932,24 @@ uint32_t DataPageAccess_RpcMdExtend_result::write(::apache::thrift::protocol::TP
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcMdExtendMany_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcMdExtendMany_result");
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
 
 DataPageAccess_RpcMdExtend_presult::~DataPageAccess_RpcMdExtend_presult() noexcept {
 }
 
+DataPageAccess_RpcMdExtendMany_presult::~DataPageAccess_RpcMdExtendMany_presult() noexcept {
+}
+
 
 uint32_t DataPageAccess_RpcMdExtend_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
 
@@ -1763,6 +1979,34 @@ uint32_t DataPageAccess_RpcMdExtend_presult::read(::apache::thrift::protocol::TP
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcMdExtendMany_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    xfer += iprot->skip(ftype);
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
 
 DataPageAccess_RpcTruncate_args::~DataPageAccess_RpcTruncate_args() noexcept {
 }
@@ -4410,6 +4654,9 @@ uint32_t DataPageAccess_RpcFtruncate_presult::read(::apache::thrift::protocol::T
 DataPageAccess_RpcInitFile_args::~DataPageAccess_RpcInitFile_args() noexcept {
 }
 
+DataPageAccess_RpcOpenAndReadFile_args::~DataPageAccess_RpcOpenAndReadFile_args() noexcept {
+}
+
 
 uint32_t DataPageAccess_RpcInitFile_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
@@ -4452,45 +4699,7 @@ uint32_t DataPageAccess_RpcInitFile_args::read(::apache::thrift::protocol::TProt
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcInitFile_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
-  uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcInitFile_args");
-
-  xfer += oprot->writeFieldBegin("_path", ::apache::thrift::protocol::T_STRING, 1);
-  xfer += oprot->writeBinary(this->_path);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
-
-
-DataPageAccess_RpcInitFile_pargs::~DataPageAccess_RpcInitFile_pargs() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcInitFile_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
-  uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcInitFile_pargs");
-
-  xfer += oprot->writeFieldBegin("_path", ::apache::thrift::protocol::T_STRING, 1);
-  xfer += oprot->writeBinary((*(this->_path)));
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
-
-
-DataPageAccess_RpcInitFile_result::~DataPageAccess_RpcInitFile_result() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcInitFile_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcOpenAndReadFile_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -4511,7 +4720,209 @@ uint32_t DataPageAccess_RpcInitFile_result::read(::apache::thrift::protocol::TPr
     }
     switch (fid)
     {
-      case 0:
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->_path);
+          this->__isset._path = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_flags);
+          this->__isset._flags = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_amount);
+          this->__isset._amount = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_transient);
+          this->__isset._transient = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcInitFile_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcInitFile_args");
+
+  xfer += oprot->writeFieldBegin("_path", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary(this->_path);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcOpenAndReadFile_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcOpenAndReadFile_args");
+
+  xfer += oprot->writeFieldBegin("_path", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary(this->_path);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_flags", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_flags);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_amount", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_amount);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_transient", ::apache::thrift::protocol::T_I32, 4);
+  xfer += oprot->writeI32(this->_transient);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcInitFile_pargs::~DataPageAccess_RpcInitFile_pargs() noexcept {
+}
+
+DataPageAccess_RpcOpenAndReadFile_pargs::~DataPageAccess_RpcOpenAndReadFile_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcInitFile_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcInitFile_pargs");
+
+  xfer += oprot->writeFieldBegin("_path", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary((*(this->_path)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcOpenAndReadFile_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcOpenAndReadFile_pargs");
+
+  xfer += oprot->writeFieldBegin("_path", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary((*(this->_path)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_flags", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_flags)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_amount", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_amount)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_transient", ::apache::thrift::protocol::T_I32, 4);
+  xfer += oprot->writeI32((*(this->_transient)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcInitFile_result::~DataPageAccess_RpcInitFile_result() noexcept {
+}
+
+DataPageAccess_RpcOpenAndReadFile_result::~DataPageAccess_RpcOpenAndReadFile_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcInitFile_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcOpenAndReadFile_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
         if (ftype == ::apache::thrift::protocol::T_STRING) {
           xfer += iprot->readBinary(this->success);
           this->__isset.success = true;
@@ -4547,10 +4958,29 @@ uint32_t DataPageAccess_RpcInitFile_result::write(::apache::thrift::protocol::TP
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcOpenAndReadFile_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcOpenAndReadFile_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_STRING, 0);
+    xfer += oprot->writeBinary(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
 
 DataPageAccess_RpcInitFile_presult::~DataPageAccess_RpcInitFile_presult() noexcept {
 }
 
+DataPageAccess_RpcOpenAndReadFile_presult::~DataPageAccess_RpcOpenAndReadFile_presult() noexcept {
+}
+
 
 uint32_t DataPageAccess_RpcInitFile_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
 
@@ -4593,6 +5023,47 @@ uint32_t DataPageAccess_RpcInitFile_presult::read(::apache::thrift::protocol::TP
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcOpenAndReadFile_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
 
 DataPageAccess_RpcOpenTransientFile_args::~DataPageAccess_RpcOpenTransientFile_args() noexcept {
 }
@@ -7642,6 +8113,15 @@ uint32_t DataPageAccess_RpcStat_presult::read(::apache::thrift::protocol::TProto
 DataPageAccess_RpcDirectoryIsEmpty_args::~DataPageAccess_RpcDirectoryIsEmpty_args() noexcept {
 }
 
+DataPageAccess_RpcSyncFiles_args::~DataPageAccess_RpcSyncFiles_args() noexcept {
+}
+
+DataPageAccess_RpcAttachSharedMemory_args::~DataPageAccess_RpcAttachSharedMemory_args() noexcept {
+}
+
+DataPageAccess_RpcPublishResidentPages_args::~DataPageAccess_RpcPublishResidentPages_args() noexcept {
+}
+
 
 uint32_t DataPageAccess_RpcDirectoryIsEmpty_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
@@ -7684,45 +8164,7 @@ uint32_t DataPageAccess_RpcDirectoryIsEmpty_args::read(::apache::thrift::protoco
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcDirectoryIsEmpty_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
-  uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcDirectoryIsEmpty_args");
-
-  xfer += oprot->writeFieldBegin("_path", ::apache::thrift::protocol::T_STRING, 1);
-  xfer += oprot->writeBinary(this->_path);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
-
-
-DataPageAccess_RpcDirectoryIsEmpty_pargs::~DataPageAccess_RpcDirectoryIsEmpty_pargs() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcDirectoryIsEmpty_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
-  uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcDirectoryIsEmpty_pargs");
-
-  xfer += oprot->writeFieldBegin("_path", ::apache::thrift::protocol::T_STRING, 1);
-  xfer += oprot->writeBinary((*(this->_path)));
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
-
-
-DataPageAccess_RpcDirectoryIsEmpty_result::~DataPageAccess_RpcDirectoryIsEmpty_result() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcDirectoryIsEmpty_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcSyncFiles_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -7743,10 +8185,22 @@ uint32_t DataPageAccess_RpcDirectoryIsEmpty_result::read(::apache::thrift::proto
     }
     switch (fid)
     {
-      case 0:
-        if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->success);
-          this->__isset.success = true;
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->_paths.clear();
+            uint32_t _size30;
+            ::apache::thrift::protocol::TType _etype33;
+            xfer += iprot->readListBegin(_etype33, _size30);
+            this->_paths.resize(_size30);
+            uint32_t _i34;
+            for (_i34 = 0; _i34 < _size30; ++_i34)
+            {
+              xfer += iprot->readBinary(this->_paths[_i34]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset._paths = true;
         } else {
           xfer += iprot->skip(ftype);
         }
@@ -7763,28 +8217,7 @@ uint32_t DataPageAccess_RpcDirectoryIsEmpty_result::read(::apache::thrift::proto
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcDirectoryIsEmpty_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
-
-  uint32_t xfer = 0;
-
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcDirectoryIsEmpty_result");
-
-  if (this->__isset.success) {
-    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
-    xfer += oprot->writeI32(this->success);
-    xfer += oprot->writeFieldEnd();
-  }
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
-
-
-DataPageAccess_RpcDirectoryIsEmpty_presult::~DataPageAccess_RpcDirectoryIsEmpty_presult() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcDirectoryIsEmpty_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcAttachSharedMemory_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -7805,10 +8238,10 @@ uint32_t DataPageAccess_RpcDirectoryIsEmpty_presult::read(::apache::thrift::prot
     }
     switch (fid)
     {
-      case 0:
-        if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32((*(this->success)));
-          this->__isset.success = true;
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->_name);
+          this->__isset._name = true;
         } else {
           xfer += iprot->skip(ftype);
         }
@@ -7825,12 +8258,7 @@ uint32_t DataPageAccess_RpcDirectoryIsEmpty_presult::read(::apache::thrift::prot
   return xfer;
 }
 
-
-DataPageAccess_RpcCopyDir_args::~DataPageAccess_RpcCopyDir_args() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcCopyDir_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcPublishResidentPages_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -7853,16 +8281,8 @@ uint32_t DataPageAccess_RpcCopyDir_args::read(::apache::thrift::protocol::TProto
     {
       case 1:
         if (ftype == ::apache::thrift::protocol::T_STRING) {
-          xfer += iprot->readBinary(this->_src);
-          this->__isset._src = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      case 2:
-        if (ftype == ::apache::thrift::protocol::T_STRING) {
-          xfer += iprot->readBinary(this->_dst);
-          this->__isset._dst = true;
+          xfer += iprot->readBinary(this->_summary);
+          this->__isset._summary = true;
         } else {
           xfer += iprot->skip(ftype);
         }
@@ -7879,17 +8299,35 @@ uint32_t DataPageAccess_RpcCopyDir_args::read(::apache::thrift::protocol::TProto
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcCopyDir_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+uint32_t DataPageAccess_RpcDirectoryIsEmpty_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
   uint32_t xfer = 0;
   ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcCopyDir_args");
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcDirectoryIsEmpty_args");
 
-  xfer += oprot->writeFieldBegin("_src", ::apache::thrift::protocol::T_STRING, 1);
-  xfer += oprot->writeBinary(this->_src);
+  xfer += oprot->writeFieldBegin("_path", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary(this->_path);
   xfer += oprot->writeFieldEnd();
 
-  xfer += oprot->writeFieldBegin("_dst", ::apache::thrift::protocol::T_STRING, 2);
-  xfer += oprot->writeBinary(this->_dst);
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcSyncFiles_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSyncFiles_args");
+
+  xfer += oprot->writeFieldBegin("_paths", ::apache::thrift::protocol::T_LIST, 1);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRING, static_cast<uint32_t>(this->_paths.size()));
+    std::vector<_Path> ::const_iterator _iter35;
+    for (_iter35 = this->_paths.begin(); _iter35 != this->_paths.end(); ++_iter35)
+    {
+      xfer += oprot->writeBinary((*_iter35));
+    }
+    xfer += oprot->writeListEnd();
+  }
   xfer += oprot->writeFieldEnd();
 
   xfer += oprot->writeFieldStop();
@@ -7897,22 +8335,77 @@ uint32_t DataPageAccess_RpcCopyDir_args::write(::apache::thrift::protocol::TProt
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcAttachSharedMemory_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcAttachSharedMemory_args");
 
-DataPageAccess_RpcCopyDir_pargs::~DataPageAccess_RpcCopyDir_pargs() noexcept {
+  xfer += oprot->writeFieldBegin("_name", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary(this->_name);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
 }
 
+uint32_t DataPageAccess_RpcPublishResidentPages_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcPublishResidentPages_args");
 
-uint32_t DataPageAccess_RpcCopyDir_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  xfer += oprot->writeFieldBegin("_summary", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary(this->_summary);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcDirectoryIsEmpty_pargs::~DataPageAccess_RpcDirectoryIsEmpty_pargs() noexcept {
+}
+
+DataPageAccess_RpcSyncFiles_pargs::~DataPageAccess_RpcSyncFiles_pargs() noexcept {
+}
+
+DataPageAccess_RpcAttachSharedMemory_pargs::~DataPageAccess_RpcAttachSharedMemory_pargs() noexcept {
+}
+
+DataPageAccess_RpcPublishResidentPages_pargs::~DataPageAccess_RpcPublishResidentPages_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcDirectoryIsEmpty_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
   uint32_t xfer = 0;
   ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcCopyDir_pargs");
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcDirectoryIsEmpty_pargs");
 
-  xfer += oprot->writeFieldBegin("_src", ::apache::thrift::protocol::T_STRING, 1);
-  xfer += oprot->writeBinary((*(this->_src)));
+  xfer += oprot->writeFieldBegin("_path", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary((*(this->_path)));
   xfer += oprot->writeFieldEnd();
 
-  xfer += oprot->writeFieldBegin("_dst", ::apache::thrift::protocol::T_STRING, 2);
-  xfer += oprot->writeBinary((*(this->_dst)));
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcSyncFiles_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSyncFiles_pargs");
+
+  xfer += oprot->writeFieldBegin("_paths", ::apache::thrift::protocol::T_LIST, 1);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRING, static_cast<uint32_t>((*(this->_paths)).size()));
+    std::vector<_Path> ::const_iterator _iter36;
+    for (_iter36 = (*(this->_paths)).begin(); _iter36 != (*(this->_paths)).end(); ++_iter36)
+    {
+      xfer += oprot->writeBinary((*_iter36));
+    }
+    xfer += oprot->writeListEnd();
+  }
   xfer += oprot->writeFieldEnd();
 
   xfer += oprot->writeFieldStop();
@@ -7920,12 +8413,49 @@ uint32_t DataPageAccess_RpcCopyDir_pargs::write(::apache::thrift::protocol::TPro
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcAttachSharedMemory_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcAttachSharedMemory_pargs");
+
+  xfer += oprot->writeFieldBegin("_name", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary((*(this->_name)));
+  xfer += oprot->writeFieldEnd();
 
-DataPageAccess_RpcCopyDir_result::~DataPageAccess_RpcCopyDir_result() noexcept {
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
 }
 
+uint32_t DataPageAccess_RpcPublishResidentPages_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcPublishResidentPages_pargs");
+
+  xfer += oprot->writeFieldBegin("_summary", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary((*(this->_summary)));
+  xfer += oprot->writeFieldEnd();
 
-uint32_t DataPageAccess_RpcCopyDir_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcDirectoryIsEmpty_result::~DataPageAccess_RpcDirectoryIsEmpty_result() noexcept {
+}
+
+DataPageAccess_RpcSyncFiles_result::~DataPageAccess_RpcSyncFiles_result() noexcept {
+}
+
+DataPageAccess_RpcAttachSharedMemory_result::~DataPageAccess_RpcAttachSharedMemory_result() noexcept {
+}
+
+DataPageAccess_RpcPublishResidentPages_result::~DataPageAccess_RpcPublishResidentPages_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcDirectoryIsEmpty_result::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -7966,28 +8496,48 @@ uint32_t DataPageAccess_RpcCopyDir_result::read(::apache::thrift::protocol::TPro
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcCopyDir_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+uint32_t DataPageAccess_RpcSyncFiles_result::read(::apache::thrift::protocol::TProtocol* iprot) {
 
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcCopyDir_result");
+  xfer += iprot->readStructBegin(fname);
 
-  if (this->__isset.success) {
-    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
-    xfer += oprot->writeI32(this->success);
-    xfer += oprot->writeFieldEnd();
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
   }
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
 
+  xfer += iprot->readStructEnd();
 
-DataPageAccess_RpcCopyDir_presult::~DataPageAccess_RpcCopyDir_presult() noexcept {
+  return xfer;
 }
 
-
-uint32_t DataPageAccess_RpcCopyDir_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcAttachSharedMemory_result::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8010,7 +8560,7 @@ uint32_t DataPageAccess_RpcCopyDir_presult::read(::apache::thrift::protocol::TPr
     {
       case 0:
         if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32((*(this->success)));
+          xfer += iprot->readI32(this->success);
           this->__isset.success = true;
         } else {
           xfer += iprot->skip(ftype);
@@ -8028,12 +8578,7 @@ uint32_t DataPageAccess_RpcCopyDir_presult::read(::apache::thrift::protocol::TPr
   return xfer;
 }
 
-
-DataPageAccess_RpcPgFsync_args::~DataPageAccess_RpcPgFsync_args() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcPgFsync_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcPublishResidentPages_result::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8054,10 +8599,10 @@ uint32_t DataPageAccess_RpcPgFsync_args::read(::apache::thrift::protocol::TProto
     }
     switch (fid)
     {
-      case 1:
+      case 0:
         if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->_fd);
-          this->__isset._fd = true;
+          xfer += iprot->readI32(this->success);
+          this->__isset.success = true;
         } else {
           xfer += iprot->skip(ftype);
         }
@@ -8074,90 +8619,59 @@ uint32_t DataPageAccess_RpcPgFsync_args::read(::apache::thrift::protocol::TProto
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcPgFsync_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+uint32_t DataPageAccess_RpcDirectoryIsEmpty_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
   uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcPgFsync_args");
 
-  xfer += oprot->writeFieldBegin("_fd", ::apache::thrift::protocol::T_I32, 1);
-  xfer += oprot->writeI32(this->_fd);
-  xfer += oprot->writeFieldEnd();
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcDirectoryIsEmpty_result");
 
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
   xfer += oprot->writeFieldStop();
   xfer += oprot->writeStructEnd();
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcSyncFiles_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
 
-DataPageAccess_RpcPgFsync_pargs::~DataPageAccess_RpcPgFsync_pargs() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcPgFsync_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
   uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcPgFsync_pargs");
 
-  xfer += oprot->writeFieldBegin("_fd", ::apache::thrift::protocol::T_I32, 1);
-  xfer += oprot->writeI32((*(this->_fd)));
-  xfer += oprot->writeFieldEnd();
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSyncFiles_result");
 
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
   xfer += oprot->writeFieldStop();
   xfer += oprot->writeStructEnd();
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcAttachSharedMemory_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
 
-DataPageAccess_RpcPgFsync_result::~DataPageAccess_RpcPgFsync_result() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcPgFsync_result::read(::apache::thrift::protocol::TProtocol* iprot) {
-
-  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TType ftype;
-  int16_t fid;
-
-  xfer += iprot->readStructBegin(fname);
-
-  using ::apache::thrift::protocol::TProtocolException;
 
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcAttachSharedMemory_result");
 
-  while (true)
-  {
-    xfer += iprot->readFieldBegin(fname, ftype, fid);
-    if (ftype == ::apache::thrift::protocol::T_STOP) {
-      break;
-    }
-    switch (fid)
-    {
-      case 0:
-        if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->success);
-          this->__isset.success = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      default:
-        xfer += iprot->skip(ftype);
-        break;
-    }
-    xfer += iprot->readFieldEnd();
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
   }
-
-  xfer += iprot->readStructEnd();
-
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcPgFsync_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+uint32_t DataPageAccess_RpcPublishResidentPages_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
 
   uint32_t xfer = 0;
 
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcPgFsync_result");
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcPublishResidentPages_result");
 
   if (this->__isset.success) {
     xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
@@ -8170,11 +8684,20 @@ uint32_t DataPageAccess_RpcPgFsync_result::write(::apache::thrift::protocol::TPr
 }
 
 
-DataPageAccess_RpcPgFsync_presult::~DataPageAccess_RpcPgFsync_presult() noexcept {
+DataPageAccess_RpcDirectoryIsEmpty_presult::~DataPageAccess_RpcDirectoryIsEmpty_presult() noexcept {
 }
 
+DataPageAccess_RpcSyncFiles_presult::~DataPageAccess_RpcSyncFiles_presult() noexcept {
+}
 
-uint32_t DataPageAccess_RpcPgFsync_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+DataPageAccess_RpcAttachSharedMemory_presult::~DataPageAccess_RpcAttachSharedMemory_presult() noexcept {
+}
+
+DataPageAccess_RpcPublishResidentPages_presult::~DataPageAccess_RpcPublishResidentPages_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcDirectoryIsEmpty_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8215,12 +8738,7 @@ uint32_t DataPageAccess_RpcPgFsync_presult::read(::apache::thrift::protocol::TPr
   return xfer;
 }
 
-
-DataPageAccess_RpcDurableUnlink_args::~DataPageAccess_RpcDurableUnlink_args() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcDurableUnlink_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcSyncFiles_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8241,18 +8759,10 @@ uint32_t DataPageAccess_RpcDurableUnlink_args::read(::apache::thrift::protocol::
     }
     switch (fid)
     {
-      case 1:
-        if (ftype == ::apache::thrift::protocol::T_STRING) {
-          xfer += iprot->readBinary(this->_fname);
-          this->__isset._fname = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      case 2:
+      case 0:
         if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->_flag);
-          this->__isset._flag = true;
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
         } else {
           xfer += iprot->skip(ftype);
         }
@@ -8269,53 +8779,7 @@ uint32_t DataPageAccess_RpcDurableUnlink_args::read(::apache::thrift::protocol::
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcDurableUnlink_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
-  uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableUnlink_args");
-
-  xfer += oprot->writeFieldBegin("_fname", ::apache::thrift::protocol::T_STRING, 1);
-  xfer += oprot->writeBinary(this->_fname);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_flag", ::apache::thrift::protocol::T_I32, 2);
-  xfer += oprot->writeI32(this->_flag);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
-
-
-DataPageAccess_RpcDurableUnlink_pargs::~DataPageAccess_RpcDurableUnlink_pargs() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcDurableUnlink_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
-  uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableUnlink_pargs");
-
-  xfer += oprot->writeFieldBegin("_fname", ::apache::thrift::protocol::T_STRING, 1);
-  xfer += oprot->writeBinary((*(this->_fname)));
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_flag", ::apache::thrift::protocol::T_I32, 2);
-  xfer += oprot->writeI32((*(this->_flag)));
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
-
-
-DataPageAccess_RpcDurableUnlink_result::~DataPageAccess_RpcDurableUnlink_result() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcDurableUnlink_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcAttachSharedMemory_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8338,7 +8802,7 @@ uint32_t DataPageAccess_RpcDurableUnlink_result::read(::apache::thrift::protocol
     {
       case 0:
         if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->success);
+          xfer += iprot->readI32((*(this->success)));
           this->__isset.success = true;
         } else {
           xfer += iprot->skip(ftype);
@@ -8356,28 +8820,7 @@ uint32_t DataPageAccess_RpcDurableUnlink_result::read(::apache::thrift::protocol
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcDurableUnlink_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
-
-  uint32_t xfer = 0;
-
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableUnlink_result");
-
-  if (this->__isset.success) {
-    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
-    xfer += oprot->writeI32(this->success);
-    xfer += oprot->writeFieldEnd();
-  }
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
-
-
-DataPageAccess_RpcDurableUnlink_presult::~DataPageAccess_RpcDurableUnlink_presult() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcDurableUnlink_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcPublishResidentPages_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8419,11 +8862,11 @@ uint32_t DataPageAccess_RpcDurableUnlink_presult::read(::apache::thrift::protoco
 }
 
 
-DataPageAccess_RpcDurableRenameExcl_args::~DataPageAccess_RpcDurableRenameExcl_args() noexcept {
+DataPageAccess_RpcCopyDir_args::~DataPageAccess_RpcCopyDir_args() noexcept {
 }
 
 
-uint32_t DataPageAccess_RpcDurableRenameExcl_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcCopyDir_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8446,24 +8889,16 @@ uint32_t DataPageAccess_RpcDurableRenameExcl_args::read(::apache::thrift::protoc
     {
       case 1:
         if (ftype == ::apache::thrift::protocol::T_STRING) {
-          xfer += iprot->readBinary(this->_oldFname);
-          this->__isset._oldFname = true;
+          xfer += iprot->readBinary(this->_src);
+          this->__isset._src = true;
         } else {
           xfer += iprot->skip(ftype);
         }
         break;
       case 2:
         if (ftype == ::apache::thrift::protocol::T_STRING) {
-          xfer += iprot->readBinary(this->_newFname);
-          this->__isset._newFname = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      case 3:
-        if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->_elevel);
-          this->__isset._elevel = true;
+          xfer += iprot->readBinary(this->_dst);
+          this->__isset._dst = true;
         } else {
           xfer += iprot->skip(ftype);
         }
@@ -8480,21 +8915,17 @@ uint32_t DataPageAccess_RpcDurableRenameExcl_args::read(::apache::thrift::protoc
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcDurableRenameExcl_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+uint32_t DataPageAccess_RpcCopyDir_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
   uint32_t xfer = 0;
   ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableRenameExcl_args");
-
-  xfer += oprot->writeFieldBegin("_oldFname", ::apache::thrift::protocol::T_STRING, 1);
-  xfer += oprot->writeBinary(this->_oldFname);
-  xfer += oprot->writeFieldEnd();
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcCopyDir_args");
 
-  xfer += oprot->writeFieldBegin("_newFname", ::apache::thrift::protocol::T_STRING, 2);
-  xfer += oprot->writeBinary(this->_newFname);
+  xfer += oprot->writeFieldBegin("_src", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary(this->_src);
   xfer += oprot->writeFieldEnd();
 
-  xfer += oprot->writeFieldBegin("_elevel", ::apache::thrift::protocol::T_I32, 3);
-  xfer += oprot->writeI32(this->_elevel);
+  xfer += oprot->writeFieldBegin("_dst", ::apache::thrift::protocol::T_STRING, 2);
+  xfer += oprot->writeBinary(this->_dst);
   xfer += oprot->writeFieldEnd();
 
   xfer += oprot->writeFieldStop();
@@ -8503,25 +8934,21 @@ uint32_t DataPageAccess_RpcDurableRenameExcl_args::write(::apache::thrift::proto
 }
 
 
-DataPageAccess_RpcDurableRenameExcl_pargs::~DataPageAccess_RpcDurableRenameExcl_pargs() noexcept {
+DataPageAccess_RpcCopyDir_pargs::~DataPageAccess_RpcCopyDir_pargs() noexcept {
 }
 
 
-uint32_t DataPageAccess_RpcDurableRenameExcl_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+uint32_t DataPageAccess_RpcCopyDir_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
   uint32_t xfer = 0;
   ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableRenameExcl_pargs");
-
-  xfer += oprot->writeFieldBegin("_oldFname", ::apache::thrift::protocol::T_STRING, 1);
-  xfer += oprot->writeBinary((*(this->_oldFname)));
-  xfer += oprot->writeFieldEnd();
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcCopyDir_pargs");
 
-  xfer += oprot->writeFieldBegin("_newFname", ::apache::thrift::protocol::T_STRING, 2);
-  xfer += oprot->writeBinary((*(this->_newFname)));
+  xfer += oprot->writeFieldBegin("_src", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary((*(this->_src)));
   xfer += oprot->writeFieldEnd();
 
-  xfer += oprot->writeFieldBegin("_elevel", ::apache::thrift::protocol::T_I32, 3);
-  xfer += oprot->writeI32((*(this->_elevel)));
+  xfer += oprot->writeFieldBegin("_dst", ::apache::thrift::protocol::T_STRING, 2);
+  xfer += oprot->writeBinary((*(this->_dst)));
   xfer += oprot->writeFieldEnd();
 
   xfer += oprot->writeFieldStop();
@@ -8530,11 +8957,11 @@ uint32_t DataPageAccess_RpcDurableRenameExcl_pargs::write(::apache::thrift::prot
 }
 
 
-DataPageAccess_RpcDurableRenameExcl_result::~DataPageAccess_RpcDurableRenameExcl_result() noexcept {
+DataPageAccess_RpcCopyDir_result::~DataPageAccess_RpcCopyDir_result() noexcept {
 }
 
 
-uint32_t DataPageAccess_RpcDurableRenameExcl_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcCopyDir_result::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8575,11 +9002,11 @@ uint32_t DataPageAccess_RpcDurableRenameExcl_result::read(::apache::thrift::prot
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcDurableRenameExcl_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+uint32_t DataPageAccess_RpcCopyDir_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
 
   uint32_t xfer = 0;
 
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableRenameExcl_result");
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcCopyDir_result");
 
   if (this->__isset.success) {
     xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
@@ -8592,11 +9019,11 @@ uint32_t DataPageAccess_RpcDurableRenameExcl_result::write(::apache::thrift::pro
 }
 
 
-DataPageAccess_RpcDurableRenameExcl_presult::~DataPageAccess_RpcDurableRenameExcl_presult() noexcept {
+DataPageAccess_RpcCopyDir_presult::~DataPageAccess_RpcCopyDir_presult() noexcept {
 }
 
 
-uint32_t DataPageAccess_RpcDurableRenameExcl_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcCopyDir_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8638,11 +9065,20 @@ uint32_t DataPageAccess_RpcDurableRenameExcl_presult::read(::apache::thrift::pro
 }
 
 
-DataPageAccess_RpcXLogWrite_args::~DataPageAccess_RpcXLogWrite_args() noexcept {
+DataPageAccess_RpcPgFsync_args::~DataPageAccess_RpcPgFsync_args() noexcept {
+}
+
+DataPageAccess_RpcSetPageCompression_args::~DataPageAccess_RpcSetPageCompression_args() noexcept {
 }
 
+DataPageAccess_RpcSetRequestClass_args::~DataPageAccess_RpcSetRequestClass_args() noexcept {
+}
 
-uint32_t DataPageAccess_RpcXLogWrite_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+DataPageAccess_RpcSetRequestDeadline_args::~DataPageAccess_RpcSetRequestDeadline_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcPgFsync_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8671,76 +9107,8 @@ uint32_t DataPageAccess_RpcXLogWrite_args::read(::apache::thrift::protocol::TPro
           xfer += iprot->skip(ftype);
         }
         break;
-      case 2:
-        if (ftype == ::apache::thrift::protocol::T_STRING) {
-          xfer += iprot->readBinary(this->_page);
-          this->__isset._page = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      case 3:
-        if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->_amount);
-          this->__isset._amount = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      case 4:
-        if (ftype == ::apache::thrift::protocol::T_I64) {
-          xfer += iprot->readI64(this->_offset);
-          this->__isset._offset = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      case 5:
-        if (ftype == ::apache::thrift::protocol::T_LIST) {
-          {
-            this->_xlblocks.clear();
-            uint32_t _size6;
-            ::apache::thrift::protocol::TType _etype9;
-            xfer += iprot->readListBegin(_etype9, _size6);
-            this->_xlblocks.resize(_size6);
-            uint32_t _i10;
-            for (_i10 = 0; _i10 < _size6; ++_i10)
-            {
-              xfer += iprot->readI64(this->_xlblocks[_i10]);
-            }
-            xfer += iprot->readListEnd();
-          }
-          this->__isset._xlblocks = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      case 6:
-        if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->_blknum);
-          this->__isset._blknum = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      case 7:
-        if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->_idx);
-          this->__isset._idx = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      case 8:
-        if (ftype == ::apache::thrift::protocol::T_I64) {
-          xfer += iprot->readI64(this->_lsn);
-          this->__isset._lsn = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      default:
-        xfer += iprot->skip(ftype);
+      default:
+        xfer += iprot->skip(ftype);
         break;
     }
     xfer += iprot->readFieldEnd();
@@ -8751,117 +9119,7 @@ uint32_t DataPageAccess_RpcXLogWrite_args::read(::apache::thrift::protocol::TPro
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcXLogWrite_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
-  uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogWrite_args");
-
-  xfer += oprot->writeFieldBegin("_fd", ::apache::thrift::protocol::T_I32, 1);
-  xfer += oprot->writeI32(this->_fd);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_page", ::apache::thrift::protocol::T_STRING, 2);
-  xfer += oprot->writeBinary(this->_page);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_amount", ::apache::thrift::protocol::T_I32, 3);
-  xfer += oprot->writeI32(this->_amount);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_offset", ::apache::thrift::protocol::T_I64, 4);
-  xfer += oprot->writeI64(this->_offset);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_xlblocks", ::apache::thrift::protocol::T_LIST, 5);
-  {
-    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>(this->_xlblocks.size()));
-    std::vector<int64_t> ::const_iterator _iter11;
-    for (_iter11 = this->_xlblocks.begin(); _iter11 != this->_xlblocks.end(); ++_iter11)
-    {
-      xfer += oprot->writeI64((*_iter11));
-    }
-    xfer += oprot->writeListEnd();
-  }
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_blknum", ::apache::thrift::protocol::T_I32, 6);
-  xfer += oprot->writeI32(this->_blknum);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_idx", ::apache::thrift::protocol::T_I32, 7);
-  xfer += oprot->writeI32(this->_idx);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 8);
-  xfer += oprot->writeI64(this->_lsn);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
-
-
-DataPageAccess_RpcXLogWrite_pargs::~DataPageAccess_RpcXLogWrite_pargs() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcXLogWrite_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
-  uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogWrite_pargs");
-
-  xfer += oprot->writeFieldBegin("_fd", ::apache::thrift::protocol::T_I32, 1);
-  xfer += oprot->writeI32((*(this->_fd)));
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_page", ::apache::thrift::protocol::T_STRING, 2);
-  xfer += oprot->writeBinary((*(this->_page)));
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_amount", ::apache::thrift::protocol::T_I32, 3);
-  xfer += oprot->writeI32((*(this->_amount)));
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_offset", ::apache::thrift::protocol::T_I64, 4);
-  xfer += oprot->writeI64((*(this->_offset)));
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_xlblocks", ::apache::thrift::protocol::T_LIST, 5);
-  {
-    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>((*(this->_xlblocks)).size()));
-    std::vector<int64_t> ::const_iterator _iter12;
-    for (_iter12 = (*(this->_xlblocks)).begin(); _iter12 != (*(this->_xlblocks)).end(); ++_iter12)
-    {
-      xfer += oprot->writeI64((*_iter12));
-    }
-    xfer += oprot->writeListEnd();
-  }
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_blknum", ::apache::thrift::protocol::T_I32, 6);
-  xfer += oprot->writeI32((*(this->_blknum)));
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_idx", ::apache::thrift::protocol::T_I32, 7);
-  xfer += oprot->writeI32((*(this->_idx)));
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 8);
-  xfer += oprot->writeI64((*(this->_lsn)));
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
-
-
-DataPageAccess_RpcXLogWrite_result::~DataPageAccess_RpcXLogWrite_result() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcXLogWrite_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcSetPageCompression_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8882,10 +9140,10 @@ uint32_t DataPageAccess_RpcXLogWrite_result::read(::apache::thrift::protocol::TP
     }
     switch (fid)
     {
-      case 0:
+      case 1:
         if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->success);
-          this->__isset.success = true;
+          xfer += iprot->readI32(this->_method);
+          this->__isset._method = true;
         } else {
           xfer += iprot->skip(ftype);
         }
@@ -8902,28 +9160,7 @@ uint32_t DataPageAccess_RpcXLogWrite_result::read(::apache::thrift::protocol::TP
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcXLogWrite_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
-
-  uint32_t xfer = 0;
-
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogWrite_result");
-
-  if (this->__isset.success) {
-    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
-    xfer += oprot->writeI32(this->success);
-    xfer += oprot->writeFieldEnd();
-  }
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
-
-
-DataPageAccess_RpcXLogWrite_presult::~DataPageAccess_RpcXLogWrite_presult() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcXLogWrite_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcSetRequestClass_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8944,10 +9181,10 @@ uint32_t DataPageAccess_RpcXLogWrite_presult::read(::apache::thrift::protocol::T
     }
     switch (fid)
     {
-      case 0:
+      case 1:
         if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32((*(this->success)));
-          this->__isset.success = true;
+          xfer += iprot->readI32(this->_requestClass);
+          this->__isset._requestClass = true;
         } else {
           xfer += iprot->skip(ftype);
         }
@@ -8964,12 +9201,7 @@ uint32_t DataPageAccess_RpcXLogWrite_presult::read(::apache::thrift::protocol::T
   return xfer;
 }
 
-
-DataPageAccess_RpcXLogFileInit_args::~DataPageAccess_RpcXLogFileInit_args() noexcept {
-}
-
-
-uint32_t DataPageAccess_RpcXLogFileInit_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcSetRequestDeadline_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -8991,25 +9223,9 @@ uint32_t DataPageAccess_RpcXLogFileInit_args::read(::apache::thrift::protocol::T
     switch (fid)
     {
       case 1:
-        if (ftype == ::apache::thrift::protocol::T_I64) {
-          xfer += iprot->readI64(this->_logsegno);
-          this->__isset._logsegno = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      case 2:
-        if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->_use_existent);
-          this->__isset._use_existent = true;
-        } else {
-          xfer += iprot->skip(ftype);
-        }
-        break;
-      case 3:
         if (ftype == ::apache::thrift::protocol::T_I32) {
-          xfer += iprot->readI32(this->_use_lock);
-          this->__isset._use_lock = true;
+          xfer += iprot->readI32(this->_queue_ms);
+          this->__isset._queue_ms = true;
         } else {
           xfer += iprot->skip(ftype);
         }
@@ -9026,21 +9242,13 @@ uint32_t DataPageAccess_RpcXLogFileInit_args::read(::apache::thrift::protocol::T
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcXLogFileInit_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+uint32_t DataPageAccess_RpcPgFsync_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
   uint32_t xfer = 0;
   ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogFileInit_args");
-
-  xfer += oprot->writeFieldBegin("_logsegno", ::apache::thrift::protocol::T_I64, 1);
-  xfer += oprot->writeI64(this->_logsegno);
-  xfer += oprot->writeFieldEnd();
-
-  xfer += oprot->writeFieldBegin("_use_existent", ::apache::thrift::protocol::T_I32, 2);
-  xfer += oprot->writeI32(this->_use_existent);
-  xfer += oprot->writeFieldEnd();
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcPgFsync_args");
 
-  xfer += oprot->writeFieldBegin("_use_lock", ::apache::thrift::protocol::T_I32, 3);
-  xfer += oprot->writeI32(this->_use_lock);
+  xfer += oprot->writeFieldBegin("_fd", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32(this->_fd);
   xfer += oprot->writeFieldEnd();
 
   xfer += oprot->writeFieldStop();
@@ -9048,26 +9256,69 @@ uint32_t DataPageAccess_RpcXLogFileInit_args::write(::apache::thrift::protocol::
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcSetPageCompression_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSetPageCompression_args");
 
-DataPageAccess_RpcXLogFileInit_pargs::~DataPageAccess_RpcXLogFileInit_pargs() noexcept {
-}
+  xfer += oprot->writeFieldBegin("_method", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32(this->_method);
+  xfer += oprot->writeFieldEnd();
 
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
 
-uint32_t DataPageAccess_RpcXLogFileInit_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+uint32_t DataPageAccess_RpcSetRequestClass_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
   uint32_t xfer = 0;
   ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogFileInit_pargs");
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSetRequestClass_args");
 
-  xfer += oprot->writeFieldBegin("_logsegno", ::apache::thrift::protocol::T_I64, 1);
-  xfer += oprot->writeI64((*(this->_logsegno)));
+  xfer += oprot->writeFieldBegin("_requestClass", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32(this->_requestClass);
   xfer += oprot->writeFieldEnd();
 
-  xfer += oprot->writeFieldBegin("_use_existent", ::apache::thrift::protocol::T_I32, 2);
-  xfer += oprot->writeI32((*(this->_use_existent)));
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcSetRequestDeadline_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSetRequestDeadline_args");
+
+  xfer += oprot->writeFieldBegin("_queue_ms", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32(this->_queue_ms);
   xfer += oprot->writeFieldEnd();
 
-  xfer += oprot->writeFieldBegin("_use_lock", ::apache::thrift::protocol::T_I32, 3);
-  xfer += oprot->writeI32((*(this->_use_lock)));
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcPgFsync_pargs::~DataPageAccess_RpcPgFsync_pargs() noexcept {
+}
+
+DataPageAccess_RpcSetPageCompression_pargs::~DataPageAccess_RpcSetPageCompression_pargs() noexcept {
+}
+
+DataPageAccess_RpcSetRequestClass_pargs::~DataPageAccess_RpcSetRequestClass_pargs() noexcept {
+}
+
+DataPageAccess_RpcSetRequestDeadline_pargs::~DataPageAccess_RpcSetRequestDeadline_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcPgFsync_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcPgFsync_pargs");
+
+  xfer += oprot->writeFieldBegin("_fd", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32((*(this->_fd)));
   xfer += oprot->writeFieldEnd();
 
   xfer += oprot->writeFieldStop();
@@ -9075,12 +9326,63 @@ uint32_t DataPageAccess_RpcXLogFileInit_pargs::write(::apache::thrift::protocol:
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcSetPageCompression_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSetPageCompression_pargs");
 
-DataPageAccess_RpcXLogFileInit_result::~DataPageAccess_RpcXLogFileInit_result() noexcept {
+  xfer += oprot->writeFieldBegin("_method", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32((*(this->_method)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
 }
 
+uint32_t DataPageAccess_RpcSetRequestClass_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSetRequestClass_pargs");
+
+  xfer += oprot->writeFieldBegin("_requestClass", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32((*(this->_requestClass)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcSetRequestDeadline_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSetRequestDeadline_pargs");
+
+  xfer += oprot->writeFieldBegin("_queue_ms", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32((*(this->_queue_ms)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
 
-uint32_t DataPageAccess_RpcXLogFileInit_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+DataPageAccess_RpcPgFsync_result::~DataPageAccess_RpcPgFsync_result() noexcept {
+}
+
+DataPageAccess_RpcSetPageCompression_result::~DataPageAccess_RpcSetPageCompression_result() noexcept {
+}
+
+DataPageAccess_RpcSetRequestClass_result::~DataPageAccess_RpcSetRequestClass_result() noexcept {
+}
+
+DataPageAccess_RpcSetRequestDeadline_result::~DataPageAccess_RpcSetRequestDeadline_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcPgFsync_result::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -9102,8 +9404,8 @@ uint32_t DataPageAccess_RpcXLogFileInit_result::read(::apache::thrift::protocol:
     switch (fid)
     {
       case 0:
-        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
-          xfer += this->success.read(iprot);
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
           this->__isset.success = true;
         } else {
           xfer += iprot->skip(ftype);
@@ -9121,28 +9423,48 @@ uint32_t DataPageAccess_RpcXLogFileInit_result::read(::apache::thrift::protocol:
   return xfer;
 }
 
-uint32_t DataPageAccess_RpcXLogFileInit_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+uint32_t DataPageAccess_RpcSetPageCompression_result::read(::apache::thrift::protocol::TProtocol* iprot) {
 
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogFileInit_result");
+  xfer += iprot->readStructBegin(fname);
 
-  if (this->__isset.success) {
-    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_STRUCT, 0);
-    xfer += this->success.write(oprot);
-    xfer += oprot->writeFieldEnd();
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
   }
-  xfer += oprot->writeFieldStop();
-  xfer += oprot->writeStructEnd();
-  return xfer;
-}
 
+  xfer += iprot->readStructEnd();
 
-DataPageAccess_RpcXLogFileInit_presult::~DataPageAccess_RpcXLogFileInit_presult() noexcept {
+  return xfer;
 }
 
-
-uint32_t DataPageAccess_RpcXLogFileInit_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcSetRequestClass_result::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -9164,8 +9486,8 @@ uint32_t DataPageAccess_RpcXLogFileInit_presult::read(::apache::thrift::protocol
     switch (fid)
     {
       case 0:
-        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
-          xfer += (*(this->success)).read(iprot);
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
           this->__isset.success = true;
         } else {
           xfer += iprot->skip(ftype);
@@ -9183,12 +9505,7 @@ uint32_t DataPageAccess_RpcXLogFileInit_presult::read(::apache::thrift::protocol
   return xfer;
 }
 
-
-DataPageAccess_zip_args::~DataPageAccess_zip_args() noexcept {
-}
-
-
-uint32_t DataPageAccess_zip_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+uint32_t DataPageAccess_RpcSetRequestDeadline_result::read(::apache::thrift::protocol::TProtocol* iprot) {
 
   ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
   uint32_t xfer = 0;
@@ -9207,7 +9524,20 @@ uint32_t DataPageAccess_zip_args::read(::apache::thrift::protocol::TProtocol* ip
     if (ftype == ::apache::thrift::protocol::T_STOP) {
       break;
     }
-    xfer += iprot->skip(ftype);
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
     xfer += iprot->readFieldEnd();
   }
 
@@ -9216,2688 +9546,11055 @@ uint32_t DataPageAccess_zip_args::read(::apache::thrift::protocol::TProtocol* ip
   return xfer;
 }
 
-uint32_t DataPageAccess_zip_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+uint32_t DataPageAccess_RpcPgFsync_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
   uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_zip_args");
 
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcPgFsync_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
   xfer += oprot->writeFieldStop();
   xfer += oprot->writeStructEnd();
   return xfer;
 }
 
+uint32_t DataPageAccess_RpcSetPageCompression_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
 
-DataPageAccess_zip_pargs::~DataPageAccess_zip_pargs() noexcept {
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSetPageCompression_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
 }
 
+uint32_t DataPageAccess_RpcSetRequestClass_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
 
-uint32_t DataPageAccess_zip_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
   uint32_t xfer = 0;
-  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-  xfer += oprot->writeStructBegin("DataPageAccess_zip_pargs");
 
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSetRequestClass_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
   xfer += oprot->writeFieldStop();
   xfer += oprot->writeStructEnd();
   return xfer;
 }
 
-void DataPageAccessClient::ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn)
-{
-  send_ReadBufferCommon(_reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn);
-  recv_ReadBufferCommon(_return);
-}
+uint32_t DataPageAccess_RpcSetRequestDeadline_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
 
-void DataPageAccessClient::send_ReadBufferCommon(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("ReadBufferCommon", ::apache::thrift::protocol::T_CALL, cseqid);
+  uint32_t xfer = 0;
 
-  DataPageAccess_ReadBufferCommon_pargs args;
-  args._reln = &_reln;
-  args._relpersistence = &_relpersistence;
-  args._forknum = &_forknum;
-  args._blknum = &_blknum;
-  args._readBufferMode = &_readBufferMode;
-  args._lsn = &_lsn;
-  args.write(oprot_);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSetRequestDeadline_result");
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
 }
 
-void DataPageAccessClient::recv_ReadBufferCommon(_Page& _return)
-{
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+DataPageAccess_RpcPgFsync_presult::~DataPageAccess_RpcPgFsync_presult() noexcept {
+}
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("ReadBufferCommon") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  DataPageAccess_ReadBufferCommon_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
+DataPageAccess_RpcSetPageCompression_presult::~DataPageAccess_RpcSetPageCompression_presult() noexcept {
+}
 
-  if (result.__isset.success) {
-    // _return pointer has now been filled
-    return;
-  }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ReadBufferCommon failed: unknown result");
+DataPageAccess_RpcSetRequestClass_presult::~DataPageAccess_RpcSetRequestClass_presult() noexcept {
 }
 
-int32_t DataPageAccessClient::RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn)
-{
-  send_RpcRegisterSecondaryNode(_primary, _lsn);
-  return recv_RpcRegisterSecondaryNode();
+DataPageAccess_RpcSetRequestDeadline_presult::~DataPageAccess_RpcSetRequestDeadline_presult() noexcept {
 }
 
-void DataPageAccessClient::send_RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcRegisterSecondaryNode", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcRegisterSecondaryNode_pargs args;
-  args._primary = &_primary;
-  args._lsn = &_lsn;
-  args.write(oprot_);
+uint32_t DataPageAccess_RpcPgFsync_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-int32_t DataPageAccessClient::recv_RpcRegisterSecondaryNode()
-{
+  xfer += iprot->readStructBegin(fname);
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  using ::apache::thrift::protocol::TProtocolException;
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcRegisterSecondaryNode") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  int32_t _return;
-  DataPageAccess_RpcRegisterSecondaryNode_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcRegisterSecondaryNode failed: unknown result");
-}
 
-void DataPageAccessClient::RpcSecondaryNodeUpdatesLsn(const int32_t _node_id, const int64_t _lsn)
-{
-  send_RpcSecondaryNodeUpdatesLsn(_node_id, _lsn);
-  recv_RpcSecondaryNodeUpdatesLsn();
+  xfer += iprot->readStructEnd();
+
+  return xfer;
 }
 
-void DataPageAccessClient::send_RpcSecondaryNodeUpdatesLsn(const int32_t _node_id, const int64_t _lsn)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcSecondaryNodeUpdatesLsn", ::apache::thrift::protocol::T_CALL, cseqid);
+uint32_t DataPageAccess_RpcSetPageCompression_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
 
-  DataPageAccess_RpcSecondaryNodeUpdatesLsn_pargs args;
-  args._node_id = &_node_id;
-  args._lsn = &_lsn;
-  args.write(oprot_);
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  xfer += iprot->readStructBegin(fname);
 
-void DataPageAccessClient::recv_RpcSecondaryNodeUpdatesLsn()
-{
+  using ::apache::thrift::protocol::TProtocolException;
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcSecondaryNodeUpdatesLsn") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
   }
-  DataPageAccess_RpcSecondaryNodeUpdatesLsn_presult result;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  return;
-}
+  xfer += iprot->readStructEnd();
 
-void DataPageAccessClient::RpcMdRead(_Page& _return, const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _blknum, const int64_t _lsn)
-{
-  send_RpcMdRead(_reln, _forknum, _blknum, _lsn);
-  recv_RpcMdRead(_return);
+  return xfer;
 }
 
-void DataPageAccessClient::send_RpcMdRead(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _blknum, const int64_t _lsn)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcMdRead", ::apache::thrift::protocol::T_CALL, cseqid);
+uint32_t DataPageAccess_RpcSetRequestClass_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
 
-  DataPageAccess_RpcMdRead_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._blknum = &_blknum;
-  args._lsn = &_lsn;
-  args.write(oprot_);
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  xfer += iprot->readStructBegin(fname);
 
-void DataPageAccessClient::recv_RpcMdRead(_Page& _return)
-{
+  using ::apache::thrift::protocol::TProtocolException;
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcMdRead") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
   }
-  DataPageAccess_RpcMdRead_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    // _return pointer has now been filled
-    return;
-  }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdRead failed: unknown result");
-}
+  xfer += iprot->readStructEnd();
 
-int32_t DataPageAccessClient::RpcMdNblocks(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
-{
-  send_RpcMdNblocks(_reln, _forknum, _lsn);
-  return recv_RpcMdNblocks();
+  return xfer;
 }
 
-void DataPageAccessClient::send_RpcMdNblocks(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcMdNblocks", ::apache::thrift::protocol::T_CALL, cseqid);
+uint32_t DataPageAccess_RpcSetRequestDeadline_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
 
-  DataPageAccess_RpcMdNblocks_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._lsn = &_lsn;
-  args.write(oprot_);
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  xfer += iprot->readStructBegin(fname);
 
-int32_t DataPageAccessClient::recv_RpcMdNblocks()
-{
+  using ::apache::thrift::protocol::TProtocolException;
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcMdNblocks") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
   }
-  int32_t _return;
-  DataPageAccess_RpcMdNblocks_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
-  }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdNblocks failed: unknown result");
-}
+  xfer += iprot->readStructEnd();
 
-int32_t DataPageAccessClient::RpcMdExists(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
-{
-  send_RpcMdExists(_reln, _forknum, _lsn);
-  return recv_RpcMdExists();
+  return xfer;
 }
 
-void DataPageAccessClient::send_RpcMdExists(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcMdExists", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_RpcMdExists_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._lsn = &_lsn;
-  args.write(oprot_);
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+DataPageAccess_RpcDurableUnlink_args::~DataPageAccess_RpcDurableUnlink_args() noexcept {
 }
 
-int32_t DataPageAccessClient::recv_RpcMdExists()
-{
 
-  int32_t rseqid = 0;
+uint32_t DataPageAccess_RpcDurableUnlink_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
   std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcMdExists") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  int32_t _return;
-  DataPageAccess_RpcMdExists_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
+  xfer += iprot->readStructBegin(fname);
 
-  if (result.__isset.success) {
-    return _return;
-  }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdExists failed: unknown result");
-}
+  using ::apache::thrift::protocol::TProtocolException;
 
-void DataPageAccessClient::RpcMdCreate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _isRedo, const int64_t _lsn)
-{
-  send_RpcMdCreate(_reln, _forknum, _isRedo, _lsn);
-  recv_RpcMdCreate();
-}
 
-void DataPageAccessClient::send_RpcMdCreate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _isRedo, const int64_t _lsn)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcMdCreate", ::apache::thrift::protocol::T_CALL, cseqid);
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->_fname);
+          this->__isset._fname = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_flag);
+          this->__isset._flag = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
 
-  DataPageAccess_RpcMdCreate_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._isRedo = &_isRedo;
-  args._lsn = &_lsn;
-  args.write(oprot_);
+  xfer += iprot->readStructEnd();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+  return xfer;
 }
 
-void DataPageAccessClient::recv_RpcMdCreate()
-{
+uint32_t DataPageAccess_RpcDurableUnlink_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableUnlink_args");
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  xfer += oprot->writeFieldBegin("_fname", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary(this->_fname);
+  xfer += oprot->writeFieldEnd();
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcMdCreate") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  DataPageAccess_RpcMdCreate_presult result;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
+  xfer += oprot->writeFieldBegin("_flag", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_flag);
+  xfer += oprot->writeFieldEnd();
 
-  return;
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
 }
 
-void DataPageAccessClient::RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn)
-{
-  send_RpcMdExtend(_reln, _forknum, _blknum, _buff, skipFsync, _lsn);
-  recv_RpcMdExtend();
+
+DataPageAccess_RpcDurableUnlink_pargs::~DataPageAccess_RpcDurableUnlink_pargs() noexcept {
 }
 
-void DataPageAccessClient::send_RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcMdExtend", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcMdExtend_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._blknum = &_blknum;
-  args._buff = &_buff;
-  args.skipFsync = &skipFsync;
-  args._lsn = &_lsn;
-  args.write(oprot_);
+uint32_t DataPageAccess_RpcDurableUnlink_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableUnlink_pargs");
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+  xfer += oprot->writeFieldBegin("_fname", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary((*(this->_fname)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_flag", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_flag)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
 }
 
-void DataPageAccessClient::recv_RpcMdExtend()
-{
 
-  int32_t rseqid = 0;
+DataPageAccess_RpcDurableUnlink_result::~DataPageAccess_RpcDurableUnlink_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcDurableUnlink_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
   std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcMdExtend") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  DataPageAccess_RpcMdExtend_presult result;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
+  xfer += iprot->readStructBegin(fname);
 
-  return;
-}
+  using ::apache::thrift::protocol::TProtocolException;
 
-void DataPageAccessClient::RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn)
-{
-  send_RpcTruncate(_reln, _forknum, _blknum, _lsn);
-  recv_RpcTruncate();
-}
 
-void DataPageAccessClient::send_RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcTruncate", ::apache::thrift::protocol::T_CALL, cseqid);
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
 
-  DataPageAccess_RpcTruncate_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._blknum = &_blknum;
-  args._lsn = &_lsn;
-  args.write(oprot_);
+  xfer += iprot->readStructEnd();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+  return xfer;
 }
 
-void DataPageAccessClient::recv_RpcTruncate()
-{
-
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+uint32_t DataPageAccess_RpcDurableUnlink_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcTruncate") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  DataPageAccess_RpcTruncate_presult result;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
+  uint32_t xfer = 0;
 
-  return;
-}
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableUnlink_result");
 
-void DataPageAccessClient::RpcFileClose(const _File _fd)
-{
-  send_RpcFileClose(_fd);
-  recv_RpcFileClose();
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
 }
 
-void DataPageAccessClient::send_RpcFileClose(const _File _fd)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcFileClose", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_RpcFileClose_pargs args;
-  args._fd = &_fd;
-  args.write(oprot_);
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+DataPageAccess_RpcDurableUnlink_presult::~DataPageAccess_RpcDurableUnlink_presult() noexcept {
 }
 
-void DataPageAccessClient::recv_RpcFileClose()
-{
 
-  int32_t rseqid = 0;
+uint32_t DataPageAccess_RpcDurableUnlink_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
   std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcFileClose") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  DataPageAccess_RpcFileClose_presult result;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
+  xfer += iprot->readStructBegin(fname);
 
-  return;
-}
+  using ::apache::thrift::protocol::TProtocolException;
 
-void DataPageAccessClient::RpcTablespaceCreateDbspace(const _Oid _spcnode, const _Oid _dbnode, const bool isRedo)
-{
-  send_RpcTablespaceCreateDbspace(_spcnode, _dbnode, isRedo);
-  recv_RpcTablespaceCreateDbspace();
-}
 
-void DataPageAccessClient::send_RpcTablespaceCreateDbspace(const _Oid _spcnode, const _Oid _dbnode, const bool isRedo)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcTablespaceCreateDbspace", ::apache::thrift::protocol::T_CALL, cseqid);
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
 
-  DataPageAccess_RpcTablespaceCreateDbspace_pargs args;
-  args._spcnode = &_spcnode;
-  args._dbnode = &_dbnode;
-  args.isRedo = &isRedo;
-  args.write(oprot_);
+  xfer += iprot->readStructEnd();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+  return xfer;
 }
 
-void DataPageAccessClient::recv_RpcTablespaceCreateDbspace()
-{
-
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
-
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcTablespaceCreateDbspace") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  DataPageAccess_RpcTablespaceCreateDbspace_presult result;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  return;
+DataPageAccess_RpcDurableRenameExcl_args::~DataPageAccess_RpcDurableRenameExcl_args() noexcept {
 }
 
-_File DataPageAccessClient::RpcPathNameOpenFile(const _Path& _path, const _Flag _flag)
-{
-  send_RpcPathNameOpenFile(_path, _flag);
-  return recv_RpcPathNameOpenFile();
-}
 
-void DataPageAccessClient::send_RpcPathNameOpenFile(const _Path& _path, const _Flag _flag)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcPathNameOpenFile", ::apache::thrift::protocol::T_CALL, cseqid);
+uint32_t DataPageAccess_RpcDurableRenameExcl_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
-  DataPageAccess_RpcPathNameOpenFile_pargs args;
-  args._path = &_path;
-  args._flag = &_flag;
-  args.write(oprot_);
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  xfer += iprot->readStructBegin(fname);
 
-_File DataPageAccessClient::recv_RpcPathNameOpenFile()
-{
+  using ::apache::thrift::protocol::TProtocolException;
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcPathNameOpenFile") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->_oldFname);
+          this->__isset._oldFname = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->_newFname);
+          this->__isset._newFname = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_elevel);
+          this->__isset._elevel = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
   }
-  _File _return;
-  DataPageAccess_RpcPathNameOpenFile_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
-  }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPathNameOpenFile failed: unknown result");
-}
+  xfer += iprot->readStructEnd();
 
-int32_t DataPageAccessClient::RpcFileWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
-{
-  send_RpcFileWrite(_fd, _page, _amount, _seekpos, _wait_event_info);
-  return recv_RpcFileWrite();
+  return xfer;
 }
 
-void DataPageAccessClient::send_RpcFileWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcFileWrite", ::apache::thrift::protocol::T_CALL, cseqid);
+uint32_t DataPageAccess_RpcDurableRenameExcl_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableRenameExcl_args");
 
-  DataPageAccess_RpcFileWrite_pargs args;
-  args._fd = &_fd;
-  args._page = &_page;
-  args._amount = &_amount;
-  args._seekpos = &_seekpos;
-  args._wait_event_info = &_wait_event_info;
-  args.write(oprot_);
+  xfer += oprot->writeFieldBegin("_oldFname", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary(this->_oldFname);
+  xfer += oprot->writeFieldEnd();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  xfer += oprot->writeFieldBegin("_newFname", ::apache::thrift::protocol::T_STRING, 2);
+  xfer += oprot->writeBinary(this->_newFname);
+  xfer += oprot->writeFieldEnd();
 
-int32_t DataPageAccessClient::recv_RpcFileWrite()
-{
+  xfer += oprot->writeFieldBegin("_elevel", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_elevel);
+  xfer += oprot->writeFieldEnd();
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcFileWrite") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  int32_t _return;
-  DataPageAccess_RpcFileWrite_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
-  }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileWrite failed: unknown result");
+DataPageAccess_RpcDurableRenameExcl_pargs::~DataPageAccess_RpcDurableRenameExcl_pargs() noexcept {
 }
 
-void DataPageAccessClient::RpcFilePathName(_Path& _return, const _File _fd)
-{
-  send_RpcFilePathName(_fd);
-  recv_RpcFilePathName(_return);
-}
 
-void DataPageAccessClient::send_RpcFilePathName(const _File _fd)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcFilePathName", ::apache::thrift::protocol::T_CALL, cseqid);
+uint32_t DataPageAccess_RpcDurableRenameExcl_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableRenameExcl_pargs");
 
-  DataPageAccess_RpcFilePathName_pargs args;
-  args._fd = &_fd;
-  args.write(oprot_);
+  xfer += oprot->writeFieldBegin("_oldFname", ::apache::thrift::protocol::T_STRING, 1);
+  xfer += oprot->writeBinary((*(this->_oldFname)));
+  xfer += oprot->writeFieldEnd();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  xfer += oprot->writeFieldBegin("_newFname", ::apache::thrift::protocol::T_STRING, 2);
+  xfer += oprot->writeBinary((*(this->_newFname)));
+  xfer += oprot->writeFieldEnd();
 
-void DataPageAccessClient::recv_RpcFilePathName(_Path& _return)
-{
+  xfer += oprot->writeFieldBegin("_elevel", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_elevel)));
+  xfer += oprot->writeFieldEnd();
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcFilePathName") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  DataPageAccess_RpcFilePathName_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    // _return pointer has now been filled
-    return;
-  }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFilePathName failed: unknown result");
+DataPageAccess_RpcDurableRenameExcl_result::~DataPageAccess_RpcDurableRenameExcl_result() noexcept {
 }
 
-void DataPageAccessClient::RpcFileRead(_Page& _return, const _File _fd, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
-{
-  send_RpcFileRead(_fd, _amount, _seekpos, _wait_event_info);
-  recv_RpcFileRead(_return);
-}
 
-void DataPageAccessClient::send_RpcFileRead(const _File _fd, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcFileRead", ::apache::thrift::protocol::T_CALL, cseqid);
+uint32_t DataPageAccess_RpcDurableRenameExcl_result::read(::apache::thrift::protocol::TProtocol* iprot) {
 
-  DataPageAccess_RpcFileRead_pargs args;
-  args._fd = &_fd;
-  args._amount = &_amount;
-  args._seekpos = &_seekpos;
-  args._wait_event_info = &_wait_event_info;
-  args.write(oprot_);
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  xfer += iprot->readStructBegin(fname);
 
-void DataPageAccessClient::recv_RpcFileRead(_Page& _return)
-{
+  using ::apache::thrift::protocol::TProtocolException;
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcFileRead") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  DataPageAccess_RpcFileRead_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
-
-  if (result.__isset.success) {
-    // _return pointer has now been filled
-    return;
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileRead failed: unknown result");
-}
-
-int32_t DataPageAccessClient::RpcFileTruncate(const _File _fd, const _Off_t _offset)
-{
-  send_RpcFileTruncate(_fd, _offset);
-  return recv_RpcFileTruncate();
-}
-
-void DataPageAccessClient::send_RpcFileTruncate(const _File _fd, const _Off_t _offset)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcFileTruncate", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcFileTruncate_pargs args;
-  args._fd = &_fd;
-  args._offset = &_offset;
-  args.write(oprot_);
+  xfer += iprot->readStructEnd();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+  return xfer;
 }
 
-int32_t DataPageAccessClient::recv_RpcFileTruncate()
-{
+uint32_t DataPageAccess_RpcDurableRenameExcl_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  uint32_t xfer = 0;
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcFileTruncate") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  int32_t _return;
-  DataPageAccess_RpcFileTruncate_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcDurableRenameExcl_result");
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileTruncate failed: unknown result");
-}
-
-_Off_t DataPageAccessClient::RpcFileSize(const _File _fd)
-{
-  send_RpcFileSize(_fd);
-  return recv_RpcFileSize();
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
 }
 
-void DataPageAccessClient::send_RpcFileSize(const _File _fd)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcFileSize", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_RpcFileSize_pargs args;
-  args._fd = &_fd;
-  args.write(oprot_);
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+DataPageAccess_RpcDurableRenameExcl_presult::~DataPageAccess_RpcDurableRenameExcl_presult() noexcept {
 }
 
-_Off_t DataPageAccessClient::recv_RpcFileSize()
-{
 
-  int32_t rseqid = 0;
+uint32_t DataPageAccess_RpcDurableRenameExcl_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
   std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcFileSize") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  _Off_t _return;
-  DataPageAccess_RpcFileSize_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
+  xfer += iprot->readStructBegin(fname);
 
-  if (result.__isset.success) {
-    return _return;
-  }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileSize failed: unknown result");
-}
+  using ::apache::thrift::protocol::TProtocolException;
 
-int32_t DataPageAccessClient::RpcFilePrefetch(const _File _fd, const _Off_t _offset, const int32_t _amount, const int32_t wait_event_info)
-{
-  send_RpcFilePrefetch(_fd, _offset, _amount, wait_event_info);
-  return recv_RpcFilePrefetch();
-}
 
-void DataPageAccessClient::send_RpcFilePrefetch(const _File _fd, const _Off_t _offset, const int32_t _amount, const int32_t wait_event_info)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcFilePrefetch", ::apache::thrift::protocol::T_CALL, cseqid);
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
 
-  DataPageAccess_RpcFilePrefetch_pargs args;
-  args._fd = &_fd;
-  args._offset = &_offset;
-  args._amount = &_amount;
-  args.wait_event_info = &wait_event_info;
-  args.write(oprot_);
+  xfer += iprot->readStructEnd();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+  return xfer;
 }
 
-int32_t DataPageAccessClient::recv_RpcFilePrefetch()
-{
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+DataPageAccess_RpcXLogWrite_args::~DataPageAccess_RpcXLogWrite_args() noexcept {
+}
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcFilePrefetch") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  int32_t _return;
-  DataPageAccess_RpcFilePrefetch_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
-  }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFilePrefetch failed: unknown result");
-}
+uint32_t DataPageAccess_RpcXLogWrite_args::read(::apache::thrift::protocol::TProtocol* iprot) {
 
-void DataPageAccessClient::RpcFileWriteback(const _File _fd, const _Off_t _offset, const _Off_t nbytes, const int32_t wait_event_info)
-{
-  send_RpcFileWriteback(_fd, _offset, nbytes, wait_event_info);
-  recv_RpcFileWriteback();
-}
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
 
-void DataPageAccessClient::send_RpcFileWriteback(const _File _fd, const _Off_t _offset, const _Off_t nbytes, const int32_t wait_event_info)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcFileWriteback", ::apache::thrift::protocol::T_CALL, cseqid);
+  xfer += iprot->readStructBegin(fname);
 
-  DataPageAccess_RpcFileWriteback_pargs args;
-  args._fd = &_fd;
-  args._offset = &_offset;
-  args.nbytes = &nbytes;
-  args.wait_event_info = &wait_event_info;
-  args.write(oprot_);
+  using ::apache::thrift::protocol::TProtocolException;
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
 
-void DataPageAccessClient::recv_RpcFileWriteback()
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_fd);
+          this->__isset._fd = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->_page);
+          this->__isset._page = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_amount);
+          this->__isset._amount = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_offset);
+          this->__isset._offset = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 5:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->_xlblocks.clear();
+            uint32_t _size6;
+            ::apache::thrift::protocol::TType _etype9;
+            xfer += iprot->readListBegin(_etype9, _size6);
+            this->_xlblocks.resize(_size6);
+            uint32_t _i10;
+            for (_i10 = 0; _i10 < _size6; ++_i10)
+            {
+              xfer += iprot->readI64(this->_xlblocks[_i10]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset._xlblocks = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 6:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_blknum);
+          this->__isset._blknum = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 7:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_idx);
+          this->__isset._idx = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 8:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcXLogWrite_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogWrite_args");
+
+  xfer += oprot->writeFieldBegin("_fd", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32(this->_fd);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_page", ::apache::thrift::protocol::T_STRING, 2);
+  xfer += oprot->writeBinary(this->_page);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_amount", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_amount);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_offset", ::apache::thrift::protocol::T_I64, 4);
+  xfer += oprot->writeI64(this->_offset);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_xlblocks", ::apache::thrift::protocol::T_LIST, 5);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>(this->_xlblocks.size()));
+    std::vector<int64_t> ::const_iterator _iter11;
+    for (_iter11 = this->_xlblocks.begin(); _iter11 != this->_xlblocks.end(); ++_iter11)
+    {
+      xfer += oprot->writeI64((*_iter11));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknum", ::apache::thrift::protocol::T_I32, 6);
+  xfer += oprot->writeI32(this->_blknum);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_idx", ::apache::thrift::protocol::T_I32, 7);
+  xfer += oprot->writeI32(this->_idx);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 8);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcXLogWrite_pargs::~DataPageAccess_RpcXLogWrite_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcXLogWrite_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogWrite_pargs");
+
+  xfer += oprot->writeFieldBegin("_fd", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32((*(this->_fd)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_page", ::apache::thrift::protocol::T_STRING, 2);
+  xfer += oprot->writeBinary((*(this->_page)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_amount", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_amount)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_offset", ::apache::thrift::protocol::T_I64, 4);
+  xfer += oprot->writeI64((*(this->_offset)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_xlblocks", ::apache::thrift::protocol::T_LIST, 5);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>((*(this->_xlblocks)).size()));
+    std::vector<int64_t> ::const_iterator _iter12;
+    for (_iter12 = (*(this->_xlblocks)).begin(); _iter12 != (*(this->_xlblocks)).end(); ++_iter12)
+    {
+      xfer += oprot->writeI64((*_iter12));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknum", ::apache::thrift::protocol::T_I32, 6);
+  xfer += oprot->writeI32((*(this->_blknum)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_idx", ::apache::thrift::protocol::T_I32, 7);
+  xfer += oprot->writeI32((*(this->_idx)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 8);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcXLogWrite_result::~DataPageAccess_RpcXLogWrite_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcXLogWrite_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcXLogWrite_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogWrite_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcXLogWrite_presult::~DataPageAccess_RpcXLogWrite_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcXLogWrite_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+DataPageAccess_RpcXLogFileInit_args::~DataPageAccess_RpcXLogFileInit_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcXLogFileInit_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_logsegno);
+          this->__isset._logsegno = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_use_existent);
+          this->__isset._use_existent = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_use_lock);
+          this->__isset._use_lock = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcXLogFileInit_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogFileInit_args");
+
+  xfer += oprot->writeFieldBegin("_logsegno", ::apache::thrift::protocol::T_I64, 1);
+  xfer += oprot->writeI64(this->_logsegno);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_use_existent", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_use_existent);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_use_lock", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_use_lock);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcXLogFileInit_pargs::~DataPageAccess_RpcXLogFileInit_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcXLogFileInit_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogFileInit_pargs");
+
+  xfer += oprot->writeFieldBegin("_logsegno", ::apache::thrift::protocol::T_I64, 1);
+  xfer += oprot->writeI64((*(this->_logsegno)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_use_existent", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_use_existent)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_use_lock", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_use_lock)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcXLogFileInit_result::~DataPageAccess_RpcXLogFileInit_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcXLogFileInit_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->success.read(iprot);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcXLogFileInit_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcXLogFileInit_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_STRUCT, 0);
+    xfer += this->success.write(oprot);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcXLogFileInit_presult::~DataPageAccess_RpcXLogFileInit_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcXLogFileInit_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += (*(this->success)).read(iprot);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+DataPageAccess_ReadBufferBatch_args::~DataPageAccess_ReadBufferBatch_args() noexcept {
+}
+
+DataPageAccess_ReadRelationHeads_args::~DataPageAccess_ReadRelationHeads_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_ReadBufferBatch_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->_reln.read(iprot);
+          this->__isset._reln = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_relpersistence);
+          this->__isset._relpersistence = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_forknum);
+          this->__isset._forknum = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->_blknums.clear();
+            uint32_t _size13;
+            ::apache::thrift::protocol::TType _etype14;
+            xfer += iprot->readListBegin(_etype14, _size13);
+            this->_blknums.resize(_size13);
+            uint32_t _i15;
+            for (_i15 = 0; _i15 < _size13; ++_i15)
+            {
+              xfer += iprot->readI64(this->_blknums[_i15]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset._blknums = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 5:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_readBufferMode);
+          this->__isset._readBufferMode = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 6:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_ReadRelationHeads_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->_relns.clear();
+            uint32_t _size37;
+            ::apache::thrift::protocol::TType _etype40;
+            xfer += iprot->readListBegin(_etype40, _size37);
+            this->_relns.resize(_size37);
+            uint32_t _i41;
+            for (_i41 = 0; _i41 < _size37; ++_i41)
+            {
+              xfer += this->_relns[_i41].read(iprot);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset._relns = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_forknum);
+          this->__isset._forknum = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_max_blocks);
+          this->__isset._max_blocks = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_ReadBufferBatch_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_ReadBufferBatch_args");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += this->_reln.write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_relpersistence", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_relpersistence);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_forknum);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknums", ::apache::thrift::protocol::T_LIST, 4);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>(this->_blknums.size()));
+    std::vector<int64_t> ::const_iterator _iter16;
+    for (_iter16 = this->_blknums.begin(); _iter16 != this->_blknums.end(); ++_iter16)
+    {
+      xfer += oprot->writeI64((*_iter16));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_readBufferMode", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32(this->_readBufferMode);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_ReadRelationHeads_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_ReadRelationHeads_args");
+
+  xfer += oprot->writeFieldBegin("_relns", ::apache::thrift::protocol::T_LIST, 1);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRUCT, static_cast<uint32_t>(this->_relns.size()));
+    std::vector<_Smgr_Relation> ::const_iterator _iter42;
+    for (_iter42 = this->_relns.begin(); _iter42 != this->_relns.end(); ++_iter42)
+    {
+      xfer += (*_iter42).write(oprot);
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_forknum);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_max_blocks", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_max_blocks);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 4);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_ReadBufferBatch_pargs::~DataPageAccess_ReadBufferBatch_pargs() noexcept {
+}
+
+DataPageAccess_ReadRelationHeads_pargs::~DataPageAccess_ReadRelationHeads_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_ReadBufferBatch_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_ReadBufferBatch_pargs");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += (*(this->_reln)).write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_relpersistence", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_relpersistence)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_forknum)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknums", ::apache::thrift::protocol::T_LIST, 4);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>((*(this->_blknums)).size()));
+    std::vector<int64_t> ::const_iterator _iter17;
+    for (_iter17 = (*(this->_blknums)).begin(); _iter17 != (*(this->_blknums)).end(); ++_iter17)
+    {
+      xfer += oprot->writeI64((*_iter17));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_readBufferMode", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32((*(this->_readBufferMode)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_ReadRelationHeads_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_ReadRelationHeads_pargs");
+
+  xfer += oprot->writeFieldBegin("_relns", ::apache::thrift::protocol::T_LIST, 1);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRUCT, static_cast<uint32_t>((*(this->_relns)).size()));
+    std::vector<_Smgr_Relation> ::const_iterator _iter43;
+    for (_iter43 = (*(this->_relns)).begin(); _iter43 != (*(this->_relns)).end(); ++_iter43)
+    {
+      xfer += (*_iter43).write(oprot);
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_forknum)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_max_blocks", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_max_blocks)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 4);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_ReadBufferBatch_result::~DataPageAccess_ReadBufferBatch_result() noexcept {
+}
+
+DataPageAccess_ReadRelationHeads_result::~DataPageAccess_ReadRelationHeads_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_ReadBufferBatch_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->success.clear();
+            uint32_t _size18;
+            ::apache::thrift::protocol::TType _etype19;
+            xfer += iprot->readListBegin(_etype19, _size18);
+            this->success.resize(_size18);
+            uint32_t _i20;
+            for (_i20 = 0; _i20 < _size18; ++_i20)
+            {
+              xfer += iprot->readBinary(this->success[_i20]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_ReadRelationHeads_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->success.clear();
+            uint32_t _size18;
+            ::apache::thrift::protocol::TType _etype19;
+            xfer += iprot->readListBegin(_etype19, _size18);
+            this->success.resize(_size18);
+            uint32_t _i20;
+            for (_i20 = 0; _i20 < _size18; ++_i20)
+            {
+              xfer += iprot->readBinary(this->success[_i20]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_ReadBufferBatch_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_ReadBufferBatch_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_LIST, 0);
+    {
+      xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRING, static_cast<uint32_t>(this->success.size()));
+      std::vector<_Page> ::const_iterator _iter21;
+      for (_iter21 = this->success.begin(); _iter21 != this->success.end(); ++_iter21)
+      {
+        xfer += oprot->writeBinary((*_iter21));
+      }
+      xfer += oprot->writeListEnd();
+    }
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_ReadRelationHeads_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_ReadRelationHeads_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_LIST, 0);
+    {
+      xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRING, static_cast<uint32_t>(this->success.size()));
+      std::vector<_Page> ::const_iterator _iter21;
+      for (_iter21 = this->success.begin(); _iter21 != this->success.end(); ++_iter21)
+      {
+        xfer += oprot->writeBinary((*_iter21));
+      }
+      xfer += oprot->writeListEnd();
+    }
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_ReadBufferBatch_presult::~DataPageAccess_ReadBufferBatch_presult() noexcept {
+}
+
+DataPageAccess_ReadRelationHeads_presult::~DataPageAccess_ReadRelationHeads_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_ReadBufferBatch_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            (*(this->success)).clear();
+            uint32_t _size22;
+            ::apache::thrift::protocol::TType _etype23;
+            xfer += iprot->readListBegin(_etype23, _size22);
+            (*(this->success)).resize(_size22);
+            uint32_t _i24;
+            for (_i24 = 0; _i24 < _size22; ++_i24)
+            {
+              xfer += iprot->readBinary((*(this->success))[_i24]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_ReadRelationHeads_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            (*(this->success)).clear();
+            uint32_t _size22;
+            ::apache::thrift::protocol::TType _etype23;
+            xfer += iprot->readListBegin(_etype23, _size22);
+            (*(this->success)).resize(_size22);
+            uint32_t _i24;
+            for (_i24 = 0; _i24 < _size22; ++_i24)
+            {
+              xfer += iprot->readBinary((*(this->success))[_i24]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+DataPageAccess_ReadBufferIfModified_args::~DataPageAccess_ReadBufferIfModified_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_ReadBufferIfModified_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->_reln.read(iprot);
+          this->__isset._reln = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_relpersistence);
+          this->__isset._relpersistence = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_forknum);
+          this->__isset._forknum = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_blknum);
+          this->__isset._blknum = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 5:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_readBufferMode);
+          this->__isset._readBufferMode = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 6:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 7:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_cachedLsn);
+          this->__isset._cachedLsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_ReadBufferIfModified_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_ReadBufferIfModified_args");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += this->_reln.write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_relpersistence", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_relpersistence);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_forknum);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknum", ::apache::thrift::protocol::T_I32, 4);
+  xfer += oprot->writeI32(this->_blknum);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_readBufferMode", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32(this->_readBufferMode);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_cachedLsn", ::apache::thrift::protocol::T_I64, 7);
+  xfer += oprot->writeI64(this->_cachedLsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_ReadBufferIfModified_pargs::~DataPageAccess_ReadBufferIfModified_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_ReadBufferIfModified_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_ReadBufferIfModified_pargs");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += (*(this->_reln)).write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_relpersistence", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_relpersistence)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_forknum)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknum", ::apache::thrift::protocol::T_I32, 4);
+  xfer += oprot->writeI32((*(this->_blknum)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_readBufferMode", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32((*(this->_readBufferMode)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_cachedLsn", ::apache::thrift::protocol::T_I64, 7);
+  xfer += oprot->writeI64((*(this->_cachedLsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_ReadBufferIfModified_result::~DataPageAccess_ReadBufferIfModified_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_ReadBufferIfModified_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_ReadBufferIfModified_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_ReadBufferIfModified_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_STRING, 0);
+    xfer += oprot->writeBinary(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_ReadBufferIfModified_presult::~DataPageAccess_ReadBufferIfModified_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_ReadBufferIfModified_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+DataPageAccess_PrefetchBuffers_args::~DataPageAccess_PrefetchBuffers_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_PrefetchBuffers_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->_reln.read(iprot);
+          this->__isset._reln = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_forknum);
+          this->__isset._forknum = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->_blknums.clear();
+            uint32_t _size25;
+            ::apache::thrift::protocol::TType _etype26;
+            xfer += iprot->readListBegin(_etype26, _size25);
+            this->_blknums.resize(_size25);
+            uint32_t _i27;
+            for (_i27 = 0; _i27 < _size25; ++_i27)
+            {
+              xfer += iprot->readI64(this->_blknums[_i27]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset._blknums = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_PrefetchBuffers_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_PrefetchBuffers_args");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += this->_reln.write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_forknum);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknums", ::apache::thrift::protocol::T_LIST, 3);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>(this->_blknums.size()));
+    std::vector<int64_t> ::const_iterator _iter28;
+    for (_iter28 = this->_blknums.begin(); _iter28 != this->_blknums.end(); ++_iter28)
+    {
+      xfer += oprot->writeI64((*_iter28));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 4);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_PrefetchBuffers_pargs::~DataPageAccess_PrefetchBuffers_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_PrefetchBuffers_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_PrefetchBuffers_pargs");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += (*(this->_reln)).write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_forknum)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknums", ::apache::thrift::protocol::T_LIST, 3);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>((*(this->_blknums)).size()));
+    std::vector<int64_t> ::const_iterator _iter29;
+    for (_iter29 = (*(this->_blknums)).begin(); _iter29 != (*(this->_blknums)).end(); ++_iter29)
+    {
+      xfer += oprot->writeI64((*_iter29));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 4);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_PrefetchBuffers_result::~DataPageAccess_PrefetchBuffers_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_PrefetchBuffers_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_PrefetchBuffers_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_PrefetchBuffers_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_PrefetchBuffers_presult::~DataPageAccess_PrefetchBuffers_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_PrefetchBuffers_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+DataPageAccess_InstallPages_args::~DataPageAccess_InstallPages_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_InstallPages_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->_reln.read(iprot);
+          this->__isset._reln = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_forknum);
+          this->__isset._forknum = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->_blknums.clear();
+            uint32_t _size51;
+            ::apache::thrift::protocol::TType _etype52;
+            xfer += iprot->readListBegin(_etype52, _size51);
+            this->_blknums.resize(_size51);
+            uint32_t _i53;
+            for (_i53 = 0; _i53 < _size51; ++_i53)
+            {
+              xfer += iprot->readI64(this->_blknums[_i53]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset._blknums = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->_pages);
+          this->__isset._pages = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 5:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_InstallPages_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_InstallPages_args");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += this->_reln.write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_forknum);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknums", ::apache::thrift::protocol::T_LIST, 3);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>(this->_blknums.size()));
+    std::vector<int64_t> ::const_iterator _iter54;
+    for (_iter54 = this->_blknums.begin(); _iter54 != this->_blknums.end(); ++_iter54)
+    {
+      xfer += oprot->writeI64((*_iter54));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_pages", ::apache::thrift::protocol::T_STRING, 4);
+  xfer += oprot->writeBinary(this->_pages);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 5);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_InstallPages_pargs::~DataPageAccess_InstallPages_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_InstallPages_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_InstallPages_pargs");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += (*(this->_reln)).write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_forknum)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknums", ::apache::thrift::protocol::T_LIST, 3);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>((*(this->_blknums)).size()));
+    std::vector<int64_t> ::const_iterator _iter55;
+    for (_iter55 = (*(this->_blknums)).begin(); _iter55 != (*(this->_blknums)).end(); ++_iter55)
+    {
+      xfer += oprot->writeI64((*_iter55));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_pages", ::apache::thrift::protocol::T_STRING, 4);
+  xfer += oprot->writeBinary((*(this->_pages)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 5);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_InstallPages_result::~DataPageAccess_InstallPages_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_InstallPages_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_InstallPages_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_InstallPages_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_InstallPages_presult::~DataPageAccess_InstallPages_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_InstallPages_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+DataPageAccess_InstallEvictedPages_args::~DataPageAccess_InstallEvictedPages_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_InstallEvictedPages_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->_reln.read(iprot);
+          this->__isset._reln = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_forknum);
+          this->__isset._forknum = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->_blknums.clear();
+            uint32_t _size51;
+            ::apache::thrift::protocol::TType _etype52;
+            xfer += iprot->readListBegin(_etype52, _size51);
+            this->_blknums.resize(_size51);
+            uint32_t _i53;
+            for (_i53 = 0; _i53 < _size51; ++_i53)
+            {
+              xfer += iprot->readI64(this->_blknums[_i53]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset._blknums = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->_pages);
+          this->__isset._pages = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 5:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_InstallEvictedPages_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_InstallEvictedPages_args");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += this->_reln.write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_forknum);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknums", ::apache::thrift::protocol::T_LIST, 3);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>(this->_blknums.size()));
+    std::vector<int64_t> ::const_iterator _iter54;
+    for (_iter54 = this->_blknums.begin(); _iter54 != this->_blknums.end(); ++_iter54)
+    {
+      xfer += oprot->writeI64((*_iter54));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_pages", ::apache::thrift::protocol::T_STRING, 4);
+  xfer += oprot->writeBinary(this->_pages);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 5);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_InstallEvictedPages_pargs::~DataPageAccess_InstallEvictedPages_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_InstallEvictedPages_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_InstallEvictedPages_pargs");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += (*(this->_reln)).write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_forknum", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_forknum)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_blknums", ::apache::thrift::protocol::T_LIST, 3);
+  {
+    xfer += oprot->writeListBegin(::apache::thrift::protocol::T_I64, static_cast<uint32_t>((*(this->_blknums)).size()));
+    std::vector<int64_t> ::const_iterator _iter55;
+    for (_iter55 = (*(this->_blknums)).begin(); _iter55 != (*(this->_blknums)).end(); ++_iter55)
+    {
+      xfer += oprot->writeI64((*_iter55));
+    }
+    xfer += oprot->writeListEnd();
+  }
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_pages", ::apache::thrift::protocol::T_STRING, 4);
+  xfer += oprot->writeBinary((*(this->_pages)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 5);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_InstallEvictedPages_result::~DataPageAccess_InstallEvictedPages_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_InstallEvictedPages_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_InstallEvictedPages_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_InstallEvictedPages_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_InstallEvictedPages_presult::~DataPageAccess_InstallEvictedPages_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_InstallEvictedPages_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+DataPageAccess_RpcGetSmartReplayMetrics_args::~DataPageAccess_RpcGetSmartReplayMetrics_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcGetSmartReplayMetrics_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    xfer += iprot->skip(ftype);
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcGetSmartReplayMetrics_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcGetSmartReplayMetrics_args");
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcGetSmartReplayMetrics_pargs::~DataPageAccess_RpcGetSmartReplayMetrics_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcGetSmartReplayMetrics_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcGetSmartReplayMetrics_pargs");
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+DataPageAccess_RpcGetSmartReplayMetrics_result::~DataPageAccess_RpcGetSmartReplayMetrics_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcGetSmartReplayMetrics_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readString(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcGetSmartReplayMetrics_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcGetSmartReplayMetrics_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_STRING, 0);
+    xfer += oprot->writeString(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcGetSmartReplayMetrics_presult::~DataPageAccess_RpcGetSmartReplayMetrics_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcGetSmartReplayMetrics_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readString((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+DataPageAccess_RpcFetchPageChanges_args::~DataPageAccess_RpcFetchPageChanges_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcFetchPageChanges_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_max_entries);
+          this->__isset._max_entries = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_wait_ms);
+          this->__isset._wait_ms = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_from_seq);
+          this->__isset._from_seq = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcFetchPageChanges_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcFetchPageChanges_args");
+
+  xfer += oprot->writeFieldBegin("_max_entries", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32(this->_max_entries);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_wait_ms", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_wait_ms);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_from_seq", ::apache::thrift::protocol::T_I64, 3);
+  xfer += oprot->writeI64(this->_from_seq);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcFetchPageChanges_pargs::~DataPageAccess_RpcFetchPageChanges_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcFetchPageChanges_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcFetchPageChanges_pargs");
+
+  xfer += oprot->writeFieldBegin("_max_entries", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32((*(this->_max_entries)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_wait_ms", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_wait_ms)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_from_seq", ::apache::thrift::protocol::T_I64, 3);
+  xfer += oprot->writeI64((*(this->_from_seq)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcFetchPageChanges_result::~DataPageAccess_RpcFetchPageChanges_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcFetchPageChanges_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcFetchPageChanges_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcFetchPageChanges_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_STRING, 0);
+    xfer += oprot->writeBinary(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcFetchPageChanges_presult::~DataPageAccess_RpcFetchPageChanges_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcFetchPageChanges_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+DataPageAccess_RpcSecondaryNodeHeartbeat_args::~DataPageAccess_RpcSecondaryNodeHeartbeat_args() noexcept {
+}
+
+DataPageAccess_RpcWaitWalParsed_args::~DataPageAccess_RpcWaitWalParsed_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcSecondaryNodeHeartbeat_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_node_id);
+          this->__isset._node_id = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcWaitWalParsed_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_wait_ms);
+          this->__isset._wait_ms = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcSecondaryNodeHeartbeat_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSecondaryNodeHeartbeat_args");
+
+  xfer += oprot->writeFieldBegin("_node_id", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32(this->_node_id);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 2);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcWaitWalParsed_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcWaitWalParsed_args");
+
+  xfer += oprot->writeFieldBegin("_wait_ms", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32(this->_wait_ms);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 2);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcSecondaryNodeHeartbeat_pargs::~DataPageAccess_RpcSecondaryNodeHeartbeat_pargs() noexcept {
+}
+
+DataPageAccess_RpcWaitWalParsed_pargs::~DataPageAccess_RpcWaitWalParsed_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcSecondaryNodeHeartbeat_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSecondaryNodeHeartbeat_pargs");
+
+  xfer += oprot->writeFieldBegin("_node_id", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32((*(this->_node_id)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 2);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcWaitWalParsed_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcWaitWalParsed_pargs");
+
+  xfer += oprot->writeFieldBegin("_wait_ms", ::apache::thrift::protocol::T_I32, 1);
+  xfer += oprot->writeI32((*(this->_wait_ms)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 2);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcSecondaryNodeHeartbeat_result::~DataPageAccess_RpcSecondaryNodeHeartbeat_result() noexcept {
+}
+
+DataPageAccess_RpcWaitWalParsed_result::~DataPageAccess_RpcWaitWalParsed_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcSecondaryNodeHeartbeat_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcWaitWalParsed_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcSecondaryNodeHeartbeat_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcSecondaryNodeHeartbeat_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I32, 0);
+    xfer += oprot->writeI32(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcWaitWalParsed_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_RpcWaitWalParsed_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_I64, 0);
+    xfer += oprot->writeI64(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_RpcSecondaryNodeHeartbeat_presult::~DataPageAccess_RpcSecondaryNodeHeartbeat_presult() noexcept {
+}
+
+DataPageAccess_RpcWaitWalParsed_presult::~DataPageAccess_RpcWaitWalParsed_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_RpcSecondaryNodeHeartbeat_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_RpcWaitWalParsed_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+DataPageAccess_ScanRelation_args::~DataPageAccess_ScanRelation_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_ScanRelation_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->_reln.read(iprot);
+          this->__isset._reln = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_first_block);
+          this->__isset._first_block = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_end_block);
+          this->__isset._end_block = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->_qual);
+          this->__isset._qual = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 5:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_max_pages);
+          this->__isset._max_pages = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 6:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_ScanRelation_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_ScanRelation_args");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += this->_reln.write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_first_block", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_first_block);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_end_block", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_end_block);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_qual", ::apache::thrift::protocol::T_STRING, 4);
+  xfer += oprot->writeBinary(this->_qual);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_max_pages", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32(this->_max_pages);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_ScanRelation_pargs::~DataPageAccess_ScanRelation_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_ScanRelation_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_ScanRelation_pargs");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += (*(this->_reln)).write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_first_block", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_first_block)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_end_block", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_end_block)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_qual", ::apache::thrift::protocol::T_STRING, 4);
+  xfer += oprot->writeBinary((*(this->_qual)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_max_pages", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32((*(this->_max_pages)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_ScanRelation_result::~DataPageAccess_ScanRelation_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_ScanRelation_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            this->success.clear();
+            uint32_t _size44;
+            ::apache::thrift::protocol::TType _etype45;
+            xfer += iprot->readListBegin(_etype45, _size44);
+            this->success.resize(_size44);
+            uint32_t _i46;
+            for (_i46 = 0; _i46 < _size44; ++_i46)
+            {
+              xfer += iprot->readBinary(this->success[_i46]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_ScanRelation_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_ScanRelation_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_LIST, 0);
+    {
+      xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRING, static_cast<uint32_t>(this->success.size()));
+      std::vector<_Page> ::const_iterator _iter47;
+      for (_iter47 = this->success.begin(); _iter47 != this->success.end(); ++_iter47)
+      {
+        xfer += oprot->writeBinary((*_iter47));
+      }
+      xfer += oprot->writeListEnd();
+    }
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_ScanRelation_presult::~DataPageAccess_ScanRelation_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_ScanRelation_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_LIST) {
+          {
+            (*(this->success)).clear();
+            uint32_t _size48;
+            ::apache::thrift::protocol::TType _etype49;
+            xfer += iprot->readListBegin(_etype49, _size48);
+            (*(this->success)).resize(_size48);
+            uint32_t _i50;
+            for (_i50 = 0; _i50 < _size48; ++_i50)
+            {
+              xfer += iprot->readBinary((*(this->success))[_i50]);
+            }
+            xfer += iprot->readListEnd();
+          }
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+DataPageAccess_AggregateRelation_args::~DataPageAccess_AggregateRelation_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_AggregateRelation_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->_reln.read(iprot);
+          this->__isset._reln = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_first_block);
+          this->__isset._first_block = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_end_block);
+          this->__isset._end_block = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->_spec);
+          this->__isset._spec = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 5:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_max_fallback);
+          this->__isset._max_fallback = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 6:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_AggregateRelation_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_AggregateRelation_args");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += this->_reln.write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_first_block", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_first_block);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_end_block", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_end_block);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_spec", ::apache::thrift::protocol::T_STRING, 4);
+  xfer += oprot->writeBinary(this->_spec);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_max_fallback", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32(this->_max_fallback);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_AggregateRelation_pargs::~DataPageAccess_AggregateRelation_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_AggregateRelation_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_AggregateRelation_pargs");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += (*(this->_reln)).write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_first_block", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_first_block)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_end_block", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_end_block)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_spec", ::apache::thrift::protocol::T_STRING, 4);
+  xfer += oprot->writeBinary((*(this->_spec)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_max_fallback", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32((*(this->_max_fallback)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_AggregateRelation_result::~DataPageAccess_AggregateRelation_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_AggregateRelation_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_AggregateRelation_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_AggregateRelation_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_STRING, 0);
+    xfer += oprot->writeBinary(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_AggregateRelation_presult::~DataPageAccess_AggregateRelation_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_AggregateRelation_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+DataPageAccess_TriageVacuum_args::~DataPageAccess_TriageVacuum_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_TriageVacuum_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 1:
+        if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+          xfer += this->_reln.read(iprot);
+          this->__isset._reln = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 2:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_first_block);
+          this->__isset._first_block = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 3:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_end_block);
+          this->__isset._end_block = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 4:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->_horizon);
+          this->__isset._horizon = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 5:
+        if (ftype == ::apache::thrift::protocol::T_I32) {
+          xfer += iprot->readI32(this->_max_dead);
+          this->__isset._max_dead = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      case 6:
+        if (ftype == ::apache::thrift::protocol::T_I64) {
+          xfer += iprot->readI64(this->_lsn);
+          this->__isset._lsn = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_TriageVacuum_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_TriageVacuum_args");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += this->_reln.write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_first_block", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32(this->_first_block);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_end_block", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32(this->_end_block);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_horizon", ::apache::thrift::protocol::T_STRING, 4);
+  xfer += oprot->writeBinary(this->_horizon);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_max_dead", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32(this->_max_dead);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64(this->_lsn);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_TriageVacuum_pargs::~DataPageAccess_TriageVacuum_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_TriageVacuum_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_TriageVacuum_pargs");
+
+  xfer += oprot->writeFieldBegin("_reln", ::apache::thrift::protocol::T_STRUCT, 1);
+  xfer += (*(this->_reln)).write(oprot);
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_first_block", ::apache::thrift::protocol::T_I32, 2);
+  xfer += oprot->writeI32((*(this->_first_block)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_end_block", ::apache::thrift::protocol::T_I32, 3);
+  xfer += oprot->writeI32((*(this->_end_block)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_horizon", ::apache::thrift::protocol::T_STRING, 4);
+  xfer += oprot->writeBinary((*(this->_horizon)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_max_dead", ::apache::thrift::protocol::T_I32, 5);
+  xfer += oprot->writeI32((*(this->_max_dead)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldBegin("_lsn", ::apache::thrift::protocol::T_I64, 6);
+  xfer += oprot->writeI64((*(this->_lsn)));
+  xfer += oprot->writeFieldEnd();
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_TriageVacuum_result::~DataPageAccess_TriageVacuum_result() noexcept {
+}
+
+
+uint32_t DataPageAccess_TriageVacuum_result::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary(this->success);
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_TriageVacuum_result::write(::apache::thrift::protocol::TProtocol* oprot) const {
+
+  uint32_t xfer = 0;
+
+  xfer += oprot->writeStructBegin("DataPageAccess_TriageVacuum_result");
+
+  if (this->__isset.success) {
+    xfer += oprot->writeFieldBegin("success", ::apache::thrift::protocol::T_STRING, 0);
+    xfer += oprot->writeBinary(this->success);
+    xfer += oprot->writeFieldEnd();
+  }
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_TriageVacuum_presult::~DataPageAccess_TriageVacuum_presult() noexcept {
+}
+
+
+uint32_t DataPageAccess_TriageVacuum_presult::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    switch (fid)
+    {
+      case 0:
+        if (ftype == ::apache::thrift::protocol::T_STRING) {
+          xfer += iprot->readBinary((*(this->success)));
+          this->__isset.success = true;
+        } else {
+          xfer += iprot->skip(ftype);
+        }
+        break;
+      default:
+        xfer += iprot->skip(ftype);
+        break;
+    }
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+
+DataPageAccess_zip_args::~DataPageAccess_zip_args() noexcept {
+}
+
+
+uint32_t DataPageAccess_zip_args::read(::apache::thrift::protocol::TProtocol* iprot) {
+
+  ::apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+  uint32_t xfer = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TType ftype;
+  int16_t fid;
+
+  xfer += iprot->readStructBegin(fname);
+
+  using ::apache::thrift::protocol::TProtocolException;
+
+
+  while (true)
+  {
+    xfer += iprot->readFieldBegin(fname, ftype, fid);
+    if (ftype == ::apache::thrift::protocol::T_STOP) {
+      break;
+    }
+    xfer += iprot->skip(ftype);
+    xfer += iprot->readFieldEnd();
+  }
+
+  xfer += iprot->readStructEnd();
+
+  return xfer;
+}
+
+uint32_t DataPageAccess_zip_args::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_zip_args");
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+
+DataPageAccess_zip_pargs::~DataPageAccess_zip_pargs() noexcept {
+}
+
+
+uint32_t DataPageAccess_zip_pargs::write(::apache::thrift::protocol::TProtocol* oprot) const {
+  uint32_t xfer = 0;
+  ::apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+  xfer += oprot->writeStructBegin("DataPageAccess_zip_pargs");
+
+  xfer += oprot->writeFieldStop();
+  xfer += oprot->writeStructEnd();
+  return xfer;
+}
+
+void DataPageAccessClient::ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId)
+{
+  send_ReadBufferCommon(_reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn, _traceId);
+  recv_ReadBufferCommon(_return);
+}
+
+void DataPageAccessClient::send_ReadBufferCommon(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("ReadBufferCommon", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_ReadBufferCommon_pargs args;
+  args._reln = &_reln;
+  args._relpersistence = &_relpersistence;
+  args._forknum = &_forknum;
+  args._blknum = &_blknum;
+  args._readBufferMode = &_readBufferMode;
+  args._lsn = &_lsn;
+  args._traceId = &_traceId;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_ReadBufferCommon(_Page& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("ReadBufferCommon") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_ReadBufferCommon_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ReadBufferCommon failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn)
+{
+  send_RpcRegisterSecondaryNode(_primary, _lsn);
+  return recv_RpcRegisterSecondaryNode();
+}
+
+void DataPageAccessClient::send_RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcRegisterSecondaryNode", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcRegisterSecondaryNode_pargs args;
+  args._primary = &_primary;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcRegisterSecondaryNode()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcRegisterSecondaryNode") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcRegisterSecondaryNode_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcRegisterSecondaryNode failed: unknown result");
+}
+
+void DataPageAccessClient::RpcSecondaryNodeUpdatesLsn(const int32_t _node_id, const int64_t _lsn)
+{
+  send_RpcSecondaryNodeUpdatesLsn(_node_id, _lsn);
+  recv_RpcSecondaryNodeUpdatesLsn();
+}
+
+void DataPageAccessClient::send_RpcSecondaryNodeUpdatesLsn(const int32_t _node_id, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcSecondaryNodeUpdatesLsn", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcSecondaryNodeUpdatesLsn_pargs args;
+  args._node_id = &_node_id;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcSecondaryNodeUpdatesLsn()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcSecondaryNodeUpdatesLsn") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcSecondaryNodeUpdatesLsn_presult result;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  return;
+}
+
+void DataPageAccessClient::RpcMdRead(_Page& _return, const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _blknum, const int64_t _lsn)
+{
+  send_RpcMdRead(_reln, _forknum, _blknum, _lsn);
+  recv_RpcMdRead(_return);
+}
+
+void DataPageAccessClient::send_RpcMdRead(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _blknum, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcMdRead", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcMdRead_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknum = &_blknum;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcMdRead(_Page& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcMdRead") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcMdRead_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdRead failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcMdNblocks(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
+{
+  send_RpcMdNblocks(_reln, _forknum, _lsn);
+  return recv_RpcMdNblocks();
+}
+
+void DataPageAccessClient::send_RpcMdNblocks(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcMdNblocks", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcMdNblocks_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcMdNblocks()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcMdNblocks") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcMdNblocks_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdNblocks failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcMdExists(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
+{
+  send_RpcMdExists(_reln, _forknum, _lsn);
+  return recv_RpcMdExists();
+}
+
+void DataPageAccessClient::send_RpcMdExists(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcMdExists", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcMdExists_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcMdExists()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcMdExists") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcMdExists_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdExists failed: unknown result");
+}
+
+void DataPageAccessClient::RpcMdCreate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _isRedo, const int64_t _lsn)
+{
+  send_RpcMdCreate(_reln, _forknum, _isRedo, _lsn);
+  recv_RpcMdCreate();
+}
+
+void DataPageAccessClient::send_RpcMdCreate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _isRedo, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcMdCreate", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcMdCreate_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._isRedo = &_isRedo;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcMdCreate()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcMdCreate") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcMdCreate_presult result;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  return;
+}
+
+void DataPageAccessClient::RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn)
+{
+  send_RpcMdExtend(_reln, _forknum, _blknum, _buff, skipFsync, _lsn);
+  recv_RpcMdExtend();
+}
+
+void DataPageAccessClient::RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn)
+{
+  send_RpcMdExtendMany(_reln, _forknum, _startblk, _nblocks, skipFsync, _lsn);
+  recv_RpcMdExtendMany();
+}
+
+void DataPageAccessClient::send_RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcMdExtend", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcMdExtend_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknum = &_blknum;
+  args._buff = &_buff;
+  args.skipFsync = &skipFsync;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::send_RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcMdExtendMany", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcMdExtendMany_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._startblk = &_startblk;
+  args._nblocks = &_nblocks;
+  args.skipFsync = &skipFsync;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcMdExtend()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcMdExtend") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcMdExtend_presult result;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  return;
+}
+
+void DataPageAccessClient::recv_RpcMdExtendMany()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcMdExtendMany") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcMdExtendMany_presult result;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  return;
+}
+
+void DataPageAccessClient::RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn)
+{
+  send_RpcTruncate(_reln, _forknum, _blknum, _lsn);
+  recv_RpcTruncate();
+}
+
+void DataPageAccessClient::send_RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcTruncate", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcTruncate_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknum = &_blknum;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcTruncate()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcTruncate") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcTruncate_presult result;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  return;
+}
+
+void DataPageAccessClient::RpcFileClose(const _File _fd)
+{
+  send_RpcFileClose(_fd);
+  recv_RpcFileClose();
+}
+
+void DataPageAccessClient::send_RpcFileClose(const _File _fd)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcFileClose", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFileClose_pargs args;
+  args._fd = &_fd;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcFileClose()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcFileClose") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcFileClose_presult result;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  return;
+}
+
+void DataPageAccessClient::RpcTablespaceCreateDbspace(const _Oid _spcnode, const _Oid _dbnode, const bool isRedo)
+{
+  send_RpcTablespaceCreateDbspace(_spcnode, _dbnode, isRedo);
+  recv_RpcTablespaceCreateDbspace();
+}
+
+void DataPageAccessClient::send_RpcTablespaceCreateDbspace(const _Oid _spcnode, const _Oid _dbnode, const bool isRedo)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcTablespaceCreateDbspace", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcTablespaceCreateDbspace_pargs args;
+  args._spcnode = &_spcnode;
+  args._dbnode = &_dbnode;
+  args.isRedo = &isRedo;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcTablespaceCreateDbspace()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcTablespaceCreateDbspace") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcTablespaceCreateDbspace_presult result;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  return;
+}
+
+_File DataPageAccessClient::RpcPathNameOpenFile(const _Path& _path, const _Flag _flag)
+{
+  send_RpcPathNameOpenFile(_path, _flag);
+  return recv_RpcPathNameOpenFile();
+}
+
+void DataPageAccessClient::send_RpcPathNameOpenFile(const _Path& _path, const _Flag _flag)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcPathNameOpenFile", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcPathNameOpenFile_pargs args;
+  args._path = &_path;
+  args._flag = &_flag;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+_File DataPageAccessClient::recv_RpcPathNameOpenFile()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcPathNameOpenFile") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  _File _return;
+  DataPageAccess_RpcPathNameOpenFile_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPathNameOpenFile failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcFileWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
+{
+  send_RpcFileWrite(_fd, _page, _amount, _seekpos, _wait_event_info);
+  return recv_RpcFileWrite();
+}
+
+void DataPageAccessClient::send_RpcFileWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcFileWrite", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFileWrite_pargs args;
+  args._fd = &_fd;
+  args._page = &_page;
+  args._amount = &_amount;
+  args._seekpos = &_seekpos;
+  args._wait_event_info = &_wait_event_info;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcFileWrite()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcFileWrite") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcFileWrite_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileWrite failed: unknown result");
+}
+
+void DataPageAccessClient::RpcFilePathName(_Path& _return, const _File _fd)
+{
+  send_RpcFilePathName(_fd);
+  recv_RpcFilePathName(_return);
+}
+
+void DataPageAccessClient::send_RpcFilePathName(const _File _fd)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcFilePathName", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFilePathName_pargs args;
+  args._fd = &_fd;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcFilePathName(_Path& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcFilePathName") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcFilePathName_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFilePathName failed: unknown result");
+}
+
+void DataPageAccessClient::RpcFileRead(_Page& _return, const _File _fd, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
+{
+  send_RpcFileRead(_fd, _amount, _seekpos, _wait_event_info);
+  recv_RpcFileRead(_return);
+}
+
+void DataPageAccessClient::send_RpcFileRead(const _File _fd, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcFileRead", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFileRead_pargs args;
+  args._fd = &_fd;
+  args._amount = &_amount;
+  args._seekpos = &_seekpos;
+  args._wait_event_info = &_wait_event_info;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcFileRead(_Page& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcFileRead") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcFileRead_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileRead failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcFileTruncate(const _File _fd, const _Off_t _offset)
+{
+  send_RpcFileTruncate(_fd, _offset);
+  return recv_RpcFileTruncate();
+}
+
+void DataPageAccessClient::send_RpcFileTruncate(const _File _fd, const _Off_t _offset)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcFileTruncate", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFileTruncate_pargs args;
+  args._fd = &_fd;
+  args._offset = &_offset;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcFileTruncate()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcFileTruncate") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcFileTruncate_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileTruncate failed: unknown result");
+}
+
+_Off_t DataPageAccessClient::RpcFileSize(const _File _fd)
+{
+  send_RpcFileSize(_fd);
+  return recv_RpcFileSize();
+}
+
+void DataPageAccessClient::send_RpcFileSize(const _File _fd)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcFileSize", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFileSize_pargs args;
+  args._fd = &_fd;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+_Off_t DataPageAccessClient::recv_RpcFileSize()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcFileSize") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  _Off_t _return;
+  DataPageAccess_RpcFileSize_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileSize failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcFilePrefetch(const _File _fd, const _Off_t _offset, const int32_t _amount, const int32_t wait_event_info)
+{
+  send_RpcFilePrefetch(_fd, _offset, _amount, wait_event_info);
+  return recv_RpcFilePrefetch();
+}
+
+void DataPageAccessClient::send_RpcFilePrefetch(const _File _fd, const _Off_t _offset, const int32_t _amount, const int32_t wait_event_info)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcFilePrefetch", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFilePrefetch_pargs args;
+  args._fd = &_fd;
+  args._offset = &_offset;
+  args._amount = &_amount;
+  args.wait_event_info = &wait_event_info;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcFilePrefetch()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcFilePrefetch") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcFilePrefetch_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFilePrefetch failed: unknown result");
+}
+
+void DataPageAccessClient::RpcFileWriteback(const _File _fd, const _Off_t _offset, const _Off_t nbytes, const int32_t wait_event_info)
+{
+  send_RpcFileWriteback(_fd, _offset, nbytes, wait_event_info);
+  recv_RpcFileWriteback();
+}
+
+void DataPageAccessClient::send_RpcFileWriteback(const _File _fd, const _Off_t _offset, const _Off_t nbytes, const int32_t wait_event_info)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcFileWriteback", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFileWriteback_pargs args;
+  args._fd = &_fd;
+  args._offset = &_offset;
+  args.nbytes = &nbytes;
+  args.wait_event_info = &wait_event_info;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcFileWriteback()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcFileWriteback") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcFileWriteback_presult result;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  return;
+}
+
+int32_t DataPageAccessClient::RpcUnlink(const _Path& _path)
+{
+  send_RpcUnlink(_path);
+  return recv_RpcUnlink();
+}
+
+void DataPageAccessClient::send_RpcUnlink(const _Path& _path)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcUnlink", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcUnlink_pargs args;
+  args._path = &_path;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcUnlink()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcUnlink") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcUnlink_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcUnlink failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcFtruncate(const _File _fd, const _Off_t _offset)
+{
+  send_RpcFtruncate(_fd, _offset);
+  return recv_RpcFtruncate();
+}
+
+void DataPageAccessClient::send_RpcFtruncate(const _File _fd, const _Off_t _offset)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcFtruncate", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFtruncate_pargs args;
+  args._fd = &_fd;
+  args._offset = &_offset;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcFtruncate()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcFtruncate") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcFtruncate_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFtruncate failed: unknown result");
+}
+
+void DataPageAccessClient::RpcInitFile(_Page& _return, const _Path& _path)
+{
+  send_RpcInitFile(_path);
+  recv_RpcInitFile(_return);
+}
+
+void DataPageAccessClient::RpcOpenAndReadFile(_Page& _return, const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient)
+{
+  send_RpcOpenAndReadFile(_path, _flags, _amount, _transient);
+  recv_RpcOpenAndReadFile(_return);
+}
+
+void DataPageAccessClient::send_RpcInitFile(const _Path& _path)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcInitFile", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcInitFile_pargs args;
+  args._path = &_path;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::send_RpcOpenAndReadFile(const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcOpenAndReadFile", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcOpenAndReadFile_pargs args;
+  args._path = &_path;
+  args._flags = &_flags;
+  args._amount = &_amount;
+  args._transient = &_transient;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcInitFile(_Page& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcInitFile") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcInitFile_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcInitFile failed: unknown result");
+}
+
+void DataPageAccessClient::recv_RpcOpenAndReadFile(_Page& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcOpenAndReadFile") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcOpenAndReadFile_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcOpenAndReadFile failed: unknown result");
+}
+
+_File DataPageAccessClient::RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags)
+{
+  send_RpcOpenTransientFile(_filename, _fileflags);
+  return recv_RpcOpenTransientFile();
+}
+
+void DataPageAccessClient::send_RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcOpenTransientFile", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcOpenTransientFile_pargs args;
+  args._filename = &_filename;
+  args._fileflags = &_fileflags;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+_File DataPageAccessClient::recv_RpcOpenTransientFile()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcOpenTransientFile") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  _File _return;
+  DataPageAccess_RpcOpenTransientFile_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcOpenTransientFile failed: unknown result");
+}
+
+_File DataPageAccessClient::RpcOpenTransientFileUnderPgData(const _Path& _filename, const int32_t _fileflags)
+{
+  send_RpcOpenTransientFileUnderPgData(_filename, _fileflags);
+  return recv_RpcOpenTransientFileUnderPgData();
+}
+
+void DataPageAccessClient::send_RpcOpenTransientFileUnderPgData(const _Path& _filename, const int32_t _fileflags)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcOpenTransientFileUnderPgData", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcOpenTransientFileUnderPgData_pargs args;
+  args._filename = &_filename;
+  args._fileflags = &_fileflags;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+_File DataPageAccessClient::recv_RpcOpenTransientFileUnderPgData()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcOpenTransientFileUnderPgData") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  _File _return;
+  DataPageAccess_RpcOpenTransientFileUnderPgData_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcOpenTransientFileUnderPgData failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcCloseTransientFile(const _File _fd)
+{
+  send_RpcCloseTransientFile(_fd);
+  return recv_RpcCloseTransientFile();
+}
+
+void DataPageAccessClient::send_RpcCloseTransientFile(const _File _fd)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcCloseTransientFile", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcCloseTransientFile_pargs args;
+  args._fd = &_fd;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcCloseTransientFile()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcCloseTransientFile") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcCloseTransientFile_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcCloseTransientFile failed: unknown result");
+}
+
+void DataPageAccessClient::Rpcread(_Page& _return, const _File _fd, const int32_t size)
+{
+  send_Rpcread(_fd, size);
+  recv_Rpcread(_return);
+}
+
+void DataPageAccessClient::send_Rpcread(const _File _fd, const int32_t size)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("Rpcread", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_Rpcread_pargs args;
+  args._fd = &_fd;
+  args.size = &size;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_Rpcread(_Page& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("Rpcread") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_Rpcread_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "Rpcread failed: unknown result");
+}
+
+int32_t DataPageAccessClient::Rpcwrite(const _File _fd, const _Page& _page, const int32_t size)
+{
+  send_Rpcwrite(_fd, _page, size);
+  return recv_Rpcwrite();
+}
+
+void DataPageAccessClient::send_Rpcwrite(const _File _fd, const _Page& _page, const int32_t size)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("Rpcwrite", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_Rpcwrite_pargs args;
+  args._fd = &_fd;
+  args._page = &_page;
+  args.size = &size;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_Rpcwrite()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("Rpcwrite") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_Rpcwrite_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "Rpcwrite failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcFileSync(const _File _fd, const int32_t _wait_event_info)
+{
+  send_RpcFileSync(_fd, _wait_event_info);
+  return recv_RpcFileSync();
+}
+
+void DataPageAccessClient::send_RpcFileSync(const _File _fd, const int32_t _wait_event_info)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcFileSync", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFileSync_pargs args;
+  args._fd = &_fd;
+  args._wait_event_info = &_wait_event_info;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcFileSync()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcFileSync") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcFileSync_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileSync failed: unknown result");
+}
+
+void DataPageAccessClient::RpcPgPRead(_Page& _return, const _File _fd, const int32_t _seg_bytes, const _Off_t _start_off)
+{
+  send_RpcPgPRead(_fd, _seg_bytes, _start_off);
+  recv_RpcPgPRead(_return);
+}
+
+void DataPageAccessClient::send_RpcPgPRead(const _File _fd, const int32_t _seg_bytes, const _Off_t _start_off)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcPgPRead", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcPgPRead_pargs args;
+  args._fd = &_fd;
+  args._seg_bytes = &_seg_bytes;
+  args._start_off = &_start_off;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcPgPRead(_Page& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcPgPRead") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcPgPRead_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgPRead failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcPgPWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset)
+{
+  send_RpcPgPWrite(_fd, _page, _amount, _offset);
+  return recv_RpcPgPWrite();
+}
+
+void DataPageAccessClient::send_RpcPgPWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcPgPWrite", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcPgPWrite_pargs args;
+  args._fd = &_fd;
+  args._page = &_page;
+  args._amount = &_amount;
+  args._offset = &_offset;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcPgPWrite()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcPgPWrite") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcPgPWrite_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgPWrite failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcClose(const _File _fd)
+{
+  send_RpcClose(_fd);
+  return recv_RpcClose();
+}
+
+void DataPageAccessClient::send_RpcClose(const _File _fd)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcClose", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcClose_pargs args;
+  args._fd = &_fd;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcClose()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcClose") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcClose_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcClose failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcBasicOpenFile(const _Path& _path, const int32_t _flags)
+{
+  send_RpcBasicOpenFile(_path, _flags);
+  return recv_RpcBasicOpenFile();
+}
+
+void DataPageAccessClient::send_RpcBasicOpenFile(const _Path& _path, const int32_t _flags)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcBasicOpenFile", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcBasicOpenFile_pargs args;
+  args._path = &_path;
+  args._flags = &_flags;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcBasicOpenFile()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcBasicOpenFile") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcBasicOpenFile_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcBasicOpenFile failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcBasicOpenFileUnderPgData(const _Path& _path, const int32_t _flags)
+{
+  send_RpcBasicOpenFileUnderPgData(_path, _flags);
+  return recv_RpcBasicOpenFileUnderPgData();
+}
+
+void DataPageAccessClient::send_RpcBasicOpenFileUnderPgData(const _Path& _path, const int32_t _flags)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcBasicOpenFileUnderPgData", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcBasicOpenFileUnderPgData_pargs args;
+  args._path = &_path;
+  args._flags = &_flags;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcBasicOpenFileUnderPgData()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcBasicOpenFileUnderPgData") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcBasicOpenFileUnderPgData_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcBasicOpenFileUnderPgData failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcPgFdatasync(const _File _fd)
+{
+  send_RpcPgFdatasync(_fd);
+  return recv_RpcPgFdatasync();
+}
+
+void DataPageAccessClient::send_RpcPgFdatasync(const _File _fd)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcPgFdatasync", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcPgFdatasync_pargs args;
+  args._fd = &_fd;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcPgFdatasync()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcPgFdatasync") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcPgFdatasync_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFdatasync failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcPgFsyncNoWritethrough(const _File _fd)
+{
+  send_RpcPgFsyncNoWritethrough(_fd);
+  return recv_RpcPgFsyncNoWritethrough();
+}
+
+void DataPageAccessClient::send_RpcPgFsyncNoWritethrough(const _File _fd)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcPgFsyncNoWritethrough", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcPgFsyncNoWritethrough_pargs args;
+  args._fd = &_fd;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcPgFsyncNoWritethrough()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcPgFsyncNoWritethrough") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcPgFsyncNoWritethrough_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFsyncNoWritethrough failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcLseek(const int32_t _fd, const _Off_t _offset, const int32_t _flag)
+{
+  send_RpcLseek(_fd, _offset, _flag);
+  return recv_RpcLseek();
+}
+
+void DataPageAccessClient::send_RpcLseek(const int32_t _fd, const _Off_t _offset, const int32_t _flag)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcLseek", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcLseek_pargs args;
+  args._fd = &_fd;
+  args._offset = &_offset;
+  args._flag = &_flag;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcLseek()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcLseek") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcLseek_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcLseek failed: unknown result");
+}
+
+void DataPageAccessClient::RpcStat(_Stat_Resp& _return, const _Path& _path)
+{
+  send_RpcStat(_path);
+  recv_RpcStat(_return);
+}
+
+void DataPageAccessClient::send_RpcStat(const _Path& _path)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcStat", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcStat_pargs args;
+  args._path = &_path;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcStat(_Stat_Resp& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcStat") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcStat_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcStat failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcDirectoryIsEmpty(const _Path& _path)
+{
+  send_RpcDirectoryIsEmpty(_path);
+  return recv_RpcDirectoryIsEmpty();
+}
+
+int32_t DataPageAccessClient::RpcSyncFiles(const std::vector<_Path> & _paths)
+{
+  send_RpcSyncFiles(_paths);
+  return recv_RpcSyncFiles();
+}
+
+int32_t DataPageAccessClient::RpcAttachSharedMemory(const _Path& _name)
+{
+  send_RpcAttachSharedMemory(_name);
+  return recv_RpcAttachSharedMemory();
+}
+
+int32_t DataPageAccessClient::RpcPublishResidentPages(const _Page& _summary)
+{
+  send_RpcPublishResidentPages(_summary);
+  return recv_RpcPublishResidentPages();
+}
+
+void DataPageAccessClient::send_RpcDirectoryIsEmpty(const _Path& _path)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcDirectoryIsEmpty", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcDirectoryIsEmpty_pargs args;
+  args._path = &_path;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::send_RpcSyncFiles(const std::vector<_Path> & _paths)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcSyncFiles", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcSyncFiles_pargs args;
+  args._paths = &_paths;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::send_RpcAttachSharedMemory(const _Path& _name)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcAttachSharedMemory", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcAttachSharedMemory_pargs args;
+  args._name = &_name;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::send_RpcPublishResidentPages(const _Page& _summary)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcPublishResidentPages", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcPublishResidentPages_pargs args;
+  args._summary = &_summary;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcDirectoryIsEmpty()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcDirectoryIsEmpty") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcDirectoryIsEmpty_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDirectoryIsEmpty failed: unknown result");
+}
+
+int32_t DataPageAccessClient::recv_RpcSyncFiles()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcSyncFiles") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcSyncFiles_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcSyncFiles failed: unknown result");
+}
+
+int32_t DataPageAccessClient::recv_RpcAttachSharedMemory()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcAttachSharedMemory") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcAttachSharedMemory_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcAttachSharedMemory failed: unknown result");
+}
+
+int32_t DataPageAccessClient::recv_RpcPublishResidentPages()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcPublishResidentPages") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcPublishResidentPages_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPublishResidentPages failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcCopyDir(const _Path& _src, const _Path& _dst)
+{
+  send_RpcCopyDir(_src, _dst);
+  return recv_RpcCopyDir();
+}
+
+void DataPageAccessClient::send_RpcCopyDir(const _Path& _src, const _Path& _dst)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcCopyDir", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcCopyDir_pargs args;
+  args._src = &_src;
+  args._dst = &_dst;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcCopyDir()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcCopyDir") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcCopyDir_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcCopyDir failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcPgFsync(const int32_t _fd)
+{
+  send_RpcPgFsync(_fd);
+  return recv_RpcPgFsync();
+}
+
+int32_t DataPageAccessClient::RpcSetPageCompression(const int32_t _method)
+{
+  send_RpcSetPageCompression(_method);
+  return recv_RpcSetPageCompression();
+}
+
+int32_t DataPageAccessClient::RpcSetRequestClass(const int32_t _requestClass)
+{
+  send_RpcSetRequestClass(_requestClass);
+  return recv_RpcSetRequestClass();
+}
+
+int32_t DataPageAccessClient::RpcSetRequestDeadline(const int32_t _queue_ms)
+{
+  send_RpcSetRequestDeadline(_queue_ms);
+  return recv_RpcSetRequestDeadline();
+}
+
+void DataPageAccessClient::send_RpcPgFsync(const int32_t _fd)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcPgFsync", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcPgFsync_pargs args;
+  args._fd = &_fd;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::send_RpcSetPageCompression(const int32_t _method)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcSetPageCompression", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcSetPageCompression_pargs args;
+  args._method = &_method;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::send_RpcSetRequestClass(const int32_t _requestClass)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcSetRequestClass", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcSetRequestClass_pargs args;
+  args._requestClass = &_requestClass;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::send_RpcSetRequestDeadline(const int32_t _queue_ms)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcSetRequestDeadline", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcSetRequestDeadline_pargs args;
+  args._queue_ms = &_queue_ms;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcPgFsync()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcPgFsync") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcPgFsync_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFsync failed: unknown result");
+}
+
+int32_t DataPageAccessClient::recv_RpcSetPageCompression()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcSetPageCompression") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcSetPageCompression_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcSetPageCompression failed: unknown result");
+}
+
+int32_t DataPageAccessClient::recv_RpcSetRequestClass()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcSetRequestClass") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcSetRequestClass_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcSetRequestClass failed: unknown result");
+}
+
+int32_t DataPageAccessClient::recv_RpcSetRequestDeadline()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcSetRequestDeadline") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcSetRequestDeadline_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcSetRequestDeadline failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcDurableUnlink(const _Path& _fname, const int32_t _flag)
+{
+  send_RpcDurableUnlink(_fname, _flag);
+  return recv_RpcDurableUnlink();
+}
+
+void DataPageAccessClient::send_RpcDurableUnlink(const _Path& _fname, const int32_t _flag)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcDurableUnlink", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcDurableUnlink_pargs args;
+  args._fname = &_fname;
+  args._flag = &_flag;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcDurableUnlink()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcDurableUnlink") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcDurableUnlink_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDurableUnlink failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcDurableRenameExcl(const _Path& _oldFname, const _Path& _newFname, const int32_t _elevel)
+{
+  send_RpcDurableRenameExcl(_oldFname, _newFname, _elevel);
+  return recv_RpcDurableRenameExcl();
+}
+
+void DataPageAccessClient::send_RpcDurableRenameExcl(const _Path& _oldFname, const _Path& _newFname, const int32_t _elevel)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcDurableRenameExcl", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcDurableRenameExcl_pargs args;
+  args._oldFname = &_oldFname;
+  args._newFname = &_newFname;
+  args._elevel = &_elevel;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcDurableRenameExcl()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcDurableRenameExcl") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcDurableRenameExcl_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDurableRenameExcl failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcXLogWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset, const std::vector<int64_t> & _xlblocks, const int32_t _blknum, const int32_t _idx, const int64_t _lsn)
+{
+  send_RpcXLogWrite(_fd, _page, _amount, _offset, _xlblocks, _blknum, _idx, _lsn);
+  return recv_RpcXLogWrite();
+}
+
+void DataPageAccessClient::send_RpcXLogWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset, const std::vector<int64_t> & _xlblocks, const int32_t _blknum, const int32_t _idx, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcXLogWrite", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcXLogWrite_pargs args;
+  args._fd = &_fd;
+  args._page = &_page;
+  args._amount = &_amount;
+  args._offset = &_offset;
+  args._xlblocks = &_xlblocks;
+  args._blknum = &_blknum;
+  args._idx = &_idx;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcXLogWrite()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcXLogWrite") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcXLogWrite_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcXLogWrite failed: unknown result");
+}
+
+void DataPageAccessClient::RpcXLogFileInit(_XLog_Init_File_Resp& _return, const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock)
+{
+  send_RpcXLogFileInit(_logsegno, _use_existent, _use_lock);
+  recv_RpcXLogFileInit(_return);
+}
+
+void DataPageAccessClient::send_RpcXLogFileInit(const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcXLogFileInit", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcXLogFileInit_pargs args;
+  args._logsegno = &_logsegno;
+  args._use_existent = &_use_existent;
+  args._use_lock = &_use_lock;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcXLogFileInit(_XLog_Init_File_Resp& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcXLogFileInit") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcXLogFileInit_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcXLogFileInit failed: unknown result");
+}
+
+void DataPageAccessClient::ReadBufferBatch(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode, const int64_t _lsn)
+{
+  send_ReadBufferBatch(_reln, _relpersistence, _forknum, _blknums, _readBufferMode, _lsn);
+  recv_ReadBufferBatch(_return);
+}
+
+void DataPageAccessClient::ReadRelationHeads(std::vector<_Page> & _return, const std::vector<_Smgr_Relation> & _relns, const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn)
+{
+  send_ReadRelationHeads(_relns, _forknum, _max_blocks, _lsn);
+  recv_ReadRelationHeads(_return);
+}
+
+void DataPageAccessClient::send_ReadBufferBatch(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("ReadBufferBatch", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_ReadBufferBatch_pargs args;
+  args._reln = &_reln;
+  args._relpersistence = &_relpersistence;
+  args._forknum = &_forknum;
+  args._blknums = &_blknums;
+  args._readBufferMode = &_readBufferMode;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::send_ReadRelationHeads(const std::vector<_Smgr_Relation> & _relns, const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("ReadRelationHeads", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_ReadRelationHeads_pargs args;
+  args._relns = &_relns;
+  args._forknum = &_forknum;
+  args._max_blocks = &_max_blocks;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_ReadBufferBatch(std::vector<_Page> & _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("ReadBufferBatch") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_ReadBufferBatch_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ReadBufferBatch failed: unknown result");
+}
+
+void DataPageAccessClient::recv_ReadRelationHeads(std::vector<_Page> & _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("ReadRelationHeads") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_ReadRelationHeads_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ReadRelationHeads failed: unknown result");
+}
+
+void DataPageAccessClient::ReadBufferIfModified(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _cachedLsn)
+{
+  send_ReadBufferIfModified(_reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn, _cachedLsn);
+  recv_ReadBufferIfModified(_return);
+}
+
+void DataPageAccessClient::send_ReadBufferIfModified(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _cachedLsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("ReadBufferIfModified", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_ReadBufferIfModified_pargs args;
+  args._reln = &_reln;
+  args._relpersistence = &_relpersistence;
+  args._forknum = &_forknum;
+  args._blknum = &_blknum;
+  args._readBufferMode = &_readBufferMode;
+  args._lsn = &_lsn;
+  args._cachedLsn = &_cachedLsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_ReadBufferIfModified(_Page& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("ReadBufferIfModified") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_ReadBufferIfModified_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ReadBufferIfModified failed: unknown result");
+}
+
+int32_t DataPageAccessClient::PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int64_t _lsn)
+{
+  send_PrefetchBuffers(_reln, _forknum, _blknums, _lsn);
+  return recv_PrefetchBuffers();
+}
+
+void DataPageAccessClient::send_PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("PrefetchBuffers", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_PrefetchBuffers_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknums = &_blknums;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_PrefetchBuffers()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("PrefetchBuffers") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_PrefetchBuffers_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "PrefetchBuffers failed: unknown result");
+}
+int32_t DataPageAccessClient::InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn)
+{
+  send_InstallPages(_reln, _forknum, _blknums, _pages, _lsn);
+  return recv_InstallPages();
+}
+
+void DataPageAccessClient::send_InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("InstallPages", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_InstallPages_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknums = &_blknums;
+  args._pages = &_pages;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_InstallPages()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("InstallPages") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_InstallPages_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "InstallPages failed: unknown result");
+}
+int32_t DataPageAccessClient::InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn)
+{
+  send_InstallEvictedPages(_reln, _forknum, _blknums, _pages, _lsn);
+  return recv_InstallEvictedPages();
+}
+
+void DataPageAccessClient::send_InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("InstallEvictedPages", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_InstallEvictedPages_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknums = &_blknums;
+  args._pages = &_pages;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_InstallEvictedPages()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("InstallEvictedPages") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_InstallEvictedPages_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "InstallEvictedPages failed: unknown result");
+}
+
+void DataPageAccessClient::RpcGetSmartReplayMetrics(std::string& _return)
+{
+  send_RpcGetSmartReplayMetrics();
+  recv_RpcGetSmartReplayMetrics(_return);
+}
+
+void DataPageAccessClient::send_RpcGetSmartReplayMetrics()
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcGetSmartReplayMetrics", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcGetSmartReplayMetrics_pargs args;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcGetSmartReplayMetrics(std::string& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcGetSmartReplayMetrics") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcGetSmartReplayMetrics_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcGetSmartReplayMetrics failed: unknown result");
+}
+
+void DataPageAccessClient::RpcFetchPageChanges(_Page& _return, const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq)
+{
+  send_RpcFetchPageChanges(_max_entries, _wait_ms, _from_seq);
+  recv_RpcFetchPageChanges(_return);
+}
+
+void DataPageAccessClient::send_RpcFetchPageChanges(const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcFetchPageChanges", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFetchPageChanges_pargs args;
+  args._max_entries = &_max_entries;
+  args._wait_ms = &_wait_ms;
+  args._from_seq = &_from_seq;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_RpcFetchPageChanges(_Page& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcFetchPageChanges") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_RpcFetchPageChanges_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFetchPageChanges failed: unknown result");
+}
+
+int32_t DataPageAccessClient::RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn)
+{
+  send_RpcSecondaryNodeHeartbeat(_node_id, _lsn);
+  return recv_RpcSecondaryNodeHeartbeat();
+}
+
+int64_t DataPageAccessClient::RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn)
+{
+  send_RpcWaitWalParsed(_wait_ms, _lsn);
+  return recv_RpcWaitWalParsed();
+}
+
+void DataPageAccessClient::send_RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcSecondaryNodeHeartbeat", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcSecondaryNodeHeartbeat_pargs args;
+  args._node_id = &_node_id;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::send_RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("RpcWaitWalParsed", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcWaitWalParsed_pargs args;
+  args._wait_ms = &_wait_ms;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+int32_t DataPageAccessClient::recv_RpcSecondaryNodeHeartbeat()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcSecondaryNodeHeartbeat") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int32_t _return;
+  DataPageAccess_RpcSecondaryNodeHeartbeat_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcSecondaryNodeHeartbeat failed: unknown result");
+}
+
+int64_t DataPageAccessClient::recv_RpcWaitWalParsed()
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("RpcWaitWalParsed") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  int64_t _return;
+  DataPageAccess_RpcWaitWalParsed_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    return _return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcWaitWalParsed failed: unknown result");
+}
+
+void DataPageAccessClient::ScanRelation(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _qual, const int32_t _max_pages, const int64_t _lsn)
+{
+  send_ScanRelation(_reln, _first_block, _end_block, _qual, _max_pages, _lsn);
+  recv_ScanRelation(_return);
+}
+
+void DataPageAccessClient::send_ScanRelation(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _qual, const int32_t _max_pages, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("ScanRelation", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_ScanRelation_pargs args;
+  args._reln = &_reln;
+  args._first_block = &_first_block;
+  args._end_block = &_end_block;
+  args._qual = &_qual;
+  args._max_pages = &_max_pages;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_ScanRelation(std::vector<_Page> & _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("ScanRelation") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_ScanRelation_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ScanRelation failed: unknown result");
+}
+
+void DataPageAccessClient::AggregateRelation(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback, const int64_t _lsn)
+{
+  send_AggregateRelation(_reln, _first_block, _end_block, _spec, _max_fallback, _lsn);
+  recv_AggregateRelation(_return);
+}
+
+void DataPageAccessClient::send_AggregateRelation(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("AggregateRelation", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_AggregateRelation_pargs args;
+  args._reln = &_reln;
+  args._first_block = &_first_block;
+  args._end_block = &_end_block;
+  args._spec = &_spec;
+  args._max_fallback = &_max_fallback;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_AggregateRelation(std::string& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("AggregateRelation") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_AggregateRelation_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "AggregateRelation failed: unknown result");
+}
+
+void DataPageAccessClient::TriageVacuum(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead, const int64_t _lsn)
+{
+  send_TriageVacuum(_reln, _first_block, _end_block, _horizon, _max_dead, _lsn);
+  recv_TriageVacuum(_return);
+}
+
+void DataPageAccessClient::send_TriageVacuum(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead, const int64_t _lsn)
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("TriageVacuum", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_TriageVacuum_pargs args;
+  args._reln = &_reln;
+  args._first_block = &_first_block;
+  args._end_block = &_end_block;
+  args._horizon = &_horizon;
+  args._max_dead = &_max_dead;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+void DataPageAccessClient::recv_TriageVacuum(std::string& _return)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  iprot_->readMessageBegin(fname, mtype, rseqid);
+  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+    ::apache::thrift::TApplicationException x;
+    x.read(iprot_);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+    throw x;
+  }
+  if (mtype != ::apache::thrift::protocol::T_REPLY) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  if (fname.compare("TriageVacuum") != 0) {
+    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot_->readMessageEnd();
+    iprot_->getTransport()->readEnd();
+  }
+  DataPageAccess_TriageVacuum_presult result;
+  result.success = &_return;
+  result.read(iprot_);
+  iprot_->readMessageEnd();
+  iprot_->getTransport()->readEnd();
+
+  if (result.__isset.success) {
+    // _return pointer has now been filled
+    return;
+  }
+  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "TriageVacuum failed: unknown result");
+}
+
+void DataPageAccessClient::zip()
+{
+  send_zip();
+}
+
+void DataPageAccessClient::send_zip()
+{
+  int32_t cseqid = 0;
+  oprot_->writeMessageBegin("zip", ::apache::thrift::protocol::T_ONEWAY, cseqid);
+
+  DataPageAccess_zip_pargs args;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+}
+
+bool DataPageAccessProcessor::dispatchCall(::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, const std::string& fname, int32_t seqid, void* callContext) {
+  ProcessMap::iterator pfn;
+  pfn = processMap_.find(fname);
+  if (pfn == processMap_.end()) {
+    iprot->skip(::apache::thrift::protocol::T_STRUCT);
+    iprot->readMessageEnd();
+    iprot->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(::apache::thrift::TApplicationException::UNKNOWN_METHOD, "Invalid method name: '"+fname+"'");
+    oprot->writeMessageBegin(fname, ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return true;
+  }
+  (this->*(pfn->second))(seqid, iprot, oprot, callContext);
+  return true;
+}
+
+void DataPageAccessProcessor::process_ReadBufferCommon(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.ReadBufferCommon", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.ReadBufferCommon");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.ReadBufferCommon");
+  }
+
+  DataPageAccess_ReadBufferCommon_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.ReadBufferCommon", bytes);
+  }
+
+  DataPageAccess_ReadBufferCommon_result result;
+  try {
+    iface_->ReadBufferCommon(result.success, args._reln, args._relpersistence, args._forknum, args._blknum, args._readBufferMode, args._lsn, args._traceId);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.ReadBufferCommon");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("ReadBufferCommon", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.ReadBufferCommon");
+  }
+
+  oprot->writeMessageBegin("ReadBufferCommon", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.ReadBufferCommon", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcRegisterSecondaryNode(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcRegisterSecondaryNode", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcRegisterSecondaryNode");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcRegisterSecondaryNode");
+  }
+
+  DataPageAccess_RpcRegisterSecondaryNode_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcRegisterSecondaryNode", bytes);
+  }
+
+  DataPageAccess_RpcRegisterSecondaryNode_result result;
+  try {
+    result.success = iface_->RpcRegisterSecondaryNode(args._primary, args._lsn);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcRegisterSecondaryNode");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcRegisterSecondaryNode", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcRegisterSecondaryNode");
+  }
+
+  oprot->writeMessageBegin("RpcRegisterSecondaryNode", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcRegisterSecondaryNode", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcSecondaryNodeUpdatesLsn(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcSecondaryNodeUpdatesLsn", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn");
+  }
+
+  DataPageAccess_RpcSecondaryNodeUpdatesLsn_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn", bytes);
+  }
+
+  DataPageAccess_RpcSecondaryNodeUpdatesLsn_result result;
+  try {
+    iface_->RpcSecondaryNodeUpdatesLsn(args._node_id, args._lsn);
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcSecondaryNodeUpdatesLsn", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn");
+  }
+
+  oprot->writeMessageBegin("RpcSecondaryNodeUpdatesLsn", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcMdRead(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcMdRead", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcMdRead");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcMdRead");
+  }
+
+  DataPageAccess_RpcMdRead_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcMdRead", bytes);
+  }
+
+  DataPageAccess_RpcMdRead_result result;
+  try {
+    iface_->RpcMdRead(result.success, args._reln, args._forknum, args._blknum, args._lsn);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcMdRead");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcMdRead", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcMdRead");
+  }
+
+  oprot->writeMessageBegin("RpcMdRead", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcMdRead", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcMdNblocks(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcMdNblocks", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcMdNblocks");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcMdNblocks");
+  }
+
+  DataPageAccess_RpcMdNblocks_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcMdNblocks", bytes);
+  }
+
+  DataPageAccess_RpcMdNblocks_result result;
+  try {
+    result.success = iface_->RpcMdNblocks(args._reln, args._forknum, args._lsn);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcMdNblocks");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcMdNblocks", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcMdNblocks");
+  }
+
+  oprot->writeMessageBegin("RpcMdNblocks", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcMdNblocks", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcMdExists(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcMdExists", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcMdExists");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcMdExists");
+  }
+
+  DataPageAccess_RpcMdExists_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcMdExists", bytes);
+  }
+
+  DataPageAccess_RpcMdExists_result result;
+  try {
+    result.success = iface_->RpcMdExists(args._reln, args._forknum, args._lsn);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcMdExists");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcMdExists", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcMdExists");
+  }
+
+  oprot->writeMessageBegin("RpcMdExists", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcMdExists", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcMdCreate(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcMdCreate", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcMdCreate");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcMdCreate");
+  }
+
+  DataPageAccess_RpcMdCreate_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcMdCreate", bytes);
+  }
+
+  DataPageAccess_RpcMdCreate_result result;
+  try {
+    iface_->RpcMdCreate(args._reln, args._forknum, args._isRedo, args._lsn);
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcMdCreate");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcMdCreate", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcMdCreate");
+  }
+
+  oprot->writeMessageBegin("RpcMdCreate", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcMdCreate", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcMdExtend(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcMdExtend", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcMdExtend");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcMdExtend");
+  }
+
+  DataPageAccess_RpcMdExtend_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcMdExtend", bytes);
+  }
+
+  DataPageAccess_RpcMdExtend_result result;
+  try {
+    iface_->RpcMdExtend(args._reln, args._forknum, args._blknum, args._buff, args.skipFsync, args._lsn);
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcMdExtend");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcMdExtend", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcMdExtend");
+  }
+
+  oprot->writeMessageBegin("RpcMdExtend", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcMdExtend", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcMdExtendMany(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcMdExtendMany", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcMdExtendMany");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcMdExtendMany");
+  }
+
+  DataPageAccess_RpcMdExtendMany_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcMdExtendMany", bytes);
+  }
+
+  DataPageAccess_RpcMdExtendMany_result result;
+  try {
+    iface_->RpcMdExtendMany(args._reln, args._forknum, args._startblk, args._nblocks, args.skipFsync, args._lsn);
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcMdExtendMany");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcMdExtendMany", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcMdExtendMany");
+  }
+
+  oprot->writeMessageBegin("RpcMdExtendMany", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcMdExtendMany", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcTruncate(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcTruncate", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcTruncate");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcTruncate");
+  }
+
+  DataPageAccess_RpcTruncate_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcTruncate", bytes);
+  }
+
+  DataPageAccess_RpcTruncate_result result;
+  try {
+    iface_->RpcTruncate(args._reln, args._forknum, args._blknum, args._lsn);
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcTruncate");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcTruncate", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcTruncate");
+  }
+
+  oprot->writeMessageBegin("RpcTruncate", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcTruncate", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcFileClose(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileClose", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileClose");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileClose");
+  }
+
+  DataPageAccess_RpcFileClose_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileClose", bytes);
+  }
+
+  DataPageAccess_RpcFileClose_result result;
+  try {
+    iface_->RpcFileClose(args._fd);
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileClose");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcFileClose", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileClose");
+  }
+
+  oprot->writeMessageBegin("RpcFileClose", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileClose", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcTablespaceCreateDbspace(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcTablespaceCreateDbspace", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcTablespaceCreateDbspace");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcTablespaceCreateDbspace");
+  }
+
+  DataPageAccess_RpcTablespaceCreateDbspace_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcTablespaceCreateDbspace", bytes);
+  }
+
+  DataPageAccess_RpcTablespaceCreateDbspace_result result;
+  try {
+    iface_->RpcTablespaceCreateDbspace(args._spcnode, args._dbnode, args.isRedo);
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcTablespaceCreateDbspace");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcTablespaceCreateDbspace", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcTablespaceCreateDbspace");
+  }
+
+  oprot->writeMessageBegin("RpcTablespaceCreateDbspace", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcTablespaceCreateDbspace", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcPathNameOpenFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPathNameOpenFile", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPathNameOpenFile");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPathNameOpenFile");
+  }
+
+  DataPageAccess_RpcPathNameOpenFile_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPathNameOpenFile", bytes);
+  }
+
+  DataPageAccess_RpcPathNameOpenFile_result result;
+  try {
+    result.success = iface_->RpcPathNameOpenFile(args._path, args._flag);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPathNameOpenFile");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcPathNameOpenFile", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPathNameOpenFile");
+  }
+
+  oprot->writeMessageBegin("RpcPathNameOpenFile", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPathNameOpenFile", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcFileWrite(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileWrite", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileWrite");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileWrite");
+  }
+
+  DataPageAccess_RpcFileWrite_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileWrite", bytes);
+  }
+
+  DataPageAccess_RpcFileWrite_result result;
+  try {
+    result.success = iface_->RpcFileWrite(args._fd, args._page, args._amount, args._seekpos, args._wait_event_info);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileWrite");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcFileWrite", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileWrite");
+  }
+
+  oprot->writeMessageBegin("RpcFileWrite", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileWrite", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcFilePathName(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFilePathName", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFilePathName");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFilePathName");
+  }
+
+  DataPageAccess_RpcFilePathName_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFilePathName", bytes);
+  }
+
+  DataPageAccess_RpcFilePathName_result result;
+  try {
+    iface_->RpcFilePathName(result.success, args._fd);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFilePathName");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcFilePathName", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFilePathName");
+  }
+
+  oprot->writeMessageBegin("RpcFilePathName", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFilePathName", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcFileRead(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileRead", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileRead");
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileRead");
+  }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
+  DataPageAccess_RpcFileRead_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileRead", bytes);
   }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  DataPageAccess_RpcFileRead_result result;
+  try {
+    iface_->RpcFileRead(result.success, args._fd, args._amount, args._seekpos, args._wait_event_info);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileRead");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcFileRead", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  if (fname.compare("RpcFileWriteback") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileRead");
   }
-  DataPageAccess_RpcFileWriteback_presult result;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  return;
+  oprot->writeMessageBegin("RpcFileRead", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileRead", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcFileTruncate(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileTruncate", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileTruncate");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileTruncate");
+  }
+
+  DataPageAccess_RpcFileTruncate_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileTruncate", bytes);
+  }
+
+  DataPageAccess_RpcFileTruncate_result result;
+  try {
+    result.success = iface_->RpcFileTruncate(args._fd, args._offset);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileTruncate");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcFileTruncate", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileTruncate");
+  }
+
+  oprot->writeMessageBegin("RpcFileTruncate", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileTruncate", bytes);
+  }
+}
+
+void DataPageAccessProcessor::process_RpcFileSize(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileSize", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileSize");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileSize");
+  }
+
+  DataPageAccess_RpcFileSize_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileSize", bytes);
+  }
+
+  DataPageAccess_RpcFileSize_result result;
+  try {
+    result.success = iface_->RpcFileSize(args._fd);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileSize");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcFileSize", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileSize");
+  }
+
+  oprot->writeMessageBegin("RpcFileSize", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileSize", bytes);
+  }
 }
 
-int32_t DataPageAccessClient::RpcUnlink(const _Path& _path)
-{
-  send_RpcUnlink(_path);
-  return recv_RpcUnlink();
+void DataPageAccessProcessor::process_RpcFilePrefetch(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+{
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFilePrefetch", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFilePrefetch");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFilePrefetch");
+  }
+
+  DataPageAccess_RpcFilePrefetch_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFilePrefetch", bytes);
+  }
+
+  DataPageAccess_RpcFilePrefetch_result result;
+  try {
+    result.success = iface_->RpcFilePrefetch(args._fd, args._offset, args._amount, args.wait_event_info);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFilePrefetch");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcFilePrefetch", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFilePrefetch");
+  }
+
+  oprot->writeMessageBegin("RpcFilePrefetch", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFilePrefetch", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcUnlink(const _Path& _path)
+void DataPageAccessProcessor::process_RpcFileWriteback(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcUnlink", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileWriteback", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileWriteback");
 
-  DataPageAccess_RpcUnlink_pargs args;
-  args._path = &_path;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileWriteback");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcFileWriteback_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcUnlink()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileWriteback", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcFileWriteback_result result;
+  try {
+    iface_->RpcFileWriteback(args._fd, args._offset, args.nbytes, args.wait_event_info);
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileWriteback");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcUnlink") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcFileWriteback", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcUnlink_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileWriteback");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcUnlink failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcFtruncate(const _File _fd, const _Off_t _offset)
-{
-  send_RpcFtruncate(_fd, _offset);
-  return recv_RpcFtruncate();
+  oprot->writeMessageBegin("RpcFileWriteback", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileWriteback", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcFtruncate(const _File _fd, const _Off_t _offset)
+void DataPageAccessProcessor::process_RpcUnlink(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcFtruncate", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcUnlink", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcUnlink");
 
-  DataPageAccess_RpcFtruncate_pargs args;
-  args._fd = &_fd;
-  args._offset = &_offset;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcUnlink");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcUnlink_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcFtruncate()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcUnlink", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcUnlink_result result;
+  try {
+    result.success = iface_->RpcUnlink(args._path);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcUnlink");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcFtruncate") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcUnlink", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcFtruncate_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcUnlink");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFtruncate failed: unknown result");
-}
-
-void DataPageAccessClient::RpcInitFile(_Page& _return, const _Path& _path)
-{
-  send_RpcInitFile(_path);
-  recv_RpcInitFile(_return);
-}
-
-void DataPageAccessClient::send_RpcInitFile(const _Path& _path)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcInitFile", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcInitFile_pargs args;
-  args._path = &_path;
-  args.write(oprot_);
+  oprot->writeMessageBegin("RpcUnlink", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcUnlink", bytes);
+  }
 }
 
-void DataPageAccessClient::recv_RpcInitFile(_Page& _return)
+void DataPageAccessProcessor::process_RpcFtruncate(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
-
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFtruncate", callContext);
   }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFtruncate");
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFtruncate");
   }
-  if (fname.compare("RpcInitFile") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  DataPageAccess_RpcFtruncate_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFtruncate", bytes);
   }
-  DataPageAccess_RpcInitFile_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    // _return pointer has now been filled
+  DataPageAccess_RpcFtruncate_result result;
+  try {
+    result.success = iface_->RpcFtruncate(args._fd, args._offset);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFtruncate");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcFtruncate", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
     return;
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcInitFile failed: unknown result");
-}
-
-_File DataPageAccessClient::RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags)
-{
-  send_RpcOpenTransientFile(_filename, _fileflags);
-  return recv_RpcOpenTransientFile();
-}
 
-void DataPageAccessClient::send_RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcOpenTransientFile", ::apache::thrift::protocol::T_CALL, cseqid);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFtruncate");
+  }
 
-  DataPageAccess_RpcOpenTransientFile_pargs args;
-  args._filename = &_filename;
-  args._fileflags = &_fileflags;
-  args.write(oprot_);
+  oprot->writeMessageBegin("RpcFtruncate", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFtruncate", bytes);
+  }
 }
 
-_File DataPageAccessClient::recv_RpcOpenTransientFile()
+void DataPageAccessProcessor::process_RpcInitFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcInitFile", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcInitFile");
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
-
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcInitFile");
   }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  DataPageAccess_RpcInitFile_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcInitFile", bytes);
   }
-  if (fname.compare("RpcOpenTransientFile") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  DataPageAccess_RpcInitFile_result result;
+  try {
+    iface_->RpcInitFile(result.success, args._path);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcInitFile");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcInitFile", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  _File _return;
-  DataPageAccess_RpcOpenTransientFile_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcInitFile");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcOpenTransientFile failed: unknown result");
-}
 
-_File DataPageAccessClient::RpcOpenTransientFileUnderPgData(const _Path& _filename, const int32_t _fileflags)
-{
-  send_RpcOpenTransientFileUnderPgData(_filename, _fileflags);
-  return recv_RpcOpenTransientFileUnderPgData();
+  oprot->writeMessageBegin("RpcInitFile", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcInitFile", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcOpenTransientFileUnderPgData(const _Path& _filename, const int32_t _fileflags)
+void DataPageAccessProcessor::process_RpcOpenAndReadFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcOpenTransientFileUnderPgData", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcOpenAndReadFile", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcOpenAndReadFile");
 
-  DataPageAccess_RpcOpenTransientFileUnderPgData_pargs args;
-  args._filename = &_filename;
-  args._fileflags = &_fileflags;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcOpenAndReadFile");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcOpenAndReadFile_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-_File DataPageAccessClient::recv_RpcOpenTransientFileUnderPgData()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcOpenAndReadFile", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcOpenAndReadFile_result result;
+  try {
+    iface_->RpcOpenAndReadFile(result.success, args._path, args._flags, args._amount, args._transient);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcOpenAndReadFile");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcOpenTransientFileUnderPgData") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcOpenAndReadFile", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  _File _return;
-  DataPageAccess_RpcOpenTransientFileUnderPgData_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcOpenAndReadFile");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcOpenTransientFileUnderPgData failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcCloseTransientFile(const _File _fd)
-{
-  send_RpcCloseTransientFile(_fd);
-  return recv_RpcCloseTransientFile();
+  oprot->writeMessageBegin("RpcOpenAndReadFile", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcOpenAndReadFile", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcCloseTransientFile(const _File _fd)
+void DataPageAccessProcessor::process_RpcOpenTransientFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcCloseTransientFile", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcOpenTransientFile", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcOpenTransientFile");
 
-  DataPageAccess_RpcCloseTransientFile_pargs args;
-  args._fd = &_fd;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcOpenTransientFile");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcOpenTransientFile_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcCloseTransientFile()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcOpenTransientFile", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcOpenTransientFile_result result;
+  try {
+    result.success = iface_->RpcOpenTransientFile(args._filename, args._fileflags);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcOpenTransientFile");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcCloseTransientFile") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcOpenTransientFile", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcCloseTransientFile_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcOpenTransientFile");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcCloseTransientFile failed: unknown result");
-}
 
-void DataPageAccessClient::Rpcread(_Page& _return, const _File _fd, const int32_t size)
-{
-  send_Rpcread(_fd, size);
-  recv_Rpcread(_return);
+  oprot->writeMessageBegin("RpcOpenTransientFile", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcOpenTransientFile", bytes);
+  }
 }
 
-void DataPageAccessClient::send_Rpcread(const _File _fd, const int32_t size)
+void DataPageAccessProcessor::process_RpcOpenTransientFileUnderPgData(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("Rpcread", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcOpenTransientFileUnderPgData", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData");
 
-  DataPageAccess_Rpcread_pargs args;
-  args._fd = &_fd;
-  args.size = &size;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcOpenTransientFileUnderPgData_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-void DataPageAccessClient::recv_Rpcread(_Page& _return)
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcOpenTransientFileUnderPgData_result result;
+  try {
+    result.success = iface_->RpcOpenTransientFileUnderPgData(args._filename, args._fileflags);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("Rpcread") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcOpenTransientFileUnderPgData", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  DataPageAccess_Rpcread_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    // _return pointer has now been filled
-    return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "Rpcread failed: unknown result");
-}
 
-int32_t DataPageAccessClient::Rpcwrite(const _File _fd, const _Page& _page, const int32_t size)
-{
-  send_Rpcwrite(_fd, _page, size);
-  return recv_Rpcwrite();
+  oprot->writeMessageBegin("RpcOpenTransientFileUnderPgData", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData", bytes);
+  }
 }
 
-void DataPageAccessClient::send_Rpcwrite(const _File _fd, const _Page& _page, const int32_t size)
+void DataPageAccessProcessor::process_RpcCloseTransientFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("Rpcwrite", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcCloseTransientFile", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcCloseTransientFile");
 
-  DataPageAccess_Rpcwrite_pargs args;
-  args._fd = &_fd;
-  args._page = &_page;
-  args.size = &size;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcCloseTransientFile");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcCloseTransientFile_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_Rpcwrite()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcCloseTransientFile", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcCloseTransientFile_result result;
+  try {
+    result.success = iface_->RpcCloseTransientFile(args._fd);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcCloseTransientFile");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("Rpcwrite") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcCloseTransientFile", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_Rpcwrite_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcCloseTransientFile");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "Rpcwrite failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcFileSync(const _File _fd, const int32_t _wait_event_info)
-{
-  send_RpcFileSync(_fd, _wait_event_info);
-  return recv_RpcFileSync();
+  oprot->writeMessageBegin("RpcCloseTransientFile", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcCloseTransientFile", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcFileSync(const _File _fd, const int32_t _wait_event_info)
+void DataPageAccessProcessor::process_Rpcread(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcFileSync", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.Rpcread", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.Rpcread");
 
-  DataPageAccess_RpcFileSync_pargs args;
-  args._fd = &_fd;
-  args._wait_event_info = &_wait_event_info;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.Rpcread");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_Rpcread_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcFileSync()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.Rpcread", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_Rpcread_result result;
+  try {
+    iface_->Rpcread(result.success, args._fd, args.size);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.Rpcread");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcFileSync") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("Rpcread", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcFileSync_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.Rpcread");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileSync failed: unknown result");
-}
 
-void DataPageAccessClient::RpcPgPRead(_Page& _return, const _File _fd, const int32_t _seg_bytes, const _Off_t _start_off)
-{
-  send_RpcPgPRead(_fd, _seg_bytes, _start_off);
-  recv_RpcPgPRead(_return);
+  oprot->writeMessageBegin("Rpcread", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.Rpcread", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcPgPRead(const _File _fd, const int32_t _seg_bytes, const _Off_t _start_off)
+void DataPageAccessProcessor::process_Rpcwrite(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcPgPRead", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.Rpcwrite", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.Rpcwrite");
 
-  DataPageAccess_RpcPgPRead_pargs args;
-  args._fd = &_fd;
-  args._seg_bytes = &_seg_bytes;
-  args._start_off = &_start_off;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.Rpcwrite");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_Rpcwrite_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-void DataPageAccessClient::recv_RpcPgPRead(_Page& _return)
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.Rpcwrite", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_Rpcwrite_result result;
+  try {
+    result.success = iface_->Rpcwrite(args._fd, args._page, args.size);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.Rpcwrite");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("Rpcwrite", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  if (fname.compare("RpcPgPRead") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.Rpcwrite");
   }
-  DataPageAccess_RpcPgPRead_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    // _return pointer has now been filled
-    return;
+  oprot->writeMessageBegin("Rpcwrite", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.Rpcwrite", bytes);
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgPRead failed: unknown result");
 }
 
-int32_t DataPageAccessClient::RpcPgPWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset)
+void DataPageAccessProcessor::process_RpcFileSync(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  send_RpcPgPWrite(_fd, _page, _amount, _offset);
-  return recv_RpcPgPWrite();
-}
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileSync", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileSync");
 
-void DataPageAccessClient::send_RpcPgPWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcPgPWrite", ::apache::thrift::protocol::T_CALL, cseqid);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileSync");
+  }
 
-  DataPageAccess_RpcPgPWrite_pargs args;
-  args._fd = &_fd;
-  args._page = &_page;
-  args._amount = &_amount;
-  args._offset = &_offset;
-  args.write(oprot_);
+  DataPageAccess_RpcFileSync_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileSync", bytes);
+  }
+
+  DataPageAccess_RpcFileSync_result result;
+  try {
+    result.success = iface_->RpcFileSync(args._fd, args._wait_event_info);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileSync");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcFileSync", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileSync");
+  }
+
+  oprot->writeMessageBegin("RpcFileSync", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileSync", bytes);
+  }
 }
 
-int32_t DataPageAccessClient::recv_RpcPgPWrite()
+void DataPageAccessProcessor::process_RpcPgPRead(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPgPRead", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPgPRead");
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
-
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPgPRead");
   }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  DataPageAccess_RpcPgPRead_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPgPRead", bytes);
   }
-  if (fname.compare("RpcPgPWrite") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  DataPageAccess_RpcPgPRead_result result;
+  try {
+    iface_->RpcPgPRead(result.success, args._fd, args._seg_bytes, args._start_off);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPgPRead");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcPgPRead", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcPgPWrite_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPgPRead");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgPWrite failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcClose(const _File _fd)
-{
-  send_RpcClose(_fd);
-  return recv_RpcClose();
+  oprot->writeMessageBegin("RpcPgPRead", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPgPRead", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcClose(const _File _fd)
+void DataPageAccessProcessor::process_RpcPgPWrite(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcClose", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPgPWrite", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPgPWrite");
 
-  DataPageAccess_RpcClose_pargs args;
-  args._fd = &_fd;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPgPWrite");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcPgPWrite_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcClose()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPgPWrite", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcPgPWrite_result result;
+  try {
+    result.success = iface_->RpcPgPWrite(args._fd, args._page, args._amount, args._offset);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPgPWrite");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcClose") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcPgPWrite", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcClose_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPgPWrite");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcClose failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcBasicOpenFile(const _Path& _path, const int32_t _flags)
-{
-  send_RpcBasicOpenFile(_path, _flags);
-  return recv_RpcBasicOpenFile();
+  oprot->writeMessageBegin("RpcPgPWrite", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPgPWrite", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcBasicOpenFile(const _Path& _path, const int32_t _flags)
+void DataPageAccessProcessor::process_RpcClose(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcBasicOpenFile", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcClose", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcClose");
 
-  DataPageAccess_RpcBasicOpenFile_pargs args;
-  args._path = &_path;
-  args._flags = &_flags;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcClose");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcClose_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcBasicOpenFile()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcClose", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcClose_result result;
+  try {
+    result.success = iface_->RpcClose(args._fd);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcClose");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcBasicOpenFile") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcClose", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcBasicOpenFile_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcClose");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcBasicOpenFile failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcBasicOpenFileUnderPgData(const _Path& _path, const int32_t _flags)
-{
-  send_RpcBasicOpenFileUnderPgData(_path, _flags);
-  return recv_RpcBasicOpenFileUnderPgData();
+  oprot->writeMessageBegin("RpcClose", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcClose", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcBasicOpenFileUnderPgData(const _Path& _path, const int32_t _flags)
+void DataPageAccessProcessor::process_RpcBasicOpenFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcBasicOpenFileUnderPgData", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcBasicOpenFile", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcBasicOpenFile");
 
-  DataPageAccess_RpcBasicOpenFileUnderPgData_pargs args;
-  args._path = &_path;
-  args._flags = &_flags;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcBasicOpenFile");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcBasicOpenFile_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcBasicOpenFileUnderPgData()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcBasicOpenFile", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcBasicOpenFile_result result;
+  try {
+    result.success = iface_->RpcBasicOpenFile(args._path, args._flags);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcBasicOpenFile");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcBasicOpenFileUnderPgData") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcBasicOpenFile", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcBasicOpenFileUnderPgData_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcBasicOpenFile");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcBasicOpenFileUnderPgData failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcPgFdatasync(const _File _fd)
-{
-  send_RpcPgFdatasync(_fd);
-  return recv_RpcPgFdatasync();
+  oprot->writeMessageBegin("RpcBasicOpenFile", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcBasicOpenFile", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcPgFdatasync(const _File _fd)
+void DataPageAccessProcessor::process_RpcBasicOpenFileUnderPgData(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcPgFdatasync", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcBasicOpenFileUnderPgData", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData");
 
-  DataPageAccess_RpcPgFdatasync_pargs args;
-  args._fd = &_fd;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcBasicOpenFileUnderPgData_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcPgFdatasync()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcBasicOpenFileUnderPgData_result result;
+  try {
+    result.success = iface_->RpcBasicOpenFileUnderPgData(args._path, args._flags);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcPgFdatasync") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcBasicOpenFileUnderPgData", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcPgFdatasync_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFdatasync failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcPgFsyncNoWritethrough(const _File _fd)
-{
-  send_RpcPgFsyncNoWritethrough(_fd);
-  return recv_RpcPgFsyncNoWritethrough();
+  oprot->writeMessageBegin("RpcBasicOpenFileUnderPgData", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcPgFsyncNoWritethrough(const _File _fd)
+void DataPageAccessProcessor::process_RpcPgFdatasync(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcPgFsyncNoWritethrough", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPgFdatasync", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPgFdatasync");
 
-  DataPageAccess_RpcPgFsyncNoWritethrough_pargs args;
-  args._fd = &_fd;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPgFdatasync");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcPgFdatasync_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcPgFsyncNoWritethrough()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPgFdatasync", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcPgFdatasync_result result;
+  try {
+    result.success = iface_->RpcPgFdatasync(args._fd);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPgFdatasync");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcPgFsyncNoWritethrough") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcPgFdatasync", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcPgFsyncNoWritethrough_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPgFdatasync");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFsyncNoWritethrough failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcLseek(const int32_t _fd, const _Off_t _offset, const int32_t _flag)
-{
-  send_RpcLseek(_fd, _offset, _flag);
-  return recv_RpcLseek();
+  oprot->writeMessageBegin("RpcPgFdatasync", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPgFdatasync", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcLseek(const int32_t _fd, const _Off_t _offset, const int32_t _flag)
+void DataPageAccessProcessor::process_RpcPgFsyncNoWritethrough(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcLseek", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPgFsyncNoWritethrough", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPgFsyncNoWritethrough");
 
-  DataPageAccess_RpcLseek_pargs args;
-  args._fd = &_fd;
-  args._offset = &_offset;
-  args._flag = &_flag;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPgFsyncNoWritethrough");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcPgFsyncNoWritethrough_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcLseek()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPgFsyncNoWritethrough", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcPgFsyncNoWritethrough_result result;
+  try {
+    result.success = iface_->RpcPgFsyncNoWritethrough(args._fd);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPgFsyncNoWritethrough");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcLseek") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  int32_t _return;
-  DataPageAccess_RpcLseek_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcPgFsyncNoWritethrough", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPgFsyncNoWritethrough");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcLseek failed: unknown result");
-}
 
-void DataPageAccessClient::RpcStat(_Stat_Resp& _return, const _Path& _path)
-{
-  send_RpcStat(_path);
-  recv_RpcStat(_return);
+  oprot->writeMessageBegin("RpcPgFsyncNoWritethrough", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPgFsyncNoWritethrough", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcStat(const _Path& _path)
+void DataPageAccessProcessor::process_RpcLseek(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcStat", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcLseek", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcLseek");
 
-  DataPageAccess_RpcStat_pargs args;
-  args._path = &_path;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcLseek");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcLseek_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-void DataPageAccessClient::recv_RpcStat(_Stat_Resp& _return)
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcLseek", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcLseek_result result;
+  try {
+    result.success = iface_->RpcLseek(args._fd, args._offset, args._flag);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcLseek");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcStat") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcLseek", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  DataPageAccess_RpcStat_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    // _return pointer has now been filled
-    return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcLseek");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcStat failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcDirectoryIsEmpty(const _Path& _path)
-{
-  send_RpcDirectoryIsEmpty(_path);
-  return recv_RpcDirectoryIsEmpty();
+  oprot->writeMessageBegin("RpcLseek", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcLseek", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcDirectoryIsEmpty(const _Path& _path)
+void DataPageAccessProcessor::process_RpcStat(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcDirectoryIsEmpty", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcStat", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcStat");
 
-  DataPageAccess_RpcDirectoryIsEmpty_pargs args;
-  args._path = &_path;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcStat");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcStat_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcDirectoryIsEmpty()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcStat", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcStat_result result;
+  try {
+    iface_->RpcStat(result.success, args._path);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcStat");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcDirectoryIsEmpty") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcStat", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcDirectoryIsEmpty_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcStat");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDirectoryIsEmpty failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcCopyDir(const _Path& _src, const _Path& _dst)
-{
-  send_RpcCopyDir(_src, _dst);
-  return recv_RpcCopyDir();
+  oprot->writeMessageBegin("RpcStat", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcStat", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcCopyDir(const _Path& _src, const _Path& _dst)
+void DataPageAccessProcessor::process_RpcDirectoryIsEmpty(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcCopyDir", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcDirectoryIsEmpty", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcDirectoryIsEmpty");
 
-  DataPageAccess_RpcCopyDir_pargs args;
-  args._src = &_src;
-  args._dst = &_dst;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcDirectoryIsEmpty");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcDirectoryIsEmpty_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcCopyDir()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcDirectoryIsEmpty", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcDirectoryIsEmpty_result result;
+  try {
+    result.success = iface_->RpcDirectoryIsEmpty(args._path);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcDirectoryIsEmpty");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcCopyDir") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcDirectoryIsEmpty", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcCopyDir_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcDirectoryIsEmpty");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcCopyDir failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcPgFsync(const int32_t _fd)
-{
-  send_RpcPgFsync(_fd);
-  return recv_RpcPgFsync();
+  oprot->writeMessageBegin("RpcDirectoryIsEmpty", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcDirectoryIsEmpty", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcPgFsync(const int32_t _fd)
+void DataPageAccessProcessor::process_RpcSyncFiles(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcPgFsync", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcSyncFiles", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcSyncFiles");
 
-  DataPageAccess_RpcPgFsync_pargs args;
-  args._fd = &_fd;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcSyncFiles");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcSyncFiles_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcPgFsync()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcSyncFiles", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcSyncFiles_result result;
+  try {
+    result.success = iface_->RpcSyncFiles(args._paths);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcSyncFiles");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcPgFsync") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcSyncFiles", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcPgFsync_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcSyncFiles");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFsync failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcDurableUnlink(const _Path& _fname, const int32_t _flag)
-{
-  send_RpcDurableUnlink(_fname, _flag);
-  return recv_RpcDurableUnlink();
+  oprot->writeMessageBegin("RpcSyncFiles", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcSyncFiles", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcDurableUnlink(const _Path& _fname, const int32_t _flag)
+void DataPageAccessProcessor::process_RpcAttachSharedMemory(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcDurableUnlink", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcAttachSharedMemory", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcAttachSharedMemory");
 
-  DataPageAccess_RpcDurableUnlink_pargs args;
-  args._fname = &_fname;
-  args._flag = &_flag;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcAttachSharedMemory");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcAttachSharedMemory_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcDurableUnlink()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcAttachSharedMemory", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcAttachSharedMemory_result result;
+  try {
+    result.success = iface_->RpcAttachSharedMemory(args._name);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcAttachSharedMemory");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcAttachSharedMemory", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  if (fname.compare("RpcDurableUnlink") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcAttachSharedMemory");
   }
-  int32_t _return;
-  DataPageAccess_RpcDurableUnlink_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  oprot->writeMessageBegin("RpcAttachSharedMemory", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcAttachSharedMemory", bytes);
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDurableUnlink failed: unknown result");
 }
 
-int32_t DataPageAccessClient::RpcDurableRenameExcl(const _Path& _oldFname, const _Path& _newFname, const int32_t _elevel)
+void DataPageAccessProcessor::process_RpcPublishResidentPages(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  send_RpcDurableRenameExcl(_oldFname, _newFname, _elevel);
-  return recv_RpcDurableRenameExcl();
-}
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPublishResidentPages", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPublishResidentPages");
 
-void DataPageAccessClient::send_RpcDurableRenameExcl(const _Path& _oldFname, const _Path& _newFname, const int32_t _elevel)
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcDurableRenameExcl", ::apache::thrift::protocol::T_CALL, cseqid);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPublishResidentPages");
+  }
 
-  DataPageAccess_RpcDurableRenameExcl_pargs args;
-  args._oldFname = &_oldFname;
-  args._newFname = &_newFname;
-  args._elevel = &_elevel;
-  args.write(oprot_);
+  DataPageAccess_RpcPublishResidentPages_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPublishResidentPages", bytes);
+  }
+
+  DataPageAccess_RpcPublishResidentPages_result result;
+  try {
+    result.success = iface_->RpcPublishResidentPages(args._summary);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPublishResidentPages");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcPublishResidentPages", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPublishResidentPages");
+  }
+
+  oprot->writeMessageBegin("RpcPublishResidentPages", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPublishResidentPages", bytes);
+  }
 }
 
-int32_t DataPageAccessClient::recv_RpcDurableRenameExcl()
+void DataPageAccessProcessor::process_RpcCopyDir(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcCopyDir", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcCopyDir");
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
-
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcCopyDir");
   }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  DataPageAccess_RpcCopyDir_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcCopyDir", bytes);
   }
-  if (fname.compare("RpcDurableRenameExcl") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  DataPageAccess_RpcCopyDir_result result;
+  try {
+    result.success = iface_->RpcCopyDir(args._src, args._dst);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcCopyDir");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcCopyDir", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcDurableRenameExcl_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcCopyDir");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDurableRenameExcl failed: unknown result");
-}
 
-int32_t DataPageAccessClient::RpcXLogWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset, const std::vector<int64_t> & _xlblocks, const int32_t _blknum, const int32_t _idx, const int64_t _lsn)
-{
-  send_RpcXLogWrite(_fd, _page, _amount, _offset, _xlblocks, _blknum, _idx, _lsn);
-  return recv_RpcXLogWrite();
+  oprot->writeMessageBegin("RpcCopyDir", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcCopyDir", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcXLogWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset, const std::vector<int64_t> & _xlblocks, const int32_t _blknum, const int32_t _idx, const int64_t _lsn)
+void DataPageAccessProcessor::process_RpcPgFsync(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcXLogWrite", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPgFsync", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPgFsync");
 
-  DataPageAccess_RpcXLogWrite_pargs args;
-  args._fd = &_fd;
-  args._page = &_page;
-  args._amount = &_amount;
-  args._offset = &_offset;
-  args._xlblocks = &_xlblocks;
-  args._blknum = &_blknum;
-  args._idx = &_idx;
-  args._lsn = &_lsn;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPgFsync");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcPgFsync_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-int32_t DataPageAccessClient::recv_RpcXLogWrite()
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPgFsync", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcPgFsync_result result;
+  try {
+    result.success = iface_->RpcPgFsync(args._fd);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPgFsync");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-  }
-  if (fname.compare("RpcXLogWrite") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcPgFsync", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  int32_t _return;
-  DataPageAccess_RpcXLogWrite_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    return _return;
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPgFsync");
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcXLogWrite failed: unknown result");
-}
 
-void DataPageAccessClient::RpcXLogFileInit(_XLog_Init_File_Resp& _return, const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock)
-{
-  send_RpcXLogFileInit(_logsegno, _use_existent, _use_lock);
-  recv_RpcXLogFileInit(_return);
+  oprot->writeMessageBegin("RpcPgFsync", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPgFsync", bytes);
+  }
 }
 
-void DataPageAccessClient::send_RpcXLogFileInit(const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock)
+void DataPageAccessProcessor::process_RpcSetPageCompression(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("RpcXLogFileInit", ::apache::thrift::protocol::T_CALL, cseqid);
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcSetPageCompression", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcSetPageCompression");
 
-  DataPageAccess_RpcXLogFileInit_pargs args;
-  args._logsegno = &_logsegno;
-  args._use_existent = &_use_existent;
-  args._use_lock = &_use_lock;
-  args.write(oprot_);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcSetPageCompression");
+  }
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  DataPageAccess_RpcSetPageCompression_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-void DataPageAccessClient::recv_RpcXLogFileInit(_XLog_Init_File_Resp& _return)
-{
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcSetPageCompression", bytes);
+  }
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
+  DataPageAccess_RpcSetPageCompression_result result;
+  try {
+    result.success = iface_->RpcSetPageCompression(args._method);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcSetPageCompression");
+    }
 
-  iprot_->readMessageBegin(fname, mtype, rseqid);
-  if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-    ::apache::thrift::TApplicationException x;
-    x.read(iprot_);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
-    throw x;
-  }
-  if (mtype != ::apache::thrift::protocol::T_REPLY) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcSetPageCompression", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    x.write(oprot);
+    oprot->writeMessageEnd();
+    oprot->getTransport()->writeEnd();
+    oprot->getTransport()->flush();
+    return;
   }
-  if (fname.compare("RpcXLogFileInit") != 0) {
-    iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot_->readMessageEnd();
-    iprot_->getTransport()->readEnd();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcSetPageCompression");
   }
-  DataPageAccess_RpcXLogFileInit_presult result;
-  result.success = &_return;
-  result.read(iprot_);
-  iprot_->readMessageEnd();
-  iprot_->getTransport()->readEnd();
 
-  if (result.__isset.success) {
-    // _return pointer has now been filled
-    return;
+  oprot->writeMessageBegin("RpcSetPageCompression", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcSetPageCompression", bytes);
   }
-  throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcXLogFileInit failed: unknown result");
 }
 
-void DataPageAccessClient::zip()
+void DataPageAccessProcessor::process_RpcSetRequestClass(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
-  send_zip();
-}
+  void* ctx = nullptr;
+  if (this->eventHandler_.get() != nullptr) {
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcSetRequestClass", callContext);
+  }
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcSetRequestClass");
 
-void DataPageAccessClient::send_zip()
-{
-  int32_t cseqid = 0;
-  oprot_->writeMessageBegin("zip", ::apache::thrift::protocol::T_ONEWAY, cseqid);
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcSetRequestClass");
+  }
 
-  DataPageAccess_zip_pargs args;
-  args.write(oprot_);
+  DataPageAccess_RpcSetRequestClass_args args;
+  args.read(iprot);
+  iprot->readMessageEnd();
+  uint32_t bytes = iprot->getTransport()->readEnd();
 
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-}
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcSetRequestClass", bytes);
+  }
 
-bool DataPageAccessProcessor::dispatchCall(::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, const std::string& fname, int32_t seqid, void* callContext) {
-  ProcessMap::iterator pfn;
-  pfn = processMap_.find(fname);
-  if (pfn == processMap_.end()) {
-    iprot->skip(::apache::thrift::protocol::T_STRUCT);
-    iprot->readMessageEnd();
-    iprot->getTransport()->readEnd();
-    ::apache::thrift::TApplicationException x(::apache::thrift::TApplicationException::UNKNOWN_METHOD, "Invalid method name: '"+fname+"'");
-    oprot->writeMessageBegin(fname, ::apache::thrift::protocol::T_EXCEPTION, seqid);
+  DataPageAccess_RpcSetRequestClass_result result;
+  try {
+    result.success = iface_->RpcSetRequestClass(args._requestClass);
+    result.__isset.success = true;
+  } catch (const std::exception& e) {
+    if (this->eventHandler_.get() != nullptr) {
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcSetRequestClass");
+    }
+
+    ::apache::thrift::TApplicationException x(e.what());
+    oprot->writeMessageBegin("RpcSetRequestClass", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
     oprot->getTransport()->flush();
-    return true;
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcSetRequestClass");
+  }
+
+  oprot->writeMessageBegin("RpcSetRequestClass", ::apache::thrift::protocol::T_REPLY, seqid);
+  result.write(oprot);
+  oprot->writeMessageEnd();
+  bytes = oprot->getTransport()->writeEnd();
+  oprot->getTransport()->flush();
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcSetRequestClass", bytes);
   }
-  (this->*(pfn->second))(seqid, iprot, oprot, callContext);
-  return true;
 }
 
-void DataPageAccessProcessor::process_ReadBufferCommon(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_RpcSetRequestDeadline(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.ReadBufferCommon", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcSetRequestDeadline", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.ReadBufferCommon");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcSetRequestDeadline");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.ReadBufferCommon");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcSetRequestDeadline");
   }
 
-  DataPageAccess_ReadBufferCommon_args args;
+  DataPageAccess_RpcSetRequestDeadline_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.ReadBufferCommon", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcSetRequestDeadline", bytes);
   }
 
-  DataPageAccess_ReadBufferCommon_result result;
+  DataPageAccess_RpcSetRequestDeadline_result result;
   try {
-    iface_->ReadBufferCommon(result.success, args._reln, args._relpersistence, args._forknum, args._blknum, args._readBufferMode, args._lsn);
+    result.success = iface_->RpcSetRequestDeadline(args._queue_ms);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.ReadBufferCommon");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcSetRequestDeadline");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("ReadBufferCommon", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("RpcSetRequestDeadline", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -11906,52 +20603,52 @@ void DataPageAccessProcessor::process_ReadBufferCommon(int32_t seqid, ::apache::
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.ReadBufferCommon");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcSetRequestDeadline");
   }
 
-  oprot->writeMessageBegin("ReadBufferCommon", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("RpcSetRequestDeadline", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.ReadBufferCommon", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcSetRequestDeadline", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcRegisterSecondaryNode(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_RpcDurableUnlink(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcRegisterSecondaryNode", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcDurableUnlink", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcRegisterSecondaryNode");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcDurableUnlink");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcRegisterSecondaryNode");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcDurableUnlink");
   }
 
-  DataPageAccess_RpcRegisterSecondaryNode_args args;
+  DataPageAccess_RpcDurableUnlink_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcRegisterSecondaryNode", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcDurableUnlink", bytes);
   }
 
-  DataPageAccess_RpcRegisterSecondaryNode_result result;
+  DataPageAccess_RpcDurableUnlink_result result;
   try {
-    result.success = iface_->RpcRegisterSecondaryNode(args._primary, args._lsn);
+    result.success = iface_->RpcDurableUnlink(args._fname, args._flag);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcRegisterSecondaryNode");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcDurableUnlink");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcRegisterSecondaryNode", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("RpcDurableUnlink", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -11960,51 +20657,52 @@ void DataPageAccessProcessor::process_RpcRegisterSecondaryNode(int32_t seqid, ::
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcRegisterSecondaryNode");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcDurableUnlink");
   }
 
-  oprot->writeMessageBegin("RpcRegisterSecondaryNode", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("RpcDurableUnlink", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcRegisterSecondaryNode", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcDurableUnlink", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcSecondaryNodeUpdatesLsn(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_RpcDurableRenameExcl(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcSecondaryNodeUpdatesLsn", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcDurableRenameExcl", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcDurableRenameExcl");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcDurableRenameExcl");
   }
 
-  DataPageAccess_RpcSecondaryNodeUpdatesLsn_args args;
+  DataPageAccess_RpcDurableRenameExcl_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcDurableRenameExcl", bytes);
   }
 
-  DataPageAccess_RpcSecondaryNodeUpdatesLsn_result result;
+  DataPageAccess_RpcDurableRenameExcl_result result;
   try {
-    iface_->RpcSecondaryNodeUpdatesLsn(args._node_id, args._lsn);
+    result.success = iface_->RpcDurableRenameExcl(args._oldFname, args._newFname, args._elevel);
+    result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcDurableRenameExcl");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcSecondaryNodeUpdatesLsn", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("RpcDurableRenameExcl", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12013,52 +20711,52 @@ void DataPageAccessProcessor::process_RpcSecondaryNodeUpdatesLsn(int32_t seqid,
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcDurableRenameExcl");
   }
 
-  oprot->writeMessageBegin("RpcSecondaryNodeUpdatesLsn", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("RpcDurableRenameExcl", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcSecondaryNodeUpdatesLsn", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcDurableRenameExcl", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcMdRead(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_RpcXLogWrite(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcMdRead", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcXLogWrite", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcMdRead");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcXLogWrite");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcMdRead");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcXLogWrite");
   }
 
-  DataPageAccess_RpcMdRead_args args;
+  DataPageAccess_RpcXLogWrite_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcMdRead", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcXLogWrite", bytes);
   }
 
-  DataPageAccess_RpcMdRead_result result;
+  DataPageAccess_RpcXLogWrite_result result;
   try {
-    iface_->RpcMdRead(result.success, args._reln, args._forknum, args._blknum, args._lsn);
+    result.success = iface_->RpcXLogWrite(args._fd, args._page, args._amount, args._offset, args._xlblocks, args._blknum, args._idx, args._lsn);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcMdRead");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcXLogWrite");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcMdRead", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("RpcXLogWrite", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12067,52 +20765,52 @@ void DataPageAccessProcessor::process_RpcMdRead(int32_t seqid, ::apache::thrift:
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcMdRead");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcXLogWrite");
   }
 
-  oprot->writeMessageBegin("RpcMdRead", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("RpcXLogWrite", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcMdRead", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcXLogWrite", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcMdNblocks(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_RpcXLogFileInit(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcMdNblocks", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcXLogFileInit", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcMdNblocks");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcXLogFileInit");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcMdNblocks");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcXLogFileInit");
   }
 
-  DataPageAccess_RpcMdNblocks_args args;
+  DataPageAccess_RpcXLogFileInit_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcMdNblocks", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcXLogFileInit", bytes);
   }
 
-  DataPageAccess_RpcMdNblocks_result result;
+  DataPageAccess_RpcXLogFileInit_result result;
   try {
-    result.success = iface_->RpcMdNblocks(args._reln, args._forknum, args._lsn);
+    iface_->RpcXLogFileInit(result.success, args._logsegno, args._use_existent, args._use_lock);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcMdNblocks");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcXLogFileInit");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcMdNblocks", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("RpcXLogFileInit", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12121,52 +20819,52 @@ void DataPageAccessProcessor::process_RpcMdNblocks(int32_t seqid, ::apache::thri
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcMdNblocks");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcXLogFileInit");
   }
 
-  oprot->writeMessageBegin("RpcMdNblocks", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("RpcXLogFileInit", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcMdNblocks", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcXLogFileInit", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcMdExists(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_ReadBufferBatch(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcMdExists", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.ReadBufferBatch", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcMdExists");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.ReadBufferBatch");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcMdExists");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.ReadBufferBatch");
   }
 
-  DataPageAccess_RpcMdExists_args args;
+  DataPageAccess_ReadBufferBatch_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcMdExists", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.ReadBufferBatch", bytes);
   }
 
-  DataPageAccess_RpcMdExists_result result;
+  DataPageAccess_ReadBufferBatch_result result;
   try {
-    result.success = iface_->RpcMdExists(args._reln, args._forknum, args._lsn);
+    iface_->ReadBufferBatch(result.success, args._reln, args._relpersistence, args._forknum, args._blknums, args._readBufferMode, args._lsn);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcMdExists");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.ReadBufferBatch");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcMdExists", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("ReadBufferBatch", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12175,51 +20873,52 @@ void DataPageAccessProcessor::process_RpcMdExists(int32_t seqid, ::apache::thrif
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcMdExists");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.ReadBufferBatch");
   }
 
-  oprot->writeMessageBegin("RpcMdExists", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("ReadBufferBatch", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcMdExists", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.ReadBufferBatch", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcMdCreate(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_ReadRelationHeads(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcMdCreate", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.ReadRelationHeads", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcMdCreate");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.ReadRelationHeads");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcMdCreate");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.ReadRelationHeads");
   }
 
-  DataPageAccess_RpcMdCreate_args args;
+  DataPageAccess_ReadRelationHeads_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcMdCreate", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.ReadRelationHeads", bytes);
   }
 
-  DataPageAccess_RpcMdCreate_result result;
+  DataPageAccess_ReadRelationHeads_result result;
   try {
-    iface_->RpcMdCreate(args._reln, args._forknum, args._isRedo, args._lsn);
+    iface_->ReadRelationHeads(result.success, args._relns, args._forknum, args._max_blocks, args._lsn);
+    result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcMdCreate");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.ReadRelationHeads");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcMdCreate", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("ReadRelationHeads", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12228,51 +20927,52 @@ void DataPageAccessProcessor::process_RpcMdCreate(int32_t seqid, ::apache::thrif
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcMdCreate");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.ReadRelationHeads");
   }
 
-  oprot->writeMessageBegin("RpcMdCreate", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("ReadRelationHeads", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcMdCreate", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.ReadRelationHeads", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcMdExtend(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_ReadBufferIfModified(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcMdExtend", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.ReadBufferIfModified", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcMdExtend");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.ReadBufferIfModified");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcMdExtend");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.ReadBufferIfModified");
   }
 
-  DataPageAccess_RpcMdExtend_args args;
+  DataPageAccess_ReadBufferIfModified_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcMdExtend", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.ReadBufferIfModified", bytes);
   }
 
-  DataPageAccess_RpcMdExtend_result result;
+  DataPageAccess_ReadBufferIfModified_result result;
   try {
-    iface_->RpcMdExtend(args._reln, args._forknum, args._blknum, args._buff, args.skipFsync, args._lsn);
+    iface_->ReadBufferIfModified(result.success, args._reln, args._relpersistence, args._forknum, args._blknum, args._readBufferMode, args._lsn, args._cachedLsn);
+    result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcMdExtend");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.ReadBufferIfModified");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcMdExtend", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("ReadBufferIfModified", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12281,51 +20981,52 @@ void DataPageAccessProcessor::process_RpcMdExtend(int32_t seqid, ::apache::thrif
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcMdExtend");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.ReadBufferIfModified");
   }
 
-  oprot->writeMessageBegin("RpcMdExtend", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("ReadBufferIfModified", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcMdExtend", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.ReadBufferIfModified", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcTruncate(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_PrefetchBuffers(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcTruncate", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.PrefetchBuffers", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcTruncate");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.PrefetchBuffers");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcTruncate");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.PrefetchBuffers");
   }
 
-  DataPageAccess_RpcTruncate_args args;
+  DataPageAccess_PrefetchBuffers_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcTruncate", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.PrefetchBuffers", bytes);
   }
 
-  DataPageAccess_RpcTruncate_result result;
+  DataPageAccess_PrefetchBuffers_result result;
   try {
-    iface_->RpcTruncate(args._reln, args._forknum, args._blknum, args._lsn);
+    result.success = iface_->PrefetchBuffers(args._reln, args._forknum, args._blknums, args._lsn);
+    result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcTruncate");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.PrefetchBuffers");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcTruncate", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("PrefetchBuffers", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12334,51 +21035,52 @@ void DataPageAccessProcessor::process_RpcTruncate(int32_t seqid, ::apache::thrif
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcTruncate");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.PrefetchBuffers");
   }
 
-  oprot->writeMessageBegin("RpcTruncate", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("PrefetchBuffers", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcTruncate", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.PrefetchBuffers", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcFileClose(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_InstallPages(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileClose", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.InstallPages", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileClose");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.InstallPages");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileClose");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.InstallPages");
   }
 
-  DataPageAccess_RpcFileClose_args args;
+  DataPageAccess_InstallPages_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileClose", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.InstallPages", bytes);
   }
 
-  DataPageAccess_RpcFileClose_result result;
+  DataPageAccess_InstallPages_result result;
   try {
-    iface_->RpcFileClose(args._fd);
+    result.success = iface_->InstallPages(args._reln, args._forknum, args._blknums, args._pages, args._lsn);
+    result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileClose");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.InstallPages");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcFileClose", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("InstallPages", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12387,51 +21089,52 @@ void DataPageAccessProcessor::process_RpcFileClose(int32_t seqid, ::apache::thri
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileClose");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.InstallPages");
   }
 
-  oprot->writeMessageBegin("RpcFileClose", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("InstallPages", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileClose", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.InstallPages", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcTablespaceCreateDbspace(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_InstallEvictedPages(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcTablespaceCreateDbspace", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.InstallEvictedPages", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcTablespaceCreateDbspace");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.InstallEvictedPages");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcTablespaceCreateDbspace");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.InstallEvictedPages");
   }
 
-  DataPageAccess_RpcTablespaceCreateDbspace_args args;
+  DataPageAccess_InstallEvictedPages_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcTablespaceCreateDbspace", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.InstallEvictedPages", bytes);
   }
 
-  DataPageAccess_RpcTablespaceCreateDbspace_result result;
+  DataPageAccess_InstallEvictedPages_result result;
   try {
-    iface_->RpcTablespaceCreateDbspace(args._spcnode, args._dbnode, args.isRedo);
+    result.success = iface_->InstallEvictedPages(args._reln, args._forknum, args._blknums, args._pages, args._lsn);
+    result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcTablespaceCreateDbspace");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.InstallEvictedPages");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcTablespaceCreateDbspace", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("InstallEvictedPages", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12440,52 +21143,52 @@ void DataPageAccessProcessor::process_RpcTablespaceCreateDbspace(int32_t seqid,
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcTablespaceCreateDbspace");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.InstallEvictedPages");
   }
 
-  oprot->writeMessageBegin("RpcTablespaceCreateDbspace", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("InstallEvictedPages", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcTablespaceCreateDbspace", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.InstallEvictedPages", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcPathNameOpenFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_RpcGetSmartReplayMetrics(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPathNameOpenFile", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcGetSmartReplayMetrics", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPathNameOpenFile");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcGetSmartReplayMetrics");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPathNameOpenFile");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcGetSmartReplayMetrics");
   }
 
-  DataPageAccess_RpcPathNameOpenFile_args args;
+  DataPageAccess_RpcGetSmartReplayMetrics_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPathNameOpenFile", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcGetSmartReplayMetrics", bytes);
   }
 
-  DataPageAccess_RpcPathNameOpenFile_result result;
+  DataPageAccess_RpcGetSmartReplayMetrics_result result;
   try {
-    result.success = iface_->RpcPathNameOpenFile(args._path, args._flag);
+    iface_->RpcGetSmartReplayMetrics(result.success);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPathNameOpenFile");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcGetSmartReplayMetrics");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcPathNameOpenFile", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("RpcGetSmartReplayMetrics", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12494,52 +21197,52 @@ void DataPageAccessProcessor::process_RpcPathNameOpenFile(int32_t seqid, ::apach
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPathNameOpenFile");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcGetSmartReplayMetrics");
   }
 
-  oprot->writeMessageBegin("RpcPathNameOpenFile", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("RpcGetSmartReplayMetrics", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPathNameOpenFile", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcGetSmartReplayMetrics", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcFileWrite(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_RpcFetchPageChanges(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileWrite", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFetchPageChanges", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileWrite");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFetchPageChanges");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileWrite");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFetchPageChanges");
   }
 
-  DataPageAccess_RpcFileWrite_args args;
+  DataPageAccess_RpcFetchPageChanges_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileWrite", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFetchPageChanges", bytes);
   }
 
-  DataPageAccess_RpcFileWrite_result result;
+  DataPageAccess_RpcFetchPageChanges_result result;
   try {
-    result.success = iface_->RpcFileWrite(args._fd, args._page, args._amount, args._seekpos, args._wait_event_info);
+    iface_->RpcFetchPageChanges(result.success, args._max_entries, args._wait_ms, args._from_seq);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileWrite");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFetchPageChanges");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcFileWrite", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("RpcFetchPageChanges", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12548,52 +21251,52 @@ void DataPageAccessProcessor::process_RpcFileWrite(int32_t seqid, ::apache::thri
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileWrite");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFetchPageChanges");
   }
 
-  oprot->writeMessageBegin("RpcFileWrite", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("RpcFetchPageChanges", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileWrite", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFetchPageChanges", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcFilePathName(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_RpcSecondaryNodeHeartbeat(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFilePathName", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcSecondaryNodeHeartbeat", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFilePathName");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcSecondaryNodeHeartbeat");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFilePathName");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcSecondaryNodeHeartbeat");
   }
 
-  DataPageAccess_RpcFilePathName_args args;
+  DataPageAccess_RpcSecondaryNodeHeartbeat_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFilePathName", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcSecondaryNodeHeartbeat", bytes);
   }
 
-  DataPageAccess_RpcFilePathName_result result;
+  DataPageAccess_RpcSecondaryNodeHeartbeat_result result;
   try {
-    iface_->RpcFilePathName(result.success, args._fd);
+    result.success = iface_->RpcSecondaryNodeHeartbeat(args._node_id, args._lsn);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFilePathName");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcSecondaryNodeHeartbeat");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcFilePathName", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("RpcSecondaryNodeHeartbeat", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12602,52 +21305,52 @@ void DataPageAccessProcessor::process_RpcFilePathName(int32_t seqid, ::apache::t
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFilePathName");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcSecondaryNodeHeartbeat");
   }
 
-  oprot->writeMessageBegin("RpcFilePathName", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("RpcSecondaryNodeHeartbeat", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFilePathName", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcSecondaryNodeHeartbeat", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcFileRead(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_RpcWaitWalParsed(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileRead", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.RpcWaitWalParsed", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileRead");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcWaitWalParsed");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileRead");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcWaitWalParsed");
   }
 
-  DataPageAccess_RpcFileRead_args args;
+  DataPageAccess_RpcWaitWalParsed_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileRead", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcWaitWalParsed", bytes);
   }
 
-  DataPageAccess_RpcFileRead_result result;
+  DataPageAccess_RpcWaitWalParsed_result result;
   try {
-    iface_->RpcFileRead(result.success, args._fd, args._amount, args._seekpos, args._wait_event_info);
+    result.success = iface_->RpcWaitWalParsed(args._wait_ms, args._lsn);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileRead");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcWaitWalParsed");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcFileRead", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("RpcWaitWalParsed", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12656,52 +21359,52 @@ void DataPageAccessProcessor::process_RpcFileRead(int32_t seqid, ::apache::thrif
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileRead");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcWaitWalParsed");
   }
 
-  oprot->writeMessageBegin("RpcFileRead", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("RpcWaitWalParsed", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileRead", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcWaitWalParsed", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcFileTruncate(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_ScanRelation(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileTruncate", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.ScanRelation", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileTruncate");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.ScanRelation");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileTruncate");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.ScanRelation");
   }
 
-  DataPageAccess_RpcFileTruncate_args args;
+  DataPageAccess_ScanRelation_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileTruncate", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.ScanRelation", bytes);
   }
 
-  DataPageAccess_RpcFileTruncate_result result;
+  DataPageAccess_ScanRelation_result result;
   try {
-    result.success = iface_->RpcFileTruncate(args._fd, args._offset);
+    iface_->ScanRelation(result.success, args._reln, args._first_block, args._end_block, args._qual, args._max_pages, args._lsn);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileTruncate");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.ScanRelation");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcFileTruncate", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("ScanRelation", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12710,52 +21413,52 @@ void DataPageAccessProcessor::process_RpcFileTruncate(int32_t seqid, ::apache::t
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileTruncate");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.ScanRelation");
   }
 
-  oprot->writeMessageBegin("RpcFileTruncate", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("ScanRelation", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileTruncate", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.ScanRelation", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcFileSize(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_AggregateRelation(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileSize", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.AggregateRelation", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileSize");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.AggregateRelation");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileSize");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.AggregateRelation");
   }
 
-  DataPageAccess_RpcFileSize_args args;
+  DataPageAccess_AggregateRelation_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileSize", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.AggregateRelation", bytes);
   }
 
-  DataPageAccess_RpcFileSize_result result;
+  DataPageAccess_AggregateRelation_result result;
   try {
-    result.success = iface_->RpcFileSize(args._fd);
+    iface_->AggregateRelation(result.success, args._reln, args._first_block, args._end_block, args._spec, args._max_fallback, args._lsn);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileSize");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.AggregateRelation");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcFileSize", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("AggregateRelation", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12764,52 +21467,52 @@ void DataPageAccessProcessor::process_RpcFileSize(int32_t seqid, ::apache::thrif
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileSize");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.AggregateRelation");
   }
 
-  oprot->writeMessageBegin("RpcFileSize", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("AggregateRelation", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileSize", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.AggregateRelation", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcFilePrefetch(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_TriageVacuum(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFilePrefetch", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.TriageVacuum", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFilePrefetch");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.TriageVacuum");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFilePrefetch");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.TriageVacuum");
   }
 
-  DataPageAccess_RpcFilePrefetch_args args;
+  DataPageAccess_TriageVacuum_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFilePrefetch", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.TriageVacuum", bytes);
   }
 
-  DataPageAccess_RpcFilePrefetch_result result;
+  DataPageAccess_TriageVacuum_result result;
   try {
-    result.success = iface_->RpcFilePrefetch(args._fd, args._offset, args._amount, args.wait_event_info);
+    iface_->TriageVacuum(result.success, args._reln, args._first_block, args._end_block, args._horizon, args._max_dead, args._lsn);
     result.__isset.success = true;
   } catch (const std::exception& e) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFilePrefetch");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.TriageVacuum");
     }
 
     ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcFilePrefetch", ::apache::thrift::protocol::T_EXCEPTION, seqid);
+    oprot->writeMessageBegin("TriageVacuum", ::apache::thrift::protocol::T_EXCEPTION, seqid);
     x.write(oprot);
     oprot->writeMessageEnd();
     oprot->getTransport()->writeEnd();
@@ -12818,1486 +21521,1954 @@ void DataPageAccessProcessor::process_RpcFilePrefetch(int32_t seqid, ::apache::t
   }
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFilePrefetch");
+    this->eventHandler_->preWrite(ctx, "DataPageAccess.TriageVacuum");
   }
 
-  oprot->writeMessageBegin("RpcFilePrefetch", ::apache::thrift::protocol::T_REPLY, seqid);
+  oprot->writeMessageBegin("TriageVacuum", ::apache::thrift::protocol::T_REPLY, seqid);
   result.write(oprot);
   oprot->writeMessageEnd();
   bytes = oprot->getTransport()->writeEnd();
   oprot->getTransport()->flush();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFilePrefetch", bytes);
+    this->eventHandler_->postWrite(ctx, "DataPageAccess.TriageVacuum", bytes);
   }
 }
 
-void DataPageAccessProcessor::process_RpcFileWriteback(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessProcessor::process_zip(int32_t, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol*, void* callContext)
 {
   void* ctx = nullptr;
   if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileWriteback", callContext);
+    ctx = this->eventHandler_->getContext("DataPageAccess.zip", callContext);
   }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileWriteback");
+  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.zip");
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileWriteback");
+    this->eventHandler_->preRead(ctx, "DataPageAccess.zip");
   }
 
-  DataPageAccess_RpcFileWriteback_args args;
+  DataPageAccess_zip_args args;
   args.read(iprot);
   iprot->readMessageEnd();
   uint32_t bytes = iprot->getTransport()->readEnd();
 
   if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileWriteback", bytes);
+    this->eventHandler_->postRead(ctx, "DataPageAccess.zip", bytes);
   }
 
-  DataPageAccess_RpcFileWriteback_result result;
   try {
-    iface_->RpcFileWriteback(args._fd, args._offset, args.nbytes, args.wait_event_info);
-  } catch (const std::exception& e) {
+    iface_->zip();
+  } catch (const std::exception&) {
     if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileWriteback");
+      this->eventHandler_->handlerError(ctx, "DataPageAccess.zip");
+    }
+    return;
+  }
+
+  if (this->eventHandler_.get() != nullptr) {
+    this->eventHandler_->asyncComplete(ctx, "DataPageAccess.zip");
+  }
+
+  return;
+}
+
+::std::shared_ptr< ::apache::thrift::TProcessor > DataPageAccessProcessorFactory::getProcessor(const ::apache::thrift::TConnectionInfo& connInfo) {
+  ::apache::thrift::ReleaseHandler< DataPageAccessIfFactory > cleanup(handlerFactory_);
+  ::std::shared_ptr< DataPageAccessIf > handler(handlerFactory_->getHandler(connInfo), cleanup);
+  ::std::shared_ptr< ::apache::thrift::TProcessor > processor(new DataPageAccessProcessor(handler));
+  return processor;
+}
+
+void DataPageAccessConcurrentClient::ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId)
+{
+  int32_t seqid = send_ReadBufferCommon(_reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn, _traceId);
+  recv_ReadBufferCommon(_return, seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::send_ReadBufferCommon(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("ReadBufferCommon", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_ReadBufferCommon_pargs args;
+  args._reln = &_reln;
+  args._relpersistence = &_relpersistence;
+  args._forknum = &_forknum;
+  args._blknum = &_blknum;
+  args._readBufferMode = &_readBufferMode;
+  args._lsn = &_lsn;
+  args._traceId = &_traceId;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
+}
+
+void DataPageAccessConcurrentClient::recv_ReadBufferCommon(_Page& _return, const int32_t seqid)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
+
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("ReadBufferCommon") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_ReadBufferCommon_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        // _return pointer has now been filled
+        sentry.commit();
+        return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ReadBufferCommon failed: unknown result");
+    }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
+
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
+
+int32_t DataPageAccessConcurrentClient::RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn)
+{
+  int32_t seqid = send_RpcRegisterSecondaryNode(_primary, _lsn);
+  return recv_RpcRegisterSecondaryNode(seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::send_RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcRegisterSecondaryNode", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcRegisterSecondaryNode_pargs args;
+  args._primary = &_primary;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
+}
+
+int32_t DataPageAccessConcurrentClient::recv_RpcRegisterSecondaryNode(const int32_t seqid)
+{
+
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
+
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
+
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcRegisterSecondaryNode") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      int32_t _return;
+      DataPageAccess_RpcRegisterSecondaryNode_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcRegisterSecondaryNode failed: unknown result");
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
+
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
+
+void DataPageAccessConcurrentClient::RpcSecondaryNodeUpdatesLsn(const int32_t _node_id, const int64_t _lsn)
+{
+  int32_t seqid = send_RpcSecondaryNodeUpdatesLsn(_node_id, _lsn);
+  recv_RpcSecondaryNodeUpdatesLsn(seqid);
+}
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcFileWriteback", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcSecondaryNodeUpdatesLsn(const int32_t _node_id, const int64_t _lsn)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcSecondaryNodeUpdatesLsn", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileWriteback");
-  }
+  DataPageAccess_RpcSecondaryNodeUpdatesLsn_pargs args;
+  args._node_id = &_node_id;
+  args._lsn = &_lsn;
+  args.write(oprot_);
 
-  oprot->writeMessageBegin("RpcFileWriteback", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileWriteback", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcUnlink(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::recv_RpcSecondaryNodeUpdatesLsn(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcUnlink", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcUnlink");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcUnlink");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_RpcUnlink_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcUnlink", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcSecondaryNodeUpdatesLsn") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcUnlink_result result;
-  try {
-    result.success = iface_->RpcUnlink(args._path);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcUnlink");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_RpcSecondaryNodeUpdatesLsn_presult result;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      sentry.commit();
+      return;
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcUnlink", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcUnlink");
-  }
+void DataPageAccessConcurrentClient::RpcMdRead(_Page& _return, const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _blknum, const int64_t _lsn)
+{
+  int32_t seqid = send_RpcMdRead(_reln, _forknum, _blknum, _lsn);
+  recv_RpcMdRead(_return, seqid);
+}
 
-  oprot->writeMessageBegin("RpcUnlink", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+int32_t DataPageAccessConcurrentClient::send_RpcMdRead(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _blknum, const int64_t _lsn)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcMdRead", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcUnlink", bytes);
-  }
+  DataPageAccess_RpcMdRead_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknum = &_blknum;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcFtruncate(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::recv_RpcMdRead(_Page& _return, const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFtruncate", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFtruncate");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFtruncate");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_RpcFtruncate_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFtruncate", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcMdRead") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcFtruncate_result result;
-  try {
-    result.success = iface_->RpcFtruncate(args._fd, args._offset);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFtruncate");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_RpcMdRead_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        // _return pointer has now been filled
+        sentry.commit();
+        return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdRead failed: unknown result");
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcFtruncate", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFtruncate");
-  }
+int32_t DataPageAccessConcurrentClient::RpcMdNblocks(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
+{
+  int32_t seqid = send_RpcMdNblocks(_reln, _forknum, _lsn);
+  return recv_RpcMdNblocks(seqid);
+}
 
-  oprot->writeMessageBegin("RpcFtruncate", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+int32_t DataPageAccessConcurrentClient::send_RpcMdNblocks(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcMdNblocks", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcMdNblocks_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFtruncate", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcInitFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+int32_t DataPageAccessConcurrentClient::recv_RpcMdNblocks(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcInitFile", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcInitFile");
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcInitFile");
-  }
 
-  DataPageAccess_RpcInitFile_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcInitFile", bytes);
-  }
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  DataPageAccess_RpcInitFile_result result;
-  try {
-    iface_->RpcInitFile(result.success, args._path);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcInitFile");
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
     }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcMdNblocks") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcInitFile", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcInitFile");
-  }
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      int32_t _return;
+      DataPageAccess_RpcMdNblocks_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
 
-  oprot->writeMessageBegin("RpcInitFile", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdNblocks failed: unknown result");
+    }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcInitFile", bytes);
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
 }
 
-void DataPageAccessProcessor::process_RpcOpenTransientFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+int32_t DataPageAccessConcurrentClient::RpcMdExists(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcOpenTransientFile", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcOpenTransientFile");
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcOpenTransientFile");
-  }
-
-  DataPageAccess_RpcOpenTransientFile_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcOpenTransientFile", bytes);
-  }
-
-  DataPageAccess_RpcOpenTransientFile_result result;
-  try {
-    result.success = iface_->RpcOpenTransientFile(args._filename, args._fileflags);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcOpenTransientFile");
-    }
+  int32_t seqid = send_RpcMdExists(_reln, _forknum, _lsn);
+  return recv_RpcMdExists(seqid);
+}
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcOpenTransientFile", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcMdExists(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcMdExists", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcOpenTransientFile");
-  }
+  DataPageAccess_RpcMdExists_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._lsn = &_lsn;
+  args.write(oprot_);
 
-  oprot->writeMessageBegin("RpcOpenTransientFile", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcOpenTransientFile", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcOpenTransientFileUnderPgData(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+int32_t DataPageAccessConcurrentClient::recv_RpcMdExists(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcOpenTransientFileUnderPgData", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_RpcOpenTransientFileUnderPgData_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcMdExists") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcOpenTransientFileUnderPgData_result result;
-  try {
-    result.success = iface_->RpcOpenTransientFileUnderPgData(args._filename, args._fileflags);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      int32_t _return;
+      DataPageAccess_RpcMdExists_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdExists failed: unknown result");
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcOpenTransientFileUnderPgData", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
+
+void DataPageAccessConcurrentClient::RpcMdCreate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _isRedo, const int64_t _lsn)
+{
+  int32_t seqid = send_RpcMdCreate(_reln, _forknum, _isRedo, _lsn);
+  recv_RpcMdCreate(seqid);
+}
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData");
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcMdCreate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _isRedo, const int64_t _lsn)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcMdCreate", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  oprot->writeMessageBegin("RpcOpenTransientFileUnderPgData", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  DataPageAccess_RpcMdCreate_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._isRedo = &_isRedo;
+  args._lsn = &_lsn;
+  args.write(oprot_);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcOpenTransientFileUnderPgData", bytes);
-  }
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcCloseTransientFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::recv_RpcMdCreate(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcCloseTransientFile", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcCloseTransientFile");
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcCloseTransientFile");
-  }
 
-  DataPageAccess_RpcCloseTransientFile_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcCloseTransientFile", bytes);
-  }
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  DataPageAccess_RpcCloseTransientFile_result result;
-  try {
-    result.success = iface_->RpcCloseTransientFile(args._fd);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcCloseTransientFile");
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
     }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcMdCreate") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcCloseTransientFile", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_RpcMdCreate_presult result;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcCloseTransientFile");
-  }
+      sentry.commit();
+      return;
+    }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-  oprot->writeMessageBegin("RpcCloseTransientFile", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcCloseTransientFile", bytes);
-  }
+void DataPageAccessConcurrentClient::RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn)
+{
+  int32_t seqid = send_RpcMdExtend(_reln, _forknum, _blknum, _buff, skipFsync, _lsn);
+  recv_RpcMdExtend(seqid);
 }
 
-void DataPageAccessProcessor::process_Rpcread(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.Rpcread", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.Rpcread");
+  int32_t seqid = send_RpcMdExtendMany(_reln, _forknum, _startblk, _nblocks, skipFsync, _lsn);
+  recv_RpcMdExtendMany(seqid);
+}
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.Rpcread");
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcMdExtend", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_Rpcread_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  DataPageAccess_RpcMdExtend_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknum = &_blknum;
+  args._buff = &_buff;
+  args.skipFsync = &skipFsync;
+  args._lsn = &_lsn;
+  args.write(oprot_);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.Rpcread", bytes);
-  }
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  DataPageAccess_Rpcread_result result;
-  try {
-    iface_->Rpcread(result.success, args._fd, args.size);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.Rpcread");
-    }
+  sentry.commit();
+  return cseqid;
+}
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("Rpcread", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcMdExtendMany", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.Rpcread");
-  }
+  DataPageAccess_RpcMdExtendMany_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._startblk = &_startblk;
+  args._nblocks = &_nblocks;
+  args.skipFsync = &skipFsync;
+  args._lsn = &_lsn;
+  args.write(oprot_);
 
-  oprot->writeMessageBegin("Rpcread", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.Rpcread", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_Rpcwrite(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::recv_RpcMdExtend(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.Rpcwrite", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.Rpcwrite");
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.Rpcwrite");
-  }
 
-  DataPageAccess_Rpcwrite_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.Rpcwrite", bytes);
-  }
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  DataPageAccess_Rpcwrite_result result;
-  try {
-    result.success = iface_->Rpcwrite(args._fd, args._page, args.size);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.Rpcwrite");
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
     }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcMdExtend") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("Rpcwrite", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.Rpcwrite");
-  }
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_RpcMdExtend_presult result;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
 
-  oprot->writeMessageBegin("Rpcwrite", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+      sentry.commit();
+      return;
+    }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.Rpcwrite", bytes);
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
 }
 
-void DataPageAccessProcessor::process_RpcFileSync(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::recv_RpcMdExtendMany(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcFileSync", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcFileSync");
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcFileSync");
-  }
 
-  DataPageAccess_RpcFileSync_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcFileSync", bytes);
-  }
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  DataPageAccess_RpcFileSync_result result;
-  try {
-    result.success = iface_->RpcFileSync(args._fd, args._wait_event_info);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcFileSync");
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
     }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcMdExtendMany") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcFileSync", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcFileSync");
-  }
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_RpcMdExtendMany_presult result;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
 
-  oprot->writeMessageBegin("RpcFileSync", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+      sentry.commit();
+      return;
+    }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcFileSync", bytes);
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
 }
 
-void DataPageAccessProcessor::process_RpcPgPRead(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPgPRead", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPgPRead");
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPgPRead");
-  }
-
-  DataPageAccess_RpcPgPRead_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPgPRead", bytes);
-  }
-
-  DataPageAccess_RpcPgPRead_result result;
-  try {
-    iface_->RpcPgPRead(result.success, args._fd, args._seg_bytes, args._start_off);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPgPRead");
-    }
+  int32_t seqid = send_RpcTruncate(_reln, _forknum, _blknum, _lsn);
+  recv_RpcTruncate(seqid);
+}
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcPgPRead", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcTruncate", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPgPRead");
-  }
+  DataPageAccess_RpcTruncate_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknum = &_blknum;
+  args._lsn = &_lsn;
+  args.write(oprot_);
 
-  oprot->writeMessageBegin("RpcPgPRead", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPgPRead", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcPgPWrite(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::recv_RpcTruncate(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPgPWrite", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPgPWrite");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPgPWrite");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_RpcPgPWrite_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPgPWrite", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcTruncate") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcPgPWrite_result result;
-  try {
-    result.success = iface_->RpcPgPWrite(args._fd, args._page, args._amount, args._offset);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPgPWrite");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_RpcTruncate_presult result;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      sentry.commit();
+      return;
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
+
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
+
+void DataPageAccessConcurrentClient::RpcFileClose(const _File _fd)
+{
+  int32_t seqid = send_RpcFileClose(_fd);
+  recv_RpcFileClose(seqid);
+}
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcPgPWrite", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcFileClose(const _File _fd)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcFileClose", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPgPWrite");
-  }
+  DataPageAccess_RpcFileClose_pargs args;
+  args._fd = &_fd;
+  args.write(oprot_);
 
-  oprot->writeMessageBegin("RpcPgPWrite", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPgPWrite", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcClose(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::recv_RpcFileClose(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcClose", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcClose");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcClose");
-  }
-
-  DataPageAccess_RpcClose_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcClose", bytes);
-  }
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  DataPageAccess_RpcClose_result result;
-  try {
-    result.success = iface_->RpcClose(args._fd);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcClose");
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
     }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcFileClose") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcClose", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcClose");
-  }
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_RpcFileClose_presult result;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
 
-  oprot->writeMessageBegin("RpcClose", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+      sentry.commit();
+      return;
+    }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcClose", bytes);
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
 }
 
-void DataPageAccessProcessor::process_RpcBasicOpenFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::RpcTablespaceCreateDbspace(const _Oid _spcnode, const _Oid _dbnode, const bool isRedo)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcBasicOpenFile", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcBasicOpenFile");
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcBasicOpenFile");
-  }
-
-  DataPageAccess_RpcBasicOpenFile_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcBasicOpenFile", bytes);
-  }
-
-  DataPageAccess_RpcBasicOpenFile_result result;
-  try {
-    result.success = iface_->RpcBasicOpenFile(args._path, args._flags);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcBasicOpenFile");
-    }
+  int32_t seqid = send_RpcTablespaceCreateDbspace(_spcnode, _dbnode, isRedo);
+  recv_RpcTablespaceCreateDbspace(seqid);
+}
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcBasicOpenFile", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcTablespaceCreateDbspace(const _Oid _spcnode, const _Oid _dbnode, const bool isRedo)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcTablespaceCreateDbspace", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcBasicOpenFile");
-  }
+  DataPageAccess_RpcTablespaceCreateDbspace_pargs args;
+  args._spcnode = &_spcnode;
+  args._dbnode = &_dbnode;
+  args.isRedo = &isRedo;
+  args.write(oprot_);
 
-  oprot->writeMessageBegin("RpcBasicOpenFile", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcBasicOpenFile", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcBasicOpenFileUnderPgData(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::recv_RpcTablespaceCreateDbspace(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcBasicOpenFileUnderPgData", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_RpcBasicOpenFileUnderPgData_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcTablespaceCreateDbspace") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcBasicOpenFileUnderPgData_result result;
-  try {
-    result.success = iface_->RpcBasicOpenFileUnderPgData(args._path, args._flags);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_RpcTablespaceCreateDbspace_presult result;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      sentry.commit();
+      return;
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
+
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcBasicOpenFileUnderPgData", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+_File DataPageAccessConcurrentClient::RpcPathNameOpenFile(const _Path& _path, const _Flag _flag)
+{
+  int32_t seqid = send_RpcPathNameOpenFile(_path, _flag);
+  return recv_RpcPathNameOpenFile(seqid);
+}
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData");
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcPathNameOpenFile(const _Path& _path, const _Flag _flag)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcPathNameOpenFile", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  oprot->writeMessageBegin("RpcBasicOpenFileUnderPgData", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  DataPageAccess_RpcPathNameOpenFile_pargs args;
+  args._path = &_path;
+  args._flag = &_flag;
+  args.write(oprot_);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcBasicOpenFileUnderPgData", bytes);
-  }
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcPgFdatasync(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+_File DataPageAccessConcurrentClient::recv_RpcPathNameOpenFile(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPgFdatasync", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPgFdatasync");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPgFdatasync");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_RpcPgFdatasync_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPgFdatasync", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcPathNameOpenFile") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcPgFdatasync_result result;
-  try {
-    result.success = iface_->RpcPgFdatasync(args._fd);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPgFdatasync");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      _File _return;
+      DataPageAccess_RpcPathNameOpenFile_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPathNameOpenFile failed: unknown result");
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcPgFdatasync", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPgFdatasync");
-  }
+int32_t DataPageAccessConcurrentClient::RpcFileWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
+{
+  int32_t seqid = send_RpcFileWrite(_fd, _page, _amount, _seekpos, _wait_event_info);
+  return recv_RpcFileWrite(seqid);
+}
 
-  oprot->writeMessageBegin("RpcPgFdatasync", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+int32_t DataPageAccessConcurrentClient::send_RpcFileWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcFileWrite", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPgFdatasync", bytes);
-  }
+  DataPageAccess_RpcFileWrite_pargs args;
+  args._fd = &_fd;
+  args._page = &_page;
+  args._amount = &_amount;
+  args._seekpos = &_seekpos;
+  args._wait_event_info = &_wait_event_info;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcPgFsyncNoWritethrough(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+int32_t DataPageAccessConcurrentClient::recv_RpcFileWrite(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPgFsyncNoWritethrough", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPgFsyncNoWritethrough");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPgFsyncNoWritethrough");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_RpcPgFsyncNoWritethrough_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPgFsyncNoWritethrough", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcFileWrite") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcPgFsyncNoWritethrough_result result;
-  try {
-    result.success = iface_->RpcPgFsyncNoWritethrough(args._fd);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPgFsyncNoWritethrough");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      int32_t _return;
+      DataPageAccess_RpcFileWrite_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileWrite failed: unknown result");
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcPgFsyncNoWritethrough", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPgFsyncNoWritethrough");
-  }
+void DataPageAccessConcurrentClient::RpcFilePathName(_Path& _return, const _File _fd)
+{
+  int32_t seqid = send_RpcFilePathName(_fd);
+  recv_RpcFilePathName(_return, seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::send_RpcFilePathName(const _File _fd)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcFilePathName", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcFilePathName_pargs args;
+  args._fd = &_fd;
+  args.write(oprot_);
 
-  oprot->writeMessageBegin("RpcPgFsyncNoWritethrough", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPgFsyncNoWritethrough", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcLseek(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::recv_RpcFilePathName(_Path& _return, const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcLseek", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcLseek");
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcLseek");
-  }
 
-  DataPageAccess_RpcLseek_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcLseek", bytes);
-  }
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  DataPageAccess_RpcLseek_result result;
-  try {
-    result.success = iface_->RpcLseek(args._fd, args._offset, args._flag);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcLseek");
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
     }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcFilePathName") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcLseek", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcLseek");
-  }
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_RpcFilePathName_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
 
-  oprot->writeMessageBegin("RpcLseek", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+      if (result.__isset.success) {
+        // _return pointer has now been filled
+        sentry.commit();
+        return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFilePathName failed: unknown result");
+    }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcLseek", bytes);
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
 }
 
-void DataPageAccessProcessor::process_RpcStat(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::RpcFileRead(_Page& _return, const _File _fd, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcStat", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcStat");
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcStat");
-  }
-
-  DataPageAccess_RpcStat_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcStat", bytes);
-  }
-
-  DataPageAccess_RpcStat_result result;
-  try {
-    iface_->RpcStat(result.success, args._path);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcStat");
-    }
+  int32_t seqid = send_RpcFileRead(_fd, _amount, _seekpos, _wait_event_info);
+  recv_RpcFileRead(_return, seqid);
+}
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcStat", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcFileRead(const _File _fd, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcFileRead", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcStat");
-  }
+  DataPageAccess_RpcFileRead_pargs args;
+  args._fd = &_fd;
+  args._amount = &_amount;
+  args._seekpos = &_seekpos;
+  args._wait_event_info = &_wait_event_info;
+  args.write(oprot_);
 
-  oprot->writeMessageBegin("RpcStat", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcStat", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcDirectoryIsEmpty(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::recv_RpcFileRead(_Page& _return, const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcDirectoryIsEmpty", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcDirectoryIsEmpty");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcDirectoryIsEmpty");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_RpcDirectoryIsEmpty_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcDirectoryIsEmpty", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcFileRead") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcDirectoryIsEmpty_result result;
-  try {
-    result.success = iface_->RpcDirectoryIsEmpty(args._path);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcDirectoryIsEmpty");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_RpcFileRead_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        // _return pointer has now been filled
+        sentry.commit();
+        return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileRead failed: unknown result");
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
+
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
+
+int32_t DataPageAccessConcurrentClient::RpcFileTruncate(const _File _fd, const _Off_t _offset)
+{
+  int32_t seqid = send_RpcFileTruncate(_fd, _offset);
+  return recv_RpcFileTruncate(seqid);
+}
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcDirectoryIsEmpty", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcFileTruncate(const _File _fd, const _Off_t _offset)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcFileTruncate", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcDirectoryIsEmpty");
-  }
+  DataPageAccess_RpcFileTruncate_pargs args;
+  args._fd = &_fd;
+  args._offset = &_offset;
+  args.write(oprot_);
 
-  oprot->writeMessageBegin("RpcDirectoryIsEmpty", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcDirectoryIsEmpty", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcCopyDir(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+int32_t DataPageAccessConcurrentClient::recv_RpcFileTruncate(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcCopyDir", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcCopyDir");
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcCopyDir");
-  }
 
-  DataPageAccess_RpcCopyDir_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcCopyDir", bytes);
-  }
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  DataPageAccess_RpcCopyDir_result result;
-  try {
-    result.success = iface_->RpcCopyDir(args._src, args._dst);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcCopyDir");
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
     }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcFileTruncate") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcCopyDir", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcCopyDir");
-  }
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      int32_t _return;
+      DataPageAccess_RpcFileTruncate_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
 
-  oprot->writeMessageBegin("RpcCopyDir", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileTruncate failed: unknown result");
+    }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcCopyDir", bytes);
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
 }
 
-void DataPageAccessProcessor::process_RpcPgFsync(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+_Off_t DataPageAccessConcurrentClient::RpcFileSize(const _File _fd)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcPgFsync", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcPgFsync");
-
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcPgFsync");
-  }
+  int32_t seqid = send_RpcFileSize(_fd);
+  return recv_RpcFileSize(seqid);
+}
 
-  DataPageAccess_RpcPgFsync_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+int32_t DataPageAccessConcurrentClient::send_RpcFileSize(const _File _fd)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcFileSize", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcPgFsync", bytes);
-  }
+  DataPageAccess_RpcFileSize_pargs args;
+  args._fd = &_fd;
+  args.write(oprot_);
 
-  DataPageAccess_RpcPgFsync_result result;
-  try {
-    result.success = iface_->RpcPgFsync(args._fd);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcPgFsync");
-    }
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcPgFsync", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+  sentry.commit();
+  return cseqid;
+}
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcPgFsync");
-  }
+_Off_t DataPageAccessConcurrentClient::recv_RpcFileSize(const int32_t seqid)
+{
 
-  oprot->writeMessageBegin("RpcPgFsync", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcPgFsync", bytes);
-  }
-}
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-void DataPageAccessProcessor::process_RpcDurableUnlink(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
-{
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcDurableUnlink", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcDurableUnlink");
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcFileSize") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcDurableUnlink");
-  }
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      _Off_t _return;
+      DataPageAccess_RpcFileSize_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcDurableUnlink_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileSize failed: unknown result");
+    }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcDurableUnlink", bytes);
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
 
-  DataPageAccess_RpcDurableUnlink_result result;
-  try {
-    result.success = iface_->RpcDurableUnlink(args._fname, args._flag);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcDurableUnlink");
-    }
+int32_t DataPageAccessConcurrentClient::RpcFilePrefetch(const _File _fd, const _Off_t _offset, const int32_t _amount, const int32_t wait_event_info)
+{
+  int32_t seqid = send_RpcFilePrefetch(_fd, _offset, _amount, wait_event_info);
+  return recv_RpcFilePrefetch(seqid);
+}
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcDurableUnlink", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+int32_t DataPageAccessConcurrentClient::send_RpcFilePrefetch(const _File _fd, const _Off_t _offset, const int32_t _amount, const int32_t wait_event_info)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcFilePrefetch", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcDurableUnlink");
-  }
+  DataPageAccess_RpcFilePrefetch_pargs args;
+  args._fd = &_fd;
+  args._offset = &_offset;
+  args._amount = &_amount;
+  args.wait_event_info = &wait_event_info;
+  args.write(oprot_);
 
-  oprot->writeMessageBegin("RpcDurableUnlink", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcDurableUnlink", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcDurableRenameExcl(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+int32_t DataPageAccessConcurrentClient::recv_RpcFilePrefetch(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcDurableRenameExcl", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcDurableRenameExcl");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcDurableRenameExcl");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_RpcDurableRenameExcl_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcDurableRenameExcl", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcFilePrefetch") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcDurableRenameExcl_result result;
-  try {
-    result.success = iface_->RpcDurableRenameExcl(args._oldFname, args._newFname, args._elevel);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcDurableRenameExcl");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      int32_t _return;
+      DataPageAccess_RpcFilePrefetch_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFilePrefetch failed: unknown result");
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcDurableRenameExcl", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcDurableRenameExcl");
-  }
+void DataPageAccessConcurrentClient::RpcFileWriteback(const _File _fd, const _Off_t _offset, const _Off_t nbytes, const int32_t wait_event_info)
+{
+  int32_t seqid = send_RpcFileWriteback(_fd, _offset, nbytes, wait_event_info);
+  recv_RpcFileWriteback(seqid);
+}
 
-  oprot->writeMessageBegin("RpcDurableRenameExcl", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+int32_t DataPageAccessConcurrentClient::send_RpcFileWriteback(const _File _fd, const _Off_t _offset, const _Off_t nbytes, const int32_t wait_event_info)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcFileWriteback", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcDurableRenameExcl", bytes);
-  }
+  DataPageAccess_RpcFileWriteback_pargs args;
+  args._fd = &_fd;
+  args._offset = &_offset;
+  args.nbytes = &nbytes;
+  args.wait_event_info = &wait_event_info;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcXLogWrite(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+void DataPageAccessConcurrentClient::recv_RpcFileWriteback(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcXLogWrite", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcXLogWrite");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcXLogWrite");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_RpcXLogWrite_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcXLogWrite", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcFileWriteback") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcXLogWrite_result result;
-  try {
-    result.success = iface_->RpcXLogWrite(args._fd, args._page, args._amount, args._offset, args._xlblocks, args._blknum, args._idx, args._lsn);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcXLogWrite");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      DataPageAccess_RpcFileWriteback_presult result;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      sentry.commit();
+      return;
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcXLogWrite", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
+
+int32_t DataPageAccessConcurrentClient::RpcUnlink(const _Path& _path)
+{
+  int32_t seqid = send_RpcUnlink(_path);
+  return recv_RpcUnlink(seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::send_RpcUnlink(const _Path& _path)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcUnlink", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcXLogWrite");
-  }
+  DataPageAccess_RpcUnlink_pargs args;
+  args._path = &_path;
+  args.write(oprot_);
 
-  oprot->writeMessageBegin("RpcXLogWrite", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcXLogWrite", bytes);
-  }
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_RpcXLogFileInit(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext)
+int32_t DataPageAccessConcurrentClient::recv_RpcUnlink(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.RpcXLogFileInit", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.RpcXLogFileInit");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.RpcXLogFileInit");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_RpcXLogFileInit_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.RpcXLogFileInit", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcUnlink") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  DataPageAccess_RpcXLogFileInit_result result;
-  try {
-    iface_->RpcXLogFileInit(result.success, args._logsegno, args._use_existent, args._use_lock);
-    result.__isset.success = true;
-  } catch (const std::exception& e) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.RpcXLogFileInit");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      int32_t _return;
+      DataPageAccess_RpcUnlink_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcUnlink failed: unknown result");
     }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-    ::apache::thrift::TApplicationException x(e.what());
-    oprot->writeMessageBegin("RpcXLogFileInit", ::apache::thrift::protocol::T_EXCEPTION, seqid);
-    x.write(oprot);
-    oprot->writeMessageEnd();
-    oprot->getTransport()->writeEnd();
-    oprot->getTransport()->flush();
-    return;
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preWrite(ctx, "DataPageAccess.RpcXLogFileInit");
-  }
+int32_t DataPageAccessConcurrentClient::RpcFtruncate(const _File _fd, const _Off_t _offset)
+{
+  int32_t seqid = send_RpcFtruncate(_fd, _offset);
+  return recv_RpcFtruncate(seqid);
+}
 
-  oprot->writeMessageBegin("RpcXLogFileInit", ::apache::thrift::protocol::T_REPLY, seqid);
-  result.write(oprot);
-  oprot->writeMessageEnd();
-  bytes = oprot->getTransport()->writeEnd();
-  oprot->getTransport()->flush();
+int32_t DataPageAccessConcurrentClient::send_RpcFtruncate(const _File _fd, const _Off_t _offset)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcFtruncate", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postWrite(ctx, "DataPageAccess.RpcXLogFileInit", bytes);
-  }
+  DataPageAccess_RpcFtruncate_pargs args;
+  args._fd = &_fd;
+  args._offset = &_offset;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
 }
 
-void DataPageAccessProcessor::process_zip(int32_t, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol*, void* callContext)
+int32_t DataPageAccessConcurrentClient::recv_RpcFtruncate(const int32_t seqid)
 {
-  void* ctx = nullptr;
-  if (this->eventHandler_.get() != nullptr) {
-    ctx = this->eventHandler_->getContext("DataPageAccess.zip", callContext);
-  }
-  ::apache::thrift::TProcessorContextFreer freer(this->eventHandler_.get(), ctx, "DataPageAccess.zip");
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->preRead(ctx, "DataPageAccess.zip");
-  }
+  int32_t rseqid = 0;
+  std::string fname;
+  ::apache::thrift::protocol::TMessageType mtype;
 
-  DataPageAccess_zip_args args;
-  args.read(iprot);
-  iprot->readMessageEnd();
-  uint32_t bytes = iprot->getTransport()->readEnd();
+  // the read mutex gets dropped and reacquired as part of waitForWork()
+  // The destructor of this sentry wakes up other clients
+  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->postRead(ctx, "DataPageAccess.zip", bytes);
-  }
+  while(true) {
+    if(!this->sync_->getPending(fname, mtype, rseqid)) {
+      iprot_->readMessageBegin(fname, mtype, rseqid);
+    }
+    if(seqid == rseqid) {
+      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
+        ::apache::thrift::TApplicationException x;
+        x.read(iprot_);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+        sentry.commit();
+        throw x;
+      }
+      if (mtype != ::apache::thrift::protocol::T_REPLY) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
+      }
+      if (fname.compare("RpcFtruncate") != 0) {
+        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
+        iprot_->readMessageEnd();
+        iprot_->getTransport()->readEnd();
 
-  try {
-    iface_->zip();
-  } catch (const std::exception&) {
-    if (this->eventHandler_.get() != nullptr) {
-      this->eventHandler_->handlerError(ctx, "DataPageAccess.zip");
+        // in a bad state, don't commit
+        using ::apache::thrift::protocol::TProtocolException;
+        throw TProtocolException(TProtocolException::INVALID_DATA);
+      }
+      int32_t _return;
+      DataPageAccess_RpcFtruncate_presult result;
+      result.success = &_return;
+      result.read(iprot_);
+      iprot_->readMessageEnd();
+      iprot_->getTransport()->readEnd();
+
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFtruncate failed: unknown result");
     }
-    return;
-  }
+    // seqid != rseqid
+    this->sync_->updatePending(fname, mtype, rseqid);
 
-  if (this->eventHandler_.get() != nullptr) {
-    this->eventHandler_->asyncComplete(ctx, "DataPageAccess.zip");
-  }
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
 
-  return;
+void DataPageAccessConcurrentClient::RpcInitFile(_Page& _return, const _Path& _path)
+{
+  int32_t seqid = send_RpcInitFile(_path);
+  recv_RpcInitFile(_return, seqid);
 }
 
-::std::shared_ptr< ::apache::thrift::TProcessor > DataPageAccessProcessorFactory::getProcessor(const ::apache::thrift::TConnectionInfo& connInfo) {
-  ::apache::thrift::ReleaseHandler< DataPageAccessIfFactory > cleanup(handlerFactory_);
-  ::std::shared_ptr< DataPageAccessIf > handler(handlerFactory_->getHandler(connInfo), cleanup);
-  ::std::shared_ptr< ::apache::thrift::TProcessor > processor(new DataPageAccessProcessor(handler));
-  return processor;
+void DataPageAccessConcurrentClient::RpcOpenAndReadFile(_Page& _return, const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient)
+{
+  int32_t seqid = send_RpcOpenAndReadFile(_path, _flags, _amount, _transient);
+  recv_RpcOpenAndReadFile(_return, seqid);
 }
 
-void DataPageAccessConcurrentClient::ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::send_RpcInitFile(const _Path& _path)
 {
-  int32_t seqid = send_ReadBufferCommon(_reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn);
-  recv_ReadBufferCommon(_return, seqid);
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcInitFile", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcInitFile_pargs args;
+  args._path = &_path;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::send_ReadBufferCommon(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::send_RpcOpenAndReadFile(const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("ReadBufferCommon", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcOpenAndReadFile", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_ReadBufferCommon_pargs args;
-  args._reln = &_reln;
-  args._relpersistence = &_relpersistence;
-  args._forknum = &_forknum;
-  args._blknum = &_blknum;
-  args._readBufferMode = &_readBufferMode;
-  args._lsn = &_lsn;
+  DataPageAccess_RpcOpenAndReadFile_pargs args;
+  args._path = &_path;
+  args._flags = &_flags;
+  args._amount = &_amount;
+  args._transient = &_transient;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -14308,7 +23479,7 @@ int32_t DataPageAccessConcurrentClient::send_ReadBufferCommon(const _Smgr_Relati
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_ReadBufferCommon(_Page& _return, const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_RpcInitFile(_Page& _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -14337,7 +23508,7 @@ void DataPageAccessConcurrentClient::recv_ReadBufferCommon(_Page& _return, const
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("ReadBufferCommon") != 0) {
+      if (fname.compare("RpcInitFile") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -14346,7 +23517,7 @@ void DataPageAccessConcurrentClient::recv_ReadBufferCommon(_Page& _return, const
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_ReadBufferCommon_presult result;
+      DataPageAccess_RpcInitFile_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -14358,7 +23529,7 @@ void DataPageAccessConcurrentClient::recv_ReadBufferCommon(_Page& _return, const
         return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ReadBufferCommon failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcInitFile failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -14368,32 +23539,7 @@ void DataPageAccessConcurrentClient::recv_ReadBufferCommon(_Page& _return, const
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn)
-{
-  int32_t seqid = send_RpcRegisterSecondaryNode(_primary, _lsn);
-  return recv_RpcRegisterSecondaryNode(seqid);
-}
-
-int32_t DataPageAccessConcurrentClient::send_RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn)
-{
-  int32_t cseqid = this->sync_->generateSeqId();
-  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcRegisterSecondaryNode", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_RpcRegisterSecondaryNode_pargs args;
-  args._primary = &_primary;
-  args._lsn = &_lsn;
-  args.write(oprot_);
-
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-
-  sentry.commit();
-  return cseqid;
-}
-
-int32_t DataPageAccessConcurrentClient::recv_RpcRegisterSecondaryNode(const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_RpcOpenAndReadFile(_Page& _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -14422,7 +23568,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcRegisterSecondaryNode(const int3
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcRegisterSecondaryNode") != 0) {
+      if (fname.compare("RpcOpenAndReadFile") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -14431,19 +23577,19 @@ int32_t DataPageAccessConcurrentClient::recv_RpcRegisterSecondaryNode(const int3
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      int32_t _return;
-      DataPageAccess_RpcRegisterSecondaryNode_presult result;
+      DataPageAccess_RpcOpenAndReadFile_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
+        // _return pointer has now been filled
         sentry.commit();
-        return _return;
+        return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcRegisterSecondaryNode failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcOpenAndReadFile failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -14453,21 +23599,21 @@ int32_t DataPageAccessConcurrentClient::recv_RpcRegisterSecondaryNode(const int3
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcSecondaryNodeUpdatesLsn(const int32_t _node_id, const int64_t _lsn)
+_File DataPageAccessConcurrentClient::RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags)
 {
-  int32_t seqid = send_RpcSecondaryNodeUpdatesLsn(_node_id, _lsn);
-  recv_RpcSecondaryNodeUpdatesLsn(seqid);
+  int32_t seqid = send_RpcOpenTransientFile(_filename, _fileflags);
+  return recv_RpcOpenTransientFile(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcSecondaryNodeUpdatesLsn(const int32_t _node_id, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::send_RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcSecondaryNodeUpdatesLsn", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcOpenTransientFile", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcSecondaryNodeUpdatesLsn_pargs args;
-  args._node_id = &_node_id;
-  args._lsn = &_lsn;
+  DataPageAccess_RpcOpenTransientFile_pargs args;
+  args._filename = &_filename;
+  args._fileflags = &_fileflags;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -14478,7 +23624,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcSecondaryNodeUpdatesLsn(const in
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcSecondaryNodeUpdatesLsn(const int32_t seqid)
+_File DataPageAccessConcurrentClient::recv_RpcOpenTransientFile(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -14507,7 +23653,7 @@ void DataPageAccessConcurrentClient::recv_RpcSecondaryNodeUpdatesLsn(const int32
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcSecondaryNodeUpdatesLsn") != 0) {
+      if (fname.compare("RpcOpenTransientFile") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -14516,13 +23662,19 @@ void DataPageAccessConcurrentClient::recv_RpcSecondaryNodeUpdatesLsn(const int32
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcSecondaryNodeUpdatesLsn_presult result;
+      _File _return;
+      DataPageAccess_RpcOpenTransientFile_presult result;
+      result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
-      sentry.commit();
-      return;
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcOpenTransientFile failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -14532,23 +23684,21 @@ void DataPageAccessConcurrentClient::recv_RpcSecondaryNodeUpdatesLsn(const int32
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcMdRead(_Page& _return, const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _blknum, const int64_t _lsn)
+_File DataPageAccessConcurrentClient::RpcOpenTransientFileUnderPgData(const _Path& _filename, const int32_t _fileflags)
 {
-  int32_t seqid = send_RpcMdRead(_reln, _forknum, _blknum, _lsn);
-  recv_RpcMdRead(_return, seqid);
+  int32_t seqid = send_RpcOpenTransientFileUnderPgData(_filename, _fileflags);
+  return recv_RpcOpenTransientFileUnderPgData(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcMdRead(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _blknum, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::send_RpcOpenTransientFileUnderPgData(const _Path& _filename, const int32_t _fileflags)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcMdRead", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcOpenTransientFileUnderPgData", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcMdRead_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._blknum = &_blknum;
-  args._lsn = &_lsn;
+  DataPageAccess_RpcOpenTransientFileUnderPgData_pargs args;
+  args._filename = &_filename;
+  args._fileflags = &_fileflags;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -14559,7 +23709,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcMdRead(const _Smgr_Relation& _re
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcMdRead(_Page& _return, const int32_t seqid)
+_File DataPageAccessConcurrentClient::recv_RpcOpenTransientFileUnderPgData(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -14588,7 +23738,7 @@ void DataPageAccessConcurrentClient::recv_RpcMdRead(_Page& _return, const int32_
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcMdRead") != 0) {
+      if (fname.compare("RpcOpenTransientFileUnderPgData") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -14597,19 +23747,19 @@ void DataPageAccessConcurrentClient::recv_RpcMdRead(_Page& _return, const int32_
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcMdRead_presult result;
+      _File _return;
+      DataPageAccess_RpcOpenTransientFileUnderPgData_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
-        // _return pointer has now been filled
         sentry.commit();
-        return;
+        return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdRead failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcOpenTransientFileUnderPgData failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -14619,22 +23769,20 @@ void DataPageAccessConcurrentClient::recv_RpcMdRead(_Page& _return, const int32_
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcMdNblocks(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::RpcCloseTransientFile(const _File _fd)
 {
-  int32_t seqid = send_RpcMdNblocks(_reln, _forknum, _lsn);
-  return recv_RpcMdNblocks(seqid);
+  int32_t seqid = send_RpcCloseTransientFile(_fd);
+  return recv_RpcCloseTransientFile(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcMdNblocks(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::send_RpcCloseTransientFile(const _File _fd)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcMdNblocks", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcCloseTransientFile", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcMdNblocks_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._lsn = &_lsn;
+  DataPageAccess_RpcCloseTransientFile_pargs args;
+  args._fd = &_fd;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -14645,7 +23793,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcMdNblocks(const _Smgr_Relation&
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcMdNblocks(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcCloseTransientFile(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -14674,7 +23822,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcMdNblocks(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcMdNblocks") != 0) {
+      if (fname.compare("RpcCloseTransientFile") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -14684,7 +23832,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcMdNblocks(const int32_t seqid)
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcMdNblocks_presult result;
+      DataPageAccess_RpcCloseTransientFile_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -14695,7 +23843,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcMdNblocks(const int32_t seqid)
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdNblocks failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcCloseTransientFile failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -14705,22 +23853,21 @@ int32_t DataPageAccessConcurrentClient::recv_RpcMdNblocks(const int32_t seqid)
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcMdExists(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
+void DataPageAccessConcurrentClient::Rpcread(_Page& _return, const _File _fd, const int32_t size)
 {
-  int32_t seqid = send_RpcMdExists(_reln, _forknum, _lsn);
-  return recv_RpcMdExists(seqid);
+  int32_t seqid = send_Rpcread(_fd, size);
+  recv_Rpcread(_return, seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcMdExists(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::send_Rpcread(const _File _fd, const int32_t size)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcMdExists", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("Rpcread", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcMdExists_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._lsn = &_lsn;
+  DataPageAccess_Rpcread_pargs args;
+  args._fd = &_fd;
+  args.size = &size;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -14731,7 +23878,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcMdExists(const _Smgr_Relation& _
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcMdExists(const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_Rpcread(_Page& _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -14760,7 +23907,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcMdExists(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcMdExists") != 0) {
+      if (fname.compare("Rpcread") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -14769,19 +23916,19 @@ int32_t DataPageAccessConcurrentClient::recv_RpcMdExists(const int32_t seqid)
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      int32_t _return;
-      DataPageAccess_RpcMdExists_presult result;
+      DataPageAccess_Rpcread_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
+        // _return pointer has now been filled
         sentry.commit();
-        return _return;
+        return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcMdExists failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "Rpcread failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -14791,23 +23938,22 @@ int32_t DataPageAccessConcurrentClient::recv_RpcMdExists(const int32_t seqid)
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcMdCreate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _isRedo, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::Rpcwrite(const _File _fd, const _Page& _page, const int32_t size)
 {
-  int32_t seqid = send_RpcMdCreate(_reln, _forknum, _isRedo, _lsn);
-  recv_RpcMdCreate(seqid);
+  int32_t seqid = send_Rpcwrite(_fd, _page, size);
+  return recv_Rpcwrite(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcMdCreate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _isRedo, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::send_Rpcwrite(const _File _fd, const _Page& _page, const int32_t size)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcMdCreate", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("Rpcwrite", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcMdCreate_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._isRedo = &_isRedo;
-  args._lsn = &_lsn;
+  DataPageAccess_Rpcwrite_pargs args;
+  args._fd = &_fd;
+  args._page = &_page;
+  args.size = &size;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -14818,7 +23964,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcMdCreate(const _Smgr_Relation& _
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcMdCreate(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_Rpcwrite(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -14847,7 +23993,7 @@ void DataPageAccessConcurrentClient::recv_RpcMdCreate(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcMdCreate") != 0) {
+      if (fname.compare("Rpcwrite") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -14856,13 +24002,19 @@ void DataPageAccessConcurrentClient::recv_RpcMdCreate(const int32_t seqid)
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcMdCreate_presult result;
+      int32_t _return;
+      DataPageAccess_Rpcwrite_presult result;
+      result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
-      sentry.commit();
-      return;
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "Rpcwrite failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -14872,25 +24024,21 @@ void DataPageAccessConcurrentClient::recv_RpcMdCreate(const int32_t seqid)
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::RpcFileSync(const _File _fd, const int32_t _wait_event_info)
 {
-  int32_t seqid = send_RpcMdExtend(_reln, _forknum, _blknum, _buff, skipFsync, _lsn);
-  recv_RpcMdExtend(seqid);
+  int32_t seqid = send_RpcFileSync(_fd, _wait_event_info);
+  return recv_RpcFileSync(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::send_RpcFileSync(const _File _fd, const int32_t _wait_event_info)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcMdExtend", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcFileSync", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcMdExtend_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._blknum = &_blknum;
-  args._buff = &_buff;
-  args.skipFsync = &skipFsync;
-  args._lsn = &_lsn;
+  DataPageAccess_RpcFileSync_pargs args;
+  args._fd = &_fd;
+  args._wait_event_info = &_wait_event_info;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -14901,7 +24049,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcMdExtend(const _Smgr_Relation& _
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcMdExtend(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcFileSync(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -14930,7 +24078,7 @@ void DataPageAccessConcurrentClient::recv_RpcMdExtend(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcMdExtend") != 0) {
+      if (fname.compare("RpcFileSync") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -14939,13 +24087,19 @@ void DataPageAccessConcurrentClient::recv_RpcMdExtend(const int32_t seqid)
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcMdExtend_presult result;
+      int32_t _return;
+      DataPageAccess_RpcFileSync_presult result;
+      result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
-      sentry.commit();
-      return;
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileSync failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -14955,23 +24109,22 @@ void DataPageAccessConcurrentClient::recv_RpcMdExtend(const int32_t seqid)
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn)
+void DataPageAccessConcurrentClient::RpcPgPRead(_Page& _return, const _File _fd, const int32_t _seg_bytes, const _Off_t _start_off)
 {
-  int32_t seqid = send_RpcTruncate(_reln, _forknum, _blknum, _lsn);
-  recv_RpcTruncate(seqid);
+  int32_t seqid = send_RpcPgPRead(_fd, _seg_bytes, _start_off);
+  recv_RpcPgPRead(_return, seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::send_RpcPgPRead(const _File _fd, const int32_t _seg_bytes, const _Off_t _start_off)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcTruncate", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcPgPRead", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcTruncate_pargs args;
-  args._reln = &_reln;
-  args._forknum = &_forknum;
-  args._blknum = &_blknum;
-  args._lsn = &_lsn;
+  DataPageAccess_RpcPgPRead_pargs args;
+  args._fd = &_fd;
+  args._seg_bytes = &_seg_bytes;
+  args._start_off = &_start_off;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -14982,7 +24135,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcTruncate(const _Smgr_Relation& _
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcTruncate(const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_RpcPgPRead(_Page& _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15011,7 +24164,7 @@ void DataPageAccessConcurrentClient::recv_RpcTruncate(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcTruncate") != 0) {
+      if (fname.compare("RpcPgPRead") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15020,13 +24173,19 @@ void DataPageAccessConcurrentClient::recv_RpcTruncate(const int32_t seqid)
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcTruncate_presult result;
+      DataPageAccess_RpcPgPRead_presult result;
+      result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
-      sentry.commit();
-      return;
+      if (result.__isset.success) {
+        // _return pointer has now been filled
+        sentry.commit();
+        return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgPRead failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -15036,20 +24195,23 @@ void DataPageAccessConcurrentClient::recv_RpcTruncate(const int32_t seqid)
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcFileClose(const _File _fd)
+int32_t DataPageAccessConcurrentClient::RpcPgPWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset)
 {
-  int32_t seqid = send_RpcFileClose(_fd);
-  recv_RpcFileClose(seqid);
+  int32_t seqid = send_RpcPgPWrite(_fd, _page, _amount, _offset);
+  return recv_RpcPgPWrite(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcFileClose(const _File _fd)
+int32_t DataPageAccessConcurrentClient::send_RpcPgPWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcFileClose", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcPgPWrite", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcFileClose_pargs args;
+  DataPageAccess_RpcPgPWrite_pargs args;
   args._fd = &_fd;
+  args._page = &_page;
+  args._amount = &_amount;
+  args._offset = &_offset;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -15060,7 +24222,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcFileClose(const _File _fd)
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcFileClose(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcPgPWrite(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15089,7 +24251,7 @@ void DataPageAccessConcurrentClient::recv_RpcFileClose(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcFileClose") != 0) {
+      if (fname.compare("RpcPgPWrite") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15098,13 +24260,19 @@ void DataPageAccessConcurrentClient::recv_RpcFileClose(const int32_t seqid)
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcFileClose_presult result;
+      int32_t _return;
+      DataPageAccess_RpcPgPWrite_presult result;
+      result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
-      sentry.commit();
-      return;
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgPWrite failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -15114,22 +24282,20 @@ void DataPageAccessConcurrentClient::recv_RpcFileClose(const int32_t seqid)
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcTablespaceCreateDbspace(const _Oid _spcnode, const _Oid _dbnode, const bool isRedo)
+int32_t DataPageAccessConcurrentClient::RpcClose(const _File _fd)
 {
-  int32_t seqid = send_RpcTablespaceCreateDbspace(_spcnode, _dbnode, isRedo);
-  recv_RpcTablespaceCreateDbspace(seqid);
+  int32_t seqid = send_RpcClose(_fd);
+  return recv_RpcClose(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcTablespaceCreateDbspace(const _Oid _spcnode, const _Oid _dbnode, const bool isRedo)
+int32_t DataPageAccessConcurrentClient::send_RpcClose(const _File _fd)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcTablespaceCreateDbspace", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcClose", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcTablespaceCreateDbspace_pargs args;
-  args._spcnode = &_spcnode;
-  args._dbnode = &_dbnode;
-  args.isRedo = &isRedo;
+  DataPageAccess_RpcClose_pargs args;
+  args._fd = &_fd;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -15140,7 +24306,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcTablespaceCreateDbspace(const _O
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcTablespaceCreateDbspace(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcClose(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15169,7 +24335,7 @@ void DataPageAccessConcurrentClient::recv_RpcTablespaceCreateDbspace(const int32
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcTablespaceCreateDbspace") != 0) {
+      if (fname.compare("RpcClose") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15178,13 +24344,19 @@ void DataPageAccessConcurrentClient::recv_RpcTablespaceCreateDbspace(const int32
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcTablespaceCreateDbspace_presult result;
+      int32_t _return;
+      DataPageAccess_RpcClose_presult result;
+      result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
-      sentry.commit();
-      return;
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcClose failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -15194,21 +24366,21 @@ void DataPageAccessConcurrentClient::recv_RpcTablespaceCreateDbspace(const int32
   } // end while(true)
 }
 
-_File DataPageAccessConcurrentClient::RpcPathNameOpenFile(const _Path& _path, const _Flag _flag)
+int32_t DataPageAccessConcurrentClient::RpcBasicOpenFile(const _Path& _path, const int32_t _flags)
 {
-  int32_t seqid = send_RpcPathNameOpenFile(_path, _flag);
-  return recv_RpcPathNameOpenFile(seqid);
+  int32_t seqid = send_RpcBasicOpenFile(_path, _flags);
+  return recv_RpcBasicOpenFile(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcPathNameOpenFile(const _Path& _path, const _Flag _flag)
+int32_t DataPageAccessConcurrentClient::send_RpcBasicOpenFile(const _Path& _path, const int32_t _flags)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcPathNameOpenFile", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcBasicOpenFile", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcPathNameOpenFile_pargs args;
+  DataPageAccess_RpcBasicOpenFile_pargs args;
   args._path = &_path;
-  args._flag = &_flag;
+  args._flags = &_flags;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -15219,7 +24391,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcPathNameOpenFile(const _Path& _p
   return cseqid;
 }
 
-_File DataPageAccessConcurrentClient::recv_RpcPathNameOpenFile(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcBasicOpenFile(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15248,7 +24420,7 @@ _File DataPageAccessConcurrentClient::recv_RpcPathNameOpenFile(const int32_t seq
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcPathNameOpenFile") != 0) {
+      if (fname.compare("RpcBasicOpenFile") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15257,8 +24429,8 @@ _File DataPageAccessConcurrentClient::recv_RpcPathNameOpenFile(const int32_t seq
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      _File _return;
-      DataPageAccess_RpcPathNameOpenFile_presult result;
+      int32_t _return;
+      DataPageAccess_RpcBasicOpenFile_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -15269,7 +24441,7 @@ _File DataPageAccessConcurrentClient::recv_RpcPathNameOpenFile(const int32_t seq
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPathNameOpenFile failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcBasicOpenFile failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -15279,24 +24451,21 @@ _File DataPageAccessConcurrentClient::recv_RpcPathNameOpenFile(const int32_t seq
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcFileWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
+int32_t DataPageAccessConcurrentClient::RpcBasicOpenFileUnderPgData(const _Path& _path, const int32_t _flags)
 {
-  int32_t seqid = send_RpcFileWrite(_fd, _page, _amount, _seekpos, _wait_event_info);
-  return recv_RpcFileWrite(seqid);
+  int32_t seqid = send_RpcBasicOpenFileUnderPgData(_path, _flags);
+  return recv_RpcBasicOpenFileUnderPgData(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcFileWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
+int32_t DataPageAccessConcurrentClient::send_RpcBasicOpenFileUnderPgData(const _Path& _path, const int32_t _flags)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcFileWrite", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcBasicOpenFileUnderPgData", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcFileWrite_pargs args;
-  args._fd = &_fd;
-  args._page = &_page;
-  args._amount = &_amount;
-  args._seekpos = &_seekpos;
-  args._wait_event_info = &_wait_event_info;
+  DataPageAccess_RpcBasicOpenFileUnderPgData_pargs args;
+  args._path = &_path;
+  args._flags = &_flags;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -15307,7 +24476,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcFileWrite(const _File _fd, const
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcFileWrite(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcBasicOpenFileUnderPgData(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15336,7 +24505,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileWrite(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcFileWrite") != 0) {
+      if (fname.compare("RpcBasicOpenFileUnderPgData") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15346,7 +24515,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileWrite(const int32_t seqid)
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcFileWrite_presult result;
+      DataPageAccess_RpcBasicOpenFileUnderPgData_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -15357,7 +24526,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileWrite(const int32_t seqid)
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileWrite failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcBasicOpenFileUnderPgData failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -15367,19 +24536,19 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileWrite(const int32_t seqid)
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcFilePathName(_Path& _return, const _File _fd)
+int32_t DataPageAccessConcurrentClient::RpcPgFdatasync(const _File _fd)
 {
-  int32_t seqid = send_RpcFilePathName(_fd);
-  recv_RpcFilePathName(_return, seqid);
+  int32_t seqid = send_RpcPgFdatasync(_fd);
+  return recv_RpcPgFdatasync(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcFilePathName(const _File _fd)
+int32_t DataPageAccessConcurrentClient::send_RpcPgFdatasync(const _File _fd)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcFilePathName", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcPgFdatasync", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcFilePathName_pargs args;
+  DataPageAccess_RpcPgFdatasync_pargs args;
   args._fd = &_fd;
   args.write(oprot_);
 
@@ -15391,7 +24560,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcFilePathName(const _File _fd)
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcFilePathName(_Path& _return, const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcPgFdatasync(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15420,7 +24589,7 @@ void DataPageAccessConcurrentClient::recv_RpcFilePathName(_Path& _return, const
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcFilePathName") != 0) {
+      if (fname.compare("RpcPgFdatasync") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15429,19 +24598,19 @@ void DataPageAccessConcurrentClient::recv_RpcFilePathName(_Path& _return, const
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcFilePathName_presult result;
+      int32_t _return;
+      DataPageAccess_RpcPgFdatasync_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
-        // _return pointer has now been filled
         sentry.commit();
-        return;
+        return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFilePathName failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFdatasync failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -15451,23 +24620,20 @@ void DataPageAccessConcurrentClient::recv_RpcFilePathName(_Path& _return, const
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcFileRead(_Page& _return, const _File _fd, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
+int32_t DataPageAccessConcurrentClient::RpcPgFsyncNoWritethrough(const _File _fd)
 {
-  int32_t seqid = send_RpcFileRead(_fd, _amount, _seekpos, _wait_event_info);
-  recv_RpcFileRead(_return, seqid);
+  int32_t seqid = send_RpcPgFsyncNoWritethrough(_fd);
+  return recv_RpcPgFsyncNoWritethrough(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcFileRead(const _File _fd, const int32_t _amount, const _Off_t _seekpos, const int32_t _wait_event_info)
+int32_t DataPageAccessConcurrentClient::send_RpcPgFsyncNoWritethrough(const _File _fd)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcFileRead", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcPgFsyncNoWritethrough", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcFileRead_pargs args;
+  DataPageAccess_RpcPgFsyncNoWritethrough_pargs args;
   args._fd = &_fd;
-  args._amount = &_amount;
-  args._seekpos = &_seekpos;
-  args._wait_event_info = &_wait_event_info;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -15478,7 +24644,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcFileRead(const _File _fd, const
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcFileRead(_Page& _return, const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcPgFsyncNoWritethrough(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15507,7 +24673,7 @@ void DataPageAccessConcurrentClient::recv_RpcFileRead(_Page& _return, const int3
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcFileRead") != 0) {
+      if (fname.compare("RpcPgFsyncNoWritethrough") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15516,19 +24682,19 @@ void DataPageAccessConcurrentClient::recv_RpcFileRead(_Page& _return, const int3
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcFileRead_presult result;
+      int32_t _return;
+      DataPageAccess_RpcPgFsyncNoWritethrough_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
-        // _return pointer has now been filled
         sentry.commit();
-        return;
+        return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileRead failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFsyncNoWritethrough failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -15538,21 +24704,22 @@ void DataPageAccessConcurrentClient::recv_RpcFileRead(_Page& _return, const int3
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcFileTruncate(const _File _fd, const _Off_t _offset)
+int32_t DataPageAccessConcurrentClient::RpcLseek(const int32_t _fd, const _Off_t _offset, const int32_t _flag)
 {
-  int32_t seqid = send_RpcFileTruncate(_fd, _offset);
-  return recv_RpcFileTruncate(seqid);
+  int32_t seqid = send_RpcLseek(_fd, _offset, _flag);
+  return recv_RpcLseek(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcFileTruncate(const _File _fd, const _Off_t _offset)
+int32_t DataPageAccessConcurrentClient::send_RpcLseek(const int32_t _fd, const _Off_t _offset, const int32_t _flag)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcFileTruncate", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcLseek", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcFileTruncate_pargs args;
+  DataPageAccess_RpcLseek_pargs args;
   args._fd = &_fd;
   args._offset = &_offset;
+  args._flag = &_flag;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -15563,7 +24730,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcFileTruncate(const _File _fd, co
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcFileTruncate(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcLseek(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15592,7 +24759,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileTruncate(const int32_t seqid
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcFileTruncate") != 0) {
+      if (fname.compare("RpcLseek") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15602,7 +24769,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileTruncate(const int32_t seqid
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcFileTruncate_presult result;
+      DataPageAccess_RpcLseek_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -15613,7 +24780,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileTruncate(const int32_t seqid
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileTruncate failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcLseek failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -15623,20 +24790,20 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileTruncate(const int32_t seqid
   } // end while(true)
 }
 
-_Off_t DataPageAccessConcurrentClient::RpcFileSize(const _File _fd)
+void DataPageAccessConcurrentClient::RpcStat(_Stat_Resp& _return, const _Path& _path)
 {
-  int32_t seqid = send_RpcFileSize(_fd);
-  return recv_RpcFileSize(seqid);
+  int32_t seqid = send_RpcStat(_path);
+  recv_RpcStat(_return, seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcFileSize(const _File _fd)
+int32_t DataPageAccessConcurrentClient::send_RpcStat(const _Path& _path)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcFileSize", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcStat", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcFileSize_pargs args;
-  args._fd = &_fd;
+  DataPageAccess_RpcStat_pargs args;
+  args._path = &_path;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -15647,7 +24814,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcFileSize(const _File _fd)
   return cseqid;
 }
 
-_Off_t DataPageAccessConcurrentClient::recv_RpcFileSize(const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_RpcStat(_Stat_Resp& _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15676,7 +24843,7 @@ _Off_t DataPageAccessConcurrentClient::recv_RpcFileSize(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcFileSize") != 0) {
+      if (fname.compare("RpcStat") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15685,45 +24852,114 @@ _Off_t DataPageAccessConcurrentClient::recv_RpcFileSize(const int32_t seqid)
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      _Off_t _return;
-      DataPageAccess_RpcFileSize_presult result;
+      DataPageAccess_RpcStat_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
+        // _return pointer has now been filled
         sentry.commit();
-        return _return;
+        return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileSize failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcStat failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
 
-    // this will temporarily unlock the readMutex, and let other clients get work done
-    this->sync_->waitForWork(seqid);
-  } // end while(true)
+    // this will temporarily unlock the readMutex, and let other clients get work done
+    this->sync_->waitForWork(seqid);
+  } // end while(true)
+}
+
+int32_t DataPageAccessConcurrentClient::RpcDirectoryIsEmpty(const _Path& _path)
+{
+  int32_t seqid = send_RpcDirectoryIsEmpty(_path);
+  return recv_RpcDirectoryIsEmpty(seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::RpcSyncFiles(const std::vector<_Path> & _paths)
+{
+  int32_t seqid = send_RpcSyncFiles(_paths);
+  return recv_RpcSyncFiles(seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::RpcAttachSharedMemory(const _Path& _name)
+{
+  int32_t seqid = send_RpcAttachSharedMemory(_name);
+  return recv_RpcAttachSharedMemory(seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::RpcPublishResidentPages(const _Page& _summary)
+{
+  int32_t seqid = send_RpcPublishResidentPages(_summary);
+  return recv_RpcPublishResidentPages(seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::send_RpcDirectoryIsEmpty(const _Path& _path)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcDirectoryIsEmpty", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcDirectoryIsEmpty_pargs args;
+  args._path = &_path;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
+}
+
+int32_t DataPageAccessConcurrentClient::send_RpcSyncFiles(const std::vector<_Path> & _paths)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcSyncFiles", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcSyncFiles_pargs args;
+  args._paths = &_paths;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::RpcFilePrefetch(const _File _fd, const _Off_t _offset, const int32_t _amount, const int32_t wait_event_info)
+int32_t DataPageAccessConcurrentClient::send_RpcAttachSharedMemory(const _Path& _name)
 {
-  int32_t seqid = send_RpcFilePrefetch(_fd, _offset, _amount, wait_event_info);
-  return recv_RpcFilePrefetch(seqid);
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcAttachSharedMemory", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcAttachSharedMemory_pargs args;
+  args._name = &_name;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcFilePrefetch(const _File _fd, const _Off_t _offset, const int32_t _amount, const int32_t wait_event_info)
+int32_t DataPageAccessConcurrentClient::send_RpcPublishResidentPages(const _Page& _summary)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcFilePrefetch", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcPublishResidentPages", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcFilePrefetch_pargs args;
-  args._fd = &_fd;
-  args._offset = &_offset;
-  args._amount = &_amount;
-  args.wait_event_info = &wait_event_info;
+  DataPageAccess_RpcPublishResidentPages_pargs args;
+  args._summary = &_summary;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -15734,7 +24970,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcFilePrefetch(const _File _fd, co
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcFilePrefetch(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcDirectoryIsEmpty(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15763,7 +24999,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFilePrefetch(const int32_t seqid
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcFilePrefetch") != 0) {
+      if (fname.compare("RpcDirectoryIsEmpty") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15773,7 +25009,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFilePrefetch(const int32_t seqid
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcFilePrefetch_presult result;
+      DataPageAccess_RpcDirectoryIsEmpty_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -15784,7 +25020,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFilePrefetch(const int32_t seqid
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFilePrefetch failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDirectoryIsEmpty failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -15794,34 +25030,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFilePrefetch(const int32_t seqid
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcFileWriteback(const _File _fd, const _Off_t _offset, const _Off_t nbytes, const int32_t wait_event_info)
-{
-  int32_t seqid = send_RpcFileWriteback(_fd, _offset, nbytes, wait_event_info);
-  recv_RpcFileWriteback(seqid);
-}
-
-int32_t DataPageAccessConcurrentClient::send_RpcFileWriteback(const _File _fd, const _Off_t _offset, const _Off_t nbytes, const int32_t wait_event_info)
-{
-  int32_t cseqid = this->sync_->generateSeqId();
-  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcFileWriteback", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_RpcFileWriteback_pargs args;
-  args._fd = &_fd;
-  args._offset = &_offset;
-  args.nbytes = &nbytes;
-  args.wait_event_info = &wait_event_info;
-  args.write(oprot_);
-
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-
-  sentry.commit();
-  return cseqid;
-}
-
-void DataPageAccessConcurrentClient::recv_RpcFileWriteback(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcSyncFiles(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15850,7 +25059,7 @@ void DataPageAccessConcurrentClient::recv_RpcFileWriteback(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcFileWriteback") != 0) {
+      if (fname.compare("RpcSyncFiles") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15859,13 +25068,19 @@ void DataPageAccessConcurrentClient::recv_RpcFileWriteback(const int32_t seqid)
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcFileWriteback_presult result;
+      int32_t _return;
+      DataPageAccess_RpcSyncFiles_presult result;
+      result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
-      sentry.commit();
-      return;
+      if (result.__isset.success) {
+        sentry.commit();
+        return _return;
+      }
+      // in a bad state, don't commit
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcSyncFiles failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -15875,31 +25090,7 @@ void DataPageAccessConcurrentClient::recv_RpcFileWriteback(const int32_t seqid)
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcUnlink(const _Path& _path)
-{
-  int32_t seqid = send_RpcUnlink(_path);
-  return recv_RpcUnlink(seqid);
-}
-
-int32_t DataPageAccessConcurrentClient::send_RpcUnlink(const _Path& _path)
-{
-  int32_t cseqid = this->sync_->generateSeqId();
-  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcUnlink", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_RpcUnlink_pargs args;
-  args._path = &_path;
-  args.write(oprot_);
-
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-
-  sentry.commit();
-  return cseqid;
-}
-
-int32_t DataPageAccessConcurrentClient::recv_RpcUnlink(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcAttachSharedMemory(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -15928,7 +25119,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcUnlink(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcUnlink") != 0) {
+      if (fname.compare("RpcAttachSharedMemory") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -15938,7 +25129,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcUnlink(const int32_t seqid)
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcUnlink_presult result;
+      DataPageAccess_RpcAttachSharedMemory_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -15949,7 +25140,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcUnlink(const int32_t seqid)
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcUnlink failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcAttachSharedMemory failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -15959,32 +25150,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcUnlink(const int32_t seqid)
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcFtruncate(const _File _fd, const _Off_t _offset)
-{
-  int32_t seqid = send_RpcFtruncate(_fd, _offset);
-  return recv_RpcFtruncate(seqid);
-}
-
-int32_t DataPageAccessConcurrentClient::send_RpcFtruncate(const _File _fd, const _Off_t _offset)
-{
-  int32_t cseqid = this->sync_->generateSeqId();
-  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcFtruncate", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_RpcFtruncate_pargs args;
-  args._fd = &_fd;
-  args._offset = &_offset;
-  args.write(oprot_);
-
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-
-  sentry.commit();
-  return cseqid;
-}
-
-int32_t DataPageAccessConcurrentClient::recv_RpcFtruncate(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcPublishResidentPages(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -16013,7 +25179,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFtruncate(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcFtruncate") != 0) {
+      if (fname.compare("RpcPublishResidentPages") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -16023,7 +25189,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFtruncate(const int32_t seqid)
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcFtruncate_presult result;
+      DataPageAccess_RpcPublishResidentPages_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -16034,7 +25200,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFtruncate(const int32_t seqid)
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFtruncate failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPublishResidentPages failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -16044,20 +25210,21 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFtruncate(const int32_t seqid)
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcInitFile(_Page& _return, const _Path& _path)
+int32_t DataPageAccessConcurrentClient::RpcCopyDir(const _Path& _src, const _Path& _dst)
 {
-  int32_t seqid = send_RpcInitFile(_path);
-  recv_RpcInitFile(_return, seqid);
+  int32_t seqid = send_RpcCopyDir(_src, _dst);
+  return recv_RpcCopyDir(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcInitFile(const _Path& _path)
+int32_t DataPageAccessConcurrentClient::send_RpcCopyDir(const _Path& _src, const _Path& _dst)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcInitFile", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcCopyDir", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcInitFile_pargs args;
-  args._path = &_path;
+  DataPageAccess_RpcCopyDir_pargs args;
+  args._src = &_src;
+  args._dst = &_dst;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -16068,7 +25235,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcInitFile(const _Path& _path)
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcInitFile(_Page& _return, const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcCopyDir(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -16097,7 +25264,7 @@ void DataPageAccessConcurrentClient::recv_RpcInitFile(_Page& _return, const int3
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcInitFile") != 0) {
+      if (fname.compare("RpcCopyDir") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -16106,19 +25273,19 @@ void DataPageAccessConcurrentClient::recv_RpcInitFile(_Page& _return, const int3
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcInitFile_presult result;
+      int32_t _return;
+      DataPageAccess_RpcCopyDir_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
-        // _return pointer has now been filled
         sentry.commit();
-        return;
+        return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcInitFile failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcCopyDir failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -16128,21 +25295,38 @@ void DataPageAccessConcurrentClient::recv_RpcInitFile(_Page& _return, const int3
   } // end while(true)
 }
 
-_File DataPageAccessConcurrentClient::RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags)
+int32_t DataPageAccessConcurrentClient::RpcPgFsync(const int32_t _fd)
 {
-  int32_t seqid = send_RpcOpenTransientFile(_filename, _fileflags);
-  return recv_RpcOpenTransientFile(seqid);
+  int32_t seqid = send_RpcPgFsync(_fd);
+  return recv_RpcPgFsync(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags)
+int32_t DataPageAccessConcurrentClient::RpcSetPageCompression(const int32_t _method)
+{
+  int32_t seqid = send_RpcSetPageCompression(_method);
+  return recv_RpcSetPageCompression(seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::RpcSetRequestClass(const int32_t _requestClass)
+{
+  int32_t seqid = send_RpcSetRequestClass(_requestClass);
+  return recv_RpcSetRequestClass(seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::RpcSetRequestDeadline(const int32_t _queue_ms)
+{
+  int32_t seqid = send_RpcSetRequestDeadline(_queue_ms);
+  return recv_RpcSetRequestDeadline(seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::send_RpcPgFsync(const int32_t _fd)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcOpenTransientFile", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcPgFsync", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcOpenTransientFile_pargs args;
-  args._filename = &_filename;
-  args._fileflags = &_fileflags;
+  DataPageAccess_RpcPgFsync_pargs args;
+  args._fd = &_fd;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -16153,81 +25337,50 @@ int32_t DataPageAccessConcurrentClient::send_RpcOpenTransientFile(const _Path& _
   return cseqid;
 }
 
-_File DataPageAccessConcurrentClient::recv_RpcOpenTransientFile(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::send_RpcSetPageCompression(const int32_t _method)
 {
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcSetPageCompression", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  int32_t rseqid = 0;
-  std::string fname;
-  ::apache::thrift::protocol::TMessageType mtype;
-
-  // the read mutex gets dropped and reacquired as part of waitForWork()
-  // The destructor of this sentry wakes up other clients
-  ::apache::thrift::async::TConcurrentRecvSentry sentry(this->sync_.get(), seqid);
+  DataPageAccess_RpcSetPageCompression_pargs args;
+  args._method = &_method;
+  args.write(oprot_);
 
-  while(true) {
-    if(!this->sync_->getPending(fname, mtype, rseqid)) {
-      iprot_->readMessageBegin(fname, mtype, rseqid);
-    }
-    if(seqid == rseqid) {
-      if (mtype == ::apache::thrift::protocol::T_EXCEPTION) {
-        ::apache::thrift::TApplicationException x;
-        x.read(iprot_);
-        iprot_->readMessageEnd();
-        iprot_->getTransport()->readEnd();
-        sentry.commit();
-        throw x;
-      }
-      if (mtype != ::apache::thrift::protocol::T_REPLY) {
-        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-        iprot_->readMessageEnd();
-        iprot_->getTransport()->readEnd();
-      }
-      if (fname.compare("RpcOpenTransientFile") != 0) {
-        iprot_->skip(::apache::thrift::protocol::T_STRUCT);
-        iprot_->readMessageEnd();
-        iprot_->getTransport()->readEnd();
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
 
-        // in a bad state, don't commit
-        using ::apache::thrift::protocol::TProtocolException;
-        throw TProtocolException(TProtocolException::INVALID_DATA);
-      }
-      _File _return;
-      DataPageAccess_RpcOpenTransientFile_presult result;
-      result.success = &_return;
-      result.read(iprot_);
-      iprot_->readMessageEnd();
-      iprot_->getTransport()->readEnd();
+  sentry.commit();
+  return cseqid;
+}
 
-      if (result.__isset.success) {
-        sentry.commit();
-        return _return;
-      }
-      // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcOpenTransientFile failed: unknown result");
-    }
-    // seqid != rseqid
-    this->sync_->updatePending(fname, mtype, rseqid);
+int32_t DataPageAccessConcurrentClient::send_RpcSetRequestClass(const int32_t _requestClass)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcSetRequestClass", ::apache::thrift::protocol::T_CALL, cseqid);
 
-    // this will temporarily unlock the readMutex, and let other clients get work done
-    this->sync_->waitForWork(seqid);
-  } // end while(true)
-}
+  DataPageAccess_RpcSetRequestClass_pargs args;
+  args._requestClass = &_requestClass;
+  args.write(oprot_);
 
-_File DataPageAccessConcurrentClient::RpcOpenTransientFileUnderPgData(const _Path& _filename, const int32_t _fileflags)
-{
-  int32_t seqid = send_RpcOpenTransientFileUnderPgData(_filename, _fileflags);
-  return recv_RpcOpenTransientFileUnderPgData(seqid);
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcOpenTransientFileUnderPgData(const _Path& _filename, const int32_t _fileflags)
+int32_t DataPageAccessConcurrentClient::send_RpcSetRequestDeadline(const int32_t _queue_ms)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcOpenTransientFileUnderPgData", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcSetRequestDeadline", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcOpenTransientFileUnderPgData_pargs args;
-  args._filename = &_filename;
-  args._fileflags = &_fileflags;
+  DataPageAccess_RpcSetRequestDeadline_pargs args;
+  args._queue_ms = &_queue_ms;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -16238,7 +25391,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcOpenTransientFileUnderPgData(con
   return cseqid;
 }
 
-_File DataPageAccessConcurrentClient::recv_RpcOpenTransientFileUnderPgData(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcPgFsync(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -16267,7 +25420,7 @@ _File DataPageAccessConcurrentClient::recv_RpcOpenTransientFileUnderPgData(const
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcOpenTransientFileUnderPgData") != 0) {
+      if (fname.compare("RpcPgFsync") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -16276,8 +25429,8 @@ _File DataPageAccessConcurrentClient::recv_RpcOpenTransientFileUnderPgData(const
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      _File _return;
-      DataPageAccess_RpcOpenTransientFileUnderPgData_presult result;
+      int32_t _return;
+      DataPageAccess_RpcPgFsync_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -16288,7 +25441,7 @@ _File DataPageAccessConcurrentClient::recv_RpcOpenTransientFileUnderPgData(const
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcOpenTransientFileUnderPgData failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFsync failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -16298,31 +25451,7 @@ _File DataPageAccessConcurrentClient::recv_RpcOpenTransientFileUnderPgData(const
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcCloseTransientFile(const _File _fd)
-{
-  int32_t seqid = send_RpcCloseTransientFile(_fd);
-  return recv_RpcCloseTransientFile(seqid);
-}
-
-int32_t DataPageAccessConcurrentClient::send_RpcCloseTransientFile(const _File _fd)
-{
-  int32_t cseqid = this->sync_->generateSeqId();
-  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcCloseTransientFile", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_RpcCloseTransientFile_pargs args;
-  args._fd = &_fd;
-  args.write(oprot_);
-
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-
-  sentry.commit();
-  return cseqid;
-}
-
-int32_t DataPageAccessConcurrentClient::recv_RpcCloseTransientFile(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcSetPageCompression(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -16351,7 +25480,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcCloseTransientFile(const int32_t
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcCloseTransientFile") != 0) {
+      if (fname.compare("RpcSetPageCompression") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -16361,7 +25490,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcCloseTransientFile(const int32_t
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcCloseTransientFile_presult result;
+      DataPageAccess_RpcSetPageCompression_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -16372,7 +25501,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcCloseTransientFile(const int32_t
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcCloseTransientFile failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcSetPageCompression failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -16382,32 +25511,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcCloseTransientFile(const int32_t
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::Rpcread(_Page& _return, const _File _fd, const int32_t size)
-{
-  int32_t seqid = send_Rpcread(_fd, size);
-  recv_Rpcread(_return, seqid);
-}
-
-int32_t DataPageAccessConcurrentClient::send_Rpcread(const _File _fd, const int32_t size)
-{
-  int32_t cseqid = this->sync_->generateSeqId();
-  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("Rpcread", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_Rpcread_pargs args;
-  args._fd = &_fd;
-  args.size = &size;
-  args.write(oprot_);
-
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-
-  sentry.commit();
-  return cseqid;
-}
-
-void DataPageAccessConcurrentClient::recv_Rpcread(_Page& _return, const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcSetRequestClass(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -16436,7 +25540,7 @@ void DataPageAccessConcurrentClient::recv_Rpcread(_Page& _return, const int32_t
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("Rpcread") != 0) {
+      if (fname.compare("RpcSetRequestClass") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -16445,19 +25549,19 @@ void DataPageAccessConcurrentClient::recv_Rpcread(_Page& _return, const int32_t
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_Rpcread_presult result;
+      int32_t _return;
+      DataPageAccess_RpcSetRequestClass_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
-        // _return pointer has now been filled
         sentry.commit();
-        return;
+        return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "Rpcread failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcSetRequestClass failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -16467,33 +25571,7 @@ void DataPageAccessConcurrentClient::recv_Rpcread(_Page& _return, const int32_t
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::Rpcwrite(const _File _fd, const _Page& _page, const int32_t size)
-{
-  int32_t seqid = send_Rpcwrite(_fd, _page, size);
-  return recv_Rpcwrite(seqid);
-}
-
-int32_t DataPageAccessConcurrentClient::send_Rpcwrite(const _File _fd, const _Page& _page, const int32_t size)
-{
-  int32_t cseqid = this->sync_->generateSeqId();
-  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("Rpcwrite", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_Rpcwrite_pargs args;
-  args._fd = &_fd;
-  args._page = &_page;
-  args.size = &size;
-  args.write(oprot_);
-
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-
-  sentry.commit();
-  return cseqid;
-}
-
-int32_t DataPageAccessConcurrentClient::recv_Rpcwrite(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcSetRequestDeadline(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -16522,7 +25600,7 @@ int32_t DataPageAccessConcurrentClient::recv_Rpcwrite(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("Rpcwrite") != 0) {
+      if (fname.compare("RpcSetRequestDeadline") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -16532,7 +25610,7 @@ int32_t DataPageAccessConcurrentClient::recv_Rpcwrite(const int32_t seqid)
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_Rpcwrite_presult result;
+      DataPageAccess_RpcSetRequestDeadline_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -16543,7 +25621,7 @@ int32_t DataPageAccessConcurrentClient::recv_Rpcwrite(const int32_t seqid)
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "Rpcwrite failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcSetRequestDeadline failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -16553,21 +25631,21 @@ int32_t DataPageAccessConcurrentClient::recv_Rpcwrite(const int32_t seqid)
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcFileSync(const _File _fd, const int32_t _wait_event_info)
+int32_t DataPageAccessConcurrentClient::RpcDurableUnlink(const _Path& _fname, const int32_t _flag)
 {
-  int32_t seqid = send_RpcFileSync(_fd, _wait_event_info);
-  return recv_RpcFileSync(seqid);
+  int32_t seqid = send_RpcDurableUnlink(_fname, _flag);
+  return recv_RpcDurableUnlink(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcFileSync(const _File _fd, const int32_t _wait_event_info)
+int32_t DataPageAccessConcurrentClient::send_RpcDurableUnlink(const _Path& _fname, const int32_t _flag)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcFileSync", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcDurableUnlink", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcFileSync_pargs args;
-  args._fd = &_fd;
-  args._wait_event_info = &_wait_event_info;
+  DataPageAccess_RpcDurableUnlink_pargs args;
+  args._fname = &_fname;
+  args._flag = &_flag;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -16578,7 +25656,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcFileSync(const _File _fd, const
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcFileSync(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcDurableUnlink(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -16607,7 +25685,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileSync(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcFileSync") != 0) {
+      if (fname.compare("RpcDurableUnlink") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -16617,7 +25695,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileSync(const int32_t seqid)
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcFileSync_presult result;
+      DataPageAccess_RpcDurableUnlink_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -16628,7 +25706,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileSync(const int32_t seqid)
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFileSync failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDurableUnlink failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -16638,22 +25716,22 @@ int32_t DataPageAccessConcurrentClient::recv_RpcFileSync(const int32_t seqid)
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcPgPRead(_Page& _return, const _File _fd, const int32_t _seg_bytes, const _Off_t _start_off)
+int32_t DataPageAccessConcurrentClient::RpcDurableRenameExcl(const _Path& _oldFname, const _Path& _newFname, const int32_t _elevel)
 {
-  int32_t seqid = send_RpcPgPRead(_fd, _seg_bytes, _start_off);
-  recv_RpcPgPRead(_return, seqid);
+  int32_t seqid = send_RpcDurableRenameExcl(_oldFname, _newFname, _elevel);
+  return recv_RpcDurableRenameExcl(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcPgPRead(const _File _fd, const int32_t _seg_bytes, const _Off_t _start_off)
+int32_t DataPageAccessConcurrentClient::send_RpcDurableRenameExcl(const _Path& _oldFname, const _Path& _newFname, const int32_t _elevel)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcPgPRead", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcDurableRenameExcl", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcPgPRead_pargs args;
-  args._fd = &_fd;
-  args._seg_bytes = &_seg_bytes;
-  args._start_off = &_start_off;
+  DataPageAccess_RpcDurableRenameExcl_pargs args;
+  args._oldFname = &_oldFname;
+  args._newFname = &_newFname;
+  args._elevel = &_elevel;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -16664,7 +25742,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcPgPRead(const _File _fd, const i
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcPgPRead(_Page& _return, const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcDurableRenameExcl(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -16693,7 +25771,7 @@ void DataPageAccessConcurrentClient::recv_RpcPgPRead(_Page& _return, const int32
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcPgPRead") != 0) {
+      if (fname.compare("RpcDurableRenameExcl") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -16702,19 +25780,19 @@ void DataPageAccessConcurrentClient::recv_RpcPgPRead(_Page& _return, const int32
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcPgPRead_presult result;
+      int32_t _return;
+      DataPageAccess_RpcDurableRenameExcl_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
-        // _return pointer has now been filled
         sentry.commit();
-        return;
+        return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgPRead failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDurableRenameExcl failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -16724,23 +25802,27 @@ void DataPageAccessConcurrentClient::recv_RpcPgPRead(_Page& _return, const int32
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcPgPWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset)
+int32_t DataPageAccessConcurrentClient::RpcXLogWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset, const std::vector<int64_t> & _xlblocks, const int32_t _blknum, const int32_t _idx, const int64_t _lsn)
 {
-  int32_t seqid = send_RpcPgPWrite(_fd, _page, _amount, _offset);
-  return recv_RpcPgPWrite(seqid);
+  int32_t seqid = send_RpcXLogWrite(_fd, _page, _amount, _offset, _xlblocks, _blknum, _idx, _lsn);
+  return recv_RpcXLogWrite(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcPgPWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset)
+int32_t DataPageAccessConcurrentClient::send_RpcXLogWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset, const std::vector<int64_t> & _xlblocks, const int32_t _blknum, const int32_t _idx, const int64_t _lsn)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcPgPWrite", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcXLogWrite", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcPgPWrite_pargs args;
+  DataPageAccess_RpcXLogWrite_pargs args;
   args._fd = &_fd;
   args._page = &_page;
   args._amount = &_amount;
   args._offset = &_offset;
+  args._xlblocks = &_xlblocks;
+  args._blknum = &_blknum;
+  args._idx = &_idx;
+  args._lsn = &_lsn;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -16751,7 +25833,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcPgPWrite(const _File _fd, const
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcPgPWrite(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_RpcXLogWrite(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -16780,7 +25862,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgPWrite(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcPgPWrite") != 0) {
+      if (fname.compare("RpcXLogWrite") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -16790,7 +25872,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgPWrite(const int32_t seqid)
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcPgPWrite_presult result;
+      DataPageAccess_RpcXLogWrite_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -16801,7 +25883,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgPWrite(const int32_t seqid)
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgPWrite failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcXLogWrite failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -16811,20 +25893,22 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgPWrite(const int32_t seqid)
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcClose(const _File _fd)
+void DataPageAccessConcurrentClient::RpcXLogFileInit(_XLog_Init_File_Resp& _return, const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock)
 {
-  int32_t seqid = send_RpcClose(_fd);
-  return recv_RpcClose(seqid);
+  int32_t seqid = send_RpcXLogFileInit(_logsegno, _use_existent, _use_lock);
+  recv_RpcXLogFileInit(_return, seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcClose(const _File _fd)
+int32_t DataPageAccessConcurrentClient::send_RpcXLogFileInit(const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcClose", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcXLogFileInit", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcClose_pargs args;
-  args._fd = &_fd;
+  DataPageAccess_RpcXLogFileInit_pargs args;
+  args._logsegno = &_logsegno;
+  args._use_existent = &_use_existent;
+  args._use_lock = &_use_lock;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -16835,7 +25919,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcClose(const _File _fd)
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcClose(const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_RpcXLogFileInit(_XLog_Init_File_Resp& _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -16864,7 +25948,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcClose(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcClose") != 0) {
+      if (fname.compare("RpcXLogFileInit") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -16873,19 +25957,19 @@ int32_t DataPageAccessConcurrentClient::recv_RpcClose(const int32_t seqid)
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      int32_t _return;
-      DataPageAccess_RpcClose_presult result;
+      DataPageAccess_RpcXLogFileInit_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
+        // _return pointer has now been filled
         sentry.commit();
-        return _return;
+        return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcClose failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcXLogFileInit failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -16895,21 +25979,31 @@ int32_t DataPageAccessConcurrentClient::recv_RpcClose(const int32_t seqid)
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcBasicOpenFile(const _Path& _path, const int32_t _flags)
+void DataPageAccessConcurrentClient::ReadBufferBatch(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode, const int64_t _lsn)
 {
-  int32_t seqid = send_RpcBasicOpenFile(_path, _flags);
-  return recv_RpcBasicOpenFile(seqid);
+  int32_t seqid = send_ReadBufferBatch(_reln, _relpersistence, _forknum, _blknums, _readBufferMode, _lsn);
+  recv_ReadBufferBatch(_return, seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcBasicOpenFile(const _Path& _path, const int32_t _flags)
+void DataPageAccessConcurrentClient::ReadRelationHeads(std::vector<_Page> & _return, const std::vector<_Smgr_Relation> & _relns, const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn)
+{
+  int32_t seqid = send_ReadRelationHeads(_relns, _forknum, _max_blocks, _lsn);
+  recv_ReadRelationHeads(_return, seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::send_ReadBufferBatch(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode, const int64_t _lsn)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcBasicOpenFile", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("ReadBufferBatch", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcBasicOpenFile_pargs args;
-  args._path = &_path;
-  args._flags = &_flags;
+  DataPageAccess_ReadBufferBatch_pargs args;
+  args._reln = &_reln;
+  args._relpersistence = &_relpersistence;
+  args._forknum = &_forknum;
+  args._blknums = &_blknums;
+  args._readBufferMode = &_readBufferMode;
+  args._lsn = &_lsn;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -16920,7 +26014,28 @@ int32_t DataPageAccessConcurrentClient::send_RpcBasicOpenFile(const _Path& _path
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcBasicOpenFile(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::send_ReadRelationHeads(const std::vector<_Smgr_Relation> & _relns, const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("ReadRelationHeads", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_ReadRelationHeads_pargs args;
+  args._relns = &_relns;
+  args._forknum = &_forknum;
+  args._max_blocks = &_max_blocks;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
+}
+
+void DataPageAccessConcurrentClient::recv_ReadBufferBatch(std::vector<_Page> & _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -16949,7 +26064,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcBasicOpenFile(const int32_t seqi
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcBasicOpenFile") != 0) {
+      if (fname.compare("ReadBufferBatch") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -16958,19 +26073,19 @@ int32_t DataPageAccessConcurrentClient::recv_RpcBasicOpenFile(const int32_t seqi
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      int32_t _return;
-      DataPageAccess_RpcBasicOpenFile_presult result;
+      DataPageAccess_ReadBufferBatch_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
+        // _return pointer has now been filled
         sentry.commit();
-        return _return;
+        return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcBasicOpenFile failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ReadBufferBatch failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -16980,32 +26095,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcBasicOpenFile(const int32_t seqi
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcBasicOpenFileUnderPgData(const _Path& _path, const int32_t _flags)
-{
-  int32_t seqid = send_RpcBasicOpenFileUnderPgData(_path, _flags);
-  return recv_RpcBasicOpenFileUnderPgData(seqid);
-}
-
-int32_t DataPageAccessConcurrentClient::send_RpcBasicOpenFileUnderPgData(const _Path& _path, const int32_t _flags)
-{
-  int32_t cseqid = this->sync_->generateSeqId();
-  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcBasicOpenFileUnderPgData", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_RpcBasicOpenFileUnderPgData_pargs args;
-  args._path = &_path;
-  args._flags = &_flags;
-  args.write(oprot_);
-
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-
-  sentry.commit();
-  return cseqid;
-}
-
-int32_t DataPageAccessConcurrentClient::recv_RpcBasicOpenFileUnderPgData(const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_ReadRelationHeads(std::vector<_Page> & _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17034,7 +26124,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcBasicOpenFileUnderPgData(const i
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcBasicOpenFileUnderPgData") != 0) {
+      if (fname.compare("ReadRelationHeads") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17043,19 +26133,19 @@ int32_t DataPageAccessConcurrentClient::recv_RpcBasicOpenFileUnderPgData(const i
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      int32_t _return;
-      DataPageAccess_RpcBasicOpenFileUnderPgData_presult result;
+      DataPageAccess_ReadRelationHeads_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
+        // _return pointer has now been filled
         sentry.commit();
-        return _return;
+        return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcBasicOpenFileUnderPgData failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ReadRelationHeads failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -17065,20 +26155,26 @@ int32_t DataPageAccessConcurrentClient::recv_RpcBasicOpenFileUnderPgData(const i
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcPgFdatasync(const _File _fd)
+void DataPageAccessConcurrentClient::ReadBufferIfModified(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _cachedLsn)
 {
-  int32_t seqid = send_RpcPgFdatasync(_fd);
-  return recv_RpcPgFdatasync(seqid);
+  int32_t seqid = send_ReadBufferIfModified(_reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn, _cachedLsn);
+  recv_ReadBufferIfModified(_return, seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcPgFdatasync(const _File _fd)
+int32_t DataPageAccessConcurrentClient::send_ReadBufferIfModified(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _cachedLsn)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcPgFdatasync", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("ReadBufferIfModified", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcPgFdatasync_pargs args;
-  args._fd = &_fd;
+  DataPageAccess_ReadBufferIfModified_pargs args;
+  args._reln = &_reln;
+  args._relpersistence = &_relpersistence;
+  args._forknum = &_forknum;
+  args._blknum = &_blknum;
+  args._readBufferMode = &_readBufferMode;
+  args._lsn = &_lsn;
+  args._cachedLsn = &_cachedLsn;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -17089,7 +26185,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcPgFdatasync(const _File _fd)
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcPgFdatasync(const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_ReadBufferIfModified(_Page& _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17118,7 +26214,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgFdatasync(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcPgFdatasync") != 0) {
+      if (fname.compare("ReadBufferIfModified") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17127,19 +26223,19 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgFdatasync(const int32_t seqid)
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      int32_t _return;
-      DataPageAccess_RpcPgFdatasync_presult result;
+      DataPageAccess_ReadBufferIfModified_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
+        // _return pointer has now been filled
         sentry.commit();
-        return _return;
+        return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFdatasync failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ReadBufferIfModified failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -17149,20 +26245,23 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgFdatasync(const int32_t seqid)
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcPgFsyncNoWritethrough(const _File _fd)
+int32_t DataPageAccessConcurrentClient::PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int64_t _lsn)
 {
-  int32_t seqid = send_RpcPgFsyncNoWritethrough(_fd);
-  return recv_RpcPgFsyncNoWritethrough(seqid);
+  int32_t seqid = send_PrefetchBuffers(_reln, _forknum, _blknums, _lsn);
+  return recv_PrefetchBuffers(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcPgFsyncNoWritethrough(const _File _fd)
+int32_t DataPageAccessConcurrentClient::send_PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int64_t _lsn)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcPgFsyncNoWritethrough", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("PrefetchBuffers", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcPgFsyncNoWritethrough_pargs args;
-  args._fd = &_fd;
+  DataPageAccess_PrefetchBuffers_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknums = &_blknums;
+  args._lsn = &_lsn;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -17173,7 +26272,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcPgFsyncNoWritethrough(const _Fil
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcPgFsyncNoWritethrough(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_PrefetchBuffers(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17202,7 +26301,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgFsyncNoWritethrough(const int3
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcPgFsyncNoWritethrough") != 0) {
+      if (fname.compare("PrefetchBuffers") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17212,7 +26311,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgFsyncNoWritethrough(const int3
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcPgFsyncNoWritethrough_presult result;
+      DataPageAccess_PrefetchBuffers_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -17223,7 +26322,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgFsyncNoWritethrough(const int3
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFsyncNoWritethrough failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "PrefetchBuffers failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -17233,22 +26332,24 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgFsyncNoWritethrough(const int3
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcLseek(const int32_t _fd, const _Off_t _offset, const int32_t _flag)
+int32_t DataPageAccessConcurrentClient::InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn)
 {
-  int32_t seqid = send_RpcLseek(_fd, _offset, _flag);
-  return recv_RpcLseek(seqid);
+  int32_t seqid = send_InstallPages(_reln, _forknum, _blknums, _pages, _lsn);
+  return recv_InstallPages(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcLseek(const int32_t _fd, const _Off_t _offset, const int32_t _flag)
+int32_t DataPageAccessConcurrentClient::send_InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcLseek", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("InstallPages", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcLseek_pargs args;
-  args._fd = &_fd;
-  args._offset = &_offset;
-  args._flag = &_flag;
+  DataPageAccess_InstallPages_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknums = &_blknums;
+  args._pages = &_pages;
+  args._lsn = &_lsn;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -17259,7 +26360,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcLseek(const int32_t _fd, const _
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcLseek(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_InstallPages(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17288,7 +26389,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcLseek(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcLseek") != 0) {
+      if (fname.compare("InstallPages") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17298,7 +26399,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcLseek(const int32_t seqid)
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcLseek_presult result;
+      DataPageAccess_InstallPages_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -17309,7 +26410,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcLseek(const int32_t seqid)
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcLseek failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "InstallPages failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -17319,20 +26420,24 @@ int32_t DataPageAccessConcurrentClient::recv_RpcLseek(const int32_t seqid)
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcStat(_Stat_Resp& _return, const _Path& _path)
+int32_t DataPageAccessConcurrentClient::InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn)
 {
-  int32_t seqid = send_RpcStat(_path);
-  recv_RpcStat(_return, seqid);
+  int32_t seqid = send_InstallEvictedPages(_reln, _forknum, _blknums, _pages, _lsn);
+  return recv_InstallEvictedPages(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcStat(const _Path& _path)
+int32_t DataPageAccessConcurrentClient::send_InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcStat", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("InstallEvictedPages", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcStat_pargs args;
-  args._path = &_path;
+  DataPageAccess_InstallEvictedPages_pargs args;
+  args._reln = &_reln;
+  args._forknum = &_forknum;
+  args._blknums = &_blknums;
+  args._pages = &_pages;
+  args._lsn = &_lsn;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -17343,7 +26448,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcStat(const _Path& _path)
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcStat(_Stat_Resp& _return, const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::recv_InstallEvictedPages(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17372,7 +26477,7 @@ void DataPageAccessConcurrentClient::recv_RpcStat(_Stat_Resp& _return, const int
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcStat") != 0) {
+      if (fname.compare("InstallEvictedPages") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17381,19 +26486,19 @@ void DataPageAccessConcurrentClient::recv_RpcStat(_Stat_Resp& _return, const int
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcStat_presult result;
+      int32_t _return;
+      DataPageAccess_InstallEvictedPages_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
-        // _return pointer has now been filled
         sentry.commit();
-        return;
+        return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcStat failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "InstallEvictedPages failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -17403,20 +26508,19 @@ void DataPageAccessConcurrentClient::recv_RpcStat(_Stat_Resp& _return, const int
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcDirectoryIsEmpty(const _Path& _path)
+void DataPageAccessConcurrentClient::RpcGetSmartReplayMetrics(std::string& _return)
 {
-  int32_t seqid = send_RpcDirectoryIsEmpty(_path);
-  return recv_RpcDirectoryIsEmpty(seqid);
+  int32_t seqid = send_RpcGetSmartReplayMetrics();
+  recv_RpcGetSmartReplayMetrics(_return, seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcDirectoryIsEmpty(const _Path& _path)
+int32_t DataPageAccessConcurrentClient::send_RpcGetSmartReplayMetrics()
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcDirectoryIsEmpty", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcGetSmartReplayMetrics", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcDirectoryIsEmpty_pargs args;
-  args._path = &_path;
+  DataPageAccess_RpcGetSmartReplayMetrics_pargs args;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -17427,7 +26531,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcDirectoryIsEmpty(const _Path& _p
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcDirectoryIsEmpty(const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_RpcGetSmartReplayMetrics(std::string& _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17456,7 +26560,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcDirectoryIsEmpty(const int32_t s
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcDirectoryIsEmpty") != 0) {
+      if (fname.compare("RpcGetSmartReplayMetrics") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17465,19 +26569,19 @@ int32_t DataPageAccessConcurrentClient::recv_RpcDirectoryIsEmpty(const int32_t s
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      int32_t _return;
-      DataPageAccess_RpcDirectoryIsEmpty_presult result;
+      DataPageAccess_RpcGetSmartReplayMetrics_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
+        // _return pointer has now been filled
         sentry.commit();
-        return _return;
+        return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDirectoryIsEmpty failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcGetSmartReplayMetrics failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -17487,21 +26591,22 @@ int32_t DataPageAccessConcurrentClient::recv_RpcDirectoryIsEmpty(const int32_t s
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcCopyDir(const _Path& _src, const _Path& _dst)
+void DataPageAccessConcurrentClient::RpcFetchPageChanges(_Page& _return, const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq)
 {
-  int32_t seqid = send_RpcCopyDir(_src, _dst);
-  return recv_RpcCopyDir(seqid);
+  int32_t seqid = send_RpcFetchPageChanges(_max_entries, _wait_ms, _from_seq);
+  recv_RpcFetchPageChanges(_return, seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcCopyDir(const _Path& _src, const _Path& _dst)
+int32_t DataPageAccessConcurrentClient::send_RpcFetchPageChanges(const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcCopyDir", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcFetchPageChanges", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcCopyDir_pargs args;
-  args._src = &_src;
-  args._dst = &_dst;
+  DataPageAccess_RpcFetchPageChanges_pargs args;
+  args._max_entries = &_max_entries;
+  args._wait_ms = &_wait_ms;
+  args._from_seq = &_from_seq;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -17512,7 +26617,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcCopyDir(const _Path& _src, const
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcCopyDir(const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_RpcFetchPageChanges(_Page& _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17541,7 +26646,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcCopyDir(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcCopyDir") != 0) {
+      if (fname.compare("RpcFetchPageChanges") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17550,19 +26655,19 @@ int32_t DataPageAccessConcurrentClient::recv_RpcCopyDir(const int32_t seqid)
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      int32_t _return;
-      DataPageAccess_RpcCopyDir_presult result;
+      DataPageAccess_RpcFetchPageChanges_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
+        // _return pointer has now been filled
         sentry.commit();
-        return _return;
+        return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcCopyDir failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcFetchPageChanges failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -17572,20 +26677,27 @@ int32_t DataPageAccessConcurrentClient::recv_RpcCopyDir(const int32_t seqid)
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcPgFsync(const int32_t _fd)
+int32_t DataPageAccessConcurrentClient::RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn)
 {
-  int32_t seqid = send_RpcPgFsync(_fd);
-  return recv_RpcPgFsync(seqid);
+  int32_t seqid = send_RpcSecondaryNodeHeartbeat(_node_id, _lsn);
+  return recv_RpcSecondaryNodeHeartbeat(seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcPgFsync(const int32_t _fd)
+int64_t DataPageAccessConcurrentClient::RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn)
+{
+  int32_t seqid = send_RpcWaitWalParsed(_wait_ms, _lsn);
+  return recv_RpcWaitWalParsed(seqid);
+}
+
+int32_t DataPageAccessConcurrentClient::send_RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcPgFsync", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("RpcSecondaryNodeHeartbeat", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcPgFsync_pargs args;
-  args._fd = &_fd;
+  DataPageAccess_RpcSecondaryNodeHeartbeat_pargs args;
+  args._node_id = &_node_id;
+  args._lsn = &_lsn;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -17596,7 +26708,26 @@ int32_t DataPageAccessConcurrentClient::send_RpcPgFsync(const int32_t _fd)
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcPgFsync(const int32_t seqid)
+int32_t DataPageAccessConcurrentClient::send_RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn)
+{
+  int32_t cseqid = this->sync_->generateSeqId();
+  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
+  oprot_->writeMessageBegin("RpcWaitWalParsed", ::apache::thrift::protocol::T_CALL, cseqid);
+
+  DataPageAccess_RpcWaitWalParsed_pargs args;
+  args._wait_ms = &_wait_ms;
+  args._lsn = &_lsn;
+  args.write(oprot_);
+
+  oprot_->writeMessageEnd();
+  oprot_->getTransport()->writeEnd();
+  oprot_->getTransport()->flush();
+
+  sentry.commit();
+  return cseqid;
+}
+
+int32_t DataPageAccessConcurrentClient::recv_RpcSecondaryNodeHeartbeat(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17625,7 +26756,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgFsync(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcPgFsync") != 0) {
+      if (fname.compare("RpcSecondaryNodeHeartbeat") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17635,7 +26766,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgFsync(const int32_t seqid)
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
       int32_t _return;
-      DataPageAccess_RpcPgFsync_presult result;
+      DataPageAccess_RpcSecondaryNodeHeartbeat_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -17646,7 +26777,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgFsync(const int32_t seqid)
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcPgFsync failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcSecondaryNodeHeartbeat failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -17656,32 +26787,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcPgFsync(const int32_t seqid)
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcDurableUnlink(const _Path& _fname, const int32_t _flag)
-{
-  int32_t seqid = send_RpcDurableUnlink(_fname, _flag);
-  return recv_RpcDurableUnlink(seqid);
-}
-
-int32_t DataPageAccessConcurrentClient::send_RpcDurableUnlink(const _Path& _fname, const int32_t _flag)
-{
-  int32_t cseqid = this->sync_->generateSeqId();
-  ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcDurableUnlink", ::apache::thrift::protocol::T_CALL, cseqid);
-
-  DataPageAccess_RpcDurableUnlink_pargs args;
-  args._fname = &_fname;
-  args._flag = &_flag;
-  args.write(oprot_);
-
-  oprot_->writeMessageEnd();
-  oprot_->getTransport()->writeEnd();
-  oprot_->getTransport()->flush();
-
-  sentry.commit();
-  return cseqid;
-}
-
-int32_t DataPageAccessConcurrentClient::recv_RpcDurableUnlink(const int32_t seqid)
+int64_t DataPageAccessConcurrentClient::recv_RpcWaitWalParsed(const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17710,7 +26816,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcDurableUnlink(const int32_t seqi
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcDurableUnlink") != 0) {
+      if (fname.compare("RpcWaitWalParsed") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17719,8 +26825,8 @@ int32_t DataPageAccessConcurrentClient::recv_RpcDurableUnlink(const int32_t seqi
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      int32_t _return;
-      DataPageAccess_RpcDurableUnlink_presult result;
+      int64_t _return;
+      DataPageAccess_RpcWaitWalParsed_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -17731,7 +26837,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcDurableUnlink(const int32_t seqi
         return _return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDurableUnlink failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcWaitWalParsed failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -17741,22 +26847,25 @@ int32_t DataPageAccessConcurrentClient::recv_RpcDurableUnlink(const int32_t seqi
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcDurableRenameExcl(const _Path& _oldFname, const _Path& _newFname, const int32_t _elevel)
+void DataPageAccessConcurrentClient::ScanRelation(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _qual, const int32_t _max_pages, const int64_t _lsn)
 {
-  int32_t seqid = send_RpcDurableRenameExcl(_oldFname, _newFname, _elevel);
-  return recv_RpcDurableRenameExcl(seqid);
+  int32_t seqid = send_ScanRelation(_reln, _first_block, _end_block, _qual, _max_pages, _lsn);
+  recv_ScanRelation(_return, seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcDurableRenameExcl(const _Path& _oldFname, const _Path& _newFname, const int32_t _elevel)
+int32_t DataPageAccessConcurrentClient::send_ScanRelation(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _qual, const int32_t _max_pages, const int64_t _lsn)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcDurableRenameExcl", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("ScanRelation", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcDurableRenameExcl_pargs args;
-  args._oldFname = &_oldFname;
-  args._newFname = &_newFname;
-  args._elevel = &_elevel;
+  DataPageAccess_ScanRelation_pargs args;
+  args._reln = &_reln;
+  args._first_block = &_first_block;
+  args._end_block = &_end_block;
+  args._qual = &_qual;
+  args._max_pages = &_max_pages;
+  args._lsn = &_lsn;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -17767,7 +26876,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcDurableRenameExcl(const _Path& _
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcDurableRenameExcl(const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_ScanRelation(std::vector<_Page> & _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17796,7 +26905,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcDurableRenameExcl(const int32_t
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcDurableRenameExcl") != 0) {
+      if (fname.compare("ScanRelation") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17805,19 +26914,19 @@ int32_t DataPageAccessConcurrentClient::recv_RpcDurableRenameExcl(const int32_t
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      int32_t _return;
-      DataPageAccess_RpcDurableRenameExcl_presult result;
+      DataPageAccess_ScanRelation_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
+        // _return pointer has now been filled
         sentry.commit();
-        return _return;
+        return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcDurableRenameExcl failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "ScanRelation failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -17827,26 +26936,24 @@ int32_t DataPageAccessConcurrentClient::recv_RpcDurableRenameExcl(const int32_t
   } // end while(true)
 }
 
-int32_t DataPageAccessConcurrentClient::RpcXLogWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset, const std::vector<int64_t> & _xlblocks, const int32_t _blknum, const int32_t _idx, const int64_t _lsn)
+void DataPageAccessConcurrentClient::AggregateRelation(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback, const int64_t _lsn)
 {
-  int32_t seqid = send_RpcXLogWrite(_fd, _page, _amount, _offset, _xlblocks, _blknum, _idx, _lsn);
-  return recv_RpcXLogWrite(seqid);
+  int32_t seqid = send_AggregateRelation(_reln, _first_block, _end_block, _spec, _max_fallback, _lsn);
+  recv_AggregateRelation(_return, seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcXLogWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset, const std::vector<int64_t> & _xlblocks, const int32_t _blknum, const int32_t _idx, const int64_t _lsn)
+int32_t DataPageAccessConcurrentClient::send_AggregateRelation(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback, const int64_t _lsn)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcXLogWrite", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("AggregateRelation", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcXLogWrite_pargs args;
-  args._fd = &_fd;
-  args._page = &_page;
-  args._amount = &_amount;
-  args._offset = &_offset;
-  args._xlblocks = &_xlblocks;
-  args._blknum = &_blknum;
-  args._idx = &_idx;
+  DataPageAccess_AggregateRelation_pargs args;
+  args._reln = &_reln;
+  args._first_block = &_first_block;
+  args._end_block = &_end_block;
+  args._spec = &_spec;
+  args._max_fallback = &_max_fallback;
   args._lsn = &_lsn;
   args.write(oprot_);
 
@@ -17858,7 +26965,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcXLogWrite(const _File _fd, const
   return cseqid;
 }
 
-int32_t DataPageAccessConcurrentClient::recv_RpcXLogWrite(const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_AggregateRelation(std::string& _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17887,7 +26994,7 @@ int32_t DataPageAccessConcurrentClient::recv_RpcXLogWrite(const int32_t seqid)
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcXLogWrite") != 0) {
+      if (fname.compare("AggregateRelation") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17896,19 +27003,19 @@ int32_t DataPageAccessConcurrentClient::recv_RpcXLogWrite(const int32_t seqid)
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      int32_t _return;
-      DataPageAccess_RpcXLogWrite_presult result;
+      DataPageAccess_AggregateRelation_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
       iprot_->getTransport()->readEnd();
 
       if (result.__isset.success) {
+        // _return pointer has now been filled
         sentry.commit();
-        return _return;
+        return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcXLogWrite failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "AggregateRelation failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
@@ -17918,22 +27025,25 @@ int32_t DataPageAccessConcurrentClient::recv_RpcXLogWrite(const int32_t seqid)
   } // end while(true)
 }
 
-void DataPageAccessConcurrentClient::RpcXLogFileInit(_XLog_Init_File_Resp& _return, const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock)
+void DataPageAccessConcurrentClient::TriageVacuum(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead, const int64_t _lsn)
 {
-  int32_t seqid = send_RpcXLogFileInit(_logsegno, _use_existent, _use_lock);
-  recv_RpcXLogFileInit(_return, seqid);
+  int32_t seqid = send_TriageVacuum(_reln, _first_block, _end_block, _horizon, _max_dead, _lsn);
+  recv_TriageVacuum(_return, seqid);
 }
 
-int32_t DataPageAccessConcurrentClient::send_RpcXLogFileInit(const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock)
+int32_t DataPageAccessConcurrentClient::send_TriageVacuum(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead, const int64_t _lsn)
 {
   int32_t cseqid = this->sync_->generateSeqId();
   ::apache::thrift::async::TConcurrentSendSentry sentry(this->sync_.get());
-  oprot_->writeMessageBegin("RpcXLogFileInit", ::apache::thrift::protocol::T_CALL, cseqid);
+  oprot_->writeMessageBegin("TriageVacuum", ::apache::thrift::protocol::T_CALL, cseqid);
 
-  DataPageAccess_RpcXLogFileInit_pargs args;
-  args._logsegno = &_logsegno;
-  args._use_existent = &_use_existent;
-  args._use_lock = &_use_lock;
+  DataPageAccess_TriageVacuum_pargs args;
+  args._reln = &_reln;
+  args._first_block = &_first_block;
+  args._end_block = &_end_block;
+  args._horizon = &_horizon;
+  args._max_dead = &_max_dead;
+  args._lsn = &_lsn;
   args.write(oprot_);
 
   oprot_->writeMessageEnd();
@@ -17944,7 +27054,7 @@ int32_t DataPageAccessConcurrentClient::send_RpcXLogFileInit(const int64_t _logs
   return cseqid;
 }
 
-void DataPageAccessConcurrentClient::recv_RpcXLogFileInit(_XLog_Init_File_Resp& _return, const int32_t seqid)
+void DataPageAccessConcurrentClient::recv_TriageVacuum(std::string& _return, const int32_t seqid)
 {
 
   int32_t rseqid = 0;
@@ -17973,7 +27083,7 @@ void DataPageAccessConcurrentClient::recv_RpcXLogFileInit(_XLog_Init_File_Resp&
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
       }
-      if (fname.compare("RpcXLogFileInit") != 0) {
+      if (fname.compare("TriageVacuum") != 0) {
         iprot_->skip(::apache::thrift::protocol::T_STRUCT);
         iprot_->readMessageEnd();
         iprot_->getTransport()->readEnd();
@@ -17982,7 +27092,7 @@ void DataPageAccessConcurrentClient::recv_RpcXLogFileInit(_XLog_Init_File_Resp&
         using ::apache::thrift::protocol::TProtocolException;
         throw TProtocolException(TProtocolException::INVALID_DATA);
       }
-      DataPageAccess_RpcXLogFileInit_presult result;
+      DataPageAccess_TriageVacuum_presult result;
       result.success = &_return;
       result.read(iprot_);
       iprot_->readMessageEnd();
@@ -17994,7 +27104,7 @@ void DataPageAccessConcurrentClient::recv_RpcXLogFileInit(_XLog_Init_File_Resp&
         return;
       }
       // in a bad state, don't commit
-      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "RpcXLogFileInit failed: unknown result");
+      throw ::apache::thrift::TApplicationException(::apache::thrift::TApplicationException::MISSING_RESULT, "TriageVacuum failed: unknown result");
     }
     // seqid != rseqid
     this->sync_->updatePending(fname, mtype, rseqid);
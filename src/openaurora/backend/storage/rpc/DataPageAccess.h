@@ -40,7 +40,7 @@ class DataPageAccessIf {
    * @param _readBufferMode
    * @param _lsn
    */
-  virtual void ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn) = 0;
+  virtual void ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId) = 0;
   virtual int32_t RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn) = 0;
   virtual void RpcSecondaryNodeUpdatesLsn(const int32_t _node_id, const int64_t _lsn) = 0;
   virtual void RpcMdRead(_Page& _return, const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _blknum, const int64_t _lsn) = 0;
@@ -48,6 +48,7 @@ class DataPageAccessIf {
   virtual int32_t RpcMdExists(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn) = 0;
   virtual void RpcMdCreate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _isRedo, const int64_t _lsn) = 0;
   virtual void RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn) = 0;
+  virtual void RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn) = 0;
   virtual void RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn) = 0;
   virtual void RpcFileClose(const _File _fd) = 0;
   virtual void RpcTablespaceCreateDbspace(const _Oid _spcnode, const _Oid _dbnode, const bool isRedo) = 0;
@@ -62,6 +63,7 @@ class DataPageAccessIf {
   virtual int32_t RpcUnlink(const _Path& _path) = 0;
   virtual int32_t RpcFtruncate(const _File _fd, const _Off_t _offset) = 0;
   virtual void RpcInitFile(_Page& _return, const _Path& _path) = 0;
+  virtual void RpcOpenAndReadFile(_Page& _return, const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient) = 0;
   virtual _File RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags) = 0;
   virtual _File RpcOpenTransientFileUnderPgData(const _Path& _filename, const int32_t _fileflags) = 0;
   virtual int32_t RpcCloseTransientFile(const _File _fd) = 0;
@@ -78,12 +80,31 @@ class DataPageAccessIf {
   virtual int32_t RpcLseek(const int32_t _fd, const _Off_t _offset, const int32_t _flag) = 0;
   virtual void RpcStat(_Stat_Resp& _return, const _Path& _path) = 0;
   virtual int32_t RpcDirectoryIsEmpty(const _Path& _path) = 0;
+  virtual int32_t RpcSyncFiles(const std::vector<_Path> & _paths) = 0;
+  virtual int32_t RpcAttachSharedMemory(const _Path& _name) = 0;
+  virtual int32_t RpcPublishResidentPages(const _Page& _summary) = 0;
   virtual int32_t RpcCopyDir(const _Path& _src, const _Path& _dst) = 0;
   virtual int32_t RpcPgFsync(const int32_t _fd) = 0;
+  virtual int32_t RpcSetPageCompression(const int32_t _method) = 0;
+  virtual int32_t RpcSetRequestClass(const int32_t _requestClass) = 0;
+  virtual int32_t RpcSetRequestDeadline(const int32_t _queue_ms) = 0;
   virtual int32_t RpcDurableUnlink(const _Path& _fname, const int32_t _flag) = 0;
   virtual int32_t RpcDurableRenameExcl(const _Path& _oldFname, const _Path& _newFname, const int32_t _elevel) = 0;
   virtual int32_t RpcXLogWrite(const _File _fd, const _Page& _page, const int32_t _amount, const _Off_t _offset, const std::vector<int64_t> & _xlblocks, const int32_t _blknum, const int32_t _idx, const int64_t _lsn) = 0;
   virtual void RpcXLogFileInit(_XLog_Init_File_Resp& _return, const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock) = 0;
+  virtual void ReadBufferBatch(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode, const int64_t _lsn) = 0;
+  virtual void ReadRelationHeads(std::vector<_Page> & _return, const std::vector<_Smgr_Relation> & _relns, const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn) = 0;
+  virtual void ReadBufferIfModified(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _cachedLsn) = 0;
+  virtual int32_t PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int64_t _lsn) = 0;
+  virtual int32_t InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn) = 0;
+  virtual int32_t InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn) = 0;
+  virtual void RpcGetSmartReplayMetrics(std::string& _return) = 0;
+  virtual void RpcFetchPageChanges(_Page& _return, const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq) = 0;
+  virtual int32_t RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn) = 0;
+  virtual int64_t RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn) = 0;
+  virtual void ScanRelation(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _qual, const int32_t _max_pages, const int64_t _lsn) = 0;
+  virtual void AggregateRelation(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback, const int64_t _lsn) = 0;
+  virtual void TriageVacuum(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead, const int64_t _lsn) = 0;
 
   /**
    * This method has a oneway modifier. That means the client only makes
@@ -120,7 +141,7 @@ class DataPageAccessIfSingletonFactory : virtual public DataPageAccessIfFactory
 class DataPageAccessNull : virtual public DataPageAccessIf {
  public:
   virtual ~DataPageAccessNull() {}
-  void ReadBufferCommon(_Page& /* _return */, const _Smgr_Relation& /* _reln */, const int32_t /* _relpersistence */, const int32_t /* _forknum */, const int32_t /* _blknum */, const int32_t /* _readBufferMode */, const int64_t /* _lsn */) override {
+  void ReadBufferCommon(_Page& /* _return */, const _Smgr_Relation& /* _reln */, const int32_t /* _relpersistence */, const int32_t /* _forknum */, const int32_t /* _blknum */, const int32_t /* _readBufferMode */, const int64_t /* _lsn */, const int64_t /* _traceId */) override {
     return;
   }
   int32_t RpcRegisterSecondaryNode(const bool /* _primary */, const int64_t /* _lsn */) override {
@@ -147,6 +168,9 @@ class DataPageAccessNull : virtual public DataPageAccessIf {
   void RpcMdExtend(const _Smgr_Relation& /* _reln */, const int32_t /* _forknum */, const int32_t /* _blknum */, const _Page& /* _buff */, const int32_t /* skipFsync */, const int64_t /* _lsn */) override {
     return;
   }
+  void RpcMdExtendMany(const _Smgr_Relation& /* _reln */, const int32_t /* _forknum */, const int32_t /* _startblk */, const int32_t /* _nblocks */, const int32_t /* skipFsync */, const int64_t /* _lsn */) override {
+    return;
+  }
   void RpcTruncate(const _Smgr_Relation& /* _reln */, const int32_t /* _forknum */, const int32_t /* _blknum */, const int64_t /* _lsn */) override {
     return;
   }
@@ -196,6 +220,9 @@ class DataPageAccessNull : virtual public DataPageAccessIf {
   void RpcInitFile(_Page& /* _return */, const _Path& /* _path */) override {
     return;
   }
+  void RpcOpenAndReadFile(_Page& /* _return */, const _Path& /* _path */, const int32_t /* _flags */, const int32_t /* _amount */, const int32_t /* _transient */) override {
+    return;
+  }
   _File RpcOpenTransientFile(const _Path& /* _filename */, const int32_t /* _fileflags */) override {
     _File _return = 0;
     return _return;
@@ -257,6 +284,18 @@ class DataPageAccessNull : virtual public DataPageAccessIf {
     int32_t _return = 0;
     return _return;
   }
+  int32_t RpcSyncFiles(const std::vector<_Path> & /* _paths */) override {
+    int32_t _return = 0;
+    return _return;
+  }
+  int32_t RpcAttachSharedMemory(const _Path& /* _name */) override {
+    int32_t _return = 0;
+    return _return;
+  }
+  int32_t RpcPublishResidentPages(const _Page& /* _summary */) override {
+    int32_t _return = 0;
+    return _return;
+  }
   int32_t RpcCopyDir(const _Path& /* _src */, const _Path& /* _dst */) override {
     int32_t _return = 0;
     return _return;
@@ -265,6 +304,18 @@ class DataPageAccessNull : virtual public DataPageAccessIf {
     int32_t _return = 0;
     return _return;
   }
+  int32_t RpcSetPageCompression(const int32_t /* _method */) override {
+    int32_t _return = 0;
+    return _return;
+  }
+  int32_t RpcSetRequestClass(const int32_t /* _requestClass */) override {
+    int32_t _return = 0;
+    return _return;
+  }
+  int32_t RpcSetRequestDeadline(const int32_t /* _queue_ms */) override {
+    int32_t _return = 0;
+    return _return;
+  }
   int32_t RpcDurableUnlink(const _Path& /* _fname */, const int32_t /* _flag */) override {
     int32_t _return = 0;
     return _return;
@@ -280,19 +331,64 @@ class DataPageAccessNull : virtual public DataPageAccessIf {
   void RpcXLogFileInit(_XLog_Init_File_Resp& /* _return */, const int64_t /* _logsegno */, const int32_t /* _use_existent */, const int32_t /* _use_lock */) override {
     return;
   }
+  void ReadBufferBatch(std::vector<_Page> & /* _return */, const _Smgr_Relation& /* _reln */, const int32_t /* _relpersistence */, const int32_t /* _forknum */, const std::vector<int64_t> & /* _blknums */, const int32_t /* _readBufferMode */, const int64_t /* _lsn */) override {
+    return;
+  }
+  void ReadRelationHeads(std::vector<_Page> & /* _return */, const std::vector<_Smgr_Relation> & /* _relns */, const int32_t /* _forknum */, const int32_t /* _max_blocks */, const int64_t /* _lsn */) override {
+    return;
+  }
+  void ReadBufferIfModified(_Page& /* _return */, const _Smgr_Relation& /* _reln */, const int32_t /* _relpersistence */, const int32_t /* _forknum */, const int32_t /* _blknum */, const int32_t /* _readBufferMode */, const int64_t /* _lsn */, const int64_t /* _cachedLsn */) override {
+    return;
+  }
+  int32_t PrefetchBuffers(const _Smgr_Relation& /* _reln */, const int32_t /* _forknum */, const std::vector<int64_t> & /* _blknums */, const int64_t /* _lsn */) override {
+    int32_t _return = 0;
+    return _return;
+  }
+  int32_t InstallPages(const _Smgr_Relation& /* _reln */, const int32_t /* _forknum */, const std::vector<int64_t> & /* _blknums */, const _Page& /* _pages */, const int64_t /* _lsn */) override {
+    int32_t _return = 0;
+    return _return;
+  }
+  int32_t InstallEvictedPages(const _Smgr_Relation& /* _reln */, const int32_t /* _forknum */, const std::vector<int64_t> & /* _blknums */, const _Page& /* _pages */, const int64_t /* _lsn */) override {
+    int32_t _return = 0;
+    return _return;
+  }
+  void RpcGetSmartReplayMetrics(std::string& /* _return */) override {
+    return;
+  }
+  void RpcFetchPageChanges(_Page& /* _return */, const int32_t /* _max_entries */, const int32_t /* _wait_ms */, const int64_t /* _from_seq */) override {
+    return;
+  }
+  int32_t RpcSecondaryNodeHeartbeat(const int32_t /* _node_id */, const int64_t /* _lsn */) override {
+    int32_t _return = 0;
+    return _return;
+  }
+  int64_t RpcWaitWalParsed(const int32_t /* _wait_ms */, const int64_t /* _lsn */) override {
+    int64_t _return = 0;
+    return _return;
+  }
+  void ScanRelation(std::vector<_Page> & /* _return */, const _Smgr_Relation& /* _reln */, const int32_t /* _first_block */, const int32_t /* _end_block */, const std::string& /* _qual */, const int32_t /* _max_pages */, const int64_t /* _lsn */) override {
+    return;
+  }
+  void AggregateRelation(std::string& /* _return */, const _Smgr_Relation& /* _reln */, const int32_t /* _first_block */, const int32_t /* _end_block */, const std::string& /* _spec */, const int32_t /* _max_fallback */, const int64_t /* _lsn */) override {
+    return;
+  }
+  void TriageVacuum(std::string& /* _return */, const _Smgr_Relation& /* _reln */, const int32_t /* _first_block */, const int32_t /* _end_block */, const std::string& /* _horizon */, const int32_t /* _max_dead */, const int64_t /* _lsn */) override {
+    return;
+  }
   void zip() override {
     return;
   }
 };
 
 typedef struct _DataPageAccess_ReadBufferCommon_args__isset {
-  _DataPageAccess_ReadBufferCommon_args__isset() : _reln(false), _relpersistence(false), _forknum(false), _blknum(false), _readBufferMode(false), _lsn(false) {}
+  _DataPageAccess_ReadBufferCommon_args__isset() : _reln(false), _relpersistence(false), _forknum(false), _blknum(false), _readBufferMode(false), _lsn(false), _traceId(false) {}
   bool _reln :1;
   bool _relpersistence :1;
   bool _forknum :1;
   bool _blknum :1;
   bool _readBufferMode :1;
   bool _lsn :1;
+  bool _traceId :1;
 } _DataPageAccess_ReadBufferCommon_args__isset;
 
 class DataPageAccess_ReadBufferCommon_args {
@@ -305,7 +401,8 @@ class DataPageAccess_ReadBufferCommon_args {
                                          _forknum(0),
                                          _blknum(0),
                                          _readBufferMode(0),
-                                         _lsn(0) {
+                                         _lsn(0),
+                                         _traceId(0) {
   }
 
   virtual ~DataPageAccess_ReadBufferCommon_args() noexcept;
@@ -315,6 +412,7 @@ class DataPageAccess_ReadBufferCommon_args {
   int32_t _blknum;
   int32_t _readBufferMode;
   int64_t _lsn;
+  int64_t _traceId;
 
   _DataPageAccess_ReadBufferCommon_args__isset __isset;
 
@@ -330,6 +428,8 @@ class DataPageAccess_ReadBufferCommon_args {
 
   void __set__lsn(const int64_t val);
 
+  void __set__traceId(const int64_t val);
+
   bool operator == (const DataPageAccess_ReadBufferCommon_args & rhs) const
   {
     if (!(_reln == rhs._reln))
@@ -344,6 +444,8 @@ class DataPageAccess_ReadBufferCommon_args {
       return false;
     if (!(_lsn == rhs._lsn))
       return false;
+    if (!(_traceId == rhs._traceId))
+      return false;
     return true;
   }
   bool operator != (const DataPageAccess_ReadBufferCommon_args &rhs) const {
@@ -369,6 +471,7 @@ class DataPageAccess_ReadBufferCommon_pargs {
   const int32_t* _blknum;
   const int32_t* _readBufferMode;
   const int64_t* _lsn;
+  const int64_t* _traceId;
 
   uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
 
@@ -1130,6 +1233,16 @@ typedef struct _DataPageAccess_RpcMdExtend_args__isset {
   bool _lsn :1;
 } _DataPageAccess_RpcMdExtend_args__isset;
 
+typedef struct _DataPageAccess_RpcMdExtendMany_args__isset {
+  _DataPageAccess_RpcMdExtendMany_args__isset() : _reln(false), _forknum(false), _startblk(false), _nblocks(false), skipFsync(false), _lsn(false) {}
+  bool _reln :1;
+  bool _forknum :1;
+  bool _startblk :1;
+  bool _nblocks :1;
+  bool skipFsync :1;
+  bool _lsn :1;
+} _DataPageAccess_RpcMdExtendMany_args__isset;
+
 class DataPageAccess_RpcMdExtend_args {
  public:
 
@@ -1192,6 +1305,68 @@ class DataPageAccess_RpcMdExtend_args {
 
 };
 
+class DataPageAccess_RpcMdExtendMany_args {
+ public:
+
+  DataPageAccess_RpcMdExtendMany_args(const DataPageAccess_RpcMdExtendMany_args&);
+  DataPageAccess_RpcMdExtendMany_args& operator=(const DataPageAccess_RpcMdExtendMany_args&);
+  DataPageAccess_RpcMdExtendMany_args() noexcept
+                                  : _forknum(0),
+                                    _startblk(0),
+                                    _nblocks(0),
+                                    skipFsync(0),
+                                    _lsn(0) {
+  }
+
+  virtual ~DataPageAccess_RpcMdExtendMany_args() noexcept;
+  _Smgr_Relation _reln;
+  int32_t _forknum;
+  int32_t _startblk;
+  int32_t _nblocks;
+  int32_t skipFsync;
+  int64_t _lsn;
+
+  _DataPageAccess_RpcMdExtendMany_args__isset __isset;
+
+  void __set__reln(const _Smgr_Relation& val);
+
+  void __set__forknum(const int32_t val);
+
+  void __set__startblk(const int32_t val);
+
+  void __set__nblocks(const int32_t val);
+
+  void __set_skipFsync(const int32_t val);
+
+  void __set__lsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_RpcMdExtendMany_args & rhs) const
+  {
+    if (!(_reln == rhs._reln))
+      return false;
+    if (!(_forknum == rhs._forknum))
+      return false;
+    if (!(_startblk == rhs._startblk))
+      return false;
+    if (!(_nblocks == rhs._nblocks))
+      return false;
+    if (!(skipFsync == rhs.skipFsync))
+      return false;
+    if (!(_lsn == rhs._lsn))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcMdExtendMany_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcMdExtendMany_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
 
 class DataPageAccess_RpcMdExtend_pargs {
  public:
@@ -1209,6 +1384,22 @@ class DataPageAccess_RpcMdExtend_pargs {
 
 };
 
+class DataPageAccess_RpcMdExtendMany_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcMdExtendMany_pargs() noexcept;
+  const _Smgr_Relation* _reln;
+  const int32_t* _forknum;
+  const int32_t* _startblk;
+  const int32_t* _nblocks;
+  const int32_t* skipFsync;
+  const int64_t* _lsn;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
 
 class DataPageAccess_RpcMdExtend_result {
  public:
@@ -1235,6 +1426,31 @@ class DataPageAccess_RpcMdExtend_result {
 
 };
 
+class DataPageAccess_RpcMdExtendMany_result {
+ public:
+
+  DataPageAccess_RpcMdExtendMany_result(const DataPageAccess_RpcMdExtendMany_result&) noexcept;
+  DataPageAccess_RpcMdExtendMany_result& operator=(const DataPageAccess_RpcMdExtendMany_result&) noexcept;
+  DataPageAccess_RpcMdExtendMany_result() noexcept {
+  }
+
+  virtual ~DataPageAccess_RpcMdExtendMany_result() noexcept;
+
+  bool operator == (const DataPageAccess_RpcMdExtendMany_result & /* rhs */) const
+  {
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcMdExtendMany_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcMdExtendMany_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
 
 class DataPageAccess_RpcMdExtend_presult {
  public:
@@ -1246,6 +1462,16 @@ class DataPageAccess_RpcMdExtend_presult {
 
 };
 
+class DataPageAccess_RpcMdExtendMany_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcMdExtendMany_presult() noexcept;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
 typedef struct _DataPageAccess_RpcTruncate_args__isset {
   _DataPageAccess_RpcTruncate_args__isset() : _reln(false), _forknum(false), _blknum(false), _lsn(false) {}
   bool _reln :1;
@@ -2720,6 +2946,14 @@ typedef struct _DataPageAccess_RpcInitFile_args__isset {
   bool _path :1;
 } _DataPageAccess_RpcInitFile_args__isset;
 
+typedef struct _DataPageAccess_RpcOpenAndReadFile_args__isset {
+  _DataPageAccess_RpcOpenAndReadFile_args__isset() : _path(false), _flags(false), _amount(false), _transient(false) {}
+  bool _path :1;
+  bool _flags :1;
+  bool _amount :1;
+  bool _transient :1;
+} _DataPageAccess_RpcOpenAndReadFile_args__isset;
+
 class DataPageAccess_RpcInitFile_args {
  public:
 
@@ -2753,6 +2987,57 @@ class DataPageAccess_RpcInitFile_args {
 
 };
 
+class DataPageAccess_RpcOpenAndReadFile_args {
+ public:
+
+  DataPageAccess_RpcOpenAndReadFile_args(const DataPageAccess_RpcOpenAndReadFile_args&);
+  DataPageAccess_RpcOpenAndReadFile_args& operator=(const DataPageAccess_RpcOpenAndReadFile_args&);
+  DataPageAccess_RpcOpenAndReadFile_args() noexcept
+                                  : _path(),
+                                         _flags(0),
+                                         _amount(0),
+                                         _transient(0) {
+  }
+
+  virtual ~DataPageAccess_RpcOpenAndReadFile_args() noexcept;
+  _Path _path;
+  int32_t _flags;
+  int32_t _amount;
+  int32_t _transient;
+
+  _DataPageAccess_RpcOpenAndReadFile_args__isset __isset;
+
+  void __set__path(const _Path& val);
+
+  void __set__flags(const int32_t val);
+
+  void __set__amount(const int32_t val);
+
+  void __set__transient(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcOpenAndReadFile_args & rhs) const
+  {
+    if (!(_path == rhs._path))
+      return false;
+    if (!(_flags == rhs._flags))
+      return false;
+    if (!(_amount == rhs._amount))
+      return false;
+    if (!(_transient == rhs._transient))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcOpenAndReadFile_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcOpenAndReadFile_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
 
 class DataPageAccess_RpcInitFile_pargs {
  public:
@@ -2765,11 +3050,30 @@ class DataPageAccess_RpcInitFile_pargs {
 
 };
 
+class DataPageAccess_RpcOpenAndReadFile_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcOpenAndReadFile_pargs() noexcept;
+  const _Path* _path;
+  const int32_t* _flags;
+  const int32_t* _amount;
+  const int32_t* _transient;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
 typedef struct _DataPageAccess_RpcInitFile_result__isset {
   _DataPageAccess_RpcInitFile_result__isset() : success(false) {}
   bool success :1;
 } _DataPageAccess_RpcInitFile_result__isset;
 
+typedef struct _DataPageAccess_RpcOpenAndReadFile_result__isset {
+  _DataPageAccess_RpcOpenAndReadFile_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcOpenAndReadFile_result__isset;
+
 class DataPageAccess_RpcInitFile_result {
  public:
 
@@ -2803,11 +3107,49 @@ class DataPageAccess_RpcInitFile_result {
 
 };
 
+class DataPageAccess_RpcOpenAndReadFile_result {
+ public:
+
+  DataPageAccess_RpcOpenAndReadFile_result(const DataPageAccess_RpcOpenAndReadFile_result&);
+  DataPageAccess_RpcOpenAndReadFile_result& operator=(const DataPageAccess_RpcOpenAndReadFile_result&);
+  DataPageAccess_RpcOpenAndReadFile_result() noexcept
+                                    : success() {
+  }
+
+  virtual ~DataPageAccess_RpcOpenAndReadFile_result() noexcept;
+  _Page success;
+
+  _DataPageAccess_RpcOpenAndReadFile_result__isset __isset;
+
+  void __set_success(const _Page& val);
+
+  bool operator == (const DataPageAccess_RpcOpenAndReadFile_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcOpenAndReadFile_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcOpenAndReadFile_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
 typedef struct _DataPageAccess_RpcInitFile_presult__isset {
   _DataPageAccess_RpcInitFile_presult__isset() : success(false) {}
   bool success :1;
 } _DataPageAccess_RpcInitFile_presult__isset;
 
+typedef struct _DataPageAccess_RpcOpenAndReadFile_presult__isset {
+  _DataPageAccess_RpcOpenAndReadFile_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcOpenAndReadFile_presult__isset;
+
 class DataPageAccess_RpcInitFile_presult {
  public:
 
@@ -2821,6 +3163,19 @@ class DataPageAccess_RpcInitFile_presult {
 
 };
 
+class DataPageAccess_RpcOpenAndReadFile_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcOpenAndReadFile_presult() noexcept;
+  _Page* success;
+
+  _DataPageAccess_RpcOpenAndReadFile_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
 typedef struct _DataPageAccess_RpcOpenTransientFile_args__isset {
   _DataPageAccess_RpcOpenTransientFile_args__isset() : _filename(false), _fileflags(false) {}
   bool _filename :1;
@@ -4535,6 +4890,21 @@ typedef struct _DataPageAccess_RpcDirectoryIsEmpty_args__isset {
   bool _path :1;
 } _DataPageAccess_RpcDirectoryIsEmpty_args__isset;
 
+typedef struct _DataPageAccess_RpcSyncFiles_args__isset {
+  _DataPageAccess_RpcSyncFiles_args__isset() : _paths(false) {}
+  bool _paths :1;
+} _DataPageAccess_RpcSyncFiles_args__isset;
+
+typedef struct _DataPageAccess_RpcAttachSharedMemory_args__isset {
+  _DataPageAccess_RpcAttachSharedMemory_args__isset() : _name(false) {}
+  bool _name :1;
+} _DataPageAccess_RpcAttachSharedMemory_args__isset;
+
+typedef struct _DataPageAccess_RpcPublishResidentPages_args__isset {
+  _DataPageAccess_RpcPublishResidentPages_args__isset() : _summary(false) {}
+  bool _summary :1;
+} _DataPageAccess_RpcPublishResidentPages_args__isset;
+
 class DataPageAccess_RpcDirectoryIsEmpty_args {
  public:
 
@@ -4568,28 +4938,175 @@ class DataPageAccess_RpcDirectoryIsEmpty_args {
 
 };
 
-
-class DataPageAccess_RpcDirectoryIsEmpty_pargs {
+class DataPageAccess_RpcSyncFiles_args {
  public:
 
+  DataPageAccess_RpcSyncFiles_args(const DataPageAccess_RpcSyncFiles_args&);
+  DataPageAccess_RpcSyncFiles_args& operator=(const DataPageAccess_RpcSyncFiles_args&);
+  DataPageAccess_RpcSyncFiles_args() noexcept
+                                          : _paths() {
+  }
 
-  virtual ~DataPageAccess_RpcDirectoryIsEmpty_pargs() noexcept;
-  const _Path* _path;
+  virtual ~DataPageAccess_RpcSyncFiles_args() noexcept;
+  std::vector<_Path>  _paths;
+
+  _DataPageAccess_RpcSyncFiles_args__isset __isset;
+
+  void __set__paths(const std::vector<_Path> & val);
+
+  bool operator == (const DataPageAccess_RpcSyncFiles_args & rhs) const
+  {
+    if (!(_paths == rhs._paths))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcSyncFiles_args &rhs) const {
+    return !(*this == rhs);
+  }
 
+  bool operator < (const DataPageAccess_RpcSyncFiles_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
   uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
 
 };
 
-typedef struct _DataPageAccess_RpcDirectoryIsEmpty_result__isset {
-  _DataPageAccess_RpcDirectoryIsEmpty_result__isset() : success(false) {}
-  bool success :1;
-} _DataPageAccess_RpcDirectoryIsEmpty_result__isset;
-
-class DataPageAccess_RpcDirectoryIsEmpty_result {
+class DataPageAccess_RpcAttachSharedMemory_args {
  public:
 
-  DataPageAccess_RpcDirectoryIsEmpty_result(const DataPageAccess_RpcDirectoryIsEmpty_result&) noexcept;
-  DataPageAccess_RpcDirectoryIsEmpty_result& operator=(const DataPageAccess_RpcDirectoryIsEmpty_result&) noexcept;
+  DataPageAccess_RpcAttachSharedMemory_args(const DataPageAccess_RpcAttachSharedMemory_args&);
+  DataPageAccess_RpcAttachSharedMemory_args& operator=(const DataPageAccess_RpcAttachSharedMemory_args&);
+  DataPageAccess_RpcAttachSharedMemory_args() noexcept
+                                          : _name() {
+  }
+
+  virtual ~DataPageAccess_RpcAttachSharedMemory_args() noexcept;
+  _Path _name;
+
+  _DataPageAccess_RpcAttachSharedMemory_args__isset __isset;
+
+  void __set__name(const _Path& val);
+
+  bool operator == (const DataPageAccess_RpcAttachSharedMemory_args & rhs) const
+  {
+    if (!(_name == rhs._name))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcAttachSharedMemory_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcAttachSharedMemory_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcPublishResidentPages_args {
+ public:
+
+  DataPageAccess_RpcPublishResidentPages_args(const DataPageAccess_RpcPublishResidentPages_args&);
+  DataPageAccess_RpcPublishResidentPages_args& operator=(const DataPageAccess_RpcPublishResidentPages_args&);
+  DataPageAccess_RpcPublishResidentPages_args() noexcept
+                                          : _summary() {
+  }
+
+  virtual ~DataPageAccess_RpcPublishResidentPages_args() noexcept;
+  _Page _summary;
+
+  _DataPageAccess_RpcPublishResidentPages_args__isset __isset;
+
+  void __set__summary(const _Page& val);
+
+  bool operator == (const DataPageAccess_RpcPublishResidentPages_args & rhs) const
+  {
+    if (!(_summary == rhs._summary))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcPublishResidentPages_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcPublishResidentPages_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_RpcDirectoryIsEmpty_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcDirectoryIsEmpty_pargs() noexcept;
+  const _Path* _path;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcSyncFiles_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcSyncFiles_pargs() noexcept;
+  const std::vector<_Path> * _paths;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcAttachSharedMemory_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcAttachSharedMemory_pargs() noexcept;
+  const _Path* _name;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcPublishResidentPages_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcPublishResidentPages_pargs() noexcept;
+  const _Page* _summary;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcDirectoryIsEmpty_result__isset {
+  _DataPageAccess_RpcDirectoryIsEmpty_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcDirectoryIsEmpty_result__isset;
+
+typedef struct _DataPageAccess_RpcSyncFiles_result__isset {
+  _DataPageAccess_RpcSyncFiles_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcSyncFiles_result__isset;
+
+typedef struct _DataPageAccess_RpcAttachSharedMemory_result__isset {
+  _DataPageAccess_RpcAttachSharedMemory_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcAttachSharedMemory_result__isset;
+
+typedef struct _DataPageAccess_RpcPublishResidentPages_result__isset {
+  _DataPageAccess_RpcPublishResidentPages_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcPublishResidentPages_result__isset;
+
+class DataPageAccess_RpcDirectoryIsEmpty_result {
+ public:
+
+  DataPageAccess_RpcDirectoryIsEmpty_result(const DataPageAccess_RpcDirectoryIsEmpty_result&) noexcept;
+  DataPageAccess_RpcDirectoryIsEmpty_result& operator=(const DataPageAccess_RpcDirectoryIsEmpty_result&) noexcept;
   DataPageAccess_RpcDirectoryIsEmpty_result() noexcept
                                             : success(0) {
   }
@@ -4618,11 +5135,125 @@ class DataPageAccess_RpcDirectoryIsEmpty_result {
 
 };
 
+class DataPageAccess_RpcSyncFiles_result {
+ public:
+
+  DataPageAccess_RpcSyncFiles_result(const DataPageAccess_RpcSyncFiles_result&) noexcept;
+  DataPageAccess_RpcSyncFiles_result& operator=(const DataPageAccess_RpcSyncFiles_result&) noexcept;
+  DataPageAccess_RpcSyncFiles_result() noexcept
+                                            : success(0) {
+  }
+
+  virtual ~DataPageAccess_RpcSyncFiles_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_RpcSyncFiles_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcSyncFiles_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcSyncFiles_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcSyncFiles_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcAttachSharedMemory_result {
+ public:
+
+  DataPageAccess_RpcAttachSharedMemory_result(const DataPageAccess_RpcAttachSharedMemory_result&) noexcept;
+  DataPageAccess_RpcAttachSharedMemory_result& operator=(const DataPageAccess_RpcAttachSharedMemory_result&) noexcept;
+  DataPageAccess_RpcAttachSharedMemory_result() noexcept
+                                            : success(0) {
+  }
+
+  virtual ~DataPageAccess_RpcAttachSharedMemory_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_RpcAttachSharedMemory_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcAttachSharedMemory_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcAttachSharedMemory_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcAttachSharedMemory_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcPublishResidentPages_result {
+ public:
+
+  DataPageAccess_RpcPublishResidentPages_result(const DataPageAccess_RpcPublishResidentPages_result&) noexcept;
+  DataPageAccess_RpcPublishResidentPages_result& operator=(const DataPageAccess_RpcPublishResidentPages_result&) noexcept;
+  DataPageAccess_RpcPublishResidentPages_result() noexcept
+                                            : success(0) {
+  }
+
+  virtual ~DataPageAccess_RpcPublishResidentPages_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_RpcPublishResidentPages_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcPublishResidentPages_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcPublishResidentPages_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcPublishResidentPages_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
 typedef struct _DataPageAccess_RpcDirectoryIsEmpty_presult__isset {
   _DataPageAccess_RpcDirectoryIsEmpty_presult__isset() : success(false) {}
   bool success :1;
 } _DataPageAccess_RpcDirectoryIsEmpty_presult__isset;
 
+typedef struct _DataPageAccess_RpcSyncFiles_presult__isset {
+  _DataPageAccess_RpcSyncFiles_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcSyncFiles_presult__isset;
+
+typedef struct _DataPageAccess_RpcAttachSharedMemory_presult__isset {
+  _DataPageAccess_RpcAttachSharedMemory_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcAttachSharedMemory_presult__isset;
+
+typedef struct _DataPageAccess_RpcPublishResidentPages_presult__isset {
+  _DataPageAccess_RpcPublishResidentPages_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcPublishResidentPages_presult__isset;
+
 class DataPageAccess_RpcDirectoryIsEmpty_presult {
  public:
 
@@ -4636,6 +5267,45 @@ class DataPageAccess_RpcDirectoryIsEmpty_presult {
 
 };
 
+class DataPageAccess_RpcSyncFiles_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcSyncFiles_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_RpcSyncFiles_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+class DataPageAccess_RpcAttachSharedMemory_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcAttachSharedMemory_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_RpcAttachSharedMemory_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+class DataPageAccess_RpcPublishResidentPages_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcPublishResidentPages_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_RpcPublishResidentPages_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
 typedef struct _DataPageAccess_RpcCopyDir_args__isset {
   _DataPageAccess_RpcCopyDir_args__isset() : _src(false), _dst(false) {}
   bool _src :1;
@@ -4755,6 +5425,21 @@ typedef struct _DataPageAccess_RpcPgFsync_args__isset {
   bool _fd :1;
 } _DataPageAccess_RpcPgFsync_args__isset;
 
+typedef struct _DataPageAccess_RpcSetPageCompression_args__isset {
+  _DataPageAccess_RpcSetPageCompression_args__isset() : _method(false) {}
+  bool _method :1;
+} _DataPageAccess_RpcSetPageCompression_args__isset;
+
+typedef struct _DataPageAccess_RpcSetRequestClass_args__isset {
+  _DataPageAccess_RpcSetRequestClass_args__isset() : _requestClass(false) {}
+  bool _requestClass :1;
+} _DataPageAccess_RpcSetRequestClass_args__isset;
+
+typedef struct _DataPageAccess_RpcSetRequestDeadline_args__isset {
+  _DataPageAccess_RpcSetRequestDeadline_args__isset() : _queue_ms(false) {}
+  bool _queue_ms :1;
+} _DataPageAccess_RpcSetRequestDeadline_args__isset;
+
 class DataPageAccess_RpcPgFsync_args {
  public:
 
@@ -4788,75 +5473,375 @@ class DataPageAccess_RpcPgFsync_args {
 
 };
 
-
-class DataPageAccess_RpcPgFsync_pargs {
+class DataPageAccess_RpcSetPageCompression_args {
  public:
 
+  DataPageAccess_RpcSetPageCompression_args(const DataPageAccess_RpcSetPageCompression_args&) noexcept;
+  DataPageAccess_RpcSetPageCompression_args& operator=(const DataPageAccess_RpcSetPageCompression_args&) noexcept;
+  DataPageAccess_RpcSetPageCompression_args() noexcept
+                                 : _method(0) {
+  }
+
+  virtual ~DataPageAccess_RpcSetPageCompression_args() noexcept;
+  int32_t _method;
 
-  virtual ~DataPageAccess_RpcPgFsync_pargs() noexcept;
-  const int32_t* _fd;
+  _DataPageAccess_RpcSetPageCompression_args__isset __isset;
+
+  void __set__method(const int32_t val);
 
+  bool operator == (const DataPageAccess_RpcSetPageCompression_args & rhs) const
+  {
+    if (!(_method == rhs._method))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcSetPageCompression_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcSetPageCompression_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
   uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
 
 };
 
-typedef struct _DataPageAccess_RpcPgFsync_result__isset {
-  _DataPageAccess_RpcPgFsync_result__isset() : success(false) {}
-  bool success :1;
-} _DataPageAccess_RpcPgFsync_result__isset;
-
-class DataPageAccess_RpcPgFsync_result {
+class DataPageAccess_RpcSetRequestClass_args {
  public:
 
-  DataPageAccess_RpcPgFsync_result(const DataPageAccess_RpcPgFsync_result&) noexcept;
-  DataPageAccess_RpcPgFsync_result& operator=(const DataPageAccess_RpcPgFsync_result&) noexcept;
-  DataPageAccess_RpcPgFsync_result() noexcept
-                                   : success(0) {
+  DataPageAccess_RpcSetRequestClass_args(const DataPageAccess_RpcSetRequestClass_args&) noexcept;
+  DataPageAccess_RpcSetRequestClass_args& operator=(const DataPageAccess_RpcSetRequestClass_args&) noexcept;
+  DataPageAccess_RpcSetRequestClass_args() noexcept
+                                 : _requestClass(0) {
   }
 
-  virtual ~DataPageAccess_RpcPgFsync_result() noexcept;
-  int32_t success;
+  virtual ~DataPageAccess_RpcSetRequestClass_args() noexcept;
+  int32_t _requestClass;
 
-  _DataPageAccess_RpcPgFsync_result__isset __isset;
+  _DataPageAccess_RpcSetRequestClass_args__isset __isset;
 
-  void __set_success(const int32_t val);
+  void __set__requestClass(const int32_t val);
 
-  bool operator == (const DataPageAccess_RpcPgFsync_result & rhs) const
+  bool operator == (const DataPageAccess_RpcSetRequestClass_args & rhs) const
   {
-    if (!(success == rhs.success))
+    if (!(_requestClass == rhs._requestClass))
       return false;
     return true;
   }
-  bool operator != (const DataPageAccess_RpcPgFsync_result &rhs) const {
+  bool operator != (const DataPageAccess_RpcSetRequestClass_args &rhs) const {
     return !(*this == rhs);
   }
 
-  bool operator < (const DataPageAccess_RpcPgFsync_result & ) const;
+  bool operator < (const DataPageAccess_RpcSetRequestClass_args & ) const;
 
   uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
   uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
 
 };
 
-typedef struct _DataPageAccess_RpcPgFsync_presult__isset {
-  _DataPageAccess_RpcPgFsync_presult__isset() : success(false) {}
-  bool success :1;
-} _DataPageAccess_RpcPgFsync_presult__isset;
-
-class DataPageAccess_RpcPgFsync_presult {
+class DataPageAccess_RpcSetRequestDeadline_args {
  public:
 
+  DataPageAccess_RpcSetRequestDeadline_args(const DataPageAccess_RpcSetRequestDeadline_args&) noexcept;
+  DataPageAccess_RpcSetRequestDeadline_args& operator=(const DataPageAccess_RpcSetRequestDeadline_args&) noexcept;
+  DataPageAccess_RpcSetRequestDeadline_args() noexcept
+                                 : _queue_ms(0) {
+  }
 
-  virtual ~DataPageAccess_RpcPgFsync_presult() noexcept;
-  int32_t* success;
+  virtual ~DataPageAccess_RpcSetRequestDeadline_args() noexcept;
+  int32_t _queue_ms;
 
-  _DataPageAccess_RpcPgFsync_presult__isset __isset;
+  _DataPageAccess_RpcSetRequestDeadline_args__isset __isset;
+
+  void __set__queue_ms(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcSetRequestDeadline_args & rhs) const
+  {
+    if (!(_queue_ms == rhs._queue_ms))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcSetRequestDeadline_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcSetRequestDeadline_args & ) const;
 
   uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
 
 };
 
-typedef struct _DataPageAccess_RpcDurableUnlink_args__isset {
+
+class DataPageAccess_RpcPgFsync_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcPgFsync_pargs() noexcept;
+  const int32_t* _fd;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcSetPageCompression_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcSetPageCompression_pargs() noexcept;
+  const int32_t* _method;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcSetRequestClass_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcSetRequestClass_pargs() noexcept;
+  const int32_t* _requestClass;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcSetRequestDeadline_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcSetRequestDeadline_pargs() noexcept;
+  const int32_t* _queue_ms;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcPgFsync_result__isset {
+  _DataPageAccess_RpcPgFsync_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcPgFsync_result__isset;
+
+typedef struct _DataPageAccess_RpcSetPageCompression_result__isset {
+  _DataPageAccess_RpcSetPageCompression_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcSetPageCompression_result__isset;
+
+typedef struct _DataPageAccess_RpcSetRequestClass_result__isset {
+  _DataPageAccess_RpcSetRequestClass_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcSetRequestClass_result__isset;
+
+typedef struct _DataPageAccess_RpcSetRequestDeadline_result__isset {
+  _DataPageAccess_RpcSetRequestDeadline_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcSetRequestDeadline_result__isset;
+
+class DataPageAccess_RpcPgFsync_result {
+ public:
+
+  DataPageAccess_RpcPgFsync_result(const DataPageAccess_RpcPgFsync_result&) noexcept;
+  DataPageAccess_RpcPgFsync_result& operator=(const DataPageAccess_RpcPgFsync_result&) noexcept;
+  DataPageAccess_RpcPgFsync_result() noexcept
+                                   : success(0) {
+  }
+
+  virtual ~DataPageAccess_RpcPgFsync_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_RpcPgFsync_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcPgFsync_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcPgFsync_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcPgFsync_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcSetPageCompression_result {
+ public:
+
+  DataPageAccess_RpcSetPageCompression_result(const DataPageAccess_RpcSetPageCompression_result&) noexcept;
+  DataPageAccess_RpcSetPageCompression_result& operator=(const DataPageAccess_RpcSetPageCompression_result&) noexcept;
+  DataPageAccess_RpcSetPageCompression_result() noexcept
+                                   : success(0) {
+  }
+
+  virtual ~DataPageAccess_RpcSetPageCompression_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_RpcSetPageCompression_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcSetPageCompression_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcSetPageCompression_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcSetPageCompression_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcSetRequestClass_result {
+ public:
+
+  DataPageAccess_RpcSetRequestClass_result(const DataPageAccess_RpcSetRequestClass_result&) noexcept;
+  DataPageAccess_RpcSetRequestClass_result& operator=(const DataPageAccess_RpcSetRequestClass_result&) noexcept;
+  DataPageAccess_RpcSetRequestClass_result() noexcept
+                                   : success(0) {
+  }
+
+  virtual ~DataPageAccess_RpcSetRequestClass_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_RpcSetRequestClass_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcSetRequestClass_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcSetRequestClass_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcSetRequestClass_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcSetRequestDeadline_result {
+ public:
+
+  DataPageAccess_RpcSetRequestDeadline_result(const DataPageAccess_RpcSetRequestDeadline_result&) noexcept;
+  DataPageAccess_RpcSetRequestDeadline_result& operator=(const DataPageAccess_RpcSetRequestDeadline_result&) noexcept;
+  DataPageAccess_RpcSetRequestDeadline_result() noexcept
+                                   : success(0) {
+  }
+
+  virtual ~DataPageAccess_RpcSetRequestDeadline_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_RpcSetRequestDeadline_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcSetRequestDeadline_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcSetRequestDeadline_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcSetRequestDeadline_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcPgFsync_presult__isset {
+  _DataPageAccess_RpcPgFsync_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcPgFsync_presult__isset;
+
+typedef struct _DataPageAccess_RpcSetPageCompression_presult__isset {
+  _DataPageAccess_RpcSetPageCompression_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcSetPageCompression_presult__isset;
+
+typedef struct _DataPageAccess_RpcSetRequestClass_presult__isset {
+  _DataPageAccess_RpcSetRequestClass_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcSetRequestClass_presult__isset;
+
+typedef struct _DataPageAccess_RpcSetRequestDeadline_presult__isset {
+  _DataPageAccess_RpcSetRequestDeadline_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcSetRequestDeadline_presult__isset;
+
+class DataPageAccess_RpcPgFsync_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcPgFsync_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_RpcPgFsync_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+class DataPageAccess_RpcSetPageCompression_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcSetPageCompression_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_RpcSetPageCompression_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+class DataPageAccess_RpcSetRequestClass_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcSetRequestClass_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_RpcSetRequestClass_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+class DataPageAccess_RpcSetRequestDeadline_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcSetRequestDeadline_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_RpcSetRequestDeadline_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _DataPageAccess_RpcDurableUnlink_args__isset {
   _DataPageAccess_RpcDurableUnlink_args__isset() : _fname(false), _flag(false) {}
   bool _fname :1;
   bool _flag :1;
@@ -5129,49 +6114,1726 @@ class DataPageAccess_RpcXLogWrite_args {
   int32_t _idx;
   int64_t _lsn;
 
-  _DataPageAccess_RpcXLogWrite_args__isset __isset;
+  _DataPageAccess_RpcXLogWrite_args__isset __isset;
+
+  void __set__fd(const _File val);
+
+  void __set__page(const _Page& val);
+
+  void __set__amount(const int32_t val);
+
+  void __set__offset(const _Off_t val);
+
+  void __set__xlblocks(const std::vector<int64_t> & val);
+
+  void __set__blknum(const int32_t val);
+
+  void __set__idx(const int32_t val);
+
+  void __set__lsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_RpcXLogWrite_args & rhs) const
+  {
+    if (!(_fd == rhs._fd))
+      return false;
+    if (!(_page == rhs._page))
+      return false;
+    if (!(_amount == rhs._amount))
+      return false;
+    if (!(_offset == rhs._offset))
+      return false;
+    if (!(_xlblocks == rhs._xlblocks))
+      return false;
+    if (!(_blknum == rhs._blknum))
+      return false;
+    if (!(_idx == rhs._idx))
+      return false;
+    if (!(_lsn == rhs._lsn))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcXLogWrite_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcXLogWrite_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_RpcXLogWrite_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcXLogWrite_pargs() noexcept;
+  const _File* _fd;
+  const _Page* _page;
+  const int32_t* _amount;
+  const _Off_t* _offset;
+  const std::vector<int64_t> * _xlblocks;
+  const int32_t* _blknum;
+  const int32_t* _idx;
+  const int64_t* _lsn;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcXLogWrite_result__isset {
+  _DataPageAccess_RpcXLogWrite_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcXLogWrite_result__isset;
+
+class DataPageAccess_RpcXLogWrite_result {
+ public:
+
+  DataPageAccess_RpcXLogWrite_result(const DataPageAccess_RpcXLogWrite_result&) noexcept;
+  DataPageAccess_RpcXLogWrite_result& operator=(const DataPageAccess_RpcXLogWrite_result&) noexcept;
+  DataPageAccess_RpcXLogWrite_result() noexcept
+                                     : success(0) {
+  }
+
+  virtual ~DataPageAccess_RpcXLogWrite_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_RpcXLogWrite_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcXLogWrite_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcXLogWrite_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcXLogWrite_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcXLogWrite_presult__isset {
+  _DataPageAccess_RpcXLogWrite_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcXLogWrite_presult__isset;
+
+class DataPageAccess_RpcXLogWrite_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcXLogWrite_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_RpcXLogWrite_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _DataPageAccess_RpcXLogFileInit_args__isset {
+  _DataPageAccess_RpcXLogFileInit_args__isset() : _logsegno(false), _use_existent(false), _use_lock(false) {}
+  bool _logsegno :1;
+  bool _use_existent :1;
+  bool _use_lock :1;
+} _DataPageAccess_RpcXLogFileInit_args__isset;
+
+class DataPageAccess_RpcXLogFileInit_args {
+ public:
+
+  DataPageAccess_RpcXLogFileInit_args(const DataPageAccess_RpcXLogFileInit_args&) noexcept;
+  DataPageAccess_RpcXLogFileInit_args& operator=(const DataPageAccess_RpcXLogFileInit_args&) noexcept;
+  DataPageAccess_RpcXLogFileInit_args() noexcept
+                                      : _logsegno(0),
+                                        _use_existent(0),
+                                        _use_lock(0) {
+  }
+
+  virtual ~DataPageAccess_RpcXLogFileInit_args() noexcept;
+  int64_t _logsegno;
+  int32_t _use_existent;
+  int32_t _use_lock;
+
+  _DataPageAccess_RpcXLogFileInit_args__isset __isset;
+
+  void __set__logsegno(const int64_t val);
+
+  void __set__use_existent(const int32_t val);
+
+  void __set__use_lock(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcXLogFileInit_args & rhs) const
+  {
+    if (!(_logsegno == rhs._logsegno))
+      return false;
+    if (!(_use_existent == rhs._use_existent))
+      return false;
+    if (!(_use_lock == rhs._use_lock))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcXLogFileInit_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcXLogFileInit_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_RpcXLogFileInit_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcXLogFileInit_pargs() noexcept;
+  const int64_t* _logsegno;
+  const int32_t* _use_existent;
+  const int32_t* _use_lock;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcXLogFileInit_result__isset {
+  _DataPageAccess_RpcXLogFileInit_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcXLogFileInit_result__isset;
+
+class DataPageAccess_RpcXLogFileInit_result {
+ public:
+
+  DataPageAccess_RpcXLogFileInit_result(const DataPageAccess_RpcXLogFileInit_result&) noexcept;
+  DataPageAccess_RpcXLogFileInit_result& operator=(const DataPageAccess_RpcXLogFileInit_result&) noexcept;
+  DataPageAccess_RpcXLogFileInit_result() noexcept {
+  }
+
+  virtual ~DataPageAccess_RpcXLogFileInit_result() noexcept;
+  _XLog_Init_File_Resp success;
+
+  _DataPageAccess_RpcXLogFileInit_result__isset __isset;
+
+  void __set_success(const _XLog_Init_File_Resp& val);
+
+  bool operator == (const DataPageAccess_RpcXLogFileInit_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcXLogFileInit_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcXLogFileInit_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcXLogFileInit_presult__isset {
+  _DataPageAccess_RpcXLogFileInit_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcXLogFileInit_presult__isset;
+
+class DataPageAccess_RpcXLogFileInit_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcXLogFileInit_presult() noexcept;
+  _XLog_Init_File_Resp* success;
+
+  _DataPageAccess_RpcXLogFileInit_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _DataPageAccess_ReadBufferBatch_args__isset {
+  _DataPageAccess_ReadBufferBatch_args__isset() : _reln(false), _relpersistence(false), _forknum(false), _blknums(false), _readBufferMode(false), _lsn(false) {}
+  bool _reln :1;
+  bool _relpersistence :1;
+  bool _forknum :1;
+  bool _blknums :1;
+  bool _readBufferMode :1;
+  bool _lsn :1;
+} _DataPageAccess_ReadBufferBatch_args__isset;
+
+typedef struct _DataPageAccess_ReadRelationHeads_args__isset {
+  _DataPageAccess_ReadRelationHeads_args__isset() : _relns(false), _forknum(false), _max_blocks(false), _lsn(false) {}
+  bool _relns :1;
+  bool _forknum :1;
+  bool _max_blocks :1;
+  bool _lsn :1;
+} _DataPageAccess_ReadRelationHeads_args__isset;
+
+class DataPageAccess_ReadBufferBatch_args {
+ public:
+
+  DataPageAccess_ReadBufferBatch_args(const DataPageAccess_ReadBufferBatch_args&);
+  DataPageAccess_ReadBufferBatch_args& operator=(const DataPageAccess_ReadBufferBatch_args&);
+  DataPageAccess_ReadBufferBatch_args() noexcept
+                                      : _relpersistence(0),
+                                        _forknum(0),
+                                        _readBufferMode(0),
+                                        _lsn(0) {
+  }
+
+  virtual ~DataPageAccess_ReadBufferBatch_args() noexcept;
+  _Smgr_Relation _reln;
+  int32_t _relpersistence;
+  int32_t _forknum;
+  std::vector<int64_t>  _blknums;
+  int32_t _readBufferMode;
+  int64_t _lsn;
+
+  _DataPageAccess_ReadBufferBatch_args__isset __isset;
+
+  void __set__reln(const _Smgr_Relation& val);
+
+  void __set__relpersistence(const int32_t val);
+
+  void __set__forknum(const int32_t val);
+
+  void __set__blknums(const std::vector<int64_t> & val);
+
+  void __set__readBufferMode(const int32_t val);
+
+  void __set__lsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_ReadBufferBatch_args & rhs) const
+  {
+    if (!(_reln == rhs._reln))
+      return false;
+    if (!(_relpersistence == rhs._relpersistence))
+      return false;
+    if (!(_forknum == rhs._forknum))
+      return false;
+    if (!(_blknums == rhs._blknums))
+      return false;
+    if (!(_readBufferMode == rhs._readBufferMode))
+      return false;
+    if (!(_lsn == rhs._lsn))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_ReadBufferBatch_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_ReadBufferBatch_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_ReadRelationHeads_args {
+ public:
+
+  DataPageAccess_ReadRelationHeads_args(const DataPageAccess_ReadRelationHeads_args&);
+  DataPageAccess_ReadRelationHeads_args& operator=(const DataPageAccess_ReadRelationHeads_args&);
+  DataPageAccess_ReadRelationHeads_args() noexcept
+                                        : _forknum(0),
+                                          _max_blocks(0),
+                                          _lsn(0) {
+  }
+
+  virtual ~DataPageAccess_ReadRelationHeads_args() noexcept;
+  std::vector<_Smgr_Relation>  _relns;
+  int32_t _forknum;
+  int32_t _max_blocks;
+  int64_t _lsn;
+
+  _DataPageAccess_ReadRelationHeads_args__isset __isset;
+
+  void __set__relns(const std::vector<_Smgr_Relation> & val);
+
+  void __set__forknum(const int32_t val);
+
+  void __set__max_blocks(const int32_t val);
+
+  void __set__lsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_ReadRelationHeads_args & rhs) const
+  {
+    if (!(_relns == rhs._relns))
+      return false;
+    if (!(_forknum == rhs._forknum))
+      return false;
+    if (!(_max_blocks == rhs._max_blocks))
+      return false;
+    if (!(_lsn == rhs._lsn))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_ReadRelationHeads_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_ReadRelationHeads_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_ReadBufferBatch_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_ReadBufferBatch_pargs() noexcept;
+  const _Smgr_Relation* _reln;
+  const int32_t* _relpersistence;
+  const int32_t* _forknum;
+  const std::vector<int64_t> * _blknums;
+  const int32_t* _readBufferMode;
+  const int64_t* _lsn;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_ReadRelationHeads_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_ReadRelationHeads_pargs() noexcept;
+  const std::vector<_Smgr_Relation> * _relns;
+  const int32_t* _forknum;
+  const int32_t* _max_blocks;
+  const int64_t* _lsn;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_ReadBufferBatch_result__isset {
+  _DataPageAccess_ReadBufferBatch_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_ReadBufferBatch_result__isset;
+
+typedef struct _DataPageAccess_ReadRelationHeads_result__isset {
+  _DataPageAccess_ReadRelationHeads_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_ReadRelationHeads_result__isset;
+
+class DataPageAccess_ReadBufferBatch_result {
+ public:
+
+  DataPageAccess_ReadBufferBatch_result(const DataPageAccess_ReadBufferBatch_result&);
+  DataPageAccess_ReadBufferBatch_result& operator=(const DataPageAccess_ReadBufferBatch_result&);
+  DataPageAccess_ReadBufferBatch_result() noexcept {
+  }
+
+  virtual ~DataPageAccess_ReadBufferBatch_result() noexcept;
+  std::vector<_Page>  success;
+
+  _DataPageAccess_ReadBufferBatch_result__isset __isset;
+
+  void __set_success(const std::vector<_Page> & val);
+
+  bool operator == (const DataPageAccess_ReadBufferBatch_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_ReadBufferBatch_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_ReadBufferBatch_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_ReadRelationHeads_result {
+ public:
+
+  DataPageAccess_ReadRelationHeads_result(const DataPageAccess_ReadRelationHeads_result&);
+  DataPageAccess_ReadRelationHeads_result& operator=(const DataPageAccess_ReadRelationHeads_result&);
+  DataPageAccess_ReadRelationHeads_result() noexcept {
+  }
+
+  virtual ~DataPageAccess_ReadRelationHeads_result() noexcept;
+  std::vector<_Page>  success;
+
+  _DataPageAccess_ReadRelationHeads_result__isset __isset;
+
+  void __set_success(const std::vector<_Page> & val);
+
+  bool operator == (const DataPageAccess_ReadRelationHeads_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_ReadRelationHeads_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_ReadRelationHeads_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_ReadBufferBatch_presult__isset {
+  _DataPageAccess_ReadBufferBatch_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_ReadBufferBatch_presult__isset;
+
+typedef struct _DataPageAccess_ReadRelationHeads_presult__isset {
+  _DataPageAccess_ReadRelationHeads_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_ReadRelationHeads_presult__isset;
+
+class DataPageAccess_ReadBufferBatch_presult {
+ public:
+
+
+  virtual ~DataPageAccess_ReadBufferBatch_presult() noexcept;
+  std::vector<_Page> * success;
+
+  _DataPageAccess_ReadBufferBatch_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+class DataPageAccess_ReadRelationHeads_presult {
+ public:
+
+
+  virtual ~DataPageAccess_ReadRelationHeads_presult() noexcept;
+  std::vector<_Page> * success;
+
+  _DataPageAccess_ReadRelationHeads_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _DataPageAccess_ReadBufferIfModified_args__isset {
+  _DataPageAccess_ReadBufferIfModified_args__isset() : _reln(false), _relpersistence(false), _forknum(false), _blknum(false), _readBufferMode(false), _lsn(false), _cachedLsn(false) {}
+  bool _reln :1;
+  bool _relpersistence :1;
+  bool _forknum :1;
+  bool _blknum :1;
+  bool _readBufferMode :1;
+  bool _lsn :1;
+  bool _cachedLsn :1;
+} _DataPageAccess_ReadBufferIfModified_args__isset;
+
+class DataPageAccess_ReadBufferIfModified_args {
+ public:
+
+  DataPageAccess_ReadBufferIfModified_args(const DataPageAccess_ReadBufferIfModified_args&) noexcept;
+  DataPageAccess_ReadBufferIfModified_args& operator=(const DataPageAccess_ReadBufferIfModified_args&) noexcept;
+  DataPageAccess_ReadBufferIfModified_args() noexcept
+                                           : _relpersistence(0),
+                                             _forknum(0),
+                                             _blknum(0),
+                                             _readBufferMode(0),
+                                             _lsn(0),
+                                             _cachedLsn(0) {
+  }
+
+  virtual ~DataPageAccess_ReadBufferIfModified_args() noexcept;
+  _Smgr_Relation _reln;
+  int32_t _relpersistence;
+  int32_t _forknum;
+  int32_t _blknum;
+  int32_t _readBufferMode;
+  int64_t _lsn;
+  int64_t _cachedLsn;
+
+  _DataPageAccess_ReadBufferIfModified_args__isset __isset;
+
+  void __set__reln(const _Smgr_Relation& val);
+
+  void __set__relpersistence(const int32_t val);
+
+  void __set__forknum(const int32_t val);
+
+  void __set__blknum(const int32_t val);
+
+  void __set__readBufferMode(const int32_t val);
+
+  void __set__lsn(const int64_t val);
+
+  void __set__cachedLsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_ReadBufferIfModified_args & rhs) const
+  {
+    if (!(_reln == rhs._reln))
+      return false;
+    if (!(_relpersistence == rhs._relpersistence))
+      return false;
+    if (!(_forknum == rhs._forknum))
+      return false;
+    if (!(_blknum == rhs._blknum))
+      return false;
+    if (!(_readBufferMode == rhs._readBufferMode))
+      return false;
+    if (!(_lsn == rhs._lsn))
+      return false;
+    if (!(_cachedLsn == rhs._cachedLsn))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_ReadBufferIfModified_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_ReadBufferIfModified_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_ReadBufferIfModified_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_ReadBufferIfModified_pargs() noexcept;
+  const _Smgr_Relation* _reln;
+  const int32_t* _relpersistence;
+  const int32_t* _forknum;
+  const int32_t* _blknum;
+  const int32_t* _readBufferMode;
+  const int64_t* _lsn;
+  const int64_t* _cachedLsn;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_ReadBufferIfModified_result__isset {
+  _DataPageAccess_ReadBufferIfModified_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_ReadBufferIfModified_result__isset;
+
+class DataPageAccess_ReadBufferIfModified_result {
+ public:
+
+  DataPageAccess_ReadBufferIfModified_result(const DataPageAccess_ReadBufferIfModified_result&);
+  DataPageAccess_ReadBufferIfModified_result& operator=(const DataPageAccess_ReadBufferIfModified_result&);
+  DataPageAccess_ReadBufferIfModified_result() noexcept
+                                             : success() {
+  }
+
+  virtual ~DataPageAccess_ReadBufferIfModified_result() noexcept;
+  _Page success;
+
+  _DataPageAccess_ReadBufferIfModified_result__isset __isset;
+
+  void __set_success(const _Page& val);
+
+  bool operator == (const DataPageAccess_ReadBufferIfModified_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_ReadBufferIfModified_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_ReadBufferIfModified_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_ReadBufferIfModified_presult__isset {
+  _DataPageAccess_ReadBufferIfModified_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_ReadBufferIfModified_presult__isset;
+
+class DataPageAccess_ReadBufferIfModified_presult {
+ public:
+
+
+  virtual ~DataPageAccess_ReadBufferIfModified_presult() noexcept;
+  _Page* success;
+
+  _DataPageAccess_ReadBufferIfModified_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _DataPageAccess_PrefetchBuffers_args__isset {
+  _DataPageAccess_PrefetchBuffers_args__isset() : _reln(false), _forknum(false), _blknums(false), _lsn(false) {}
+  bool _reln :1;
+  bool _forknum :1;
+  bool _blknums :1;
+  bool _lsn :1;
+} _DataPageAccess_PrefetchBuffers_args__isset;
+
+class DataPageAccess_PrefetchBuffers_args {
+ public:
+
+  DataPageAccess_PrefetchBuffers_args(const DataPageAccess_PrefetchBuffers_args&);
+  DataPageAccess_PrefetchBuffers_args& operator=(const DataPageAccess_PrefetchBuffers_args&);
+  DataPageAccess_PrefetchBuffers_args() noexcept
+                                      : _forknum(0),
+                                        _lsn(0) {
+  }
+
+  virtual ~DataPageAccess_PrefetchBuffers_args() noexcept;
+  _Smgr_Relation _reln;
+  int32_t _forknum;
+  std::vector<int64_t>  _blknums;
+  int64_t _lsn;
+
+  _DataPageAccess_PrefetchBuffers_args__isset __isset;
+
+  void __set__reln(const _Smgr_Relation& val);
+
+  void __set__forknum(const int32_t val);
+
+  void __set__blknums(const std::vector<int64_t> & val);
+
+  void __set__lsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_PrefetchBuffers_args & rhs) const
+  {
+    if (!(_reln == rhs._reln))
+      return false;
+    if (!(_forknum == rhs._forknum))
+      return false;
+    if (!(_blknums == rhs._blknums))
+      return false;
+    if (!(_lsn == rhs._lsn))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_PrefetchBuffers_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_PrefetchBuffers_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_PrefetchBuffers_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_PrefetchBuffers_pargs() noexcept;
+  const _Smgr_Relation* _reln;
+  const int32_t* _forknum;
+  const std::vector<int64_t> * _blknums;
+  const int64_t* _lsn;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_PrefetchBuffers_result__isset {
+  _DataPageAccess_PrefetchBuffers_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_PrefetchBuffers_result__isset;
+
+class DataPageAccess_PrefetchBuffers_result {
+ public:
+
+  DataPageAccess_PrefetchBuffers_result(const DataPageAccess_PrefetchBuffers_result&) noexcept;
+  DataPageAccess_PrefetchBuffers_result& operator=(const DataPageAccess_PrefetchBuffers_result&) noexcept;
+  DataPageAccess_PrefetchBuffers_result() noexcept
+                                        : success(0) {
+  }
+
+  virtual ~DataPageAccess_PrefetchBuffers_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_PrefetchBuffers_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_PrefetchBuffers_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_PrefetchBuffers_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_PrefetchBuffers_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_PrefetchBuffers_presult__isset {
+  _DataPageAccess_PrefetchBuffers_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_PrefetchBuffers_presult__isset;
+
+class DataPageAccess_PrefetchBuffers_presult {
+ public:
+
+
+  virtual ~DataPageAccess_PrefetchBuffers_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_PrefetchBuffers_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _DataPageAccess_InstallPages_args__isset {
+  _DataPageAccess_InstallPages_args__isset() : _reln(false), _forknum(false), _blknums(false), _pages(false), _lsn(false) {}
+  bool _reln :1;
+  bool _forknum :1;
+  bool _blknums :1;
+  bool _pages :1;
+  bool _lsn :1;
+} _DataPageAccess_InstallPages_args__isset;
+
+class DataPageAccess_InstallPages_args {
+ public:
+
+  DataPageAccess_InstallPages_args(const DataPageAccess_InstallPages_args&);
+  DataPageAccess_InstallPages_args& operator=(const DataPageAccess_InstallPages_args&);
+  DataPageAccess_InstallPages_args() noexcept
+                                   : _forknum(0),
+                                     _pages(),
+                                     _lsn(0) {
+  }
+
+  virtual ~DataPageAccess_InstallPages_args() noexcept;
+  _Smgr_Relation _reln;
+  int32_t _forknum;
+  std::vector<int64_t>  _blknums;
+  _Page _pages;
+  int64_t _lsn;
+
+  _DataPageAccess_InstallPages_args__isset __isset;
+
+  void __set__reln(const _Smgr_Relation& val);
+
+  void __set__forknum(const int32_t val);
+
+  void __set__blknums(const std::vector<int64_t> & val);
+
+  void __set__pages(const _Page& val);
+
+  void __set__lsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_InstallPages_args & rhs) const
+  {
+    if (!(_reln == rhs._reln))
+      return false;
+    if (!(_forknum == rhs._forknum))
+      return false;
+    if (!(_blknums == rhs._blknums))
+      return false;
+    if (!(_pages == rhs._pages))
+      return false;
+    if (!(_lsn == rhs._lsn))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_InstallPages_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_InstallPages_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_InstallPages_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_InstallPages_pargs() noexcept;
+  const _Smgr_Relation* _reln;
+  const int32_t* _forknum;
+  const std::vector<int64_t> * _blknums;
+  const _Page* _pages;
+  const int64_t* _lsn;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_InstallPages_result__isset {
+  _DataPageAccess_InstallPages_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_InstallPages_result__isset;
+
+class DataPageAccess_InstallPages_result {
+ public:
+
+  DataPageAccess_InstallPages_result(const DataPageAccess_InstallPages_result&) noexcept;
+  DataPageAccess_InstallPages_result& operator=(const DataPageAccess_InstallPages_result&) noexcept;
+  DataPageAccess_InstallPages_result() noexcept
+                                     : success(0) {
+  }
+
+  virtual ~DataPageAccess_InstallPages_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_InstallPages_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_InstallPages_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_InstallPages_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_InstallPages_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_InstallPages_presult__isset {
+  _DataPageAccess_InstallPages_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_InstallPages_presult__isset;
+
+class DataPageAccess_InstallPages_presult {
+ public:
+
+
+  virtual ~DataPageAccess_InstallPages_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_InstallPages_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _DataPageAccess_InstallEvictedPages_args__isset {
+  _DataPageAccess_InstallEvictedPages_args__isset() : _reln(false), _forknum(false), _blknums(false), _pages(false), _lsn(false) {}
+  bool _reln :1;
+  bool _forknum :1;
+  bool _blknums :1;
+  bool _pages :1;
+  bool _lsn :1;
+} _DataPageAccess_InstallEvictedPages_args__isset;
+
+class DataPageAccess_InstallEvictedPages_args {
+ public:
+
+  DataPageAccess_InstallEvictedPages_args(const DataPageAccess_InstallEvictedPages_args&);
+  DataPageAccess_InstallEvictedPages_args& operator=(const DataPageAccess_InstallEvictedPages_args&);
+  DataPageAccess_InstallEvictedPages_args() noexcept
+                                   : _forknum(0),
+                                     _pages(),
+                                     _lsn(0) {
+  }
+
+  virtual ~DataPageAccess_InstallEvictedPages_args() noexcept;
+  _Smgr_Relation _reln;
+  int32_t _forknum;
+  std::vector<int64_t>  _blknums;
+  _Page _pages;
+  int64_t _lsn;
+
+  _DataPageAccess_InstallEvictedPages_args__isset __isset;
+
+  void __set__reln(const _Smgr_Relation& val);
+
+  void __set__forknum(const int32_t val);
+
+  void __set__blknums(const std::vector<int64_t> & val);
+
+  void __set__pages(const _Page& val);
+
+  void __set__lsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_InstallEvictedPages_args & rhs) const
+  {
+    if (!(_reln == rhs._reln))
+      return false;
+    if (!(_forknum == rhs._forknum))
+      return false;
+    if (!(_blknums == rhs._blknums))
+      return false;
+    if (!(_pages == rhs._pages))
+      return false;
+    if (!(_lsn == rhs._lsn))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_InstallEvictedPages_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_InstallEvictedPages_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_InstallEvictedPages_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_InstallEvictedPages_pargs() noexcept;
+  const _Smgr_Relation* _reln;
+  const int32_t* _forknum;
+  const std::vector<int64_t> * _blknums;
+  const _Page* _pages;
+  const int64_t* _lsn;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_InstallEvictedPages_result__isset {
+  _DataPageAccess_InstallEvictedPages_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_InstallEvictedPages_result__isset;
+
+class DataPageAccess_InstallEvictedPages_result {
+ public:
+
+  DataPageAccess_InstallEvictedPages_result(const DataPageAccess_InstallEvictedPages_result&) noexcept;
+  DataPageAccess_InstallEvictedPages_result& operator=(const DataPageAccess_InstallEvictedPages_result&) noexcept;
+  DataPageAccess_InstallEvictedPages_result() noexcept
+                                     : success(0) {
+  }
+
+  virtual ~DataPageAccess_InstallEvictedPages_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_InstallEvictedPages_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_InstallEvictedPages_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_InstallEvictedPages_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_InstallEvictedPages_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_InstallEvictedPages_presult__isset {
+  _DataPageAccess_InstallEvictedPages_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_InstallEvictedPages_presult__isset;
+
+class DataPageAccess_InstallEvictedPages_presult {
+ public:
+
+
+  virtual ~DataPageAccess_InstallEvictedPages_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_InstallEvictedPages_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+
+class DataPageAccess_RpcGetSmartReplayMetrics_args {
+ public:
+
+  DataPageAccess_RpcGetSmartReplayMetrics_args(const DataPageAccess_RpcGetSmartReplayMetrics_args&) noexcept;
+  DataPageAccess_RpcGetSmartReplayMetrics_args& operator=(const DataPageAccess_RpcGetSmartReplayMetrics_args&) noexcept;
+  DataPageAccess_RpcGetSmartReplayMetrics_args() noexcept {
+  }
+
+  virtual ~DataPageAccess_RpcGetSmartReplayMetrics_args() noexcept;
+
+  bool operator == (const DataPageAccess_RpcGetSmartReplayMetrics_args & /* rhs */) const
+  {
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcGetSmartReplayMetrics_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcGetSmartReplayMetrics_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_RpcGetSmartReplayMetrics_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcGetSmartReplayMetrics_pargs() noexcept;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcGetSmartReplayMetrics_result__isset {
+  _DataPageAccess_RpcGetSmartReplayMetrics_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcGetSmartReplayMetrics_result__isset;
+
+class DataPageAccess_RpcGetSmartReplayMetrics_result {
+ public:
+
+  DataPageAccess_RpcGetSmartReplayMetrics_result(const DataPageAccess_RpcGetSmartReplayMetrics_result&);
+  DataPageAccess_RpcGetSmartReplayMetrics_result& operator=(const DataPageAccess_RpcGetSmartReplayMetrics_result&);
+  DataPageAccess_RpcGetSmartReplayMetrics_result() noexcept
+                                                 : success() {
+  }
+
+  virtual ~DataPageAccess_RpcGetSmartReplayMetrics_result() noexcept;
+  std::string success;
+
+  _DataPageAccess_RpcGetSmartReplayMetrics_result__isset __isset;
+
+  void __set_success(const std::string& val);
+
+  bool operator == (const DataPageAccess_RpcGetSmartReplayMetrics_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcGetSmartReplayMetrics_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcGetSmartReplayMetrics_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcGetSmartReplayMetrics_presult__isset {
+  _DataPageAccess_RpcGetSmartReplayMetrics_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcGetSmartReplayMetrics_presult__isset;
+
+class DataPageAccess_RpcGetSmartReplayMetrics_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcGetSmartReplayMetrics_presult() noexcept;
+  std::string* success;
+
+  _DataPageAccess_RpcGetSmartReplayMetrics_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _DataPageAccess_RpcFetchPageChanges_args__isset {
+  _DataPageAccess_RpcFetchPageChanges_args__isset() : _max_entries(false), _wait_ms(false), _from_seq(false) {}
+  bool _max_entries :1;
+  bool _wait_ms :1;
+  bool _from_seq :1;
+} _DataPageAccess_RpcFetchPageChanges_args__isset;
+
+class DataPageAccess_RpcFetchPageChanges_args {
+ public:
+
+  DataPageAccess_RpcFetchPageChanges_args(const DataPageAccess_RpcFetchPageChanges_args&) noexcept;
+  DataPageAccess_RpcFetchPageChanges_args& operator=(const DataPageAccess_RpcFetchPageChanges_args&) noexcept;
+  DataPageAccess_RpcFetchPageChanges_args() noexcept
+                                          : _max_entries(0),
+                                            _wait_ms(0),
+                                            _from_seq(0) {
+  }
+
+  virtual ~DataPageAccess_RpcFetchPageChanges_args() noexcept;
+  int32_t _max_entries;
+  int32_t _wait_ms;
+  int64_t _from_seq;
+
+  _DataPageAccess_RpcFetchPageChanges_args__isset __isset;
+
+  void __set__max_entries(const int32_t val);
+
+  void __set__wait_ms(const int32_t val);
+
+  void __set__from_seq(const int64_t val);
+
+  bool operator == (const DataPageAccess_RpcFetchPageChanges_args & rhs) const
+  {
+    if (!(_max_entries == rhs._max_entries))
+      return false;
+    if (!(_wait_ms == rhs._wait_ms))
+      return false;
+    if (!(_from_seq == rhs._from_seq))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcFetchPageChanges_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcFetchPageChanges_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_RpcFetchPageChanges_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcFetchPageChanges_pargs() noexcept;
+  const int32_t* _max_entries;
+  const int32_t* _wait_ms;
+  const int64_t* _from_seq;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcFetchPageChanges_result__isset {
+  _DataPageAccess_RpcFetchPageChanges_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcFetchPageChanges_result__isset;
+
+class DataPageAccess_RpcFetchPageChanges_result {
+ public:
+
+  DataPageAccess_RpcFetchPageChanges_result(const DataPageAccess_RpcFetchPageChanges_result&);
+  DataPageAccess_RpcFetchPageChanges_result& operator=(const DataPageAccess_RpcFetchPageChanges_result&);
+  DataPageAccess_RpcFetchPageChanges_result() noexcept
+                                            : success() {
+  }
+
+  virtual ~DataPageAccess_RpcFetchPageChanges_result() noexcept;
+  _Page success;
+
+  _DataPageAccess_RpcFetchPageChanges_result__isset __isset;
+
+  void __set_success(const _Page& val);
+
+  bool operator == (const DataPageAccess_RpcFetchPageChanges_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcFetchPageChanges_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcFetchPageChanges_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcFetchPageChanges_presult__isset {
+  _DataPageAccess_RpcFetchPageChanges_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcFetchPageChanges_presult__isset;
+
+class DataPageAccess_RpcFetchPageChanges_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcFetchPageChanges_presult() noexcept;
+  _Page* success;
+
+  _DataPageAccess_RpcFetchPageChanges_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _DataPageAccess_RpcSecondaryNodeHeartbeat_args__isset {
+  _DataPageAccess_RpcSecondaryNodeHeartbeat_args__isset() : _node_id(false), _lsn(false) {}
+  bool _node_id :1;
+  bool _lsn :1;
+} _DataPageAccess_RpcSecondaryNodeHeartbeat_args__isset;
+
+typedef struct _DataPageAccess_RpcWaitWalParsed_args__isset {
+  _DataPageAccess_RpcWaitWalParsed_args__isset() : _wait_ms(false), _lsn(false) {}
+  bool _wait_ms :1;
+  bool _lsn :1;
+} _DataPageAccess_RpcWaitWalParsed_args__isset;
+
+class DataPageAccess_RpcSecondaryNodeHeartbeat_args {
+ public:
+
+  DataPageAccess_RpcSecondaryNodeHeartbeat_args(const DataPageAccess_RpcSecondaryNodeHeartbeat_args&) noexcept;
+  DataPageAccess_RpcSecondaryNodeHeartbeat_args& operator=(const DataPageAccess_RpcSecondaryNodeHeartbeat_args&) noexcept;
+  DataPageAccess_RpcSecondaryNodeHeartbeat_args() noexcept
+                                                : _node_id(0),
+                                                  _lsn(0) {
+  }
+
+  virtual ~DataPageAccess_RpcSecondaryNodeHeartbeat_args() noexcept;
+  int32_t _node_id;
+  int64_t _lsn;
+
+  _DataPageAccess_RpcSecondaryNodeHeartbeat_args__isset __isset;
+
+  void __set__node_id(const int32_t val);
+
+  void __set__lsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_RpcSecondaryNodeHeartbeat_args & rhs) const
+  {
+    if (!(_node_id == rhs._node_id))
+      return false;
+    if (!(_lsn == rhs._lsn))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcSecondaryNodeHeartbeat_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcSecondaryNodeHeartbeat_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcWaitWalParsed_args {
+ public:
+
+  DataPageAccess_RpcWaitWalParsed_args(const DataPageAccess_RpcWaitWalParsed_args&) noexcept;
+  DataPageAccess_RpcWaitWalParsed_args& operator=(const DataPageAccess_RpcWaitWalParsed_args&) noexcept;
+  DataPageAccess_RpcWaitWalParsed_args() noexcept
+                                                : _wait_ms(0),
+                                                  _lsn(0) {
+  }
+
+  virtual ~DataPageAccess_RpcWaitWalParsed_args() noexcept;
+  int32_t _wait_ms;
+  int64_t _lsn;
+
+  _DataPageAccess_RpcWaitWalParsed_args__isset __isset;
+
+  void __set__wait_ms(const int32_t val);
+
+  void __set__lsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_RpcWaitWalParsed_args & rhs) const
+  {
+    if (!(_wait_ms == rhs._wait_ms))
+      return false;
+    if (!(_lsn == rhs._lsn))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcWaitWalParsed_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcWaitWalParsed_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_RpcSecondaryNodeHeartbeat_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcSecondaryNodeHeartbeat_pargs() noexcept;
+  const int32_t* _node_id;
+  const int64_t* _lsn;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcWaitWalParsed_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_RpcWaitWalParsed_pargs() noexcept;
+  const int32_t* _wait_ms;
+  const int64_t* _lsn;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcSecondaryNodeHeartbeat_result__isset {
+  _DataPageAccess_RpcSecondaryNodeHeartbeat_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcSecondaryNodeHeartbeat_result__isset;
+
+typedef struct _DataPageAccess_RpcWaitWalParsed_result__isset {
+  _DataPageAccess_RpcWaitWalParsed_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcWaitWalParsed_result__isset;
+
+class DataPageAccess_RpcSecondaryNodeHeartbeat_result {
+ public:
+
+  DataPageAccess_RpcSecondaryNodeHeartbeat_result(const DataPageAccess_RpcSecondaryNodeHeartbeat_result&) noexcept;
+  DataPageAccess_RpcSecondaryNodeHeartbeat_result& operator=(const DataPageAccess_RpcSecondaryNodeHeartbeat_result&) noexcept;
+  DataPageAccess_RpcSecondaryNodeHeartbeat_result() noexcept
+                                                  : success(0) {
+  }
+
+  virtual ~DataPageAccess_RpcSecondaryNodeHeartbeat_result() noexcept;
+  int32_t success;
+
+  _DataPageAccess_RpcSecondaryNodeHeartbeat_result__isset __isset;
+
+  void __set_success(const int32_t val);
+
+  bool operator == (const DataPageAccess_RpcSecondaryNodeHeartbeat_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcSecondaryNodeHeartbeat_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcSecondaryNodeHeartbeat_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+class DataPageAccess_RpcWaitWalParsed_result {
+ public:
+
+  DataPageAccess_RpcWaitWalParsed_result(const DataPageAccess_RpcWaitWalParsed_result&) noexcept;
+  DataPageAccess_RpcWaitWalParsed_result& operator=(const DataPageAccess_RpcWaitWalParsed_result&) noexcept;
+  DataPageAccess_RpcWaitWalParsed_result() noexcept
+                                                  : success(0) {
+  }
+
+  virtual ~DataPageAccess_RpcWaitWalParsed_result() noexcept;
+  int64_t success;
+
+  _DataPageAccess_RpcWaitWalParsed_result__isset __isset;
+
+  void __set_success(const int64_t val);
+
+  bool operator == (const DataPageAccess_RpcWaitWalParsed_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_RpcWaitWalParsed_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_RpcWaitWalParsed_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_RpcSecondaryNodeHeartbeat_presult__isset {
+  _DataPageAccess_RpcSecondaryNodeHeartbeat_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcSecondaryNodeHeartbeat_presult__isset;
+
+typedef struct _DataPageAccess_RpcWaitWalParsed_presult__isset {
+  _DataPageAccess_RpcWaitWalParsed_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_RpcWaitWalParsed_presult__isset;
+
+class DataPageAccess_RpcSecondaryNodeHeartbeat_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcSecondaryNodeHeartbeat_presult() noexcept;
+  int32_t* success;
+
+  _DataPageAccess_RpcSecondaryNodeHeartbeat_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+class DataPageAccess_RpcWaitWalParsed_presult {
+ public:
+
+
+  virtual ~DataPageAccess_RpcWaitWalParsed_presult() noexcept;
+  int64_t* success;
+
+  _DataPageAccess_RpcWaitWalParsed_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _DataPageAccess_ScanRelation_args__isset {
+  _DataPageAccess_ScanRelation_args__isset() : _reln(false), _first_block(false), _end_block(false), _qual(false), _max_pages(false), _lsn(false) {}
+  bool _reln :1;
+  bool _first_block :1;
+  bool _end_block :1;
+  bool _qual :1;
+  bool _max_pages :1;
+  bool _lsn :1;
+} _DataPageAccess_ScanRelation_args__isset;
+
+class DataPageAccess_ScanRelation_args {
+ public:
+
+  DataPageAccess_ScanRelation_args(const DataPageAccess_ScanRelation_args&);
+  DataPageAccess_ScanRelation_args& operator=(const DataPageAccess_ScanRelation_args&);
+  DataPageAccess_ScanRelation_args() noexcept
+                                   : _first_block(0),
+                                     _end_block(0),
+                                     _qual(),
+                                     _max_pages(0),
+                                     _lsn(0) {
+  }
+
+  virtual ~DataPageAccess_ScanRelation_args() noexcept;
+  _Smgr_Relation _reln;
+  int32_t _first_block;
+  int32_t _end_block;
+  std::string _qual;
+  int32_t _max_pages;
+  int64_t _lsn;
+
+  _DataPageAccess_ScanRelation_args__isset __isset;
+
+  void __set__reln(const _Smgr_Relation& val);
+
+  void __set__first_block(const int32_t val);
+
+  void __set__end_block(const int32_t val);
+
+  void __set__qual(const std::string& val);
+
+  void __set__max_pages(const int32_t val);
+
+  void __set__lsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_ScanRelation_args & rhs) const
+  {
+    if (!(_reln == rhs._reln))
+      return false;
+    if (!(_first_block == rhs._first_block))
+      return false;
+    if (!(_end_block == rhs._end_block))
+      return false;
+    if (!(_qual == rhs._qual))
+      return false;
+    if (!(_max_pages == rhs._max_pages))
+      return false;
+    if (!(_lsn == rhs._lsn))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_ScanRelation_args &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_ScanRelation_args & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+
+class DataPageAccess_ScanRelation_pargs {
+ public:
+
+
+  virtual ~DataPageAccess_ScanRelation_pargs() noexcept;
+  const _Smgr_Relation* _reln;
+  const int32_t* _first_block;
+  const int32_t* _end_block;
+  const std::string* _qual;
+  const int32_t* _max_pages;
+  const int64_t* _lsn;
+
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_ScanRelation_result__isset {
+  _DataPageAccess_ScanRelation_result__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_ScanRelation_result__isset;
+
+class DataPageAccess_ScanRelation_result {
+ public:
+
+  DataPageAccess_ScanRelation_result(const DataPageAccess_ScanRelation_result&);
+  DataPageAccess_ScanRelation_result& operator=(const DataPageAccess_ScanRelation_result&);
+  DataPageAccess_ScanRelation_result() noexcept {
+  }
+
+  virtual ~DataPageAccess_ScanRelation_result() noexcept;
+  std::vector<_Page>  success;
+
+  _DataPageAccess_ScanRelation_result__isset __isset;
+
+  void __set_success(const std::vector<_Page> & val);
+
+  bool operator == (const DataPageAccess_ScanRelation_result & rhs) const
+  {
+    if (!(success == rhs.success))
+      return false;
+    return true;
+  }
+  bool operator != (const DataPageAccess_ScanRelation_result &rhs) const {
+    return !(*this == rhs);
+  }
+
+  bool operator < (const DataPageAccess_ScanRelation_result & ) const;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+  uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
+
+};
+
+typedef struct _DataPageAccess_ScanRelation_presult__isset {
+  _DataPageAccess_ScanRelation_presult__isset() : success(false) {}
+  bool success :1;
+} _DataPageAccess_ScanRelation_presult__isset;
+
+class DataPageAccess_ScanRelation_presult {
+ public:
+
+
+  virtual ~DataPageAccess_ScanRelation_presult() noexcept;
+  std::vector<_Page> * success;
+
+  _DataPageAccess_ScanRelation_presult__isset __isset;
+
+  uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
+
+};
+
+typedef struct _DataPageAccess_AggregateRelation_args__isset {
+  _DataPageAccess_AggregateRelation_args__isset() : _reln(false), _first_block(false), _end_block(false), _spec(false), _max_fallback(false), _lsn(false) {}
+  bool _reln :1;
+  bool _first_block :1;
+  bool _end_block :1;
+  bool _spec :1;
+  bool _max_fallback :1;
+  bool _lsn :1;
+} _DataPageAccess_AggregateRelation_args__isset;
 
-  void __set__fd(const _File val);
+class DataPageAccess_AggregateRelation_args {
+ public:
 
-  void __set__page(const _Page& val);
+  DataPageAccess_AggregateRelation_args(const DataPageAccess_AggregateRelation_args&);
+  DataPageAccess_AggregateRelation_args& operator=(const DataPageAccess_AggregateRelation_args&);
+  DataPageAccess_AggregateRelation_args() noexcept
+                                        : _first_block(0),
+                                          _end_block(0),
+                                          _spec(),
+                                          _max_fallback(0),
+                                          _lsn(0) {
+  }
 
-  void __set__amount(const int32_t val);
+  virtual ~DataPageAccess_AggregateRelation_args() noexcept;
+  _Smgr_Relation _reln;
+  int32_t _first_block;
+  int32_t _end_block;
+  std::string _spec;
+  int32_t _max_fallback;
+  int64_t _lsn;
 
-  void __set__offset(const _Off_t val);
+  _DataPageAccess_AggregateRelation_args__isset __isset;
 
-  void __set__xlblocks(const std::vector<int64_t> & val);
+  void __set__reln(const _Smgr_Relation& val);
 
-  void __set__blknum(const int32_t val);
+  void __set__first_block(const int32_t val);
 
-  void __set__idx(const int32_t val);
+  void __set__end_block(const int32_t val);
+
+  void __set__spec(const std::string& val);
+
+  void __set__max_fallback(const int32_t val);
 
   void __set__lsn(const int64_t val);
 
-  bool operator == (const DataPageAccess_RpcXLogWrite_args & rhs) const
+  bool operator == (const DataPageAccess_AggregateRelation_args & rhs) const
   {
-    if (!(_fd == rhs._fd))
-      return false;
-    if (!(_page == rhs._page))
-      return false;
-    if (!(_amount == rhs._amount))
+    if (!(_reln == rhs._reln))
       return false;
-    if (!(_offset == rhs._offset))
+    if (!(_first_block == rhs._first_block))
       return false;
-    if (!(_xlblocks == rhs._xlblocks))
+    if (!(_end_block == rhs._end_block))
       return false;
-    if (!(_blknum == rhs._blknum))
+    if (!(_spec == rhs._spec))
       return false;
-    if (!(_idx == rhs._idx))
+    if (!(_max_fallback == rhs._max_fallback))
       return false;
     if (!(_lsn == rhs._lsn))
       return false;
     return true;
   }
-  bool operator != (const DataPageAccess_RpcXLogWrite_args &rhs) const {
+  bool operator != (const DataPageAccess_AggregateRelation_args &rhs) const {
     return !(*this == rhs);
   }
 
-  bool operator < (const DataPageAccess_RpcXLogWrite_args & ) const;
+  bool operator < (const DataPageAccess_AggregateRelation_args & ) const;
 
   uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
   uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
@@ -5179,126 +7841,144 @@ class DataPageAccess_RpcXLogWrite_args {
 };
 
 
-class DataPageAccess_RpcXLogWrite_pargs {
+class DataPageAccess_AggregateRelation_pargs {
  public:
 
 
-  virtual ~DataPageAccess_RpcXLogWrite_pargs() noexcept;
-  const _File* _fd;
-  const _Page* _page;
-  const int32_t* _amount;
-  const _Off_t* _offset;
-  const std::vector<int64_t> * _xlblocks;
-  const int32_t* _blknum;
-  const int32_t* _idx;
+  virtual ~DataPageAccess_AggregateRelation_pargs() noexcept;
+  const _Smgr_Relation* _reln;
+  const int32_t* _first_block;
+  const int32_t* _end_block;
+  const std::string* _spec;
+  const int32_t* _max_fallback;
   const int64_t* _lsn;
 
   uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
 
 };
 
-typedef struct _DataPageAccess_RpcXLogWrite_result__isset {
-  _DataPageAccess_RpcXLogWrite_result__isset() : success(false) {}
+typedef struct _DataPageAccess_AggregateRelation_result__isset {
+  _DataPageAccess_AggregateRelation_result__isset() : success(false) {}
   bool success :1;
-} _DataPageAccess_RpcXLogWrite_result__isset;
+} _DataPageAccess_AggregateRelation_result__isset;
 
-class DataPageAccess_RpcXLogWrite_result {
+class DataPageAccess_AggregateRelation_result {
  public:
 
-  DataPageAccess_RpcXLogWrite_result(const DataPageAccess_RpcXLogWrite_result&) noexcept;
-  DataPageAccess_RpcXLogWrite_result& operator=(const DataPageAccess_RpcXLogWrite_result&) noexcept;
-  DataPageAccess_RpcXLogWrite_result() noexcept
-                                     : success(0) {
+  DataPageAccess_AggregateRelation_result(const DataPageAccess_AggregateRelation_result&);
+  DataPageAccess_AggregateRelation_result& operator=(const DataPageAccess_AggregateRelation_result&);
+  DataPageAccess_AggregateRelation_result() noexcept
+                                          : success() {
   }
 
-  virtual ~DataPageAccess_RpcXLogWrite_result() noexcept;
-  int32_t success;
+  virtual ~DataPageAccess_AggregateRelation_result() noexcept;
+  std::string success;
 
-  _DataPageAccess_RpcXLogWrite_result__isset __isset;
+  _DataPageAccess_AggregateRelation_result__isset __isset;
 
-  void __set_success(const int32_t val);
+  void __set_success(const std::string& val);
 
-  bool operator == (const DataPageAccess_RpcXLogWrite_result & rhs) const
+  bool operator == (const DataPageAccess_AggregateRelation_result & rhs) const
   {
     if (!(success == rhs.success))
       return false;
     return true;
   }
-  bool operator != (const DataPageAccess_RpcXLogWrite_result &rhs) const {
+  bool operator != (const DataPageAccess_AggregateRelation_result &rhs) const {
     return !(*this == rhs);
   }
 
-  bool operator < (const DataPageAccess_RpcXLogWrite_result & ) const;
+  bool operator < (const DataPageAccess_AggregateRelation_result & ) const;
 
   uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
   uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
 
 };
 
-typedef struct _DataPageAccess_RpcXLogWrite_presult__isset {
-  _DataPageAccess_RpcXLogWrite_presult__isset() : success(false) {}
+typedef struct _DataPageAccess_AggregateRelation_presult__isset {
+  _DataPageAccess_AggregateRelation_presult__isset() : success(false) {}
   bool success :1;
-} _DataPageAccess_RpcXLogWrite_presult__isset;
+} _DataPageAccess_AggregateRelation_presult__isset;
 
-class DataPageAccess_RpcXLogWrite_presult {
+class DataPageAccess_AggregateRelation_presult {
  public:
 
 
-  virtual ~DataPageAccess_RpcXLogWrite_presult() noexcept;
-  int32_t* success;
+  virtual ~DataPageAccess_AggregateRelation_presult() noexcept;
+  std::string* success;
 
-  _DataPageAccess_RpcXLogWrite_presult__isset __isset;
+  _DataPageAccess_AggregateRelation_presult__isset __isset;
 
   uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
 
 };
 
-typedef struct _DataPageAccess_RpcXLogFileInit_args__isset {
-  _DataPageAccess_RpcXLogFileInit_args__isset() : _logsegno(false), _use_existent(false), _use_lock(false) {}
-  bool _logsegno :1;
-  bool _use_existent :1;
-  bool _use_lock :1;
-} _DataPageAccess_RpcXLogFileInit_args__isset;
+typedef struct _DataPageAccess_TriageVacuum_args__isset {
+  _DataPageAccess_TriageVacuum_args__isset() : _reln(false), _first_block(false), _end_block(false), _horizon(false), _max_dead(false), _lsn(false) {}
+  bool _reln :1;
+  bool _first_block :1;
+  bool _end_block :1;
+  bool _horizon :1;
+  bool _max_dead :1;
+  bool _lsn :1;
+} _DataPageAccess_TriageVacuum_args__isset;
 
-class DataPageAccess_RpcXLogFileInit_args {
+class DataPageAccess_TriageVacuum_args {
  public:
 
-  DataPageAccess_RpcXLogFileInit_args(const DataPageAccess_RpcXLogFileInit_args&) noexcept;
-  DataPageAccess_RpcXLogFileInit_args& operator=(const DataPageAccess_RpcXLogFileInit_args&) noexcept;
-  DataPageAccess_RpcXLogFileInit_args() noexcept
-                                      : _logsegno(0),
-                                        _use_existent(0),
-                                        _use_lock(0) {
+  DataPageAccess_TriageVacuum_args(const DataPageAccess_TriageVacuum_args&);
+  DataPageAccess_TriageVacuum_args& operator=(const DataPageAccess_TriageVacuum_args&);
+  DataPageAccess_TriageVacuum_args() noexcept
+                                        : _first_block(0),
+                                          _end_block(0),
+                                          _horizon(),
+                                          _max_dead(0),
+                                          _lsn(0) {
   }
 
-  virtual ~DataPageAccess_RpcXLogFileInit_args() noexcept;
-  int64_t _logsegno;
-  int32_t _use_existent;
-  int32_t _use_lock;
+  virtual ~DataPageAccess_TriageVacuum_args() noexcept;
+  _Smgr_Relation _reln;
+  int32_t _first_block;
+  int32_t _end_block;
+  std::string _horizon;
+  int32_t _max_dead;
+  int64_t _lsn;
 
-  _DataPageAccess_RpcXLogFileInit_args__isset __isset;
+  _DataPageAccess_TriageVacuum_args__isset __isset;
 
-  void __set__logsegno(const int64_t val);
+  void __set__reln(const _Smgr_Relation& val);
 
-  void __set__use_existent(const int32_t val);
+  void __set__first_block(const int32_t val);
 
-  void __set__use_lock(const int32_t val);
+  void __set__end_block(const int32_t val);
 
-  bool operator == (const DataPageAccess_RpcXLogFileInit_args & rhs) const
+  void __set__horizon(const std::string& val);
+
+  void __set__max_dead(const int32_t val);
+
+  void __set__lsn(const int64_t val);
+
+  bool operator == (const DataPageAccess_TriageVacuum_args & rhs) const
   {
-    if (!(_logsegno == rhs._logsegno))
+    if (!(_reln == rhs._reln))
       return false;
-    if (!(_use_existent == rhs._use_existent))
+    if (!(_first_block == rhs._first_block))
       return false;
-    if (!(_use_lock == rhs._use_lock))
+    if (!(_end_block == rhs._end_block))
+      return false;
+    if (!(_horizon == rhs._horizon))
+      return false;
+    if (!(_max_dead == rhs._max_dead))
+      return false;
+    if (!(_lsn == rhs._lsn))
       return false;
     return true;
   }
-  bool operator != (const DataPageAccess_RpcXLogFileInit_args &rhs) const {
+  bool operator != (const DataPageAccess_TriageVacuum_args &rhs) const {
     return !(*this == rhs);
   }
 
-  bool operator < (const DataPageAccess_RpcXLogFileInit_args & ) const;
+  bool operator < (const DataPageAccess_TriageVacuum_args & ) const;
 
   uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
   uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
@@ -5306,69 +7986,73 @@ class DataPageAccess_RpcXLogFileInit_args {
 };
 
 
-class DataPageAccess_RpcXLogFileInit_pargs {
+class DataPageAccess_TriageVacuum_pargs {
  public:
 
 
-  virtual ~DataPageAccess_RpcXLogFileInit_pargs() noexcept;
-  const int64_t* _logsegno;
-  const int32_t* _use_existent;
-  const int32_t* _use_lock;
+  virtual ~DataPageAccess_TriageVacuum_pargs() noexcept;
+  const _Smgr_Relation* _reln;
+  const int32_t* _first_block;
+  const int32_t* _end_block;
+  const std::string* _horizon;
+  const int32_t* _max_dead;
+  const int64_t* _lsn;
 
   uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
 
 };
 
-typedef struct _DataPageAccess_RpcXLogFileInit_result__isset {
-  _DataPageAccess_RpcXLogFileInit_result__isset() : success(false) {}
+typedef struct _DataPageAccess_TriageVacuum_result__isset {
+  _DataPageAccess_TriageVacuum_result__isset() : success(false) {}
   bool success :1;
-} _DataPageAccess_RpcXLogFileInit_result__isset;
+} _DataPageAccess_TriageVacuum_result__isset;
 
-class DataPageAccess_RpcXLogFileInit_result {
+class DataPageAccess_TriageVacuum_result {
  public:
 
-  DataPageAccess_RpcXLogFileInit_result(const DataPageAccess_RpcXLogFileInit_result&) noexcept;
-  DataPageAccess_RpcXLogFileInit_result& operator=(const DataPageAccess_RpcXLogFileInit_result&) noexcept;
-  DataPageAccess_RpcXLogFileInit_result() noexcept {
+  DataPageAccess_TriageVacuum_result(const DataPageAccess_TriageVacuum_result&);
+  DataPageAccess_TriageVacuum_result& operator=(const DataPageAccess_TriageVacuum_result&);
+  DataPageAccess_TriageVacuum_result() noexcept
+                                          : success() {
   }
 
-  virtual ~DataPageAccess_RpcXLogFileInit_result() noexcept;
-  _XLog_Init_File_Resp success;
+  virtual ~DataPageAccess_TriageVacuum_result() noexcept;
+  std::string success;
 
-  _DataPageAccess_RpcXLogFileInit_result__isset __isset;
+  _DataPageAccess_TriageVacuum_result__isset __isset;
 
-  void __set_success(const _XLog_Init_File_Resp& val);
+  void __set_success(const std::string& val);
 
-  bool operator == (const DataPageAccess_RpcXLogFileInit_result & rhs) const
+  bool operator == (const DataPageAccess_TriageVacuum_result & rhs) const
   {
     if (!(success == rhs.success))
       return false;
     return true;
   }
-  bool operator != (const DataPageAccess_RpcXLogFileInit_result &rhs) const {
+  bool operator != (const DataPageAccess_TriageVacuum_result &rhs) const {
     return !(*this == rhs);
   }
 
-  bool operator < (const DataPageAccess_RpcXLogFileInit_result & ) const;
+  bool operator < (const DataPageAccess_TriageVacuum_result & ) const;
 
   uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
   uint32_t write(::apache::thrift::protocol::TProtocol* oprot) const;
 
 };
 
-typedef struct _DataPageAccess_RpcXLogFileInit_presult__isset {
-  _DataPageAccess_RpcXLogFileInit_presult__isset() : success(false) {}
+typedef struct _DataPageAccess_TriageVacuum_presult__isset {
+  _DataPageAccess_TriageVacuum_presult__isset() : success(false) {}
   bool success :1;
-} _DataPageAccess_RpcXLogFileInit_presult__isset;
+} _DataPageAccess_TriageVacuum_presult__isset;
 
-class DataPageAccess_RpcXLogFileInit_presult {
+class DataPageAccess_TriageVacuum_presult {
  public:
 
 
-  virtual ~DataPageAccess_RpcXLogFileInit_presult() noexcept;
-  _XLog_Init_File_Resp* success;
+  virtual ~DataPageAccess_TriageVacuum_presult() noexcept;
+  std::string* success;
 
-  _DataPageAccess_RpcXLogFileInit_presult__isset __isset;
+  _DataPageAccess_TriageVacuum_presult__isset __isset;
 
   uint32_t read(::apache::thrift::protocol::TProtocol* iprot);
 
@@ -5449,8 +8133,8 @@ class DataPageAccessClient : virtual public DataPageAccessIf {
    * @param _readBufferMode
    * @param _lsn
    */
-  void ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn) override;
-  void send_ReadBufferCommon(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn);
+  void ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId) override;
+  void send_ReadBufferCommon(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId);
   void recv_ReadBufferCommon(_Page& _return);
   int32_t RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn) override;
   void send_RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn);
@@ -5473,6 +8157,9 @@ class DataPageAccessClient : virtual public DataPageAccessIf {
   void RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn) override;
   void send_RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn);
   void recv_RpcMdExtend();
+  void RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn) override;
+  void send_RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn);
+  void recv_RpcMdExtendMany();
   void RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn) override;
   void send_RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn);
   void recv_RpcTruncate();
@@ -5515,6 +8202,9 @@ class DataPageAccessClient : virtual public DataPageAccessIf {
   void RpcInitFile(_Page& _return, const _Path& _path) override;
   void send_RpcInitFile(const _Path& _path);
   void recv_RpcInitFile(_Page& _return);
+  void RpcOpenAndReadFile(_Page& _return, const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient) override;
+  void send_RpcOpenAndReadFile(const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient);
+  void recv_RpcOpenAndReadFile(_Page& _return);
   _File RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags) override;
   void send_RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags);
   _File recv_RpcOpenTransientFile();
@@ -5563,12 +8253,30 @@ class DataPageAccessClient : virtual public DataPageAccessIf {
   int32_t RpcDirectoryIsEmpty(const _Path& _path) override;
   void send_RpcDirectoryIsEmpty(const _Path& _path);
   int32_t recv_RpcDirectoryIsEmpty();
+  int32_t RpcSyncFiles(const std::vector<_Path> & _paths) override;
+  void send_RpcSyncFiles(const std::vector<_Path> & _paths);
+  int32_t recv_RpcSyncFiles();
+  int32_t RpcAttachSharedMemory(const _Path& _name) override;
+  void send_RpcAttachSharedMemory(const _Path& _name);
+  int32_t recv_RpcAttachSharedMemory();
+  int32_t RpcPublishResidentPages(const _Page& _summary) override;
+  void send_RpcPublishResidentPages(const _Page& _summary);
+  int32_t recv_RpcPublishResidentPages();
   int32_t RpcCopyDir(const _Path& _src, const _Path& _dst) override;
   void send_RpcCopyDir(const _Path& _src, const _Path& _dst);
   int32_t recv_RpcCopyDir();
   int32_t RpcPgFsync(const int32_t _fd) override;
   void send_RpcPgFsync(const int32_t _fd);
   int32_t recv_RpcPgFsync();
+  int32_t RpcSetPageCompression(const int32_t _method) override;
+  void send_RpcSetPageCompression(const int32_t _method);
+  int32_t recv_RpcSetPageCompression();
+  int32_t RpcSetRequestClass(const int32_t _requestClass) override;
+  void send_RpcSetRequestClass(const int32_t _requestClass);
+  int32_t recv_RpcSetRequestClass();
+  int32_t RpcSetRequestDeadline(const int32_t _queue_ms) override;
+  void send_RpcSetRequestDeadline(const int32_t _queue_ms);
+  int32_t recv_RpcSetRequestDeadline();
   int32_t RpcDurableUnlink(const _Path& _fname, const int32_t _flag) override;
   void send_RpcDurableUnlink(const _Path& _fname, const int32_t _flag);
   int32_t recv_RpcDurableUnlink();
@@ -5581,6 +8289,45 @@ class DataPageAccessClient : virtual public DataPageAccessIf {
   void RpcXLogFileInit(_XLog_Init_File_Resp& _return, const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock) override;
   void send_RpcXLogFileInit(const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock);
   void recv_RpcXLogFileInit(_XLog_Init_File_Resp& _return);
+  void ReadBufferBatch(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode, const int64_t _lsn) override;
+  void send_ReadBufferBatch(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode, const int64_t _lsn);
+  void recv_ReadBufferBatch(std::vector<_Page> & _return);
+  void ReadRelationHeads(std::vector<_Page> & _return, const std::vector<_Smgr_Relation> & _relns, const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn) override;
+  void send_ReadRelationHeads(const std::vector<_Smgr_Relation> & _relns, const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn);
+  void recv_ReadRelationHeads(std::vector<_Page> & _return);
+  void ReadBufferIfModified(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _cachedLsn) override;
+  void send_ReadBufferIfModified(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _cachedLsn);
+  void recv_ReadBufferIfModified(_Page& _return);
+  int32_t PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int64_t _lsn) override;
+  void send_PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int64_t _lsn);
+  int32_t recv_PrefetchBuffers();
+  int32_t InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn) override;
+  void send_InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn);
+  int32_t recv_InstallPages();
+  int32_t InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn) override;
+  void send_InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn);
+  int32_t recv_InstallEvictedPages();
+  void RpcGetSmartReplayMetrics(std::string& _return) override;
+  void send_RpcGetSmartReplayMetrics();
+  void recv_RpcGetSmartReplayMetrics(std::string& _return);
+  void RpcFetchPageChanges(_Page& _return, const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq) override;
+  void send_RpcFetchPageChanges(const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq);
+  void recv_RpcFetchPageChanges(_Page& _return);
+  int32_t RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn) override;
+  void send_RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn);
+  int32_t recv_RpcSecondaryNodeHeartbeat();
+  int64_t RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn) override;
+  void send_RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn);
+  int64_t recv_RpcWaitWalParsed();
+  void ScanRelation(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _qual, const int32_t _max_pages, const int64_t _lsn) override;
+  void send_ScanRelation(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _qual, const int32_t _max_pages, const int64_t _lsn);
+  void recv_ScanRelation(std::vector<_Page> & _return);
+  void AggregateRelation(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback, const int64_t _lsn) override;
+  void send_AggregateRelation(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback, const int64_t _lsn);
+  void recv_AggregateRelation(std::string& _return);
+  void TriageVacuum(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead, const int64_t _lsn) override;
+  void send_TriageVacuum(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead, const int64_t _lsn);
+  void recv_TriageVacuum(std::string& _return);
   /**
    * This method has a oneway modifier. That means the client only makes
    * a request and does not listen for any response at all. Oneway methods
@@ -5611,6 +8358,7 @@ class DataPageAccessProcessor : public ::apache::thrift::TDispatchProcessor {
   void process_RpcMdExists(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcMdCreate(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcMdExtend(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcMdExtendMany(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcTruncate(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcFileClose(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcTablespaceCreateDbspace(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
@@ -5625,6 +8373,7 @@ class DataPageAccessProcessor : public ::apache::thrift::TDispatchProcessor {
   void process_RpcUnlink(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcFtruncate(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcInitFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcOpenAndReadFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcOpenTransientFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcOpenTransientFileUnderPgData(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcCloseTransientFile(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
@@ -5641,12 +8390,31 @@ class DataPageAccessProcessor : public ::apache::thrift::TDispatchProcessor {
   void process_RpcLseek(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcStat(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcDirectoryIsEmpty(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcSyncFiles(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcAttachSharedMemory(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcPublishResidentPages(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcCopyDir(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcPgFsync(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcSetPageCompression(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcSetRequestClass(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcSetRequestDeadline(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcDurableUnlink(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcDurableRenameExcl(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcXLogWrite(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_RpcXLogFileInit(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_ReadBufferBatch(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_ReadRelationHeads(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_ReadBufferIfModified(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_PrefetchBuffers(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_InstallPages(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_InstallEvictedPages(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcGetSmartReplayMetrics(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcFetchPageChanges(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcSecondaryNodeHeartbeat(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_RpcWaitWalParsed(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_ScanRelation(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_AggregateRelation(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
+  void process_TriageVacuum(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
   void process_zip(int32_t seqid, ::apache::thrift::protocol::TProtocol* iprot, ::apache::thrift::protocol::TProtocol* oprot, void* callContext);
  public:
   DataPageAccessProcessor(::std::shared_ptr<DataPageAccessIf> iface) :
@@ -5659,6 +8427,7 @@ class DataPageAccessProcessor : public ::apache::thrift::TDispatchProcessor {
     processMap_["RpcMdExists"] = &DataPageAccessProcessor::process_RpcMdExists;
     processMap_["RpcMdCreate"] = &DataPageAccessProcessor::process_RpcMdCreate;
     processMap_["RpcMdExtend"] = &DataPageAccessProcessor::process_RpcMdExtend;
+    processMap_["RpcMdExtendMany"] = &DataPageAccessProcessor::process_RpcMdExtendMany;
     processMap_["RpcTruncate"] = &DataPageAccessProcessor::process_RpcTruncate;
     processMap_["RpcFileClose"] = &DataPageAccessProcessor::process_RpcFileClose;
     processMap_["RpcTablespaceCreateDbspace"] = &DataPageAccessProcessor::process_RpcTablespaceCreateDbspace;
@@ -5673,6 +8442,7 @@ class DataPageAccessProcessor : public ::apache::thrift::TDispatchProcessor {
     processMap_["RpcUnlink"] = &DataPageAccessProcessor::process_RpcUnlink;
     processMap_["RpcFtruncate"] = &DataPageAccessProcessor::process_RpcFtruncate;
     processMap_["RpcInitFile"] = &DataPageAccessProcessor::process_RpcInitFile;
+    processMap_["RpcOpenAndReadFile"] = &DataPageAccessProcessor::process_RpcOpenAndReadFile;
     processMap_["RpcOpenTransientFile"] = &DataPageAccessProcessor::process_RpcOpenTransientFile;
     processMap_["RpcOpenTransientFileUnderPgData"] = &DataPageAccessProcessor::process_RpcOpenTransientFileUnderPgData;
     processMap_["RpcCloseTransientFile"] = &DataPageAccessProcessor::process_RpcCloseTransientFile;
@@ -5689,12 +8459,31 @@ class DataPageAccessProcessor : public ::apache::thrift::TDispatchProcessor {
     processMap_["RpcLseek"] = &DataPageAccessProcessor::process_RpcLseek;
     processMap_["RpcStat"] = &DataPageAccessProcessor::process_RpcStat;
     processMap_["RpcDirectoryIsEmpty"] = &DataPageAccessProcessor::process_RpcDirectoryIsEmpty;
+    processMap_["RpcSyncFiles"] = &DataPageAccessProcessor::process_RpcSyncFiles;
+    processMap_["RpcAttachSharedMemory"] = &DataPageAccessProcessor::process_RpcAttachSharedMemory;
+    processMap_["RpcPublishResidentPages"] = &DataPageAccessProcessor::process_RpcPublishResidentPages;
     processMap_["RpcCopyDir"] = &DataPageAccessProcessor::process_RpcCopyDir;
     processMap_["RpcPgFsync"] = &DataPageAccessProcessor::process_RpcPgFsync;
+    processMap_["RpcSetPageCompression"] = &DataPageAccessProcessor::process_RpcSetPageCompression;
+    processMap_["RpcSetRequestClass"] = &DataPageAccessProcessor::process_RpcSetRequestClass;
+    processMap_["RpcSetRequestDeadline"] = &DataPageAccessProcessor::process_RpcSetRequestDeadline;
     processMap_["RpcDurableUnlink"] = &DataPageAccessProcessor::process_RpcDurableUnlink;
     processMap_["RpcDurableRenameExcl"] = &DataPageAccessProcessor::process_RpcDurableRenameExcl;
     processMap_["RpcXLogWrite"] = &DataPageAccessProcessor::process_RpcXLogWrite;
     processMap_["RpcXLogFileInit"] = &DataPageAccessProcessor::process_RpcXLogFileInit;
+    processMap_["ReadBufferBatch"] = &DataPageAccessProcessor::process_ReadBufferBatch;
+    processMap_["ReadRelationHeads"] = &DataPageAccessProcessor::process_ReadRelationHeads;
+    processMap_["ReadBufferIfModified"] = &DataPageAccessProcessor::process_ReadBufferIfModified;
+    processMap_["PrefetchBuffers"] = &DataPageAccessProcessor::process_PrefetchBuffers;
+    processMap_["InstallPages"] = &DataPageAccessProcessor::process_InstallPages;
+    processMap_["InstallEvictedPages"] = &DataPageAccessProcessor::process_InstallEvictedPages;
+    processMap_["RpcGetSmartReplayMetrics"] = &DataPageAccessProcessor::process_RpcGetSmartReplayMetrics;
+    processMap_["RpcFetchPageChanges"] = &DataPageAccessProcessor::process_RpcFetchPageChanges;
+    processMap_["RpcSecondaryNodeHeartbeat"] = &DataPageAccessProcessor::process_RpcSecondaryNodeHeartbeat;
+    processMap_["RpcWaitWalParsed"] = &DataPageAccessProcessor::process_RpcWaitWalParsed;
+    processMap_["ScanRelation"] = &DataPageAccessProcessor::process_ScanRelation;
+    processMap_["AggregateRelation"] = &DataPageAccessProcessor::process_AggregateRelation;
+    processMap_["TriageVacuum"] = &DataPageAccessProcessor::process_TriageVacuum;
     processMap_["zip"] = &DataPageAccessProcessor::process_zip;
   }
 
@@ -5737,13 +8526,13 @@ class DataPageAccessMultiface : virtual public DataPageAccessIf {
    * @param _readBufferMode
    * @param _lsn
    */
-  void ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn) override {
+  void ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId) override {
     size_t sz = ifaces_.size();
     size_t i = 0;
     for (; i < (sz - 1); ++i) {
-      ifaces_[i]->ReadBufferCommon(_return, _reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn);
+      ifaces_[i]->ReadBufferCommon(_return, _reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn, _traceId);
     }
-    ifaces_[i]->ReadBufferCommon(_return, _reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn);
+    ifaces_[i]->ReadBufferCommon(_return, _reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn, _traceId);
     return;
   }
 
@@ -5810,6 +8599,14 @@ class DataPageAccessMultiface : virtual public DataPageAccessIf {
     }
     ifaces_[i]->RpcMdExtend(_reln, _forknum, _blknum, _buff, skipFsync, _lsn);
   }
+  void RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcMdExtendMany(_reln, _forknum, _startblk, _nblocks, skipFsync, _lsn);
+    }
+    ifaces_[i]->RpcMdExtendMany(_reln, _forknum, _startblk, _nblocks, skipFsync, _lsn);
+  }
 
   void RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn) override {
     size_t sz = ifaces_.size();
@@ -5939,6 +8736,15 @@ class DataPageAccessMultiface : virtual public DataPageAccessIf {
     ifaces_[i]->RpcInitFile(_return, _path);
     return;
   }
+  void RpcOpenAndReadFile(_Page& _return, const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcOpenAndReadFile(_return, _path, _flags, _amount, _transient);
+    }
+    ifaces_[i]->RpcOpenAndReadFile(_return, _path, _flags, _amount, _transient);
+    return;
+  }
 
   _File RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags) override {
     size_t sz = ifaces_.size();
@@ -6086,6 +8892,30 @@ class DataPageAccessMultiface : virtual public DataPageAccessIf {
     }
     return ifaces_[i]->RpcDirectoryIsEmpty(_path);
   }
+  int32_t RpcSyncFiles(const std::vector<_Path> & _paths) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcSyncFiles(_paths);
+    }
+    return ifaces_[i]->RpcSyncFiles(_paths);
+  }
+  int32_t RpcAttachSharedMemory(const _Path& _name) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcAttachSharedMemory(_name);
+    }
+    return ifaces_[i]->RpcAttachSharedMemory(_name);
+  }
+  int32_t RpcPublishResidentPages(const _Page& _summary) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcPublishResidentPages(_summary);
+    }
+    return ifaces_[i]->RpcPublishResidentPages(_summary);
+  }
 
   int32_t RpcCopyDir(const _Path& _src, const _Path& _dst) override {
     size_t sz = ifaces_.size();
@@ -6104,6 +8934,30 @@ class DataPageAccessMultiface : virtual public DataPageAccessIf {
     }
     return ifaces_[i]->RpcPgFsync(_fd);
   }
+  int32_t RpcSetPageCompression(const int32_t _method) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcSetPageCompression(_method);
+    }
+    return ifaces_[i]->RpcSetPageCompression(_method);
+  }
+  int32_t RpcSetRequestClass(const int32_t _requestClass) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcSetRequestClass(_requestClass);
+    }
+    return ifaces_[i]->RpcSetRequestClass(_requestClass);
+  }
+  int32_t RpcSetRequestDeadline(const int32_t _queue_ms) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcSetRequestDeadline(_queue_ms);
+    }
+    return ifaces_[i]->RpcSetRequestDeadline(_queue_ms);
+  }
 
   int32_t RpcDurableUnlink(const _Path& _fname, const int32_t _flag) override {
     size_t sz = ifaces_.size();
@@ -6142,6 +8996,129 @@ class DataPageAccessMultiface : virtual public DataPageAccessIf {
     return;
   }
 
+  void ReadBufferBatch(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode, const int64_t _lsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->ReadBufferBatch(_return, _reln, _relpersistence, _forknum, _blknums, _readBufferMode, _lsn);
+    }
+    ifaces_[i]->ReadBufferBatch(_return, _reln, _relpersistence, _forknum, _blknums, _readBufferMode, _lsn);
+    return;
+  }
+  void ReadRelationHeads(std::vector<_Page> & _return, const std::vector<_Smgr_Relation> & _relns, const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->ReadRelationHeads(_return, _relns, _forknum, _max_blocks, _lsn);
+    }
+    ifaces_[i]->ReadRelationHeads(_return, _relns, _forknum, _max_blocks, _lsn);
+    return;
+  }
+
+  void ReadBufferIfModified(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _cachedLsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->ReadBufferIfModified(_return, _reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn, _cachedLsn);
+    }
+    ifaces_[i]->ReadBufferIfModified(_return, _reln, _relpersistence, _forknum, _blknum, _readBufferMode, _lsn, _cachedLsn);
+    return;
+  }
+
+  int32_t PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int64_t _lsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->PrefetchBuffers(_reln, _forknum, _blknums, _lsn);
+    }
+    return ifaces_[i]->PrefetchBuffers(_reln, _forknum, _blknums, _lsn);
+  }
+
+  int32_t InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->InstallPages(_reln, _forknum, _blknums, _pages, _lsn);
+    }
+    return ifaces_[i]->InstallPages(_reln, _forknum, _blknums, _pages, _lsn);
+  }
+
+  int32_t InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->InstallEvictedPages(_reln, _forknum, _blknums, _pages, _lsn);
+    }
+    return ifaces_[i]->InstallEvictedPages(_reln, _forknum, _blknums, _pages, _lsn);
+  }
+
+  void RpcGetSmartReplayMetrics(std::string& _return) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcGetSmartReplayMetrics(_return);
+    }
+    ifaces_[i]->RpcGetSmartReplayMetrics(_return);
+    return;
+  }
+
+  void RpcFetchPageChanges(_Page& _return, const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcFetchPageChanges(_return, _max_entries, _wait_ms, _from_seq);
+    }
+    ifaces_[i]->RpcFetchPageChanges(_return, _max_entries, _wait_ms, _from_seq);
+    return;
+  }
+
+  int32_t RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcSecondaryNodeHeartbeat(_node_id, _lsn);
+    }
+    return ifaces_[i]->RpcSecondaryNodeHeartbeat(_node_id, _lsn);
+  }
+  int64_t RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->RpcWaitWalParsed(_wait_ms, _lsn);
+    }
+    return ifaces_[i]->RpcWaitWalParsed(_wait_ms, _lsn);
+  }
+
+  void ScanRelation(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _qual, const int32_t _max_pages, const int64_t _lsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->ScanRelation(_return, _reln, _first_block, _end_block, _qual, _max_pages, _lsn);
+    }
+    ifaces_[i]->ScanRelation(_return, _reln, _first_block, _end_block, _qual, _max_pages, _lsn);
+    return;
+  }
+
+  void AggregateRelation(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback, const int64_t _lsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->AggregateRelation(_return, _reln, _first_block, _end_block, _spec, _max_fallback, _lsn);
+    }
+    ifaces_[i]->AggregateRelation(_return, _reln, _first_block, _end_block, _spec, _max_fallback, _lsn);
+    return;
+  }
+
+  void TriageVacuum(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead, const int64_t _lsn) override {
+    size_t sz = ifaces_.size();
+    size_t i = 0;
+    for (; i < (sz - 1); ++i) {
+      ifaces_[i]->TriageVacuum(_return, _reln, _first_block, _end_block, _horizon, _max_dead, _lsn);
+    }
+    ifaces_[i]->TriageVacuum(_return, _reln, _first_block, _end_block, _horizon, _max_dead, _lsn);
+    return;
+  }
+
   /**
    * This method has a oneway modifier. That means the client only makes
    * a request and does not listen for any response at all. Oneway methods
@@ -6201,8 +9178,8 @@ class DataPageAccessConcurrentClient : virtual public DataPageAccessIf {
    * @param _readBufferMode
    * @param _lsn
    */
-  void ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn) override;
-  int32_t send_ReadBufferCommon(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn);
+  void ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId) override;
+  int32_t send_ReadBufferCommon(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId);
   void recv_ReadBufferCommon(_Page& _return, const int32_t seqid);
   int32_t RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn) override;
   int32_t send_RpcRegisterSecondaryNode(const bool _primary, const int64_t _lsn);
@@ -6225,6 +9202,9 @@ class DataPageAccessConcurrentClient : virtual public DataPageAccessIf {
   void RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn) override;
   int32_t send_RpcMdExtend(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const _Page& _buff, const int32_t skipFsync, const int64_t _lsn);
   void recv_RpcMdExtend(const int32_t seqid);
+  void RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn) override;
+  int32_t send_RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn);
+  void recv_RpcMdExtendMany(const int32_t seqid);
   void RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn) override;
   int32_t send_RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn);
   void recv_RpcTruncate(const int32_t seqid);
@@ -6267,6 +9247,9 @@ class DataPageAccessConcurrentClient : virtual public DataPageAccessIf {
   void RpcInitFile(_Page& _return, const _Path& _path) override;
   int32_t send_RpcInitFile(const _Path& _path);
   void recv_RpcInitFile(_Page& _return, const int32_t seqid);
+  void RpcOpenAndReadFile(_Page& _return, const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient) override;
+  int32_t send_RpcOpenAndReadFile(const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient);
+  void recv_RpcOpenAndReadFile(_Page& _return, const int32_t seqid);
   _File RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags) override;
   int32_t send_RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags);
   _File recv_RpcOpenTransientFile(const int32_t seqid);
@@ -6315,12 +9298,30 @@ class DataPageAccessConcurrentClient : virtual public DataPageAccessIf {
   int32_t RpcDirectoryIsEmpty(const _Path& _path) override;
   int32_t send_RpcDirectoryIsEmpty(const _Path& _path);
   int32_t recv_RpcDirectoryIsEmpty(const int32_t seqid);
+  int32_t RpcSyncFiles(const std::vector<_Path> & _paths) override;
+  int32_t send_RpcSyncFiles(const std::vector<_Path> & _paths);
+  int32_t recv_RpcSyncFiles(const int32_t seqid);
+  int32_t RpcAttachSharedMemory(const _Path& _name) override;
+  int32_t send_RpcAttachSharedMemory(const _Path& _name);
+  int32_t recv_RpcAttachSharedMemory(const int32_t seqid);
+  int32_t RpcPublishResidentPages(const _Page& _summary) override;
+  int32_t send_RpcPublishResidentPages(const _Page& _summary);
+  int32_t recv_RpcPublishResidentPages(const int32_t seqid);
   int32_t RpcCopyDir(const _Path& _src, const _Path& _dst) override;
   int32_t send_RpcCopyDir(const _Path& _src, const _Path& _dst);
   int32_t recv_RpcCopyDir(const int32_t seqid);
   int32_t RpcPgFsync(const int32_t _fd) override;
   int32_t send_RpcPgFsync(const int32_t _fd);
   int32_t recv_RpcPgFsync(const int32_t seqid);
+  int32_t RpcSetPageCompression(const int32_t _method) override;
+  int32_t send_RpcSetPageCompression(const int32_t _method);
+  int32_t recv_RpcSetPageCompression(const int32_t seqid);
+  int32_t RpcSetRequestClass(const int32_t _requestClass) override;
+  int32_t send_RpcSetRequestClass(const int32_t _requestClass);
+  int32_t recv_RpcSetRequestClass(const int32_t seqid);
+  int32_t RpcSetRequestDeadline(const int32_t _queue_ms) override;
+  int32_t send_RpcSetRequestDeadline(const int32_t _queue_ms);
+  int32_t recv_RpcSetRequestDeadline(const int32_t seqid);
   int32_t RpcDurableUnlink(const _Path& _fname, const int32_t _flag) override;
   int32_t send_RpcDurableUnlink(const _Path& _fname, const int32_t _flag);
   int32_t recv_RpcDurableUnlink(const int32_t seqid);
@@ -6333,6 +9334,45 @@ class DataPageAccessConcurrentClient : virtual public DataPageAccessIf {
   void RpcXLogFileInit(_XLog_Init_File_Resp& _return, const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock) override;
   int32_t send_RpcXLogFileInit(const int64_t _logsegno, const int32_t _use_existent, const int32_t _use_lock);
   void recv_RpcXLogFileInit(_XLog_Init_File_Resp& _return, const int32_t seqid);
+  void ReadBufferBatch(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode, const int64_t _lsn) override;
+  int32_t send_ReadBufferBatch(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode, const int64_t _lsn);
+  void recv_ReadBufferBatch(std::vector<_Page> & _return, const int32_t seqid);
+  void ReadRelationHeads(std::vector<_Page> & _return, const std::vector<_Smgr_Relation> & _relns, const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn) override;
+  int32_t send_ReadRelationHeads(const std::vector<_Smgr_Relation> & _relns, const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn);
+  void recv_ReadRelationHeads(std::vector<_Page> & _return, const int32_t seqid);
+  void ReadBufferIfModified(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _cachedLsn) override;
+  int32_t send_ReadBufferIfModified(const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _cachedLsn);
+  void recv_ReadBufferIfModified(_Page& _return, const int32_t seqid);
+  int32_t PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int64_t _lsn) override;
+  int32_t send_PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int64_t _lsn);
+  int32_t recv_PrefetchBuffers(const int32_t seqid);
+  int32_t InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn) override;
+  int32_t send_InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn);
+  int32_t recv_InstallPages(const int32_t seqid);
+  int32_t InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn) override;
+  int32_t send_InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn);
+  int32_t recv_InstallEvictedPages(const int32_t seqid);
+  void RpcGetSmartReplayMetrics(std::string& _return) override;
+  int32_t send_RpcGetSmartReplayMetrics();
+  void recv_RpcGetSmartReplayMetrics(std::string& _return, const int32_t seqid);
+  void RpcFetchPageChanges(_Page& _return, const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq) override;
+  int32_t send_RpcFetchPageChanges(const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq);
+  void recv_RpcFetchPageChanges(_Page& _return, const int32_t seqid);
+  int32_t RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn) override;
+  int32_t send_RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn);
+  int32_t recv_RpcSecondaryNodeHeartbeat(const int32_t seqid);
+  int64_t RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn) override;
+  int32_t send_RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn);
+  int64_t recv_RpcWaitWalParsed(const int32_t seqid);
+  void ScanRelation(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _qual, const int32_t _max_pages, const int64_t _lsn) override;
+  int32_t send_ScanRelation(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _qual, const int32_t _max_pages, const int64_t _lsn);
+  void recv_ScanRelation(std::vector<_Page> & _return, const int32_t seqid);
+  void AggregateRelation(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback, const int64_t _lsn) override;
+  int32_t send_AggregateRelation(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback, const int64_t _lsn);
+  void recv_AggregateRelation(std::string& _return, const int32_t seqid);
+  void TriageVacuum(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead, const int64_t _lsn) override;
+  int32_t send_TriageVacuum(const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead, const int64_t _lsn);
+  void recv_TriageVacuum(std::string& _return, const int32_t seqid);
   /**
    * This method has a oneway modifier. That means the client only makes
    * a request and does not listen for any response at all. Oneway methods
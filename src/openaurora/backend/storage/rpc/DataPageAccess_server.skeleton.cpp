@@ -33,7 +33,7 @@ class DataPageAccessHandler : virtual public DataPageAccessIf {
    * @param _readBufferMode
    * @param _lsn
    */
-  void ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn) {
+  void ReadBufferCommon(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId) {
     // Your implementation goes here
     printf("ReadBufferCommon\n");
   }
@@ -72,6 +72,10 @@ class DataPageAccessHandler : virtual public DataPageAccessIf {
     // Your implementation goes here
     printf("RpcMdExtend\n");
   }
+  void RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn) {
+    // Your implementation goes here
+    printf("RpcMdExtendMany\n");
+  }
 
   void RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn) {
     // Your implementation goes here
@@ -142,6 +146,10 @@ class DataPageAccessHandler : virtual public DataPageAccessIf {
     // Your implementation goes here
     printf("RpcInitFile\n");
   }
+  void RpcOpenAndReadFile(_Page& _return, const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient) {
+    // Your implementation goes here
+    printf("RpcOpenAndReadFile\n");
+  }
 
   _File RpcOpenTransientFile(const _Path& _filename, const int32_t _fileflags) {
     // Your implementation goes here
@@ -222,6 +230,18 @@ class DataPageAccessHandler : virtual public DataPageAccessIf {
     // Your implementation goes here
     printf("RpcDirectoryIsEmpty\n");
   }
+  int32_t RpcSyncFiles(const std::vector<_Path> & _paths) {
+    // Your implementation goes here
+    printf("RpcSyncFiles\n");
+  }
+  int32_t RpcAttachSharedMemory(const _Path& _name) {
+    // Your implementation goes here
+    printf("RpcAttachSharedMemory\n");
+  }
+  int32_t RpcPublishResidentPages(const _Page& _summary) {
+    // Your implementation goes here
+    printf("RpcPublishResidentPages\n");
+  }
 
   int32_t RpcCopyDir(const _Path& _src, const _Path& _dst) {
     // Your implementation goes here
@@ -232,6 +252,18 @@ class DataPageAccessHandler : virtual public DataPageAccessIf {
     // Your implementation goes here
     printf("RpcPgFsync\n");
   }
+  int32_t RpcSetPageCompression(const int32_t _method) {
+    // Your implementation goes here
+    printf("RpcSetPageCompression\n");
+  }
+  int32_t RpcSetRequestClass(const int32_t _requestClass) {
+    // Your implementation goes here
+    printf("RpcSetRequestClass\n");
+  }
+  int32_t RpcSetRequestDeadline(const int32_t _queue_ms) {
+    // Your implementation goes here
+    printf("RpcSetRequestDeadline\n");
+  }
 
   int32_t RpcDurableUnlink(const _Path& _fname, const int32_t _flag) {
     // Your implementation goes here
@@ -253,6 +285,69 @@ class DataPageAccessHandler : virtual public DataPageAccessIf {
     printf("RpcXLogFileInit\n");
   }
 
+  void ReadBufferBatch(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode, const int64_t _lsn) {
+    // Your implementation goes here
+    printf("ReadBufferBatch\n");
+  }
+  void ReadRelationHeads(std::vector<_Page> & _return, const std::vector<_Smgr_Relation> & _relns, const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn) {
+    // Your implementation goes here
+    printf("ReadRelationHeads\n");
+  }
+
+  void ReadBufferIfModified(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence, const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _cachedLsn) {
+    // Your implementation goes here
+    printf("ReadBufferIfModified\n");
+  }
+
+  int32_t PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const int64_t _lsn) {
+    // Your implementation goes here
+    printf("PrefetchBuffers\n");
+  }
+
+  int32_t InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn) {
+    // Your implementation goes here
+    printf("InstallPages\n");
+  }
+
+  int32_t InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn) {
+    // Your implementation goes here
+    printf("InstallEvictedPages\n");
+  }
+
+  void RpcGetSmartReplayMetrics(std::string& _return) {
+    // Your implementation goes here
+    printf("RpcGetSmartReplayMetrics\n");
+  }
+
+  void RpcFetchPageChanges(_Page& _return, const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq) {
+    // Your implementation goes here
+    printf("RpcFetchPageChanges\n");
+  }
+
+  int32_t RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn) {
+    // Your implementation goes here
+    printf("RpcSecondaryNodeHeartbeat\n");
+  }
+  int64_t RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn) {
+    // Your implementation goes here
+    printf("RpcWaitWalParsed\n");
+  }
+
+  void ScanRelation(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _qual, const int32_t _max_pages, const int64_t _lsn) {
+    // Your implementation goes here
+    printf("ScanRelation\n");
+  }
+
+  void AggregateRelation(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback, const int64_t _lsn) {
+    // Your implementation goes here
+    printf("AggregateRelation\n");
+  }
+
+  void TriageVacuum(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block, const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead, const int64_t _lsn) {
+    // Your implementation goes here
+    printf("TriageVacuum\n");
+  }
+
   /**
    * This method has a oneway modifier. That means the client only makes
    * a request and does not listen for any response at all. Oneway methods
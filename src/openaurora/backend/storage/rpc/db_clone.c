@@ -0,0 +1,406 @@
+//
+// Copy-on-write database clones, see storage/db_clone.h.
+//
+// The map is written by the startup process, which replays the records
+// that change it, and read by the page service threads. One rwlock covers
+// it all; forks are found through a chained hash by relation.
+//
+#include "postgres.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "common/hashfn.h"
+#include "common/relpath.h"
+#include "lib/stringinfo.h"
+#include "storage/copydir.h"
+#include "storage/db_clone.h"
+#include "storage/fd.h"
+#include "storage/rel_cache.h"
+#include "storage/reinit.h"
+#include "tcop/storage_server.h"
+
+#define DB_CLONE_REL_BUCKETS (4096)
+
+typedef struct DbClone {
+    Oid spcNode;
+    Oid dbNode;
+    Oid parentSpc;
+    Oid parentDb;
+    XLogRecPtr forkLsn;
+    // Dropped, but kept for the clones made of it
+    bool dropped;
+} DbClone;
+
+typedef struct DbCloneRel {
+    RelFileNode rnode;
+    ForkNumber forkNum;
+    BlockNumber parentBlocks;
+    struct DbCloneRel *next;
+} DbCloneRel;
+
+static DbClone *dbClones = NULL;
+static int dbCloneNum = 0;
+static int dbCloneCapacity = 0;
+static DbCloneRel *dbCloneRels[DB_CLONE_REL_BUCKETS];
+static pthread_rwlock_t dbCloneLock = PTHREAD_RWLOCK_INITIALIZER;
+static pthread_once_t dbCloneLoadOnce = PTHREAD_ONCE_INIT;
+// -1 until the environment is read
+static int dbCloneEnabled = -1;
+
+bool DbCloneEnabled(void) {
+    if (dbCloneEnabled < 0)
+        dbCloneEnabled = getenv("DATABASE_CLONE") != NULL;
+    return dbCloneEnabled;
+}
+
+static uint32 DbCloneRelHash(RelFileNode rnode, ForkNumber forkNum) {
+    uint32 key[4] = {rnode.spcNode, rnode.dbNode, rnode.relNode, (uint32) forkNum};
+
+    return hash_bytes((const unsigned char *) key, sizeof(key)) % DB_CLONE_REL_BUCKETS;
+}
+
+static DbCloneRel **DbCloneRelFindLocked(RelFileNode rnode, ForkNumber forkNum) {
+    DbCloneRel **link = &dbCloneRels[DbCloneRelHash(rnode, forkNum)];
+
+    for (; *link != NULL; link = &(*link)->next)
+        if (RelFileNodeEquals((*link)->rnode, rnode) && (*link)->forkNum == forkNum)
+            break;
+    return link;
+}
+
+// parentBlocks 0 forgets the fork
+static void DbCloneRelSetLocked(RelFileNode rnode, ForkNumber forkNum, BlockNumber parentBlocks) {
+    DbCloneRel **link = DbCloneRelFindLocked(rnode, forkNum);
+
+    if (*link != NULL && parentBlocks == 0) {
+        DbCloneRel *rel = *link;
+
+        *link = rel->next;
+        free(rel);
+    } else if (*link != NULL)
+        (*link)->parentBlocks = parentBlocks;
+    else if (parentBlocks > 0) {
+        DbCloneRel *rel = (DbCloneRel *) malloc(sizeof(DbCloneRel));
+
+        rel->rnode = rnode;
+        rel->forkNum = forkNum;
+        rel->parentBlocks = parentBlocks;
+        rel->next = NULL;
+        *link = rel;
+    }
+}
+
+static void DbCloneForgetDatabaseLocked(Oid spcNode, Oid dbNode) {
+    for (int i = 0; i < DB_CLONE_REL_BUCKETS; i++) {
+        DbCloneRel **link = &dbCloneRels[i];
+
+        while (*link != NULL) {
+            DbCloneRel *rel = *link;
+
+            if (rel->rnode.spcNode == spcNode && rel->rnode.dbNode == dbNode) {
+                *link = rel->next;
+                free(rel);
+            } else
+                link = &rel->next;
+        }
+    }
+}
+
+static DbClone *DbCloneFindLocked(Oid spcNode, Oid dbNode) {
+    for (int i = 0; i < dbCloneNum; i++)
+        if (dbClones[i].spcNode == spcNode && dbClones[i].dbNode == dbNode)
+            return &dbClones[i];
+    return NULL;
+}
+
+static void DbCloneAddLocked(Oid parentSpc, Oid parentDb, Oid spcNode, Oid dbNode, XLogRecPtr forkLsn) {
+    DbClone *clone = DbCloneFindLocked(spcNode, dbNode);
+
+    // A create replayed again starts over
+    DbCloneForgetDatabaseLocked(spcNode, dbNode);
+    if (clone == NULL) {
+        if (dbCloneNum == dbCloneCapacity) {
+            dbCloneCapacity = Max(dbCloneCapacity * 2, 8);
+            dbClones = (DbClone *) realloc(dbClones, sizeof(DbClone) * dbCloneCapacity);
+        }
+        clone = &dbClones[dbCloneNum++];
+    }
+    clone->spcNode = spcNode;
+    clone->dbNode = dbNode;
+    clone->parentSpc = parentSpc;
+    clone->parentDb = parentDb;
+    clone->forkLsn = forkLsn;
+    clone->dropped = false;
+}
+
+static bool DbCloneDropLocked(Oid spcNode, Oid dbNode) {
+    DbClone *clone = DbCloneFindLocked(spcNode, dbNode);
+
+    for (int i = 0; i < dbCloneNum; i++)
+        if (dbClones[i].parentSpc == spcNode && dbClones[i].parentDb == dbNode) {
+            if (clone != NULL)
+                clone->dropped = true;
+            return false;
+        }
+
+    if (clone != NULL) {
+        DbCloneForgetDatabaseLocked(spcNode, dbNode);
+        *clone = dbClones[--dbCloneNum];
+    }
+    return true;
+}
+
+static void DbCloneApplyLine(char *line) {
+    char *tokens[8];
+    char *save = NULL;
+    int ntokens = 0;
+    char *token;
+
+    for (token = strtok_r(line, " \t\r\n", &save); token != NULL && ntokens < 8;
+         token = strtok_r(NULL, " \t\r\n", &save))
+        tokens[ntokens++] = token;
+    if (ntokens == 0 || tokens[0][0] == '#')
+        return;
+
+    if (strcmp(tokens[0], "clone") == 0 && ntokens == 8 && strcmp(tokens[3], "from") == 0 &&
+        strcmp(tokens[6], "at") == 0) {
+        uint32 hi, lo;
+
+        if (sscanf(tokens[7], "%X/%X", &hi, &lo) == 2)
+            DbCloneAddLocked(atooid(tokens[4]), atooid(tokens[5]), atooid(tokens[1]), atooid(tokens[2]),
+                             ((XLogRecPtr) hi << 32) | lo);
+    } else if (strcmp(tokens[0], "rel") == 0 && ntokens == 6) {
+        RelFileNode rnode = {atooid(tokens[1]), atooid(tokens[2]), atooid(tokens[3])};
+
+        DbCloneRelSetLocked(rnode, (ForkNumber) atoi(tokens[4]), (BlockNumber) strtoul(tokens[5], NULL, 10));
+    } else if (strcmp(tokens[0], "drop") == 0 && ntokens == 3)
+        DbCloneDropLocked(atooid(tokens[1]), atooid(tokens[2]));
+}
+
+static void DbCloneLoad(void) {
+    FILE *file = fopen(DB_CLONE_FILE, "r");
+    char line[256];
+
+    if (file == NULL)
+        return;
+    pthread_rwlock_wrlock(&dbCloneLock);
+    while (fgets(line, sizeof(line), file) != NULL)
+        DbCloneApplyLine(line);
+    pthread_rwlock_unlock(&dbCloneLock);
+    fclose(file);
+}
+
+static void DbCloneEnsureLoaded(void) {
+    pthread_once(&dbCloneLoadOnce, DbCloneLoad);
+}
+
+// Adds the lines to the file, then to the map
+static void DbCloneAppend(StringInfo lines) {
+    int fd = OpenTransientFile(DB_CLONE_FILE, O_WRONLY | O_APPEND | O_CREAT | PG_BINARY);
+
+    if (fd < 0)
+        ereport(ERROR,
+                (errcode_for_file_access(),
+                 errmsg("could not open file \"%s\": %m", DB_CLONE_FILE)));
+    if (write(fd, lines->data, lines->len) != lines->len || pg_fsync(fd) != 0)
+        ereport(ERROR,
+                (errcode_for_file_access(),
+                 errmsg("could not write file \"%s\": %m", DB_CLONE_FILE)));
+    CloseTransientFile(fd);
+
+    pthread_rwlock_wrlock(&dbCloneLock);
+    for (char *save = NULL, *line = strtok_r(lines->data, "\n", &save); line != NULL;
+         line = strtok_r(NULL, "\n", &save))
+        DbCloneApplyLine(line);
+    pthread_rwlock_unlock(&dbCloneLock);
+}
+
+// Blocks of the template's fork as of now, the fork LSN when replaying it
+static BlockNumber DbCloneForkBlocks(RelFileNode rnode, ForkNumber forkNum) {
+    RelKey relKey = {rnode.spcNode, rnode.dbNode, rnode.relNode, (uint32_t) forkNum};
+    uint32_t cached;
+    int nblocks;
+
+    if (GetRelSizeCache(relKey, &cached))
+        return cached;
+    nblocks = SyncGetRelSize(rnode, forkNum, 0);
+    return nblocks > 0 ? (BlockNumber) nblocks : 0;
+}
+
+void DbCloneCreate(Oid srcSpc, Oid srcDb, Oid spcNode, Oid dbNode, XLogRecPtr forkLsn) {
+    char *srcPath = GetDatabasePath(srcDb, srcSpc);
+    char *dstPath = GetDatabasePath(dbNode, spcNode);
+    char fromFile[MAXPGPATH * 2];
+    char toFile[MAXPGPATH * 2];
+    StringInfoData lines;
+    DIR *dir;
+    struct dirent *de;
+
+    DbCloneEnsureLoaded();
+    if (MakePGDirectory(dstPath) != 0)
+        ereport(ERROR,
+                (errcode_for_file_access(),
+                 errmsg("could not create directory \"%s\": %m", dstPath)));
+
+    initStringInfo(&lines);
+    appendStringInfo(&lines, "clone %u %u from %u %u at %X/%X\n", spcNode, dbNode, srcSpc, srcDb,
+                     (uint32) (forkLsn >> 32), (uint32) forkLsn);
+
+    dir = AllocateDir(srcPath);
+    while ((de = ReadDir(dir, srcPath)) != NULL) {
+        struct stat st;
+        int oidchars;
+        ForkNumber forkNum;
+        RelFileNode parent;
+        BlockNumber nblocks;
+        int fd;
+
+        if (strcmp(de->d_name, ".") == 0 || strcmp(de->d_name, "..") == 0)
+            continue;
+        snprintf(fromFile, sizeof(fromFile), "%s/%s", srcPath, de->d_name);
+        snprintf(toFile, sizeof(toFile), "%s/%s", dstPath, de->d_name);
+        if (lstat(fromFile, &st) < 0)
+            ereport(ERROR,
+                    (errcode_for_file_access(),
+                     errmsg("could not stat file \"%s\": %m", fromFile)));
+        if (!S_ISREG(st.st_mode))
+            continue;
+
+        // The map file, PG_VERSION and such are copied
+        if (!parse_filename_for_nontemp_relation(de->d_name, &oidchars, &forkNum)) {
+            copy_file(fromFile, toFile);
+            continue;
+        }
+        // The first segment stands for the whole fork
+        if (strchr(de->d_name, '.') != NULL)
+            continue;
+
+        fd = OpenTransientFile(toFile, O_RDWR | O_CREAT | O_EXCL | PG_BINARY);
+        if (fd < 0)
+            ereport(ERROR,
+                    (errcode_for_file_access(),
+                     errmsg("could not create file \"%s\": %m", toFile)));
+        CloseTransientFile(fd);
+
+        parent.spcNode = srcSpc;
+        parent.dbNode = srcDb;
+        parent.relNode = atooid(de->d_name);
+        nblocks = DbCloneForkBlocks(parent, forkNum);
+        if (nblocks > 0)
+            appendStringInfo(&lines, "rel %u %u %u %d %u\n", spcNode, dbNode, parent.relNode, (int) forkNum,
+                             nblocks);
+    }
+    FreeDir(dir);
+    fsync_fname(dstPath, true);
+
+    DbCloneAppend(&lines);
+    pfree(lines.data);
+    pfree(srcPath);
+    pfree(dstPath);
+}
+
+bool DbCloneRouteBlock(RelFileNode rnode, ForkNumber forkNum, BlockNumber blkNum, DbCloneRoute *route) {
+    bool routed = false;
+
+    DbCloneEnsureLoaded();
+    if (__atomic_load_n(&dbCloneNum, __ATOMIC_RELAXED) == 0)
+        return false;
+
+    pthread_rwlock_rdlock(&dbCloneLock);
+    DbCloneRel *rel = *DbCloneRelFindLocked(rnode, forkNum);
+    if (rel != NULL && blkNum < rel->parentBlocks) {
+        DbClone *clone = DbCloneFindLocked(rnode.spcNode, rnode.dbNode);
+
+        if (clone != NULL) {
+            route->parent.spcNode = clone->parentSpc;
+            route->parent.dbNode = clone->parentDb;
+            route->parent.relNode = rnode.relNode;
+            route->forkLsn = clone->forkLsn;
+            routed = true;
+        }
+    }
+    pthread_rwlock_unlock(&dbCloneLock);
+    return routed;
+}
+
+BlockNumber DbCloneParentBlocks(RelFileNode rnode, ForkNumber forkNum) {
+    BlockNumber nblocks = 0;
+
+    DbCloneEnsureLoaded();
+    if (__atomic_load_n(&dbCloneNum, __ATOMIC_RELAXED) == 0)
+        return 0;
+
+    pthread_rwlock_rdlock(&dbCloneLock);
+    DbCloneRel *rel = *DbCloneRelFindLocked(rnode, forkNum);
+    if (rel != NULL)
+        nblocks = rel->parentBlocks;
+    pthread_rwlock_unlock(&dbCloneLock);
+    return nblocks;
+}
+
+void DbCloneTruncate(RelFileNode rnode, ForkNumber forkNum, BlockNumber nblocks) {
+    BlockNumber parentBlocks = DbCloneParentBlocks(rnode, forkNum);
+    StringInfoData lines;
+
+    if (nblocks >= parentBlocks)
+        return;
+    initStringInfo(&lines);
+    appendStringInfo(&lines, "rel %u %u %u %d %u\n", rnode.spcNode, rnode.dbNode, rnode.relNode, (int) forkNum,
+                     nblocks);
+    DbCloneAppend(&lines);
+    pfree(lines.data);
+}
+
+void DbCloneForget(RelFileNode rnode, ForkNumber forkNum) {
+    DbCloneTruncate(rnode, forkNum, 0);
+}
+
+bool DbCloneDrop(Oid spcNode, Oid dbNode) {
+    StringInfoData lines;
+    bool known = false;
+    bool removeFiles;
+
+    DbCloneEnsureLoaded();
+    pthread_rwlock_rdlock(&dbCloneLock);
+    for (int i = 0; i < dbCloneNum && !known; i++)
+        known = (dbClones[i].spcNode == spcNode && dbClones[i].dbNode == dbNode) ||
+                (dbClones[i].parentSpc == spcNode && dbClones[i].parentDb == dbNode);
+    pthread_rwlock_unlock(&dbCloneLock);
+    if (!known)
+        return true;
+
+    initStringInfo(&lines);
+    appendStringInfo(&lines, "drop %u %u\n", spcNode, dbNode);
+    // Decided under the lock DbCloneAppend applies the line with
+    pthread_rwlock_rdlock(&dbCloneLock);
+    removeFiles = true;
+    for (int i = 0; i < dbCloneNum; i++)
+        if (dbClones[i].parentSpc == spcNode && dbClones[i].parentDb == dbNode)
+            removeFiles = false;
+    pthread_rwlock_unlock(&dbCloneLock);
+    DbCloneAppend(&lines);
+    pfree(lines.data);
+    return removeFiles;
+}
+
+XLogRecPtr DbCloneOldestForkLsn(Oid spcNode, Oid dbNode) {
+    XLogRecPtr oldest = InvalidXLogRecPtr;
+
+    DbCloneEnsureLoaded();
+    if (__atomic_load_n(&dbCloneNum, __ATOMIC_RELAXED) == 0)
+        return InvalidXLogRecPtr;
+
+    pthread_rwlock_rdlock(&dbCloneLock);
+    for (int i = 0; i < dbCloneNum; i++) {
+        const DbClone *clone = &dbClones[i];
+
+        if (dbNode != InvalidOid && (clone->parentSpc != spcNode || clone->parentDb != dbNode))
+            continue;
+        if (oldest == InvalidXLogRecPtr || clone->forkLsn < oldest)
+            oldest = clone->forkLsn;
+    }
+    pthread_rwlock_unlock(&dbCloneLock);
+    return oldest;
+}
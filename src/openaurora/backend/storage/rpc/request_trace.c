@@ -0,0 +1,174 @@
+#include "postgres.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include "storage/request_trace.h"
+
+#define REQUEST_TRACE_BUFFER (512)
+// A stream's records reach the file at most this late, unless it goes idle
+#define REQUEST_TRACE_FLUSH_NS (1000 * 1000 * 1000)
+
+typedef struct RequestTraceBuffer {
+    uint32_t stream;
+    int n;
+    RequestTraceRecord records[REQUEST_TRACE_BUFFER];
+} RequestTraceBuffer;
+
+// -1 until the environment is read
+static int requestTraceEnabled = -1;
+static int requestTraceFd = -1;
+static uint64_t requestTraceStartNs = 0;
+static uint32_t requestTraceStreams = 0;
+static pthread_once_t requestTraceOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t requestTraceLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t requestTraceKey;
+
+static __thread RequestTraceBuffer *myRequestTrace = NULL;
+
+static uint64_t RequestTraceNow(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void RequestTraceFlush(RequestTraceBuffer *buffer) {
+    size_t len = sizeof(RequestTraceRecord) * buffer->n;
+
+    pthread_mutex_lock(&requestTraceLock);
+    if (write(requestTraceFd, buffer->records, len) != (ssize_t) len) {
+        printf("%s couldn't append %d records to the request trace, stopping: %s\n", __func__, buffer->n,
+               strerror(errno));
+        fflush(stdout);
+        __atomic_store_n(&requestTraceEnabled, 0, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&requestTraceLock);
+    buffer->n = 0;
+}
+
+// A server thread that exits leaves its records
+static void RequestTraceThreadExit(void *arg) {
+    RequestTraceBuffer *buffer = (RequestTraceBuffer *) arg;
+
+    if (buffer->n > 0 && __atomic_load_n(&requestTraceEnabled, __ATOMIC_RELAXED) > 0)
+        RequestTraceFlush(buffer);
+    free(buffer);
+}
+
+static void RequestTraceInit(void) {
+    char *path = getenv("STORAGE_REQUEST_TRACE");
+    RequestTraceHeader header;
+    struct timeval now;
+
+    if (path == NULL || path[0] == '\0') {
+        requestTraceEnabled = 0;
+        return;
+    }
+    requestTraceFd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | PG_BINARY, 0600);
+    if (requestTraceFd < 0) {
+        printf("%s couldn't open the request trace \"%s\": %s\n", __func__, path, strerror(errno));
+        fflush(stdout);
+        requestTraceEnabled = 0;
+        return;
+    }
+
+    memcpy(header.magic, REQUEST_TRACE_MAGIC, sizeof(header.magic));
+    gettimeofday(&now, NULL);
+    header.startUs = (uint64_t) now.tv_sec * 1000000 + now.tv_usec;
+    requestTraceStartNs = RequestTraceNow();
+    if (write(requestTraceFd, &header, sizeof(header)) != sizeof(header)) {
+        close(requestTraceFd);
+        requestTraceEnabled = 0;
+        return;
+    }
+    pthread_key_create(&requestTraceKey, RequestTraceThreadExit);
+    printf("%s capturing requests to \"%s\"\n", __func__, path);
+    fflush(stdout);
+    __atomic_store_n(&requestTraceEnabled, 1, __ATOMIC_RELEASE);
+}
+
+bool RequestTraceEnabled(void) {
+    int enabled = __atomic_load_n(&requestTraceEnabled, __ATOMIC_ACQUIRE);
+
+    if (enabled < 0) {
+        pthread_once(&requestTraceOnce, RequestTraceInit);
+        enabled = __atomic_load_n(&requestTraceEnabled, __ATOMIC_ACQUIRE);
+    }
+    return enabled > 0;
+}
+
+static RequestTraceRecord *RequestTraceNext(void) {
+    RequestTraceBuffer *buffer = myRequestTrace;
+
+    if (buffer == NULL) {
+        buffer = (RequestTraceBuffer *) calloc(1, sizeof(RequestTraceBuffer));
+        if (buffer == NULL)
+            return NULL;
+        buffer->stream = __atomic_fetch_add(&requestTraceStreams, 1, __ATOMIC_RELAXED);
+        pthread_setspecific(requestTraceKey, buffer);
+        myRequestTrace = buffer;
+    }
+    if (buffer->n == REQUEST_TRACE_BUFFER)
+        RequestTraceFlush(buffer);
+    return &buffer->records[buffer->n++];
+}
+
+// Appends the buffered records of a while ago, a quiet stream isn't held back
+static void RequestTraceDone(void) {
+    RequestTraceBuffer *buffer = myRequestTrace;
+
+    if (buffer != NULL && buffer->n > 0 &&
+        buffer->records[buffer->n - 1].offsetNs - buffer->records[0].offsetNs >= REQUEST_TRACE_FLUSH_NS)
+        RequestTraceFlush(buffer);
+}
+
+static void RequestTraceFill(RequestTraceRecord *record, RequestTraceType type, uint32_t spcNode, uint32_t dbNode,
+                             uint32_t relNode, int forkNum, uint32_t blkNum, uint64_t lsn, uint64_t cachedLsn,
+                             uint64_t offsetNs) {
+    record->offsetNs = offsetNs;
+    record->lsn = lsn;
+    record->cachedLsn = cachedLsn;
+    record->spcNode = spcNode;
+    record->dbNode = dbNode;
+    record->relNode = relNode;
+    record->blkNum = blkNum;
+    record->stream = myRequestTrace->stream;
+    record->count = 1;
+    record->type = (uint8_t) type;
+    record->forkNum = (uint8_t) forkNum;
+}
+
+void RequestTraceCapture(RequestTraceType type, uint32_t spcNode, uint32_t dbNode, uint32_t relNode,
+                         int forkNum, uint32_t blkNum, uint64_t lsn, uint64_t cachedLsn) {
+    RequestTraceRecord *record;
+
+    if (!RequestTraceEnabled() || (record = RequestTraceNext()) == NULL)
+        return;
+    RequestTraceFill(record, type, spcNode, dbNode, relNode, forkNum, blkNum, lsn, cachedLsn,
+                     RequestTraceNow() - requestTraceStartNs);
+    RequestTraceDone();
+}
+
+void RequestTraceCaptureList(RequestTraceType type, uint32_t spcNode, uint32_t dbNode, uint32_t relNode,
+                             int forkNum, const int64_t *blkNums, int n, uint64_t lsn) {
+    uint64_t offsetNs;
+
+    if (n <= 0 || !RequestTraceEnabled())
+        return;
+    n = Min(n, PG_UINT16_MAX);
+    offsetNs = RequestTraceNow() - requestTraceStartNs;
+    for (int i = 0; i < n; i++) {
+        RequestTraceRecord *record = RequestTraceNext();
+
+        if (record == NULL)
+            return;
+        RequestTraceFill(record, i == 0 ? type : REQUEST_TRACE_CONTINUED, spcNode, dbNode, relNode, forkNum,
+                         (uint32_t) blkNums[i], lsn, 0, offsetNs);
+        if (i == 0)
+            record->count = (uint16_t) n;
+    }
+    RequestTraceDone();
+}
@@ -0,0 +1,124 @@
+//
+// Aggregates computed on the storage node, the partial aggregation both
+// sides agree on.
+//
+// See storage/rpc_agg.h. The transitions are those of int8inc, int8inc_any,
+// int2_sum, int4_sum and the larger and smaller functions of the integer
+// and oid types, their states all fit an int64.
+//
+#include "postgres.h"
+
+#include "access/htup_details.h"
+#include "storage/bufpage.h"
+#include "storage/rpc_agg.h"
+
+void
+RpcAggInit(const RpcAggSpec *spec, RpcAggState *states) {
+    int i;
+
+    for (i = 0; i < spec->naggs && i < RPC_AGG_MAX_AGGS; i++) {
+        states[i].value = 0;
+        // count starts at 0, the others have no state before the first row
+        states[i].isnull = spec->aggs[i].func != RPC_AGG_COUNT_STAR && spec->aggs[i].func != RPC_AGG_COUNT;
+        states[i].pad = 0;
+    }
+}
+
+void
+RpcAggAdvance(const RpcAggTarget *agg, RpcAggState *state, int64_t value, bool isnull) {
+    if (agg->func == RPC_AGG_COUNT_STAR) {
+        state->value++;
+        return;
+    }
+    if (isnull)
+        return;
+
+    switch (agg->func) {
+        case RPC_AGG_COUNT:
+            state->value++;
+            return;
+        case RPC_AGG_SUM:
+            state->value = state->isnull ? value : state->value + value;
+            break;
+        case RPC_AGG_MIN:
+            if (state->isnull || value < state->value)
+                state->value = value;
+            break;
+        case RPC_AGG_MAX:
+            if (state->isnull || value > state->value)
+                state->value = value;
+            break;
+        default:
+            return;
+    }
+    state->isnull = 0;
+}
+
+void
+RpcAggCombine(const RpcAggSpec *spec, RpcAggState *states, const RpcAggState *other) {
+    int i;
+
+    for (i = 0; i < spec->naggs && i < RPC_AGG_MAX_AGGS; i++) {
+        const RpcAggTarget *agg = &spec->aggs[i];
+
+        if (agg->func == RPC_AGG_COUNT_STAR || agg->func == RPC_AGG_COUNT)
+            states[i].value += other[i].value;
+        else if (!other[i].isnull)
+            RpcAggAdvance(agg, &states[i], other[i].value, false);
+    }
+}
+
+bool
+RpcAggPage(const RpcAggSpec *spec, const char *page, RpcAggState *states) {
+    Page p = (Page) page;
+    RpcAggState local[RPC_AGG_MAX_AGGS];
+    OffsetNumber maxoff;
+    OffsetNumber off;
+    int i;
+
+    if (spec->naggs < 1 || spec->naggs > RPC_AGG_MAX_AGGS)
+        return false;
+    if (PageIsNew(p))
+        return true;
+    if (PageGetPageSize(p) != BLCKSZ || ((PageHeader) p)->pd_lower > BLCKSZ || !PageIsAllVisible(p))
+        return false;
+
+    RpcAggInit(spec, local);
+    maxoff = PageGetMaxOffsetNumber(p);
+    for (off = FirstOffsetNumber; off <= maxoff; off = OffsetNumberNext(off)) {
+        ItemId lp = PageGetItemId(p, off);
+        HeapTupleHeader tup;
+        uint32 len;
+        int64_t value;
+        bool isnull;
+
+        if (!ItemIdIsNormal(lp))
+            continue;
+        if (ItemIdGetOffset(lp) + ItemIdGetLength(lp) > BLCKSZ)
+            return false;
+        tup = (HeapTupleHeader) PageGetItem(p, lp);
+        len = ItemIdGetLength(lp);
+
+        if (spec->qual.attnum > 0) {
+            if (!RpcScanTupleAttr(spec->qual.atts, spec->qual.attnum, spec->qual.kind, tup, len, &value, &isnull))
+                return false;
+            if (isnull || !RpcScanCompare(&spec->qual, value))
+                continue;
+        }
+
+        for (i = 0; i < spec->naggs; i++) {
+            const RpcAggTarget *agg = &spec->aggs[i];
+
+            value = 0;
+            isnull = false;
+            if (agg->func != RPC_AGG_COUNT_STAR &&
+                !RpcScanTupleAttr(spec->qual.atts, agg->attnum, agg->kind, tup, len,
+                                  agg->func == RPC_AGG_COUNT ? NULL : &value, &isnull))
+                return false;
+            RpcAggAdvance(agg, &local[i], value, isnull);
+        }
+    }
+
+    RpcAggCombine(spec, states, local);
+    return true;
+}
@@ -0,0 +1,340 @@
+//
+// Hand-specialized codec of the hot page service calls
+//
+#ifndef SRC_RPC_FASTCODEC_H
+#define SRC_RPC_FASTCODEC_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <thrift/TApplicationException.h>
+#include <thrift/protocol/TProtocol.h>
+#include <thrift/protocol/TProtocolException.h>
+#include <thrift/transport/TTransport.h>
+
+#include "DataPageAccess.h"
+#include "port/pg_bswap.h"
+#include "rpc_wire.h"
+
+//! ReadBufferCommon, RpcMdRead and RpcMdNblocks take and return the same
+//! fields on every call. In the binary protocol their messages are the same
+//! bytes each time but for the values, which sit at fixed offsets, so the
+//! layouts below are spelled out as templates: a call is encoded with
+//! stores into one buffer written to the transport at once, and its
+//! arguments are decoded from the bytes the transport already holds. The
+//! generated code makes a virtual protocol call per field instead.
+//!
+//! The bytes are the ones the generated code writes, either end may use
+//! either codec. The compact and header protocols, and RPC_FAST_CODEC=off
+//! on an end, keep the generated code there. A message of another shape,
+//! from another writer, is left to the generated processor, which reads
+//! what it knows and skips the rest.
+
+namespace rpcfast {
+
+using apache::thrift::protocol::TProtocol;
+using apache::thrift::transport::TTransport;
+
+// TBinaryProtocol's strict message header
+constexpr uint32_t kVersion1 = 0x80010000U;
+constexpr size_t kFieldHeaderSize = 3;
+
+class Writer {
+public:
+    explicit Writer(uint8_t *at) : at_(at) {}
+
+    void I8(int8_t v) { *at_++ = (uint8_t) v; }
+    void I16(int16_t v) { uint16_t be = pg_hton16((uint16_t) v); Put(&be, sizeof(be)); }
+    void I32(int32_t v) { uint32_t be = pg_hton32((uint32_t) v); Put(&be, sizeof(be)); }
+    void I64(int64_t v) { uint64_t be = pg_hton64((uint64_t) v); Put(&be, sizeof(be)); }
+    void Put(const void *bytes, size_t len) { memcpy(at_, bytes, len); at_ += len; }
+    void FieldBegin(int8_t type, int16_t id) { I8(type); I16(id); }
+    void Stop() { I8(apache::thrift::protocol::T_STOP); }
+
+private:
+    uint8_t *at_;
+};
+
+class Reader {
+public:
+    explicit Reader(const uint8_t *at) : at_(at) {}
+
+    int8_t I8() { return (int8_t) *at_++; }
+    int16_t I16() { uint16_t be; Get(&be, sizeof(be)); return (int16_t) pg_ntoh16(be); }
+    int32_t I32() { uint32_t be; Get(&be, sizeof(be)); return (int32_t) pg_ntoh32(be); }
+    int64_t I64() { uint64_t be; Get(&be, sizeof(be)); return (int64_t) pg_ntoh64(be); }
+    void Get(void *bytes, size_t len) { memcpy(bytes, at_, len); at_ += len; }
+    bool FieldBegin(int8_t type, int16_t id) { int8_t t = I8(); return t == type && I16() == id; }
+    bool Stop() { return I8() == apache::thrift::protocol::T_STOP; }
+
+private:
+    const uint8_t *at_;
+};
+
+template <typename T> struct Scalar;
+
+template <> struct Scalar<int32_t> {
+    static constexpr int8_t kType = apache::thrift::protocol::T_I32;
+    static constexpr size_t kSize = 4;
+    static void Encode(Writer &w, int32_t v) { w.I32(v); }
+    static void Decode(Reader &r, int32_t &v) { v = r.I32(); }
+};
+
+template <> struct Scalar<int64_t> {
+    static constexpr int8_t kType = apache::thrift::protocol::T_I64;
+    static constexpr size_t kSize = 8;
+    static void Encode(Writer &w, int64_t v) { w.I64(v); }
+    static void Decode(Reader &r, int64_t &v) { v = r.I64(); }
+};
+
+// An integer field
+template <int16_t Id, typename T> struct Field {
+    typedef T Value;
+    static constexpr size_t kSize = kFieldHeaderSize + Scalar<T>::kSize;
+
+    static void Encode(Writer &w, T v) {
+        w.FieldBegin(Scalar<T>::kType, Id);
+        Scalar<T>::Encode(w, v);
+    }
+    static bool Decode(Reader &r, T &v) {
+        if(!r.FieldBegin(Scalar<T>::kType, Id))
+            return false;
+        Scalar<T>::Decode(r, v);
+        return true;
+    }
+};
+
+// A _Smgr_Relation field, the struct's fields in the order they are written
+template <int16_t Id> struct RelationField {
+    typedef tutorial::_Smgr_Relation Value;
+    typedef Field<1, int64_t> Spc;
+    typedef Field<2, int64_t> Db;
+    typedef Field<3, int64_t> Rel;
+    typedef Field<4, int32_t> Backend;
+    static constexpr size_t kSize = kFieldHeaderSize + Spc::kSize + Db::kSize + Rel::kSize + Backend::kSize + 1;
+
+    static void Encode(Writer &w, const Value &reln) {
+        w.FieldBegin(apache::thrift::protocol::T_STRUCT, Id);
+        Spc::Encode(w, reln._spc_node);
+        Db::Encode(w, reln._db_node);
+        Rel::Encode(w, reln._rel_node);
+        Backend::Encode(w, reln._backend_id);
+        w.Stop();
+    }
+    static bool Decode(Reader &r, Value &reln) {
+        if(!r.FieldBegin(apache::thrift::protocol::T_STRUCT, Id) || !Spc::Decode(r, reln._spc_node) ||
+           !Db::Decode(r, reln._db_node) || !Rel::Decode(r, reln._rel_node) ||
+           !Backend::Decode(r, reln._backend_id) || !r.Stop())
+            return false;
+        reln.__isset._spc_node = reln.__isset._db_node = reln.__isset._rel_node = reln.__isset._backend_id = true;
+        return true;
+    }
+};
+
+// The arguments struct of a call
+template <typename... Fields> struct ArgsLayout {
+    typedef std::tuple<typename Fields::Value...> Values;
+    static constexpr size_t kSize = (Fields::kSize + ... + 0) + 1;
+
+    template <typename... Args> static void Encode(Writer &w, const Args &...args) {
+        (Fields::Encode(w, args), ...);
+        w.Stop();
+    }
+    static bool Decode(Reader &r, Values &values) {
+        return DecodeAt(r, values, std::index_sequence_for<Fields...>());
+    }
+
+private:
+    template <size_t... I> static bool DecodeAt(Reader &r, Values &values, std::index_sequence<I...>) {
+        return (Fields::Decode(r, std::get<I>(values)) && ...) && r.Stop();
+    }
+};
+
+struct ReadBufferCommonCall {
+    static constexpr char kName[] = "ReadBufferCommon";
+    typedef ArgsLayout<RelationField<1>, Field<2, int32_t>, Field<3, int32_t>, Field<4, int32_t>,
+                       Field<5, int32_t>, Field<6, int64_t>, Field<7, int64_t>> Args;
+    typedef std::string Result;
+};
+
+struct RpcMdReadCall {
+    static constexpr char kName[] = "RpcMdRead";
+    typedef ArgsLayout<RelationField<1>, Field<2, int32_t>, Field<3, int64_t>, Field<4, int64_t>> Args;
+    typedef std::string Result;
+};
+
+struct RpcMdNblocksCall {
+    static constexpr char kName[] = "RpcMdNblocks";
+    typedef ArgsLayout<RelationField<1>, Field<2, int32_t>, Field<3, int64_t>> Args;
+    typedef int32_t Result;
+};
+
+template <typename Call> constexpr size_t MessageHeaderSize() {
+    return 4 + 4 + (sizeof(Call::kName) - 1) + 4;
+}
+
+template <typename Call> inline void MessageBegin(Writer &w, apache::thrift::protocol::TMessageType type,
+                                                  int32_t seqid) {
+    w.I32((int32_t) (kVersion1 | (uint32_t) type));
+    w.I32((int32_t) (sizeof(Call::kName) - 1));
+    w.Put(Call::kName, sizeof(Call::kName) - 1);
+    w.I32(seqid);
+}
+
+// The type of the message, or -1 if it isn't the call's
+template <typename Call> inline int MessageType(Reader &r) {
+    uint32_t version = (uint32_t) r.I32();
+    char name[sizeof(Call::kName) - 1];
+
+    if((version & 0xFFFF0000U) != kVersion1 || r.I32() != (int32_t) sizeof(name))
+        return -1;
+    r.Get(name, sizeof(name));
+    r.I32();
+    return memcmp(name, Call::kName, sizeof(name)) == 0 ? (int) (version & 0xFF) : -1;
+}
+
+template <typename Call> inline void WriteReply(TProtocol *oprot, int32_t seqid,
+                                                const typename Call::Result &result) {
+    TTransport *transport = oprot->getTransport().get();
+
+    if constexpr (std::is_same<typename Call::Result, std::string>::value) {
+        // The page is written from where it is, between the header and the stop
+        uint8_t header[MessageHeaderSize<Call>() + kFieldHeaderSize + 4];
+        uint8_t stop = apache::thrift::protocol::T_STOP;
+        Writer w(header);
+
+        MessageBegin<Call>(w, apache::thrift::protocol::T_REPLY, seqid);
+        w.FieldBegin(apache::thrift::protocol::T_STRING, 0);
+        w.I32((int32_t) result.size());
+        transport->write(header, sizeof(header));
+        transport->write((const uint8_t *) result.data(), (uint32_t) result.size());
+        transport->write(&stop, 1);
+    } else {
+        uint8_t reply[MessageHeaderSize<Call>() + Field<0, typename Call::Result>::kSize + 1];
+        Writer w(reply);
+
+        MessageBegin<Call>(w, apache::thrift::protocol::T_REPLY, seqid);
+        Field<0, typename Call::Result>::Encode(w, result);
+        w.Stop();
+        transport->write(reply, sizeof(reply));
+    }
+    transport->writeEnd();
+    transport->flush();
+}
+
+// Client side, what send_ of the call does
+template <typename Call, typename... Args> inline void Send(TProtocol *oprot, const Args &...args) {
+    TTransport *transport = oprot->getTransport().get();
+    uint8_t message[MessageHeaderSize<Call>() + Call::Args::kSize];
+    Writer w(message);
+
+    MessageBegin<Call>(w, apache::thrift::protocol::T_CALL, 0);
+    Call::Args::Encode(w, args...);
+    transport->write(message, sizeof(message));
+    transport->writeEnd();
+    transport->flush();
+}
+
+//! Client side, what recv_ of the call does. An exception is read by the
+//! generated code and thrown as there. The servers always set the result
+//! of these calls, a reply without it is taken as invalid data.
+template <typename Call> inline void Recv(TProtocol *iprot, typename Call::Result &result) {
+    using apache::thrift::protocol::TProtocolException;
+    TTransport *transport = iprot->getTransport().get();
+    uint8_t header[MessageHeaderSize<Call>()];
+    Reader r(header);
+    int type;
+
+    transport->readAll(header, sizeof(header));
+    type = MessageType<Call>(r);
+    if(type == apache::thrift::protocol::T_EXCEPTION) {
+        apache::thrift::TApplicationException x;
+
+        x.read(iprot);
+        iprot->readMessageEnd();
+        transport->readEnd();
+        throw x;
+    }
+    if(type != apache::thrift::protocol::T_REPLY)
+        throw TProtocolException(TProtocolException::INVALID_DATA, std::string("unexpected reply to ") + Call::kName);
+
+    if constexpr (std::is_same<typename Call::Result, std::string>::value) {
+        uint8_t field[kFieldHeaderSize + 4];
+        uint8_t stop;
+        Reader fr(field);
+        int32_t len;
+
+        transport->readAll(field, sizeof(field));
+        if(!fr.FieldBegin(apache::thrift::protocol::T_STRING, 0))
+            throw TProtocolException(TProtocolException::INVALID_DATA, std::string("no result of ") + Call::kName);
+        if((len = fr.I32()) < 0)
+            throw TProtocolException(TProtocolException::NEGATIVE_SIZE);
+        result.resize((size_t) len);
+        if(len > 0)
+            transport->readAll((uint8_t *) &result[0], (uint32_t) len);
+        transport->readAll(&stop, 1);
+        if(stop != apache::thrift::protocol::T_STOP)
+            throw TProtocolException(TProtocolException::INVALID_DATA, std::string("unexpected reply to ") + Call::kName);
+    } else {
+        uint8_t field[Field<0, typename Call::Result>::kSize + 1];
+        Reader fr(field);
+
+        transport->readAll(field, sizeof(field));
+        if(!Field<0, typename Call::Result>::Decode(fr, result) || !fr.Stop())
+            throw TProtocolException(TProtocolException::INVALID_DATA, std::string("no result of ") + Call::kName);
+    }
+    iprot->readMessageEnd();
+    transport->readEnd();
+}
+
+//! Server side, for a call whose message header the processor read. The
+//! arguments are decoded from the transport's buffer, handler(result, args...)
+//! makes the call. Returns false with nothing read if they aren't there
+//! whole, or aren't of the layout; the generated processor takes the call.
+template <typename Call, typename Handler>
+inline bool Serve(TProtocol *iprot, TProtocol *oprot, int32_t seqid, Handler &&handler) {
+    TTransport *transport = iprot->getTransport().get();
+    uint32_t len = (uint32_t) Call::Args::kSize;
+    const uint8_t *bytes = transport->borrow(nullptr, &len);
+    typename Call::Args::Values args;
+    typename Call::Result result{};
+
+    if(bytes == nullptr)
+        return false;
+    Reader r(bytes);
+    if(!Call::Args::Decode(r, args))
+        return false;
+    transport->consume((uint32_t) Call::Args::kSize);
+    iprot->readMessageEnd();
+    transport->readEnd();
+
+    try {
+        std::apply([&](auto &...values) { handler(result, values...); }, args);
+    } catch (const std::exception &e) {
+        apache::thrift::TApplicationException x(e.what());
+
+        oprot->writeMessageBegin(Call::kName, apache::thrift::protocol::T_EXCEPTION, seqid);
+        x.write(oprot);
+        oprot->writeMessageEnd();
+        oprot->getTransport()->writeEnd();
+        oprot->getTransport()->flush();
+        return true;
+    }
+    WriteReply<Call>(oprot, seqid, result);
+    return true;
+}
+
+// Whether an end with this wire uses the codec
+static inline bool RpcFastCodecEnabled(const RpcWire &wire) {
+    const char *setting = getenv("RPC_FAST_CODEC");
+
+    return wire.protocol == RPC_PROTOCOL_BINARY && (setting == NULL || strcmp(setting, "off") != 0);
+}
+
+} // namespace rpcfast
+
+#endif //SRC_RPC_FASTCODEC_H
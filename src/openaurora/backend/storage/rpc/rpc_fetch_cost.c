@@ -0,0 +1,149 @@
+//
+// Page fetch latencies of a compute node, see storage/rpc_fetch_cost.h.
+//
+// Every slot keeps an exponential moving average of each kind of fetch in
+// 1/RPC_FETCH_COST_SCALE microseconds, a sample weighing 1/RPC_FETCH_COST_SCALE
+// of it. Backends update them without a lock: two updates racing lose one
+// sample, which an average of many doesn't miss.
+//
+#include "postgres.h"
+
+#include "common/hashfn.h"
+#include "port/atomics.h"
+#include "storage/rpc_fetch_cost.h"
+#include "storage/shmem.h"
+
+#define RPC_FETCH_COST_SCALE (16)
+// A sample longer than this, a stall more than a fetch, counts as this long
+#define RPC_FETCH_COST_MAX_USEC (1000000)
+// Batched pages faster than this count as this fast, not to divide by nothing
+#define RPC_FETCH_COST_MIN_USEC (1.0)
+
+typedef struct RpcFetchCostSlot {
+    // dbNode and relNode of the relation, 0 for none
+    pg_atomic_uint64 key;
+    pg_atomic_uint32 average[RPC_FETCH_KINDS];
+    pg_atomic_uint32 samples[RPC_FETCH_KINDS];
+} RpcFetchCostSlot;
+
+typedef struct RpcFetchCostCtl {
+    // Every fetch of the node
+    RpcFetchCostSlot node;
+    RpcFetchCostSlot slots[RPC_FETCH_COST_SLOTS];
+} RpcFetchCostCtl;
+
+bool rpc_measured_page_costs = false;
+
+static RpcFetchCostCtl *ctl = NULL;
+
+static uint64 RpcFetchCostKey(RelFileNode rnode) {
+    return ((uint64) rnode.dbNode << 32) | rnode.relNode;
+}
+
+static RpcFetchCostSlot *RpcFetchCostSlotOf(uint64 key) {
+    return &ctl->slots[hash_bytes((const unsigned char *) &key, sizeof(key)) % RPC_FETCH_COST_SLOTS];
+}
+
+static void RpcFetchCostAdd(RpcFetchCostSlot *slot, RpcFetchKind kind, uint64_t usec) {
+    int64 sample = (int64) Min(usec, RPC_FETCH_COST_MAX_USEC) * RPC_FETCH_COST_SCALE;
+    int64 average = pg_atomic_read_u32(&slot->average[kind]);
+
+    if (pg_atomic_fetch_add_u32(&slot->samples[kind], 1) == 0)
+        average = sample;
+    else
+        average += (sample - average) / RPC_FETCH_COST_SCALE;
+    pg_atomic_write_u32(&slot->average[kind], (uint32) average);
+}
+
+// The average of the kind in microseconds, if the slot had enough samples
+static bool RpcFetchCostAverage(RpcFetchCostSlot *slot, RpcFetchKind kind, double *usec) {
+    if (pg_atomic_read_u32(&slot->samples[kind]) < RPC_FETCH_COST_MIN_SAMPLES)
+        return false;
+    *usec = (double) pg_atomic_read_u32(&slot->average[kind]) / RPC_FETCH_COST_SCALE;
+    return true;
+}
+
+static double RpcFetchCostRatio(double usec, double base) {
+    double ratio = usec / Max(base, RPC_FETCH_COST_MIN_USEC);
+
+    return Min(Max(ratio, 1.0 / RPC_FETCH_COST_MAX_RATIO), RPC_FETCH_COST_MAX_RATIO);
+}
+
+static void RpcFetchCostSlotInit(RpcFetchCostSlot *slot) {
+    pg_atomic_init_u64(&slot->key, 0);
+    for (int kind = 0; kind < RPC_FETCH_KINDS; kind++) {
+        pg_atomic_init_u32(&slot->average[kind], 0);
+        pg_atomic_init_u32(&slot->samples[kind], 0);
+    }
+}
+
+Size RpcFetchCostShmemSize(void) {
+    return sizeof(RpcFetchCostCtl);
+}
+
+void RpcFetchCostShmemInit(void) {
+    bool found;
+
+    ctl = (RpcFetchCostCtl *) ShmemInitStruct("RPC Fetch Costs", sizeof(RpcFetchCostCtl), &found);
+    if (found)
+        return;
+    RpcFetchCostSlotInit(&ctl->node);
+    for (int i = 0; i < RPC_FETCH_COST_SLOTS; i++)
+        RpcFetchCostSlotInit(&ctl->slots[i]);
+}
+
+void RpcFetchCostRecord(RelFileNode rnode, RpcFetchKind kind, uint64_t usec) {
+    uint64 key = RpcFetchCostKey(rnode);
+    RpcFetchCostSlot *slot;
+    uint64 current;
+
+    if (ctl == NULL || rnode.relNode == InvalidOid)
+        return;
+    slot = RpcFetchCostSlotOf(key);
+    current = pg_atomic_read_u64(&slot->key);
+    // The relation takes the slot over, starting its averages over
+    if (current != key && pg_atomic_compare_exchange_u64(&slot->key, &current, key)) {
+        for (int i = 0; i < RPC_FETCH_KINDS; i++)
+            pg_atomic_write_u32(&slot->samples[i], 0);
+    }
+    if (pg_atomic_read_u64(&slot->key) == key)
+        RpcFetchCostAdd(slot, kind, usec);
+    RpcFetchCostAdd(&ctl->node, kind, usec);
+}
+
+bool RpcFetchPageCosts(RelFileNode rnode, double *random_page_cost, double *seq_page_cost) {
+    uint64 key = RpcFetchCostKey(rnode);
+    RpcFetchCostSlot *slot;
+    double nodeSingle, nodeBatched, relSingle, relBatched;
+    bool haveNodeSingle, haveNodeBatched, haveRelSingle = false, haveRelBatched = false;
+    double seq = *seq_page_cost;
+    double random = *random_page_cost;
+
+    if (ctl == NULL)
+        return false;
+    haveNodeSingle = RpcFetchCostAverage(&ctl->node, RPC_FETCH_SINGLE, &nodeSingle);
+    haveNodeBatched = RpcFetchCostAverage(&ctl->node, RPC_FETCH_BATCHED, &nodeBatched);
+    slot = RpcFetchCostSlotOf(key);
+    if (pg_atomic_read_u64(&slot->key) == key) {
+        haveRelSingle = RpcFetchCostAverage(slot, RPC_FETCH_SINGLE, &relSingle);
+        haveRelBatched = RpcFetchCostAverage(slot, RPC_FETCH_BATCHED, &relBatched);
+    }
+
+    if (haveNodeBatched && haveRelBatched)
+        seq = *seq_page_cost * RpcFetchCostRatio(relBatched, nodeBatched);
+    // A single page against the batched one where the node has both, else
+    // against the node's single pages
+    if (haveNodeBatched && haveRelSingle)
+        random = *seq_page_cost * RpcFetchCostRatio(relSingle, nodeBatched);
+    else if (haveNodeSingle && haveRelSingle)
+        random = *random_page_cost * RpcFetchCostRatio(relSingle, nodeSingle);
+    else if (haveNodeBatched && haveNodeSingle)
+        random = *seq_page_cost * RpcFetchCostRatio(nodeSingle, nodeBatched);
+    else if (!haveNodeBatched || !haveRelBatched)
+        return false;
+
+    *seq_page_cost = seq;
+    // A page fetched alone never costs less than one of a batch
+    *random_page_cost = Max(random, seq);
+    return true;
+}
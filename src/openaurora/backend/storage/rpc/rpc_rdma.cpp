@@ -0,0 +1,406 @@
+//
+// RDMA page reads between a compute node and a storage node.
+//
+// See storage/rpc_rdma.h. Both sides are an RDMA_Manager of their own: a
+// backend's holds the one queue pair to its storage node, the node's the
+// queue pairs of every backend connected. The queue pairs are set up the
+// way compute nodes connect to memory nodes, only over the listener's port.
+//
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "storage/DSMEngine/rdma_manager.h"
+
+#include "postgres.h"
+#include "storage/rpc_rdma.h"
+
+// GUC
+int rpc_rdma_port = 0;
+
+// The storage node as the backend's RDMA_Manager knows it
+#define RPC_RDMA_NODE (1)
+// Any name but the thread-local ones of RDMA_Manager is its main queue pair
+#define RPC_RDMA_QP "rpc"
+#define RPC_RDMA_SPINS 2000
+// How long a backend waits for a reply before it gives the queue pair up
+#define RPC_RDMA_REPLY_TIMEOUT_MS (60 * 1000)
+// How long an idle serving thread sleeps between polls at most
+#define RPC_RDMA_IDLE_SLEEP_US 1000
+
+typedef struct RpcRdmaRegion {
+    RpcRdmaRequest request[RPC_RDMA_SLOTS];
+    RpcRdmaReply reply[RPC_RDMA_SLOTS];
+    char page[RPC_RDMA_SLOTS][BLCKSZ] __attribute__((aligned(64)));
+} RpcRdmaRegion;
+
+// What a serving thread receives into and sends from
+typedef struct RpcRdmaServerRegion {
+    RpcRdmaRequest request[RPC_RDMA_SLOTS];
+    RpcRdmaReply reply;
+    char page[BLCKSZ] __attribute__((aligned(64)));
+} RpcRdmaServerRegion;
+
+struct RpcRdmaChannel {
+    DSMEngine::RDMA_Manager *rdma;
+    RpcRdmaRegion *region;
+    ibv_mr *mr;
+    // Requests ever submitted and replies taken, as rpc_shm's head / taken
+    uint32_t head;
+    uint32_t taken;
+    // Sends not completed yet, their request slots can't be reused
+    uint32_t sendsPending;
+    bool failed;
+};
+
+/*
+ * What the page reads need of RDMA_Manager beyond its public interface: the
+ * resources and accepted queue pairs, which only MemPoolManager sets up
+ * otherwise.
+ */
+class RpcRdmaEndpoint {
+public:
+    static DSMEngine::RDMA_Manager *Open(int port, uint16_t nodeId) {
+        DSMEngine::config_t config = {
+                NULL, /* dev_name */
+                (u_int32_t) port, /* tcp_port */
+                1, /* ib_port */
+                1, /* gid_idx */
+                0,
+                nodeId};
+        DSMEngine::RDMA_Manager *rdma = new DSMEngine::RDMA_Manager(config);
+
+        if (rdma->resources_create()) {
+            delete rdma;
+            return NULL;
+        }
+        if (rdma->rdma_config.gid_idx < 0)
+            memset(&rdma->res->my_gid, 0, sizeof(rdma->res->my_gid));
+        else if (ibv_query_gid(rdma->res->ib_ctx, rdma->rdma_config.ib_port, rdma->rdma_config.gid_idx,
+                               &rdma->res->my_gid)) {
+            delete rdma;
+            return NULL;
+        }
+        return rdma;
+    }
+
+    static ibv_mr *Register(DSMEngine::RDMA_Manager *rdma, void *addr, size_t size, int access) {
+        return ibv_reg_mr(rdma->res->pd, addr, size, access);
+    }
+
+    // Called by the accepting thread only, ConnectQPThroughSocket hands out the ids
+    static uint16_t Accept(DSMEngine::RDMA_Manager *rdma, int fd) {
+        uint16_t peer;
+
+        rdma->ConnectQPThroughSocket(RPC_RDMA_QP, fd, peer);
+        std::unique_lock<std::shared_mutex> l(rdma->qp_cq_map_mutex);
+        rdma->res->sock_map[peer] = fd;
+        return peer;
+    }
+
+    // The last step of the set up, once the receives are posted
+    static bool Sync(DSMEngine::RDMA_Manager *rdma, int fd) {
+        char receive[3 * sizeof(ibv_mr)];
+        char send[3 * sizeof(ibv_mr)] = "Q";
+
+        return rdma->sock_sync_data(fd, 3 * sizeof(ibv_mr), send, receive) == 0;
+    }
+
+    // Destroys the queue pair and closes the socket of peer
+    static void Close(DSMEngine::RDMA_Manager *rdma, uint16_t peer) {
+        std::unique_lock<std::shared_mutex> l(rdma->qp_cq_map_mutex);
+        rdma->ClearOneConnection(peer);
+    }
+};
+
+// An ibv_mr of part of a registered region, which is what post_send and post_receive take
+static ibv_mr
+RpcRdmaSubRegion(const ibv_mr *mr, void *addr, size_t length) {
+    ibv_mr sub = *mr;
+
+    sub.addr = addr;
+    sub.length = length;
+    return sub;
+}
+
+static uint64_t
+RpcRdmaNowMs(void) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+RpcRdmaChannel *
+RpcRdmaConnect(const char *host, int port) {
+    // Shared by every RDMA_Manager of the process, the memory pool's
+    // included, and the connection overwrites it
+    uint16_t nodeId = DSMEngine::RDMA_Manager::node_id;
+    RpcRdmaChannel *channel = new RpcRdmaChannel();
+    void *region = NULL;
+    bool connected = false;
+
+    channel->rdma = RpcRdmaEndpoint::Open(port, nodeId);
+    if (channel->rdma != NULL && posix_memalign(&region, 4096, sizeof(RpcRdmaRegion)) == 0) {
+        channel->region = (RpcRdmaRegion *) region;
+        memset(channel->region, 0, sizeof(RpcRdmaRegion));
+        channel->mr = RpcRdmaEndpoint::Register(channel->rdma, channel->region, sizeof(RpcRdmaRegion),
+                                                IBV_ACCESS_LOCAL_WRITE | IBV_ACCESS_REMOTE_WRITE);
+    }
+    if (channel->mr != NULL) {
+        channel->rdma->memory_nodes[RPC_RDMA_NODE] = host;
+        connected = channel->rdma->Client_Set_Up_One_Connection(RPC_RDMA_NODE);
+    }
+    DSMEngine::RDMA_Manager::node_id = nodeId;
+    if (!connected) {
+        RpcRdmaDisconnect(channel);
+        return NULL;
+    }
+    return channel;
+}
+
+void
+RpcRdmaDisconnect(RpcRdmaChannel *channel) {
+    if (channel->rdma != NULL)
+        RpcRdmaEndpoint::Close(channel->rdma, RPC_RDMA_NODE);
+    if (channel->mr != NULL)
+        ibv_dereg_mr(channel->mr);
+    delete channel->rdma;
+    free(channel->region);
+    delete channel;
+}
+
+// Takes the send completions there are, waiting for one if wait
+static bool
+RpcRdmaReapSends(RpcRdmaChannel *channel, bool wait) {
+    std::string qpType = RPC_RDMA_QP;
+    ibv_wc wc[RPC_RDMA_SLOTS];
+
+    while (channel->sendsPending > 0) {
+        int n;
+
+        if (wait) {
+            if (channel->rdma->poll_completion(wc, 1, qpType, true, RPC_RDMA_NODE) != 0)
+                return false;
+            n = 1;
+            wait = false;
+        } else if ((n = channel->rdma->try_poll_completions(wc, RPC_RDMA_SLOTS, qpType, true,
+                                                              RPC_RDMA_NODE)) <= 0)
+            return n == 0;
+        for (int i = 0; i < n; i++) {
+            if (wc[i].status != IBV_WC_SUCCESS)
+                return false;
+        }
+        channel->sendsPending -= n;
+    }
+    return true;
+}
+
+RpcRdmaRequest *
+RpcRdmaRequestSlot(RpcRdmaChannel *channel) {
+    RpcRdmaRequest *request;
+    uint32_t slot = channel->head % RPC_RDMA_SLOTS;
+
+    if (channel->failed || channel->head - channel->taken >= RPC_RDMA_SLOTS)
+        return NULL;
+    request = &channel->region->request[slot];
+    memset(request, 0, sizeof(RpcRdmaRequest));
+    request->ticket = channel->head;
+    request->pageAddr = (uint64_t) (uintptr_t) channel->region->page[slot];
+    request->pageRkey = channel->mr->rkey;
+    return request;
+}
+
+bool
+RpcRdmaSubmit(RpcRdmaChannel *channel, uint32_t *ticket) {
+    uint32_t slot = channel->head % RPC_RDMA_SLOTS;
+    ibv_mr replyMr = RpcRdmaSubRegion(channel->mr, &channel->region->reply[slot], sizeof(RpcRdmaReply));
+    ibv_mr requestMr = RpcRdmaSubRegion(channel->mr, &channel->region->request[slot], sizeof(RpcRdmaRequest));
+
+    // The sends complete in order, below RPC_RDMA_SLOTS pending the one of
+    // this slot's last request has
+    if (!RpcRdmaReapSends(channel, false) ||
+        (channel->sendsPending >= RPC_RDMA_SLOTS && !RpcRdmaReapSends(channel, true))) {
+        channel->failed = true;
+        return false;
+    }
+    // The reply's receive goes first, so the node never finds none posted
+    if (channel->rdma->post_receive<RpcRdmaReply>(&replyMr, RPC_RDMA_NODE, RPC_RDMA_QP) != 0 ||
+        channel->rdma->post_send<RpcRdmaRequest>(&requestMr, RPC_RDMA_NODE, RPC_RDMA_QP) != 0) {
+        channel->failed = true;
+        return false;
+    }
+    channel->sendsPending++;
+    *ticket = channel->head++;
+    return true;
+}
+
+RpcRdmaReply *
+RpcRdmaTakeReply(RpcRdmaChannel *channel, uint32_t ticket) {
+    std::string qpType = RPC_RDMA_QP;
+    RpcRdmaReply *reply = &channel->region->reply[ticket % RPC_RDMA_SLOTS];
+    uint64_t deadline = 0;
+    ibv_wc wc;
+    int n;
+
+    Assert(ticket == channel->taken);
+    if (channel->failed)
+        return NULL;
+    // The receives complete in the order they were posted, one per ticket
+    for (int i = 0; (n = channel->rdma->try_poll_completions(&wc, 1, qpType, false, RPC_RDMA_NODE)) == 0; i++) {
+        if (i < RPC_RDMA_SPINS)
+            continue;
+        if (deadline == 0)
+            deadline = RpcRdmaNowMs() + RPC_RDMA_REPLY_TIMEOUT_MS;
+        else if (i % 1000 == 0 && RpcRdmaNowMs() > deadline)
+            break;
+        sched_yield();
+    }
+    if (n != 1 || wc.status != IBV_WC_SUCCESS || reply->ticket != ticket) {
+        channel->failed = true;
+        return NULL;
+    }
+    channel->taken = ticket + 1;
+    return reply;
+}
+
+const char *
+RpcRdmaPage(RpcRdmaChannel *channel, uint32_t ticket) {
+    return channel->region->page[ticket % RPC_RDMA_SLOTS];
+}
+
+// Whether the backend closed the socket the queue pair was set up over
+static bool
+RpcRdmaPeerGone(int fd) {
+    struct pollfd pfd = {fd, POLLIN | POLLRDHUP, 0};
+    char c;
+
+    if (poll(&pfd, 1, 0) <= 0)
+        return false;
+    return (pfd.revents & (POLLRDHUP | POLLHUP | POLLERR)) != 0 ||
+           recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 0;
+}
+
+// Waits for the next request, polling slower the longer none comes
+static bool
+RpcRdmaWaitRequest(DSMEngine::RDMA_Manager *rdma, uint16_t peer, int fd, ibv_wc *wc) {
+    std::string qpType = RPC_RDMA_QP;
+    int sleepUs = 1;
+    int n;
+
+    for (int i = 0; (n = rdma->try_poll_completions(wc, 1, qpType, false, peer)) == 0; i++) {
+        if (i < RPC_RDMA_SPINS)
+            continue;
+        if (RpcRdmaPeerGone(fd))
+            return false;
+        usleep(sleepUs);
+        sleepUs = Min(sleepUs * 2, RPC_RDMA_IDLE_SLEEP_US);
+    }
+    return n == 1 && wc->status == IBV_WC_SUCCESS;
+}
+
+static void
+RpcRdmaServePeer(DSMEngine::RDMA_Manager *rdma, uint16_t peer, int fd, RpcRdmaServeFunc serve, void *arg) {
+    std::string qpType = RPC_RDMA_QP;
+    RpcRdmaServerRegion *region = NULL;
+    void *buffer = NULL;
+    ibv_mr *mr = NULL;
+    bool ok;
+
+    if (posix_memalign(&buffer, 4096, sizeof(RpcRdmaServerRegion)) == 0) {
+        region = (RpcRdmaServerRegion *) buffer;
+        mr = RpcRdmaEndpoint::Register(rdma, region, sizeof(RpcRdmaServerRegion), IBV_ACCESS_LOCAL_WRITE);
+    }
+    ok = mr != NULL;
+    for (int i = 0; ok && i < RPC_RDMA_SLOTS; i++) {
+        ibv_mr requestMr = RpcRdmaSubRegion(mr, &region->request[i], sizeof(RpcRdmaRequest));
+
+        ok = rdma->post_receive<RpcRdmaRequest>(&requestMr, peer, qpType) == 0;
+    }
+    ok = ok && RpcRdmaEndpoint::Sync(rdma, fd);
+
+    for (uint32_t next = 0; ok; next++) {
+        uint32_t slot = next % RPC_RDMA_SLOTS;
+        ibv_mr requestMr = RpcRdmaSubRegion(mr, &region->request[slot], sizeof(RpcRdmaRequest));
+        ibv_mr replyMr = RpcRdmaSubRegion(mr, &region->reply, sizeof(RpcRdmaReply));
+        ibv_mr pageMr = RpcRdmaSubRegion(mr, region->page, BLCKSZ);
+        RpcRdmaRequest request;
+        ibv_wc wc;
+
+        if (!RpcRdmaWaitRequest(rdma, peer, fd, &wc))
+            break;
+        request = region->request[slot];
+        // The backend may send the next request as soon as it has this reply
+        if (rdma->post_receive<RpcRdmaRequest>(&requestMr, peer, qpType) != 0)
+            break;
+
+        memset(&region->reply, 0, sizeof(RpcRdmaReply));
+        serve(arg, &request, &region->reply, region->page);
+        region->reply.ticket = request.ticket;
+        // Unsignaled, the reply's completion covers it
+        if (request.command == RPC_RDMA_READ && region->reply.status == RPC_RDMA_OK &&
+            rdma->RDMA_Write((void *) (uintptr_t) request.pageAddr, request.pageRkey, &pageMr, BLCKSZ, qpType, 0,
+                             0, peer) != 0)
+            break;
+        if (rdma->post_send<RpcRdmaReply>(&replyMr, peer, qpType) != 0 ||
+            rdma->poll_completion(&wc, 1, qpType, true, peer) != 0 || wc.status != IBV_WC_SUCCESS)
+            break;
+    }
+
+    RpcRdmaEndpoint::Close(rdma, peer);
+    if (mr != NULL)
+        ibv_dereg_mr(mr);
+    free(region);
+}
+
+static int
+RpcRdmaListen(int port) {
+    struct sockaddr_in address;
+    int option = 1;
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    if (fd < 0)
+        return -1;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons((uint16_t) port);
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option));
+    if (bind(fd, (struct sockaddr *) &address, sizeof(address)) != 0 || listen(fd, 64) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool
+RpcRdmaStartServer(int port, RpcRdmaServeFunc serve, void *arg) {
+    DSMEngine::RDMA_Manager *rdma = RpcRdmaEndpoint::Open(port, 1);
+    int listenFd;
+
+    if (rdma == NULL)
+        return false;
+    if ((listenFd = RpcRdmaListen(port)) < 0) {
+        delete rdma;
+        return false;
+    }
+    std::thread([rdma, listenFd, serve, arg] {
+        for (;;) {
+            int fd = accept(listenFd, NULL, NULL);
+
+            if (fd < 0) {
+                if (errno != EINTR)
+                    usleep(1000);
+                continue;
+            }
+            // The queue pair is set up here, a backend at a time
+            uint16_t peer = RpcRdmaEndpoint::Accept(rdma, fd);
+            std::thread(RpcRdmaServePeer, rdma, peer, fd, serve, arg).detach();
+        }
+    }).detach();
+    return true;
+}
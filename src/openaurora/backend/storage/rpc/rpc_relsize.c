@@ -0,0 +1,162 @@
+//
+// Relation size history of the storage node, see storage/rpc_relsize.h.
+//
+// The logs are kept in sets of RPC_REL_SIZE_WAYS under one mutex the way the
+// zone maps are, a full set replaces a log not looked up since its last
+// pass. A full log drops its older half, reads that far back go to
+// SyncGetRelSize again.
+//
+#include "postgres.h"
+
+#include <pthread.h>
+#include <string.h>
+#include "common/hashfn.h"
+#include "storage/rpc_relsize.h"
+
+#define RPC_REL_SIZE_SETS (4096)
+#define RPC_REL_SIZE_WAYS (4)
+#define RPC_REL_SIZE_CHANGES (32)
+
+typedef struct RpcRelSizeChange {
+    uint64_t lsn;
+    uint32_t nblocks;
+} RpcRelSizeChange;
+
+typedef struct RpcRelSizeLog {
+    RelKey key;
+    bool valid;
+    bool referenced;
+    // Oldest first, never empty while valid
+    int count;
+    RpcRelSizeChange changes[RPC_REL_SIZE_CHANGES];
+} RpcRelSizeLog;
+
+static pthread_mutex_t relSizeLogLock = PTHREAD_MUTEX_INITIALIZER;
+static RpcRelSizeLog logs[RPC_REL_SIZE_SETS * RPC_REL_SIZE_WAYS];
+
+static bool RpcRelSizeKeyEquals(RelKey a, RelKey b) {
+    return a.SpcId == b.SpcId && a.DbId == b.DbId && a.RelId == b.RelId && a.forkNum == b.forkNum;
+}
+
+static RpcRelSizeLog *RpcRelSizeSet(RelKey relKey) {
+    uint64_t fields[4];
+    uint32 hash;
+
+    fields[0] = relKey.SpcId;
+    fields[1] = relKey.DbId;
+    fields[2] = relKey.RelId;
+    fields[3] = relKey.forkNum;
+    hash = hash_bytes((const unsigned char *) fields, sizeof(fields));
+    return &logs[(size_t) (hash % RPC_REL_SIZE_SETS) * RPC_REL_SIZE_WAYS];
+}
+
+// Caller holds the lock
+static RpcRelSizeLog *RpcRelSizeFind(RpcRelSizeLog *set, RelKey relKey) {
+    for (int i = 0; i < RPC_REL_SIZE_WAYS; i++) {
+        if (set[i].valid && RpcRelSizeKeyEquals(set[i].key, relKey))
+            return &set[i];
+    }
+    return NULL;
+}
+
+// Caller holds the lock
+static RpcRelSizeLog *RpcRelSizeStart(RpcRelSizeLog *set, RelKey relKey) {
+    RpcRelSizeLog *log = NULL;
+
+    for (int i = 0; i < RPC_REL_SIZE_WAYS && log == NULL; i++) {
+        if (!set[i].valid)
+            log = &set[i];
+    }
+    // One not looked up since the last pass
+    for (int i = 0; log == NULL; i = (i + 1) % RPC_REL_SIZE_WAYS) {
+        if (!set[i].referenced)
+            log = &set[i];
+        set[i].referenced = false;
+    }
+    log->key = relKey;
+    log->valid = true;
+    log->referenced = false;
+    log->count = 0;
+    return log;
+}
+
+// Caller holds the lock
+static void RpcRelSizeAppend(RpcRelSizeLog *log, uint32_t nblocks, uint64_t lsn) {
+    if (log->count > 0 && log->changes[log->count - 1].lsn == lsn) {
+        log->changes[log->count - 1].nblocks = nblocks;
+        return;
+    }
+    if (log->count == RPC_REL_SIZE_CHANGES) {
+        int keep = RPC_REL_SIZE_CHANGES / 2;
+
+        memmove(log->changes, log->changes + (log->count - keep), keep * sizeof(RpcRelSizeChange));
+        log->count = keep;
+    }
+    log->changes[log->count].lsn = lsn;
+    log->changes[log->count].nblocks = nblocks;
+    log->count++;
+}
+
+void RpcRelSizeExtend(RelKey relKey, uint32_t nblocks, uint64_t lsn) {
+    RpcRelSizeLog *set;
+    RpcRelSizeLog *log;
+    RpcRelSizeChange *last;
+
+    pthread_mutex_lock(&relSizeLogLock);
+    set = RpcRelSizeSet(relKey);
+    log = RpcRelSizeFind(set, relKey);
+    if (log == NULL) {
+        RpcRelSizeAppend(RpcRelSizeStart(set, relKey), nblocks, lsn);
+    } else {
+        last = &log->changes[log->count - 1];
+        // Not before a truncate logged already, the log can't say
+        // what the relation looked like in between
+        if (lsn < last->lsn)
+            log->valid = false;
+        else if (nblocks > last->nblocks)
+            RpcRelSizeAppend(log, nblocks, lsn);
+    }
+    pthread_mutex_unlock(&relSizeLogLock);
+}
+
+void RpcRelSizeTruncate(RelKey relKey, uint32_t nblocks, uint64_t lsn) {
+    RpcRelSizeLog *log;
+
+    pthread_mutex_lock(&relSizeLogLock);
+    log = RpcRelSizeFind(RpcRelSizeSet(relKey), relKey);
+    // Extends logged past lsn were measured against the old size
+    if (log != NULL) {
+        if (lsn < log->changes[log->count - 1].lsn)
+            log->valid = false;
+        else
+            RpcRelSizeAppend(log, nblocks, lsn);
+    }
+    pthread_mutex_unlock(&relSizeLogLock);
+}
+
+bool RpcRelSizeLookup(RelKey relKey, uint64_t lsn, uint32_t *nblocks) {
+    RpcRelSizeLog *log;
+    bool found = false;
+
+    pthread_mutex_lock(&relSizeLogLock);
+    log = RpcRelSizeFind(RpcRelSizeSet(relKey), relKey);
+    if (log != NULL && lsn >= log->changes[0].lsn) {
+        // The last change at or before lsn
+        int lo = 0;
+        int hi = log->count - 1;
+
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+
+            if (log->changes[mid].lsn <= lsn)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+        *nblocks = log->changes[lo].nblocks;
+        log->referenced = true;
+        found = true;
+    }
+    pthread_mutex_unlock(&relSizeLogLock);
+    return found;
+}
@@ -0,0 +1,152 @@
+//
+// Scans filtered on the storage node, the page filter both sides agree on.
+//
+// See storage/rpc_scan.h. A tuple is read the way nocachegetattr does,
+// attribute after attribute from the qual's descriptions, without a
+// TupleDesc: the node has no catalogs and its page service runs in threads.
+//
+#include "postgres.h"
+
+#include "access/htup_details.h"
+#include "access/stratnum.h"
+#include "access/tupmacs.h"
+#include "storage/bufpage.h"
+#include "storage/rpc_scan.h"
+
+bool
+RpcScanCompare(const RpcScanQual *qual, int64_t value) {
+    int cmp;
+
+    if (qual->kind == RPC_SCAN_UNSIGNED)
+        cmp = (uint64_t) value < (uint64_t) qual->constant ? -1 : (uint64_t) value > (uint64_t) qual->constant;
+    else
+        cmp = value < qual->constant ? -1 : value > qual->constant;
+
+    switch (qual->strategy) {
+        case BTLessStrategyNumber:
+            return cmp < 0;
+        case BTLessEqualStrategyNumber:
+            return cmp <= 0;
+        case BTEqualStrategyNumber:
+            return cmp == 0;
+        case BTGreaterEqualStrategyNumber:
+            return cmp >= 0;
+        case BTGreaterStrategyNumber:
+            return cmp > 0;
+        default:
+            return true;
+    }
+}
+
+bool
+RpcScanTupleAttr(const RpcScanAttr *atts, int attnum, int kind, HeapTupleHeader tup, uint32 len,
+                 int64_t *value, bool *isnull) {
+    bool hasnulls = (tup->t_infomask & HEAP_HASNULL) != 0;
+    char *tp;
+    uint32 datalen;
+    long off = 0;
+    int i;
+
+    if (attnum < 1 || attnum > RPC_SCAN_MAX_ATTS)
+        return false;
+    if (len < SizeofHeapTupleHeader || tup->t_hoff > len)
+        return false;
+    // A later ALTER TABLE ADD COLUMN, the value is the column's default
+    if (attnum > (int) HeapTupleHeaderGetNatts(tup))
+        return false;
+
+    *isnull = hasnulls && att_isnull(attnum - 1, tup->t_bits);
+    if (*isnull || value == NULL)
+        return true;
+
+    tp = (char *) tup + tup->t_hoff;
+    datalen = len - tup->t_hoff;
+    for (i = 0; i < attnum; i++) {
+        const RpcScanAttr *att = &atts[i];
+
+        if (hasnulls && att_isnull(i, tup->t_bits))
+            continue;
+        if (off >= datalen)
+            return false;
+        if (att->attlen == -1)
+            off = att_align_pointer(off, att->attalign, -1, tp + off);
+        else
+            off = att_align_nominal(off, att->attalign);
+        if (i == attnum - 1)
+            break;
+        if (off >= datalen)
+            return false;
+        off = att_addlength_pointer(off, att->attlen, tp + off);
+    }
+
+    switch (atts[attnum - 1].attlen) {
+        case sizeof(int16): {
+            int16 v;
+
+            if (off + sizeof(v) > datalen)
+                return false;
+            memcpy(&v, tp + off, sizeof(v));
+            *value = v;
+            break;
+        }
+        case sizeof(int32): {
+            int32 v;
+
+            if (off + sizeof(v) > datalen)
+                return false;
+            memcpy(&v, tp + off, sizeof(v));
+            *value = kind == RPC_SCAN_UNSIGNED ? (int64_t) (uint32) v : (int64_t) v;
+            break;
+        }
+        case sizeof(int64): {
+            int64 v;
+
+            if (off + sizeof(v) > datalen)
+                return false;
+            memcpy(&v, tp + off, sizeof(v));
+            *value = v;
+            break;
+        }
+        default:
+            return false;
+    }
+    return true;
+}
+
+static bool
+ScanTupleMayMatch(const RpcScanQual *qual, HeapTupleHeader tup, uint32 len) {
+    int64_t value;
+    bool isnull;
+
+    if (!RpcScanTupleAttr(qual->atts, qual->attnum, qual->kind, tup, len, &value, &isnull))
+        return true;
+    // The comparisons are strict
+    return !isnull && RpcScanCompare(qual, value);
+}
+
+bool
+RpcScanPageMayMatch(const RpcScanQual *qual, const char *page) {
+    Page p = (Page) page;
+    OffsetNumber maxoff;
+    OffsetNumber off;
+
+    if (qual->attnum < 1 || qual->attnum > RPC_SCAN_MAX_ATTS)
+        return true;
+    if (PageIsNew(p))
+        return false;
+    if (PageGetPageSize(p) != BLCKSZ || ((PageHeader) p)->pd_lower > BLCKSZ)
+        return true;
+
+    maxoff = PageGetMaxOffsetNumber(p);
+    for (off = FirstOffsetNumber; off <= maxoff; off = OffsetNumberNext(off)) {
+        ItemId lp = PageGetItemId(p, off);
+
+        if (!ItemIdIsNormal(lp))
+            continue;
+        if (ItemIdGetOffset(lp) + ItemIdGetLength(lp) > BLCKSZ)
+            return true;
+        if (ScanTupleMayMatch(qual, (HeapTupleHeader) PageGetItem(p, lp), ItemIdGetLength(lp)))
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,207 @@
+//
+// Shared-memory page reads between a compute node and a storage node on one host.
+//
+// See storage/rpc_shm.h. Both sides wait the way wal_redo_channel does: set
+// the waiting flag, re-check the counter and sleep on the futex word the
+// other side bumps after every move, so no wakeup is lost. Waits are bounded
+// so either side notices when the other has gone away.
+//
+#include "postgres.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "port/atomics.h"
+#include "storage/rpc_shm.h"
+
+#define RPC_SHM_SPINS 2000
+#define RPC_SHM_WAIT_NSEC (100 * 1000 * 1000)
+
+static uint32_t rpcShmCreated = 0;
+
+static void
+ShmFutexWait(uint32_t *addr, uint32_t val) {
+    struct timespec timeout = {0, RPC_SHM_WAIT_NSEC};
+
+    // The mapping is shared between processes, so no FUTEX_PRIVATE_FLAG
+    syscall(SYS_futex, addr, FUTEX_WAIT, val, &timeout, NULL, 0);
+}
+
+static void
+ShmFutexWake(uint32_t *addr) {
+    syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+static bool
+ShmPeerGone(pid_t pid) {
+    return pid != 0 && kill(pid, 0) != 0 && errno == ESRCH;
+}
+
+/*
+ * Wait until *counter is past value, false if the segment was closed or
+ * peer exited instead.
+ */
+static bool
+ShmWait(RpcShmSegment *segment, uint32_t *counter, uint32_t value, uint32_t *seq, uint32_t *waiting, pid_t peer) {
+    for (int i = 0; i < RPC_SHM_SPINS; i++) {
+        if (__atomic_load_n(counter, __ATOMIC_ACQUIRE) != value)
+            return true;
+        pg_spin_delay();
+    }
+
+    while (true) {
+        uint32_t s = __atomic_load_n(seq, __ATOMIC_SEQ_CST);
+
+        __atomic_store_n(waiting, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(counter, __ATOMIC_SEQ_CST) != value)
+            break;
+        if (__atomic_load_n(&segment->closed, __ATOMIC_SEQ_CST) || ShmPeerGone(peer)) {
+            __atomic_store_n(waiting, 0, __ATOMIC_SEQ_CST);
+            return false;
+        }
+        ShmFutexWait(seq, s);
+    }
+    __atomic_store_n(waiting, 0, __ATOMIC_SEQ_CST);
+    return true;
+}
+
+static void
+ShmAdvance(uint32_t *counter, uint32_t *seq, uint32_t *waiting) {
+    __atomic_add_fetch(counter, 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(waiting, __ATOMIC_SEQ_CST))
+        ShmFutexWake(seq);
+}
+
+RpcShmSegment *
+RpcShmCreate(char *name) {
+    RpcShmSegment *segment;
+    int fd;
+
+    snprintf(name, RPC_SHM_NAME_LEN, "/openaurora-rpc-%d-%u", (int) getpid(), rpcShmCreated++);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        return NULL;
+    if (ftruncate(fd, sizeof(RpcShmSegment)) != 0) {
+        close(fd);
+        shm_unlink(name);
+        return NULL;
+    }
+    segment = (RpcShmSegment *) mmap(NULL, sizeof(RpcShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (segment == MAP_FAILED) {
+        shm_unlink(name);
+        return NULL;
+    }
+
+    // A new object starts zeroed, which is an empty, open ring
+    segment->size = sizeof(RpcShmSegment);
+    segment->clientPid = getpid();
+    __atomic_store_n(&segment->magic, RPC_SHM_MAGIC, __ATOMIC_RELEASE);
+    return segment;
+}
+
+void
+RpcShmUnlink(const char *name) {
+    shm_unlink(name);
+}
+
+void
+RpcShmDestroy(RpcShmSegment *segment) {
+    munmap(segment, sizeof(RpcShmSegment));
+}
+
+RpcShmSlot *
+RpcShmRequestSlot(RpcShmSegment *segment) {
+    if (segment->head - segment->taken >= RPC_SHM_SLOTS)
+        return NULL;
+    return &segment->slot[segment->head % RPC_SHM_SLOTS];
+}
+
+uint32_t
+RpcShmSubmit(RpcShmSegment *segment) {
+    uint32_t ticket = segment->head;
+
+    ShmAdvance(&segment->head, &segment->requestSeq, &segment->serverWaiting);
+    return ticket;
+}
+
+RpcShmSlot *
+RpcShmTakeReply(RpcShmSegment *segment, uint32_t ticket) {
+    uint32_t tail;
+
+    Assert(ticket == segment->taken);
+    while ((int32_t) ((tail = __atomic_load_n(&segment->tail, __ATOMIC_ACQUIRE)) - ticket) <= 0) {
+        if (!ShmWait(segment, &segment->tail, tail, &segment->replySeq, &segment->clientWaiting,
+                     segment->serverPid))
+            return NULL;
+    }
+    segment->taken = ticket + 1;
+    return &segment->slot[ticket % RPC_SHM_SLOTS];
+}
+
+RpcShmSegment *
+RpcShmMap(const char *name) {
+    RpcShmSegment *segment;
+    struct stat st;
+    int fd = shm_open(name, O_RDWR, 0);
+
+    if (fd < 0)
+        return NULL;
+    // Anything but a segment of this build is left alone
+    if (fstat(fd, &st) != 0 || st.st_size != sizeof(RpcShmSegment)) {
+        close(fd);
+        return NULL;
+    }
+    segment = (RpcShmSegment *) mmap(NULL, sizeof(RpcShmSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (segment == MAP_FAILED)
+        return NULL;
+    if (__atomic_load_n(&segment->magic, __ATOMIC_ACQUIRE) != RPC_SHM_MAGIC ||
+        segment->size != sizeof(RpcShmSegment)) {
+        munmap(segment, sizeof(RpcShmSegment));
+        return NULL;
+    }
+    segment->serverPid = getpid();
+    return segment;
+}
+
+void
+RpcShmUnmap(RpcShmSegment *segment) {
+    munmap(segment, sizeof(RpcShmSegment));
+}
+
+RpcShmSlot *
+RpcShmNextRequest(RpcShmSegment *segment) {
+    uint32_t tail = segment->tail;
+
+    if (__atomic_load_n(&segment->closed, __ATOMIC_SEQ_CST))
+        return NULL;
+    if (__atomic_load_n(&segment->head, __ATOMIC_ACQUIRE) == tail &&
+        !ShmWait(segment, &segment->head, tail, &segment->requestSeq, &segment->serverWaiting,
+                 segment->clientPid))
+        return NULL;
+    return &segment->slot[tail % RPC_SHM_SLOTS];
+}
+
+void
+RpcShmReply(RpcShmSegment *segment) {
+    ShmAdvance(&segment->tail, &segment->replySeq, &segment->clientWaiting);
+}
+
+void
+RpcShmClose(RpcShmSegment *segment) {
+    __atomic_store_n(&segment->closed, 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&segment->requestSeq, 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&segment->replySeq, 1, __ATOMIC_SEQ_CST);
+    ShmFutexWake(&segment->requestSeq);
+    ShmFutexWake(&segment->replySeq);
+}
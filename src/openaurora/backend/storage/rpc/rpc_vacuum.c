@@ -0,0 +1,100 @@
+//
+// Vacuum triage on the storage node, the page rules both sides agree on.
+//
+// See storage/rpc_vacuum.h. A page is left to the compute node whenever
+// lazy_scan_heap would change it: prune a dead tuple, freeze an xid, or set
+// it all-visible. The transactions of a tuple are judged by its hint bits
+// alone, those it can't be are taken as possibly anything.
+//
+#include "postgres.h"
+
+#include "access/htup_details.h"
+#include "access/transam.h"
+#include "storage/bufpage.h"
+#include "storage/rpc_vacuum.h"
+
+RpcVacuumStatus
+RpcVacuumTriagePage(const RpcVacuumHorizon *horizon, const char *page, RpcVacuumEntry *entry,
+                    uint16_t *deadOffsets) {
+    Page p = (Page) page;
+    TransactionId oldestXmin = (TransactionId) horizon->oldestXmin;
+    TransactionId freezeLimit = (TransactionId) horizon->freezeLimit;
+    // What lazy_scan_heap would find, unless the page can't be judged here
+    bool allVisible = true;
+    OffsetNumber maxoff;
+    OffsetNumber off;
+
+    if (!TransactionIdIsNormal(oldestXmin) || !TransactionIdIsNormal(freezeLimit))
+        return RPC_VACUUM_READ;
+    if (PageIsNew(p) || PageGetPageSize(p) != BLCKSZ || ((PageHeader) p)->pd_lower > BLCKSZ ||
+        PageIsEmpty(p) || PageIsAllVisible(p))
+        return RPC_VACUUM_READ;
+
+    memset(entry, 0, sizeof(RpcVacuumEntry));
+    maxoff = PageGetMaxOffsetNumber(p);
+    for (off = FirstOffsetNumber; off <= maxoff; off = OffsetNumberNext(off)) {
+        ItemId lp = PageGetItemId(p, off);
+        HeapTupleHeader tup;
+        TransactionId xmin;
+        TransactionId xmax;
+        bool deleted = false;
+
+        if (!ItemIdIsUsed(lp)) {
+            entry->nunused++;
+            continue;
+        }
+        if (ItemIdIsRedirected(lp)) {
+            entry->hastup = 1;
+            continue;
+        }
+        if (ItemIdIsDead(lp)) {
+            deadOffsets[entry->ndead++] = off;
+            allVisible = false;
+            continue;
+        }
+        if (ItemIdGetOffset(lp) + ItemIdGetLength(lp) > BLCKSZ)
+            return RPC_VACUUM_READ;
+        tup = (HeapTupleHeader) PageGetItem(p, lp);
+
+        // The inserter has to be known committed, and old enough to be kept
+        if (tup->t_infomask & HEAP_MOVED)
+            return RPC_VACUUM_READ;
+        if (!HeapTupleHeaderXminCommitted(tup))
+            return RPC_VACUUM_READ;
+        xmin = HeapTupleHeaderGetXmin(tup);
+        if (!HeapTupleHeaderXminFrozen(tup) &&
+            (!TransactionIdIsNormal(xmin) || TransactionIdPrecedes(xmin, freezeLimit)))
+            return RPC_VACUUM_READ;
+        if (!TransactionIdPrecedes(xmin, oldestXmin))
+            allVisible = false;
+
+        // Any xmax but a recent one would be frozen, whether it counts or not
+        if (tup->t_infomask & HEAP_XMAX_IS_MULTI)
+            return RPC_VACUUM_READ;
+        xmax = HeapTupleHeaderGetRawXmax(tup);
+        if (TransactionIdIsNormal(xmax) && TransactionIdPrecedes(xmax, freezeLimit))
+            return RPC_VACUUM_READ;
+        if (!(tup->t_infomask & HEAP_XMAX_INVALID) && !HEAP_XMAX_IS_LOCKED_ONLY(tup->t_infomask)) {
+            // Only a deleter known committed since oldestXmin leaves the
+            // tuple recently dead. An older one made it dead, one that
+            // aborted leaves it live on a page that may be all-visible.
+            if (!(tup->t_infomask & HEAP_XMAX_COMMITTED) || TransactionIdPrecedes(xmax, oldestXmin))
+                return RPC_VACUUM_READ;
+            deleted = true;
+            allVisible = false;
+        }
+
+        entry->ntuples++;
+        if (!deleted)
+            entry->nlive++;
+        entry->hastup = 1;
+    }
+
+    // lazy_scan_heap would set it all-visible
+    if (allVisible)
+        return RPC_VACUUM_READ;
+
+    entry->freespace = (int32_t) PageGetHeapFreeSpace(p);
+    entry->status = entry->ndead > 0 ? RPC_VACUUM_DEAD_ONLY : RPC_VACUUM_CLEAN;
+    return (RpcVacuumStatus) entry->status;
+}
@@ -0,0 +1,131 @@
+//
+// Thrift protocol and transport of the page service
+//
+#ifndef SRC_RPC_WIRE_H
+#define SRC_RPC_WIRE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <memory>
+
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/protocol/TCompactProtocol.h>
+#include <thrift/protocol/THeaderProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+
+//! Compute nodes, the storage node and the test tools agree on the wire
+//! format from the environment, it has to be set the same on both ends:
+//!
+//!     RPC_PROTOCOL   binary (default), compact or header
+//!     RPC_TRANSPORT  buffered (default) or framed
+//!
+//! The compact protocol writes field headers and integers as varints, which
+//! roughly halves RpcMdNblocks, RpcMdExists, RpcLseek and RpcFileSize calls,
+//! most of whose bytes are headers. Framed transport sends each message with
+//! its length in front and is what RPC_NONBLOCKING_SERVER needs. Header is
+//! its own transport, framed, with a header carrying the sequence ID and
+//! key-value pairs, what out-of-order replies on one connection would need
+//! later; a header server also takes binary and compact clients, framed or
+//! not, so it suits a mixed rollout. The nonblocking server reads the frames
+//! itself and can't serve header, with it header falls back to binary.
+
+enum RpcWireProtocol {
+    RPC_PROTOCOL_BINARY,
+    RPC_PROTOCOL_COMPACT,
+    RPC_PROTOCOL_HEADER
+};
+
+enum RpcWireTransport {
+    RPC_TRANSPORT_BUFFERED,
+    RPC_TRANSPORT_FRAMED
+};
+
+struct RpcWire {
+    RpcWireProtocol protocol;
+    RpcWireTransport transport;
+};
+
+static inline RpcWire RpcWireFromEnv() {
+    static bool warned = false;
+    const char *protocol = getenv("RPC_PROTOCOL");
+    const char *transport = getenv("RPC_TRANSPORT");
+    RpcWire wire = {RPC_PROTOCOL_BINARY, RPC_TRANSPORT_BUFFERED};
+
+    if(protocol != NULL && strcmp(protocol, "compact") == 0)
+        wire.protocol = RPC_PROTOCOL_COMPACT;
+    else if(protocol != NULL && strcmp(protocol, "header") == 0)
+        wire.protocol = RPC_PROTOCOL_HEADER;
+    if(transport != NULL && strcmp(transport, "framed") == 0)
+        wire.transport = RPC_TRANSPORT_FRAMED;
+
+    if(getenv("RPC_NONBLOCKING_SERVER") != NULL) {
+        wire.transport = RPC_TRANSPORT_FRAMED;
+        if(wire.protocol == RPC_PROTOCOL_HEADER) {
+            if(!warned) {
+                printf("%s RPC_PROTOCOL=header doesn't work with RPC_NONBLOCKING_SERVER, using binary\n", __func__);
+                fflush(stdout);
+                warned = true;
+            }
+            wire.protocol = RPC_PROTOCOL_BINARY;
+        }
+    }
+    return wire;
+}
+
+// Client side, over a socket. THeaderProtocol puts its transport over the
+// socket itself
+static inline std::shared_ptr<apache::thrift::transport::TTransport>
+RpcWireTransport(const RpcWire &wire, const std::shared_ptr<apache::thrift::transport::TTransport> &socket) {
+    using namespace apache::thrift::transport;
+
+    if(wire.protocol == RPC_PROTOCOL_HEADER)
+        return socket;
+    if(wire.transport == RPC_TRANSPORT_FRAMED)
+        return std::make_shared<TFramedTransport>(socket);
+    return std::make_shared<TBufferedTransport>(socket);
+}
+
+static inline std::shared_ptr<apache::thrift::protocol::TProtocol>
+RpcWireProtocol(const RpcWire &wire, const std::shared_ptr<apache::thrift::transport::TTransport> &transport) {
+    using namespace apache::thrift::protocol;
+
+    if(wire.protocol == RPC_PROTOCOL_HEADER)
+        return std::make_shared<THeaderProtocol>(transport);
+    if(wire.protocol == RPC_PROTOCOL_COMPACT)
+        return std::make_shared<TCompactProtocol>(transport);
+    return std::make_shared<TBinaryProtocol>(transport);
+}
+
+// Server side, the header protocol wraps the raw connection itself
+static inline std::shared_ptr<apache::thrift::transport::TTransportFactory>
+RpcWireTransportFactory(const RpcWire &wire) {
+    using namespace apache::thrift::transport;
+
+    if(wire.protocol == RPC_PROTOCOL_HEADER)
+        return std::make_shared<TTransportFactory>();
+    if(wire.transport == RPC_TRANSPORT_FRAMED)
+        return std::make_shared<TFramedTransportFactory>();
+    return std::make_shared<TBufferedTransportFactory>();
+}
+
+static inline std::shared_ptr<apache::thrift::protocol::TProtocolFactory>
+RpcWireProtocolFactory(const RpcWire &wire) {
+    using namespace apache::thrift::protocol;
+
+    if(wire.protocol == RPC_PROTOCOL_HEADER)
+        return std::make_shared<THeaderProtocolFactory>();
+    if(wire.protocol == RPC_PROTOCOL_COMPACT)
+        return std::make_shared<TCompactProtocolFactory>();
+    return std::make_shared<TBinaryProtocolFactory>();
+}
+
+static inline const char *RpcWireName(const RpcWire &wire) {
+    if(wire.protocol == RPC_PROTOCOL_HEADER)
+        return "header";
+    if(wire.protocol == RPC_PROTOCOL_COMPACT)
+        return wire.transport == RPC_TRANSPORT_FRAMED ? "compact/framed" : "compact/buffered";
+    return wire.transport == RPC_TRANSPORT_FRAMED ? "binary/framed" : "binary/buffered";
+}
+
+#endif //SRC_RPC_WIRE_H
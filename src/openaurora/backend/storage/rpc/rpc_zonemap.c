@@ -0,0 +1,218 @@
+//
+// Zone maps of the storage node, see storage/rpc_zonemap.h.
+//
+// The summaries are kept in sets of RPC_ZONEMAP_WAYS entries under one
+// mutex, a full set replaces an entry not looked up since its last pass.
+//
+#include "postgres.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "access/htup_details.h"
+#include "access/stratnum.h"
+#include "common/hashfn.h"
+#include "storage/bufpage.h"
+#include "storage/rpc_zonemap.h"
+
+// GUC
+int rpc_zonemap_size = 65536;
+
+#define RPC_ZONEMAP_WAYS (4)
+
+typedef struct RpcZoneMapKey {
+    RelFileNode rnode;
+    int32_t attnum;
+    int32_t kind;
+    uint32_t range;
+} RpcZoneMapKey;
+
+typedef struct RpcZoneMapEntry {
+    RpcZoneMapKey key;
+    RpcZoneMapSummary summary;
+    bool valid;
+    bool referenced;
+} RpcZoneMapEntry;
+
+static pthread_mutex_t zoneMapLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t zoneMapOnce = PTHREAD_ONCE_INIT;
+static RpcZoneMapEntry *entries = NULL;
+static int setNum = 0;
+
+static void RpcZoneMapInit(void) {
+    setNum = rpc_zonemap_size / RPC_ZONEMAP_WAYS;
+    if (setNum <= 0)
+        return;
+    entries = (RpcZoneMapEntry*) calloc((size_t) setNum * RPC_ZONEMAP_WAYS, sizeof(RpcZoneMapEntry));
+    if (entries == NULL)
+        setNum = 0;
+}
+
+static bool RpcZoneMapEnabled(void) {
+    pthread_once(&zoneMapOnce, RpcZoneMapInit);
+    return entries != NULL;
+}
+
+static void RpcZoneMapMakeKey(RpcZoneMapKey *key, RelFileNode rnode, const RpcScanQual *qual, uint32_t range) {
+    // Zeroed for the hash and compare, there's no padding but be sure of it
+    memset(key, 0, sizeof(RpcZoneMapKey));
+    key->rnode = rnode;
+    key->attnum = qual->attnum;
+    key->kind = qual->kind;
+    key->range = range;
+}
+
+static RpcZoneMapEntry *RpcZoneMapSet(const RpcZoneMapKey *key) {
+    uint32 hash = hash_bytes((const unsigned char *) key, sizeof(RpcZoneMapKey));
+
+    return &entries[(size_t) (hash % setNum) * RPC_ZONEMAP_WAYS];
+}
+
+// Caller holds the lock
+static RpcZoneMapEntry *RpcZoneMapFind(RpcZoneMapEntry *set, const RpcZoneMapKey *key) {
+    for (int i = 0; i < RPC_ZONEMAP_WAYS; i++) {
+        if (set[i].valid && memcmp(&set[i].key, key, sizeof(RpcZoneMapKey)) == 0)
+            return &set[i];
+    }
+    return NULL;
+}
+
+static int RpcZoneMapCompare(const RpcScanQual *qual, int64_t a, int64_t b) {
+    if (qual->kind == RPC_SCAN_UNSIGNED)
+        return (uint64_t) a < (uint64_t) b ? -1 : (uint64_t) a > (uint64_t) b;
+    return a < b ? -1 : a > b;
+}
+
+void RpcZoneMapInitSummary(RpcZoneMapSummary *summary, uint64_t lsn) {
+    memset(summary, 0, sizeof(RpcZoneMapSummary));
+    summary->lsn = lsn;
+}
+
+void RpcZoneMapAddPage(const RpcScanQual *qual, const char *page, RpcZoneMapSummary *summary) {
+    Page p = (Page) page;
+    OffsetNumber maxoff;
+    OffsetNumber off;
+
+    if (summary->unknown)
+        return;
+    if (qual->attnum < 1 || qual->attnum > RPC_SCAN_MAX_ATTS) {
+        summary->unknown = true;
+        return;
+    }
+    if (PageIsNew(p))
+        return;
+    if (PageGetPageSize(p) != BLCKSZ || ((PageHeader) p)->pd_lower > BLCKSZ) {
+        summary->unknown = true;
+        return;
+    }
+
+    maxoff = PageGetMaxOffsetNumber(p);
+    for (off = FirstOffsetNumber; off <= maxoff; off = OffsetNumberNext(off)) {
+        ItemId lp = PageGetItemId(p, off);
+        int64_t value;
+        bool isnull;
+
+        if (!ItemIdIsNormal(lp))
+            continue;
+        if (ItemIdGetOffset(lp) + ItemIdGetLength(lp) > BLCKSZ ||
+            !RpcScanTupleAttr(qual->atts, qual->attnum, qual->kind, (HeapTupleHeader) PageGetItem(p, lp),
+                              ItemIdGetLength(lp), &value, &isnull)) {
+            summary->unknown = true;
+            return;
+        }
+        if (isnull)
+            continue;
+        if (!summary->hasValue || RpcZoneMapCompare(qual, value, summary->min) < 0)
+            summary->min = value;
+        if (!summary->hasValue || RpcZoneMapCompare(qual, value, summary->max) > 0)
+            summary->max = value;
+        summary->hasValue = true;
+    }
+}
+
+bool RpcZoneMapExcludes(const RpcScanQual *qual, const RpcZoneMapSummary *summary) {
+    if (summary->unknown)
+        return false;
+    // The comparisons are strict
+    if (!summary->hasValue)
+        return true;
+
+    switch (qual->strategy) {
+        case BTLessStrategyNumber:
+        case BTLessEqualStrategyNumber:
+            return !RpcScanCompare(qual, summary->min);
+        case BTEqualStrategyNumber:
+            return RpcZoneMapCompare(qual, qual->constant, summary->min) < 0 ||
+                   RpcZoneMapCompare(qual, qual->constant, summary->max) > 0;
+        case BTGreaterEqualStrategyNumber:
+        case BTGreaterStrategyNumber:
+            return !RpcScanCompare(qual, summary->max);
+        default:
+            return false;
+    }
+}
+
+bool RpcZoneMapLookup(RelFileNode rnode, const RpcScanQual *qual, uint32_t range, RpcZoneMapSummary *summary) {
+    RpcZoneMapKey key;
+    RpcZoneMapEntry *entry;
+
+    if (!RpcZoneMapEnabled())
+        return false;
+    RpcZoneMapMakeKey(&key, rnode, qual, range);
+
+    pthread_mutex_lock(&zoneMapLock);
+    entry = RpcZoneMapFind(RpcZoneMapSet(&key), &key);
+    if (entry != NULL) {
+        entry->referenced = true;
+        *summary = entry->summary;
+    }
+    pthread_mutex_unlock(&zoneMapLock);
+    return entry != NULL;
+}
+
+void RpcZoneMapStore(RelFileNode rnode, const RpcScanQual *qual, uint32_t range, const RpcZoneMapSummary *summary) {
+    RpcZoneMapKey key;
+    RpcZoneMapEntry *set;
+    RpcZoneMapEntry *entry;
+
+    if (!RpcZoneMapEnabled())
+        return;
+    RpcZoneMapMakeKey(&key, rnode, qual, range);
+
+    pthread_mutex_lock(&zoneMapLock);
+    set = RpcZoneMapSet(&key);
+    entry = RpcZoneMapFind(set, &key);
+    for (int i = 0; i < RPC_ZONEMAP_WAYS && entry == NULL; i++) {
+        if (!set[i].valid)
+            entry = &set[i];
+    }
+    // One not looked up since the last pass
+    for (int i = 0; entry == NULL; i = (i + 1) % RPC_ZONEMAP_WAYS) {
+        if (!set[i].referenced)
+            entry = &set[i];
+        set[i].referenced = false;
+    }
+    // Another scan may have read the range at a later LSN
+    if (!entry->valid || memcmp(&entry->key, &key, sizeof(key)) != 0 || entry->summary.lsn < summary->lsn) {
+        entry->key = key;
+        entry->summary = *summary;
+        entry->valid = true;
+        entry->referenced = false;
+    }
+    pthread_mutex_unlock(&zoneMapLock);
+}
+
+void RpcZoneMapDropRelation(RelFileNode rnode, uint32_t firstBlock) {
+    uint32_t firstRange = firstBlock / RPC_ZONEMAP_RANGE_BLOCKS;
+
+    if (!RpcZoneMapEnabled())
+        return;
+
+    pthread_mutex_lock(&zoneMapLock);
+    for (size_t i = 0; i < (size_t) setNum * RPC_ZONEMAP_WAYS; i++) {
+        if (entries[i].valid && RelFileNodeEquals(entries[i].key.rnode, rnode) &&
+            entries[i].key.range >= firstRange)
+            entries[i].valid = false;
+    }
+    pthread_mutex_unlock(&zoneMapLock);
+}
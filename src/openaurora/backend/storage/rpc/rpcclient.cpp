@@ -15,22 +15,49 @@
 
 #include <unistd.h>
 #include <fcntl.h>
+#include <poll.h>
 
 #include <iostream>
 #include <fstream>
 #include <string.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
 
 #include "postgres.h"
 #include "storage/rpcclient.h"
+#include "storage/local_page_cache.h"
+#include "storage/shard_map.h"
+#include "storage/rpc_shm.h"
+#include "storage/rpc_rdma.h"
+#include "storage/rpc_lanes.h"
+#include "storage/rpc_file_cache.h"
+#include "storage/rpc_fetch_cost.h"
+#include "storage/proc.h"
+#include "postmaster/autovacuum.h"
+#include "replication/wal_ship_compress.h"
 #include "DataPageAccess.h"
 #include "storage/copydir.h"
 #include "storage/smgr.h"
 #include "catalog/storage.h"
+#include "catalog/pg_class.h"
 #include "access/xlog.h"
+#include "executor/instrument.h"
+#include "miscadmin.h"
+#include "pg_trace.h"
+#include "pgstat.h"
+#include "port/pg_bswap.h"
+#include "storage/checksum.h"
+#include "storage/stage_timing.h"
 
 #include <thrift/protocol/TBinaryProtocol.h>
 #include <thrift/transport/TSocket.h>
 #include <thrift/transport/TTransportUtils.h>
+#include "rpc_wire.h"
+#include "rpc_fastcodec.h"
 
 /*** behavior for mdopen & _mdfd_getseg ***/
 /* ereport if segment not present */
@@ -65,156 +92,453 @@ std::shared_ptr<TTransport> rpctransport;
 std::shared_ptr<TProtocol> rpcprotocol;
 DataPageAccessClient *client=NULL;
 
+/*
+ * Reply buffer reused by the page read calls. Thrift deserializes into its
+ * existing capacity, so steady-state reads do not allocate; the only copy
+ * left on the client is the one into the caller's shared buffer.
+ */
+static _Page rpcPageBuffer;
+
 int IsRpcClient = 0;
 pid_t MyPid = 0;
 
-//#define DEBUG_TIMING
-//#define DEBUG_TIMING2
-#ifdef DEBUG_TIMING
+/*
+ * Every ReadBufferCommon carries a trace ID, the backend's pid over a count
+ * of its reads. The storage node tags the probes of the read with it, hands
+ * it to the redo process that replays the page, and appends what it spent
+ * waiting for the parser and replaying to the page, which EXPLAIN (ANALYZE,
+ * STORAGE) reports per plan node.
+ */
+static uint32 rpcTraceCount = 0;
 
-#include <sys/time.h>
-#include <pthread.h>
-#include <cstdlib>
+static uint64 RpcNextTraceId() {
+    return ((uint64) MyProcPid << 32) | ++rpcTraceCount;
+}
 
-int initialized5 = 0;
-struct timeval output_timing5;
+/*
+ * A storage node compresses the pages it sends a connection that asked for
+ * it with rpc_page_compression, into the frames of wal_ship_compress.h. A
+ * page that doesn't shrink comes as it is, a frame is told apart by being
+ * shorter than a page and is decompressed straight into the caller's
+ * buffer. The trailer of a traced read follows either.
+ */
+int rpc_page_compression = WAL_SHIP_COMPRESSION_OFF;
 
-pthread_mutex_t timing_mutex5 = PTHREAD_MUTEX_INITIALIZER;
-long client_nblocks_time[16];
-long client_nblocks_count[16];
+// Asks a new connection for compressed pages, an older node doesn't know how
+static void RpcNegotiatePageCompression(DataPageAccessClient *pageClient) {
+    if(rpc_page_compression == WAL_SHIP_COMPRESSION_OFF)
+        return;
+    try {
+        pageClient->RpcSetPageCompression(rpc_page_compression);
+    } catch (TApplicationException &e) {
+    }
+}
 
-long client_readbuffer_time[16];
-long client_readbuffer_count[16];
+static size_t RpcPageTrailerSize(const _Page &page, bool traced) {
+    size_t len = page.size();
 
-long client_extend_time[16];
-long client_extend_count[16];
+    if(!traced || len < sizeof(StageTraceTrailer))
+        return 0;
+    len -= sizeof(StageTraceTrailer);
+    if(len == BLCKSZ || (len < BLCKSZ && WalShipFrameRawLength(page.data(), len) == BLCKSZ))
+        return sizeof(StageTraceTrailer);
+    return 0;
+}
 
-long client_exist_time[16];
-long client_exist_count[16];
+// Copies the page of a reply into buff, decompressing a frame
+static void RpcPageCopy(const _Page &page, bool traced, char *buff) {
+    size_t len = page.size() - RpcPageTrailerSize(page, traced);
 
-long client_create_time[16];
-long client_create_count[16];
+    if(len >= BLCKSZ) {
+        memcpy(buff, page.data(), BLCKSZ);
+        return;
+    }
+    if(!WalShipDecompress(page.data(), len, buff, BLCKSZ))
+        throw TException("storage node sent a page that doesn't decompress");
+}
 
-long client_truncate_time[16];
-long client_truncate_count[16];
+/*
+ * Reads through shared memory, see storage/rpc_shm.h. Only the home node's
+ * connection gets a segment; shards and replicas are read over TCP.
+ */
+bool rpc_shared_memory_reads = false;
 
-long client_read_time[16];
-long client_read_count[16];
+static RpcShmSegment *rpcShm = NULL;
 
-void PrintTimingResult5() {
-    struct timeval now;
+static void RpcSetUpSharedMemory(DataPageAccessClient *pageClient) {
+    char name[RPC_SHM_NAME_LEN];
+    int32_t attached = 0;
 
-    if(!initialized5){
-        gettimeofday(&output_timing5, NULL);
-        initialized5 = 1;
+    // A parent's segment is its own, the parent's node serves it
+    if(rpcShm != NULL && rpcShm->clientPid != getpid()) {
+        RpcShmDestroy(rpcShm);
+        rpcShm = NULL;
+    }
+    if(!rpc_shared_memory_reads || rpcShm != NULL)
+        return;
+    if((rpcShm = RpcShmCreate(name)) == NULL)
+        return;
+    try {
+        attached = pageClient->RpcAttachSharedMemory(name);
+    } catch (TApplicationException &e) {
+    }
+    // Both sides have it mapped or it's no use, the name is gone either way
+    RpcShmUnlink(name);
+    if(attached != 1) {
+        RpcShmDestroy(rpcShm);
+        rpcShm = NULL;
+    }
+}
 
-        memset(client_nblocks_time, 0, 16*sizeof(client_nblocks_time[0]));
-        memset(client_nblocks_count, 0, 16*sizeof(client_nblocks_count[0]));
+// Puts a read in the segment, false if there's none or all slots are in flight
+static bool RpcShmSubmitRead(const _Smgr_Relation &_reln, int32_t _relpersistence, int32_t _forkNum,
+                             int32_t _blkNum, int32_t _readBufferMode, int64_t lsn, uint64 traceId,
+                             uint32_t *ticket) {
+    RpcShmSlot *slot;
+
+    if(rpcShm == NULL || (slot = RpcShmRequestSlot(rpcShm)) == NULL)
+        return false;
+    slot->spcNode = (uint32_t) _reln._spc_node;
+    slot->dbNode = (uint32_t) _reln._db_node;
+    slot->relNode = (uint32_t) _reln._rel_node;
+    slot->relPersistence = _relpersistence;
+    slot->forkNum = _forkNum;
+    slot->blkNum = _blkNum;
+    slot->readBufferMode = _readBufferMode;
+    slot->lsn = lsn;
+    slot->traceId = (int64_t) traceId;
+    *ticket = RpcShmSubmit(rpcShm);
+    return true;
+}
 
-        memset(client_readbuffer_time, 0, 16*sizeof(client_readbuffer_time[0]));
-        memset(client_readbuffer_count, 0, 16*sizeof(client_readbuffer_count[0]));
+static void RpcShmReceiveRead(uint32_t ticket, char *buff) {
+    RpcShmSlot *slot = RpcShmTakeReply(rpcShm, ticket);
 
-        memset(client_extend_time, 0, 16*sizeof(client_nblocks_time[0]));
-        memset(client_extend_count, 0, 16*sizeof(client_nblocks_count[0]));
+    if(slot == NULL) {
+        RpcShmDestroy(rpcShm);
+        rpcShm = NULL;
+        throw TException("storage node stopped serving shared memory reads");
+    }
+    if(slot->status != RPC_SHM_OK)
+        throw TApplicationException("storage node failed a shared memory read");
+    memcpy(buff, slot->page, BLCKSZ);
+    pgStorageUsage.remote_reads++;
+    pgStorageUsage.remote_bytes += BLCKSZ;
+    pgStorageUsage.wait_parse_ns += slot->waitParseNs;
+    pgStorageUsage.replay_ns += slot->replayNs;
+}
 
-        memset(client_exist_time, 0, 16*sizeof(client_nblocks_time[0]));
-        memset(client_exist_count, 0, 16*sizeof(client_nblocks_count[0]));
+/*
+ * Reads over RDMA, see storage/rpc_rdma.h. Like the segment, only the home
+ * node's connection gets a queue pair, and only when it got no segment: a
+ * node on the same host is cheaper to reach through shared memory.
+ */
+static RpcRdmaChannel *rpcRdma = NULL;
+static pid_t rpcRdmaPid = 0;
+
+static void RpcSetUpRdma(const std::string &host) {
+    // A parent's queue pair is its own, the child leaves it be
+    if(rpcRdma != NULL && rpcRdmaPid != getpid())
+        rpcRdma = NULL;
+    if(rpc_rdma_port <= 0 || rpcRdma != NULL || rpcShm != NULL)
+        return;
+    rpcRdma = RpcRdmaConnect(host.c_str(), rpc_rdma_port);
+    rpcRdmaPid = getpid();
+}
 
-        memset(client_create_time, 0, 16*sizeof(client_nblocks_time[0]));
-        memset(client_create_count, 0, 16*sizeof(client_nblocks_count[0]));
+// The queue pair failed, what's left goes over TCP
+static void RpcRdmaFailed() {
+    RpcRdmaDisconnect(rpcRdma);
+    rpcRdma = NULL;
+}
 
-        memset(client_truncate_time, 0, 16*sizeof(client_nblocks_time[0]));
-        memset(client_truncate_count, 0, 16*sizeof(client_nblocks_count[0]));
+// False if the queue pair failed before the page came, the read has to be made over TCP then
+static bool RpcRdmaReceiveRead(uint32_t ticket, char *buff) {
+    RpcRdmaReply *reply;
 
-        memset(client_read_time, 0, 16*sizeof(client_nblocks_time[0]));
-        memset(client_read_count, 0, 16*sizeof(client_nblocks_count[0]));
+    if(rpcRdma == NULL)
+        return false;
+    if((reply = RpcRdmaTakeReply(rpcRdma, ticket)) == NULL) {
+        RpcRdmaFailed();
+        return false;
     }
+    if(reply->status != RPC_RDMA_OK)
+        throw TApplicationException("storage node failed an RDMA read");
+    memcpy(buff, RpcRdmaPage(rpcRdma, ticket), BLCKSZ);
+    pgStorageUsage.remote_reads++;
+    pgStorageUsage.remote_bytes += BLCKSZ;
+    pgStorageUsage.wait_parse_ns += reply->waitParseNs;
+    pgStorageUsage.replay_ns += reply->replayNs;
+    return true;
+}
 
+// RpcMdNblocks over the queue pair, false if there's none or it failed
+static bool RpcRdmaNblocks(const _Smgr_Relation &_reln, int32_t _forknum, int64_t lsn, int32_t *nblocks) {
+    RpcRdmaRequest *request;
+    RpcRdmaReply *reply;
+    uint32_t ticket;
+
+    if(rpcRdma == NULL || (request = RpcRdmaRequestSlot(rpcRdma)) == NULL)
+        return false;
+    request->command = RPC_RDMA_NBLOCKS;
+    request->spcNode = (uint32_t) _reln._spc_node;
+    request->dbNode = (uint32_t) _reln._db_node;
+    request->relNode = (uint32_t) _reln._rel_node;
+    request->forkNum = _forknum;
+    request->lsn = lsn;
+    if(!RpcRdmaSubmit(rpcRdma, &ticket) || (reply = RpcRdmaTakeReply(rpcRdma, ticket)) == NULL) {
+        RpcRdmaFailed();
+        return false;
+    }
+    if(reply->status != RPC_RDMA_OK)
+        throw TApplicationException("storage node failed an RDMA nblocks");
+    *nblocks = reply->nblocks;
+    return true;
+}
 
-    gettimeofday(&now, NULL);
+static void RpcCountStorageRead(const _Page &page, bool traced) {
+    size_t trailerSize = RpcPageTrailerSize(page, traced);
 
-    if(now.tv_sec-output_timing5.tv_sec >= 5) {
-        output_timing5 = now;
+    pgStorageUsage.remote_reads++;
+    pgStorageUsage.remote_bytes += page.size();
+    if(trailerSize > 0) {
+        StageTraceTrailer trailer;
 
-        for(int i = 0 ; i < 9; i++) {
-            if(client_nblocks_count[i] == 0)
-                continue;
-            printf("client_nblocks_%d = %ld\n",i,  client_nblocks_time[i]/client_nblocks_count[i]);
-            printf("client_nblocks_%d = %ld, count = %ld\n",i,  client_nblocks_time[i], client_nblocks_count[i]);
-            fflush(stdout);
-        }
+        memcpy(&trailer, page.data() + page.size() - trailerSize, sizeof(trailer));
+        pgStorageUsage.wait_parse_ns += pg_ntoh64(trailer.wait_parse_ns);
+        pgStorageUsage.replay_ns += pg_ntoh64(trailer.replay_ns);
+    }
+}
 
-        for(int i = 0 ; i < 9; i++) {
-            if(client_readbuffer_count[i] == 0)
-                continue;
-            printf("client_readbuffer_%d = %ld\n",i,  client_readbuffer_time[i]/client_readbuffer_count[i]);
-            printf("client_readbuffer_%d = %ld, count = %ld\n",i,  client_readbuffer_time[i], client_readbuffer_count[i]);
-            fflush(stdout);
-        }
+/*
+ * WAL writes sent but not yet answered. XLogWrite() hands the chunks to the
+ * storage node without waiting for each reply, up to wal_ship_window of them,
+ * and the flush request travels together with the writes instead of after
+ * them. Every backend has a connection of its own, so the replies are all
+ * collected before XLogWrite() returns and WALWriteLock passes on. Replies
+ * come back in order on the one connection, so any other call first drains
+ * the window. A short write found while draining is kept and reported by the
+ * next WAL write or flush, both of which PANIC on it.
+ */
+#define RPC_XLOG_WINDOW_MAX 64
 
-        for(int i = 0 ; i < 9; i++) {
-            if(client_extend_count[i] == 0)
-                continue;
-            printf("client_extend_%d = %ld\n",i,  client_extend_time[i]/client_extend_count[i]);
-            printf("client_extend_%d = %ld, count = %ld\n",i,  client_extend_time[i], client_extend_count[i]);
-            fflush(stdout);
-        }
+int wal_ship_window = 4;
 
-        for(int i = 0 ; i < 9; i++) {
-            if(client_exist_count[i] == 0)
-                continue;
-            printf("client_exist_%d = %ld\n",i,  client_exist_time[i]/client_exist_count[i]);
-            printf("client_exist_%d = %ld, count = %ld\n",i,  client_exist_time[i], client_exist_count[i]);
-            fflush(stdout);
-        }
+static int32_t rpcXLogPending[RPC_XLOG_WINDOW_MAX];
+static int rpcXLogPendingHead = 0;
+static int rpcXLogPendingNum = 0;
+static bool rpcXLogWriteFailed = false;
 
-        for(int i = 0 ; i < 9; i++) {
-            if(client_create_count[i] == 0)
-                continue;
-            printf("client_create_%d = %ld\n",i,  client_create_time[i]/client_create_count[i]);
-            printf("client_create_%d = %ld, count = %ld\n",i,  client_create_time[i], client_create_count[i]);
-            fflush(stdout);
-        }
+//#define DEBUG_TIMING2
 
-        for(int i = 0 ; i < 9; i++) {
-            if(client_truncate_count[i] == 0)
-                continue;
-            printf("client_truncate_%d = %ld\n",i,  client_truncate_time[i]/client_truncate_count[i]);
-            printf("client_truncate_%d = %ld, count = %ld\n",i,  client_truncate_time[i], client_truncate_count[i]);
-            fflush(stdout);
-        }
+/*
+ * Storage node endpoints, from RPC_SERVER_ENDPOINTS ("host:port,host:port").
+ * Falls back to PRIMARY_NODE_IP:9092 when unset. Each backend starts at the
+ * endpoint picked by its pid so that connections spread across the list, and
+ * moves to the next one if the connect fails.
+ */
+static std::vector<std::pair<std::string, int>> rpcEndpoints;
 
-        for(int i = 0 ; i < 9; i++) {
-            if(client_truncate_count[i] == 0)
-                continue;
-            printf("client_read_%d = %ld\n",i,  client_read_time[i]/client_read_count[i]);
-            printf("client_read_%d = %ld, count = %ld\n",i,  client_read_time[i], client_read_count[i]);
-            fflush(stdout);
+static void RpcLoadEndpoints() {
+    if(!rpcEndpoints.empty())
+        return;
+
+    char *endpoints = getenv("RPC_SERVER_ENDPOINTS");
+    if(endpoints != NULL) {
+        std::string list(endpoints);
+        size_t start = 0;
+        while(start < list.size()) {
+            size_t end = list.find(',', start);
+            if(end == std::string::npos)
+                end = list.size();
+            std::string entry = list.substr(start, end - start);
+            size_t colon = entry.rfind(':');
+            if(colon == std::string::npos)
+                rpcEndpoints.emplace_back(entry, 9092);
+            else if(colon > 0)
+                rpcEndpoints.emplace_back(entry.substr(0, colon), atoi(entry.c_str() + colon + 1));
+            start = end + 1;
         }
+    }
+
+    if(rpcEndpoints.empty())
+        rpcEndpoints.emplace_back(PRIMARY_NODE_IP, 9092);
+}
+
+// Must match the server's, see rpc_wire.h
+static const RpcWire &RpcGetWire() {
+    static const RpcWire wire = RpcWireFromEnv();
+    return wire;
+}
+
+static std::shared_ptr<TTransport> RpcWrapSocket(const std::shared_ptr<TTransport> &socket) {
+    return RpcWireTransport(RpcGetWire(), socket);
+}
+
+static std::shared_ptr<TProtocol> RpcWrapTransport(const std::shared_ptr<TTransport> &transport) {
+    return RpcWireProtocol(RpcGetWire(), transport);
+}
 
+/*
+ * The hot page calls, encoded by the codec of rpc_fastcodec.h when the wire
+ * is binary and by the generated client otherwise. The bytes are the same,
+ * either end may use either.
+ */
+static bool RpcFastCodec() {
+    static const bool enabled = rpcfast::RpcFastCodecEnabled(RpcGetWire());
+    return enabled;
+}
+
+static void RpcSendReadBufferCommon(DataPageAccessClient *pageClient, const _Smgr_Relation &reln,
+                                    int32_t relpersistence, int32_t forkNum, int32_t blkNum, int32_t mode,
+                                    int64_t lsn, int64_t traceId) {
+    if(RpcFastCodec())
+        rpcfast::Send<rpcfast::ReadBufferCommonCall>(pageClient->getOutputProtocol().get(), reln, relpersistence,
+                                                     forkNum, blkNum, mode, lsn, traceId);
+    else
+        pageClient->send_ReadBufferCommon(reln, relpersistence, forkNum, blkNum, mode, lsn, traceId);
+}
+
+static void RpcRecvReadBufferCommon(DataPageAccessClient *pageClient, _Page &page) {
+    if(RpcFastCodec())
+        rpcfast::Recv<rpcfast::ReadBufferCommonCall>(pageClient->getInputProtocol().get(), page);
+    else
+        pageClient->recv_ReadBufferCommon(page);
+}
+
+static void RpcCallReadBufferCommon(DataPageAccessClient *pageClient, _Page &page, const _Smgr_Relation &reln,
+                                    int32_t relpersistence, int32_t forkNum, int32_t blkNum, int32_t mode,
+                                    int64_t lsn, int64_t traceId) {
+    RpcSendReadBufferCommon(pageClient, reln, relpersistence, forkNum, blkNum, mode, lsn, traceId);
+    RpcRecvReadBufferCommon(pageClient, page);
+}
+
+static void RpcCallMdRead(DataPageAccessClient *pageClient, _Page &page, const _Smgr_Relation &reln,
+                          int32_t forkNum, int64_t blkNum, int64_t lsn) {
+    if(!RpcFastCodec()) {
+        pageClient->RpcMdRead(page, reln, forkNum, blkNum, lsn);
+        return;
     }
+    rpcfast::Send<rpcfast::RpcMdReadCall>(pageClient->getOutputProtocol().get(), reln, forkNum, blkNum, lsn);
+    rpcfast::Recv<rpcfast::RpcMdReadCall>(pageClient->getInputProtocol().get(), page);
 }
 
-#define START_TIMING(start_p)  \
-do {                         \
-    gettimeofday(start_p, NULL); \
-} while(0);
+static int32_t RpcCallMdNblocks(DataPageAccessClient *pageClient, const _Smgr_Relation &reln, int32_t forkNum,
+                                int64_t lsn) {
+    int32_t nblocks = 0;
 
-#define RECORD_TIMING(start_p, end_p, global_timing, global_count) \
-do { \
-    gettimeofday(end_p, NULL); \
-    pthread_mutex_lock(&timing_mutex5); \
-    (*global_timing) += ((*end_p.tv_sec*1000000+*end_p.tv_usec) - (*start_p.tv_sec*1000000+*start_p.tv_usec))/1000; \
-    (*global_count)++;                                                               \
-    pthread_mutex_unlock(&timing_mutex5); \
-    PrintTimingResult5(); \
-    gettimeofday(start_p, NULL); \
-} while (0);
+    if(!RpcFastCodec())
+        return pageClient->RpcMdNblocks(reln, forkNum, lsn);
+    rpcfast::Send<rpcfast::RpcMdNblocksCall>(pageClient->getOutputProtocol().get(), reln, forkNum, lsn);
+    rpcfast::Recv<rpcfast::RpcMdNblocksCall>(pageClient->getInputProtocol().get(), nblocks);
+    return nblocks;
+}
 
+/*
+ * Class of the requests of this process, see storage/rpc_lanes.h. The home
+ * node's connection is told whenever it changes; shards and replicas take
+ * every request as foreground.
+ */
+static int rpcRequestClass = RPC_CLASS_FOREGROUND;
+static bool rpcRequestClassUnsupported = false;
+
+static int RpcCurrentRequestClass() {
+    if(AmCheckpointerProcess() || AmBackgroundWriterProcess() || AmStartupProcess())
+        return RPC_CLASS_MAINTENANCE;
+    if(IsAutoVacuumWorkerProcess() || (MyPgXact != NULL && (MyPgXact->vacuumFlags & PROC_IN_VACUUM)))
+        return RPC_CLASS_BACKGROUND;
+    return RPC_CLASS_FOREGROUND;
+}
 
-#endif
+static void RpcUpdateRequestClass() {
+    int requestClass = RpcCurrentRequestClass();
 
-void RpcInit()
+    if(requestClass == rpcRequestClass || rpcRequestClassUnsupported)
+        return;
+    try {
+        client->RpcSetRequestClass(requestClass);
+    } catch (TApplicationException &e) {
+        // An older node, it has one queue
+        rpcRequestClassUnsupported = true;
+    }
+    rpcRequestClass = requestClass;
+}
+
+// Sends a read over the queue pair, false if there's none or all slots are in flight
+static bool RpcRdmaSubmitRead(const _Smgr_Relation &_reln, int32_t _relpersistence, int32_t _forkNum,
+                              int32_t _blkNum, int32_t _readBufferMode, int64_t lsn, uint64 traceId,
+                              uint32_t *ticket) {
+    RpcRdmaRequest *request;
+
+    if(rpcRdma == NULL || (request = RpcRdmaRequestSlot(rpcRdma)) == NULL)
+        return false;
+    request->command = RPC_RDMA_READ;
+    request->spcNode = (uint32_t) _reln._spc_node;
+    request->dbNode = (uint32_t) _reln._db_node;
+    request->relNode = (uint32_t) _reln._rel_node;
+    request->relPersistence = _relpersistence;
+    request->forkNum = _forkNum;
+    request->blkNum = _blkNum;
+    request->readBufferMode = _readBufferMode;
+    request->requestClass = RpcCurrentRequestClass();
+    request->lsn = lsn;
+    request->traceId = (int64_t) traceId;
+    if(!RpcRdmaSubmit(rpcRdma, ticket)) {
+        RpcRdmaFailed();
+        return false;
+    }
+    return true;
+}
+
+/*
+ * How long a call of this process may wait for a lane on the home node
+ * before it's shed, the node told when it changes. 0 waits as long as it
+ * takes.
+ */
+int rpc_request_queue_timeout = 0;
+
+static int rpcRequestDeadline = 0;
+static bool rpcRequestDeadlineUnsupported = false;
+
+static void RpcUpdateRequestDeadline() {
+    if(rpc_request_queue_timeout == rpcRequestDeadline || rpcRequestDeadlineUnsupported)
+        return;
+    try {
+        client->RpcSetRequestDeadline(rpc_request_queue_timeout);
+    } catch (TApplicationException &e) {
+        // An older node, it queues without a deadline
+        rpcRequestDeadlineUnsupported = true;
+    }
+    rpcRequestDeadline = rpc_request_queue_timeout;
+}
+
+// Whether e is a call the storage node shed, see storage/rpc_lanes.h, once
+// the time it asked for has passed
+static bool RpcWaitShed(const TApplicationException &e) {
+    const char *what = e.what();
+    size_t len = strlen(RPC_LANE_SHED_MESSAGE);
+
+    if(strncmp(what, RPC_LANE_SHED_MESSAGE, len) != 0)
+        return false;
+    pg_usleep(Max(atoi(what + len), 1) * 1000L);
+    return true;
+}
+
+// Runs call until the storage node takes it
+template <typename Call>
+static void RpcRetryShed(Call call) {
+    for(;;) {
+        try {
+            call();
+            return;
+        } catch (TApplicationException &e) {
+            if(!RpcWaitShed(e))
+                throw;
+        }
+    }
+}
+
+static void RpcConnect()
 {
 #ifdef ENABLE_DEBUG_INFO
     printf("%s Start\n", __func__ );
@@ -224,11 +548,37 @@ void RpcInit()
     int myPid = getpid();
     if(myPid == MyPid)
         return;
-    rpcsocket = std::make_shared<TSocket>(PRIMARY_NODE_IP, 9092);
-    rpctransport = std::make_shared<TBufferedTransport>(rpcsocket);
-    rpcprotocol = std::make_shared<TBinaryProtocol>(rpctransport);
+
+    RpcLoadEndpoints();
+    size_t first = (size_t)myPid % rpcEndpoints.size();
+    std::string host;
+    for(size_t i = 0; i < rpcEndpoints.size(); i++) {
+        const std::pair<std::string, int> &endpoint = rpcEndpoints[(first + i) % rpcEndpoints.size()];
+        rpcsocket = std::make_shared<TSocket>(endpoint.first, endpoint.second);
+        rpctransport = RpcWrapSocket(rpcsocket);
+        try {
+            rpctransport->open();
+            host = endpoint.first;
+            break;
+        } catch (TTransportException &e) {
+            // Last endpoint, let the caller see the failure
+            if(i + 1 == rpcEndpoints.size())
+                throw;
+        }
+    }
+    rpcprotocol = RpcWrapTransport(rpctransport);
     client = new DataPageAccessClient(rpcprotocol);
-    rpctransport->open();
+    RpcNegotiatePageCompression(client);
+    RpcSetUpSharedMemory(client);
+    RpcSetUpRdma(host);
+    // Replies owed on the parent's connection are not ours to read
+    rpcXLogPendingHead = 0;
+    rpcXLogPendingNum = 0;
+    rpcXLogWriteFailed = false;
+    rpcRequestClass = RPC_CLASS_FOREGROUND;
+    rpcRequestClassUnsupported = false;
+    rpcRequestDeadline = 0;
+    rpcRequestDeadlineUnsupported = false;
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s transport created\n", __func__ );
@@ -238,6 +588,76 @@ void RpcInit()
     MyPid = myPid;
 }
 
+static void RpcXLogWriteRecvOne() {
+    int32_t expected = rpcXLogPending[rpcXLogPendingHead];
+
+    rpcXLogPendingHead = (rpcXLogPendingHead + 1) % RPC_XLOG_WINDOW_MAX;
+    rpcXLogPendingNum--;
+    if(client->recv_RpcXLogWrite() != expected)
+        rpcXLogWriteFailed = true;
+}
+
+// Collects the replies of all WAL writes in flight, false if one was short
+static bool RpcXLogWriteDrain() {
+    while(rpcXLogPendingNum > 0)
+        RpcXLogWriteRecvOne();
+    if(rpcXLogWriteFailed) {
+        rpcXLogWriteFailed = false;
+        errno = EIO;
+        return false;
+    }
+    return true;
+}
+
+void RpcInit()
+{
+    RpcConnect();
+    while(rpcXLogPendingNum > 0)
+        RpcXLogWriteRecvOne();
+    RpcUpdateRequestClass();
+    RpcUpdateRequestDeadline();
+}
+
+/*
+ * Connects ahead of the first storage access, for a backend the postmaster
+ * starts before it has a client. False if the node couldn't be reached, the
+ * first access then tries again.
+ */
+bool RpcWarmUp(void) {
+    try {
+        RpcInit();
+    } catch (TException &e) {
+        return false;
+    }
+    return true;
+}
+
+bool RpcXLogWritesComplete(void) {
+    if(MyPid != getpid())
+        return true;
+    return RpcXLogWriteDrain();
+}
+
+/*
+ * A sync of the WAL file goes out behind the writes still in flight, it is
+ * applied after them on the server, and its reply comes after theirs. The
+ * flush then costs one round trip in all rather than one per write plus one.
+ */
+static int32_t RpcSyncBehindXLogWrites(const std::function<void()> &send, const std::function<int32_t()> &recv) {
+    RpcConnect();
+    if(rpcXLogPendingNum == 0 && !RpcXLogWriteDrain())
+        return -1;
+
+    send();
+    bool written = RpcXLogWriteDrain();
+    int32_t result = recv();
+    if(!written) {
+        errno = EIO;
+        return -1;
+    }
+    return result;
+}
+
 void RpcTransportClose() {
     int myPid = getpid();
 #ifdef ENABLE_DEBUG_INFO
@@ -245,8 +665,11 @@ void RpcTransportClose() {
     fflush(stdout);
 #endif
     // Only close transport created by itself
-    if(myPid == MyPid)
+    if(myPid == MyPid) {
+        while(rpcXLogPendingNum > 0)
+            RpcXLogWriteRecvOne();
         rpctransport->close();
+    }
 }
 
 _Smgr_Relation MarshalSmgrRelation2RPC(SMgrRelation reln) {
@@ -279,7 +702,642 @@ public:
                (end.tv_sec*1000000+end.tv_usec) - (start.tv_sec*1000000+start.tv_usec));                            \
     }
 };
-#endif
+#endif
+
+// Reports a wait event for as long as it is in scope, exceptions included
+class RpcWaitEvent {
+public:
+    explicit RpcWaitEvent(uint32 waitEvent) {
+        pgstat_report_wait_start(waitEvent);
+    }
+    ~RpcWaitEvent() {
+        pgstat_report_wait_end();
+    }
+};
+
+// Records how long each of the pages of a fetch took once it returns, see
+// storage/rpc_fetch_cost.h. A fetch that threw, or got no pages, isn't one.
+class RpcFetchTimer {
+public:
+    int pages;
+
+    RpcFetchTimer(const RelFileNode &rnode, RpcFetchKind kind, int pages)
+        : pages(pages), rnode(rnode), kind(kind), start(std::chrono::steady_clock::now()) {}
+    ~RpcFetchTimer() {
+        if(pages <= 0 || std::uncaught_exceptions() > 0)
+            return;
+        auto usec = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        RpcFetchCostRecord(rnode, kind, (uint64_t) usec.count() / pages);
+    }
+
+private:
+    RelFileNode rnode;
+    RpcFetchKind kind;
+    std::chrono::steady_clock::time_point start;
+};
+
+/*
+ * Small direct-mapped cache of pages this backend fetched before, sized in
+ * pages by RPC_PAGE_CACHE_SIZE (0, the default, disables it). A page that is
+ * read again has been evicted from shared buffers, so instead of pulling the
+ * full image we send the cached copy's LSN and let the storage node answer
+ * "not modified" when nothing changed.
+ */
+typedef struct RpcCachedPage {
+    RelFileNode rnode;
+    ForkNumber  forkNum;
+    BlockNumber blockNum;
+    bool        valid;
+    char        page[BLCKSZ];
+} RpcCachedPage;
+
+static RpcCachedPage *rpcPageCache = NULL;
+static int rpcPageCacheSize = -1;
+
+static RpcCachedPage *RpcPageCacheSlot(SMgrRelation reln, ForkNumber forkNum, BlockNumber blockNum) {
+    if(rpcPageCacheSize < 0) {
+        char *size = getenv("RPC_PAGE_CACHE_SIZE");
+        rpcPageCacheSize = (size != NULL && atoi(size) > 0) ? atoi(size) : 0;
+        if(rpcPageCacheSize > 0)
+            rpcPageCache = (RpcCachedPage *) calloc(rpcPageCacheSize, sizeof(RpcCachedPage));
+        if(rpcPageCache == NULL)
+            rpcPageCacheSize = 0;
+    }
+    if(rpcPageCacheSize == 0)
+        return NULL;
+
+    uint64_t hash = ((uint64_t)reln->smgr_rnode.node.relNode * 0x9E3779B1u) ^
+                    ((uint64_t)forkNum << 29) ^ blockNum;
+    return &rpcPageCache[hash % rpcPageCacheSize];
+}
+
+/*
+ * Connections to the storage shards, see storage/shard_map.h. A page read
+ * goes to the shard that owns its block at the LSN read at; shard 0, the
+ * home node, is the main connection. The connection of a shard is opened on
+ * first use and opened again when the map moves the shard elsewhere. A
+ * storage node reading from another shard uses a set of its own on every
+ * thread.
+ */
+class RpcShardSet {
+public:
+    // Client to read the block at lsn through
+    DataPageAccessClient *Route(const RelFileNode &rnode, BlockNumber blkNum, int64_t lsn) {
+        ShardRoute route;
+
+        if(!ShardMapRoute(rnode.spcNode, rnode.dbNode, rnode.relNode, blkNum, (XLogRecPtr) lsn, &route)
+           || route.shard == SHARD_MAP_HOME)
+            return client;
+        return Connect(route.shard);
+    }
+
+    DataPageAccessClient *Connect(int shard) {
+        const char *host;
+        int port;
+
+        pid_t pid = getpid();
+        if(ownerPid != pid) {
+            // The parent's connections are left to the parent
+            shards.clear();
+            ownerPid = pid;
+        }
+        if(!ShardMapEndpoint(shard, &host, &port))
+            throw TException("storage shard without an endpoint");
+
+        Shard &entry = shards[shard];
+        if(entry.client != NULL && entry.host == host && entry.port == port)
+            return entry.client;
+        if(entry.client != NULL) {
+            try {
+                entry.transport->close();
+            } catch (TException &e) {
+            }
+            delete entry.client;
+            entry.client = NULL;
+        }
+        entry.host = host;
+        entry.port = port;
+        entry.transport = RpcWrapSocket(std::make_shared<TSocket>(entry.host, entry.port));
+        entry.transport->open();
+        entry.client = new DataPageAccessClient(RpcWrapTransport(entry.transport));
+        RpcNegotiatePageCompression(entry.client);
+        return entry.client;
+    }
+
+private:
+    struct Shard {
+        std::string host;
+        int port = 0;
+        std::shared_ptr<TTransport> transport;
+        DataPageAccessClient *client = NULL;
+    };
+
+    std::unordered_map<int, Shard> shards;
+    pid_t ownerPid = 0;
+};
+
+static thread_local RpcShardSet rpcShards;
+
+void RpcShardReadPage(int shard, char *buff, RelFileNode rnode, ForkNumber forkNum, BlockNumber blkNum,
+                      XLogRecPtr lsn) {
+    _Smgr_Relation _reln;
+    _Page _return;
+
+    _reln._spc_node = rnode.spcNode;
+    _reln._db_node = rnode.dbNode;
+    _reln._rel_node = rnode.relNode;
+    _reln._backend_id = InvalidBackendId;
+    RpcCallReadBufferCommon(rpcShards.Connect(shard), _return, _reln, RELPERSISTENCE_PERMANENT, forkNum, blkNum,
+                            RBM_NORMAL | SHARD_MAP_FORWARDED_READ, (int64_t) lsn, (int64_t) StageTimingTraceId());
+    RpcPageCopy(_return, StageTimingTraceId() != 0, buff);
+}
+
+/*
+ * Prefetch requests are collected per backend and shipped in one
+ * PrefetchBuffers call when RPC_PREFETCH_BATCH blocks of one relation fork
+ * are pending, when the relation fork changes, or right before the next
+ * page read so that the storage node starts replaying them early.
+ */
+#define RPC_PREFETCH_BATCH 16
+
+static RelFileNodeBackend rpcPrefetchRnode;
+static ForkNumber rpcPrefetchFork = InvalidForkNumber;
+static std::vector<int64_t> rpcPrefetchBlocks;
+
+static void RpcFlushPrefetch(BlockNumber skipBlock) {
+    if(rpcPrefetchBlocks.empty())
+        return;
+
+    // The block about to be read on demand gains nothing from a prefetch
+    for(size_t i = 0; i < rpcPrefetchBlocks.size(); i++) {
+        if(rpcPrefetchBlocks[i] == (int64_t) skipBlock) {
+            rpcPrefetchBlocks.erase(rpcPrefetchBlocks.begin() + i);
+            break;
+        }
+    }
+
+    if(!rpcPrefetchBlocks.empty()) {
+        _Smgr_Relation _reln;
+        _reln._rel_node = rpcPrefetchRnode.node.relNode;
+        _reln._spc_node = rpcPrefetchRnode.node.spcNode;
+        _reln._db_node = rpcPrefetchRnode.node.dbNode;
+        _reln._backend_id = rpcPrefetchRnode.backend;
+        int64_t lsn = GetLogWrtResultLsn();
+        try {
+            rpcShards.Route(rpcPrefetchRnode.node, (BlockNumber) rpcPrefetchBlocks[0], lsn)
+                ->PrefetchBuffers(_reln, rpcPrefetchFork, rpcPrefetchBlocks, lsn);
+        } catch (TApplicationException &e) {
+            // A shed prefetch is only a hint lost
+            if(strncmp(e.what(), RPC_LANE_SHED_MESSAGE, strlen(RPC_LANE_SHED_MESSAGE)) != 0)
+                throw;
+        }
+    }
+    rpcPrefetchBlocks.clear();
+}
+
+void RpcPrefetchBuffer(SMgrRelation reln, ForkNumber forkNum, BlockNumber blockNum) {
+    RpcInit();
+
+    if(!rpcPrefetchBlocks.empty() && (!RelFileNodeBackendEquals(rpcPrefetchRnode, reln->smgr_rnode) || rpcPrefetchFork != forkNum))
+        RpcFlushPrefetch(InvalidBlockNumber);
+
+    rpcPrefetchRnode = reln->smgr_rnode;
+    rpcPrefetchFork = forkNum;
+    rpcPrefetchBlocks.push_back(blockNum);
+
+    if(rpcPrefetchBlocks.size() >= RPC_PREFETCH_BATCH)
+        RpcFlushPrefetch(InvalidBlockNumber);
+}
+
+/*
+ * Pages written without WAL are collected per backend the same way and
+ * shipped in one InstallPages call when RPC_INSTALL_BATCH blocks of one
+ * relation fork are pending, when the relation fork changes, before this
+ * backend reads the relation back, and at smgrimmedsync. They go in at the
+ * LSN the first of them was written at, which every later read of the
+ * backend is at or past.
+ */
+#define RPC_INSTALL_BATCH 32
+
+static RelFileNodeBackend rpcInstallRnode;
+static ForkNumber rpcInstallFork = InvalidForkNumber;
+static std::vector<int64_t> rpcInstallBlocks;
+static std::string rpcInstallPages;
+static int64_t rpcInstallLsn;
+
+void RpcFlushInstalls(void) {
+    if(rpcInstallBlocks.empty())
+        return;
+
+    _Smgr_Relation _reln;
+    _reln._rel_node = rpcInstallRnode.node.relNode;
+    _reln._spc_node = rpcInstallRnode.node.spcNode;
+    _reln._db_node = rpcInstallRnode.node.dbNode;
+    _reln._backend_id = rpcInstallRnode.backend;
+    DataPageAccessClient *installClient = rpcShards.Route(rpcInstallRnode.node, (BlockNumber) rpcInstallBlocks[0],
+                                                          rpcInstallLsn);
+    RpcRetryShed([&] {
+        installClient->InstallPages(_reln, rpcInstallFork, rpcInstallBlocks, rpcInstallPages, rpcInstallLsn);
+    });
+    rpcInstallBlocks.clear();
+    rpcInstallPages.clear();
+}
+
+// Ships the pending pages first if they are of reln
+static void RpcFlushInstallsOf(SMgrRelation reln) {
+    if(!rpcInstallBlocks.empty() && RelFileNodeBackendEquals(rpcInstallRnode, reln->smgr_rnode))
+        RpcFlushInstalls();
+}
+
+void RpcInstallPage(SMgrRelation reln, ForkNumber forkNum, BlockNumber blockNum, const char* buffer) {
+    RpcInit();
+
+    if(!rpcInstallBlocks.empty() && (!RelFileNodeBackendEquals(rpcInstallRnode, reln->smgr_rnode) || rpcInstallFork != forkNum))
+        RpcFlushInstalls();
+
+    // A page written again replaces the pending image
+    for(size_t i = 0; i < rpcInstallBlocks.size(); i++) {
+        if(rpcInstallBlocks[i] == (int64_t) blockNum) {
+            rpcInstallPages.replace(i * BLCKSZ, BLCKSZ, buffer, BLCKSZ);
+            return;
+        }
+    }
+
+    if(rpcInstallBlocks.empty())
+        rpcInstallLsn = GetLogWrtResultLsn();
+    rpcInstallRnode = reln->smgr_rnode;
+    rpcInstallFork = forkNum;
+    rpcInstallBlocks.push_back(blockNum);
+    rpcInstallPages.append(buffer, BLCKSZ);
+
+    if(rpcInstallBlocks.size() >= RPC_INSTALL_BATCH)
+        RpcFlushInstalls();
+}
+
+/*
+ * With rpc_install_evicted_pages, clean pages this backend evicts are
+ * collected the same way and shipped in one InstallEvictedPages call when
+ * RPC_EVICTED_BATCH blocks of one relation fork are pending, or when the
+ * relation fork changes. The storage node only queues them, so the backend
+ * doesn't wait for the install; a batch it sheds or can't queue is dropped,
+ * the pages are replayed when read as before.
+ */
+#define RPC_EVICTED_BATCH 32
+
+bool rpc_install_evicted_pages = false;
+
+static RelFileNode rpcEvictedRnode;
+static ForkNumber rpcEvictedFork = InvalidForkNumber;
+static std::vector<int64_t> rpcEvictedBlocks;
+static std::string rpcEvictedPages;
+
+static void RpcFlushEvicted(void) {
+    if(rpcEvictedBlocks.empty())
+        return;
+
+    _Smgr_Relation _reln;
+    _reln._rel_node = rpcEvictedRnode.relNode;
+    _reln._spc_node = rpcEvictedRnode.spcNode;
+    _reln._db_node = rpcEvictedRnode.dbNode;
+    _reln._backend_id = InvalidBackendId;
+    int64_t lsn = GetLogWrtResultLsn();
+    try {
+        rpcShards.Route(rpcEvictedRnode, (BlockNumber) rpcEvictedBlocks[0], lsn)
+            ->InstallEvictedPages(_reln, rpcEvictedFork, rpcEvictedBlocks, rpcEvictedPages, lsn);
+    } catch (TApplicationException &e) {
+        if(strncmp(e.what(), RPC_LANE_SHED_MESSAGE, strlen(RPC_LANE_SHED_MESSAGE)) != 0)
+            throw;
+    }
+    rpcEvictedBlocks.clear();
+    rpcEvictedPages.clear();
+}
+
+void RpcInstallEvictedPage(RelFileNode rnode, ForkNumber forkNum, BlockNumber blockNum, const char* buffer) {
+    RpcInit();
+
+    if(!rpcEvictedBlocks.empty() && (!RelFileNodeEquals(rpcEvictedRnode, rnode) || rpcEvictedFork != forkNum))
+        RpcFlushEvicted();
+
+    rpcEvictedRnode = rnode;
+    rpcEvictedFork = forkNum;
+    rpcEvictedBlocks.push_back(blockNum);
+    rpcEvictedPages.append(buffer, BLCKSZ);
+
+    if(rpcEvictedBlocks.size() >= RPC_EVICTED_BATCH)
+        RpcFlushEvicted();
+}
+
+/*
+ * Read routing across storage replicas, on when RPC_READ_ROUTING is set.
+ * Every endpoint of RPC_SERVER_ENDPOINTS is taken to hold the same data. A
+ * backend opens a read connection to each of them when it first reads, and
+ * every RPC_READ_HEARTBEAT_MS asks each for its metrics to learn how far it
+ * has parsed WAL. A page read at an LSN goes to the replica with the lowest
+ * smoothed latency of those parsed past it, so it never waits in WaitParse;
+ * if none is, the read goes over the main connection as before.
+ *
+ * A read not answered within the p99 latency of its replica, and at least
+ * RPC_READ_HEDGE_MIN_US, is sent to the next best replica as well, and the
+ * first reply wins. The other reply is read and dropped before its
+ * connection is picked again. Writes and metadata calls stay on the main
+ * connection.
+ */
+#define RPC_READ_LATENCY_SAMPLES 128
+#define RPC_READ_TIMEOUT_MS 1000
+#define RPC_READ_RETRY_MS 1000
+#define RPC_READ_PARSE_GAUGE "openaurora_xlog_parse_upto_lsn "
+
+class RpcReadReplicaSet {
+public:
+    // Fills page and returns true if a replica answered the read
+    bool Read(_Page &page, const _Smgr_Relation &reln, int32_t relpersistence, int32_t forkNum,
+              int32_t blkNum, int32_t mode, int64_t lsn, int64_t traceId) {
+        if(!Enabled())
+            return false;
+        Heartbeat();
+
+        int first = Pick(lsn, -1);
+        if(first < 0)
+            return false;
+        Replica *a = replicas[first];
+        Clock::time_point start = Clock::now();
+        if(!Send(a, reln, relpersistence, forkNum, blkNum, mode, lsn, traceId))
+            return false;
+
+        // Wait for the first replica up to its deadline, then hedge
+        Replica *winner = a;
+        Replica *b = NULL;
+        if(a->p99Us > 0 && !Readable(a, (int)(a->p99Us / 1000))) {
+            int second = Pick(lsn, first);
+            if(second >= 0 && Send(replicas[second], reln, relpersistence, forkNum, blkNum, mode, lsn, traceId)) {
+                b = replicas[second];
+                winner = FirstReadable(a, b);
+            }
+        }
+        Replica *loser = (b == NULL) ? NULL : (winner == a ? b : a);
+
+        if(Recv(winner, page, start)) {
+            // The slower one is known to take at least as long
+            if(loser != NULL) {
+                loser->owed++;
+                loser->latencyUs = Max(loser->latencyUs, winner->latencyUs);
+            }
+            return true;
+        }
+        // The winner broke, the other one may still answer
+        return loser != NULL && Recv(loser, page, start);
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Replica {
+        std::string host;
+        int port;
+        std::shared_ptr<TSocket> socket;
+        std::shared_ptr<TTransport> transport;
+        DataPageAccessClient *client = NULL;
+        bool connected = false;
+        Clock::time_point retryAt;
+        XLogRecPtr parsedUpto = InvalidXLogRecPtr;
+        // Replies of reads answered elsewhere, to drop
+        int owed = 0;
+        double latencyUs = 0;
+        int64_t p99Us = 0;
+        uint32_t samples[RPC_READ_LATENCY_SAMPLES];
+        int sampleNext = 0;
+        int sampleNum = 0;
+    };
+
+    std::vector<Replica *> replicas;
+    pid_t ownerPid = 0;
+    int enabled = -1;
+    int heartbeatMs = 100;
+    int hedgeMinUs = 500;
+    Clock::time_point lastHeartbeat;
+    _Page dropped;
+
+    bool Enabled() {
+        if(enabled < 0) {
+            char *value;
+
+            enabled = getenv("RPC_READ_ROUTING") != NULL;
+            if((value = getenv("RPC_READ_HEARTBEAT_MS")) != NULL && atoi(value) > 0)
+                heartbeatMs = atoi(value);
+            if((value = getenv("RPC_READ_HEDGE_MIN_US")) != NULL && atoi(value) >= 0)
+                hedgeMinUs = atoi(value);
+        }
+        if(!enabled)
+            return false;
+
+        pid_t pid = getpid();
+        if(ownerPid != pid) {
+            // Connections of the parent are left alone, closing them here
+            // would shut them down under it too
+            replicas.clear();
+            RpcLoadEndpoints();
+            for(const std::pair<std::string, int> &endpoint : rpcEndpoints) {
+                Replica *replica = new Replica();
+                replica->host = endpoint.first;
+                replica->port = endpoint.second;
+                replicas.push_back(replica);
+            }
+            ownerPid = pid;
+            lastHeartbeat = Clock::time_point();
+        }
+        return true;
+    }
+
+    bool Connect(Replica *replica) {
+        if(replica->connected)
+            return true;
+        if(Clock::now() < replica->retryAt)
+            return false;
+        try {
+            replica->socket = std::make_shared<TSocket>(replica->host, replica->port);
+            replica->socket->setConnTimeout(RPC_READ_TIMEOUT_MS);
+            replica->socket->setRecvTimeout(RPC_READ_TIMEOUT_MS);
+            replica->transport = RpcWrapSocket(replica->socket);
+            replica->transport->open();
+        } catch (TException &e) {
+            replica->retryAt = Clock::now() + std::chrono::milliseconds(RPC_READ_RETRY_MS);
+            return false;
+        }
+        delete replica->client;
+        replica->client = new DataPageAccessClient(RpcWrapTransport(replica->transport));
+        try {
+            RpcNegotiatePageCompression(replica->client);
+        } catch (TException &e) {
+            Disconnect(replica);
+            return false;
+        }
+        replica->connected = true;
+        replica->owed = 0;
+        return true;
+    }
+
+    void Disconnect(Replica *replica) {
+        try {
+            replica->transport->close();
+        } catch (TException &e) {
+        }
+        replica->connected = false;
+        replica->parsedUpto = InvalidXLogRecPtr;
+        replica->retryAt = Clock::now() + std::chrono::milliseconds(RPC_READ_RETRY_MS);
+    }
+
+    bool Readable(Replica *replica, int timeoutMs) {
+        struct pollfd pfd;
+
+        pfd.fd = replica->socket->getSocketFD();
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        return poll(&pfd, 1, timeoutMs) > 0;
+    }
+
+    Replica *FirstReadable(Replica *a, Replica *b) {
+        struct pollfd pfds[2];
+
+        pfds[0].fd = a->socket->getSocketFD();
+        pfds[1].fd = b->socket->getSocketFD();
+        pfds[0].events = pfds[1].events = POLLIN;
+        pfds[0].revents = pfds[1].revents = 0;
+        if(poll(pfds, 2, RPC_READ_TIMEOUT_MS) > 0 && pfds[0].revents == 0 && pfds[1].revents != 0)
+            return b;
+        return a;
+    }
+
+    // Drops the replies owed without blocking, false if some are still due
+    bool Settle(Replica *replica) {
+        try {
+            while(replica->owed > 0 && Readable(replica, 0)) {
+                RpcRecvReadBufferCommon(replica->client, dropped);
+                replica->owed--;
+            }
+        } catch (TException &e) {
+            Disconnect(replica);
+            return false;
+        }
+        return replica->owed == 0;
+    }
+
+    int Pick(int64_t lsn, int exclude) {
+        int best = -1;
+
+        for(int i = 0; i < (int)replicas.size(); i++) {
+            Replica *replica = replicas[i];
+
+            if(i == exclude || !replica->connected || replica->parsedUpto < (XLogRecPtr)lsn)
+                continue;
+            if(!Settle(replica))
+                continue;
+            if(best < 0 || replica->latencyUs < replicas[best]->latencyUs)
+                best = i;
+        }
+        return best;
+    }
+
+    bool Send(Replica *replica, const _Smgr_Relation &reln, int32_t relpersistence, int32_t forkNum,
+              int32_t blkNum, int32_t mode, int64_t lsn, int64_t traceId) {
+        try {
+            RpcSendReadBufferCommon(replica->client, reln, relpersistence, forkNum, blkNum, mode, lsn, traceId);
+        } catch (TException &e) {
+            Disconnect(replica);
+            return false;
+        }
+        return true;
+    }
+
+    bool Recv(Replica *replica, _Page &page, Clock::time_point start) {
+        try {
+            RpcRecvReadBufferCommon(replica->client, page);
+        } catch (TException &e) {
+            Disconnect(replica);
+            return false;
+        }
+
+        int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+        replica->latencyUs = replica->sampleNum == 0 ? us : replica->latencyUs * 0.875 + us * 0.125;
+        replica->samples[replica->sampleNext] = (uint32_t)Min(us, (int64_t)PG_UINT32_MAX);
+        replica->sampleNext = (replica->sampleNext + 1) % RPC_READ_LATENCY_SAMPLES;
+        if(replica->sampleNum < RPC_READ_LATENCY_SAMPLES)
+            replica->sampleNum++;
+        return true;
+    }
+
+    // Hedging waits for a full window of samples, a p99 of a few is noise
+    void UpdateDeadline(Replica *replica) {
+        if(replica->sampleNum < RPC_READ_LATENCY_SAMPLES) {
+            replica->p99Us = 0;
+            return;
+        }
+        std::vector<uint32_t> sorted(replica->samples, replica->samples + RPC_READ_LATENCY_SAMPLES);
+        size_t rank = RPC_READ_LATENCY_SAMPLES * 99 / 100;
+        std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+        replica->p99Us = Max((int64_t)sorted[rank], (int64_t)hedgeMinUs);
+    }
+
+    void Heartbeat() {
+        Clock::time_point now = Clock::now();
+
+        if(now - lastHeartbeat < std::chrono::milliseconds(heartbeatMs))
+            return;
+        lastHeartbeat = now;
+
+        for(Replica *replica : replicas) {
+            std::string text;
+
+            if(!Connect(replica) || !Settle(replica))
+                continue;
+            try {
+                replica->client->RpcGetSmartReplayMetrics(text);
+            } catch (TException &e) {
+                Disconnect(replica);
+                continue;
+            }
+            size_t at = text.find(RPC_READ_PARSE_GAUGE);
+            if(at != std::string::npos)
+                replica->parsedUpto = (XLogRecPtr)strtod(text.c_str() + at + strlen(RPC_READ_PARSE_GAUGE), NULL);
+            UpdateDeadline(replica);
+        }
+    }
+};
+
+static RpcReadReplicaSet rpcReadReplicas;
+
+/*
+ * With rpc_verify_page_checksums, a page from the storage node must carry
+ * the checksum the node stamped on it as it served it, and a new page must
+ * be all zeroes, as PageIsVerified() has it. A page damaged on its way over
+ * the network, the shared memory segment or the queue pair is read once
+ * more over TCP, and is an error if that one is bad as well. What the local
+ * caches hand out isn't checked, those pages may have changed here since.
+ */
+bool rpc_verify_page_checksums = false;
+
+static bool RpcPageChecksumOk(char *page, BlockNumber blkno) {
+    if(!PageIsNew((Page) page))
+        return ((PageHeader) page)->pd_checksum == pg_checksum_page(page, blkno);
+    for(int i = 0; i < BLCKSZ; i++)
+        if(page[i] != 0)
+            return false;
+    return true;
+}
+
+static void RpcVerifyPage(char *buff, DataPageAccessClient *pageClient, const _Smgr_Relation &_reln,
+                          int32_t relpersistence, int32_t forkNum, BlockNumber blkno, int32_t mode, int64_t lsn) {
+    _Page page;
+
+    if(!rpc_verify_page_checksums || RpcPageChecksumOk(buff, blkno))
+        return;
+    RpcRetryShed([&] {
+        RpcCallReadBufferCommon(pageClient, page, _reln, relpersistence, forkNum, (int32_t) blkno, mode, lsn, 0);
+    });
+    RpcPageCopy(page, false, buff);
+    if(!RpcPageChecksumOk(buff, blkno))
+        throw TException("storage node sent block " + std::to_string(blkno) + " of relation " +
+                         std::to_string(_reln._rel_node) + " with a bad checksum twice");
+}
 
 void RpcReadBuffer_common(char* buff, SMgrRelation reln, char relpersistence, ForkNumber forkNum,
                           BlockNumber blockNum, ReadBufferMode mode) {
@@ -300,13 +1358,15 @@ void RpcReadBuffer_common(char* buff, SMgrRelation reln, char relpersistence, Fo
     fflush(stdout);
 #endif
 
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    START_TIMING(&start);
-#endif
     RpcInit();
+    RpcWaitEvent waitEvent(WAIT_EVENT_RPC_READ);
+    RpcFetchTimer fetchTimer(reln->smgr_rnode.node, RPC_FETCH_SINGLE, 1);
 
-    _Page _return;
+    RpcFlushInstallsOf(reln);
+    RpcFlushPrefetch(RelFileNodeBackendEquals(rpcPrefetchRnode, reln->smgr_rnode) && rpcPrefetchFork == forkNum
+                     ? blockNum : InvalidBlockNumber);
+
+    _Page &_return = rpcPageBuffer;
     int32_t _forkNum, _blkNum, _relpersistence, _readBufferMode;
 
     _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
@@ -315,12 +1375,87 @@ void RpcReadBuffer_common(char* buff, SMgrRelation reln, char relpersistence, Fo
     _relpersistence = (int32_t)relpersistence;
     _readBufferMode = mode;
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_readbuffer_time[0]), &(client_readbuffer_count[0]))
-#endif
-    client->ReadBufferCommon(_return, _reln, _relpersistence, _forkNum, _blkNum, _readBufferMode, GetLogWrtResultLsn());
+    RpcCachedPage *cached = (mode == RBM_NORMAL) ? RpcPageCacheSlot(reln, forkNum, blockNum) : NULL;
+    BufferTag tag;
+    INIT_BUFFERTAG(tag, reln->smgr_rnode.node, forkNum, blockNum);
+    bool fetched = true;
+    bool current = false;
+    bool traced = false;
+    // From the storage node rather than a local cache
+    bool received = true;
+    int64_t readLsn = GetLogWrtResultLsn();
+    DataPageAccessClient *pageClient = rpcShards.Route(reln->smgr_rnode.node, blockNum, GetLogWrtResultLsn());
+    if(cached != NULL && cached->valid && RelFileNodeEquals(cached->rnode, reln->smgr_rnode.node)
+       && cached->forkNum == forkNum && cached->blockNum == blockNum) {
+        RpcRetryShed([&] {
+            pageClient->ReadBufferIfModified(_return, _reln, _relpersistence, _forkNum, _blkNum, _readBufferMode,
+                                             readLsn, PageGetLSN((Page) cached->page));
+        });
+        RpcCountStorageRead(_return, false);
+        if(_return.empty()) {
+            memcpy(buff, cached->page, BLCKSZ);
+            return;
+        }
+    } else if(mode == RBM_NORMAL && !SmgrIsTemp(reln) && LocalPageCacheGet(&tag, buff, &current)) {
+        // A page not invalidated since it was put, or written at the LSN
+        // read at or later, is current
+        XLogRecPtr lsn = readLsn;
+        if(current || PageGetLSN((Page) buff) >= lsn)
+            fetched = received = false;
+        else {
+            RpcRetryShed([&] {
+                pageClient->ReadBufferIfModified(_return, _reln, _relpersistence, _forkNum, _blkNum, _readBufferMode,
+                                                 lsn, PageGetLSN((Page) buff));
+            });
+            RpcCountStorageRead(_return, false);
+            fetched = received = !_return.empty();
+        }
+    } else {
+        int64_t lsn = readLsn;
+        uint64 traceId = RpcNextTraceId();
+        uint32_t ticket;
+
+        TRACE_POSTGRESQL_STORAGE_READ_START(traceId, forkNum, blockNum, reln->smgr_rnode.node.spcNode,
+                                            reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode,
+                                            (uint64) lsn);
+        if(pageClient == client && RpcShmSubmitRead(_reln, _relpersistence, _forkNum, _blkNum, _readBufferMode,
+                                                    lsn, traceId, &ticket)) {
+            RpcShmReceiveRead(ticket, buff);
+            fetched = false;
+        } else if(pageClient == client && RpcRdmaSubmitRead(_reln, _relpersistence, _forkNum, _blkNum,
+                                                            _readBufferMode, lsn, traceId, &ticket) &&
+                  RpcRdmaReceiveRead(ticket, buff)) {
+            fetched = false;
+        } else {
+            // Only WAL-logged pages are on every replica, which follow the
+            // home node
+            if(mode != RBM_NORMAL || relpersistence != RELPERSISTENCE_PERMANENT || pageClient != client ||
+               !rpcReadReplicas.Read(_return, _reln, _relpersistence, _forkNum, _blkNum, _readBufferMode, lsn,
+                                     (int64_t) traceId))
+                RpcRetryShed([&] {
+                    RpcCallReadBufferCommon(pageClient, _return, _reln, _relpersistence, _forkNum, _blkNum,
+                                            _readBufferMode, lsn, (int64_t) traceId);
+                });
+            traced = true;
+            RpcCountStorageRead(_return, traced);
+        }
+        TRACE_POSTGRESQL_STORAGE_READ_DONE(traceId, forkNum, blockNum, reln->smgr_rnode.node.spcNode,
+                                           reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode,
+                                           fetched ? (int) _return.size() : BLCKSZ);
+    }
 
-    _return.copy(buff, BLCKSZ);
+    if(fetched)
+        RpcPageCopy(_return, traced, buff);
+    if(received)
+        RpcVerifyPage(buff, pageClient, _reln, _relpersistence, _forkNum, blockNum, _readBufferMode, readLsn);
+
+    if(cached != NULL) {
+        cached->rnode = reln->smgr_rnode.node;
+        cached->forkNum = forkNum;
+        cached->blockNum = blockNum;
+        cached->valid = true;
+        memcpy(cached->page, buff, BLCKSZ);
+    }
 
 #ifdef DEBUG_TIMING2
     gettimeofday(&end, NULL);
@@ -329,9 +1464,6 @@ void RpcReadBuffer_common(char* buff, SMgrRelation reln, char relpersistence, Fo
     fflush(stdout);
 #endif
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_readbuffer_time[1]), &(client_readbuffer_count[1]))
-#endif
 #ifdef ENABLE_DEBUG_INFO
     printf("%s End, spc=%u, db=%u, rel=%u, forkNum=%d, blk=%u, lsn = %lu\n", __func__, reln->smgr_rnode.node.spcNode,
            reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode, forkNum, blockNum, GetLogWrtResultLsn());
@@ -339,6 +1471,322 @@ void RpcReadBuffer_common(char* buff, SMgrRelation reln, char relpersistence, Fo
 #endif
 }
 
+/*
+ * Fetch up to nblocks consecutive pages starting at firstBlock in one round
+ * trip. buffs must hold nblocks*BLCKSZ bytes. All pages are materialized at
+ * lsn. Returns the number of pages copied, which is smaller than nblocks when
+ * the range runs past the end of the relation.
+ */
+int RpcReadBufferBatch(char* buffs, SMgrRelation reln, char relpersistence, ForkNumber forkNum,
+                       BlockNumber firstBlock, int nblocks, ReadBufferMode mode, uint64_t lsn) {
+#ifdef ENABLE_DEBUG_INFO
+    printf("%s Start, spc=%u, db=%u, rel=%u, forkNum=%d, blk=%u, nblocks=%d, lsn = %lu\n", __func__, reln->smgr_rnode.node.spcNode,
+           reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode, forkNum, firstBlock, nblocks, lsn);
+    fflush(stdout);
+#endif
+    RpcInit();
+    RpcWaitEvent waitEvent(WAIT_EVENT_RPC_READ);
+    RpcFetchTimer fetchTimer(reln->smgr_rnode.node, RPC_FETCH_BATCHED, 0);
+    RpcFlushInstallsOf(reln);
+
+    // A segment is on one shard, the batch stops at its end
+    if(ShardMapActive())
+        nblocks = Min(nblocks, (int)(RELSEG_SIZE - firstBlock % RELSEG_SIZE));
+
+    std::vector<_Page> _return;
+    std::vector<int64_t> _blknums(nblocks);
+
+    _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
+    for(int i = 0; i < nblocks; i++)
+        _blknums[i] = (int64_t)firstBlock + i;
+
+    DataPageAccessClient *batchClient = rpcShards.Route(reln->smgr_rnode.node, firstBlock, lsn);
+    RpcRetryShed([&] {
+        batchClient->ReadBufferBatch(_return, _reln, (int32_t)relpersistence, forkNum, _blknums, mode, lsn);
+    });
+
+    int count = 0;
+    for(; count < (int)_return.size() && count < nblocks; count++) {
+        RpcPageCopy(_return[count], false, buffs + (size_t)count * BLCKSZ);
+        RpcCountStorageRead(_return[count], false);
+    }
+    for(int i = 0; i < count; i++)
+        RpcVerifyPage(buffs + (size_t)i * BLCKSZ, batchClient, _reln, (int32_t)relpersistence, forkNum,
+                      firstBlock + i, mode, (int64_t)lsn);
+
+    fetchTimer.pages = count;
+    return count;
+}
+
+/*
+ * Fetch the first pages, up to maxBlocks, of the fork of each of nrels
+ * relations in one round trip. Relation i's pages go to buffs + i *
+ * maxBlocks * BLCKSZ and their number to counts[i]. All pages are
+ * materialized at lsn.
+ */
+void RpcReadRelationHeads(char* buffs, int* counts, const RelFileNode* rnodes, int nrels, ForkNumber forkNum,
+                          int maxBlocks, uint64_t lsn) {
+    RpcInit();
+
+    std::vector<_Page> _return;
+    std::vector<_Smgr_Relation> _relns(nrels);
+
+    for(int i = 0; i < nrels; i++) {
+        _relns[i]._spc_node = rnodes[i].spcNode;
+        _relns[i]._db_node = rnodes[i].dbNode;
+        _relns[i]._rel_node = rnodes[i].relNode;
+        _relns[i]._backend_id = InvalidBackendId;
+    }
+
+    client->ReadRelationHeads(_return, _relns, forkNum, maxBlocks, lsn);
+
+    if(_return.empty() || _return[0].size() != sizeof(int32_t) * nrels)
+        throw TException("storage node sent relation heads of other relations");
+    size_t next = 1;
+    for(int i = 0; i < nrels; i++) {
+        int32_t count;
+
+        memcpy(&count, _return[0].data() + sizeof(int32_t) * i, sizeof(int32_t));
+        if(count < 0 || count > maxBlocks || next + count > _return.size())
+            throw TException("storage node sent relation heads of other relations");
+        for(int j = 0; j < count; j++, next++) {
+            RpcPageCopy(_return[next], false, buffs + ((size_t)i * maxBlocks + j) * BLCKSZ);
+            RpcCountStorageRead(_return[next], false);
+        }
+        counts[i] = count;
+    }
+    for(int i = 0; i < nrels; i++)
+        for(int j = 0; j < counts[i]; j++)
+            RpcVerifyPage(buffs + ((size_t)i * maxBlocks + j) * BLCKSZ, client, _relns[i], RELPERSISTENCE_PERMANENT,
+                          forkNum, (BlockNumber) j, RBM_NORMAL, (int64_t)lsn);
+}
+
+/*
+ * The pages of blocks [firstBlock, endBlock) the storage node found a tuple
+ * qual may be true for, at most maxPages of them into buffs and their
+ * numbers into blocks. *nextBlock is where the node stopped. -1 if the node
+ * has no ScanRelation, the caller reads the blocks itself then.
+ */
+int RpcScanRelation(char* buffs, BlockNumber* blocks, BlockNumber* nextBlock, SMgrRelation reln,
+                    BlockNumber firstBlock, BlockNumber endBlock, const RpcScanQual* qual, int maxPages,
+                    uint64_t lsn) {
+    RpcInit();
+    RpcFlushInstallsOf(reln);
+
+    std::vector<_Page> _return;
+    _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
+    std::string _qual((const char *) qual, sizeof(RpcScanQual));
+
+    try {
+        client->ScanRelation(_return, _reln, (int32_t) firstBlock, (int32_t) endBlock, _qual, maxPages, lsn);
+    } catch (TApplicationException &e) {
+        return -1;
+    }
+
+    if(_return.empty() || _return[0].size() % sizeof(int32_t) != 0 ||
+       _return[0].size() / sizeof(int32_t) != _return.size() ||
+       (int) _return.size() - 1 > maxPages)
+        throw TException("storage node sent a scan of other blocks");
+
+    int32_t next;
+    memcpy(&next, _return[0].data(), sizeof(int32_t));
+    *nextBlock = (BlockNumber) next;
+    for(size_t i = 1; i < _return.size(); i++) {
+        int32_t blkno;
+
+        memcpy(&blkno, _return[0].data() + sizeof(int32_t) * i, sizeof(int32_t));
+        if((BlockNumber) blkno < firstBlock || (BlockNumber) blkno >= endBlock)
+            throw TException("storage node sent a scan of other blocks");
+        blocks[i - 1] = (BlockNumber) blkno;
+        RpcPageCopy(_return[i], false, buffs + (i - 1) * BLCKSZ);
+        RpcCountStorageRead(_return[i], false);
+    }
+    return (int) _return.size() - 1;
+}
+
+/*
+ * The partial states of spec's aggregates over the all-visible pages of
+ * blocks [firstBlock, endBlock), and the other blocks of the range the node
+ * got to, at most maxFallback of them, for the caller to add. *nextBlock is
+ * where the node stopped. Returns how many blocks there are then, or -1 if
+ * the node has no AggregateRelation.
+ */
+int RpcAggregateRelation(RpcAggState* states, BlockNumber* fallback, BlockNumber* nextBlock, SMgrRelation reln,
+                         BlockNumber firstBlock, BlockNumber endBlock, const RpcAggSpec* spec, int maxFallback,
+                         uint64_t lsn) {
+    RpcInit();
+    RpcFlushInstallsOf(reln);
+
+    std::string _return;
+    _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
+    std::string _spec((const char *) spec, sizeof(RpcAggSpec));
+    RpcAggReply reply;
+
+    try {
+        client->AggregateRelation(_return, _reln, (int32_t) firstBlock, (int32_t) endBlock, _spec, maxFallback, lsn);
+    } catch (TApplicationException &e) {
+        return -1;
+    }
+
+    if(_return.size() < sizeof(reply))
+        throw TException("storage node sent an aggregate of other blocks");
+    memcpy(&reply, _return.data(), sizeof(reply));
+    if(reply.nfallback < 0 || reply.nfallback > maxFallback ||
+       _return.size() != sizeof(reply) + reply.nfallback * sizeof(int32_t))
+        throw TException("storage node sent an aggregate of other blocks");
+
+    for(int i = 0; i < reply.nfallback; i++) {
+        int32_t blkno;
+
+        memcpy(&blkno, _return.data() + sizeof(reply) + sizeof(int32_t) * i, sizeof(int32_t));
+        if((BlockNumber) blkno < firstBlock || (BlockNumber) blkno >= endBlock)
+            throw TException("storage node sent an aggregate of other blocks");
+        fallback[i] = (BlockNumber) blkno;
+    }
+    memcpy(states, reply.states, sizeof(RpcAggState) * Min(spec->naggs, RPC_AGG_MAX_AGGS));
+    *nextBlock = (BlockNumber) reply.nextBlock;
+    return reply.nfallback;
+}
+
+/*
+ * The pages of blocks [firstBlock, endBlock) the first pass of a vacuum
+ * with horizon's cutoffs needn't read, up to where the node got to,
+ * *nextBlock, and the dead offsets of all of them, at most maxDead. entries
+ * must have room for endBlock - firstBlock. Returns how many pages there
+ * are, or -1 if the node has no TriageVacuum.
+ */
+int RpcTriageVacuum(RpcVacuumEntry* entries, uint16_t* dead, BlockNumber* nextBlock, SMgrRelation reln,
+                    BlockNumber firstBlock, BlockNumber endBlock, const RpcVacuumHorizon* horizon, int maxDead,
+                    uint64_t lsn) {
+    RpcInit();
+    RpcFlushInstallsOf(reln);
+
+    std::string _return;
+    _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
+    std::string _horizon((const char *) horizon, sizeof(RpcVacuumHorizon));
+    RpcVacuumReply reply;
+    int32_t ndead = 0;
+
+    try {
+        client->TriageVacuum(_return, _reln, (int32_t) firstBlock, (int32_t) endBlock, _horizon, maxDead, lsn);
+    } catch (TApplicationException &e) {
+        return -1;
+    }
+
+    if(_return.size() < sizeof(reply))
+        throw TException("storage node sent a triage of other blocks");
+    memcpy(&reply, _return.data(), sizeof(reply));
+    if(reply.nentries < 0 || (uint32_t) reply.nentries > endBlock - firstBlock ||
+       _return.size() < sizeof(reply) + reply.nentries * sizeof(RpcVacuumEntry))
+        throw TException("storage node sent a triage of other blocks");
+    memcpy(entries, _return.data() + sizeof(reply), reply.nentries * sizeof(RpcVacuumEntry));
+
+    for(int i = 0; i < reply.nentries; i++) {
+        if((BlockNumber) entries[i].blkno < firstBlock || (BlockNumber) entries[i].blkno >= endBlock ||
+           (i > 0 && entries[i].blkno <= entries[i - 1].blkno) ||
+           entries[i].ndead < 0 || entries[i].ndead > maxDead - ndead)
+            throw TException("storage node sent a triage of other blocks");
+        ndead += entries[i].ndead;
+    }
+    if(_return.size() != sizeof(reply) + reply.nentries * sizeof(RpcVacuumEntry) + ndead * sizeof(uint16_t))
+        throw TException("storage node sent a triage of other blocks");
+    memcpy(dead, _return.data() + sizeof(reply) + reply.nentries * sizeof(RpcVacuumEntry), ndead * sizeof(uint16_t));
+    *nextBlock = (BlockNumber) reply.nextBlock;
+    return reply.nentries;
+}
+
+/*
+ * Fetch nblocks arbitrary pages with all requests in flight at once. The
+ * requests are written back-to-back on the connection and the replies are
+ * collected afterwards. The server answers the requests of one connection
+ * in order, so replies land in blocks[] order. buffs must hold
+ * nblocks*BLCKSZ bytes.
+ */
+void RpcReadBufferPipelined(char* buffs, SMgrRelation reln, char relpersistence, ForkNumber forkNum,
+                            const BlockNumber* blocks, int nblocks, ReadBufferMode mode) {
+#ifdef ENABLE_DEBUG_INFO
+    printf("%s Start, spc=%u, db=%u, rel=%u, forkNum=%d, nblocks=%d\n", __func__, reln->smgr_rnode.node.spcNode,
+           reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode, forkNum, nblocks);
+    fflush(stdout);
+#endif
+    RpcInit();
+    // Pages in flight together, but each at a block of its own
+    RpcFetchTimer fetchTimer(reln->smgr_rnode.node, RPC_FETCH_SINGLE, nblocks);
+    RpcFlushInstallsOf(reln);
+
+    _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
+    int64_t lsn = GetLogWrtResultLsn();
+    // Each shard answers its own requests in order
+    std::vector<DataPageAccessClient *> clients(nblocks);
+    std::vector<uint64> traceIds(nblocks);
+    // Ticket of a read put in the shared memory segment or sent over the
+    // queue pair, the rest go over TCP
+    std::vector<int64_t> tickets(nblocks, -1);
+    std::vector<int64_t> rdmaTickets(nblocks, -1);
+    // Reads the queue pair failed, made over TCP once the replies sent for are in
+    std::vector<int> retries;
+
+    for(int i = 0; i < nblocks; i++) {
+        uint32_t ticket;
+
+        traceIds[i] = RpcNextTraceId();
+        TRACE_POSTGRESQL_STORAGE_READ_START(traceIds[i], forkNum, blocks[i], reln->smgr_rnode.node.spcNode,
+                                            reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode,
+                                            (uint64) lsn);
+        clients[i] = rpcShards.Route(reln->smgr_rnode.node, blocks[i], lsn);
+        if(clients[i] == client && RpcShmSubmitRead(_reln, (int32_t)relpersistence, forkNum, blocks[i], mode, lsn,
+                                                    traceIds[i], &ticket))
+            tickets[i] = ticket;
+        else if(clients[i] == client && RpcRdmaSubmitRead(_reln, (int32_t)relpersistence, forkNum, blocks[i], mode,
+                                                          lsn, traceIds[i], &ticket))
+            rdmaTickets[i] = ticket;
+        else
+            RpcSendReadBufferCommon(clients[i], _reln, (int32_t)relpersistence, forkNum, blocks[i], mode, lsn,
+                                    (int64_t) traceIds[i]);
+    }
+
+    for(int i = 0; i < nblocks; i++) {
+        _Page &_return = rpcPageBuffer;
+        int size = BLCKSZ;
+
+        if(tickets[i] >= 0)
+            RpcShmReceiveRead((uint32_t) tickets[i], buffs + (size_t)i * BLCKSZ);
+        else if(rdmaTickets[i] >= 0) {
+            if(!RpcRdmaReceiveRead((uint32_t) rdmaTickets[i], buffs + (size_t)i * BLCKSZ)) {
+                retries.push_back(i);
+                continue;
+            }
+        } else {
+            RpcRecvReadBufferCommon(clients[i], _return);
+            RpcPageCopy(_return, true, buffs + (size_t)i * BLCKSZ);
+            RpcCountStorageRead(_return, true);
+            size = (int) _return.size();
+        }
+        TRACE_POSTGRESQL_STORAGE_READ_DONE(traceIds[i], forkNum, blocks[i], reln->smgr_rnode.node.spcNode,
+                                           reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode,
+                                           size);
+    }
+
+    for(int i : retries) {
+        _Page &_return = rpcPageBuffer;
+
+        RpcRetryShed([&] {
+            RpcCallReadBufferCommon(client, _return, _reln, (int32_t)relpersistence, forkNum, blocks[i], mode, lsn,
+                                    (int64_t) traceIds[i]);
+        });
+        RpcPageCopy(_return, true, buffs + (size_t)i * BLCKSZ);
+        RpcCountStorageRead(_return, true);
+        TRACE_POSTGRESQL_STORAGE_READ_DONE(traceIds[i], forkNum, blocks[i], reln->smgr_rnode.node.spcNode,
+                                           reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode,
+                                           (int) _return.size());
+    }
+
+    // Once every reply sent for is in, the connections are free again
+    for(int i = 0; i < nblocks; i++)
+        RpcVerifyPage(buffs + (size_t)i * BLCKSZ, clients[i], _reln, (int32_t)relpersistence, forkNum, blocks[i],
+                      mode, lsn);
+}
+
 int32_t RpcRegisterSecondaryNode(bool primary, int64_t lsn){
     RpcInit();
     return client->RpcRegisterSecondaryNode(primary, lsn);
@@ -349,6 +1797,16 @@ void RpcSecondaryNodeUpdatesLsn(int32_t node_id, int64_t lsn){
     client->RpcSecondaryNodeUpdatesLsn(node_id, lsn);
 }
 
+int32_t RpcSecondaryNodeHeartbeat(int32_t node_id, int64_t lsn){
+    RpcInit();
+    return client->RpcSecondaryNodeHeartbeat(node_id, lsn);
+}
+
+int64_t RpcWaitWalParsed(int64_t lsn, int32_t wait_ms){
+    RpcInit();
+    return client->RpcWaitWalParsed(wait_ms, lsn);
+}
+
 void RpcMdRead(char* buff, SMgrRelation reln, ForkNumber forknum, BlockNumber blknum) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
@@ -363,12 +1821,9 @@ void RpcMdRead(char* buff, SMgrRelation reln, ForkNumber forknum, BlockNumber bl
     fflush(stdout);
 #endif
 
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    START_TIMING(&start);
-#endif
     RpcInit();
-    _Page _return;
+    RpcFlushInstallsOf(reln);
+    _Page &_return = rpcPageBuffer;
     int32_t _forkNum, _blkNum;
     _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
 
@@ -377,15 +1832,11 @@ void RpcMdRead(char* buff, SMgrRelation reln, ForkNumber forknum, BlockNumber bl
     _forkNum = forknum;
     _blkNum = blknum;
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_read_time[0]), &(client_read_count[0]))
-#endif
-    client->RpcMdRead(_return, _reln, _forkNum, _blkNum, GetLogWrtResultLsn());
-    _return.copy(buff, BLCKSZ);
+    RpcRetryShed([&] {
+        RpcCallMdRead(client, _return, _reln, _forkNum, _blkNum, GetLogWrtResultLsn());
+    });
+    RpcPageCopy(_return, false, buff);
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_read_time[1]), &(client_read_count[1]))
-#endif
 #ifdef ENABLE_DEBUG_INFO
     printf("%s End\n", __func__ );
     fflush(stdout);
@@ -413,22 +1864,12 @@ int32_t RpcMdExists(SMgrRelation reln, int32_t forknum) {
     fflush(stdout);
 #endif
 
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    START_TIMING(&start);
-#endif
     RpcInit();
     _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
     int32_t _forknum = forknum;
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_exist_time[0]), &(client_exist_count[0]))
-#endif
     int32_t result = client->RpcMdExists(_reln, _forknum, GetLogWrtResultLsn());
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_exist_time[1]), &(client_exist_count[1]))
-#endif
 #ifdef ENABLE_DEBUG_INFO
     printf("%s End, exist = %d spc=%u, db=%u, rel=%u, forkNum=%d, lsn=%lu\n", __func__, result, reln->smgr_rnode.node.spcNode,
            reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode, forknum, GetLogWrtResultLsn());
@@ -457,23 +1898,18 @@ int32_t RpcMdNblocks(SMgrRelation reln, int32_t forknum) {
     fflush(stdout);
 #endif
 
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    START_TIMING(&start);
-#endif
     RpcInit();
 
     _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
     int32_t _forknum = forknum;
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_nblocks_time[0]), &(client_nblocks_count[0]))
-#endif
-    int32_t result = client->RpcMdNblocks(_reln, _forknum, GetLogWrtResultLsn());
+    int64_t lsn = GetLogWrtResultLsn();
+    int32_t result;
+    RpcWaitEvent waitEvent(WAIT_EVENT_RPC_NBLOCKS);
+
+    if(!RpcRdmaNblocks(_reln, _forknum, lsn, &result))
+        result = RpcCallMdNblocks(client, _reln, _forknum, lsn);
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_nblocks_time[1]), &(client_nblocks_count[1]))
-#endif
 #ifdef ENABLE_DEBUG_INFO
     printf("%s End, result = %d,  spc=%u, db=%u, rel=%u, forkNum=%d, lsn=%lu\n", __func__,  result, reln->smgr_rnode.node.spcNode,
            reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode, forknum, GetLogWrtResultLsn());
@@ -503,23 +1939,13 @@ void RpcMdCreate(SMgrRelation reln, int32_t forknum, int32_t isRedo) {
     fflush(stdout);
 #endif
 
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    START_TIMING(&start);
-#endif
     RpcInit();
 
     _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
     int32_t _forknum = forknum;
     int32_t _isRedo = isRedo;
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_create_time[0]), &(client_create_count[0]))
-#endif
     client->RpcMdCreate(_reln, _forknum, _isRedo, GetLogWrtResultLsn());
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_create_time[1]), &(client_create_count[1]))
-#endif
 #ifdef ENABLE_DEBUG_INFO
     printf("%s End, spc=%u, db=%u, rel=%u, forkNum=%d, lsn=%lu\n", __func__, reln->smgr_rnode.node.spcNode,
            reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode, forknum, GetLogWrtResultLsn());
@@ -533,6 +1959,31 @@ void RpcMdCreate(SMgrRelation reln, int32_t forknum, int32_t isRedo) {
 #endif
 }
 
+// Extends the relation by nblocks zero pages from startblk, in one call
+void RpcMdExtendMany(SMgrRelation reln, int32_t forknum, int32_t startblk, int32_t nblocks, int32_t skipFsync) {
+#ifdef ENABLE_FUNCTION_TIMING
+    FunctionTiming functionTiming(const_cast<char *>(__func__));
+#endif
+#ifdef ENABLE_DEBUG_INFO
+    printf("%s Start, spc=%u, db=%u, rel=%u, forkNum=%d, blk=%u nblocks=%d\n", __func__, reln->smgr_rnode.node.spcNode,
+           reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode, forknum, startblk, nblocks);
+    fflush(stdout);
+#endif
+
+    RpcInit();
+    _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
+
+    RpcRetryShed([&] {
+        client->RpcMdExtendMany(_reln, forknum, startblk, nblocks, skipFsync, GetLogWrtResultLsn());
+    });
+
+#ifdef ENABLE_DEBUG_INFO
+    printf("%s End, spc=%u, db=%u, rel=%u, forkNum=%d, blk=%u nblocks=%d\n", __func__, reln->smgr_rnode.node.spcNode,
+           reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode, forknum, startblk, nblocks);
+    fflush(stdout);
+#endif
+}
+
 void RpcMdExtend(SMgrRelation reln, int32_t forknum, int32_t blknum, char* buff, int32_t skipFsync) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
@@ -547,10 +1998,6 @@ void RpcMdExtend(SMgrRelation reln, int32_t forknum, int32_t blknum, char* buff,
     fflush(stdout);
 #endif
 
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    START_TIMING(&start);
-#endif
     RpcInit();
     _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
     int32_t _forknum = forknum;
@@ -560,14 +2007,10 @@ void RpcMdExtend(SMgrRelation reln, int32_t forknum, int32_t blknum, char* buff,
 
     _buff.assign(buff, BLCKSZ);
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_extend_time[0]), &(client_extend_count[0]))
-#endif
-    client->RpcMdExtend(_reln, _forknum, _blknum, _buff, _skipFsync, GetLogWrtResultLsn());
+    RpcRetryShed([&] {
+        client->RpcMdExtend(_reln, _forknum, _blknum, _buff, _skipFsync, GetLogWrtResultLsn());
+    });
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_extend_time[1]), &(client_extend_count[1]))
-#endif
 #ifdef ENABLE_DEBUG_INFO
     printf("%s End, spc=%u, db=%u, rel=%u, forkNum=%d, blk=%u pageIsNew=%d\n", __func__, reln->smgr_rnode.node.spcNode,
            reln->smgr_rnode.node.dbNode, reln->smgr_rnode.node.relNode, forknum, blknum, PageIsNew(buff));
@@ -595,22 +2038,13 @@ void RpcMdTruncate(SMgrRelation reln, int32_t forknum, int32_t blknum) {
     fflush(stdout);
 #endif
 
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    START_TIMING(&start);
-#endif
     RpcInit();
+    RpcFlushInstallsOf(reln);
     _Smgr_Relation _reln = MarshalSmgrRelation2RPC(reln);
     int32_t _forknum = forknum;
     int32_t _blknum = blknum;
 
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_truncate_time[0]), &(client_truncate_count[0]))
-#endif
     client->RpcTruncate(_reln, _forknum, _blknum, GetLogWrtResultLsn());
-#ifdef DEBUG_TIMING
-    RECORD_TIMING(&start, &end, &(client_truncate_time[1]), &(client_truncate_count[1]))
-#endif
 #ifdef ENABLE_DEBUG_INFO
     printf("%s End\n", __func__ );
     fflush(stdout);
@@ -626,35 +2060,174 @@ void RpcMdTruncate(SMgrRelation reln, int32_t forknum, int32_t blknum) {
 
 // Following are Rpc interfaces for fd.c
 
+/*
+ * Remote file handles and leased stat results, see storage/rpc_file_cache.h
+ */
+int rpc_small_file_size = 64;
+int rpc_file_metadata_lease = 1000;
+
+#define RPC_CACHED_STATS_MAX (4096)
+
+struct RpcCachedFile {
+    std::string path;
+    int32_t flags;
+    bool transient;
+    std::string data;
+    int64_t pos;
+    // Descriptor on the node, once something needed the file there
+    int32_t serverFd;
+};
+
+struct RpcCachedStat {
+    int result;
+    uint32_t mode;
+    std::chrono::steady_clock::time_point expires;
+};
+
+static std::unordered_map<int, RpcCachedFile> rpcCachedFiles;
+static std::unordered_map<std::string, RpcCachedStat> rpcCachedStats;
+static int rpcNextCachedFd = RPC_CACHED_FD_BASE;
+// The node predates RpcOpenAndReadFile
+static bool rpcOpenAndReadMissing = false;
+
+static void RpcRememberStat(const char *path, int result, uint32_t mode) {
+    if(rpc_file_metadata_lease <= 0)
+        return;
+    if(rpcCachedStats.size() >= RPC_CACHED_STATS_MAX)
+        rpcCachedStats.clear();
+
+    RpcCachedStat &entry = rpcCachedStats[path];
+    entry.result = result;
+    entry.mode = mode;
+    entry.expires = std::chrono::steady_clock::now() + std::chrono::milliseconds(rpc_file_metadata_lease);
+}
+
+static void RpcForgetStat(const char *path) {
+    rpcCachedStats.erase(path);
+}
+
+static RpcCachedFile *RpcCachedFileOf(int fd) {
+    if(fd < RPC_CACHED_FD_BASE)
+        return NULL;
+    auto it = rpcCachedFiles.find(fd);
+    return it == rpcCachedFiles.end() ? NULL : &it->second;
+}
+
+/*
+ * One RpcOpenAndReadFile for a read-only open, false if the open has to go
+ * the usual way. Otherwise *fd is a cached handle, the node's descriptor of
+ * a file too large to send, or -1 with errno set.
+ */
+static bool RpcOpenSmallFile(const char *path, int32_t flags, bool transient, int32_t *fd) {
+    RpcOpenReadReply head;
+    _Page reply;
+    _Path _path;
+
+    if((flags & O_ACCMODE) != O_RDONLY) {
+        // An open for writing may create or truncate it
+        RpcForgetStat(path);
+        return false;
+    }
+    if(rpc_small_file_size <= 0 || rpcOpenAndReadMissing)
+        return false;
+
+    RpcInit();
+    _path.assign(path);
+    try {
+        client->RpcOpenAndReadFile(reply, _path, flags, rpc_small_file_size * 1024, transient);
+    } catch (TApplicationException &e) {
+        rpcOpenAndReadMissing = true;
+        return false;
+    }
+    if(reply.size() < sizeof(head))
+        throw TException("storage node sent a short RpcOpenAndReadFile reply");
+    memcpy(&head, reply.data(), sizeof(head));
+
+    if(head.fd < 0 && !head.complete) {
+        if(head.error == ENOENT)
+            RpcRememberStat(path, -1, 0);
+        errno = head.error;
+        *fd = -1;
+        return true;
+    }
+    RpcRememberStat(path, 0, head.mode);
+    if(!head.complete) {
+        *fd = head.fd;
+        return true;
+    }
+
+    RpcCachedFile &file = rpcCachedFiles[rpcNextCachedFd];
+    file.path = path;
+    file.flags = flags;
+    file.transient = transient;
+    file.data.assign(reply, sizeof(head), std::string::npos);
+    file.pos = 0;
+    file.serverFd = -1;
+    *fd = rpcNextCachedFd++;
+    return true;
+}
+
+static int32_t RpcCachedFileRead(RpcCachedFile *file, char *p, int32_t amount, int32_t offset) {
+    int64_t from = offset == -1 ? file->pos : offset;
+    int64_t n = 0;
+
+    if(from < (int64_t) file->data.size())
+        n = Min((int64_t) amount, (int64_t) file->data.size() - from);
+    if(n > 0)
+        memcpy(p, file->data.data() + from, n);
+    if(offset == -1)
+        file->pos += n;
+    return (int32_t) n;
+}
+
+// The node's descriptor of fd, opening a cached file there first
+static int32_t RpcServerFd(int fd) {
+    RpcCachedFile *file = RpcCachedFileOf(fd);
+    _Path _path;
+
+    if(file == NULL || file->serverFd >= 0)
+        return file == NULL ? fd : file->serverFd;
+
+    RpcInit();
+    _path.assign(file->path);
+    if(file->transient)
+        file->serverFd = client->RpcOpenTransientFile(_path, file->flags);
+    else
+        file->serverFd = client->RpcBasicOpenFile(_path, file->flags);
+    if(file->serverFd >= 0 && file->pos != 0)
+        client->RpcLseek(file->serverFd, file->pos, SEEK_SET);
+    return file->serverFd;
+}
+
+static int32_t RpcCloseCachedFile(RpcCachedFile *file, int fd) {
+    int32_t result = 0;
+
+    if(file->serverFd >= 0) {
+        RpcInit();
+        if(file->transient)
+            result = client->RpcCloseTransientFile(file->serverFd);
+        else
+            result = client->RpcClose(file->serverFd);
+    }
+    rpcCachedFiles.erase(fd);
+    return result;
+}
+
 void RpcFileClose(const int fd) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
     //rpctransport->open();
     client->RpcFileClose((_File)fd);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return;
 }
 
 void RpcTablespaceCreateDbspace(const int64_t _spcnode, const int64_t _dbnode, const bool isRedo) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
@@ -662,22 +2235,12 @@ void RpcTablespaceCreateDbspace(const int64_t _spcnode, const int64_t _dbnode, c
     //rpctransport->open();
     client->RpcTablespaceCreateDbspace(_spcnode, _dbnode, isRedo);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return;
 }
 
 int RpcPathNameOpenFile(const char* path, const int32_t _flag) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
@@ -688,22 +2251,12 @@ int RpcPathNameOpenFile(const char* path, const int32_t _flag) {
     //rpctransport->open();
     result = client->RpcPathNameOpenFile(_path, _flag);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 int32_t RpcFileWrite(const int _fd, const char* page, const int32_t _amount, const int64_t _seekpos, const int32_t _wait_event_info) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
@@ -713,22 +2266,12 @@ int32_t RpcFileWrite(const int _fd, const char* page, const int32_t _amount, con
     //rpctransport->open();
     result = client->RpcFileWrite(_fd, _page, _amount, _seekpos, _wait_event_info);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 char* RpcFilePathName(const int _fd) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
@@ -740,22 +2283,12 @@ char* RpcFilePathName(const int _fd) {
     client->RpcFilePathName(_return, _fd);
     _return.copy(filename, _return.length());
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return filename;
 }
 
 int RpcFileRead(char *buff, const int _fd, const int32_t _amount,  const int64_t _seekpos, const int32_t _wait_event_info) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 
@@ -764,22 +2297,12 @@ int RpcFileRead(char *buff, const int _fd, const int32_t _amount,  const int64_t
     client->RpcFileRead(_return, _fd, _amount, _seekpos, _wait_event_info);
     //rpctransport->close();
     _return.copy(buff, BLCKSZ);
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return _return.length();
 }
 
 int32_t RpcFileTruncate(const int _fd, const int64_t _offset) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
@@ -788,22 +2311,12 @@ int32_t RpcFileTruncate(const int _fd, const int64_t _offset) {
     //rpctransport->open();
     result = client->RpcFileTruncate(_fd, _offset);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 int64_t RpcFileSize(const int _fd) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start %d , fd = %d\n", __func__ , getpid(), _fd);
@@ -813,22 +2326,12 @@ int64_t RpcFileSize(const int _fd) {
     result = client->RpcFileSize(_fd);
     //rpctransport->close();
 //    printf("[%s] function end %d , result = %d , fd = %d\n", __func__ , getpid(), result, _fd);
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 int32_t RpcFilePrefetch(const int _fd, const int64_t _offset, const int32_t _amount, const int32_t wait_event_info) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
@@ -836,44 +2339,24 @@ int32_t RpcFilePrefetch(const int _fd, const int64_t _offset, const int32_t _amo
     //rpctransport->open();
     result = client->RpcFilePrefetch(_fd, _offset, _amount, wait_event_info);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 void RpcFileWriteback(const int _fd, const int64_t _offset, const int64_t nbytes, const int32_t wait_event_info) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
     //rpctransport->open();
     client->RpcFileWriteback(_fd, _offset, nbytes, wait_event_info);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return;
 }
 
 int32_t RpcUnlink(const char* filepath) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
@@ -881,40 +2364,25 @@ int32_t RpcUnlink(const char* filepath) {
     int32_t result = 0;
 
     _path.assign(filepath);
+    RpcForgetStat(filepath);
 
     //rpctransport->open();
     result = client->RpcUnlink(_path);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 int32_t RpcFtruncate(const int _fd, const int64_t _offset) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
     int32_t result = 0;
 
     //rpctransport->open();
-    result = client->RpcFtruncate(_fd, _offset);
+    result = client->RpcFtruncate(RpcServerFd(_fd), _offset);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
@@ -926,48 +2394,31 @@ int RpcOpenTransientFile(const char* filename, const int32_t _fileflags) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
 #endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
-    RpcInit();
-//    printf("[%s] function start \n", __func__ );
     _File result = 0;
     _Path _filename;
 
+    if(RpcOpenSmallFile(filename, _fileflags, true, &result))
+        return result;
+
+    RpcInit();
+//    printf("[%s] function start \n", __func__ );
     _filename.assign(filename);
 
     //rpctransport->open();
     result = client->RpcOpenTransientFile(_filename, _fileflags);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 int RpcOpenTransientFileUnderPgData(const char* filename, const int32_t _fileflags) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
     _File result = 0;
     _Path _filename;
     _filename.assign(filename);
     result = client->RpcOpenTransientFileUnderPgData(_filename, _fileflags);
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
@@ -975,10 +2426,11 @@ int32_t RpcCloseTransientFile(const int _fd) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
 #endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
+    RpcCachedFile *file = RpcCachedFileOf(_fd);
+
+    if(file != NULL)
+        return RpcCloseCachedFile(file, _fd);
+
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
 
@@ -986,22 +2438,12 @@ int32_t RpcCloseTransientFile(const int _fd) {
     //rpctransport->open();
     result = client->RpcCloseTransientFile(_fd);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 int32_t RpcFileSync(const int _fd, const int32_t _wait_event_info) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
@@ -1010,12 +2452,6 @@ int32_t RpcFileSync(const int _fd, const int32_t _wait_event_info) {
     //rpctransport->open();
     result = client->RpcFileSync(_fd, _wait_event_info);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
@@ -1023,35 +2459,53 @@ int32_t RpcPgPRead(const int _fd, char *p, const int32_t _amount, const int32_t
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
 #endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
+    RpcCachedFile *file = RpcCachedFileOf(_fd);
+
+    if(file != NULL && file->serverFd < 0)
+        return RpcCachedFileRead(file, p, _amount, _offset);
+
     RpcInit();
 
     int32_t result;
     _Page _return;
     //rpctransport->open();
-    client->RpcPgPRead(_return, _fd, _amount, _offset);
+    client->RpcPgPRead(_return, RpcServerFd(_fd), _amount, _offset);
     //rpctransport->close();
     _return.copy(p, _return.length());
 //    printf("[%s] return value = %d\n", __func__ , (int32_t)_return.length());
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return (int32_t)_return.length();
 }
 
+/*
+ * Read num ranges of amount bytes of the file, all requests sent before the
+ * first reply is taken, so they cost one round trip. bufs[i] receives the
+ * range at offsets[i].
+ */
+void RpcPgPReadRanges(const int _fd, char **bufs, const int32_t _amount, const int32_t *offsets, int num) {
+    RpcCachedFile *file = RpcCachedFileOf(_fd);
+
+    if(file != NULL && file->serverFd < 0) {
+        for(int i = 0; i < num; i++)
+            RpcCachedFileRead(file, bufs[i], _amount, offsets[i]);
+        return;
+    }
+
+    RpcInit();
+    int32_t fd = RpcServerFd(_fd);
+
+    for(int i = 0; i < num; i++)
+        client->send_RpcPgPRead(fd, _amount, offsets[i]);
+
+    for(int i = 0; i < num; i++) {
+        _Page &_return = rpcPageBuffer;
+        client->recv_RpcPgPRead(_return);
+        _return.copy(bufs[i], Min((size_t) _amount, _return.length()));
+    }
+}
+
 int32_t RpcPgPWrite(const int _fd, char *p, const int32_t _amount, const int32_t _offset) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
@@ -1060,15 +2514,9 @@ int32_t RpcPgPWrite(const int _fd, char *p, const int32_t _amount, const int32_t
     _Page _page;
     _page.assign(p, _amount);
     //rpctransport->open();
-    result = client->RpcPgPWrite(_fd, _page, _amount, _offset);
+    result = client->RpcPgPWrite(RpcServerFd(_fd), _page, _amount, _offset);
     //rpctransport->close();
 //    printf("[%s] result = %d \n", __func__ , result);
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
@@ -1076,10 +2524,11 @@ int32_t RpcClose(const int _fd) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
 #endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
+    RpcCachedFile *file = RpcCachedFileOf(_fd);
+
+    if(file != NULL)
+        return RpcCloseCachedFile(file, _fd);
+
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
 
@@ -1087,12 +2536,6 @@ int32_t RpcClose(const int _fd) {
     //rpctransport->open();
     result = client->RpcClose(_fd);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
@@ -1100,72 +2543,47 @@ int32_t RpcBasicOpenFile(char *path, int32_t _flags) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
 #endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
-    RpcInit();
-//    printf("[%s] function start , path = %s\n", __func__ , path);
-
     int32_t result;
     _Path _path;
+
+    if(RpcOpenSmallFile(path, _flags, false, &result))
+        return result;
+
+    RpcInit();
+//    printf("[%s] function start , path = %s\n", __func__ , path);
     _path.assign(path);
     //rpctransport->open();
     result = client->RpcBasicOpenFile(_path, _flags);
     //rpctransport->close();
 //    printf("[%s] result = %d\n", __func__ , result);
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 int32_t RpcBasicOpenFileUnderPgData(char *path, int32_t _flags) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
     int32_t result;
     _Path _path;
     _path.assign(path);
     result = client->RpcBasicOpenFileUnderPgData(_path, _flags);
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 int32_t RpcPgFdatasync(const int32_t _fd) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
 
     int32_t result;
     //rpctransport->open();
-    result = client->RpcPgFdatasync(_fd);
+    int32_t fd = RpcServerFd(_fd);
+    result = RpcSyncBehindXLogWrites([&]() { client->send_RpcPgFdatasync(fd); },
+                                     [&]() { return client->recv_RpcPgFdatasync(); });
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
@@ -1173,24 +2591,16 @@ int32_t RpcPgFdatasync(const int32_t _fd) {
 int32_t RpcPgFsyncNoWritethrough(const int32_t _fd) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 //    printf("[%s] function start \n", __func__ );
 
     int32_t result;
     //rpctransport->open();
-    result = client->RpcPgFsyncNoWritethrough(_fd);
+    int32_t fd = RpcServerFd(_fd);
+    result = RpcSyncBehindXLogWrites([&]() { client->send_RpcPgFsyncNoWritethrough(fd); },
+                                     [&]() { return client->recv_RpcPgFsyncNoWritethrough(); });
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
@@ -1198,21 +2608,26 @@ int32_t RpcLseek(const int32_t _fd, const int64_t _offset, const int32_t _flag)
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
 #endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
+    RpcCachedFile *file = RpcCachedFileOf(_fd);
+
+    if(file != NULL && file->serverFd < 0) {
+        int64_t pos = _flag == SEEK_SET ? _offset :
+                      _flag == SEEK_CUR ? file->pos + _offset :
+                      _flag == SEEK_END ? (int64_t) file->data.size() + _offset : -1;
+
+        if(pos < 0) {
+            errno = EINVAL;
+            return -1;
+        }
+        file->pos = pos;
+        return (int32_t) pos;
+    }
+
     RpcInit();
     int32_t result;
     //rpctransport->open();
-    result = client->RpcLseek(_fd, _offset, _flag);
+    result = client->RpcLseek(RpcServerFd(_fd), _offset, _flag);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
 
     return result;
 }
@@ -1221,10 +2636,16 @@ int RpcStat(const char* path, struct stat* _stat) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
 #endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
+    auto cached = rpcCachedStats.find(path);
+
+    if(cached != rpcCachedStats.end()) {
+        if(std::chrono::steady_clock::now() < cached->second.expires) {
+            _stat->st_mode = cached->second.mode;
+            return cached->second.result;
+        }
+        rpcCachedStats.erase(cached);
+    }
+
     RpcInit();
     _Path _path;
     _path.assign(path);
@@ -1234,23 +2655,14 @@ int RpcStat(const char* path, struct stat* _stat) {
     //rpctransport->open();
     client->RpcStat(response, _path);
     //rpctransport->close();
+    RpcRememberStat(path, response._result, response._stat_mode);
     _stat->st_mode = response._stat_mode;
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return response._result;
 }
 
 int32_t RpcDirectoryIsEmpty(const char* path) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
     _Path _path;
@@ -1259,22 +2671,12 @@ int32_t RpcDirectoryIsEmpty(const char* path) {
     //rpctransport->open();
     result = client->RpcDirectoryIsEmpty(_path);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 int32_t RpcCopyDir(const char* _src, const char* _dst) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
     // create another copy of initialized-db in compute node
@@ -1288,63 +2690,63 @@ int32_t RpcCopyDir(const char* _src, const char* _dst) {
     _Path _path_src, _path_dst;
     _path_src.assign(_src);
     _path_dst.assign(_dst);
+    rpcCachedStats.clear();
     int32_t result;
     //rpctransport->open();
     result = client->RpcCopyDir(_path_src, _path_dst);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
 int32_t RpcPgFsync(const int32_t _fd) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
     int32_t result;
     //rpctransport->open();
-    result = client->RpcPgFsync(_fd);
+    int32_t fd = RpcServerFd(_fd);
+    result = RpcSyncBehindXLogWrites([&]() { client->send_RpcPgFsync(fd); },
+                                     [&]() { return client->recv_RpcPgFsync(); });
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
+    return result;
+}
+
+/*
+ * fsyncs num files or directories in one call, which the storage node runs
+ * in parallel. 0 once all are synced, else one plus the index of the first
+ * that wasn't, errno set to EIO.
+ */
+int32_t RpcSyncFiles(const char **paths, int num) {
+#ifdef ENABLE_FUNCTION_TIMING
+    FunctionTiming functionTiming(const_cast<char *>(__func__));
 #endif
+    RpcInit();
+    std::vector<_Path> _paths(paths, paths + num);
+    int32_t result;
+
+    result = RpcSyncBehindXLogWrites([&]() { client->send_RpcSyncFiles(_paths); },
+                                     [&]() { return client->recv_RpcSyncFiles(); });
+    if(result < 0)
+        result = 1;
+    if(result != 0)
+        errno = EIO;
     return result;
 }
 
 int32_t RpcDurableUnlink(const char * filename, const int32_t _flag) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
     _Path _fname;
     _fname.assign(filename);
+    RpcForgetStat(filename);
 
     int32_t result;
     //rpctransport->open();
     result = client->RpcDurableUnlink(_fname, _flag);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 
 }
@@ -1352,27 +2754,19 @@ int32_t RpcDurableUnlink(const char * filename, const int32_t _flag) {
 int32_t RpcDurableRenameExcl(const char* oldFname, const char* newFname, const int32_t _elevel) {
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
-#endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
 #endif
     RpcInit();
 
     _Path _oldFname, _newFname;
     _oldFname.assign(oldFname);
     _newFname.assign(newFname);
+    RpcForgetStat(oldFname);
+    RpcForgetStat(newFname);
 
     int32_t result;
     //rpctransport->open();
     result = client->RpcDurableRenameExcl(_oldFname, _newFname, _elevel);
     //rpctransport->close();
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    uint64_t usec = (end.tv_sec + end.tv_usec*1000000) - (start.tv_sec + start.tv_usec*1000000);
-    printf("%s time cost = %lu\n", __func__ , usec);
-    fflush(stdout);
-#endif
     return result;
 }
 
@@ -1380,19 +2774,44 @@ int32_t RpcXLogWriteWithPosition(const int _fd, char *p, const int32_t _amount,
 #ifdef ENABLE_FUNCTION_TIMING
     FunctionTiming functionTiming(const_cast<char *>(__func__));
 #endif
-    RpcInit();
+    RpcConnect();
 //    printf("[%s] function start \n", __func__ );
 
     int32_t result;
     _Page _page;
-    _page.assign(p, _amount);
+    size_t framelen = 0;
+    if(wal_ship_compression != WAL_SHIP_COMPRESSION_OFF) {
+        _page.resize(WalShipCompressBound(_amount));
+        framelen = WalShipCompress(wal_ship_compression, p, _amount, &_page[0]);
+    }
+    if(framelen > 0)
+        _page.resize(framelen);
+    else
+        _page.assign(p, _amount);
     vector<int64_t> xlblocksVec;
     for(int i = 0; i < blkNum; i++) {
         xlblocksVec.push_back( xlblocks[(startIdx+i) % xlblocksBufferNum] );
     }
 
-    result = client->RpcXLogWrite(_fd, _page, _amount, _offset, xlblocksVec, blkNum, startIdx, lsn);
-    return result;
+    int window = Min(wal_ship_window, RPC_XLOG_WINDOW_MAX);
+    if(window <= 1) {
+        if(!RpcXLogWriteDrain())
+            return -1;
+        result = client->RpcXLogWrite(_fd, _page, _amount, _offset, xlblocksVec, blkNum, startIdx, lsn);
+        return result;
+    }
+
+    // Wait for the oldest write only once the window is full
+    while(rpcXLogPendingNum >= window)
+        RpcXLogWriteRecvOne();
+    if(rpcXLogWriteFailed) {
+        RpcXLogWriteDrain();
+        return -1;
+    }
+    client->send_RpcXLogWrite(_fd, _page, _amount, _offset, xlblocksVec, blkNum, startIdx, lsn);
+    rpcXLogPending[(rpcXLogPendingHead + rpcXLogPendingNum) % RPC_XLOG_WINDOW_MAX] = _amount;
+    rpcXLogPendingNum++;
+    return _amount;
 }
 
 int RpcXLogFileInit(XLogSegNo logsegno, bool *use_existent, bool use_lock) {
@@ -1406,7 +2825,36 @@ int RpcXLogFileInit(XLogSegNo logsegno, bool *use_existent, bool use_lock) {
 
     _XLog_Init_File_Resp resp;
     client->RpcXLogFileInit(resp, _logsegno, _use_existent, _use_lock);
+    // It creates and renames segments whose paths we don't know here
+    rpcCachedStats.clear();
 
     *use_existent = resp._use_existent;
     return resp._fd;
 }
+
+int RpcFetchPageChanges(char *buf, int maxEntries, int waitMs, uint64_t fromSeq) {
+    RpcInit();
+    _Page &_return = rpcPageBuffer;
+    client->RpcFetchPageChanges(_return, maxEntries, waitMs, (int64_t)fromSeq);
+
+    _return.copy(buf, _return.size());
+    return (int)_return.size();
+}
+
+int32_t RpcPublishResidentPages(const char *summary, int32_t len) {
+    RpcInit();
+    _Page _summary;
+    _summary.assign(summary, len);
+    return client->RpcPublishResidentPages(_summary);
+}
+
+char *RpcGetSmartReplayMetrics(void) {
+    RpcInit();
+    std::string text;
+    client->RpcGetSmartReplayMetrics(text);
+
+    char *result = (char *) palloc(text.size() + 1);
+    memcpy(result, text.data(), text.size());
+    result[text.size()] = '\0';
+    return result;
+}
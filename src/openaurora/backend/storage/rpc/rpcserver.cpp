@@ -13,28 +13,72 @@
 #include <thrift/transport/TBufferTransports.h>
 #include <thrift/server/TThreadPoolServer.h>
 #include <thrift/server/TThreadedServer.h>
+#include <thrift/server/TNonblockingServer.h>
+#include <thrift/transport/TNonblockingServerSocket.h>
 #include <thrift/concurrency/ThreadManager.h>
+#include "rpc_wire.h"
+#include "rpc_fastcodec.h"
 #include "storage/fd.h"
+#include "storage/cpu_roles.h"
 #include "commands/tablespace.h"
 #include "storage/rpcserver.h"
 #include "storage/bufmgr.h"
 #include <sys/stat.h>
 #include "storage/copydir.h"
+#include "storage/db_clone.h"
 #include "storage/md.h"
 #include "catalog/catalog.h"
 #include "utils/relcache.h"
 #include "storage/smgr.h"
 #include "utils/rel.h"
+#include "tcop/base_page_reader.h"
 #include "tcop/storage_server.h"
+#include "access/background_hashmap_vacuumer.h"
+#include "access/logindex_gc_queue.h"
 #include "access/logindex_hashmap.h"
 #include "access/wakeup_latch.h"
+#include "access/lsn_waiter.h"
+#include "access/logindex_hot_queue.h"
+#include "access/logindex_materialize.h"
+#include "access/logindex_resident.h"
+#include "access/logindex_tombstone.h"
+#include "access/page_change_feed.h"
+#include "access/wal_retention.h"
 #include "replication/walreceiver.h"
+#include "replication/wal_ship_compress.h"
 #include "storage/kv_interface.h"
 #include "storage/buf_internals.h"
+#include "storage/checksum.h"
 #include "access/xlog.h"
+#include "access/xlog_internal.h"
 #include "pgstat.h"
+#include "pg_trace.h"
+#include "port/pg_bswap.h"
 #include "storage/rel_cache.h"
+#include "storage/shard_map.h"
 #include "storage/adaptive_sr.h"
+#include "storage/smart_replay_metrics.h"
+#include "storage/stage_timing.h"
+#include "storage/request_trace.h"
+#include "storage/rpc_shm.h"
+#include "storage/rpc_rdma.h"
+#include "storage/rpc_relsize.h"
+#include "storage/rpc_lanes.h"
+#include "storage/rpc_file_cache.h"
+#include "storage/rpc_agg.h"
+#include "storage/rpc_scan.h"
+#include "storage/rpc_vacuum.h"
+#include "storage/rpc_zonemap.h"
+#include "utils/memutils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 extern HashMap pageVersionHashMap;
 
@@ -48,7 +92,6 @@ extern pthread_rwlock_t *RpcXLogPagesLocks;
 extern uint64_t RpcXLogFlushedLsn;
 
 
-//#define DEBUG_TIMING 1
 //#define INFO_FUNC_START
 //#define INFO_FUNC_START2
 //#define ENABLE_DEBUG_INFO
@@ -92,92 +135,6 @@ public:
 };
 #endif
 
-#ifdef DEBUG_TIMING
-
-#include <sys/time.h>
-#include <pthread.h>
-#include <cstdlib>
-
-int initialized = 0;
-struct timeval output_timing;
-
-pthread_mutex_t timing_mutex = PTHREAD_MUTEX_INITIALIZER;
-long readBufferCommon[36];
-long readBufferCount[36];
-
-long nblocksTime[16];
-long nblocksCount[16];
-
-long existsTime[16];
-long existsCount[16];
-
-void PrintTimingResult() {
-    struct timeval now;
-
-    if(!initialized){
-        gettimeofday(&output_timing, NULL);
-        initialized = 1;
-
-        memset(readBufferCount, 0, 16*sizeof(readBufferCount[0]));
-        memset(readBufferCommon, 0, 16*sizeof(readBufferCommon[0]));
-
-        memset(nblocksCount, 0, 16*sizeof(nblocksCount[0]));
-        memset(nblocksTime, 0, 16*sizeof(nblocksTime[0]));
-
-        memset(existsCount, 0, 16*sizeof(existsCount[0]));
-        memset(existsTime, 0, 16*sizeof(existsTime[0]));
-    }
-
-
-    gettimeofday(&now, NULL);
-
-    if(now.tv_sec-output_timing.tv_sec >= 1) {
-        for(int i = 0 ; i < 35; i++) {
-            if(readBufferCount[i] == 0)
-                continue;
-            printf("readBufferCommon_%d = %ld\n",i,  readBufferCommon[i]/readBufferCount[i]);
-            printf("total_readBufferCommon_%d = %ld, count = %ld\n",i,  readBufferCommon[i], readBufferCount[i]);
-            fflush(stdout);
-        }
-
-        for(int i = 0 ; i < 9; i++) {
-            if(nblocksCount[i] == 0)
-                continue;
-            printf("nblocks_%d = %ld\n",i,  nblocksTime[i]/nblocksCount[i]);
-            printf("nblocks_%d = %ld, count = %ld\n",i,  nblocksTime[i], nblocksCount[i]);
-            fflush(stdout);
-        }
-
-        for(int i = 0 ; i < 9; i++) {
-            if(existsCount[i] == 0)
-                continue;
-            printf("exists_%d = %ld\n",i,  existsTime[i]/existsCount[i]);
-            printf("exists_%d = %ld, count = %ld\n",i,  existsTime[i], existsCount[i]);
-            fflush(stdout);
-        }
-
-        output_timing = now;
-    }
-}
-
-#define START_TIMING(start_p)  \
-do {                         \
-    gettimeofday(start_p, NULL); \
-} while(0);
-
-#define RECORD_TIMING(start_p, end_p, global_timing, global_count) \
-do { \
-    gettimeofday(end_p, NULL); \
-    pthread_mutex_lock(&timing_mutex); \
-    (*global_timing) += ((*end_p.tv_sec*1000000+*end_p.tv_usec) - (*start_p.tv_sec*1000000+*start_p.tv_usec))/1000; \
-    (*global_count)++;                                                               \
-    pthread_mutex_unlock(&timing_mutex); \
-    PrintTimingResult(); \
-    gettimeofday(start_p, NULL); \
-} while (0);
-
-
-#endif
 
 extern XLogRecPtr XLogParseUpto;
 
@@ -191,8 +148,50 @@ static void TransRelNode2RelKey(RelFileNode node, RelKey *relKey, ForkNumber for
 }
 #include <sys/time.h>
 
+// Times every stage of a traced read while in scope, see stage_timing.h
+class StageTraceScope {
+public:
+    explicit StageTraceScope(int64_t traceId) : trace() {
+        if (traceId != 0)
+            StageTimingTraceBegin(&trace, (uint64) traceId);
+    }
+    ~StageTraceScope() {
+        if (trace.traceId != 0)
+            StageTimingTraceEnd();
+    }
+    StageTrace trace;
+};
+
+// Buffers of the request a thread handles, while in scope. They come from
+// a bump context of the thread's own, reset when the request is done,
+// instead of a malloc() and free() every request. A handler only takes
+// one at its top, since a nested one would reset the outer one's buffers.
+// The first block of the context, kept across requests, holds a few pages.
+#define RPC_REQUEST_BUFFERS_SIZE (64 * 1024)
+
+class RpcRequestBuffers {
+public:
+    RpcRequestBuffers() {
+        if(context == NULL)
+            context = BumpContextCreate(NULL, "RPC request buffers", RPC_REQUEST_BUFFERS_SIZE,
+                                        RPC_REQUEST_BUFFERS_SIZE, ALLOCSET_DEFAULT_MAXSIZE);
+    }
+    ~RpcRequestBuffers() {
+        MemoryContextReset(context);
+    }
+    char *Alloc(Size size) {
+        return (char *) MemoryContextAlloc(context, size);
+    }
+
+private:
+    static thread_local MemoryContext context;
+};
+
+thread_local MemoryContext RpcRequestBuffers::context = NULL;
+
 pthread_mutex_t wakeupMutex;
 void WaitParse(int64_t _lsn) {
+    uint64 stageStart = StageTimingStart();
 
 //    struct timeval now;
 //    gettimeofday(&now, NULL);
@@ -249,7 +248,9 @@ void WaitParse(int64_t _lsn) {
 
 //            printf("%s get into sleep\n", __func__ );
 //            fflush(stdout);
-            usleep(500);
+            // Sleep until the startup process parses past targetLsn-64; the
+            // timeout only bounds the cost of a missed wakeup.
+            LsnWaiterWait(targetLsn-64, 10000);
 //            pthread_mutex_lock(&wakeupMutex);
 //            WakeupRecovery();
 //            WakeupStartupRecovery();
@@ -268,6 +269,7 @@ void WaitParse(int64_t _lsn) {
     }
 //    printf("%s %d exit\n" ,__func__ , __LINE__);
 //    fflush(stdout);
+    StageTimingEnd(STAGE_WAIT_PARSE, stageStart);
 }
 
 using namespace ::apache::thrift;
@@ -276,36 +278,972 @@ using namespace ::apache::thrift::transport;
 using namespace ::apache::thrift::server;
 
 using namespace  ::tutorial;
-class DataPageAccessHandler : virtual public DataPageAccessIf {
+
+/*
+ * State of one client connection. A server event handler hands the context
+ * of the connection a request came on to the thread serving it, with either
+ * server model.
+ */
+struct RpcConnectionContext {
+    // What RpcSetPageCompression agreed on, WAL_SHIP_COMPRESSION_OFF until then
+    int pageCompression = WAL_SHIP_COMPRESSION_OFF;
+    // Of RpcSetRequestClass
+    int requestClass = RPC_CLASS_FOREGROUND;
+    // Of RpcSetRequestDeadline, how long a call may wait for a lane, 0 for
+    // as long as it takes
+    int queueMs = 0;
+    // Calls holding or waiting for a lane, under the lanes' mutex
+    int inFlight = 0;
+    // Segment of RpcAttachSharedMemory and the thread serving it, which
+    // stops with the connection
+    RpcShmSegment *shm = NULL;
+    std::thread shmThread;
+
+    ~RpcConnectionContext() {
+        if (shm == NULL)
+            return;
+        RpcShmClose(shm);
+        shmThread.join();
+        RpcShmUnmap(shm);
+    }
+};
+
+static thread_local RpcConnectionContext *currentConnection = NULL;
+
+class RpcServerEventHandler : public TServerEventHandler {
 public:
-    DataPageAccessHandler() {
-        // Your initialization goes here
+    void *createContext(std::shared_ptr<TProtocol> input, std::shared_ptr<TProtocol> output) override {
+        return new RpcConnectionContext();
     }
 
-    /**
-     * A method definition looks like C code. It has a return type, arguments,
-     * and optionally a list of exceptions that it may throw. Note that argument
-     * lists and exception lists are specified using the exact same syntax as
-     * field lists in struct or exception definitions.
-     *
-     * @param _fd
+    void deleteContext(void *serverContext, std::shared_ptr<TProtocol> input,
+                       std::shared_ptr<TProtocol> output) override {
+        if (currentConnection == serverContext)
+            currentConnection = NULL;
+        delete (RpcConnectionContext *) serverContext;
+    }
+
+    void processContext(void *serverContext, std::shared_ptr<TTransport> transport) override {
+        currentConnection = (RpcConnectionContext *) serverContext;
+    }
+};
+
+/*
+ * Page images of a connection that asked for compression go as frames of
+ * wal_ship_compress.h, if the frame takes at most
+ * RPC_PAGE_COMPRESSION_THRESHOLD percent of the page (90 by default); a page
+ * that doesn't shrink that much goes raw and costs the client no
+ * decompression. A frame is shorter than a page, which is how the client
+ * tells them apart.
+ */
+static int PageCompressionThreshold() {
+    static int threshold = -1;
+
+    if (threshold < 0) {
+        char *value = getenv("RPC_PAGE_COMPRESSION_THRESHOLD");
+
+        threshold = (value != NULL && atoi(value) > 0 && atoi(value) < 100) ? atoi(value) : 90;
+    }
+    return threshold;
+}
+
+// Threads a RpcSyncFiles spreads its fsyncs over
+static int SyncFilesWorkers() {
+    static int workers = -1;
+
+    if (workers < 0) {
+        char *value = getenv("RPC_SYNC_WORKERS");
+
+        workers = (value != NULL && atoi(value) > 0) ? atoi(value) : 8;
+    }
+    return workers;
+}
+
+// fsync_fname without the ereport, which mustn't run off the main thread
+static int SyncPath(const char *path) {
+    struct stat st;
+    int fd;
+    int rc;
+
+    if (!enableFsync)
+        return 0;
+    if ((fd = open(path, O_RDONLY | PG_BINARY)) < 0)
+        return -1;
+    rc = pg_fsync(fd);
+    // Some systems can't fsync a directory, as fsync_fname allows
+    if (rc != 0 && (errno == EBADF || errno == EINVAL) && fstat(fd, &st) == 0 && S_ISDIR(st.st_mode))
+        rc = 0;
+    if (rc != 0)
+        printf("%s could not fsync \"%s\": %s\n", __func__, path, strerror(errno));
+    close(fd);
+    return rc;
+}
+
+// Storage replay doesn't keep pd_checksum up to date, so every page served
+// gets it computed afresh; a compute node with rpc_verify_page_checksums
+// checks it on arrival, whatever the cluster's data_checksums
+static void StampPageChecksum(char *page, BlockNumber blkno) {
+    if (!PageIsNew((Page) page))
+        ((PageHeader) page)->pd_checksum = pg_checksum_page(page, blkno);
+}
+
+static void CompressReplyPage(_Page &page) {
+    static thread_local std::string frame;
+    int method = currentConnection != NULL ? currentConnection->pageCompression : WAL_SHIP_COMPRESSION_OFF;
+    size_t len = 0;
+
+    if (method == WAL_SHIP_COMPRESSION_OFF || page.size() != BLCKSZ)
+        return;
+    frame.resize(WalShipCompressBound(BLCKSZ));
+    len = WalShipCompress(method, page.data(), BLCKSZ, &frame[0]);
+    if (len == 0 || len * 100 > (size_t) BLCKSZ * PageCompressionThreshold()) {
+        SmartReplayMetricsCountPageSent(BLCKSZ, false);
+        return;
+    }
+    page.assign(frame.data(), len);
+    SmartReplayMetricsCountPageSent(len, true);
+}
+
+/*
+ * Admission of the requests of storage/rpc_lanes.h. A request that finds a
+ * slot free and nobody queued goes ahead, the others wait in the queue of
+ * their class. A freed slot goes to the head of a queue picked by smooth
+ * weighted round robin over the classes with waiters. The calls of a
+ * connection are shed rather than queued past the limits; those of the
+ * shared memory segments, which have a thread of their own, always wait.
+ */
+class RequestLanes {
+public:
+    RequestLanes() {
+        char *slotsEnv = getenv("RPC_LANE_SLOTS");
+        char *weightsEnv = getenv("RPC_LANE_WEIGHTS");
+        char *queueEnv = getenv("RPC_LANE_QUEUE");
+        char *connectionEnv = getenv("RPC_LANE_CONNECTION_SLOTS");
+
+        slots = (slotsEnv != NULL && atoi(slotsEnv) >= 0) ? atoi(slotsEnv) : 64;
+        queueLimit = (queueEnv != NULL && atoi(queueEnv) >= 0) ? atoi(queueEnv) : 4 * slots;
+        connectionSlots = (connectionEnv != NULL && atoi(connectionEnv) >= 0) ? atoi(connectionEnv) : 8;
+        if (weightsEnv != NULL) {
+            char *p = weightsEnv;
+
+            for (int c = 0; c < RPC_CLASSES && *p != '\0'; c++) {
+                int w = (int) strtol(p, &p, 10);
+
+                if (w > 0)
+                    weights[c] = w;
+                while (*p == ',' || *p == ' ')
+                    p++;
+            }
+        }
+        if (slots > 0) {
+            printf("%s %d slots, weights %d,%d,%d, queue %d, %d per connection\n", __func__, slots,
+                   weights[RPC_CLASS_FOREGROUND], weights[RPC_CLASS_BACKGROUND], weights[RPC_CLASS_MAINTENANCE],
+                   queueLimit, connectionSlots);
+            fflush(stdout);
+        }
+    }
+
+    bool Enabled() const {
+        return slots > 0;
+    }
+
+    // The server runs the calls on workers threads, of which reserved are
+    // left for the calls that aren't held back
+    void ReserveWorkers(int workers, int reserved) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        heldLimit = Max(workers - reserved, 1);
+    }
+
+    /*
+     * Takes a slot for a call of connection, NULL for one that waits however
+     * long it takes. False if the call is shed, *retryMs is then how long the
+     * client should wait before trying again.
      */
+    bool Acquire(int requestClass, RpcConnectionContext *connection, int *retryMs) {
+        Waiter waiter;
+        std::chrono::steady_clock::time_point start;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (connection != NULL && connectionSlots > 0 && connection->inFlight >= connectionSlots)
+            return Shed(requestClass, retryMs);
+        if (busy < slots && waiting == 0 && (connection == NULL || busy < heldLimit)) {
+            busy++;
+            if (connection != NULL)
+                connection->inFlight++;
+            lock.unlock();
+            SmartReplayMetricsCountLane(requestClass, 0);
+            return true;
+        }
+        if (connection != NULL && (waiting >= queueLimit || busy + waiting >= heldLimit))
+            return Shed(requestClass, retryMs);
+
+        start = std::chrono::steady_clock::now();
+        queues[requestClass].push_back(&waiter);
+        waiting++;
+        if (connection != NULL)
+            connection->inFlight++;
+        if (connection != NULL && connection->queueMs > 0) {
+            auto deadline = start + std::chrono::milliseconds(connection->queueMs);
+
+            if (!waiter.cond.wait_until(lock, deadline, [&waiter] { return waiter.admitted; })) {
+                std::deque<Waiter *> &queue = queues[requestClass];
+
+                queue.erase(std::find(queue.begin(), queue.end(), &waiter));
+                waiting--;
+                connection->inFlight--;
+                return Shed(requestClass, retryMs);
+            }
+        } else
+            waiter.cond.wait(lock, [&waiter] { return waiter.admitted; });
+        lock.unlock();
+        SmartReplayMetricsCountLane(requestClass, (uint64) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count());
+        return true;
+    }
 
-    void
-    ReadBufferCommon(_Page &_return, const _Smgr_Relation &_reln, const int32_t _relpersistence, const int32_t _forknum,
-                     const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn) {
+    // Gives back the slot of a call of connection that held it for serviceNs
+    void Release(RpcConnectionContext *connection, uint64 serviceNs) {
+        std::lock_guard<std::mutex> lock(mutex);
+        int next = waiting > 0 ? Pick() : -1;
 
-//        printf("%s %d start, spc = %lu, db = %lu, rel = %lu, fork = %d, blk = %d, lsn = %lu, tid = %d\n", __func__ , __LINE__,
-//               _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum, _blknum, _lsn, gettid());
-//        fflush(stdout);
+        if (connection != NULL)
+            connection->inFlight--;
+        serviceUs = serviceUs * 0.875 + (serviceNs / 1000.0) * 0.125;
+        if (next < 0) {
+            busy--;
+            return;
+        }
+        // The slot passes on as it is
+        Waiter *waiter = queues[next].front();
+        queues[next].pop_front();
+        waiting--;
+        waiter->admitted = true;
+        waiter->cond.notify_one();
+    }
+
+private:
+    struct Waiter {
+        std::condition_variable cond;
+        bool admitted = false;
+    };
+
+    int Pick() {
+        int total = 0;
+        int best = -1;
+
+        for (int c = 0; c < RPC_CLASSES; c++) {
+            if (queues[c].empty())
+                continue;
+            current[c] += weights[c];
+            total += weights[c];
+            if (best < 0 || current[c] > current[best])
+                best = c;
+        }
+        current[best] -= total;
+        return best;
+    }
+
+    // With the mutex held; about how long the waiting calls take to go
+    bool Shed(int requestClass, int *retryMs) {
+        double drainUs = slots > 0 ? serviceUs * (waiting + 1) / slots : serviceUs;
+
+        *retryMs = Min(Max((int) (drainUs / 1000), 1), 1000);
+        SmartReplayMetricsCountShed(requestClass);
+        return false;
+    }
+
+    int slots;
+    int queueLimit;
+    int connectionSlots;
+    int heldLimit = INT_MAX;
+    int weights[RPC_CLASSES] = {8, 2, 1};
+    int current[RPC_CLASSES] = {0, 0, 0};
+    std::mutex mutex;
+    int busy = 0;
+    int waiting = 0;
+    // Smoothed time a call holds its slot
+    double serviceUs = 1000;
+    std::deque<Waiter *> queues[RPC_CLASSES];
+};
+
+// Set up by the first request, the compute nodes link this file too
+static RequestLanes &GetRequestLanes() {
+    static RequestLanes lanes;
+
+    return lanes;
+}
+
+// The class a call is admitted in, -1 for the calls that aren't held back
+static int RequestLaneOf(const char *fnName, const RpcConnectionContext *connection) {
+    static const std::unordered_map<std::string, bool> gated = {
+        // true for the calls that are maintenance whoever sends them
+        {"DataPageAccess.ReadBufferCommon", false},
+        {"DataPageAccess.ReadBufferBatch", false},
+        {"DataPageAccess.ReadRelationHeads", false},
+        {"DataPageAccess.ScanRelation", false},
+        {"DataPageAccess.AggregateRelation", false},
+        {"DataPageAccess.TriageVacuum", false},
+        {"DataPageAccess.ReadBufferIfModified", false},
+        {"DataPageAccess.PrefetchBuffers", false},
+        {"DataPageAccess.InstallPages", false},
+        {"DataPageAccess.InstallEvictedPages", true},
+        {"DataPageAccess.RpcMdRead", false},
+        {"DataPageAccess.RpcMdExtend", false},
+        {"DataPageAccess.RpcMdExtendMany", false},
+        {"DataPageAccess.RpcFileSync", true},
+        {"DataPageAccess.RpcFileWriteback", true},
+        {"DataPageAccess.RpcPgFsync", true},
+        {"DataPageAccess.RpcPgFdatasync", true},
+        {"DataPageAccess.RpcPgFsyncNoWritethrough", true},
+        {"DataPageAccess.RpcSyncFiles", true},
+    };
+    auto it = gated.find(fnName);
+
+    if (it == gated.end())
+        return -1;
+    if (it->second)
+        return RPC_CLASS_MAINTENANCE;
+    return connection != NULL ? connection->requestClass : RPC_CLASS_FOREGROUND;
+}
+
+/*
+ * Holds a call back until its lane admits it, from before the arguments are
+ * read to after the reply is written. A shed call's arguments are skipped
+ * and it's answered with the exception of storage/rpc_lanes.h, the way the
+ * generated code answers a call it doesn't know.
+ *
+ * With the binary protocol the hot page calls are decoded and answered by
+ * the codec of rpc_fastcodec.h, the others by the generated processor.
+ */
+class RequestLaneProcessor : public DataPageAccessProcessor {
+public:
+    RequestLaneProcessor(const std::shared_ptr<DataPageAccessIf> &iface, bool fastCodec)
+        : DataPageAccessProcessor(iface), fastCodec_(fastCodec) {}
+
+protected:
+    bool dispatchCall(TProtocol *iprot, TProtocol *oprot, const std::string &fname, int32_t seqid,
+                      void *callContext) override {
+        RpcConnectionContext *connection = (RpcConnectionContext *) callContext;
+        int lane = RequestLaneOf(("DataPageAccess." + fname).c_str(), connection);
+        int retryMs = 0;
+
+        if (lane < 0 || !GetRequestLanes().Enabled())
+            return Dispatch(iprot, oprot, fname, seqid, callContext);
+        if (!GetRequestLanes().Acquire(lane, connection, &retryMs)) {
+            iprot->skip(::apache::thrift::protocol::T_STRUCT);
+            iprot->readMessageEnd();
+            iprot->getTransport()->readEnd();
+
+            TApplicationException x(TApplicationException::INTERNAL_ERROR,
+                                    RPC_LANE_SHED_MESSAGE + std::to_string(retryMs));
+            oprot->writeMessageBegin(fname, ::apache::thrift::protocol::T_EXCEPTION, seqid);
+            x.write(oprot);
+            oprot->writeMessageEnd();
+            oprot->getTransport()->writeEnd();
+            oprot->getTransport()->flush();
+            return true;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        bool result;
+        try {
+            result = Dispatch(iprot, oprot, fname, seqid, callContext);
+        } catch (...) {
+            GetRequestLanes().Release(connection, 0);
+            throw;
+        }
+        GetRequestLanes().Release(connection, (uint64) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count());
+        return result;
+    }
+
+private:
+    bool fastCodec_;
+
+    bool Dispatch(TProtocol *iprot, TProtocol *oprot, const std::string &fname, int32_t seqid,
+                  void *callContext) {
+        // The generated processor calls the event handler around each step
+        if (fastCodec_ && eventHandler_ == nullptr && ServeFast(iprot, oprot, fname, seqid))
+            return true;
+        return DataPageAccessProcessor::dispatchCall(iprot, oprot, fname, seqid, callContext);
+    }
+
+    bool ServeFast(TProtocol *iprot, TProtocol *oprot, const std::string &fname, int32_t seqid) {
+        DataPageAccessIf *iface = iface_.get();
+
+        if (fname == rpcfast::ReadBufferCommonCall::kName)
+            return rpcfast::Serve<rpcfast::ReadBufferCommonCall>(iprot, oprot, seqid,
+                    [iface](_Page &page, const _Smgr_Relation &reln, int32_t relpersistence, int32_t forknum,
+                            int32_t blknum, int32_t mode, int64_t lsn, int64_t traceId) {
+                        iface->ReadBufferCommon(page, reln, relpersistence, forknum, blknum, mode, lsn, traceId);
+                    });
+        if (fname == rpcfast::RpcMdReadCall::kName)
+            return rpcfast::Serve<rpcfast::RpcMdReadCall>(iprot, oprot, seqid,
+                    [iface](_Page &page, const _Smgr_Relation &reln, int32_t forknum, int64_t blknum, int64_t lsn) {
+                        iface->RpcMdRead(page, reln, forknum, blknum, lsn);
+                    });
+        if (fname == rpcfast::RpcMdNblocksCall::kName)
+            return rpcfast::Serve<rpcfast::RpcMdNblocksCall>(iprot, oprot, seqid,
+                    [iface](int32_t &nblocks, const _Smgr_Relation &reln, int32_t forknum, int64_t lsn) {
+                        nblocks = iface->RpcMdNblocks(reln, forknum, lsn);
+                    });
+        return false;
+    }
+};
+
+/*
+ * Pages replayed ahead of demand for PrefetchBuffers. Entries remember the
+ * LSN they were materialized at and are dropped after PREFETCH_TTL_MS or
+ * when the cache is full (oldest first). A hit is consumed: the page moves
+ * into the compute node's buffer pool, so we never serve it twice.
+ */
+#define PREFETCH_CACHE_SIZE 4096
+#define PREFETCH_QUEUE_SIZE 8192
+#define PREFETCH_TTL_MS 1000
+#define PREFETCH_WORKERS 4
+// Evicted page images queued for InstallEvictedPages at most
+#define EVICTED_INSTALL_QUEUE_PAGES 4096
+
+struct PrefetchKey {
+    int64_t spc, db, rel;
+    int32_t fork, blk;
+
+    bool operator==(const PrefetchKey &o) const {
+        return spc == o.spc && db == o.db && rel == o.rel && fork == o.fork && blk == o.blk;
+    }
+};
+
+struct PrefetchKeyHash {
+    size_t operator()(const PrefetchKey &k) const {
+        return std::hash<int64_t>()(k.rel) ^ (std::hash<int64_t>()(((int64_t) k.fork << 32) | (uint32_t) k.blk) * 31);
+    }
+};
+
+struct PrefetchRequest {
+    _Smgr_Relation reln;
+    int32_t forknum;
+    int32_t blknum;
+    int64_t lsn;
+};
+
+struct EvictedPageBatch {
+    _Smgr_Relation reln;
+    int32_t forknum;
+    std::vector<int64_t> blknums;
+    std::string pages;
+    int64_t lsn;
+};
+
+struct PrefetchedPage {
+    int64_t lsn;
+    std::chrono::steady_clock::time_point readyAt;
+    std::string page;
+};
+
+class PrefetchReadyCache {
+public:
+    void Put(const PrefetchKey &key, int64_t lsn, std::string &&page) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (pages.find(key) == pages.end()) {
+            if (pages.size() >= PREFETCH_CACHE_SIZE)
+                EvictOldest();
+            order.push_back(key);
+        }
+        PrefetchedPage &entry = pages[key];
+        entry.lsn = lsn;
+        entry.readyAt = std::chrono::steady_clock::now();
+        entry.page = std::move(page);
+    }
+
+    // Move the cached image into page if present and not expired.
+    bool Take(const PrefetchKey &key, int64_t *lsn, std::string &page) {
+        std::lock_guard<std::mutex> guard(mutex);
+        auto it = pages.find(key);
+        if (it == pages.end())
+            return false;
+        bool fresh = std::chrono::steady_clock::now() - it->second.readyAt
+                     < std::chrono::milliseconds(PREFETCH_TTL_MS);
+        if (fresh) {
+            *lsn = it->second.lsn;
+            page = std::move(it->second.page);
+        }
+        pages.erase(it);
+        return fresh;
+    }
+
+    bool Contains(const PrefetchKey &key) {
+        std::lock_guard<std::mutex> guard(mutex);
+        return pages.find(key) != pages.end();
+    }
+
+private:
+    void EvictOldest() {
+        // order can hold keys already taken; skip those
+        while (!order.empty()) {
+            PrefetchKey oldest = order.front();
+            order.pop_front();
+            if (pages.erase(oldest) > 0)
+                return;
+        }
+    }
+
+    std::mutex mutex;
+    std::unordered_map<PrefetchKey, PrefetchedPage, PrefetchKeyHash> pages;
+    std::deque<PrefetchKey> order;
+};
+
+/*
+ * Replays in progress on this server, by page and the LSN they replay up to.
+ * When several readers miss the same page at once, the first one to Join
+ * leads and replays; the others wait for it and copy its page instead of
+ * replaying the same chain again. A leader that gives up without Publish
+ * (the replay threw) releases its followers to replay on their own.
+ */
+struct ReplayFlight {
+    std::condition_variable cond;
+    bool done = false;
+    bool ok = false;
+    std::string page;
+};
+
+struct ReplayFlightKey {
+    PrefetchKey page;
+    uint64_t lsn;
+
+    bool operator==(const ReplayFlightKey &o) const {
+        return page == o.page && lsn == o.lsn;
+    }
+};
+
+struct ReplayFlightKeyHash {
+    size_t operator()(const ReplayFlightKey &k) const {
+        return PrefetchKeyHash()(k.page) ^ std::hash<uint64_t>()(k.lsn);
+    }
+};
+
+class ReplayInFlightTable {
+public:
+    class Ticket {
+    public:
+        Ticket(ReplayInFlightTable &table, const ReplayFlightKey &key) : table(table), key(key) {}
+
+        ~Ticket() {
+            if (leader)
+                table.Finish(key, flight, NULL);
+        }
+
+        // Copy the page the leader replayed; false if it gave up
+        bool Wait(char *page) {
+            std::unique_lock<std::mutex> lock(table.mutex);
+            flight->cond.wait(lock, [this] { return flight->done; });
+            if (flight->ok)
+                memcpy(page, flight->page.data(), BLCKSZ);
+            return flight->ok;
+        }
+
+        void Publish(const char *page) {
+            table.Finish(key, flight, page);
+            leader = false;
+        }
+
+        bool leader = false;
+        std::shared_ptr<ReplayFlight> flight;
+
+    private:
+        ReplayInFlightTable &table;
+        ReplayFlightKey key;
+    };
+
+    void Join(Ticket &ticket, const ReplayFlightKey &key) {
+        std::lock_guard<std::mutex> guard(mutex);
+        std::shared_ptr<ReplayFlight> &flight = flights[key];
+        if (!flight) {
+            flight = std::make_shared<ReplayFlight>();
+            ticket.leader = true;
+        }
+        ticket.flight = flight;
+    }
+
+private:
+    void Finish(const ReplayFlightKey &key, const std::shared_ptr<ReplayFlight> &flight, const char *page) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (page != NULL) {
+            flight->page.assign(page, BLCKSZ);
+            flight->ok = true;
+        }
+        flight->done = true;
+        flights.erase(key);
+        flight->cond.notify_all();
+    }
+
+    std::mutex mutex;
+    std::unordered_map<ReplayFlightKey, std::shared_ptr<ReplayFlight>, ReplayFlightKeyHash> flights;
+};
+
+/*
+ * WAL pushed by the compute nodes is published to the parser as soon as it
+ * is in RpcXLogPages; writing it to the segment files is left to a thread of
+ * its own, in the order the chunks arrived. A sync or close first waits for
+ * what was queued before it, and a reader missing RpcXLogPages waits in
+ * XLogPageRead() for the WAL it reads from the files. A failed write fails
+ * every later sync, so the compute node never counts it flushed.
+ * RPC_XLOG_PERSIST_SYNC writes in the RPC thread before publishing instead.
+ */
+#define XLOG_PERSIST_QUEUE_BYTES (64 * 1024 * 1024)
+
+struct XLogPersistChunk {
+    int fd;
+    int64_t offset;
+    uint64_t endLsn;
+    std::string data;
+};
+
+class XLogPersistQueue {
+public:
+    // Queues a copy of the chunk, waits while the queue is full
+    void Push(int fd, const char *data, int32_t amount, int64_t offset, uint64_t endLsn) {
+        std::call_once(writerStarted, [this] {
+            std::thread(&XLogPersistQueue::WriterLoop, this).detach();
+        });
+
+        std::unique_lock<std::mutex> lock(mutex);
+        spaceCond.wait(lock, [this] { return queuedBytes < XLOG_PERSIST_QUEUE_BYTES || chunks.empty(); });
+        XLogRpcPersistQueued((XLogRecPtr) endLsn);
+        chunks.push_back(XLogPersistChunk{fd, offset, endLsn, std::string(data, amount)});
+        queuedBytes += amount;
+        pushed++;
+        workCond.notify_one();
+    }
+
+    // Waits for the chunks queued so far to be written, false if one failed
+    bool Wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        uint64_t ticket = pushed;
+        doneCond.wait(lock, [this, ticket] { return written >= ticket; });
+        if (failed) {
+            errno = EIO;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    void WriterLoop() {
+        for (;;) {
+            XLogPersistChunk chunk;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                workCond.wait(lock, [this] { return !chunks.empty(); });
+                chunk = std::move(chunks.front());
+                chunks.pop_front();
+            }
+
+            ssize_t result = pg_pwrite(chunk.fd, chunk.data.data(), chunk.data.size(), chunk.offset);
+            if (result != (ssize_t) chunk.data.size()) {
+                printf("%s could not write WAL at offset %ld to fd %d: %s\n", __func__ ,
+                       (long) chunk.offset, chunk.fd, strerror(errno));
+                fflush(stdout);
+            }
+            // Readers aren't held up by a failed write, the next sync fails
+            XLogRpcPersistWritten((XLogRecPtr) chunk.endLsn);
+
+            std::lock_guard<std::mutex> guard(mutex);
+            if (result != (ssize_t) chunk.data.size())
+                failed = true;
+            queuedBytes -= chunk.data.size();
+            written++;
+            doneCond.notify_all();
+            spaceCond.notify_all();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable workCond;
+    std::condition_variable spaceCond;
+    std::condition_variable doneCond;
+    std::deque<XLogPersistChunk> chunks;
+    size_t queuedBytes = 0;
+    uint64_t pushed = 0;
+    uint64_t written = 0;
+    bool failed = false;
+    std::once_flag writerStarted;
+};
+
+/*
+ * WAL segments initialized ahead of the compute node. Each time it opens a
+ * segment, the next RPC_XLOG_PREALLOC_SEGMENTS (default 2) are created in
+ * the background unless they exist already, recycled by a checkpoint or
+ * made before, so a segment switch only opens a file. XLogFileInit() zero
+ * fills under one temp file name per process, so the RPC threads and this
+ * one take turns.
+ */
+class XLogSegmentPreallocator {
+public:
+    XLogSegmentPreallocator() {
+        char *value = getenv("RPC_XLOG_PREALLOC_SEGMENTS");
+        segments = value != NULL ? Max(atoi(value), 0) : 2;
+    }
+
+    int Init(XLogSegNo segno, bool *use_existent, bool use_lock) {
+        int fd;
+        {
+            std::lock_guard<std::mutex> guard(initMutex);
+            fd = XLogFileInit(segno, use_existent, use_lock);
+        }
+        if (segments > 0)
+            Request(segno + segments);
+        return fd;
+    }
+
+private:
+    void Request(XLogSegNo upto) {
+        std::call_once(workerStarted, [this] {
+            std::thread(&XLogSegmentPreallocator::WorkerLoop, this).detach();
+        });
+        std::lock_guard<std::mutex> guard(mutex);
+        if (upto > wantedUpto) {
+            if (preparedUpto + segments < upto)
+                preparedUpto = upto - segments;
+            wantedUpto = upto;
+            cond.notify_one();
+        }
+    }
+
+    void WorkerLoop() {
+        for (;;) {
+            XLogSegNo segno;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [this] { return preparedUpto < wantedUpto; });
+                segno = ++preparedUpto;
+            }
+
+            char path[MAXPGPATH];
+            struct stat st;
+            XLogFilePath(path, ThisTimeLineID, segno, wal_segment_size);
+            if (stat(path, &st) == 0)
+                continue;
+
+            std::lock_guard<std::mutex> guard(initMutex);
+            bool use_existent = true;
+            int fd = XLogFileInit(segno, &use_existent, true);
+            if (fd >= 0)
+                close(fd);
+        }
+    }
+
+    int segments;
+    std::mutex initMutex;
+    std::mutex mutex;
+    std::condition_variable cond;
+    XLogSegNo preparedUpto = 0;
+    XLogSegNo wantedUpto = 0;
+    std::once_flag workerStarted;
+};
+
+class DataPageAccessHandler : virtual public DataPageAccessIf {
+private:
+    PrefetchReadyCache prefetchCache;
+    XLogPersistQueue xlogPersistQueue;
+    XLogSegmentPreallocator xlogPreallocator;
+    ReplayInFlightTable replayFlights;
+    std::mutex prefetchQueueMutex;
+    std::condition_variable prefetchQueueCond;
+    std::deque<PrefetchRequest> prefetchQueue;
+    std::once_flag prefetchWorkersStarted;
+    std::mutex evictedQueueMutex;
+    std::condition_variable evictedQueueCond;
+    std::deque<EvictedPageBatch> evictedQueue;
+    size_t evictedQueuedPages = 0;
+    std::once_flag evictedWorkerStarted;
+
+    static PrefetchKey MakePrefetchKey(const _Smgr_Relation &_reln, int32_t _forknum, int32_t _blknum) {
+        PrefetchKey key = {_reln._spc_node, _reln._db_node, _reln._rel_node, _forknum, _blknum};
+        return key;
+    }
+
+    void PrefetchWorkerLoop() {
+        CpuRoleBind(CPU_ROLE_REPLAY, -1);
+        for (;;) {
+            PrefetchRequest request;
+            {
+                std::unique_lock<std::mutex> lock(prefetchQueueMutex);
+                prefetchQueueCond.wait(lock, [this] { return !prefetchQueue.empty(); });
+                request = prefetchQueue.front();
+                prefetchQueue.pop_front();
+            }
+
+            PrefetchKey key = MakePrefetchKey(request.reln, request.forknum, request.blknum);
+            if (prefetchCache.Contains(key))
+                continue;
+
+            WaitParse(request.lsn);
+            std::string page(BLCKSZ, '\0');
+            ReadPageAtLsn(&page[0], request.reln, request.forknum, request.blknum, request.lsn, false);
+            prefetchCache.Put(key, request.lsn, std::move(page));
+        }
+    }
+
+    // Installs the evicted pages of InstallEvictedPages once the WAL up to
+    // the batch's LSN is parsed, so every version before a page's LSN is in
+    // the logindex to check the page against
+    void EvictedInstallLoop() {
+        CpuRoleBind(CPU_ROLE_REPLAY, -1);
+        for (;;) {
+            EvictedPageBatch batch;
+            {
+                std::unique_lock<std::mutex> lock(evictedQueueMutex);
+                evictedQueueCond.wait(lock, [this] { return !evictedQueue.empty(); });
+                batch = std::move(evictedQueue.front());
+                evictedQueue.pop_front();
+                evictedQueuedPages -= batch.blknums.size();
+            }
+
+            WaitParse(batch.lsn);
+            for (size_t i = 0; i < batch.blknums.size(); i++) {
+                const char *page = batch.pages.data() + i * BLCKSZ;
+                XLogRecPtr pageLsn = PageGetLSN((Page) page);
+
+                // Only a page of WAL the compute node had flushed when it
+                // sent it, and the parser has reached
+                if (pageLsn == InvalidXLogRecPtr || pageLsn > (XLogRecPtr) batch.lsn || pageLsn > XLogParseUpto)
+                    continue;
+
+                KeyType key;
+                key.SpcID = batch.reln._spc_node;
+                key.DbID = batch.reln._db_node;
+                key.RelID = batch.reln._rel_node;
+                key.ForkNum = batch.forknum;
+                key.BlkNum = batch.blknums[i];
+                BackgroundInstallPage(pageVersionHashMap, key, page, pageLsn);
+            }
+        }
+    }
+
+    /*
+     * Serves the reads a backend puts in its segment, the way a connection
+     * thread serves ReadBufferCommon. No compression, the page goes back in
+     * the slot.
+     */
+    void SharedMemoryLoop(RpcShmSegment *segment, const RpcConnectionContext *connection) {
+        RpcShmSlot *slot;
+        _Page page;
+
+        while ((slot = RpcShmNextRequest(segment)) != NULL) {
+            _Smgr_Relation reln;
+
+            reln._spc_node = slot->spcNode;
+            reln._db_node = slot->dbNode;
+            reln._rel_node = slot->relNode;
+            reln._backend_id = InvalidBackendId;
+            slot->status = RPC_SHM_OK;
+            auto start = std::chrono::steady_clock::now();
+            if (GetRequestLanes().Enabled())
+                GetRequestLanes().Acquire(connection->requestClass, NULL, NULL);
+            try {
+                ReadBufferCommon(page, reln, slot->relPersistence, slot->forkNum, slot->blkNum,
+                                 slot->readBufferMode, slot->lsn, slot->traceId);
+            } catch (std::exception &e) {
+                slot->status = RPC_SHM_FAILED;
+            }
+            if (GetRequestLanes().Enabled())
+                GetRequestLanes().Release(NULL, (uint64) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - start).count());
+            if (page.size() < BLCKSZ)
+                slot->status = RPC_SHM_FAILED;
+            if (slot->status == RPC_SHM_OK)
+                memcpy(slot->page, page.data(), BLCKSZ);
+            slot->waitParseNs = slot->replayNs = 0;
+            if (slot->status == RPC_SHM_OK && page.size() == BLCKSZ + sizeof(StageTraceTrailer)) {
+                StageTraceTrailer trailer;
+
+                memcpy(&trailer, page.data() + BLCKSZ, sizeof(trailer));
+                slot->waitParseNs = pg_ntoh64(trailer.wait_parse_ns);
+                slot->replayNs = pg_ntoh64(trailer.replay_ns);
+            }
+            RpcShmReply(segment);
+        }
+    }
+
+    /*
+     * A page prefetched at prefetchLsn is still the right image at _lsn when
+     * no version of it lies in (prefetchLsn, _lsn].
+     */
+    bool TakePrefetchedPage(_Page &_return, const _Smgr_Relation &_reln, int32_t _forknum, int32_t _blknum,
+                            int64_t _lsn) {
+        PrefetchKey prefetchKey = MakePrefetchKey(_reln, _forknum, _blknum);
+        int64_t prefetchLsn;
+        if (!prefetchCache.Take(prefetchKey, &prefetchLsn, _return))
+            return false;
+        if (prefetchLsn >= _lsn)
+            return prefetchLsn == _lsn;
+
+        KeyType key;
+        key.SpcID = _reln._spc_node;
+        key.DbID = _reln._db_node;
+        key.RelID = _reln._rel_node;
+        key.ForkNum = _forknum;
+        key.BlkNum = _blknum;
 
-        WaitParse(_lsn);
+        uint64_t latestLsn;
+        if (HashMapGetLatestLsn(pageVersionHashMap, key, _lsn, &latestLsn) && latestLsn > (uint64_t) prefetchLsn)
+            return false;
+        return true;
+    }
+    /*
+     * The block of a database clone, as its parent had it at the fork LSN,
+     * into page. False if the block is the clone's own.
+     */
+    bool ReadCloneParentPage(char *page, const _Smgr_Relation &_reln, const int32_t _forknum, const int32_t _blknum,
+                             RelFileNode rnode) {
+        DbCloneRoute clone;
+        if (!DbCloneRouteBlock(rnode, (ForkNumber) _forknum, (BlockNumber) _blknum, &clone))
+            return false;
+
+        _Smgr_Relation parent = _reln;
+        parent._spc_node = clone.parent.spcNode;
+        parent._db_node = clone.parent.dbNode;
+        parent._rel_node = clone.parent.relNode;
+        MaterializePageAtLsn(page, parent, _forknum, _blknum, (int64_t) clone.forkLsn, false, true);
+        return true;
+    }
+
+    /*
+     * Materialize one page version at _lsn into page (BLCKSZ bytes), with its
+     * checksum stamped. The caller must have already waited for the parser
+     * to reach _lsn. A block another storage shard owns is read from it,
+     * unless forward is off.
+     */
+    void ReadPageAtLsn(char *page, const _Smgr_Relation &_reln, const int32_t _forknum, const int32_t _blknum,
+                       const int64_t _lsn, bool onDemand = true, bool forward = true) {
+        MaterializePageAtLsn(page, _reln, _forknum, _blknum, _lsn, onDemand, forward);
+        StampPageChecksum(page, (BlockNumber) _blknum);
+    }
 
+    void MaterializePageAtLsn(char *page, const _Smgr_Relation &_reln, const int32_t _forknum, const int32_t _blknum,
+                              const int64_t _lsn, bool onDemand, bool forward) {
         RelFileNode rnode;
         rnode.spcNode = _reln._spc_node;
         rnode.dbNode = _reln._db_node;
         rnode.relNode = _reln._rel_node;
 
+        ShardRoute route;
+        bool migrated = false;
+        if (ShardMapRoute(rnode.spcNode, rnode.dbNode, rnode.relNode, (BlockNumber) _blknum, (XLogRecPtr) _lsn, &route)) {
+            if (route.shard != MyStorageShard && forward) {
+                RpcShardReadPage(route.shard, page, rnode, (ForkNumber) _forknum, (BlockNumber) _blknum, (XLogRecPtr) _lsn);
+                return;
+            }
+            migrated = route.shard == MyStorageShard && route.baseShard >= 0;
+        }
+
+        // Dropped by then, its chains may be half reclaimed
+        if (LogindexTombstoneHides(rnode, (uint64_t) _lsn)) {
+            memset(page, 0, BLCKSZ);
+            return;
+        }
+
         KeyType key;
         key.SpcID = _reln._spc_node;
         key.DbID = _reln._db_node;
@@ -316,19 +1254,41 @@ public:
         uint64_t replayedLsn;
         uint64_t *toReplayList;
         int listSize = 0;
+        uint64 stageStart = StageTimingStart();
         int found = HashMapGetBlockReplayList(pageVersionHashMap, key, _lsn, &replayedLsn, &toReplayList, &listSize);
+        StageTimingEnd(STAGE_HASHMAP_LOOKUP, stageStart);
+
+        // What this shard indexed before it last gave the partition away is
+        // stale, the previous owner has what came since
+        if (found && migrated) {
+            int kept = 0;
+
+            if (replayedLsn <= route.baseLsn)
+                replayedLsn = 0;
+            for (int i = 0; i < listSize; i++)
+                if (toReplayList[i] > route.baseLsn)
+                    toReplayList[kept++] = toReplayList[i];
+            if (kept == 0 && listSize > 0)
+                free(toReplayList);
+            listSize = kept;
+        }
 
+        // Steer the background replay to what is read, and above all to what
+        // had to be replayed while the reader waited
+        if (onDemand)
+            ASR_RecordRead(key.DbID, key.RelID);
+        if (found && onDemand)
+            LogindexHotQueueRecord(key, listSize > 0 ? LOGINDEX_HOT_MISS_WEIGHT : LOGINDEX_HOT_READ_WEIGHT);
 
         if (!found || replayedLsn <= 0ull && listSize == 0) {
 
             BufferTag bufferTag;
             INIT_BUFFERTAG(bufferTag, rnode, (ForkNumber) _forknum, (BlockNumber) _blknum);
-            char *buff = (char *) malloc(BLCKSZ);
-            GetBasePage(rnode, (ForkNumber) _forknum, (BlockNumber) _blknum, buff);
-
-            _return.assign(buff, BLCKSZ);
-
-            free(buff);
+            if (migrated)
+                RpcShardReadPage(route.baseShard, page, rnode, (ForkNumber) _forknum, (BlockNumber) _blknum, route.baseLsn);
+            else if (!ReadCloneParentPage(page, _reln, _forknum, _blknum, rnode))
+                GetBasePage(rnode, (ForkNumber) _forknum, (BlockNumber) _blknum, page);
+            SmartReplayMetricsCountRead(PAGE_READ_BASE);
 
 //            printf("%s %d, spc = %lu, db = %lu, rel = %lu, fork = %d, blk = %d, lsn = %lu, tid = %d\n", __func__ , __LINE__,
 //                   _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum, _blknum, _lsn, gettid());
@@ -339,14 +1299,11 @@ public:
 
         // Then replayLSN is what we needed from RocksDB
         if (listSize == 0) {
-            char* targetPage = NULL;
-
             BufferTag bufferTag;
             INIT_BUFFERTAG(bufferTag, rnode, (ForkNumber) _forknum, (BlockNumber) _blknum);
-            GetPageFromRocksdb(bufferTag, replayedLsn, &targetPage);
-
-            _return.assign(targetPage, BLCKSZ);
-            free(targetPage);
+            // Straight from the pinned value into the response
+            ReadPageFromRocksdb(bufferTag, replayedLsn, page);
+            SmartReplayMetricsCountRead(PAGE_READ_ROCKSDB);
 //            printf("%s %d, spc = %lu, db = %lu, rel = %lu, fork = %d, blk = %d, lsn = %lu, tid = %d\n", __func__ , __LINE__,
 //                   _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum, _blknum, _lsn, gettid());
 //            fflush(stdout);
@@ -357,9 +1314,8 @@ public:
          * Adaptive Smart Replay: record a hot miss.
          * We're here because replay is not caught up and we must block to replay logs.
          */
-        ASR_RecordHotMiss();
-
-        char *page2 = (char *) malloc(BLCKSZ);
+        if (onDemand)
+            ASR_RecordHotMiss(key.DbID, key.RelID);
 
         //! Print all the lsn in the list
 //        printf("%s %d, tid = %d, listsize = %d, replayedLSN = %lu\n", __func__ , __LINE__, gettid(), listSize, replayedLsn);
@@ -369,26 +1325,60 @@ public:
 //            fflush(stdout);
 //        }
 
+        // Another reader may be replaying this very version already
+        ReplayFlightKey flightKey = {MakePrefetchKey(_reln, _forknum, _blknum), toReplayList[listSize - 1]};
+        ReplayInFlightTable::Ticket ticket(replayFlights, flightKey);
+        replayFlights.Join(ticket, flightKey);
+        if (!ticket.leader && ticket.Wait(page)) {
+            free(toReplayList);
+            SmartReplayMetricsCountRead(PAGE_READ_REPLAY);
+            return;
+        }
+
         BufferTag bufferTag;
         INIT_BUFFERTAG(bufferTag, rnode, (ForkNumber) _forknum, (BlockNumber) _blknum);
 
         if(replayedLsn > 0) {
-            char* basePage = NULL;
-            GetPageFromRocksdb(bufferTag, replayedLsn, &basePage);
+            PGAlignedBlock basePage;
+            bool baseFound = ReadPageFromRocksdb(bufferTag, replayedLsn, basePage.data);
             ApplyLsnList(rnode, (ForkNumber) _forknum, (BlockNumber) _blknum, reinterpret_cast<XLogRecPtr *>(toReplayList),
-                         listSize, basePage, page2);
-            free(basePage);
+                         listSize, baseFound ? basePage.data : NULL, page);
+        } else if (migrated) {
+            // The relation files here don't have the blocks moved in
+            PGAlignedBlock basePage;
+            RpcShardReadPage(route.baseShard, basePage.data, rnode, (ForkNumber) _forknum, (BlockNumber) _blknum, route.baseLsn);
+            ApplyLsnList(rnode, (ForkNumber) _forknum, (BlockNumber) _blknum, reinterpret_cast<XLogRecPtr *>(toReplayList),
+                         listSize, basePage.data, page);
         } else {
-            ApplyLsnListAndGetUpdatedPage(rnode, (ForkNumber) _forknum, (BlockNumber) _blknum, reinterpret_cast<XLogRecPtr *>(toReplayList),
-                                          listSize, page2);
+            // A clone's versions go on top of its parent's page
+            PGAlignedBlock basePage;
+            if (ReadCloneParentPage(basePage.data, _reln, _forknum, _blknum, rnode))
+                ApplyLsnList(rnode, (ForkNumber) _forknum, (BlockNumber) _blknum, reinterpret_cast<XLogRecPtr *>(toReplayList),
+                             listSize, basePage.data, page);
+            else
+                ApplyLsnListAndGetUpdatedPage(rnode, (ForkNumber) _forknum, (BlockNumber) _blknum, reinterpret_cast<XLogRecPtr *>(toReplayList),
+                                              listSize, page);
         }
 
 
-        PutPage2Rocksdb(bufferTag, toReplayList[listSize - 1], page2);
+        // A page cheap to replay again and rarely read stays as WAL only
+        bool materialize = LogindexShouldMaterialize(LogindexHotQueueScore(key), listSize);
+
+        stageStart = StageTimingStart();
+        if (materialize)
+            PutPage2Rocksdb(bufferTag, toReplayList[listSize - 1], page);
+        SmartReplayMetricsCountRead(PAGE_READ_REPLAY);
+        if (ticket.leader)
+            ticket.Publish(page);
 
 
         if (listSize > 0) {
-            HashMapUpdateReplayedLsn(pageVersionHashMap, key, toReplayList[listSize - 1], true);
+            // HashMapGetBlockReplayList took the version for materialized
+            if (materialize)
+                HashMapUpdateReplayedLsn(pageVersionHashMap, key, toReplayList[listSize - 1], true);
+            else
+                HashMapUpdateMaterializedStatus(pageVersionHashMap, key, toReplayList[listSize - 1], true, false);
+            StageTimingEnd(STAGE_PUT_BACK, stageStart);
 
             free(toReplayList);
 #ifdef ENABLE_FUNCTION_TIMING
@@ -396,26 +1386,570 @@ public:
 #endif
         }
 
-        HashMapGarbageCollectKey(pageVersionHashMap, key);
+        // Off the read path, the GC threads trim it
+        LogindexGcQueuePush(pageVersionHashMap, key);
 
 //        printf("%s %d end, targetPageLsn = %lu, spc = %lu, db = %lu, rel = %lu, fork = %d, blk = %d, lsn = %lu, tid = %d\n", __func__ , __LINE__,
-//               PageGetLSN(page2), _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum, _blknum, _lsn, gettid());
+//               PageGetLSN(page), _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum, _blknum, _lsn, gettid());
 //        fflush(stdout);
 
-#ifdef DEBUG_TIMING
-        RECORD_TIMING(&start, &end, &readBufferCommon[14], &readBufferCount[14])
-#endif
 
-        //TODO: Return page2
-        // Set the desired page version as return value
-        _return.assign(page2, BLCKSZ);
+    }
+
+public:
+    DataPageAccessHandler() {
+        // Your initialization goes here
+    }
+
+    /*
+     * Runs a request a backend sent over its queue pair, see
+     * storage/rpc_rdma.h, the way SharedMemoryLoop runs one of a slot. The
+     * serving thread of the backend writes the page back.
+     */
+    void ServeRdmaRequest(const RpcRdmaRequest *request, RpcRdmaReply *reply, char *buff) {
+        _Smgr_Relation reln;
+        _Page page;
+
+        reln._spc_node = request->spcNode;
+        reln._db_node = request->dbNode;
+        reln._rel_node = request->relNode;
+        reln._backend_id = InvalidBackendId;
+        reply->status = RPC_RDMA_OK;
+        if (request->command == RPC_RDMA_NBLOCKS) {
+            try {
+                reply->nblocks = RpcMdNblocks(reln, request->forkNum, request->lsn);
+            } catch (std::exception &e) {
+                reply->status = RPC_RDMA_FAILED;
+            }
+            return;
+        }
+        if (request->command != RPC_RDMA_READ) {
+            reply->status = RPC_RDMA_FAILED;
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        if (GetRequestLanes().Enabled())
+            GetRequestLanes().Acquire(request->requestClass, NULL, NULL);
+        try {
+            ReadBufferCommon(page, reln, request->relPersistence, request->forkNum, request->blkNum,
+                             request->readBufferMode, request->lsn, request->traceId);
+        } catch (std::exception &e) {
+            reply->status = RPC_RDMA_FAILED;
+        }
+        if (GetRequestLanes().Enabled())
+            GetRequestLanes().Release(NULL, (uint64) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+        if (page.size() < BLCKSZ)
+            reply->status = RPC_RDMA_FAILED;
+        if (reply->status != RPC_RDMA_OK)
+            return;
+        memcpy(buff, page.data(), BLCKSZ);
+        if (page.size() == BLCKSZ + sizeof(StageTraceTrailer)) {
+            StageTraceTrailer trailer;
+
+            memcpy(&trailer, page.data() + BLCKSZ, sizeof(trailer));
+            reply->waitParseNs = pg_ntoh64(trailer.wait_parse_ns);
+            reply->replayNs = pg_ntoh64(trailer.replay_ns);
+        }
+    }
+
+    /**
+     * A method definition looks like C code. It has a return type, arguments,
+     * and optionally a list of exceptions that it may throw. Note that argument
+     * lists and exception lists are specified using the exact same syntax as
+     * field lists in struct or exception definitions.
+     *
+     * @param _fd
+     */
+
+    void
+    ReadBufferCommon(_Page &_return, const _Smgr_Relation &_reln, const int32_t _relpersistence, const int32_t _forknum,
+                     const int32_t _blknum, const int32_t _readBufferMode, const int64_t _lsn, const int64_t _traceId) {
+
+//        printf("%s %d start, spc = %lu, db = %lu, rel = %lu, fork = %d, blk = %d, lsn = %lu, tid = %d\n", __func__ , __LINE__,
+//               _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum, _blknum, _lsn, gettid());
+//        fflush(stdout);
+
+        StageTraceScope scope(_traceId);
+
+        if (RequestTraceEnabled())
+            RequestTraceCapture(REQUEST_TRACE_READ, _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum,
+                                (uint32_t) _blknum, (uint64_t) _lsn, 0);
 
-        free(page2);
+        TRACE_POSTGRESQL_STORAGE_SERVE_START((uint64) _traceId, _forknum, _blknum, _reln._spc_node,
+                                             _reln._db_node, _reln._rel_node, (uint64) _lsn);
 
-#ifdef DEBUG_TIMING
-        RECORD_TIMING(&start, &end, &readBufferCommon[15], &readBufferCount[15])
+        WaitParse(_lsn);
+
+        if (!TakePrefetchedPage(_return, _reln, _forknum, _blknum, _lsn)) {
+            // Replay straight into the reply buffer, thrift serializes from it
+            _return.resize(BLCKSZ);
+            ReadPageAtLsn(&_return[0], _reln, _forknum, _blknum, _lsn, true,
+                          (_readBufferMode & SHARD_MAP_FORWARDED_READ) == 0);
+        }
+        CompressReplyPage(_return);
+
+        TRACE_POSTGRESQL_STORAGE_SERVE_DONE((uint64) _traceId, _forknum, _blknum, _reln._spc_node,
+                                            _reln._db_node, _reln._rel_node,
+                                            scope.trace.ns[STAGE_WAIT_PARSE], scope.trace.ns[STAGE_REDO]);
+        if (_traceId != 0) {
+            StageTraceTrailer trailer;
+
+            trailer.wait_parse_ns = pg_hton64(scope.trace.ns[STAGE_WAIT_PARSE]);
+            trailer.replay_ns = pg_hton64(scope.trace.ns[STAGE_REDO]);
+            _return.append((const char *) &trailer, sizeof(trailer));
+        }
+    }
+
+    /*
+     * Batched version of ReadBufferCommon. All blocks belong to the same
+     * relation fork and are materialized at the same _lsn, so the caller pays
+     * one round trip and one WaitParse for the whole batch. Blocks beyond the
+     * end of the relation are dropped, so the result may be shorter than
+     * _blknums.
+     */
+    void ReadBufferBatch(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _relpersistence,
+                         const int32_t _forknum, const std::vector<int64_t> & _blknums, const int32_t _readBufferMode,
+                         const int64_t _lsn) {
+#ifdef ENABLE_DEBUG_INFO
+        printf("%s %d , spc = %lu, db = %lu, rel = %lu, fork = %d, nblocks = %lu, lsn = %lu\n", __func__ , __LINE__,
+               _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum, _blknums.size(), _lsn);
+        fflush(stdout);
 #endif
+        if (RequestTraceEnabled())
+            RequestTraceCaptureList(REQUEST_TRACE_READ_BATCH, _reln._spc_node, _reln._db_node, _reln._rel_node,
+                                    _forknum, _blknums.data(), (int) _blknums.size(), (uint64_t) _lsn);
+
+        WaitParse(_lsn);
+
+        int64_t relSize = MdNblocks(_reln, _forknum, _lsn);
+
+        _return.clear();
+        _return.reserve(_blknums.size());
+        for (size_t i = 0; i < _blknums.size(); i++) {
+            if (_blknums[i] >= relSize)
+                break;
+            _return.emplace_back(BLCKSZ, '\0');
+        }
+
+        // Blocks that were never versioned are read from the relation files
+        // together, their disk reads overlap instead of queueing up
+        std::vector<BasePageRequest> baseRequests;
+        if (base_page_direct_read) {
+            KeyType key;
+            key.SpcID = _reln._spc_node;
+            key.DbID = _reln._db_node;
+            key.RelID = _reln._rel_node;
+            key.ForkNum = _forknum;
+
+            for (size_t i = 0; i < _return.size(); i++) {
+                uint64_t latestLsn;
+
+                key.BlkNum = (int32_t) _blknums[i];
+                if (HashMapGetLatestLsn(pageVersionHashMap, key, _lsn, &latestLsn))
+                    continue;
+                // Only the blocks this shard always had are in its files
+                ShardRoute route;
+                if (ShardMapRoute(key.SpcID, key.DbID, key.RelID, (BlockNumber) key.BlkNum, (XLogRecPtr) _lsn, &route)
+                    && (route.shard != MyStorageShard || route.baseShard >= 0))
+                    continue;
+                BasePageRequest request;
+                request.rnode.spcNode = _reln._spc_node;
+                request.rnode.dbNode = _reln._db_node;
+                request.rnode.relNode = _reln._rel_node;
+                request.forknum = (ForkNumber) _forknum;
+                request.blkno = (BlockNumber) _blknums[i];
+                request.page = &_return[i][0];
+                baseRequests.push_back(request);
+            }
+            if (baseRequests.size() > 1)
+                BasePageReaderReadList(baseRequests.data(), (int) baseRequests.size());
+            else
+                baseRequests.clear();
+        }
+
+        size_t next = 0;
+        for (size_t i = 0; i < _return.size(); i++) {
+            if (next < baseRequests.size() && baseRequests[next].page == &_return[i][0]) {
+                if (baseRequests[next++].done) {
+                    ASR_RecordRead(_reln._db_node, _reln._rel_node);
+                    SmartReplayMetricsCountRead(PAGE_READ_BASE);
+                    continue;
+                }
+            }
+            ReadPageAtLsn(&_return[i][0], _reln, _forknum, (int32_t) _blknums[i], _lsn);
+        }
+        for (size_t i = 0; i < _return.size(); i++)
+            CompressReplyPage(_return[i]);
+    }
+
+    /*
+     * The first _max_blocks pages of many relations in one round trip, what a
+     * compute node's backends read of the catalogs while starting up. The
+     * first element holds the number of pages of each relation, fewer than
+     * _max_blocks for a shorter one; the pages follow in _relns order.
+     */
+    void ReadRelationHeads(std::vector<_Page> & _return, const std::vector<_Smgr_Relation> & _relns,
+                           const int32_t _forknum, const int32_t _max_blocks, const int64_t _lsn) {
+        std::vector<int32_t> counts(_relns.size());
+
+        WaitParse(_lsn);
+
+        for (size_t i = 0; i < _relns.size(); i++)
+            counts[i] = (int32_t) Min((int64_t) MdNblocks(_relns[i], _forknum, _lsn), (int64_t) Max(_max_blocks, 0));
+
+        _return.clear();
+        _return.emplace_back((const char *) counts.data(), counts.size() * sizeof(int32_t));
+        for (size_t i = 0; i < _relns.size(); i++) {
+            for (int32_t blkno = 0; blkno < counts[i]; blkno++) {
+                _return.emplace_back(BLCKSZ, '\0');
+                ReadPageAtLsn(&_return.back()[0], _relns[i], _forknum, blkno, _lsn);
+                CompressReplyPage(_return.back());
+            }
+        }
+    }
+
+    // Whether summary, of the range from firstBlock, holds at _lsn: no block
+    // of it got a version after the summary's
+    static bool ZoneMapCurrent(RelFileNode rnode, int32_t firstBlock, const RpcZoneMapSummary& summary,
+                               const int64_t _lsn) {
+        if ((uint64_t) _lsn < summary.lsn)
+            return false;
+        for (int32_t blkno = firstBlock; blkno < firstBlock + RPC_ZONEMAP_RANGE_BLOCKS; blkno++) {
+            KeyType key;
+            key.SpcID = rnode.spcNode;
+            key.DbID = rnode.dbNode;
+            key.RelID = rnode.relNode;
+            key.ForkNum = MAIN_FORKNUM;
+            key.BlkNum = blkno;
+
+            uint64_t latestLsn = 0;
+            if (HashMapGetLatestLsn(pageVersionHashMap, key, (uint64_t) _lsn, &latestLsn) && latestLsn > summary.lsn)
+                return false;
+        }
+        return true;
+    }
+
+    /*
+     * A scan with its qual evaluated here, see storage/rpc_scan.h. Of blocks
+     * [_first_block, _end_block) only the pages holding a tuple _qual may be
+     * true for are sent, at most _max_pages of them. The first element holds
+     * the block to go on from, then the numbers of the pages that follow.
+     * A _qual this node can't read lets every page through. A whole range of
+     * blocks read leaves its zone map, see storage/rpc_zonemap.h, and a range
+     * whose zone map rules _qual out isn't read.
+     */
+    void ScanRelation(std::vector<_Page> & _return, const _Smgr_Relation& _reln, const int32_t _first_block,
+                      const int32_t _end_block, const std::string& _qual, const int32_t _max_pages,
+                      const int64_t _lsn) {
+        RpcScanQual qual;
+        std::vector<int32_t> header(1);
+        std::vector<_Page> pages;
+        std::string page(BLCKSZ, '\0');
+        int32_t blkno;
+
+        memset(&qual, 0, sizeof(qual));
+        if (_qual.size() == sizeof(qual))
+            memcpy(&qual, _qual.data(), sizeof(qual));
+
+        WaitParse(_lsn);
+
+        RelFileNode rnode;
+        rnode.spcNode = _reln._spc_node;
+        rnode.dbNode = _reln._db_node;
+        rnode.relNode = _reln._rel_node;
+
+        RpcZoneMapSummary summary;
+        bool summarizing = false;
+        int32_t end = (int32_t) Min((int64_t) _end_block, (int64_t) MdNblocks(_reln, MAIN_FORKNUM, _lsn));
+        for (blkno = Max(_first_block, 0); blkno < end && (int32_t) pages.size() < _max_pages; blkno++) {
+            if (blkno % RPC_ZONEMAP_RANGE_BLOCKS == 0 && blkno + RPC_ZONEMAP_RANGE_BLOCKS <= end) {
+                uint32_t range = (uint32_t) blkno / RPC_ZONEMAP_RANGE_BLOCKS;
+
+                if (RpcZoneMapLookup(rnode, &qual, range, &summary) && ZoneMapCurrent(rnode, blkno, summary, _lsn)) {
+                    if (RpcZoneMapExcludes(&qual, &summary)) {
+                        blkno += RPC_ZONEMAP_RANGE_BLOCKS - 1;
+                        continue;
+                    }
+                    summarizing = false;
+                } else {
+                    RpcZoneMapInitSummary(&summary, (uint64_t) _lsn);
+                    summarizing = true;
+                }
+            }
+
+            ReadPageAtLsn(&page[0], _reln, MAIN_FORKNUM, blkno, _lsn);
+            if (summarizing) {
+                RpcZoneMapAddPage(&qual, page.data(), &summary);
+                if (blkno % RPC_ZONEMAP_RANGE_BLOCKS == RPC_ZONEMAP_RANGE_BLOCKS - 1) {
+                    RpcZoneMapStore(rnode, &qual, (uint32_t) blkno / RPC_ZONEMAP_RANGE_BLOCKS, &summary);
+                    summarizing = false;
+                }
+            }
+            if (!RpcScanPageMayMatch(&qual, page.data()))
+                continue;
+            header.push_back(blkno);
+            pages.push_back(page);
+            CompressReplyPage(pages.back());
+        }
+        header[0] = Max(blkno, _first_block);
+
+        _return.clear();
+        _return.reserve(pages.size() + 1);
+        _return.emplace_back((const char *) header.data(), header.size() * sizeof(int32_t));
+        for (auto &p : pages)
+            _return.push_back(std::move(p));
+    }
+
+    /*
+     * Partial aggregation here, see storage/rpc_agg.h. The all-visible pages
+     * of blocks [_first_block, _end_block) are added to the states of _spec's
+     * aggregates, the numbers of the others follow the RpcAggReply, at most
+     * _max_fallback of them. A _spec this node can't read adds no page.
+     */
+    void AggregateRelation(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block,
+                           const int32_t _end_block, const std::string& _spec, const int32_t _max_fallback,
+                           const int64_t _lsn) {
+        RpcAggSpec spec;
+        RpcAggReply reply;
+        std::vector<int32_t> fallback;
+        std::string page(BLCKSZ, '\0');
+        int32_t blkno;
+
+        memset(&spec, 0, sizeof(spec));
+        if (_spec.size() == sizeof(spec))
+            memcpy(&spec, _spec.data(), sizeof(spec));
+        memset(&reply, 0, sizeof(reply));
+        RpcAggInit(&spec, reply.states);
+
+        WaitParse(_lsn);
+
+        int32_t end = (int32_t) Min((int64_t) _end_block, (int64_t) MdNblocks(_reln, MAIN_FORKNUM, _lsn));
+        for (blkno = Max(_first_block, 0); blkno < end && (int32_t) fallback.size() < _max_fallback; blkno++) {
+            ReadPageAtLsn(&page[0], _reln, MAIN_FORKNUM, blkno, _lsn);
+            if (!RpcAggPage(&spec, page.data(), reply.states))
+                fallback.push_back(blkno);
+        }
+        reply.nextBlock = Max(blkno, _first_block);
+        reply.nfallback = (int32_t) fallback.size();
+
+        _return.assign((const char *) &reply, sizeof(reply));
+        _return.append((const char *) fallback.data(), fallback.size() * sizeof(int32_t));
+    }
+
+    /*
+     * Vacuum triage here, see storage/rpc_vacuum.h. Of blocks [_first_block,
+     * _end_block) the pages needing no read by the compute node are listed,
+     * until their dead items would be more than _max_dead. A _horizon this
+     * node can't read lists no page.
+     */
+    void TriageVacuum(std::string& _return, const _Smgr_Relation& _reln, const int32_t _first_block,
+                      const int32_t _end_block, const std::string& _horizon, const int32_t _max_dead,
+                      const int64_t _lsn) {
+        RpcVacuumHorizon horizon;
+        RpcVacuumReply reply;
+        std::vector<RpcVacuumEntry> entries;
+        std::vector<uint16_t> dead;
+        uint16_t offsets[MaxHeapTuplesPerPage];
+        std::string page(BLCKSZ, '\0');
+        int32_t blkno;
+
+        memset(&horizon, 0, sizeof(horizon));
+        if (_horizon.size() == sizeof(horizon))
+            memcpy(&horizon, _horizon.data(), sizeof(horizon));
+
+        WaitParse(_lsn);
 
+        int32_t end = (int32_t) Min((int64_t) _end_block, (int64_t) MdNblocks(_reln, MAIN_FORKNUM, _lsn));
+        for (blkno = Max(_first_block, 0); blkno < end; blkno++) {
+            RpcVacuumEntry entry;
+
+            ReadPageAtLsn(&page[0], _reln, MAIN_FORKNUM, blkno, _lsn);
+            if (RpcVacuumTriagePage(&horizon, page.data(), &entry, offsets) == RPC_VACUUM_READ)
+                continue;
+            if (entry.ndead > 0) {
+                // No index to collect them for, the compute node vacuums the page
+                if (_max_dead <= 0)
+                    continue;
+                if ((int32_t) dead.size() + entry.ndead > _max_dead)
+                    break;
+                dead.insert(dead.end(), offsets, offsets + entry.ndead);
+            }
+            entry.blkno = blkno;
+            entries.push_back(entry);
+        }
+        reply.nextBlock = Max(blkno, _first_block);
+        reply.nentries = (int32_t) entries.size();
+
+        _return.assign((const char *) &reply, sizeof(reply));
+        _return.append((const char *) entries.data(), entries.size() * sizeof(RpcVacuumEntry));
+        _return.append((const char *) dead.data(), dead.size() * sizeof(uint16_t));
+    }
+
+    /*
+     * Conditional version of ReadBufferCommon. _cachedLsn is the page LSN of
+     * the copy the client already holds. Version map entries are keyed by
+     * record start LSN while the page LSN is the record end, so the copy is
+     * current if the newest version <= _lsn starts before _cachedLsn. In
+     * that case reply with an empty page; otherwise ship the image.
+     */
+    void ReadBufferIfModified(_Page& _return, const _Smgr_Relation& _reln, const int32_t _relpersistence,
+                              const int32_t _forknum, const int32_t _blknum, const int32_t _readBufferMode,
+                              const int64_t _lsn, const int64_t _cachedLsn) {
+        if (RequestTraceEnabled())
+            RequestTraceCapture(REQUEST_TRACE_READ_IF_MODIFIED, _reln._spc_node, _reln._db_node, _reln._rel_node,
+                                _forknum, (uint32_t) _blknum, (uint64_t) _lsn, (uint64_t) _cachedLsn);
+
+        WaitParse(_lsn);
+
+        if (_cachedLsn > 0) {
+            KeyType key;
+            key.SpcID = _reln._spc_node;
+            key.DbID = _reln._db_node;
+            key.RelID = _reln._rel_node;
+            key.ForkNum = _forknum;
+            key.BlkNum = _blknum;
+
+            uint64_t latestLsn;
+            if (HashMapGetLatestLsn(pageVersionHashMap, key, _lsn, &latestLsn)
+                && latestLsn < (uint64_t) _cachedLsn) {
+                _return.clear();
+                return;
+            }
+        }
+
+        _return.resize(BLCKSZ);
+        ReadPageAtLsn(&_return[0], _reln, _forknum, _blknum, _lsn);
+        CompressReplyPage(_return);
+    }
+
+    /*
+     * Queue pages for background replay so that a later ReadBufferCommon
+     * finds them in the ready cache instead of replaying synchronously.
+     * Returns at once; requests beyond PREFETCH_QUEUE_SIZE are dropped.
+     */
+    int32_t PrefetchBuffers(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums,
+                            const int64_t _lsn) {
+        if (RequestTraceEnabled())
+            RequestTraceCaptureList(REQUEST_TRACE_PREFETCH, _reln._spc_node, _reln._db_node, _reln._rel_node,
+                                    _forknum, _blknums.data(), (int) _blknums.size(), (uint64_t) _lsn);
+
+        std::call_once(prefetchWorkersStarted, [this] {
+            for (int i = 0; i < PREFETCH_WORKERS; i++)
+                std::thread(&DataPageAccessHandler::PrefetchWorkerLoop, this).detach();
+        });
+
+        int32_t queued = 0;
+        {
+            std::lock_guard<std::mutex> guard(prefetchQueueMutex);
+            for (size_t i = 0; i < _blknums.size() && prefetchQueue.size() < PREFETCH_QUEUE_SIZE; i++) {
+                PrefetchRequest request = {_reln, _forknum, (int32_t) _blknums[i], _lsn};
+                prefetchQueue.push_back(request);
+                queued++;
+            }
+        }
+        prefetchQueueCond.notify_all();
+        return queued;
+    }
+
+    /*
+     * Pages a compute node wrote without WAL, under wal_level=minimal, go in
+     * as materialized versions at _lsn: a full page version the logindex
+     * points at, with nothing to replay under it. A block with a newer
+     * version from the WAL keeps it. Returns how many pages went in.
+     */
+    int32_t InstallPages(const _Smgr_Relation& _reln, const int32_t _forknum, const std::vector<int64_t> & _blknums,
+                         const _Page& _pages, const int64_t _lsn) {
+        if (_pages.size() != _blknums.size() * BLCKSZ)
+            return 0;
+        // WAL of the blocks from before _lsn has to be in the logindex first
+        WaitParse(_lsn);
+
+        RelFileNode rnode;
+        rnode.spcNode = _reln._spc_node;
+        rnode.dbNode = _reln._db_node;
+        rnode.relNode = _reln._rel_node;
+
+        RelKey relKey;
+        TransRelNode2RelKey(rnode, &relKey, (ForkNumber) _forknum);
+
+        if (_forknum == MAIN_FORKNUM)
+            RpcZoneMapDropRelation(rnode, 0);
+
+        int32_t installed = 0;
+        PGAlignedBlock page;
+        for (size_t i = 0; i < _blknums.size(); i++) {
+            KeyType key;
+            key.SpcID = _reln._spc_node;
+            key.DbID = _reln._db_node;
+            key.RelID = _reln._rel_node;
+            key.ForkNum = _forknum;
+            key.BlkNum = _blknums[i];
+
+            uint64_t latestLsn = 0;
+            bool known = HashMapGetLatestLsn(pageVersionHashMap, key, UINT64_MAX, &latestLsn);
+            if (known && latestLsn > (uint64_t) _lsn)
+                continue;
+
+            BufferTag bufferTag;
+            INIT_BUFFERTAG(bufferTag, rnode, (ForkNumber) _forknum, (BlockNumber) _blknums[i]);
+            _pages.copy(page.data, BLCKSZ, i * BLCKSZ);
+            PutPage2Rocksdb(bufferTag, (uint64_t) _lsn, page.data);
+
+            if (!known || latestLsn < (uint64_t) _lsn)
+                HashMapInsertKey(pageVersionHashMap, key, (uint64_t) _lsn, 0, true, true);
+            HashMapUpdateMaterializedStatus(pageVersionHashMap, key, (uint64_t) _lsn, false, true);
+            HashMapUpdateReplayedLsn(pageVersionHashMap, key, (uint64_t) _lsn, false);
+            ExtendRelSizeCache(relKey, (uint32_t) _blknums[i] + 1);
+            installed++;
+        }
+        return installed;
+    }
+
+    /*
+     * Clean pages a compute node evicted, their images in _pages, to save
+     * the replay of their chains on the next read. They're queued and
+     * installed in the background, see BackgroundInstallPage. _lsn is the
+     * WAL the compute node had flushed; no page past it is taken. Returns
+     * how many were queued, those beyond EVICTED_INSTALL_QUEUE_PAGES are
+     * dropped.
+     */
+    int32_t InstallEvictedPages(const _Smgr_Relation& _reln, const int32_t _forknum,
+                                const std::vector<int64_t> & _blknums, const _Page& _pages, const int64_t _lsn) {
+        if (_pages.size() != _blknums.size() * BLCKSZ || _blknums.empty())
+            return 0;
+
+        std::call_once(evictedWorkerStarted, [this] {
+            std::thread(&DataPageAccessHandler::EvictedInstallLoop, this).detach();
+        });
+
+        {
+            std::lock_guard<std::mutex> guard(evictedQueueMutex);
+            if (evictedQueuedPages + _blknums.size() > EVICTED_INSTALL_QUEUE_PAGES)
+                return 0;
+            EvictedPageBatch batch = {_reln, _forknum, _blknums, _pages, _lsn};
+            evictedQueue.push_back(std::move(batch));
+            evictedQueuedPages += _blknums.size();
+        }
+        evictedQueueCond.notify_one();
+        return (int32_t) _blknums.size();
+    }
+
+    // Feeds pg_stat_smart_replay on the compute nodes
+    void RpcGetSmartReplayMetrics(std::string& _return) {
+        size_t len;
+        char *text = SmartReplayMetricsText(&len);
+
+        if(text != NULL) {
+            _return.assign(text, len);
+            free(text);
+        }
+    }
+
+    void RpcFetchPageChanges(_Page& _return, const int32_t _max_entries, const int32_t _wait_ms, const int64_t _from_seq) {
+        _return.resize(PageChangeFeedReplySize(_max_entries));
+        _return.resize(PageChangeFeedRead((uint64_t) _from_seq, _max_entries, _wait_ms, &_return[0]));
     }
 
     int32_t RpcRegisterSecondaryNode(bool _primary, int64_t _lsn){
@@ -426,6 +1960,25 @@ public:
         HashMapSecondaryNodeUpdatesLsn(pageVersionHashMap, _node_id, _lsn);
     }
 
+    int32_t RpcSecondaryNodeHeartbeat(const int32_t _node_id, const int64_t _lsn) {
+        return HashMapSecondaryNodeUpdatesLsn(pageVersionHashMap, _node_id, _lsn);
+    }
+
+    // Waits for the WAL writes queued so far and then, up to _wait_ms, for
+    // the parse to reach _lsn. Returns how far the WAL is parsed, 0 if a
+    // write failed, which a compute node's checkpoint holds its redo pointer
+    // against
+    int64_t RpcWaitWalParsed(const int32_t _wait_ms, const int64_t _lsn) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_wait_ms);
+
+        if(!xlogPersistQueue.Wait())
+            return 0;
+        WaitParse(_lsn);
+        while(XLogParseUpto < (XLogRecPtr) _lsn && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return (int64_t) XLogParseUpto;
+    }
+
     void RpcMdRead(_Page& _return, const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _blknum, const int64_t _lsn) {
 #ifdef ENABLE_FUNCTION_TIMING
         FunctionTiming functionTiming(const_cast<char *>(__func__));
@@ -445,7 +1998,9 @@ public:
 
         char buff[BLCKSZ];
         GetPageByLsn(rnode, (ForkNumber)_forknum, _blknum, 0, buff);
+        StampPageChecksum(buff, (BlockNumber) _blknum);
         _return.assign(buff, BLCKSZ);
+        CompressReplyPage(_return);
 
 #ifdef ENABLE_DEBUG_INFO
         printf("%s End\n", __func__ );
@@ -483,6 +2038,14 @@ public:
     }
 
     int32_t RpcMdNblocks(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn) {
+        if (RequestTraceEnabled())
+            RequestTraceCapture(REQUEST_TRACE_NBLOCKS, _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum,
+                                0, (uint64_t) _lsn, 0);
+        return MdNblocks(_reln, _forknum, _lsn);
+    }
+
+    // The size lookup of RpcMdNblocks, which ReadBufferBatch makes too without it being a request of its own
+    int32_t MdNblocks(const _Smgr_Relation& _reln, const int32_t _forknum, const int64_t _lsn) {
 #ifdef ENABLE_FUNCTION_TIMING
         FunctionTiming functionTiming(const_cast<char *>(__func__));
 #endif
@@ -494,15 +2057,8 @@ public:
         // Your implementation goes here
 //        SyncReplayProcess();
 
-#ifdef DEBUG_TIMING
-        struct timeval start, end;
-        START_TIMING(&start);
-#endif
         WaitParse(_lsn);
 
-#ifdef DEBUG_TIMING
-        RECORD_TIMING(&start, &end, &nblocksTime[4], &nblocksCount[4])
-#endif
         RelFileNode rnode;
         rnode.spcNode = _reln._spc_node;
         rnode.dbNode = _reln._db_node;
@@ -514,32 +2070,23 @@ public:
         TransRelNode2RelKey(rnode, &relKey, (ForkNumber)_forknum);
 
 
-#ifdef DEBUG_TIMING
-        RECORD_TIMING(&start, &end, &nblocksTime[0], &nblocksCount[0])
-#endif
 
         uint32_t foundPageNum = 0;
+        // The size at _lsn, which the cache doesn't tell once the relation changed since
+        if (_lsn > 0 && RpcRelSizeLookup(relKey, (uint64_t) _lsn, &foundPageNum))
+            return (int32_t)foundPageNum;
 //        printf("%s %d\n", __func__ , __LINE__);
 //        fflush(stdout);
-        RelSizePthreadReadLock(relKey);
         if ( GetRelSizeCache(relKey, &foundPageNum) ) {
-            RelSizePthreadUnlock(relKey);
 #ifdef ENABLE_DEBUG_INFO2
             printf("%s cached, pageNum = %u\n", __func__, foundPageNum);
             fflush(stdout);
-#endif
-#ifdef DEBUG_TIMING
-            RECORD_TIMING(&start, &end, &nblocksTime[1], &nblocksCount[1])
 #endif
             return (int32_t)foundPageNum;
         }
 //        printf("%s %d\n", __func__ , __LINE__);
 //        fflush(stdout);
-        RelSizePthreadUnlock(relKey);
 
-#ifdef DEBUG_TIMING
-        RECORD_TIMING(&start, &end, &nblocksTime[2], &nblocksCount[2])
-#endif
         int relSize = SyncGetRelSize(rnode, (ForkNumber)_forknum, 0);
 #ifdef ENABLE_DEBUG_INFO2
         printf("%s get relsize=%d from standalone pg\n", __func__ , relSize);
@@ -547,11 +2094,9 @@ public:
 #endif
 //        printf("%s %d\n", __func__ , __LINE__);
 //        fflush(stdout);
-        RelSizePthreadWriteLock(relKey);
-        uint32 tempResult = 0;
-        if(relSize>=0 && GetRelSizeCache(relKey, &tempResult) == false)
-            InsertRelSizeCache(relKey, (uint32) relSize);
-        RelSizePthreadUnlock(relKey);
+        // An extend may have cached a bigger size meanwhile
+        if(relSize>=0)
+            InsertRelSizeCacheIfAbsent(relKey, (uint32) relSize);
 //        printf("%s %d\n", __func__ , __LINE__);
 //        fflush(stdout);
 
@@ -561,9 +2106,6 @@ public:
         fflush(stdout);
 #endif
 
-#ifdef DEBUG_TIMING
-        RECORD_TIMING(&start, &end, &nblocksTime[3], &nblocksCount[3])
-#endif
         return relSize;
     }
 
@@ -571,15 +2113,14 @@ public:
 #ifdef ENABLE_FUNCTION_TIMING
         FunctionTiming functionTiming(const_cast<char *>(__func__));
 #endif
-#ifdef DEBUG_TIMING
-        struct timeval start, end;
-        START_TIMING(&start);
-#endif
 #ifdef ENABLE_DEBUG_INFO
         printf("%s %s %d , spcID = %ld, dbID = %ld, tabID = %ld, fornum = %d, lsn = %ld tid=%d\n", __func__ , __FILE__, __LINE__,
                _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum, _lsn, gettid());
         fflush(stdout);
 #endif
+        if (RequestTraceEnabled())
+            RequestTraceCapture(REQUEST_TRACE_EXISTS, _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum,
+                                0, (uint64_t) _lsn, 0);
 
         WaitParse(_lsn);
 //        SyncReplayProcess();
@@ -593,18 +2134,10 @@ public:
         TransRelNode2RelKey(rnode, &relKey, (ForkNumber)_forknum);
 
         uint32_t foundPageNum;
-        RelSizePthreadReadLock(relKey);
         int found = GetRelSizeCache(relKey, &foundPageNum);
-        RelSizePthreadUnlock(relKey);
-#ifdef DEBUG_TIMING
-            RECORD_TIMING(&start, &end, &existsTime[0], &existsCount[0])
-#endif
         if(found) {
 //            printf("%s %d\n", __func__ , __LINE__);
 //            fflush(stdout);
-#ifdef DEBUG_TIMING
-            RECORD_TIMING(&start, &end, &existsTime[1], &existsCount[1])
-#endif
                 return 1;
         }
 //        printf("%s %d\n", __func__ , __LINE__);
@@ -613,27 +2146,22 @@ public:
 //        SMgrRelation smgrReln = smgropen(rnode, InvalidBackendId);
 //        int32_t result = mdexists(smgrReln, (ForkNumber)_forknum);
 
-#ifdef DEBUG_TIMING
-        RECORD_TIMING(&start, &end, &existsTime[2], &existsCount[2])
-#endif
+        // Logged as extended by _lsn
+        if (_lsn > 0 && RpcRelSizeLookup(relKey, (uint64_t) _lsn, &foundPageNum))
+            return 1;
+
         int relSize = SyncGetRelSize(rnode, (ForkNumber)_forknum, _lsn);
 #ifdef ENABLE_DEBUG_INFO
         printf("%s get relsize=%d from standalone pg\n", __func__ , relSize);
 #endif
-        uint32 tempResult = -1;
-        RelSizePthreadWriteLock(relKey);
-        if(relSize >= 0 && GetRelSizeCache(relKey, &tempResult)==false)
-            InsertRelSizeCache(relKey, (uint32)relSize);
-        RelSizePthreadUnlock(relKey);
+        if(relSize >= 0)
+            InsertRelSizeCacheIfAbsent(relKey, (uint32)relSize);
 //        printf("%s %d\n", __func__ , __LINE__);
 //        fflush(stdout);
 
 #ifdef ENABLE_DEBUG_INFO
         printf("%s result = %d end\n", __func__, relSize);
         fflush(stdout);
-#endif
-#ifdef DEBUG_TIMING
-        RECORD_TIMING(&start, &end, &existsTime[3], &existsCount[3])
 #endif
         return (relSize>=0);
     }
@@ -662,14 +2190,7 @@ public:
 //        printf("%s %d\n", __func__ , __LINE__);
 //        fflush(stdout);
 
-        uint64_t foundLsn;
-        uint32 foundPageNum;
-        RelSizePthreadWriteLock(relKey);
-        int found = GetRelSizeCache(relKey, &foundPageNum);
-        if(!found) {
-            InsertRelSizeCache(relKey, 0);
-        }
-        RelSizePthreadUnlock(relKey);
+        InsertRelSizeCacheIfAbsent(relKey, 0);
 #endif
 
 //        printf("%s %d\n", __func__ , __LINE__);
@@ -711,19 +2232,12 @@ public:
 
 //        printf("%s %d\n", __func__ , __LINE__);
 //        fflush(stdout);
-        uint64_t foundLsn;
-        uint32_t foundPageNum;
-        RelSizePthreadWriteLock(relKey);
-        int found = GetRelSizeCache(relKey, &foundPageNum);
         //TODO: Here may have some problems: extend-page content's lsn is larger than parameter lsn
 #ifdef ENABLE_DEBUG_INFO
         printf("%s %d\n", __func__ , __LINE__);
         fflush(stdout);
 #endif
-        if(!found || foundPageNum<_blknum+1) {
-            InsertRelSizeCache(relKey, _blknum+1);
-        }
-        RelSizePthreadUnlock(relKey);
+        ExtendRelSizeCache(relKey, _blknum+1);
 #endif
 
 //        printf("%s %d\n", __func__ , __LINE__);
@@ -734,7 +2248,8 @@ public:
 #endif
         BufferTag tag;
         INIT_BUFFERTAG(tag, rnode, (ForkNumber)_forknum, (BlockNumber)_blknum);
-        char *extendPage = (char*) malloc(BLCKSZ);
+        RpcRequestBuffers buffers;
+        char *extendPage = buffers.Alloc(BLCKSZ);
 
         _buff.copy(extendPage, BLCKSZ);
 
@@ -763,6 +2278,28 @@ public:
 #endif
     }
 
+    // RpcMdExtend of _nblocks zero pages from _startblk, the replay process
+    // extends the file once for all of them
+    void RpcMdExtendMany(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _startblk, const int32_t _nblocks, const int32_t skipFsync, const int64_t _lsn) {
+#ifdef ENABLE_FUNCTION_TIMING
+        FunctionTiming functionTiming(const_cast<char *>(__func__));
+#endif
+#ifdef ENABLE_DEBUG_INFO
+        printf("%s %s %d , spcID = %ld, dbID = %ld, tabID = %ld, fornum = %d, startblk = %d nblocks = %d lsn = %ld tid=%d\n", __func__ , __FILE__, __LINE__,
+               _reln._spc_node, _reln._db_node, _reln._rel_node, _forknum, _startblk, _nblocks, _lsn, gettid());
+        fflush(stdout);
+#endif
+        if(_nblocks <= 0)
+            return;
+
+        RelFileNode rnode;
+        rnode.spcNode = _reln._spc_node;
+        rnode.dbNode = _reln._db_node;
+        rnode.relNode = _reln._rel_node;
+
+        WalRedoExtendRelMany(rnode, (ForkNumber) _forknum, (BlockNumber) _startblk, _nblocks);
+    }
+
 
     void RpcTruncate(const _Smgr_Relation& _reln, const int32_t _forknum, const int32_t _blknum, const int64_t _lsn) {
 #ifdef ENABLE_FUNCTION_TIMING
@@ -786,9 +2323,20 @@ public:
         RelKey relKey;
         TransRelNode2RelKey(rnode, &relKey, (ForkNumber)_forknum);
 
-        RelSizePthreadWriteLock(relKey);
         InsertRelSizeCache(relKey, _blknum);
-        RelSizePthreadUnlock(relKey);
+        RpcRelSizeTruncate(relKey, (uint32_t) _blknum, (uint64_t) _lsn);
+
+        // Blocks past the new end won't get newer versions; have their old
+        // ones collected soon instead of waiting for the vacuumer to reach them
+        KeyType key;
+        key.SpcID = rnode.spcNode;
+        key.DbID = rnode.dbNode;
+        key.RelID = rnode.relNode;
+        key.ForkNum = _forknum;
+        key.BlkNum = -1;
+        LogindexTombstoneTruncate(key, _blknum);
+        if (_forknum == MAIN_FORKNUM)
+            RpcZoneMapDropRelation(rnode, (uint32_t) _blknum);
 //        printf("%s %d\n", __func__ , __LINE__);
 //        fflush(stdout);
     }
@@ -888,7 +2436,8 @@ public:
 #ifdef INFO_FUNC_START
         printf("%s start\n", __func__ );
 #endif
-        char *page = (char *)malloc(BLCKSZ);
+        RpcRequestBuffers buffers;
+        char *page = buffers.Alloc(BLCKSZ);
         int readLen = 0;
 
 //        RpcRelation relNode = ParseRpcRequestPath(FilePathName(_fd), _seekpos);
@@ -902,7 +2451,6 @@ public:
 //        }
 
         _return.assign(page, readLen);
-        free(page);
         return;
     }
 
@@ -959,7 +2507,9 @@ public:
 #ifdef INFO_FUNC_START
         printf("%s start\n", __func__ );
 #endif
-        return unlink(_path.c_str());
+        int32_t result = unlink(_path.c_str());
+        BasePageReaderInvalidate();
+        return result;
     }
 
     int32_t RpcFtruncate(const _File _fd, const _Off_t _offset) {
@@ -1006,6 +2556,7 @@ public:
 #ifdef INFO_FUNC_START
         printf("%s start\n", __func__ );
 #endif
+        xlogPersistQueue.Wait();
         return CloseTransientFile(_fd);
     }
 
@@ -1044,14 +2595,20 @@ public:
 #ifdef INFO_FUNC_START
         printf("%s start\n", __func__ );
 #endif
-        char *p = (char*)malloc(_seg_bytes+64);
+        // WAL files are read back, e.g. by a walsender, only once written
+        xlogPersistQueue.Wait();
+        RpcRequestBuffers buffers;
+        char *p = buffers.Alloc(_seg_bytes+64);
          if(_start_off == -1) {
              read(_fd, p, _seg_bytes);
          } else {
-             pg_pread(_fd, p, _seg_bytes, _start_off);
+             ssize_t got = pg_pread(_fd, p, _seg_bytes, _start_off);
+
+             // Blocks of a compressed WAL segment read as zeros
+             if(got > 0)
+                 WalRetentionFillFd(_fd, p, (int) got, (uint32_t) _start_off);
          }
         _return.assign(p, _seg_bytes);
-        free(p);
         return;
     }
 
@@ -1079,6 +2636,8 @@ public:
 #ifdef INFO_FUNC_START
         printf("%s start\n", __func__ );
 #endif
+        // Queued WAL must not land in a file reopened under the same fd
+        xlogPersistQueue.Wait();
         return close(_fd);
     }
 
@@ -1102,6 +2661,55 @@ public:
         return BasicOpenFile(fullPath.c_str(), _flags);
     }
 
+    // Opens the file and, if it's read only and at most _amount bytes, sends
+    // all of it, see storage/rpc_file_cache.h
+    void RpcOpenAndReadFile(_Page& _return, const _Path& _path, const int32_t _flags, const int32_t _amount, const int32_t _transient) {
+#ifdef ENABLE_FUNCTION_TIMING
+        FunctionTiming functionTiming(const_cast<char *>(__func__));
+#endif
+        RpcOpenReadReply reply;
+        struct stat st;
+        int fd;
+
+        memset(&reply, 0, sizeof(reply));
+        fd = _transient ? OpenTransientFile(_path.c_str(), _flags) : BasicOpenFile(_path.c_str(), _flags);
+        reply.fd = fd;
+        if(fd < 0)
+            reply.error = errno;
+        _return.assign(sizeof(reply), '\0');
+
+        if(fd >= 0 && fstat(fd, &st) == 0) {
+            reply.size = st.st_size;
+            reply.mode = st.st_mode;
+            if((_flags & O_ACCMODE) == O_RDONLY && st.st_size <= _amount) {
+                size_t done = 0;
+
+                // The same as RpcPgPRead waits for, a WAL file read back
+                xlogPersistQueue.Wait();
+                _return.resize(sizeof(reply) + st.st_size);
+                while(done < (size_t) st.st_size) {
+                    ssize_t got = pg_pread(fd, &_return[sizeof(reply) + done], st.st_size - done, done);
+
+                    if(got <= 0)
+                        break;
+                    done += got;
+                }
+                if(done == (size_t) st.st_size && done > 0)
+                    WalRetentionFillFd(fd, &_return[sizeof(reply)], (int) done, 0);
+                if(done == (size_t) st.st_size) {
+                    if(_transient)
+                        CloseTransientFile(fd);
+                    else
+                        close(fd);
+                    reply.fd = -1;
+                    reply.complete = 1;
+                } else
+                    _return.resize(sizeof(reply));
+            }
+        }
+        memcpy(&_return[0], &reply, sizeof(reply));
+    }
+
     int32_t RpcPgFdatasync(const _File _fd) {
 #ifdef ENABLE_FUNCTION_TIMING
         FunctionTiming functionTiming(const_cast<char *>(__func__));
@@ -1109,6 +2717,8 @@ public:
 #ifdef INFO_FUNC_START
         printf("%s start\n", __func__ );
 #endif
+        if(!xlogPersistQueue.Wait())
+            return -1;
         return pg_fdatasync(_fd);
     }
 
@@ -1119,6 +2729,8 @@ public:
 #ifdef INFO_FUNC_START
         printf("%s start\n", __func__ );
 #endif
+        if(!xlogPersistQueue.Wait())
+            return -1;
         return pg_fsync_no_writethrough(_fd);
     }
 
@@ -1176,6 +2788,55 @@ public:
         return 0;
     }
 
+    // Answers the compression this connection's pages will come with
+    // 1 if the segment is mapped and served, 0 if it isn't on this host
+    int32_t RpcAttachSharedMemory(const _Path &_name) {
+        RpcShmSegment *segment;
+
+        if (currentConnection == NULL || currentConnection->shm != NULL)
+            return 0;
+        segment = RpcShmMap(_name.c_str());
+        if (segment == NULL)
+            return 0;
+        currentConnection->shm = segment;
+        currentConnection->shmThread = std::thread(&DataPageAccessHandler::SharedMemoryLoop, this, segment,
+                                                   currentConnection);
+        return 1;
+    }
+
+    // 1 if the summary is kept, 0 if it is malformed
+    int32_t RpcPublishResidentPages(const _Page &_summary) {
+        return LogindexResidentPublish(_summary.data(), _summary.size()) ? 1 : 0;
+    }
+
+    // Answers the class the requests of this connection are admitted in
+    int32_t RpcSetRequestClass(const int32_t _requestClass) {
+        if (currentConnection == NULL || _requestClass < 0 || _requestClass >= RPC_CLASSES)
+            return RPC_CLASS_FOREGROUND;
+        currentConnection->requestClass = _requestClass;
+        return _requestClass;
+    }
+
+    // How long the calls of this connection may wait for a lane before
+    // they are shed, see storage/rpc_lanes.h
+    int32_t RpcSetRequestDeadline(const int32_t _queue_ms) {
+        if (currentConnection == NULL || _queue_ms < 0)
+            return -1;
+        currentConnection->queueMs = _queue_ms;
+        return _queue_ms;
+    }
+
+    int32_t RpcSetPageCompression(const int32_t _method) {
+        int method = WAL_SHIP_COMPRESSION_OFF;
+
+        if (_method == WAL_SHIP_COMPRESSION_LZ4 || _method == WAL_SHIP_COMPRESSION_ZSTD)
+            method = _method;
+        if (currentConnection == NULL)
+            return WAL_SHIP_COMPRESSION_OFF;
+        currentConnection->pageCompression = method;
+        return method;
+    }
+
     int32_t RpcPgFsync(const int32_t _fd) {
 #ifdef ENABLE_FUNCTION_TIMING
         FunctionTiming functionTiming(const_cast<char *>(__func__));
@@ -1183,11 +2844,52 @@ public:
 #ifdef INFO_FUNC_START
         printf("%s start\n", __func__ );
 #endif
+        if(!xlogPersistQueue.Wait())
+            return -1;
         int32_t result = pg_fsync(_fd);
 //        printf("RpcPgFsync, result = %d\n", result);
         return result;
     }
 
+    // fsyncs all of _paths, SyncFilesWorkers() of them at a time. 0, -1 if
+    // the WAL queued before failed, else one plus the index of the first
+    // path that couldn't be synced
+    int32_t RpcSyncFiles(const std::vector<_Path> & _paths) {
+#ifdef ENABLE_FUNCTION_TIMING
+        FunctionTiming functionTiming(const_cast<char *>(__func__));
+#endif
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        size_t next = 0;
+        size_t failed = _paths.size();
+
+        if(!xlogPersistQueue.Wait())
+            return -1;
+
+        auto work = [&]() {
+            while(true) {
+                size_t i;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if(next == _paths.size())
+                        return;
+                    i = next++;
+                }
+                if(SyncPath(_paths[i].c_str()) != 0) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    failed = std::min(failed, i);
+                }
+            }
+        };
+        for(size_t i = 1; i < std::min((size_t) SyncFilesWorkers(), _paths.size()); i++)
+            workers.emplace_back(work);
+        work();
+        for(auto &worker : workers)
+            worker.join();
+
+        return failed == _paths.size() ? 0 : (int32_t) failed + 1;
+    }
+
     int32_t RpcDurableUnlink(const _Path& _fname, const int32_t _flag) {
 #ifdef ENABLE_FUNCTION_TIMING
         FunctionTiming functionTiming(const_cast<char *>(__func__));
@@ -1195,7 +2897,9 @@ public:
 #ifdef INFO_FUNC_START
         printf("%s start\n", __func__ );
 #endif
-        return durable_unlink(_fname.c_str(), _flag);
+        int32_t result = durable_unlink(_fname.c_str(), _flag);
+        BasePageReaderInvalidate();
+        return result;
     }
 
     int32_t RpcDurableRenameExcl(const _Path& _oldFname, const _Path& _newFname, const int32_t _elevel) {
@@ -1234,7 +2938,28 @@ public:
 #endif
 
 
-        int32_t result = pg_pwrite(_fd, _page.c_str(), _amount, _offset);
+        // A compute node may send the chunk compressed, it is then shorter
+        // than the amount written
+        const char *wal = _page.c_str();
+        if(_page.size() < (size_t) _amount) {
+            static thread_local std::string walBuffer;
+
+            walBuffer.resize(_amount);
+            if(!WalShipDecompress(_page.data(), _page.size(), &walBuffer[0], _amount)) {
+                printf("%s invalid compressed WAL at offset %ld, %zu bytes for %d\n", __func__ ,
+                       (long) _offset, _page.size(), _amount);
+                fflush(stdout);
+                return -1;
+            }
+            wal = walBuffer.data();
+        }
+
+        static const bool syncPersist = getenv("RPC_XLOG_PERSIST_SYNC") != NULL;
+        int32_t result = _amount;
+        if(syncPersist)
+            result = pg_pwrite(_fd, wal, _amount, _offset);
+        else
+            xlogPersistQueue.Push(_fd, wal, _amount, _offset, (uint64_t) _lsn);
 
 #ifdef ENABLE_DEBUG_INFO
         printf("%s %d\n", __func__ , __LINE__);
@@ -1258,7 +2983,7 @@ public:
 
         // Based on XLogWrite code, startIdx+_blknum <= XLogBuffers-1
         // So, RpcXLogPages + (_idx*BLCKSZ) + (_blknum*BLCKSZ) will smaller than or equal with end of RpcXLogPages
-        memcpy( RpcXLogPages+(XLOG_BLCKSZ*_idx), _page.c_str(), XLOG_BLCKSZ*_blknum );
+        memcpy( RpcXLogPages+(XLOG_BLCKSZ*_idx), wal, XLOG_BLCKSZ*_blknum );
 
         for(int i = 0; i < _blknum; i++) {
             pthread_rwlock_unlock(&(RpcXLogPagesLocks[(_idx+i)]));
@@ -1307,7 +3032,7 @@ public:
         bool use_existent = (_use_existent == 1);
         bool use_lock = (_use_lock == 1);
 
-        int fd = XLogFileInit(_logsegno, &use_existent, use_lock);
+        int fd = xlogPreallocator.Init(_logsegno, &use_existent, use_lock);
 
         _return._fd = fd;
         _return._use_existent = use_existent;
@@ -1328,13 +3053,38 @@ public:
 };
 
 
+static void
+RpcServeRdmaRequest(void *arg, const RpcRdmaRequest *request, RpcRdmaReply *reply, char *page) {
+    ((DataPageAccessHandler *) arg)->ServeRdmaRequest(request, reply, page);
+}
+
+static int
+RpcServerEnvInt(const char *name, int defaultValue) {
+    char *value = getenv(name);
+    if(value == NULL || atoi(value) <= 0)
+        return defaultValue;
+    return atoi(value);
+}
+
 void
 RpcServerLoop(void){
     int port = 9092;
+    // The server's threads and the ones they start inherit the mask
+    CpuRoleBind(CPU_ROLE_RPC, -1);
+    // RPC_NONBLOCKING_SERVER switches from one pooled thread per connection
+    // to an event-driven server: a few I/O threads multiplex every
+    // connection with epoll and hand complete frames to a worker pool.
+    // Clients must use framed transport, see RpcInit().
+    bool nonblocking = (getenv("RPC_NONBLOCKING_SERVER") != NULL);
+    RpcWire wire = RpcWireFromEnv();
+    printf("%s serving %s on port %d\n", __func__, RpcWireName(wire), port);
+    fflush(stdout);
+    int workerThreads = RpcServerEnvInt("RPC_WORKER_THREADS", nonblocking ? 32 : 150);
+    int ioThreads = RpcServerEnvInt("RPC_IO_THREADS", 4);
 
     std::shared_ptr<concurrency::ThreadFactory> threadFactory = std::make_shared<concurrency::ThreadFactory>(new concurrency::ThreadFactory());
 //    std::shared_ptr<concurrency::ThreadManager> threadManager = concurrency::ThreadManager::newThreadManager();
-    std::shared_ptr<concurrency::ThreadManager> threadManager = concurrency::ThreadManager::newSimpleThreadManager(150);
+    std::shared_ptr<concurrency::ThreadManager> threadManager = concurrency::ThreadManager::newSimpleThreadManager(workerThreads);
     threadManager->threadFactory(threadFactory);
     threadManager->start();
 
@@ -1342,13 +3092,40 @@ RpcServerLoop(void){
 //    TSimpleServer server(
 //    TThreadedServer server(
     std::shared_ptr<server::TServer> server;
-    server.reset ( new TThreadPoolServer(
-            std::make_shared<DataPageAccessProcessor>(std::make_shared<DataPageAccessHandler>()),
-            std::make_shared<TServerSocket>(port), //port
-            std::make_shared<TBufferedTransportFactory>(),
-            std::make_shared<TBinaryProtocolFactory>(),
-            threadManager
-            ) );
+    std::shared_ptr<DataPageAccessHandler> handler = std::make_shared<DataPageAccessHandler>();
+    bool fastCodec = rpcfast::RpcFastCodecEnabled(wire);
+    std::shared_ptr<DataPageAccessProcessor> processor = std::make_shared<RequestLaneProcessor>(handler, fastCodec);
+    printf("%s %s the page call codec\n", __func__, fastCodec ? "specializing" : "generating");
+    fflush(stdout);
+    // RPC_RDMA_PORT takes page reads over RDMA besides, see storage/rpc_rdma.h
+    int rdmaPort = RpcServerEnvInt("RPC_RDMA_PORT", 0);
+    if(rdmaPort > 0) {
+        bool started = RpcRdmaStartServer(rdmaPort, RpcServeRdmaRequest, handler.get());
+
+        printf("%s %s RDMA reads on port %d\n", __func__, started ? "serving" : "found no device for", rdmaPort);
+        fflush(stdout);
+    }
+    if(nonblocking) {
+        GetRequestLanes().ReserveWorkers(workerThreads, RpcServerEnvInt("RPC_LANE_INGEST_THREADS", 2));
+        std::shared_ptr<TNonblockingServer> nbServer = std::make_shared<TNonblockingServer>(
+                processor,
+                RpcWireProtocolFactory(wire),
+                std::make_shared<TNonblockingServerSocket>(port),
+                threadManager
+                );
+        nbServer->setNumIOThreads(ioThreads);
+        server = nbServer;
+    } else {
+        server.reset ( new TThreadPoolServer(
+                processor,
+                std::make_shared<TServerSocket>(port), //port
+                RpcWireTransportFactory(wire),
+                RpcWireProtocolFactory(wire),
+                threadManager
+                ) );
+    }
+
+    server->setServerEventHandler(std::make_shared<RpcServerEventHandler>());
 
     concurrency::ThreadFactory factory;
     factory.setDetached(false);
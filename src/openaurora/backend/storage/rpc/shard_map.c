@@ -0,0 +1,275 @@
+#include "postgres.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "common/hashfn.h"
+#include "storage/rpcclient.h"
+#include "storage/shard_map.h"
+
+extern int IsRpcClient;
+
+#define SHARD_MAP_MAX_SIZE (64 * 1024)
+#define SHARD_MAP_HOST_LEN (256)
+
+typedef struct ShardMapPartition {
+    int16 owner;
+    // Owner before since, -1 if the partition didn't move
+    int16 prevOwner;
+    XLogRecPtr since;
+} ShardMapPartition;
+
+typedef struct ShardMap {
+    uint64 version;
+    int nshards;
+    char hosts[SHARD_MAP_MAX_SHARDS][SHARD_MAP_HOST_LEN];
+    int ports[SHARD_MAP_MAX_SHARDS];
+    ShardMapPartition parts[SHARD_MAP_PARTITIONS];
+} ShardMap;
+
+int MyStorageShard = -1;
+
+// -1 until the environment is read
+static int shardMapEnabled = -1;
+// Replaced maps are kept, a reader on another thread may still hold one
+static ShardMap *shardMapCurrent = NULL;
+static time_t shardMapChecked = 0;
+static time_t shardMapMtime = 0;
+static off_t shardMapFileSize = -1;
+static pthread_mutex_t shardMapLock = PTHREAD_MUTEX_INITIALIZER;
+
+// The storage node logs from threads elog isn't safe on
+static void ShardMapLog(const char *message, uint64 version) {
+    if (IsRpcClient)
+        ereport(LOG, (errmsg("%s " UINT64_FORMAT " of \"%s\"", message, version, SHARD_MAP_FILE)));
+    else {
+        printf("%s %s " UINT64_FORMAT " of \"%s\"\n", __func__, message, version, SHARD_MAP_FILE);
+        fflush(stdout);
+    }
+}
+
+static bool ShardMapParseLine(char *line, ShardMap *map, bool *shardSeen) {
+    char *tokens[8];
+    char *save = NULL;
+    int ntokens = 0;
+    char *token;
+
+    for (token = strtok_r(line, " \t\r", &save); token != NULL && ntokens < 8;
+         token = strtok_r(NULL, " \t\r", &save))
+        tokens[ntokens++] = token;
+    if (ntokens == 0 || tokens[0][0] == '#')
+        return true;
+
+    if (strcmp(tokens[0], "version") == 0 && ntokens == 2) {
+        map->version = strtoull(tokens[1], NULL, 10);
+        return true;
+    }
+    if (strcmp(tokens[0], "shard") == 0 && ntokens == 3) {
+        int shard = atoi(tokens[1]);
+        char *colon = strrchr(tokens[2], ':');
+
+        if (shard < 0 || shard >= SHARD_MAP_MAX_SHARDS || colon == NULL ||
+            colon - tokens[2] >= SHARD_MAP_HOST_LEN)
+            return false;
+        memcpy(map->hosts[shard], tokens[2], colon - tokens[2]);
+        map->hosts[shard][colon - tokens[2]] = '\0';
+        map->ports[shard] = atoi(colon + 1);
+        map->nshards = Max(map->nshards, shard + 1);
+        shardSeen[shard] = true;
+        return true;
+    }
+    if (strcmp(tokens[0], "part") == 0 && (ntokens == 3 || ntokens == 7)) {
+        int first, last, owner = atoi(tokens[2]);
+        int prevOwner = -1;
+        uint32 hi = 0, lo = 0;
+        int n = sscanf(tokens[1], "%d-%d", &first, &last);
+
+        if (n < 1)
+            return false;
+        if (n == 1)
+            last = first;
+        if (ntokens == 7) {
+            if (strcmp(tokens[3], "from") != 0 || strcmp(tokens[5], "at") != 0 ||
+                sscanf(tokens[6], "%X/%X", &hi, &lo) != 2)
+                return false;
+            prevOwner = atoi(tokens[4]);
+        }
+        if (first < 0 || last >= SHARD_MAP_PARTITIONS || first > last ||
+            owner < 0 || owner >= SHARD_MAP_MAX_SHARDS || prevOwner >= SHARD_MAP_MAX_SHARDS)
+            return false;
+        for (int i = first; i <= last; i++) {
+            map->parts[i].owner = (int16) owner;
+            map->parts[i].prevOwner = (int16) (prevOwner == owner ? -1 : prevOwner);
+            map->parts[i].since = ((XLogRecPtr) hi << 32) | lo;
+        }
+        return true;
+    }
+    return false;
+}
+
+static ShardMap *ShardMapParse(char *text) {
+    ShardMap *map = (ShardMap *) calloc(1, sizeof(ShardMap));
+    bool shardSeen[SHARD_MAP_MAX_SHARDS] = {false};
+    char *save = NULL;
+
+    for (int i = 0; i < SHARD_MAP_PARTITIONS; i++)
+        map->parts[i].prevOwner = -1;
+    for (char *line = strtok_r(text, "\n", &save); line != NULL; line = strtok_r(NULL, "\n", &save)) {
+        if (!ShardMapParseLine(line, map, shardSeen)) {
+            free(map);
+            return NULL;
+        }
+    }
+    // Every shard a partition names has to be reachable
+    for (int i = 0; i < SHARD_MAP_PARTITIONS; i++) {
+        ShardMapPartition *part = &map->parts[i];
+
+        if (!shardSeen[part->owner] || (part->prevOwner >= 0 && !shardSeen[part->prevOwner])) {
+            free(map);
+            return NULL;
+        }
+    }
+    return map;
+}
+
+// Reads the map file into text, its length or -1 if there's none
+static int ShardMapReadFile(char *text) {
+    int fd;
+    int len;
+
+    if (IsRpcClient) {
+        fd = RpcOpenTransientFile(SHARD_MAP_FILE, O_RDONLY | PG_BINARY);
+        if (fd < 0)
+            return -1;
+        len = RpcPgPRead(fd, text, SHARD_MAP_MAX_SIZE - 1, 0);
+        RpcCloseTransientFile(fd);
+    } else {
+        struct stat st;
+
+        // The file didn't change since it was parsed
+        if (stat(SHARD_MAP_FILE, &st) != 0)
+            return -1;
+        if (st.st_mtime == shardMapMtime && st.st_size == shardMapFileSize)
+            return 0;
+        shardMapMtime = st.st_mtime;
+        shardMapFileSize = st.st_size;
+
+        fd = open(SHARD_MAP_FILE, O_RDONLY | PG_BINARY);
+        if (fd < 0)
+            return -1;
+        len = (int) pg_pread(fd, text, SHARD_MAP_MAX_SIZE - 1, 0);
+        close(fd);
+    }
+    if (len < 0)
+        return -1;
+    text[len] = '\0';
+    return len;
+}
+
+static void ShardMapReload(void) {
+    char *text = (char *) malloc(SHARD_MAP_MAX_SIZE);
+    int len = ShardMapReadFile(text);
+    ShardMap *map;
+
+    if (len <= 0) {
+        // A map once in force stays, a shard can't be taken back by deleting it
+        free(text);
+        return;
+    }
+    map = ShardMapParse(text);
+    free(text);
+    if (map == NULL) {
+        ShardMapLog("ignoring invalid shard map after version",
+                    shardMapCurrent == NULL ? 0 : shardMapCurrent->version);
+        return;
+    }
+    if (shardMapCurrent != NULL && map->version <= shardMapCurrent->version) {
+        free(map);
+        return;
+    }
+    __atomic_store_n(&shardMapCurrent, map, __ATOMIC_RELEASE);
+    ShardMapLog("loaded shard map version", map->version);
+}
+
+static ShardMap *ShardMapGet(void) {
+    time_t now;
+
+    if (shardMapEnabled < 0) {
+        char *shard = getenv("STORAGE_SHARD_ID");
+
+        if (IsRpcClient)
+            shardMapEnabled = getenv("RPC_SHARDING") != NULL;
+        else if (shard != NULL) {
+            MyStorageShard = atoi(shard);
+            shardMapEnabled = MyStorageShard >= 0 && MyStorageShard < SHARD_MAP_MAX_SHARDS;
+        } else
+            shardMapEnabled = 0;
+    }
+    if (!shardMapEnabled)
+        return NULL;
+
+    now = time(NULL);
+    if (__atomic_load_n(&shardMapChecked, __ATOMIC_ACQUIRE) != now) {
+        pthread_mutex_lock(&shardMapLock);
+        if (shardMapChecked != now) {
+            ShardMapReload();
+            __atomic_store_n(&shardMapChecked, now, __ATOMIC_RELEASE);
+        }
+        pthread_mutex_unlock(&shardMapLock);
+    }
+    return __atomic_load_n(&shardMapCurrent, __ATOMIC_ACQUIRE);
+}
+
+bool ShardMapActive(void) {
+    return ShardMapGet() != NULL;
+}
+
+bool ShardMapRoute(Oid spcNode, Oid dbNode, Oid relNode, BlockNumber blkNum, XLogRecPtr lsn,
+                   ShardRoute *route) {
+    ShardMap *map = ShardMapGet();
+    uint32 key[4];
+    ShardMapPartition *part;
+
+    if (map == NULL)
+        return false;
+
+    key[0] = spcNode;
+    key[1] = dbNode;
+    key[2] = relNode;
+    key[3] = blkNum / RELSEG_SIZE;
+    part = &map->parts[hash_bytes((const unsigned char *) key, sizeof(key)) % SHARD_MAP_PARTITIONS];
+
+    if (part->prevOwner >= 0 && lsn < part->since) {
+        route->shard = part->prevOwner;
+        route->baseShard = -1;
+        route->baseLsn = InvalidXLogRecPtr;
+    } else {
+        route->shard = part->owner;
+        route->baseShard = part->prevOwner;
+        route->baseLsn = part->prevOwner >= 0 ? part->since - 1 : InvalidXLogRecPtr;
+    }
+    return true;
+}
+
+bool ShardMapOwns(Oid spcNode, Oid dbNode, Oid relNode, BlockNumber blkNum, XLogRecPtr lsn) {
+    ShardRoute route;
+
+    // Compute nodes index what they replay
+    if (IsRpcClient)
+        return true;
+    if (!ShardMapRoute(spcNode, dbNode, relNode, blkNum, lsn, &route))
+        return true;
+    return route.shard == MyStorageShard;
+}
+
+bool ShardMapEndpoint(int shard, const char **host, int *port) {
+    ShardMap *map = ShardMapGet();
+
+    if (map == NULL || shard < 0 || shard >= map->nshards || map->ports[shard] <= 0)
+        return false;
+    *host = map->hosts[shard];
+    *port = map->ports[shard];
+    return true;
+}
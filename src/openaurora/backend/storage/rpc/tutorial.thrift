@@ -108,7 +108,7 @@ service DataPageAccess {
    * field lists in struct or exception definitions.
    */
 
-   _Page ReadBufferCommon(1:_Smgr_Relation _reln, 2:i32 _relpersistence, 3:i32 _forknum, 4:i32 _blknum, 5:i32 _readBufferMode, 6:i64 _lsn),
+   _Page ReadBufferCommon(1:_Smgr_Relation _reln, 2:i32 _relpersistence, 3:i32 _forknum, 4:i32 _blknum, 5:i32 _readBufferMode, 6:i64 _lsn, 7:i64 _traceId),
 
    i32 RpcRegisterSecondaryNode(1:bool _primary, 2:i64 _lsn),
 
@@ -123,6 +123,9 @@ service DataPageAccess {
    void RpcMdCreate(1:_Smgr_Relation _reln, 2:i32 _forknum, 3:i32 _isRedo, 4:i64 _lsn),
 
    void RpcMdExtend(1:_Smgr_Relation _reln, 2:i32 _forknum, 3:i32 _blknum, 4:_Page _buff, 5:i32 skipFsync, 6:i64 _lsn), 
+
+   /* RpcMdExtend of _nblocks zero pages from _startblk in one call */
+   void RpcMdExtendMany(1:_Smgr_Relation _reln, 2:i32 _forknum, 3:i32 _startblk, 4:i32 _nblocks, 5:i32 skipFsync, 6:i64 _lsn),
    
    void RpcTruncate(1:_Smgr_Relation _reln, 2:i32 _forknum, 3:i32 _blknum, 4:i64 _lsn),
 
@@ -176,6 +179,9 @@ service DataPageAccess {
 
    i32 RpcBasicOpenFileUnderPgData(1: _Path _path, 2: i32 _flags),
 
+   /* Open, and read if it's small, see storage/rpc_file_cache.h */
+   _Page RpcOpenAndReadFile(1:_Path _path, 2:i32 _flags, 3:i32 _amount, 4:i32 _transient),
+
    i32 RpcPgFdatasync(1: _File _fd),
 
    i32 RpcPgFsyncNoWritethrough(1: _File _fd),
@@ -186,6 +192,9 @@ service DataPageAccess {
 
    i32 RpcDirectoryIsEmpty(1:_Path _path),
 
+   /* fsync of many files or directories, run in parallel by the node */
+   i32 RpcSyncFiles(1:list<_Path> _paths),
+
    i32 RpcCopyDir(1:_Path _src, 2:_Path _dst),
 
    i32 RpcPgFsync(1:i32 _fd),
@@ -197,6 +206,67 @@ service DataPageAccess {
    i32 RpcXLogWrite(1: _File _fd, 2:_Page _page, 3:i32 _amount, 4: _Off_t _offset, 5: list<i64> _xlblocks, 6: i32 _blknum, 7: i32 _idx, 8: i64 _lsn),
 
    _XLog_Init_File_Resp RpcXLogFileInit(1:i64 _logsegno, 2:i32 _use_existent, 3:i32 _use_lock),
+
+   /* Batched ReadBufferCommon: consecutive page images of one relation fork, all at _lsn */
+   list<_Page> ReadBufferBatch(1:_Smgr_Relation _reln, 2:i32 _relpersistence, 3:i32 _forknum, 4:list<i64> _blknums, 5:i32 _readBufferMode, 6:i64 _lsn),
+
+   /* The first pages, up to _max_blocks, of the fork of each of _relns at _lsn, relation after relation,
+      after a _Page holding how many there are of each as i32s */
+   list<_Page> ReadRelationHeads(1:list<_Smgr_Relation> _relns, 2:i32 _forknum, 3:i32 _max_blocks, 4:i64 _lsn),
+
+   /* The pages of main fork blocks [_first_block, _end_block) at _lsn holding a tuple _qual, an RpcScanQual, may
+      be true for, up to _max_pages, after a _Page holding the block the scan got to and theirs as i32s */
+   list<_Page> ScanRelation(1:_Smgr_Relation _reln, 2:i32 _first_block, 3:i32 _end_block, 4:binary _qual, 5:i32 _max_pages, 6:i64 _lsn),
+
+   /* The partial states of the aggregates of _spec, an RpcAggSpec, over the all-visible pages of main fork blocks
+      [_first_block, _end_block) at _lsn, an RpcAggReply followed by the numbers of up to _max_fallback other pages */
+   binary AggregateRelation(1:_Smgr_Relation _reln, 2:i32 _first_block, 3:i32 _end_block, 4:binary _spec, 5:i32 _max_fallback, 6:i64 _lsn),
+
+   /* Vacuum triage of main fork blocks [_first_block, _end_block) at _lsn against _horizon, an RpcVacuumHorizon:
+      an RpcVacuumReply followed by an entry, and its dead items, for each page up to _max_dead dead items that
+      needs no pruning or freezing */
+   binary TriageVacuum(1:_Smgr_Relation _reln, 2:i32 _first_block, 3:i32 _end_block, 4:binary _horizon, 5:i32 _max_dead, 6:i64 _lsn),
+
+   /* Conditional ReadBufferCommon: empty reply if the page has no version in (_cachedLsn, _lsn] */
+   _Page ReadBufferIfModified(1:_Smgr_Relation _reln, 2:i32 _relpersistence, 3:i32 _forknum, 4:i32 _blknum, 5:i32 _readBufferMode, 6:i64 _lsn, 7:i64 _cachedLsn),
+
+   /* Queue pages of one relation fork for background replay at _lsn; returns how many were queued */
+   i32 PrefetchBuffers(1:_Smgr_Relation _reln, 2:i32 _forknum, 3:list<i64> _blknums, 4:i64 _lsn),
+
+   /* Pages of one relation fork written without WAL, _pages their images one after the other, to be read from _lsn
+      on as if replayed there; returns how many were installed */
+   i32 InstallPages(1:_Smgr_Relation _reln, 2:i32 _forknum, 3:list<i64> _blknums, 4:_Page _pages, 5:i64 _lsn),
+
+   /* Clean pages of one relation fork a compute node evicted, _pages their images, _lsn the WAL it had flushed;
+      installed in the background where they save a replay; returns how many were queued */
+   i32 InstallEvictedPages(1:_Smgr_Relation _reln, 2:i32 _forknum, 3:list<i64> _blknums, 4:_Page _pages, 5:i64 _lsn),
+
+   /* Smart replay and logindex metrics of the storage node, in the Prometheus text format */
+   string RpcGetSmartReplayMetrics(),
+
+   /* Page change feed entries from _from_seq, up to _max_entries of them, waiting up to _wait_ms for new ones */
+   _Page RpcFetchPageChanges(1:i32 _max_entries, 2:i32 _wait_ms, 3:i64 _from_seq),
+
+   /* RpcSecondaryNodeUpdatesLsn, answering whether the node has to register again */
+   i32 RpcSecondaryNodeHeartbeat(1:i32 _node_id, 2:i64 _lsn),
+
+   /* Waits up to _wait_ms for the WAL up to _lsn to be written and parsed; returns how far it is parsed */
+   i64 RpcWaitWalParsed(1:i32 _wait_ms, 2:i64 _lsn),
+
+   /* Compression of the pages sent on this connection, 0 for none; returns the method that will be used */
+   i32 RpcSetPageCompression(1:i32 _method),
+
+   /* Request class of the calls on this connection, see storage/rpc_lanes.h; returns the class taken */
+   i32 RpcSetRequestClass(1:i32 _requestClass),
+
+   /* How long the calls on this connection may wait for a lane before they are shed, 0 for no limit; returns it */
+   i32 RpcSetRequestDeadline(1:i32 _queue_ms),
+
+   /* Serve the ReadBufferCommon requests of the shm_open'd segment _name too; returns 1 if it could map it */
+   i32 RpcAttachSharedMemory(1:_Path _name),
+
+   /* Summary of the pages in a compute node's shared buffers, see access/logindex_resident.h; returns 1 if taken */
+   i32 RpcPublishResidentPages(1:_Page _summary),
   
    /**
     * This method has a oneway modifier. That means the client only makes
@@ -0,0 +1,155 @@
+#include "postgres.h"
+
+#include "access/xlog.h"
+#include "access/xlog_internal.h"
+#include "storage/rpcclient.h"
+#include "storage/wal_read_cache.h"
+#include "utils/memutils.h"
+
+// GUC, in kB
+int wal_read_cache_size = 16384;
+
+typedef struct WalReadCacheExtent {
+    TimeLineID tli;
+    XLogSegNo segno;
+    int extent;
+    bool valid;
+    bool referenced;
+} WalReadCacheExtent;
+
+static WalReadCacheExtent *extents = NULL;
+static char *extentData = NULL;
+static int extentNum = -1;
+static int hand = 0;
+static int lastHit = 0;
+
+// The extent missed last, to tell a sequential reader
+static TimeLineID lastMissTli = 0;
+static XLogSegNo lastMissSegno = 0;
+static int lastMissExtent = -1;
+
+static bool WalReadCacheInit(void) {
+    if (extentNum >= 0)
+        return extentNum > 0;
+    extentNum = (int) Min((int64) wal_read_cache_size * 1024 / WAL_READ_CACHE_EXTENT,
+                          (int64) MaxAllocSize / WAL_READ_CACHE_EXTENT);
+    // Room for an extent and the one read ahead at least
+    if (extentNum < 2) {
+        extentNum = 0;
+        return false;
+    }
+    extents = (WalReadCacheExtent *) MemoryContextAllocZero(TopMemoryContext,
+                                                            sizeof(WalReadCacheExtent) * extentNum);
+    extentData = (char *) MemoryContextAllocHuge(TopMemoryContext,
+                                                 (Size) WAL_READ_CACHE_EXTENT * extentNum);
+    return true;
+}
+
+static int WalReadCacheFind(TimeLineID tli, XLogSegNo segno, int extent) {
+    WalReadCacheExtent *entry = &extents[lastHit];
+
+    if (entry->valid && entry->tli == tli && entry->segno == segno && entry->extent == extent)
+        return lastHit;
+    for (int i = 0; i < extentNum; i++) {
+        entry = &extents[i];
+        if (entry->valid && entry->tli == tli && entry->segno == segno && entry->extent == extent) {
+            lastHit = i;
+            return i;
+        }
+    }
+    return -1;
+}
+
+// An extent not referenced since the hand last passed it is taken
+static int WalReadCacheEvict(int keep) {
+    for (;;) {
+        int slot = hand;
+        WalReadCacheExtent *entry = &extents[slot];
+
+        hand = (hand + 1) % extentNum;
+        if (slot == keep)
+            continue;
+        if (entry->valid && entry->referenced) {
+            entry->referenced = false;
+            continue;
+        }
+        entry->valid = false;
+        return slot;
+    }
+}
+
+// Whether the extent is wholly below the flushed LSN and no longer changes
+static bool WalReadCacheStable(XLogSegNo segno, int extent) {
+    XLogRecPtr end;
+
+    if ((int64) (extent + 1) * WAL_READ_CACHE_EXTENT > wal_segment_size)
+        return false;
+    XLogSegNoOffsetToRecPtr(segno, (extent + 1) * WAL_READ_CACHE_EXTENT, wal_segment_size, end);
+    return end <= GetLogWrtResultLsn();
+}
+
+// Fetches the extent, and the next one with it for a sequential reader
+static int WalReadCacheFetch(int fd, TimeLineID tli, XLogSegNo segno, int extent) {
+    bool sequential = lastMissTli == tli && lastMissSegno == segno && lastMissExtent == extent - 1;
+    bool readAhead = sequential && WalReadCacheStable(segno, extent + 1) &&
+                     WalReadCacheFind(tli, segno, extent + 1) < 0;
+    int slots[2];
+    int32_t offsets[2];
+    char *bufs[2];
+    int num = readAhead ? 2 : 1;
+
+    lastMissTli = tli;
+    lastMissSegno = segno;
+    lastMissExtent = extent + (readAhead ? 1 : 0);
+
+    slots[0] = WalReadCacheEvict(-1);
+    if (readAhead)
+        slots[1] = WalReadCacheEvict(slots[0]);
+    for (int i = 0; i < num; i++) {
+        offsets[i] = (extent + i) * WAL_READ_CACHE_EXTENT;
+        bufs[i] = extentData + (Size) slots[i] * WAL_READ_CACHE_EXTENT;
+    }
+    RpcPgPReadRanges(fd, bufs, WAL_READ_CACHE_EXTENT, offsets, num);
+
+    for (int i = 0; i < num; i++) {
+        WalReadCacheExtent *entry = &extents[slots[i]];
+
+        entry->tli = tli;
+        entry->segno = segno;
+        entry->extent = extent + i;
+        entry->valid = true;
+        // The extent read ahead has to earn its place
+        entry->referenced = (i == 0);
+    }
+    lastHit = slots[0];
+    return slots[0];
+}
+
+int WalReadCacheRead(int fd, TimeLineID tli, XLogSegNo segno, char *p, int amount, int offset) {
+    int done = 0;
+
+    if (!WalReadCacheInit())
+        return RpcPgPRead(fd, p, amount, offset);
+
+    while (done < amount) {
+        int pos = offset + done;
+        int extent = pos / WAL_READ_CACHE_EXTENT;
+        int within = pos % WAL_READ_CACHE_EXTENT;
+        int len = Min(amount - done, WAL_READ_CACHE_EXTENT - within);
+        int slot = WalReadCacheFind(tli, segno, extent);
+
+        if (slot < 0) {
+            // The tail still grows, read the rest through
+            if (!WalReadCacheStable(segno, extent)) {
+                int r = RpcPgPRead(fd, p + done, amount - done, pos);
+
+                return r < 0 ? r : done + r;
+            }
+            slot = WalReadCacheFetch(fd, tli, segno, extent);
+        }
+        extents[slot].referenced = true;
+        memcpy(p + done, extentData + (Size) slot * WAL_READ_CACHE_EXTENT + within, len);
+        done += len;
+    }
+    return done;
+}
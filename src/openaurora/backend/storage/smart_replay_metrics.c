@@ -0,0 +1,629 @@
+/*-------------------------------------------------------------------------
+ *
+ * smart_replay_metrics.c
+ *		Storage node replay metrics in the Prometheus text format
+ *
+ * SmartReplayMetricsText() renders one snapshot of the adaptive smart
+ * replay controller (ASR_ReadMetrics, ASR_ReadTenants), the wal_redo pool
+ * (WalRedoPoolGetStats, WalRedoPoolGetBusyTime), the logindex hashmap, the
+ * memory of the node by component (MemGovernorRead), the page reads by how
+ * they were served, the latency of their stages (StageTimingCollect) and
+ * the parsed and flushed WAL positions.
+ * All of these are thread-safe readers, so the text can be built from any
+ * storage server thread; it is malloc'd rather than palloc'd for the same
+ * reason.
+ *
+ * The HTTP endpoint is deliberately minimal: one thread that answers GET
+ * requests one connection at a time, which is all a scraper needs.
+ *
+ * IDENTIFICATION
+ *		src/backend/storage/smart_replay_metrics.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+
+#include "access/logindex_hashmap.h"
+#include "access/xlogdefs.h"
+#include "access/logindex_hot_queue.h"
+#include "access/logindex_resident.h"
+#include "access/wal_retention.h"
+#include "storage/adaptive_sr.h"
+#include "storage/mem_governor.h"
+#include "storage/rpc_lanes.h"
+#include "storage/smart_replay_metrics.h"
+#include "storage/stage_timing.h"
+#include "tcop/wal_redo_cache.h"
+#include "tcop/wal_redo_pool.h"
+
+extern HashMap pageVersionHashMap;
+extern XLogRecPtr XLogParseUpto;
+extern uint64_t RpcXLogFlushedLsn;
+
+#define METRICS_PREFIX "openaurora_"
+#define METRICS_REQUEST_SIZE 4096
+#define METRICS_IO_TIMEOUT_S 2
+
+int			asr_metrics_port = 0;
+
+static uint64 page_reads[PAGE_READ_PATHS];
+/* Of the connections asking for compressed pages, raw and compressed */
+static uint64 pages_sent[2];
+static uint64 page_bytes_sent[2];
+/* Per request class of rpc_lanes.h */
+static uint64 lane_admitted[RPC_CLASSES];
+static uint64 lane_waited[RPC_CLASSES];
+static uint64 lane_wait_ns[RPC_CLASSES];
+static uint64 lane_shed[RPC_CLASSES];
+
+typedef struct MetricsBuf {
+	char	   *data;
+	size_t		len;
+	size_t		cap;
+} MetricsBuf;
+
+static void
+metrics_append(MetricsBuf *buf, const char *fmt,...)
+{
+	for (;;)
+	{
+		va_list		args;
+		int			needed = 0;
+		size_t		cap;
+		char	   *data;
+
+		if (buf->data != NULL)
+		{
+			va_start(args, fmt);
+			needed = vsnprintf(buf->data + buf->len, buf->cap - buf->len, fmt, args);
+			va_end(args);
+			if (needed < 0)
+				return;
+			if ((size_t) needed < buf->cap - buf->len)
+			{
+				buf->len += needed;
+				return;
+			}
+		}
+
+		cap = Max(buf->cap * 2, buf->len + needed + 1024);
+		data = realloc(buf->data, cap);
+		if (data == NULL)
+			return;
+		buf->data = data;
+		buf->cap = cap;
+	}
+}
+
+static void
+metrics_family(MetricsBuf *buf, const char *name, const char *type, const char *help)
+{
+	metrics_append(buf, "# HELP " METRICS_PREFIX "%s %s\n# TYPE " METRICS_PREFIX "%s %s\n",
+				   name, help, name, type);
+}
+
+static void
+metrics_gauge(MetricsBuf *buf, const char *name, const char *help, double value)
+{
+	metrics_family(buf, name, "gauge", help);
+	metrics_append(buf, METRICS_PREFIX "%s %.17g\n", name, value);
+}
+
+static void
+metrics_counter(MetricsBuf *buf, const char *name, const char *help, uint64 value)
+{
+	metrics_family(buf, name, "counter", help);
+	metrics_append(buf, METRICS_PREFIX "%s " UINT64_FORMAT "\n", name, value);
+}
+
+static void
+metrics_asr(MetricsBuf *buf)
+{
+	ASRMetrics	m = ASR_ReadMetrics();
+
+	metrics_gauge(buf, "asr_enabled", "Whether adaptive smart replay is on.",
+				  ASR_Enabled() ? 1 : 0);
+	metrics_gauge(buf, "asr_replay_queue_length", "Smoothed page versions not replayed yet.",
+				  m.replay_queue_length);
+	metrics_gauge(buf, "asr_parse_gap_bytes", "Smoothed WAL bytes flushed but not parsed into the logindex.",
+				  m.parse_gap_bytes);
+	metrics_gauge(buf, "asr_hot_miss_rate", "Smoothed fraction of reads that waited for replay.",
+				  m.hot_miss_rate);
+	metrics_gauge(buf, "asr_replay_tasks_per_second", "Smoothed replay throughput.",
+				  m.replay_tasks_per_sec);
+	metrics_gauge(buf, "asr_wal_ingest_bytes_per_second", "Smoothed WAL arrival rate.",
+				  m.wal_ingest_bps);
+	metrics_gauge(buf, "asr_aggressiveness", "Controller output between 0 and 1.",
+				  m.aggressiveness);
+	metrics_gauge(buf, "asr_replay_budget", "Records a redo process replays per call.",
+				  m.replay_budget);
+	metrics_gauge(buf, "asr_replayer_threads", "Background replayer threads running.",
+				  m.replayer_threads);
+	metrics_gauge(buf, "asr_replayer_sleep_microseconds", "Background replayer sleep between rounds.",
+				  m.replayer_sleep_us);
+	metrics_gauge(buf, "asr_redo_processes", "Redo processes the pool may put in service.",
+				  m.redo_processes);
+	metrics_counter(buf, "asr_reads_total", "Page reads served.", m.reads_total);
+	metrics_counter(buf, "asr_hot_misses_total", "Page reads that waited for replay.", m.hot_misses_total);
+	metrics_counter(buf, "asr_replay_tasks_total", "Records replayed by the redo processes.", m.replay_tasks_total);
+	metrics_counter(buf, "asr_wal_bytes_total", "WAL bytes received.", m.wal_bytes_total);
+}
+
+static void
+metrics_tenants(MetricsBuf *buf)
+{
+	static const struct
+	{
+		const char *name;
+		const char *help;
+	}			families[] =
+	{
+		{"asr_tenant_weight", "Configured weight of the tenant."},
+		{"asr_tenant_share", "Share of the background replay capacity this cycle."},
+		{"asr_tenant_tokens", "Background replays left to the tenant this cycle."},
+		{"asr_tenant_hot_misses_per_second", "Smoothed hot misses of the tenant."},
+		{"asr_tenant_hot_miss_rate", "Smoothed fraction of the tenant's reads that waited for replay."},
+		{"asr_tenant_wal_ingest_bytes_per_second", "Smoothed WAL parsed for the tenant."},
+		{"asr_tenant_replayed_per_second", "Smoothed page versions replayed in the background for the tenant."},
+	};
+	ASRTenantMetrics tenants[ASR_MAX_TENANTS + 1];
+	int			num = ASR_ReadTenants(tenants, lengthof(tenants));
+
+	for (int f = 0; f < lengthof(families); f++)
+	{
+		metrics_family(buf, families[f].name, "gauge", families[f].help);
+		for (int i = 0; i < num; i++)
+		{
+			ASRTenantMetrics *t = &tenants[i];
+			double		value = 0.0;
+			char		db[16];
+
+			switch (f)
+			{
+				case 0: value = t->weight; break;
+				case 1: value = t->share; break;
+				case 2: value = t->tokens; break;
+				case 3: value = t->hot_miss_per_sec; break;
+				case 4: value = t->hot_miss_rate; break;
+				case 5: value = t->wal_ingest_bps; break;
+				case 6: value = t->replayed_per_sec; break;
+			}
+			if (t->other)
+				strcpy(db, "other");
+			else
+				snprintf(db, sizeof(db), "%u", t->dbNode);
+			metrics_append(buf, METRICS_PREFIX "%s{db=\"%s\",rel=\"%u\"} %.17g\n",
+						   families[f].name, db, t->relNode, value);
+		}
+	}
+}
+
+static void
+metrics_redo_pool(MetricsBuf *buf)
+{
+	WalRedoPoolStats stats;
+	uint64_t   *busyUs;
+	uint64_t	cacheHits;
+	uint64_t	cacheMisses;
+	int			num;
+
+	WalRedoPoolGetStats(&stats);
+	metrics_gauge(buf, "redo_pool_forked", "Redo processes forked.", stats.forked);
+	metrics_gauge(buf, "redo_pool_min_size", "Lower limit of redo processes in service.", stats.minSize);
+	metrics_gauge(buf, "redo_pool_max_size", "Upper limit of redo processes in service.", stats.maxSize);
+	metrics_gauge(buf, "redo_pool_size", "Redo processes in service.", stats.size);
+	metrics_gauge(buf, "redo_pool_busy", "Redo processes acquired.", stats.busy);
+	metrics_gauge(buf, "redo_pool_waiting", "Threads queued for a redo process.", stats.waiting);
+	metrics_counter(buf, "redo_pool_waits_total", "Acquisitions that had to queue.", stats.waits);
+	metrics_counter(buf, "redo_pool_affinity_hits_total", "Affine acquisitions served by the preferred process.",
+					stats.affinityHits);
+	metrics_counter(buf, "redo_pool_affinity_steals_total", "Affine acquisitions served by another process.",
+					stats.affinitySteals);
+	WalRedoCacheGetStats(&cacheHits, &cacheMisses);
+	metrics_counter(buf, "redo_cache_hits_total", "Replays continued from the page version a redo process kept.",
+					cacheHits);
+	metrics_counter(buf, "redo_cache_misses_total", "Replays resent in full as the kept version was gone.",
+					cacheMisses);
+
+	busyUs = malloc(Max(stats.forked, 1) * sizeof(uint64_t));
+	if (busyUs == NULL)
+		return;
+	num = WalRedoPoolGetBusyTime(busyUs, stats.forked);
+	metrics_family(buf, "redo_process_busy_seconds_total", "counter", "Time each redo process spent acquired.");
+	for (int i = 0; i < num; i++)
+		metrics_append(buf, METRICS_PREFIX "redo_process_busy_seconds_total{process=\"%d\"} %.6f\n",
+					   i, busyUs[i] / 1e6);
+	free(busyUs);
+}
+
+static void
+metrics_logindex(MetricsBuf *buf)
+{
+	HashMap		map = pageVersionHashMap;
+	uint64_t	residentNodes;
+	uint64_t	residentDeferred;
+
+	LogindexResidentCounts(&residentNodes, &residentDeferred);
+	metrics_gauge(buf, "logindex_resident_summary_nodes", "Compute nodes with a summary of their resident pages.",
+				  (double) residentNodes);
+	metrics_counter(buf, "logindex_resident_deferred_total", "Background replays deferred for a page resident on a compute node.",
+					residentDeferred);
+	metrics_gauge(buf, "logindex_hot_queue_length", "Pages queued for hot background replay.",
+				  LogindexHotQueueLength());
+	metrics_gauge(buf, "logindex_resident_bytes", "Bytes held by logindex heads and element nodes.",
+				  (double) HashMapResidentBytes());
+	if (map == NULL)
+		return;
+	metrics_gauge(buf, "logindex_memory_limit_bytes", "Logindex memory budget, 0 if unbounded.",
+				  (double) map->memoryLimit);
+	metrics_gauge(buf, "logindex_buckets", "Logindex hash buckets.",
+				  __atomic_load_n(&map->bucketNum, __ATOMIC_RELAXED));
+	metrics_gauge(buf, "logindex_heads", "Pages with a logindex head.",
+				  (double) __atomic_load_n(&map->headNum, __ATOMIC_RELAXED));
+	metrics_gauge(buf, "logindex_unreplayed_versions", "Page versions above their head's replayed LSN.",
+				  (double) HashMapUnreplayedEntries(map));
+	metrics_counter(buf, "logindex_spilled_chains_total", "Version chains moved to RocksDB.",
+					__atomic_load_n(&map->spilledChains, __ATOMIC_RELAXED));
+	metrics_counter(buf, "logindex_faulted_chains_total", "Spilled version chains read back.",
+					__atomic_load_n(&map->faultedChains, __ATOMIC_RELAXED));
+	metrics_gauge(buf, "logindex_page_filter_bytes", "Size of the filter of pages with a version, 0 if off.",
+				  (double) (map->pageFilterBlocks * 64));
+	metrics_counter(buf, "logindex_page_filter_negatives_total", "Lookups the page filter answered without the logindex.",
+					__atomic_load_n(&map->pageFilterNegatives, __ATOMIC_RELAXED));
+}
+
+static void
+metrics_memory(MetricsBuf *buf)
+{
+	static const char *const components[MEM_COMPONENTS] = {
+		"memtables", "block_cache", "page_cache", "logindex", "redo", "other"
+	};
+	static const char *const actions[MEM_ACTIONS] = {"flush", "shrink", "spill"};
+	MemGovernorStats stats;
+
+	MemGovernorRead(&stats);
+	metrics_family(buf, "memory_bytes", "gauge", "Memory held by the storage node, by component.");
+	for (int i = 0; i < MEM_COMPONENTS; i++)
+		metrics_append(buf, METRICS_PREFIX "memory_bytes{component=\"%s\"} " UINT64_FORMAT "\n",
+					   components[i], stats.bytes[i]);
+	metrics_gauge(buf, "memory_limit_bytes", "Storage node memory budget, 0 if unbounded.",
+				  (double) stats.limit);
+	metrics_gauge(buf, "memory_cache_scale", "Share of their size the caches may use.",
+				  stats.cacheScale);
+	metrics_family(buf, "memory_pressure_actions_total", "counter",
+				   "Times the memory governor pushed back, by how.");
+	for (int i = 0; i < MEM_ACTIONS; i++)
+		metrics_append(buf, METRICS_PREFIX "memory_pressure_actions_total{action=\"%s\"} " UINT64_FORMAT "\n",
+					   actions[i], stats.actions[i]);
+}
+
+void
+SmartReplayMetricsCountRead(PageReadPath path)
+{
+	__atomic_fetch_add(&page_reads[path], 1, __ATOMIC_RELAXED);
+}
+
+void
+SmartReplayMetricsCountPageSent(size_t bytes, bool compressed)
+{
+	__atomic_fetch_add(&pages_sent[compressed], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&page_bytes_sent[compressed], (uint64) bytes, __ATOMIC_RELAXED);
+}
+
+void
+SmartReplayMetricsCountLane(int requestClass, uint64 waitNs)
+{
+	__atomic_fetch_add(&lane_admitted[requestClass], 1, __ATOMIC_RELAXED);
+	if (waitNs == 0)
+		return;
+	__atomic_fetch_add(&lane_waited[requestClass], 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&lane_wait_ns[requestClass], waitNs, __ATOMIC_RELAXED);
+}
+
+void
+SmartReplayMetricsCountShed(int requestClass)
+{
+	__atomic_fetch_add(&lane_shed[requestClass], 1, __ATOMIC_RELAXED);
+}
+
+static void
+metrics_lanes(MetricsBuf *buf)
+{
+	static const char *const classes[RPC_CLASSES] = {"foreground", "background", "maintenance"};
+
+	metrics_family(buf, "rpc_lane_admitted_total", "counter", "Requests admitted, by request class.");
+	for (int i = 0; i < RPC_CLASSES; i++)
+		metrics_append(buf, METRICS_PREFIX "rpc_lane_admitted_total{class=\"%s\"} " UINT64_FORMAT "\n",
+					   classes[i], __atomic_load_n(&lane_admitted[i], __ATOMIC_RELAXED));
+	metrics_family(buf, "rpc_lane_waited_total", "counter", "Requests that queued for a slot, by request class.");
+	for (int i = 0; i < RPC_CLASSES; i++)
+		metrics_append(buf, METRICS_PREFIX "rpc_lane_waited_total{class=\"%s\"} " UINT64_FORMAT "\n",
+					   classes[i], __atomic_load_n(&lane_waited[i], __ATOMIC_RELAXED));
+	metrics_family(buf, "rpc_lane_wait_seconds_total", "counter", "Time requests queued for a slot.");
+	for (int i = 0; i < RPC_CLASSES; i++)
+		metrics_append(buf, METRICS_PREFIX "rpc_lane_wait_seconds_total{class=\"%s\"} %.6f\n",
+					   classes[i], __atomic_load_n(&lane_wait_ns[i], __ATOMIC_RELAXED) / 1e9);
+	metrics_family(buf, "rpc_lane_shed_total", "counter", "Requests rejected to shed load, by request class.");
+	for (int i = 0; i < RPC_CLASSES; i++)
+		metrics_append(buf, METRICS_PREFIX "rpc_lane_shed_total{class=\"%s\"} " UINT64_FORMAT "\n",
+					   classes[i], __atomic_load_n(&lane_shed[i], __ATOMIC_RELAXED));
+}
+
+static void
+metrics_page_reads(MetricsBuf *buf)
+{
+	static const char *const paths[PAGE_READ_PATHS] = {"base", "rocksdb", "replay"};
+	static const char *const encodings[2] = {"raw", "compressed"};
+
+	metrics_family(buf, "page_reads_total", "counter", "Page reads served, by how the page was made.");
+	for (int i = 0; i < PAGE_READ_PATHS; i++)
+		metrics_append(buf, METRICS_PREFIX "page_reads_total{path=\"%s\"} " UINT64_FORMAT "\n",
+					   paths[i], __atomic_load_n(&page_reads[i], __ATOMIC_RELAXED));
+
+	metrics_family(buf, "page_sent_total", "counter",
+				   "Pages sent to connections asking for compression, by how they went.");
+	for (int i = 0; i < 2; i++)
+		metrics_append(buf, METRICS_PREFIX "page_sent_total{encoding=\"%s\"} " UINT64_FORMAT "\n",
+					   encodings[i], __atomic_load_n(&pages_sent[i], __ATOMIC_RELAXED));
+	metrics_family(buf, "page_sent_bytes_total", "counter",
+				   "Bytes of the pages sent to connections asking for compression.");
+	for (int i = 0; i < 2; i++)
+		metrics_append(buf, METRICS_PREFIX "page_sent_bytes_total{encoding=\"%s\"} " UINT64_FORMAT "\n",
+					   encodings[i], __atomic_load_n(&page_bytes_sent[i], __ATOMIC_RELAXED));
+}
+
+/*
+ * The fine histogram buckets are folded into powers of two from 1us to 16s
+ * for the exposition; the quantiles are taken off the fine buckets.
+ */
+#define STAGE_LE_FIRST_SHIFT 10
+#define STAGE_LE_LAST_SHIFT 34
+
+static double
+stage_quantile(const uint64 *counts, uint64 total, double q)
+{
+	uint64		rank = (uint64) (q * (double) total);
+	uint64		seen = 0;
+
+	for (int b = 0; b < STAGE_TIMING_BUCKETS; b++)
+	{
+		seen += counts[b];
+		if (seen > rank)
+			return (double) StageTimingBucketUpper(b) / 1e9;
+	}
+	return 0;
+}
+
+static void
+metrics_stages(MetricsBuf *buf)
+{
+	static const double quantiles[] = {0.5, 0.99, 0.999};
+	uint64		(*counts)[STAGE_TIMING_BUCKETS];
+	uint64		sum_ns[STAGE_NUM];
+	uint64		total[STAGE_NUM];
+
+	counts = malloc(sizeof(uint64) * STAGE_NUM * STAGE_TIMING_BUCKETS);
+	if (counts == NULL)
+		return;
+	StageTimingCollect(counts, sum_ns);
+
+	metrics_family(buf, "stage_seconds", "histogram", "Sampled latency of the stages of page reads.");
+	for (int s = 0; s < STAGE_NUM; s++)
+	{
+		const char *name = StageTimingName((StorageStage) s);
+		uint64		cumulative = 0;
+		int			b = 0;
+
+		for (int shift = STAGE_LE_FIRST_SHIFT; shift <= STAGE_LE_LAST_SHIFT; shift++)
+		{
+			for (; b < STAGE_TIMING_BUCKETS && StageTimingBucketUpper(b) < ((uint64) 1 << shift); b++)
+				cumulative += counts[s][b];
+			metrics_append(buf, METRICS_PREFIX "stage_seconds_bucket{stage=\"%s\",le=\"%.9g\"} " UINT64_FORMAT "\n",
+						   name, (double) ((uint64) 1 << shift) / 1e9, cumulative);
+		}
+		for (; b < STAGE_TIMING_BUCKETS; b++)
+			cumulative += counts[s][b];
+		total[s] = cumulative;
+		metrics_append(buf, METRICS_PREFIX "stage_seconds_bucket{stage=\"%s\",le=\"+Inf\"} " UINT64_FORMAT "\n",
+					   name, cumulative);
+		metrics_append(buf, METRICS_PREFIX "stage_seconds_sum{stage=\"%s\"} %.9f\n",
+					   name, (double) sum_ns[s] / 1e9);
+		metrics_append(buf, METRICS_PREFIX "stage_seconds_count{stage=\"%s\"} " UINT64_FORMAT "\n",
+					   name, cumulative);
+	}
+
+	metrics_family(buf, "stage_quantile_seconds", "gauge", "Upper bound of a latency quantile of a page read stage.");
+	for (int s = 0; s < STAGE_NUM; s++)
+		for (int i = 0; i < lengthof(quantiles); i++)
+			metrics_append(buf, METRICS_PREFIX "stage_quantile_seconds{stage=\"%s\",quantile=\"%g\"} %.9g\n",
+						   StageTimingName((StorageStage) s), quantiles[i],
+						   stage_quantile(counts[s], total[s], quantiles[i]));
+	free(counts);
+}
+
+/*
+ * Compute nodes routing reads across storage replicas poll these to tell
+ * which replica serves an LSN without waiting for the parser.
+ */
+static void
+metrics_wal(MetricsBuf *buf)
+{
+	uint64_t	segments;
+	uint64_t	rawBytes;
+	uint64_t	storedBytes;
+
+	WalRetentionCounts(&segments, &rawBytes, &storedBytes);
+	metrics_gauge(buf, "xlog_parse_upto_lsn", "WAL position parsed into the logindex.",
+				  (double) XLogParseUpto);
+	metrics_gauge(buf, "xlog_flushed_lsn", "WAL position flushed by the compute node.",
+				  (double) RpcXLogFlushedLsn);
+	metrics_gauge(buf, "wal_retention_segments", "Retained WAL segments compressed.",
+				  (double) segments);
+	metrics_gauge(buf, "wal_retention_raw_bytes", "Bytes of the compressed WAL segments.",
+				  (double) rawBytes);
+	metrics_gauge(buf, "wal_retention_stored_bytes", "Bytes the compressed WAL segments take.",
+				  (double) storedBytes);
+}
+
+char *
+SmartReplayMetricsText(size_t *len)
+{
+	MetricsBuf	buf = {NULL, 0, 0};
+
+	metrics_asr(&buf);
+	metrics_tenants(&buf);
+	metrics_redo_pool(&buf);
+	metrics_logindex(&buf);
+	metrics_memory(&buf);
+	metrics_page_reads(&buf);
+	metrics_lanes(&buf);
+	metrics_stages(&buf);
+	metrics_wal(&buf);
+
+	if (buf.data == NULL)
+		buf.data = strdup("");
+	*len = buf.data != NULL ? buf.len : 0;
+	return buf.data;
+}
+
+static bool
+metrics_write_all(int fd, const char *data, size_t len)
+{
+	while (len > 0)
+	{
+		ssize_t		n = send(fd, data, len, MSG_NOSIGNAL);
+
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return false;
+		data += n;
+		len -= n;
+	}
+	return true;
+}
+
+static void
+metrics_serve(int fd)
+{
+	char		request[METRICS_REQUEST_SIZE];
+	size_t		got = 0;
+	char		header[256];
+	char	   *body = NULL;
+	size_t		bodyLen = 0;
+	const char *status;
+
+	/* Only the request line matters, read until the end of the headers */
+	while (got < sizeof(request) - 1)
+	{
+		ssize_t		n = recv(fd, request + got, sizeof(request) - 1 - got, 0);
+
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			break;
+		got += n;
+		request[got] = '\0';
+		if (strstr(request, "\r\n\r\n") != NULL || strstr(request, "\n\n") != NULL)
+			break;
+	}
+	request[got] = '\0';
+
+	if (strncmp(request, "GET /metrics", 12) == 0 || strncmp(request, "GET / ", 6) == 0)
+	{
+		status = "200 OK";
+		body = SmartReplayMetricsText(&bodyLen);
+	}
+	else
+		status = "404 Not Found";
+
+	snprintf(header, sizeof(header),
+			 "HTTP/1.0 %s\r\n"
+			 "Content-Type: text/plain; version=0.0.4\r\n"
+			 "Content-Length: %zu\r\n"
+			 "Connection: close\r\n\r\n",
+			 status, bodyLen);
+	if (metrics_write_all(fd, header, strlen(header)) && body != NULL)
+		metrics_write_all(fd, body, bodyLen);
+	free(body);
+}
+
+static void *
+metrics_server_main(void *arg)
+{
+	int			listenFd = (int) (intptr_t) arg;
+
+	for (;;)
+	{
+		struct timeval timeout = {METRICS_IO_TIMEOUT_S, 0};
+		int			fd = accept(listenFd, NULL, NULL);
+
+		if (fd < 0)
+		{
+			if (errno != EINTR)
+				pg_usleep(100000L);
+			continue;
+		}
+		/* A stalled scraper must not hold up the next one for long */
+		setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+		setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+		metrics_serve(fd);
+		close(fd);
+	}
+	return NULL;
+}
+
+void
+SmartReplayMetricsStartServer(void)
+{
+	struct sockaddr_in addr;
+	pthread_t	tid;
+	int			fd;
+	int			one = 1;
+
+	if (asr_metrics_port <= 0)
+		return;
+
+	fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd < 0)
+	{
+		ereport(WARNING,
+				(errmsg("[ASR] could not create metrics socket: %m")));
+		return;
+	}
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	addr.sin_port = htons((uint16) asr_metrics_port);
+	if (bind(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0 || listen(fd, 16) < 0)
+	{
+		ereport(WARNING,
+				(errmsg("[ASR] could not listen for metrics on port %d: %m", asr_metrics_port)));
+		close(fd);
+		return;
+	}
+
+	if (pthread_create(&tid, NULL, metrics_server_main, (void *) (intptr_t) fd) != 0)
+	{
+		ereport(WARNING,
+				(errmsg("[ASR] could not start the metrics thread")));
+		close(fd);
+		return;
+	}
+	pthread_detach(tid);
+
+	ereport(LOG,
+			(errmsg("[ASR] serving metrics on port %d", asr_metrics_port)));
+}
@@ -175,30 +175,25 @@ rpcmdexists(SMgrRelation reln, ForkNumber forkNum)
 {
 
 #ifdef ENABLE_REL_SIZE_CACHE2
-    uint32_t result=-1;
     RelKey relKey;
 
     TransRelNode2RelKey(reln, &relKey, forkNum);
 
+    int cached = GetRelExistsCache(relKey);
+    if(cached >= 0)
+        return cached;
 
-    //! TODO After add these locks, sysbench will crash
-    RelSizeSharedLock(relKey);
-    if(GetRelSizeCache(relKey, &result)) {
-        // printf("%s %d\n", __func__ , __LINE__);
-        fflush(stdout);
-        RelSizeReleaseLock(relKey);
-        return result >= 0;
-    }
-    RelSizeReleaseLock(relKey);
+    // Asked before the call, so that a drop meanwhile voids the answer
+    uint64_t leaseLsn = GetLogWrtResultLsn();
 #endif
 
     // If not cached locally, get from remote
     uint32_t rpcResult = RpcMdExists(reln, forkNum);
-#ifdef ENABLE_REL_SIZE_CACHE
-    if(result != -1 && (result>=0) != rpcResult) {
-        printf("%s %d, %lu_%lu_%lu_%d cache=%u, rpc=%u\n", __func__ , __LINE__, relKey.SpcId, relKey.DbId, relKey.RelId, relKey.forkNum, (result>=0), rpcResult);
-        fflush(stdout);
-    }
+#ifdef ENABLE_REL_SIZE_CACHE2
+    // An existing fork gets its size cached by the next nblocks, a missing
+    // one is remembered here, so that FSM and VM probes don't ask each time
+    if(!rpcResult)
+        InsertRelSizeLease(relKey, -1, leaseLsn);
 #endif
 
     return rpcResult;
@@ -209,24 +204,12 @@ rpcmdcreate(SMgrRelation reln, ForkNumber forkNum, bool isRedo)
 {
 
 #ifdef ENABLE_REL_SIZE_CACHE2
-    uint32_t result;
     RelKey relKey;
 
     TransRelNode2RelKey(reln, &relKey, forkNum);
 
-    RelSizeExclusiveLock(relKey);
-    if(GetRelSizeCache(relKey, &result)) {
-        if(result < 0) { // If it was deleted?
-//            printf("%s %d, %lu_%lu_%lu_%d = %u\n", __func__ , __LINE__, relKey.SpcId, relKey.DbId, relKey.RelId, relKey.forkNum, 0);
-//            fflush(stdout);
-            InsertRelSizeCache(relKey, 0);
-        }
-    } else { // Not exist in buffer, init blkNum as 0
-//        printf("%s %d, %lu_%lu_%lu_%d = %u\n", __func__ , __LINE__, relKey.SpcId, relKey.DbId, relKey.RelId, relKey.forkNum, 0);
-//        fflush(stdout);
-        InsertRelSizeCache(relKey, 0);
-    }
-    RelSizeReleaseLock(relKey);
+    // Not exist in buffer, init blkNum as 0
+    InsertRelSizeCacheIfAbsent(relKey, 0);
 #endif
 
     // Secondary compute node won't alter the shared relation
@@ -237,6 +220,21 @@ rpcmdcreate(SMgrRelation reln, ForkNumber forkNum, bool isRedo)
 void
 rpcmdunlink(RelFileNodeBackend rnode, ForkNumber forkNum, bool isRedo)
 {
+#ifdef ENABLE_REL_SIZE_CACHE
+    RelKey relKey;
+    uint64_t lsn = GetLogWrtResultLsn();
+
+    relKey.SpcId = rnode.node.spcNode;
+    relKey.DbId = rnode.node.dbNode;
+    relKey.RelId = rnode.node.relNode;
+    // InvalidForkNumber stands for all forks
+    for (int fork = 0; fork <= MAX_FORKNUM; fork++) {
+        if (forkNum != InvalidForkNumber && fork != forkNum)
+            continue;
+        relKey.forkNum = fork;
+        ForgetRelSizeCache(relKey, lsn);
+    }
+#endif
 }
 
 static void
@@ -250,26 +248,12 @@ rpcmdextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum,
 {
 
 #ifdef ENABLE_REL_SIZE_CACHE
-    uint32_t result;
     RelKey relKey;
 
     TransRelNode2RelKey(reln, &relKey, forknum);
 
-//    printf("%s %d\n", __func__ , __LINE__);
-//    fflush(stdout);
-    RelSizeExclusiveLock(relKey);
-    if(GetRelSizeCache(relKey, &result)) { //After extend, blkNum increased
-        if(blocknum+1 > result) {
-//            printf("%s %d, %lu_%lu_%lu_%d = %u\n", __func__ , __LINE__, relKey.SpcId, relKey.DbId, relKey.RelId, relKey.forkNum, blocknum+1);
-//            fflush(stdout);
-            InsertRelSizeCache(relKey, blocknum+1);
-        }
-    } else { // Not exist
-//        printf("%s %d, %lu_%lu_%lu_%d = %u\n", __func__ , __LINE__, relKey.SpcId, relKey.DbId, relKey.RelId, relKey.forkNum, blocknum+1);
-//        fflush(stdout);
-        InsertRelSizeCache(relKey, blocknum+1);
-    }
-    RelSizeReleaseLock(relKey);
+    //After extend, blkNum increased
+    ExtendRelSizeCache(relKey, blocknum+1);
 #endif
 
     // Secondary compute node won't alter the shared relation
@@ -277,6 +261,24 @@ rpcmdextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum,
         RpcMdExtend(reln, forknum, blocknum, buffer, skipFsync);
 }
 
+void
+rpcmdzeroextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum,
+         int nblocks, bool skipFsync)
+{
+
+#ifdef ENABLE_REL_SIZE_CACHE
+    RelKey relKey;
+
+    TransRelNode2RelKey(reln, &relKey, forknum);
+
+    ExtendRelSizeCache(relKey, blocknum+nblocks);
+#endif
+
+    // One round trip for all of them, the storage node writes the zero pages
+    if(!InRecovery)
+        RpcMdExtendMany(reln, forknum, blocknum, nblocks, skipFsync);
+}
+
 static MdfdVec *
 rpcmdopenfork(SMgrRelation reln, ForkNumber forknum, int behavior)
 {
@@ -295,6 +297,7 @@ rpcmdclose(SMgrRelation reln, ForkNumber forknum)
 bool
 rpcmdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum)
 {
+    RpcPrefetchBuffer(reln, forknum, blocknum);
     return true;
 }
 
@@ -315,6 +318,18 @@ void
 rpcmdwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum,
 		char *buffer, bool skipFsync)
 {
+    /*
+     * The storage node replays every page from the WAL, except those
+     * written without it under wal_level=minimal: a page of a relation
+     * made in this transaction carries no WAL LSN, and only reaches the
+     * storage node here. The free space map is rebuilt by vacuum instead.
+     */
+    if (XLogIsNeeded() || forknum == FSM_FORKNUM)
+        return;
+    if (PageIsNew((Page) buffer) || PageGetLSN((Page) buffer) >= FirstNormalUnloggedLSN)
+        return;
+
+    RpcInstallPage(reln, forknum, blocknum, buffer);
 }
 
 BlockNumber
@@ -327,14 +342,13 @@ rpcmdnblocks(SMgrRelation reln, ForkNumber forknum)
     TransRelNode2RelKey(reln, &relKey, forknum);
 //    printf("%s %d\n", __func__ , __LINE__);
 //    fflush(stdout);
-    RelSizeSharedLock(relKey);
     if(GetRelSizeCache(relKey, &result)) { //After extend, blkNum increased
-        RelSizeReleaseLock(relKey);
         // printf("%s %d\n", __func__ , __LINE__);
         // fflush(stdout);
         return result;
     }
-    RelSizeReleaseLock(relKey);
+
+    uint64_t leaseLsn = GetLogWrtResultLsn();
 #endif
 
     uint32_t blckNum = RpcMdNblocks(reln, forknum);
@@ -347,13 +361,9 @@ rpcmdnblocks(SMgrRelation reln, ForkNumber forknum)
     }
 //    printf("%s %d, %lu_%lu_%lu_%d = %u\n", __func__ , __LINE__, relKey.SpcId, relKey.DbId, relKey.RelId, relKey.forkNum, blckNum);
 //    fflush(stdout);
-    RelSizeExclusiveLock(relKey);
-
-    // Before we create a new relSize entry, check whether other process has already created
-    bool found = GetRelSizeCache(relKey, &result);
-    if(!found)
-        InsertRelSizeCache(relKey, blckNum);
-    RelSizeReleaseLock(relKey);
+    // Other process may have already created or extended it, the node's
+    // own changes win over the answer
+    InsertRelSizeLease(relKey, (int32_t) blckNum, leaseLsn);
 #endif
     return blckNum;
 }
@@ -368,9 +378,7 @@ rpcmdtruncate(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks)
 //    printf("%s %d, %lu_%lu_%lu_%d = %u\n", __func__ , __LINE__, relKey.SpcId, relKey.DbId, relKey.RelId, relKey.forkNum, nblocks);
 //    fflush(stdout);
 
-    RelSizeExclusiveLock(relKey);
     InsertRelSizeCache(relKey, nblocks);
-    RelSizeReleaseLock(relKey);
 #endif
 
     // Secondary compute node won't alter the shared relation
@@ -381,6 +389,8 @@ rpcmdtruncate(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks)
 void
 rpcmdimmedsync(SMgrRelation reln, ForkNumber forknum)
 {
+    // The pages written without WAL are durable once installed
+    RpcFlushInstalls();
 }
 
 static void
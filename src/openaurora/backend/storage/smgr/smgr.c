@@ -54,6 +54,8 @@ typedef struct f_smgr
 								bool isRedo);
 	void		(*smgr_extend) (SMgrRelation reln, ForkNumber forknum,
 								BlockNumber blocknum, char *buffer, bool skipFsync);
+	void		(*smgr_zeroextend) (SMgrRelation reln, ForkNumber forknum,
+									BlockNumber blocknum, int nblocks, bool skipFsync);	/* may be NULL */
 	bool		(*smgr_prefetch) (SMgrRelation reln, ForkNumber forknum,
 								  BlockNumber blocknum);
 	void		(*smgr_read) (SMgrRelation reln, ForkNumber forknum,
@@ -79,6 +81,7 @@ static const f_smgr smgrsw[] = {
 		.smgr_exists = mdexists,
 		.smgr_unlink = mdunlink,
 		.smgr_extend = mdextend,
+		.smgr_zeroextend = NULL,
 		.smgr_prefetch = mdprefetch,
 		.smgr_read = mdread,
 		.smgr_write = mdwrite,
@@ -96,6 +99,7 @@ static const f_smgr smgrsw[] = {
         .smgr_exists = rpcmdexists,
         .smgr_unlink = rpcmdunlink,
         .smgr_extend = rpcmdextend,
+        .smgr_zeroextend = rpcmdzeroextend,
         .smgr_prefetch = rpcmdprefetch,
         .smgr_read = rpcmdread,
         .smgr_write = rpcmdwrite,
@@ -113,6 +117,7 @@ static const f_smgr smgrsw[] = {
         .smgr_exists = rpcmdexists,
         .smgr_unlink = rpcmdunlink,
         .smgr_extend = rpcmdextend,
+        .smgr_zeroextend = rpcmdzeroextend,
         .smgr_prefetch = rpcmdprefetch,
         .smgr_read = rpcmdread,
         .smgr_write = MemPoolmdwrite,
@@ -524,6 +529,36 @@ smgrextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum,
 										 buffer, skipFsync);
 }
 
+/*
+ *	smgrzeroextend() -- Add nblocks zero-filled blocks to a file.
+ *
+ *		Same as calling smgrextend() with an all-zero page for blocknum up to
+ *		blocknum + nblocks - 1, but lets a storage manager that can do it in
+ *		one go (rpcmd: one round trip to the storage node) do so.
+ */
+void
+smgrzeroextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum,
+			   int nblocks, bool skipFsync)
+{
+	PGAlignedBlock zerobuf;
+	int			i;
+
+	if (nblocks <= 0)
+		return;
+
+	if (smgrsw[reln->smgr_which].smgr_zeroextend)
+	{
+		smgrsw[reln->smgr_which].smgr_zeroextend(reln, forknum, blocknum,
+												 nblocks, skipFsync);
+		return;
+	}
+
+	MemSet(zerobuf.data, 0, BLCKSZ);
+	for (i = 0; i < nblocks; i++)
+		smgrsw[reln->smgr_which].smgr_extend(reln, forknum, blocknum + i,
+											 zerobuf.data, skipFsync);
+}
+
 /*
  *	smgrprefetch() -- Initiate asynchronous read of the specified block of a relation.
  *
@@ -0,0 +1,215 @@
+/*-------------------------------------------------------------------------
+ *
+ * stage_timing.c
+ *		Latency histograms of the stages of a storage node page read
+ *
+ * The histograms of a thread are written by it alone, with plain relaxed
+ * stores, and read by StageTimingCollect() from any thread with relaxed
+ * loads; a sum may be a few measurements behind, never torn.  A block of
+ * histograms is claimed by a thread with a CAS on in_use and released by
+ * a thread-specific destructor when the thread exits, so a server that
+ * starts a thread per connection doesn't grow a block per connection.
+ *
+ * A start time carries whether the measurement is sampled in its low bit,
+ * a traced request times the stages that aren't too.
+ *
+ * IDENTIFICATION
+ *		src/backend/storage/stage_timing.c
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#include "postgres.h"
+
+#include <pthread.h>
+#include <time.h>
+
+#include "storage/stage_timing.h"
+
+/* Below this many nanoseconds a bucket holds a single value */
+#define STAGE_TIMING_LINEAR 4
+
+typedef struct StageHistograms
+{
+	uint64		counts[STAGE_NUM][STAGE_TIMING_BUCKETS];
+	uint64		sum_ns[STAGE_NUM];
+	bool		in_use;
+	struct StageHistograms *next;
+} StageHistograms;
+
+int			stage_timing_sample_rate = 16;
+
+static const char *const stage_names[STAGE_NUM] = {
+	"wait_parse",
+	"hashmap_lookup",
+	"rocksdb_get",
+	"pipe_send",
+	"pipe_receive",
+	"redo",
+	"put_back",
+};
+
+static StageHistograms *all_histograms = NULL;
+static pthread_key_t release_key;
+static pthread_once_t release_key_once = PTHREAD_ONCE_INIT;
+
+static __thread StageHistograms *my_histograms = NULL;
+static __thread int sample_tick = 0;
+static __thread StageTrace *my_trace = NULL;
+
+static void
+stage_timing_release(void *arg)
+{
+	StageHistograms *h = (StageHistograms *) arg;
+
+	__atomic_store_n(&h->in_use, false, __ATOMIC_RELEASE);
+}
+
+static void
+stage_timing_make_key(void)
+{
+	pthread_key_create(&release_key, stage_timing_release);
+}
+
+static StageHistograms *
+stage_timing_claim(void)
+{
+	StageHistograms *h;
+
+	pthread_once(&release_key_once, stage_timing_make_key);
+
+	for (h = __atomic_load_n(&all_histograms, __ATOMIC_ACQUIRE); h != NULL; h = h->next)
+	{
+		bool		expected = false;
+
+		if (__atomic_compare_exchange_n(&h->in_use, &expected, true, false,
+										__ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+			break;
+	}
+
+	if (h == NULL)
+	{
+		h = calloc(1, sizeof(StageHistograms));
+		if (h == NULL)
+			return NULL;
+		h->in_use = true;
+		h->next = __atomic_load_n(&all_histograms, __ATOMIC_RELAXED);
+		while (!__atomic_compare_exchange_n(&all_histograms, &h->next, h, false,
+											__ATOMIC_RELEASE, __ATOMIC_RELAXED))
+			;
+	}
+	pthread_setspecific(release_key, h);
+	return h;
+}
+
+static int
+stage_timing_bucket(uint64 ns)
+{
+	int			msb;
+
+	if (ns < STAGE_TIMING_LINEAR)
+		return (int) ns;
+	msb = 63 - __builtin_clzll(ns);
+	return (msb - 1) * 4 + (int) ((ns >> (msb - 2)) & 3);
+}
+
+uint64
+StageTimingBucketUpper(int bucket)
+{
+	int			shift;
+
+	if (bucket < STAGE_TIMING_LINEAR)
+		return bucket;
+	shift = bucket / 4 - 1;
+	return ((uint64) (4 + bucket % 4) << shift) + ((uint64) 1 << shift) - 1;
+}
+
+static uint64
+stage_timing_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64) ts.tv_sec * 1000000000 + ts.tv_nsec + 1;
+}
+
+uint64
+StageTimingStart(void)
+{
+	int			rate = stage_timing_sample_rate;
+	bool		sampled = false;
+
+	if (rate > 0 && ++sample_tick >= rate)
+	{
+		sample_tick = 0;
+		sampled = true;
+	}
+	if (!sampled && my_trace == NULL)
+		return 0;
+	return (stage_timing_now() << 1) | (sampled ? 1 : 0);
+}
+
+void
+StageTimingEnd(StorageStage stage, uint64 start)
+{
+	StageHistograms *h = my_histograms;
+	uint64		ns;
+	int			bucket;
+
+	if (start == 0)
+		return;
+	ns = stage_timing_now() - (start >> 1);
+	if (my_trace != NULL)
+		my_trace->ns[stage] += ns;
+	if ((start & 1) == 0)
+		return;
+	if (h == NULL && (h = my_histograms = stage_timing_claim()) == NULL)
+		return;
+
+	bucket = stage_timing_bucket(ns);
+	__atomic_store_n(&h->counts[stage][bucket], h->counts[stage][bucket] + 1, __ATOMIC_RELAXED);
+	__atomic_store_n(&h->sum_ns[stage], h->sum_ns[stage] + ns, __ATOMIC_RELAXED);
+}
+
+void
+StageTimingCollect(uint64 counts[STAGE_NUM][STAGE_TIMING_BUCKETS], uint64 sum_ns[STAGE_NUM])
+{
+	memset(counts, 0, sizeof(uint64) * STAGE_NUM * STAGE_TIMING_BUCKETS);
+	memset(sum_ns, 0, sizeof(uint64) * STAGE_NUM);
+
+	for (StageHistograms *h = __atomic_load_n(&all_histograms, __ATOMIC_ACQUIRE); h != NULL; h = h->next)
+	{
+		for (int s = 0; s < STAGE_NUM; s++)
+		{
+			for (int b = 0; b < STAGE_TIMING_BUCKETS; b++)
+				counts[s][b] += __atomic_load_n(&h->counts[s][b], __ATOMIC_RELAXED);
+			sum_ns[s] += __atomic_load_n(&h->sum_ns[s], __ATOMIC_RELAXED);
+		}
+	}
+}
+
+const char *
+StageTimingName(StorageStage stage)
+{
+	return stage_names[stage];
+}
+
+void
+StageTimingTraceBegin(StageTrace *trace, uint64 traceId)
+{
+	memset(trace, 0, sizeof(StageTrace));
+	trace->traceId = traceId;
+	my_trace = trace;
+}
+
+void
+StageTimingTraceEnd(void)
+{
+	my_trace = NULL;
+}
+
+uint64
+StageTimingTraceId(void)
+{
+	return my_trace != NULL ? my_trace->traceId : 0;
+}
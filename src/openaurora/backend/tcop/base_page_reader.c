@@ -0,0 +1,469 @@
+//
+// Base pages read straight from the relation files, see tcop/base_page_reader.h.
+//
+// This runs in rpc server threads, so it stays away from everything that
+// is per-process in PostgreSQL: no palloc, no fd.c virtual files, no
+// ereport. Paths are built by hand like GetRelationPath() does, relative to
+// the data directory the server runs in.
+//
+// With base_page_mmap a cached segment is mapped as well, and its pages are
+// copied out of the mapping. A block the mapping can't back any more, the
+// file was truncated under it by a wal_redo process, raises SIGBUS; the copy
+// catches it and the page goes to the wal_redo process like one past the end.
+//
+#include "postgres.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "catalog/pg_tablespace_d.h"
+#include "common/relpath.h"
+#include "tcop/base_page_reader.h"
+
+bool base_page_direct_read = true;
+bool base_page_mmap = false;
+
+#define BASE_PAGE_FD_SLOTS (512)
+#define BASE_PAGE_FD_LOCKS (32)
+#define BASE_PAGE_READER_THREADS (8)
+// A segment read this many blocks in a row in order is read ahead by the
+// kernel, one read out of order as often turns readahead off again
+#define BASE_PAGE_SEQUENTIAL_RUN (8)
+#define BASE_PAGE_SEGMENT_BYTES ((size_t) RELSEG_SIZE * BLCKSZ)
+
+typedef struct BasePageFdSlot {
+    bool        valid;
+    RelFileNode rnode;
+    ForkNumber  forknum;
+    BlockNumber segno;
+    int         fd;
+    int         refs;
+    uint64      generation;
+    // Mapping of the whole segment, NULL without base_page_mmap. Only the
+    // first fileLen bytes are known to exist
+    char       *map;
+    off_t       fileLen;
+    BlockNumber lastBlock;
+    int         run;        // > 0 in order, < 0 out of order
+    int         advice;
+} BasePageFdSlot;
+
+static BasePageFdSlot fdSlots[BASE_PAGE_FD_SLOTS];
+static pthread_mutex_t fdLocks[BASE_PAGE_FD_LOCKS];
+// Bumped by BasePageReaderInvalidate, older slots are reopened
+static uint64 fdGeneration = 0;
+
+#ifdef RWF_NOWAIT
+// Cleared once the kernel or the file system turns RWF_NOWAIT down
+static bool nowaitSupported = true;
+#endif
+
+typedef struct BasePageBatch {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int pending;
+} BasePageBatch;
+
+typedef struct BasePageJob {
+    struct BasePageJob *next;
+    int fd;
+    off_t offset;
+    char *page;
+    bool *done;
+    BasePageBatch *batch;
+} BasePageJob;
+
+static BasePageJob *jobHead = NULL;
+static BasePageJob *jobTail = NULL;
+static pthread_mutex_t jobLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jobCond = PTHREAD_COND_INITIALIZER;
+static pthread_once_t readerOnce = PTHREAD_ONCE_INIT;
+static pthread_once_t mapOnce = PTHREAD_ONCE_INIT;
+// Where a copy out of a mapping jumps back to if it faults
+static __thread sigjmp_buf *mapFaultJump = NULL;
+
+static void BasePageSegmentPath(char *path, size_t len, RelFileNode rnode, ForkNumber forknum, BlockNumber segno) {
+    int pos;
+
+    if (rnode.spcNode == GLOBALTABLESPACE_OID)
+        pos = snprintf(path, len, "global/%u", rnode.relNode);
+    else if (rnode.spcNode == DEFAULTTABLESPACE_OID)
+        pos = snprintf(path, len, "base/%u/%u", rnode.dbNode, rnode.relNode);
+    else
+        pos = snprintf(path, len, "pg_tblspc/%u/%s/%u/%u", rnode.spcNode, TABLESPACE_VERSION_DIRECTORY,
+                       rnode.dbNode, rnode.relNode);
+    if (forknum != MAIN_FORKNUM)
+        pos += snprintf(path + pos, len - pos, "_%s", forkNames[forknum]);
+    if (segno > 0)
+        snprintf(path + pos, len - pos, ".%u", segno);
+}
+
+static void BasePageMapFault(int signo, siginfo_t *info, void *context) {
+    if (mapFaultJump != NULL)
+        siglongjmp(*mapFaultJump, 1);
+    // Not ours, die of it as if there was no handler
+    signal(signo, SIG_DFL);
+    raise(signo);
+}
+
+static void BasePageInstallFaultHandler(void) {
+    struct sigaction action;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = BasePageMapFault;
+    action.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGBUS, &action, NULL);
+}
+
+// The segment's mapping, NULL if mmap is off or fails. Reserves the whole
+// segment, the file may still grow into it
+static char *BasePageMapSegment(int fd, off_t *fileLen) {
+    struct stat st;
+    void *map;
+
+    if (!base_page_mmap || SIZEOF_VOID_P < 8 || fstat(fd, &st) != 0)
+        return NULL;
+    pthread_once(&mapOnce, BasePageInstallFaultHandler);
+    map = mmap(NULL, BASE_PAGE_SEGMENT_BYTES, PROT_READ, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+        return NULL;
+    // Point reads until the segment is seen read in order
+    madvise(map, BASE_PAGE_SEGMENT_BYTES, MADV_RANDOM);
+    *fileLen = st.st_size;
+    return (char *) map;
+}
+
+static void BasePageCloseSlot(BasePageFdSlot *entry) {
+    if (entry->map != NULL)
+        munmap(entry->map, BASE_PAGE_SEGMENT_BYTES);
+    entry->map = NULL;
+    close(entry->fd);
+    entry->valid = false;
+}
+
+// Caller holds the slot's lock. Follows the slot's reads and switches the
+// readahead of its mapping when they turn sequential or random
+static void BasePageNoteAccess(BasePageFdSlot *entry, BlockNumber blkno) {
+    int advice = entry->advice;
+
+    if (entry->map == NULL)
+        return;
+    if (blkno == entry->lastBlock + 1)
+        entry->run = entry->run > 0 ? entry->run + 1 : 1;
+    else if (blkno != entry->lastBlock)
+        entry->run = entry->run < 0 ? entry->run - 1 : -1;
+    entry->lastBlock = blkno;
+
+    if (entry->run >= BASE_PAGE_SEQUENTIAL_RUN)
+        advice = MADV_SEQUENTIAL;
+    else if (entry->run <= -BASE_PAGE_SEQUENTIAL_RUN)
+        advice = MADV_RANDOM;
+    if (advice != entry->advice) {
+        madvise(entry->map, BASE_PAGE_SEGMENT_BYTES, advice);
+        entry->advice = advice;
+    }
+}
+
+static int BasePageFdSlotOf(RelFileNode rnode, ForkNumber forknum, BlockNumber segno) {
+    uint32 hash = rnode.relNode * 0x9E3779B1u ^ rnode.dbNode * 0x85EBCA77u ^ (uint32) forknum * 31u ^ segno;
+
+    return (int) (hash % BASE_PAGE_FD_SLOTS);
+}
+
+// Returns the fd of the segment holding blkno, or -1. *slotNum is the cache
+// slot to release, -1 for a private fd the caller closes.
+static int BasePageAcquireFd(RelFileNode rnode, ForkNumber forknum, BlockNumber blkno, int *slotNum) {
+    BlockNumber segno = blkno / ((BlockNumber) RELSEG_SIZE);
+    int slot = BasePageFdSlotOf(rnode, forknum, segno);
+    BasePageFdSlot *entry = &fdSlots[slot];
+    uint64 generation = __atomic_load_n(&fdGeneration, __ATOMIC_ACQUIRE);
+    char path[MAXPGPATH];
+    int fd;
+
+    pthread_mutex_lock(&fdLocks[slot % BASE_PAGE_FD_LOCKS]);
+    if (entry->valid && entry->generation == generation && RelFileNodeEquals(entry->rnode, rnode)
+        && entry->forknum == forknum && entry->segno == segno) {
+        entry->refs++;
+        fd = entry->fd;
+        BasePageNoteAccess(entry, blkno);
+        pthread_mutex_unlock(&fdLocks[slot % BASE_PAGE_FD_LOCKS]);
+        *slotNum = slot;
+        return fd;
+    }
+    pthread_mutex_unlock(&fdLocks[slot % BASE_PAGE_FD_LOCKS]);
+
+    BasePageSegmentPath(path, sizeof(path), rnode, forknum, segno);
+    fd = open(path, O_RDONLY | PG_BINARY, 0);
+    if (fd < 0) {
+        *slotNum = -1;
+        return -1;
+    }
+
+    pthread_mutex_lock(&fdLocks[slot % BASE_PAGE_FD_LOCKS]);
+    // Another reader still uses the file it holds, keep ours private
+    if (entry->valid && entry->refs > 0) {
+        pthread_mutex_unlock(&fdLocks[slot % BASE_PAGE_FD_LOCKS]);
+        *slotNum = -1;
+        return fd;
+    }
+    if (entry->valid)
+        BasePageCloseSlot(entry);
+    entry->valid = true;
+    entry->rnode = rnode;
+    entry->forknum = forknum;
+    entry->segno = segno;
+    entry->fd = fd;
+    entry->refs = 1;
+    entry->generation = generation;
+    entry->map = BasePageMapSegment(fd, &entry->fileLen);
+    entry->lastBlock = blkno;
+    entry->run = 0;
+    entry->advice = MADV_RANDOM;
+    pthread_mutex_unlock(&fdLocks[slot % BASE_PAGE_FD_LOCKS]);
+    *slotNum = slot;
+    return fd;
+}
+
+static void BasePageReleaseFd(int fd, int slot) {
+    BasePageFdSlot *entry;
+
+    if (slot < 0) {
+        close(fd);
+        return;
+    }
+    entry = &fdSlots[slot];
+    pthread_mutex_lock(&fdLocks[slot % BASE_PAGE_FD_LOCKS]);
+    entry->refs--;
+    // Invalidated while in use
+    if (entry->refs == 0 && entry->generation != __atomic_load_n(&fdGeneration, __ATOMIC_ACQUIRE))
+        BasePageCloseSlot(entry);
+    pthread_mutex_unlock(&fdLocks[slot % BASE_PAGE_FD_LOCKS]);
+}
+
+static void BasePageReaderStart(void);
+
+void BasePageReaderInvalidate(void) {
+    pthread_once(&readerOnce, BasePageReaderStart);
+    __atomic_add_fetch(&fdGeneration, 1, __ATOMIC_RELEASE);
+    for (int i = 0; i < BASE_PAGE_FD_SLOTS; i++) {
+        pthread_mutex_lock(&fdLocks[i % BASE_PAGE_FD_LOCKS]);
+        if (fdSlots[i].valid && fdSlots[i].refs == 0)
+            BasePageCloseSlot(&fdSlots[i]);
+        pthread_mutex_unlock(&fdLocks[i % BASE_PAGE_FD_LOCKS]);
+    }
+}
+
+// Blocking read of a whole page, false at the end of the file
+static bool BasePageReadFully(int fd, char *page, off_t offset) {
+    size_t nread = 0;
+
+    while (nread < BLCKSZ) {
+        ssize_t n = pread(fd, page + nread, BLCKSZ - nread, offset + nread);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        nread += n;
+    }
+    return true;
+}
+
+// Copies the page out of the slot's mapping; false past the end of the file
+// or if the mapping faulted. The caller holds a reference to the slot
+static bool BasePageCopyMapped(BasePageFdSlot *entry, char *page, off_t offset) {
+    sigjmp_buf jump;
+
+    if (offset + BLCKSZ > __atomic_load_n(&entry->fileLen, __ATOMIC_RELAXED)) {
+        struct stat st;
+
+        // Extended since it was mapped, or truncated
+        if (fstat(entry->fd, &st) != 0)
+            return false;
+        __atomic_store_n(&entry->fileLen, st.st_size, __ATOMIC_RELAXED);
+        if (offset + BLCKSZ > st.st_size)
+            return false;
+    }
+    if (sigsetjmp(jump, 1) != 0) {
+        mapFaultJump = NULL;
+        return false;
+    }
+    mapFaultJump = &jump;
+    memcpy(page, entry->map + offset, BLCKSZ);
+    mapFaultJump = NULL;
+    return true;
+}
+
+static void BasePageRunJob(BasePageJob *job) {
+    *job->done = BasePageReadFully(job->fd, job->page, job->offset);
+
+    pthread_mutex_lock(&job->batch->lock);
+    if (--job->batch->pending == 0)
+        pthread_cond_signal(&job->batch->cond);
+    pthread_mutex_unlock(&job->batch->lock);
+}
+
+static void *BasePageReaderLoop(void *arg) {
+    for (;;) {
+        BasePageJob *job;
+
+        pthread_mutex_lock(&jobLock);
+        while (jobHead == NULL)
+            pthread_cond_wait(&jobCond, &jobLock);
+        job = jobHead;
+        jobHead = job->next;
+        if (jobHead == NULL)
+            jobTail = NULL;
+        pthread_mutex_unlock(&jobLock);
+
+        BasePageRunJob(job);
+    }
+    return NULL;
+}
+
+static void BasePageReaderStart(void) {
+    for (int i = 0; i < BASE_PAGE_FD_LOCKS; i++)
+        pthread_mutex_init(&fdLocks[i], NULL);
+    for (int i = 0; i < BASE_PAGE_READER_THREADS; i++) {
+        pthread_t thread;
+
+        if (pthread_create(&thread, NULL, BasePageReaderLoop, NULL) == 0)
+            pthread_detach(thread);
+    }
+}
+
+#ifdef RWF_NOWAIT
+// Returns 1 if the page came from the page cache, 0 at the end of the file,
+// -1 if it has to be read from disk
+static int BasePageReadCached(int fd, char *page, off_t offset) {
+    struct iovec iov;
+    ssize_t n;
+
+    if (!nowaitSupported)
+        return -1;
+    iov.iov_base = page;
+    iov.iov_len = BLCKSZ;
+    n = preadv2(fd, &iov, 1, offset, RWF_NOWAIT);
+    if (n == BLCKSZ)
+        return 1;
+    if (n == 0)
+        return 0;
+    if (n < 0 && (errno == EOPNOTSUPP || errno == ENOSYS || errno == EINVAL))
+        nowaitSupported = false;
+    // A part of the page only, or not cached
+    return -1;
+}
+#endif
+
+int BasePageReaderReadList(BasePageRequest *requests, int num) {
+    int *fds;
+    int *slots;
+    BasePageJob *jobs;
+    BasePageBatch batch;
+    int jobNum = 0;
+    int doneNum = 0;
+
+    for (int i = 0; i < num; i++)
+        requests[i].done = false;
+    if (!base_page_direct_read || num <= 0)
+        return 0;
+    pthread_once(&readerOnce, BasePageReaderStart);
+
+    fds = (int *) malloc(sizeof(int) * num);
+    slots = (int *) malloc(sizeof(int) * num);
+    jobs = (BasePageJob *) malloc(sizeof(BasePageJob) * num);
+    pthread_mutex_init(&batch.lock, NULL);
+    pthread_cond_init(&batch.cond, NULL);
+    batch.pending = 0;
+
+    for (int i = 0; i < num; i++) {
+        off_t offset = (off_t) (requests[i].blkno % ((BlockNumber) RELSEG_SIZE)) * BLCKSZ;
+
+        fds[i] = BasePageAcquireFd(requests[i].rnode, requests[i].forknum, requests[i].blkno, &slots[i]);
+        // The copies below then find the rest of the batch on its way in
+        if (fds[i] >= 0 && slots[i] >= 0 && fdSlots[slots[i]].map != NULL && num > 1)
+            madvise(fdSlots[slots[i]].map + offset, BLCKSZ, MADV_WILLNEED);
+    }
+
+    for (int i = 0; i < num; i++) {
+        off_t offset = (off_t) (requests[i].blkno % ((BlockNumber) RELSEG_SIZE)) * BLCKSZ;
+
+        if (fds[i] < 0)
+            continue;
+        if (slots[i] >= 0 && fdSlots[slots[i]].map != NULL) {
+            requests[i].done = BasePageCopyMapped(&fdSlots[slots[i]], requests[i].page, offset);
+            continue;
+        }
+#ifdef RWF_NOWAIT
+        int cached = BasePageReadCached(fds[i], requests[i].page, offset);
+        if (cached >= 0) {
+            requests[i].done = cached == 1;
+            continue;
+        }
+#endif
+        jobs[jobNum].fd = fds[i];
+        jobs[jobNum].offset = offset;
+        jobs[jobNum].page = requests[i].page;
+        jobs[jobNum].done = &requests[i].done;
+        jobs[jobNum].batch = &batch;
+        jobNum++;
+    }
+
+    if (jobNum > 0) {
+        batch.pending = jobNum;
+        // The first one is read here, the others by the pool meanwhile
+        if (jobNum > 1) {
+            pthread_mutex_lock(&jobLock);
+            for (int i = 1; i < jobNum; i++) {
+                jobs[i].next = NULL;
+                if (jobTail != NULL)
+                    jobTail->next = &jobs[i];
+                else
+                    jobHead = &jobs[i];
+                jobTail = &jobs[i];
+            }
+            pthread_cond_broadcast(&jobCond);
+            pthread_mutex_unlock(&jobLock);
+        }
+        BasePageRunJob(&jobs[0]);
+
+        pthread_mutex_lock(&batch.lock);
+        while (batch.pending > 0)
+            pthread_cond_wait(&batch.cond, &batch.lock);
+        pthread_mutex_unlock(&batch.lock);
+    }
+
+    for (int i = 0; i < num; i++) {
+        if (fds[i] >= 0)
+            BasePageReleaseFd(fds[i], slots[i]);
+        if (requests[i].done)
+            doneNum++;
+    }
+    pthread_mutex_destroy(&batch.lock);
+    pthread_cond_destroy(&batch.cond);
+    free(fds);
+    free(slots);
+    free(jobs);
+    return doneNum;
+}
+
+bool BasePageReaderRead(RelFileNode rnode, ForkNumber forknum, BlockNumber blkno, char *page) {
+    BasePageRequest request;
+
+    request.rnode = rnode;
+    request.forknum = forknum;
+    request.blkno = blkno;
+    request.page = page;
+    BasePageReaderReadList(&request, 1);
+    return request.done;
+}
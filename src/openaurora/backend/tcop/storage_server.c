@@ -30,21 +30,36 @@
 #include "utils/ps_status.h"
 #include "signal.h"
 #include "pgstat.h"
+#include "pg_trace.h"
 #include <pthread.h>
 #include <sys/types.h>
 #include "libpq/pqsignal.h"
 #include "postmaster/fork_process.h"
 #include "postmaster/startup.h"
+#include "postmaster/interrupt.h"
 #include "bootstrap/bootstrap.h"
 #include "storage/sync.h"
+#include "tcop/base_page_reader.h"
+#include "tcop/storage_server.h"
 #include "tcop/wal_redo.h"
+#include "tcop/wal_redo_cache.h"
+#include "tcop/wal_redo_channel.h"
+#include "tcop/wal_redo_local.h"
+#include "tcop/wal_redo_pool.h"
 #include "replication/walreceiver.h"
 #include "storage/md.h"
+#include "storage/db_clone.h"
+#include "access/logindex_gc_queue.h"
 #include "access/logindex_hashmap.h"
 #include "storage/kv_interface.h"
 #include "access/background_hashmap_vacuumer.h"
 #include "access/wakeup_latch.h"
+#include "access/wal_retention.h"
 #include "storage/adaptive_sr.h"
+#include "storage/cpu_roles.h"
+#include "storage/mem_governor.h"
+#include "storage/smart_replay_metrics.h"
+#include "storage/stage_timing.h"
 
 extern HashMap pageVersionHashMap;
 
@@ -64,23 +79,7 @@ pid_t WalRcvPid = 0;
 pid_t StartupPid = 0;
 
 //#define ENABLE_DEBUG_INFO
-//#define DEBUG_TIMING
-#ifdef DEBUG_TIMING
-struct timeval output_timing3;
-int initialized3 = 0;
-
-long SyncGetRelSizeTime = 0;
-long SyncGetRelSizeCount = 0;
-long ApplyOneLsnTime = 0;
-long ApplyOneLsnCount = 0;
-long GetBasePageTime = 0;
-long GetBasePageCount = 0;
-long GetPageByLsnTime = 0;
-long GetPageByLsnCount = 0;
-#endif
 
-#define REPLAY_PROCESS_NUM 5
-pthread_mutex_t replayProcessMutex[REPLAY_PROCESS_NUM];
 
 static void
 getInstallationPaths(const char *argv0)
@@ -247,9 +246,6 @@ sigusr1_handler(SIGNAL_ARGS) {
     latch_sigusr1_handler();
 }
 
-int **serverPipe;
-int **computePipe;
-
 static void
 proc_die(SIGNAL_ARGS) {
     HashMapDestroy(pageVersionHashMap);
@@ -260,17 +256,12 @@ proc_die(SIGNAL_ARGS) {
     free(RpcXLogPages);
     free(RpcXLogPagesLocks);
 
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        free(serverPipe[i]);
-        free(computePipe[i]);
-    }
-    free(serverPipe);
-    free(computePipe);
+    WalRedoChannelsClose(walRedoChannels, WalRedoPoolForkedProcesses());
     exit(0);
 }
 
 // WalRedo Process will use this variable
-// it will determine which pipe should use
+// it will determine which channel should use
 int ReplayProcessNum = -1;
 
 static void
@@ -278,56 +269,16 @@ StartWalRedoProcess(int argc, char *argv[],
                     const char *dbname,
                     const char *username) {
 
-    // Init ReplayProcess thread locks
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        pthread_mutex_init(&(replayProcessMutex[i]), NULL);
-    }
-    serverPipe = (int**) malloc(REPLAY_PROCESS_NUM*sizeof(int*));
-    computePipe = (int**) malloc(REPLAY_PROCESS_NUM*sizeof(int*));
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        serverPipe[i] = (int*) malloc(sizeof(int)*2);
-        computePipe[i] = (int*) malloc(sizeof(int)*2);
-    }
+    WalRedoPoolInit();
+    WalRedoLocalInit();
+    WalRedoCacheInit(WalRedoPoolForkedProcesses());
+    walRedoChannels = WalRedoChannelsCreate(WalRedoPoolForkedProcesses());
 
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        if(pipe(serverPipe[i]) == -1)
-            printf("Error on pipe\n");
-
-        if(pipe(computePipe[i]) == -1)
-            printf("Error on pipe\n");
-    }
-
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
+    for(int i = 0; i < WalRedoPoolForkedProcesses(); i++) {
         __pid_t pid = fork();
-        if(pid > 0) {
-            close(computePipe[i][1]); // Close comp's write pipe
-            close(serverPipe[i][0]); //Close server's read pipe
-
-            // Set the comp's read pipe to non-block
-            int flags = 0|O_NONBLOCK;
-            fcntl(computePipe[i][0], F_SETFL, flags);
-
-            //todo: should close at the end
-        } else if (pid == 0) { // Child Process
+        if (pid == 0) { // Child Process
             ReplayProcessNum = i;
-
-            close(computePipe[i][0]); //Close comp's read pipe
-            close(serverPipe[i][1]); //Close server's write pipe
-
-            // Set the server's read pipe to non-block
-            int flags = 0|O_NONBLOCK;
-            fcntl(serverPipe[i][0], F_SETFL, flags);
-
-            // Close pipes that master connects to other processes.
-            for(int j = 0; j < ReplayProcessNum; j++) {
-                if(j != i) {
-                    close(computePipe[j][0]);
-                    close(computePipe[j][1]);
-                    close(serverPipe[j][0]);
-                    close(serverPipe[j][1]);
-                }
-            }
-
+            CpuRoleBind(CPU_ROLE_REDO, i);
 
             InitPostmasterChild();
 
@@ -336,15 +287,152 @@ StartWalRedoProcess(int argc, char *argv[],
 
             WalRedoMain(argc, argv, dbname, username);
 
-            close(computePipe[i][1]);
-            close(serverPipe[i][0]);
             exit(0);
         }
-
+        if (pid > 0)
+            MemGovernorTrackProcess(pid);
     }
 
 }
 
+/*
+ * With ASR on, append its budget to an "ApplyRecordUntil" request of the
+ * given length and fix up $msgLen; the redo processes have no controller of
+ * their own. Returns the new length.
+ */
+static int
+AppendReplayBudget(char *requestBuffer, int targetMsgLen) {
+    if(!ASR_Enabled())
+        return targetMsgLen;
+
+    uint32 budget = pg_hton32((uint32) ASR_GetCurrentBudget());
+    memcpy(&requestBuffer[targetMsgLen], &budget, sizeof(budget));
+    targetMsgLen += sizeof(budget);
+
+    int32 msgLen = pg_hton32(targetMsgLen - 1);
+    memcpy(&requestBuffer[1], &msgLen, sizeof(msgLen));
+    return targetMsgLen;
+}
+
+/*
+ * Buffers of the requests to the redo processes, from a bump context of the
+ * thread's own that RedoRequestBufferDone() resets once a request is sent.
+ * A request then costs no malloc() unless it outgrows the first block,
+ * which the context keeps across resets.
+ */
+#define REDO_REQUEST_BUFFERS_SIZE (64 * 1024)
+
+static __thread MemoryContext redoRequestContext = NULL;
+
+static char *
+RedoRequestBuffer(size_t len) {
+    if (redoRequestContext == NULL)
+        redoRequestContext = BumpContextCreate(NULL, "Redo request buffers", REDO_REQUEST_BUFFERS_SIZE,
+                                               REDO_REQUEST_BUFFERS_SIZE, ALLOCSET_DEFAULT_MAXSIZE);
+    return (char *) MemoryContextAlloc(redoRequestContext, len);
+}
+
+static void
+RedoRequestBufferDone(void) {
+    MemoryContextReset(redoRequestContext);
+}
+
+/*
+ * Send a request to a redo process, and read its reply, timing each. The
+ * request of a traced read is preceded by a 'T' message with the trace ID,
+ * the redo process tags the next request with it.
+ */
+static void
+RedoRequestSend(int replayPid, const char *request, size_t len) {
+    uint64 traceId = StageTimingTraceId();
+    uint64 stageStart = StageTimingStart();
+
+    if (traceId != 0) {
+        char traceMessage[1 + sizeof(int32) + sizeof(uint64)];
+        int32 msgLen = pg_hton32(sizeof(int32) + sizeof(uint64));
+        uint64 netTraceId = pg_hton64(traceId);
+
+        traceMessage[0] = 'T';
+        memcpy(&traceMessage[1], &msgLen, sizeof(msgLen));
+        memcpy(&traceMessage[1 + sizeof(int32)], &netTraceId, sizeof(netTraceId));
+        WalRedoRingWrite(&walRedoChannels[replayPid].request, traceMessage, sizeof(traceMessage));
+        TRACE_POSTGRESQL_STORAGE_REDO_SEND(traceId, replayPid);
+    }
+    WalRedoRingWrite(&walRedoChannels[replayPid].request, request, len);
+    StageTimingEnd(STAGE_PIPE_SEND, stageStart);
+}
+
+static size_t
+RedoResponseRead(int replayPid, void *buf, size_t len) {
+    uint64 stageStart = StageTimingStart();
+    size_t done = WalRedoRingRead(NULL, &walRedoChannels[replayPid].response, buf, len);
+
+    StageTimingEnd(STAGE_PIPE_RECEIVE, stageStart);
+    return done;
+}
+
+/*
+ * Take a redo process for a replay of the given page, preferring the one it
+ * has affinity to when WAL_REDO_AFFINITY is set.
+ */
+static int
+AcquireReplayProcess(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blockNumber) {
+    return WalRedoPoolAcquireAffine(WalRedoPoolAffinityKey(relFileNode.spcNode, relFileNode.dbNode,
+                                                           relFileNode.relNode, forkNumber, blockNumber));
+}
+
+/*
+ * Replay the head of lsnList in this thread, as far as wal_redo_local
+ * allows, on a copy of origPage in targetPage. Returns how many LSNs are
+ * done; for the rest targetPage is the new base page.
+ */
+static int
+ApplyLsnListLocally(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blockNumber, XLogRecPtr* lsnList,
+                    int listSize, char* origPage, char* targetPage) {
+    BufferTag bufferTag;
+
+    if (!WalRedoLocalEnabled())
+        return 0;
+    INIT_BUFFERTAG(bufferTag, relFileNode, forkNumber, blockNumber);
+    memcpy(targetPage, origPage, BLCKSZ);
+    return WalRedoLocalApplyLsnList(&bufferTag, lsnList, listSize, targetPage);
+}
+
+#ifdef XLOG_IN_ROCKSDB
+/*
+ * Read the xlog records of lsnList for wal_redo, which takes them inline
+ * after the rest of the request, with one RocksDB lookup for all of them.
+ * Returns their total length; AppendXlogRecords copies and frees them.
+ */
+static size_t
+FetchXlogRecords(const XLogRecPtr* lsnList, int listSize, XLogRecord*** records) {
+    size_t *recordSizes = (size_t*) malloc(sizeof(size_t) * Max(listSize, 1));
+    size_t totalLen = 0;
+
+    *records = (XLogRecord**) malloc(sizeof(XLogRecord*) * Max(listSize, 1));
+    GetXlogListWithLsn(lsnList, listSize, *records, recordSizes);
+    for(int i = 0; i < listSize; i++) {
+        // The parser stores a record before publishing its versions
+        if((*records)[i] == NULL)
+            elog(PANIC, "xlog record at %X/%X is missing from RocksDB",
+                 (uint32) (lsnList[i] >> 32), (uint32) lsnList[i]);
+        totalLen += (*records)[i]->xl_tot_len;
+    }
+    free(recordSizes);
+    return totalLen;
+}
+
+static char *
+AppendXlogRecords(char* cursor, XLogRecord** records, int listSize) {
+    for(int i = 0; i < listSize; i++) {
+        memcpy(cursor, records[i], records[i]->xl_tot_len);
+        cursor += records[i]->xl_tot_len;
+        free(records[i]);
+    }
+    free(records);
+    return cursor;
+}
+#endif
 
 int SyncGetRelSize(RelFileNode relFileNode, ForkNumber forkNumber, XLogRecPtr lsn) {
 #ifdef ENABLE_DEBUG_INFO
@@ -352,25 +440,9 @@ int SyncGetRelSize(RelFileNode relFileNode, ForkNumber forkNumber, XLogRecPtr ls
     fflush(stdout);
 #endif
 
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
-    int tid = gettid();
-    int replayPid = tid%REPLAY_PROCESS_NUM;
-    int gotLock = 0;
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        if(pthread_mutex_trylock( &(replayProcessMutex[ (replayPid+i)%REPLAY_PROCESS_NUM ]) ) == 0) { // Lock successfully
-            gotLock = 1;
-            replayPid = (replayPid+i) % REPLAY_PROCESS_NUM;
-            break;
-        }
-    }
-
-    // if we didn't get lock with trylock(), then use block wait lock
-    if(gotLock == 0) {
-        pthread_mutex_lock(&(replayProcessMutex[replayPid]));
-    }
+    int replayPid = AcquireReplayProcess(relFileNode, forkNumber, 0);
+    // The blocks a clone reads from its parent aren't in its files
+    BlockNumber parentBlocks = DbCloneParentBlocks(relFileNode, forkNumber);
 
     // ------- Send "ApplyRecordUntil" request to replay process ------
     char requestBuffer[1024];
@@ -393,7 +465,7 @@ int SyncGetRelSize(RelFileNode relFileNode, ForkNumber forkNumber, XLogRecPtr ls
 //    memcpy(&requestBuffer[1], &msgLen, sizeof(msgLen));
 //    memcpy(&requestBuffer[1+sizeof(msgLen)], &lsn, sizeof(lsn));
 //
-//    int targetMsgLen = 1+4+sizeof(lsn);
+//    int targetMsgLen = AppendReplayBudget(requestBuffer, 1+4+sizeof(lsn));
 //
 //    int sendLen = 0;
 //    while(sendLen < targetMsgLen) {
@@ -405,7 +477,6 @@ int SyncGetRelSize(RelFileNode relFileNode, ForkNumber forkNumber, XLogRecPtr ls
 
     // -------- Send "MdNblocks" request to replay process -------
     int targetMsgLen = 0;
-    int sendLen = 0;
 
     requestBuffer[0] = 'M';
 
@@ -428,81 +499,30 @@ int SyncGetRelSize(RelFileNode relFileNode, ForkNumber forkNumber, XLogRecPtr ls
     memcpy(&requestBuffer[1+4+1+4+4], &relFileNode.relNode, 4);
 
     targetMsgLen = 1+4+1+4+4+4;
-    sendLen = 0;
 #ifdef ENABLE_DEBUG_INFO
     printf("%s send M request to standalone PG process\n", __func__ );
     fflush(stdout);
 #endif
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[replayPid][1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
     // ------- Read target page from replay process ------
-    int recvLen = 0;
     int nblocks = 0;
-    while (recvLen < sizeof(int)) {
-        char* tempP = &nblocks;
-        int readLen = read(computePipe[replayPid][0], &(tempP[recvLen]), sizeof(int) - recvLen);
-        if (readLen < 0) {
-            if (errno == EAGAIN) {
-                continue;
-            }
-            else {
-                printf("Error on read\n");
-                exit(1);
-            }
-        }
-        Assert(readLen >= 0);
-        recvLen += readLen;
-    }
+    int recvLen = RedoResponseRead(replayPid, &nblocks, sizeof(int));
 
     Assert(recvLen == sizeof(int));
 #ifdef ENABLE_DEBUG_INFO
     printf("%s, get page number = %d\n", __func__ , nblocks);
     fflush(stdout);
 #endif
-    pthread_mutex_unlock(&(replayProcessMutex[replayPid]));
+    WalRedoPoolRelease(replayPid);
 
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    SyncGetRelSizeTime += ((end.tv_sec*1000000+end.tv_usec) - (start.tv_sec*1000000+start.tv_usec));
-    SyncGetRelSizeCount++;
-
-    struct timeval now;
-
-    if(!initialized3){
-        gettimeofday(&output_timing3, NULL);
-        initialized3 = 1;
-    }
-    gettimeofday(&now, NULL);
-    if(now.tv_sec-output_timing3.tv_sec >= 5) {
-
-        printf("walredo_SyncGetRelSize = %ld, count = %d\n",SyncGetRelSizeTime, SyncGetRelSizeCount);
-        fflush(stdout);
-        output_timing3 = now;
-    }
-#endif
-    return nblocks;
+    return Max(nblocks, (int) parentBlocks);
 
 }
 
 void ApplyOneLsnWithoutBasePage(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blockNumber, XLogRecPtr lsn, char* targetPage) {
-    int tid = gettid();
-    int replayPid = tid%REPLAY_PROCESS_NUM;
-    int gotLock = 0;
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        if(pthread_mutex_trylock( &(replayProcessMutex[ (replayPid+i)%REPLAY_PROCESS_NUM ]) ) == 0) { // Lock successfully
-            gotLock = 1;
-            replayPid = (replayPid+i) % REPLAY_PROCESS_NUM;
-            break;
-        }
-    }
-
-    // if we didn't get lock with trylock(), then use block wait lock
-    if(gotLock == 0) {
-        pthread_mutex_lock(&(replayProcessMutex[replayPid]));
-    }
+    uint64 redoStart = StageTimingStart();
+    int replayPid = AcquireReplayProcess(relFileNode, forkNumber, blockNumber);
 
 
 #ifdef ENABLE_DEBUG_INFO
@@ -520,9 +540,9 @@ void ApplyOneLsnWithoutBasePage(RelFileNode relFileNode, ForkNumber forkNumber,
 
     // ------ Send "ApplyOneLsn" request to replay process ------
 #ifdef XLOG_IN_ROCKSDB
-    char *requestBuffer = (char*) malloc(8192+1024+record->xl_tot_len);
+    char *requestBuffer = RedoRequestBuffer(8192+1024+record->xl_tot_len);
 #else
-    char *requestBuffer = (char*) malloc(8192+1024);
+    char *requestBuffer = RedoRequestBuffer(8192+1024);
 #endif
     int32 msgLen = 0;
 
@@ -567,33 +587,15 @@ void ApplyOneLsnWithoutBasePage(RelFileNode relFileNode, ForkNumber forkNumber,
 #else
     int targetMsgLen = 1+4+1+4+4+4+4+8;
 #endif
-    int sendLen = 0;
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[replayPid][1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
 #ifdef XLOG_IN_ROCKSDB
     free(record);
 #endif
-    free(requestBuffer);
+    RedoRequestBufferDone();
 
     // ------- Read target page from replay process ------
-    int recvLen = 0;
-    while (recvLen < BLCKSZ) {
-        int readLen = read(computePipe[replayPid][0], &targetPage[recvLen], BLCKSZ - recvLen);
-        if (readLen < 0) {
-            if (errno == EAGAIN) {
-                continue;
-            }
-            else {
-                printf("Error on read\n");
-                exit(1);
-            }
-        }
-        Assert(readLen >= 0);
-        recvLen += readLen;
-    }
+    int recvLen = RedoResponseRead(replayPid, targetPage, BLCKSZ);
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s read %d from standalone \n", __func__ , recvLen);
@@ -601,32 +603,16 @@ void ApplyOneLsnWithoutBasePage(RelFileNode relFileNode, ForkNumber forkNumber,
 #endif
 
     Assert(recvLen == BLCKSZ);
-    pthread_mutex_unlock(&(replayProcessMutex[replayPid]));
+    WalRedoPoolRelease(replayPid);
+    StageTimingEnd(STAGE_REDO, redoStart);
 
 }
 
 // targetPage should be allocated by caller function
 // This function can be optimized by passing []lsn to PgStandalone and get several pages from PgStandalone
 void ApplyOneLsn(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blockNumber, XLogRecPtr lsn, char* origPage, char* targetPage) {
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
-    int tid = gettid();
-    int replayPid = tid%REPLAY_PROCESS_NUM;
-    int gotLock = 0;
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        if(pthread_mutex_trylock( &(replayProcessMutex[ (replayPid+i)%REPLAY_PROCESS_NUM ]) ) == 0) { // Lock successfully
-            gotLock = 1;
-            replayPid = (replayPid+i) % REPLAY_PROCESS_NUM;
-            break;
-        }
-    }
-
-    // if we didn't get lock with trylock(), then use block wait lock
-    if(gotLock == 0) {
-        pthread_mutex_lock(&(replayProcessMutex[replayPid]));
-    }
+    uint64 redoStart = StageTimingStart();
+    int replayPid = AcquireReplayProcess(relFileNode, forkNumber, blockNumber);
 
 
 //    pthread_mutex_lock(&replayProcessMutex);
@@ -646,9 +632,9 @@ void ApplyOneLsn(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blo
 
     // ------ Send "ApplyOneLsn" request to replay process ------
 #ifdef XLOG_IN_ROCKSDB
-    char *requestBuffer = (char*) malloc(8192+1024+record->xl_tot_len);
+    char *requestBuffer = RedoRequestBuffer(8192+1024+record->xl_tot_len);
 #else
-    char *requestBuffer = (char*) malloc(8192+1024);
+    char *requestBuffer = RedoRequestBuffer(8192+1024);
 #endif
     int32 msgLen = 0;
 
@@ -693,33 +679,15 @@ void ApplyOneLsn(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blo
 #else
     int targetMsgLen = 1+4+1+4+4+4+4+8+BLCKSZ;
 #endif
-    int sendLen = 0;
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[replayPid][1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
 #ifdef XLOG_IN_ROCKSDB
     free(record);
 #endif
-    free(requestBuffer);
+    RedoRequestBufferDone();
 
     // ------- Read target page from replay process ------
-    int recvLen = 0;
-    while (recvLen < BLCKSZ) {
-        int readLen = read(computePipe[replayPid][0], &targetPage[recvLen], BLCKSZ - recvLen);
-        if (readLen < 0) {
-            if (errno == EAGAIN) {
-                continue;
-            }
-            else {
-                printf("Error on read\n");
-                exit(1);
-            }
-        }
-        Assert(readLen >= 0);
-        recvLen += readLen;
-    }
+    int recvLen = RedoResponseRead(replayPid, targetPage, BLCKSZ);
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s read %d from standalone \n", __func__ , recvLen);
@@ -727,27 +695,8 @@ void ApplyOneLsn(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blo
 #endif
 
     Assert(recvLen == BLCKSZ);
-    pthread_mutex_unlock(&(replayProcessMutex[replayPid]));
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    ApplyOneLsnTime += ((end.tv_sec*1000000+end.tv_usec) - (start.tv_sec*1000000+start.tv_usec));
-    ApplyOneLsnCount++;
-
-    struct timeval now;
-
-    if(!initialized3){
-        gettimeofday(&output_timing3, NULL);
-        initialized3 = 1;
-    }
-    gettimeofday(&now, NULL);
-    if(now.tv_sec-output_timing3.tv_sec >= 5) {
-
-        //printf("walredo_wait_time = %ld\n",walRedoWaitLockTime);
-        printf("walredo_ApplyOneLsn = %ld, count = %d\n",ApplyOneLsnTime, ApplyOneLsnCount);
-        fflush(stdout);
-        output_timing3 = now;
-    }
-#endif
+    WalRedoPoolRelease(replayPid);
+    StageTimingEnd(STAGE_REDO, redoStart);
 }
 
 
@@ -759,25 +708,8 @@ void ApplyLsnListAndGetUpdatedPage(RelFileNode relFileNode, ForkNumber forkNumbe
     printf("%s %d\n", __func__ , __LINE__);
     fflush(stdout);
 #endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
-    int tid = gettid();
-    int replayPid = tid%REPLAY_PROCESS_NUM;
-    int gotLock = 0;
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        if(pthread_mutex_trylock( &(replayProcessMutex[ (replayPid+i)%REPLAY_PROCESS_NUM ]) ) == 0) { // Lock successfully
-            gotLock = 1;
-            replayPid = (replayPid+i) % REPLAY_PROCESS_NUM;
-            break;
-        }
-    }
-
-    // if we didn't get lock with trylock(), then use block wait lock
-    if(gotLock == 0) {
-        pthread_mutex_lock(&(replayProcessMutex[replayPid]));
-    }
+    uint64 redoStart = StageTimingStart();
+    int replayPid = AcquireReplayProcess(relFileNode, forkNumber, blockNumber);
 
 
 //    pthread_mutex_lock(&replayProcessMutex);
@@ -789,17 +721,16 @@ void ApplyLsnListAndGetUpdatedPage(RelFileNode relFileNode, ForkNumber forkNumbe
 #endif
 
 #ifdef XLOG_IN_ROCKSDB
-    // Read XlogRecord from RocksDB
-    XLogRecord *record;
-    size_t record_size;
-    GetXlogWithLsn(lsn, &record, &record_size);
+    // Read the XlogRecords of the whole list from RocksDB
+    XLogRecord **records;
+    size_t recordsLen = FetchXlogRecords(lsnList, listSize, &records);
 #endif
 
     // ------ Send "ApplyOneLsn" request to replay process ------
 #ifdef XLOG_IN_ROCKSDB
-    char *requestBuffer = (char*) malloc(8192+1024+record->xl_tot_len);
+    char *requestBuffer = RedoRequestBuffer(1024+listSize*sizeof(uint64_t)+recordsLen);
 #else
-    char *requestBuffer = (char*) malloc(1024+listSize*sizeof(uint64_t));
+    char *requestBuffer = RedoRequestBuffer(1024+listSize*sizeof(uint64_t));
 #endif
     int32 msgLen = 0;
 
@@ -814,7 +745,7 @@ void ApplyLsnListAndGetUpdatedPage(RelFileNode relFileNode, ForkNumber forkNumbe
     msgLen += 4; // $listSize
     msgLen += 8*listSize; // $lsnList
 #ifdef XLOG_IN_ROCKSDB
-    msgLen += record->xl_tot_len; // record, wal_redo will get its length by its header
+    msgLen += recordsLen; // records, wal_redo gets each one's length from its header
 #endif
     int origMsgLen = msgLen;
     msgLen = pg_hton32(msgLen);
@@ -877,7 +808,7 @@ void ApplyLsnListAndGetUpdatedPage(RelFileNode relFileNode, ForkNumber forkNumbe
     fflush(stdout);
 #endif
 #ifdef XLOG_IN_ROCKSDB
-    memcpy(&requestBuffer[1+4+1+4+4+4+4+8+BLCKSZ], record, record->xl_tot_len);
+    AppendXlogRecords(&requestBuffer[currLen], records, origListSize);
 #endif
 
 
@@ -887,38 +818,13 @@ void ApplyLsnListAndGetUpdatedPage(RelFileNode relFileNode, ForkNumber forkNumbe
 #endif
 
 
-#ifdef XLOG_IN_ROCKSDB
-    int targetMsgLen = 1+4+1+4+4+4+4+8+BLCKSZ+record->xl_tot_len;
-#else
     int targetMsgLen = 1+origMsgLen;
-#endif
-    int sendLen = 0;
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[replayPid][1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
-#ifdef XLOG_IN_ROCKSDB
-    free(record);
-#endif
-    free(requestBuffer);
+    RedoRequestBufferDone();
 
     // ------- Read target page from replay process ------
-    int recvLen = 0;
-    while (recvLen < BLCKSZ) {
-        int readLen = read(computePipe[replayPid][0], &targetPage[recvLen], BLCKSZ - recvLen);
-        if (readLen < 0) {
-            if (errno == EAGAIN) {
-                continue;
-            }
-            else {
-                printf("Error on read\n");
-                exit(1);
-            }
-        }
-        Assert(readLen >= 0);
-        recvLen += readLen;
-    }
+    int recvLen = RedoResponseRead(replayPid, targetPage, BLCKSZ);
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s read %d from standalone \n", __func__ , recvLen);
@@ -926,7 +832,8 @@ void ApplyLsnListAndGetUpdatedPage(RelFileNode relFileNode, ForkNumber forkNumbe
 #endif
 
     Assert(recvLen == BLCKSZ);
-    pthread_mutex_unlock(&(replayProcessMutex[replayPid]));
+    WalRedoPoolRelease(replayPid);
+    StageTimingEnd(STAGE_REDO, redoStart);
 }
 
 
@@ -935,25 +842,7 @@ void WalRedoExtendRel(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumbe
     printf("%s %d\n", __func__ , __LINE__);
     fflush(stdout);
 #endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
-    int tid = gettid();
-    int replayPid = tid%REPLAY_PROCESS_NUM;
-    int gotLock = 0;
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        if(pthread_mutex_trylock( &(replayProcessMutex[ (replayPid+i)%REPLAY_PROCESS_NUM ]) ) == 0) { // Lock successfully
-            gotLock = 1;
-            replayPid = (replayPid+i) % REPLAY_PROCESS_NUM;
-            break;
-        }
-    }
-
-    // if we didn't get lock with trylock(), then use block wait lock
-    if(gotLock == 0) {
-        pthread_mutex_lock(&(replayProcessMutex[replayPid]));
-    }
+    int replayPid = AcquireReplayProcess(relFileNode, forkNumber, blockNumber);
 
 
 //    pthread_mutex_lock(&replayProcessMutex);
@@ -964,19 +853,8 @@ void WalRedoExtendRel(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumbe
     fflush(stdout);
 #endif
 
-#ifdef XLOG_IN_ROCKSDB
-    // Read XlogRecord from RocksDB
-    XLogRecord *record;
-    size_t record_size;
-    GetXlogWithLsn(lsn, &record, &record_size);
-#endif
-
     // ------ Send "ApplyOneLsn" request to replay process ------
-#ifdef XLOG_IN_ROCKSDB
-    char *requestBuffer = (char*) malloc(8192+1024+record->xl_tot_len);
-#else
-    char *requestBuffer = (char*) malloc(8192+1024);
-#endif
+    char *requestBuffer = RedoRequestBuffer(8192+1024);
     int32 msgLen = 0;
 
     requestBuffer[0] = 'F';
@@ -988,9 +866,6 @@ void WalRedoExtendRel(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumbe
     msgLen += 4; // $rel
     msgLen += 4; // $blknum
     msgLen += BLCKSZ; // $pageContent
-#ifdef XLOG_IN_ROCKSDB
-    msgLen += record->xl_tot_len; // record, wal_redo will get its length by its header
-#endif
     int origMsgLen = msgLen;
     msgLen = pg_hton32(msgLen);
 
@@ -1021,46 +896,69 @@ void WalRedoExtendRel(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumbe
     currLen+=4;
     memcpy(&requestBuffer[currLen], content, BLCKSZ);
 
-#ifdef XLOG_IN_ROCKSDB
-    int targetMsgLen = 1+4+1+4+4+4+4+8+BLCKSZ+record->xl_tot_len;
-#else
     int targetMsgLen = 1+origMsgLen;
-#endif
-    int sendLen = 0;
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[replayPid][1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
-#ifdef XLOG_IN_ROCKSDB
-    free(record);
-#endif
-    free(requestBuffer);
+    RedoRequestBufferDone();
 
     // ------- Read target page from replay process ------
-    int recvLen = 0;
-    while (recvLen < sizeof(int)) {
-        int readLen = read(computePipe[replayPid][0], &content[recvLen], sizeof(int) - recvLen);
-        if (readLen < 0) {
-            if (errno == EAGAIN) {
-                continue;
-            }
-            else {
-                printf("Error on read\n");
-                exit(1);
-            }
-        }
-        Assert(readLen >= 0);
-        recvLen += readLen;
-    }
+    int recvLen = RedoResponseRead(replayPid, content, sizeof(int));
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s read %d from standalone \n", __func__ , recvLen);
     fflush(stdout);
 #endif
 
-    pthread_mutex_unlock(&(replayProcessMutex[replayPid]));
+    WalRedoPoolRelease(replayPid);
+
+}
+
+
+void WalRedoExtendRelMany(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber startBlock, int nblocks) {
+    int replayPid = AcquireReplayProcess(relFileNode, forkNumber, startBlock);
+    char requestBuffer[64];
+    int32 msgLen = 0;
+    int32 response;
+    uint32 count = pg_hton32((uint32) nblocks);
+
+    // ------ Send "ExtendRelMany" request to replay process ------
+    requestBuffer[0] = 'Z';
+
+    msgLen = 4; // $msgLen itself
+    msgLen += sizeof(unsigned char); //forknum
+    msgLen += 4; // $spc
+    msgLen += 4; // $db
+    msgLen += 4; // $rel
+    msgLen += 4; // $startblk
+    msgLen += 4; // $nblocks
+    int origMsgLen = msgLen;
+    msgLen = pg_hton32(msgLen);
+
+    relFileNode.spcNode = pg_hton32(relFileNode.spcNode);
+    relFileNode.dbNode = pg_hton32(relFileNode.dbNode);
+    relFileNode.relNode = pg_hton32(relFileNode.relNode);
+    startBlock = pg_hton32(startBlock);
+
+    int currLen = 1;
+    memcpy(&requestBuffer[currLen], &msgLen, sizeof(msgLen));
+    currLen+=4;
+    memcpy(&requestBuffer[currLen], &forkNumber, sizeof(unsigned char));
+    currLen+=1;
+    memcpy(&requestBuffer[currLen], &relFileNode.spcNode, 4);
+    currLen+=4;
+    memcpy(&requestBuffer[currLen], &relFileNode.dbNode, 4);
+    currLen+=4;
+    memcpy(&requestBuffer[currLen], &relFileNode.relNode, 4);
+    currLen+=4;
+    memcpy(&requestBuffer[currLen], &startBlock, 4);
+    currLen+=4;
+    memcpy(&requestBuffer[currLen], &count, 4);
 
+    RedoRequestSend(replayPid, requestBuffer, 1+origMsgLen);
+
+    RedoResponseRead(replayPid, (char *) &response, sizeof(int));
+
+    WalRedoPoolRelease(replayPid);
 }
 
 
@@ -1070,25 +968,7 @@ void WalRedoCreateRel(RelFileNode relFileNode, ForkNumber forkNumber) {
     fflush(stdout);
 #endif
 
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
-    int tid = gettid();
-    int replayPid = tid%REPLAY_PROCESS_NUM;
-    int gotLock = 0;
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        if(pthread_mutex_trylock( &(replayProcessMutex[ (replayPid+i)%REPLAY_PROCESS_NUM ]) ) == 0) { // Lock successfully
-            gotLock = 1;
-            replayPid = (replayPid+i) % REPLAY_PROCESS_NUM;
-            break;
-        }
-    }
-
-    // if we didn't get lock with trylock(), then use block wait lock
-    if(gotLock == 0) {
-        pthread_mutex_lock(&(replayProcessMutex[replayPid]));
-    }
+    int replayPid = AcquireReplayProcess(relFileNode, forkNumber, 0);
 
     // ------- Send "ApplyRecordUntil" request to replay process ------
     char requestBuffer[1024];
@@ -1097,7 +977,6 @@ void WalRedoCreateRel(RelFileNode relFileNode, ForkNumber forkNumber) {
 
     // -------- Send "CreateRel" request to replay process -------
     int targetMsgLen = 0;
-    int sendLen = 0;
 
     requestBuffer[0] = 'C';
 
@@ -1120,66 +999,83 @@ void WalRedoCreateRel(RelFileNode relFileNode, ForkNumber forkNumber) {
     memcpy(&requestBuffer[1+4+1+4+4], &relFileNode.relNode, 4);
 
     targetMsgLen = 1+4+1+4+4+4;
-    sendLen = 0;
 #ifdef ENABLE_DEBUG_INFO
     printf("%s send M request to standalone PG process\n", __func__ );
     fflush(stdout);
 #endif
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[replayPid][1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
     // ------- Read target response from replay process ------
-    int recvLen = 0;
     int nblocks = 0;
-    while (recvLen < sizeof(int)) {
-        char* tempP = &nblocks;
-        int readLen = read(computePipe[replayPid][0], &(tempP[recvLen]), sizeof(int) - recvLen);
-        if (readLen < 0) {
-            if (errno == EAGAIN) {
-                continue;
-            }
-            else {
-                printf("Error on read\n");
-                exit(1);
-            }
-        }
-        Assert(readLen >= 0);
-        recvLen += readLen;
-    }
+    int recvLen = RedoResponseRead(replayPid, &nblocks, sizeof(int));
 
     Assert(recvLen == sizeof(int));
 #ifdef ENABLE_DEBUG_INFO
     printf("%s, get page number = %d\n", __func__ , nblocks);
     fflush(stdout);
 #endif
-    pthread_mutex_unlock(&(replayProcessMutex[replayPid]));
+    WalRedoPoolRelease(replayPid);
 
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    SyncGetRelSizeTime += ((end.tv_sec*1000000+end.tv_usec) - (start.tv_sec*1000000+start.tv_usec));
-    SyncGetRelSizeCount++;
+    return;
+}
 
-    struct timeval now;
 
-    if(!initialized3){
-        gettimeofday(&output_timing3, NULL);
-        initialized3 = 1;
-    }
-    gettimeofday(&now, NULL);
-    if(now.tv_sec-output_timing3.tv_sec >= 5) {
 
-        printf("walredo_SyncGetRelSize = %ld, count = %d\n",SyncGetRelSizeTime, SyncGetRelSizeCount);
-        fflush(stdout);
-        output_timing3 = now;
+
+/*
+ * Ask replayPid to continue the replay from the version of the page it kept,
+ * lsnList[cachedIndex], with a 'K' request. Returns false if the process no
+ * longer had it and the full request has to be sent.
+ */
+static bool
+ApplyLsnListCached(int replayPid, const BufferTag *tag, XLogRecPtr* lsnList, int listSize, int cachedIndex,
+                   char* targetPage) {
+    XLogRecPtr *tail = &lsnList[cachedIndex + 1];
+    int tailSize = listSize - cachedIndex - 1;
+    int32 msgLen = 4 + sizeof(unsigned char) + 4*4 + 8 + 4 + 8*tailSize; // see tcop/wal_redo_cache.h
+#ifdef XLOG_IN_ROCKSDB
+    XLogRecord **records;
+    msgLen += FetchXlogRecords(tail, tailSize, &records);
+#endif
+    char *requestBuffer = RedoRequestBuffer(1 + msgLen);
+    char *cursor = requestBuffer;
+    uint32 fields[5] = {
+            pg_hton32(msgLen), pg_hton32(tag->rnode.spcNode), pg_hton32(tag->rnode.dbNode),
+            pg_hton32(tag->rnode.relNode), pg_hton32(tag->blockNum)
+    };
+    uint64_t netLsn = pg_hton64(lsnList[cachedIndex]);
+    uint32 netTailSize = pg_hton32(tailSize);
+    int found = 0;
+
+    *cursor++ = 'K';
+    memcpy(cursor, &fields[0], 4);
+    cursor += 4;
+    *cursor++ = (unsigned char) tag->forkNum;
+    memcpy(cursor, &fields[1], 4*4);
+    cursor += 4*4;
+    memcpy(cursor, &netLsn, 8);
+    cursor += 8;
+    memcpy(cursor, &netTailSize, 4);
+    cursor += 4;
+    for(int i = 0; i < tailSize; i++) {
+        netLsn = pg_hton64(tail[i]);
+        memcpy(cursor, &netLsn, 8);
+        cursor += 8;
     }
+#ifdef XLOG_IN_ROCKSDB
+    cursor = AppendXlogRecords(cursor, records, tailSize);
 #endif
-    return;
-}
-
+    Assert(cursor - requestBuffer == 1 + msgLen);
 
+    RedoRequestSend(replayPid, requestBuffer, 1 + msgLen);
+    RedoRequestBufferDone();
 
+    RedoResponseRead(replayPid, &found, sizeof(int));
+    if(found)
+        RedoResponseRead(replayPid, targetPage, BLCKSZ);
+    WalRedoCacheContinued(replayPid, tag, found);
+    return found;
+}
 
 // targetPage should be allocated by caller function
 // This function can be optimized by passing []lsn to PgStandalone and get several pages from PgStandalone
@@ -1188,24 +1084,28 @@ void ApplyLsnList(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber bl
     printf("%s %d\n", __func__ , __LINE__);
     fflush(stdout);
 #endif
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
-    int tid = gettid();
-    int replayPid = tid%REPLAY_PROCESS_NUM;
-    int gotLock = 0;
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        if(pthread_mutex_trylock( &(replayProcessMutex[ (replayPid+i)%REPLAY_PROCESS_NUM ]) ) == 0) { // Lock successfully
-            gotLock = 1;
-            replayPid = (replayPid+i) % REPLAY_PROCESS_NUM;
-            break;
-        }
+    if(WalRedoLocalEnabled()) {
+        int localDone = ApplyLsnListLocally(relFileNode, forkNumber, blockNumber, lsnList, listSize, origPage, targetPage);
+
+        if(localDone == listSize)
+            return;
+        lsnList += localDone;
+        listSize -= localDone;
+        origPage = targetPage;
     }
 
-    // if we didn't get lock with trylock(), then use block wait lock
-    if(gotLock == 0) {
-        pthread_mutex_lock(&(replayProcessMutex[replayPid]));
+    uint64 redoStart = StageTimingStart();
+    int replayPid = AcquireReplayProcess(relFileNode, forkNumber, blockNumber);
+
+    BufferTag cacheTag;
+    INIT_BUFFERTAG(cacheTag, relFileNode, forkNumber, blockNumber);
+    int cachedIndex = WalRedoCacheFind(replayPid, &cacheTag, lsnList, listSize);
+    if(cachedIndex >= 0 &&
+       ApplyLsnListCached(replayPid, &cacheTag, lsnList, listSize, cachedIndex, targetPage)) {
+        WalRedoCacheNote(replayPid, &cacheTag, lsnList[listSize - 1]);
+        WalRedoPoolRelease(replayPid);
+        StageTimingEnd(STAGE_REDO, redoStart);
+        return;
     }
 
 
@@ -1218,17 +1118,16 @@ void ApplyLsnList(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber bl
 #endif
 
 #ifdef XLOG_IN_ROCKSDB
-    // Read XlogRecord from RocksDB
-    XLogRecord *record;
-    size_t record_size;
-    GetXlogWithLsn(lsn, &record, &record_size);
+    // Read the XlogRecords of the whole list from RocksDB
+    XLogRecord **records;
+    size_t recordsLen = FetchXlogRecords(lsnList, listSize, &records);
 #endif
 
     // ------ Send "ApplyOneLsn" request to replay process ------
 #ifdef XLOG_IN_ROCKSDB
-    char *requestBuffer = (char*) malloc(8192+1024+record->xl_tot_len);
+    char *requestBuffer = RedoRequestBuffer(8192+1024+listSize*sizeof(uint64_t)+recordsLen);
 #else
-    char *requestBuffer = (char*) malloc(8192+1024+listSize*sizeof(uint64_t));
+    char *requestBuffer = RedoRequestBuffer(8192+1024+listSize*sizeof(uint64_t));
 #endif
     int32 msgLen = 0;
 
@@ -1244,7 +1143,7 @@ void ApplyLsnList(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber bl
     msgLen += 8*listSize; // $lsnList
     msgLen += BLCKSZ; // $pageContent
 #ifdef XLOG_IN_ROCKSDB
-    msgLen += record->xl_tot_len; // record, wal_redo will get its length by its header
+    msgLen += recordsLen; // records, wal_redo gets each one's length from its header
 #endif
     int origMsgLen = msgLen;
     msgLen = pg_hton32(msgLen);
@@ -1308,7 +1207,7 @@ void ApplyLsnList(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber bl
     fflush(stdout);
 #endif
 #ifdef XLOG_IN_ROCKSDB
-    memcpy(&requestBuffer[1+4+1+4+4+4+4+8+BLCKSZ], record, record->xl_tot_len);
+    AppendXlogRecords(&requestBuffer[currLen+BLCKSZ], records, origListSize);
 #endif
 
 
@@ -1318,38 +1217,13 @@ void ApplyLsnList(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber bl
 #endif
 
 
-#ifdef XLOG_IN_ROCKSDB
-    int targetMsgLen = 1+4+1+4+4+4+4+8+BLCKSZ+record->xl_tot_len;
-#else
     int targetMsgLen = 1+origMsgLen;
-#endif
-    int sendLen = 0;
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[replayPid][1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
-#ifdef XLOG_IN_ROCKSDB
-    free(record);
-#endif
-    free(requestBuffer);
+    RedoRequestBufferDone();
 
     // ------- Read target page from replay process ------
-    int recvLen = 0;
-    while (recvLen < BLCKSZ) {
-        int readLen = read(computePipe[replayPid][0], &targetPage[recvLen], BLCKSZ - recvLen);
-        if (readLen < 0) {
-            if (errno == EAGAIN) {
-                continue;
-            }
-            else {
-                printf("Error on read\n");
-                exit(1);
-            }
-        }
-        Assert(readLen >= 0);
-        recvLen += readLen;
-    }
+    int recvLen = RedoResponseRead(replayPid, targetPage, BLCKSZ);
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s read %d from standalone \n", __func__ , recvLen);
@@ -1357,29 +1231,132 @@ void ApplyLsnList(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber bl
 #endif
 
     Assert(recvLen == BLCKSZ);
-    pthread_mutex_unlock(&(replayProcessMutex[replayPid]));
+    WalRedoCacheNote(replayPid, &cacheTag, origListSize > 0 ? lsnList[origListSize - 1] : InvalidXLogRecPtr);
+    WalRedoPoolRelease(replayPid);
+    StageTimingEnd(STAGE_REDO, redoStart);
 }
 
-void GetBasePage(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blockNumber, char* buffer) {
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
+/*
+ * Replay several pages with one 'N' request per REPLAY_BATCH_MAX_PAGES pages,
+ * so a batch pays for a single redo process round trip. The whole batch goes
+ * to the process the first page has affinity to.
+ */
+void ApplyLsnListBatch(ReplayBatchEntry *entries, int num) {
+    // Pages whose replay can finish in this thread drop out of the batch
+    ReplayBatchEntry *pending = (ReplayBatchEntry*) malloc(sizeof(ReplayBatchEntry) * num);
+    int pendingNum = 0;
+    for(int i = 0; i < num; i++) {
+        ReplayBatchEntry entry = entries[i];
+        int localDone = ApplyLsnListLocally(entry.rnode, entry.forkNum, entry.blkNum, entry.lsnList,
+                                            entry.listSize, entry.basePage, entry.targetPage);
+
+        if(localDone == entry.listSize)
+            continue;
+        if(WalRedoLocalEnabled())
+            entry.basePage = entry.targetPage;
+        entry.lsnList += localDone;
+        entry.listSize -= localDone;
+        pending[pendingNum++] = entry;
+    }
+
+    for(int start = 0; start < pendingNum; start += REPLAY_BATCH_MAX_PAGES) {
+        ReplayBatchEntry *batch = &pending[start];
+        int batchSize = Min(pendingNum - start, REPLAY_BATCH_MAX_PAGES);
+
+        int32 msgLen = 4; // $msgLen itself
+        msgLen += 4; // $pageNum
+        for(int i = 0; i < batchSize; i++) {
+            msgLen += sizeof(unsigned char) + 4*5; // forknum, spc, db, rel, blknum, listSize
+            msgLen += 8*batch[i].listSize + BLCKSZ;
+        }
+#ifdef XLOG_IN_ROCKSDB
+        // Every page's records, read from RocksDB in one go
+        int lsnNum = 0;
+        for(int i = 0; i < batchSize; i++)
+            lsnNum += batch[i].listSize;
+        XLogRecPtr *batchLsns = (XLogRecPtr*) malloc(sizeof(XLogRecPtr) * lsnNum);
+        lsnNum = 0;
+        for(int i = 0; i < batchSize; i++)
+            for(int j = 0; j < batch[i].listSize; j++)
+                batchLsns[lsnNum++] = batch[i].lsnList[j];
+        XLogRecord **records;
+        msgLen += FetchXlogRecords(batchLsns, lsnNum, &records);
+        free(batchLsns);
+        XLogRecord **pageRecords = records;
+#endif
+
+        char *requestBuffer = RedoRequestBuffer(1 + msgLen);
+        char *cursor = requestBuffer;
+        uint32 netInt;
+
+        *cursor++ = 'N';
+        netInt = pg_hton32(msgLen);
+        memcpy(cursor, &netInt, 4);
+        cursor += 4;
+        netInt = pg_hton32(batchSize);
+        memcpy(cursor, &netInt, 4);
+        cursor += 4;
+        for(int i = 0; i < batchSize; i++) {
+            uint32 fields[5] = {
+                    pg_hton32(batch[i].rnode.spcNode), pg_hton32(batch[i].rnode.dbNode),
+                    pg_hton32(batch[i].rnode.relNode), pg_hton32(batch[i].blkNum),
+                    pg_hton32(batch[i].listSize)
+            };
+
+            *cursor++ = (unsigned char) batch[i].forkNum;
+            memcpy(cursor, fields, sizeof(fields));
+            cursor += sizeof(fields);
+            for(int j = 0; j < batch[i].listSize; j++) {
+                uint64_t netLsn = pg_hton64(batch[i].lsnList[j]);
+                memcpy(cursor, &netLsn, 8);
+                cursor += 8;
+            }
+            memcpy(cursor, batch[i].basePage, BLCKSZ);
+            cursor += BLCKSZ;
+#ifdef XLOG_IN_ROCKSDB
+            for(int j = 0; j < batch[i].listSize; j++) {
+                memcpy(cursor, pageRecords[j], pageRecords[j]->xl_tot_len);
+                cursor += pageRecords[j]->xl_tot_len;
+                free(pageRecords[j]);
+            }
+            pageRecords += batch[i].listSize;
 #endif
-    int tid = gettid();
-    int replayPid = tid%REPLAY_PROCESS_NUM;
-    int gotLock = 0;
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        if(pthread_mutex_trylock( &(replayProcessMutex[ (replayPid+i)%REPLAY_PROCESS_NUM ]) ) == 0) { // Lock successfully
-            gotLock = 1;
-            replayPid = (replayPid+i) % REPLAY_PROCESS_NUM;
-            break;
         }
-    }
+#ifdef XLOG_IN_ROCKSDB
+        free(records);
+#endif
+        Assert(cursor - requestBuffer == 1 + msgLen);
+
+        uint64 redoStart = StageTimingStart();
+        int replayPid = AcquireReplayProcess(batch[0].rnode, batch[0].forkNum, batch[0].blkNum);
+        RedoRequestSend(replayPid, requestBuffer, 1 + msgLen);
+        RedoRequestBufferDone();
+
+        // ------- Read the pages back, in request order ------
+        for(int i = 0; i < batchSize; i++) {
+            int recvLen = RedoResponseRead(replayPid, batch[i].targetPage, BLCKSZ);
+
+            Assert(recvLen == BLCKSZ);
+            if(batch[i].listSize > 0) {
+                BufferTag cacheTag;
 
-    // if we didn't get lock with trylock(), then use block wait lock
-    if(gotLock == 0) {
-        pthread_mutex_lock(&(replayProcessMutex[replayPid]));
+                INIT_BUFFERTAG(cacheTag, batch[i].rnode, batch[i].forkNum, batch[i].blkNum);
+                WalRedoCacheNote(replayPid, &cacheTag, batch[i].lsnList[batch[i].listSize - 1]);
+            }
+        }
+        WalRedoPoolRelease(replayPid);
+        StageTimingEnd(STAGE_REDO, redoStart);
     }
+    free(pending);
+}
+
+void GetBasePage(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blockNumber, char* buffer) {
+    // Never versioned, the relation file has it as it is
+    if (BasePageReaderRead(relFileNode, forkNumber, blockNumber, buffer))
+        return;
+
+    uint64 redoStart = StageTimingStart();
+    int replayPid = AcquireReplayProcess(relFileNode, forkNumber, blockNumber);
 
 
 //    pthread_mutex_lock(&replayProcessMutex);
@@ -1410,75 +1387,21 @@ void GetBasePage(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blo
     memcpy(&requestBuffer[1+4+1+4+4+4], &blockNumber, 4);
 
     int targetMsgLen = 1+4+1+4+4+4+4;
-    int sendLen = 0;
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[replayPid][1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
 
 
     // ------- Read target page from replay process ------
-    int recvLen = 0;
-    while (recvLen < BLCKSZ) {
-        int readLen = read(computePipe[replayPid][0], &buffer[recvLen], BLCKSZ - recvLen);
-        if (readLen < 0) {
-            if (errno == EAGAIN) {
-                continue;
-            }
-            else {
-                printf("Error on read\n");
-                exit(1);
-            }
-        }
-        Assert(readLen >= 0);
-        recvLen += readLen;
-    }
+    int recvLen = RedoResponseRead(replayPid, buffer, BLCKSZ);
 
     Assert(recvLen == BLCKSZ);
-    pthread_mutex_unlock(&(replayProcessMutex[replayPid]));
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    GetBasePageTime += ((end.tv_sec*1000000+end.tv_usec) - (start.tv_sec*1000000+start.tv_usec));
-    GetBasePageCount++;
-
-    struct timeval now;
-
-    if(!initialized3){
-        gettimeofday(&output_timing3, NULL);
-        initialized3 = 1;
-    }
-    gettimeofday(&now, NULL);
-    if(now.tv_sec-output_timing3.tv_sec >= 5) {
-
-        //printf("walredo_wait_time = %ld\n",walRedoWaitLockTime);
-        printf("walredo_getBasePage = %ld, count = %d\n",GetBasePageTime, GetBasePageCount);
-        fflush(stdout);
-        output_timing3 = now;
-    }
-#endif
+    WalRedoPoolRelease(replayPid);
+    StageTimingEnd(STAGE_REDO, redoStart);
 }
 
 void GetPageByLsn(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blockNumber, XLogRecPtr lsn, char* buffer) {
-#ifdef DEBUG_TIMING
-    struct timeval start, end;
-    gettimeofday(&start, NULL);
-#endif
-    int tid = gettid();
-    int replayPid = tid%REPLAY_PROCESS_NUM;
-    int gotLock = 0;
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        if(pthread_mutex_trylock( &(replayProcessMutex[ (replayPid+i)%REPLAY_PROCESS_NUM ]) ) == 0) { // Lock successfully
-            gotLock = 1;
-            replayPid = (replayPid+i) % REPLAY_PROCESS_NUM;
-            break;
-        }
-    }
-
-    // if we didn't get lock with trylock(), then use block wait lock
-    if(gotLock == 0) {
-        pthread_mutex_lock(&(replayProcessMutex[replayPid]));
-    }
+    uint64 redoStart = StageTimingStart();
+    int replayPid = AcquireReplayProcess(relFileNode, forkNumber, blockNumber);
 
 
 
@@ -1508,14 +1431,9 @@ void GetPageByLsn(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber bl
     memcpy(&requestBuffer[1+sizeof(msgLen)], &lsn, sizeof(lsn));
 
 
-    int targetMsgLen = 1+4+sizeof(lsn);
+    int targetMsgLen = AppendReplayBudget(requestBuffer, 1+4+sizeof(lsn));
 
-    int sendLen = 0;
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[replayPid][1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
 
     // ------- Send "GetPage" request to replay process ------
@@ -1543,73 +1461,21 @@ void GetPageByLsn(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber bl
     memcpy(&requestBuffer[1+4+1+4+4+4], &blockNumber, 4);
 
     targetMsgLen = 1+4+1+4+4+4+4;
-    sendLen = 0;
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[replayPid][1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
 
 
     // ------- Read target page from replay process ------
-    int recvLen = 0;
-    while (recvLen < BLCKSZ) {
-        int readLen = read(computePipe[replayPid][0], &buffer[recvLen], BLCKSZ - recvLen);
-        if (readLen < 0) {
-            if (errno == EAGAIN) {
-                continue;
-            }
-            else {
-                printf("Error on read\n");
-                exit(1);
-            }
-        }
-        Assert(readLen >= 0);
-        recvLen += readLen;
-    }
+    int recvLen = RedoResponseRead(replayPid, buffer, BLCKSZ);
 
     Assert(recvLen == BLCKSZ);
-    pthread_mutex_unlock(&(replayProcessMutex[replayPid]));
-
-#ifdef DEBUG_TIMING
-    gettimeofday(&end, NULL);
-    GetBasePageTime += ((end.tv_sec*1000000+end.tv_usec) - (start.tv_sec*1000000+start.tv_usec));
-    GetBasePageCount++;
+    WalRedoPoolRelease(replayPid);
+    StageTimingEnd(STAGE_REDO, redoStart);
 
-    struct timeval now;
-
-    if(!initialized3){
-        gettimeofday(&output_timing3, NULL);
-        initialized3 = 1;
-    }
-    gettimeofday(&now, NULL);
-    if(now.tv_sec-output_timing3.tv_sec >= 5) {
-
-        //printf("walredo_wait_time = %ld\n",walRedoWaitLockTime);
-        printf("walredo_getPageByLsn = %ld, count = %d\n",GetBasePageTime, GetBasePageCount);
-
-        fflush(stdout);
-        output_timing3 = now;
-    }
-#endif
 }
 
 void SyncReplayProcess() {
-    int tid = gettid();
-    int replayPid = tid%REPLAY_PROCESS_NUM;
-    int gotLock = 0;
-    for(int i = 0; i < REPLAY_PROCESS_NUM; i++) {
-        if(pthread_mutex_trylock( &(replayProcessMutex[ (replayPid+i)%REPLAY_PROCESS_NUM ]) ) == 0) { // Lock successfully
-            gotLock = 1;
-            replayPid = (replayPid+i) % REPLAY_PROCESS_NUM;
-            break;
-        }
-    }
-
-    // if we didn't get lock with trylock(), then use block wait lock
-    if(gotLock == 0) {
-        pthread_mutex_lock(&(replayProcessMutex[replayPid]));
-    }
+    int replayPid = WalRedoPoolAcquire();
 
     // ------- Send "ApplyRecordUntil" request to replay process ------
     XLogRecPtr lsn = 0;
@@ -1634,13 +1500,9 @@ void SyncReplayProcess() {
     memcpy(&requestBuffer[1], &msgLen, sizeof(msgLen));
     memcpy(&requestBuffer[1+sizeof(msgLen)], &lsn, sizeof(lsn));
 
-    int targetMsgLen = 1+4+sizeof(lsn);
+    int targetMsgLen = AppendReplayBudget(requestBuffer, 1+4+sizeof(lsn));
 
-    int sendLen = 0;
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
     // -------- Send "SyncLsnReplay" request to replay process ---------
     requestBuffer[0] = 'S'; // Request function "SyncLsnReplay"
@@ -1655,34 +1517,12 @@ void SyncReplayProcess() {
 
     targetMsgLen = 1+4+sizeof(lsn);
 
-    sendLen = 0;
-    while(sendLen < targetMsgLen) {
-        int writeLen = write(serverPipe[1], &requestBuffer[sendLen], targetMsgLen-sendLen);
-        sendLen+=writeLen;
-    }
+    RedoRequestSend(replayPid, requestBuffer, targetMsgLen);
 
 
     // --------- Receive "ok" flag from replay process ----------
     char buffer[8];
-    int recvLen = 0;
-    while (recvLen < 2) {
-#ifdef ENABLE_DEBUG_INFO
-        printf("%s Start reading\n", __func__ );
-        fflush(stdout);
-#endif
-        int readLen = read(computePipe[0], &buffer[recvLen], 2 - recvLen);
-        if (readLen < 0) {
-            if (errno == EAGAIN) {
-                continue;
-            }
-            else {
-                printf("Error on read\n");
-                exit(1);
-            }
-        }
-        Assert(readLen >= 0);
-        recvLen += readLen;
-    }
+    int recvLen = RedoResponseRead(replayPid, buffer, 2);
 
     if(recvLen != 2) {
         printf("%s, Error reply, expected len 2, received len %d\n", __func__ , recvLen);
@@ -1690,12 +1530,21 @@ void SyncReplayProcess() {
     }
 
 
-    pthread_mutex_unlock(&(replayProcessMutex[replayPid]));
+    WalRedoPoolRelease(replayPid);
 }
 
 pthread_t XlogStartupTid2 = 0;
-void BackgroundHashMapCleanPageVersion() {
-    BackgroundHashMapCleanRocksdb(pageVersionHashMap);
+void *BackgroundHashMapCleanPageVersion(void *arg) {
+    CpuRoleBind(CPU_ROLE_REPLAY, -1);
+    BackgroundHashMapCleanRocksdb(pageVersionHashMap, (int) (intptr_t) arg);
+    return NULL;
+}
+
+// The WAL parse, on the CPUs of storage/cpu_roles.h kept for it
+static void *StartupXLOGThread(void *arg) {
+    CpuRoleBind(CPU_ROLE_PARSE, -1);
+    StartupXLOG();
+    return NULL;
 }
 #include <sys/time.h>
 extern XLogRecPtr XLogParseUpto;
@@ -1719,14 +1568,22 @@ RpcServerMain(int argc, char *argv[],
     printf("%s start, pid = %d\n", __func__ , getpid());
     fflush(stdout);
 #endif
+    // Before any thread starts, they inherit the mask
+    CpuRolesInit();
+
     HashMapInit(&pageVersionHashMap, 1023);
     RelSizePthreadLockInit();
 
-    for(int i = 0; i < 5; i++) {
+    // All of them are started, the ones above the active limit stay parked
+    for(int i = 0; i < BACKGROUND_REPLAYER_MAX_THREADS; i++) {
         printf("%s start background replayer %d\n", __func__ , i);
         pthread_t tempTid;
-        pthread_create(&tempTid, NULL, (void*) BackgroundHashMapCleanPageVersion, NULL);
+        pthread_create(&tempTid, NULL, BackgroundHashMapCleanPageVersion, (void *) (intptr_t) i);
     }
+    HashMapStartSpiller(pageVersionHashMap);
+    HashMapStartGcSweeper(pageVersionHashMap);
+    LogindexTombstoneStart(pageVersionHashMap);
+    LogindexGcQueueStart(pageVersionHashMap);
 #ifdef ENABLE_DEBUG_INFO
     printf("%s HashMapAddress = %p\n", __func__ , pageVersionHashMap);
     fflush(stdout);
@@ -1765,6 +1622,7 @@ RpcServerMain(int argc, char *argv[],
     pqsignal_pm(SIGTERM, proc_die);	/* wait for children and shut down */
 
     pqsignal_pm(SIGUSR1, sigusr1_handler);	/* message from child process */
+    pqsignal_pm(SIGHUP, SignalHandlerForConfigReload);	/* reloaded by the ASR controller */
 
     InitializeGUCOptions();
 
@@ -1798,7 +1656,7 @@ RpcServerMain(int argc, char *argv[],
     InitAuxiliaryProcess();
 
 //    StartupPid = StartChildProcess(StartupProcess);
-    pthread_create(&XlogStartupTid2, NULL, (void*)StartupXLOG, NULL);
+    pthread_create(&XlogStartupTid2, NULL, StartupXLOGThread, NULL);
 //    pthread_t tempTid;
 //    pthread_create(&tempTid, NULL, (void*)RecordReplayProgress, NULL);
 //    pthread_create(&XlogStartupTid2, NULL, (void*)StartupProcessMain, NULL);
@@ -1809,6 +1667,9 @@ RpcServerMain(int argc, char *argv[],
 
     /* Start Adaptive Smart Replay controller thread */
     ASR_StartController();
+    MemGovernorStart();
+    SmartReplayMetricsStartServer();
+    WalRetentionStart();
 
     /*************************BaseInit**********************************/
     //Here is the content of BaseInit(). We move the CreateSharedMemoryAndSemaphores to ahead
@@ -1916,7 +1777,7 @@ RpcServerMain_(int argc, char *argv[],
     pgstat_bestart();
     SetProcessingMode(NormalProcessing);
 
-    pthread_create(&XlogStartupTid, NULL, (void*)StartupXLOG, NULL);
+    pthread_create(&XlogStartupTid, NULL, StartupXLOGThread, NULL);
 
     RpcServerLoop();
     proc_exit(0);
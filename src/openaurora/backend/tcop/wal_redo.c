@@ -82,6 +82,7 @@
 #include "libpq/libpq.h"
 #include "libpq/pqformat.h"
 #include "miscadmin.h"
+#include "pg_trace.h"
 #include "postmaster/postmaster.h"
 #include "storage/buf_internals.h"
 #include "storage/bufmgr.h"
@@ -91,6 +92,8 @@
 #include "storage/adaptive_sr.h"
 #include "tcop/tcopprot.h"
 #include "tcop/storage_server.h"
+#include "tcop/wal_redo_channel.h"
+#include "tcop/wal_redo_cache.h"
 #include "utils/memutils.h"
 #include "utils/ps_status.h"
 #include "replication/walreceiver.h"
@@ -112,11 +115,22 @@ static void ApplyOneXlog(StringInfo input_message);
 static void ApplyOneXlogWithoutBasePage(StringInfo input_message);
 static void ApplyLsnListXlog(StringInfo input_message);
 static void ApplyLsnListXlogWithoutBasePage(StringInfo input_message);
+static void ApplyLsnListBatchXlog(StringInfo input_message);
+static void ApplyLsnListCachedXlog(StringInfo input_message);
+static void ReplayLsnListOnPage(StringInfo input_message, RelFileNode rnode, ForkNumber forknum, BlockNumber blknum,
+                                const char *content, uint64_t *lsnList, int listSize, XLogRecPtr resultLsn);
+#ifdef XLOG_IN_ROCKSDB
+static XLogRecord *ReadInlineRecord(StringInfo input_message, XLogRecPtr lsn);
+#endif
 static void ExtendRel(StringInfo input_message);
+static void ExtendRelMany(StringInfo input_message);
 static void CreateRel(StringInfo input_message);
 
 static BufferTag target_redo_tag;
 
+/* Trace ID of the next request, set by a 'T' message before it */
+static uint64 redo_trace_id = 0;
+
 
 /*
  * Buffer with target WAL redo page.
@@ -127,8 +141,6 @@ static BufferTag target_redo_tag;
 Buffer		wal_redo_buffer;
 bool		am_wal_redo_postgres = false;
 
-extern int** serverPipe;
-extern int** computePipe;
 
 extern int ReplayProcessNum;
 
@@ -136,6 +148,10 @@ extern int IsRpcServer;
 
 static XLogReaderState *reader_state;
 
+/* Records ApplyXlogUntil() reads at a time */
+#define REDO_RECORD_BATCH 256
+static XLogRecordBatch *redo_batch;
+
 extern bool doRequestWalReceiverReply;
 
 //#define ENABLE_DEBUG_INFO
@@ -156,6 +172,9 @@ enter_seccomp_mode(void)
 		PG_SCMP_ALLOW(read),
 		PG_SCMP_ALLOW(select),
 		PG_SCMP_ALLOW(write),
+		/* wal_redo_channel.c sleeps on futexes and watches its parent */
+		PG_SCMP_ALLOW(futex),
+		PG_SCMP_ALLOW(getppid),
 
 		/* Memory allocation */
 		PG_SCMP_ALLOW(brk),
@@ -381,6 +400,8 @@ WalRedoMain(int argc, char *argv[],
     reader_state = XLogReaderAllocate(wal_segment_size, NULL, XL_ROUTINE(.page_read = &XLogPageRead,
                                                                          .segment_open = NULL,
                                                                          .segment_close = wal_segment_close), &private);
+    XLogReaderSetReadahead(reader_state, wal_readahead_size);
+    redo_batch = XLogRecordBatchAllocate(REDO_RECORD_BATCH);
     XLogBeginRead(reader_state, InvalidXLogRecPtr);
 #ifdef HAVE_LIBSECCOMP
     /* We prefer opt-out to opt-in for greater security */
@@ -419,6 +440,13 @@ WalRedoMain(int argc, char *argv[],
         printf("%s %d %d start \n", __func__ , __LINE__, ReplayProcessNum);
         fflush(stdout);
 #endif
+        if (firstchar == 'T')	/* TraceContext of the next request */
+        {
+            redo_trace_id = (uint64) pq_getmsgint64(&input_message);
+            continue;
+        }
+        TRACE_POSTGRESQL_STORAGE_REDO_START(redo_trace_id, firstchar);
+
         switch (firstchar)
         {
             case 'E':
@@ -433,6 +461,14 @@ WalRedoMain(int argc, char *argv[],
                 ApplyLsnListXlogWithoutBasePage(&input_message);
                 break;
 
+            case 'N':           /* ApplyLsnList for several pages */
+                ApplyLsnListBatchXlog(&input_message);
+                break;
+
+            case 'K':           /* ApplyLsnList on a cached version */
+                ApplyLsnListCachedXlog(&input_message);
+                break;
+
             case 'D':
                 ApplyOneXlog(&input_message);
                 break;
@@ -473,6 +509,10 @@ WalRedoMain(int argc, char *argv[],
                 ExtendRel(&input_message);
                 break;
 
+            case 'Z':           /* Extend by zero pages */
+                ExtendRelMany(&input_message);
+                break;
+
                 /*
                  * EOF means we're done. Perform normal shutdown.
                  */
@@ -505,6 +545,9 @@ WalRedoMain(int argc, char *argv[],
                                 errmsg("invalid frontend message type %d",
                                        firstchar)));
         }
+
+        TRACE_POSTGRESQL_STORAGE_REDO_DONE(redo_trace_id, firstchar);
+        redo_trace_id = 0;
     }							/* end of input-reading loop */
 }
 
@@ -631,21 +674,7 @@ SyncLsnReplay(StringInfo input_message) {
     lsn = pq_getmsgint64(input_message);
 
     char resp[16] = "ok\0";
-    int tot_written = 0;
-    do {
-        ssize_t		rc;
-
-        rc = write(computePipe[ReplayProcessNum][1], &resp[tot_written], 2 - tot_written);
-        if (rc < 0) {
-            /* If interrupted by signal, just retry */
-            if (errno == EINTR)
-                continue;
-            ereport(ERROR,
-                    (errcode_for_file_access(),
-                            errmsg("could not write to stdout: %m")));
-        }
-        tot_written += rc;
-    } while (tot_written < 2);
+    int tot_written = WalRedoRingWrite(&walRedoChannels[ReplayProcessNum].response, resp, 2);
 #ifdef ENABLE_DEBUG_INFO
     printf("%s %d %d sent OK to RpcServer\n", __func__ , __LINE__, ReplayProcessNum);
     fflush(stdout);
@@ -659,6 +688,7 @@ ApplyXlogUntil(StringInfo input_message) {
      * message format:
      *
      * LSN
+     * Replay budget (int32, only when ASR is on in the storage server)
      */
 
 #ifdef ENABLE_DEBUG_INFO
@@ -702,15 +732,26 @@ ApplyXlogUntil(StringInfo input_message) {
      * This prevents excessive CPU usage during light load and ensures responsive
      * degradation under heavy write load.
      */
-    int replay_budget = ASR_GetCurrentBudget();	/* Dynamic budget from controller */
+    int replay_budget;
+    if (input_message->cursor < input_message->len)
+        replay_budget = (int) pq_getmsgint(input_message, 4);	/* Dynamic budget from controller */
+    else
+        replay_budget = ASR_GetCurrentBudget();
     int records_replayed = 0;
+    int batched = 0;
+    int next = 0;
     
     while(reader_state->EndRecPtr < lsn) {
 #ifdef ENABLE_DEBUG_INFO
         printf("%s %d %d readRecPtr = %ld, pid=%d\n", __func__ , __LINE__, ReplayProcessNum, reader_state->EndRecPtr, getpid());
         fflush(stdout);
 #endif
-        record = XLogReadRecord(reader_state, &err_msg);
+        // Read the records up to lsn a batch at a time, most not copied
+        if(next == batched) {
+            batched = XLogReadRecordBatch(reader_state, redo_batch, lsn, &err_msg);
+            next = 0;
+        }
+        record = next < batched ? XLogRecordBatchDecode(reader_state, redo_batch, next++, &err_msg) : NULL;
 
         //! todo, is it correct to use WALRcv.flushUpTo
         if(record == NULL)
@@ -894,22 +935,46 @@ ExtendRel(StringInfo input_message)
 
     /* Response: 1 */
     int responce = 1;
-    int tot_written = 0;
-    do {
-        ssize_t		rc;
-
-        char * tempP = (char*) &responce;
-        rc = write(computePipe[ReplayProcessNum][1], &(tempP[tot_written]), sizeof(int) - tot_written);
-        if (rc < 0) {
-            /* If interrupted by signal, just retry */
-            if (errno == EINTR)
-                continue;
-            ereport(ERROR,
-                    (errcode_for_file_access(),
-                            errmsg("could not write to stdout: %m")));
-        }
-        tot_written += rc;
-    } while (tot_written < sizeof(int));
+    int tot_written = WalRedoRingWrite(&walRedoChannels[ReplayProcessNum].response, &responce, sizeof(int));
+
+#ifdef ENABLE_DEBUG_INFO
+    printf("%s write %d bytes to RPC_SERVER\n", __func__ , tot_written);
+    fflush(stdout);
+#endif
+}
+
+static void
+ExtendRelMany(StringInfo input_message)
+{
+    RelFileNode rnode;
+    ForkNumber forknum;
+    BlockNumber startblk;
+    int         nblocks;
+
+    /*
+     * message format:
+     *
+     * ForkNumber
+     * spcNode
+     * dbNode
+     * relNode
+     * first BlockNumber
+     * number of zero pages
+     */
+    forknum = pq_getmsgbyte(input_message);
+    rnode.spcNode = pq_getmsgint(input_message, 4);
+    rnode.dbNode = pq_getmsgint(input_message, 4);
+    rnode.relNode = pq_getmsgint(input_message, 4);
+    startblk = pq_getmsgint(input_message, 4);
+    nblocks = pq_getmsgint(input_message, 4);
+
+    SMgrRelation smgrReln = smgropen(rnode, InvalidBackendId);
+
+    smgrzeroextend(smgrReln, forknum, startblk, nblocks, false);
+
+    /* Response: 1 */
+    int responce = 1;
+    int tot_written = WalRedoRingWrite(&walRedoChannels[ReplayProcessNum].response, &responce, sizeof(int));
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s write %d bytes to RPC_SERVER\n", __func__ , tot_written);
@@ -955,22 +1020,7 @@ CreateRel(StringInfo input_message) {
 
     /* Response: 1 */
     pageNum = 1;
-    tot_written = 0;
-    do {
-        ssize_t		rc;
-
-        char * tempP = (char*) &pageNum;
-        rc = write(computePipe[ReplayProcessNum][1], &(tempP[tot_written]), sizeof(int) - tot_written);
-        if (rc < 0) {
-            /* If interrupted by signal, just retry */
-            if (errno == EINTR)
-                continue;
-            ereport(ERROR,
-                    (errcode_for_file_access(),
-                            errmsg("could not write to stdout: %m")));
-        }
-        tot_written += rc;
-    } while (tot_written < sizeof(int));
+    tot_written = WalRedoRingWrite(&walRedoChannels[ReplayProcessNum].response, &pageNum, sizeof(int));
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s write %d bytes to RPC_SERVER\n", __func__ , tot_written);
@@ -1133,21 +1183,7 @@ ApplyOneXlogWithoutBasePage(StringInfo input_message) {
     /* single thread, so don't bother locking the page */
 
     /* Response: Page content */
-    int tot_written = 0;
-    do {
-        ssize_t		rc;
-
-        rc = write(computePipe[ReplayProcessNum][1], &page[tot_written], BLCKSZ - tot_written);
-        if (rc < 0) {
-            /* If interrupted by signal, just retry */
-            if (errno == EINTR)
-                continue;
-            ereport(ERROR,
-                    (errcode_for_file_access(),
-                            errmsg("could not write to stdout: %m")));
-        }
-        tot_written += rc;
-    } while (tot_written < BLCKSZ);
+    int tot_written = WalRedoRingWrite(&walRedoChannels[ReplayProcessNum].response, page, BLCKSZ);
 
     ReleaseBuffer(buf);
 #ifdef ENABLE_DEBUG_INFO
@@ -1316,21 +1352,7 @@ ApplyOneXlog(StringInfo input_message) {
     /* single thread, so don't bother locking the page */
 
     /* Response: Page content */
-    int tot_written = 0;
-    do {
-        ssize_t		rc;
-
-        rc = write(computePipe[ReplayProcessNum][1], &page[tot_written], BLCKSZ - tot_written);
-        if (rc < 0) {
-            /* If interrupted by signal, just retry */
-            if (errno == EINTR)
-                continue;
-            ereport(ERROR,
-                    (errcode_for_file_access(),
-                            errmsg("could not write to stdout: %m")));
-        }
-        tot_written += rc;
-    } while (tot_written < BLCKSZ);
+    int tot_written = WalRedoRingWrite(&walRedoChannels[ReplayProcessNum].response, page, BLCKSZ);
 
     ReleaseBuffer(buf);
 #ifdef ENABLE_DEBUG_INFO
@@ -1350,6 +1372,57 @@ ApplyOneXlog(StringInfo input_message) {
 }
 
 
+#ifdef XLOG_IN_ROCKSDB
+/*
+ * Decode the next of the records the storage server read from RocksDB and
+ * sent after the rest of an 'O'/'o' request, as if XLogReadRecord had read
+ * it at lsn. The record stays valid until the next call.
+ */
+static XLogRecord *
+ReadInlineRecord(StringInfo input_message, XLogRecPtr lsn) {
+    static char *recordBuffer = NULL;
+    static uint32 recordBufferSize = 0;
+    XLogRecord header;
+    XLogRecPtr pos = lsn;
+    uint32 left;
+    char *err_msg;
+
+    if (input_message->len - input_message->cursor < (int) sizeof(XLogRecord))
+        elog(ERROR, "record at %X/%X missing from message", (uint32) (lsn >> 32), (uint32) lsn);
+    memcpy(&header, input_message->data + input_message->cursor, sizeof(XLogRecord));
+    if (header.xl_tot_len < sizeof(XLogRecord))
+        elog(ERROR, "invalid record length %u at %X/%X", header.xl_tot_len, (uint32) (lsn >> 32), (uint32) lsn);
+
+    if (header.xl_tot_len > recordBufferSize) {
+        if (recordBuffer != NULL)
+            pfree(recordBuffer);
+        recordBufferSize = Max(header.xl_tot_len, BLCKSZ);
+        recordBuffer = MemoryContextAlloc(TopMemoryContext, recordBufferSize);
+    }
+    pq_copymsgbytes(input_message, recordBuffer, header.xl_tot_len);
+
+    // Redo routines stamp pages with EndRecPtr, which also counts the page
+    // headers the record spans in the WAL
+    for (left = header.xl_tot_len; left > 0; ) {
+        uint32 avail;
+
+        if (pos % XLOG_BLCKSZ == 0)
+            pos += XLogSegmentOffset(pos, reader_state->segcxt.ws_segsize) == 0 ? SizeOfXLogLongPHD : SizeOfXLogShortPHD;
+        avail = Min(left, XLOG_BLCKSZ - pos % XLOG_BLCKSZ);
+        pos += avail;
+        left -= avail;
+    }
+
+    XLogBeginRead(reader_state, lsn);
+    reader_state->ReadRecPtr = lsn;
+    reader_state->EndRecPtr = MAXALIGN64(pos);
+    reader_state->decoded_record = (XLogRecord *) recordBuffer;
+    if (!DecodeXLogRecord(reader_state, (XLogRecord *) recordBuffer, &err_msg))
+        elog(ERROR, "failed to decode WAL record: %s", err_msg);
+    return (XLogRecord *) recordBuffer;
+}
+#endif
+
 static void
 ApplyLsnListXlogWithoutBasePage(StringInfo input_message) {
 #ifdef ENABLE_DEBUG_INFO
@@ -1378,6 +1451,7 @@ ApplyLsnListXlogWithoutBasePage(StringInfo input_message) {
       * BlockNumber
       * listSize
       * lsnList
+      * with XLOG_IN_ROCKSDB, the listSize records
       */
     forknum = pq_getmsgbyte(input_message);
     rnode.spcNode = pq_getmsgint(input_message, 4);
@@ -1428,8 +1502,12 @@ ApplyLsnListXlogWithoutBasePage(StringInfo input_message) {
 
     char *err_msg;
     for(int i = 0; i < listSize; i++) {
+#ifdef XLOG_IN_ROCKSDB
+        record = ReadInlineRecord(input_message, lsnList[i]);
+#else
         XLogBeginRead(reader_state, lsnList[i]);
         record = XLogReadRecord(reader_state, &err_msg);
+#endif
 #ifdef ENABLE_DEBUG_INFO
         const char*id=NULL;
         id = RmgrTable[record->xl_rmid].rm_identify( record->xl_info );
@@ -1516,21 +1594,7 @@ ApplyLsnListXlogWithoutBasePage(StringInfo input_message) {
     /* single thread, so don't bother locking the page */
 
     /* Response: Page content */
-    int tot_written = 0;
-    do {
-        ssize_t		rc;
-
-        rc = write(computePipe[ReplayProcessNum][1], &page[tot_written], BLCKSZ - tot_written);
-        if (rc < 0) {
-            /* If interrupted by signal, just retry */
-            if (errno == EINTR)
-                continue;
-            ereport(ERROR,
-                    (errcode_for_file_access(),
-                            errmsg("could not write to stdout: %m")));
-        }
-        tot_written += rc;
-    } while (tot_written < BLCKSZ);
+    int tot_written = WalRedoRingWrite(&walRedoChannels[ReplayProcessNum].response, page, BLCKSZ);
 
     ReleaseBuffer(buf);
 #ifdef ENABLE_DEBUG_INFO
@@ -1546,66 +1610,19 @@ ApplyLsnListXlogWithoutBasePage(StringInfo input_message) {
     return;
 }
 
-static void
-ApplyLsnListXlog(StringInfo input_message) {
-#ifdef ENABLE_DEBUG_INFO
-    printf("%s %d  ReplayProcessNum = %d, start \n", __func__ , __LINE__, ReplayProcessNum);
-    fflush(stdout);
-#endif
 
-    RelFileNode rnode;
-    ForkNumber forknum;
-    BlockNumber blknum;
-    const char *content;
+/*
+ * Replay lsnList on content, the page as of before the first of them, and
+ * send the result back. The result is kept as the version at resultLsn, see
+ * tcop/wal_redo_cache.h.
+ */
+static void
+ReplayLsnListOnPage(StringInfo input_message, RelFileNode rnode, ForkNumber forknum, BlockNumber blknum,
+                    const char *content, uint64_t *lsnList, int listSize, XLogRecPtr resultLsn) {
     Buffer		buf;
     Page		page;
-    uint64_t*    lsnList;
-    unsigned int listSize;
     XLogRecord * record;
 
-
-    /*
-      * message format:
-      *
-      * ForkNumber
-      * spcNode
-      * dbNode
-      * relNode
-      * BlockNumber
-      * listSize
-      * lsnList
-      * 8k page content
-      */
-    forknum = pq_getmsgbyte(input_message);
-    rnode.spcNode = pq_getmsgint(input_message, 4);
-    rnode.dbNode = pq_getmsgint(input_message, 4);
-    rnode.relNode = pq_getmsgint(input_message, 4);
-    blknum = pq_getmsgint(input_message, 4);
-
-    listSize = pq_getmsgint(input_message, 4);
-#ifdef ENABLE_DEBUG_INFO
-    printf("%s %d, ReplayProcessNum = %d, spc = %lu, db = %lu, rel = %lu, fork = %d, blk = %lu, listSize = %d\n",
-           __func__ , __LINE__, ReplayProcessNum, rnode.spcNode, rnode.dbNode, rnode.relNode, forknum,
-           blknum, listSize);
-    fflush(stdout);
-#endif
-
-    lsnList = (uint64_t*) malloc(listSize*sizeof(uint64_t));
-    for(int i = 0; i < listSize; i++) {
-        pq_copymsgbytes(input_message, (char *) &(lsnList[i]), sizeof(uint64_t));
-        lsnList[i] = pg_ntoh64(lsnList[i]);
-    }
-
-
-    content = pq_getmsgbytes(input_message, BLCKSZ);
-
-#ifdef ENABLE_DEBUG_INFO
-    printf("%s %d, ReplayProcessNum = %d, lsn size = %d\n", __func__ , __LINE__, ReplayProcessNum, listSize);
-    for(int i = 0; i < listSize; i++) {
-        printf("lsn %d = %lu\n", i, lsnList[i]);
-    }
-    fflush(stdout);
-#endif
     // Put the original page to buffer
     buf = ReadBufferWithoutRelcache(rnode, forknum, blknum, RBM_ZERO_AND_LOCK, NULL);
     wal_redo_buffer = buf;
@@ -1624,8 +1641,12 @@ ApplyLsnListXlog(StringInfo input_message) {
 
     char *err_msg;
     for(int i = 0; i < listSize; i++) {
+#ifdef XLOG_IN_ROCKSDB
+        record = ReadInlineRecord(input_message, lsnList[i]);
+#else
         XLogBeginRead(reader_state, lsnList[i]);
         record = XLogReadRecord(reader_state, &err_msg);
+#endif
 #ifdef ENABLE_DEBUG_INFO
         const char*id=NULL;
         id = RmgrTable[record->xl_rmid].rm_identify( record->xl_info );
@@ -1691,8 +1712,6 @@ ApplyLsnListXlog(StringInfo input_message) {
         }
     }
 
-    free(lsnList);
-
     // For now, redo completed, find the page from buffer pool
     buf = ReadBufferWithoutRelcache(rnode, forknum, blknum, RBM_NORMAL, NULL);
     Assert(buf == wal_redo_buffer);
@@ -1701,21 +1720,8 @@ ApplyLsnListXlog(StringInfo input_message) {
     /* single thread, so don't bother locking the page */
 
     /* Response: Page content */
-    int tot_written = 0;
-    do {
-        ssize_t		rc;
-
-        rc = write(computePipe[ReplayProcessNum][1], &page[tot_written], BLCKSZ - tot_written);
-        if (rc < 0) {
-            /* If interrupted by signal, just retry */
-            if (errno == EINTR)
-                continue;
-            ereport(ERROR,
-                    (errcode_for_file_access(),
-                            errmsg("could not write to stdout: %m")));
-        }
-        tot_written += rc;
-    } while (tot_written < BLCKSZ);
+    int tot_written = WalRedoRingWrite(&walRedoChannels[ReplayProcessNum].response, page, BLCKSZ);
+    WalRedoCachePut(&bufferTag, resultLsn, page);
 
     ReleaseBuffer(buf);
 #ifdef ENABLE_DEBUG_INFO
@@ -1729,7 +1735,147 @@ ApplyLsnListXlog(StringInfo input_message) {
 #endif
 //    DropRelFileNodeAllLocalBuffers(rnode);
     wal_redo_buffer = InvalidBuffer;
-    return;
+}
+
+static void
+ApplyLsnListXlog(StringInfo input_message) {
+#ifdef ENABLE_DEBUG_INFO
+    printf("%s %d  ReplayProcessNum = %d, start \n", __func__ , __LINE__, ReplayProcessNum);
+    fflush(stdout);
+#endif
+
+    RelFileNode rnode;
+    ForkNumber forknum;
+    BlockNumber blknum;
+    const char *content;
+    uint64_t*    lsnList;
+    unsigned int listSize;
+
+
+    /*
+      * message format:
+      *
+      * ForkNumber
+      * spcNode
+      * dbNode
+      * relNode
+      * BlockNumber
+      * listSize
+      * lsnList
+      * 8k page content
+      * with XLOG_IN_ROCKSDB, the listSize records
+      */
+    forknum = pq_getmsgbyte(input_message);
+    rnode.spcNode = pq_getmsgint(input_message, 4);
+    rnode.dbNode = pq_getmsgint(input_message, 4);
+    rnode.relNode = pq_getmsgint(input_message, 4);
+    blknum = pq_getmsgint(input_message, 4);
+
+    listSize = pq_getmsgint(input_message, 4);
+#ifdef ENABLE_DEBUG_INFO
+    printf("%s %d, ReplayProcessNum = %d, spc = %lu, db = %lu, rel = %lu, fork = %d, blk = %lu, listSize = %d\n",
+           __func__ , __LINE__, ReplayProcessNum, rnode.spcNode, rnode.dbNode, rnode.relNode, forknum,
+           blknum, listSize);
+    fflush(stdout);
+#endif
+
+    lsnList = (uint64_t*) malloc(listSize*sizeof(uint64_t));
+    for(int i = 0; i < listSize; i++) {
+        pq_copymsgbytes(input_message, (char *) &(lsnList[i]), sizeof(uint64_t));
+        lsnList[i] = pg_ntoh64(lsnList[i]);
+    }
+
+
+    content = pq_getmsgbytes(input_message, BLCKSZ);
+
+#ifdef ENABLE_DEBUG_INFO
+    printf("%s %d, ReplayProcessNum = %d, lsn size = %d\n", __func__ , __LINE__, ReplayProcessNum, listSize);
+    for(int i = 0; i < listSize; i++) {
+        printf("lsn %d = %lu\n", i, lsnList[i]);
+    }
+    fflush(stdout);
+#endif
+    ReplayLsnListOnPage(input_message, rnode, forknum, blknum, content, lsnList, listSize,
+                        listSize > 0 ? lsnList[listSize - 1] : InvalidXLogRecPtr);
+    free(lsnList);
+}
+
+/*
+ * Replay on the version of the page this process kept, see
+ * tcop/wal_redo_cache.h.
+ *
+ * message format:
+ *
+ * ForkNumber
+ * spcNode
+ * dbNode
+ * relNode
+ * BlockNumber
+ * cachedLsn
+ * listSize
+ * lsnList, the LSNs after cachedLsn
+ * with XLOG_IN_ROCKSDB, the listSize records
+ *
+ * The response is an int, 1 and the page if the version was kept, else 0.
+ */
+static void
+ApplyLsnListCachedXlog(StringInfo input_message) {
+    RelFileNode rnode;
+    ForkNumber forknum;
+    BlockNumber blknum;
+    XLogRecPtr cachedLsn;
+    unsigned int listSize;
+    uint64_t *lsnList;
+    BufferTag bufferTag;
+    const char *cached;
+    int found;
+
+    forknum = pq_getmsgbyte(input_message);
+    rnode.spcNode = pq_getmsgint(input_message, 4);
+    rnode.dbNode = pq_getmsgint(input_message, 4);
+    rnode.relNode = pq_getmsgint(input_message, 4);
+    blknum = pq_getmsgint(input_message, 4);
+    cachedLsn = (XLogRecPtr) pq_getmsgint64(input_message);
+    listSize = pq_getmsgint(input_message, 4);
+
+    INIT_BUFFERTAG(bufferTag, rnode, forknum, blknum);
+    cached = WalRedoCacheGet(&bufferTag, cachedLsn);
+    found = cached != NULL ? 1 : 0;
+    WalRedoRingWrite(&walRedoChannels[ReplayProcessNum].response, (char *) &found, sizeof(found));
+    // The records left in the message are dropped with it
+    if (cached == NULL)
+        return;
+
+    lsnList = (uint64_t*) malloc(Max(listSize, 1) * sizeof(uint64_t));
+    for(int i = 0; i < listSize; i++) {
+        pq_copymsgbytes(input_message, (char *) &(lsnList[i]), sizeof(uint64_t));
+        lsnList[i] = pg_ntoh64(lsnList[i]);
+    }
+    ReplayLsnListOnPage(input_message, rnode, forknum, blknum, cached, lsnList, listSize,
+                        listSize > 0 ? lsnList[listSize - 1] : cachedLsn);
+    free(lsnList);
+}
+
+/*
+ * Replay several pages in one request.
+ *
+ * message format:
+ *
+ * pageNum
+ * pageNum times the body of an 'O' message (ForkNumber, spcNode, dbNode,
+ * relNode, BlockNumber, listSize, lsnList, 8k page content, and with
+ * XLOG_IN_ROCKSDB the records)
+ *
+ * The response is the pageNum replayed pages, in request order.
+ */
+static void
+ApplyLsnListBatchXlog(StringInfo input_message) {
+    int pageNum = pq_getmsgint(input_message, 4);
+
+    // Each call consumes one page's fields and sends that page back
+    for(int i = 0; i < pageNum; i++)
+        ApplyLsnListXlog(input_message);
+    pq_getmsgend(input_message);
 }
 
 /*
@@ -1932,22 +2078,7 @@ GetRelSize(StringInfo input_message) {
     fflush(stdout);
 #endif
     /* Response: relation size */
-    tot_written = 0;
-    do {
-        ssize_t		rc;
-
-        char * tempP = (char*) &pageNum;
-        rc = write(computePipe[ReplayProcessNum][1], &(tempP[tot_written]), sizeof(int) - tot_written);
-        if (rc < 0) {
-            /* If interrupted by signal, just retry */
-            if (errno == EINTR)
-                continue;
-            ereport(ERROR,
-                    (errcode_for_file_access(),
-                            errmsg("could not write to stdout: %m")));
-        }
-        tot_written += rc;
-    } while (tot_written < sizeof(int));
+    tot_written = WalRedoRingWrite(&walRedoChannels[ReplayProcessNum].response, &pageNum, sizeof(int));
 
 #ifdef ENABLE_DEBUG_INFO
     printf("%s write %d bytes to RPC_SERVER\n", __func__ , tot_written);
@@ -2007,21 +2138,7 @@ GetPage(StringInfo input_message)
 #endif
 
     /* Response: Page content */
-    tot_written = 0;
-    do {
-        ssize_t		rc;
-
-        rc = write(computePipe[ReplayProcessNum][1], &page[tot_written], BLCKSZ - tot_written);
-        if (rc < 0) {
-            /* If interrupted by signal, just retry */
-            if (errno == EINTR)
-                continue;
-            ereport(ERROR,
-                    (errcode_for_file_access(),
-                            errmsg("could not write to stdout: %m")));
-        }
-        tot_written += rc;
-    } while (tot_written < BLCKSZ);
+    tot_written = WalRedoRingWrite(&walRedoChannels[ReplayProcessNum].response, page, BLCKSZ);
 
 #ifdef ENABLE_DEBUG_INFO
     if(PageIsNew(page)) {
@@ -2043,65 +2160,21 @@ GetPage(StringInfo input_message)
 }
 
 
-/* Buffer used by buffered_read() */
-static char stdin_buf[16 * 1024];
-static size_t stdin_len = 0;	/* # of bytes in buffer */
-static size_t stdin_ptr = 0;	/* # of bytes already consumed */
-
 /*
- * Like read() on stdin, but buffered.
+ * Like read() on stdin, but from this process's request ring.
  *
  * We cannot use libc's buffered fread(), because it uses syscalls that we
- * have disabled with seccomp(). Depending on the platform, it can call
- * 'fstat' or 'newfstatat'. 'fstat' is probably harmless, but 'newfstatat'
- * seems problematic because it allows interrogating files by path name.
+ * have disabled with seccomp(). The ring already lives in memory, so no
+ * extra buffering is needed.
  *
- * The return value is the number of bytes read. On error, -1 is returned, and
- * errno is set appropriately. Unlike read(), this fills the buffer completely
- * unless an error happens or EOF is reached.
+ * The return value is the number of bytes read. Unlike read(), this fills
+ * the buffer completely unless EOF is reached (the rpc server closed the
+ * channel or exited).
  */
 static ssize_t
 buffered_read(void *buf, size_t count)
 {
-    char	   *dst = buf;
-
-    while (count > 0)
-    {
-        size_t		nthis;
-
-        if (stdin_ptr == stdin_len)
-        {
-            ssize_t		ret;
-
-            ret = read(serverPipe[ReplayProcessNum][0], stdin_buf, sizeof(stdin_buf));
-#ifdef ENABLE_DEBUG_INFO
-            printf("Compute: read %d bytes from pipe\n", ret);
-            fflush(stdout);
-#endif
-            if (ret < 0)
-            {
-                // Nonblocking, if no data, just read again
-                if (errno == EAGAIN)
-                    continue;
-                /* don't do anything here that could set 'errno' */
-                return ret;
-            }
-            if (ret == 0)
-            {
-                /* EOF */
-                break;
-            }
-            stdin_len = (size_t) ret;
-            stdin_ptr = 0;
-        }
-        nthis = Min(stdin_len - stdin_ptr, count);
-
-        memcpy(dst, &stdin_buf[stdin_ptr], nthis);
-
-        stdin_ptr += nthis;
-        count -= nthis;
-        dst += nthis;
-    }
+    WalRedoChannel *channel = &walRedoChannels[ReplayProcessNum];
 
-    return (dst - (char *) buf);
+    return (ssize_t) WalRedoRingRead(channel, &channel->request, buf, count);
 }
@@ -0,0 +1,153 @@
+//
+// Pages the wal_redo processes keep after replaying them, see
+// tcop/wal_redo_cache.h.
+//
+// The server's mirror needs no lock: a process's slots are only read and
+// written by the thread that acquired the process, and the pool hands a
+// process from one thread to the next under its own lock. The pages of a
+// redo process are allocated on its first put, the server never has any.
+//
+#include "postgres.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "common/hashfn.h"
+#include "tcop/wal_redo_cache.h"
+
+typedef struct WalRedoCacheSlot {
+    BufferTag   tag;
+    XLogRecPtr  lsn;        // InvalidXLogRecPtr if the slot is empty
+} WalRedoCacheSlot;
+
+static bool cache_enabled = false;
+
+// Server side, WAL_REDO_CACHE_PAGES slots per process
+static WalRedoCacheSlot *mirror = NULL;
+static int mirror_processes = 0;
+static uint64_t cache_hits = 0;
+static uint64_t cache_misses = 0;
+
+// Redo process side
+static WalRedoCacheSlot *slots = NULL;
+static char *pages = NULL;
+
+static int
+WalRedoCacheSlotOf(const BufferTag *tag) {
+    return (int) (hash_bytes((const unsigned char *) tag, sizeof(BufferTag)) % WAL_REDO_CACHE_PAGES);
+}
+
+void
+WalRedoCacheInit(int processes) {
+    const char *value = getenv("WAL_REDO_CACHE");
+
+    cache_enabled = value == NULL || strcmp(value, "off") != 0;
+    if (!cache_enabled || processes <= 0)
+        return;
+    mirror = (WalRedoCacheSlot *) calloc((size_t) processes * WAL_REDO_CACHE_PAGES, sizeof(WalRedoCacheSlot));
+    if (mirror == NULL) {
+        cache_enabled = false;
+        return;
+    }
+    mirror_processes = processes;
+}
+
+bool
+WalRedoCacheEnabled(void) {
+    return cache_enabled;
+}
+
+const char *
+WalRedoCacheGet(const BufferTag *tag, XLogRecPtr lsn) {
+    int slot;
+
+    if (slots == NULL || lsn == InvalidXLogRecPtr)
+        return NULL;
+    slot = WalRedoCacheSlotOf(tag);
+    if (slots[slot].lsn != lsn || !BUFFERTAGS_EQUAL(slots[slot].tag, *tag))
+        return NULL;
+    return pages + (size_t) slot * BLCKSZ;
+}
+
+void
+WalRedoCachePut(const BufferTag *tag, XLogRecPtr lsn, const char *page) {
+    int slot;
+
+    if (!cache_enabled || lsn == InvalidXLogRecPtr)
+        return;
+    if (slots == NULL) {
+        slots = (WalRedoCacheSlot *) calloc(WAL_REDO_CACHE_PAGES, sizeof(WalRedoCacheSlot));
+        pages = (char *) malloc((size_t) WAL_REDO_CACHE_PAGES * BLCKSZ);
+        if (slots == NULL || pages == NULL) {
+            free(slots);
+            free(pages);
+            slots = NULL;
+            pages = NULL;
+            cache_enabled = false;
+            return;
+        }
+    }
+    slot = WalRedoCacheSlotOf(tag);
+    // page may be the slot's own copy, replayed no further
+    if (page != pages + (size_t) slot * BLCKSZ)
+        memcpy(pages + (size_t) slot * BLCKSZ, page, BLCKSZ);
+    slots[slot].tag = *tag;
+    slots[slot].lsn = lsn;
+}
+
+static WalRedoCacheSlot *
+WalRedoCacheMirrorSlot(int proc, const BufferTag *tag) {
+    if (mirror == NULL || proc < 0 || proc >= mirror_processes)
+        return NULL;
+    return &mirror[(size_t) proc * WAL_REDO_CACHE_PAGES + WalRedoCacheSlotOf(tag)];
+}
+
+int
+WalRedoCacheFind(int proc, const BufferTag *tag, const XLogRecPtr *lsnList, int listSize) {
+    WalRedoCacheSlot *slot = WalRedoCacheMirrorSlot(proc, tag);
+    int low = 0;
+    int high = listSize - 1;
+
+    if (slot == NULL || slot->lsn == InvalidXLogRecPtr || !BUFFERTAGS_EQUAL(slot->tag, *tag))
+        return -1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+
+        if (lsnList[mid] == slot->lsn)
+            return mid;
+        if (lsnList[mid] < slot->lsn)
+            low = mid + 1;
+        else
+            high = mid - 1;
+    }
+    return -1;
+}
+
+void
+WalRedoCacheNote(int proc, const BufferTag *tag, XLogRecPtr lsn) {
+    WalRedoCacheSlot *slot = WalRedoCacheMirrorSlot(proc, tag);
+
+    if (slot == NULL)
+        return;
+    slot->tag = *tag;
+    slot->lsn = lsn;
+}
+
+void
+WalRedoCacheContinued(int proc, const BufferTag *tag, bool found) {
+    WalRedoCacheSlot *slot = WalRedoCacheMirrorSlot(proc, tag);
+
+    if (found) {
+        __atomic_fetch_add(&cache_hits, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    if (slot != NULL)
+        slot->lsn = InvalidXLogRecPtr;
+    __atomic_fetch_add(&cache_misses, 1, __ATOMIC_RELAXED);
+}
+
+void
+WalRedoCacheGetStats(uint64_t *hits, uint64_t *misses) {
+    *hits = __atomic_load_n(&cache_hits, __ATOMIC_RELAXED);
+    *misses = __atomic_load_n(&cache_misses, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,172 @@
+//
+// Shared-memory channels between the rpc server and its wal_redo processes.
+//
+// Each ring is a plain SPSC byte queue over two monotonically increasing
+// counters. To block, a side sets its waiting flag, re-checks the ring and
+// sleeps on the futex word the other side bumps after every move, so a
+// wakeup can never be lost between the check and the sleep. Waits are
+// bounded so a redo process notices when the rpc server has gone away.
+//
+#include "postgres.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "port/atomics.h"
+#include "tcop/wal_redo_channel.h"
+
+// How long to spin on an empty / full ring before sleeping
+#define WAL_REDO_RING_SPINS 2000
+#define WAL_REDO_RING_WAIT_NSEC (100 * 1000 * 1000)
+
+WalRedoChannel *walRedoChannels = NULL;
+
+static void
+RingFutexWait(uint32_t *addr, uint32_t val) {
+    struct timespec timeout = {0, WAL_REDO_RING_WAIT_NSEC};
+
+    // The mapping is shared between processes, so no FUTEX_PRIVATE_FLAG
+    syscall(SYS_futex, addr, FUTEX_WAIT, val, &timeout, NULL, 0);
+}
+
+static void
+RingFutexWake(uint32_t *addr) {
+    syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+static inline uint64_t
+RingUsed(WalRedoRing *ring) {
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
+
+static inline bool
+RingReady(WalRedoRing *ring, bool forData) {
+    uint64_t used = RingUsed(ring);
+
+    return forData ? used > 0 : used < WAL_REDO_RING_SIZE;
+}
+
+static bool
+ChannelPeerGone(WalRedoChannel *channel) {
+    // Only the redo processes watch their peer, the server outlives them
+    return channel != NULL && getpid() != channel->serverPid && getppid() != channel->serverPid;
+}
+
+/*
+ * Wait until the ring has data (forData) or free space. Returns false if
+ * the ring was closed or the peer exited instead.
+ */
+static bool
+RingWait(WalRedoChannel *channel, WalRedoRing *ring, bool forData) {
+    uint32_t *seq = forData ? &ring->dataSeq : &ring->spaceSeq;
+    uint32_t *waiting = forData ? &ring->readerWaiting : &ring->writerWaiting;
+
+    for (int i = 0; i < WAL_REDO_RING_SPINS; i++) {
+        if (RingReady(ring, forData))
+            return true;
+        pg_spin_delay();
+    }
+
+    while (true) {
+        uint32_t s = __atomic_load_n(seq, __ATOMIC_SEQ_CST);
+
+        __atomic_store_n(waiting, 1, __ATOMIC_SEQ_CST);
+        if (RingReady(ring, forData))
+            break;
+        if (__atomic_load_n(&ring->closed, __ATOMIC_SEQ_CST) || ChannelPeerGone(channel)) {
+            __atomic_store_n(waiting, 0, __ATOMIC_SEQ_CST);
+            return false;
+        }
+        RingFutexWait(seq, s);
+    }
+    __atomic_store_n(waiting, 0, __ATOMIC_SEQ_CST);
+    return true;
+}
+
+WalRedoChannel *
+WalRedoChannelsCreate(int num) {
+    size_t size = sizeof(WalRedoChannel) * num;
+    void *mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    if (mem == MAP_FAILED)
+        elog(FATAL, "could not map %zu bytes for wal_redo channels: %m", size);
+
+    // Anonymous mappings start zeroed, which is an empty, open ring
+    WalRedoChannel *channels = (WalRedoChannel *) mem;
+    for (int i = 0; i < num; i++)
+        channels[i].serverPid = getpid();
+    return channels;
+}
+
+void
+WalRedoChannelsClose(WalRedoChannel *channels, int num) {
+    for (int i = 0; i < num; i++) {
+        __atomic_store_n(&channels[i].request.closed, 1, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&channels[i].request.dataSeq, 1, __ATOMIC_SEQ_CST);
+        RingFutexWake(&channels[i].request.dataSeq);
+    }
+}
+
+size_t
+WalRedoRingWrite(WalRedoRing *ring, const void *buf, size_t len) {
+    const char *src = (const char *) buf;
+    size_t done = 0;
+
+    while (done < len) {
+        uint64_t head = ring->head;
+        uint64_t space = WAL_REDO_RING_SIZE - (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE));
+
+        if (space == 0) {
+            RingWait(NULL, ring, false);
+            continue;
+        }
+
+        size_t n = Min(space, len - done);
+        size_t off = head % WAL_REDO_RING_SIZE;
+        size_t first = Min(n, WAL_REDO_RING_SIZE - off);
+
+        memcpy(&ring->data[off], &src[done], first);
+        memcpy(&ring->data[0], &src[done + first], n - first);
+        __atomic_store_n(&ring->head, head + n, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&ring->dataSeq, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&ring->readerWaiting, __ATOMIC_SEQ_CST))
+            RingFutexWake(&ring->dataSeq);
+        done += n;
+    }
+    return done;
+}
+
+size_t
+WalRedoRingRead(WalRedoChannel *channel, WalRedoRing *ring, void *buf, size_t len) {
+    char *dst = (char *) buf;
+    size_t done = 0;
+
+    while (done < len) {
+        uint64_t tail = ring->tail;
+        uint64_t used = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - tail;
+
+        if (used == 0) {
+            if (!RingWait(channel, ring, true))
+                break;
+            continue;
+        }
+
+        size_t n = Min(used, len - done);
+        size_t off = tail % WAL_REDO_RING_SIZE;
+        size_t first = Min(n, WAL_REDO_RING_SIZE - off);
+
+        memcpy(&dst[done], &ring->data[off], first);
+        memcpy(&dst[done + first], &ring->data[0], n - first);
+        __atomic_store_n(&ring->tail, tail + n, __ATOMIC_SEQ_CST);
+        __atomic_add_fetch(&ring->spaceSeq, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&ring->writerWaiting, __ATOMIC_SEQ_CST))
+            RingFutexWake(&ring->spaceSeq);
+        done += n;
+    }
+    return done;
+}
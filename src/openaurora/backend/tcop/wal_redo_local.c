@@ -0,0 +1,414 @@
+//
+// In-process replay of simple WAL records, see tcop/wal_redo_local.h.
+//
+// This runs in rpc server threads, so it stays away from everything that
+// is per-process in PostgreSQL: no palloc, no buffer manager, no
+// XLogReaderState. Records are copied out of RpcXLogPages under the page
+// locks into a malloc'd buffer, checked against their CRC, decoded by a
+// small copy of DecodeXLogRecord and applied with the pure page routines
+// from bufpage.c, mirroring what the rmgr redo function would do.
+//
+#include "postgres.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lz4.h>
+
+#include "access/heapam_xlog.h"
+#include "access/htup_details.h"
+#include "access/rmgr.h"
+#include "access/xlog_internal.h"
+#include "access/xlogrecord.h"
+#include "catalog/pg_control.h"
+#include "common/pg_lzcompress.h"
+#include "port/pg_crc32c.h"
+#include "storage/bufpage.h"
+#include "tcop/wal_redo_local.h"
+
+extern int XLOGbuffers;
+extern XLogRecPtr *RpcXlblocks;
+extern char *RpcXLogPages;
+extern pthread_rwlock_t *RpcXLogPagesLocks;
+
+// Larger records are never whitelisted ones without an image
+#define LOCAL_REDO_MAX_RECORD (2 * BLCKSZ)
+
+typedef struct LocalRedoBlock {
+    bool        inUse;
+    RelFileNode rnode;
+    ForkNumber  forknum;
+    BlockNumber blkno;
+
+    bool        hasData;
+    uint16      dataLen;
+    const char *data;
+
+    bool        hasImage;
+    bool        applyImage;
+    uint16      bimgLen;
+    uint16      holeOffset;
+    uint16      holeLength;
+    uint8       bimgInfo;
+    const char *image;
+} LocalRedoBlock;
+
+typedef struct LocalRedoRecord {
+    const XLogRecord *header;
+    XLogRecPtr  endRecPtr;
+    const char *mainData;
+    uint32      mainDataLen;
+    LocalRedoBlock *block;      // the reference to the page being replayed
+} LocalRedoRecord;
+
+static bool local_redo_enabled = true;
+static uint64_t local_redo_applied = 0;
+static uint64_t local_redo_fallbacks = 0;
+
+void
+WalRedoLocalInit(void) {
+    const char *value = getenv("WAL_REDO_LOCAL");
+
+    local_redo_enabled = value == NULL || strcmp(value, "off") != 0;
+}
+
+bool
+WalRedoLocalEnabled(void) {
+    return local_redo_enabled;
+}
+
+/*
+ * Copy len bytes of WAL starting at *pos out of RpcXLogPages, skipping the
+ * headers of the pages a record continues on, and advance *pos past them.
+ * Returns false as soon as a page isn't in the cache.
+ */
+static bool
+LocalRedoCopyWal(XLogRecPtr *pos, char *dst, uint32 len) {
+    while (len > 0) {
+        XLogRecPtr pagePtr = *pos - *pos % XLOG_BLCKSZ;
+        uint32 offset = *pos % XLOG_BLCKSZ;
+        int idx = (int) ((pagePtr / XLOG_BLCKSZ) % XLOGbuffers);
+        const char *page = RpcXLogPages + (Size) XLOG_BLCKSZ * idx;
+        bool cached;
+
+        pthread_rwlock_rdlock(&RpcXLogPagesLocks[idx]);
+        cached = RpcXlblocks[idx] == pagePtr + XLOG_BLCKSZ;
+        if (cached) {
+            if (offset == 0)
+                offset = XLogPageHeaderSize((XLogPageHeader) page);
+
+            uint32 n = Min(len, XLOG_BLCKSZ - offset);
+            memcpy(dst, page + offset, n);
+            dst += n;
+            len -= n;
+            *pos = pagePtr + offset + n;
+        }
+        pthread_rwlock_unlock(&RpcXLogPagesLocks[idx]);
+
+        if (!cached)
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Decode the record in buf the way DecodeXLogRecord does and find the block
+ * reference for tag. Returns false for anything malformed or when the
+ * record doesn't touch the page.
+ */
+static bool
+LocalRedoDecode(const XLogRecord *record, const BufferTag *tag, LocalRedoBlock *blocks, LocalRedoRecord *rec) {
+    const char *ptr = (const char *) record + SizeOfXLogRecord;
+    const char *end = (const char *) record + record->xl_tot_len;
+    const RelFileNode *lastRnode = NULL;
+    uint32 dataTotal = 0;
+    int maxBlockId = -1;
+
+#define LOCAL_REDO_COPY(dst, size) \
+    do { \
+        if (end - ptr < (size)) \
+            return false; \
+        memcpy((dst), ptr, (size)); \
+        ptr += (size); \
+    } while (0)
+
+    rec->header = record;
+    rec->mainData = NULL;
+    rec->mainDataLen = 0;
+    rec->block = NULL;
+
+    while (end - ptr > dataTotal) {
+        uint8 blockId;
+
+        LOCAL_REDO_COPY(&blockId, sizeof(uint8));
+        if (blockId == XLR_BLOCK_ID_DATA_SHORT) {
+            uint8 mainDataLen;
+
+            LOCAL_REDO_COPY(&mainDataLen, sizeof(uint8));
+            rec->mainDataLen = mainDataLen;
+            break;
+        } else if (blockId == XLR_BLOCK_ID_DATA_LONG) {
+            LOCAL_REDO_COPY(&rec->mainDataLen, sizeof(uint32));
+            break;
+        } else if (blockId == XLR_BLOCK_ID_ORIGIN) {
+            RepOriginId origin;
+
+            LOCAL_REDO_COPY(&origin, sizeof(RepOriginId));
+        } else if (blockId <= XLR_MAX_BLOCK_ID && (int) blockId > maxBlockId) {
+            LocalRedoBlock *blk = &blocks[blockId];
+            uint8 forkFlags;
+
+            for (int i = maxBlockId + 1; i < blockId; i++)
+                blocks[i].inUse = false;
+            maxBlockId = blockId;
+
+            memset(blk, 0, sizeof(LocalRedoBlock));
+            blk->inUse = true;
+            LOCAL_REDO_COPY(&forkFlags, sizeof(uint8));
+            blk->forknum = forkFlags & BKPBLOCK_FORK_MASK;
+            blk->hasImage = (forkFlags & BKPBLOCK_HAS_IMAGE) != 0;
+            blk->hasData = (forkFlags & BKPBLOCK_HAS_DATA) != 0;
+
+            LOCAL_REDO_COPY(&blk->dataLen, sizeof(uint16));
+            if (blk->hasData != (blk->dataLen > 0))
+                return false;
+            dataTotal += blk->dataLen;
+
+            if (blk->hasImage) {
+                LOCAL_REDO_COPY(&blk->bimgLen, sizeof(uint16));
+                LOCAL_REDO_COPY(&blk->holeOffset, sizeof(uint16));
+                LOCAL_REDO_COPY(&blk->bimgInfo, sizeof(uint8));
+                blk->applyImage = (blk->bimgInfo & BKPIMAGE_APPLY) != 0;
+                if (blk->bimgInfo & BKPIMAGE_IS_COMPRESSED) {
+                    if (blk->bimgInfo & BKPIMAGE_HAS_HOLE)
+                        LOCAL_REDO_COPY(&blk->holeLength, sizeof(uint16));
+                    else
+                        blk->holeLength = 0;
+                } else
+                    blk->holeLength = BLCKSZ - blk->bimgLen;
+                if (blk->holeOffset + blk->holeLength > BLCKSZ)
+                    return false;
+                dataTotal += blk->bimgLen;
+            }
+
+            if (!(forkFlags & BKPBLOCK_SAME_REL)) {
+                LOCAL_REDO_COPY(&blk->rnode, sizeof(RelFileNode));
+                lastRnode = &blk->rnode;
+            } else {
+                if (lastRnode == NULL)
+                    return false;
+                blk->rnode = *lastRnode;
+            }
+            LOCAL_REDO_COPY(&blk->blkno, sizeof(BlockNumber));
+        } else
+            return false;
+    }
+
+    // Then come the images and data of every block, and the main data
+    for (int i = 0; i <= maxBlockId; i++) {
+        LocalRedoBlock *blk = &blocks[i];
+
+        if (!blk->inUse)
+            continue;
+        if (blk->hasImage) {
+            if (end - ptr < blk->bimgLen)
+                return false;
+            blk->image = ptr;
+            ptr += blk->bimgLen;
+        }
+        if (blk->hasData) {
+            if (end - ptr < blk->dataLen)
+                return false;
+            blk->data = ptr;
+            ptr += blk->dataLen;
+        }
+        if (RelFileNodeEquals(blk->rnode, tag->rnode) && blk->forknum == tag->forkNum && blk->blkno == tag->blockNum)
+            rec->block = blk;
+    }
+    if (rec->mainDataLen > 0) {
+        if (end - ptr < rec->mainDataLen)
+            return false;
+        rec->mainData = ptr;
+        ptr += rec->mainDataLen;
+    }
+#undef LOCAL_REDO_COPY
+
+    return ptr == end && rec->block != NULL;
+}
+
+/*
+ * Fetch the record at lsn into buf (LOCAL_REDO_MAX_RECORD bytes) and decode
+ * it for tag.
+ */
+static bool
+LocalRedoReadRecord(XLogRecPtr lsn, const BufferTag *tag, char *buf, LocalRedoBlock *blocks, LocalRedoRecord *rec) {
+    XLogRecord *record = (XLogRecord *) buf;
+    XLogRecPtr pos = lsn;
+    pg_crc32c crc;
+
+    if (!LocalRedoCopyWal(&pos, buf, SizeOfXLogRecord))
+        return false;
+    if (record->xl_tot_len < SizeOfXLogRecord || record->xl_tot_len > LOCAL_REDO_MAX_RECORD)
+        return false;
+    if (!LocalRedoCopyWal(&pos, buf + SizeOfXLogRecord, record->xl_tot_len - SizeOfXLogRecord))
+        return false;
+
+    // Same check as ValidXLogRecord, which also catches a recycled cache slot
+    INIT_CRC32C(crc);
+    COMP_CRC32C(crc, buf + SizeOfXLogRecord, record->xl_tot_len - SizeOfXLogRecord);
+    COMP_CRC32C(crc, buf, offsetof(XLogRecord, xl_crc));
+    FIN_CRC32C(crc);
+    if (!EQ_CRC32C(record->xl_crc, crc))
+        return false;
+
+    // Page headers are MAXALIGNed, so this is the reader's EndRecPtr
+    rec->endRecPtr = MAXALIGN64(pos);
+    return LocalRedoDecode(record, tag, blocks, rec);
+}
+
+// Like RestoreBlockImage
+static bool
+LocalRedoRestoreImage(const LocalRedoBlock *blk, char *page) {
+    PGAlignedBlock tmp;
+    const char *ptr = blk->image;
+
+    if (blk->bimgInfo & BKPIMAGE_IS_COMPRESSED) {
+        int rawLen = BLCKSZ - blk->holeLength;
+
+        if (blk->bimgInfo & BKPIMAGE_COMPRESS_LZ4) {
+            if (LZ4_decompress_safe(ptr, tmp.data, blk->bimgLen, rawLen) != rawLen)
+                return false;
+        } else if (pglz_decompress(ptr, blk->bimgLen, tmp.data, rawLen, true) < 0)
+            return false;
+        ptr = tmp.data;
+    }
+
+    if (blk->holeLength == 0) {
+        memcpy(page, ptr, BLCKSZ);
+    } else {
+        memcpy(page, ptr, blk->holeOffset);
+        MemSet(page + blk->holeOffset, 0, blk->holeLength);
+        memcpy(page + (blk->holeOffset + blk->holeLength), ptr + blk->holeOffset,
+               BLCKSZ - (blk->holeOffset + blk->holeLength));
+    }
+    return true;
+}
+
+// The BLK_NEEDS_REDO branch of heap_xlog_insert
+static bool
+LocalRedoHeapInsert(const LocalRedoRecord *rec, Page page) {
+    const LocalRedoBlock *blk = rec->block;
+    xl_heap_insert xlrec;
+    xl_heap_header xlhdr;
+    union {
+        HeapTupleHeaderData hdr;
+        char data[MaxHeapTupleSize];
+    } tbuf;
+    HeapTupleHeader htup = &tbuf.hdr;
+    ItemPointerData targetTid;
+    uint32 newlen;
+
+    if (rec->mainDataLen < SizeOfHeapInsert || !blk->hasData || blk->dataLen <= SizeOfHeapHeader)
+        return false;
+    memcpy(&xlrec, rec->mainData, SizeOfHeapInsert);
+    newlen = blk->dataLen - SizeOfHeapHeader;
+    if (newlen > MaxHeapTupleSize || PageGetMaxOffsetNumber(page) + 1 < xlrec.offnum)
+        return false;
+    memcpy(&xlhdr, blk->data, SizeOfHeapHeader);
+
+    ItemPointerSetBlockNumber(&targetTid, blk->blkno);
+    ItemPointerSetOffsetNumber(&targetTid, xlrec.offnum);
+
+    MemSet((char *) htup, 0, SizeofHeapTupleHeader);
+    memcpy((char *) htup + SizeofHeapTupleHeader, blk->data + SizeOfHeapHeader, newlen);
+    newlen += SizeofHeapTupleHeader;
+    htup->t_infomask2 = xlhdr.t_infomask2;
+    htup->t_infomask = xlhdr.t_infomask;
+    htup->t_hoff = xlhdr.t_hoff;
+    HeapTupleHeaderSetXmin(htup, rec->header->xl_xid);
+    HeapTupleHeaderSetCmin(htup, FirstCommandId);
+    htup->t_ctid = targetTid;
+
+    if (PageAddItem(page, (Item) htup, newlen, xlrec.offnum, true, true) == InvalidOffsetNumber)
+        return false;
+
+    PageSetLSN(page, rec->endRecPtr);
+    if (xlrec.flags & XLH_INSERT_ALL_VISIBLE_CLEARED)
+        PageClearAllVisible(page);
+    return true;
+}
+
+/*
+ * Apply one decoded record to page. Returns false, leaving the page as it
+ * was, if the record is not one we replay here.
+ */
+static bool
+LocalRedoApplyRecord(const LocalRedoRecord *rec, char *page) {
+    const LocalRedoBlock *blk = rec->block;
+    uint8 info = rec->header->xl_info & ~XLR_INFO_MASK;
+    bool heapInsert = rec->header->xl_rmid == RM_HEAP_ID && (info & XLOG_HEAP_OPMASK) == XLOG_HEAP_INSERT;
+    bool fpi = rec->header->xl_rmid == RM_XLOG_ID && (info == XLOG_FPI || info == XLOG_FPI_FOR_HINT);
+
+    if (!heapInsert && !fpi)
+        return false;
+
+    if (heapInsert && (info & XLOG_HEAP_INIT_PAGE)) {
+        PGAlignedBlock init;
+
+        // Build it aside so a failed insert leaves page untouched
+        PageInit(init.data, BLCKSZ, 0);
+        if (!LocalRedoHeapInsert(rec, init.data))
+            return false;
+        memcpy(page, init.data, BLCKSZ);
+        return true;
+    }
+
+    // XLogReadBufferForRedo: BLK_RESTORED
+    if (blk->hasImage && blk->applyImage) {
+        if (!LocalRedoRestoreImage(blk, page))
+            return false;
+        if (!PageIsNew((Page) page))
+            PageSetLSN((Page) page, rec->endRecPtr);
+        return true;
+    }
+    // xlog_redo insists on restoring an FPI
+    if (fpi)
+        return false;
+
+    // BLK_DONE
+    if (rec->endRecPtr <= PageGetLSN((Page) page))
+        return true;
+
+    return LocalRedoHeapInsert(rec, (Page) page);
+}
+
+int
+WalRedoLocalApplyLsnList(const BufferTag *tag, const XLogRecPtr *lsnList, int listSize, char *page) {
+    LocalRedoBlock blocks[XLR_MAX_BLOCK_ID + 1];
+    LocalRedoRecord rec;
+    char *buf;
+    int applied = 0;
+
+    if (!local_redo_enabled || listSize <= 0)
+        return 0;
+
+    buf = (char *) malloc(LOCAL_REDO_MAX_RECORD);
+    while (applied < listSize) {
+        if (!LocalRedoReadRecord(lsnList[applied], tag, buf, blocks, &rec) || !LocalRedoApplyRecord(&rec, page))
+            break;
+        applied++;
+    }
+    free(buf);
+
+    if (applied > 0)
+        __atomic_add_fetch(&local_redo_applied, applied, __ATOMIC_RELAXED);
+    if (applied < listSize)
+        __atomic_add_fetch(&local_redo_fallbacks, 1, __ATOMIC_RELAXED);
+    return applied;
+}
+
+void
+WalRedoLocalGetStats(uint64_t *applied, uint64_t *fallbacks) {
+    *applied = __atomic_load_n(&local_redo_applied, __ATOMIC_RELAXED);
+    *fallbacks = __atomic_load_n(&local_redo_fallbacks, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,320 @@
+//
+// Elastic pool of wal_redo processes.
+//
+// The processes in service are kept to a prefix [0, pool_size) of the
+// forked ones: an acquisition takes the lowest idle index, the pool grows by
+// bringing index pool_size into service and shrinks by parking the last one
+// once it has been idle long enough. That keeps the busy processes packed
+// at the front, so the ones at the end really are the spare ones, and gives
+// affinity routing a stable range to hash into. A releasing thread hands
+// its process straight to the oldest queued waiter instead of waking every
+// thread that waits.
+//
+#include "postgres.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "common/hashfn.h"
+#include "tcop/wal_redo_pool.h"
+
+typedef enum PoolProcState {
+    POOL_PROC_PARKED = 0,
+    POOL_PROC_IDLE,
+    POOL_PROC_BUSY
+} PoolProcState;
+
+typedef struct PoolWaiter {
+    pthread_cond_t      cond;
+    int                 proc;
+    struct PoolWaiter  *next;
+} PoolWaiter;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static int pool_forked = 0;
+static int pool_min = 0;
+static int pool_max = 0;
+// Every index >= pool_size is parked. Below it a process is only parked
+// transiently, after the upper limit was lowered while it was busy.
+static int pool_size = 0;
+static int pool_busy = 0;
+static uint64_t pool_waits = 0;
+static uint64_t pool_affinity_hits = 0;
+static uint64_t pool_affinity_steals = 0;
+static WalRedoAffinityMode pool_affinity = WAL_REDO_AFFINITY_NONE;
+
+static PoolProcState *pool_state = NULL;
+static uint64_t *pool_idle_since = NULL;   // ms, valid while idle
+static uint64_t *pool_busy_since = NULL;   // us, valid while busy
+static uint64_t *pool_busy_us = NULL;      // us spent busy, ever
+
+static PoolWaiter *pool_wait_head = NULL;
+static PoolWaiter *pool_wait_tail = NULL;
+static int pool_waiting = 0;
+
+static uint64_t
+PoolNowMs(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static uint64_t
+PoolNowUs(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static int
+PoolEnvInt(const char *name, int defaultValue) {
+    const char *value = getenv(name);
+
+    if (value == NULL || atoi(value) <= 0)
+        return defaultValue;
+    return atoi(value);
+}
+
+void
+WalRedoPoolInit(void) {
+    const char *affinity = getenv("WAL_REDO_AFFINITY");
+
+    pool_min = PoolEnvInt("WAL_REDO_PROCESS_NUM", WAL_REDO_POOL_DEFAULT_SIZE);
+    pool_forked = PoolEnvInt("WAL_REDO_PROCESS_MAX", Max(WAL_REDO_POOL_DEFAULT_MAX, pool_min));
+    if (pool_min > pool_forked)
+        pool_min = pool_forked;
+    pool_max = pool_forked;
+
+    if (affinity != NULL && strcmp(affinity, "page") == 0)
+        pool_affinity = WAL_REDO_AFFINITY_PAGE;
+    else if (affinity != NULL && strcmp(affinity, "relation") == 0)
+        pool_affinity = WAL_REDO_AFFINITY_RELATION;
+
+    pool_state = (PoolProcState *) calloc(pool_forked, sizeof(PoolProcState));
+    pool_idle_since = (uint64_t *) calloc(pool_forked, sizeof(uint64_t));
+    pool_busy_since = (uint64_t *) calloc(pool_forked, sizeof(uint64_t));
+    pool_busy_us = (uint64_t *) calloc(pool_forked, sizeof(uint64_t));
+
+    uint64_t now = PoolNowMs();
+    for (int i = 0; i < pool_min; i++) {
+        pool_state[i] = POOL_PROC_IDLE;
+        pool_idle_since[i] = now;
+    }
+    pool_size = pool_min;
+
+    printf("%s wal_redo processes: %d in service, up to %d, affinity = %s\n", __func__, pool_min, pool_forked,
+           pool_affinity == WAL_REDO_AFFINITY_PAGE ? "page" :
+           pool_affinity == WAL_REDO_AFFINITY_RELATION ? "relation" : "none");
+    fflush(stdout);
+}
+
+int
+WalRedoPoolForkedProcesses(void) {
+    return pool_forked;
+}
+
+uint32_t
+WalRedoPoolAffinityKey(Oid spcNode, Oid dbNode, Oid relNode, int forkNum, BlockNumber blockNum) {
+    uint32_t key[5];
+
+    if (pool_affinity == WAL_REDO_AFFINITY_NONE)
+        return WAL_REDO_NO_AFFINITY;
+
+    key[0] = spcNode;
+    key[1] = dbNode;
+    key[2] = relNode;
+    key[3] = (uint32_t) forkNum;
+    key[4] = pool_affinity == WAL_REDO_AFFINITY_PAGE ? blockNum : 0;
+    return hash_bytes((const unsigned char *) key, sizeof(key)) & ~WAL_REDO_NO_AFFINITY;
+}
+
+// Park trailing processes that have been idle too long, or any idle ones
+// above the upper limit. Called with pool_lock held.
+static void
+PoolShrink(uint64_t now) {
+    while (pool_size > 0) {
+        int last = pool_size - 1;
+
+        if (pool_state[last] == POOL_PROC_BUSY)
+            break;
+        if (pool_state[last] == POOL_PROC_IDLE) {
+            if (pool_size <= pool_min)
+                break;
+            if (pool_size <= pool_max && now - pool_idle_since[last] < WAL_REDO_POOL_SHRINK_IDLE_MS)
+                break;
+            pool_state[last] = POOL_PROC_PARKED;
+        }
+        pool_size--;
+    }
+}
+
+static void
+PoolTakeProc(int proc) {
+    pool_state[proc] = POOL_PROC_BUSY;
+    pool_busy_since[proc] = PoolNowUs();
+    pool_busy++;
+}
+
+int
+WalRedoPoolAcquireAffine(uint32_t affinityKey) {
+    int proc = -1;
+
+    pthread_mutex_lock(&pool_lock);
+    if (affinityKey != WAL_REDO_NO_AFFINITY && pool_size > 0) {
+        int preferred = (int) (affinityKey % (uint32_t) pool_size);
+
+        if (pool_state[preferred] == POOL_PROC_IDLE) {
+            PoolTakeProc(preferred);
+            pool_affinity_hits++;
+            pthread_mutex_unlock(&pool_lock);
+            return preferred;
+        }
+        pool_affinity_steals++;
+    }
+
+    for (int i = 0; i < pool_size; i++)
+        if (pool_state[i] == POOL_PROC_IDLE) {
+            proc = i;
+            break;
+        }
+    if (proc < 0 && pool_size < pool_max)
+        proc = pool_size++;
+
+    if (proc < 0) {
+        PoolWaiter waiter;
+
+        pthread_cond_init(&waiter.cond, NULL);
+        waiter.proc = -1;
+        waiter.next = NULL;
+        if (pool_wait_tail != NULL)
+            pool_wait_tail->next = &waiter;
+        else
+            pool_wait_head = &waiter;
+        pool_wait_tail = &waiter;
+        pool_waiting++;
+        pool_waits++;
+
+        while (waiter.proc < 0)
+            pthread_cond_wait(&waiter.cond, &pool_lock);
+        pthread_cond_destroy(&waiter.cond);
+
+        // Handed over by whoever dequeued us, already counted as busy
+        pthread_mutex_unlock(&pool_lock);
+        return waiter.proc;
+    }
+
+    PoolTakeProc(proc);
+    pthread_mutex_unlock(&pool_lock);
+    return proc;
+}
+
+int
+WalRedoPoolAcquire(void) {
+    return WalRedoPoolAcquireAffine(WAL_REDO_NO_AFFINITY);
+}
+
+static void
+PoolHandOff(int proc) {
+    PoolWaiter *waiter = pool_wait_head;
+
+    pool_wait_head = waiter->next;
+    if (pool_wait_head == NULL)
+        pool_wait_tail = NULL;
+    pool_waiting--;
+    waiter->proc = proc;
+    pthread_cond_signal(&waiter->cond);
+}
+
+void
+WalRedoPoolRelease(int proc) {
+    uint64_t now = PoolNowMs();
+
+    pthread_mutex_lock(&pool_lock);
+    Assert(pool_state[proc] == POOL_PROC_BUSY);
+
+    if (pool_wait_head != NULL && proc < pool_max) {
+        // Stays busy, it just changes hands
+        PoolHandOff(proc);
+        pthread_mutex_unlock(&pool_lock);
+        return;
+    }
+
+    pool_busy--;
+    pool_busy_us[proc] += PoolNowUs() - pool_busy_since[proc];
+    if (proc >= pool_max) {
+        pool_state[proc] = POOL_PROC_PARKED;
+    } else {
+        pool_state[proc] = POOL_PROC_IDLE;
+        pool_idle_since[proc] = now;
+    }
+    PoolShrink(now);
+    pthread_mutex_unlock(&pool_lock);
+}
+
+void
+WalRedoPoolSetLimits(int minSize, int maxSize) {
+    pthread_mutex_lock(&pool_lock);
+    maxSize = Min(Max(maxSize, 1), pool_forked);
+    minSize = Min(Max(minSize, 1), maxSize);
+    pool_min = minSize;
+    pool_max = maxSize;
+
+    // Bring the lower limit into service, and serve queued threads right
+    // away if the upper limit went up
+    uint64_t now = PoolNowMs();
+    while (pool_size < pool_min) {
+        pool_state[pool_size] = POOL_PROC_IDLE;
+        pool_idle_since[pool_size] = now;
+        pool_size++;
+    }
+    while (pool_wait_head != NULL && pool_size < pool_max) {
+        PoolTakeProc(pool_size);
+        PoolHandOff(pool_size);
+        pool_size++;
+    }
+    for (int i = 0; i < pool_size && pool_wait_head != NULL; i++)
+        if (pool_state[i] == POOL_PROC_IDLE) {
+            PoolTakeProc(i);
+            PoolHandOff(i);
+        }
+    PoolShrink(now);
+    pthread_mutex_unlock(&pool_lock);
+}
+
+void
+WalRedoPoolGetStats(WalRedoPoolStats *stats) {
+    pthread_mutex_lock(&pool_lock);
+    stats->forked = pool_forked;
+    stats->minSize = pool_min;
+    stats->maxSize = pool_max;
+    stats->size = 0;
+    for (int i = 0; i < pool_size; i++)
+        if (pool_state[i] != POOL_PROC_PARKED)
+            stats->size++;
+    stats->busy = pool_busy;
+    stats->waiting = pool_waiting;
+    stats->waits = pool_waits;
+    stats->affinityHits = pool_affinity_hits;
+    stats->affinitySteals = pool_affinity_steals;
+    pthread_mutex_unlock(&pool_lock);
+}
+
+int
+WalRedoPoolGetBusyTime(uint64_t *busyUs, int max) {
+    uint64_t now = PoolNowUs();
+    int num;
+
+    pthread_mutex_lock(&pool_lock);
+    num = Min(max, pool_forked);
+    for (int i = 0; i < num; i++) {
+        busyUs[i] = pool_busy_us[i];
+        if (pool_state[i] == POOL_PROC_BUSY)
+            busyUs[i] += now - pool_busy_since[i];
+    }
+    pthread_mutex_unlock(&pool_lock);
+    return num;
+}
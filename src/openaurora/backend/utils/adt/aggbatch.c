@@ -0,0 +1,137 @@
+/*-------------------------------------------------------------------------
+ *
+ * aggbatch.c
+ *	  Batched transition functions of built-in aggregates
+ *
+ * This file has the lookup of the batched transition functions, the loops
+ * over a batch the integer ones share, and those of count().  The loops
+ * are written for the compiler to vectorize, and the file is built with
+ * CFLAGS_VECTOR for it, as storage/page/checksum.c is.  See
+ * utils/aggbatch.h.
+ *
+ * Portions Copyright (c) 1996-2020, PostgreSQL Global Development Group
+ *
+ * IDENTIFICATION
+ *	  src/backend/utils/adt/aggbatch.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "common/int.h"
+#include "utils/aggbatch.h"
+#include "utils/fmgroids.h"
+
+AggBatchTransFunc
+AggBatchTransFuncFor(Oid transfn)
+{
+	switch (transfn)
+	{
+			/* Those with an int8 or float8 transition value keep it in the Datum */
+#ifdef USE_FLOAT8_BYVAL
+		case F_INT8INC:
+			return int8inc_batch;
+		case F_INT8INC_ANY:
+			return int8inc_any_batch;
+		case F_INT2_SUM:
+		case F_INT4_SUM:
+			return int4_sum_batch;
+		case F_FLOAT8PL:
+			return float8pl_batch;
+#endif
+		case F_FLOAT4PL:
+			return float4pl_batch;
+		case F_INT2_AVG_ACCUM:
+		case F_INT4_AVG_ACCUM:
+			return int4_avg_accum_batch;
+#ifdef HAVE_INT128
+		case F_INT8_AVG_ACCUM:
+			return int8_avg_accum_batch;
+#endif
+		case F_NUMERIC_AVG_ACCUM:
+			return numeric_avg_accum_batch;
+		case F_FLOAT8_ACCUM:
+			return float8_accum_batch;
+		default:
+			return NULL;
+	}
+}
+
+int64
+AggBatchCountNotNull(const bool *nulls, int nrows)
+{
+	int64		count = 0;
+
+	for (int i = 0; i < nrows; i++)
+		count += !nulls[i];
+	return count;
+}
+
+/*
+ * The sum of the non-null int2 or int4 values; an int2 Datum is sign
+ * extended, so it reads as the same int4.
+ */
+int64
+AggBatchSumInt32(const Datum *values, const bool *nulls, int nrows)
+{
+	int64		sum = 0;
+
+	for (int i = 0; i < nrows; i++)
+		sum += nulls[i] ? 0 : (int64) DatumGetInt32(values[i]);
+	return sum;
+}
+
+#ifdef HAVE_INT128
+/*
+ * The sum of the non-null int8 values.  The high and the low 32 bits of the
+ * values are summed apart in 64 bits, which has no carries to propagate
+ * from lane to lane and can't overflow for a batch of fewer than 2^31 rows.
+ */
+int128
+AggBatchSumInt64(const Datum *values, const bool *nulls, int nrows)
+{
+	int64		high = 0;
+	int64		low = 0;
+
+	for (int i = 0; i < nrows; i++)
+	{
+		int64		value = nulls[i] ? 0 : DatumGetInt64(values[i]);
+
+		high += value >> 32;
+		low += value & INT64CONST(0xFFFFFFFF);
+	}
+	return ((int128) high << 32) + low;
+}
+#endif
+
+static void
+int8inc_batch_add(Datum *transValue, int64 count)
+{
+	int64		result;
+
+	if (unlikely(pg_add_s64_overflow(DatumGetInt64(*transValue), count, &result)))
+		ereport(ERROR,
+				(errcode(ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE),
+				 errmsg("bigint out of range")));
+	*transValue = Int64GetDatum(result);
+}
+
+/* count(*) */
+void
+int8inc_batch(Datum *transValue, bool *transValueIsNull,
+			  const Datum *values, const bool *nulls,
+			  int nrows, MemoryContext aggcontext)
+{
+	Assert(!*transValueIsNull);
+	int8inc_batch_add(transValue, nrows);
+}
+
+/* count(any), by the rows it isn't null in */
+void
+int8inc_any_batch(Datum *transValue, bool *transValueIsNull,
+				  const Datum *values, const bool *nulls,
+				  int nrows, MemoryContext aggcontext)
+{
+	Assert(!*transValueIsNull);
+	int8inc_batch_add(transValue, AggBatchCountNotNull(nulls, nrows));
+}
@@ -24,6 +24,7 @@
 #include "common/shortest_dec.h"
 #include "libpq/pqformat.h"
 #include "miscadmin.h"
+#include "utils/aggbatch.h"
 #include "utils/array.h"
 #include "utils/float.h"
 #include "utils/fmgrprotos.h"
@@ -761,6 +762,33 @@ float4pl(PG_FUNCTION_ARGS)
 	PG_RETURN_FLOAT4(float4_pl(arg1, arg2));
 }
 
+/*
+ * Batched float4pl as the transition function of sum(float4), see
+ * utils/aggbatch.h.  The inputs are added in row order.
+ */
+void
+float4pl_batch(Datum *transValue, bool *transValueIsNull,
+			   const Datum *values, const bool *nulls,
+			   int nrows, MemoryContext aggcontext)
+{
+	bool		isnull = *transValueIsNull;
+	float4		sum = isnull ? 0 : DatumGetFloat4(*transValue);
+
+	for (int i = 0; i < nrows; i++)
+	{
+		if (nulls[i])
+			continue;
+		if (isnull)
+			sum = DatumGetFloat4(values[i]);
+		else
+			sum = float4_pl(sum, DatumGetFloat4(values[i]));
+		isnull = false;
+	}
+	if (!isnull)
+		*transValue = Float4GetDatum(sum);
+	*transValueIsNull = isnull;
+}
+
 Datum
 float4mi(PG_FUNCTION_ARGS)
 {
@@ -803,6 +831,34 @@ float8pl(PG_FUNCTION_ARGS)
 	PG_RETURN_FLOAT8(float8_pl(arg1, arg2));
 }
 
+/*
+ * Batched float8pl as the transition function of sum(float8), see
+ * utils/aggbatch.h.  The inputs are added in row order.  float8 is passed by
+ * value where this is called.
+ */
+void
+float8pl_batch(Datum *transValue, bool *transValueIsNull,
+			   const Datum *values, const bool *nulls,
+			   int nrows, MemoryContext aggcontext)
+{
+	bool		isnull = *transValueIsNull;
+	float8		sum = isnull ? 0 : DatumGetFloat8(*transValue);
+
+	for (int i = 0; i < nrows; i++)
+	{
+		if (nulls[i])
+			continue;
+		if (isnull)
+			sum = DatumGetFloat8(values[i]);
+		else
+			sum = float8_pl(sum, DatumGetFloat8(values[i]));
+		isnull = false;
+	}
+	if (!isnull)
+		*transValue = Float8GetDatum(sum);
+	*transValueIsNull = isnull;
+}
+
 Datum
 float8mi(PG_FUNCTION_ARGS)
 {
@@ -2884,32 +2940,23 @@ float8_combine(PG_FUNCTION_ARGS)
 	}
 }
 
-Datum
-float8_accum(PG_FUNCTION_ARGS)
+/*
+ * Use the Youngs-Cramer algorithm to incorporate a new value into the
+ * transition values.
+ */
+static inline void
+float8_accum_value(float8 newval, float8 *N, float8 *Sx, float8 *Sxx)
 {
-	ArrayType  *transarray = PG_GETARG_ARRAYTYPE_P(0);
-	float8		newval = PG_GETARG_FLOAT8(1);
-	float8	   *transvalues;
-	float8		N,
-				Sx,
-				Sxx,
+	float8		oldN = *N,
+				oldSx = *Sx,
 				tmp;
 
-	transvalues = check_float8_array(transarray, "float8_accum", 3);
-	N = transvalues[0];
-	Sx = transvalues[1];
-	Sxx = transvalues[2];
-
-	/*
-	 * Use the Youngs-Cramer algorithm to incorporate the new value into the
-	 * transition values.
-	 */
-	N += 1.0;
-	Sx += newval;
-	if (transvalues[0] > 0.0)
+	*N += 1.0;
+	*Sx += newval;
+	if (oldN > 0.0)
 	{
-		tmp = newval * N - Sx;
-		Sxx += tmp * tmp / (N * transvalues[0]);
+		tmp = newval * *N - *Sx;
+		*Sxx += tmp * tmp / (*N * oldN);
 
 		/*
 		 * Overflow check.  We only report an overflow error when finite
@@ -2917,12 +2964,12 @@ float8_accum(PG_FUNCTION_ARGS)
 		 * if any of the inputs are infinite, so we intentionally prevent Sxx
 		 * from becoming infinite.
 		 */
-		if (isinf(Sx) || isinf(Sxx))
+		if (isinf(*Sx) || isinf(*Sxx))
 		{
-			if (!isinf(transvalues[1]) && !isinf(newval))
+			if (!isinf(oldSx) && !isinf(newval))
 				float_overflow_error();
 
-			Sxx = get_float8_nan();
+			*Sxx = get_float8_nan();
 		}
 	}
 	else
@@ -2934,8 +2981,26 @@ float8_accum(PG_FUNCTION_ARGS)
 		 * more inputs.
 		 */
 		if (isnan(newval) || isinf(newval))
-			Sxx = get_float8_nan();
+			*Sxx = get_float8_nan();
 	}
+}
+
+Datum
+float8_accum(PG_FUNCTION_ARGS)
+{
+	ArrayType  *transarray = PG_GETARG_ARRAYTYPE_P(0);
+	float8		newval = PG_GETARG_FLOAT8(1);
+	float8	   *transvalues;
+	float8		N,
+				Sx,
+				Sxx;
+
+	transvalues = check_float8_array(transarray, "float8_accum", 3);
+	N = transvalues[0];
+	Sx = transvalues[1];
+	Sxx = transvalues[2];
+
+	float8_accum_value(newval, &N, &Sx, &Sxx);
 
 	/*
 	 * If we're invoked as an aggregate, we can cheat and modify our first
@@ -2967,6 +3032,38 @@ float8_accum(PG_FUNCTION_ARGS)
 	}
 }
 
+/*
+ * Batched float8_accum, see utils/aggbatch.h.  The transition array lives in
+ * the aggregate context and is modified in place.
+ */
+void
+float8_accum_batch(Datum *transValue, bool *transValueIsNull,
+				   const Datum *values, const bool *nulls,
+				   int nrows, MemoryContext aggcontext)
+{
+	ArrayType  *transarray = DatumGetArrayTypeP(*transValue);
+	float8	   *transvalues;
+	float8		N,
+				Sx,
+				Sxx;
+
+	Assert(!*transValueIsNull);
+	transvalues = check_float8_array(transarray, "float8_accum", 3);
+	N = transvalues[0];
+	Sx = transvalues[1];
+	Sxx = transvalues[2];
+
+	for (int i = 0; i < nrows; i++)
+	{
+		if (!nulls[i])
+			float8_accum_value(DatumGetFloat8(values[i]), &N, &Sx, &Sxx);
+	}
+
+	transvalues[0] = N;
+	transvalues[1] = Sx;
+	transvalues[2] = Sxx;
+}
+
 Datum
 float4_accum(PG_FUNCTION_ARGS)
 {
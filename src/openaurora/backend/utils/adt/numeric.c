@@ -35,6 +35,7 @@
 #include "miscadmin.h"
 #include "nodes/nodeFuncs.h"
 #include "nodes/supportnodes.h"
+#include "utils/aggbatch.h"
 #include "utils/array.h"
 #include "utils/builtins.h"
 #include "utils/float.h"
@@ -3755,6 +3756,22 @@ makeNumericAggStateCurrentContext(bool calcSumX2)
 	return state;
 }
 
+/*
+ * Track the highest input dscale that we've seen, to support inverse
+ * transitions (see do_numeric_discard).
+ */
+static inline void
+numeric_accum_scale(NumericAggState *state, int dscale)
+{
+	if (dscale > state->maxScale)
+	{
+		state->maxScale = dscale;
+		state->maxScaleCount = 1;
+	}
+	else if (dscale == state->maxScale)
+		state->maxScaleCount++;
+}
+
 /*
  * Accumulate a new input value for numeric aggregate functions.
  */
@@ -3775,17 +3792,7 @@ do_numeric_accum(NumericAggState *state, Numeric newval)
 	/* load processed number in short-lived context */
 	init_var_from_num(newval, &X);
 
-	/*
-	 * Track the highest input dscale that we've seen, to support inverse
-	 * transitions (see do_numeric_discard).
-	 */
-	if (X.dscale > state->maxScale)
-	{
-		state->maxScale = X.dscale;
-		state->maxScaleCount = 1;
-	}
-	else if (X.dscale == state->maxScale)
-		state->maxScaleCount++;
+	numeric_accum_scale(state, X.dscale);
 
 	/* if we need X^2, calculate that in short-lived context */
 	if (state->calcSumX2)
@@ -4016,6 +4023,177 @@ numeric_avg_accum(PG_FUNCTION_ARGS)
 	PG_RETURN_POINTER(state);
 }
 
+/*
+ * A numeric input of a batch, unpacked into this rather than into a palloc'd
+ * copy when it has a short header.
+ */
+typedef union NumericBatchArg
+{
+	char		data[VARHDRSZ + VARATT_SHORT_MAX];
+	int32		align;
+} NumericBatchArg;
+
+static Numeric
+numeric_batch_arg(Datum value, NumericBatchArg *buf)
+{
+	struct varlena *attr = (struct varlena *) DatumGetPointer(value);
+
+	if (VARATT_IS_SHORT(attr))
+	{
+		Size		len = VARSIZE_SHORT(attr) - VARHDRSZ_SHORT;
+
+		SET_VARSIZE(buf->data, VARHDRSZ + len);
+		memcpy(buf->data + VARHDRSZ, VARDATA_SHORT(attr), len);
+		return (Numeric) buf->data;
+	}
+	return DatumGetNumeric(value);
+}
+
+#ifdef HAVE_INT128
+/*
+ * A batch sums its inputs as 128-bit integers of NBASE digits, up to this many
+ * of them at and above the scale of the sum, and at most NUMERIC_BATCH_MAX_N
+ * inputs before adding the sum to the accumulator; 10^6 inputs below 10^32
+ * don't overflow an int128.
+ */
+#define NUMERIC_BATCH_DIGITS	8
+#define NUMERIC_BATCH_MAX_N		1000000
+
+/*
+ * Convert var, scaled by NBASE^fracdigits, to an int128.  Returns false if it
+ * has more than fracdigits fractional NBASE digits, or too many digits.
+ */
+static bool
+numericvar_to_scaled_int128(const NumericVar *var, int fracdigits,
+							int128 *result)
+{
+	int			lastweight = var->weight - (var->ndigits - 1);
+	int128		val = 0;
+
+	if (var->ndigits == 0)
+	{
+		*result = 0;
+		return true;
+	}
+	if (lastweight < -fracdigits ||
+		var->weight + 1 + fracdigits > NUMERIC_BATCH_DIGITS)
+		return false;
+
+	for (int i = 0; i < var->ndigits; i++)
+		val = val * NBASE + var->digits[i];
+	/* the digits not stored down to the scale are zeroes */
+	for (int w = lastweight; w > -fracdigits; w--)
+		val *= NBASE;
+
+	*result = var->sign == NUMERIC_NEG ? -val : val;
+	return true;
+}
+
+/*
+ * Add a sum scaled by NBASE^fracdigits, of inputs of at most dscale decimal
+ * digits after the point, to the accumulator of state.
+ */
+static void
+numeric_batch_add_sum(NumericAggState *state, int128 sum, int fracdigits,
+					  int dscale)
+{
+	NumericVar	X;
+	MemoryContext old_context;
+
+	init_var(&X);
+	int128_to_numericvar(sum, &X);
+	if (X.ndigits > 0)
+		X.weight -= fracdigits;
+	X.dscale = dscale;
+
+	old_context = MemoryContextSwitchTo(state->agg_context);
+	accum_sum_add(&(state->sumX), &X);
+	MemoryContextSwitchTo(old_context);
+
+	free_var(&X);
+}
+#endif
+
+/*
+ * Batched numeric_avg_accum, see utils/aggbatch.h.  An input with no more
+ * fractional digits than the first of the batch, and not too large, is added
+ * to a 128-bit integer sum rather than to the accumulator, which the sum is
+ * added to once at the end.  The other inputs are accumulated one by one.
+ */
+void
+numeric_avg_accum_batch(Datum *transValue, bool *transValueIsNull,
+						const Datum *values, const bool *nulls,
+						int nrows, MemoryContext aggcontext)
+{
+	NumericAggState *state;
+	NumericBatchArg buf;
+#ifdef HAVE_INT128
+	int128		sum = 0;
+	int64		summed = 0;
+	int			fracdigits = -1;
+	int			sumdscale = 0;
+#endif
+
+	/* Create the state data on the first call */
+	if (*transValueIsNull)
+	{
+		MemoryContext old_context = MemoryContextSwitchTo(aggcontext);
+
+		state = makeNumericAggStateCurrentContext(false);
+		MemoryContextSwitchTo(old_context);
+
+		*transValue = PointerGetDatum(state);
+		*transValueIsNull = false;
+	}
+	state = (NumericAggState *) DatumGetPointer(*transValue);
+
+	for (int i = 0; i < nrows; i++)
+	{
+		Numeric		newval;
+#ifdef HAVE_INT128
+		NumericVar	X;
+		int128		scaled;
+#endif
+
+		if (nulls[i])
+			continue;
+		newval = numeric_batch_arg(values[i], &buf);
+
+#ifdef HAVE_INT128
+		if (NUMERIC_IS_NAN(newval))
+		{
+			state->NaNcount++;
+			continue;
+		}
+
+		init_var_from_num(newval, &X);
+		if (fracdigits < 0)
+			fracdigits = (X.dscale + DEC_DIGITS - 1) / DEC_DIGITS;
+		if (numericvar_to_scaled_int128(&X, fracdigits, &scaled))
+		{
+			numeric_accum_scale(state, X.dscale);
+			state->N++;
+
+			sum += scaled;
+			sumdscale = Max(sumdscale, X.dscale);
+			if (++summed == NUMERIC_BATCH_MAX_N)
+			{
+				numeric_batch_add_sum(state, sum, fracdigits, sumdscale);
+				sum = 0;
+				summed = 0;
+			}
+			continue;
+		}
+#endif
+		do_numeric_accum(state, newval);
+	}
+
+#ifdef HAVE_INT128
+	if (summed > 0)
+		numeric_batch_add_sum(state, sum, fracdigits, sumdscale);
+#endif
+}
+
 /*
  * Combine function for numeric aggregates which don't require sumX2
  */
@@ -4755,6 +4933,35 @@ int8_avg_accum(PG_FUNCTION_ARGS)
 	PG_RETURN_POINTER(state);
 }
 
+#ifdef HAVE_INT128
+/*
+ * Batched int8_avg_accum, see utils/aggbatch.h.
+ */
+void
+int8_avg_accum_batch(Datum *transValue, bool *transValueIsNull,
+					 const Datum *values, const bool *nulls,
+					 int nrows, MemoryContext aggcontext)
+{
+	PolyNumAggState *state;
+
+	/* Create the state data on the first call */
+	if (*transValueIsNull)
+	{
+		MemoryContext old_context = MemoryContextSwitchTo(aggcontext);
+
+		state = makePolyNumAggStateCurrentContext(false);
+		MemoryContextSwitchTo(old_context);
+
+		*transValue = PointerGetDatum(state);
+		*transValueIsNull = false;
+	}
+	state = (PolyNumAggState *) DatumGetPointer(*transValue);
+
+	state->N += AggBatchCountNotNull(nulls, nrows);
+	state->sumX += AggBatchSumInt64(values, nulls, nrows);
+}
+#endif
+
 /*
  * Combine function for PolyNumAggState for aggregates which don't require
  * sumX2
@@ -5562,6 +5769,29 @@ int4_sum(PG_FUNCTION_ARGS)
 	}
 }
 
+/*
+ * Batched int2_sum and int4_sum, see utils/aggbatch.h.  int8 is passed by
+ * value where this is called.
+ */
+void
+int4_sum_batch(Datum *transValue, bool *transValueIsNull,
+			   const Datum *values, const bool *nulls,
+			   int nrows, MemoryContext aggcontext)
+{
+	int64		sum;
+
+	/* Leave the transition value alone if there are no non-null inputs */
+	if (AggBatchCountNotNull(nulls, nrows) == 0)
+		return;
+
+	sum = AggBatchSumInt32(values, nulls, nrows);
+	if (!*transValueIsNull)
+		sum += DatumGetInt64(*transValue);
+
+	*transValue = Int64GetDatum(sum);
+	*transValueIsNull = false;
+}
+
 /*
  * Note: this function is obsolete, it's no longer used for SUM(int8).
  */
@@ -5672,6 +5902,28 @@ int4_avg_accum(PG_FUNCTION_ARGS)
 	PG_RETURN_ARRAYTYPE_P(transarray);
 }
 
+/*
+ * Batched int2_avg_accum and int4_avg_accum, see utils/aggbatch.h.  The
+ * transition array lives in the aggregate context and is modified in place.
+ */
+void
+int4_avg_accum_batch(Datum *transValue, bool *transValueIsNull,
+					 const Datum *values, const bool *nulls,
+					 int nrows, MemoryContext aggcontext)
+{
+	ArrayType  *transarray = DatumGetArrayTypeP(*transValue);
+	Int8TransTypeData *transdata;
+
+	Assert(!*transValueIsNull);
+	if (ARR_HASNULL(transarray) ||
+		ARR_SIZE(transarray) != ARR_OVERHEAD_NONULLS(1) + sizeof(Int8TransTypeData))
+		elog(ERROR, "expected 2-element int8 array");
+
+	transdata = (Int8TransTypeData *) ARR_DATA_PTR(transarray);
+	transdata->count += AggBatchCountNotNull(nulls, nrows);
+	transdata->sum += AggBatchSumInt32(values, nulls, nrows);
+}
+
 Datum
 int4_avg_combine(PG_FUNCTION_ARGS)
 {
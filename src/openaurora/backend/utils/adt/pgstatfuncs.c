@@ -26,7 +26,10 @@
 #include "postmaster/postmaster.h"
 #include "storage/proc.h"
 #include "storage/procarray.h"
+#include "storage/GroundDB/mempool_client.h"
+#include "storage/rpcclient.h"
 #include "utils/acl.h"
+#include "utils/array.h"
 #include "utils/builtins.h"
 #include "utils/inet.h"
 #include "utils/timestamp.h"
@@ -35,6 +38,8 @@
 
 #define HAS_PGSTAT_PERMISSIONS(role)	 (is_member_of_role(GetUserId(), DEFAULT_ROLE_READ_ALL_STATS) || has_privs_of_role(GetUserId(), role))
 
+extern int IsRpcClient;
+
 /* Global bgwriter statistics, from bgwriter.c */
 extern PgStat_MsgBgWriter bgwriterStats;
 
@@ -2098,3 +2103,174 @@ pg_stat_get_archiver(PG_FUNCTION_ARGS)
 	/* Returns the record as Datum */
 	PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
 }
+
+/*
+ * Replay metrics of the storage node, fetched over RPC.
+ *
+ * The storage node renders them in the Prometheus text format; every sample
+ * line becomes a row of (metric, labels, value), the comment lines are
+ * skipped.
+ */
+Datum
+pg_stat_get_smart_replay(PG_FUNCTION_ARGS)
+{
+#define PG_STAT_GET_SMART_REPLAY_COLS	3
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	TupleDesc	tupdesc;
+	Tuplestorestate *tupstore;
+	MemoryContext per_query_ctx;
+	MemoryContext oldcontext;
+	char	   *text;
+	char	   *line;
+	char	   *saveptr;
+
+	/* check to see if caller supports us returning a tuplestore */
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not allowed in this context")));
+	if (!IsRpcClient)
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("smart replay metrics are only available on compute nodes")));
+
+	/* Build a tuple descriptor for our result type */
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	per_query_ctx = rsinfo->econtext->ecxt_per_query_memory;
+	oldcontext = MemoryContextSwitchTo(per_query_ctx);
+
+	tupstore = tuplestore_begin_heap(true, false, work_mem);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = tupstore;
+	rsinfo->setDesc = tupdesc;
+
+	MemoryContextSwitchTo(oldcontext);
+
+	text = RpcGetSmartReplayMetrics();
+	for (line = strtok_r(text, "\n", &saveptr); line != NULL; line = strtok_r(NULL, "\n", &saveptr))
+	{
+		Datum		values[PG_STAT_GET_SMART_REPLAY_COLS];
+		bool		nulls[PG_STAT_GET_SMART_REPLAY_COLS];
+		char	   *name_end;
+		char	   *value;
+		char	   *end;
+
+		if (line[0] == '#' || line[0] == '\0')
+			continue;
+
+		MemSet(nulls, 0, sizeof(nulls));
+
+		name_end = line + strcspn(line, "{ ");
+		if (*name_end == '{')
+		{
+			char	   *labels = name_end + 1;
+			char	   *labels_end = strchr(labels, '}');
+
+			if (labels_end == NULL)
+				continue;
+			*labels_end = '\0';
+			values[1] = CStringGetTextDatum(labels);
+			value = labels_end + 1;
+		}
+		else
+		{
+			nulls[1] = true;
+			value = name_end;
+		}
+		*name_end = '\0';
+		values[0] = CStringGetTextDatum(line);
+
+		values[2] = Float8GetDatum(strtod(value, &end));
+		if (end == value)
+			continue;
+
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+	}
+	pfree(text);
+
+	/* clean up and return the tuplestore */
+	tuplestore_donestoring(tupstore);
+
+	return (Datum) 0;
+}
+
+/*
+ * Mempool counters of this compute node, summed up over all processes.
+ */
+Datum
+pg_stat_get_mempool(PG_FUNCTION_ARGS)
+{
+#define PG_STAT_GET_MEMPOOL_COLS	11
+	TupleDesc	tupdesc;
+	Datum		values[PG_STAT_GET_MEMPOOL_COLS];
+	bool		nulls[PG_STAT_GET_MEMPOOL_COLS];
+	Datum		latency[MEMPOOL_STAT_READ_LATENCY_BUCKETS];
+	MemPoolStatSlot stats;
+	TimestampTz reset_time;
+	int			i;
+
+	/* Initialise values and NULL flags arrays */
+	MemSet(values, 0, sizeof(values));
+	MemSet(nulls, 0, sizeof(nulls));
+
+	/* Initialise attributes information in the tuple descriptor */
+	tupdesc = CreateTemplateTupleDesc(PG_STAT_GET_MEMPOOL_COLS);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 1, "hits",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 2, "stale_hits",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 3, "misses",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 4, "read_failures",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 5, "flush_failures",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 6, "reconnects",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 7, "flushed_pages",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 8, "queued_flushes",
+					   INT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 9, "read_time",
+					   FLOAT8OID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 10, "read_latency_histogram",
+					   INT8ARRAYOID, -1, 0);
+	TupleDescInitEntry(tupdesc, (AttrNumber) 11, "stats_reset",
+					   TIMESTAMPTZOID, -1, 0);
+
+	BlessTupleDesc(tupdesc);
+
+	MemPoolStatCollect(&stats);
+	LWLockAcquire(mempool_client_stat_lock, LW_SHARED);
+	reset_time = *mpc_stat_reset_time;
+	LWLockRelease(mempool_client_stat_lock);
+
+	/* Fill values and NULLs */
+	values[0] = Int64GetDatum(stats.counters[MEMPOOL_STAT_HITS]);
+	values[1] = Int64GetDatum(stats.counters[MEMPOOL_STAT_STALE_HITS]);
+	values[2] = Int64GetDatum(stats.counters[MEMPOOL_STAT_MISSES]);
+	values[3] = Int64GetDatum(stats.counters[MEMPOOL_STAT_READ_FAILURES]);
+	values[4] = Int64GetDatum(stats.counters[MEMPOOL_STAT_FLUSH_FAILURES]);
+	values[5] = Int64GetDatum(stats.counters[MEMPOOL_STAT_RECONNECTS]);
+	values[6] = Int64GetDatum(stats.counters[MEMPOOL_STAT_FLUSHED_PAGES]);
+	values[7] = Int64GetDatum(stats.counters[MEMPOOL_STAT_QUEUED_FLUSHES]);
+	/* in milliseconds, like the other timings */
+	values[8] = Float8GetDatum((double) stats.counters[MEMPOOL_STAT_READ_TIME_US] / 1000.0);
+
+	for (i = 0; i < MEMPOOL_STAT_READ_LATENCY_BUCKETS; i++)
+		latency[i] = Int64GetDatum(stats.read_latency[i]);
+	values[9] = PointerGetDatum(construct_array(latency, MEMPOOL_STAT_READ_LATENCY_BUCKETS,
+												INT8OID, sizeof(int64), FLOAT8PASSBYVAL,
+												TYPALIGN_DOUBLE));
+
+	values[10] = TimestampTzGetDatum(reset_time);
+
+	/* Returns the record as Datum */
+	PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(tupdesc, values, nulls)));
+}
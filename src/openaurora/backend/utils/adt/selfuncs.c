@@ -6098,9 +6098,9 @@ genericcostestimate(PlannerInfo *root,
 		numIndexPages = 1.0;
 
 	/* fetch estimated page cost for tablespace containing index */
-	get_tablespace_page_costs(index->reltablespace,
-							  &spc_random_page_cost,
-							  NULL);
+	get_relation_page_costs(index->reltablespace, index->relfilenode,
+							&spc_random_page_cost,
+							NULL);
 
 	/*
 	 * Now compute the disk access costs.
@@ -7118,9 +7118,9 @@ gincostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
 											   NULL);
 
 	/* fetch estimated page cost for tablespace containing index */
-	get_tablespace_page_costs(index->reltablespace,
-							  &spc_random_page_cost,
-							  NULL);
+	get_relation_page_costs(index->reltablespace, index->relfilenode,
+							&spc_random_page_cost,
+							NULL);
 
 	/*
 	 * Generic assumption about index correlation: there isn't any.
@@ -7355,9 +7355,9 @@ brincostestimate(PlannerInfo *root, IndexPath *path, double loop_count,
 	Assert(rte->rtekind == RTE_RELATION);
 
 	/* fetch estimated page cost for the tablespace containing the index */
-	get_tablespace_page_costs(index->reltablespace,
-							  &spc_random_page_cost,
-							  &spc_seq_page_cost);
+	get_relation_page_costs(index->reltablespace, index->relfilenode,
+							&spc_random_page_cost,
+							&spc_seq_page_cost);
 
 	/*
 	 * Obtain some data from the index itself, if possible.  Otherwise invent
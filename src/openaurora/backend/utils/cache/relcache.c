@@ -73,6 +73,7 @@
 #include "optimizer/optimizer.h"
 #include "rewrite/rewriteDefine.h"
 #include "rewrite/rowsecurity.h"
+#include "storage/bufmgr.h"
 #include "storage/lmgr.h"
 #include "storage/smgr.h"
 #include "utils/array.h"
@@ -3785,6 +3786,37 @@ RelationCacheInitialize(void)
 	RelationMapInitialize();
 }
 
+/*
+ *		RelationCachePrewarmCatalogs
+ *
+ *		On a compute node every catalog page a new backend misses on is a
+ *		round trip to the storage node.  Read the first rpc_catalog_prewarm_blocks
+ *		pages of each shared or local mapped catalog, which hold what backend
+ *		startup and syscache priming look at, into shared buffers in one call
+ *		instead.  That's only paid by the first backend after a restart, or
+ *		after the pages were evicted; the others find them in shared buffers.
+ */
+void
+RelationCachePrewarmCatalogs(bool shared)
+{
+	Oid			filenodes[64];
+	RelFileNode rnodes[64];
+	int			n;
+	int			i;
+
+	if (rpc_catalog_prewarm_blocks <= 0 || IsBootstrapProcessingMode())
+		return;
+
+	n = RelationMapGetFilenodes(shared, filenodes, lengthof(filenodes));
+	for (i = 0; i < n; i++)
+	{
+		rnodes[i].spcNode = shared ? GLOBALTABLESPACE_OID : MyDatabaseTableSpace;
+		rnodes[i].dbNode = shared ? InvalidOid : MyDatabaseId;
+		rnodes[i].relNode = filenodes[i];
+	}
+	PrewarmRelationHeads(rnodes, n, rpc_catalog_prewarm_blocks);
+}
+
 /*
  *		RelationCacheInitializePhase2
  *
@@ -3868,6 +3900,8 @@ RelationCacheInitializePhase3(void)
 	 */
 	RelationMapInitializePhase3();
 
+	RelationCachePrewarmCatalogs(false);
+
 	/*
 	 * switch to cache memory context
 	 */
@@ -196,6 +196,25 @@ RelationMapOidToFilenode(Oid relationId, bool shared)
 	return InvalidOid;
 }
 
+/*
+ * RelationMapGetFilenodes
+ *
+ * Fill filenodes with the relfilenodes of up to max of the shared or the
+ * local mapped relations, and return how many there are.  Active updates are
+ * left out, so this is only good for things like prewarming, where a stale
+ * entry does no harm.
+ */
+int
+RelationMapGetFilenodes(bool shared, Oid *filenodes, int max)
+{
+	const RelMapFile *map = shared ? &shared_map : &local_map;
+	int32		i;
+
+	for (i = 0; i < map->num_mappings && i < max; i++)
+		filenodes[i] = map->mappings[i].mapfilenode;
+	return i;
+}
+
 /*
  * RelationMapFilenodeToOid
  *
@@ -0,0 +1,583 @@
+/*-------------------------------------------------------------------------
+ *
+ * sharedplancache.c
+ *	  Generic plans shared across backends.
+ *
+ * A backend about to build the generic plan of a saved statement first
+ * looks for the one another backend built for the same statement, and
+ * otherwise shares the plan it builds.  The custom-or-generic choice stays
+ * with each backend, only the planning of the generic plan is saved.  Plans
+ * are kept as nodeToString() text in a DSA area laid out in the main shared
+ * memory, indexed by a shared hash table; a plan that doesn't fit pushes out
+ * an arbitrary one.
+ *
+ * A statement is only shared between backends that would parse it the same
+ * way: the key holds the database, the role, the query text, parameter types
+ * and cursor options, the search path and the settings that change how the
+ * text or its literals are read (see spc_key_settings).  The planner's cost
+ * and enable_* settings are not part of it, a backend gets the plan made
+ * under the settings of the one that built it.  Statements whose parameters
+ * are resolved by parser hooks, like PL/pgSQL's, are never shared, as the
+ * same text means something else in every function.
+ *
+ * Invalidation rides on the sinval machinery: each backend's plan cache
+ * callbacks also drop the shared plans that depend on what changed.  Every
+ * backend processes the pending invalidations before it looks a plan up (it
+ * does so when locking the statement's relations), so a stale plan is gone
+ * by the time anybody could find it -- provided it isn't stored later by a
+ * backend that planned before the change.  To rule that out, processing an
+ * invalidation bumps a counter first, and a plan is only stored if the
+ * counter hasn't moved since its backend looked it up.  A plan's
+ * dependencies are kept as a small bloom-style mask, so an unrelated change
+ * drops a plan now and then, which only costs a replan.
+ *
+ * Portions Copyright (c) 1996-2020, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * IDENTIFICATION
+ *	  src/backend/utils/cache/sharedplancache.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "catalog/namespace.h"
+#include "common/hashfn.h"
+#include "miscadmin.h"
+#include "nodes/plannodes.h"
+#include "port/atomics.h"
+#include "storage/lwlock.h"
+#include "storage/shmem.h"
+#include "utils/dsa.h"
+#include "utils/guc.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+#include "utils/sharedplancache.h"
+
+
+/* Entries of the hash table, per kB of shared_plan_cache_size */
+#define SPC_KB_PER_ENTRY		4
+
+/* Statements with a longer search path are not shared */
+#define SPC_MAX_SEARCH_PATH		32
+
+/* How many plans a new plan may push out to find room */
+#define SPC_EVICT_TRIES			8
+
+/* Shared control data, followed by the DSA area */
+typedef struct SharedPlanCacheCtl
+{
+	LWLock		lock;			/* protects the hash table */
+	pg_atomic_uint64 generation;	/* invalidations processed so far */
+} SharedPlanCacheCtl;
+
+#define SPC_AREA(ctl) ((char *) (ctl) + MAXALIGN(sizeof(SharedPlanCacheCtl)))
+
+typedef struct SharedPlanEntry
+{
+	SharedPlanKey key;			/* hash key; must be first */
+	dsa_pointer blob;			/* SharedPlanBlob of the plan */
+	uint64		relmask;		/* bits of the relations it depends on */
+	uint64		itemmask;		/* and of its other dependencies */
+} SharedPlanEntry;
+
+/*
+ * A shared plan.  The statement is kept along, to tell it from one hashing
+ * to the same key: data holds num_params parameter types, then the query
+ * text and the plan, each NUL-terminated.
+ */
+typedef struct SharedPlanBlob
+{
+	int			cursor_options;
+	int			num_params;
+	int			query_len;
+	char		data[FLEXIBLE_ARRAY_MEMBER];
+} SharedPlanBlob;
+
+#define SPC_BLOB_QUERY(blob) \
+	((blob)->data + (blob)->num_params * sizeof(Oid))
+#define SPC_BLOB_PLAN(blob) \
+	(SPC_BLOB_QUERY(blob) + (blob)->query_len + 1)
+
+/* Settings changing how the text of a statement is read */
+static const char *const spc_key_settings[] = {
+	"DateStyle",
+	"IntervalStyle",
+	"TimeZone",
+	"lc_monetary",
+	"standard_conforming_strings",
+	"transform_null_equals",
+	"array_nulls",
+	"xmloption",
+	"row_security",
+};
+
+int			shared_plan_cache_size = 0;
+
+static SharedPlanCacheCtl *spc_ctl = NULL;
+static HTAB *spc_hash = NULL;
+static dsa_area *spc_area = NULL;
+
+static int
+spc_max_entries(void)
+{
+	return Max(shared_plan_cache_size / SPC_KB_PER_ENTRY, 64);
+}
+
+static Size
+spc_area_size(void)
+{
+	return Max((Size) shared_plan_cache_size * 1024, dsa_minimum_size());
+}
+
+/*
+ * Report shared-memory space needed by SharedPlanCacheShmemInit
+ */
+Size
+SharedPlanCacheShmemSize(void)
+{
+	Size		size;
+
+	if (shared_plan_cache_size <= 0)
+		return 0;
+
+	size = MAXALIGN(sizeof(SharedPlanCacheCtl));
+	size = add_size(size, spc_area_size());
+	size = add_size(size, hash_estimate_size(spc_max_entries(),
+											 sizeof(SharedPlanEntry)));
+	return size;
+}
+
+/*
+ * Initialize the shared plan cache during shared-memory initialization
+ */
+void
+SharedPlanCacheShmemInit(void)
+{
+	HASHCTL		info;
+	bool		found;
+
+	if (shared_plan_cache_size <= 0)
+		return;
+
+	spc_ctl = (SharedPlanCacheCtl *)
+		ShmemInitStruct("Shared Plan Cache",
+						MAXALIGN(sizeof(SharedPlanCacheCtl)) + spc_area_size(),
+						&found);
+	if (!found)
+	{
+		dsa_area   *area;
+
+		LWLockInitialize(&spc_ctl->lock, LWTRANCHE_SHARED_PLAN_CACHE);
+		pg_atomic_init_u64(&spc_ctl->generation, 0);
+
+		/*
+		 * The area never grows out of its region into DSM segments, and
+		 * stays around while backends come and go.
+		 */
+		area = dsa_create_in_place(SPC_AREA(spc_ctl), spc_area_size(),
+								   LWTRANCHE_SHARED_PLAN_CACHE_DSA, NULL);
+		dsa_set_size_limit(area, spc_area_size());
+		dsa_pin(area);
+		dsa_detach(area);
+	}
+
+	MemSet(&info, 0, sizeof(info));
+	info.keysize = sizeof(SharedPlanKey);
+	info.entrysize = sizeof(SharedPlanEntry);
+	spc_hash = ShmemInitHash("Shared Plan Cache Hash",
+							 spc_max_entries(), spc_max_entries(),
+							 &info, HASH_ELEM | HASH_BLOBS);
+}
+
+/*
+ * Attach to the DSA area on first use.  False if plans aren't shared.
+ */
+static bool
+spc_attach(void)
+{
+	if (spc_ctl == NULL)
+		return false;
+	if (spc_area == NULL)
+	{
+		MemoryContext oldcxt = MemoryContextSwitchTo(TopMemoryContext);
+
+		spc_area = dsa_attach_in_place(SPC_AREA(spc_ctl), NULL);
+		dsa_pin_mapping(spc_area);
+		MemoryContextSwitchTo(oldcxt);
+	}
+	return true;
+}
+
+/*
+ * Two bits of the 64 of a dependency mask, for a hash value.
+ */
+static inline uint64
+spc_mask_bits(uint32 hash)
+{
+	return (UINT64CONST(1) << (hash % 64)) |
+		(UINT64CONST(1) << ((hash >> 6) % 64));
+}
+
+static inline uint64
+spc_rel_bits(Oid relid)
+{
+	return spc_mask_bits(hash_bytes_uint32(relid));
+}
+
+static inline uint64
+spc_item_bits(int cacheid, uint32 hashvalue)
+{
+	return spc_mask_bits(hash_combine(hash_bytes_uint32((uint32) cacheid),
+									  hashvalue));
+}
+
+/*
+ * Whether a dependency mask has the bits of a change: of one object, or of
+ * any if bits is PG_UINT64_MAX.  Never if bits is 0.
+ */
+static inline bool
+spc_mask_matches(uint64 mask, uint64 bits)
+{
+	if (bits == PG_UINT64_MAX)
+		return mask != 0;
+	return bits != 0 && (mask & bits) == bits;
+}
+
+static void
+spc_add_dependencies(List *relationOids, List *invalItems,
+					 uint64 *relmask, uint64 *itemmask)
+{
+	ListCell   *lc;
+
+	foreach(lc, relationOids)
+		*relmask |= spc_rel_bits(lfirst_oid(lc));
+	foreach(lc, invalItems)
+	{
+		PlanInvalItem *item = (PlanInvalItem *) lfirst(lc);
+
+		*itemmask |= spc_item_bits(item->cacheId, item->hashValue);
+	}
+}
+
+/*
+ * Compute the key of plansource's statement in the current environment.
+ * False if it is not to be shared.
+ */
+static bool
+spc_make_key(CachedPlanSource *plansource, SharedPlanKey *key)
+{
+	Oid			path[SPC_MAX_SEARCH_PATH];
+	int			npath;
+	uint64		hash;
+	int			i;
+
+	npath = fetch_search_path_array(path, SPC_MAX_SEARCH_PATH);
+	if (npath > SPC_MAX_SEARCH_PATH)
+		return false;
+
+	key->dbid = MyDatabaseId;
+	key->roleid = GetUserId();
+
+	hash = hash_bytes_extended((const unsigned char *) plansource->query_string,
+							   strlen(plansource->query_string), 0);
+	if (plansource->num_params > 0)
+		hash = hash_bytes_extended((const unsigned char *) plansource->param_types,
+								   plansource->num_params * sizeof(Oid), hash);
+	key->fingerprint = hash_combine64(hash, (uint64) plansource->cursor_options);
+
+	hash = hash_bytes_extended((const unsigned char *) path,
+							   npath * sizeof(Oid), 0);
+	for (i = 0; i < lengthof(spc_key_settings); i++)
+	{
+		/* The value may be in a static buffer, hash it right away */
+		const char *value = GetConfigOption(spc_key_settings[i], true, false);
+
+		if (value != NULL)
+			hash = hash_bytes_extended((const unsigned char *) value,
+									   strlen(value), hash);
+	}
+	key->envhash = hash;
+
+	return true;
+}
+
+static bool
+spc_blob_matches(SharedPlanBlob *blob, CachedPlanSource *plansource)
+{
+	if (blob->cursor_options != plansource->cursor_options ||
+		blob->num_params != plansource->num_params)
+		return false;
+	if (plansource->num_params > 0 &&
+		memcmp(blob->data, plansource->param_types,
+			   plansource->num_params * sizeof(Oid)) != 0)
+		return false;
+	return strcmp(SPC_BLOB_QUERY(blob), plansource->query_string) == 0;
+}
+
+/*
+ * Remove one entry to make room.  Caller holds the lock exclusively.
+ */
+static bool
+spc_evict_one(void)
+{
+	HASH_SEQ_STATUS status;
+	SharedPlanEntry *entry;
+
+	hash_seq_init(&status, spc_hash);
+	entry = (SharedPlanEntry *) hash_seq_search(&status);
+	if (entry == NULL)
+		return false;
+	hash_seq_term(&status);
+
+	dsa_free(spc_area, entry->blob);
+	hash_search(spc_hash, &entry->key, HASH_REMOVE, NULL);
+	return true;
+}
+
+/*
+ * SharedPlanCacheLookup: find the generic plan of plansource's statement.
+ *
+ * Returns the list of PlannedStmts, in the caller's memory context, or NIL.
+ * lookup is filled in for SharedPlanCacheStore(), to share the plan the
+ * caller builds on a miss.
+ */
+List *
+SharedPlanCacheLookup(CachedPlanSource *plansource,
+					  QueryEnvironment *queryEnv,
+					  SharedPlanLookup *lookup)
+{
+	SharedPlanEntry *entry;
+	List	   *stmt_list = NIL;
+
+	lookup->shareable = false;
+
+	if (!plansource->is_saved || plansource->is_oneshot ||
+		plansource->raw_parse_tree == NULL ||
+		plansource->parserSetup != NULL || queryEnv != NULL)
+		return NIL;
+	if (!spc_attach())
+		return NIL;
+	if (!spc_make_key(plansource, &lookup->key))
+		return NIL;
+	lookup->shareable = true;
+
+	LWLockAcquire(&spc_ctl->lock, LW_SHARED);
+
+	lookup->generation = pg_atomic_read_u64(&spc_ctl->generation);
+	entry = (SharedPlanEntry *) hash_search(spc_hash, &lookup->key,
+											HASH_FIND, NULL);
+	if (entry != NULL)
+	{
+		SharedPlanBlob *blob = dsa_get_address(spc_area, entry->blob);
+
+		if (spc_blob_matches(blob, plansource))
+			stmt_list = (List *) stringToNode(SPC_BLOB_PLAN(blob));
+	}
+
+	LWLockRelease(&spc_ctl->lock);
+
+	return stmt_list;
+}
+
+/*
+ * SharedPlanCacheStore: share the generic plan built after a lookup missed.
+ */
+void
+SharedPlanCacheStore(SharedPlanLookup *lookup, CachedPlanSource *plansource,
+					 List *stmt_list)
+{
+	uint64		relmask = 0;
+	uint64		itemmask = 0;
+	ListCell   *lc;
+	char	   *plan;
+	Size		query_len;
+	Size		size;
+	dsa_pointer dp = InvalidDsaPointer;
+	SharedPlanBlob *blob;
+	SharedPlanEntry *entry;
+	bool		found;
+	int			tries;
+
+	if (!lookup->shareable)
+		return;
+
+	spc_add_dependencies(plansource->relationOids, plansource->invalItems,
+						 &relmask, &itemmask);
+	foreach(lc, stmt_list)
+	{
+		PlannedStmt *plannedstmt = lfirst_node(PlannedStmt, lc);
+
+		/*
+		 * Utility statements can't all be read back, and a transient plan
+		 * is only good for this backend's TransactionXmin.
+		 */
+		if (plannedstmt->commandType == CMD_UTILITY ||
+			plannedstmt->transientPlan)
+			return;
+		spc_add_dependencies(plannedstmt->relationOids,
+							 plannedstmt->invalItems, &relmask, &itemmask);
+	}
+
+	plan = nodeToString(stmt_list);
+	query_len = strlen(plansource->query_string);
+	size = offsetof(SharedPlanBlob, data) +
+		plansource->num_params * sizeof(Oid) +
+		query_len + 1 + strlen(plan) + 1;
+
+	/* Don't push out a good part of the cache for one plan */
+	if (size > spc_area_size() / 8)
+	{
+		pfree(plan);
+		return;
+	}
+
+	for (tries = 0; tries < SPC_EVICT_TRIES; tries++)
+	{
+		bool		evicted;
+
+		dp = dsa_allocate_extended(spc_area, size, DSA_ALLOC_NO_OOM);
+		if (DsaPointerIsValid(dp))
+			break;
+
+		LWLockAcquire(&spc_ctl->lock, LW_EXCLUSIVE);
+		evicted = spc_evict_one();
+		LWLockRelease(&spc_ctl->lock);
+		if (!evicted)
+			break;
+	}
+	if (!DsaPointerIsValid(dp))
+	{
+		pfree(plan);
+		return;
+	}
+
+	blob = dsa_get_address(spc_area, dp);
+	blob->cursor_options = plansource->cursor_options;
+	blob->num_params = plansource->num_params;
+	blob->query_len = query_len;
+	if (plansource->num_params > 0)
+		memcpy(blob->data, plansource->param_types,
+			   plansource->num_params * sizeof(Oid));
+	memcpy(SPC_BLOB_QUERY(blob), plansource->query_string, query_len + 1);
+	strcpy(SPC_BLOB_PLAN(blob), plan);
+	pfree(plan);
+
+	LWLockAcquire(&spc_ctl->lock, LW_EXCLUSIVE);
+
+	/*
+	 * If an invalidation was processed since the lookup, the plan may have
+	 * been made before it, and the backends that processed it wouldn't drop
+	 * it.
+	 */
+	if (pg_atomic_read_u64(&spc_ctl->generation) != lookup->generation)
+	{
+		LWLockRelease(&spc_ctl->lock);
+		dsa_free(spc_area, dp);
+		return;
+	}
+
+	entry = (SharedPlanEntry *) hash_search(spc_hash, &lookup->key,
+											HASH_FIND, NULL);
+	if (entry == NULL &&
+		hash_get_num_entries(spc_hash) >= spc_max_entries())
+		spc_evict_one();
+	entry = (SharedPlanEntry *) hash_search(spc_hash, &lookup->key,
+											HASH_ENTER_NULL, &found);
+	if (entry == NULL)
+	{
+		LWLockRelease(&spc_ctl->lock);
+		dsa_free(spc_area, dp);
+		return;
+	}
+	if (found)
+		dsa_free(spc_area, entry->blob);
+	entry->blob = dp;
+	entry->relmask = relmask;
+	entry->itemmask = itemmask;
+
+	LWLockRelease(&spc_ctl->lock);
+}
+
+/*
+ * Drop the plans whose masks match relbits or itembits, or all of them.
+ */
+static void
+spc_invalidate(uint64 relbits, uint64 itembits, bool all)
+{
+	HASH_SEQ_STATUS status;
+	SharedPlanEntry *entry;
+	bool		matched = false;
+
+	if (!spc_attach())
+		return;
+
+	/* Before looking, see SharedPlanCacheStore */
+	pg_atomic_fetch_add_u64(&spc_ctl->generation, 1);
+
+	/* Every backend processes the invalidation, most find nothing to do */
+	LWLockAcquire(&spc_ctl->lock, LW_SHARED);
+	hash_seq_init(&status, spc_hash);
+	while ((entry = (SharedPlanEntry *) hash_seq_search(&status)) != NULL)
+	{
+		if (all || spc_mask_matches(entry->relmask, relbits) ||
+			spc_mask_matches(entry->itemmask, itembits))
+		{
+			matched = true;
+			hash_seq_term(&status);
+			break;
+		}
+	}
+	LWLockRelease(&spc_ctl->lock);
+
+	if (!matched)
+		return;
+
+	LWLockAcquire(&spc_ctl->lock, LW_EXCLUSIVE);
+	hash_seq_init(&status, spc_hash);
+	while ((entry = (SharedPlanEntry *) hash_seq_search(&status)) != NULL)
+	{
+		if (all || spc_mask_matches(entry->relmask, relbits) ||
+			spc_mask_matches(entry->itemmask, itembits))
+		{
+			dsa_free(spc_area, entry->blob);
+			hash_search(spc_hash, &entry->key, HASH_REMOVE, NULL);
+		}
+	}
+	LWLockRelease(&spc_ctl->lock);
+}
+
+/*
+ * SharedPlanCacheInvalRel: drop the plans mentioning relid, or any rel at
+ * all if relid == InvalidOid.
+ */
+void
+SharedPlanCacheInvalRel(Oid relid)
+{
+	if (relid == InvalidOid)
+		spc_invalidate(PG_UINT64_MAX, 0, false);
+	else
+		spc_invalidate(spc_rel_bits(relid), 0, false);
+}
+
+/*
+ * SharedPlanCacheInvalObject: drop the plans mentioning the object of
+ * cacheid with the given hash value, or any of them if hashvalue == 0.
+ */
+void
+SharedPlanCacheInvalObject(int cacheid, uint32 hashvalue)
+{
+	if (hashvalue == 0)
+		spc_invalidate(0, PG_UINT64_MAX, false);
+	else
+		spc_invalidate(0, spc_item_bits(cacheid, hashvalue), false);
+}
+
+/*
+ * SharedPlanCacheReset: drop all shared plans.
+ */
+void
+SharedPlanCacheReset(void)
+{
+	spc_invalidate(0, 0, true);
+}
@@ -536,6 +536,15 @@ InitializeMaxBackends(void)
 	/* internal error because the values were all checked previously */
 	if (MaxBackends > MAX_BACKENDS)
 		elog(ERROR, "too many backends configured");
+
+	/*
+	 * Give each backend enough fast-path lock slots for the relation locks
+	 * of a typical transaction, so they stay off the main lock table.
+	 */
+	FastPathLockGroupsPerBackend = 1;
+	while (FastPathLockGroupsPerBackend < FP_LOCK_GROUPS_PER_BACKEND_MAX &&
+		   FastPathLockSlotsPerBackend() < max_locks_per_xact)
+		FastPathLockGroupsPerBackend *= 2;
 }
 
 /*
@@ -739,6 +748,9 @@ InitPostgres(const char *in_dbname, Oid dboid, const char *username,
 		 */
 		XactIsoLevel = XACT_READ_COMMITTED;
 
+		/* Shared catalog pages in one round trip, see relcache.c */
+		RelationCachePrewarmCatalogs(true);
+
 		(void) GetTransactionSnapshot();
 	}
 
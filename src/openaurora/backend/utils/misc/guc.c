@@ -26,12 +26,21 @@
 #include <syslog.h>
 #endif
 
+#include "access/background_hashmap_vacuumer.h"
+#include "access/clog.h"
 #include "access/commit_ts.h"
 #include "access/gin.h"
+#include "access/heaptoast.h"
+#include "access/multixact.h"
+#include "access/parallelredo.h"
 #include "access/rmgr.h"
+#include "access/slru.h"
+#include "access/subtrans.h"
 #include "access/tableam.h"
 #include "access/transam.h"
+#include "access/toast_compression.h"
 #include "access/twophase.h"
+#include "access/wal_retention.h"
 #include "access/xact.h"
 #include "access/xlog_internal.h"
 #include "catalog/namespace.h"
@@ -44,6 +53,10 @@
 #include "commands/vacuum.h"
 #include "commands/variable.h"
 #include "common/string.h"
+#include "executor/nodeAgg.h"
+#include "executor/nodeHashjoin.h"
+#include "executor/nodeIndexscan.h"
+#include "executor/nodeSeqscan.h"
 #include "funcapi.h"
 #include "jit/jit.h"
 #include "libpq/auth.h"
@@ -71,16 +84,45 @@
 #include "replication/slot.h"
 #include "replication/syncrep.h"
 #include "replication/walreceiver.h"
+#include "replication/wal_ship_compress.h"
 #include "replication/walsender.h"
+#include "storage/adaptive_sr.h"
+#include "storage/smart_replay_metrics.h"
+#include "storage/stage_timing.h"
 #include "storage/bufmgr.h"
+#include "storage/compressed_page_cache.h"
 #include "storage/dsm_impl.h"
 #include "storage/fd.h"
+#include "storage/GroundDB/mempool_client.h"
+#include "storage/kv_engine.h"
+#include "storage/kv_interface.h"
+#include "storage/kv_page_cache.h"
+#include "storage/kv_tier.h"
 #include "storage/large_object.h"
+#include "storage/local_page_cache.h"
+#include "storage/map_page_cache.h"
+#include "storage/buf_change_feed.h"
+#include "storage/buf_numa.h"
+#include "storage/buf_resident_summary.h"
+#include "storage/buf_warm_start.h"
 #include "storage/pg_shmem.h"
 #include "storage/predicate.h"
 #include "storage/proc.h"
+#include "storage/rpcclient.h"
+#include "storage/rpc_agg.h"
+#include "storage/rpc_fetch_cost.h"
+#include "storage/rpc_vacuum.h"
+#include "storage/rpc_zonemap.h"
+#include "storage/rpc_file_cache.h"
+#include "storage/rpc_lanes.h"
+#include "storage/rpc_scan.h"
+#include "storage/rpc_shm.h"
+#include "storage/rpc_rdma.h"
 #include "storage/standby.h"
+#include "storage/wal_read_cache.h"
+#include "tcop/base_page_reader.h"
 #include "tcop/tcopprot.h"
+#include "tcop/wal_redo_pool.h"
 #include "tsearch/ts_cache.h"
 #include "utils/acl.h"
 #include "utils/builtins.h"
@@ -94,6 +136,7 @@
 #include "utils/portal.h"
 #include "utils/ps_status.h"
 #include "utils/rls.h"
+#include "utils/sharedplancache.h"
 #include "utils/snapmgr.h"
 #include "utils/tzparser.h"
 #include "utils/varlena.h"
@@ -219,6 +262,7 @@ static bool check_recovery_target_name(char **newval, void **extra, GucSource so
 static void assign_recovery_target_name(const char *newval, void *extra);
 static bool check_recovery_target_lsn(char **newval, void **extra, GucSource source);
 static void assign_recovery_target_lsn(const char *newval, void *extra);
+static void assign_rpc_as_of_lsn(const char *newval, void *extra);
 static bool check_primary_slot_name(char **newval, void **extra, GucSource source);
 static bool check_default_with_oids(bool *newval, void **extra, GucSource source);
 
@@ -456,6 +500,30 @@ static const struct config_enum_entry force_parallel_mode_options[] = {
 	{NULL, 0, false}
 };
 
+/*
+ * wal_compression used to be a boolean, compressing with pglz when on, so
+ * accept all the likely variants of "on" and "off".
+ */
+static const struct config_enum_entry wal_compression_options[] = {
+	{"pglz", WAL_COMPRESSION_PGLZ, false},
+	{"lz4", WAL_COMPRESSION_LZ4, false},
+	{"on", WAL_COMPRESSION_PGLZ, false},
+	{"off", WAL_COMPRESSION_NONE, false},
+	{"true", WAL_COMPRESSION_PGLZ, true},
+	{"false", WAL_COMPRESSION_NONE, true},
+	{"yes", WAL_COMPRESSION_PGLZ, true},
+	{"no", WAL_COMPRESSION_NONE, true},
+	{"1", WAL_COMPRESSION_PGLZ, true},
+	{"0", WAL_COMPRESSION_NONE, true},
+	{NULL, 0, false}
+};
+
+static const struct config_enum_entry default_toast_compression_options[] = {
+	{"pglz", TOAST_PGLZ_COMPRESSION_ID, false},
+	{"lz4", TOAST_LZ4_COMPRESSION_ID, false},
+	{NULL, 0, false}
+};
+
 static const struct config_enum_entry plan_cache_mode_options[] = {
 	{"auto", PLAN_CACHE_MODE_AUTO, false},
 	{"force_generic_plan", PLAN_CACHE_MODE_FORCE_GENERIC_PLAN, false},
@@ -490,6 +558,26 @@ const struct config_enum_entry ssl_protocol_versions_info[] = {
 StaticAssertDecl(lengthof(ssl_protocol_versions_info) == (PG_TLS1_3_VERSION + 2),
 				 "array length mismatch");
 
+static const struct config_enum_entry mempool_admission_options[] = {
+	{"all", MEMPOOL_ADMIT_ALL, false},
+	{"adaptive", MEMPOOL_ADMIT_ADAPTIVE, false},
+	{NULL, 0, false}
+};
+
+static const struct config_enum_entry mempool_huge_pages_options[] = {
+	{"off", MEMPOOL_HUGE_PAGES_OFF, false},
+	{"2MB", MEMPOOL_HUGE_PAGES_2MB, false},
+	{"1GB", MEMPOOL_HUGE_PAGES_1GB, false},
+	{NULL, 0, false}
+};
+
+static const struct config_enum_entry wal_ship_compression_options[] = {
+	{"off", WAL_SHIP_COMPRESSION_OFF, false},
+	{"lz4", WAL_SHIP_COMPRESSION_LZ4, false},
+	{"zstd", WAL_SHIP_COMPRESSION_ZSTD, false},
+	{NULL, 0, false}
+};
+
 static struct config_enum_entry shared_memory_options[] = {
 #ifndef WIN32
 	{"sysv", SHMEM_TYPE_SYSV, false},
@@ -619,6 +707,7 @@ static char *recovery_target_string;
 static char *recovery_target_xid_string;
 static char *recovery_target_name_string;
 static char *recovery_target_lsn_string;
+static char *rpc_as_of_lsn_string;
 
 
 /* should be static, but commands/variable.c needs to get at this */
@@ -941,6 +1030,17 @@ static struct config_bool ConfigureNamesBool[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"enable_batch_seqscan", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enables evaluating the quals of sequential scans a page at a time."),
+			gettext_noop("Comparisons and integer arithmetic on integer, oid and date columns "
+						 "are evaluated over the visible tuples of a page together."),
+			GUC_EXPLAIN
+		},
+		&enable_batch_seqscan,
+		true,
+		NULL, NULL, NULL
+	},
 	{
 		{"enable_indexscan", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enables the planner's use of index-scan plans."),
@@ -1010,6 +1110,17 @@ static struct config_bool ConfigureNamesBool[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"enable_batch_agg", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enables advancing aggregates a batch of input rows at a time."),
+			gettext_noop("The transition functions of count(), and of sum() and avg() over "
+						 "integer, float and numeric inputs, consume many rows per call."),
+			GUC_EXPLAIN
+		},
+		&enable_batch_agg,
+		true,
+		NULL, NULL, NULL
+	},
 	{
 		{"enable_material", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enables the planner's use of materialization."),
@@ -1040,6 +1151,16 @@ static struct config_bool ConfigureNamesBool[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"enable_hashjoin_bloom", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enables hash joins to filter their outer scan by a bloom filter of the inner keys."),
+			NULL,
+			GUC_EXPLAIN
+		},
+		&enable_hashjoin_bloom,
+		true,
+		NULL, NULL, NULL
+	},
 	{
 		{"enable_hashjoin", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enables the planner's use of hash join plans."),
@@ -1090,6 +1211,16 @@ static struct config_bool ConfigureNamesBool[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"enable_async_append", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enables the planner's use of async append plans."),
+			NULL,
+			GUC_EXPLAIN
+		},
+		&enable_async_append,
+		true,
+		NULL, NULL, NULL
+	},
 	{
 		{"enable_parallel_hash", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enables the planner's use of parallel hash plans."),
@@ -1263,16 +1394,6 @@ static struct config_bool ConfigureNamesBool[] =
 		NULL, NULL, NULL
 	},
 
-	{
-		{"wal_compression", PGC_SUSET, WAL_SETTINGS,
-			gettext_noop("Compresses full-page writes written in WAL file."),
-			NULL
-		},
-		&wal_compression,
-		false,
-		NULL, NULL, NULL
-	},
-
 	{
 		{"wal_init_zero", PGC_SUSET, WAL_SETTINGS,
 			gettext_noop("Writes zeroes to new WAL files before first use."),
@@ -1848,6 +1969,226 @@ static struct config_bool ConfigureNamesBool[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"asr_enable", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Enables the adaptive smart replay controller on the storage server."),
+			NULL
+		},
+		&asr_enable,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_verbose_metrics", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Logs the adaptive smart replay metrics on every controller cycle."),
+			NULL
+		},
+		&asr_verbose_metrics,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_tenant_per_relation", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Shares the adaptive smart replay budget between relations rather than databases."),
+			NULL
+		},
+		&asr_tenant_per_relation,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"kv_page_disable_wal", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Writes page versions to the storage node KV store without its WAL."),
+			gettext_noop("Versions lost in a crash are replayed again from the xlog.")
+		},
+		&kv_page_disable_wal,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"kv_page_compaction_gc", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Drops obsolete page versions in KV store compaction instead of deleting them."),
+			gettext_noop("Versions older than the newest one at or below the oldest compute node LSN are dropped.")
+		},
+		&kv_page_compaction_gc,
+		true,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"kv_per_database", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Keeps the page versions of each database in a KV store instance of its own."),
+			gettext_noop("Their compactions don't hold up each other, and a dropped database's store is "
+						 "removed as a whole. An existing KV store keeps the setting it was created with.")
+		},
+		&kv_per_database,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"numa_buffer_partitions", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Partitions shared buffers by NUMA node and binds each backend to one node."),
+			gettext_noop("Backends look for victim buffers in the partition of their node first.")
+		},
+		&numa_buffer_partitions,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"page_change_feed", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Refreshes buffers from the page change feed of the storage node instead of redoing page records."),
+			gettext_noop("Records that change no page are still redone.")
+		},
+		&page_change_feed,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"buffer_warm_start", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Records the buffers in use and reads them back when the node starts."),
+			gettext_noop("They are read before the node accepts connections.")
+		},
+		&buffer_warm_start,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"base_page_direct_read", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Reads never versioned pages from the relation files in the RPC server threads."),
+			gettext_noop("Otherwise they are read by a WAL redo process.")
+		},
+		&base_page_direct_read,
+		true,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"base_page_mmap", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Reads never versioned pages through memory mappings of the relation segments."),
+			gettext_noop("Applies to the segment files opened after it is set; needs base_page_direct_read.")
+		},
+		&base_page_mmap,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_shared_memory_reads", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Reads pages through shared memory from a storage node on the same host."),
+			gettext_noop("Set up for every new connection; other calls, and nodes on other hosts, use TCP.")
+		},
+		&rpc_shared_memory_reads,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_disaggregated_checkpoint", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Checkpoints without writing dirty buffers, once the storage node has parsed the WAL."),
+			gettext_noop("Dirty buffers are then only written when evicted.")
+		},
+		&rpc_disaggregated_checkpoint,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_local_hint_bits", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Keeps hint bit updates in the compute node's buffers."),
+			gettext_noop("A page whose only change is a hint isn't dirtied, WAL-logged or "
+						 "written back; its hints are set again after it is evicted.")
+		},
+		&rpc_local_hint_bits,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_verify_page_checksums", PGC_SUSET, REPLICATION_STANDBY,
+			gettext_noop("Verifies the checksum of every page read from the storage node."),
+			gettext_noop("The storage node computes the checksum of each page it serves. "
+						 "A page that fails it is read once more, and fails the read "
+						 "if it is damaged again.")
+		},
+		&rpc_verify_page_checksums,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_install_evicted_pages", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sends the pages a primary evicts after changing them to the storage node."),
+			gettext_noop("The storage node installs them as replayed versions where that saves "
+						 "replaying their WAL when they are read next.")
+		},
+		&rpc_install_evicted_pages,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_instant_recovery", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Leaves the page redo of crash recovery to the storage node."),
+			gettext_noop("Only the records rebuilding the transaction status are redone, "
+						 "and connections are accepted without an end-of-recovery checkpoint.")
+		},
+		&rpc_instant_recovery,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_toast_prefetch", PGC_USERSET, REPLICATION_STANDBY,
+			gettext_noop("Fetches the toast pages of a large value together."),
+			gettext_noop("The toast index is read first for the pages, which are then "
+						 "fetched from the storage node a batch at a time.")
+		},
+		&rpc_toast_prefetch,
+		true,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_agg_pushdown", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enables computing partial aggregates on the storage node."),
+			NULL,
+			GUC_EXPLAIN
+		},
+		&rpc_agg_pushdown,
+		true,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_measured_page_costs", PGC_USERSET, QUERY_TUNING_COST,
+			gettext_noop("Scales page costs by the fetch latencies measured in RPC mode."),
+			gettext_noop("The cost of a relation's pages follows how long its "
+						 "single and batched fetches from the storage node took."),
+			GUC_EXPLAIN
+		},
+		&rpc_measured_page_costs,
+		false,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_vacuum_triage", PGC_USERSET, CLIENT_CONN_STATEMENT,
+			gettext_noop("Lets the storage node find the pages vacuum needn't read."),
+			NULL
+		},
+		&rpc_vacuum_triage,
+		true,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"allow_system_table_mods", PGC_SUSET, DEVELOPER_OPTIONS,
 			gettext_noop("Allows modifications of the structure of system tables."),
@@ -2106,6 +2447,15 @@ static struct config_int ConfigureNamesInt[] =
 		8, 1, INT_MAX,
 		NULL, NULL, NULL
 	},
+	{
+		{"jit_cache_size", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Sets the number of JIT compiled modules kept for reuse by later queries."),
+			gettext_noop("0 compiles the expressions of every query afresh.")
+		},
+		&jit_cache_size,
+		64, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
 	{
 		{"geqo_threshold", PGC_USERSET, QUERY_TUNING_GEQO,
 			gettext_noop("Sets the threshold of FROM items beyond which GEQO is used."),
@@ -2127,90 +2477,503 @@ static struct config_int ConfigureNamesInt[] =
 		NULL, NULL, NULL
 	},
 	{
-		{"geqo_pool_size", PGC_USERSET, QUERY_TUNING_GEQO,
-			gettext_noop("GEQO: number of individuals in the population."),
-			gettext_noop("Zero selects a suitable default value."),
-			GUC_EXPLAIN
+		{"geqo_pool_size", PGC_USERSET, QUERY_TUNING_GEQO,
+			gettext_noop("GEQO: number of individuals in the population."),
+			gettext_noop("Zero selects a suitable default value."),
+			GUC_EXPLAIN
+		},
+		&Geqo_pool_size,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+	{
+		{"geqo_generations", PGC_USERSET, QUERY_TUNING_GEQO,
+			gettext_noop("GEQO: number of iterations of the algorithm."),
+			gettext_noop("Zero selects a suitable default value."),
+			GUC_EXPLAIN
+		},
+		&Geqo_generations,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		/* This is PGC_SUSET to prevent hiding from log_lock_waits. */
+		{"deadlock_timeout", PGC_SUSET, LOCK_MANAGEMENT,
+			gettext_noop("Sets the time to wait on a lock before checking for deadlock."),
+			NULL,
+			GUC_UNIT_MS
+		},
+		&DeadlockTimeout,
+		1000, 1, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"max_standby_archive_delay", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the maximum delay before canceling queries when a hot standby server is processing archived WAL data."),
+			NULL,
+			GUC_UNIT_MS
+		},
+		&max_standby_archive_delay,
+		30 * 1000, -1, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"max_standby_streaming_delay", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the maximum delay before canceling queries when a hot standby server is processing streamed WAL data."),
+			NULL,
+			GUC_UNIT_MS
+		},
+		&max_standby_streaming_delay,
+		30 * 1000, -1, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"recovery_min_apply_delay", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the minimum delay for applying changes during recovery."),
+			NULL,
+			GUC_UNIT_MS
+		},
+		&recovery_min_apply_delay,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"wal_receiver_status_interval", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the maximum interval between WAL receiver status reports to the sending server."),
+			NULL,
+			GUC_UNIT_S
+		},
+		&wal_receiver_status_interval,
+		10, 0, INT_MAX / 1000,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"wal_receiver_timeout", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the maximum wait time to receive data from the sending server."),
+			NULL,
+			GUC_UNIT_MS
+		},
+		&wal_receiver_timeout,
+		60 * 1000, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_min_budget", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the smallest replay budget the adaptive smart replay controller uses."),
+			NULL
+		},
+		&asr_min_budget,
+		10, 1, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_max_budget", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the largest replay budget the adaptive smart replay controller uses."),
+			NULL
+		},
+		&asr_max_budget,
+		2000, 1, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_hysteresis", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the smallest replay budget change the adaptive smart replay controller applies."),
+			NULL
+		},
+		&asr_hysteresis,
+		20, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_smoothing_ms", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the time constant of the adaptive smart replay metric averages."),
+			NULL,
+			GUC_UNIT_MS
+		},
+		&asr_smoothing_ms,
+		1000, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_controller_interval", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the period of the adaptive smart replay controller."),
+			NULL,
+			GUC_UNIT_MS
+		},
+		&asr_controller_interval,
+		200, 10, 60000,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_min_replayers", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the fewest background replayer threads adaptive smart replay keeps running."),
+			NULL
+		},
+		&asr_min_replayers,
+		1, 1, BACKGROUND_REPLAYER_MAX_THREADS,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_max_replayers", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the most background replayer threads adaptive smart replay runs."),
+			NULL
+		},
+		&asr_max_replayers,
+		8, 1, BACKGROUND_REPLAYER_MAX_THREADS,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_min_replayer_sleep_us", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the background replayer sleep in microseconds under the heaviest load."),
+			NULL
+		},
+		&asr_min_replayer_sleep_us,
+		100, 0, 1000000,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_max_replayer_sleep_us", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the background replayer sleep in microseconds when idle."),
+			NULL
+		},
+		&asr_max_replayer_sleep_us,
+		10000, 0, 1000000,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_min_redo_processes", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the fewest redo processes adaptive smart replay keeps in service."),
+			NULL
+		},
+		&asr_min_redo_processes,
+		1, 1, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_max_redo_processes", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the most redo processes adaptive smart replay puts in service."),
+			NULL
+		},
+		&asr_max_redo_processes,
+		WAL_REDO_POOL_DEFAULT_MAX, 1, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_metrics_port", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the port the storage server serves replay metrics on over HTTP."),
+			gettext_noop("0 disables the endpoint.")
+		},
+		&asr_metrics_port,
+		0, 0, 65535,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"stage_timing_sample_rate", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets one in how many page read stages the storage server times."),
+			gettext_noop("0 turns stage timing off.")
+		},
+		&stage_timing_sample_rate,
+		16, 0, 1048576,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"kv_page_batch_size", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets how many page version writes the storage node commits to the KV store at once."),
+			gettext_noop("1 writes each page version on its own.")
+		},
+		&kv_page_batch_size,
+		32, 1, 4096,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"kv_page_batch_delay", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the longest time page version writes wait for a KV store commit."),
+			NULL,
+			GUC_UNIT_MS
+		},
+		&kv_page_batch_delay,
+		5, 1, 1000,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"kv_page_delta_versions", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets how many page versions are stored as deltas after each full version."),
+			gettext_noop("0 stores every page version in full. Deltas need kv_page_compaction_gc.")
+		},
+		&kv_page_delta_versions,
+		0, 0, 64,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"kv_compaction_rate_limit", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the rate, in megabytes per second, the KV store flushes and compacts at."),
+			gettext_noop("One limit for all of the KV store instances. 0 doesn't limit it.")
+		},
+		&kv_compaction_rate_limit,
+		0, 0, 1024 * 1024,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"kv_page_cache_size", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the size of the storage node's cache of the newest page versions."),
+			gettext_noop("0 reads every page version from the KV store."),
+			GUC_UNIT_BLOCKS
+		},
+		&kv_page_cache_size,
+		16384, 0, INT_MAX / 2,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_zonemap_size", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the number of block range summaries the storage node keeps for pushed down scans."),
+			gettext_noop("0 reads every block of a pushed down scan.")
+		},
+		&rpc_zonemap_size,
+		65536, 0, INT_MAX / 2,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"wal_ship_window", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the number of WAL writes kept in flight to the storage node."),
+			gettext_noop("1 waits for each write before sending the next.")
+		},
+		&wal_ship_window,
+		4, 1, 64,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"wal_read_cache_size", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the WAL each process of a compute node keeps after reading it from the storage node."),
+			gettext_noop("Used by walsenders, logical decoding and recovery of replicas. 0 turns it off."),
+			GUC_UNIT_KB
+		},
+		&wal_read_cache_size,
+		16384, 0, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"wal_readahead_size", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets how much WAL recovery reads from a segment at a time."),
+			gettext_noop("Only WAL that can't change any more is read ahead. Also bounds the "
+						 "pages a batch of records read by the WAL redo process may span. "
+						 "1 reads a page at a time."),
+			GUC_UNIT_XBLOCKS
+		},
+		&wal_readahead_size,
+		32, 1, 8192,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_small_file_size", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the largest file a read-only open on the storage node sends back whole."),
+			gettext_noop("Such a file is then read and closed without further round trips. 0 turns it off."),
+			GUC_UNIT_KB
+		},
+		&rpc_small_file_size,
+		64, 0, 16384,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_file_metadata_lease", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets how long a backend answers a stat of a storage node file from what it saw last."),
+			gettext_noop("Changes by other backends can go unseen that long. 0 turns it off."),
+			GUC_UNIT_MS
+		},
+		&rpc_file_metadata_lease,
+		1000, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_catalog_prewarm_blocks", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets how many pages of each mapped catalog a starting backend reads in one call to the storage node."),
+			gettext_noop("Only if they aren't in shared buffers yet. 0 turns it off.")
+		},
+		&rpc_catalog_prewarm_blocks,
+		8, 0, 1024,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_warm_backends", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets how many backends the postmaster keeps started and connected to the storage node ahead of their clients."),
+			gettext_noop("A new connection is handed to one of them instead of a new process. 0 turns it off.")
+		},
+		&rpc_warm_backends,
+		0, 0, 64,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_redo_workers", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets how many background workers redo the pages in buffers of a compute node's hot standby."),
+			gettext_noop("Each page is redone by the worker its tag hashes to. They are "
+						 "taken from max_worker_processes. 0 has the startup process redo them.")
+		},
+		&rpc_redo_workers,
+		0, 0, 64,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_parallel_scan_chunk", PGC_USERSET, REPLICATION_STANDBY,
+			gettext_noop("Sets how many consecutive blocks a parallel scan hands a worker at a time."),
+			gettext_noop("The worker reads them from the storage node a batch at a time. "
+						 "Chunks get smaller towards the end of the scan.")
+		},
+		&rpc_parallel_scan_chunk,
+		64, 1, 8192,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_index_prefetch_distance", PGC_USERSET, REPLICATION_STANDBY,
+			gettext_noop("Sets how many TIDs an index scan reads ahead to fetch their heap pages."),
+			gettext_noop("The pages are fetched from the storage node together. 0 turns it off.")
+		},
+		&rpc_index_prefetch_distance,
+		32, 0, 256,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_request_queue_timeout", PGC_USERSET, REPLICATION_STANDBY,
+			gettext_noop("Sets how long a page request may queue on a busy storage node."),
+			gettext_noop("A request queued longer is turned away and sent again once the node "
+						 "says it can take it. 0 waits as long as it takes."),
+			GUC_UNIT_MS
+		},
+		&rpc_request_queue_timeout,
+		0, 0, INT_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_rdma_port", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the port of the storage node's RDMA listener pages are read over."),
+			gettext_noop("Set up for every new connection without a shared memory segment; "
+						 "other calls use TCP. 0 reads over TCP only.")
+		},
+		&rpc_rdma_port,
+		0, 0, 65535,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"buffer_warm_start_interval", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets how often the buffers in use are recorded for a warm start."),
+			gettext_noop("Only used with buffer_warm_start. 0 turns recording off."),
+			GUC_UNIT_S
 		},
-		&Geqo_pool_size,
-		0, 0, INT_MAX,
+		&buffer_warm_start_interval,
+		300, 0, INT_MAX / 1000,
 		NULL, NULL, NULL
 	},
+
 	{
-		{"geqo_generations", PGC_USERSET, QUERY_TUNING_GEQO,
-			gettext_noop("GEQO: number of iterations of the algorithm."),
-			gettext_noop("Zero selects a suitable default value."),
-			GUC_EXPLAIN
+		{"buffer_resident_summary_interval", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets how often the storage node is sent a summary of the pages in shared buffers."),
+			gettext_noop("The storage node defers the background replay of those pages. 0 turns the summaries off."),
+			GUC_UNIT_MS
 		},
-		&Geqo_generations,
-		0, 0, INT_MAX,
+		&buffer_resident_summary_interval,
+		0, 0, INT_MAX / 1000,
 		NULL, NULL, NULL
 	},
 
 	{
-		/* This is PGC_SUSET to prevent hiding from log_lock_waits. */
-		{"deadlock_timeout", PGC_SUSET, LOCK_MANAGEMENT,
-			gettext_noop("Sets the time to wait on a lock before checking for deadlock."),
-			NULL,
-			GUC_UNIT_MS
+		{"local_page_cache_size", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the size of the compute node's page cache on its local SSD."),
+			gettext_noop("Only used with local_page_cache_path."),
+			GUC_UNIT_BLOCKS
 		},
-		&DeadlockTimeout,
-		1000, 1, INT_MAX,
+		&local_page_cache_size,
+		131072, 0, INT_MAX / 2,
 		NULL, NULL, NULL
 	},
 
 	{
-		{"max_standby_archive_delay", PGC_SIGHUP, REPLICATION_STANDBY,
-			gettext_noop("Sets the maximum delay before canceling queries when a hot standby server is processing archived WAL data."),
-			NULL,
-			GUC_UNIT_MS
+		{"map_page_cache_size", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the memory a compute node keeps its evicted visibility map and free space map pages in."),
+			gettext_noop("0 turns the cache off."),
+			GUC_UNIT_BLOCKS
 		},
-		&max_standby_archive_delay,
-		30 * 1000, -1, INT_MAX,
+		&map_page_cache_size,
+		4096, 0, INT_MAX / BLCKSZ,
 		NULL, NULL, NULL
 	},
 
 	{
-		{"max_standby_streaming_delay", PGC_SIGHUP, REPLICATION_STANDBY,
-			gettext_noop("Sets the maximum delay before canceling queries when a hot standby server is processing streamed WAL data."),
-			NULL,
-			GUC_UNIT_MS
+		{"index_page_cache_size", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the memory a compute node keeps its evicted B-tree root and internal pages in."),
+			gettext_noop("0 turns the cache off."),
+			GUC_UNIT_BLOCKS
 		},
-		&max_standby_streaming_delay,
-		30 * 1000, -1, INT_MAX,
+		&index_page_cache_size,
+		4096, 0, INT_MAX / BLCKSZ,
 		NULL, NULL, NULL
 	},
 
 	{
-		{"recovery_min_apply_delay", PGC_SIGHUP, REPLICATION_STANDBY,
-			gettext_noop("Sets the minimum delay for applying changes during recovery."),
-			NULL,
-			GUC_UNIT_MS
+		{"compressed_page_cache_size", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the memory a compute node keeps its evicted pages in, compressed."),
+			gettext_noop("0 turns the cache off."),
+			GUC_UNIT_BLOCKS
 		},
-		&recovery_min_apply_delay,
-		0, 0, INT_MAX,
+		&compressed_page_cache_size,
+		0, 0, INT_MAX / BLCKSZ,
 		NULL, NULL, NULL
 	},
 
 	{
-		{"wal_receiver_status_interval", PGC_SIGHUP, REPLICATION_STANDBY,
-			gettext_noop("Sets the maximum interval between WAL receiver status reports to the sending server."),
-			NULL,
-			GUC_UNIT_S
+		{"kv_tier_min_age", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets how much WAL a page must go unchanged for below the compute nodes before it is moved to the object store."),
+			gettext_noop("Only used with kv_tier_path."),
+			GUC_UNIT_MB
 		},
-		&wal_receiver_status_interval,
-		10, 0, INT_MAX / 1000,
+		&kv_tier_min_age,
+		4096, 0, INT_MAX,
 		NULL, NULL, NULL
 	},
 
 	{
-		{"wal_receiver_timeout", PGC_SIGHUP, REPLICATION_STANDBY,
-			gettext_noop("Sets the maximum wait time to receive data from the sending server."),
-			NULL,
-			GUC_UNIT_MS
+		{"wal_retention_compress_age", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets how far below the parsed WAL a segment of the storage node must be before it is compressed."),
+			gettext_noop("-1 never compresses the retained WAL."),
+			GUC_UNIT_MB
 		},
-		&wal_receiver_timeout,
-		60 * 1000, 0, INT_MAX,
+		&wal_retention_compress_age,
+		-1, -1, INT_MAX,
 		NULL, NULL, NULL
 	},
 
@@ -2328,6 +3091,17 @@ static struct config_int ConfigureNamesInt[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"shared_plan_cache_size", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the amount of shared memory used to share generic plans across sessions."),
+			gettext_noop("0 turns sharing off."),
+			GUC_UNIT_KB
+		},
+		&shared_plan_cache_size,
+		0, 0, MAX_KILOBYTES,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"maintenance_work_mem", PGC_USERSET, RESOURCES_MEM,
 			gettext_noop("Sets the maximum memory to be used for maintenance operations."),
@@ -2451,6 +3225,50 @@ static struct config_int ConfigureNamesInt[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"transaction_buffers", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the number of shared memory buffers used for the transaction status cache."),
+			gettext_noop("0 sizes it from shared_buffers."),
+			GUC_UNIT_BLOCKS
+		},
+		&transaction_buffers,
+		0, 0, SLRU_MAX_ALLOWED_BUFFERS,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"subtransaction_buffers", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the number of shared memory buffers used for the subtransaction cache."),
+			NULL,
+			GUC_UNIT_BLOCKS
+		},
+		&subtransaction_buffers,
+		NUM_SUBTRANS_BUFFERS, 4, SLRU_MAX_ALLOWED_BUFFERS,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"multixact_offset_buffers", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the number of shared memory buffers used for the MultiXact offset cache."),
+			NULL,
+			GUC_UNIT_BLOCKS
+		},
+		&multixact_offset_buffers,
+		NUM_MULTIXACTOFFSET_BUFFERS, 4, SLRU_MAX_ALLOWED_BUFFERS,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"multixact_member_buffers", PGC_POSTMASTER, RESOURCES_MEM,
+			gettext_noop("Sets the number of shared memory buffers used for the MultiXact member cache."),
+			NULL,
+			GUC_UNIT_BLOCKS
+		},
+		&multixact_member_buffers,
+		NUM_MULTIXACTMEMBER_BUFFERS, 4, SLRU_MAX_ALLOWED_BUFFERS,
+		NULL, NULL, NULL
+	},
+
 #ifdef LOCK_DEBUG
 	{
 		{"trace_lock_oidmin", PGC_SUSET, DEVELOPER_OPTIONS,
@@ -2711,6 +3529,16 @@ static struct config_int ConfigureNamesInt[] =
 		check_wal_buffers, NULL, NULL
 	},
 
+	{
+		{"wal_insert_locks", PGC_POSTMASTER, WAL_SETTINGS,
+			gettext_noop("Sets the number of locks allowing WAL insertions to proceed concurrently."),
+			gettext_noop("-1 sets it based on the number of CPUs.")
+		},
+		&XLOGInsertLocks,
+		-1, -1, MAX_XLOGINSERT_LOCKS,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"wal_writer_delay", PGC_SIGHUP, WAL_SETTINGS,
 			gettext_noop("Time between WAL flushes performed in the WAL writer."),
@@ -2999,6 +3827,20 @@ static struct config_int ConfigureNamesInt[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"max_parallel_apply_workers_per_subscription",
+			PGC_SIGHUP,
+			REPLICATION_SUBSCRIBERS,
+			gettext_noop("Maximum number of parallel apply workers per subscription."),
+			gettext_noop("Transactions changing disjoint tables are applied by "
+						 "that many workers at once, committed in the order of "
+						 "the publisher. Zero applies them one at a time.")
+		},
+		&max_parallel_apply_workers_per_subscription,
+		0, 0, MAX_PARALLEL_WORKER_LIMIT,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"log_rotation_age", PGC_SIGHUP, LOGGING_WHERE,
 			gettext_noop("Automatic log file rotation will occur after N minutes."),
@@ -3359,6 +4201,16 @@ static struct config_int ConfigureNamesInt[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"max_stats_tables", PGC_POSTMASTER, STATS_COLLECTOR,
+			gettext_noop("Sets the maximum number of tables, and of functions, statistics are kept for."),
+			gettext_noop("The statistics of objects beyond this many are not counted.")
+		},
+		&pgstat_max_tables,
+		16384, 100, INT_MAX / 4,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"gin_pending_list_limit", PGC_USERSET, CLIENT_CONN_STATEMENT,
 			gettext_noop("Sets the maximum size of the pending list for GIN index."),
@@ -3661,6 +4513,127 @@ static struct config_real ConfigureNamesReal[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"asr_queue_target", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the number of unreplayed page versions the adaptive smart replay controller aims for."),
+			NULL
+		},
+		&asr_queue_target,
+		100.0, 1.0, DBL_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_parse_gap_target", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the bytes of unparsed WAL the adaptive smart replay controller aims for."),
+			NULL
+		},
+		&asr_parse_gap_target,
+		16.0 * 1024 * 1024, 1.0, DBL_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_miss_rate_target", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the fraction of reads waiting for replay the adaptive smart replay controller aims for."),
+			NULL
+		},
+		&asr_miss_rate_target,
+		0.05, 0.0001, 1.0,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_wal_rate_target", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the WAL ingest rate in bytes per second above which adaptive smart replay speeds up."),
+			NULL
+		},
+		&asr_wal_rate_target,
+		10.0 * 1024 * 1024, 1.0, DBL_MAX,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_queue_weight", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the weight of the replay backlog in the adaptive smart replay error."),
+			NULL
+		},
+		&asr_queue_weight,
+		0.3, 0.0, 1.0,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_miss_weight", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the weight of the hot miss rate in the adaptive smart replay error."),
+			NULL
+		},
+		&asr_miss_weight,
+		0.6, 0.0, 1.0,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_wal_weight", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the weight of the WAL ingest rate in the adaptive smart replay error."),
+			NULL
+		},
+		&asr_wal_weight,
+		0.1, 0.0, 1.0,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_max_step", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the largest change of adaptive smart replay aggressiveness per second."),
+			NULL
+		},
+		&asr_max_step,
+		1.0, 0.001, 1000.0,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_kp", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the proportional gain of the adaptive smart replay controller."),
+			NULL
+		},
+		&asr_kp,
+		0.5, 0.0, 100.0,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_ki", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the integral gain of the adaptive smart replay controller, per second."),
+			NULL
+		},
+		&asr_ki,
+		0.5, 0.0, 100.0,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"asr_tenant_demand_share", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the fraction of the background replay capacity shared out by tenant demand."),
+			gettext_noop("The rest is split equally between the tenants.")
+		},
+		&asr_tenant_demand_share,
+		0.8, 0.0, 1.0,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_scan_pushdown_selectivity", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Sets the highest selectivity of a qual a scan has the storage node check."),
+			gettext_noop("Zero turns off filtering pages on the storage node."),
+			GUC_EXPLAIN
+		},
+		&rpc_scan_pushdown_selectivity,
+		0.01, 0.0, 1.0,
+		NULL, NULL, NULL
+	},
+
 	/* End-of-list marker */
 	{
 		{NULL, 0, 0, NULL, NULL}, NULL, 0.0, 0.0, 0.0, NULL, NULL, NULL
@@ -4313,6 +5286,47 @@ static struct config_string ConfigureNamesString[] =
 		check_synchronous_standby_names, assign_synchronous_standby_names, NULL
 	},
 
+	{
+		{"asr_tenant_weights", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Sets the adaptive smart replay weights of databases, as a list of oid:weight."),
+			gettext_noop("Databases not listed weigh 1."),
+			GUC_LIST_INPUT
+		},
+		&asr_tenant_weights,
+		"",
+		NULL, NULL, NULL
+	},
+
+	{
+		{"kv_engine", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the storage engine of the storage node's KV store."),
+			gettext_noop("rocksdb, memory or ssd, or an engine registered by an extension.")
+		},
+		&kv_engine,
+		"rocksdb",
+		NULL, NULL, NULL
+	},
+
+	{
+		{"kv_tier_path", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the directory cold page versions are moved to."),
+			gettext_noop("Usually the mount of an S3-compatible bucket. An empty string keeps them all in the KV store.")
+		},
+		&kv_tier_path,
+		"",
+		NULL, NULL, NULL
+	},
+
+	{
+		{"local_page_cache_path", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the file on a local SSD that pages evicted from shared buffers are kept in."),
+			gettext_noop("An empty string reads them all from the storage node again.")
+		},
+		&local_page_cache_path,
+		"",
+		NULL, NULL, NULL
+	},
+
 	{
 		{"default_text_search_config", PGC_USERSET, CLIENT_CONN_LOCALE,
 			gettext_noop("Sets default text search configuration."),
@@ -4430,6 +5444,17 @@ static struct config_string ConfigureNamesString[] =
 		check_backtrace_functions, assign_backtrace_functions, NULL
 	},
 
+	{
+		{"rpc_as_of_lsn", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Pins the pages this compute node reads to a past LSN."),
+			gettext_noop("The node has to start as a hot standby and pauses its recovery there. "
+						 "Empty reads the newest pages.")
+		},
+		&rpc_as_of_lsn_string,
+		"",
+		check_recovery_target_lsn, assign_rpc_as_of_lsn, NULL
+	},
+
 	/* End-of-list marker */
 	{
 		{NULL, 0, 0, NULL, NULL}, NULL, NULL, NULL, NULL, NULL
@@ -4459,6 +5484,17 @@ static struct config_enum ConfigureNamesEnum[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"default_toast_compression", PGC_USERSET, CLIENT_CONN_STATEMENT,
+			gettext_noop("Sets the default compression method for compressible values."),
+			gettext_noop("Columns can choose their own with the \"compression\" attribute option.")
+		},
+		&default_toast_compression,
+		TOAST_PGLZ_COMPRESSION_ID,
+		default_toast_compression_options,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"client_min_messages", PGC_USERSET, CLIENT_CONN_STATEMENT,
 			gettext_noop("Sets the message levels that are sent to the client."),
@@ -4677,6 +5713,16 @@ static struct config_enum ConfigureNamesEnum[] =
 		NULL, assign_xlog_sync_method, NULL
 	},
 
+	{
+		{"wal_compression", PGC_SUSET, WAL_SETTINGS,
+			gettext_noop("Compresses full-page writes written in WAL file with specified method."),
+			NULL
+		},
+		&wal_compression,
+		WAL_COMPRESSION_NONE, wal_compression_options,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"xmlbinary", PGC_USERSET, CLIENT_CONN_STATEMENT,
 			gettext_noop("Sets how binary values are to be encoded in XML."),
@@ -4766,6 +5812,59 @@ static struct config_enum ConfigureNamesEnum[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"mempool_admission", PGC_SUSET, REPLICATION_STANDBY,
+			gettext_noop("Selects which pages evicted from shared buffers are kept in the memory pool."),
+			gettext_noop("adaptive skips the pages of scans with a buffer ring and takes a page "
+						 "only the second time it is evicted.")
+		},
+		&mempool_admission,
+		MEMPOOL_ADMIT_ALL, mempool_admission_options,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"wal_ship_compression", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Compresses the WAL a compute node ships to the storage nodes."),
+			gettext_noop("A walreceiver asks its walsender to compress what it streams.")
+		},
+		&wal_ship_compression,
+		WAL_SHIP_COMPRESSION_OFF, wal_ship_compression_options,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"rpc_page_compression", PGC_SIGHUP, REPLICATION_STANDBY,
+			gettext_noop("Compresses the pages storage nodes send this compute node."),
+			gettext_noop("Asked on every new connection; a page that doesn't shrink comes uncompressed.")
+		},
+		&rpc_page_compression,
+		WAL_SHIP_COMPRESSION_OFF, wal_ship_compression_options,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"wal_sender_compression", PGC_BACKEND, REPLICATION_SENDING,
+			gettext_noop("Compresses the WAL streamed to this connection."),
+			gettext_noop("Set by a walreceiver with wal_ship_compression."),
+			GUC_NOT_IN_SAMPLE | GUC_DISALLOW_IN_FILE
+		},
+		&wal_sender_compression,
+		WAL_SHIP_COMPRESSION_OFF, wal_ship_compression_options,
+		NULL, NULL, NULL
+	},
+
+	{
+		{"mempool_huge_pages", PGC_POSTMASTER, REPLICATION_STANDBY,
+			gettext_noop("Sets the largest pages backing the RDMA buffers of the memory pool client."),
+			gettext_noop("Smaller huge pages, then transparent huge pages, then ordinary "
+						 "pages are used when none of that size are free.")
+		},
+		&mempool_huge_pages,
+		MEMPOOL_HUGE_PAGES_2MB, mempool_huge_pages_options,
+		NULL, NULL, NULL
+	},
+
 	/* End-of-list marker */
 	{
 		{NULL, 0, 0, NULL, NULL}, NULL, 0, NULL, NULL, NULL, NULL
@@ -11984,6 +13083,15 @@ assign_recovery_target_lsn(const char *newval, void *extra)
 		recoveryTarget = RECOVERY_TARGET_UNSET;
 }
 
+static void
+assign_rpc_as_of_lsn(const char *newval, void *extra)
+{
+	if (newval && strcmp(newval, "") != 0)
+		RpcAsOfLsn = *((XLogRecPtr *) extra);
+	else
+		RpcAsOfLsn = InvalidXLogRecPtr;
+}
+
 static bool
 check_primary_slot_name(char **newval, void **extra, GucSource source)
 {
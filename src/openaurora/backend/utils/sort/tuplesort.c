@@ -148,9 +148,10 @@ bool		optimize_bounded_sort = true;
 /*
  * The objects we actually sort are SortTuple structs.  These contain
  * a pointer to the tuple proper (might be a MinimalTuple or IndexTuple),
- * which is a separate palloc chunk --- we assume it is just one chunk and
- * can be freed by a simple pfree() (except during merge, when we use a
- * simple slab allocator).  SortTuples also contain the tuple's first key
+ * which is a separate palloc chunk --- we assume it is just one chunk, in
+ * tuplecontext, and only freed along with all the others by a reset of that
+ * context (or a simple pfree() in a bounded sort, and a slab allocator
+ * during merge).  SortTuples also contain the tuple's first key
  * column in Datum/nullflag format, and a source/input tape number that
  * tracks which tape each heap element/slot belongs to during merging.
  *
@@ -286,9 +287,10 @@ struct Tuplesortstate
 	 * Function to write a stored tuple onto tape.  The representation of the
 	 * tuple on tape need not be the same as it is in memory; requirements on
 	 * the tape representation are given below.  Unless the slab allocator is
-	 * used, after writing the tuple, pfree() the out-of-line data (not the
-	 * SortTuple struct!), and increase state->availMem by the amount of
-	 * memory space thereby released.
+	 * used, after writing the tuple, increase state->availMem by the amount
+	 * of memory space of the out-of-line data (not the SortTuple struct!).
+	 * The caller frees that data by resetting tuplecontext once the whole
+	 * run is written.
 	 */
 	void		(*writetup) (Tuplesortstate *state, int tapenum,
 							 SortTuple *stup);
@@ -678,6 +680,242 @@ static void tuplesort_updatemax(Tuplesortstate *state);
  */
 #include "qsort_tuple.c"
 
+/*
+ * Radix sort of the memtuples, for a first key whose comparator is one of
+ * the ssup_datum_*_cmp() functions.  Such a key orders the same as the
+ * unsigned integer we get from datum1 by flipping the sign bit (and all bits
+ * for a descending key), so the tuples are distributed on that integer a byte
+ * at a time, most significant first, in place (an "American flag" sort).
+ * Buckets that get small, and tuples whose keys are equal all the way down,
+ * are left to the quicksort routines, which also break ties on the other
+ * keys, the full value behind an abbreviated key, or the heap TID in index
+ * builds.
+ */
+#define RADIX_SORT_MIN_TUPLES	1024
+#define RADIX_SORT_QSORT_BELOW	64
+
+typedef enum
+{
+	RADIX_KEY_UNSIGNED,
+	RADIX_KEY_SIGNED,
+	RADIX_KEY_INT32
+} RadixKeyKind;
+
+typedef struct
+{
+	Tuplesortstate *state;
+	SortSupport ssup;
+	RadixKeyKind kind;
+	int			nlevels;		/* bytes of the normalized key */
+	bool		tiebreak;		/* equal datum1s still need comparetup */
+} RadixSortContext;
+
+/* datum1 as an unsigned key in the high bytes of a uint64 */
+static inline uint64
+radix_norm_key(const RadixSortContext *cxt, Datum datum)
+{
+	uint64		key;
+
+	switch (cxt->kind)
+	{
+		case RADIX_KEY_INT32:
+			key = (uint64) ((uint32) DatumGetInt32(datum) ^ ((uint32) 1 << 31)) << 32;
+			break;
+#if SIZEOF_DATUM >= 8
+		case RADIX_KEY_SIGNED:
+			key = (uint64) datum ^ ((uint64) 1 << 63);
+			break;
+#endif
+		default:
+			key = (uint64) datum << (64 - 8 * SIZEOF_DATUM);
+			break;
+	}
+	if (cxt->ssup->ssup_reverse)
+		key = ~key;
+	return key;
+}
+
+static inline int
+radix_digit(const RadixSortContext *cxt, const SortTuple *tuple, int level)
+{
+	return (int) ((radix_norm_key(cxt, tuple->datum1) >> (56 - 8 * level)) & 0xFF);
+}
+
+/* Sorts tuples no radix pass is worth spending on */
+static void
+radix_sort_finish(RadixSortContext *cxt, SortTuple *tuples, size_t n)
+{
+	if (n < 2)
+		return;
+	if (cxt->tiebreak)
+		qsort_tuple(tuples, n, cxt->state->comparetup, cxt->state);
+	else
+		qsort_ssup(tuples, n, cxt->ssup);
+}
+
+/* Sorts non-null tuples whose keys agree on the bytes before level */
+static void
+radix_sort_level(RadixSortContext *cxt, SortTuple *tuples, size_t n,
+				 int level)
+{
+	size_t		count[256];
+	size_t		next[256];
+	size_t		end[256];
+	size_t		offset;
+
+	for (; level < cxt->nlevels; level++)
+	{
+		int			digit = -1;
+
+		if (n < RADIX_SORT_QSORT_BELOW)
+		{
+			radix_sort_finish(cxt, tuples, n);
+			return;
+		}
+
+		CHECK_FOR_INTERRUPTS();
+
+		memset(count, 0, sizeof(count));
+		for (size_t i = 0; i < n; i++)
+			count[radix_digit(cxt, &tuples[i], level)]++;
+
+		/* If every key has the same byte here, go on to the next one */
+		for (int d = 0; d < 256; d++)
+		{
+			if (count[d] == n)
+				digit = d;
+			if (count[d] != 0)
+				break;
+		}
+		if (digit < 0)
+			break;
+	}
+
+	if (level == cxt->nlevels)
+	{
+		/* The keys are all equal */
+		if (cxt->tiebreak)
+			qsort_tuple(tuples, n, cxt->state->comparetup, cxt->state);
+		return;
+	}
+
+	offset = 0;
+	for (int d = 0; d < 256; d++)
+	{
+		next[d] = offset;
+		offset += count[d];
+		end[d] = offset;
+	}
+
+	/* Swap each tuple into its bucket, until every bucket is full */
+	for (int d = 0; d < 256; d++)
+	{
+		while (next[d] < end[d])
+		{
+			SortTuple	tuple = tuples[next[d]];
+			int			target = radix_digit(cxt, &tuple, level);
+
+			while (target != d)
+			{
+				SortTuple	displaced = tuples[next[target]];
+
+				tuples[next[target]++] = tuple;
+				tuple = displaced;
+				target = radix_digit(cxt, &tuple, level);
+			}
+			tuples[next[d]++] = tuple;
+		}
+	}
+
+	offset = 0;
+	for (int d = 0; d < 256; d++)
+	{
+		if (count[d] > 1)
+			radix_sort_level(cxt, tuples + offset, count[d], level + 1);
+		offset += count[d];
+	}
+}
+
+/*
+ * Sorts the memtuples with a radix sort if the first key allows it.  Returns
+ * false, having done nothing, if it doesn't.
+ */
+static bool
+radix_sort_tuple(Tuplesortstate *state)
+{
+	RadixSortContext cxt;
+	SortTuple  *tuples = state->memtuples;
+	size_t		n = state->memtupcount;
+	size_t		nnulls = 0;
+	SortTuple  *nulls;
+	SortTuple  *notnulls;
+
+	if (n < RADIX_SORT_MIN_TUPLES || state->sortKeys == NULL)
+		return false;
+
+	cxt.state = state;
+	cxt.ssup = state->sortKeys;
+	if (cxt.ssup->comparator == ssup_datum_unsigned_cmp)
+	{
+		cxt.kind = RADIX_KEY_UNSIGNED;
+		cxt.nlevels = SIZEOF_DATUM;
+	}
+#if SIZEOF_DATUM >= 8
+	else if (cxt.ssup->comparator == ssup_datum_signed_cmp)
+	{
+		cxt.kind = RADIX_KEY_SIGNED;
+		cxt.nlevels = 8;
+	}
+#endif
+	else if (cxt.ssup->comparator == ssup_datum_int32_cmp)
+	{
+		cxt.kind = RADIX_KEY_INT32;
+		cxt.nlevels = 4;
+	}
+	else
+		return false;
+	cxt.tiebreak = (state->onlyKey == NULL);
+
+	/* Move the NULLs to the end of the array they sort to */
+	if (cxt.ssup->ssup_nulls_first)
+	{
+		for (size_t i = 0; i < n; i++)
+		{
+			if (tuples[i].isnull1)
+			{
+				SortTuple	tmp = tuples[nnulls];
+
+				tuples[nnulls++] = tuples[i];
+				tuples[i] = tmp;
+			}
+		}
+		nulls = tuples;
+		notnulls = tuples + nnulls;
+	}
+	else
+	{
+		size_t		nnotnulls = 0;
+
+		for (size_t i = 0; i < n; i++)
+		{
+			if (!tuples[i].isnull1)
+			{
+				SortTuple	tmp = tuples[nnotnulls];
+
+				tuples[nnotnulls++] = tuples[i];
+				tuples[i] = tmp;
+			}
+		}
+		nnulls = n - nnotnulls;
+		notnulls = tuples;
+		nulls = tuples + nnotnulls;
+	}
+
+	if (cxt.tiebreak && nnulls > 1)
+		qsort_tuple(nulls, nnulls, state->comparetup, state);
+	radix_sort_level(&cxt, notnulls, n - nnulls, 0);
+	return true;
+}
 
 /*
  *		tuplesort_begin_xxx
@@ -825,10 +1063,14 @@ tuplesort_begin_batch(Tuplesortstate *state)
 	 * fragmentation. Note that the memtuples array of SortTuples is allocated
 	 * in the parent context, not this context, because there is no need to
 	 * free memtuples early.
+	 *
+	 * The tuples are only ever freed all at once, by those resets, so they
+	 * go to a bump context, which packs them without rounding them up to a
+	 * power of 2.  tuplesort_set_bound() replaces it for a bounded sort.
 	 */
-	state->tuplecontext = AllocSetContextCreate(state->sortcontext,
-												"Caller tuples",
-												ALLOCSET_DEFAULT_SIZES);
+	state->tuplecontext = BumpContextCreate(state->sortcontext,
+											"Caller tuples",
+											ALLOCSET_DEFAULT_SIZES);
 
 	state->status = TSS_INITIAL;
 	state->bounded = false;
@@ -1121,6 +1363,64 @@ tuplesort_begin_index_btree(Relation heapRel,
 	return state;
 }
 
+Tuplesortstate *
+tuplesort_begin_index_gist(Relation heapRel,
+						   Relation indexRel,
+						   int workMem,
+						   SortCoordinate coordinate,
+						   bool randomAccess)
+{
+	Tuplesortstate *state = tuplesort_begin_common(workMem, coordinate,
+												   randomAccess);
+	MemoryContext oldcontext;
+	int			i;
+
+	oldcontext = MemoryContextSwitchTo(state->maincontext);
+
+#ifdef TRACE_SORT
+	if (trace_sort)
+		elog(LOG,
+			 "begin index sort: workMem = %d, randomAccess = %c",
+			 workMem, randomAccess ? 't' : 'f');
+#endif
+
+	state->nKeys = IndexRelationGetNumberOfKeyAttributes(indexRel);
+
+	state->comparetup = comparetup_index_btree;
+	state->copytup = copytup_index;
+	state->writetup = writetup_index;
+	state->readtup = readtup_index;
+	state->abbrevNext = 10;
+
+	state->heapRel = heapRel;
+	state->indexRel = indexRel;
+
+	/* Prepare SortSupport data for each column */
+	state->sortKeys = (SortSupport) palloc0(state->nKeys *
+											sizeof(SortSupportData));
+
+	for (i = 0; i < state->nKeys; i++)
+	{
+		SortSupport sortKey = state->sortKeys + i;
+
+		sortKey->ssup_cxt = CurrentMemoryContext;
+		sortKey->ssup_collation = indexRel->rd_indcollation[i];
+		sortKey->ssup_nulls_first = false;
+		sortKey->ssup_attno = i + 1;
+		/* Convey if abbreviation optimization is applicable in principle */
+		sortKey->abbreviate = (i == 0);
+
+		AssertState(sortKey->ssup_attno != 0);
+
+		/* Look for a sort support function */
+		PrepareSortSupportFromGistIndexRel(indexRel, sortKey);
+	}
+
+	MemoryContextSwitchTo(oldcontext);
+
+	return state;
+}
+
 Tuplesortstate *
 tuplesort_begin_index_hash(Relation heapRel,
 						   Relation indexRel,
@@ -1281,6 +1581,15 @@ tuplesort_set_bound(Tuplesortstate *state, int64 bound)
 	state->bounded = true;
 	state->bound = (int) bound;
 
+	/*
+	 * The bounded heap frees each tuple it discards, which the bump context
+	 * of tuplesort_begin_batch() doesn't support.
+	 */
+	MemoryContextDelete(state->tuplecontext);
+	state->tuplecontext = AllocSetContextCreate(state->sortcontext,
+												"Caller tuples",
+												ALLOCSET_DEFAULT_SIZES);
+
 	/*
 	 * Bounded sorts are not an effective target for abbreviated key
 	 * optimization.  Disable by setting state to be consistent with no
@@ -1652,12 +1961,15 @@ tuplesort_putindextuplevalues(Tuplesortstate *state, Relation rel,
 							  ItemPointer self, Datum *values,
 							  bool *isnull)
 {
-	MemoryContext oldcontext = MemoryContextSwitchTo(state->tuplecontext);
+	MemoryContext oldcontext;
 	SortTuple	stup;
 	Datum		original;
 	IndexTuple	tuple;
 
-	stup.tuple = index_form_tuple(RelationGetDescr(rel), values, isnull);
+	/* Values detoasted or compressed on the way are freed in our context */
+	stup.tuple = index_form_tuple_context(RelationGetDescr(rel), values,
+										  isnull, state->tuplecontext);
+	oldcontext = MemoryContextSwitchTo(state->tuplecontext);
 	tuple = ((IndexTuple) stup.tuple);
 	tuple->t_tid = *self;
 	USEMEM(state, GetMemoryChunkSpace(stup.tuple));
@@ -3171,11 +3483,8 @@ dumptuples(Tuplesortstate *state, bool alltuples)
 	}
 
 	/*
-	 * Reset tuple memory.  We've freed all of the tuples that we previously
-	 * allocated.  It's important to avoid fragmentation when there is a stark
-	 * change in the sizes of incoming tuples.  Fragmentation due to
-	 * AllocSetFree's bucketing by size class might be particularly bad if
-	 * this step wasn't taken.
+	 * Reset tuple memory, which frees all of the tuples that we previously
+	 * allocated and just wrote out.
 	 */
 	MemoryContextReset(state->tuplecontext);
 
@@ -3474,6 +3783,8 @@ sort_bounded_heap(Tuplesortstate *state)
  * Sort all memtuples using specialized qsort() routines.
  *
  * Quicksort is used for small in-memory sorts, and external sort runs.
+ * Large sorts on an integer or abbreviated first key are radix sorted
+ * instead, see radix_sort_tuple().
  */
 static void
 tuplesort_sort_memtuples(Tuplesortstate *state)
@@ -3482,6 +3793,9 @@ tuplesort_sort_memtuples(Tuplesortstate *state)
 
 	if (state->memtupcount > 1)
 	{
+		if (radix_sort_tuple(state))
+			return;
+
 		/* Can we use the single-key sort function? */
 		if (state->onlyKey != NULL)
 			qsort_ssup(state->memtuples, state->memtupcount,
@@ -3835,11 +4149,9 @@ writetup_heap(Tuplesortstate *state, int tapenum, SortTuple *stup)
 		LogicalTapeWrite(state->tapeset, tapenum,
 						 (void *) &tuplen, sizeof(tuplen));
 
+	/* dumptuples() frees the tuple with the rest of tuplecontext */
 	if (!state->slabAllocatorUsed)
-	{
 		FREEMEM(state, GetMemoryChunkSpace(tuple));
-		heap_free_minimal_tuple(tuple);
-	}
 }
 
 static void
@@ -4075,11 +4387,9 @@ writetup_cluster(Tuplesortstate *state, int tapenum, SortTuple *stup)
 		LogicalTapeWrite(state->tapeset, tapenum,
 						 &tuplen, sizeof(tuplen));
 
+	/* dumptuples() frees the tuple with the rest of tuplecontext */
 	if (!state->slabAllocatorUsed)
-	{
 		FREEMEM(state, GetMemoryChunkSpace(tuple));
-		heap_freetuple(tuple);
-	}
 }
 
 static void
@@ -4330,11 +4640,9 @@ writetup_index(Tuplesortstate *state, int tapenum, SortTuple *stup)
 		LogicalTapeWrite(state->tapeset, tapenum,
 						 (void *) &tuplen, sizeof(tuplen));
 
+	/* dumptuples() frees the tuple with the rest of tuplecontext */
 	if (!state->slabAllocatorUsed)
-	{
 		FREEMEM(state, GetMemoryChunkSpace(tuple));
-		pfree(tuple);
-	}
 }
 
 static void
@@ -4423,11 +4731,9 @@ writetup_datum(Tuplesortstate *state, int tapenum, SortTuple *stup)
 		LogicalTapeWrite(state->tapeset, tapenum,
 						 (void *) &writtenlen, sizeof(writtenlen));
 
+	/* dumptuples() frees the datum with the rest of tuplecontext */
 	if (!state->slabAllocatorUsed && stup->tuple)
-	{
 		FREEMEM(state, GetMemoryChunkSpace(stup->tuple));
-		pfree(stup->tuple);
-	}
 }
 
 static void
@@ -4700,3 +5006,44 @@ free_sort_tuple(Tuplesortstate *state, SortTuple *stup)
 	FREEMEM(state, GetMemoryChunkSpace(stup->tuple));
 	pfree(stup->tuple);
 }
+
+int
+ssup_datum_unsigned_cmp(Datum x, Datum y, SortSupport ssup)
+{
+	if (x < y)
+		return -1;
+	else if (x > y)
+		return 1;
+	else
+		return 0;
+}
+
+#if SIZEOF_DATUM >= 8
+int
+ssup_datum_signed_cmp(Datum x, Datum y, SortSupport ssup)
+{
+	int64		xx = DatumGetInt64(x);
+	int64		yy = DatumGetInt64(y);
+
+	if (xx < yy)
+		return -1;
+	else if (xx > yy)
+		return 1;
+	else
+		return 0;
+}
+#endif
+
+int
+ssup_datum_int32_cmp(Datum x, Datum y, SortSupport ssup)
+{
+	int32		xx = DatumGetInt32(x);
+	int32		yy = DatumGetInt32(y);
+
+	if (xx < yy)
+		return -1;
+	else if (xx > yy)
+		return 1;
+	else
+		return 0;
+}
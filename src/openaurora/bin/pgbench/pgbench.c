@@ -233,6 +233,7 @@ int			agg_interval;		/* log aggregates instead of individual
 bool		per_script_stats = false;	/* whether to collect stats per script */
 int			progress = 0;		/* thread progress report every this seconds */
 bool		progress_timestamp = false; /* progress report with Unix time */
+bool		storage_metrics = false;	/* report OpenAurora storage metrics */
 int			nclients = 1;		/* number of clients */
 int			nthreads = 1;		/* number of threads */
 bool		is_connect;			/* establish connection for each transaction */
@@ -246,10 +247,23 @@ char	   *dbName;
 char	   *logfile_prefix = NULL;
 const char *progname;
 
+/*
+ * OpenAurora read replicas, other compute nodes on the same storage, whose
+ * replay lag behind the benchmarked node is reported with the progress.
+ */
+#define MAX_REPLICAS	8
+
+char	   *replica_conninfo[MAX_REPLICAS];
+int			num_replicas = 0;
+
 #define WSEP '@'				/* weight separator */
 
 volatile bool timer_exceeded = false;	/* flag from signal handler */
 
+/* connections sampling OpenAurora metrics, used by thread 0 during the run */
+static PGconn *monitor_con = NULL;
+static PGconn *replica_con[MAX_REPLICAS];
+
 /*
  * Variable definitions.
  *
@@ -299,6 +313,28 @@ typedef struct StatsData
 	SimpleStats lag;
 } StatsData;
 
+/*
+ * Counters and gauges of the OpenAurora storage node and of the mempool, as
+ * seen from the benchmarked compute node (--storage-metrics).  The counters
+ * are reported as differences between two samples.
+ */
+typedef struct DisaggStats
+{
+	bool		valid;			/* sampled successfully? */
+	double		reads;			/* page reads the storage node served */
+	double		hot_misses;		/* ... of which waited for replay */
+	double		replay_tasks;	/* records replayed by the redo processes */
+	double		unreplayed;		/* page versions not replayed yet */
+	double		replay_queue;	/* smoothed replay queue length */
+	double		replay_budget;	/* records a redo process replays per call */
+	int64		mempool_hits;
+	int64		mempool_stale_hits;
+	int64		mempool_misses;
+} DisaggStats;
+
+static DisaggStats disagg_start;	/* sampled when the run starts */
+static DisaggStats progress_disagg; /* sampled with the last progress report */
+
 /*
  * Struct to keep random state.
  */
@@ -484,7 +520,9 @@ typedef enum MetaCommand
 	META_IF,					/* \if */
 	META_ELIF,					/* \elif */
 	META_ELSE,					/* \else */
-	META_ENDIF					/* \endif */
+	META_ENDIF,					/* \endif */
+	META_STARTPIPELINE,			/* \startpipeline */
+	META_ENDPIPELINE			/* \endpipeline */
 } MetaCommand;
 
 typedef enum QueryMode
@@ -586,6 +624,29 @@ static const BuiltinScript builtin_script[] =
 		"<builtin: select only>",
 		"\\set aid random(1, " CppAsString2(naccounts) " * :scale)\n"
 		"SELECT abalance FROM pgbench_accounts WHERE aid = :aid;\n"
+	},
+
+	/*
+	 * Updates skewed onto few accounts pile versions onto few pages, so that
+	 * the storage node replays long chains on demand; run select-only on a
+	 * read replica alongside to see its lag grow.
+	 */
+	{
+		"hot-update",
+		"<builtin: skewed update>",
+		"\\set aid random_zipfian(1, " CppAsString2(naccounts) " * :scale, 1.1)\n"
+		"\\set delta random(-5000, 5000)\n"
+		"BEGIN;\n"
+		"UPDATE pgbench_accounts SET abalance = abalance + :delta WHERE aid = :aid;\n"
+		"SELECT abalance FROM pgbench_accounts WHERE aid = :aid;\n"
+		"END;\n"
+	},
+	/* Scans of consecutive pages, which compute nodes read in batches */
+	{
+		"range-select",
+		"<builtin: range select>",
+		"\\set aid random(1, " CppAsString2(naccounts) " * :scale - 999)\n"
+		"SELECT sum(abalance) FROM pgbench_accounts WHERE aid BETWEEN :aid AND :aid + 999;\n"
 	}
 };
 
@@ -674,8 +735,10 @@ usage(void)
 		   "                           (default: \"pgbench_log\")\n"
 		   "  --progress-timestamp     use Unix epoch timestamps for progress\n"
 		   "  --random-seed=SEED       set random seed (\"time\", \"rand\", integer)\n"
+		   "  --replica=CONNINFO       report the replay lag of this read replica\n"
 		   "  --sampling-rate=NUM      fraction of transactions to log (e.g., 0.01 for 1%%)\n"
 		   "  --show-script=NAME       show builtin script code, then exit\n"
+		   "  --storage-metrics        report OpenAurora storage node and mempool metrics\n"
 		   "\nCommon options:\n"
 		   "  -d, --debug              print debugging output\n"
 		   "  -h, --host=HOSTNAME      database server host or socket directory\n"
@@ -2494,6 +2557,10 @@ getMetaCommand(const char *cmd)
 		mc = META_GSET;
 	else if (pg_strcasecmp(cmd, "aset") == 0)
 		mc = META_ASET;
+	else if (pg_strcasecmp(cmd, "startpipeline") == 0)
+		mc = META_STARTPIPELINE;
+	else if (pg_strcasecmp(cmd, "endpipeline") == 0)
+		mc = META_ENDPIPELINE;
 	else
 		mc = META_NONE;
 	return mc;
@@ -2637,6 +2704,37 @@ chooseScript(TState *thread)
 	return i - 1;
 }
 
+/*
+ * Prepare the SQL commands of the chosen script, unless already done.
+ *
+ * This uses the synchronous PQprepare, so it has to run before the
+ * connection enters pipeline mode.
+ */
+static void
+prepareCommands(CState *st)
+{
+	Command   **commands = sql_script[st->use_file].commands;
+
+	if (st->prepared[st->use_file])
+		return;
+
+	for (int j = 0; commands[j] != NULL; j++)
+	{
+		PGresult   *res;
+		char		name[MAX_PREPARE_NAME];
+
+		if (commands[j]->type != SQL_COMMAND)
+			continue;
+		preparedStatementName(name, st->use_file, j);
+		res = PQprepare(st->con, name,
+						commands[j]->argv[0], commands[j]->argc - 1, NULL);
+		if (PQresultStatus(res) != PGRES_COMMAND_OK)
+			pg_log_error("%s", PQerrorMessage(st->con));
+		PQclear(res);
+	}
+	st->prepared[st->use_file] = true;
+}
+
 /* Send a SQL command, using the chosen querymode */
 static bool
 sendCommand(CState *st, Command *command)
@@ -2670,27 +2768,7 @@ sendCommand(CState *st, Command *command)
 		char		name[MAX_PREPARE_NAME];
 		const char *params[MAX_ARGS];
 
-		if (!st->prepared[st->use_file])
-		{
-			int			j;
-			Command   **commands = sql_script[st->use_file].commands;
-
-			for (j = 0; commands[j] != NULL; j++)
-			{
-				PGresult   *res;
-				char		name[MAX_PREPARE_NAME];
-
-				if (commands[j]->type != SQL_COMMAND)
-					continue;
-				preparedStatementName(name, st->use_file, j);
-				res = PQprepare(st->con, name,
-								commands[j]->argv[0], commands[j]->argc - 1, NULL);
-				if (PQresultStatus(res) != PGRES_COMMAND_OK)
-					pg_log_error("%s", PQerrorMessage(st->con));
-				PQclear(res);
-			}
-			st->prepared[st->use_file] = true;
-		}
+		prepareCommands(st);
 
 		getQueryParams(st, command, params);
 		preparedStatementName(name, st->use_file, st->command);
@@ -2719,6 +2797,10 @@ sendCommand(CState *st, Command *command)
  * the results of the *last* command (META_GSET) or *all* commands
  * (META_ASET).
  *
+ * In pipeline mode (meta is META_ENDPIPELINE) this reads the results of a
+ * single queued command, or the pipeline sync, which ends the pipeline; the
+ * caller calls again until it has.
+ *
  * Returns true if everything is A-OK, false if any error occurs.
  */
 static bool
@@ -2732,7 +2814,7 @@ readCommandResponse(CState *st, MetaCommand meta, char *varprefix)
 	 * varprefix should be set only with \gset or \aset, and SQL commands do
 	 * not need it.
 	 */
-	Assert((meta == META_NONE && varprefix == NULL) ||
+	Assert(((meta == META_NONE || meta == META_ENDPIPELINE) && varprefix == NULL) ||
 		   ((meta == META_GSET || meta == META_ASET) && varprefix != NULL));
 
 	res = PQgetResult(st->con);
@@ -2801,6 +2883,16 @@ readCommandResponse(CState *st, MetaCommand meta, char *varprefix)
 				/* otherwise the result is simply thrown away by PQclear below */
 				break;
 
+			case PGRES_PIPELINE_SYNC:
+				/* all queued commands are done, leave pipeline mode */
+				if (PQexitPipelineMode(st->con) != 1)
+				{
+					pg_log_error("client %d failed to exit pipeline mode: %s",
+								 st->id, PQerrorMessage(st->con));
+					goto error;
+				}
+				break;
+
 			default:
 				/* anything else is unexpected */
 				pg_log_error("client %d script %d aborted in command %d query %d: %s",
@@ -3045,6 +3137,13 @@ advanceConnectionState(TState *thread, CState *st, StatsData *agg)
 				/* Transition to script end processing if done */
 				if (command == NULL)
 				{
+					if (PQpipelineStatus(st->con) != PQ_PIPELINE_OFF)
+					{
+						pg_log_error("client %d aborted: end of script reached with pipeline open",
+									 st->id);
+						st->state = CSTATE_ABORTED;
+						break;
+					}
 					st->state = CSTATE_END_TX;
 					break;
 				}
@@ -3059,11 +3158,20 @@ advanceConnectionState(TState *thread, CState *st, StatsData *agg)
 				/* Execute the command */
 				if (command->type == SQL_COMMAND)
 				{
-					if (!sendCommand(st, command))
+					/* results are only read at \endpipeline */
+					if (PQpipelineStatus(st->con) != PQ_PIPELINE_OFF &&
+						(command->meta == META_GSET || command->meta == META_ASET))
+					{
+						commandFailed(st, "SQL", "\\gset and \\aset are not allowed in pipeline mode");
+						st->state = CSTATE_ABORTED;
+					}
+					else if (!sendCommand(st, command))
 					{
 						commandFailed(st, "SQL", "SQL command send failed");
 						st->state = CSTATE_ABORTED;
 					}
+					else if (PQpipelineStatus(st->con) != PQ_PIPELINE_OFF)
+						st->state = CSTATE_END_COMMAND;
 					else
 						st->state = CSTATE_WAIT_RESULT;
 				}
@@ -3073,6 +3181,7 @@ advanceConnectionState(TState *thread, CState *st, StatsData *agg)
 					 * Possible state changes when executing meta commands:
 					 * - on errors CSTATE_ABORTED
 					 * - on sleep CSTATE_SLEEP
+					 * - on \endpipeline CSTATE_WAIT_RESULT
 					 * - else CSTATE_END_COMMAND
 					 */
 					st->state = executeMetaCommand(st, &now);
@@ -3201,11 +3310,18 @@ advanceConnectionState(TState *thread, CState *st, StatsData *agg)
 				if (PQisBusy(st->con))
 					return;		/* don't have the whole result yet */
 
-				/* store or discard the query results */
+				/*
+				 * Store or discard the query results.  At \endpipeline, keep
+				 * reading until the pipeline sync has taken us out of
+				 * pipeline mode.
+				 */
 				if (readCommandResponse(st,
 										sql_script[st->use_file].commands[st->command]->meta,
 										sql_script[st->use_file].commands[st->command]->varprefix))
-					st->state = CSTATE_END_COMMAND;
+				{
+					if (PQpipelineStatus(st->con) == PQ_PIPELINE_OFF)
+						st->state = CSTATE_END_COMMAND;
+				}
 				else
 					st->state = CSTATE_ABORTED;
 				break;
@@ -3449,6 +3565,42 @@ executeMetaCommand(CState *st, instr_time *now)
 			return CSTATE_ABORTED;
 		}
 	}
+	else if (command->meta == META_STARTPIPELINE)
+	{
+		if (querymode == QUERY_SIMPLE)
+		{
+			commandFailed(st, "startpipeline", "cannot use pipeline mode with the simple query protocol");
+			return CSTATE_ABORTED;
+		}
+		if (PQpipelineStatus(st->con) != PQ_PIPELINE_OFF)
+		{
+			commandFailed(st, "startpipeline", "already in pipeline mode");
+			return CSTATE_ABORTED;
+		}
+		/* statements can't be prepared synchronously once in the pipeline */
+		if (querymode == QUERY_PREPARED)
+			prepareCommands(st);
+		if (PQenterPipelineMode(st->con) == 0)
+		{
+			commandFailed(st, "startpipeline", "failed to enter pipeline mode");
+			return CSTATE_ABORTED;
+		}
+	}
+	else if (command->meta == META_ENDPIPELINE)
+	{
+		if (PQpipelineStatus(st->con) == PQ_PIPELINE_OFF)
+		{
+			commandFailed(st, "endpipeline", "not in pipeline mode");
+			return CSTATE_ABORTED;
+		}
+		if (PQpipelineSync(st->con) == 0)
+		{
+			commandFailed(st, "endpipeline", "failed to send a pipeline sync");
+			return CSTATE_ABORTED;
+		}
+		/* collect the results of the queued commands */
+		return CSTATE_WAIT_RESULT;
+	}
 
 	/*
 	 * executing the expression or shell command might have taken a
@@ -4677,7 +4829,9 @@ process_backslash_command(PsqlScanState sstate, const char *source)
 			syntax_error(source, lineno, my_command->first_line, my_command->argv[0],
 						 "missing command", NULL, -1);
 	}
-	else if (my_command->meta == META_ELSE || my_command->meta == META_ENDIF)
+	else if (my_command->meta == META_ELSE || my_command->meta == META_ENDIF ||
+			 my_command->meta == META_STARTPIPELINE ||
+			 my_command->meta == META_ENDPIPELINE)
 	{
 		if (my_command->argc != 1)
 			syntax_error(source, lineno, my_command->first_line, my_command->argv[0],
@@ -5083,6 +5237,155 @@ addScript(ParsedScript script)
 	num_scripts++;
 }
 
+/*
+ * Sample the storage node's metrics and the mempool counters on the
+ * monitoring connection.  If that fails, say because the server isn't an
+ * OpenAurora compute node, complain once and stop sampling.
+ */
+static void
+getDisaggStats(DisaggStats *ds)
+{
+	PGresult   *res;
+
+	memset(ds, 0, sizeof(DisaggStats));
+	if (!storage_metrics)
+		return;
+
+	res = PQexec(monitor_con,
+				 "SELECT metric, value FROM pg_stat_smart_replay "
+				 "WHERE labels IS NULL AND metric IN ("
+				 "'openaurora_asr_reads_total', 'openaurora_asr_hot_misses_total', "
+				 "'openaurora_asr_replay_tasks_total', 'openaurora_logindex_unreplayed_versions', "
+				 "'openaurora_asr_replay_queue_length', 'openaurora_asr_replay_budget')");
+	if (PQresultStatus(res) != PGRES_TUPLES_OK)
+		goto fail;
+	for (int i = 0; i < PQntuples(res); i++)
+	{
+		const char *metric = PQgetvalue(res, i, 0) + strlen("openaurora_");
+		double		value = atof(PQgetvalue(res, i, 1));
+
+		if (strcmp(metric, "asr_reads_total") == 0)
+			ds->reads = value;
+		else if (strcmp(metric, "asr_hot_misses_total") == 0)
+			ds->hot_misses = value;
+		else if (strcmp(metric, "asr_replay_tasks_total") == 0)
+			ds->replay_tasks = value;
+		else if (strcmp(metric, "logindex_unreplayed_versions") == 0)
+			ds->unreplayed = value;
+		else if (strcmp(metric, "asr_replay_queue_length") == 0)
+			ds->replay_queue = value;
+		else if (strcmp(metric, "asr_replay_budget") == 0)
+			ds->replay_budget = value;
+	}
+	PQclear(res);
+
+	res = PQexec(monitor_con, "SELECT hits, stale_hits, misses FROM pg_stat_mempool");
+	if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) != 1)
+		goto fail;
+	ds->mempool_hits = strtoi64(PQgetvalue(res, 0, 0), NULL, 10);
+	ds->mempool_stale_hits = strtoi64(PQgetvalue(res, 0, 1), NULL, 10);
+	ds->mempool_misses = strtoi64(PQgetvalue(res, 0, 2), NULL, 10);
+	PQclear(res);
+
+	ds->valid = true;
+	return;
+
+fail:
+	pg_log_error("could not sample storage metrics, no longer reporting them: %s",
+				 PQerrorMessage(monitor_con));
+	PQclear(res);
+	storage_metrics = false;
+}
+
+/*
+ * Print what the storage node and the mempool did between two samples taken
+ * the given number of seconds apart.
+ */
+static void
+printDisaggStats(FILE *out, const char *prefix, const DisaggStats *prev,
+				 const DisaggStats *cur, double seconds)
+{
+	double		reads = cur->reads - prev->reads;
+	int64		hits = cur->mempool_hits - prev->mempool_hits;
+	int64		lookups = hits +
+		(cur->mempool_stale_hits - prev->mempool_stale_hits) +
+		(cur->mempool_misses - prev->mempool_misses);
+
+	if (!prev->valid || !cur->valid || seconds <= 0)
+		return;
+
+	fprintf(out,
+			"%sstorage: %.1f reads/s, hot miss %.2f %%, %.1f replayed/s, "
+			"unreplayed %.0f, replay queue %.1f, budget %.0f; mempool hit %.2f %%\n",
+			prefix, reads / seconds,
+			reads > 0 ? 100.0 * (cur->hot_misses - prev->hot_misses) / reads : 0.0,
+			(cur->replay_tasks - prev->replay_tasks) / seconds,
+			cur->unreplayed, cur->replay_queue, cur->replay_budget,
+			lookups > 0 ? 100.0 * hits / lookups : 0.0);
+}
+
+/* parse a "X/X" WAL location, as printed by the server */
+static bool
+parseLsn(const char *str, uint64 *lsn)
+{
+	uint32		hi,
+				lo;
+
+	if (sscanf(str, "%X/%X", &hi, &lo) != 2)
+		return false;
+	*lsn = ((uint64) hi << 32) | lo;
+	return true;
+}
+
+/*
+ * Print how far behind the benchmarked node each read replica replays.  The
+ * two positions are sampled one after the other, so the lag is approximate.
+ */
+static void
+printReplicaLag(FILE *out, const char *prefix)
+{
+	PGresult   *res;
+	uint64		primary_lsn = 0;
+
+	if (num_replicas == 0)
+		return;
+
+	res = PQexec(monitor_con, "SELECT pg_current_wal_lsn()");
+	if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) != 1 ||
+		!parseLsn(PQgetvalue(res, 0, 0), &primary_lsn))
+	{
+		PQclear(res);
+		fprintf(out, "%sreplicas: primary WAL position unavailable: %s",
+				prefix, PQerrorMessage(monitor_con));
+		return;
+	}
+	PQclear(res);
+
+	for (int i = 0; i < num_replicas; i++)
+	{
+		uint64		replay_lsn;
+
+		if (PQstatus(replica_con[i]) == CONNECTION_BAD)
+			PQreset(replica_con[i]);
+		res = PQexec(replica_con[i],
+					 "SELECT pg_last_wal_replay_lsn(), "
+					 "extract(epoch FROM now() - pg_last_xact_replay_timestamp())");
+		if (PQresultStatus(res) != PGRES_TUPLES_OK || PQntuples(res) != 1 ||
+			PQgetisnull(res, 0, 0) || !parseLsn(PQgetvalue(res, 0, 0), &replay_lsn))
+			fprintf(out, "%sreplica %d: unavailable\n", prefix, i + 1);
+		else
+		{
+			fprintf(out, "%sreplica %d: lag " UINT64_FORMAT " bytes", prefix, i + 1,
+					primary_lsn > replay_lsn ? primary_lsn - replay_lsn : 0);
+			if (!PQgetisnull(res, 0, 1))
+				fprintf(out, ", %.3f s since the last replayed commit",
+						atof(PQgetvalue(res, 0, 1)));
+			fprintf(out, "\n");
+		}
+		PQclear(res);
+	}
+}
+
 /*
  * Print progress report.
  *
@@ -5172,6 +5475,16 @@ printProgressReport(TState *threads, int64 test_start, int64 now,
 	}
 	fprintf(stderr, "\n");
 
+	if (storage_metrics)
+	{
+		DisaggStats ds;
+
+		getDisaggStats(&ds);
+		printDisaggStats(stderr, "  ", &progress_disagg, &ds, run / 1000000.0);
+		progress_disagg = ds;
+	}
+	printReplicaLag(stderr, "  ");
+
 	*last = cur;
 	*last_report = now;
 }
@@ -5268,6 +5581,15 @@ printResults(StatsData *total, instr_time total_time,
 	printf("tps = %f (including connections establishing)\n", tps_include);
 	printf("tps = %f (excluding connections establishing)\n", tps_exclude);
 
+	if (storage_metrics)
+	{
+		DisaggStats ds;
+
+		getDisaggStats(&ds);
+		printDisaggStats(stdout, "", &disagg_start, &ds, time_include);
+	}
+	printReplicaLag(stdout, "");
+
 	/* Report per-script/command statistics */
 	if (per_script_stats || report_per_command)
 	{
@@ -5422,6 +5744,8 @@ main(int argc, char **argv)
 		{"show-script", required_argument, NULL, 10},
 		{"partitions", required_argument, NULL, 11},
 		{"partition-method", required_argument, NULL, 12},
+		{"storage-metrics", no_argument, NULL, 13},
+		{"replica", required_argument, NULL, 14},
 		{NULL, 0, NULL, 0}
 	};
 
@@ -5795,6 +6119,19 @@ main(int argc, char **argv)
 					exit(1);
 				}
 				break;
+			case 13:			/* storage-metrics */
+				benchmarking_option_set = true;
+				storage_metrics = true;
+				break;
+			case 14:			/* replica */
+				benchmarking_option_set = true;
+				if (num_replicas >= MAX_REPLICAS)
+				{
+					pg_log_fatal("at most %d replicas allowed", MAX_REPLICAS);
+					exit(1);
+				}
+				replica_conninfo[num_replicas++] = pg_strdup(optarg);
+				break;
 			default:
 				fprintf(stderr, _("Try \"%s --help\" for more information.\n"), progname);
 				exit(1);
@@ -6099,7 +6436,24 @@ main(int argc, char **argv)
 			fprintf(stderr, "end.\n");
 		}
 	}
-	PQfinish(con);
+
+	/* keep the connection to sample OpenAurora metrics during the run */
+	if (storage_metrics || num_replicas > 0)
+	{
+		monitor_con = con;
+		for (i = 0; i < num_replicas; i++)
+		{
+			replica_con[i] = PQconnectdb(replica_conninfo[i]);
+			if (PQstatus(replica_con[i]) == CONNECTION_BAD)
+			{
+				pg_log_fatal("connection to replica \"%s\" failed: %s",
+							 replica_conninfo[i], PQerrorMessage(replica_con[i]));
+				exit(1);
+			}
+		}
+	}
+	else
+		PQfinish(con);
 
 	/* set up thread data structures */
 	threads = (TState *) pg_malloc(sizeof(TState) * nthreads);
@@ -6126,6 +6480,9 @@ main(int argc, char **argv)
 	/* all clients must be assigned to a thread */
 	Assert(nclients_dealt == nclients);
 
+	getDisaggStats(&disagg_start);
+	progress_disagg = disagg_start;
+
 	/* get start up time */
 	INSTR_TIME_SET_CURRENT(start_time);
 
@@ -6217,6 +6574,13 @@ main(int argc, char **argv)
 	INSTR_TIME_SUBTRACT(total_time, start_time);
 	printResults(&stats, total_time, conn_total_time, latency_late);
 
+	if (monitor_con != NULL)
+	{
+		PQfinish(monitor_con);
+		for (i = 0; i < num_replicas; i++)
+			PQfinish(replica_con[i]);
+	}
+
 	if (exit_code != 0)
 		pg_log_fatal("Run was aborted; the above results are incomplete.");
 
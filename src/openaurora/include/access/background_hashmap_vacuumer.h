@@ -11,7 +11,27 @@
 extern "C" {
 #endif
 
-extern bool BackgroundHashMapCleanRocksdb(HashMap hashMap);
+// The storage server starts BACKGROUND_REPLAYER_MAX_THREADS replayers but
+// only the first few are active; the others stay parked until the limit
+// goes up. Active replayers sleep between rounds, and each bucket is swept
+// at most once per that interval.
+#define BACKGROUND_REPLAYER_MAX_THREADS (16)
+#define BACKGROUND_REPLAYER_DEFAULT_THREADS (5)
+#define BACKGROUND_REPLAYER_DEFAULT_SLEEP_US (300)
+
+// Replayer loop, replayerId in [0, BACKGROUND_REPLAYER_MAX_THREADS)
+extern bool BackgroundHashMapCleanRocksdb(HashMap hashMap, int replayerId);
+
+// Change how many replayers run and how long they sleep (e.g. from the ASR
+// controller). Clamped to [1, BACKGROUND_REPLAYER_MAX_THREADS] and
+// [0, 1000000] us.
+extern void BackgroundReplayerSetLimits(int activeThreads, int sleepUs);
+extern void BackgroundReplayerGetLimits(int *activeThreads, int *sleepUs);
+
+// Installs a page image a compute node evicted, pageLsn being its LSN, as
+// a replayed version, when that saves a replay worth a page write. The WAL
+// up to pageLsn has to be parsed. Returns whether it was installed.
+extern bool BackgroundInstallPage(HashMap hashMap, KeyType key, const char *page, uint64_t pageLsn);
 
 #ifdef __cplusplus
 }
@@ -35,6 +35,7 @@
 #define HEAP_INSERT_FROZEN		TABLE_INSERT_FROZEN
 #define HEAP_INSERT_NO_LOGICAL	TABLE_INSERT_NO_LOGICAL
 #define HEAP_INSERT_SPECULATIVE 0x0010
+#define HEAP_INSERT_PARALLEL	TABLE_INSERT_PARALLEL
 
 typedef struct BulkInsertStateData *BulkInsertState;
 struct TupleTableSlot;
@@ -54,6 +55,10 @@ typedef struct HeapScanDescData
 	BlockNumber rs_numblocks;	/* max number of blocks to scan */
 	/* rs_numblocks is usually InvalidBlockNumber, meaning "scan whole rel" */
 
+	/* blocks still to be named to rs_read_stream, for seqscans */
+	BlockNumber rs_stream_next;
+	BlockNumber rs_stream_left;
+
 	/* scan current state */
 	bool		rs_inited;		/* false = scan not init'd yet */
 	BlockNumber rs_cblock;		/* current block # in scan, if any */
@@ -63,6 +68,9 @@ typedef struct HeapScanDescData
 	/* rs_numblocks is usually InvalidBlockNumber, meaning "scan whole rel" */
 	BufferAccessStrategy rs_strategy;	/* access strategy for reads */
 
+	/* parallel scans only: this backend's chunk of the blocks */
+	ParallelBlockTableScanWorkerData *rs_parallelworkerdata;
+
 	HeapTupleData rs_ctup;		/* current tuple in scan, if any */
 
 	/* these fields only used in page-at-a-time mode and for bitmap scans */
@@ -121,6 +129,7 @@ extern void heap_endscan(TableScanDesc scan);
 extern HeapTuple heap_getnext(TableScanDesc scan, ScanDirection direction);
 extern bool heap_getnextslot(TableScanDesc sscan,
 							 ScanDirection direction, struct TupleTableSlot *slot);
+extern int	heap_getnextbatch(TableScanDesc sscan, HeapTuple tuples, Buffer *buffer);
 
 extern bool heap_fetch(Relation relation, Snapshot snapshot,
 					   HeapTuple tuple, Buffer *userbuf);
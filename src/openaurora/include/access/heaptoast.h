@@ -136,6 +136,9 @@ extern HeapTuple toast_build_flattened_tuple(TupleDesc tupleDesc,
 											 Datum *values,
 											 bool *isnull);
 
+/* in heaptoast.c */
+extern bool rpc_toast_prefetch;
+
 /* ----------
  * heap_fetch_toast_slice
  *
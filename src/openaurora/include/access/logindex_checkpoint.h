@@ -0,0 +1,74 @@
+//
+// Persistent snapshots of the logindex version hashmap (pageVersionHashMap).
+//
+// With "LOGINDEX_CHECKPOINT_DIR" set (relative to the data directory), the
+// storage node periodically writes the heads changed since the previous
+// snapshot, together with the XLogParseUpto they are consistent with, to a
+// flat file in that directory. Every LOGINDEX_CHECKPOINT_FULL_EVERY-th file
+// is a full snapshot that starts a new generation; older generations are
+// then removed. On restart StartupXLOG restores the newest generation and
+// starts parsing WAL at its parse lsn instead of the checkpoint redo point.
+//
+// File layout (native endianness, the files never leave the node):
+//   LogindexCheckpointHeader
+//   headCount x { key, replayedLsn, entryNum, entryNum x { lsn, pageNum, flags } }
+//   with flags bit 0 materialized and bit 1 full page (files from before
+//   full-page tracking only ever set bit 0)
+//   LogindexCheckpointTrailer, whose crc32c covers everything before it
+//   plus its own headCount
+//
+
+#ifndef DB2_PG_LOGINDEX_CHECKPOINT_H
+#define DB2_PG_LOGINDEX_CHECKPOINT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "access/logindex_hashmap.h"
+
+#define LOGINDEX_CHECKPOINT_MAGIC (0x584c414fu) // "OALX"
+#define LOGINDEX_CHECKPOINT_VERSION (1)
+#define LOGINDEX_CHECKPOINT_DEFAULT_INTERVAL_MS (30000)
+#define LOGINDEX_CHECKPOINT_FULL_EVERY (16)
+
+typedef struct LogindexCheckpointHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t generation;
+    uint32_t sequence; // 0 for a full snapshot
+    uint32_t padding;
+    uint64_t parseLsn; // every record below this lsn is reflected in the file
+} LogindexCheckpointHeader;
+
+typedef struct LogindexCheckpointTrailer {
+    uint64_t headCount;
+    uint32_t crc;
+    uint32_t magic;
+} LogindexCheckpointTrailer;
+
+// Called once per restored relation with the largest block number seen, so
+// the caller can rebuild its relation size cache.
+typedef void (*LogindexRestoreRelCallback)(const KeyType *relKey, int64_t maxBlkNum, uint64_t parseLsn, void *arg);
+
+extern bool LogindexCheckpointEnabled(void);
+
+// Restore the newest complete generation into an empty hashMap if its parse
+// lsn is newer than minLsn. Returns true and sets *parseLsn on success.
+extern bool LogindexCheckpointRestore(HashMap hashMap, uint64_t minLsn, uint64_t *parseLsn,
+                                      LogindexRestoreRelCallback relCallback, void *arg);
+
+// Write one snapshot now. parseUpto is read after the dirty epoch is bumped.
+extern bool LogindexCheckpointWrite(HashMap hashMap, const volatile uint64_t *parseUpto, bool full);
+
+// Start the background thread that calls LogindexCheckpointWrite every
+// LOGINDEX_CHECKPOINT_INTERVAL_MS. No-op unless enabled.
+extern void LogindexCheckpointStart(HashMap hashMap, const volatile uint64_t *parseUpto);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_LOGINDEX_CHECKPOINT_H
@@ -0,0 +1,47 @@
+//
+// Deferred garbage collection of page version chains.
+//
+// A read that replayed a page used to trim the page's chain itself, taking
+// the bucket and head locks again inside the request and contending with
+// the other readers of the page. It now only queues the key here, and
+// background threads trim the queued chains in batches with
+// HashMapGarbageCollectKey. A key already queued isn't queued again, so a
+// hot page is trimmed once per batch however often it is read. With the
+// queue full a key is dropped, the GC sweeper (HashMapStartGcSweeper) gets
+// to its chain once minComputeLsn moves.
+//
+
+#ifndef DB2_PG_LOGINDEX_GC_QUEUE_H
+#define DB2_PG_LOGINDEX_GC_QUEUE_H
+
+#include <stdint.h>
+
+#include "access/logindex_hashmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Keys queued at most, split over LOGINDEX_GC_SHARDS queues by hash
+#define LOGINDEX_GC_QUEUE_SIZE (16384)
+#define LOGINDEX_GC_SHARDS (16)
+#define LOGINDEX_GC_THREADS (2)
+// Keys a thread takes off a queue at a time
+#define LOGINDEX_GC_BATCH (64)
+
+// Starts the threads collecting the chains of hashMap
+extern void LogindexGcQueueStart(HashMap hashMap);
+
+// Queue key's chain for collection. Collects it on the spot if the threads
+// weren't started.
+extern void LogindexGcQueuePush(HashMap hashMap, KeyType key);
+
+// Keys queued now, and dropped for a full queue ever
+extern int LogindexGcQueueLength(void);
+extern uint64_t LogindexGcQueueDropped(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_LOGINDEX_GC_QUEUE_H
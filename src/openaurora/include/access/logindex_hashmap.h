@@ -13,9 +13,19 @@ extern "C" {
 #define HASH_HEAD_NUM (15)
 #define HASH_ELEM_NUM (30)
 
+// Buckets live in fixed-size segments so the table can grow one bucket at a
+// time (linear hashing) without moving existing buckets.
+#define HASH_SEGMENT_SHIFT (10)
+#define HASH_SEGMENT_SIZE (1 << HASH_SEGMENT_SHIFT)
+#define HASH_MAX_SEGMENTS (4096)
+// Split one more bucket whenever the average chain exceeds this many heads
+#define HASH_SPLIT_LOAD (4)
+#define HASH_BUCKET_ALIGN (64)
+
 struct HashBucket;
 struct HashNodeHead;
 struct HashNodeEle;
+struct LogindexRelIndex;
 
 typedef struct HashBucket HashBucket;
 typedef struct HashNodeHead HashNodeHead;
@@ -38,16 +48,20 @@ struct LsnEntry {
     uint64_t lsn;
     int pageNum;
     bool materialized;
+    // The record rewrites the whole page (a full-page image or a page
+    // init), so replaying up to here needs nothing before it
+    bool fullPage;
 };
 typedef struct LsnEntry LsnEntry;
 
+// Padded to a cache line so neighbouring buckets' locks don't false-share
 struct HashBucket {
 //    Lock bucketLock;
     pthread_rwlock_t bucketLock;
     pthread_mutex_t replayLock;
     struct timeval lastReplayTime;
     HashNodeHead* nodeList;
-};
+} __attribute__((aligned(HASH_BUCKET_ALIGN)));
 
 struct HashNodeHead {
     KeyType key;
@@ -56,6 +70,9 @@ struct HashNodeHead {
     HashBucket* bucket;
 //    Lock headLock;
     pthread_rwlock_t headLock;
+    // Seqlock for the lsn entries. HashMapInsertKey appends under the shared
+    // headLock, so shared-lock readers use it to detect a concurrent append.
+    uint32_t writeSeq;
 
     LsnEntry lsnEntry[HASH_HEAD_NUM];
     uint64_t maxLsn; // Max lsn stored in this element node
@@ -73,13 +90,31 @@ struct HashNodeHead {
 
     // Finish Vacuum Time
     struct timeval finishVacuumTime;
+
+    // HashMapStruct.dirtyEpoch at the last change, see HashMapForEachDirtyHead
+    uint64_t dirtyEpoch;
+
+    // Number of element node entries the spiller moved to RocksDB, 0 if the
+    // whole chain is in memory. Only changes under the exclusive headLock.
+    uint32_t spilledEntryNum;
+    // HashMapStruct.accessTick at the last lookup, tells the spiller how cold it is
+    uint32_t accessTick;
 };
 
+// Element nodes hold the long tail of a page's version chain, so they use a
+// compact frame-of-reference layout: each lsn is stored as a 32-bit delta
+// from baseLsn (the node's first lsn) and the materialized flags are a
+// bitmap. An lsn more than 4GB past baseLsn starts a new element node.
+// Use the HashEle* helpers below rather than the raw fields.
 struct HashNodeEle {
     uint64_t maxLsn; // Max lsn stored in this element node
+    uint64_t baseLsn; // lsn of entry 0, every lsnDelta is relative to it
     int entryNum; // How many values stored in the element node
 
-    LsnEntry lsnEntry[HASH_ELEM_NUM];
+    uint64_t materializedBits; // bit i set if entry i is materialized
+    uint64_t fullPageBits; // bit i set if entry i rewrites the whole page
+    uint32_t lsnDelta[HASH_ELEM_NUM];
+    int32_t pageNum[HASH_ELEM_NUM];
 
     // When entryNum reaches HASH_ELEM_NUM, malloc a new
     // element node linked with this node
@@ -87,21 +122,120 @@ struct HashNodeEle {
     HashNodeEle *prevEle;
 };
 
+#define HASH_ELE_MAX_DELTA ((uint64_t) UINT32_MAX)
+
+static inline uint64_t HashEleLsn(const HashNodeEle *ele, int i) {
+    return ele->baseLsn + ele->lsnDelta[i];
+}
+
+static inline bool HashEleMaterialized(const HashNodeEle *ele, int i) {
+    return (ele->materializedBits >> i) & 1;
+}
+
+static inline void HashEleSetMaterialized(HashNodeEle *ele, int i, bool materialized) {
+    if (materialized)
+        ele->materializedBits |= ((uint64_t) 1 << i);
+    else
+        ele->materializedBits &= ~((uint64_t) 1 << i);
+}
+
+static inline bool HashEleFullPage(const HashNodeEle *ele, int i) {
+    return (ele->fullPageBits >> i) & 1;
+}
+
+static inline void HashEleSetFullPage(HashNodeEle *ele, int i, bool fullPage) {
+    if (fullPage)
+        ele->fullPageBits |= ((uint64_t) 1 << i);
+    else
+        ele->fullPageBits &= ~((uint64_t) 1 << i);
+}
+
+// Can lsn be appended to ele without overflowing its delta?
+static inline bool HashEleFits(const HashNodeEle *ele, uint64_t lsn) {
+    return ele->entryNum < HASH_ELEM_NUM && lsn - ele->baseLsn <= HASH_ELE_MAX_DELTA;
+}
+
+// Reference to one version entry, either in the head or in an element node
+typedef struct LsnEntryRef {
+    LsnEntry *headEntry;
+    HashNodeEle *ele;
+    int index;
+} LsnEntryRef;
+
+static inline LsnEntryRef HeadEntryRef(LsnEntry *entry) {
+    LsnEntryRef ref = {entry, NULL, 0};
+    return ref;
+}
+
+static inline LsnEntryRef EleEntryRef(HashNodeEle *ele, int index) {
+    LsnEntryRef ref = {NULL, ele, index};
+    return ref;
+}
+
+static inline uint64_t LsnEntryRefLsn(LsnEntryRef ref) {
+    return ref.ele != NULL ? HashEleLsn(ref.ele, ref.index) : ref.headEntry->lsn;
+}
+
+static inline bool LsnEntryRefMaterialized(LsnEntryRef ref) {
+    return ref.ele != NULL ? HashEleMaterialized(ref.ele, ref.index) : ref.headEntry->materialized;
+}
+
+static inline bool LsnEntryRefFullPage(LsnEntryRef ref) {
+    return ref.ele != NULL ? HashEleFullPage(ref.ele, ref.index) : ref.headEntry->fullPage;
+}
+
+static inline void LsnEntryRefSetMaterialized(LsnEntryRef ref, bool materialized) {
+    if (ref.ele != NULL)
+        HashEleSetMaterialized(ref.ele, ref.index, materialized);
+    else if (ref.headEntry != NULL)
+        ref.headEntry->materialized = materialized;
+}
+
 struct ComputeNodeInfo {
     uint32_t id;
     bool primary;
     bool active;
     uint64_t lsn;
     struct timeval activeTime;
+    // Bytes it may fall behind the newest node before it's dropped, 0 = no limit
+    uint64_t maxLagBytes;
 };
 typedef struct ComputeNodeInfo ComputeNodeInfo;
 
 struct HashMapStruct {
-    HashBucket* bucketList;
-    int bucketNum;
+    HashBucket** bucketSegments;
+    int bucketNum; // current number of buckets, grows by one per split
+    int initBucketNum;
+    // (level << 32) | next bucket to split. A key lives in
+    // hash % (initBucketNum << level), or in hash % (initBucketNum << (level+1))
+    // if the former has already been split.
+    uint64_t splitState;
+    uint64_t headNum;
+    pthread_mutex_t splitLock;
+    // Bumped by every logindex checkpoint; heads remember the value at their
+    // last change so a checkpoint only has to write what changed since.
+    uint64_t dirtyEpoch;
+    // relation -> blocks with a head, see access/logindex_relindex.h
+    struct LogindexRelIndex *relIndex;
+    // Memory budget in bytes (0 = unbounded) and the spiller's clock,
+    // see HashMapStartSpiller
+    uint64_t memoryLimit;
+    uint32_t accessTick;
+    int spillerStarted;
+    uint64_t spilledChains;
+    uint64_t faultedChains;
+    // Page versions above their head's replayedLsn, summed over all heads.
+    // Only moved through HashMapInsertKey and HashMapSetReplayedLsn.
+    int64_t unreplayedEntries;
+    // Bloom filter of the keys with a head, LOGINDEX_PAGE_FILTER_MB (default
+    // 32, 0 = none) of 64-byte blocks, see HashMapMayContain
+    uint64_t *pageFilter;
+    uint64_t pageFilterBlocks;
+    uint64_t pageFilterNegatives;
 
     ComputeNodeInfo* computeNodeList;
     int computeNodeNum;
+    uint32_t nextComputeNodeId;
     pthread_rwlock_t computeNodeLock;
     uint64_t minComputeLsn;
 } ;
@@ -114,21 +248,86 @@ typedef struct HashMapStruct* HashMap;
 //extern void *ReadLock(void*);
 //extern void *WriteLock(void*);
 
+extern int LsnListFindLowerBound(uint64_t targetLsn, LsnEntry* entryList, int listSize);
+extern int HashEleFindLowerBound(uint64_t targetLsn, const HashNodeEle *ele);
+
 extern void HashMapInit(HashMap* hashMap, int bucketNum);
 extern void HashMapDestroy(HashMap hashMap);
-extern bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, bool noEmptyFirstSlot);
+extern HashBucket* HashMapGetBucket(HashMap hashMap, uint32_t bucketPos);
+// fullPage marks a version whose record rewrites the whole page, replay
+// lists then start there instead of at the last materialized version.
+extern bool HashMapInsertKey(HashMap hashMap, KeyType key, uint64_t lsn, int pageNum, bool noEmptyFirstSlot, bool fullPage);
 
 extern bool HashMapGetBlockReplayList(HashMap hashMap, KeyType key, uint64_t targetLsn, uint64_t *replayedLsn, uint64_t **toReplayList, int *listLen);
 extern bool HashMapUpdateReplayedLsn(HashMap hashMap, KeyType key, uint64_t lsn, bool holdHeadLock);
+// Raise head->replayedLsn to lsn, keeping unreplayedEntries in step. The
+// caller holds the exclusive headLock on a resident head.
+extern void HashMapSetReplayedLsn(HashMap hashMap, HashNodeHead *head, uint64_t lsn);
+// Page versions waiting for replay across the whole map
+extern uint64_t HashMapUnreplayedEntries(HashMap hashMap);
 extern bool HashMapUpdateMaterializedStatus(HashMap hashMap, KeyType key, uint64_t lsn, bool holdHeadLock, bool status);
+extern bool HashMapGetLatestLsn(HashMap hashMap, KeyType key, uint64_t targetLsn, uint64_t *latestLsn);
+// False if key certainly has no head, without taking any lock. The lookups
+// above check it first, so a page that never had a version goes to its
+// base page without touching the bucket.
+extern bool HashMapMayContain(HashMap hashMap, KeyType key);
 extern bool HashMapGarbageCollectKey(HashMap hashMap, KeyType key);
 extern void HashMapGarbageCollectNode(HashMap hashMap, HashNodeHead *head);
+// The head of key without taking any lock on it, NULL if not indexed. Heads
+// stay allocated until HashMapDestroy, callers lock it before reading.
+extern HashNodeHead *HashMapFindHead(HashMap hashMap, KeyType key);
+
+// Callers holding head->headLock that change the head (or its element nodes)
+// outside of this file must call HashMapMarkHeadDirty before unlocking.
+extern void HashMapMarkHeadDirty(HashMap hashMap, HashNodeHead *head);
+extern uint64_t HashMapAdvanceDirtyEpoch(HashMap hashMap);
+
+// Calls visitor with a copy of every head whose dirtyEpoch >= minEpoch
+// (0 visits all heads). The head is exclusively locked while it is copied
+// but not while visitor runs. Returns the number of heads visited.
+typedef void (*HashMapHeadVisitor)(const KeyType *key, uint64_t replayedLsn,
+                                   const LsnEntry *entries, int entryNum, void *arg);
+extern uint64_t HashMapForEachDirtyHead(HashMap hashMap, uint64_t minEpoch, HashMapHeadVisitor visitor, void *arg);
+
+// Relation-scoped access through the relation index. relKey.BlkNum is
+// ignored; blocks come back ascending, starting at fromBlk.
+extern int HashMapGetRelationBlocks(HashMap hashMap, KeyType relKey, int64_t fromBlk, int64_t *blocks, int maxBlocks);
+// HashMapGarbageCollectKey for every indexed block >= fromBlk of the relation.
+// Returns the number of blocks visited.
+extern int64_t HashMapGarbageCollectRelation(HashMap hashMap, KeyType relKey, int64_t fromBlk);
+// Empties the version chains of up to maxBlocks indexed blocks >= fromBlk of
+// a dropped relation, deleting their page versions unless deletePages is off.
+// The heads stay, as they always do. Returns the block to go on from, -1
+// once the relation's last block is done.
+extern int64_t HashMapDropRelation(HashMap hashMap, KeyType relKey, int64_t fromBlk, int maxBlocks, bool deletePages);
+
+// Recreate a head from a saved version chain. The key must not exist yet.
+extern bool HashMapRestoreHead(HashMap hashMap, KeyType key, const LsnEntry *entries, int entryNum, uint64_t replayedLsn);
+
+// Start the thread that keeps the hashmap under LOGINDEX_MEMORY_LIMIT_MB by
+// moving the element chains of cold heads to RocksDB. A spilled chain is read
+// back the next time its head is used. No-op if the limit is unset.
+extern void HashMapStartSpiller(HashMap hashMap);
+// Change the budget at runtime (0 = unbounded), starting the spiller if it
+// isn't running yet. Used by the memory governor, storage/mem_governor.h.
+extern void HashMapSetMemoryLimit(HashMap hashMap, uint64_t bytes);
+// Bytes held by heads and element nodes currently in use
+extern uint64_t HashMapResidentBytes(void);
+// Start the thread that garbage collects every head once minComputeLsn moves
+extern void HashMapStartGcSweeper(HashMap hashMap);
 
 
 #define HashMapComputeNodeHearbeatInterval_us 1000000ul
 #define HashMapComputeNodeInactiveTimeout_us (10ul * HashMapComputeNodeHearbeatInterval_us)
+// A node silent past the timeout, or a secondary more than
+// SECONDARY_NODE_MAX_LAG_MB behind the newest node, no longer holds versions
+// back. Its next update is answered HASHMAP_NODE_RESYNC, and it registers again.
+#define HASHMAP_NODE_OK (0)
+#define HASHMAP_NODE_RESYNC (1)
+// -1 for a primary, or a node pinned to a past LSN, whose lsn is older than
+// the versions kept
 extern int32_t HashMapRegisterSecondaryNode(HashMap hashMap, bool primary, uint64_t lsn);
-extern void HashMapSecondaryNodeUpdatesLsn(HashMap hashMap, int32_t node_id, int64_t lsn);
+extern int32_t HashMapSecondaryNodeUpdatesLsn(HashMap hashMap, int32_t node_id, int64_t lsn);
 extern uint64_t HashMapGetMinComputeLsn(HashMap hashMap);
 extern void HashMapClearInactiveComputeNode(HashMap hashMap);
 
@@ -0,0 +1,43 @@
+//
+// Priority queue of pages for background replay.
+//
+// Readers that find versions to replay for a page report it here, hot
+// misses (a reader blocked on the replay) weighing much more than other
+// reads. Scores halve every LOGINDEX_HOT_DECAY_MS, so the queue follows what
+// is read now. The background vacuumers pop the hottest pages first, replay
+// them and push them back at half their score; they only sweep the buckets
+// for cold pages when the hot ones have nothing left to replay.
+//
+
+#ifndef DB2_PG_LOGINDEX_HOT_QUEUE_H
+#define DB2_PG_LOGINDEX_HOT_QUEUE_H
+
+#include "access/logindex_hashmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Pages tracked at most, the coldest ones give way to hot misses
+#define LOGINDEX_HOT_QUEUE_SIZE (4096)
+#define LOGINDEX_HOT_DECAY_MS (1000)
+
+#define LOGINDEX_HOT_READ_WEIGHT (1)
+#define LOGINDEX_HOT_MISS_WEIGHT (16)
+
+// Add weight to key's score, queueing it if needed
+extern void LogindexHotQueueRecord(KeyType key, uint32_t weight);
+
+// Remove up to max of the hottest pages, hottest first. Returns how many.
+extern int LogindexHotQueuePop(KeyType *keys, uint32_t *scores, int max);
+
+extern int LogindexHotQueueLength(void);
+
+// Current score of key, 0 if it isn't queued
+extern uint32_t LogindexHotQueueScore(KeyType key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_LOGINDEX_HOT_QUEUE_H
@@ -0,0 +1,34 @@
+//
+// Lower-bound search over the delta-encoded lsn arrays of logindex element
+// nodes (HashNodeEle::lsnDelta).
+//
+// The arrays are short (HASH_ELEM_NUM) and sorted, so instead of a binary
+// search we count, branch-free, how many deltas are <= the target. On x86-64
+// the AVX2 kernel is picked at run time if the CPU has it; aarch64 always
+// uses NEON; everything else gets the scalar loop.
+//
+
+#ifndef DB2_PG_LOGINDEX_LSN_SEARCH_H
+#define DB2_PG_LOGINDEX_LSN_SEARCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Index of the last delta <= target, or -1 if there is none.
+// deltas[0..n) must be sorted ascending.
+extern int LsnDeltaFindLowerBound(const uint32_t *deltas, int n, uint32_t target);
+
+// The individual kernels, exposed for the microbenchmark
+extern int LsnDeltaFindLowerBoundScalar(const uint32_t *deltas, int n, uint32_t target);
+extern int LsnDeltaFindLowerBoundBinary(const uint32_t *deltas, int n, uint32_t target);
+extern int LsnDeltaFindLowerBoundVector(const uint32_t *deltas, int n, uint32_t target);
+extern const char* LsnDeltaSearchKernelName(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_LOGINDEX_LSN_SEARCH_H
@@ -0,0 +1,40 @@
+//
+// Which replayed page versions are written to RocksDB.
+//
+// Writing the version a page was replayed to costs a page write, but the
+// next read starts from it instead of replaying the whole chain again. A
+// version is materialized if a reread would be expensive, chainLen versions
+// having been replayed since the last materialized one, or if the page is
+// read often, by its hot queue score. Both within a write budget of
+// LOGINDEX_MATERIALIZE_MB page bytes a second (unset or 0, no limit).
+// Chains of LOGINDEX_MATERIALIZE_FORCE_CHAIN versions are materialized
+// regardless, the version index and its GC can't hold them back longer.
+// Cheap-to-replay, rarely read pages stay as WAL only.
+//
+
+#ifndef DB2_PG_LOGINDEX_MATERIALIZE_H
+#define DB2_PG_LOGINDEX_MATERIALIZE_H
+
+#include "access/logindex_hot_queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOGINDEX_MATERIALIZE_MIN_CHAIN (8)
+// Two hot misses within a decay period
+#define LOGINDEX_MATERIALIZE_MIN_SCORE (2 * LOGINDEX_HOT_MISS_WEIGHT)
+#define LOGINDEX_MATERIALIZE_FORCE_CHAIN (64)
+
+// Whether to write a version replayed over chainLen versions for a page of
+// the given hot queue score. Taking the answer yes uses up budget.
+extern bool LogindexShouldMaterialize(uint32_t score, int chainLen);
+
+// Versions materialized and left as WAL only so far
+extern void LogindexMaterializeCounts(uint64_t *materialized, uint64_t *skipped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_LOGINDEX_MATERIALIZE_H
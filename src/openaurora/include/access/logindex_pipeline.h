@@ -0,0 +1,48 @@
+//
+// Parallel logindex insertion for the storage node's xlog parser.
+//
+// The startup thread still reads and decodes every record in order (records
+// the logindex doesn't cover are redone right there), but the page versions
+// it extracts are handed to LOGINDEX_INDEX_THREADS worker threads, sharded
+// by page so each page's versions are still inserted in LSN order. The
+// parser reports its progress through LogindexPipelineAdvance, and
+// XLogParseUpto is only moved to a record's end once every version of that
+// record and all earlier ones is in pageVersionHashMap, so readers waiting
+// on XLogParseUpto see the same map as before.
+//
+
+#ifndef DB2_PG_LOGINDEX_PIPELINE_H
+#define DB2_PG_LOGINDEX_PIPELINE_H
+
+#include "access/xlogdefs.h"
+#include "access/logindex_hashmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOGINDEX_PIPELINE_DEFAULT_THREADS (4)
+#define LOGINDEX_PIPELINE_MAX_THREADS (32)
+// Versions queued per worker before the parser blocks
+#define LOGINDEX_PIPELINE_QUEUE_SIZE (4096)
+
+// Start the workers (LOGINDEX_INDEX_THREADS, 0 keeps inserting inline).
+// Called by the thread that will parse.
+extern void LogindexPipelineStart(HashMap hashMap);
+
+// Queue one page version, or insert it right away without workers. fullPage
+// as for HashMapInsertKey.
+extern void LogindexPipelineInsert(HashMap hashMap, KeyType key, XLogRecPtr lsn, bool fullPage);
+
+// Everything queued so far belongs to records ending at or before parsedUpto
+extern void LogindexPipelineAdvance(XLogRecPtr parsedUpto);
+
+// Wait for every queued version to be inserted and published. A no-op
+// outside the process running the pipeline.
+extern void LogindexPipelineDrain(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_LOGINDEX_PIPELINE_H
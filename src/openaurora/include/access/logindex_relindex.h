@@ -0,0 +1,42 @@
+//
+// Secondary relation -> blocks index for the logindex version hashmap.
+//
+// The hashmap is keyed by (spc, db, rel, fork, blk), so finding every block
+// of one relation that has versions would mean walking the whole table. This
+// index keeps one block bitmap per (spc, db, rel, fork), updated when
+// HashMapInsertKey creates a new head, so relation-scoped work can iterate
+// exactly the blocks that exist, in block order.
+//
+
+#ifndef DB2_PG_LOGINDEX_RELINDEX_H
+#define DB2_PG_LOGINDEX_RELINDEX_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "access/logindex_hashmap.h"
+
+typedef struct LogindexRelIndex LogindexRelIndex;
+
+extern LogindexRelIndex* RelIndexCreate(void);
+extern void RelIndexDestroy(LogindexRelIndex *index);
+
+// key.BlkNum == -1 (relation size keys) is ignored
+extern void RelIndexAddBlock(LogindexRelIndex *index, const KeyType *key);
+
+// Copy up to maxBlocks block numbers >= fromBlk of relKey's relation into
+// blocks, ascending. relKey.BlkNum is ignored. Returns how many were copied.
+extern int RelIndexGetBlocks(LogindexRelIndex *index, const KeyType *relKey, int64_t fromBlk,
+                             int64_t *blocks, int maxBlocks);
+
+// Number of indexed blocks of relKey's relation
+extern int64_t RelIndexBlockCount(LogindexRelIndex *index, const KeyType *relKey);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_LOGINDEX_RELINDEX_H
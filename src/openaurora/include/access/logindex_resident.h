@@ -0,0 +1,111 @@
+//
+// Pages resident in the shared buffers of compute nodes, as the storage
+// node's background replayer sees them.
+//
+// A page a compute node holds in its buffers won't be read from the storage
+// node until it is evicted, so replaying its versions in the background now
+// is for nothing yet, while every page that isn't resident anywhere is a
+// read waiting to replay its chain. Compute nodes send a summary of their
+// buffers every buffer_resident_summary_interval over
+// RpcPublishResidentPages, see storage/buf_resident_summary.h. The
+// background replayer leaves the cold heads of pages in a summary for a
+// later sweep, so its ASR budget goes to the pages likely to miss. Hot
+// heads, pages just read from the storage node, are replayed as before,
+// and so are chains of LOGINDEX_MATERIALIZE_FORCE_CHAIN versions.
+//
+// A summary is a blocked bloom filter: each page sets
+// RESIDENT_SUMMARY_PROBES bits of one 64-byte block. False positives only
+// defer a replay, and a summary stands for ttlMs, so a node that stopped
+// sending stops deferring anything.
+//
+
+#ifndef DB2_PG_LOGINDEX_RESIDENT_H
+#define DB2_PG_LOGINDEX_RESIDENT_H
+
+#include <stdint.h>
+
+#include "access/logindex_hashmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RESIDENT_SUMMARY_MAGIC (0x52535346)   // "RSSF"
+#define RESIDENT_SUMMARY_BLOCK_WORDS (8)
+#define RESIDENT_SUMMARY_PROBES (4)
+// Bits a page takes, about 3% false positives
+#define RESIDENT_SUMMARY_BITS_PER_PAGE (8)
+// Compute nodes whose summaries are kept at once
+#define RESIDENT_SUMMARY_MAX_NODES (16)
+
+typedef struct ResidentSummaryHeader {
+    uint32_t magic;
+    // Tells the summaries of one node from those of another
+    uint32_t nodeKey;
+    // A power of two
+    uint32_t blocks;
+    uint32_t count;
+    uint32_t ttlMs;
+    uint32_t reserved;
+} ResidentSummaryHeader;
+
+// Bytes a summary of blocks blocks takes
+#define ResidentSummarySize(blocks) \
+    (sizeof(ResidentSummaryHeader) + (size_t) (blocks) * RESIDENT_SUMMARY_BLOCK_WORDS * sizeof(uint64_t))
+
+static inline uint64_t ResidentSummaryMix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Both sides hash a page the same way
+static inline uint64_t ResidentSummaryHash(uint64_t spcNode, uint64_t dbNode, uint64_t relNode,
+                                           uint32_t forkNum, uint32_t blockNum) {
+    uint64_t h = ResidentSummaryMix(spcNode ^ 0x9e3779b97f4a7c15ULL);
+
+    h = ResidentSummaryMix(h ^ dbNode);
+    h = ResidentSummaryMix(h ^ relNode);
+    return ResidentSummaryMix(h ^ (((uint64_t) forkNum << 32) | blockNum));
+}
+
+// The block from the low bits of the hash, the probes from the high ones
+static inline void ResidentSummaryAdd(uint64_t *filter, uint32_t blocks, uint64_t hash) {
+    uint64_t *block = filter + (hash & (blocks - 1)) * RESIDENT_SUMMARY_BLOCK_WORDS;
+    uint64_t bits = hash >> 32;
+
+    for(int i = 0; i < RESIDENT_SUMMARY_PROBES; i++, bits >>= 9)
+        block[(bits >> 6) & (RESIDENT_SUMMARY_BLOCK_WORDS - 1)] |= 1ull << (bits & 63);
+}
+
+static inline bool ResidentSummaryTest(const uint64_t *filter, uint32_t blocks, uint64_t hash) {
+    const uint64_t *block = filter + (hash & (blocks - 1)) * RESIDENT_SUMMARY_BLOCK_WORDS;
+    uint64_t bits = hash >> 32;
+
+    for(int i = 0; i < RESIDENT_SUMMARY_PROBES; i++, bits >>= 9)
+        if((block[(bits >> 6) & (RESIDENT_SUMMARY_BLOCK_WORDS - 1)] & (1ull << (bits & 63))) == 0)
+            return false;
+    return true;
+}
+
+// Takes a summary sent over RpcPublishResidentPages in place of the node's
+// last one. False if it is malformed.
+extern bool LogindexResidentPublish(const char *summary, size_t len);
+
+// Whether the page is in a summary that still stands
+extern bool LogindexResidentContains(KeyType key);
+
+// Counts a replay deferred for a resident page
+extern void LogindexResidentDeferred(void);
+
+// Nodes with a summary that still stands, and replays deferred so far
+extern void LogindexResidentCounts(uint64_t *nodes, uint64_t *deferred);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_LOGINDEX_RESIDENT_H
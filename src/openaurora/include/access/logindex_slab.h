@@ -0,0 +1,39 @@
+//
+// Slab pools for the logindex hashmap nodes (HashNodeHead / HashNodeEle).
+//
+// Nodes are carved from large chunks and recycled through per-thread free
+// lists, so the WAL-parse thread and the vacuum threads don't hit the glibc
+// allocator (and its locks) for every page version. Chunks are never given
+// back; LogindexSlabGetStats reports how much is reserved and in use.
+//
+
+#ifndef DB2_PG_LOGINDEX_SLAB_H
+#define DB2_PG_LOGINDEX_SLAB_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "access/logindex_hashmap.h"
+
+typedef struct LogindexSlabStats {
+    uint64_t headInUse;       // HashNodeHead handed out and not yet freed
+    uint64_t eleInUse;        // HashNodeEle handed out and not yet freed
+    uint64_t headReserved;    // HashNodeHead carved from chunks so far
+    uint64_t eleReserved;     // HashNodeEle carved from chunks so far
+    uint64_t bytesReserved;   // Total bytes obtained from malloc
+} LogindexSlabStats;
+
+extern HashNodeHead* LogindexSlabAllocHead(void);
+extern void LogindexSlabFreeHead(HashNodeHead *head);
+extern HashNodeEle* LogindexSlabAllocEle(void);
+extern void LogindexSlabFreeEle(HashNodeEle *ele);
+extern void LogindexSlabGetStats(LogindexSlabStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_LOGINDEX_SLAB_H
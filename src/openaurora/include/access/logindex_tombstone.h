@@ -0,0 +1,57 @@
+//
+// Lazy reclamation of the page versions of dropped and truncated relations.
+//
+// The versions of a relation dropped at an LSN stay readable below it, a
+// compute node or a clone of the database may still read there. Sweeping
+// them where the drop is redone would hold up the WAL parser for as long
+// as the relation is big, so the drop only leaves a tombstone of (spc, db,
+// rel) and its LSN. Reads at or after the LSN see the relation as empty
+// pages without looking at its chains, and a background thread reclaims
+// the versions once no compute node or clone reads below the LSN: the
+// hashmap chains a batch of blocks at a time through the relation index,
+// and the pages in RocksDB with one range delete, one by one with the
+// other engines. The version GC of a truncated fork is queued to the same
+// thread instead of running in RpcMdTruncate.
+//
+// A relfilenode created again while its tombstone is pending has it
+// reclaimed on the spot, before the new relation gets any versions. With
+// LOGINDEX_TOMBSTONE_MAX pending, a truncate's GC runs on the spot and a
+// drop leaves its versions behind, as drops always did before. Tombstones
+// are kept in memory only, a node restarted before reclaiming a drop leaves
+// its versions behind as well.
+//
+
+#ifndef DB2_PG_LOGINDEX_TOMBSTONE_H
+#define DB2_PG_LOGINDEX_TOMBSTONE_H
+
+#include <stdint.h>
+
+#include "access/logindex_hashmap.h"
+#include "storage/relfilenode.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOGINDEX_TOMBSTONE_MAX (1024)
+
+// Starts the thread reclaiming the versions in hashMap
+extern void LogindexTombstoneStart(HashMap hashMap);
+
+// The relation's forks were dropped at lsn
+extern void LogindexTombstoneDrop(RelFileNode rnode, uint64_t lsn);
+
+// The blocks >= fromBlk of relKey's fork were truncated away, queues their GC
+extern void LogindexTombstoneTruncate(KeyType relKey, int64_t fromBlk);
+
+// The relfilenode is about to be created, reclaims a drop of it still pending
+extern void LogindexTombstoneCreate(RelFileNode rnode);
+
+// Whether a read of the relation at lsn comes after its drop
+extern bool LogindexTombstoneHides(RelFileNode rnode, uint64_t lsn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_LOGINDEX_TOMBSTONE_H
@@ -0,0 +1,33 @@
+//
+// LSN waiter registry: lets rpc server threads sleep until the startup
+// process has parsed xlog up to a given LSN, instead of polling.
+//
+
+#ifndef DB2_PG_LSN_WAITER_H
+#define DB2_PG_LSN_WAITER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "postgres.h"
+#include "access/xlogdefs.h"
+
+/*
+ * Block until XLogParseUpto >= targetLsn, the parser reports it has reached
+ * the temporary end of xlog, or wait_usec elapses. Returns true if woken by
+ * the parser, false on timeout.
+ */
+extern bool LsnWaiterWait(XLogRecPtr targetLsn, uint32_t wait_usec);
+
+/* Wake every waiter whose target is <= parsedUpto. Called by the parser. */
+extern void LsnWaiterAdvance(XLogRecPtr parsedUpto);
+
+/* Wake every waiter regardless of its target (e.g. end of available xlog). */
+extern void LsnWaiterWakeAll(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_LSN_WAITER_H
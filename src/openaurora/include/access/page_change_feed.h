@@ -0,0 +1,78 @@
+//
+// Page change feed of the storage node for secondary compute nodes.
+//
+// The xlog parser appends a (page, LSN) entry for every page version it
+// hands to the logindex, in LSN order, to a ring of PAGE_CHANGE_FEED_ENTRIES
+// entries (256k unless set). Each entry gets a sequence number, and a
+// secondary follows the feed with the next sequence number it wants, over
+// RpcFetchPageChanges. A reply says how far the secondary got and up to
+// which LSN the feed is complete: every page changed by a record starting
+// at or after since and before upto is in an entry before nextSeq. A
+// secondary that fell off the ring is told so and has to assume every page
+// changed.
+//
+// The ring is only filled once a secondary asked for it the first time, and
+// since is the end of the first record parsed after that; it stays invalid
+// until then.
+//
+
+#ifndef DB2_PG_PAGE_CHANGE_FEED_H
+#define DB2_PG_PAGE_CHANGE_FEED_H
+
+#include <stdint.h>
+
+#include "access/xlogdefs.h"
+#include "access/logindex_hashmap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PAGE_CHANGE_FEED_DEFAULT_ENTRIES (256 * 1024)
+// Entries a reply carries at most
+#define PAGE_CHANGE_FEED_MAX_BATCH (8192)
+
+// The entries before nextSeq were overwritten, the reply starts at the
+// oldest one kept
+#define PAGE_CHANGE_FEED_OVERFLOW (1 << 0)
+
+typedef struct PageChangeFeedHeader {
+    uint64_t nextSeq;
+    uint64_t since;
+    uint64_t upto;
+    uint32_t count;
+    uint32_t flags;
+} PageChangeFeedHeader;
+
+typedef struct PageChangeFeedEntry {
+    uint64_t lsn;
+    uint32_t spcNode;
+    uint32_t dbNode;
+    uint32_t relNode;
+    uint32_t blockNum;
+    int32_t  forkNum;
+} PageChangeFeedEntry;
+
+struct XLogReaderState;
+
+// Parser side, called with every version given to the logindex and with
+// the end of every record parsed
+extern void PageChangeFeedPublish(KeyType key, XLogRecPtr lsn);
+extern void PageChangeFeedAdvance(XLogRecPtr parsedUpto);
+
+// Publishes every page of a record redone by the parser itself
+extern void PageChangeFeedPublishRecord(struct XLogReaderState *record);
+
+// Bytes a reply of up to maxEntries entries takes
+extern size_t PageChangeFeedReplySize(int maxEntries);
+
+// Writes the header and the entries from fromSeq into buf, waiting up to
+// waitMs for something past fromSeq. Returns the bytes written, 0 if the
+// feed couldn't be set up.
+extern size_t PageChangeFeedRead(uint64_t fromSeq, int maxEntries, int waitMs, char *buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_PAGE_CHANGE_FEED_H
@@ -0,0 +1,51 @@
+/*-------------------------------------------------------------------------
+ *
+ * parallelredo.h
+ *	  Parallel page redo of a compute node's hot standby
+ *
+ * Portions Copyright (c) 1996-2020, PostgreSQL Global Development Group
+ *
+ * src/include/access/parallelredo.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef PARALLELREDO_H
+#define PARALLELREDO_H
+
+#include "access/xlogreader.h"
+#include "storage/buf_internals.h"
+
+/* GUC, 0 has the startup process redo the pages itself */
+extern int	rpc_redo_workers;
+
+extern Size ParallelRedoShmemSize(void);
+extern void ParallelRedoShmemInit(void);
+
+/* Launches the workers the first time, false if none could be */
+extern bool ParallelRedoEnabled(void);
+
+/*
+ * Hands the pages in buffers of the record just read to the workers, each
+ * page to the one its BufferTag hashes to.
+ */
+extern void ParallelRedoDispatch(XLogReaderState *record, BufferTag *tags,
+								 int ntags);
+
+/* Has a page been handed to a worker and not yet redone? */
+extern bool ParallelRedoInProgress(void);
+
+/* Wait until every page handed to the workers is redone */
+extern void ParallelRedoWaitAll(void);
+
+/*
+ * The end of the last record of those up to upto all of whose pages are
+ * redone, upto being the end of the record the startup process is at.
+ */
+extern XLogRecPtr ParallelRedoReplayedUpto(XLogRecPtr upto);
+
+/* Wait for the workers to finish and stop them, as recovery ends */
+extern void ParallelRedoShutdown(void);
+
+extern void ParallelRedoWorkerMain(Datum main_arg);
+
+#endif							/* PARALLELREDO_H */
@@ -32,6 +32,17 @@
  */
 #define SLRU_PAGES_PER_SEGMENT	32
 
+/*
+ * A page can only live in the bank of slots its page number maps to, so that
+ * looking one up or picking a victim scans one bank rather than every slot.
+ * This keeps large SLRU pools cheap; a pool of fewer than two banks' worth of
+ * slots is a single bank, as it always was.
+ */
+#define SLRU_BANK_SIZE			16
+
+/* Upper limit of the SLRU buffer GUCs, 1GB of pages */
+#define SLRU_MAX_ALLOWED_BUFFERS ((1024 * 1024 * 1024) / BLCKSZ)
+
 /*
  * Page status codes.  Note that these do not include the "dirty" bit.
  * page_dirty can be true only in the VALID or WRITE_IN_PROGRESS states;
@@ -56,6 +67,9 @@ typedef struct SlruSharedData
 	/* Number of buffers managed by this SLRU structure */
 	int			num_slots;
 
+	/* Number of banks the slots are split into, see SLRU_BANK_SIZE */
+	int			num_banks;
+
 	/*
 	 * Arrays holding info for each buffer slot.  Page number is undefined
 	 * when status is EMPTY, as is page_lru_count.
@@ -196,6 +196,12 @@ typedef struct VariableCacheData
 	TransactionId latestCompletedXid;	/* newest XID that has committed or
 										 * aborted */
 
+	/*
+	 * Number of times a transaction with an XID left the ProcArray, starting
+	 * at 1.  A snapshot taken at the same count is still current.
+	 */
+	uint64		xactCompletionCount;
+
 	/*
 	 * These fields are protected by XactTruncationLock
 	 */
@@ -0,0 +1,79 @@
+//
+// Compressed WAL retention of the storage node
+//
+#ifndef SRC_WAL_RETENTION_H
+#define SRC_WAL_RETENTION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "access/xlogdefs.h"
+
+//! The storage node keeps every WAL segment its redo processes may replay
+//! versions from, and under replica lag that is a lot of raw segments. A
+//! background pass every WAL_RETENTION_INTERVAL compresses the segments
+//! wholly wal_retention_compress_age of WAL below what is parsed and
+//! written: each WAL_RETENTION_BLOCK of a segment with ZSTD, into a file of
+//! WAL_RETENTION_DIR next to an index of where each block went. Once that
+//! file is durable, the blocks are punched out of the segment, which keeps
+//! its name and size, so every path that opens a segment works as before.
+//!
+//! A punched block reads as zeros, and no WAL page has a zero xlp_magic. A
+//! reader finding one where a page starts, XLogReadFile() for the parser
+//! and redo processes or RpcPgPRead for compute nodes, takes the block from
+//! the compressed file instead, through a cache of the blocks each thread
+//! decompressed last. A block that doesn't shrink is neither stored nor
+//! punched, and a crash between the two leaves a segment whole.
+//!
+//! A compressed file whose segment is gone is removed by the next pass.
+
+//! File Format: WalRetentionHeader, WalRetentionBlock[blocks], frames
+
+// GUC, MB of WAL, -1 never compresses
+extern int wal_retention_compress_age;
+
+#define WAL_RETENTION_DIR "pg_wal/compressed"
+#define WAL_RETENTION_BLOCK (1024 * 1024)
+#define WAL_RETENTION_INTERVAL (30)   // seconds
+
+#define WAL_RETENTION_MAGIC (0x57524346)   // "WRCF"
+
+typedef struct WalRetentionHeader {
+    uint32_t magic;
+    uint32_t blockSize;
+    uint32_t blocks;
+    uint32_t reserved;
+} WalRetentionHeader;
+
+typedef struct WalRetentionBlock {
+    // Of the frame in the file
+    uint64_t offset;
+    // 0 for a block left in the segment
+    uint32_t length;
+    uint32_t reserved;
+} WalRetentionBlock;
+
+// Starts the background pass of the storage node
+extern void WalRetentionStart(void);
+
+// Compresses the segment, false if it stays as it is
+extern bool WalRetentionCompressSegment(TimeLineID tli, XLogSegNo segno);
+
+// Puts back what reading amount bytes at off of the segment returned as
+// zeros for a punched block. False if the compressed file can't be read.
+extern bool WalRetentionFill(TimeLineID tli, XLogSegNo segno, char *buf, int amount, uint32_t off);
+
+// WalRetentionFill() for a read of fd, if it is a segment
+extern bool WalRetentionFillFd(int fd, char *buf, int amount, uint32_t off);
+
+// Segments compressed, their bytes, and the bytes their files take
+extern void WalRetentionCounts(uint64_t *segments, uint64_t *rawBytes, uint64_t *storedBytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_WAL_RETENTION_H
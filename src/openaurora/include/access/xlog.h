@@ -110,13 +110,18 @@ extern int	max_wal_size_mb;
 extern int	wal_keep_size_mb;
 extern int	max_slot_wal_keep_size_mb;
 extern int	XLOGbuffers;
+extern int	XLOGInsertLocks;
+
+/* Upper limit of wal_insert_locks */
+#define MAX_XLOGINSERT_LOCKS	1024
 extern int	XLogArchiveTimeout;
 extern int	wal_retrieve_retry_interval;
+extern int	wal_readahead_size;
 extern char *XLogArchiveCommand;
 extern bool EnableHotStandby;
 extern bool fullPageWrites;
 extern bool wal_log_hints;
-extern bool wal_compression;
+extern int	wal_compression;
 extern bool wal_init_zero;
 extern bool wal_recycle;
 extern bool *wal_consistency_checking;
@@ -137,6 +142,8 @@ extern TransactionId recoveryTargetXid;
 extern char *recovery_target_time_string;
 extern const char *recoveryTargetName;
 extern XLogRecPtr recoveryTargetLSN;
+extern XLogRecPtr RpcAsOfLsn;
+extern bool rpc_instant_recovery;
 extern RecoveryTargetType recoveryTarget;
 extern char *PromoteTriggerFile;
 extern RecoveryTargetTimeLineGoal recoveryTargetTimeLineGoal;
@@ -158,6 +165,14 @@ typedef enum ArchiveMode
 } ArchiveMode;
 extern int	XLogArchiveMode;
 
+/* Compression algorithms for full-page images, see wal_compression */
+typedef enum WalCompression
+{
+	WAL_COMPRESSION_NONE = 0,
+	WAL_COMPRESSION_PGLZ,
+	WAL_COMPRESSION_LZ4
+} WalCompression;
+
 /* WAL levels */
 typedef enum WalLevel
 {
@@ -362,11 +377,18 @@ extern int	XLogPageRead(XLogReaderState *xlogreader, XLogRecPtr targetPagePtr,
 // Use this file to initialize recovery TLI for wal_redo process
 extern void ReadControlFileTimeLine(void);
 
+// The LSN compute node reads are made at, RpcAsOfLsn once it's set
 extern uint64_t GetLogWrtResultLsn(void);
 extern void GetLogWrtResult(XLogRecPtr* Write, XLogRecPtr* Flush);
 extern void UpdateLogWrtResult(XLogRecPtr Write, XLogRecPtr Flush);
 extern void ParseXLogBlocksLsn(XLogReaderState *record, int recordBlockId);
 
+// WAL queued for and written to the segment files of a storage node
+extern void XLogRpcPersistQueued(XLogRecPtr upto);
+extern void XLogRpcPersistWritten(XLogRecPtr upto);
+extern void XLogRpcPersistWait(XLogRecPtr upto);
+extern XLogRecPtr XLogRpcPersistedUpto(XLogRecPtr upto);
+
 #ifdef __cplusplus
 }
 #endif
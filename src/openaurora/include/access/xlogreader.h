@@ -29,6 +29,11 @@
  *		with the XLogRec* macros and functions. You can also decode a
  *		record that's already constructed in memory, without reading from
  *		disk, by calling the DecodeXLogRecord() function.
+ *
+ *		XLogReadRecordBatch() reads many records at once, to be decoded one
+ *		after the other with XLogRecordBatchDecode().  With a ring of pages
+ *		set up by XLogReaderSetReadahead(), most of them are left where they
+ *		were read instead of being copied.
  *-------------------------------------------------------------------------
  */
 #ifndef XLOGREADER_H
@@ -208,6 +213,21 @@ struct XLogReaderState
 	char	   *readBuf;
 	uint32		readLen;
 
+	/*
+	 * Ring of readaheadPages pages readBuf moves through, a page going to
+	 * slot pageptr / XLOG_BLCKSZ % readaheadPages, or NULL if readBuf is a
+	 * single page.  readaheadPagePtrs has the page last read into each slot,
+	 * readBufPagePtr that of readBuf without a ring.  readaheadPinned is the
+	 * first page holding a record of the current batch, which isn't to be
+	 * read over; readaheadFull is set when a page would have been.
+	 */
+	char	   *readaheadBuf;
+	XLogRecPtr *readaheadPagePtrs;
+	int			readaheadPages;
+	XLogRecPtr	readBufPagePtr;
+	XLogRecPtr	readaheadPinned;
+	bool		readaheadFull;
+
 	/* last read XLOG position for data currently in readBuf */
 	WALSegmentContext segcxt;
 	WALOpenSegment seg;
@@ -262,6 +282,9 @@ extern XLogReaderRoutine *LocalXLogReaderRoutine(void);
 /* Free an XLogReader */
 extern void XLogReaderFree(XLogReaderState *state);
 
+/* Read into a ring of npages pages, see XLogReadRecordBatch() */
+extern bool XLogReaderSetReadahead(XLogReaderState *state, int npages);
+
 /* Position the XLogReader to given record */
 extern void XLogBeginRead(XLogReaderState *state, XLogRecPtr RecPtr);
 #ifdef FRONTEND
@@ -272,6 +295,38 @@ extern XLogRecPtr XLogFindNextRecord(XLogReaderState *state, XLogRecPtr RecPtr);
 extern struct XLogRecord *XLogReadRecord(XLogReaderState *state,
 										 char **errormsg);
 
+/*
+ * Records read by XLogReadRecordBatch(), in the reader's pages or, if they
+ * cross a page boundary, in arena.  startptrs and endptrs have the
+ * ReadRecPtr and EndRecPtr of each, prevReadRecPtr and prevEndRecPtr the
+ * reader's before the batch.
+ */
+typedef struct XLogRecordBatch
+{
+	int			max_records;
+	int			nrecords;
+	XLogRecord **records;
+	XLogRecPtr *startptrs;
+	XLogRecPtr *endptrs;
+	XLogRecPtr	prevReadRecPtr;
+	XLogRecPtr	prevEndRecPtr;
+	char	   *arena;
+	Size		arena_size;
+	Size		arena_used;
+} XLogRecordBatch;
+
+extern XLogRecordBatch *XLogRecordBatchAllocate(int max_records);
+extern void XLogRecordBatchFree(XLogRecordBatch *batch);
+
+/* Read the records up to upto, or as many as fit. Returns how many */
+extern int	XLogReadRecordBatch(XLogReaderState *state, XLogRecordBatch *batch,
+								XLogRecPtr upto, char **errormsg);
+
+/* Decode record i of a batch, moving the reader past it */
+extern struct XLogRecord *XLogRecordBatchDecode(XLogReaderState *state,
+												XLogRecordBatch *batch, int i,
+												char **errormsg);
+
 /* Validate a page */
 extern bool XLogReaderValidatePageHeader(XLogReaderState *state,
 										 XLogRecPtr recptr, char *phdr);
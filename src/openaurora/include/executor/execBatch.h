@@ -0,0 +1,63 @@
+/*-------------------------------------------------------------------------
+ *
+ * execBatch.h
+ *	  Vectorized evaluation of scan quals over a page of tuples
+ *
+ * A batch is the visible tuples of one heap page. The columns a qual uses
+ * are pulled out of them into arrays, and the qual is evaluated column at
+ * a time, leaving the rows it kept in a selection vector. Only clauses of
+ * the shapes below are evaluated this way:
+ *
+ *		operand op operand, op a btree comparison of integers, oids or dates
+ *		column IS [NOT] NULL
+ *
+ * where an operand is a column, a non-null constant, or +, - or * of two
+ * integer operands (of the same type). Every value is held as an int64.
+ *
+ * Portions Copyright (c) 1996-2020, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/executor/execBatch.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef EXECBATCH_H
+#define EXECBATCH_H
+
+#include "access/htup_details.h"
+#include "executor/tuptable.h"
+#include "nodes/pg_list.h"
+
+#define BATCH_MAX_ROWS	MaxHeapTuplesPerPage
+
+typedef struct BatchExpr BatchExpr;
+
+typedef struct BatchQual
+{
+	int			ncolumns;
+	AttrNumber *attnos;			/* scan attribute of each column */
+	Oid		   *types;			/* and its type */
+	AttrNumber	maxattno;		/* the slots are deformed up to this one */
+	int64	  **values;			/* [column][row] */
+	bool	  **nulls;			/* [column][row] */
+	List	   *clauses;		/* BatchExpr *, implicitly ANDed */
+} BatchQual;
+
+/*
+ * Compiles the longest leading run of qual's clauses that can be evaluated
+ * in batches, and returns the remaining clauses in *residual; they have to
+ * be checked row by row after the batch ones, to keep the order in which
+ * the clauses may raise errors. Returns NULL if the first clause can't be.
+ */
+extern BatchQual *ExecInitBatchQual(List *qual, Index scanrelid, List **residual);
+
+/* Pulls the batch columns of the tuple in slot into row */
+extern void ExecBatchQualLoad(BatchQual *bq, int row, TupleTableSlot *slot);
+
+/*
+ * Evaluates the qual over rows 0 .. nrows-1, and fills selection with the
+ * rows it is true for, in order. Returns how many there are.
+ */
+extern int	ExecBatchQual(BatchQual *bq, int nrows, uint16 *selection);
+
+#endif							/* EXECBATCH_H */
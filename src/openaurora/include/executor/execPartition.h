@@ -59,7 +59,9 @@ typedef struct PartitionRoutingInfo
  * subpart_map contains indexes into PartitionPruningData.partrelprunedata[].
  *
  * nparts						Length of subplan_map[] and subpart_map[].
+ * partoids						The OIDs of the partitions the maps are for.
  * subplan_map					Subplan index by partition index, or -1.
+ * initial_subplan_map			subplan_map before any pruning changed it.
  * subpart_map					Subpart index by partition index, or -1.
  * present_parts				A Bitmapset of the partition indexes that we
  *								have subplans or subparts for.
@@ -75,7 +77,9 @@ typedef struct PartitionRoutingInfo
 typedef struct PartitionedRelPruningData
 {
 	int			nparts;
+	Oid		   *partoids;
 	int		   *subplan_map;
+	int		   *initial_subplan_map;
 	int		   *subpart_map;
 	Bitmapset  *present_parts;
 	List	   *initial_pruning_steps;
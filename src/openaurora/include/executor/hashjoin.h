@@ -39,6 +39,9 @@
  * "hashCxt", while storage that is only wanted for the current batch is
  * allocated in the "batchCxt".  By resetting the batchCxt at the end of
  * each batch, we free all the per-batch storage reliably and without tedium.
+ * The chunks the batch's tuples are packed in come from the "tupleCxt", a
+ * bump context reset along with the batchCxt, as they are never freed
+ * before that.  (Parallel Hash keeps its chunks in shared memory instead.)
  *
  * During first scan of inner relation, we get its tuples from executor.
  * If nbatch > 1 then tuples that don't belong in first batch get saved
@@ -347,9 +350,14 @@ typedef struct HashJoinTableData
 
 	MemoryContext hashCxt;		/* context for whole-hash-join storage */
 	MemoryContext batchCxt;		/* context for this-batch-only storage */
+	MemoryContext tupleCxt;		/* bump context for this batch's chunks */
+
+	/* hash values of every inner tuple, for the outer scan (NULL if none) */
+	struct bloom_filter *bloom;
 
 	/* used for dense allocation of tuples (into linked chunks) */
 	HashMemoryChunk chunks;		/* one list for the whole batch */
+	HashMemoryChunk unusedChunks;	/* emptied chunks, for reuse */
 
 	/* Shared and private state for Parallel Hash. */
 	HashMemoryChunk current_chunk;	/* this backend's current chunk */
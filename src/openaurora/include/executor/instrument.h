@@ -30,6 +30,10 @@ typedef struct BufferUsage
 	long		temp_blks_written;	/* # of temp blocks written */
 	instr_time	blk_read_time;	/* time spent reading */
 	instr_time	blk_write_time; /* time spent writing */
+	long		remote_blks_read;	/* # of blocks read from storage nodes */
+	long		mempool_blks_hit;	/* # of blocks read from memory nodes */
+	uint64		remote_read_bytes;	/* size of the replies to both */
+	instr_time	remote_blk_read_time;	/* time spent on both */
 } BufferUsage;
 
 typedef struct WalUsage
@@ -39,6 +43,14 @@ typedef struct WalUsage
 	uint64		wal_bytes;		/* size of WAL records produced */
 } WalUsage;
 
+typedef struct StorageUsage
+{
+	long		remote_reads;	/* # of pages read from storage nodes */
+	uint64		remote_bytes;	/* size of the replies to those reads */
+	uint64		wait_parse_ns;	/* time storage nodes waited for WAL parsing */
+	uint64		replay_ns;		/* time storage nodes spent replaying */
+} StorageUsage;
+
 /* Flag bits included in InstrAlloc's instrument_options bitmask */
 typedef enum InstrumentOption
 {
@@ -46,6 +58,7 @@ typedef enum InstrumentOption
 	INSTRUMENT_BUFFERS = 1 << 1,	/* needs buffer usage */
 	INSTRUMENT_ROWS = 1 << 2,	/* needs row count */
 	INSTRUMENT_WAL = 1 << 3,	/* needs WAL usage */
+	INSTRUMENT_STORAGE = 1 << 4,	/* needs storage node read usage */
 	INSTRUMENT_ALL = PG_INT32_MAX
 } InstrumentOption;
 
@@ -55,6 +68,7 @@ typedef struct Instrumentation
 	bool		need_timer;		/* true if we need timer data */
 	bool		need_bufusage;	/* true if we need buffer usage data */
 	bool		need_walusage;	/* true if we need WAL usage data */
+	bool		need_storageusage;	/* true if we need storage usage data */
 	/* Info about current plan cycle: */
 	bool		running;		/* true if we've completed first tuple */
 	instr_time	starttime;		/* start time of current iteration of node */
@@ -63,6 +77,7 @@ typedef struct Instrumentation
 	double		tuplecount;		/* # of tuples emitted so far this cycle */
 	BufferUsage bufusage_start; /* buffer usage at start */
 	WalUsage	walusage_start; /* WAL usage at start */
+	StorageUsage storageusage_start;	/* storage usage at start */
 	/* Accumulated statistics across all completed cycles: */
 	double		startup;		/* total startup time (in seconds) */
 	double		total;			/* total time (in seconds) */
@@ -73,6 +88,7 @@ typedef struct Instrumentation
 	double		nfiltered2;		/* # of tuples removed by "other" quals */
 	BufferUsage bufusage;		/* total buffer usage */
 	WalUsage	walusage;		/* total WAL usage */
+	StorageUsage storageusage;	/* total storage usage */
 } Instrumentation;
 
 typedef struct WorkerInstrumentation
@@ -84,10 +100,20 @@ typedef struct WorkerInstrumentation
 extern PGDLLIMPORT BufferUsage pgBufferUsage;
 extern PGDLLIMPORT WalUsage pgWalUsage;
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+/* Added to by the RPC client, in rpcclient.cpp */
+extern PGDLLIMPORT StorageUsage pgStorageUsage;
+#ifdef __cplusplus
+}
+#endif
+
 extern Instrumentation *InstrAlloc(int n, int instrument_options);
 extern void InstrInit(Instrumentation *instr, int instrument_options);
 extern void InstrStartNode(Instrumentation *instr);
 extern void InstrStopNode(Instrumentation *instr, double nTuples);
+extern void InstrUpdateTupleCount(Instrumentation *instr, double nTuples);
 extern void InstrEndLoop(Instrumentation *instr);
 extern void InstrAggNode(Instrumentation *dst, Instrumentation *add);
 extern void InstrStartParallelQuery(void);
@@ -97,5 +123,7 @@ extern void BufferUsageAccumDiff(BufferUsage *dst,
 								 const BufferUsage *add, const BufferUsage *sub);
 extern void WalUsageAccumDiff(WalUsage *dst, const WalUsage *add,
 							  const WalUsage *sub);
+extern void StorageUsageAccumDiff(StorageUsage *dst, const StorageUsage *add,
+								  const StorageUsage *sub);
 
 #endif							/* INSTRUMENT_H */
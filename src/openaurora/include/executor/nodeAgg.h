@@ -16,6 +16,7 @@
 
 #include "access/parallel.h"
 #include "nodes/execnodes.h"
+#include "utils/aggbatch.h"
 
 
 /*
@@ -165,6 +166,18 @@ typedef struct AggStatePerTransData
 	FunctionCallInfo serialfn_fcinfo;
 
 	FunctionCallInfo deserialfn_fcinfo;
+
+	/*
+	 * The batched version of the transfn, or NULL if the state is advanced
+	 * by the phase's evaltrans.  Its input, if it has one, is evaluated by
+	 * batch_argstate into batch_values and batch_nulls, see nodeAgg.c.
+	 */
+	AggBatchTransFunc batch_transfn;
+	ExprState  *batch_argstate;
+	int16		batch_argtypeLen;
+	bool		batch_argtypeByVal;
+	Datum	   *batch_values;
+	bool	   *batch_nulls;
 }			AggStatePerTransData;
 
 /*
@@ -314,6 +327,8 @@ typedef struct AggStatePerHashData
 }			AggStatePerHashData;
 
 
+extern bool enable_batch_agg;
+
 extern AggState *ExecInitAgg(Agg *node, EState *estate, int eflags);
 extern void ExecEndAgg(AggState *node);
 extern void ExecReScanAgg(AggState *node);
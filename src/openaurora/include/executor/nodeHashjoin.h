@@ -18,6 +18,8 @@
 #include "nodes/execnodes.h"
 #include "storage/buffile.h"
 
+extern bool enable_hashjoin_bloom;
+
 extern HashJoinState *ExecInitHashJoin(HashJoin *node, EState *estate, int eflags);
 extern void ExecEndHashJoin(HashJoinState *node);
 extern void ExecReScanHashJoin(HashJoinState *node);
@@ -31,4 +33,6 @@ extern void ExecHashJoinInitializeWorker(HashJoinState *state,
 extern void ExecHashJoinSaveTuple(MinimalTuple tuple, uint32 hashvalue,
 								  BufFile **fileptr);
 
+extern bool ExecHashJoinOuterMayMatch(HashJoinState *hjstate, TupleTableSlot *slot);
+
 #endif							/* NODEHASHJOIN_H */
@@ -18,6 +18,8 @@
 #include "access/parallel.h"
 #include "nodes/execnodes.h"
 
+extern int	rpc_index_prefetch_distance;
+
 extern IndexScanState *ExecInitIndexScan(IndexScan *node, EState *estate, int eflags);
 extern void ExecEndIndexScan(IndexScanState *node);
 extern void ExecIndexMarkPos(IndexScanState *node);
@@ -0,0 +1,27 @@
+/*-------------------------------------------------------------------------
+ *
+ * nodeRpcScan.h
+ *	  Scans whose pages are filtered, and aggregates computed halfway, on
+ *	  the storage node.
+ *
+ *
+ * Portions Copyright (c) 1996-2020, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/executor/nodeRpcScan.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef NODERPCSCAN_H
+#define NODERPCSCAN_H
+
+#include "nodes/pathnodes.h"
+
+extern void create_rpc_scan_paths(PlannerInfo *root, RelOptInfo *rel,
+								  RangeTblEntry *rte);
+extern void create_rpc_agg_paths(PlannerInfo *root, RelOptInfo *input_rel,
+								 RelOptInfo *grouped_rel,
+								 PathTarget *partial_target,
+								 GroupPathExtraData *extra);
+
+#endif							/* NODERPCSCAN_H */
@@ -53,6 +53,10 @@ typedef struct LLVMJitContext
 
 	/* list of handles for code emitted via Orc */
 	List	   *handles;
+
+	/* cache entries the context's code is in, and its functions' addresses */
+	List	   *cached;
+	List	   *cached_functions;
 } LLVMJitContext;
 
 /* llvm module containing information about types */
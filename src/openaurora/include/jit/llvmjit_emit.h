@@ -117,6 +117,24 @@ l_load_struct_gep(LLVMBuilderRef b, LLVMValueRef v, int32 idx, const char *name)
 /*
  * Load value of a pointer, after applying one index operation.
  */
+/*
+ * Load the value of type type at byte offset off of the object v points to,
+ * for fields inside unions, which have no struct index.
+ */
+static inline LLVMValueRef
+l_load_offset(LLVMBuilderRef b, LLVMValueRef v, size_t off, LLVMTypeRef type,
+			  const char *name)
+{
+	LLVMValueRef v_off = l_sizet_const(off);
+	LLVMValueRef v_ptr;
+
+	v_ptr = LLVMBuildBitCast(b, v, l_ptr(LLVMInt8Type()), "");
+	v_ptr = LLVMBuildGEP(b, v_ptr, &v_off, 1, "");
+	v_ptr = LLVMBuildBitCast(b, v_ptr, l_ptr(type), "");
+
+	return LLVMBuildLoad(b, v_ptr, name);
+}
+
 static inline LLVMValueRef
 l_load_gep1(LLVMBuilderRef b, LLVMValueRef v, LLVMValueRef idx, const char *name)
 {
@@ -82,6 +82,7 @@ typedef struct ExprState
 	/*
 	 * Instructions to compute expression's return value.
 	 */
+#define FIELDNO_EXPRSTATE_STEPS 5
 	struct ExprEvalStep *steps;
 
 	/*
@@ -447,6 +448,13 @@ typedef struct ResultRelInfo
 	/* true when modifying foreign table directly */
 	bool		ri_usesFdwDirectModify;
 
+	/* batch insert stuff */
+	int			ri_NumSlots;	/* number of slots in the array */
+	int			ri_NumSlotsInitialized; /* number of initialized slots */
+	int			ri_BatchSize;	/* max slots inserted in a single batch */
+	TupleTableSlot **ri_Slots;	/* input tuples for batch insert */
+	TupleTableSlot **ri_PlanSlots;
+
 	/* list of WithCheckOption's to be checked */
 	List	   *ri_WithCheckOptions;
 
@@ -986,6 +994,8 @@ typedef struct PlanState
 	ExprContext *ps_ExprContext;	/* node's expression-evaluation context */
 	ProjectionInfo *ps_ProjInfo;	/* info for doing tuple projection */
 
+	bool		async_capable;	/* true if node is async-capable */
+
 	/*
 	 * Scanslot's descriptor if known. This is a bit of a hack, but otherwise
 	 * it's hard for expression compilation to optimize based on the
@@ -1199,16 +1209,39 @@ typedef struct ModifyTableState
 	TupleConversionMap **mt_per_subplan_tupconv_maps;
 } ModifyTableState;
 
+/* ----------------
+ *	 AsyncRequest
+ *
+ *		State for an asynchronous tuple request: a requestor node (an
+ *		Append) asks a requestee node (an async-capable ForeignScan) for a
+ *		tuple, and the requestee either answers right away or marks the
+ *		request pending, to be completed when its wait event fires.
+ * ----------------
+ */
+typedef struct AsyncRequest
+{
+	struct PlanState *requestor;	/* Node that wants a tuple */
+	struct PlanState *requestee;	/* Node from which a tuple is wanted */
+	int			request_index;	/* Scratch space for requestor */
+	bool		callback_pending;	/* Callback is needed */
+	bool		request_complete;	/* Request complete, result valid */
+	TupleTableSlot *result;		/* Result (NULL or an empty slot if no more
+								 * tuples) */
+} AsyncRequest;
+
 /* ----------------
  *	 AppendState information
  *
  *		nplans				how many plans are in the array
- *		whichplan			which plan is being executed (0 .. n-1), or a
- *							special negative value. See nodeAppend.c.
+ *		whichplan			which sync plan is being executed (0 .. n-1),
+ *							or a special negative value. See nodeAppend.c.
  *		prune_state			details required to allow partitions to be
  *							eliminated from the scan, or NULL if not possible.
- *		valid_subplans		for runtime pruning, valid appendplans indexes to
- *							scan.
+ *		valid_subplans		for runtime pruning, valid synchronous
+ *							appendplans indexes to scan.
+ *		asyncplans			indexes of the async-capable appendplans; they
+ *							are all started at once and their tuples are
+ *							returned as they arrive (see nodeAppend.c).
  * ----------------
  */
 
@@ -1229,7 +1262,24 @@ struct AppendState
 	ParallelAppendState *as_pstate; /* parallel coordination info */
 	Size		pstate_len;		/* size of parallel coordination info */
 	struct PartitionPruneState *as_prune_state;
+	bool		as_valid_subplans_identified;	/* is as_valid_subplans valid? */
 	Bitmapset  *as_valid_subplans;
+	Bitmapset  *as_valid_asyncplans;	/* valid asynchronous plans indexes */
+	bool		as_begun;		/* false means need to initialize */
+
+	/* Asynchronous execution state */
+	Bitmapset  *as_asyncplans;	/* asynchronous plans indexes */
+	int			as_nasyncplans; /* # of asynchronous plans */
+	AsyncRequest **as_asyncrequests;	/* array of AsyncRequests */
+	TupleTableSlot **as_asyncresults;	/* unreturned results of async plans */
+	int			as_nasyncresults;	/* # of valid entries in as_asyncresults */
+	bool		as_syncdone;	/* true if all synchronous plans done in
+								 * asynchronous mode, else false */
+	int			as_nasyncremain;	/* # of remaining asynchronous plans */
+	Bitmapset  *as_needrequest; /* asynchronous plans needing a new request */
+	struct WaitEventSet *as_eventset;	/* WaitEventSet used to configure file
+										 * descriptor wait events */
+
 	bool		(*choose_next_subplan) (AppendState *);
 };
 
@@ -1327,6 +1377,8 @@ typedef struct BitmapOrState
  *		currentRelation    relation being scanned (NULL if none)
  *		currentScanDesc    current scan descriptor for scan (NULL if none)
  *		ScanTupleSlot	   pointer to slot in tuple table holding scan tuple
+ *		HashFilter		   hash join whose bloom filter of inner keys the
+ *						   scan's tuples must pass (NULL if none)
  * ----------------
  */
 typedef struct ScanState
@@ -1335,6 +1387,7 @@ typedef struct ScanState
 	Relation	ss_currentRelation;
 	struct TableScanDescData *ss_currentScanDesc;
 	TupleTableSlot *ss_ScanTupleSlot;
+	struct HashJoinState *ss_HashFilter;
 } ScanState;
 
 /* ----------------
@@ -1345,6 +1398,15 @@ typedef struct SeqScanState
 {
 	ScanState	ss;				/* its first field is NodeTag */
 	Size		pscan_len;		/* size of parallel heap scan descriptor */
+
+	/* batch mode, see executor/execBatch.h; batchqual is NULL in row mode */
+	struct BatchQual *batchqual;	/* the leading clauses of the qual */
+	ExprState  *batchresidual;	/* the rest, checked row by row */
+	HeapTupleData *batchtuples; /* the current page's visible tuples */
+	uint16	   *batchselection; /* of them, those batchqual is true for */
+	Buffer		batchbuffer;	/* the page batchtuples point into */
+	int			batchsize;		/* entries of batchselection */
+	int			batchpos;		/* the next of them to return */
 } SeqScanState;
 
 /* ----------------
@@ -1414,6 +1476,7 @@ typedef struct
  *		OrderByTypByVals   is the datatype of order by expression pass-by-value?
  *		OrderByTypLens	   typlens of the datatypes of order by expressions
  *		PscanLen		   size of parallel index scan descriptor
+ *		Prefetch		   TIDs read ahead to fetch their heap pages, or NULL
  * ----------------
  */
 typedef struct IndexScanState
@@ -1441,6 +1504,7 @@ typedef struct IndexScanState
 	bool	   *iss_OrderByTypByVals;
 	int16	   *iss_OrderByTypLens;
 	Size		iss_PscanLen;
+	struct IndexPrefetchQueue *iss_Prefetch;
 } IndexScanState;
 
 /* ----------------
@@ -1580,6 +1644,8 @@ typedef struct ParallelBitmapHeapState
  *		shared_tbmiterator	   shared iterator
  *		shared_prefetch_iterator shared iterator for prefetching
  *		pstate			   shared state for parallel bitmap scan
+ *		stream_iterator	   iterator naming pages to the scan's read stream
+ *		stream_nblocks	   # blocks of the relation, as of the stream's start
  * ----------------
  */
 typedef struct BitmapHeapScanState
@@ -1604,6 +1670,8 @@ typedef struct BitmapHeapScanState
 	TBMSharedIterator *shared_tbmiterator;
 	TBMSharedIterator *shared_prefetch_iterator;
 	ParallelBitmapHeapState *pstate;
+	TBMIterator *stream_iterator;
+	BlockNumber stream_nblocks;
 } BitmapHeapScanState;
 
 /* ----------------
@@ -1959,6 +2027,8 @@ typedef struct HashJoinState
 	int			hj_JoinState;
 	bool		hj_MatchedOuter;
 	bool		hj_OuterNotEmpty;
+	ExprContext *hj_BloomContext;	/* for the outer scan's bloom checks, NULL
+									 * if the join doesn't push one down */
 } HashJoinState;
 
 
@@ -2218,6 +2288,12 @@ typedef struct AggState
 										 * ->hash_pergroup */
 	ProjectionInfo *combinedproj;	/* projection machinery */
 	SharedAggInfo *shared_info; /* one entry per worker */
+	TupleTableSlot **hash_batch;	/* input tuples hashed ahead of their
+									 * lookups, NULL unless the table won't
+									 * fit in cache */
+	bool		agg_batching;	/* any batched transition states? */
+	int			agg_batch_nrows;	/* input rows collected for them */
+	MemoryContext agg_batch_context;	/* by-reference inputs collected */
 } AggState;
 
 /* ----------------
@@ -2426,6 +2502,9 @@ typedef struct HashState
 
 	/* Parallel hash state. */
 	struct ParallelHashJoinState *parallel_state;
+
+	/* Whether the hash table also gets a bloom filter of the hash values */
+	bool		build_bloom;
 } HashState;
 
 /* ----------------
@@ -19,6 +19,7 @@
 #include "nodes/params.h"
 #include "nodes/parsenodes.h"
 #include "storage/block.h"
+#include "storage/relfilenode.h"
 
 
 /*
@@ -692,6 +693,7 @@ typedef struct RelOptInfo
 	/* information about a base rel (not set for join rels!) */
 	Index		relid;
 	Oid			reltablespace;	/* containing tablespace */
+	RelFileNode relfilenode;	/* its storage, for measured page costs */
 	RTEKind		rtekind;		/* RELATION, SUBQUERY, FUNCTION, etc */
 	AttrNumber	min_attr;		/* smallest attrno of rel (often <0) */
 	AttrNumber	max_attr;		/* largest attrno of rel */
@@ -817,6 +819,7 @@ struct IndexOptInfo
 
 	Oid			indexoid;		/* OID of the index relation */
 	Oid			reltablespace;	/* tablespace of index (not table) */
+	RelFileNode relfilenode;	/* storage of index (not table) */
 	RelOptInfo *rel;			/* back-link to index's table */
 
 	/* index-size statistics (from pg_class and elsewhere) */
@@ -0,0 +1,54 @@
+//
+// Compression of the WAL shipped from compute to storage nodes
+//
+#ifndef SRC_WAL_SHIP_COMPRESS_H
+#define SRC_WAL_SHIP_COMPRESS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! WAL leaves a compute node two ways, as RpcXLogWrite chunks and as the
+//! 'w' messages of a walsender. Either payload can be sent as a frame, a
+//! small header with the codec and the raw length followed by the LZ4 or
+//! ZSTD output, and is decompressed straight into the WAL buffers or the
+//! receive buffer before anything parses it.
+//!
+//! An RpcXLogWrite frame is told apart by being shorter than the amount
+//! written, so a storage node takes either form. A walsender only sends
+//! frames, as 'z' messages, to a walreceiver that asked for them by
+//! setting wal_sender_compression on its connection, which the walreceiver
+//! does with its own wal_ship_compression. Other clients of a walsender
+//! keep getting 'w' messages. A chunk that doesn't shrink goes as it is.
+
+typedef enum WalShipCompression {
+    WAL_SHIP_COMPRESSION_OFF = 0,
+    WAL_SHIP_COMPRESSION_LZ4,
+    WAL_SHIP_COMPRESSION_ZSTD
+} WalShipCompression;
+
+// GUCs, wal_sender_compression is only set by a walreceiver connecting
+extern PGDLLIMPORT int wal_ship_compression;
+extern int wal_sender_compression;
+
+#define WAL_SHIP_FRAME_HEADER_SIZE (12)
+
+// Room the frame of len bytes may take
+extern size_t WalShipCompressBound(size_t len);
+
+// Frames len bytes of src into dst of WalShipCompressBound(len). Returns
+// the frame length, or 0 if src should be sent as it is
+extern size_t WalShipCompress(int method, const char *src, size_t len, char *dst);
+
+// Decompresses a frame into dst of rawlen bytes, false if it isn't a
+// valid frame of that length
+extern bool WalShipDecompress(const char *frame, size_t framelen, char *dst, size_t rawlen);
+
+// Raw length of a frame, 0 if it isn't one
+extern size_t WalShipFrameRawLength(const char *frame, size_t framelen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_WAL_SHIP_COMPRESS_H
@@ -17,6 +17,7 @@
 #include "access/xlogdefs.h"
 #include "catalog/pg_subscription.h"
 #include "datatype/timestamp.h"
+#include "lib/stringinfo.h"
 #include "storage/lock.h"
 
 typedef struct LogicalRepWorker
@@ -59,15 +60,22 @@ typedef struct LogicalRepWorker
 /* Main memory context for apply worker. Permanent during worker lifetime. */
 extern MemoryContext ApplyContext;
 
+/* Memory context for the replication protocol message being applied. */
+extern MemoryContext ApplyMessageContext;
+
 /* libpqreceiver connection */
 extern struct WalReceiverConn *wrconn;
 
 /* Worker and subscription objects. */
 extern Subscription *MySubscription;
+extern bool MySubscriptionValid;
 extern LogicalRepWorker *MyLogicalRepWorker;
 
 extern bool in_remote_transaction;
 
+/* Set in a parallel apply worker, see applyparallel.c. */
+extern bool InParallelApplyWorker;
+
 extern void logicalrep_worker_attach(int slot);
 extern LogicalRepWorker *logicalrep_worker_find(Oid subid, Oid relid,
 												bool only_running);
@@ -85,6 +93,19 @@ extern char *LogicalRepSyncTableStart(XLogRecPtr *origin_startpos);
 void		process_syncing_tables(XLogRecPtr current_lsn);
 void		invalidate_syncing_table_states(Datum arg, int cacheid,
 											uint32 hashvalue);
+extern bool AllTablesyncsReady(void);
+
+extern void apply_dispatch(StringInfo s);
+extern void store_flush_position(XLogRecPtr remote_lsn, XLogRecPtr local_lsn);
+
+/* Parallel apply, in applyparallel.c */
+extern bool ParallelApplyGatherMessage(char action, StringInfo s);
+extern void ParallelApplyCollect(void);
+extern bool ParallelApplyInProgress(void);
+extern void ParallelApplyWaitAll(void);
+extern void ParallelApplyStartTransaction(void);
+extern void ParallelApplyWaitTurn(void);
+extern void ParallelApplyCommitted(XLogRecPtr remote_lsn, XLogRecPtr local_lsn);
 
 static inline bool
 am_tablesync_worker(void)
@@ -92,4 +113,10 @@ am_tablesync_worker(void)
 	return OidIsValid(MyLogicalRepWorker->relid);
 }
 
+static inline bool
+am_parallel_apply_worker(void)
+{
+	return InParallelApplyWorker;
+}
+
 #endif							/* WORKER_INTERNAL_H */
@@ -3,12 +3,54 @@
 
 
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
 #include "iostream"
 #include <sys/mman.h>
 #include <memory.h>
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
 namespace DSMEngine{
 
-    static bool is_mmap_work = true;
+    // The largest pages hugePageAlloc asks for. It falls back to the smaller
+    // huge pages, then to transparent huge pages and then to ordinary ones.
+    enum HugePageSize { HugePageNone, HugePage2MB, HugePage1GB };
+    inline int huge_page_size = HugePage2MB;
+
+    // What backs the memory allocated so far. The NIC caches a translation
+    // per page of a registered region, so regions of fewer pages miss that
+    // cache less under random access. Transparent huge pages are counted as
+    // 2 MB pages, the kernel may back part of them with ordinary ones.
+    struct HugePageStats {
+        size_t bytes_1gb = 0, bytes_2mb = 0, bytes_thp = 0, bytes_4kb = 0;
+        size_t translations = 0;
+    };
+    inline HugePageStats huge_page_stats;
+
+    struct HugePageRegion {
+        bool mapped;
+        size_t len;
+        size_t *bytes;
+        size_t translations;
+    };
+    inline std::mutex huge_page_mtx;
+    inline std::map<void*, HugePageRegion> huge_page_regions;
+
+    inline void hugePageRecord(void *ptr, bool mapped, size_t len, size_t *bytes, size_t page) {
+        std::unique_lock<std::mutex> lk(huge_page_mtx);
+        huge_page_regions[ptr] = {mapped, len, bytes, len / page};
+        *bytes += len;
+        huge_page_stats.translations += len / page;
+    }
 
     inline void *hugePageAlloc(size_t size) {
         /**
@@ -16,44 +58,55 @@ namespace DSMEngine{
          * seen under /sys/kernel/mm/hugepages. The pages in question need to be available by the time mmap is invoked
          * (see HugePages_Free in /proc/meminfo), or mmap will fail. (https://stackoverflow.com/questions/30470972/using-mmap-and-madvise-for-huge-pages)
          */
-        void *res = nullptr;
-        if (is_mmap_work){
-            res = mmap(NULL, size, PROT_READ | PROT_WRITE,
-                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
-
-        }
-
-        if (res == MAP_FAILED || res == nullptr) {
-//            assert(is_mmap_work == true);
-            // printf("mmap failed!\n");
-            is_mmap_work = false;
-            //Use aligned alloc to enable the atomic variables. aligned to cache line size at least.
-            res = aligned_alloc(128, size);
-            auto set_ret = memset(res, 0,size);
-            assert(set_ret != nullptr);
-            assert(res != NULL);
-            return res;
-        }else{
-            printf("The returned pointer is %p size is %zu\n", res, size);
-            return res;
+        for (int s = huge_page_size; s >= HugePage2MB; s--) {
+            size_t page = s == HugePage1GB ? (1ul << 30) : (1ul << 21);
+            size_t len = (size + page - 1) / page * page;
+            void *res = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (s == HugePage1GB ? MAP_HUGE_1GB : MAP_HUGE_2MB), -1, 0);
+            if (res != MAP_FAILED) {
+                hugePageRecord(res, true, len, s == HugePage1GB ? &huge_page_stats.bytes_1gb : &huge_page_stats.bytes_2mb, page);
+                return res;
+            }
         }
 
+        //Use aligned alloc to enable the atomic variables. aligned to cache line size at least.
+        size_t align = huge_page_size == HugePageNone ? 128 : (1ul << 21);
+        size_t len = (size + align - 1) / align * align;
+        void *res = aligned_alloc(align, len);
+        if (res == nullptr)
+            return nullptr;
+        if (huge_page_size != HugePageNone && madvise(res, len, MADV_HUGEPAGE) == 0)
+            hugePageRecord(res, false, len, &huge_page_stats.bytes_thp, 1ul << 21);
+        else
+            hugePageRecord(res, false, len, &huge_page_stats.bytes_4kb, 1ul << 12);
+        memset(res, 0, len);
+        return res;
     }
 
     inline void hugePageDealloc(void* ptr, size_t size) {
-        /**
-         * mmap will actually go ahead and reserve the pages from the kernel's internal hugetlbfs mount, whose status can be
-         * seen under /sys/kernel/mm/hugepages. The pages in question need to be available by the time mmap is invoked
-         * (see HugePages_Free in /proc/meminfo), or mmap will fail. (https://stackoverflow.com/questions/30470972/using-mmap-and-madvise-for-huge-pages)
-         */
-        if (is_mmap_work){
-            int ret = munmap(ptr, size);
-        }else{
-
-            // printf("mmap is not enabled from the beginning\n");
+        HugePageRegion region;
+        {
+            std::unique_lock<std::mutex> lk(huge_page_mtx);
+            auto iter = huge_page_regions.find(ptr);
+            if (iter == huge_page_regions.end())
+                return;
+            region = iter->second;
+            huge_page_regions.erase(iter);
+            *region.bytes -= region.len;
+            huge_page_stats.translations -= region.translations;
         }
-        free(ptr);
+        if (region.mapped)
+            munmap(ptr, region.len);
+        else
+            free(ptr);
+    }
 
+    inline void hugePagePrintStats(FILE *out) {
+        std::unique_lock<std::mutex> lk(huge_page_mtx);
+        fprintf(out, "rdma memory: %zu MB on 1GB pages | %zu MB on 2MB pages | %zu MB transparent | %zu MB on 4KB pages | %zu translations\n",
+                huge_page_stats.bytes_1gb >> 20, huge_page_stats.bytes_2mb >> 20,
+                huge_page_stats.bytes_thp >> 20, huge_page_stats.bytes_4kb >> 20,
+                huge_page_stats.translations);
     }
 }
 
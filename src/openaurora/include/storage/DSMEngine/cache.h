@@ -60,9 +60,23 @@ bool KeyTypeCmp (const KeyType& a, const KeyType& b);
 
 class DSMEngine_EXPORT Cache;
 
-// Create a new table_cache with a fixed size capacity.  This implementation
-// of Cache uses a least-recently-used eviction policy.
-DSMEngine_EXPORT Cache* NewLRUCache(size_t capacity, mempool::FreeList* fl);
+// The eviction policy of a table_cache, chosen when it is created.
+// - kLRUCache: least-recently-used, every release moves the entry under the
+//   shard lock.
+// - kClockProCache: CLOCK-Pro. A hit only sets the entry's reference bit and
+//   releases take no lock. New entries start cold and are evicted on the
+//   cold hand's next pass unless hit meanwhile, so pages read once by a scan
+//   do not push out the hot ones. An evicted cold entry is kept without its
+//   value for a while; if its key is inserted again by then it comes back
+//   hot, and the room of the cold entries grows. Each that isn't shrinks it.
+enum CachePolicy { kLRUCache, kClockProCache };
+
+// Create a new table_cache with a fixed size capacity.
+DSMEngine_EXPORT Cache* NewLRUCache(size_t capacity, mempool::FreeList* fl,
+                                    CachePolicy policy = kLRUCache);
+
+// The shard of the cache from NewLRUCache that holds the key
+DSMEngine_EXPORT uint32_t CacheShardOf(const KeyType& key);
 
 class DSMEngine_EXPORT Cache {
  public:
@@ -160,6 +174,10 @@ class DSMEngine_EXPORT Cache {
   struct Rep;
   Rep* rep_;
 };
+    // kClockProCache entries in the clock. A test entry is an evicted cold
+    // one kept without its value, it is never returned.
+    enum ClockState : uint8_t { kClockHot, kClockCold, kClockTest };
+
     struct LRUHandle : Cache::Handle {
 
 
@@ -169,6 +187,9 @@ class DSMEngine_EXPORT Cache {
         size_t charge;  // TODO(opt): Only allow uint32_t?
         std::atomic<bool> in_cache;     // Whether entry is in the table_cache.
         uint32_t hash;     // Hash of key(); used for fast sharding and comparisons
+        // kClockProCache only. Set by the hits, cleared by the hands
+        std::atomic<bool> referenced;
+        uint8_t clock_state;    // ClockState
 //        char key_data[1];  // Beginning of key
 
         KeyType key() const {
@@ -289,6 +310,11 @@ public:
 
     // Separate from constructor so caller can easily make an array of LRUCache
     void SetCapacity(size_t capacity) { capacity_ = capacity; }
+    // Called after SetCapacity, before the shard is used
+    void SetPolicy(CachePolicy policy) {
+        policy_ = policy;
+        cold_capacity_ = capacity_ / 2 > 0 ? capacity_ / 2 : 1;
+    }
 
     // Like Cache methods, but with an extra "hash" parameter.
     Cache::Handle* Insert(const KeyType& key, uint32_t hash, void* value,
@@ -319,9 +345,18 @@ private:
     void Unref(LRUHandle *e, SpinLock *spin_l);
 //    void Unref_WithoutLock(LRUHandle* e);
     bool FinishErase(LRUHandle *e, SpinLock *spin_l) EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+    LRUHandle* Clock_Next(LRUHandle* e);
+    void Clock_Link(LRUHandle* e);
+    void Clock_Unlink(LRUHandle* e);
+    void Clock_Insert(LRUHandle* e);
+    void Clock_EndTest(LRUHandle* e);
+    void Clock_RunHandCold(LRUHandle* e_new);
+    void Clock_RunHandHot();
+    void Clock_RunHandTest();
 
     // Initialized before use.
     size_t capacity_;
+    CachePolicy policy_ = kLRUCache;
 
     // mutex_ protects the following state.
 //  mutable port::RWMutex mutex_;
@@ -337,6 +372,21 @@ private:
     // Entries are in use by clients, and have refs >= 2 and in_cache==true.
     LRUHandle in_use_ GUARDED_BY(mutex_);
 
+    // kClockProCache: all entries, test ones included, in one circular list
+    // the three hands walk, they are nullptr when it is empty. The hot and
+    // cold counts are charges, the test count is entries, of at most
+    // capacity_.
+    LRUHandle clock_ GUARDED_BY(mutex_);
+    LRUHandle* hand_hot_ GUARDED_BY(mutex_) = nullptr;
+    LRUHandle* hand_cold_ GUARDED_BY(mutex_) = nullptr;
+    LRUHandle* hand_test_ GUARDED_BY(mutex_) = nullptr;
+    size_t clock_size_ GUARDED_BY(mutex_) = 0;
+    size_t count_hot_ GUARDED_BY(mutex_) = 0;
+    size_t count_cold_ GUARDED_BY(mutex_) = 0;
+    size_t count_test_ GUARDED_BY(mutex_) = 0;
+    // The target charge of the cold entries, the hot ones get the rest
+    size_t cold_capacity_ GUARDED_BY(mutex_) = 1;
+
     HandleTable table_ GUARDED_BY(mutex_);
 //    static std::atomic<uint64_t> counter;
 };
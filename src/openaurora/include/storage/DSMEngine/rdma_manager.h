@@ -56,6 +56,8 @@
 namespace mempool{
 class MemPoolManager;
 }
+// The page reads of storage/rpc_rdma.h
+class RpcRdmaEndpoint;
 
 namespace DSMEngine {
 class Cache;
@@ -131,6 +133,7 @@ enum RDMA_Command_Type {
     flush_update_vm_info_,
     fetch_update_vm_info_,
     get_first_update_vm_info_idx_,
+    sync_pat_delta_,
 /*******/
     create_qp_,
     create_mr_,
@@ -173,6 +176,7 @@ union RDMA_Request_Content {
     mempool::flush_xlog_info_request flush_xlog_info;
     mempool::flush_update_vm_info_request flush_update_vm_info;
     mempool::fetch_update_vm_info_request fetch_update_vm_info;
+    mempool::sync_pat_delta_request sync_pat_delta;
 /******/
     Registered_qp_config qp_config;
 };
@@ -182,6 +186,7 @@ union RDMA_Reply_Content {
     mempool::fetch_xlog_info_response fetch_xlog_info;
     mempool::fetch_update_vm_info_response fetch_update_vm_info;
     mempool::get_first_update_vm_info_idx_response get_first_update_vm_info_idx;
+    mempool::sync_pat_delta_response sync_pat_delta;
 /********/
     Registered_qp_config qp_config;
 };
@@ -303,6 +308,8 @@ struct resources {
     std::map<uint16_t, std::pair<ibv_cq*, ibv_cq*>> cq_map; /* CQ Map */
     std::map<uint16_t, ibv_qp*> qp_map; /* QP Map */
     std::map<uint16_t, Registered_qp_config*> qp_main_connection_info;
+    // Completion channels of the receive CQs, only in cq_event_mode
+    std::map<uint16_t, ibv_comp_channel*> recv_channel_map;
     struct ibv_mr* mr_receive = nullptr;     /* MR handle for receive_buf */
     struct ibv_mr* mr_send = nullptr;            /* MR handle for send_buf */
     //    struct ibv_mr* mr_SST = nullptr;                                                /* MR handle for SST_buf */ struct ibv_mr* mr_remote;                                         /* remote MR handle for computing node */
@@ -331,6 +338,7 @@ struct IBV_Deleter {
 
 class RDMA_Manager {
     friend class mempool::MemPoolManager;
+    friend class ::RpcRdmaEndpoint;
     friend class DBImpl;
 public:
     RDMA_Manager(config_t config);
@@ -375,6 +383,11 @@ public:
         Chunk_type pool_name, std::string qp_type = "default");
     int RDMA_Read(ibv_mr *remote_mr, ibv_mr *local_mr, uint64_t remote_offset, size_t msg_size, size_t send_flag, int poll_num,
         uint16_t target_node_id, std::string qp_type = "default");
+    // Posts num reads as one chained work request list, only the last one
+    // signaled. The queue pair completes them in order, so one completion
+    // covers all of them. It is polled for unless poll_num is 0.
+    int RDMA_Read_Batch(ibv_mr **remote_mrs, ibv_mr **local_mrs, uint64_t *remote_offsets, size_t *msg_sizes,
+        int num, int poll_num, uint16_t target_node_id, std::string qp_type = "default");
         // TODO: implement this kind of RDMA operation for every primitive.
     int RDMA_Write(GlobalAddress remote_ptr, ibv_mr *local_mr, size_t msg_size, size_t send_flag, int poll_num,
         Chunk_type pool_name, std::string qp_type = "default");
@@ -410,6 +423,11 @@ public:
                             uint16_t target_node_id);
     int try_poll_completions_xcompute(ibv_wc *wc_p, int num_entries, bool send_cq, uint16_t target_node_id,
                                     int num_of_cp);
+    // Like try_poll_completions on the receive CQ of a main queue pair, but
+    // if it is empty sleeps on its completion channel until a completion
+    // arrives or timeout_ms passes. Without a channel it doesn't wait.
+    int wait_poll_completions(ibv_wc* wc_p, int num_entries, std::string& qp_type,
+                            uint16_t target_node_id, int timeout_ms);
     // Deserialization for linked file is problematic because different file may link to the same SSTdata
     void fs_deserilization(
             char*& buff, size_t& size, std::string& db_name,
@@ -501,6 +519,10 @@ public:
     std::map<uint16_t, std::string> memory_nodes{};
     std::atomic<uint64_t> memory_connection_counter = 0;// Reuse by both compute nodes and memory nodes
     std::atomic<uint64_t> compute_connection_counter = 0;
+    // Main queue pairs accepted from now on get a completion channel on
+    // their receive CQ, so that idle connections can be waited on instead of
+    // polled
+    bool cq_event_mode = false;
     // This global index table is in the node 0;
     std::mutex global_resources_mtx;
     ibv_mr* global_index_table = nullptr;
@@ -575,6 +597,34 @@ public:
         }
         return rc;
     }
+    // Posts num sends of a T each on the main queue pair as one chained
+    // work request list, only the last one signaled, so one doorbell and
+    // one completion cover all of them. num is at most SEND_OUTSTANDING_SIZE.
+    template <typename T>
+    int post_send_batch(ibv_mr** mrs, int num, uint16_t target_node_id) {
+        std::vector<ibv_send_wr> sr(num);
+        std::vector<ibv_sge> sge(num);
+        struct ibv_send_wr* bad_wr = NULL;
+        int rc;
+        for (int i = 0; i < num; i++) {
+            memset(&sge[i], 0, sizeof(ibv_sge));
+            sge[i].addr = (uintptr_t)mrs[i]->addr;
+            sge[i].length = sizeof(T);
+            sge[i].lkey = mrs[i]->lkey;
+
+            memset(&sr[i], 0, sizeof(ibv_send_wr));
+            sr[i].next = i + 1 < num ? &sr[i + 1] : NULL;
+            sr[i].wr_id = 0;
+            sr[i].sg_list = &sge[i];
+            sr[i].num_sge = 1;
+            sr[i].opcode = static_cast<ibv_wr_opcode>(IBV_WR_SEND);
+            if (i + 1 == num) sr[i].send_flags = IBV_SEND_SIGNALED;
+        }
+        std::shared_lock<std::shared_mutex> l(qp_cq_map_mutex);
+        rc = ibv_post_send(res->qp_map.at(target_node_id), &sr[0], &bad_wr);
+        l.unlock();
+        return rc;
+    }
 
 
  private:
@@ -1,7 +1,7 @@
 #pragma once
-#include <list>
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <mutex>
 
 namespace mempool {
 
@@ -9,26 +9,44 @@ struct PageMeta{
 	void* page_addr;
 	void* page_id_addr;
 };
+
+//! The free PageMetas, a lock-free stack over the preallocated array of
+//! them, linked by index. The head carries a tag bumped by every change, so
+//! that a pop racing with a pop and a push of the same entry fails its CAS
+//! instead of installing a stale next.
 class FreeList{
 public:
-	std::list<PageMeta*> list_;
-	std::unique_ptr<std::mutex> mtx_;
-
-	void init(){
-		mtx_ = std::make_unique<std::mutex>();
+	void init(size_t size){
+		metas_ = std::make_unique<PageMeta[]>(size);
+		next_ = std::make_unique<std::atomic<uint32_t>[]>(size);
+		head_.store(kNone, std::memory_order_relaxed);
+	}
+	PageMeta* at(size_t idx){
+		return &metas_[idx];
 	}
 	void push_back(PageMeta* ele){
-		std::lock_guard lk(*mtx_);
-		list_.push_back(ele);
+		uint32_t idx = ele - metas_.get();
+		uint64_t old_head = head_.load(std::memory_order_relaxed), new_head;
+		do{
+			next_[idx].store((uint32_t)old_head, std::memory_order_relaxed);
+			new_head = ((old_head >> 32) + 1) << 32 | idx;
+		}while(!head_.compare_exchange_weak(old_head, new_head, std::memory_order_release, std::memory_order_relaxed));
 	}
 	PageMeta* pop_front(){
-		std::lock_guard lk(*mtx_);
-		if(list_.empty())
-			return nullptr;
-		auto ele = list_.front();
-		list_.pop_front();
-		return ele;
+		uint64_t old_head = head_.load(std::memory_order_acquire), new_head;
+		do{
+			if((uint32_t)old_head == kNone)
+				return nullptr;
+			new_head = ((old_head >> 32) + 1) << 32 | next_[(uint32_t)old_head].load(std::memory_order_relaxed);
+		}while(!head_.compare_exchange_weak(old_head, new_head, std::memory_order_acquire, std::memory_order_acquire));
+		return &metas_[(uint32_t)old_head];
 	}
+
+private:
+	static constexpr uint32_t kNone = UINT32_MAX;
+	std::unique_ptr<PageMeta[]> metas_;
+	std::unique_ptr<std::atomic<uint32_t>[]> next_;
+	std::atomic<uint64_t> head_;
 };
 
-} // namespace mempool
\ No newline at end of file
+} // namespace mempool
@@ -26,9 +26,11 @@ extern "C" {
 #include "access/xlogutils.h"
 #include "catalog/pg_control.h"
 #include "commands/sequence.h"
+#include "miscadmin.h"
 #include "replication/origin.h"
 #include "storage/buf_internals.h"
 #include "storage/bufpage.h"
+#include "storage/ipc.h"
 #include "storage/GroundDB/mempool_shmem.h"
 
 // #define USE_MEMPOOL_STAT
@@ -36,8 +38,18 @@ extern "C" {
 // #define MEMPOOL_CACHE_POLICY_DISJOINT
 #define SyncPAT_Interval_us 1000000
 #define CheckSyncPAT_Interval_us (SyncPAT_Interval_us / 100)
+// The deltas and the xlog info are fetched as the doorbells ring, these only
+// bound the wait if a doorbell misses an update
+#define SyncPATDelta_Interval_us 100000
+#define FullSyncPAT_Interval_us (60ll * SyncPAT_Interval_us)
 #define SyncXLogInfo_Interval_us 1000
+#define FetchXLogInfo_Interval_us 100000
 #define SyncUpdateVersionMapInfo_Interval_us 500
+#define RewarmMemoryNode_Interval_us 1000
+// The wait between rounds of the mempool synchronizer, the longest is that
+// of the most frequent task on a timer
+#define SyncWait_Min_us 20
+#define SyncWait_Max_us SyncXLogInfo_Interval_us
 
 #define TryReconnectionToMemPool_Interval_us 1000000
 
@@ -58,6 +70,14 @@ extern bool PageExistsInMemPool(KeyType PageID, RDMAReadPageInfo* rdma_read_info
 
 extern bool FetchPageFromMemoryPool(char* des, KeyType PageID, RDMAReadPageInfo* rdma_read_info);
 
+// Posts the read of a page the mempool holds without waiting for it,
+// returns true if it is in flight
+extern bool PrefetchPageFromMemoryPool(KeyType PageID);
+
+// Completes a prefetch of the page, 1 if des was filled, 0 if the page
+// wasn't prefetched, -1 if its slot held another page by then
+extern int FetchPrefetchedPageFromMemoryPool(char* des, KeyType PageID);
+
 extern bool LsnIsSatisfied(XLogRecPtr PageLSN, XLogRecPtr TargetLSN);
 
 extern bool ReplayXLog(KeyType PageID, BufferDesc* bufHdr, char* block, XLogRecPtr current_lsn, XLogRecPtr target_lsn);
@@ -68,6 +88,28 @@ extern void AsyncRemovePageOnMemoryPool(KeyType PageID);
 
 extern void AsyncGetNewestPageAddressTable();
 
+// GUC, which of the pages evicted from shared buffers go to the mempool
+typedef enum MemPoolAdmission{
+	MEMPOOL_ADMIT_ALL,
+	// Pages read by a scan with a buffer ring, or of a relation with
+	// mempool_cache off, aren't offered, and a page is only taken the second
+	// time it is evicted
+	MEMPOOL_ADMIT_ADAPTIVE,
+} MemPoolAdmission;
+extern int mempool_admission;
+
+// GUC, the largest pages backing the RDMA buffers of a backend, in the order
+// of DSMEngine::HugePageSize
+typedef enum MemPoolHugePages{
+	MEMPOOL_HUGE_PAGES_OFF,
+	MEMPOOL_HUGE_PAGES_2MB,
+	MEMPOOL_HUGE_PAGES_1GB,
+} MemPoolHugePages;
+extern int mempool_huge_pages;
+
+// Whether a page read from storage is kept for the mempool when evicted
+extern bool MemPoolOffersReadPage(bool relationCached, bool ringStrategy);
+
 extern void MemPoolmdwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char *buffer, bool skipFsync);
 extern void ASyncFlushPageToMemoryPool(char* src, KeyType PageID);;
 extern void SyncFlushPageToMemoryPool(char* src, KeyType PageID);
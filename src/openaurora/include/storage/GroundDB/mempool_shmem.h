@@ -9,25 +9,43 @@ extern "C" {
 #include "postgres.h"
 #include "storage/lwlock.h"
 #include "storage/shmem.h"
+#include "datatype/timestamp.h"
 #include "storage/GroundDB/mempool_client.h"
 
 extern int64 *mpLocalCnt, *mpMemCnt, *mpStoCnt;
 
-#define NUMBER_OF_mempool_client_lw_lock 5
+#define NUMBER_OF_mempool_client_lw_lock 4
 #define mempool_client_connection_lock (&mempool_client_lw_lock[0])
-#define mempool_client_version_map_lock (&mempool_client_lw_lock[1])
-#define mempool_client_pat_lock (&mempool_client_lw_lock[2])
-#define mempool_client_sync_pat_lock (&mempool_client_lw_lock[3])
-#define mempool_client_stat_lock (&mempool_client_lw_lock[4])
+#define mempool_client_pat_lock (&mempool_client_lw_lock[1])
+#define mempool_client_sync_pat_lock (&mempool_client_lw_lock[2])
+#define mempool_client_stat_lock (&mempool_client_lw_lock[3])
 
 extern PGDLLIMPORT LWLock* mempool_client_lw_lock;
 
+// The version map is locked by partition, as the buffer mapping table: a
+// page's LSN list is read or appended to under the lock of its hash code.
+// The map only grows, the freelists have locks of their own.
+#define NUM_VERSION_MAP_PARTITIONS 128
+#define VersionMapPartitionLock(hashcode) \
+	(&mempool_client_version_map_locks[(hashcode) % NUM_VERSION_MAP_PARTITIONS].lock)
+
+extern PGDLLIMPORT LWLockPadded* mempool_client_version_map_locks;
+
 #define MAX_PAGE_ARRAY_COUNT 50ull
 #define MAX_TOTAL_PAGE_ARRAY_SIZE (1ull << 24)
 #define MAX_PAGE_ARRAY_COUNT_PER_MEMNODE 10ull
 #define MAX_MEMNODE_NODE 10ull
 #define PAGE_ARRAY_TABLE_PARTITION_NUM 128
 
+// Keeps every page on two memory nodes, so that the pages of a failed one
+// are read from the other
+// #define MEMPOOL_REPLICATED_PAGES
+#ifdef MEMPOOL_REPLICATED_PAGES
+#define MEMPOOL_PAGE_REPLICAS 2
+#else
+#define MEMPOOL_PAGE_REPLICAS 1
+#endif
+
 extern PGDLLIMPORT size_t *mpc_pa_cnt, *mpc_pa_size, *mpc_pa_cnt_per_memnode, *mpc_pa_to_memnode, *mpc_memnode_to_pa;
 extern PGDLLIMPORT KeyType *mpc_idx_to_pid;
 extern PGDLLIMPORT struct ibv_mr *mpc_idx_to_mr;
@@ -35,9 +53,62 @@ extern PGDLLIMPORT HTAB *mpc_pid_to_idx;
 
 typedef struct{
 	KeyType page_id;
-	size_t pa_idx, pa_ofs;
+	// One slot per replica, pa_ofs is -1 where the page has none
+	size_t pa_idx[MEMPOOL_PAGE_REPLICAS], pa_ofs[MEMPOOL_PAGE_REPLICAS];
 } PATLookupEntry;
 
+// Count-min sketch of the evictions of pages, 4 bit counters, halved every
+// MEMPOOL_SKETCH_WIDTH additions
+#define MEMPOOL_SKETCH_DEPTH 4
+#define MEMPOOL_SKETCH_WIDTH (1 << 20)
+extern PGDLLIMPORT uint8 *mpc_admission_sketch;
+extern PGDLLIMPORT uint64 *mpc_admission_sketch_adds;
+
+// Pages evicted by the backends, shipped to the memory nodes in batches by
+// the mempool synchronizer. A slot is free for the enqueue at position pos
+// when seq is pos, and holds a page for the dequeue at pos when seq is
+// pos + 1.
+#define MEMPOOL_FLUSH_RING_SIZE 1024
+typedef struct MemPoolFlushSlot{
+	uint64 seq;
+	KeyType page_id;
+	char page[BLCKSZ];
+} MemPoolFlushSlot;
+extern PGDLLIMPORT MemPoolFlushSlot *mpc_flush_ring;
+extern PGDLLIMPORT uint64 *mpc_flush_ring_head, *mpc_flush_ring_tail;
+extern PGDLLIMPORT bool *mpc_flush_daemon_running;
+
+// Always-on counters behind pg_stat_mempool. Each process adds to a slot of
+// its own, so the counting is a relaxed atomic add without contention; the
+// view sums up the slots.
+typedef enum MemPoolStatCounter{
+	MEMPOOL_STAT_HITS,				// read from the mempool, up to date
+	MEMPOOL_STAT_STALE_HITS,		// read from the mempool, then ReplayXLog'ed
+	MEMPOOL_STAT_MISSES,			// read from the storage node instead
+	MEMPOOL_STAT_READ_FAILURES,		// RDMA page reads that failed
+	MEMPOOL_STAT_FLUSH_FAILURES,	// RDMA page flushes that failed
+	MEMPOOL_STAT_RECONNECTS,		// memory node connections set up again
+	MEMPOOL_STAT_FLUSHED_PAGES,		// pages written to the memory nodes
+	MEMPOOL_STAT_QUEUED_FLUSHES,	// pages handed to the mempool synchronizer
+	MEMPOOL_STAT_READ_TIME_US,		// time spent in RDMA page reads
+	NUM_MEMPOOL_STAT_COUNTERS
+} MemPoolStatCounter;
+// Bucket i counts the RDMA page reads that took less than 2^(i+1) us, the
+// last one those that took longer
+#define MEMPOOL_STAT_READ_LATENCY_BUCKETS 16
+typedef struct MemPoolStatSlot{
+	uint64 counters[NUM_MEMPOOL_STAT_COUNTERS];
+	uint64 read_latency[MEMPOOL_STAT_READ_LATENCY_BUCKETS];
+} MemPoolStatSlot;
+extern PGDLLIMPORT MemPoolStatSlot *mpc_stat_slots;
+extern PGDLLIMPORT TimestampTz *mpc_stat_reset_time;
+
+extern void MemPoolStatCount(MemPoolStatCounter counter, uint64 n);
+extern void MemPoolStatReadLatency(uint64 us);
+// Sums up the slots of all processes
+extern void MemPoolStatCollect(MemPoolStatSlot* sum);
+extern void MemPoolStatReset();
+
 extern PGDLLIMPORT bool *is_first_mpc, *is_first_mpc_connection;
 extern PGDLLIMPORT HTAB_VM *version_map;
 extern PGDLLIMPORT size_t *update_vm_info_ptr;
@@ -22,9 +22,16 @@ public:
 	size_t page_array_count();
 	size_t page_array_size(size_t pa_idx);
 	void get_memnode_id(size_t pa_idx, size_t& memnode_id, size_t& memnode_pa_idx);
+	// false if the memory node's page array isn't in the table yet
+	bool get_pa_idx(size_t memnode_id, size_t memnode_pa_idx, size_t& pa_idx);
 	void init(size_t memnode_cnt);
 	void append_page_array(size_t memnode_id, size_t pa_idx, size_t pa_size, const ibv_mr& pa_mr, const ibv_mr& pida_mr);
-	void at(KeyType pid, RDMAReadPageInfo& info);
+	// The slot of the page on a memory node not in has_failed, pa_ofs is -1
+	// if there is none
+	void at(KeyType pid, RDMAReadPageInfo& info, const int* has_failed = nullptr);
+	bool exists_on(KeyType pid, size_t memnode_id);
+	// The page in a slot and where to read it
+	void slot_at(size_t pa_idx, size_t pa_ofs, KeyType& pid, RDMAReadPageInfo& info);
 	void update(size_t pa_idx, size_t pa_ofs, KeyType pid);
 };
 
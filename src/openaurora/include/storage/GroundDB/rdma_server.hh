@@ -2,9 +2,11 @@
 #include <cstdint>
 #include <vector>
 #include <unordered_map>
+#include <memory>
+#include <thread>
+#include <atomic>
 #include "storage/GroundDB/lru.hh"
 #include "storage/GroundDB/request_buffer.h"
-#include "storage/DSMEngine/ThreadPool.h"
 #include "storage/DSMEngine/cache.h"
 #include "storage/DSMEngine/rdma_manager.h"
 
@@ -23,7 +25,20 @@ public:
         char *pa_buf, *pida_buf;
         size_t size;
     };
-    DSMEngine::ThreadPool *thrd_pool;
+    // Requests are run by workers pinned to cores. The requests of a page
+    // go to the worker of its LRU shard, so they run in the order received
+    // and the workers rarely meet on a shard's lock. The connection threads
+    // copy the requests into a bounded ring of preallocated slots of each
+    // worker.
+    struct RequestSlot;
+    struct RequestWorker{
+        RequestSlot* ring;
+        size_t mask;
+        std::atomic<uint64_t> enqueue_pos;
+        uint64_t dequeue_pos;
+        std::thread thread;
+    };
+    std::vector<std::unique_ptr<RequestWorker>> workers;
     DSMEngine::Cache *lru;
     std::vector<page_array> page_arrays;
     FreeList freelist;
@@ -41,16 +56,33 @@ public:
         std::mutex mtx;
     };
     UpdateVersionMapInfoRing vminfo_ring;
+    // Every change of a slot's page id, clients follow it instead of
+    // rereading the page id arrays
+    struct PATDeltaRing{
+        PATDelta* ring;
+        size_t size;
+        size_t ptr;
+        std::mutex mtx;
+    };
+    PATDeltaRing pat_delta_ring;
+    UpdateDoorbell* doorbell;
+    ibv_mr* doorbell_mr;
     
     void init_rdma_manager(int pr_s, DSMEngine::config_t &config);
     void Server_to_Client_Communication();
     int server_sock_connect(const char* servername, int port);
     void server_communication_thread(std::string client_ip, int socket_fd);
 
-    void init_thread_pool(size_t thrd_num);
+    void init_request_workers(size_t worker_cnt);
+    bool dispatch_request(const DSMEngine::RDMA_Request& request, const std::string& client_ip, uint16_t compute_node_id);
+    void request_worker(size_t worker_id);
+    void run_request(void* args);
     void allocate_page_array(size_t pa_size);
     void init_xlog_info();
     void init_vminfo_ring(size_t ring_size);
+    void init_pat_delta_ring(size_t ring_size);
+    void init_doorbell();
+    void record_pat_delta(void* page_id_addr, const KeyType& page_id);
 
     void async_flush_page_handler(void* args);
     void sync_flush_page_handler(void* args);
@@ -63,6 +95,7 @@ public:
     void flush_update_vm_info_handler(void* args);
     void fetch_update_vm_info_handler(void* args);
     void get_first_update_vm_info_idx_handler(void* args);
+    void sync_pat_delta_handler(void* args);
 };
 
 
@@ -44,12 +44,44 @@ struct sync_pat_response{
 	KeyType page_id_array[SYNC_PAT_SIZE];
 };
 
+// A slot of a page array that got another page id, nullKeyType if emptied
+struct PATDelta{
+	size_t pa_idx;
+	size_t pa_ofs;
+	KeyType page_id;
+};
+// ptr is the index of the first delta wanted, SYNC_PAT_DELTA_HEAD for none
+// but the index the next delta will get
+#define SYNC_PAT_DELTA_HEAD ((size_t)-1)
+struct sync_pat_delta_request{
+	size_t ptr;
+};
+#define SYNC_PAT_DELTA_SIZE 128
+struct sync_pat_delta_response{
+	// The deltas were overwritten already, the client has to resync fully
+	bool overrun;
+	size_t next_ptr;
+	size_t cnt;
+	PATDelta deltas[SYNC_PAT_DELTA_SIZE];
+};
+
 struct mr_info_request{
 	size_t pa_idx;
 };
 struct mr_info_response{
 	ibv_mr pa_mr;
 	ibv_mr pida_mr;
+	ibv_mr doorbell_mr;
+};
+
+// Bumped by the memory node as it takes the updates clients follow. A client
+// reads it with an RDMA read, which takes no request worker, and sends its
+// fetch requests only once a word moved.
+struct UpdateDoorbell{
+	// The index the next PAT delta will get
+	uint64_t pat_delta_ptr;
+	// Bumped on every flush of the xlog info
+	uint64_t xlog_info_seq;
 };
 
 struct flush_xlog_info_request{
@@ -19,14 +19,24 @@
 #include <stdint.h>
 #include <time.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Tenants (databases or relations) tracked one by one, the rest share a slot */
+#define ASR_MAX_TENANTS 64
+
 /*
  * Configuration parameters for the Adaptive SR controller.
- * These can be tuned via GUCs or config files to adjust behavior.
+ * Each one is set from an asr_* GUC, see ASR_LoadGucConfig.
  */
 typedef struct {
-	/* Expected "healthy" queue length (approximate WAL records pending) */
+	/* Expected "healthy" queue length (page versions waiting for replay) */
 	double		QSTAR;
 	
+	/* Expected "healthy" gap between flushed and parsed WAL (bytes) */
+	double		GSTAR;
+	
 	/* Expected "healthy" hot miss rate (fraction, 0.0-1.0) */
 	double		RSTAR;
 	
@@ -47,9 +57,40 @@ typedef struct {
 	/* Hysteresis: don't update budget if change < HYST */
 	int			HYST;
 	
-	/* Maximum step change per tick (limit aggressiveness changes) */
+	/* Maximum aggressiveness change per second */
 	double		MAX_STEP;
 	
+	/* PI gains: aggressiveness per unit error, and per unit error-second */
+	double		KP;
+	double		KI;
+	
+	/* Time constant of the metric EWMAs (ms, 0 = no smoothing) */
+	int			SMOOTHING_MS;
+	
+	/* Controller period (ms) */
+	int			CYCLE_MS;
+	
+	/*
+	 * The other actuators, also driven by aggressiveness in [0.0, 1.0]:
+	 * active background replayer threads, their sleep between rounds
+	 * (longest when idle) and the redo process pool's upper limit.
+	 */
+	int			RMIN;
+	int			RMAX;
+	int			SLEEP_MIN_US;
+	int			SLEEP_MAX_US;
+	int			PMIN;
+	int			PMAX;
+	
+	/*
+	 * Fraction of the background replay capacity shared out by tenant
+	 * demand, the rest goes equally to every tenant.
+	 */
+	double		TENANT_DEMAND_SHARE;
+	
+	/* Tenants are relations rather than databases */
+	bool		tenant_per_relation;
+	
 	/* Enable/disable ASR controller */
 	bool		enable_adaptive_sr;
 	
@@ -62,12 +103,18 @@ typedef struct {
  * Values are exponential moving averages to reduce noise.
  */
 typedef struct {
-	/* Approximate pending WAL records/tasks */
+	/* Page versions in the logindex not replayed yet */
 	double		replay_queue_length;
 	
+	/* WAL flushed to this node but not parsed into the logindex (bytes) */
+	double		parse_gap_bytes;
+	
 	/* Fraction of reads that blocked waiting for replay [0.0-1.0] */
 	double		hot_miss_rate;
 	
+	/* Replay throughput in tasks per second */
+	double		replay_tasks_per_sec;
+	
 	/* WAL arrival rate in bytes per second */
 	double		wal_ingest_bps;
 	
@@ -79,15 +126,79 @@ typedef struct {
 	
 	/* Current replay budget (records/pages per tick) */
 	int			replay_budget;
+	
+	/* Current settings of the other actuators */
+	int			replayer_threads;
+	int			replayer_sleep_us;
+	int			redo_processes;
+	
+	/* Raw counters since startup */
+	uint64_t	reads_total;
+	uint64_t	hot_misses_total;
+	uint64_t	replay_tasks_total;
+	uint64_t	wal_bytes_total;
 } ASRMetrics;
 
+/*
+ * Smoothed metrics and current share of one tenant.
+ */
+typedef struct {
+	Oid			dbNode;
+	Oid			relNode;		/* InvalidOid unless tenants are relations */
+	bool		other;			/* The slot shared by untracked tenants */
+	double		weight;
+	double		share;			/* Of the background replay capacity */
+	int64_t		tokens;			/* Background replays left this cycle */
+	double		hot_miss_per_sec;
+	double		hot_miss_rate;
+	double		wal_ingest_bps;
+	double		replayed_per_sec;
+} ASRTenantMetrics;
+
+/* GUC variables */
+extern bool asr_enable;
+extern bool asr_verbose_metrics;
+extern double asr_queue_target;
+extern double asr_parse_gap_target;
+extern double asr_miss_rate_target;
+extern double asr_wal_rate_target;
+extern int	asr_min_budget;
+extern int	asr_max_budget;
+extern double asr_queue_weight;
+extern double asr_miss_weight;
+extern double asr_wal_weight;
+extern int	asr_hysteresis;
+extern double asr_max_step;
+extern double asr_kp;
+extern double asr_ki;
+extern int	asr_smoothing_ms;
+extern int	asr_controller_interval;
+extern int	asr_min_replayers;
+extern int	asr_max_replayers;
+extern int	asr_min_replayer_sleep_us;
+extern int	asr_max_replayer_sleep_us;
+extern int	asr_min_redo_processes;
+extern int	asr_max_redo_processes;
+extern bool asr_tenant_per_relation;
+extern char *asr_tenant_weights;
+extern double asr_tenant_demand_share;
+
 /*
  * Public API for metrics collection and controller
  */
 
 /* Record metrics updates (thread-safe) */
 extern void ASR_RecordReplayTask(int count);
-extern void ASR_RecordHotMiss(void);
+extern void ASR_RecordHotMiss(Oid dbNode, Oid relNode);
+extern void ASR_RecordRead(Oid dbNode, Oid relNode);
+extern void ASR_RecordTenantWal(Oid dbNode, Oid relNode, size_t bytes);
+
+/* Per-tenant budget enforcement in the background replayer */
+extern bool ASR_TenantMayReplay(Oid dbNode, Oid relNode);
+extern void ASR_RecordTenantReplay(Oid dbNode, Oid relNode, int versions);
+
+/* Copy the metrics of up to max tenants, returns how many */
+extern int ASR_ReadTenants(ASRTenantMetrics *tenants, int max);
 extern void ASR_RecordWalIngest(size_t bytes);
 
 /* Read current smoothed metrics snapshot */
@@ -96,12 +207,18 @@ extern ASRMetrics ASR_ReadMetrics(void);
 /* Get current replay budget */
 extern int ASR_GetCurrentBudget(void);
 
+/* Is the controller on */
+extern bool ASR_Enabled(void);
+
 /* Set current replay budget (controller only) */
 extern void ASR_SetBudget(int budget);
 
 /* Initialize ASR subsystem */
 extern void ASR_Init(void);
 
+/* Run one controller cycle as of now (CLOCK_MONOTONIC), without the thread */
+extern void ASR_Tick(const struct timespec *now);
+
 /* Start controller thread (from storage_server.c) */
 extern void ASR_StartController(void);
 
@@ -114,4 +231,11 @@ extern const ASRConfig* ASR_GetConfig(void);
 /* Update config (typically from GUC) */
 extern void ASR_UpdateConfig(const ASRConfig *new_config);
 
+/* Rebuild the config from the asr_* GUCs */
+extern void ASR_LoadGucConfig(void);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
@@ -0,0 +1,35 @@
+//
+// Buffer invalidation of secondary compute nodes from the page change feed
+//
+#ifndef SRC_BUF_CHANGE_FEED_H
+#define SRC_BUF_CHANGE_FEED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "access/xlogdefs.h"
+
+//! A secondary redoes every page record whose page is in its buffers to
+//! keep them current. With page_change_feed on, its startup process follows
+//! the storage node's page change feed (access/page_change_feed.h) instead,
+//! and drops or rereads the buffers of the pages listed there. Records that
+//! change no page are still redone.
+//!
+//! Before a record is redone, the feed is read until it is complete past the
+//! record, so nothing a query sees afterwards is older than the record. A
+//! record from before the feed came up, or any record once the feed failed,
+//! has its pages redone as before.
+
+// GUC
+extern bool page_change_feed;
+
+// Applies the feed up to the record at lsn. Returns true if the feed
+// covers the record's pages, so they need no redo.
+extern bool BufChangeFeedCatchUp(XLogRecPtr lsn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_BUF_CHANGE_FEED_H
@@ -164,6 +164,12 @@ typedef struct buftag
  * wait_backend_pid and setting flag bit BM_PIN_COUNT_WAITER.  At present,
  * there can be only one such waiter per buffer.
  *
+ * refetch_cost estimates how dear the page is to read again, see
+ * StrategyRefetchCost().  The clock sweep takes refetch_cost + 1 passes to
+ * drop usage_count by one, sweep_credit counting the passes left.  Both are
+ * protected by the buffer header lock, except that the backend reading the
+ * page in sets refetch_cost while it has the buffer pinned.
+ *
  * We use this same struct for local buffer headers, but the locks are not
  * used and not all of the flag bits are useful either. To avoid unnecessary
  * overhead, manipulations of the state field should be done without actual
@@ -185,6 +191,9 @@ typedef struct BufferDesc
 	int			wait_backend_pid;	/* backend PID of pin-count waiter */
 	int			freeNext;		/* link in freelist chain */
 
+	uint8		refetch_cost;	/* extra sweeps a usage count lasts */
+	uint8		sweep_credit;	/* sweeps left before it drops */
+
 	LWLock		content_lock;	/* to lock access to buffer contents */
 } BufferDesc;
 
@@ -308,6 +317,7 @@ extern void ScheduleBufferTagForWriteback(WritebackContext *context, BufferTag *
 extern BufferDesc *StrategyGetBuffer(BufferAccessStrategy strategy,
 									 uint32 *buf_state);
 extern void StrategyFreeBuffer(BufferDesc *buf);
+extern uint8 StrategyRefetchCost(bool fromMemPool, uint64 readTimeUs);
 extern bool StrategyRejectBuffer(BufferAccessStrategy strategy,
 								 BufferDesc *buf);
 
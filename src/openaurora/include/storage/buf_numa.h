@@ -0,0 +1,44 @@
+//
+// Shared buffers partitioned by NUMA node
+//
+#ifndef SRC_BUF_NUMA_H
+#define SRC_BUF_NUMA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! The buffers are split into one partition per NUMA node, in buffer id
+//! order, and the descriptors and pages of a partition are placed in the
+//! memory of its node. Each backend is bound to the CPUs of one node, the
+//! nodes taken in turn by PGPROC number, so what it allocates afterwards,
+//! its RPC client and RDMA buffers included, is local as well. Victims are
+//! looked for in the partition of the node first, with a clock hand of its
+//! own, then in the whole pool.
+
+// GUC
+extern bool numa_buffer_partitions;
+
+#define BUF_NUMA_MAX_NODES (8)
+
+// Nodes the buffers are split over, 1 if not partitioned
+extern int BufNumaNodeCount(void);
+
+// First buffer id of the partition of node, node == nodes gives NBuffers
+#define BufNumaPartitionStart(node, nodes) \
+    ((int) (((uint64) NBuffers * (node)) / (nodes)))
+
+// Places an array with an element per buffer in the memory of the nodes
+extern void BufNumaPlace(void *start, Size size, int nodes);
+
+// Binds the backend to the CPUs of its node
+extern void BufNumaBindBackend(int procno);
+
+// The node the backend runs on
+extern int BufNumaMyNode(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_BUF_NUMA_H
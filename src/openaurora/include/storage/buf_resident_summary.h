@@ -0,0 +1,28 @@
+//
+// Summaries of the shared buffers of compute nodes for the storage node
+//
+#ifndef SRC_BUF_RESIDENT_SUMMARY_H
+#define SRC_BUF_RESIDENT_SUMMARY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! With buffer_resident_summary_interval set, the bgwriter of an RPC client
+//! sends the storage node a bloom filter of the pages valid in shared
+//! buffers that often, over RpcPublishResidentPages. The storage node's
+//! background replayer defers the pages in it, see
+//! access/logindex_resident.h. A summary stands for a few intervals, so
+//! one missed or late doesn't drop the node's pages.
+
+// GUC, in milliseconds, 0 for off
+extern int buffer_resident_summary_interval;
+
+// Sends a summary if buffer_resident_summary_interval passed since last time
+extern void BufResidentSummaryPublishIfDue(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_BUF_RESIDENT_SUMMARY_H
@@ -0,0 +1,43 @@
+//
+// Warm start of the shared buffers of compute and replica nodes
+//
+#ifndef SRC_BUF_WARM_START_H
+#define SRC_BUF_WARM_START_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! A node starts with empty shared buffers and warms them up a round trip to
+//! the storage node at a time. With buffer_warm_start on, the bgwriter
+//! records the tags of the permanent pages in shared buffers every
+//! buffer_warm_start_interval, like autoprewarm, to BUF_WARM_START_FILE. An
+//! RPC client keeps the file on the storage node, where the next node to
+//! start finds it.
+//!
+//! The startup process reads the recorded pages back before the node takes
+//! connections, at the end of recovery or before hot standby begins. They're
+//! read a fork at a time in block order, so they're fetched batched or
+//! pipelined, or come from the memory pool, at the flushed LSN as any read
+//! is. If more were recorded than there are buffers, those with the highest
+//! usage count are read.
+//!
+//! Every node of a cluster shares the file, so only the primary records it.
+
+// GUCs
+extern bool buffer_warm_start;
+extern int buffer_warm_start_interval;
+
+#define BUF_WARM_START_FILE "pg_buffer_warm_start"
+
+// Records the buffers if buffer_warm_start_interval passed since last time
+extern void BufWarmStartRecordIfDue(void);
+
+// Reads the recorded buffers back, once
+extern void BufWarmStartLoad(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_BUF_WARM_START_H
@@ -57,6 +57,17 @@ typedef struct PrefetchBufferResult {
     bool initiated_io;    /* If true, a miss resulting in async I/O */
 } PrefetchBufferResult;
 
+/*
+ * Streaming reads, see ReadStreamBegin().  The callback names the next block
+ * the caller is going to read, InvalidBlockNumber once there are no more.
+ */
+typedef BlockNumber (*ReadStreamBlockCallback) (void *callback_arg);
+
+typedef struct ReadStream ReadStream;
+
+/* Most pages fetched from the storage node ahead at once */
+#define RPC_READ_BATCH_SIZE 32
+
 /* forward declared, to avoid having to expose buf_internals.h here */
 struct WritebackContext;
 
@@ -71,6 +82,9 @@ extern bool zero_damaged_pages;
 extern int bgwriter_lru_maxpages;
 extern double bgwriter_lru_multiplier;
 extern bool track_io_timing;
+extern bool rpc_disaggregated_checkpoint;
+extern bool rpc_local_hint_bits;
+extern int rpc_catalog_prewarm_blocks;
 extern int effective_io_concurrency;
 extern int maintenance_io_concurrency;
 
@@ -190,6 +204,20 @@ extern Buffer ReadBufferWithoutRelcache(RelFileNode rnode,
                                         ForkNumber forkNum, BlockNumber blockNum,
                                         ReadBufferMode mode, BufferAccessStrategy strategy);
 
+extern ReadStream *ReadStreamBegin(Relation reln, ForkNumber forkNum,
+                                   ReadStreamBlockCallback callback,
+                                   void *callback_arg);
+
+extern Buffer ReadStreamReadBuffer(ReadStream *stream, BlockNumber blockNum,
+                                   BufferAccessStrategy strategy);
+
+extern void ReadStreamReset(ReadStream *stream);
+
+extern int	PrefetchBufferBlocks(Relation reln, ForkNumber forkNum,
+								 const BlockNumber *blocks, int nblocks);
+
+extern void ReadStreamEnd(ReadStream *stream);
+
 extern void ReleaseBuffer(Buffer buffer);
 
 extern void UnlockReleaseBuffer(Buffer buffer);
@@ -212,6 +240,7 @@ extern void AtEOXact_Buffers(bool isCommit);
 extern void PrintBufferLeakWarning(Buffer buffer);
 
 extern void CheckPointBuffers(int flags);
+extern void CheckPointBuffersDisaggregated(XLogRecPtr checkPointRedo, int flags);
 
 extern BlockNumber BufferGetBlockNumber(Buffer buffer);
 
@@ -283,10 +312,22 @@ extern void FreeAccessStrategy(BufferAccessStrategy strategy);
 extern Buffer
 ReadBuffer_common(SMgrRelation smgr, char relpersistence, ForkNumber forkNum,
                   BlockNumber blockNum, ReadBufferMode mode,
-                  BufferAccessStrategy strategy, char *hit);
+                  BufferAccessStrategy strategy, bool mempoolCache, char *hit);
 
 extern Buffer
 FindPageInBuffer(RelFileNode rnode, ForkNumber forkNumber, BlockNumber blockNumber);
+
+extern void RefreshBufferForChange(RelFileNode rnode, ForkNumber forkNum,
+								   BlockNumber blockNum, XLogRecPtr lsn);
+extern void RefreshAllBuffersForChange(XLogRecPtr lsn);
+extern int	PrewarmBuffers(struct SMgrRelationData *smgr, ForkNumber forkNum,
+						   const BlockNumber *blocks, int nblocks);
+extern int	PrewarmRelationHeads(const RelFileNode *rnodes, int nrels,
+								 int maxBlocks);
+extern void LoadFetchedPages(struct SMgrRelationData *smgr, char relpersistence,
+							 ForkNumber forkNum, const BlockNumber *blocks,
+							 const char *pages, int npages, XLogRecPtr lsn,
+							 BufferAccessStrategy strategy);
 /* inline functions */
 
 /*
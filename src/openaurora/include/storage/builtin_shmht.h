@@ -37,13 +37,30 @@ extern void InitRelSizeTable();
 
 extern uint32 RelSizeTableHashCode(RelTag *relTag);
 
-// Return the relation size, if it doesn't exist, return -1
+// Return the relation size, if it doesn't exist, return -1. Takes no lock
 extern int RelSizeTableLookup(RelTag *relTag, uint32 hashcode);
 
 extern int RelSizeTableInsert(RelTag *relTag, uint32 hashcode, int relSize);
 
+// 1 if a size is cached, 0 if the fork is known missing, -1 if unknown
+extern int RelSizeTableLookupExists(RelTag *relTag, uint32 hashcode);
+
+// Caches relSize unless a size is cached already, returns true if it did
+extern bool RelSizeTableInsertIfAbsent(RelTag *relTag, uint32 hashcode, int relSize);
+
+// Raises the cached size to relSize, never lowers it
+extern void RelSizeTableExtend(RelTag *relTag, uint32 hashcode, int relSize);
+
 extern void RelSizeTableDelete(RelTag *relTag, uint32 hashcode);
 
+// Caches an answer of the storage node asked for at lsn, relSize -1 for a
+// missing fork. Only if nothing is cached and no forget at lsn or later
+// could have been missed by it
+extern bool RelSizeTableInsertLease(RelTag *relTag, uint32 hashcode, int relSize, uint64 lsn);
+
+// Drops what is cached, answers asked for up to lsn aren't cached any more
+extern void RelSizeTableForget(RelTag *relTag, uint32 hashcode, uint64 lsn);
+
 #ifdef __cplusplus
 }
 #endif
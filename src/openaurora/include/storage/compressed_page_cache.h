@@ -0,0 +1,63 @@
+//
+// Compressed in-memory tier behind shared buffers on a compute node
+//
+#ifndef SRC_COMPRESSED_PAGE_CACHE_H
+#define SRC_COMPRESSED_PAGE_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "storage/buf_internals.h"
+
+//! Pages evicted from shared buffers are LZ4-compressed into an arena in
+//! shared memory, and a page read again is decompressed from there before
+//! the memory pool, the local page cache or the storage node are asked.
+//! Most heap and index pages compress two to three times, so the arena
+//! holds that many more pages than shared buffers of its size would. A page
+//! that doesn't compress to at most three quarters of BLCKSZ isn't kept.
+//!
+//! The arena is a log: pages are appended at its head, which wraps around
+//! and overwrites the oldest ones. An entry of a page, found through a hash
+//! table, has its BufferTag, its LSN and where it was appended; it is gone
+//! once the head passed over its bytes. The entries are replaced with CLOCK.
+//! A page put again at the LSN it was kept at isn't compressed again. All of
+//! it is under one LWLock, a page is decompressed under it held shared.
+//!
+//! A page kept is the newest version, as for the map page cache: this node
+//! changes a page only in its buffer, which puts it again on eviction. What
+//! else may change it drops it: on a replica a redone record whose page
+//! isn't in buffers, a buffer refreshed from the page change feed, dropped
+//! or evicted unkept, and a relation truncated or dropped.
+
+// GUC, in blocks of the arena
+extern int compressed_page_cache_size;
+
+extern Size CompressedPageCacheShmemSize(void);
+extern void CompressedPageCacheShmemInit(void);
+
+extern bool CompressedPageCacheEnabled(void);
+
+// Returns true and fills page if the page is kept
+extern bool CompressedPageCacheGet(const BufferTag *tag, char *page);
+
+// Keeps the page, called as its buffer is evicted
+extern void CompressedPageCachePut(const BufferTag *tag, const char *page);
+
+// The page may have changed since it was put
+extern void CompressedPageCacheInvalidate(const BufferTag *tag);
+
+// Any page may have changed since it was put
+extern void CompressedPageCacheInvalidateAll(void);
+
+// The blocks from firstBlock on of the fork are gone, of all forks for
+// InvalidForkNumber
+extern void CompressedPageCacheDropRelation(RelFileNode rnode, ForkNumber forkNum, BlockNumber firstBlock);
+
+extern void CompressedPageCacheDropDatabase(Oid dbid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_COMPRESSED_PAGE_CACHE_H
@@ -0,0 +1,52 @@
+/*-------------------------------------------------------------------------
+ *
+ * cpu_roles.h
+ *		CPU placement of the storage node's threads, by what they do
+ *
+ * STORAGE_CPU_ROLES gives the CPUs of each role, for instance
+ * "parse=0;redo=1-4;rpc=5-13;replay=5-13;compaction=14,15". A thread or
+ * process binds itself to its role once it starts; the ones created after
+ * that inherit the mask. The CPUs of parse and redo are dedicated: every
+ * other thread of the node, RocksDB's among them, stays off them unless
+ * its role lists them too.
+ *
+ * IDENTIFICATION
+ *		src/include/storage/cpu_roles.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef CPU_ROLES_H
+#define CPU_ROLES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum CpuRole
+{
+	CPU_ROLE_OTHER = 0,			/* anything without a role of its own */
+	CPU_ROLE_PARSE,				/* StartupXLOG and the logindex pipeline */
+	CPU_ROLE_REDO,				/* the wal_redo processes, one CPU each */
+	CPU_ROLE_RPC,				/* the page service's threads */
+	CPU_ROLE_REPLAY,			/* background replayers and prefetchers */
+	CPU_ROLE_COMPACTION,		/* RocksDB flushes and compactions */
+	CPU_ROLES
+} CpuRole;
+
+/* Reads STORAGE_CPU_ROLES and binds the calling process to "other" */
+extern void CpuRolesInit(void);
+
+/* Whether STORAGE_CPU_ROLES placed any role */
+extern bool CpuRolesEnabled(void);
+
+/*
+ * Binds the calling thread to the CPUs of role, or, when nth >= 0, to the
+ * nth of them (wrapping around). A role that wasn't given gets "other".
+ */
+extern void CpuRoleBind(CpuRole role, int nth);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif							/* CPU_ROLES_H */
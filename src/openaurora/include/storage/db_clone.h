@@ -0,0 +1,78 @@
+//
+// Copy-on-write database clones on the storage node
+//
+#ifndef SRC_DB_CLONE_H
+#define SRC_DB_CLONE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "access/xlogdefs.h"
+#include "common/relpath.h"
+#include "storage/block.h"
+#include "storage/relfilenode.h"
+
+//! CREATE DATABASE ... TEMPLATE copies the template's directories, every
+//! page of them. With DATABASE_CLONE set, the storage node replays it as a
+//! clone instead: the new database's directory gets the template's small
+//! files and an empty file per relation fork, and the clone map remembers
+//! that the database is the template as of the LSN of the record, the fork
+//! LSN, and how many blocks each fork had then. The time this takes doesn't
+//! depend on the size of the template.
+//!
+//! A block of such a fork below that size, as long as the clone has no
+//! version of it, is the template's at the fork LSN; once the clone changes
+//! it, its versions are replayed on top of that page. A truncation lowers
+//! the size, a fork created anew with the relfilenode of a dropped one is
+//! the clone's own. The template's versions from the fork LSN on aren't
+//! collected while a clone of it exists, and a template dropped before its
+//! clones keeps its files.
+//!
+//! The map is also kept in the text file DB_CLONE_FILE of the data
+//! directory, one line per change, read when the storage node starts:
+//!
+//!     clone <spc> <db> from <spc> <db> at 0/5A000000
+//!     rel <spc> <db> <rel> <fork> <blocks>
+//!     drop <spc> <db>
+
+#define DB_CLONE_FILE "pg_db_clones"
+
+typedef struct DbCloneRoute {
+    // The relation the block is read from
+    RelFileNode parent;
+    XLogRecPtr forkLsn;
+} DbCloneRoute;
+
+// Whether CREATE DATABASE makes clones here
+extern bool DbCloneEnabled(void);
+
+// Make dbNode in spcNode a clone of srcDb in srcSpc as of forkLsn, in the
+// place of copydir()
+extern void DbCloneCreate(Oid srcSpc, Oid srcDb, Oid spcNode, Oid dbNode, XLogRecPtr forkLsn);
+
+// Routes a read of the block to the relation of the parent it falls through
+// to, false if the block is the clone's own. The caller checks the clone has
+// no version of it.
+extern bool DbCloneRouteBlock(RelFileNode rnode, ForkNumber forkNum, BlockNumber blkNum, DbCloneRoute *route);
+
+// Blocks of the fork that fall through to the parent, 0 if none do
+extern BlockNumber DbCloneParentBlocks(RelFileNode rnode, ForkNumber forkNum);
+
+// The fork was truncated to nblocks, or created anew
+extern void DbCloneTruncate(RelFileNode rnode, ForkNumber forkNum, BlockNumber nblocks);
+extern void DbCloneForget(RelFileNode rnode, ForkNumber forkNum);
+
+// The database's directory in spcNode is dropped. False if its files have
+// to stay, a clone reads from them.
+extern bool DbCloneDrop(Oid spcNode, Oid dbNode);
+
+// Oldest fork LSN of the clones of the database, of any database when
+// dbNode is InvalidOid. InvalidXLogRecPtr if there are none.
+extern XLogRecPtr DbCloneOldestForkLsn(Oid spcNode, Oid dbNode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_DB_CLONE_H
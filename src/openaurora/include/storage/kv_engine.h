@@ -0,0 +1,91 @@
+//
+// Storage engines behind the KV interface
+//
+#ifndef SRC_KV_ENGINE_H
+#define SRC_KV_ENGINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+//! The store is split into column families by access pattern. Page versions
+//! are read at random and overwritten, xlog records are appended in LSN
+//! order and read back shortly after, meta holds the rest (lsn chains).
+typedef enum KvFamily {
+    KV_FAMILY_DEFAULT = 0,  // unused, only the older single family layouts wrote it
+    KV_FAMILY_META,
+    KV_FAMILY_PAGE,
+    KV_FAMILY_XLOG,
+    KV_FAMILY_NUM
+} KvFamily;
+
+//! Page version and lsn chain keys are binary and big-endian, so the engines
+//! keep the versions of a page together, newest first:
+//!     $Kind(4) $SpcID(4) $DbID(4) $RelID(4) $ForkNum(4) $BlkNum(4) [~$LSN(8)]
+//! The first KV_PAGE_PREFIX_LEN bytes name the page.
+#define KV_PAGE_PREFIX_LEN (24)
+#define KV_PAGE_KEY_LEN (KV_PAGE_PREFIX_LEN + 8)
+
+//! An engine implements these over the families, keys and values are opaque
+//! bytes. put, get and delete return 0 on success, get sets *value to NULL
+//! if the key is missing. seek finds the first key at or after key that
+//! starts with its first prefixLen bytes, prefixLen is KV_PAGE_PREFIX_LEN
+//! in the page family and the key length elsewhere. Returns 1 if found.
+//! Returned keys and values are malloc'ed, the caller frees them. All of
+//! them may be called from several threads at once.
+typedef struct KvEngine {
+    const char *name;
+    // Opens the store under DataDir, returns 0 on success
+    int (*open)(void);
+    void (*close)(void);
+    int (*put)(KvFamily family, const char *key, size_t keyLen, const char *value, size_t valueLen);
+    int (*get)(KvFamily family, const char *key, size_t keyLen, char **value, size_t *valueLen);
+    int (*delete_key)(KvFamily family, const char *key, size_t keyLen);
+    int (*seek)(KvFamily family, const char *key, size_t keyLen, size_t prefixLen,
+                char **foundKey, size_t *foundKeyLen, char **value, size_t *valueLen);
+    // Drops obsolete page versions in its own compaction. Otherwise they are
+    // deleted explicitly once the logindex no longer needs them
+    int compactionGc;
+} KvEngine;
+
+#define KV_ENGINE_MAX (8)
+
+// Engines are registered before the store is opened, kv_engine names the one
+// in use. Returns 0 on success
+extern int KvRegisterEngine(const KvEngine *engine);
+extern const KvEngine *KvLookupEngine(const char *name);
+
+// GUC: name of the engine
+extern char *kv_engine;
+
+// Shipped engines
+extern const KvEngine KvMemoryEngine;
+extern const KvEngine KvSsdEngine;
+
+//! Sharded hash index shared by the memory and ssd engines. Keys of the page
+//! family are grouped by page, the versions of a group are kept in key
+//! order, so seek is a lookup of the group and a binary search in it. The
+//! visitors run under the shard lock, the payload is only valid in them.
+typedef struct KvIndex KvIndex;
+typedef void (*KvIndexVisitor)(const char *key, size_t keyLen, void *payload, void *arg);
+
+extern KvIndex *KvIndexCreate(void);
+// freePayload is called on every payload left
+extern void KvIndexDestroy(KvIndex *index, void (*freePayload)(void *payload));
+// Returns the payload put replaces or delete removes, NULL if there was none
+extern void *KvIndexPut(KvIndex *index, KvFamily family, const char *key, size_t keyLen, void *payload);
+extern void *KvIndexDelete(KvIndex *index, KvFamily family, const char *key, size_t keyLen);
+// Return 1 if found and visited
+extern int KvIndexGet(KvIndex *index, KvFamily family, const char *key, size_t keyLen,
+                      KvIndexVisitor visitor, void *arg);
+extern int KvIndexSeek(KvIndex *index, KvFamily family, const char *key, size_t keyLen, size_t prefixLen,
+                       KvIndexVisitor visitor, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_KV_ENGINE_H
@@ -12,6 +12,16 @@ extern "C" {
 #include <storage/buf_internals.h>
 #include <access/xlogreader.h>
 
+// GUCs: page version write combining
+extern int kv_page_batch_size;
+extern int kv_page_batch_delay;
+extern bool kv_page_disable_wal;
+extern bool kv_page_compaction_gc;
+extern int kv_page_delta_versions;
+// GUCs: a rocksdb instance per database, and the rate of their compactions
+extern bool kv_per_database;
+extern int kv_compaction_rate_limit;
+
 extern int KvPut(char *, char *, int);
 extern void InitKvStore();
 extern int KvGet(char *, char **, size_t* len);
@@ -36,12 +46,65 @@ extern void PutList2Rocksdb(BufferTag bufferTag, uint64_t* listPointer, int list
 
 // Page related
 extern int GetPageFromRocksdb(BufferTag bufferTag, uint64_t lsn, char** pageContent);
+// Zero-copy variants, the pages are copied into the caller's BLCKSZ buffers
+// from pinned values. Return 1 / the number found
+extern int ReadPageFromRocksdb(BufferTag bufferTag, uint64_t lsn, char* page);
+extern int ReadPageListFromRocksdb(const BufferTag* bufferTags, const uint64_t* lsnList, int num, char** pages, int* found);
 extern void PutPage2Rocksdb(BufferTag bufferTag, uint64_t lsn, char* pageContent);
 extern void DeletePageFromRocksdb(BufferTag bufferTag, uint64_t lsn);
+// Every version of every page of the relation's forks, with one range
+// delete. Only rocksdb deletes ranges, returns 0 for the other engines, the
+// caller deletes the versions one by one then
+extern int DeleteRelationFromRocksdb(RelFileNode rnode);
+// Page versions are put and deleted through a write batch, commit it now
+extern void KvFlushPageBatch(void);
+// With kv_per_database, the store of a database dropped at lsn is removed
+// once no compute node reads below it, or right away if a database is
+// created under its OID again
+extern void KvDropDatabase(Oid dbid, uint64_t lsn);
+extern void KvCreateDatabase(Oid dbid);
+// Oldest LSN any compute node may read. With kv_page_compaction_gc the
+// versions without use below it are dropped by compaction
+extern void KvSetPageGcHorizon(uint64_t lsn);
+// Whether the engine in use drops them, otherwise they must be deleted
+extern bool KvPageGcInCompaction(void);
+extern uint64_t KvGetPageGcHorizon(void);
+// Newest version at or before lsn, its LSN is returned in foundLsn.
+// Returns 1 if found, pageContent must be freed by the caller
+extern int GetNewestPageFromRocksdb(BufferTag bufferTag, uint64_t lsn, uint64_t *foundLsn, char** pageContent);
+
+// Cold page tiering, see kv_tier.h. The scan visits the page family in key
+// order, until the visitor returns 0. It returns 0 if it saw every key, which
+// only rocksdb can walk
+typedef int (*KvPageScanVisitor)(const char *key, size_t keyLen, const char *value, size_t valueLen, void *arg);
+extern int KvScanPages(KvPageScanVisitor visitor, void *arg);
+extern void KvReplacePageValue(const char *key, size_t keyLen, const char *value, size_t valueLen);
+
+// Memory held by the rocksdb memtables and block cache, both 0 with the
+// other engines. For the memory governor, storage/mem_governor.h
+extern void KvMemoryUsage(uint64_t *memtableBytes, uint64_t *blockCacheBytes);
+// Flush the family with the largest active memtable, if that one holds at
+// least minBytes, without waiting. Returns the family or -1
+extern int KvFlushLargestMemtable(uint64_t minBytes);
+// Capacity of the block cache, which can't grow past its size at open
+extern size_t KvBlockCacheCapacity(void);
+extern void KvSetBlockCacheCapacity(size_t bytes);
+
+// Logindex version chains spilled out of the hashmap.
+// Put returns 0 on success, Get returns 1 if found
+extern int PutLsnChain2Rocksdb(BufferTag bufferTag, uint64_t* chain, int chainLen);
+extern int GetLsnChainFromRocksdb(BufferTag bufferTag, uint64_t** chain, int* chainLen);
+// Missing chains come back NULL, returns how many were found
+extern int GetLsnChainListFromRocksdb(const BufferTag* bufferTags, int num, uint64_t** chains, int* chainLens);
+extern void DeleteLsnChainFromRocksdb(BufferTag bufferTag);
 
 // Xlog related
 extern int PutXlogWithLsn(XLogRecPtr lsn, XLogRecord* record);
 extern int GetXlogWithLsn(XLogRecPtr lsn, XLogRecord** record, size_t* record_size);
+// Fetch the records of several LSNs with one lookup, served from the xlog
+// cache where possible. Missing ones come back NULL with size 0, the others
+// must be freed by the caller. Returns how many were found.
+extern int GetXlogListWithLsn(const XLogRecPtr* lsnList, int num, XLogRecord** records, size_t* recordSizes);
 
 extern int FindListLowerBound(uint64_t* uintList, uint64_t targetLsn, uint64_t *foundLsn, uint64_t *foundPos);
 
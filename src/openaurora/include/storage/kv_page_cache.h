@@ -0,0 +1,42 @@
+//
+// Cache of the newest page versions, in front of the KV store
+//
+#ifndef SRC_KV_PAGE_CACHE_H
+#define SRC_KV_PAGE_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "storage/buf_internals.h"
+
+//! One frame per page, holding the newest version put or read. A lookup
+//! hits only for that exact (BufferTag, LSN), a stored version never
+//! changes, so nothing has to be invalidated as long as the version stays
+//! in the store. The frames are split into shards by page, each evicting
+//! with CLOCK under its own lock.
+
+// GUC, in blocks
+extern int kv_page_cache_size;
+
+// Returns 1 and fills page if the version is cached
+extern int KvPageCacheGet(BufferTag tag, uint64_t lsn, char *page);
+
+// Keeps the version unless a newer one of the page is cached
+extern void KvPageCachePut(BufferTag tag, uint64_t lsn, const char *page);
+
+// The version was deleted from the store
+extern void KvPageCacheForget(BufferTag tag, uint64_t lsn);
+
+// Use at most blocks of the kv_page_cache_size frames, handing the memory of
+// the others back. Raising it again up to kv_page_cache_size is allowed.
+extern void KvPageCacheSetLimit(int blocks);
+// Bytes of the cached versions
+extern uint64_t KvPageCacheBytes(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_KV_PAGE_CACHE_H
@@ -0,0 +1,75 @@
+//
+// Page versions stored as deltas against an earlier full version of the page
+//
+#ifndef SRC_KV_PAGE_DELTA_H
+#define SRC_KV_PAGE_DELTA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+//! A page version value is one of
+//!     $Page(BLCKSZ)                          full version, the base of later deltas
+//!     $Header $Page(BLCKSZ)                  full version that is no delta base
+//!     $Header [$Offset(2) $Len(2) $Bytes]*   the bytes changed since $Header.baseLsn
+//!     $Header $RemoteRef                     one of the above, moved to the object store
+//! A remote value keeps the kind and baseLsn of the one it stands for in its
+//! header, $Header.runs holds the kind.
+#define KV_PAGE_VALUE_MAGIC (0x50564431)  // "PVD1"
+
+#define KV_PAGE_VALUE_BASE  (0)
+#define KV_PAGE_VALUE_DELTA (1)
+#define KV_PAGE_VALUE_LOOSE (2)
+#define KV_PAGE_VALUE_REMOTE (3)
+#define KV_PAGE_VALUE_INVALID (-1)
+
+typedef struct KvPageValueHeader {
+    uint32_t magic;
+    uint16_t kind;
+    uint16_t runs;
+    uint64_t baseLsn;
+} KvPageValueHeader;
+
+#define KV_PAGE_VALUE_MAX_LEN (sizeof(KvPageValueHeader) + BLCKSZ)
+
+// Where kv_tier.c put the value
+typedef struct KvPageRemoteRef {
+    uint64_t object;
+    uint32_t offset;
+    uint32_t len;
+    uint32_t crc;       // CRC32C of the value
+    uint32_t pad;
+} KvPageRemoteRef;
+
+#define KV_PAGE_REMOTE_LEN (sizeof(KvPageValueHeader) + sizeof(KvPageRemoteRef))
+
+// Kind of a stored value, baseLsn is set for deltas
+extern int KvPageValueKind(const char *value, size_t valueLen, uint64_t *baseLsn);
+
+// Writes the delta of page against base to out, which holds maxLen bytes.
+// Returns the value length, or 0 if the delta doesn't fit
+extern size_t KvPageDeltaEncode(const char *base, uint64_t baseLsn, const char *page, char *out, size_t maxLen);
+
+// page holds the base version, the delta is applied on it. Returns 0 if the
+// delta is damaged
+extern int KvPageDeltaApply(const char *value, size_t valueLen, char *page);
+
+// Wraps page into a full version that is no delta base, out holds
+// KV_PAGE_VALUE_MAX_LEN bytes. Returns the value length
+extern size_t KvPageLooseEncode(const char *page, char *out);
+
+// Writes the stand-in of a value of the given kind to out, which holds
+// KV_PAGE_REMOTE_LEN bytes. Returns the value length
+extern size_t KvPageRemoteEncode(int kind, uint64_t baseLsn, const KvPageRemoteRef *ref, char *out);
+
+// Kind of the value a remote one stands for, ref may be NULL
+extern int KvPageRemoteDecode(const char *value, size_t valueLen, KvPageRemoteRef *ref);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_KV_PAGE_DELTA_H
@@ -0,0 +1,61 @@
+//
+// Cold page versions moved from the KV store to an object store
+//
+#ifndef SRC_KV_TIER_H
+#define SRC_KV_TIER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+//! A background sweep walks the page versions once every KV_TIER_INTERVAL.
+//! The versions of a page whose newest version lies kv_tier_min_age of WAL
+//! below the oldest LSN any compute node may read are appended to an object
+//! of up to KV_TIER_OBJECT_SIZE. Once the object is stored, each of them is
+//! replaced in the KV store by a small remote value, see kv_page_delta.h.
+//!
+//! The keys stay where they are, so the KV store remains the index of all
+//! versions, and lookups and compaction work as before. A remote value is
+//! fetched when it is read, through a cache of the values read last.
+//!
+//! The sweep also counts the remote values of every object. An object none
+//! is left of, all its versions being dropped by compaction, is removed.
+//! The objects are listed in the meta family.
+
+// GUCs
+extern char *kv_tier_path;
+extern int kv_tier_min_age;
+
+// An object store, objects are written once and read in ranges
+typedef struct KvTierStore {
+    const char *name;
+    // Returns 0 once the object is durable
+    int (*put)(uint64_t object, const char *data, size_t len);
+    // Reads len bytes at offset into buf, returns 0 on success
+    int (*get)(uint64_t object, size_t offset, size_t len, char *buf);
+    int (*remove)(uint64_t object);
+} KvTierStore;
+
+// Objects are files in the kv_tier_path directory. Point it at the mount of
+// an S3-compatible bucket (s3fs, goofys, mountpoint-s3, ...) to keep them
+// there.
+extern const KvTierStore KvTierDirStore;
+
+// Stores of extensions replace the directory before the store is opened
+extern void KvSetTierStore(const KvTierStore *store);
+
+// Starts the sweep if kv_tier_path is set, called once the store is open
+extern void KvTierStart(void);
+
+// The value a remote one stands for, malloc'ed. Returns NULL if it can't
+// be read
+extern char *KvTierFetch(const char *value, size_t valueLen, size_t *fetchedLen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_KV_TIER_H
@@ -0,0 +1,59 @@
+//
+// Page cache of a compute node on its local SSD
+//
+#ifndef SRC_LOCAL_PAGE_CACHE_H
+#define SRC_LOCAL_PAGE_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "storage/buf_internals.h"
+
+//! A second level behind shared buffers. Pages evicted from them are written
+//! to a file on the local SSD, and a page read again is taken from there
+//! instead of being fetched in full from the storage node. Its LSN goes
+//! along with the read, and the storage node only sends the page back if it
+//! changed since. A cached page whose LSN is at least the one read at is
+//! current and used as it is.
+//!
+//! The file starts with a directory of the slots, (BufferTag, LSN, CRC) each,
+//! followed by the pages. The directory is read back at startup, so the
+//! cache survives restarts. A page is only used if its CRC matches, so
+//! nothing has to be synced. A slot is found through a hash table in shared
+//! memory and replaced with CLOCK, the I/O is done outside of its lock.
+//!
+//! A page kept is current as long as nothing changed it since, and is then
+//! used without asking the storage node. This node changes a page only in
+//! its buffer, which puts it again on eviction. Whatever else may change it
+//! invalidates it by BufferTag: a redone record whose page isn't in buffers,
+//! a buffer dropped or evicted unkept. A page read back from the file after
+//! a restart isn't known to be current.
+
+// GUCs
+extern char *local_page_cache_path;
+extern int local_page_cache_size;
+
+extern Size LocalPageCacheShmemSize(void);
+extern void LocalPageCacheShmemInit(void);
+
+extern bool LocalPageCacheEnabled(void);
+
+// Returns true and fills page if the page is cached, current tells if it
+// is known to be the newest version
+extern bool LocalPageCacheGet(const BufferTag *tag, char *page, bool *current);
+
+// Keeps the page, called as its buffer is evicted
+extern void LocalPageCachePut(const BufferTag *tag, const char *page);
+
+// The page may have changed since it was put
+extern void LocalPageCacheInvalidate(const BufferTag *tag);
+
+// Any page may have changed since it was put
+extern void LocalPageCacheInvalidateAll(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_LOCAL_PAGE_CACHE_H
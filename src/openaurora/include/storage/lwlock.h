@@ -230,6 +230,14 @@ typedef enum BuiltinTrancheIds
 
 	LWTRANCHE_MEMPOOL_CLIENT,
 	LWTRANCHE_MEMPOOL_SERVER,
+	LWTRANCHE_LOCAL_PAGE_CACHE,
+	LWTRANCHE_MAP_PAGE_CACHE,
+	LWTRANCHE_INDEX_PAGE_CACHE,
+	LWTRANCHE_COMPRESSED_PAGE_CACHE,
+	LWTRANCHE_PGSTAT_PARTITION,
+	LWTRANCHE_SHARED_PLAN_CACHE,
+	LWTRANCHE_SHARED_PLAN_CACHE_DSA,
+	LWTRANCHE_MEMPOOL_VERSION_MAP,
 
 	LWTRANCHE_FIRST_USER_DEFINED
 }			BuiltinTrancheIds;
@@ -0,0 +1,95 @@
+//
+// Visibility map and free space map pages, and B-tree upper-level pages,
+// kept in memory on a compute node
+//
+#ifndef SRC_MAP_PAGE_CACHE_H
+#define SRC_MAP_PAGE_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "storage/buf_internals.h"
+
+//! The map forks are tiny and read all the time, by index-only scans and
+//! vacuum for the visibility map and by every insert looking for space in
+//! the free space map, so a page of theirs evicted from shared buffers is
+//! kept in shared memory and read back from there instead of the storage
+//! node. Their reads are RBM_ZERO_ON_ERROR, which the local page cache
+//! doesn't take.
+//!
+//! A page kept is the newest version: this node changes a page only in its
+//! buffer, which puts it again on eviction. What else may change it drops
+//! it, as for the local page cache: on a replica a redone record whose page
+//! isn't in buffers, and the visibility map page of each heap block it
+//! changes, since clearing the bits isn't a block of the record; a buffer
+//! refreshed from the page change feed, dropped or evicted unkept; and a
+//! relation truncated or dropped. The slots are found through a hash table
+//! under one LWLock and replaced with CLOCK, the pages are copied under it.
+
+// GUCs
+extern int map_page_cache_size;
+extern int index_page_cache_size;
+
+#define MapPageCacheFork(forkNum) \
+    ((forkNum) == FSM_FORKNUM || (forkNum) == VISIBILITYMAP_FORKNUM)
+
+extern Size MapPageCacheShmemSize(void);
+extern void MapPageCacheShmemInit(void);
+
+extern bool MapPageCacheEnabled(void);
+
+// Returns true and fills page if the page is kept
+extern bool MapPageCacheGet(const BufferTag *tag, char *page);
+
+// Keeps the page, called as its buffer is evicted
+extern void MapPageCachePut(const BufferTag *tag, const char *page);
+
+// The page may have changed since it was put
+extern void MapPageCacheInvalidate(const BufferTag *tag);
+
+// A record redone on a replica changed the page, see above
+extern void MapPageCacheInvalidateRedo(const BufferTag *tag);
+
+// Any page may have changed since it was put
+extern void MapPageCacheInvalidateAll(void);
+
+// The blocks from firstBlock on of the fork are gone, of all forks for
+// InvalidForkNumber
+extern void MapPageCacheDropRelation(RelFileNode rnode, ForkNumber forkNum, BlockNumber firstBlock);
+
+extern void MapPageCacheDropDatabase(Oid dbid);
+
+//! The root and internal pages of a B-tree are read by every descent, yet in
+//! the clock sweep they compete with the leaf and heap pages and lose to
+//! them now and then, to be read back from the storage node at the end of
+//! a long, hot version chain. So one evicted is kept in a cache of its own
+//! size, as is a metapage, and read back from there; leaf pages aren't. A
+//! kept page is dropped on the same changes as a map page above. A B-tree
+//! page is told apart from a hash or GiST page of the same special size by
+//! its cycle id, see MAX_BT_CYCLE_ID.
+
+extern Size IndexPageCacheShmemSize(void);
+extern void IndexPageCacheShmemInit(void);
+
+extern bool IndexPageCacheEnabled(void);
+
+extern bool IndexPageCacheGet(const BufferTag *tag, char *page);
+
+// Returns whether the page was kept, it is only if it's an upper-level page
+// or the metapage of a B-tree
+extern bool IndexPageCachePut(const BufferTag *tag, const char *page);
+
+extern void IndexPageCacheInvalidate(const BufferTag *tag);
+
+extern void IndexPageCacheInvalidateAll(void);
+
+extern void IndexPageCacheDropRelation(RelFileNode rnode, ForkNumber forkNum, BlockNumber firstBlock);
+
+extern void IndexPageCacheDropDatabase(Oid dbid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_MAP_PAGE_CACHE_H
@@ -0,0 +1,76 @@
+/*-------------------------------------------------------------------------
+ *
+ * mem_governor.h
+ *		Memory budget of the storage node, across its components
+ *
+ * STORAGE_MEMORY_LIMIT_MB caps the node as a whole: the storage server
+ * process and its wal_redo processes. The governor samples what each
+ * component holds and, once the total is over the limit, pushes back on
+ * the ones that can give memory back, in this order: it flushes the
+ * largest RocksDB memtable early, shrinks the block cache and the page
+ * cache, and lowers the logindex budget so the spiller moves chains to
+ * RocksDB. Once usage is back under 90% of the limit the caches and the
+ * logindex are given their room back. Unset means no limit; the breakdown
+ * is still exposed in the metrics.
+ *
+ * IDENTIFICATION
+ *		src/include/storage/mem_governor.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef MEM_GOVERNOR_H
+#define MEM_GOVERNOR_H
+
+#include "postgres.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum MemComponent
+{
+	MEM_MEMTABLES = 0,			/* RocksDB memtables, flushing included */
+	MEM_BLOCK_CACHE,			/* RocksDB block cache */
+	MEM_PAGE_CACHE,				/* kv_page_cache.h */
+	MEM_LOGINDEX,				/* logindex heads and element nodes */
+	MEM_REDO,					/* private memory of the wal_redo processes */
+	MEM_OTHER,					/* the rest of the process, RPC buffers included */
+	MEM_COMPONENTS
+} MemComponent;
+
+/* The ways the governor pushed back */
+typedef enum MemAction
+{
+	MEM_ACTION_FLUSH = 0,
+	MEM_ACTION_SHRINK,
+	MEM_ACTION_SPILL,
+	MEM_ACTIONS
+} MemAction;
+
+typedef struct MemGovernorStats
+{
+	uint64		bytes[MEM_COMPONENTS];
+	uint64		total;
+	uint64		limit;			/* 0 if unbounded */
+	double		cacheScale;		/* share of their size the caches may use */
+	uint64		logindexLimit;	/* budget given to the logindex, 0 if none */
+	uint64		actions[MEM_ACTIONS];
+} MemGovernorStats;
+
+/* A wal_redo process to account for, called by the process that forked it */
+extern void MemGovernorTrackProcess(pid_t pid);
+
+/*
+ * Reads STORAGE_MEMORY_LIMIT_MB and starts the governor thread if it is
+ * set. Call once the KV store and the logindex exist.
+ */
+extern void MemGovernorStart(void);
+
+/* Samples the components now, from any thread */
+extern void MemGovernorRead(MemGovernorStats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif							/* MEM_GOVERNOR_H */
@@ -27,9 +27,28 @@ typedef struct RelKeyType RelKey;
 //      Else, update the existed value
 extern void InsertRelSizeCache(RelKey relKey, uint32_t blockNum);
 
+// Raise the cached size to blockNum, never lower it. Concurrent extends
+// need no lock around it
+extern void ExtendRelSizeCache(RelKey relKey, uint32_t blockNum);
+
+// Insert blockNum unless a size is cached already, return true if inserted
+extern bool InsertRelSizeCacheIfAbsent(RelKey relKey, uint32_t blockNum);
+
+// Cache what the storage node answered for lsn, blockNum -1 if the fork
+// doesn't exist. Skipped if something is cached, or if a forget at lsn or
+// later may not be reflected in the answer
+extern bool InsertRelSizeLease(RelKey relKey, int32_t blockNum, uint64_t lsn);
+
+// The fork was dropped at lsn
+extern void ForgetRelSizeCache(RelKey relKey, uint64_t lsn);
+
+// 1 if the fork is cached as existing, 0 as missing, -1 if unknown
+extern int GetRelExistsCache(RelKey relKey);
+
 // Get relation size from cache
 // If find this key in cache, return true and return blockNum via $result
 // Otherwise, return false
+// The cache takes no lock, none is needed around single calls
 extern bool GetRelSizeCache(RelKey relKey, uint32_t *result);
 
 // Call this function at the beginning of Postmaster process
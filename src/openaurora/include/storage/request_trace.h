@@ -0,0 +1,75 @@
+//
+// Capture of the requests a storage node serves
+//
+#ifndef SRC_REQUEST_TRACE_H
+#define SRC_REQUEST_TRACE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! With STORAGE_REQUEST_TRACE set to a file name, the storage node appends
+//! every page read, batch read, conditional read, prefetch, nblocks and
+//! exists request it's sent to that file, for test/pageserver's
+//! pageserver_replay to send again, at the same pace and from as many
+//! connections. Writes and WAL traffic aren't captured, they can't be
+//! replayed against a node that already has them.
+//!
+//! The file is a RequestTraceHeader followed by RequestTraceRecords in host
+//! byte order. Each server thread, a stream, buffers its records and
+//! appends them together, so the records of one stream are in order and
+//! those of different streams interleave by the buffer. A request of a list
+//! of blocks is a record with the first block and count, followed by
+//! count - 1 REQUEST_TRACE_CONTINUED records with one block each.
+
+#define REQUEST_TRACE_MAGIC "OARQTRC1"
+
+typedef enum RequestTraceType {
+    REQUEST_TRACE_READ = 1,
+    REQUEST_TRACE_READ_BATCH,
+    REQUEST_TRACE_READ_IF_MODIFIED,
+    REQUEST_TRACE_PREFETCH,
+    REQUEST_TRACE_NBLOCKS,
+    REQUEST_TRACE_EXISTS,
+    REQUEST_TRACE_CONTINUED
+} RequestTraceType;
+
+typedef struct RequestTraceHeader {
+    char magic[8];
+    // Wall clock time capture started at, in microseconds since the epoch
+    uint64_t startUs;
+} RequestTraceHeader;
+
+typedef struct RequestTraceRecord {
+    // Since capture started
+    uint64_t offsetNs;
+    uint64_t lsn;
+    // Page LSN the client holds, of a conditional read
+    uint64_t cachedLsn;
+    uint32_t spcNode;
+    uint32_t dbNode;
+    uint32_t relNode;
+    uint32_t blkNum;
+    uint32_t stream;
+    uint16_t count;
+    uint8_t type;
+    uint8_t forkNum;
+} RequestTraceRecord;
+
+// Whether requests are captured, false unless STORAGE_REQUEST_TRACE is set
+extern bool RequestTraceEnabled(void);
+
+extern void RequestTraceCapture(RequestTraceType type, uint32_t spcNode, uint32_t dbNode, uint32_t relNode,
+                                int forkNum, uint32_t blkNum, uint64_t lsn, uint64_t cachedLsn);
+
+// A request of a list of blocks
+extern void RequestTraceCaptureList(RequestTraceType type, uint32_t spcNode, uint32_t dbNode, uint32_t relNode,
+                                    int forkNum, const int64_t *blkNums, int n, uint64_t lsn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_REQUEST_TRACE_H
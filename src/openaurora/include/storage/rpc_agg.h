@@ -0,0 +1,95 @@
+//
+// Aggregates computed on the storage node
+//
+// An aggregate of a single relation without GROUP BY, of count, sum of an
+// int2 or int4 column and min or max of an integer or oid column, with
+// either no qual or one the storage node can check (see storage/rpc_scan.h),
+// can be done halfway by the storage node: AggregateRelation reconstructs the
+// pages of a range of blocks and adds the tuples of every all-visible page
+// to the aggregates' partial states. Visibility needs the commit log, so the
+// node only knows a page's tuples count if the page is all-visible; the
+// numbers of the other pages come back with the states and the compute node
+// aggregates those itself. A Finalize Aggregate combines the partial states
+// and computes the results as after a parallel partial aggregation.
+//
+// All-visible pages of an LSN at least the snapshot's can be counted as
+// they are: vacuum sets the flag only for tuples older than every snapshot
+// of the primary, and any change since clears it again.
+//
+
+#ifndef SRC_RPC_AGG_H
+#define SRC_RPC_AGG_H
+
+#include <stdint.h>
+
+#include "storage/rpc_scan.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RPC_AGG_MAX_AGGS 16
+
+typedef enum RpcAggFunc {
+    RPC_AGG_COUNT_STAR = 0,
+    RPC_AGG_COUNT,
+    RPC_AGG_SUM,
+    RPC_AGG_MIN,
+    RPC_AGG_MAX
+} RpcAggFunc;
+
+typedef struct RpcAggTarget {
+    int32_t func;
+    // Column aggregated, 0 for count(*)
+    int32_t attnum;
+    // An RpcScanKind
+    int32_t kind;
+} RpcAggTarget;
+
+// The aggregates as sent
+typedef struct RpcAggSpec {
+    int32_t naggs;
+    RpcAggTarget aggs[RPC_AGG_MAX_AGGS];
+    // The qual, with attnum 0 if there's none. Its atts describe the
+    // columns up to the highest of the qual's and the aggregates'.
+    RpcScanQual qual;
+} RpcAggSpec;
+
+// Partial state of one aggregate, the transition value of its int8 or
+// column type
+typedef struct RpcAggState {
+    int64_t value;
+    int32_t isnull;
+    int32_t pad;
+} RpcAggState;
+
+// Head of an AggregateRelation reply, the fallback block numbers follow
+typedef struct RpcAggReply {
+    // Block the node got to
+    int32_t nextBlock;
+    // Pages it didn't add, for the compute node to
+    int32_t nfallback;
+    RpcAggState states[RPC_AGG_MAX_AGGS];
+} RpcAggReply;
+
+// GUC of the compute node
+extern bool rpc_agg_pushdown;
+
+// The states of no rows yet
+extern void RpcAggInit(const RpcAggSpec *spec, RpcAggState *states);
+
+// Adds a row's value of the aggregate's column to its state
+extern void RpcAggAdvance(const RpcAggTarget *agg, RpcAggState *state, int64_t value, bool isnull);
+
+// Adds other to states, the states of another part of the relation
+extern void RpcAggCombine(const RpcAggSpec *spec, RpcAggState *states, const RpcAggState *other);
+
+// Adds the tuples of page to states. False, with states untouched, if the
+// page isn't all-visible or has a tuple that can't be read here.
+extern bool RpcAggPage(const RpcAggSpec *spec, const char *page, RpcAggState *states);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_RPC_AGG_H
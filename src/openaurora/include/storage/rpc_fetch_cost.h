@@ -0,0 +1,64 @@
+//
+// Page fetch latencies a compute node measures, for the planner
+//
+// seq_page_cost and random_page_cost model a disk, where a compute node in
+// RPC mode reads from a memory node, from the storage node's RocksDB or from
+// pages it replays first, and a sequential scan fetches a batch of pages a
+// round trip. What a page costs then depends on where a relation's pages
+// usually come from, and nothing the tablespace says tells that.
+//
+// The read paths record how long each fetch took in shared memory, a moving
+// average for every relation of two kinds of fetch: a single page, waited
+// for alone, and a page of a batch fetched together, the batch's time over
+// its pages. With rpc_measured_page_costs the planner scales its page costs
+// by them, taking the tablespace's seq_page_cost to be the average batched
+// page of the node: a relation's seq_page_cost by how its batched pages
+// compare, its random_page_cost by how its single pages compare to that.
+// The averages fold in whatever the fetches went through, memory node hits,
+// replay and round trips alike, so a relation kept in the memory node costs
+// less to read at random than one always replayed.
+//
+// A relation only has costs of its own once it had RPC_FETCH_COST_MIN_SAMPLES
+// fetches of a kind, and shares a slot with the others hashed to it, the
+// last one to record keeping it. Kept in memory only.
+//
+
+#ifndef SRC_RPC_FETCH_COST_H
+#define SRC_RPC_FETCH_COST_H
+
+#include <stdint.h>
+
+#include "storage/relfilenode.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum RpcFetchKind {
+    RPC_FETCH_SINGLE = 0,
+    RPC_FETCH_BATCHED,
+    RPC_FETCH_KINDS
+} RpcFetchKind;
+
+#define RPC_FETCH_COST_SLOTS (4096)
+#define RPC_FETCH_COST_MIN_SAMPLES (16)
+// The furthest a measured cost goes from the one it scales
+#define RPC_FETCH_COST_MAX_RATIO (64.0)
+
+extern bool rpc_measured_page_costs;
+
+extern Size RpcFetchCostShmemSize(void);
+extern void RpcFetchCostShmemInit(void);
+
+// A page of the relation took usec to fetch
+extern void RpcFetchCostRecord(RelFileNode rnode, RpcFetchKind kind, uint64_t usec);
+
+// Scales the page costs of the relation's tablespace by the latencies
+// measured. False, leaving them, if too few fetches were.
+extern bool RpcFetchPageCosts(RelFileNode rnode, double *random_page_cost, double *seq_page_cost);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_RPC_FETCH_COST_H
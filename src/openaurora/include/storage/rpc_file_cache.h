@@ -0,0 +1,54 @@
+//
+// Remote file handles of a compute node
+//
+// The control file, timeline history files and other small files are opened,
+// read whole and closed again, each step a round trip to the storage node.
+// With rpc_small_file_size above 0 a read-only BasicOpenFile or
+// OpenTransientFile becomes one RpcOpenAndReadFile instead: the node opens
+// the file and, if it is no larger than rpc_small_file_size, reads it, closes
+// it and sends it back after an RpcOpenReadReply. The backend then hands out
+// a handle of its own, at RPC_CACHED_FD_BASE and up, whose reads, seeks and
+// close never leave the process. A file that is larger stays open on the
+// node and the reply carries its descriptor, as a plain open would. Anything
+// else done with a cached handle, an fsync say, opens the file on the node
+// first and goes there from then on.
+//
+// Every reply, and every RpcStat, also leaves the file's stat result with
+// the backend for rpc_file_metadata_lease milliseconds. A stat within the
+// lease is answered from it; unlinks, renames and opens for writing of the
+// path by this backend drop it early. Other backends' changes can go unseen
+// for up to a lease, 0 turns the cache off.
+//
+
+#ifndef SRC_RPC_FILE_CACHE_H
+#define SRC_RPC_FILE_CACHE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RPC_CACHED_FD_BASE (1 << 24)
+
+// GUCs of the compute node
+extern int rpc_small_file_size;
+extern int rpc_file_metadata_lease;
+
+// Head of an RpcOpenAndReadFile reply, the file's bytes follow when complete
+typedef struct RpcOpenReadReply {
+    // Descriptor on the node, -1 if the open failed or the node closed it
+    int32_t fd;
+    // errno of a failed open
+    int32_t error;
+    int64_t size;
+    uint32_t mode;
+    // The whole file follows and the node closed it again
+    int32_t complete;
+} RpcOpenReadReply;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_RPC_FILE_CACHE_H
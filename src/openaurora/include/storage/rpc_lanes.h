@@ -0,0 +1,55 @@
+//
+// Request classes of the page service
+//
+#ifndef SRC_RPC_LANES_H
+#define SRC_RPC_LANES_H
+
+//! A compute node tells the storage node with RpcSetRequestClass which class
+//! the requests on a connection are, whenever the backend's class changes:
+//! backends running queries are foreground, (auto)vacuum is background, the
+//! checkpointer, bgwriter and startup process are maintenance. File syncs
+//! and writebacks count as maintenance whoever sends them.
+//!
+//! The storage node admits at most RPC_LANE_SLOTS page reads, extends and
+//! file syncs at a time (64 by default, 0 turns the lanes off). Once they are
+//! all taken the waiting requests queue per class and the freed slots go
+//! round robin, weighted by RPC_LANE_WEIGHTS ("8,2,1" for foreground,
+//! background and maintenance), so a VACUUM keeps making progress without
+//! taking the slots queries wait for. Other calls aren't held back.
+//!
+//! Past that the node sheds load instead of queueing without bound. A call
+//! is rejected at once when RPC_LANE_QUEUE calls already wait (4 per slot by
+//! default), when its connection holds RPC_LANE_CONNECTION_SLOTS calls (8 by
+//! default, 0 for no limit), or when it waited longer for a slot than its
+//! connection's deadline of RpcSetRequestDeadline, rpc_request_queue_timeout
+//! of the compute node. The reply is a TApplicationException whose message
+//! starts with RPC_LANE_SHED_MESSAGE and gives how many milliseconds to wait
+//! before trying again, about how long the queue takes to drain.
+//!
+//! With RPC_NONBLOCKING_SERVER those calls share the worker threads with
+//! the rest, the WAL writes of the compute nodes among them. A call that
+//! would leave fewer than RPC_LANE_INGEST_THREADS (2 by default) workers
+//! free for the calls that aren't held back is shed too, so WAL ingest
+//! always has a thread to run on.
+
+#define RPC_LANE_SHED_MESSAGE "storage node overloaded, retry after ms: "
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// GUC of the compute node
+extern int rpc_request_queue_timeout;
+
+#ifdef __cplusplus
+}
+#endif
+
+typedef enum RpcRequestClass {
+    RPC_CLASS_FOREGROUND = 0,
+    RPC_CLASS_BACKGROUND,
+    RPC_CLASS_MAINTENANCE,
+    RPC_CLASSES
+} RpcRequestClass;
+
+#endif //SRC_RPC_LANES_H
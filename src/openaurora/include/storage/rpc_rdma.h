@@ -0,0 +1,102 @@
+//
+// RDMA page reads between a compute node and a storage node.
+//
+// With rpc_rdma_port set, every backend connects a reliable queue pair to
+// the RDMA listener a storage node started on that port (RPC_RDMA_PORT in
+// its environment) once its Thrift connection is up. The queue pair info is
+// exchanged over the port the way RDMA_Manager connects to a memory node.
+// ReadBufferCommon and RpcMdNblocks requests to the home node then go as
+// two-sided sends: the backend posts the receive of the reply and sends an
+// RpcRdmaRequest naming a page slot of its registered region, the node runs
+// the request, RDMA-writes the page into the slot and sends the reply after
+// it. A reliable queue pair executes both in order, so the page has landed
+// by the time the reply completes and the backend does no decoding at all.
+// Everything else stays on Thrift, and a backend whose queue pair fails
+// goes back to Thrift for the rest of its connection.
+//
+// The region has RPC_RDMA_SLOTS slots used as a ring, the way rpc_shm's
+// are: the node serves a backend's requests one at a time, so replies come
+// back in the order the requests went out.
+//
+
+#ifndef SRC_RPC_RDMA_H
+#define SRC_RPC_RDMA_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RPC_RDMA_SLOTS (16)
+
+// GUC of the compute node, 0 keeps every request on Thrift
+extern int rpc_rdma_port;
+
+typedef enum RpcRdmaCommand {
+    RPC_RDMA_READ = 0,
+    RPC_RDMA_NBLOCKS
+} RpcRdmaCommand;
+
+typedef enum RpcRdmaStatus {
+    RPC_RDMA_OK = 0,
+    // The node failed the request, as it would with a TApplicationException
+    RPC_RDMA_FAILED
+} RpcRdmaStatus;
+
+typedef struct RpcRdmaRequest {
+    int32_t command;
+    uint32_t ticket;
+    uint32_t spcNode;
+    uint32_t dbNode;
+    uint32_t relNode;
+    int32_t relPersistence;
+    int32_t forkNum;
+    int32_t blkNum;
+    int32_t readBufferMode;
+    // Of RpcSetRequestClass, which the queue pair doesn't see
+    int32_t requestClass;
+    int64_t lsn;
+    int64_t traceId;
+    // The slot a read's page is written to
+    uint64_t pageAddr;
+    uint32_t pageRkey;
+} RpcRdmaRequest;
+
+typedef struct RpcRdmaReply {
+    uint32_t ticket;
+    int32_t status;
+    int32_t nblocks;
+    // What the trailer of a traced read carries over TCP
+    uint64_t waitParseNs;
+    uint64_t replayNs;
+} RpcRdmaReply;
+
+typedef struct RpcRdmaChannel RpcRdmaChannel;
+
+// Backend side. Connects to the listener on host, NULL if there's none or no
+// RDMA device to reach it with
+extern RpcRdmaChannel *RpcRdmaConnect(const char *host, int port);
+extern void RpcRdmaDisconnect(RpcRdmaChannel *channel);
+// Request of the next ticket, NULL while all slots are in flight
+extern RpcRdmaRequest *RpcRdmaRequestSlot(RpcRdmaChannel *channel);
+// Sends the request filled in, false if the queue pair failed
+extern bool RpcRdmaSubmit(RpcRdmaChannel *channel, uint32_t *ticket);
+// Waits for the reply of ticket, replies have to be taken in order. The reply
+// and page stay the caller's until the slot's next RpcRdmaRequestSlot. NULL
+// if the queue pair failed or the node didn't answer in time; the channel
+// takes no more requests then.
+extern RpcRdmaReply *RpcRdmaTakeReply(RpcRdmaChannel *channel, uint32_t ticket);
+extern const char *RpcRdmaPage(RpcRdmaChannel *channel, uint32_t ticket);
+
+// Storage node side. Runs request, filling reply and the page of a read
+typedef void (*RpcRdmaServeFunc)(void *arg, const RpcRdmaRequest *request, RpcRdmaReply *reply, char *page);
+// Starts the thread accepting backends on port, a thread serves each. False
+// if there's no RDMA device
+extern bool RpcRdmaStartServer(int port, RpcRdmaServeFunc serve, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_RPC_RDMA_H
@@ -0,0 +1,42 @@
+//
+// Relation size history of the storage node
+//
+// The relation size cache only knows the size a relation has now, so an
+// RpcMdNblocks at an older LSN missing it had SyncGetRelSize take a redo
+// process just to compute one. The WAL parser keeps a short log of the
+// sizes a relation took instead, an (LSN, nblocks) change for every record
+// that grew it and for every truncate, and a size at any LSN the log covers
+// is a binary search away.
+//
+// A log starts with the size the relation had after the first record seen
+// extending it, and only tells sizes from there on. A truncate arriving
+// after the parser logged past its LSN throws the log away, as does a
+// relation losing its slot to another; both start over at the next extend.
+// Kept in memory only, a restarted node starts every log over.
+//
+
+#ifndef SRC_RPC_RELSIZE_H
+#define SRC_RPC_RELSIZE_H
+
+#include <stdint.h>
+
+#include "storage/rel_cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The relation is nblocks long as of lsn, after an extend
+extern void RpcRelSizeExtend(RelKey relKey, uint32_t nblocks, uint64_t lsn);
+
+// The relation was truncated to nblocks at lsn
+extern void RpcRelSizeTruncate(RelKey relKey, uint32_t nblocks, uint64_t lsn);
+
+// Returns true and the size the relation had at lsn if the log covers it
+extern bool RpcRelSizeLookup(RelKey relKey, uint64_t lsn, uint32_t *nblocks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_RPC_RELSIZE_H
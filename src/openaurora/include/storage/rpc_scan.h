@@ -0,0 +1,65 @@
+//
+// Scans filtered on the storage node
+//
+// A compute node scanning a relation for the rows of one selective qual,
+// "column op constant" on an integer or oid column, can ask the storage node
+// with ScanRelation for the pages of a range of blocks that hold a tuple the
+// qual may be true for. The node reconstructs each page at the LSN asked for
+// and looks at every tuple on it, dead or alive: visibility is decided on
+// the compute node, which has the commit log, once it has the pages. A page
+// the node leaves out has no tuple the qual is true for, so it can't hold a
+// row of the scan. Anything the node can't read, a tuple with fewer columns
+// than the qual's, counts as a match.
+//
+
+#ifndef SRC_RPC_SCAN_H
+#define SRC_RPC_SCAN_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RPC_SCAN_MAX_ATTS 64
+
+// How the column's bytes compare
+typedef enum RpcScanKind {
+    RPC_SCAN_SIGNED = 0,
+    RPC_SCAN_UNSIGNED
+} RpcScanKind;
+
+typedef struct RpcScanAttr {
+    int16_t attlen;
+    char attalign;
+} RpcScanAttr;
+
+// The qual as sent, column attnum compared to constant by the btree strategy
+typedef struct RpcScanQual {
+    int32_t attnum;
+    int32_t strategy;
+    int32_t kind;
+    int64_t constant;
+    // Columns 1 to attnum, dropped ones too, to find the column in a tuple
+    RpcScanAttr atts[RPC_SCAN_MAX_ATTS];
+} RpcScanQual;
+
+// GUC of the compute node
+extern double rpc_scan_pushdown_selectivity;
+
+// Whether a tuple on page may satisfy qual
+extern bool RpcScanPageMayMatch(const RpcScanQual *qual, const char *page);
+
+// Whether value satisfies qual
+extern bool RpcScanCompare(const RpcScanQual *qual, int64_t value);
+
+// Column attnum of tuple tup, len bytes long, as described by atts. Only
+// whether it's null if value is NULL. False if it can't be read here.
+extern bool RpcScanTupleAttr(const RpcScanAttr *atts, int attnum, int kind, struct HeapTupleHeaderData *tup,
+                             uint32_t len, int64_t *value, bool *isnull);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_RPC_SCAN_H
@@ -0,0 +1,114 @@
+//
+// Shared-memory page reads between a compute node and a storage node on one host.
+//
+// With rpc_shared_memory_reads on, every backend creates an RpcShmSegment,
+// shm_open'd under a name it sends the storage node with
+// RpcAttachSharedMemory and unlinks once the node answered. A node on the
+// same host maps it and serves the ReadBufferCommon requests the backend
+// puts in its slots from a thread of its own, the page going back in the
+// slot the request came in. Everything else still goes over the Thrift
+// connection, whose end also ends the segment: the node stops serving it
+// when the connection closes, and a node on another host answers that it
+// couldn't map it, so the backend keeps reading over TCP.
+//
+// The slots are a ring over two counters. The backend fills the slot of
+// request head and bumps head, the node answers the slot of request tail
+// and bumps tail, both in order. A side with nothing to do spins briefly and
+// then sleeps on a futex, the way wal_redo_channel does, so a read costs no
+// serialization, one copy out of the slot and usually no syscalls.
+//
+
+#ifndef SRC_RPC_SHM_H
+#define SRC_RPC_SHM_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RPC_SHM_MAGIC (0x4f415348)
+#define RPC_SHM_SLOTS (16)
+#define RPC_SHM_NAME_LEN (64)
+
+// GUC of the compute node
+extern bool rpc_shared_memory_reads;
+
+typedef enum RpcShmStatus {
+    RPC_SHM_OK = 0,
+    // The node failed the read, as it would with a TApplicationException
+    RPC_SHM_FAILED
+} RpcShmStatus;
+
+typedef struct RpcShmSlot {
+    uint32_t spcNode;
+    uint32_t dbNode;
+    uint32_t relNode;
+    int32_t relPersistence;
+    int32_t forkNum;
+    int32_t blkNum;
+    int32_t readBufferMode;
+    int32_t status;
+    int64_t lsn;
+    int64_t traceId;
+    // What the trailer of a traced read carries over TCP
+    uint64_t waitParseNs;
+    uint64_t replayNs;
+    char page[BLCKSZ] __attribute__((aligned(64)));
+} RpcShmSlot;
+
+typedef struct RpcShmSegment {
+    uint32_t magic;
+    uint32_t size;
+    pid_t clientPid;
+    pid_t serverPid;
+
+    // Requests ever submitted; only the backend stores it
+    uint32_t head __attribute__((aligned(64)));
+    // Replies the backend has taken, the slots before it are free again
+    uint32_t taken;
+    // Requests ever answered; only the node stores it
+    uint32_t tail __attribute__((aligned(64)));
+
+    // Futex words, bumped after head / tail move
+    uint32_t requestSeq __attribute__((aligned(64)));
+    uint32_t replySeq;
+    uint32_t serverWaiting;
+    uint32_t clientWaiting;
+    // Set by the node when it stops serving the segment
+    uint32_t closed;
+
+    RpcShmSlot slot[RPC_SHM_SLOTS] __attribute__((aligned(64)));
+} RpcShmSegment;
+
+// Backend side. Creates and maps a segment, writing its name into name
+// (RPC_SHM_NAME_LEN bytes); NULL if it couldn't
+extern RpcShmSegment *RpcShmCreate(char *name);
+// Removes the name once the node has answered, the mappings stay
+extern void RpcShmUnlink(const char *name);
+extern void RpcShmDestroy(RpcShmSegment *segment);
+// Slot of the next request, NULL while all of them are in flight
+extern RpcShmSlot *RpcShmRequestSlot(RpcShmSegment *segment);
+// Sends the request filled in, returns its ticket
+extern uint32_t RpcShmSubmit(RpcShmSegment *segment);
+// Waits for the reply of ticket, replies have to be taken in order. The
+// slot stays the caller's until the next RpcShmRequestSlot. NULL if the
+// node stopped serving the segment.
+extern RpcShmSlot *RpcShmTakeReply(RpcShmSegment *segment, uint32_t ticket);
+
+// Storage node side. Maps the segment a backend created, NULL if it isn't one
+extern RpcShmSegment *RpcShmMap(const char *name);
+extern void RpcShmUnmap(RpcShmSegment *segment);
+// Waits for the next request, NULL once the segment is closed or the backend gone
+extern RpcShmSlot *RpcShmNextRequest(RpcShmSegment *segment);
+// Answers the request RpcShmNextRequest returned
+extern void RpcShmReply(RpcShmSegment *segment);
+// Makes RpcShmNextRequest and RpcShmTakeReply return NULL
+extern void RpcShmClose(RpcShmSegment *segment);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_RPC_SHM_H
@@ -0,0 +1,81 @@
+//
+// Vacuum triage on the storage node
+//
+// Most pages the first pass of a lazy vacuum reads need nothing done: no
+// tuple is dead, none needs freezing, and the page can't be marked
+// all-visible yet. TriageVacuum reconstructs the pages of a range of blocks
+// on the storage node and finds those, and those that only hold dead line
+// pointers besides, whose offsets it sends for the index vacuum. The compute
+// node counts their tuples and records their free space without reading
+// them, and reads the others as before.
+//
+// The compute node stays the only writer of WAL, so the pruning, freezing
+// and visibility map changes are all its own; a page that needs any of them
+// is left to it. Without the commit log the node only knows about the
+// transactions of a tuple from its hint bits, a page with a tuple it can't
+// judge by them is left to the compute node too.
+//
+
+#ifndef SRC_RPC_VACUUM_H
+#define SRC_RPC_VACUUM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Blocks triaged per call
+#define RPC_VACUUM_TRIAGE_BLOCKS 256
+
+typedef enum RpcVacuumStatus {
+    // The compute node has to read the page, it isn't listed
+    RPC_VACUUM_READ = 0,
+    // Nothing to do
+    RPC_VACUUM_CLEAN,
+    // Only dead line pointers to collect
+    RPC_VACUUM_DEAD_ONLY
+} RpcVacuumStatus;
+
+// The cutoffs of the vacuum, as sent
+typedef struct RpcVacuumHorizon {
+    uint32_t oldestXmin;
+    uint32_t freezeLimit;
+} RpcVacuumHorizon;
+
+// A page needing no read, its ndead dead offsets follow the entries
+typedef struct RpcVacuumEntry {
+    int32_t blkno;
+    // An RpcVacuumStatus
+    int32_t status;
+    // Tuples that stay, and of those the ones not deleted
+    int32_t ntuples;
+    int32_t nlive;
+    int32_t nunused;
+    int32_t freespace;
+    int32_t hastup;
+    int32_t ndead;
+} RpcVacuumEntry;
+
+// Head of a TriageVacuum reply, the entries and then the dead offsets, as
+// uint16s, of all of them follow
+typedef struct RpcVacuumReply {
+    // Block the node got to
+    int32_t nextBlock;
+    int32_t nentries;
+} RpcVacuumReply;
+
+// GUC of the compute node
+extern bool rpc_vacuum_triage;
+
+// Triage of page against horizon. Unless it's RPC_VACUUM_READ fills entry,
+// but for its blkno, and the page's dead offsets, of which deadOffsets has
+// room for MaxHeapTuplesPerPage.
+extern RpcVacuumStatus RpcVacuumTriagePage(const RpcVacuumHorizon *horizon, const char *page,
+                                           RpcVacuumEntry *entry, uint16_t *deadOffsets);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_RPC_VACUUM_H
@@ -0,0 +1,69 @@
+//
+// Zone maps of the storage node
+//
+// A ScanRelation reading a whole range of RPC_ZONEMAP_RANGE_BLOCKS blocks
+// has reconstructed every page of it anyway, so it keeps the smallest and
+// largest value the qual's column takes there, over all tuples, dead or
+// alive. A later scan with a qual on the same column skips a range whose
+// values the qual can't be true for without reconstructing its pages, as
+// BRIN would, only nobody has to create one: the columns summarized are
+// those scans were pushed down for.
+//
+// A summary is of the pages at the LSN it was read at. It holds for a read
+// at a later LSN as long as no block of the range got a version since,
+// which the logindex tells. A truncated relation loses the summaries of its
+// ranges past the end, and one whose pages are installed all of them. The
+// summaries are kept in memory only, a restarted node reads them again.
+//
+
+#ifndef SRC_RPC_ZONEMAP_H
+#define SRC_RPC_ZONEMAP_H
+
+#include <stdint.h>
+
+#include "storage/relfilenode.h"
+#include "storage/rpc_scan.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RPC_ZONEMAP_RANGE_BLOCKS 128
+
+typedef struct RpcZoneMapSummary {
+    int64_t min;
+    int64_t max;
+    // A tuple had the column not null
+    bool hasValue;
+    // A tuple couldn't be read, the summary is of no use
+    bool unknown;
+    uint64_t lsn;
+} RpcZoneMapSummary;
+
+// GUC
+extern int rpc_zonemap_size;
+
+// An empty summary of a range read at lsn
+extern void RpcZoneMapInitSummary(RpcZoneMapSummary *summary, uint64_t lsn);
+
+// Adds the column of qual of the tuples on page to summary
+extern void RpcZoneMapAddPage(const RpcScanQual *qual, const char *page, RpcZoneMapSummary *summary);
+
+// Whether qual is true for no value summary has
+extern bool RpcZoneMapExcludes(const RpcScanQual *qual, const RpcZoneMapSummary *summary);
+
+// Returns true and fills summary if the range of qual's column is kept
+extern bool RpcZoneMapLookup(RelFileNode rnode, const RpcScanQual *qual, uint32_t range,
+                             RpcZoneMapSummary *summary);
+
+extern void RpcZoneMapStore(RelFileNode rnode, const RpcScanQual *qual, uint32_t range,
+                            const RpcZoneMapSummary *summary);
+
+// Drops the summaries of the ranges holding firstBlock and after
+extern void RpcZoneMapDropRelation(RelFileNode rnode, uint32_t firstBlock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_RPC_ZONEMAP_H
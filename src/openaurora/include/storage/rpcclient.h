@@ -13,23 +13,60 @@ extern "C" {
 #include "storage/relfilenode.h"
 #include "storage/smgr.h"
 #include "storage/bufmgr.h"
+#include "storage/rpc_agg.h"
+#include "storage/rpc_scan.h"
+#include "storage/rpc_vacuum.h"
 
 
 
+    // GUC, checks the checksum of every page the storage node sends
+    extern bool rpc_verify_page_checksums;
+    // GUC, ships the clean pages a primary evicts to the storage node
+    extern bool rpc_install_evicted_pages;
+
     void RpcInit(void);
+    bool RpcWarmUp(void);
     void RpcTransportClose(void);
     void RpcMdRead(char* buff, SMgrRelation reln, ForkNumber forknum, BlockNumber blknum);
     int32_t RpcMdExists(SMgrRelation reln, int32_t forknum);
     int32_t RpcMdNblocks(SMgrRelation reln, int32_t forknum);
     void RpcMdCreate(SMgrRelation reln, int32_t forknum, int32_t isRedo);
     void RpcMdExtend(SMgrRelation reln, int32_t forknum, int32_t blknum, char* buff, int32_t skipFsync);
+    void RpcMdExtendMany(SMgrRelation reln, int32_t forknum, int32_t startblk, int32_t nblocks, int32_t skipFsync);
     void RpcReadBuffer_common(char* buff, SMgrRelation reln, char relpersistence, ForkNumber forkNum,
                           BlockNumber blockNum, ReadBufferMode mode);
+    int RpcReadBufferBatch(char* buffs, SMgrRelation reln, char relpersistence, ForkNumber forkNum,
+                           BlockNumber firstBlock, int nblocks, ReadBufferMode mode, uint64_t lsn);
+    void RpcReadRelationHeads(char* buffs, int* counts, const RelFileNode* rnodes, int nrels, ForkNumber forkNum,
+                              int maxBlocks, uint64_t lsn);
+    int RpcScanRelation(char* buffs, BlockNumber* blocks, BlockNumber* nextBlock, SMgrRelation reln,
+                        BlockNumber firstBlock, BlockNumber endBlock, const RpcScanQual* qual, int maxPages,
+                        uint64_t lsn);
+    int RpcAggregateRelation(RpcAggState* states, BlockNumber* fallback, BlockNumber* nextBlock, SMgrRelation reln,
+                             BlockNumber firstBlock, BlockNumber endBlock, const RpcAggSpec* spec, int maxFallback,
+                             uint64_t lsn);
+    int RpcTriageVacuum(RpcVacuumEntry* entries, uint16_t* dead, BlockNumber* nextBlock, SMgrRelation reln,
+                        BlockNumber firstBlock, BlockNumber endBlock, const RpcVacuumHorizon* horizon, int maxDead,
+                        uint64_t lsn);
+    void RpcPrefetchBuffer(SMgrRelation reln, ForkNumber forkNum, BlockNumber blockNum);
+    // A page written without WAL, for InstallPages, and shipping those pending
+    void RpcInstallPage(SMgrRelation reln, ForkNumber forkNum, BlockNumber blockNum, const char* buffer);
+    void RpcFlushInstalls(void);
+    // A clean page evicted from shared buffers, for InstallEvictedPages
+    void RpcInstallEvictedPage(RelFileNode rnode, ForkNumber forkNum, BlockNumber blockNum, const char* buffer);
+    void RpcReadBufferPipelined(char* buffs, SMgrRelation reln, char relpersistence, ForkNumber forkNum,
+                                const BlockNumber* blocks, int nblocks, ReadBufferMode mode);
     void RpcMdTruncate(SMgrRelation reln, int32_t forknum, int32_t blknum);
 
 
     int32_t RpcRegisterSecondaryNode(bool primary, int64_t lsn);
     void RpcSecondaryNodeUpdatesLsn(int32_t node_id, int64_t lsn);
+    // RpcSecondaryNodeUpdatesLsn, non-zero once the storage node dropped the
+    // node for lagging or going silent, see access/logindex_hashmap.h
+    int32_t RpcSecondaryNodeHeartbeat(int32_t node_id, int64_t lsn);
+    // How far the storage node has parsed the WAL, once it reached lsn or
+    // wait_ms went by, see CheckPointBuffersDisaggregated()
+    int64_t RpcWaitWalParsed(int64_t lsn, int32_t wait_ms);
 
     void RpcShutdown(void);
     void RpcFileClose(const int _fd);
@@ -50,6 +87,7 @@ extern "C" {
     int32_t RpcCloseTransientFile(const int _fd);
     int32_t RpcFileSync(const int _fd, const int32_t _wait_event_info);
     int32_t RpcPgPRead(const int _fd, char *p, const int32_t _amount, const int32_t _offset);
+    void RpcPgPReadRanges(const int _fd, char **bufs, const int32_t _amount, const int32_t *offsets, int num);
     int32_t RpcPgPWrite(const int _fd, char *p, const int32_t _amount, const int32_t _offset);
     int32_t RpcClose(const int _fd);
     int32_t RpcBasicOpenFile(char *path, int32_t _flags);
@@ -61,10 +99,24 @@ extern "C" {
     int32_t RpcDirectoryIsEmpty(const char* path);
     int32_t RpcCopyDir(const char* _src, const char* _dst);
     int32_t RpcPgFsync(const int32_t _fd);
+    // One call for num fsyncs, 0 or one plus the index of the first that failed
+    int32_t RpcSyncFiles(const char **paths, int num);
     int32_t RpcDurableUnlink(const char * filename, const int32_t _flag);
     int32_t RpcDurableRenameExcl(const char* oldFname, const char* newFname, const int32_t _elevel);
+    // GUC, WAL writes kept in flight to the storage node
+    extern int wal_ship_window;
+    // GUC, compression asked of the storage nodes for the pages they send
+    extern int rpc_page_compression;
+    // Waits for the WAL writes in flight, false if one of them failed
+    bool RpcXLogWritesComplete(void);
     int32_t RpcXLogWriteWithPosition(const int _fd, char *p, const int32_t _amount, const int32_t _offset, int startIdx, int blkNum, uint64_t* xlblocks, int xlblocksBufferNum, uint64_t  lsn);
     int RpcXLogFileInit(XLogSegNo logsegno, bool *use_existent, bool use_lock);
+    // Prometheus text of the storage node's replay metrics, palloc'd
+    char *RpcGetSmartReplayMetrics(void);
+    // A reply of the page change feed into buf, see access/page_change_feed.h
+    int RpcFetchPageChanges(char *buf, int maxEntries, int waitMs, uint64_t fromSeq);
+    // Sends a summary of the resident pages, see access/logindex_resident.h
+    int32_t RpcPublishResidentPages(const char *summary, int32_t len);
 #ifdef __cplusplus
 }
 #endif
@@ -28,6 +28,8 @@ extern bool rpcmdexists(SMgrRelation reln, ForkNumber forknum);
 extern void rpcmdunlink(RelFileNodeBackend rnode, ForkNumber forknum, bool isRedo);
 extern void rpcmdextend(SMgrRelation reln, ForkNumber forknum,
 					 BlockNumber blocknum, char *buffer, bool skipFsync);
+extern void rpcmdzeroextend(SMgrRelation reln, ForkNumber forknum,
+					 BlockNumber blocknum, int nblocks, bool skipFsync);
 extern bool rpcmdprefetch(SMgrRelation reln, ForkNumber forknum,
 					   BlockNumber blocknum);
 extern void rpcmdread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum,
@@ -0,0 +1,89 @@
+//
+// Partitioning of pages across storage nodes
+//
+#ifndef SRC_SHARD_MAP_H
+#define SRC_SHARD_MAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "access/xlogdefs.h"
+#include "common/relpath.h"
+#include "storage/block.h"
+#include "storage/relfilenode.h"
+
+//! One storage node indexes and replays every page. With sharding, pages are
+//! spread over a set of storage nodes, the shards, by (spc, db, rel,
+//! segment): the key hashes to one of SHARD_MAP_PARTITIONS partitions and
+//! the partition map names the shard owning each. The map is the text file
+//! SHARD_MAP_FILE in the data directory of every shard:
+//!
+//!     version 7
+//!     shard 0 10.0.0.1:9092
+//!     shard 1 10.0.0.2:9092
+//!     part 0-127 0
+//!     part 128-255 1 from 0 at 0/5A000000
+//!
+//! Partitions not named are shard 0's, the home node. It keeps everything
+//! that isn't a page read, the files, the WAL and relation metadata.
+//!
+//! Every shard receives the whole WAL stream and parses it, like a read
+//! replica, but only indexes the versions of the blocks it owns. A
+//! partition moves online with "from <shard> at <lsn>": records from the
+//! LSN on are indexed by the new owner, earlier ones stay with the old one,
+//! which serves the new owner the base image of a block as of just before
+//! the LSN. The LSN must lie ahead of what the shards have parsed when they
+//! load the map, so each shard reloads it at most a second after it was
+//! written.
+//!
+//! Compute nodes, when RPC_SHARDING is set, read the map off the home node
+//! once a second and send each page read to the shard the partition maps to
+//! at the LSN it reads at. A shard asked for a block it doesn't hold, by a
+//! compute node whose map is older or newer than its own, fetches it from
+//! the owner on its map, once: a forwarded read isn't forwarded again.
+//!
+//! A storage node learns its own shard from STORAGE_SHARD_ID, and ignores
+//! the map without it.
+
+#define SHARD_MAP_FILE "pg_shard_map"
+#define SHARD_MAP_PARTITIONS (256)
+#define SHARD_MAP_MAX_SHARDS (64)
+#define SHARD_MAP_HOME (0)
+
+// Or'ed into the read buffer mode of a read one shard sends another
+#define SHARD_MAP_FORWARDED_READ (1 << 16)
+
+typedef struct ShardRoute {
+    // Shard that serves the block at the LSN
+    int shard;
+    // Shard holding the versions before baseLsn + 1, -1 if shard has them all
+    int baseShard;
+    XLogRecPtr baseLsn;
+} ShardRoute;
+
+// This storage node's shard, -1 when not sharded
+extern int MyStorageShard;
+
+// Whether a map is in force here
+extern bool ShardMapActive(void);
+
+// Routes a read of the block at lsn, false when no map is in force
+extern bool ShardMapRoute(Oid spcNode, Oid dbNode, Oid relNode, BlockNumber blkNum, XLogRecPtr lsn,
+                          ShardRoute *route);
+
+// Whether this storage node indexes the version of the block at lsn
+extern bool ShardMapOwns(Oid spcNode, Oid dbNode, Oid relNode, BlockNumber blkNum, XLogRecPtr lsn);
+
+// Endpoint of a shard of the map in force, false if it has none
+extern bool ShardMapEndpoint(int shard, const char **host, int *port);
+
+// Reads the block at lsn from another shard, in rpcclient.cpp
+extern void RpcShardReadPage(int shard, char *buff, RelFileNode rnode, ForkNumber forkNum, BlockNumber blkNum,
+                             XLogRecPtr lsn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_SHARD_MAP_H
@@ -0,0 +1,58 @@
+/*-------------------------------------------------------------------------
+ *
+ * smart_replay_metrics.h
+ *		Storage node replay metrics in the Prometheus text format
+ *
+ * The adaptive smart replay controller, the wal_redo pool and the logindex
+ * are rendered as one text exposition. It is served over HTTP on
+ * asr_metrics_port for scrapers, and over RPC (RpcGetSmartReplayMetrics)
+ * for the pg_stat_smart_replay view of the compute nodes.
+ *
+ * IDENTIFICATION
+ *		src/include/storage/smart_replay_metrics.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef SMART_REPLAY_METRICS_H
+#define SMART_REPLAY_METRICS_H
+
+#include "postgres.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* GUC: port of the HTTP metrics endpoint, 0 to disable it */
+extern int	asr_metrics_port;
+
+/* How a page read was served */
+typedef enum PageReadPath
+{
+	PAGE_READ_BASE,				/* from the relation files */
+	PAGE_READ_ROCKSDB,			/* a version already materialized */
+	PAGE_READ_REPLAY,			/* replayed by a redo process */
+	PAGE_READ_PATHS
+} PageReadPath;
+
+/* Count a page read served by path, from any thread */
+extern void SmartReplayMetricsCountRead(PageReadPath path);
+
+/* Count a page sent to a connection asking for compression, from any thread */
+extern void SmartReplayMetricsCountPageSent(size_t bytes, bool compressed);
+
+/* Count a request admitted in its class of rpc_lanes.h after waiting waitNs */
+extern void SmartReplayMetricsCountLane(int requestClass, uint64 waitNs);
+/* Count a request of a class of rpc_lanes.h shed instead of queued */
+extern void SmartReplayMetricsCountShed(int requestClass);
+
+/* Render the metrics; the result is malloc'd, the caller frees it */
+extern char *SmartReplayMetricsText(size_t *len);
+
+/* Start the HTTP endpoint thread if asr_metrics_port is set */
+extern void SmartReplayMetricsStartServer(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif							/* SMART_REPLAY_METRICS_H */
@@ -0,0 +1,99 @@
+/*-------------------------------------------------------------------------
+ *
+ * stage_timing.h
+ *		Latency histograms of the stages of a storage node page read
+ *
+ * Every stage a page read may go through is timed into a histogram: the
+ * wait for the parser, the logindex lookup, the RocksDB get, the request
+ * sent to a redo process and the reply read back, the whole redo call and
+ * the materialized page put back.  One in stage_timing_sample_rate
+ * measurements of a thread is taken, the others cost a thread-local counter
+ * only.
+ *
+ * Each thread adds to histograms of its own, 4 buckets per power of two
+ * nanoseconds, so recording takes no lock and no atomic read-modify-write.
+ * A thread's histograms outlive it and are handed to the next thread that
+ * starts timing.  StageTimingCollect() sums them up for the metrics text,
+ * so the breakdown shows in pg_stat_smart_replay.
+ *
+ * A read a compute node sends with a trace ID is a traced request: between
+ * StageTimingTraceBegin() and StageTimingTraceEnd() every stage the thread
+ * goes through is timed, sampled or not, and added up for the reply; the
+ * trace ID goes along to the redo process.
+ *
+ * IDENTIFICATION
+ *		src/include/storage/stage_timing.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef STAGE_TIMING_H
+#define STAGE_TIMING_H
+
+#include "postgres.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum StorageStage
+{
+	STAGE_WAIT_PARSE,
+	STAGE_HASHMAP_LOOKUP,
+	STAGE_ROCKSDB_GET,
+	STAGE_PIPE_SEND,
+	STAGE_PIPE_RECEIVE,
+	STAGE_REDO,
+	STAGE_PUT_BACK,
+	STAGE_NUM
+} StorageStage;
+
+#define STAGE_TIMING_BUCKETS 256
+
+/* Stage times of one traced request */
+typedef struct StageTrace
+{
+	uint64		traceId;
+	uint64		ns[STAGE_NUM];
+} StageTrace;
+
+/*
+ * Appended to the page a traced ReadBufferCommon returns, both in network
+ * byte order; an older storage node returns the bare page.
+ */
+typedef struct StageTraceTrailer
+{
+	uint64		wait_parse_ns;
+	uint64		replay_ns;
+} StageTraceTrailer;
+
+/* GUC: one in how many measurements is taken, 0 to take none */
+extern int	stage_timing_sample_rate;
+
+/* Start of a measurement in nanoseconds, 0 if it isn't sampled */
+extern uint64 StageTimingStart(void);
+
+/* Record the stage as lasting since start, if it was sampled */
+extern void StageTimingEnd(StorageStage stage, uint64 start);
+
+/* Sum of the histograms of all threads */
+extern void StageTimingCollect(uint64 counts[STAGE_NUM][STAGE_TIMING_BUCKETS],
+							   uint64 sum_ns[STAGE_NUM]);
+
+/* Largest value of a bucket, in nanoseconds */
+extern uint64 StageTimingBucketUpper(int bucket);
+
+/* Name of the stage in the metrics */
+extern const char *StageTimingName(StorageStage stage);
+
+/* Time every stage of this thread into trace, until StageTimingTraceEnd() */
+extern void StageTimingTraceBegin(StageTrace *trace, uint64 traceId);
+extern void StageTimingTraceEnd(void);
+
+/* Trace ID of the request this thread serves, 0 if it isn't traced */
+extern uint64 StageTimingTraceId(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif							/* STAGE_TIMING_H */
@@ -0,0 +1,37 @@
+//
+// WAL read cache of compute and replica nodes
+//
+#ifndef SRC_WAL_READ_CACHE_H
+#define SRC_WAL_READ_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "access/xlogdefs.h"
+
+//! Walsenders, logical decoding and a replica catching up read WAL from the
+//! storage node, and read the same segments again and again. Each process
+//! keeps the WAL it read in extents of WAL_READ_CACHE_EXTENT bytes of a
+//! segment, keyed by timeline and segment number, and replaced with CLOCK.
+//!
+//! Only an extent wholly below the flushed LSN is cached, as WAL no longer
+//! changes there; the tail is read through. An extent missed right after
+//! the one before it is fetched together with the next, both ranges sent
+//! to the storage node at once, so a sequential reader keeps one extent
+//! ahead.
+
+// GUC
+extern int wal_read_cache_size;
+
+#define WAL_READ_CACHE_EXTENT (1024 * 1024)
+
+// Reads amount bytes at offset of the segment open as fd on the storage
+// node, through the cache
+extern int WalReadCacheRead(int fd, TimeLineID tli, XLogSegNo segno, char *p, int amount, int offset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //SRC_WAL_READ_CACHE_H
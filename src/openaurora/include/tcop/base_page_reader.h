@@ -0,0 +1,60 @@
+//
+// Base pages read straight from the relation files.
+//
+// A page that has never been versioned is served from the storage node's
+// own relation files. Instead of a round trip to a wal_redo process, which
+// reads it through smgr one block at a time, the rpc server thread reads it
+// itself:
+//
+//   - the segment files stay open in a small fd cache
+//   - a read first tries preadv2(RWF_NOWAIT), which returns at once for
+//     pages in the OS page cache
+//   - the rest of a batch goes to a pool of reader threads, so the disk reads
+//     of a multi-page request are in flight together
+//
+// A page that can't be read this way, a missing file or a block past the
+// end of it, is left to the wal_redo process. Set base_page_direct_read =
+// off to always ask it.
+//
+// With base_page_mmap the cached segments are mapped instead, a read is a
+// copy out of the page cache. The mapping is read ahead (MADV_SEQUENTIAL)
+// while a segment is read in order and not otherwise (MADV_RANDOM), and the
+// pages of a batch are asked for (MADV_WILLNEED) before the first is copied.
+//
+
+#ifndef DB2_PG_BASE_PAGE_READER_H
+#define DB2_PG_BASE_PAGE_READER_H
+
+#include "storage/relfilenode.h"
+#include "storage/block.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// GUC
+extern bool base_page_direct_read;
+extern bool base_page_mmap;
+
+typedef struct BasePageRequest {
+    RelFileNode rnode;
+    ForkNumber  forknum;
+    BlockNumber blkno;
+    char       *page;       // BLCKSZ bytes
+    bool        done;       // set if page was filled
+} BasePageRequest;
+
+// Returns true if page was filled
+extern bool BasePageReaderRead(RelFileNode rnode, ForkNumber forknum, BlockNumber blkno, char *page);
+
+// Reads the pages of all requests in parallel, returns how many are done
+extern int BasePageReaderReadList(BasePageRequest *requests, int num);
+
+// Closes the cached files, called when relation files are unlinked
+extern void BasePageReaderInvalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_BASE_PAGE_READER_H
@@ -26,10 +26,30 @@ extern void
 ApplyOneLsnWithoutBasePage(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blockNumber, XLogRecPtr lsn, char* targetPage);
 extern void
 ApplyLsnList(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blockNumber, XLogRecPtr* lsnList, int listSize, char* origPage, char* targetPage);
+
+// One page of an ApplyLsnListBatch call
+typedef struct ReplayBatchEntry {
+    RelFileNode     rnode;
+    ForkNumber      forkNum;
+    BlockNumber     blkNum;
+    XLogRecPtr     *lsnList;
+    int             listSize;
+    char           *basePage;
+    char           *targetPage;    // allocated by the caller
+} ReplayBatchEntry;
+
+// ApplyLsnList for several pages, each redo process round trip carrying up
+// to REPLAY_BATCH_MAX_PAGES of them
+#define REPLAY_BATCH_MAX_PAGES (16)
+extern void
+ApplyLsnListBatch(ReplayBatchEntry *entries, int num);
 extern void
 ApplyLsnListAndGetUpdatedPage(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blockNumber, XLogRecPtr* lsnList, int listSize,  char* targetPage);
 extern void
 WalRedoExtendRel(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber blockNumber, char * content);
+// Extends the relation by nblocks zero pages from startBlock
+extern void
+WalRedoExtendRelMany(RelFileNode relFileNode, ForkNumber forkNumber, BlockNumber startBlock, int nblocks);
 extern void
 WalRedoCreateRel(RelFileNode relFileNode, ForkNumber forkNumber);
 
@@ -0,0 +1,58 @@
+//
+// Pages the wal_redo processes keep after replaying them.
+//
+// A page replayed again and again, an index root that keeps missing say,
+// used to travel to a redo process in full every time, together with its
+// whole list of records. Now each redo process keeps the last version it
+// replayed of WAL_REDO_CACHE_PAGES pages, one per slot of a direct-mapped
+// table, keyed by (BufferTag, LSN of the last record applied).
+//
+// The rpc server mirrors every process's table: it knows what it asked each
+// one to replay, and both sides pick the slot by the same hash. When the
+// LSN list of a replay holds the LSN a process has the page at, the server
+// sends that process a 'K' request with only the LSNs after it:
+//
+//   ForkNumber, spcNode, dbNode, relNode, BlockNumber, cachedLsn,
+//   listSize, lsnList, and with XLOG_IN_ROCKSDB the listSize records
+//
+// The reply is an int, 1 if the version was still there followed by the
+// replayed page, or 0 and the server sends the full 'O' request instead.
+// Set WAL_REDO_CACHE=off to always send the full request.
+//
+
+#ifndef DB2_PG_WAL_REDO_CACHE_H
+#define DB2_PG_WAL_REDO_CACHE_H
+
+#include "access/xlogdefs.h"
+#include "storage/buf_internals.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WAL_REDO_CACHE_PAGES (512)
+
+// Reads WAL_REDO_CACHE and sizes the server's mirror of the processes'
+// tables. Call before forking them.
+extern void WalRedoCacheInit(int processes);
+extern bool WalRedoCacheEnabled(void);
+
+// In a wal_redo process. The page returned stays valid until the next put
+extern const char *WalRedoCacheGet(const BufferTag *tag, XLogRecPtr lsn);
+extern void WalRedoCachePut(const BufferTag *tag, XLogRecPtr lsn, const char *page);
+
+// In the rpc server, by the thread that acquired proc. Find returns the
+// position in lsnList (ascending) of the version proc holds, or -1
+extern int WalRedoCacheFind(int proc, const BufferTag *tag, const XLogRecPtr *lsnList, int listSize);
+extern void WalRedoCacheNote(int proc, const BufferTag *tag, XLogRecPtr lsn);
+// proc answered a 'K' request, found tells whether it had the version
+extern void WalRedoCacheContinued(int proc, const BufferTag *tag, bool found);
+
+// Replays continued from a cached version, and those that found it gone
+extern void WalRedoCacheGetStats(uint64_t *hits, uint64_t *misses);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_WAL_REDO_CACHE_H
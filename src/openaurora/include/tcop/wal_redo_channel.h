@@ -0,0 +1,65 @@
+//
+// Shared-memory channels between the rpc server and its wal_redo processes.
+//
+// Every wal_redo process owns one WalRedoChannel: a request ring written by
+// the server threads (one at a time, under that process's replay mutex) and
+// a response ring written by the redo process. Both are single-producer /
+// single-consumer byte rings in an anonymous shared mapping created before
+// the fork, carrying the same messages the pipes used to. A side that finds
+// its ring empty (or full) spins briefly and then sleeps on a futex, so a
+// replay costs two memcpys and usually no syscalls.
+//
+
+#ifndef DB2_PG_WAL_REDO_CHANNEL_H
+#define DB2_PG_WAL_REDO_CHANNEL_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WAL_REDO_RING_SIZE (128 * 1024)
+
+typedef struct WalRedoRing {
+    // Bytes ever written; only the producer stores it
+    uint64_t head __attribute__((aligned(64)));
+    // Bytes ever read; only the consumer stores it
+    uint64_t tail __attribute__((aligned(64)));
+
+    // Futex words, bumped after head / tail move
+    uint32_t dataSeq __attribute__((aligned(64)));
+    uint32_t spaceSeq;
+    uint32_t readerWaiting;
+    uint32_t writerWaiting;
+    // Set by the producer when it shuts down, the consumer then sees EOF
+    uint32_t closed;
+
+    char data[WAL_REDO_RING_SIZE] __attribute__((aligned(64)));
+} WalRedoRing;
+
+typedef struct WalRedoChannel {
+    WalRedoRing request;
+    WalRedoRing response;
+    // The rpc server, a redo process treats its exit as EOF
+    pid_t serverPid;
+} WalRedoChannel;
+
+extern WalRedoChannel *walRedoChannels;
+
+// Map num channels shared with the children forked afterwards
+extern WalRedoChannel *WalRedoChannelsCreate(int num);
+extern void WalRedoChannelsClose(WalRedoChannel *channels, int num);
+
+// Copy len bytes into the ring, waiting for space as needed. Returns len.
+extern size_t WalRedoRingWrite(WalRedoRing *ring, const void *buf, size_t len);
+// Fill buf with len bytes. Returns fewer only at EOF (ring closed or the
+// rpc server gone).
+extern size_t WalRedoRingRead(WalRedoChannel *channel, WalRedoRing *ring, void *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_WAL_REDO_CHANNEL_H
@@ -0,0 +1,43 @@
+//
+// In-process replay of simple WAL records.
+//
+// The rpc server keeps the WAL pages the compute nodes push in RpcXLogPages.
+// For a whitelist of records that only touch the page being replayed, the
+// server thread can decode them from there and rebuild the page itself,
+// which costs microseconds instead of a wal_redo round trip:
+//
+//   - XLOG_FPI / XLOG_FPI_FOR_HINT, and any whitelisted record whose block
+//     reference carries an image to apply
+//   - XLOG_HEAP_INSERT (with or without XLOG_HEAP_INIT_PAGE)
+//
+// Anything else stops the fast path: another record type, a WAL page that
+// is no longer cached, a record failing its CRC. The remaining LSNs then go
+// to wal_redo as usual, on top of the page replayed so far. Set
+// WAL_REDO_LOCAL=off to send everything to wal_redo.
+//
+
+#ifndef DB2_PG_WAL_REDO_LOCAL_H
+#define DB2_PG_WAL_REDO_LOCAL_H
+
+#include "access/xlogdefs.h"
+#include "storage/buf_internals.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern void WalRedoLocalInit(void);
+extern bool WalRedoLocalEnabled(void);
+
+// Replay lsnList in order on page (a private copy, modified in place) for as
+// long as the records qualify. Returns how many were replayed.
+extern int WalRedoLocalApplyLsnList(const BufferTag *tag, const XLogRecPtr *lsnList, int listSize, char *page);
+
+// Records replayed in process, and lists handed to wal_redo unfinished
+extern void WalRedoLocalGetStats(uint64_t *applied, uint64_t *fallbacks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_WAL_REDO_LOCAL_H
@@ -0,0 +1,83 @@
+//
+// Elastic pool of wal_redo processes.
+//
+// The rpc server forks WAL_REDO_PROCESS_MAX redo processes at startup but
+// only keeps some of them in service. Threads that need a replay take a
+// process from the pool and give it back; when every process in service is
+// busy the pool brings a parked one into service, up to the current upper
+// limit, and otherwise queues the caller FIFO. Processes idle for longer
+// than WAL_REDO_POOL_SHRINK_IDLE_MS are parked again, down to the lower
+// limit. Parked processes stay forked and just sleep on their channel.
+//
+// With WAL_REDO_AFFINITY=page or relation, a replay prefers the process its
+// page (or relation) hashes to, so consecutive replays of the same page land
+// in the same process and find its buffers warm. When that process is busy
+// the request is served by any idle one rather than waiting for it.
+//
+
+#ifndef DB2_PG_WAL_REDO_POOL_H
+#define DB2_PG_WAL_REDO_POOL_H
+
+#include <stdint.h>
+
+#include "storage/block.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WAL_REDO_POOL_DEFAULT_SIZE (5)
+#define WAL_REDO_POOL_DEFAULT_MAX (16)
+#define WAL_REDO_POOL_SHRINK_IDLE_MS (5000)
+
+// Affinity key of a request that may go to any process
+#define WAL_REDO_NO_AFFINITY (0x80000000u)
+
+typedef enum WalRedoAffinityMode {
+    WAL_REDO_AFFINITY_NONE = 0,
+    WAL_REDO_AFFINITY_PAGE,
+    WAL_REDO_AFFINITY_RELATION
+} WalRedoAffinityMode;
+
+typedef struct WalRedoPoolStats {
+    int forked;     // processes that exist, the hard upper limit
+    int minSize;
+    int maxSize;
+    int size;       // processes in service
+    int busy;
+    int waiting;    // threads queued for a process
+    uint64_t waits; // acquisitions that had to queue, ever
+    uint64_t affinityHits;   // affine acquisitions served by the preferred process
+    uint64_t affinitySteals; // ... and by another one because it was busy
+} WalRedoPoolStats;
+
+// Read WAL_REDO_PROCESS_NUM (lower limit, default 5) and WAL_REDO_PROCESS_MAX
+// (processes to fork, default 16) and WAL_REDO_AFFINITY (none, page or
+// relation, default none). Call before forking.
+extern void WalRedoPoolInit(void);
+extern int WalRedoPoolForkedProcesses(void);
+
+// Returns the index of a redo process the caller owns until it releases it
+extern int WalRedoPoolAcquire(void);
+extern void WalRedoPoolRelease(int proc);
+
+// Key to route a replay of the given page by, WAL_REDO_NO_AFFINITY when
+// affinity routing is off
+extern uint32_t WalRedoPoolAffinityKey(Oid spcNode, Oid dbNode, Oid relNode, int forkNum, BlockNumber blockNum);
+// Like WalRedoPoolAcquire, preferring the process the key maps to
+extern int WalRedoPoolAcquireAffine(uint32_t affinityKey);
+
+// Change the limits at runtime (e.g. from the ASR controller). They are
+// clamped to [1, forked]; processes above a lowered maxSize are parked as
+// soon as they are released.
+extern void WalRedoPoolSetLimits(int minSize, int maxSize);
+extern void WalRedoPoolGetStats(WalRedoPoolStats *stats);
+// Microseconds each forked process has spent acquired, the current busy
+// period included. Fills up to max entries and returns how many.
+extern int WalRedoPoolGetBusyTime(uint64_t *busyUs, int max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //DB2_PG_WAL_REDO_POOL_H
@@ -0,0 +1,81 @@
+/*-------------------------------------------------------------------------
+ *
+ * aggbatch.h
+ *	  Batched transition functions of built-in aggregates
+ *
+ * A batched transition function folds the input values of many rows into a
+ * transition value in one call, leaving it as the aggregate's transition
+ * function would have, called on the rows one after the other.  nodeAgg.c
+ * collects the inputs of an aggregate that has one, and calls it instead of
+ * the transition function through fmgr for every row.
+ *
+ * values and nulls hold the aggregated input of nrows rows; both are NULL
+ * for an aggregate without inputs, such as count(*).  A by-reference
+ * transition value, and state reachable from it, lives in aggcontext.  The
+ * function runs in a short-lived memory context.  Unlike with fmgr, the
+ * strictness of the transition function isn't applied by the caller: the
+ * function skips null inputs, and takes the first non-null input as the
+ * initial transition value, itself.
+ *
+ * Integer sums and counts are computed by loops over the arrays that the
+ * compiler vectorizes, see aggbatch.c.  Floating-point inputs are added in
+ * row order, as reassociating the additions would change the results.
+ * Numeric sums are accumulated into a 128-bit fixed-point integer.
+ *
+ * Portions Copyright (c) 1996-2020, PostgreSQL Global Development Group
+ *
+ * src/include/utils/aggbatch.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef AGGBATCH_H
+#define AGGBATCH_H
+
+typedef void (*AggBatchTransFunc) (Datum *transValue, bool *transValueIsNull,
+								   const Datum *values, const bool *nulls,
+								   int nrows, MemoryContext aggcontext);
+
+/* The batched version of transition function transfn, or NULL */
+extern AggBatchTransFunc AggBatchTransFuncFor(Oid transfn);
+
+/* Loops over a batch in aggbatch.c */
+extern int64 AggBatchCountNotNull(const bool *nulls, int nrows);
+extern int64 AggBatchSumInt32(const Datum *values, const bool *nulls, int nrows);
+#ifdef HAVE_INT128
+extern int128 AggBatchSumInt64(const Datum *values, const bool *nulls, int nrows);
+#endif
+
+/* aggbatch.c */
+extern void int8inc_batch(Datum *transValue, bool *transValueIsNull,
+						  const Datum *values, const bool *nulls,
+						  int nrows, MemoryContext aggcontext);
+extern void int8inc_any_batch(Datum *transValue, bool *transValueIsNull,
+							  const Datum *values, const bool *nulls,
+							  int nrows, MemoryContext aggcontext);
+
+/* numeric.c */
+extern void int4_sum_batch(Datum *transValue, bool *transValueIsNull,
+						   const Datum *values, const bool *nulls,
+						   int nrows, MemoryContext aggcontext);
+extern void int4_avg_accum_batch(Datum *transValue, bool *transValueIsNull,
+								 const Datum *values, const bool *nulls,
+								 int nrows, MemoryContext aggcontext);
+extern void int8_avg_accum_batch(Datum *transValue, bool *transValueIsNull,
+								 const Datum *values, const bool *nulls,
+								 int nrows, MemoryContext aggcontext);
+extern void numeric_avg_accum_batch(Datum *transValue, bool *transValueIsNull,
+									const Datum *values, const bool *nulls,
+									int nrows, MemoryContext aggcontext);
+
+/* float.c */
+extern void float4pl_batch(Datum *transValue, bool *transValueIsNull,
+						   const Datum *values, const bool *nulls,
+						   int nrows, MemoryContext aggcontext);
+extern void float8pl_batch(Datum *transValue, bool *transValueIsNull,
+						   const Datum *values, const bool *nulls,
+						   int nrows, MemoryContext aggcontext);
+extern void float8_accum_batch(Datum *transValue, bool *transValueIsNull,
+							   const Datum *values, const bool *nulls,
+							   int nrows, MemoryContext aggcontext);
+
+#endif							/* AGGBATCH_H */
@@ -21,6 +21,7 @@ typedef struct AttributeOpts
 	int32		vl_len_;		/* varlena header (do not touch directly!) */
 	float8		n_distinct;
 	float8		n_distinct_inherited;
+	int			compression;	/* ToastCompressionId of the column's values */
 } AttributeOpts;
 
 AttributeOpts *get_attribute_options(Oid spcid, int attnum);
@@ -305,6 +305,7 @@ typedef struct StdRdOptions
 	int			parallel_workers;	/* max number of parallel workers */
 	bool		vacuum_index_cleanup;	/* enables index vacuuming and cleanup */
 	bool		vacuum_truncate;	/* enables vacuum to truncate a relation */
+	bool		mempool_cache;	/* offers pages read to the memory pool */
 } StdRdOptions;
 
 #define HEAP_MIN_FILLFACTOR			10
@@ -351,6 +352,18 @@ typedef struct StdRdOptions
 	  (relation)->rd_rel->relkind == RELKIND_MATVIEW) ? \
 	 ((StdRdOptions *) (relation)->rd_options)->user_catalog_table : false)
 
+/*
+ * RelationGetMempoolCache
+ *		Returns whether the relation's pages read from storage may be kept in
+ *		the memory pool.  Note multiple eval of argument!
+ */
+#define RelationGetMempoolCache(relation) \
+	((relation)->rd_options && \
+	 ((relation)->rd_rel->relkind == RELKIND_RELATION || \
+	  (relation)->rd_rel->relkind == RELKIND_MATVIEW || \
+	  (relation)->rd_rel->relkind == RELKIND_TOASTVALUE) ? \
+	 ((StdRdOptions *) (relation)->rd_options)->mempool_cache : true)
+
 /*
  * RelationGetParallelWorkers
  *		Returns the relation's parallel_workers reloption setting.
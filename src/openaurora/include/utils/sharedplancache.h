@@ -0,0 +1,58 @@
+/*-------------------------------------------------------------------------
+ *
+ * sharedplancache.h
+ *	  Generic plans shared across backends.
+ *
+ * See sharedplancache.c for comments.
+ *
+ * Portions Copyright (c) 1996-2020, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ * src/include/utils/sharedplancache.h
+ *
+ *-------------------------------------------------------------------------
+ */
+#ifndef SHAREDPLANCACHE_H
+#define SHAREDPLANCACHE_H
+
+#include "utils/plancache.h"
+
+/* GUC parameter, in kB; 0 disables sharing */
+extern int	shared_plan_cache_size;
+
+/*
+ * The hash key of a shared plan: the database, the role, the statement
+ * (its text, parameter types and cursor options) and the environment its
+ * names and literals were resolved in (search path and a few settings).
+ */
+typedef struct SharedPlanKey
+{
+	Oid			dbid;
+	Oid			roleid;
+	uint64		fingerprint;	/* of the statement */
+	uint64		envhash;		/* of the environment */
+} SharedPlanKey;
+
+/* State kept between a lookup and the store of the plan made on a miss */
+typedef struct SharedPlanLookup
+{
+	bool		shareable;		/* false: don't store the plan */
+	SharedPlanKey key;
+	uint64		generation;		/* invalidation count at the lookup */
+} SharedPlanLookup;
+
+extern Size SharedPlanCacheShmemSize(void);
+extern void SharedPlanCacheShmemInit(void);
+
+extern List *SharedPlanCacheLookup(CachedPlanSource *plansource,
+								   QueryEnvironment *queryEnv,
+								   SharedPlanLookup *lookup);
+extern void SharedPlanCacheStore(SharedPlanLookup *lookup,
+								 CachedPlanSource *plansource,
+								 List *stmt_list);
+
+extern void SharedPlanCacheInvalRel(Oid relid);
+extern void SharedPlanCacheInvalObject(int cacheid, uint32 hashvalue);
+extern void SharedPlanCacheReset(void);
+
+#endif							/* SHAREDPLANCACHE_H */
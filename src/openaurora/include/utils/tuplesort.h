@@ -210,6 +210,10 @@ extern Tuplesortstate *tuplesort_begin_index_btree(Relation heapRel,
 												   bool enforceUnique,
 												   int workMem, SortCoordinate coordinate,
 												   bool randomAccess);
+extern Tuplesortstate *tuplesort_begin_index_gist(Relation heapRel,
+												  Relation indexRel,
+												  int workMem, SortCoordinate coordinate,
+												  bool randomAccess);
 extern Tuplesortstate *tuplesort_begin_index_hash(Relation heapRel,
 												  Relation indexRel,
 												  uint32 high_mask,
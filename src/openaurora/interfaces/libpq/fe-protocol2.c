@@ -512,6 +512,8 @@ pqParseInput2(PGconn *conn)
 					conn->asyncStatus = PGASYNC_READY;
 					break;
 				case 'Z':		/* backend is ready for new query */
+					/* only simple queries are sent over protocol 2.0 */
+					pqCommandQueueAdvance(conn);
 					conn->asyncStatus = PGASYNC_IDLE;
 					break;
 				case 'I':		/* empty query */
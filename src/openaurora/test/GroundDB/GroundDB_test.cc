@@ -5,22 +5,20 @@
 namespace mempool {
     TEST(FreeList_Test, PopFront){
         auto fl = new FreeList();
-        fl->init();
-        uint8_t page1[BLCKSZ], page2[BLCKSZ];
-        KeyType pid1 = {0, 0, 0, 0, 1}, pid2 = {0, 0, 0, 0, 2};
-        PageMeta pm1 = {page1, &pid1}, pm2 = {page2, &pid2}, pm3 = {page1, &pid2}, *tmp;
+        fl->init(3);
+        PageMeta *pm1 = fl->at(0), *pm2 = fl->at(1), *pm3 = fl->at(2), *tmp;
 
-        fl->push_back(&pm1);
-        fl->push_back(&pm2);
+        fl->push_back(pm1);
+        fl->push_back(pm2);
         tmp = fl->pop_front();
-        ASSERT_EQ(tmp, &pm1);
+        ASSERT_EQ(tmp, pm2);
         tmp = fl->pop_front();
-        ASSERT_EQ(tmp, &pm2);
+        ASSERT_EQ(tmp, pm1);
         tmp = fl->pop_front();
         ASSERT_EQ(tmp, nullptr);
-        fl->push_back(&pm3);
+        fl->push_back(pm3);
         tmp = fl->pop_front();
-        ASSERT_EQ(tmp, &pm3);
+        ASSERT_EQ(tmp, pm3);
         tmp = fl->pop_front();
         ASSERT_EQ(tmp, nullptr);
     }
@@ -29,11 +27,10 @@ namespace mempool {
 namespace DSMEngine {
     TEST(LRUCache_Test, LRU_Policy){
         uint8_t page[4000];
-        mempool::PageMeta pm[2000];
         auto fl = new mempool::FreeList();
-        fl->init();
+        fl->init(2000);
         for(int i = 0; i < 2000; i++)
-            fl->push_back(&pm[i]);
+            fl->push_back(fl->at(i));
 
         auto lru = DSMEngine::NewLRUCache(2000, fl);
 
@@ -87,6 +84,43 @@ namespace DSMEngine {
         ASSERT_LE(cache_hit, 400);
     }
 
+    TEST(LRUCache_Test, ClockPro_ScanResistance){
+        auto fl = new mempool::FreeList();
+        fl->init(2000);
+        for(int i = 0; i < 2000; i++)
+            fl->push_back(fl->at(i));
+
+        auto lru = DSMEngine::NewLRUCache(2000, fl, DSMEngine::kClockProCache);
+
+        Cache::Handle* e;
+        int cache_hit;
+        for(int i = 0; i < 1000; i++){
+            e = lru->LookupInsert((KeyType){0, 0, 0, 0, i}, nullptr, 1, nullptr);
+            lru->Release(e);
+        }
+        for(int i = 0; i < 1000; i++){
+            e = lru->Lookup((KeyType){0, 0, 0, 0, i});
+            ASSERT_NE(e, nullptr);
+            lru->Release(e);
+        }
+        // A scan of pages read once
+        for(int i = 1000; i < 20000; i++){
+            e = lru->LookupInsert((KeyType){0, 0, 0, 0, i}, nullptr, 1, nullptr);
+            ASSERT_NE(e->value, nullptr);
+            lru->Release(e);
+        }
+        ASSERT_LE(lru->TotalCharge(), 2000);
+        cache_hit = 0;
+        for(int i = 0; i < 1000; i++){
+            e = lru->Lookup((KeyType){0, 0, 0, 0, i});
+            if(e != nullptr){
+                lru->Release(e);
+                cache_hit++;
+            }
+        }
+        ASSERT_GE(cache_hit, 900);
+    }
+
     TEST(ThreadPool_Test, MultiThreadingAdd) {
         auto thrd_pool = new DSMEngine::ThreadPool();
         thrd_pool->SetBackgroundThreads(5);
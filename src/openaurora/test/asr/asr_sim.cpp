@@ -0,0 +1,738 @@
+//
+// Offline simulator for the Adaptive Smart Replay controller: runs the
+// controller of storage/adaptive_sr.c, as built for the storage node, on a
+// simulated clock against a simulated storage node, and reports what a
+// setting of the asr_* GUCs does to hot misses, CPU and budget stability.
+//
+// Usage: asr_sim [options]
+//   -p profile  load, "secs:walMBps:reads,..." run in turn, reads per second
+//               (60:10:20000,30:60:20000,30:10:80000,30:0:500)
+//   -f trace    take the reads off a request trace instead of -p, see
+//               storage/request_trace.h
+//   -k pages    pages written and read (200000), with -f those of the trace
+//   -z theta    zipfian skew of the pages picked, 0 for uniform (0.9)
+//   -n tenants  databases the pages are spread over (1)
+//   -b bytes    WAL bytes per record (200)
+//   -c us       redo cost of a record (5)
+//   -o us       cost of a call to a redo process (50)
+//   -P MBps     WAL parse rate (100)
+//   -R procs    redo processes forked (16)
+//   -g guc=v    set an asr_* GUC, asr_enable is on unless set, may repeat
+//   -s guc=v,.. sweep a GUC over the values, may repeat for the cartesian
+//               product of them
+//   -j jobs     settings simulated at once (1)
+//   -t file     write a timeline CSV, one line per controller cycle, of
+//               setting N to file.N when there are more
+//
+// Prints one line per setting:
+//   miss%       share of reads that had to replay first
+//   miss_us     mean replay wait of such a read
+//   cpu         cores busy replaying and parsing, on average
+//   max_queue   most page versions unreplayed at once
+//   max_gap_mb  most WAL not parsed yet at once
+//   budget      mean and standard deviation of the replay budget
+//   chg/min     budget changes per minute, and rev/min those that reversed
+//               the direction of the change before
+//
+// The node: WAL comes in at the profile's rate and the parser indexes it at
+// -P, a record at a time onto a zipfian page that then has one more version
+// to replay. The background replayers sweep the pages in order, up to
+// SIM_ROUND_PAGES per round that each replays up to a budget of versions
+// with one call to a redo process, and sleep between rounds; as many run as
+// the controller lets, and no more than the redo processes in service. A
+// read of a page with versions left replays them all first, a call per
+// budget of them. Reads pick zipfian pages as well, the hottest are the
+// ones written most.
+//
+// With a trace, its reads come at their captured time and pages, the WAL
+// follows the LSNs they read at, and the records go to the pages read most.
+//
+// Left out: queueing for a redo process, the time a replay takes on the
+// page as it happens, reads at older LSNs and the cost of the controller
+// itself. Simulated time advances in steps of 1ms.
+//
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "access/background_hashmap_vacuumer.h"
+#include "storage/adaptive_sr.h"
+#include "storage/request_trace.h"
+#include "asr_sim.h"
+
+#define SIM_DB_ID 13580
+#define SIM_STEP_US 1000
+#define SIM_ROUND_PAGES 10
+// A replayer round that finds nothing to replay
+#define SIM_ROUND_US 20
+// What the redo processes use when ASR is off, it never sets the budget
+#define SIM_DEFAULT_BUDGET 100
+
+struct SimLoad {
+    double secs;
+    double walMBps;
+    double readsPerSec;
+};
+
+struct SimRead {
+    uint64_t timeUs;
+    uint32_t page;
+};
+
+struct SimWal {
+    uint64_t timeUs;
+    uint64_t bytes;
+};
+
+struct SimOptions {
+    std::string profile = "60:10:20000,30:60:20000,30:10:80000,30:0:500";
+    const char *trace = NULL;
+    uint32_t pages = 200000;
+    double theta = 0.9;
+    int tenants = 1;
+    int recordBytes = 200;
+    double recordUs = 5;
+    double callUs = 50;
+    double parseMBps = 100;
+    int redoProcesses = 16;
+    std::vector<std::pair<std::string, std::string>> gucs;
+    std::vector<std::pair<std::string, std::vector<std::string>>> sweeps;
+    int jobs = 1;
+    const char *timeline = NULL;
+};
+
+// The load of a run, from the profile or a trace
+struct SimWorkload {
+    std::vector<SimLoad> loads;
+    std::vector<SimRead> reads;
+    std::vector<SimWal> wal;
+    uint64_t durationUs = 0;
+};
+
+struct SimResult {
+    uint64_t reads = 0;
+    uint64_t misses = 0;
+    double missUs = 0;
+    double busyUs = 0;
+    uint64_t maxQueue = 0;
+    uint64_t maxGap = 0;
+    double budgetSum = 0;
+    double budgetSqSum = 0;
+    uint64_t cycles = 0;
+    uint64_t changes = 0;
+    uint64_t reversals = 0;
+    double minutes = 0;
+};
+
+enum GucType {
+    GUC_BOOL,
+    GUC_INT,
+    GUC_REAL,
+    GUC_STRING
+};
+
+struct SimGuc {
+    const char *name;
+    GucType type;
+    void *variable;
+};
+
+static const SimGuc simGucs[] = {
+    {"asr_enable", GUC_BOOL, &asr_enable},
+    {"asr_verbose_metrics", GUC_BOOL, &asr_verbose_metrics},
+    {"asr_queue_target", GUC_REAL, &asr_queue_target},
+    {"asr_parse_gap_target", GUC_REAL, &asr_parse_gap_target},
+    {"asr_miss_rate_target", GUC_REAL, &asr_miss_rate_target},
+    {"asr_wal_rate_target", GUC_REAL, &asr_wal_rate_target},
+    {"asr_min_budget", GUC_INT, &asr_min_budget},
+    {"asr_max_budget", GUC_INT, &asr_max_budget},
+    {"asr_queue_weight", GUC_REAL, &asr_queue_weight},
+    {"asr_miss_weight", GUC_REAL, &asr_miss_weight},
+    {"asr_wal_weight", GUC_REAL, &asr_wal_weight},
+    {"asr_hysteresis", GUC_INT, &asr_hysteresis},
+    {"asr_max_step", GUC_REAL, &asr_max_step},
+    {"asr_kp", GUC_REAL, &asr_kp},
+    {"asr_ki", GUC_REAL, &asr_ki},
+    {"asr_smoothing_ms", GUC_INT, &asr_smoothing_ms},
+    {"asr_controller_interval", GUC_INT, &asr_controller_interval},
+    {"asr_min_replayers", GUC_INT, &asr_min_replayers},
+    {"asr_max_replayers", GUC_INT, &asr_max_replayers},
+    {"asr_min_replayer_sleep_us", GUC_INT, &asr_min_replayer_sleep_us},
+    {"asr_max_replayer_sleep_us", GUC_INT, &asr_max_replayer_sleep_us},
+    {"asr_min_redo_processes", GUC_INT, &asr_min_redo_processes},
+    {"asr_max_redo_processes", GUC_INT, &asr_max_redo_processes},
+    {"asr_tenant_per_relation", GUC_BOOL, &asr_tenant_per_relation},
+    {"asr_tenant_weights", GUC_STRING, &asr_tenant_weights},
+    {"asr_tenant_demand_share", GUC_REAL, &asr_tenant_demand_share},
+};
+
+static bool SetGuc(const std::string &name, const std::string &value) {
+    for(const SimGuc &guc : simGucs) {
+        if(name != guc.name)
+            continue;
+        switch(guc.type) {
+            case GUC_BOOL:
+                if(value == "on" || value == "true" || value == "1")
+                    *(bool *) guc.variable = true;
+                else if(value == "off" || value == "false" || value == "0")
+                    *(bool *) guc.variable = false;
+                else
+                    return false;
+                return true;
+            case GUC_INT:
+                *(int *) guc.variable = atoi(value.c_str());
+                return true;
+            case GUC_REAL:
+                *(double *) guc.variable = atof(value.c_str());
+                return true;
+            case GUC_STRING:
+                *(char **) guc.variable = strdup(value.c_str());
+                return true;
+        }
+    }
+    return false;
+}
+
+static bool SplitSetting(const char *arg, std::string &name, std::string &value) {
+    const char *eq = strchr(arg, '=');
+
+    if(eq == NULL || eq == arg)
+        return false;
+    name.assign(arg, eq - arg);
+    value.assign(eq + 1);
+    return true;
+}
+
+static std::vector<std::string> SplitList(const std::string &list, char sep) {
+    std::vector<std::string> items;
+    size_t start = 0;
+
+    while(start <= list.size()) {
+        size_t end = list.find(sep, start);
+        if(end == std::string::npos)
+            end = list.size();
+        if(end > start)
+            items.push_back(list.substr(start, end - start));
+        start = end + 1;
+    }
+    return items;
+}
+
+// Zipfian ranks, rank 0 the hottest
+class RankPicker {
+public:
+    RankPicker(uint32_t n, double theta) {
+        double sum = 0;
+
+        cdf.resize(n);
+        for(uint32_t i = 0; i < n; i++) {
+            sum += theta > 0 ? 1 / pow((double) i + 1, theta) : 1;
+            cdf[i] = sum;
+        }
+        for(double &c : cdf)
+            c /= sum;
+    }
+
+    uint32_t Pick(std::mt19937_64 &rng) const {
+        double u = std::uniform_real_distribution<double>(0, 1)(rng);
+        size_t rank = std::upper_bound(cdf.begin(), cdf.end(), u) - cdf.begin();
+
+        return (uint32_t) std::min(rank, cdf.size() - 1);
+    }
+
+private:
+    std::vector<double> cdf;
+};
+
+static bool ParseProfile(const std::string &profile, SimWorkload &workload) {
+    for(const std::string &item : SplitList(profile, ',')) {
+        SimLoad load;
+
+        if(sscanf(item.c_str(), "%lf:%lf:%lf", &load.secs, &load.walMBps, &load.readsPerSec) != 3 ||
+           load.secs <= 0 || load.walMBps < 0 || load.readsPerSec < 0)
+            return false;
+        workload.loads.push_back(load);
+        workload.durationUs += (uint64_t) (load.secs * 1e6);
+    }
+    return !workload.loads.empty();
+}
+
+// The reads of a trace, the pages numbered by how often they are read, and
+// the WAL as the LSNs read at advance
+static bool LoadTrace(const char *path, SimOptions &options, SimWorkload &workload) {
+    FILE *file = fopen(path, "rb");
+    RequestTraceHeader header;
+    RequestTraceRecord record;
+    RequestTraceRecord first;
+    std::unordered_map<std::string, uint32_t> pageIds;
+    std::vector<uint64_t> readCounts;
+    std::vector<std::pair<uint64_t, uint64_t>> lsns;
+    bool inList = false;
+
+    if(file == NULL) {
+        fprintf(stderr, "could not read %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    if(fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, REQUEST_TRACE_MAGIC, 8) != 0) {
+        fprintf(stderr, "%s is not a request trace\n", path);
+        fclose(file);
+        return false;
+    }
+    memset(&first, 0, sizeof(first));
+    while(fread(&record, sizeof(record), 1, file) == 1) {
+        bool read;
+
+        if(record.type == REQUEST_TRACE_CONTINUED) {
+            // A block of the list started by first
+            read = inList;
+            record.spcNode = first.spcNode;
+            record.dbNode = first.dbNode;
+            record.relNode = first.relNode;
+            record.forkNum = first.forkNum;
+            record.offsetNs = first.offsetNs;
+            record.lsn = first.lsn;
+        } else {
+            read = record.type == REQUEST_TRACE_READ || record.type == REQUEST_TRACE_READ_BATCH ||
+                   record.type == REQUEST_TRACE_READ_IF_MODIFIED || record.type == REQUEST_TRACE_PREFETCH;
+            inList = read;
+            first = record;
+        }
+        if(!read)
+            continue;
+
+        char key[64];
+        snprintf(key, sizeof(key), "%u/%u/%u/%u/%u", record.spcNode, record.dbNode, record.relNode,
+                 (unsigned) record.forkNum, record.blkNum);
+        auto it = pageIds.find(key);
+        if(it == pageIds.end()) {
+            it = pageIds.emplace(key, (uint32_t) pageIds.size()).first;
+            readCounts.push_back(0);
+        }
+        readCounts[it->second]++;
+
+        SimRead simRead;
+        simRead.timeUs = record.offsetNs / 1000;
+        simRead.page = it->second;
+        workload.reads.push_back(simRead);
+        lsns.emplace_back(simRead.timeUs, record.lsn);
+    }
+    fclose(file);
+    if(workload.reads.empty()) {
+        fprintf(stderr, "%s has no reads\n", path);
+        return false;
+    }
+
+    // Number the pages by rank, for the records to hit the hot ones most
+    std::vector<uint32_t> byCount(readCounts.size());
+    std::vector<uint32_t> rank(readCounts.size());
+    for(uint32_t i = 0; i < byCount.size(); i++)
+        byCount[i] = i;
+    std::stable_sort(byCount.begin(), byCount.end(),
+                     [&](uint32_t a, uint32_t b) { return readCounts[a] > readCounts[b]; });
+    for(uint32_t i = 0; i < byCount.size(); i++)
+        rank[byCount[i]] = i;
+
+    std::stable_sort(workload.reads.begin(), workload.reads.end(),
+                     [](const SimRead &a, const SimRead &b) { return a.timeUs < b.timeUs; });
+    for(SimRead &simRead : workload.reads)
+        simRead.page = rank[simRead.page];
+
+    std::stable_sort(lsns.begin(), lsns.end());
+    uint64_t lastLsn = 0;
+    for(const auto &lsn : lsns) {
+        if(lsn.second <= lastLsn)
+            continue;
+        if(lastLsn != 0) {
+            SimWal wal;
+            wal.timeUs = lsn.first;
+            wal.bytes = lsn.second - lastLsn;
+            workload.wal.push_back(wal);
+        }
+        lastLsn = lsn.second;
+    }
+
+    options.pages = (uint32_t) byCount.size();
+    workload.durationUs = workload.reads.back().timeUs + SIM_STEP_US;
+    return true;
+}
+
+static Oid PageDb(const SimOptions &options, uint32_t page) {
+    return (Oid) (SIM_DB_ID + page % options.tenants);
+}
+
+// Cost of replaying versions versions of a page, budget at a time
+static double ReplayUs(const SimOptions &options, uint64_t versions, int budget) {
+    uint64_t calls = (versions + budget - 1) / budget;
+
+    return calls * options.callUs + versions * options.recordUs;
+}
+
+static int CurrentBudget(void) {
+    return ASR_Enabled() ? Max(ASR_GetCurrentBudget(), 1) : SIM_DEFAULT_BUDGET;
+}
+
+static SimResult Simulate(const SimOptions &options, const SimWorkload &workload, FILE *timeline) {
+    SimResult result;
+    RankPicker picker(options.pages, options.theta);
+    std::mt19937_64 rng(20201);
+    std::vector<uint32_t> versions(options.pages, 0);
+    std::set<uint32_t> dirty;
+    std::vector<uint64_t> replayerFreeUs(BACKGROUND_REPLAYER_MAX_THREADS, 0);
+    uint32_t sweepCursor = 0;
+    uint64_t flushed = 0;
+    uint64_t parsed = 0;
+    double parseCredit = 0;
+    double readCredit = 0;
+    double walCredit = 0;
+    size_t nextRead = 0;
+    size_t nextWal = 0;
+    size_t load = 0;
+    uint64_t loadEndUs = workload.loads.empty() ? 0 : (uint64_t) (workload.loads[0].secs * 1e6);
+    uint64_t cycleUs = (uint64_t) Max(asr_controller_interval, 1) * 1000;
+    uint64_t nextCycleUs = cycleUs;
+    int lastBudget = CurrentBudget();
+    int lastDirection = 0;
+
+    AsrSimNodeInit(options.redoProcesses);
+    ASR_Init();
+    AsrSimNodeSetLsns(1, 1);
+    if(timeline != NULL)
+        fprintf(timeline, "ms,budget,aggressiveness,queue,parse_gap,miss_rate,wal_bps,replayers,sleep_us,redo_max\n");
+
+    for(uint64_t nowUs = 0; nowUs < workload.durationUs; nowUs += SIM_STEP_US) {
+        uint64_t stepEndUs = nowUs + SIM_STEP_US;
+        uint64_t arrived = 0;
+        int budget = CurrentBudget();
+
+        // WAL in
+        if(workload.loads.empty()) {
+            while(nextWal < workload.wal.size() && workload.wal[nextWal].timeUs < stepEndUs)
+                arrived += workload.wal[nextWal++].bytes;
+        } else {
+            while(nowUs >= loadEndUs && load + 1 < workload.loads.size())
+                loadEndUs += (uint64_t) (workload.loads[++load].secs * 1e6);
+            walCredit += workload.loads[load].walMBps * 1024 * 1024 * SIM_STEP_US / 1e6;
+            arrived = (uint64_t) walCredit;
+            walCredit -= arrived;
+        }
+        if(arrived > 0) {
+            ASR_RecordWalIngest(arrived);
+            flushed += arrived;
+        }
+
+        // Parsed into the logindex, a version per record
+        parseCredit = std::min(parseCredit + options.parseMBps * 1024 * 1024 * SIM_STEP_US / 1e6,
+                               (double) (flushed - parsed));
+        while(parseCredit >= options.recordBytes) {
+            uint32_t page = picker.Pick(rng);
+
+            parseCredit -= options.recordBytes;
+            parsed += options.recordBytes;
+            result.busyUs += options.recordBytes / options.parseMBps / 1.048576;
+            if(versions[page]++ == 0)
+                dirty.insert(page);
+            asrSimNode.unreplayed++;
+            ASR_RecordTenantWal(PageDb(options, page), InvalidOid, options.recordBytes);
+        }
+        AsrSimNodeSetLsns(flushed + 1, parsed + 1);
+        result.maxGap = std::max(result.maxGap, flushed - parsed);
+
+        // Background replay
+        int replayers = std::min(asrSimNode.replayerThreads, asrSimNode.poolMax);
+        for(int thread = 0; thread < replayers; thread++) {
+            while(replayerFreeUs[thread] < stepEndUs) {
+                double roundUs = SIM_ROUND_US;
+
+                for(int i = 0; i < SIM_ROUND_PAGES && !dirty.empty(); i++) {
+                    auto it = dirty.lower_bound(sweepCursor);
+                    if(it == dirty.end())
+                        it = dirty.begin();
+                    uint32_t page = *it;
+                    Oid db = PageDb(options, page);
+
+                    sweepCursor = page + 1;
+                    if(!ASR_TenantMayReplay(db, InvalidOid))
+                        continue;
+                    uint32_t replayed = std::min(versions[page], (uint32_t) budget);
+                    roundUs += ReplayUs(options, replayed, budget);
+                    versions[page] -= replayed;
+                    asrSimNode.unreplayed -= replayed;
+                    if(versions[page] == 0)
+                        dirty.erase(page);
+                    ASR_RecordTenantReplay(db, InvalidOid, (int) replayed);
+                    ASR_RecordReplayTask((int) replayed);
+                }
+                result.busyUs += roundUs;
+                replayerFreeUs[thread] = std::max(replayerFreeUs[thread], nowUs) + (uint64_t) roundUs +
+                                         asrSimNode.replayerSleepUs;
+            }
+        }
+        // Parked replayers start over when they come back
+        for(int thread = replayers; thread < BACKGROUND_REPLAYER_MAX_THREADS; thread++)
+            replayerFreeUs[thread] = stepEndUs;
+
+        // Reads, replaying on demand what they find left
+        uint64_t reads = 0;
+        if(workload.loads.empty()) {
+            while(nextRead < workload.reads.size() && workload.reads[nextRead].timeUs < stepEndUs) {
+                nextRead++;
+                reads++;
+            }
+        } else {
+            readCredit += workload.loads[load].readsPerSec * SIM_STEP_US / 1e6;
+            reads = (uint64_t) readCredit;
+            readCredit -= reads;
+        }
+        for(uint64_t i = 0; i < reads; i++) {
+            uint32_t page = workload.loads.empty() ? workload.reads[nextRead - reads + i].page : picker.Pick(rng);
+            Oid db = PageDb(options, page);
+
+            ASR_RecordRead(db, InvalidOid);
+            result.reads++;
+            if(versions[page] == 0)
+                continue;
+
+            double waitUs = ReplayUs(options, versions[page], budget);
+            ASR_RecordHotMiss(db, InvalidOid);
+            ASR_RecordReplayTask((int) versions[page]);
+            result.misses++;
+            result.missUs += waitUs;
+            result.busyUs += waitUs;
+            asrSimNode.unreplayed -= versions[page];
+            versions[page] = 0;
+            dirty.erase(page);
+        }
+        result.maxQueue = std::max(result.maxQueue, asrSimNode.unreplayed);
+
+        // Controller
+        if(stepEndUs < nextCycleUs)
+            continue;
+        struct timespec tick;
+        tick.tv_sec = (time_t) (stepEndUs / 1000000) + 1;
+        tick.tv_nsec = (long) (stepEndUs % 1000000) * 1000;
+        ASR_Tick(&tick);
+        nextCycleUs += cycleUs;
+
+        budget = CurrentBudget();
+        result.cycles++;
+        result.budgetSum += budget;
+        result.budgetSqSum += (double) budget * budget;
+        if(budget != lastBudget) {
+            int direction = budget > lastBudget ? 1 : -1;
+
+            result.changes++;
+            if(lastDirection != 0 && direction != lastDirection)
+                result.reversals++;
+            lastDirection = direction;
+            lastBudget = budget;
+        }
+        if(timeline != NULL) {
+            ASRMetrics metrics = ASR_ReadMetrics();
+
+            fprintf(timeline, "%lu,%d,%.3f,%.1f,%.0f,%.4f,%.0f,%d,%d,%d\n", (unsigned long) (stepEndUs / 1000),
+                    budget, metrics.aggressiveness, metrics.replay_queue_length, metrics.parse_gap_bytes,
+                    metrics.hot_miss_rate, metrics.wal_ingest_bps, asrSimNode.replayerThreads,
+                    asrSimNode.replayerSleepUs, asrSimNode.poolMax);
+        }
+    }
+    result.minutes = workload.durationUs / 60e6;
+    return result;
+}
+
+static std::string FormatResult(const std::string &setting, const SimResult &result) {
+    double mean = result.cycles > 0 ? result.budgetSum / result.cycles : 0;
+    double variance = result.cycles > 0 ? result.budgetSqSum / result.cycles - mean * mean : 0;
+    char line[512];
+
+    snprintf(line, sizeof(line), "%-40s %7.3f %9.0f %6.2f %10lu %10.1f %7.0f %7.0f %8.1f %8.1f\n",
+             setting.empty() ? "-" : setting.c_str(),
+             result.reads > 0 ? 100.0 * result.misses / result.reads : 0,
+             result.misses > 0 ? result.missUs / result.misses : 0,
+             result.minutes > 0 ? result.busyUs / (result.minutes * 60e6) : 0,
+             (unsigned long) result.maxQueue, result.maxGap / (1024.0 * 1024.0), mean,
+             sqrt(std::max(variance, 0.0)), result.minutes > 0 ? result.changes / result.minutes : 0,
+             result.minutes > 0 ? result.reversals / result.minutes : 0);
+    return line;
+}
+
+// The index-th setting of the sweep, applied to the GUCs
+static std::string ApplySetting(const SimOptions &options, size_t index) {
+    std::string setting;
+
+    for(const auto &sweep : options.sweeps) {
+        const std::string &value = sweep.second[index % sweep.second.size()];
+
+        index /= sweep.second.size();
+        SetGuc(sweep.first, value);
+        if(!setting.empty())
+            setting += " ";
+        setting += sweep.first + "=" + value;
+    }
+    return setting;
+}
+
+// Runs the index-th setting, the controller's statics fresh in a child of its own
+static pid_t StartSetting(const SimOptions &options, const SimWorkload &workload, size_t index, size_t settings,
+                          int *fd) {
+    int pipeFds[2];
+    pid_t pid;
+
+    if(pipe(pipeFds) != 0) {
+        fprintf(stderr, "pipe: %s\n", strerror(errno));
+        exit(1);
+    }
+    fflush(stdout);
+    pid = fork();
+    if(pid < 0) {
+        fprintf(stderr, "fork: %s\n", strerror(errno));
+        exit(1);
+    }
+    if(pid > 0) {
+        close(pipeFds[1]);
+        *fd = pipeFds[0];
+        return pid;
+    }
+
+    close(pipeFds[0]);
+    std::string setting = ApplySetting(options, index);
+    FILE *timeline = NULL;
+    if(options.timeline != NULL) {
+        std::string path = options.timeline;
+        if(settings > 1)
+            path += "." + std::to_string(index);
+        timeline = fopen(path.c_str(), "w");
+        if(timeline == NULL)
+            fprintf(stderr, "could not write %s: %s\n", path.c_str(), strerror(errno));
+    }
+    std::string line = FormatResult(setting, Simulate(options, workload, timeline));
+    if(timeline != NULL)
+        fclose(timeline);
+    if(write(pipeFds[1], line.data(), line.size()) != (ssize_t) line.size())
+        _exit(1);
+    _exit(0);
+}
+
+static void Usage(const char *progname) {
+    fprintf(stderr, "usage: %s [-p profile | -f trace] [-k pages] [-z theta] [-n tenants] [-b bytes] "
+                    "[-c us] [-o us] [-P MBps] [-R procs] [-g guc=value] [-s guc=value,...] [-j jobs] "
+                    "[-t file]\n", progname);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    SimOptions options;
+    SimWorkload workload;
+    std::string name;
+    std::string value;
+    int opt;
+
+    while((opt = getopt(argc, argv, "p:f:k:z:n:b:c:o:P:R:g:s:j:t:")) != -1) {
+        switch(opt) {
+            case 'p': options.profile = optarg; break;
+            case 'f': options.trace = optarg; break;
+            case 'k': options.pages = (uint32_t) atol(optarg); break;
+            case 'z': options.theta = atof(optarg); break;
+            case 'n': options.tenants = atoi(optarg); break;
+            case 'b': options.recordBytes = atoi(optarg); break;
+            case 'c': options.recordUs = atof(optarg); break;
+            case 'o': options.callUs = atof(optarg); break;
+            case 'P': options.parseMBps = atof(optarg); break;
+            case 'R': options.redoProcesses = atoi(optarg); break;
+            case 'g':
+                if(!SplitSetting(optarg, name, value))
+                    Usage(argv[0]);
+                options.gucs.emplace_back(name, value);
+                break;
+            case 's':
+                if(!SplitSetting(optarg, name, value) || SplitList(value, ',').empty())
+                    Usage(argv[0]);
+                options.sweeps.emplace_back(name, SplitList(value, ','));
+                break;
+            case 'j': options.jobs = atoi(optarg); break;
+            case 't': options.timeline = optarg; break;
+            default: Usage(argv[0]);
+        }
+    }
+    if(options.pages == 0 || options.theta < 0 || options.tenants <= 0 || options.recordBytes <= 0 ||
+       options.recordUs < 0 || options.callUs < 0 || options.parseMBps <= 0 || options.redoProcesses <= 0 ||
+       options.jobs <= 0)
+        Usage(argv[0]);
+
+    // On unless set otherwise, comparing against off takes -s asr_enable=on,off
+    asr_enable = true;
+    for(const auto &guc : options.gucs) {
+        if(!SetGuc(guc.first, guc.second)) {
+            fprintf(stderr, "unknown GUC or bad value %s=%s\n", guc.first.c_str(), guc.second.c_str());
+            return 1;
+        }
+    }
+    size_t settings = 1;
+    for(const auto &sweep : options.sweeps) {
+        for(const std::string &v : sweep.second) {
+            bool saved = asr_enable;
+            if(!SetGuc(sweep.first, v)) {
+                fprintf(stderr, "unknown GUC or bad value %s=%s\n", sweep.first.c_str(), v.c_str());
+                return 1;
+            }
+            asr_enable = saved;
+        }
+        settings *= sweep.second.size();
+    }
+
+    if(options.trace != NULL ? !LoadTrace(options.trace, options, workload)
+                             : !ParseProfile(options.profile, workload)) {
+        if(options.trace == NULL)
+            fprintf(stderr, "bad profile %s\n", options.profile.c_str());
+        return 1;
+    }
+    printf("pages = %u, theta = %.2f, %.0f s simulated, %lu settings\n", options.pages, options.theta,
+           workload.durationUs / 1e6, (unsigned long) settings);
+    printf("%-40s %7s %9s %6s %10s %10s %7s %7s %8s %8s\n", "setting", "miss%", "miss_us", "cpu", "max_queue",
+           "max_gap_mb", "budget", "stddev", "chg/min", "rev/min");
+    fflush(stdout);
+
+    std::vector<std::string> lines(settings);
+    std::map<pid_t, std::pair<size_t, int>> running;
+    size_t next = 0;
+    int failed = 0;
+
+    while(next < settings || !running.empty()) {
+        while(next < settings && (int) running.size() < options.jobs) {
+            int fd;
+            pid_t pid = StartSetting(options, workload, next, settings, &fd);
+            running[pid] = std::make_pair(next++, fd);
+        }
+
+        int status;
+        pid_t pid = wait(&status);
+        auto it = running.find(pid);
+        if(it == running.end())
+            continue;
+
+        char buf[512];
+        ssize_t n = read(it->second.second, buf, sizeof(buf));
+        close(it->second.second);
+        if(n > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+            lines[it->second.first].assign(buf, n);
+        } else {
+            lines[it->second.first] = ApplySetting(options, it->second.first) + " failed\n";
+            failed = 1;
+        }
+        running.erase(it);
+    }
+    for(const std::string &line : lines)
+        fputs(line.c_str(), stdout);
+    return failed;
+}
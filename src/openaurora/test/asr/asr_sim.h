@@ -0,0 +1,39 @@
+//
+// The storage node the ASR simulator runs adaptive_sr.c against: what the
+// controller reads and the actuators it drives, see asr_sim_stubs.c.
+//
+#ifndef ASR_SIM_H
+#define ASR_SIM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct AsrSimNode {
+    // Page versions not replayed yet, HashMapUnreplayedEntries
+    uint64_t unreplayed;
+    // BackgroundReplayerSetLimits, clamped as the replayers clamp it
+    int replayerThreads;
+    int replayerSleepUs;
+    // The redo process pool, forked processes and WalRedoPoolSetLimits
+    int poolForked;
+    int poolMin;
+    int poolMax;
+} AsrSimNode;
+
+extern AsrSimNode asrSimNode;
+
+// Set up the node with poolForked redo processes and the replayers at their
+// defaults
+extern void AsrSimNodeInit(int poolForked);
+
+// The WAL flushed to the node and parsed into the logindex so far
+extern void AsrSimNodeSetLsns(uint64_t flushedLsn, uint64_t parsedLsn);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //ASR_SIM_H
@@ -0,0 +1,101 @@
+//
+// What adaptive_sr.c needs of a storage node, played by the simulator: the
+// logindex backlog, the flushed and parsed LSNs, the background replayers
+// and the redo process pool, see asr_sim.h. Warnings and errors of the
+// controller go to stderr, its log messages are dropped.
+//
+#include "postgres.h"
+
+#include <stdarg.h>
+#include <string.h>
+
+#include "access/background_hashmap_vacuumer.h"
+#include "access/logindex_hashmap.h"
+#include "access/logindex_slab.h"
+#include "access/xlogdefs.h"
+#include "postmaster/interrupt.h"
+#include "tcop/wal_redo_pool.h"
+#include "utils/guc.h"
+#include "asr_sim.h"
+
+AsrSimNode asrSimNode;
+
+static struct HashMapStruct simHashMap;
+HashMap pageVersionHashMap = &simHashMap;
+XLogRecPtr XLogParseUpto = InvalidXLogRecPtr;
+uint64_t RpcXLogFlushedLsn = 0;
+volatile sig_atomic_t ConfigReloadPending = false;
+
+static int simElevel = 0;
+
+void AsrSimNodeInit(int poolForked) {
+    memset(&asrSimNode, 0, sizeof(asrSimNode));
+    asrSimNode.replayerThreads = BACKGROUND_REPLAYER_DEFAULT_THREADS;
+    asrSimNode.replayerSleepUs = BACKGROUND_REPLAYER_DEFAULT_SLEEP_US;
+    asrSimNode.poolForked = poolForked;
+    asrSimNode.poolMin = Min(poolForked, 5);
+    asrSimNode.poolMax = poolForked;
+}
+
+void AsrSimNodeSetLsns(uint64_t flushedLsn, uint64_t parsedLsn) {
+    RpcXLogFlushedLsn = flushedLsn;
+    XLogParseUpto = parsedLsn;
+}
+
+uint64_t HashMapUnreplayedEntries(HashMap hashMap) {
+    return asrSimNode.unreplayed;
+}
+
+uint64_t HashMapResidentBytes(void) {
+    return 0;
+}
+
+void LogindexSlabGetStats(LogindexSlabStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+}
+
+void BackgroundReplayerSetLimits(int activeThreads, int sleepUs) {
+    asrSimNode.replayerThreads = Min(Max(activeThreads, 1), BACKGROUND_REPLAYER_MAX_THREADS);
+    asrSimNode.replayerSleepUs = Min(Max(sleepUs, 0), 1000000);
+}
+
+void BackgroundReplayerGetLimits(int *activeThreads, int *sleepUs) {
+    *activeThreads = asrSimNode.replayerThreads;
+    *sleepUs = asrSimNode.replayerSleepUs;
+}
+
+void WalRedoPoolGetStats(WalRedoPoolStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->forked = asrSimNode.poolForked;
+    stats->minSize = asrSimNode.poolMin;
+    stats->maxSize = asrSimNode.poolMax;
+    stats->size = asrSimNode.poolMax;
+}
+
+void WalRedoPoolSetLimits(int minSize, int maxSize) {
+    asrSimNode.poolMax = Min(Max(maxSize, 1), asrSimNode.poolForked);
+    asrSimNode.poolMin = Min(Max(minSize, 1), asrSimNode.poolMax);
+}
+
+void ProcessConfigFile(GucContext context) {
+}
+
+bool errstart(int elevel, const char *domain) {
+    simElevel = elevel;
+    return elevel >= WARNING;
+}
+
+int errmsg(const char *fmt, ...) {
+    va_list args;
+
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    return 0;
+}
+
+void errfinish(const char *filename, int lineno, const char *funcname) {
+    fputc('\n', stderr);
+    if (simElevel >= ERROR)
+        abort();
+}
@@ -0,0 +1,178 @@
+//
+// What the logindex and relation size cache microbenchmarks share: zipfian
+// keys, running a phase on a number of threads, and the results file a CI
+// run compares against a baseline.
+//
+// A results file has one "phase ops/s" line per phase. With -b, every
+// phase found in the baseline must reach (100 - tolerance)% of its ops/s
+// there, or the benchmark exits with 2.
+//
+#ifndef LOGINDEX_BENCH_COMMON_H
+#define LOGINDEX_BENCH_COMMON_H
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+// Zipfian ranks as in YCSB, scrambled so the hot keys aren't adjacent
+class KeyPicker {
+public:
+    KeyPicker(uint32_t n, double theta) : n(n), theta(theta) {
+        if(theta <= 0)
+            return;
+        for(uint32_t i = 1; i <= n; i++)
+            zetan += 1 / std::pow((double) i, theta);
+        double zeta2 = 1 + 1 / std::pow(2.0, theta);
+        alpha = 1 / (1 - theta);
+        eta = (1 - std::pow(2.0 / n, 1 - theta)) / (1 - zeta2 / zetan);
+    }
+
+    uint32_t Pick(std::mt19937_64 &rng) const {
+        if(theta <= 0)
+            return (uint32_t) (rng() % n);
+
+        double u = std::uniform_real_distribution<double>(0, 1)(rng);
+        double uz = u * zetan;
+        uint64_t rank;
+        if(uz < 1)
+            rank = 0;
+        else if(uz < 1 + std::pow(0.5, theta))
+            rank = 1;
+        else
+            rank = (uint64_t) (n * std::pow(eta * u - eta + 1, alpha));
+        rank = std::min(rank, (uint64_t) n - 1);
+        return (uint32_t) ((rank * 0x9E3779B97F4A7C15ull) % n);
+    }
+
+private:
+    uint32_t n;
+    double theta;
+    double zetan = 0;
+    double alpha = 0;
+    double eta = 0;
+};
+
+struct PhaseResult {
+    std::string name;
+    uint64_t ops;
+    double seconds;
+
+    double OpsPerSec() const {
+        return seconds > 0 ? ops / seconds : 0;
+    }
+};
+
+// Runs body(thread id) on threads threads at once, each returning the
+// operations it did, and times them from the common start to the last end
+static PhaseResult RunPhase(const std::string &name, int threads, const std::function<uint64_t(int)> &body) {
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<uint64_t> ops(threads, 0);
+    std::vector<std::thread> workers;
+
+    for(int i = 0; i < threads; i++) {
+        workers.emplace_back([&, i]() {
+            ready.fetch_add(1);
+            while(!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            ops[i] = body(i);
+        });
+    }
+    while(ready.load() < threads)
+        std::this_thread::yield();
+
+    Clock::time_point start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for(std::thread &worker : workers)
+        worker.join();
+
+    PhaseResult result;
+    result.name = name;
+    result.ops = 0;
+    for(uint64_t n : ops)
+        result.ops += n;
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+static void PrintResult(const PhaseResult &result, int threads) {
+    printf("%-16s %2d threads %12.0f ops/s %10.1f ns/op\n", result.name.c_str(), threads, result.OpsPerSec(),
+           result.ops > 0 ? result.seconds * 1e9 * threads / result.ops : 0);
+    fflush(stdout);
+}
+
+static bool WriteResults(const char *path, const std::vector<PhaseResult> &results) {
+    FILE *file = fopen(path, "w");
+
+    if(file == NULL) {
+        fprintf(stderr, "could not write %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    for(const PhaseResult &result : results)
+        fprintf(file, "%s %.0f\n", result.name.c_str(), result.OpsPerSec());
+    fclose(file);
+    return true;
+}
+
+// Returns 0 if every phase kept up with the baseline, 1 if it can't be
+// read, 2 if a phase regressed
+static int CheckBaseline(const char *path, int tolerance, const std::vector<PhaseResult> &results) {
+    FILE *file = fopen(path, "r");
+    std::map<std::string, double> baseline;
+    char name[128];
+    double opsPerSec;
+    int regressed = 0;
+
+    if(file == NULL) {
+        fprintf(stderr, "could not read %s: %s\n", path, strerror(errno));
+        return 1;
+    }
+    while(fscanf(file, "%127s %lf", name, &opsPerSec) == 2)
+        baseline[name] = opsPerSec;
+    fclose(file);
+
+    for(const PhaseResult &result : results) {
+        auto it = baseline.find(result.name);
+        if(it == baseline.end())
+            continue;
+        double floor = it->second * (100 - tolerance) / 100;
+        if(result.OpsPerSec() < floor) {
+            fprintf(stderr, "%s regressed: %.0f ops/s, baseline %.0f ops/s, floor %.0f ops/s\n",
+                    result.name.c_str(), result.OpsPerSec(), it->second, floor);
+            regressed = 2;
+        }
+    }
+    return regressed;
+}
+
+// Splits a comma separated list of phases
+static std::vector<std::string> SplitPhases(const std::string &list) {
+    std::vector<std::string> phases;
+    size_t start = 0;
+
+    while(start <= list.size()) {
+        size_t end = list.find(',', start);
+        if(end == std::string::npos)
+            end = list.size();
+        if(end > start)
+            phases.push_back(list.substr(start, end - start));
+        start = end + 1;
+    }
+    return phases;
+}
+
+#endif //LOGINDEX_BENCH_COMMON_H
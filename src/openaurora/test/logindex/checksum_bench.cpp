@@ -0,0 +1,197 @@
+//
+// Microbenchmark for the page checksum kernels of storage/checksum_impl.h,
+// and for what rpc_verify_page_checksums adds to every page a compute node
+// receives from the storage node.
+//
+// Usage: checksum_bench [options]
+//   -t threads  threads (1)
+//   -k pages    distinct pages each thread goes over (1024)
+//   -n ops      pages per thread of every phase (2000000)
+//   -w phases   comma separated, run in order
+//               (scalar,avx2,avx512,copy,copy-verify)
+//   -o file     write the results, one "phase ops/s" line each
+//   -b file     compare against results written before, see bench_common.h
+//   -T percent  slowdown tolerated by -b (20)
+//
+// Phases:
+//   scalar       pg_checksum_block, as the compiler vectorizes it
+//   avx2         the AVX2 kernel
+//   avx512       the AVX-512 kernel
+//   copy         a page copied out of the reply, as RpcPageCopy does for
+//                an uncompressed one
+//   copy-verify  the copy and pg_checksum_page compared with pd_checksum,
+//                with the kernel picked by CPUID, as rpc_verify_page_checksums
+//                has RpcReadBuffer_common do
+//
+// A kernel the CPU lacks is skipped. Before the phases every kernel is
+// checked to give the scalar checksum on every page. The default pages
+// fit in L2 or L3; a larger -k shows throughput out of memory, closer to
+// pages just written by the network card.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include "postgres_fe.h"
+#include "storage/checksum_impl.h"
+}
+#include "bench_common.h"
+
+struct BenchOptions {
+    int threads = 1;
+    uint32_t pages = 1024;
+    uint64_t ops = 2000000;
+    std::string phases = "scalar,avx2,avx512,copy,copy-verify";
+    const char *output = NULL;
+    const char *baseline = NULL;
+    int tolerance = 20;
+};
+
+typedef uint32 (*ChecksumKernel)(const PGChecksummablePage *page);
+
+// Pages of random bytes under a valid header, with their checksums stamped
+static char *MakePages(uint32_t pages, uint64_t seed) {
+    char *pool = (char *) aligned_alloc(64, (size_t) pages * BLCKSZ);
+    std::mt19937_64 rng(seed);
+
+    for(uint32_t i = 0; i < pages; i++) {
+        char *page = pool + (size_t) i * BLCKSZ;
+        PageHeader header = (PageHeader) page;
+
+        for(size_t at = 0; at < BLCKSZ; at += sizeof(uint64_t)) {
+            uint64_t bits = rng();
+            memcpy(page + at, &bits, sizeof(bits));
+        }
+        header->pd_upper = BLCKSZ / 2;
+        header->pd_lower = SizeOfPageHeaderData;
+        header->pd_checksum = pg_checksum_page(page, i);
+    }
+    return pool;
+}
+
+#ifdef USE_CHECKSUM_SIMD
+static ChecksumKernel KernelOf(const std::string &phase, int width) {
+    if(phase == "scalar")
+        return pg_checksum_block;
+    if(phase == "avx2")
+        return width >= 256 ? pg_checksum_block_avx2 : NULL;
+    return width >= 512 ? pg_checksum_block_avx512 : NULL;
+}
+#else
+static ChecksumKernel KernelOf(const std::string &phase, int width) {
+    return phase == "scalar" ? pg_checksum_block : NULL;
+}
+#endif
+
+static void Usage(const char *progname) {
+    fprintf(stderr, "usage: %s [-t threads] [-k pages] [-n ops] [-w phases] [-o file] [-b file] [-T percent]\n",
+            progname);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions options;
+    std::vector<PhaseResult> results;
+    int width = 0;
+    int opt;
+
+    while((opt = getopt(argc, argv, "t:k:n:w:o:b:T:")) != -1) {
+        switch(opt) {
+            case 't': options.threads = atoi(optarg); break;
+            case 'k': options.pages = (uint32_t) atol(optarg); break;
+            case 'n': options.ops = strtoull(optarg, NULL, 10); break;
+            case 'w': options.phases = optarg; break;
+            case 'o': options.output = optarg; break;
+            case 'b': options.baseline = optarg; break;
+            case 'T': options.tolerance = atoi(optarg); break;
+            default: Usage(argv[0]);
+        }
+    }
+    if(options.threads <= 0 || options.pages == 0 || options.tolerance < 0 || options.tolerance > 100)
+        Usage(argv[0]);
+
+#ifdef USE_CHECKSUM_SIMD
+    width = pg_checksum_simd_width();
+#endif
+    std::vector<char *> pools(options.threads);
+    for(int i = 0; i < options.threads; i++)
+        pools[i] = MakePages(options.pages, 20201 + i);
+
+    for(const char *phase : {"avx2", "avx512"}) {
+        ChecksumKernel kernel = KernelOf(phase, width);
+
+        for(uint32_t i = 0; kernel != NULL && i < options.pages; i++) {
+            const PGChecksummablePage *page = (const PGChecksummablePage *) (pools[0] + (size_t) i * BLCKSZ);
+
+            if(kernel(page) != pg_checksum_block(page)) {
+                fprintf(stderr, "the %s kernel disagrees with the scalar one on page %u\n", phase, i);
+                return 1;
+            }
+        }
+    }
+    printf("threads = %d, pages = %u, ops = %lu per thread, widest kernel = %d bits\n",
+           options.threads, options.pages, (unsigned long) options.ops, width);
+
+    for(const std::string &phase : SplitPhases(options.phases)) {
+        bool copy = phase == "copy" || phase == "copy-verify";
+        bool verify = phase == "copy-verify";
+        ChecksumKernel kernel = NULL;
+        std::atomic<uint64_t> failed{0};
+
+        if(!copy && phase != "scalar" && phase != "avx2" && phase != "avx512") {
+            fprintf(stderr, "unknown phase %s\n", phase.c_str());
+            return 1;
+        }
+        if(!copy && (kernel = KernelOf(phase, width)) == NULL) {
+            printf("%-16s skipped, not supported by this CPU\n", phase.c_str());
+            continue;
+        }
+
+        PhaseResult result = RunPhase(phase, options.threads, [&](int thread) -> uint64_t {
+            char *pool = pools[thread];
+            char *buff = (char *) aligned_alloc(64, BLCKSZ);
+            uint32 sink = 0;
+
+            for(uint64_t i = 0; i < options.ops; i++) {
+                uint32_t blkno = (uint32_t) (i % options.pages);
+                char *page = pool + (size_t) blkno * BLCKSZ;
+
+                if(!copy) {
+                    sink ^= kernel((const PGChecksummablePage *) page);
+                    continue;
+                }
+                memcpy(buff, page, BLCKSZ);
+                if(verify && ((PageHeader) buff)->pd_checksum != pg_checksum_page(buff, blkno))
+                    failed.fetch_add(1);
+                sink ^= (uint32) buff[i % BLCKSZ];
+            }
+            free(buff);
+            // Not to have the loop optimized away
+            if(sink == 0x5B1F36E9)
+                failed.fetch_add(0);
+            return options.ops;
+        });
+
+        if(failed.load() > 0) {
+            fprintf(stderr, "%lu pages failed their checksum\n", (unsigned long) failed.load());
+            return 1;
+        }
+        PrintResult(result, options.threads);
+        printf("%-16s %2d threads %12.2f GB/s\n", phase.c_str(), options.threads,
+               result.OpsPerSec() * BLCKSZ / 1e9);
+        results.push_back(result);
+    }
+
+    for(char *pool : pools)
+        free(pool);
+    if(options.output != NULL && !WriteResults(options.output, results))
+        return 1;
+    if(options.baseline != NULL)
+        return CheckBaseline(options.baseline, options.tolerance, results);
+    return 0;
+}
@@ -0,0 +1,245 @@
+//
+// Microbenchmark for the storage node's page version hashmap,
+// see access/logindex_hashmap.h.
+//
+// Usage: hashmap_bench [options]
+//   -t threads  threads (4)
+//   -k pages    pages per thread (32768)
+//   -c chain    versions inserted per page before the lookups (32)
+//   -n ops      operations per thread of the lookup and mix phases (1000000)
+//   -z theta    zipfian skew of the pages picked, 0 for uniform (0.99)
+//   -r percent  share of lookups in the mix phase, the rest inserts (90)
+//   -w phases   comma separated, run in order (insert,lookup,mix,gc)
+//   -o file     write the results, one "phase ops/s" line each
+//   -b file     compare against results written before, see bench_common.h
+//   -T percent  slowdown tolerated by -b (20)
+//
+// Every thread has a relation of its own, so the versions of a page come
+// in LSN order as they do from the WAL parser. Lookups pick any thread's
+// relation.
+//
+// Phases:
+//   insert   HashMapInsertKey, -c rounds over the thread's pages, each
+//            version at a higher LSN; the later phases need it run first
+//   lookup   HashMapGetBlockReplayList at a version of the chain picked at
+//            random, nothing is materialized so the list goes back to the
+//            page's first version
+//   mix      lookups and inserts of new versions on top of the chains
+//   gc       HashMapGarbageCollectKey of every page, after marking the
+//            version halfway up its chain materialized and the top replayed
+//
+// The KV engine and the database clones are stubbed out below, so the
+// versions live in the hashmap only and nothing gets spilled.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "c.h"
+#include "access/logindex_hashmap.h"
+#include "storage/db_clone.h"
+#include "storage/kv_interface.h"
+#include "bench_common.h"
+
+#define BENCH_SPC_ID 1663
+#define BENCH_DB_ID 13580
+#define BENCH_REL_ID 16384
+// Bytes between two versions, a small WAL record
+#define BENCH_LSN_STEP 64
+
+struct BenchOptions {
+    int threads = 4;
+    uint32_t pages = 32768;
+    int chain = 32;
+    uint64_t ops = 1000000;
+    double theta = 0.99;
+    int readPercent = 90;
+    std::string phases = "insert,lookup,mix,gc";
+    const char *output = NULL;
+    const char *baseline = NULL;
+    int tolerance = 20;
+};
+
+extern "C" {
+
+void DeletePageFromRocksdb(BufferTag bufferTag, uint64_t lsn) {
+}
+
+void KvSetPageGcHorizon(uint64_t lsn) {
+}
+
+bool KvPageGcInCompaction(void) {
+    return false;
+}
+
+uint64_t KvGetPageGcHorizon(void) {
+    return 0;
+}
+
+int PutLsnChain2Rocksdb(BufferTag bufferTag, uint64_t *chain, int chainLen) {
+    return -1;
+}
+
+int GetLsnChainFromRocksdb(BufferTag bufferTag, uint64_t **chain, int *chainLen) {
+    return -1;
+}
+
+void DeleteLsnChainFromRocksdb(BufferTag bufferTag) {
+}
+
+XLogRecPtr DbCloneOldestForkLsn(Oid spcNode, Oid dbNode) {
+    return InvalidXLogRecPtr;
+}
+
+}
+
+static KeyType PageKey(int thread, uint32_t blk) {
+    KeyType key;
+
+    key.SpcID = BENCH_SPC_ID;
+    key.DbID = BENCH_DB_ID;
+    key.RelID = BENCH_REL_ID + thread;
+    key.ForkNum = 0;
+    key.BlkNum = blk;
+    return key;
+}
+
+// LSN of the version-th version of blk inserted by the insert phase
+static uint64_t VersionLsn(const BenchOptions &options, int version, uint32_t blk) {
+    return (1 + (uint64_t) version * options.pages + blk) * BENCH_LSN_STEP;
+}
+
+// One read of a page at targetLsn, up to getting its replay list
+static void Lookup(HashMap hashMap, const BenchOptions &options, const KeyPicker &picker, std::mt19937_64 &rng) {
+    int thread = (int) (rng() % options.threads);
+    uint32_t blk = picker.Pick(rng);
+    uint64_t targetLsn = VersionLsn(options, (int) (rng() % options.chain), blk);
+    uint64_t replayedLsn = 0;
+    uint64_t *toReplayList = NULL;
+    int listLen = 0;
+
+    KeyType key = PageKey(thread, blk);
+
+    // A list comes back with the head locked and its last version taken for
+    // materialized, give both back as a read that doesn't materialize does
+    HashMapGetBlockReplayList(hashMap, key, targetLsn, &replayedLsn, &toReplayList, &listLen);
+    if(listLen > 0) {
+        HashMapUpdateMaterializedStatus(hashMap, key, toReplayList[listLen - 1], true, false);
+        free(toReplayList);
+    }
+}
+
+static void Usage(const char *progname) {
+    fprintf(stderr, "usage: %s [-t threads] [-k pages] [-c chain] [-n ops] [-z theta] [-r percent] "
+                    "[-w phases] [-o file] [-b file] [-T percent]\n", progname);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions options;
+    std::vector<PhaseResult> results;
+    HashMap hashMap;
+    int opt;
+
+    while((opt = getopt(argc, argv, "t:k:c:n:z:r:w:o:b:T:")) != -1) {
+        switch(opt) {
+            case 't': options.threads = atoi(optarg); break;
+            case 'k': options.pages = (uint32_t) atol(optarg); break;
+            case 'c': options.chain = atoi(optarg); break;
+            case 'n': options.ops = strtoull(optarg, NULL, 10); break;
+            case 'z': options.theta = atof(optarg); break;
+            case 'r': options.readPercent = atoi(optarg); break;
+            case 'w': options.phases = optarg; break;
+            case 'o': options.output = optarg; break;
+            case 'b': options.baseline = optarg; break;
+            case 'T': options.tolerance = atoi(optarg); break;
+            default: Usage(argv[0]);
+        }
+    }
+    if(options.threads <= 0 || options.pages == 0 || options.chain <= 0 || options.theta >= 1 ||
+       options.readPercent < 0 || options.readPercent > 100 || options.tolerance < 0 || options.tolerance > 100)
+        Usage(argv[0]);
+
+    HashMapInit(&hashMap, 1024);
+    KeyPicker picker(options.pages, options.theta);
+    printf("threads = %d, pages = %u per thread, chain = %d, ops = %lu per thread, theta = %.2f\n",
+           options.threads, options.pages, options.chain, (unsigned long) options.ops, options.theta);
+
+    bool inserted = false;
+    for(const std::string &phase : SplitPhases(options.phases)) {
+        PhaseResult result;
+
+        if(phase != "insert" && !inserted) {
+            fprintf(stderr, "phase %s needs the insert phase before it\n", phase.c_str());
+            return 1;
+        }
+        if(phase == "insert") {
+            result = RunPhase(phase, options.threads, [&](int thread) -> uint64_t {
+                for(int version = 0; version < options.chain; version++)
+                    for(uint32_t blk = 0; blk < options.pages; blk++)
+                        HashMapInsertKey(hashMap, PageKey(thread, blk), VersionLsn(options, version, blk), 0,
+                                         true, version == 0);
+                return (uint64_t) options.chain * options.pages;
+            });
+            inserted = true;
+        } else if(phase == "lookup") {
+            result = RunPhase(phase, options.threads, [&](int thread) -> uint64_t {
+                std::mt19937_64 rng(20201 + thread);
+
+                for(uint64_t i = 0; i < options.ops; i++)
+                    Lookup(hashMap, options, picker, rng);
+                return options.ops;
+            });
+        } else if(phase == "mix") {
+            // New versions go above the whole insert phase, in LSN order per thread
+            uint64_t firstLsn = VersionLsn(options, options.chain, 0);
+
+            result = RunPhase(phase, options.threads, [&](int thread) -> uint64_t {
+                std::mt19937_64 rng(30301 + thread);
+                uint64_t lsn = firstLsn;
+
+                for(uint64_t i = 0; i < options.ops; i++) {
+                    if((int) (rng() % 100) < options.readPercent) {
+                        Lookup(hashMap, options, picker, rng);
+                    } else {
+                        HashMapInsertKey(hashMap, PageKey(thread, picker.Pick(rng)), lsn, 0, true, false);
+                        lsn += BENCH_LSN_STEP;
+                    }
+                }
+                return options.ops;
+            });
+        } else if(phase == "gc") {
+            int materialized = options.chain / 2;
+            uint64_t topLsn = VersionLsn(options, options.chain - 1, options.pages - 1);
+
+            RunPhase("gc-setup", options.threads, [&](int thread) -> uint64_t {
+                for(uint32_t blk = 0; blk < options.pages; blk++) {
+                    KeyType key = PageKey(thread, blk);
+                    HashMapUpdateMaterializedStatus(hashMap, key, VersionLsn(options, materialized, blk), false, true);
+                    HashMapUpdateReplayedLsn(hashMap, key, topLsn, false);
+                }
+                return options.pages;
+            });
+            result = RunPhase(phase, options.threads, [&](int thread) -> uint64_t {
+                for(uint32_t blk = 0; blk < options.pages; blk++)
+                    HashMapGarbageCollectKey(hashMap, PageKey(thread, blk));
+                return options.pages;
+            });
+        } else {
+            fprintf(stderr, "unknown phase %s\n", phase.c_str());
+            return 1;
+        }
+        PrintResult(result, options.threads);
+        results.push_back(result);
+    }
+
+    HashMapDestroy(hashMap);
+    if(options.output != NULL && !WriteResults(options.output, results))
+        return 1;
+    if(options.baseline != NULL)
+        return CheckBaseline(options.baseline, options.tolerance, results);
+    return 0;
+}
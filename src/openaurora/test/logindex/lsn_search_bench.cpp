@@ -0,0 +1,99 @@
+//
+// Microbenchmark for the element node lsn lower-bound kernels,
+// see access/logindex_lsn_search.h.
+//
+// Usage: lsn_search_bench [array length] [iterations]
+//
+// Every kernel is first checked against the binary search on random
+// inputs, then timed on the same set of (array, target) pairs.
+//
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "access/logindex_lsn_search.h"
+
+typedef int (*SearchKernel)(const uint32_t *deltas, int n, uint32_t target);
+
+struct BenchCase {
+    std::vector<uint32_t> deltas;
+    std::vector<uint32_t> targets;
+};
+
+static BenchCase MakeCase(int length, int targetNum, std::mt19937 &rng) {
+    BenchCase c;
+    c.deltas.resize(length);
+    uint32_t delta = 0;
+    for(int i = 0; i < length; i++) {
+        // Typical WAL record spacing for one page: tens to thousands of bytes
+        c.deltas[i] = delta;
+        delta += 24 + rng() % 4096;
+    }
+    c.targets.resize(targetNum);
+    for(int i = 0; i < targetNum; i++)
+        c.targets[i] = rng() % (delta + 1);
+    return c;
+}
+
+static double TimeKernel(SearchKernel kernel, const BenchCase &c, long iterations, long *checksum) {
+    const uint32_t *deltas = c.deltas.data();
+    int n = (int) c.deltas.size();
+    size_t targetNum = c.targets.size();
+    long sum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for(long i = 0; i < iterations; i++)
+        sum += kernel(deltas, n, c.targets[i % targetNum]);
+    auto end = std::chrono::steady_clock::now();
+
+    *checksum = sum;
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(int argc, char **argv) {
+    int length = argc > 1 ? atoi(argv[1]) : 30;
+    long iterations = argc > 2 ? atol(argv[2]) : 20000000L;
+    std::mt19937 rng(20201);
+
+    if(length <= 0 || iterations <= 0) {
+        fprintf(stderr, "usage: %s [array length] [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    // Correctness: every kernel must agree with the binary search, including
+    // targets below the first and above the last delta.
+    for(int n = 0; n <= 70; n++) {
+        BenchCase c = MakeCase(n, 256, rng);
+        c.targets.push_back(0);
+        c.targets.push_back(UINT32_MAX);
+        for(uint32_t target : c.targets) {
+            int expected = LsnDeltaFindLowerBoundBinary(c.deltas.data(), n, target);
+            int scalar = LsnDeltaFindLowerBoundScalar(c.deltas.data(), n, target);
+            int vector = LsnDeltaFindLowerBoundVector(c.deltas.data(), n, target);
+            if(scalar != expected || vector != expected) {
+                fprintf(stderr, "mismatch: n = %d, target = %u, binary = %d, scalar = %d, vector = %d\n",
+                        n, target, expected, scalar, vector);
+                return 1;
+            }
+        }
+    }
+
+    BenchCase c = MakeCase(length, 4096, rng);
+    long binarySum, scalarSum, vectorSum;
+    double binaryNs = TimeKernel(LsnDeltaFindLowerBoundBinary, c, iterations, &binarySum);
+    double scalarNs = TimeKernel(LsnDeltaFindLowerBoundScalar, c, iterations, &scalarSum);
+    double vectorNs = TimeKernel(LsnDeltaFindLowerBoundVector, c, iterations, &vectorSum);
+
+    if(binarySum != scalarSum || binarySum != vectorSum) {
+        fprintf(stderr, "checksum mismatch: %ld %ld %ld\n", binarySum, scalarSum, vectorSum);
+        return 1;
+    }
+
+    printf("length = %d, iterations = %ld, vector kernel = %s\n", length, iterations, LsnDeltaSearchKernelName());
+    printf("binary  %8.2f ns/search\n", binaryNs);
+    printf("scalar  %8.2f ns/search  (%.2fx)\n", scalarNs, binaryNs / scalarNs);
+    printf("vector  %8.2f ns/search  (%.2fx)\n", vectorNs, binaryNs / vectorNs);
+    return 0;
+}
@@ -0,0 +1,257 @@
+//
+// Microbenchmark for the relation size cache tables, the lock-free table
+// in shared memory (storage/builtin_shmht.h) against the boost interprocess
+// hashmap it replaced (storage/boost_shmht.h).
+//
+// Usage: rel_cache_bench [options]
+//   -t threads  threads (4)
+//   -k rels     relations in the cache, shared by the threads (4096)
+//   -n ops      operations per thread of every phase (1000000)
+//   -z theta    zipfian skew of the relations picked, 0 for uniform (0.99)
+//   -r percent  share of lookups in the mix phases, the rest extends (95)
+//   -w phases   comma separated, run in order
+//               (builtin-insert,builtin-lookup,builtin-mix,
+//                boost-insert,boost-lookup,boost-mix)
+//   -o file     write the results, one "phase ops/s" line each
+//   -b file     compare against results written before, see bench_common.h
+//   -T percent  slowdown tolerated by -b (20)
+//
+// Every operation hashes its key the way rel_cache.c does, the builtin
+// table a RelTag and the boost one the "rel_cache_..." string. The boost
+// hashmap isn't safe for concurrent writers, so its phases take a rwlock
+// around every call, and its inserts log every key, so stdout is sent to
+// /dev/null while they run. It lives in the shared memory segment
+// "MySharedMemory", which a compute node on the same host uses as well, so
+// don't run the boost phases next to one.
+//
+// Shared memory and elog are stubbed out below for the builtin table.
+//
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include "storage/builtin_shmht.h"
+#include "storage/boost_shmht.h"
+#include "storage/shmem.h"
+#include "bench_common.h"
+
+#define BENCH_SPC_ID 1663
+#define BENCH_DB_ID 13580
+#define BENCH_REL_ID 16384
+#define BENCH_KEY_LEN 128
+
+struct BenchOptions {
+    int threads = 4;
+    uint32_t rels = 4096;
+    uint64_t ops = 1000000;
+    double theta = 0.99;
+    int readPercent = 95;
+    std::string phases = "builtin-insert,builtin-lookup,builtin-mix,boost-insert,boost-lookup,boost-mix";
+    const char *output = NULL;
+    const char *baseline = NULL;
+    int tolerance = 20;
+};
+
+static pthread_rwlock_t boostLock = PTHREAD_RWLOCK_INITIALIZER;
+
+extern "C" {
+
+void *ShmemInitStruct(const char *name, Size size, bool *foundPtr) {
+    *foundPtr = false;
+    return malloc(size);
+}
+
+Size mul_size(Size s1, Size s2) {
+    return s1 * s2;
+}
+
+bool errstart(int elevel, const char *domain) {
+    return elevel >= ERROR;
+}
+
+int errmsg_internal(const char *fmt, ...) {
+    fprintf(stderr, "%s\n", fmt);
+    return 0;
+}
+
+void errfinish(const char *filename, int lineno, const char *funcname) {
+    abort();
+}
+
+}
+
+static RelTag BenchRelTag(uint32_t rel) {
+    RelTag tag;
+
+    tag.reln.spcNode = BENCH_SPC_ID;
+    tag.reln.dbNode = BENCH_DB_ID;
+    tag.reln.relNode = BENCH_REL_ID + rel;
+    tag.forkNumber = MAIN_FORKNUM;
+    return tag;
+}
+
+// As ParseRelKey2String in rel_cache.c
+static void BenchRelString(uint32_t rel, char *key) {
+    snprintf(key, BENCH_KEY_LEN, "rel_cache_%lu_%lu_%lu_%u", (unsigned long) BENCH_SPC_ID,
+             (unsigned long) BENCH_DB_ID, (unsigned long) (BENCH_REL_ID + rel), 0u);
+}
+
+static void BuiltinInsert(uint32_t rel, uint32_t size) {
+    RelTag tag = BenchRelTag(rel);
+
+    RelSizeTableInsert(&tag, RelSizeTableHashCode(&tag), (int) size);
+}
+
+static void BuiltinExtend(uint32_t rel, uint32_t size) {
+    RelTag tag = BenchRelTag(rel);
+
+    RelSizeTableExtend(&tag, RelSizeTableHashCode(&tag), (int) size);
+}
+
+static int BuiltinLookup(uint32_t rel) {
+    RelTag tag = BenchRelTag(rel);
+
+    return RelSizeTableLookup(&tag, RelSizeTableHashCode(&tag));
+}
+
+static void BoostInsert(uint32_t rel, uint32_t size) {
+    char key[BENCH_KEY_LEN];
+
+    BenchRelString(rel, key);
+    pthread_rwlock_wrlock(&boostLock);
+    UnorderedHashMapInsert(key, size);
+    pthread_rwlock_unlock(&boostLock);
+}
+
+static bool BoostLookup(uint32_t rel) {
+    char key[BENCH_KEY_LEN];
+    uint32_t size;
+    bool found;
+
+    BenchRelString(rel, key);
+    pthread_rwlock_rdlock(&boostLock);
+    found = UnorderedHashMapGet(key, &size);
+    pthread_rwlock_unlock(&boostLock);
+    return found;
+}
+
+static void Usage(const char *progname) {
+    fprintf(stderr, "usage: %s [-t threads] [-k rels] [-n ops] [-z theta] [-r percent] "
+                    "[-w phases] [-o file] [-b file] [-T percent]\n", progname);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions options;
+    std::vector<PhaseResult> results;
+    bool builtinInserted = false;
+    bool boostCreated = false;
+    bool boostInserted = false;
+    int opt;
+
+    while((opt = getopt(argc, argv, "t:k:n:z:r:w:o:b:T:")) != -1) {
+        switch(opt) {
+            case 't': options.threads = atoi(optarg); break;
+            case 'k': options.rels = (uint32_t) atol(optarg); break;
+            case 'n': options.ops = strtoull(optarg, NULL, 10); break;
+            case 'z': options.theta = atof(optarg); break;
+            case 'r': options.readPercent = atoi(optarg); break;
+            case 'w': options.phases = optarg; break;
+            case 'o': options.output = optarg; break;
+            case 'b': options.baseline = optarg; break;
+            case 'T': options.tolerance = atoi(optarg); break;
+            default: Usage(argv[0]);
+        }
+    }
+    if(options.threads <= 0 || options.rels == 0 || options.rels > REL_SIZE_ESTIMATE_SIZE || options.theta >= 1 ||
+       options.readPercent < 0 || options.readPercent > 100 || options.tolerance < 0 || options.tolerance > 100)
+        Usage(argv[0]);
+
+    InitRelSizeTable();
+    KeyPicker picker(options.rels, options.theta);
+    printf("threads = %d, rels = %u, ops = %lu per thread, theta = %.2f\n",
+           options.threads, options.rels, (unsigned long) options.ops, options.theta);
+
+    for(const std::string &phase : SplitPhases(options.phases)) {
+        bool boost = phase.compare(0, 6, "boost-") == 0;
+        std::string op = phase.substr(phase.find('-') + 1);
+        PhaseResult result;
+        int savedStdout = -1;
+
+        if(phase.compare(0, 8, "builtin-") != 0 && !boost) {
+            fprintf(stderr, "unknown phase %s\n", phase.c_str());
+            return 1;
+        }
+        if(op != "insert" && !(boost ? boostInserted : builtinInserted)) {
+            fprintf(stderr, "phase %s needs the insert phase of its table before it\n", phase.c_str());
+            return 1;
+        }
+        if(op != "insert" && op != "lookup" && op != "mix") {
+            fprintf(stderr, "unknown phase %s\n", phase.c_str());
+            return 1;
+        }
+        if(boost) {
+            fflush(stdout);
+            savedStdout = dup(STDOUT_FILENO);
+            int devNull = open("/dev/null", O_WRONLY);
+            dup2(devNull, STDOUT_FILENO);
+            close(devNull);
+            if(!boostCreated)
+                boostCreated = UnorderedHashMapCreate();
+        }
+
+        bool insert = op == "insert";
+        int readPercent = op == "lookup" ? 100 : options.readPercent;
+
+        result = RunPhase(phase, options.threads, [&](int thread) -> uint64_t {
+            std::mt19937_64 rng(20201 + thread);
+            uint32_t size = 1;
+
+            for(uint64_t i = 0; i < options.ops; i++) {
+                // The inserts start out with a pass over all relations
+                uint64_t next = i * options.threads + thread;
+                uint32_t rel = insert && next < options.rels ? (uint32_t) next : picker.Pick(rng);
+                bool read = !insert && (int) (rng() % 100) < readPercent;
+
+                if(read) {
+                    if(boost)
+                        BoostLookup(rel);
+                    else
+                        BuiltinLookup(rel);
+                } else if(boost) {
+                    BoostInsert(rel, size++);
+                } else if(insert) {
+                    BuiltinInsert(rel, size++);
+                } else {
+                    BuiltinExtend(rel, size++);
+                }
+            }
+            return options.ops;
+        });
+
+        if(boost) {
+            fflush(stdout);
+            dup2(savedStdout, STDOUT_FILENO);
+            close(savedStdout);
+        }
+        if(insert)
+            (boost ? boostInserted : builtinInserted) = true;
+        PrintResult(result, options.threads);
+        results.push_back(result);
+    }
+
+    // Not to be found by a compute node started later
+    if(boostCreated)
+        shm_unlink("MySharedMemory");
+    if(options.output != NULL && !WriteResults(options.output, results))
+        return 1;
+    if(options.baseline != NULL)
+        return CheckBaseline(options.baseline, options.tolerance, results);
+    return 0;
+}
@@ -0,0 +1,376 @@
+//
+// Micro-benchmark of the storage node's page server. It drives the
+// DataPageAccess service directly, one connection per thread, and reports
+// throughput and a latency histogram for every phase, with the reads the
+// node served from the relation files, from RocksDB and by replay while it
+// ran (openaurora_page_reads_total).
+//
+// Usage: pageserver_bench -r spc/db/rel [options]
+//   -H host     storage node (127.0.0.1)
+//   -P port     storage node port (9092)
+//   -N          framed transport, for a node with RPC_NONBLOCKING_SERVER
+//   -f fork     fork of the relation (0)
+//   -t threads  connections (4)
+//   -d seconds  length of each phase (10)
+//   -w phases   comma separated, run in order (base,replay,rocksdb,chain,meta)
+//   -z theta    zipfian skew of the blocks read, 0 for uniform (0)
+//   -l lsn      target LSN as X/X, the node's parsed LSN by default
+//   -c lsn      lowest LSN of the chain phase, 16MB below the target by default
+//   -m percent  share of nblocks and exists calls in the meta phase (50)
+//   -F          read at the node's flushed LSN, polled every 100ms, so reads
+//               wait on the parsing of the WAL a concurrent writer ingests
+//
+// Phases:
+//   base     reads at LSN 1, below every version
+//   replay   reads at the target LSN, each block once, so that what changed
+//            since the last materialized version is replayed
+//   rocksdb  reads at the target LSN again
+//   chain    reads at an LSN between -c and the target, in ten bands by
+//            distance from -c; the farther from the last materialized
+//            version, the longer the chain replayed
+//   meta     reads mixed with nblocks and exists calls
+//
+// Attribute a path by its counters: the base phase only counts as base if
+// the node has the relation's pages in its files, the replay phase only
+// replays on a node that hasn't materialized them at that LSN yet.
+//
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pageserver_common.h"
+
+#define BENCH_CHAIN_BANDS 10
+#define BENCH_PATHS 3
+
+static const char *const benchPaths[BENCH_PATHS] = {"base", "rocksdb", "replay"};
+
+struct BenchOptions {
+    std::string host = "127.0.0.1";
+    int port = 9092;
+    bool framed = false;
+    _Smgr_Relation reln;
+    int forkNum = 0;
+    int threads = 4;
+    int seconds = 10;
+    std::vector<std::string> phases;
+    double theta = 0;
+    int64_t lsn = 0;
+    int64_t chainLow = 0;
+    int metaPercent = 50;
+    bool follow = false;
+};
+
+// Zipfian ranks as in YCSB, scrambled so the hot blocks aren't adjacent
+class BlockPicker {
+public:
+    BlockPicker(uint32_t n, double theta) : n(n), theta(theta) {
+        if(theta <= 0)
+            return;
+        for(uint32_t i = 1; i <= n; i++)
+            zetan += 1 / std::pow((double) i, theta);
+        double zeta2 = 1 + 1 / std::pow(2.0, theta);
+        alpha = 1 / (1 - theta);
+        eta = (1 - std::pow(2.0 / n, 1 - theta)) / (1 - zeta2 / zetan);
+    }
+
+    uint32_t Pick(std::mt19937_64 &rng) const {
+        if(theta <= 0)
+            return (uint32_t) (rng() % n);
+
+        double u = std::uniform_real_distribution<double>(0, 1)(rng);
+        double uz = u * zetan;
+        uint64_t rank;
+        if(uz < 1)
+            rank = 0;
+        else if(uz < 1 + std::pow(0.5, theta))
+            rank = 1;
+        else
+            rank = (uint64_t) (n * std::pow(eta * u - eta + 1, alpha));
+        rank = std::min(rank, (uint64_t) n - 1);
+        return (uint32_t) ((rank * 0x9E3779B97F4A7C15ull) % n);
+    }
+
+private:
+    uint32_t n;
+    double theta;
+    double zetan = 0;
+    double alpha = 0;
+    double eta = 0;
+};
+
+struct NodeCounters {
+    uint64_t reads[BENCH_PATHS] = {0};
+    uint64_t walBytes = 0;
+    int64_t parsedLsn = 0;
+    int64_t flushedLsn = 0;
+};
+
+// text starts with a newline, so every sample line follows one
+static double MetricValue(const std::string &text, const std::string &name) {
+    std::string line = "\n" + name + " ";
+    size_t at = text.find(line);
+
+    if(at == std::string::npos)
+        return 0;
+    return strtod(text.c_str() + at + line.size(), NULL);
+}
+
+static NodeCounters ReadCounters(Connection &conn) {
+    NodeCounters counters;
+    std::string text;
+
+    conn.client->RpcGetSmartReplayMetrics(text);
+    text = "\n" + text;
+    for(int i = 0; i < BENCH_PATHS; i++)
+        counters.reads[i] = (uint64_t) MetricValue(text, std::string("openaurora_page_reads_total{path=\"") +
+                                                         benchPaths[i] + "\"}");
+    counters.walBytes = (uint64_t) MetricValue(text, "openaurora_asr_wal_bytes_total");
+    counters.parsedLsn = (int64_t) MetricValue(text, "openaurora_xlog_parse_upto_lsn");
+    counters.flushedLsn = (int64_t) MetricValue(text, "openaurora_xlog_flushed_lsn");
+    return counters;
+}
+
+// What one phase shares between its threads
+struct Phase {
+    std::string name;
+    std::atomic<bool> stop{false};
+    std::atomic<int64_t> lsn{0};
+    // Next block of the replay phase
+    std::atomic<uint32_t> cursor{0};
+    std::vector<uint32_t> order;
+};
+
+// Histograms of one thread, by what it measured
+struct ThreadStats {
+    Histogram reads;
+    Histogram nblocks;
+    Histogram exists;
+    Histogram bands[BENCH_CHAIN_BANDS];
+};
+
+static void RunThread(const BenchOptions &options, Phase &phase, const BlockPicker &picker, uint32_t nblocks,
+                      int id, ThreadStats &stats) {
+    Connection conn = Connect(options.host, options.port, options.framed);
+    std::mt19937_64 rng(20201 + id);
+    _Page page;
+
+    while(!phase.stop.load(std::memory_order_relaxed)) {
+        int64_t lsn = phase.lsn.load(std::memory_order_relaxed);
+        int32_t blkNum;
+        Clock::time_point start;
+
+        if(phase.name == "base") {
+            blkNum = (int32_t) picker.Pick(rng);
+            start = Clock::now();
+            conn.client->ReadBufferCommon(page, options.reln, 'p', options.forkNum, blkNum, 0, 1, 0);
+            stats.reads.Record(ElapsedUs(start));
+        } else if(phase.name == "replay") {
+            uint32_t next = phase.cursor.fetch_add(1);
+            if(next >= nblocks)
+                break;
+            blkNum = (int32_t) phase.order[next];
+            start = Clock::now();
+            conn.client->ReadBufferCommon(page, options.reln, 'p', options.forkNum, blkNum, 0, lsn, 0);
+            stats.reads.Record(ElapsedUs(start));
+        } else if(phase.name == "rocksdb") {
+            blkNum = (int32_t) picker.Pick(rng);
+            start = Clock::now();
+            conn.client->ReadBufferCommon(page, options.reln, 'p', options.forkNum, blkNum, 0, lsn, 0);
+            stats.reads.Record(ElapsedUs(start));
+        } else if(phase.name == "chain") {
+            int64_t span = std::max(lsn - options.chainLow, (int64_t) 1);
+            int64_t at = options.chainLow + (int64_t) (rng() % (uint64_t) span) + 1;
+            int band = (int) ((at - options.chainLow - 1) * BENCH_CHAIN_BANDS / span);
+
+            blkNum = (int32_t) picker.Pick(rng);
+            start = Clock::now();
+            conn.client->ReadBufferCommon(page, options.reln, 'p', options.forkNum, blkNum, 0, at, 0);
+            stats.bands[band].Record(ElapsedUs(start));
+        } else {
+            int dice = (int) (rng() % 100);
+
+            start = Clock::now();
+            if(dice < options.metaPercent / 2) {
+                conn.client->RpcMdNblocks(options.reln, options.forkNum, lsn);
+                stats.nblocks.Record(ElapsedUs(start));
+            } else if(dice < options.metaPercent) {
+                conn.client->RpcMdExists(options.reln, options.forkNum, lsn);
+                stats.exists.Record(ElapsedUs(start));
+            } else {
+                blkNum = (int32_t) picker.Pick(rng);
+                conn.client->ReadBufferCommon(page, options.reln, 'p', options.forkNum, blkNum, 0, lsn, 0);
+                stats.reads.Record(ElapsedUs(start));
+            }
+        }
+    }
+    conn.transport->close();
+}
+
+static void RunPhase(const BenchOptions &options, Connection &control, const std::string &name,
+                     const BlockPicker &picker, uint32_t nblocks) {
+    Phase phase;
+    std::vector<ThreadStats> stats(options.threads);
+    std::vector<std::thread> threads;
+    std::mt19937_64 rng(7);
+
+    phase.name = name;
+    phase.lsn = options.lsn;
+    if(name == "replay") {
+        phase.order.resize(nblocks);
+        for(uint32_t i = 0; i < nblocks; i++)
+            phase.order[i] = i;
+        std::shuffle(phase.order.begin(), phase.order.end(), rng);
+    }
+
+    NodeCounters before = ReadCounters(control);
+    Clock::time_point start = Clock::now();
+    for(int i = 0; i < options.threads; i++)
+        threads.emplace_back(RunThread, std::cref(options), std::ref(phase), std::cref(picker), nblocks, i,
+                             std::ref(stats[i]));
+
+    Clock::time_point deadline = start + std::chrono::seconds(options.seconds);
+    while(Clock::now() < deadline &&
+          !(name == "replay" && phase.cursor.load() >= nblocks)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if(options.follow)
+            phase.lsn = ReadCounters(control).flushedLsn;
+    }
+    phase.stop = true;
+    for(std::thread &thread : threads)
+        thread.join();
+    double seconds = ElapsedUs(start) / 1e6;
+    NodeCounters after = ReadCounters(control);
+
+    ThreadStats total;
+    for(ThreadStats &s : stats) {
+        total.reads.Merge(s.reads);
+        total.nblocks.Merge(s.nblocks);
+        total.exists.Merge(s.exists);
+        for(int b = 0; b < BENCH_CHAIN_BANDS; b++)
+            total.bands[b].Merge(s.bands[b]);
+    }
+
+    printf("%s: %.1f s, %d threads, lsn %X/%X\n", name.c_str(), seconds, options.threads,
+           (uint32_t) (phase.lsn >> 32), (uint32_t) phase.lsn);
+    PrintHistogram("read", total.reads, seconds);
+    PrintHistogram("nblocks", total.nblocks, seconds);
+    PrintHistogram("exists", total.exists, seconds);
+    for(int b = 0; b < BENCH_CHAIN_BANDS; b++) {
+        char band[16];
+
+        snprintf(band, sizeof(band), "band %d", b);
+        PrintHistogram(band, total.bands[b], seconds);
+    }
+    printf("  node reads: base %" PRIu64 ", rocksdb %" PRIu64 ", replay %" PRIu64
+           "; wal ingested %.1f MB/s, parsed %.1f MB/s\n",
+           after.reads[0] - before.reads[0], after.reads[1] - before.reads[1], after.reads[2] - before.reads[2],
+           (after.walBytes - before.walBytes) / seconds / 1e6,
+           (after.parsedLsn - before.parsedLsn) / seconds / 1e6);
+}
+
+static bool ParseLsn(const char *text, int64_t *lsn) {
+    uint32_t hi, lo;
+
+    if(sscanf(text, "%X/%X", &hi, &lo) != 2)
+        return false;
+    *lsn = ((int64_t) hi << 32) | lo;
+    return true;
+}
+
+static void Usage(const char *argv0) {
+    fprintf(stderr, "usage: %s -r spc/db/rel [-H host] [-P port] [-N] [-f fork] [-t threads] [-d seconds]\n"
+                    "       [-w base,replay,rocksdb,chain,meta] [-z theta] [-l lsn] [-c lsn] [-m percent] [-F]\n",
+            argv0);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    BenchOptions options;
+    std::string phases = "base,replay,rocksdb,chain,meta";
+    bool haveRel = false;
+    int opt;
+
+    options.reln._backend_id = -1;
+    while((opt = getopt(argc, argv, "H:P:Nr:f:t:d:w:z:l:c:m:F")) != -1) {
+        switch(opt) {
+            case 'H': options.host = optarg; break;
+            case 'P': options.port = atoi(optarg); break;
+            case 'N': options.framed = true; break;
+            case 'r': {
+                unsigned spc, db, rel;
+                if(sscanf(optarg, "%u/%u/%u", &spc, &db, &rel) != 3)
+                    Usage(argv[0]);
+                options.reln._spc_node = spc;
+                options.reln._db_node = db;
+                options.reln._rel_node = rel;
+                haveRel = true;
+                break;
+            }
+            case 'f': options.forkNum = atoi(optarg); break;
+            case 't': options.threads = atoi(optarg); break;
+            case 'd': options.seconds = atoi(optarg); break;
+            case 'w': phases = optarg; break;
+            case 'z': options.theta = atof(optarg); break;
+            case 'l': if(!ParseLsn(optarg, &options.lsn)) Usage(argv[0]); break;
+            case 'c': if(!ParseLsn(optarg, &options.chainLow)) Usage(argv[0]); break;
+            case 'm': options.metaPercent = atoi(optarg); break;
+            case 'F': options.follow = true; break;
+            default: Usage(argv[0]);
+        }
+    }
+    // The zipfian generator's constants only hold for theta below 1
+    if(!haveRel || options.threads <= 0 || options.seconds <= 0 || options.theta < 0 || options.theta >= 1 ||
+       options.metaPercent < 0 || options.metaPercent > 100)
+        Usage(argv[0]);
+
+    std::stringstream list(phases);
+    std::string phase;
+    while(std::getline(list, phase, ',')) {
+        if(phase != "base" && phase != "replay" && phase != "rocksdb" && phase != "chain" && phase != "meta")
+            Usage(argv[0]);
+        options.phases.push_back(phase);
+    }
+
+    try {
+        Connection control = Connect(options.host, options.port, options.framed);
+        NodeCounters counters = ReadCounters(control);
+
+        if(options.lsn == 0)
+            options.lsn = options.follow ? counters.flushedLsn : counters.parsedLsn;
+        if(options.chainLow == 0)
+            options.chainLow = std::max(options.lsn - 16 * 1024 * 1024, (int64_t) 1);
+        int32_t nblocks = control.client->RpcMdNblocks(options.reln, options.forkNum, options.lsn);
+        if(nblocks <= 0) {
+            fprintf(stderr, "relation %" PRId64 "/%" PRId64 "/%" PRId64 " fork %d has no blocks at %X/%X\n",
+                    options.reln._spc_node, options.reln._db_node, options.reln._rel_node, options.forkNum,
+                    (uint32_t) (options.lsn >> 32), (uint32_t) options.lsn);
+            return 1;
+        }
+        printf("%s:%d, relation %" PRId64 "/%" PRId64 "/%" PRId64 " fork %d, %d blocks, %s\n",
+               options.host.c_str(), options.port, options.reln._spc_node, options.reln._db_node,
+               options.reln._rel_node, options.forkNum, nblocks, options.theta > 0 ? "zipfian" : "uniform");
+
+        BlockPicker picker((uint32_t) nblocks, options.theta);
+        for(const std::string &name : options.phases)
+            RunPhase(options, control, name, picker, (uint32_t) nblocks);
+        control.transport->close();
+    } catch(TException &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+//
+// What the page server benchmark and replay tool share: a latency
+// histogram, its report line and a connection to a storage node.
+//
+#ifndef PAGESERVER_COMMON_H
+#define PAGESERVER_COMMON_H
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+
+#include <thrift/protocol/TBinaryProtocol.h>
+#include <thrift/transport/TBufferTransports.h>
+#include <thrift/transport/TSocket.h>
+#include "DataPageAccess.h"
+#include "rpc_wire.h"
+
+using namespace apache::thrift;
+using namespace apache::thrift::protocol;
+using namespace apache::thrift::transport;
+using namespace tutorial;
+
+typedef std::chrono::steady_clock Clock;
+
+// Microseconds in 16 sub-buckets per power of two, within ~6%
+class Histogram {
+public:
+    static const int BUCKETS = 1024;
+
+    void Record(uint64_t us) {
+        counts[Index(us)]++;
+        count++;
+        sum += us;
+        max = std::max(max, us);
+    }
+
+    void Merge(const Histogram &other) {
+        for(int i = 0; i < BUCKETS; i++)
+            counts[i] += other.counts[i];
+        count += other.count;
+        sum += other.sum;
+        max = std::max(max, other.max);
+    }
+
+    uint64_t Percentile(double p) const {
+        uint64_t rank = (uint64_t) std::ceil(count * p / 100);
+        uint64_t seen = 0;
+
+        for(int i = 0; i < BUCKETS; i++) {
+            seen += counts[i];
+            if(seen >= rank && seen > 0)
+                return std::min(Upper(i), max);
+        }
+        return max;
+    }
+
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+
+private:
+    uint64_t counts[BUCKETS] = {0};
+
+    static int Index(uint64_t us) {
+        if(us < 32)
+            return (int) us;
+        int msb = 63 - __builtin_clzll(us);
+        return std::min((msb - 4) * 16 + (int) (us >> (msb - 4)), BUCKETS - 1);
+    }
+
+    // Largest value of bucket i
+    static uint64_t Upper(int i) {
+        if(i < 32)
+            return i;
+        int shift = i / 16 - 1;
+        return ((uint64_t) (i % 16 + 16) << shift) + ((uint64_t) 1 << shift) - 1;
+    }
+};
+
+struct Connection {
+    std::shared_ptr<TTransport> transport;
+    std::unique_ptr<DataPageAccessClient> client;
+};
+
+// In the wire format RPC_PROTOCOL and RPC_TRANSPORT name, as the nodes do
+static Connection Connect(const std::string &host, int port, bool framed) {
+    Connection conn;
+    RpcWire wire = RpcWireFromEnv();
+
+    if(framed)
+        wire.transport = RPC_TRANSPORT_FRAMED;
+    conn.transport = RpcWireTransport(wire, std::make_shared<TSocket>(host, port));
+    conn.transport->open();
+    conn.client.reset(new DataPageAccessClient(RpcWireProtocol(wire, conn.transport)));
+    return conn;
+}
+
+static uint64_t ElapsedUs(Clock::time_point start) {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+static void PrintHistogram(const char *what, const Histogram &h, double seconds) {
+    if(h.count == 0)
+        return;
+    printf("  %-10s %10" PRIu64 " ops %10.0f ops/s  mean %8.0f  p50 %8" PRIu64 "  p90 %8" PRIu64
+           "  p99 %8" PRIu64 "  p99.9 %8" PRIu64 "  max %8" PRIu64 " us\n",
+           what, h.count, h.count / seconds, (double) h.sum / h.count, h.Percentile(50), h.Percentile(90),
+           h.Percentile(99), h.Percentile(99.9), h.max);
+}
+
+#endif //PAGESERVER_COMMON_H
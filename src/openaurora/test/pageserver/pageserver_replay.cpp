@@ -0,0 +1,241 @@
+//
+// Replays a request trace a storage node captured with STORAGE_REQUEST_TRACE
+// against a storage node. Each stream of the trace, a server thread of the
+// capturing node, is sent again from a connection of its own, every request
+// at its offset in the trace divided by the speed, so the replay has the
+// concurrency and, at speed 1, the pace of the capture. It reports a latency
+// histogram for every request type and how late the requests were sent:
+// a replay that can't keep up with the trace shows as schedule lag.
+//
+// Usage: pageserver_replay -f trace [options]
+//   -H host     storage node (127.0.0.1)
+//   -P port     storage node port (9092)
+//   -N          framed transport, for a node with RPC_NONBLOCKING_SERVER
+//   -s speed    multiplier of the trace's pace, 0 to send without pauses (1)
+//   -C          cap the LSNs at the node's parsed LSN, for a node that
+//               hasn't the WAL the capturing node had
+//
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pageserver_common.h"
+#include "storage/request_trace.h"
+
+#define REPLAY_TYPES (REQUEST_TRACE_CONTINUED)
+
+static const char *const replayTypes[REPLAY_TYPES] = {"", "read", "batch", "ifmodified", "prefetch", "nblocks",
+                                                     "exists"};
+
+struct ReplayOptions {
+    std::string host = "127.0.0.1";
+    int port = 9092;
+    bool framed = false;
+    std::string trace;
+    double speed = 1;
+    bool capLsn = false;
+};
+
+// A request of the trace, the blocks of a list request together
+struct ReplayRequest {
+    RequestTraceRecord record;
+    std::vector<int64_t> blkNums;
+};
+
+struct ReplayStats {
+    Histogram types[REPLAY_TYPES];
+    Histogram lag;
+    uint64_t errors = 0;
+};
+
+static bool ReadTrace(const std::string &path, std::map<uint32_t, std::vector<ReplayRequest>> &streams,
+                      uint64_t *records) {
+    FILE *file = fopen(path.c_str(), "rb");
+    RequestTraceHeader header;
+    RequestTraceRecord record;
+
+    if(file == NULL) {
+        fprintf(stderr, "couldn't open %s: %s\n", path.c_str(), strerror(errno));
+        return false;
+    }
+    if(fread(&header, sizeof(header), 1, file) != 1 ||
+       memcmp(header.magic, REQUEST_TRACE_MAGIC, sizeof(header.magic)) != 0) {
+        fprintf(stderr, "%s isn't a request trace\n", path.c_str());
+        fclose(file);
+        return false;
+    }
+
+    *records = 0;
+    while(fread(&record, sizeof(record), 1, file) == 1) {
+        std::vector<ReplayRequest> &stream = streams[record.stream];
+
+        (*records)++;
+        if(record.type == REQUEST_TRACE_CONTINUED) {
+            // A list cut short by the end of the capture, or its head lost
+            if(!stream.empty() && stream.back().blkNums.size() < stream.back().record.count)
+                stream.back().blkNums.push_back(record.blkNum);
+            continue;
+        }
+        if(record.type == 0 || record.type >= REPLAY_TYPES)
+            continue;
+        ReplayRequest request;
+        request.record = record;
+        request.blkNums.push_back(record.blkNum);
+        stream.push_back(request);
+    }
+    fclose(file);
+    return true;
+}
+
+static void ReplayStream(const ReplayOptions &options, const std::vector<ReplayRequest> &requests,
+                         int64_t lsnCap, Clock::time_point start, ReplayStats &stats) {
+    Connection conn = Connect(options.host, options.port, options.framed);
+    std::vector<_Page> pages;
+    _Page page;
+
+    for(const ReplayRequest &request : requests) {
+        const RequestTraceRecord &r = request.record;
+        int64_t lsn = (int64_t) r.lsn;
+        _Smgr_Relation reln;
+
+        if(options.speed > 0) {
+            Clock::time_point due = start + std::chrono::nanoseconds((int64_t) (r.offsetNs / options.speed));
+            Clock::time_point now = Clock::now();
+
+            if(now < due)
+                std::this_thread::sleep_until(due);
+            else
+                stats.lag.Record((uint64_t) std::chrono::duration_cast<std::chrono::microseconds>(now - due).count());
+        }
+        if(lsnCap > 0)
+            lsn = std::min(lsn, lsnCap);
+        reln._spc_node = r.spcNode;
+        reln._db_node = r.dbNode;
+        reln._rel_node = r.relNode;
+        reln._backend_id = -1;
+
+        Clock::time_point sent = Clock::now();
+        try {
+            switch(r.type) {
+                case REQUEST_TRACE_READ:
+                    conn.client->ReadBufferCommon(page, reln, 'p', r.forkNum, (int32_t) r.blkNum, 0, lsn, 0);
+                    break;
+                case REQUEST_TRACE_READ_BATCH:
+                    conn.client->ReadBufferBatch(pages, reln, 'p', r.forkNum, request.blkNums, 0, lsn);
+                    break;
+                case REQUEST_TRACE_READ_IF_MODIFIED:
+                    conn.client->ReadBufferIfModified(page, reln, 'p', r.forkNum, (int32_t) r.blkNum, 0, lsn,
+                                                      (int64_t) r.cachedLsn);
+                    break;
+                case REQUEST_TRACE_PREFETCH:
+                    conn.client->PrefetchBuffers(reln, r.forkNum, request.blkNums, lsn);
+                    break;
+                case REQUEST_TRACE_NBLOCKS:
+                    conn.client->RpcMdNblocks(reln, r.forkNum, lsn);
+                    break;
+                case REQUEST_TRACE_EXISTS:
+                    conn.client->RpcMdExists(reln, r.forkNum, lsn);
+                    break;
+            }
+        } catch(TApplicationException &e) {
+            // The node failed the request, the connection is still in sync
+            stats.errors++;
+            continue;
+        }
+        stats.types[r.type].Record(ElapsedUs(sent));
+    }
+    conn.transport->close();
+}
+
+static void Usage(const char *argv0) {
+    fprintf(stderr, "usage: %s -f trace [-H host] [-P port] [-N] [-s speed] [-C]\n", argv0);
+    exit(1);
+}
+
+int main(int argc, char **argv) {
+    ReplayOptions options;
+    std::map<uint32_t, std::vector<ReplayRequest>> streams;
+    uint64_t records;
+    int opt;
+
+    while((opt = getopt(argc, argv, "H:P:Nf:s:C")) != -1) {
+        switch(opt) {
+            case 'H': options.host = optarg; break;
+            case 'P': options.port = atoi(optarg); break;
+            case 'N': options.framed = true; break;
+            case 'f': options.trace = optarg; break;
+            case 's': options.speed = atof(optarg); break;
+            case 'C': options.capLsn = true; break;
+            default: Usage(argv[0]);
+        }
+    }
+    if(options.trace.empty() || options.speed < 0)
+        Usage(argv[0]);
+    if(!ReadTrace(options.trace, streams, &records))
+        return 1;
+
+    uint64_t requests = 0;
+    uint64_t lastNs = 0;
+    for(auto &stream : streams) {
+        requests += stream.second.size();
+        if(!stream.second.empty())
+            lastNs = std::max(lastNs, stream.second.back().record.offsetNs);
+    }
+    printf("%s: %" PRIu64 " records, %" PRIu64 " requests in %zu streams over %.1f s, speed %g\n",
+           options.trace.c_str(), records, requests, streams.size(), lastNs / 1e9, options.speed);
+
+    try {
+        int64_t lsnCap = 0;
+
+        if(options.capLsn) {
+            Connection control = Connect(options.host, options.port, options.framed);
+            std::string text;
+
+            control.client->RpcGetSmartReplayMetrics(text);
+            text = "\n" + text;
+            size_t at = text.find("\nopenaurora_xlog_parse_upto_lsn ");
+            if(at != std::string::npos)
+                lsnCap = (int64_t) strtod(text.c_str() + at + strlen("\nopenaurora_xlog_parse_upto_lsn "), NULL);
+            control.transport->close();
+            printf("capping LSNs at %X/%X\n", (uint32_t) (lsnCap >> 32), (uint32_t) lsnCap);
+        }
+
+        std::vector<ReplayStats> stats(streams.size());
+        std::vector<std::thread> threads;
+        // Leave the threads time to connect before the first request is due
+        Clock::time_point start = Clock::now() + std::chrono::milliseconds(100);
+        size_t i = 0;
+        for(auto &stream : streams)
+            threads.emplace_back(ReplayStream, std::cref(options), std::cref(stream.second), lsnCap, start,
+                                 std::ref(stats[i++]));
+        for(std::thread &thread : threads)
+            thread.join();
+        double seconds = std::max(ElapsedUs(start), (uint64_t) 1) / 1e6;
+
+        ReplayStats total;
+        for(ReplayStats &s : stats) {
+            for(int t = 0; t < REPLAY_TYPES; t++)
+                total.types[t].Merge(s.types[t]);
+            total.lag.Merge(s.lag);
+            total.errors += s.errors;
+        }
+        printf("replayed in %.1f s, %" PRIu64 " failed\n", seconds, total.errors);
+        for(int t = 1; t < REPLAY_TYPES; t++)
+            PrintHistogram(replayTypes[t], total.types[t], seconds);
+        PrintHistogram("late", total.lag, seconds);
+    } catch(TException &e) {
+        fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}